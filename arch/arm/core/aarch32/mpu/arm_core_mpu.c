@@ -9,6 +9,7 @@
 #include <kernel.h>
 #include <soc.h>
 #include <kernel_structs.h>
+#include <string.h>
 
 #include "arm_core_mpu_dev.h"
 #include <linker/linker-defs.h>
@@ -156,6 +157,44 @@ void z_arm_configure_static_mpu_regions(void)
 #endif /* CONFIG_MPU_REQUIRES_NON_OVERLAPPING_REGIONS */
 }
 
+#if defined(CONFIG_USERSPACE)
+/* Merge a memory domain partition into a region adjacent to it, of the
+ * same attributes, if the MPU can hold their union in a single region.
+ * Domain partitions never overlap, so the merged region grants the
+ * same accesses as the two regions.
+ */
+static bool region_merge(struct z_arm_mpu_partition *region,
+			 const struct k_mem_partition *partition)
+{
+	uintptr_t start;
+	size_t size = region->size + partition->size;
+
+	if (memcmp(&region->attr, &partition->attr,
+		   sizeof(region->attr)) != 0) {
+		return false;
+	}
+
+	if (region->start + region->size == partition->start) {
+		start = region->start;
+	} else if (partition->start + partition->size == region->start) {
+		start = partition->start;
+	} else {
+		return false;
+	}
+
+#if defined(CONFIG_MPU_REQUIRES_POWER_OF_TWO_ALIGNMENT)
+	if ((size & (size - 1U)) != 0U || (start & (size - 1U)) != 0U) {
+		return false;
+	}
+#endif
+
+	region->start = start;
+	region->size = size;
+
+	return true;
+}
+#endif /* CONFIG_USERSPACE */
+
 /**
  * @brief Use the HW-specific MPU driver to program
  *        the dynamic MPU regions.
@@ -168,6 +207,9 @@ void z_arm_configure_static_mpu_regions(void)
  * For some MPU architectures, such as the unmodified ARMv8-M MPU,
  * the function must execute with MPU enabled.
  *
+ * The MPU driver is not called if the regions are the ones it last
+ * programmed, e.g. when a thread is switched back in after an interrupt.
+ *
  * This function is not inherently thread-safe, but the memory domain
  * spinlock needs to be held anyway.
  */
@@ -195,6 +237,10 @@ void z_arm_configure_dynamic_mpu_regions(struct k_thread *thread)
 	 */
 	static struct z_arm_mpu_partition
 			dynamic_regions[_MAX_DYNAMIC_MPU_REGIONS_NUM];
+	/* Regions last passed to the MPU driver */
+	static struct z_arm_mpu_partition
+			loaded_regions[_MAX_DYNAMIC_MPU_REGIONS_NUM];
+	static int loaded_num = -1;
 
 	uint8_t region_num = 0U;
 
@@ -207,7 +253,7 @@ void z_arm_configure_dynamic_mpu_regions(struct k_thread *thread)
 		LOG_DBG("configure domain: %p", mem_domain);
 		uint32_t num_partitions = mem_domain->num_partitions;
 		struct k_mem_partition *partition;
-		int i;
+		int i, j;
 
 		LOG_DBG("configure domain: %p", mem_domain);
 
@@ -221,14 +267,30 @@ void z_arm_configure_dynamic_mpu_regions(struct k_thread *thread)
 			}
 			LOG_DBG("set region 0x%lx 0x%x",
 				partition->start, partition->size);
-			__ASSERT(region_num < _MAX_DYNAMIC_MPU_REGIONS_NUM,
-				"Out-of-bounds error for dynamic region map.");
 
-			dynamic_regions[region_num].start = partition->start;
-			dynamic_regions[region_num].size = partition->size;
-			dynamic_regions[region_num].attr = partition->attr;
+			/* The domain partitions are the first regions */
+			for (j = 0; j < region_num; j++) {
+				if (region_merge(&dynamic_regions[j],
+						 partition)) {
+					break;
+				}
+			}
+
+			if (j == region_num) {
+				__ASSERT(region_num <
+					 _MAX_DYNAMIC_MPU_REGIONS_NUM,
+					"Out-of-bounds error for dynamic region map.");
+
+				dynamic_regions[region_num].start =
+					partition->start;
+				dynamic_regions[region_num].size =
+					partition->size;
+				dynamic_regions[region_num].attr =
+					partition->attr;
+
+				region_num++;
+			}
 
-			region_num++;
 			num_partitions--;
 			if (num_partitions == 0U) {
 				break;
@@ -303,6 +365,16 @@ void z_arm_configure_dynamic_mpu_regions(struct k_thread *thread)
 	region_num++;
 #endif /* CONFIG_MPU_STACK_GUARD */
 
+	if (region_num == loaded_num &&
+	    memcmp(dynamic_regions, loaded_regions,
+		   region_num * sizeof(dynamic_regions[0])) == 0) {
+		return;
+	}
+
+	memcpy(loaded_regions, dynamic_regions,
+	       region_num * sizeof(dynamic_regions[0]));
+	loaded_num = region_num;
+
 	/* Configure the dynamic MPU regions */
 	arm_core_mpu_configure_dynamic_mpu_regions(dynamic_regions,
 						   region_num);
@@ -10,6 +10,7 @@
 
 
 #include <sys/math_extras.h>
+#include <string.h>
 
 #define LOG_LEVEL CONFIG_MPU_LOG_LEVEL
 #include <logging/log.h>
@@ -318,10 +319,26 @@ static int mpu_configure_static_mpu_regions(const struct z_arm_mpu_partition
 	return mpu_reg_index;
 }
 
+/* Maximum number of regions of the ARMv6-M and ARMv7-M MPUs */
+#define MPU_MAX_NUM_REGIONS 16
+
+/* Base address and RASR value of the regions as last programmed by
+ * mpu_configure_dynamic_mpu_regions(), RASR being 0 for the disabled
+ * ones, and index of the first region it left disabled.
+ */
+static uint32_t dyn_regions_base[MPU_MAX_NUM_REGIONS];
+static uint32_t dyn_regions_rasr[MPU_MAX_NUM_REGIONS];
+static uint8_t dyn_regions_end = UINT8_MAX;
+
 /* This internal function programs the dynamic MPU regions.
  *
  * It returns the number of MPU region indices configured.
  *
+ * The regions identical to the ones programmed at the same index by the
+ * previous call are left untouched, e.g. the memory domain partitions when
+ * switching between the threads of a domain, where only the thread stack
+ * regions change.
+ *
  * Note:
  * If the dynamic MPU regions configuration has not been successfully
  * performed, the error signal is propagated to the caller of the function.
@@ -330,22 +347,59 @@ static int mpu_configure_dynamic_mpu_regions(const struct z_arm_mpu_partition
 	dynamic_regions[], uint8_t regions_num)
 {
 	int mpu_reg_index = static_regions_num;
+	arm_mpu_region_attr_t attr;
 
 	/* In ARMv7-M architecture the dynamic regions are
 	 * programmed on top of existing SRAM region configuration.
 	 */
 
-	mpu_reg_index = mpu_configure_regions(dynamic_regions,
-		regions_num, mpu_reg_index, false);
+	for (int i = 0; i < regions_num; i++) {
+		const struct z_arm_mpu_partition *region = &dynamic_regions[i];
+
+		if (region->size == 0U) {
+			continue;
+		}
+
+		get_region_attr_from_mpu_partition_info(&attr, &region->attr,
+			region->start, region->size);
 
-	if (mpu_reg_index != -EINVAL) {
+		if (mpu_reg_index < MPU_MAX_NUM_REGIONS &&
+		    dyn_regions_base[mpu_reg_index] == region->start &&
+		    dyn_regions_rasr[mpu_reg_index] == attr.rasr) {
+			mpu_reg_index++;
+			continue;
+		}
 
-		/* Disable the non-programmed MPU regions. */
-		for (int i = mpu_reg_index; i < get_num_regions(); i++) {
-			ARM_MPU_ClrRegion(i);
+		if (mpu_configure_region(mpu_reg_index, region) == -EINVAL) {
+			/* Program all the regions at the next call */
+			dyn_regions_end = UINT8_MAX;
+			(void)memset(dyn_regions_rasr, 0,
+				     sizeof(dyn_regions_rasr));
+			return -EINVAL;
 		}
+
+		if (mpu_reg_index < MPU_MAX_NUM_REGIONS) {
+			dyn_regions_base[mpu_reg_index] = region->start;
+			dyn_regions_rasr[mpu_reg_index] = attr.rasr;
+		}
+
+		mpu_reg_index++;
 	}
 
+	/* Disable the MPU regions left over from the previous
+	 * configuration.
+	 */
+	for (int i = mpu_reg_index;
+	     i < MIN(dyn_regions_end, get_num_regions()); i++) {
+		ARM_MPU_ClrRegion(i);
+
+		if (i < MPU_MAX_NUM_REGIONS) {
+			dyn_regions_rasr[i] = 0U;
+		}
+	}
+
+	dyn_regions_end = mpu_reg_index;
+
 	return mpu_reg_index;
 }
 
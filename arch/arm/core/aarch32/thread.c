@@ -444,6 +444,13 @@ uint32_t z_check_thread_stack_fail(const uint32_t fault_addr, const uint32_t psp
 #endif /* CONFIG_MPU_STACK_GUARD || CONFIG_USERSPACE */
 
 #if defined(CONFIG_FPU) && defined(CONFIG_FPU_SHARING)
+#if defined(CONFIG_CORTEX_M_FP_LAZY_RESTORE)
+/* Thread whose context is held by the callee-saved FP registers, if any,
+ * maintained by z_arm_pendsv().
+ */
+struct k_thread *z_arm_fp_owner;
+#endif
+
 int arch_float_disable(struct k_thread *thread)
 {
 	if (thread != _current) {
@@ -467,6 +474,13 @@ int arch_float_disable(struct k_thread *thread)
 
 	__set_CONTROL(__get_CONTROL() & (~CONTROL_FPCA_Msk));
 
+#if defined(CONFIG_CORTEX_M_FP_LAZY_RESTORE)
+	/* The FP registers may have been modified by the thread, and are
+	 * no longer stored when it is switched out.
+	 */
+	z_arm_fp_owner = NULL;
+#endif
+
 	/* No need to add an ISB barrier after setting the CONTROL
 	 * register; arch_irq_unlock() already adds one.
 	 */
@@ -219,7 +219,7 @@ static int set_mapping(struct arm_mmu_ptables *ptables,
 		       uint64_t desc, bool may_overwrite)
 {
 	uint64_t *pte, *ptes[XLAT_LAST_LEVEL + 1];
-	uint64_t level_size;
+	uint64_t level_size, phys;
 	uint64_t *table = ptables->base_xlat_table;
 	unsigned int level = BASE_XLAT_LEVEL;
 	int ret = 0;
@@ -250,7 +250,15 @@ static int set_mapping(struct arm_mmu_ptables *ptables,
 
 		level_size = 1ULL << LEVEL_TO_VA_SIZE_SHIFT(level);
 
-		if (is_desc_superset(*pte, desc, level)) {
+		/* A block maps virtual and physical addresses with the same
+		 * offset into it, so both must agree for the block to be
+		 * reused, and both be aligned for a new one to be created.
+		 * Unmapping (desc == 0) only depends on the virtual address.
+		 */
+		phys = desc ? (desc & GENMASK(47, PAGE_SIZE_SHIFT)) : virt;
+
+		if (((virt ^ phys) & (level_size - 1)) == 0 &&
+		    is_desc_superset(*pte, desc, level)) {
 			/* This block already covers our range */
 			level_size -= (virt & (level_size - 1));
 			if (level_size > size) {
@@ -259,7 +267,7 @@ static int set_mapping(struct arm_mmu_ptables *ptables,
 			goto move_on;
 		}
 
-		if ((size < level_size) || (virt & (level_size - 1))) {
+		if ((size < level_size) || ((virt | phys) & (level_size - 1))) {
 			/* Range doesn't fit, create subtable */
 			table = expand_to_table(pte, level);
 			if (!table) {
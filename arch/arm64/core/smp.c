@@ -177,6 +177,14 @@ void arch_sched_ipi(void)
 	broadcast_ipi(SGI_SCHED_IPI);
 }
 
+void arch_sched_directed_ipi(uint32_t cpu_bitmap)
+{
+	const uint64_t mpidr = GET_MPIDR();
+
+	/* Same single cluster assumption as broadcast_ipi() */
+	gic_raise_sgi(SGI_SCHED_IPI, mpidr, cpu_bitmap & SGIR_TGT_MASK);
+}
+
 #ifdef CONFIG_USERSPACE
 void ptable_ipi_handler(const void *unused)
 {
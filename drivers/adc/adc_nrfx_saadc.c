@@ -18,6 +18,22 @@ struct driver_data {
 	struct adc_context ctx;
 
 	uint8_t positive_inputs[SAADC_CH_NUM];
+
+#ifdef CONFIG_ADC_CONTINUOUS
+	adc_continuous_callback_t cont_callback;
+	void *cont_user_data;
+	size_t cont_size;
+	/* Buffer being filled. */
+	void *cont_cur;
+	/* Buffer set for the next START. */
+	void *cont_next;
+	/* Buffer handed back, not set yet. */
+	void *cont_free;
+	uint32_t cont_overruns;
+	/* STARTED occurred since the last START. */
+	bool cont_started;
+	bool cont_running;
+#endif
 };
 
 static struct driver_data m_data = {
@@ -253,8 +269,8 @@ static int check_buffer_size(const struct adc_sequence *sequence,
 	return 0;
 }
 
-static int start_read(const struct device *dev,
-		      const struct adc_sequence *sequence)
+static int sequence_setup(const struct adc_sequence *sequence,
+			  uint8_t *channel_cnt)
 {
 	int error;
 	uint32_t selected_channels = sequence->channels;
@@ -322,6 +338,22 @@ static int start_read(const struct device *dev,
 		return error;
 	}
 
+	*channel_cnt = active_channels;
+
+	return 0;
+}
+
+static int start_read(const struct device *dev,
+		      const struct adc_sequence *sequence)
+{
+	int error;
+	uint8_t active_channels;
+
+	error = sequence_setup(sequence, &active_channels);
+	if (error) {
+		return error;
+	}
+
 	error = check_buffer_size(sequence, active_channels);
 	if (error) {
 		return error;
@@ -366,8 +398,197 @@ static int adc_nrfx_read_async(const struct device *dev,
 }
 #endif /* CONFIG_ADC_ASYNC */
 
+#ifdef CONFIG_ADC_CONTINUOUS
+/* The buffer pointer is double buffered by the hardware, it can be set for
+ * the next START once the STARTED event of the current one occurred.
+ */
+static void continuous_next_set(void *buffer)
+{
+	nrf_saadc_buffer_pointer_set(NRF_SAADC, buffer);
+	m_data.cont_next = buffer;
+	m_data.cont_free = NULL;
+}
+
+static void continuous_on_started(void)
+{
+	m_data.cont_started = true;
+
+	if (m_data.cont_free != NULL) {
+		continuous_next_set(m_data.cont_free);
+	}
+}
+
+static void continuous_on_end(const struct device *dev)
+{
+	void *full = m_data.cont_cur;
+
+	/* The internal timer keeps triggering samplings, restart the
+	 * transfer right away to lose as few of them as possible. Without
+	 * a buffer handed back, the current one is filled again.
+	 */
+	m_data.cont_started = false;
+	nrf_saadc_task_trigger(NRF_SAADC, NRF_SAADC_TASK_START);
+
+	if (m_data.cont_next == NULL) {
+		m_data.cont_overruns++;
+		return;
+	}
+
+	m_data.cont_cur = m_data.cont_next;
+	m_data.cont_next = NULL;
+
+	m_data.cont_callback(dev, full, m_data.cont_size,
+			     m_data.cont_overruns, m_data.cont_user_data);
+	m_data.cont_overruns = 0;
+}
+
+/* Implementation of the ADC driver API function: adc_continuous_start. */
+static int adc_nrfx_continuous_start(const struct device *dev,
+				     const struct adc_continuous_cfg *cfg)
+{
+	uint8_t active_channels;
+	uint32_t cc;
+	int error;
+
+	if (cfg->sequence == NULL || cfg->callback == NULL ||
+	    cfg->buffers[0] == NULL ||
+	    cfg->buffers[1] == NULL || cfg->buffer_size == 0 ||
+	    (cfg->buffer_size % sizeof(nrf_saadc_value_t)) != 0 ||
+	    cfg->sample_rate == 0) {
+		return -EINVAL;
+	}
+
+	/* The sample rate timer of the SAADC runs at 16 MHz, with a capture
+	 * compare value from 80 to 2047.
+	 */
+	cc = 16000000 / cfg->sample_rate;
+	if (cc < 80 || cc > 2047) {
+		LOG_ERR("Sample rate %u Hz is not valid", cfg->sample_rate);
+		return -EINVAL;
+	}
+
+	if (k_sem_take(&m_data.ctx.lock, K_NO_WAIT) != 0) {
+		return -EBUSY;
+	}
+
+	error = sequence_setup(cfg->sequence, &active_channels);
+	if (error == 0 && active_channels > 1) {
+		/* Paced by the internal timer, only one channel can be
+		 * sampled.
+		 */
+		LOG_ERR("Continuous sampling of a single channel only");
+		error = -ENOTSUP;
+	}
+
+	if (error) {
+		k_sem_give(&m_data.ctx.lock);
+		return error;
+	}
+
+	m_data.cont_callback = cfg->callback;
+	m_data.cont_user_data = cfg->user_data;
+	m_data.cont_size = cfg->buffer_size;
+	m_data.cont_cur = cfg->buffers[0];
+	m_data.cont_next = NULL;
+	m_data.cont_free = cfg->buffers[1];
+	m_data.cont_overruns = 0;
+	m_data.cont_started = false;
+	m_data.cont_running = true;
+
+	nrf_saadc_buffer_init(NRF_SAADC, cfg->buffers[0],
+			      cfg->buffer_size / sizeof(nrf_saadc_value_t));
+	nrf_saadc_continuous_mode_enable(NRF_SAADC, cc);
+	nrf_saadc_event_clear(NRF_SAADC, NRF_SAADC_EVENT_STARTED);
+	nrf_saadc_int_enable(NRF_SAADC, NRF_SAADC_INT_STARTED);
+
+	nrf_saadc_enable(NRF_SAADC);
+	nrf_saadc_task_trigger(NRF_SAADC, NRF_SAADC_TASK_START);
+	/* Starts the internal timer. */
+	nrf_saadc_task_trigger(NRF_SAADC, NRF_SAADC_TASK_SAMPLE);
+
+	return 0;
+}
+
+/* Implementation of the ADC driver API function: adc_continuous_stop. */
+static int adc_nrfx_continuous_stop(const struct device *dev)
+{
+	unsigned int key;
+
+	key = irq_lock();
+
+	if (!m_data.cont_running) {
+		irq_unlock(key);
+		return -EALREADY;
+	}
+
+	m_data.cont_running = false;
+	nrf_saadc_int_disable(NRF_SAADC,
+			      NRF_SAADC_INT_END | NRF_SAADC_INT_STARTED);
+
+	irq_unlock(key);
+
+	nrf_saadc_continuous_mode_disable(NRF_SAADC);
+	nrf_saadc_event_clear(NRF_SAADC, NRF_SAADC_EVENT_STOPPED);
+	nrf_saadc_task_trigger(NRF_SAADC, NRF_SAADC_TASK_STOP);
+	while (!nrf_saadc_event_check(NRF_SAADC, NRF_SAADC_EVENT_STOPPED)) {
+	}
+	nrf_saadc_disable(NRF_SAADC);
+
+	nrf_saadc_event_clear(NRF_SAADC, NRF_SAADC_EVENT_STOPPED);
+	nrf_saadc_event_clear(NRF_SAADC, NRF_SAADC_EVENT_STARTED);
+	nrf_saadc_event_clear(NRF_SAADC, NRF_SAADC_EVENT_END);
+	nrf_saadc_int_enable(NRF_SAADC, NRF_SAADC_INT_END);
+
+	k_sem_give(&m_data.ctx.lock);
+
+	return 0;
+}
+
+/* Implementation of the ADC driver API function: adc_continuous_release. */
+static int adc_nrfx_continuous_release(const struct device *dev,
+				       void *buffer)
+{
+	unsigned int key;
+	int error = 0;
+
+	key = irq_lock();
+
+	if (!m_data.cont_running || buffer == NULL ||
+	    buffer == m_data.cont_cur || buffer == m_data.cont_next ||
+	    m_data.cont_free != NULL) {
+		error = -EINVAL;
+	} else if (m_data.cont_started && m_data.cont_next == NULL) {
+		continuous_next_set(buffer);
+	} else {
+		m_data.cont_free = buffer;
+	}
+
+	irq_unlock(key);
+
+	return error;
+}
+#endif /* CONFIG_ADC_CONTINUOUS */
+
 static void saadc_irq_handler(const struct device *dev)
 {
+#ifdef CONFIG_ADC_CONTINUOUS
+	if (m_data.cont_running) {
+		if (nrf_saadc_event_check(NRF_SAADC, NRF_SAADC_EVENT_END)) {
+			nrf_saadc_event_clear(NRF_SAADC, NRF_SAADC_EVENT_END);
+			continuous_on_end(dev);
+		}
+
+		if (nrf_saadc_event_check(NRF_SAADC,
+					  NRF_SAADC_EVENT_STARTED)) {
+			nrf_saadc_event_clear(NRF_SAADC,
+					      NRF_SAADC_EVENT_STARTED);
+			continuous_on_started();
+		}
+
+		return;
+	}
+#endif /* CONFIG_ADC_CONTINUOUS */
+
 	if (nrf_saadc_event_check(NRF_SAADC, NRF_SAADC_EVENT_END)) {
 		nrf_saadc_event_clear(NRF_SAADC, NRF_SAADC_EVENT_END);
 
@@ -411,6 +632,11 @@ static const struct adc_driver_api adc_nrfx_driver_api = {
 	.read          = adc_nrfx_read,
 #ifdef CONFIG_ADC_ASYNC
 	.read_async    = adc_nrfx_read_async,
+#endif
+#ifdef CONFIG_ADC_CONTINUOUS
+	.continuous_start   = adc_nrfx_continuous_start,
+	.continuous_stop    = adc_nrfx_continuous_stop,
+	.continuous_release = adc_nrfx_continuous_release,
 #endif
 	.ref_internal  = 600,
 };
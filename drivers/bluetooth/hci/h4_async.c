@@ -0,0 +1,696 @@
+/* h4_async.c - H:4 UART based Bluetooth driver using the async UART API */
+
+/*
+ * Copyright (c) 2015-2016 Intel Corporation
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stddef.h>
+
+#include <zephyr.h>
+#include <arch/cpu.h>
+
+#include <init.h>
+#include <drivers/uart.h>
+#include <sys/util.h>
+#include <sys/byteorder.h>
+#include <string.h>
+
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/hci.h>
+#include <drivers/bluetooth/hci_driver.h>
+
+#define BT_DBG_ENABLED IS_ENABLED(CONFIG_BT_DEBUG_HCI_DRIVER)
+#define LOG_MODULE_NAME bt_driver
+#include "common/log.h"
+
+#include "../util.h"
+
+#define H4_NONE 0x00
+#define H4_CMD  0x01
+#define H4_ACL  0x02
+#define H4_SCO  0x03
+#define H4_EVT  0x04
+#define H4_ISO  0x05
+
+#define RX_BUF_COUNT CONFIG_BT_H4_ASYNC_RX_BUF_COUNT
+#define RX_BUF_SIZE  CONFIG_BT_H4_ASYNC_RX_BUF_SIZE
+
+static K_KERNEL_STACK_DEFINE(rx_thread_stack, CONFIG_BT_RX_STACK_SIZE);
+static struct k_thread rx_thread_data;
+
+static K_SEM_DEFINE(rx_stall_sem, 0, 1);
+
+/* Reception is done by the UART driver into a ring of DMA buffers. The
+ * buffers are handed to the driver in order and parsed in the same order,
+ * straight from the UART callback, so that HCI packets are found without
+ * any intermediate copy. A buffer is given back to the driver once it has
+ * been released by the driver and all of its data has been parsed.
+ *
+ * When no HCI buffer can be allocated for a packet which must not be
+ * dropped, parsing stalls and the RX thread waits for a buffer. The DMA
+ * buffers received in the meantime are kept until parsing resumes, and
+ * reception is paused by the driver (and the flow control lines) once
+ * they have all been used.
+ */
+static struct {
+	struct k_spinlock lock;
+
+	uint8_t  dma[RX_BUF_COUNT][RX_BUF_SIZE];
+	uint16_t dma_len[RX_BUF_COUNT];
+	uint8_t  dma_released;
+	uint8_t  dma_head;
+	uint8_t  dma_tail;
+	uint8_t  dma_used;
+	uint16_t dma_offset;
+
+	bool     enabled;
+	bool     buf_requested;
+	bool     stalled;
+
+	struct net_buf *buf;
+	struct k_fifo   fifo;
+
+	uint16_t    remaining;
+	uint16_t    discard;
+
+	bool     have_hdr;
+	bool     discardable;
+
+	uint8_t     hdr_len;
+
+	uint8_t     type;
+	union {
+		struct bt_hci_evt_hdr evt;
+		struct bt_hci_acl_hdr acl;
+		struct bt_hci_iso_hdr iso;
+		uint8_t hdr[4];
+	};
+} rx = {
+	.fifo = Z_FIFO_INITIALIZER(rx.fifo),
+};
+
+/* Transmission gathers as many queued HCI packets as fit into a single
+ * buffer and sends them with one UART transfer. Packets larger than the
+ * buffer are sent over several transfers.
+ */
+static struct {
+	struct k_spinlock lock;
+	struct net_buf *buf;
+	struct k_fifo   fifo;
+	bool     type_sent;
+	bool     busy;
+	uint8_t  data[CONFIG_BT_H4_ASYNC_TX_BUF_SIZE];
+} tx = {
+	.fifo = Z_FIFO_INITIALIZER(tx.fifo),
+};
+
+static const struct device *h4_dev;
+
+static void h4_set_type(uint8_t type)
+{
+	rx.type = type;
+
+	switch (rx.type) {
+	case H4_EVT:
+		rx.remaining = sizeof(rx.evt);
+		rx.hdr_len = rx.remaining;
+		break;
+	case H4_ACL:
+		rx.remaining = sizeof(rx.acl);
+		rx.hdr_len = rx.remaining;
+		break;
+	case H4_ISO:
+		if (IS_ENABLED(CONFIG_BT_ISO)) {
+			rx.remaining = sizeof(rx.iso);
+			rx.hdr_len = rx.remaining;
+			break;
+		}
+		__fallthrough;
+	default:
+		BT_ERR("Unknown H:4 type 0x%02x", rx.type);
+		rx.type = H4_NONE;
+	}
+}
+
+static void check_evt_hdr(void)
+{
+	struct bt_hci_evt_hdr *hdr = &rx.evt;
+
+	if (rx.hdr_len == sizeof(*hdr) && rx.remaining < sizeof(*hdr)) {
+		switch (rx.evt.evt) {
+		case BT_HCI_EVT_LE_META_EVENT:
+			rx.remaining++;
+			rx.hdr_len++;
+			break;
+#if defined(CONFIG_BT_BREDR)
+		case BT_HCI_EVT_INQUIRY_RESULT_WITH_RSSI:
+		case BT_HCI_EVT_EXTENDED_INQUIRY_RESULT:
+			rx.discardable = true;
+			break;
+#endif
+		}
+	}
+
+	if (!rx.remaining) {
+		if (rx.evt.evt == BT_HCI_EVT_LE_META_EVENT &&
+		    (rx.hdr[sizeof(*hdr)] == BT_HCI_EVT_LE_ADVERTISING_REPORT ||
+		     rx.hdr[sizeof(*hdr)] == BT_HCI_EVT_LE_EXT_ADVERTISING_REPORT)) {
+			BT_DBG("Marking adv report as discardable");
+			rx.discardable = true;
+		}
+
+		rx.remaining = hdr->len - (rx.hdr_len - sizeof(*hdr));
+		BT_DBG("Got event header. Payload %u bytes", hdr->len);
+		rx.have_hdr = true;
+	}
+}
+
+static void check_hdr(void)
+{
+	switch (rx.type) {
+	case H4_EVT:
+		check_evt_hdr();
+		break;
+	case H4_ACL:
+		if (!rx.remaining) {
+			rx.remaining = sys_le16_to_cpu(rx.acl.len);
+			BT_DBG("Got ACL header. Payload %u bytes", rx.remaining);
+			rx.have_hdr = true;
+		}
+		break;
+	case H4_ISO:
+		if (!rx.remaining) {
+			rx.remaining = sys_le16_to_cpu(rx.iso.len);
+			BT_DBG("Got ISO header. Payload %u bytes", rx.remaining);
+			rx.have_hdr = true;
+		}
+		break;
+	default:
+		CODE_UNREACHABLE;
+	}
+}
+
+static void reset_rx(void)
+{
+	rx.type = H4_NONE;
+	rx.remaining = 0U;
+	rx.have_hdr = false;
+	rx.hdr_len = 0U;
+	rx.discardable = false;
+}
+
+static struct net_buf *get_rx(k_timeout_t timeout)
+{
+	BT_DBG("type 0x%02x, evt 0x%02x", rx.type, rx.evt.evt);
+
+	switch (rx.type) {
+	case H4_EVT:
+		return bt_buf_get_evt(rx.evt.evt, rx.discardable, timeout);
+	case H4_ACL:
+		return bt_buf_get_rx(BT_BUF_ACL_IN, timeout);
+	case H4_ISO:
+		if (IS_ENABLED(CONFIG_BT_ISO)) {
+			return bt_buf_get_rx(BT_BUF_ISO_IN, timeout);
+		}
+	}
+
+	return NULL;
+}
+
+/* Takes ownership of a freshly allocated buffer for the current packet */
+static void set_rx_buf(struct net_buf *buf)
+{
+	if (rx.remaining > net_buf_tailroom(buf)) {
+		BT_ERR("Not enough space in buffer");
+		net_buf_unref(buf);
+		rx.discard = rx.remaining;
+		reset_rx();
+		return;
+	}
+
+	rx.buf = buf;
+	net_buf_add_mem(rx.buf, rx.hdr, rx.hdr_len);
+}
+
+static void alloc_rx_buf(void)
+{
+	struct net_buf *buf;
+
+	buf = get_rx(K_NO_WAIT);
+	if (buf) {
+		BT_DBG("Allocated rx.buf %p", buf);
+		set_rx_buf(buf);
+		return;
+	}
+
+	if (rx.discardable) {
+		BT_WARN("Discarding event 0x%02x", rx.evt.evt);
+		rx.discard = rx.remaining;
+		reset_rx();
+		return;
+	}
+
+	BT_WARN("Failed to allocate, deferring to rx_thread");
+	rx.stalled = true;
+	k_sem_give(&rx_stall_sem);
+}
+
+static void rx_complete(void)
+{
+	struct net_buf *buf = rx.buf;
+	uint8_t evt_flags;
+
+	rx.buf = NULL;
+
+	BT_DBG("Payload (len %u): %s", buf->len, bt_hex(buf->data, buf->len));
+
+	if (rx.type == H4_EVT) {
+		evt_flags = bt_hci_evt_get_flags(rx.evt.evt);
+		bt_buf_set_type(buf, BT_BUF_EVT);
+	} else if (rx.type == H4_ISO) {
+		evt_flags = BT_HCI_EVT_FLAG_RECV;
+		bt_buf_set_type(buf, BT_BUF_ISO_IN);
+	} else {
+		evt_flags = BT_HCI_EVT_FLAG_RECV;
+		bt_buf_set_type(buf, BT_BUF_ACL_IN);
+	}
+
+	reset_rx();
+
+	if (evt_flags & BT_HCI_EVT_FLAG_RECV_PRIO) {
+		BT_DBG("Calling bt_recv_prio(%p)", buf);
+		bt_recv_prio(buf);
+	}
+
+	if (evt_flags & BT_HCI_EVT_FLAG_RECV) {
+		BT_DBG("Putting buf %p to rx fifo", buf);
+		net_buf_put(&rx.fifo, buf);
+	}
+}
+
+/* Parses received bytes, returns how many of them have been consumed. Less
+ * than len is only returned when parsing has stalled.
+ */
+static size_t rx_parse(const uint8_t *data, size_t len)
+{
+	const uint8_t *p = data;
+	const uint8_t *end = data + len;
+	size_t bytes;
+
+	while (!rx.stalled) {
+		if (rx.discard) {
+			if (p == end) {
+				break;
+			}
+
+			bytes = MIN(rx.discard, end - p);
+			rx.discard -= bytes;
+			p += bytes;
+			continue;
+		}
+
+		if (rx.type == H4_NONE) {
+			if (p == end) {
+				break;
+			}
+
+			h4_set_type(*p++);
+			continue;
+		}
+
+		if (!rx.have_hdr) {
+			if (p == end) {
+				break;
+			}
+
+			bytes = MIN(rx.remaining, end - p);
+			memcpy(&rx.hdr[rx.hdr_len - rx.remaining], p, bytes);
+			rx.remaining -= bytes;
+			p += bytes;
+			check_hdr();
+			continue;
+		}
+
+		if (!rx.buf) {
+			alloc_rx_buf();
+			continue;
+		}
+
+		bytes = MIN(rx.remaining, end - p);
+		net_buf_add_mem(rx.buf, p, bytes);
+		rx.remaining -= bytes;
+		p += bytes;
+
+		if (rx.remaining) {
+			break;
+		}
+
+		rx_complete();
+	}
+
+	return p - data;
+}
+
+static void rx_buf_provide(void)
+{
+	uint8_t idx = rx.dma_head;
+	int err;
+
+	rx.dma_len[idx] = 0U;
+	rx.dma_released &= ~BIT(idx);
+	rx.dma_head = (idx + 1) % RX_BUF_COUNT;
+	rx.dma_used++;
+
+	if (!rx.enabled) {
+		err = uart_rx_enable(h4_dev, rx.dma[idx], RX_BUF_SIZE,
+				     CONFIG_BT_H4_ASYNC_RX_TIMEOUT);
+		rx.enabled = !err;
+	} else {
+		rx.buf_requested = false;
+		err = uart_rx_buf_rsp(h4_dev, rx.dma[idx], RX_BUF_SIZE);
+	}
+
+	if (err) {
+		BT_ERR("Unable to provide RX buffer (err %d)", err);
+		rx.dma_head = idx;
+		rx.dma_used--;
+	}
+}
+
+/* Must be called with rx.lock held */
+static void rx_process(void)
+{
+	while (rx.dma_used && !rx.stalled) {
+		uint8_t idx = rx.dma_tail;
+
+		if (rx.dma_offset < rx.dma_len[idx]) {
+			rx.dma_offset += rx_parse(&rx.dma[idx][rx.dma_offset],
+						  rx.dma_len[idx] -
+						  rx.dma_offset);
+		}
+
+		if (rx.dma_offset < rx.dma_len[idx] ||
+		    !(rx.dma_released & BIT(idx))) {
+			break;
+		}
+
+		rx.dma_tail = (idx + 1) % RX_BUF_COUNT;
+		rx.dma_offset = 0U;
+		rx.dma_used--;
+	}
+
+	if (rx.dma_used < RX_BUF_COUNT &&
+	    (!rx.enabled || rx.buf_requested)) {
+		rx_buf_provide();
+	}
+}
+
+static uint8_t rx_buf_idx(const uint8_t *buf)
+{
+	return (buf - rx.dma[0]) / RX_BUF_SIZE;
+}
+
+static void rx_resume(void)
+{
+	struct net_buf *buf;
+	k_spinlock_key_t key;
+
+	/* The packet header cannot change while parsing is stalled */
+	buf = get_rx(K_FOREVER);
+	BT_DBG("Got rx.buf %p", buf);
+
+	key = k_spin_lock(&rx.lock);
+	rx.stalled = false;
+	set_rx_buf(buf);
+	rx_process();
+	k_spin_unlock(&rx.lock, key);
+}
+
+static void rx_thread(void *p1, void *p2, void *p3)
+{
+	struct k_poll_event events[] = {
+		K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_SEM_AVAILABLE,
+					 K_POLL_MODE_NOTIFY_ONLY,
+					 &rx_stall_sem),
+		K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+					 K_POLL_MODE_NOTIFY_ONLY,
+					 &rx.fifo),
+	};
+	struct net_buf *buf;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	BT_DBG("started");
+
+	while (1) {
+		events[0].state = K_POLL_STATE_NOT_READY;
+		events[1].state = K_POLL_STATE_NOT_READY;
+		k_poll(events, ARRAY_SIZE(events), K_FOREVER);
+
+		if (!k_sem_take(&rx_stall_sem, K_NO_WAIT)) {
+			rx_resume();
+		}
+
+		buf = net_buf_get(&rx.fifo, K_NO_WAIT);
+		if (buf) {
+			BT_DBG("Calling bt_recv(%p)", buf);
+			bt_recv(buf);
+
+			/* Give other threads a chance to run if the UART
+			 * is receiving data so fast that rx.fifo never
+			 * or very rarely goes empty.
+			 */
+			k_yield();
+		}
+	}
+}
+
+static uint8_t h4_get_tx_type(struct net_buf *buf)
+{
+	switch (bt_buf_get_type(buf)) {
+	case BT_BUF_ACL_OUT:
+		return H4_ACL;
+	case BT_BUF_CMD:
+		return H4_CMD;
+	case BT_BUF_ISO_OUT:
+		if (IS_ENABLED(CONFIG_BT_ISO)) {
+			return H4_ISO;
+		}
+		__fallthrough;
+	default:
+		return H4_NONE;
+	}
+}
+
+/* Must be called with tx.lock held */
+static void tx_process(void)
+{
+	size_t len = 0;
+	size_t bytes;
+	int err;
+
+	if (tx.busy) {
+		return;
+	}
+
+	while (len < sizeof(tx.data)) {
+		if (!tx.buf) {
+			tx.buf = net_buf_get(&tx.fifo, K_NO_WAIT);
+			if (!tx.buf) {
+				break;
+			}
+
+			tx.type_sent = false;
+		}
+
+		if (!tx.type_sent) {
+			tx.data[len] = h4_get_tx_type(tx.buf);
+			if (tx.data[len] == H4_NONE) {
+				BT_ERR("Unknown buffer type");
+				net_buf_unref(tx.buf);
+				tx.buf = NULL;
+				continue;
+			}
+
+			tx.type_sent = true;
+			len++;
+		}
+
+		bytes = MIN(sizeof(tx.data) - len, tx.buf->len);
+		memcpy(&tx.data[len], tx.buf->data, bytes);
+		net_buf_pull(tx.buf, bytes);
+		len += bytes;
+
+		if (!tx.buf->len) {
+			net_buf_unref(tx.buf);
+			tx.buf = NULL;
+		}
+	}
+
+	if (!len) {
+		return;
+	}
+
+	err = uart_tx(h4_dev, tx.data, len, SYS_FOREVER_MS);
+	if (err) {
+		BT_ERR("Unable to send %zu bytes (err %d)", len, err);
+		return;
+	}
+
+	tx.busy = true;
+}
+
+static void bt_uart_callback(const struct device *dev, struct uart_event *evt,
+			     void *user_data)
+{
+	k_spinlock_key_t key;
+	uint8_t idx;
+
+	ARG_UNUSED(dev);
+	ARG_UNUSED(user_data);
+
+	switch (evt->type) {
+	case UART_TX_ABORTED:
+		BT_ERR("TX aborted, %zu bytes sent", evt->data.tx.len);
+		__fallthrough;
+	case UART_TX_DONE:
+		key = k_spin_lock(&tx.lock);
+		tx.busy = false;
+		tx_process();
+		k_spin_unlock(&tx.lock, key);
+		break;
+
+	case UART_RX_RDY:
+		BT_DBG("RX %zu bytes at offset %zu", evt->data.rx.len,
+		       evt->data.rx.offset);
+
+		key = k_spin_lock(&rx.lock);
+		idx = rx_buf_idx(evt->data.rx.buf);
+		rx.dma_len[idx] = evt->data.rx.offset + evt->data.rx.len;
+		rx_process();
+		k_spin_unlock(&rx.lock, key);
+		break;
+
+	case UART_RX_BUF_REQUEST:
+		key = k_spin_lock(&rx.lock);
+		rx.buf_requested = true;
+		rx_process();
+		k_spin_unlock(&rx.lock, key);
+		break;
+
+	case UART_RX_BUF_RELEASED:
+		key = k_spin_lock(&rx.lock);
+		idx = rx_buf_idx(evt->data.rx_buf.buf);
+		rx.dma_released |= BIT(idx);
+		rx_process();
+		k_spin_unlock(&rx.lock, key);
+		break;
+
+	case UART_RX_STOPPED:
+		BT_ERR("RX stopped (reason %d)", evt->data.rx_stop.reason);
+		break;
+
+	case UART_RX_DISABLED:
+		/* Reception is disabled after an error or when the driver
+		 * ran out of buffers, start it again.
+		 */
+		key = k_spin_lock(&rx.lock);
+		rx.enabled = false;
+		rx.buf_requested = false;
+		rx_process();
+		k_spin_unlock(&rx.lock, key);
+		break;
+
+	default:
+		break;
+	}
+}
+
+static int h4_send(struct net_buf *buf)
+{
+	k_spinlock_key_t key;
+
+	BT_DBG("buf %p type %u len %u", buf, bt_buf_get_type(buf), buf->len);
+
+	net_buf_put(&tx.fifo, buf);
+
+	key = k_spin_lock(&tx.lock);
+	tx_process();
+	k_spin_unlock(&tx.lock, key);
+
+	return 0;
+}
+
+/** Setup the HCI transport, which usually means to reset the Bluetooth IC
+  *
+  * @param dev The device structure for the bus connecting to the IC
+  *
+  * @return 0 on success, negative error value on failure
+  */
+int __weak bt_hci_transport_setup(const struct device *dev)
+{
+	return 0;
+}
+
+static int h4_open(void)
+{
+	k_spinlock_key_t key;
+	k_tid_t tid;
+	int ret;
+
+	BT_DBG("");
+
+	ret = bt_hci_transport_setup(h4_dev);
+	if (ret < 0) {
+		return -EIO;
+	}
+
+	ret = uart_callback_set(h4_dev, bt_uart_callback, NULL);
+	if (ret < 0) {
+		BT_ERR("Async UART API not supported (err %d)", ret);
+		return ret;
+	}
+
+	tid = k_thread_create(&rx_thread_data, rx_thread_stack,
+			      K_KERNEL_STACK_SIZEOF(rx_thread_stack),
+			      rx_thread, NULL, NULL, NULL,
+			      K_PRIO_COOP(CONFIG_BT_RX_PRIO),
+			      0, K_NO_WAIT);
+	k_thread_name_set(tid, "bt_rx_thread");
+
+	key = k_spin_lock(&rx.lock);
+	rx_process();
+	ret = rx.enabled ? 0 : -EIO;
+	k_spin_unlock(&rx.lock, key);
+
+	return ret;
+}
+
+static const struct bt_hci_driver drv = {
+	.name		= "H:4 async",
+	.bus		= BT_HCI_DRIVER_BUS_UART,
+	.open		= h4_open,
+	.send		= h4_send,
+};
+
+static int bt_uart_init(const struct device *unused)
+{
+	ARG_UNUSED(unused);
+
+	h4_dev = device_get_binding(CONFIG_BT_UART_ON_DEV_NAME);
+	if (!h4_dev) {
+		return -EINVAL;
+	}
+
+	bt_hci_driver_register(&drv);
+
+	return 0;
+}
+
+SYS_INIT(bt_uart_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE);
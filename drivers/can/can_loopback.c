@@ -41,39 +41,90 @@ static void dispatch_frame(const struct zcan_frame *frame,
 	filter->rx_cb(&frame_tmp, filter->cb_arg);
 }
 
+BUILD_ASSERT((CONFIG_CAN_LOOPBACK_FILTER_HASH_SIZE &
+	      (CONFIG_CAN_LOOPBACK_FILTER_HASH_SIZE - 1)) == 0,
+	     "CAN_LOOPBACK_FILTER_HASH_SIZE must be a power of two");
+
 static inline int check_filter_match(const struct zcan_frame *frame,
 				     const struct zcan_filter *filter)
 {
 	return ((filter->id & filter->id_mask) ==
-		(frame->id & filter->id_mask));
+		(frame->id & filter->id_mask)) &&
+	       filter->id_type == frame->id_type &&
+	       (!filter->rtr_mask || filter->rtr == frame->rtr);
+}
+
+static inline bool filter_is_exact(const struct zcan_filter *filter)
+{
+	return filter->id_mask == (filter->id_type == CAN_STANDARD_IDENTIFIER ?
+				   CAN_STD_ID_MASK : CAN_EXT_ID_MASK);
+}
+
+static inline uint32_t id_hash(uint32_t id)
+{
+	return (id ^ (id >> 11) ^ (id >> 22)) &
+	       (CONFIG_CAN_LOOPBACK_FILTER_HASH_SIZE - 1);
+}
+
+static sys_slist_t *filter_list(struct can_loopback_data *data,
+				const struct zcan_filter *filter)
+{
+	if (filter_is_exact(filter)) {
+		return &data->exact[id_hash(filter->id)];
+	}
+
+	return &data->masked;
+}
+
+static void dispatch_list(const struct zcan_frame *frame, sys_slist_t *list)
+{
+	struct can_loopback_filter *filter, *next;
+
+	/* A receiver may detach its filter */
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(list, filter, next, node) {
+		if (check_filter_match(frame, &filter->filter)) {
+			dispatch_frame(frame, filter);
+		}
+	}
 }
 
 void tx_thread(void *data_arg, void *arg2, void *arg3)
 {
 	ARG_UNUSED(arg2);
 	ARG_UNUSED(arg3);
-	struct can_looppback_frame frame;
-	struct can_loopback_filter *filter;
+	static struct can_looppback_frame frames[CONFIG_CAN_LOOPBACK_RX_BATCH];
 	struct can_loopback_data *data = (struct can_loopback_data *)data_arg;
+	struct can_looppback_frame *frame;
+	int count;
 
 	while (1) {
-		k_msgq_get(&tx_msgq, &frame, K_FOREVER);
-		k_mutex_lock(&data->mtx, K_FOREVER);
+		k_msgq_get(&tx_msgq, &frames[0], K_FOREVER);
 
-		for (int i = 0; i < CONFIG_CAN_MAX_FILTER; i++) {
-			filter = &data->filters[i];
-			if (filter->rx_cb &&
-			    check_filter_match(&frame.frame, &filter->filter)) {
-				dispatch_frame(&frame.frame, filter);
+		/* Deliver the frames queued meanwhile at once */
+		for (count = 1; count < ARRAY_SIZE(frames); count++) {
+			if (k_msgq_get(&tx_msgq, &frames[count], K_NO_WAIT)) {
+				break;
 			}
 		}
 
+		k_mutex_lock(&data->mtx, K_FOREVER);
+
+		for (int i = 0; i < count; i++) {
+			frame = &frames[i];
+			dispatch_list(&frame->frame,
+				      &data->exact[id_hash(frame->frame.id)]);
+			dispatch_list(&frame->frame, &data->masked);
+		}
+
 		k_mutex_unlock(&data->mtx);
 
-		if (!frame.cb) {
-			k_sem_give(frame.tx_compl);
-		} else {
-			frame.cb(CAN_TX_OK, frame.cb_arg);
+		for (int i = 0; i < count; i++) {
+			frame = &frames[i];
+			if (!frame->cb) {
+				k_sem_give(frame->tx_compl);
+			} else {
+				frame->cb(CAN_TX_OK, frame->cb_arg);
+			}
 		}
 	}
 }
@@ -94,6 +145,15 @@ int can_loopback_send(const struct device *dev,
 				  "standard" : "extended",
 		frame->rtr == CAN_DATAFRAME ? "" : ", RTR frame");
 
+#ifdef CONFIG_CAN_FD_MODE
+	if (frame->fd) {
+		if (frame->dlc > CANFD_MAX_DLC) {
+			LOG_ERR("DLC of %d exceeds maximum (%d)", frame->dlc,
+				CANFD_MAX_DLC);
+			return CAN_TX_EINVAL;
+		}
+	} else
+#endif
 	if (frame->dlc > CAN_MAX_DLC) {
 		LOG_ERR("DLC of %d exceeds maximum (%d)", frame->dlc, CAN_MAX_DLC);
 		return CAN_TX_EINVAL;
@@ -164,6 +224,7 @@ int can_loopback_attach_isr(const struct device *dev, can_rx_callback_t isr,
 	loopback_filter->rx_cb = isr;
 	loopback_filter->cb_arg = cb_arg;
 	loopback_filter->filter = *filter;
+	sys_slist_append(filter_list(data, filter), &loopback_filter->node);
 	k_mutex_unlock(&data->mtx);
 
 	LOG_DBG("Filter attached. ID: %d", filter_id);
@@ -174,10 +235,15 @@ int can_loopback_attach_isr(const struct device *dev, can_rx_callback_t isr,
 void can_loopback_detach(const struct device *dev, int filter_id)
 {
 	struct can_loopback_data *data = DEV_DATA(dev);
+	struct can_loopback_filter *filter = &data->filters[filter_id];
 
 	LOG_DBG("Detach filter ID: %d", filter_id);
 	k_mutex_lock(&data->mtx, K_FOREVER);
-	data->filters[filter_id].rx_cb = NULL;
+	if (filter->rx_cb) {
+		sys_slist_find_and_remove(filter_list(data, &filter->filter),
+					  &filter->node);
+		filter->rx_cb = NULL;
+	}
 	k_mutex_unlock(&data->mtx);
 }
 
@@ -275,6 +341,12 @@ static int can_loopback_init(const struct device *dev)
 		data->filters[i].rx_cb = NULL;
 	}
 
+	for (int i = 0; i < ARRAY_SIZE(data->exact); i++) {
+		sys_slist_init(&data->exact[i]);
+	}
+
+	sys_slist_init(&data->masked);
+
 	tx_tid = k_thread_create(&tx_thread_data, tx_thread_stack,
 				 K_KERNEL_STACK_SIZEOF(tx_thread_stack),
 				 tx_thread, data, NULL, NULL,
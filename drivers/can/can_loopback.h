@@ -9,6 +9,7 @@
 #define ZEPHYR_DRIVERS_CAN_LOOPBACK_CAN_H_
 
 #include <drivers/can.h>
+#include <sys/slist.h>
 
 #define DEV_DATA(dev) ((struct can_loopback_data *const)(dev)->data)
 #define DEV_CFG(dev) \
@@ -18,10 +19,15 @@ struct can_loopback_filter {
 	can_rx_callback_t rx_cb;
 	void *cb_arg;
 	struct zcan_filter filter;
+	sys_snode_t node;
 };
 
 struct can_loopback_data {
 	struct can_loopback_filter filters[CONFIG_CAN_MAX_FILTER];
+	/* Filters matching a single ID, by hash of the ID */
+	sys_slist_t exact[CONFIG_CAN_LOOPBACK_FILTER_HASH_SIZE];
+	/* Filters with a partial ID mask */
+	sys_slist_t masked;
 	struct k_mutex mtx;
 	bool loopback;
 };
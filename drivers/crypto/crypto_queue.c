@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ *  @brief Crypto request queue and session pool
+ */
+
+#include <kernel.h>
+#include <string.h>
+#include <crypto/cipher_queue.h>
+
+#define LOG_LEVEL CONFIG_CRYPTO_LOG_LEVEL
+#include <logging/log.h>
+LOG_MODULE_REGISTER(crypto_queue);
+
+#define KEY_MAX_LEN 32
+
+static K_FIFO_DEFINE(req_fifo);
+
+struct session_entry {
+	struct cipher_ctx ctx;
+	uint8_t key[KEY_MAX_LEN];
+	enum cipher_algo algo;
+	enum cipher_op optype;
+	/* Use counter value at the last release, for the eviction. */
+	uint32_t last_use;
+	uint16_t holders;
+	bool open;
+};
+
+static struct session_entry sessions[CONFIG_CRYPTO_QUEUE_SESSIONS];
+static uint32_t use_count;
+static K_MUTEX_DEFINE(sessions_lock);
+
+static int req_check(const struct cipher_req *req)
+{
+	if (req->ctx == NULL) {
+		return -EINVAL;
+	}
+
+	/* The queue thread runs the operations of the session */
+	if ((req->ctx->flags & CAP_SYNC_OPS) == 0U) {
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
+int cipher_req_submit(struct cipher_req *req)
+{
+	int ret = req_check(req);
+
+	if (ret != 0) {
+		return ret;
+	}
+
+	k_fifo_put(&req_fifo, req);
+
+	return 0;
+}
+
+int cipher_req_submit_list(sys_slist_t *list)
+{
+	struct cipher_req *req;
+	int ret;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(list, req, node) {
+		ret = req_check(req);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	if (!sys_slist_is_empty(list)) {
+		k_fifo_put_slist(&req_fifo, list);
+	}
+
+	return 0;
+}
+
+static void req_process(struct cipher_req *req)
+{
+	struct k_poll_signal *signal = req->signal;
+	cipher_req_cb cb = req->cb;
+	struct cipher_ctx *ctx = req->ctx;
+	int ret;
+
+	switch (ctx->ops.cipher_mode) {
+	case CRYPTO_CIPHER_MODE_ECB:
+		ret = cipher_block_op(ctx, req->pkt);
+		break;
+	case CRYPTO_CIPHER_MODE_CBC:
+		ret = cipher_cbc_op(ctx, req->pkt, req->iv);
+		break;
+	case CRYPTO_CIPHER_MODE_CTR:
+		ret = cipher_ctr_op(ctx, req->pkt, req->iv);
+		break;
+	case CRYPTO_CIPHER_MODE_CCM:
+		ret = cipher_ccm_op(ctx, req->aead_pkt, req->iv);
+		break;
+	case CRYPTO_CIPHER_MODE_GCM:
+		ret = cipher_gcm_op(ctx, req->aead_pkt, req->iv);
+		break;
+	default:
+		ret = -ENOTSUP;
+		break;
+	}
+
+	req->status = ret;
+
+	/* The request may be reused as soon as one of them is notified */
+	if (signal != NULL) {
+		k_poll_signal_raise(signal, ret);
+	}
+
+	if (cb != NULL) {
+		cb(req, ret);
+	}
+}
+
+static void crypto_queue_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		req_process(k_fifo_get(&req_fifo, K_FOREVER));
+	}
+}
+
+K_THREAD_DEFINE(crypto_queue, CONFIG_CRYPTO_QUEUE_THREAD_STACK_SIZE,
+		crypto_queue_thread, NULL, NULL, NULL,
+		CONFIG_CRYPTO_QUEUE_THREAD_PRIORITY, 0, 0);
+
+static bool session_matches(const struct session_entry *entry,
+			    const struct device *dev,
+			    const struct cipher_ctx *params,
+			    enum cipher_algo algo, enum cipher_mode mode,
+			    enum cipher_op optype)
+{
+	const struct cipher_ctx *ctx = &entry->ctx;
+
+	if (!entry->open || ctx->device != dev || entry->algo != algo ||
+	    ctx->ops.cipher_mode != mode || entry->optype != optype ||
+	    ctx->flags != params->flags || ctx->keylen != params->keylen ||
+	    memcmp(entry->key, params->key.bit_stream, params->keylen) != 0) {
+		return false;
+	}
+
+	switch (mode) {
+	case CRYPTO_CIPHER_MODE_CTR:
+		return ctx->mode_params.ctr_info.ctr_len ==
+		       params->mode_params.ctr_info.ctr_len;
+	case CRYPTO_CIPHER_MODE_CCM:
+		return ctx->mode_params.ccm_info.tag_len ==
+		       params->mode_params.ccm_info.tag_len &&
+		       ctx->mode_params.ccm_info.nonce_len ==
+		       params->mode_params.ccm_info.nonce_len;
+	case CRYPTO_CIPHER_MODE_GCM:
+		return ctx->mode_params.gcm_info.tag_len ==
+		       params->mode_params.gcm_info.tag_len &&
+		       ctx->mode_params.gcm_info.nonce_len ==
+		       params->mode_params.gcm_info.nonce_len;
+	default:
+		return true;
+	}
+}
+
+/* A free entry, or else the least recently used session nobody holds. */
+static struct session_entry *session_entry_alloc(void)
+{
+	struct session_entry *lru = NULL;
+
+	for (size_t i = 0; i < ARRAY_SIZE(sessions); i++) {
+		struct session_entry *entry = &sessions[i];
+
+		if (!entry->open) {
+			return entry;
+		}
+
+		if (entry->holders == 0U &&
+		    (lru == NULL ||
+		     (int32_t)(entry->last_use - lru->last_use) < 0)) {
+			lru = entry;
+		}
+	}
+
+	if (lru != NULL) {
+		(void)cipher_free_session(lru->ctx.device, &lru->ctx);
+		lru->open = false;
+	}
+
+	return lru;
+}
+
+struct cipher_ctx *cipher_session_get(const struct device *dev,
+				      const struct cipher_ctx *params,
+				      enum cipher_algo algo,
+				      enum cipher_mode mode,
+				      enum cipher_op optype)
+{
+	struct session_entry *entry = NULL;
+	int ret;
+
+	if ((params->flags & CAP_RAW_KEY) == 0U ||
+	    (params->flags & CAP_SYNC_OPS) == 0U ||
+	    params->keylen > KEY_MAX_LEN) {
+		LOG_ERR("Unsupported session parameters");
+		return NULL;
+	}
+
+	k_mutex_lock(&sessions_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(sessions); i++) {
+		if (session_matches(&sessions[i], dev, params, algo, mode,
+				    optype)) {
+			entry = &sessions[i];
+			goto out;
+		}
+	}
+
+	entry = session_entry_alloc();
+	if (entry == NULL) {
+		LOG_WRN("All sessions are held");
+		goto out;
+	}
+
+	memcpy(entry->key, params->key.bit_stream, params->keylen);
+	entry->ctx = (struct cipher_ctx) {
+		.key.bit_stream = entry->key,
+		.keylen = params->keylen,
+		.flags = params->flags,
+		.mode_params = params->mode_params,
+	};
+	entry->algo = algo;
+	entry->optype = optype;
+
+	ret = cipher_begin_session(dev, &entry->ctx, algo, mode, optype);
+	if (ret != 0) {
+		LOG_ERR("Session setup failed (%d)", ret);
+		entry = NULL;
+		goto out;
+	}
+
+	entry->open = true;
+
+out:
+	if (entry != NULL) {
+		entry->holders++;
+	}
+
+	k_mutex_unlock(&sessions_lock);
+
+	return entry != NULL ? &entry->ctx : NULL;
+}
+
+void cipher_session_put(struct cipher_ctx *ctx)
+{
+	struct session_entry *entry = CONTAINER_OF(ctx, struct session_entry,
+						   ctx);
+
+	k_mutex_lock(&sessions_lock, K_FOREVER);
+
+	__ASSERT(entry->holders > 0U, "Session %p is not held", ctx);
+	entry->holders--;
+	entry->last_use = use_count++;
+
+	k_mutex_unlock(&sessions_lock);
+}
@@ -87,6 +87,7 @@ enum sdhc_app_ext_cmd {
 #define SDHC_CSD_SIZE 16
 #define SDHC_CSD_V1 0
 #define SDHC_CSD_V2 1
+#define SDHC_ERASE_CNT_MAX 0x7FFFFF
 
 /* Data block tokens */
 #define SDHC_TOKEN_SINGLE 0xFE
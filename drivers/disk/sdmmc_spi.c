@@ -376,6 +376,14 @@ static int sdhc_spi_rx_block(struct sdhc_spi_data *data,
 	 * between commands.
 	 */
 	uint8_t crc[SDHC_CRC16_SIZE + 1];
+	/* The ones are sent from the same buffer as many times as needed */
+	struct spi_buf tx_bufs[SDMMC_DEFAULT_BLOCK_SIZE / sizeof(sdhc_ones) + 1];
+	struct spi_buf_set tx = {
+		.buffers = tx_bufs,
+		.count = 0,
+	};
+
+	__ASSERT_NO_MSG(len <= SDMMC_DEFAULT_BLOCK_SIZE);
 
 	token = sdhc_spi_skip(data, 0xFF);
 	if (token < 0) {
@@ -387,44 +395,33 @@ static int sdhc_spi_rx_block(struct sdhc_spi_data *data,
 		return -EIO;
 	}
 
-	/* Read the data in batches */
-	for (i = 0; i < len; i += sizeof(sdhc_ones)) {
-		int remain = MIN(sizeof(sdhc_ones), len - i);
-
-		struct spi_buf tx_bufs[] = {
-			{
-				.buf = (uint8_t *)sdhc_ones,
-				.len = remain
-			}
-		};
-
-		const struct spi_buf_set tx = {
-			.buffers = tx_bufs,
-			.count = 1,
-		};
-
-		struct spi_buf rx_bufs[] = {
-			{
-				.buf = &buf[i],
-				.len = remain
-			}
-		};
-
-		const struct spi_buf_set rx = {
-			.buffers = rx_bufs,
-			.count = 1,
-		};
+	for (i = 0; i < len + sizeof(crc); i += sizeof(sdhc_ones)) {
+		tx_bufs[tx.count].buf = (uint8_t *)sdhc_ones;
+		tx_bufs[tx.count].len = MIN(sizeof(sdhc_ones),
+					    len + sizeof(crc) - i);
+		tx.count++;
+	}
 
-		err = sdhc_spi_trace(data, -1,
-				spi_transceive(data->spi, data->spi_cfg,
-				&tx, &rx),
-				&buf[i], remain);
-		if (err != 0) {
-			return err;
+	struct spi_buf rx_bufs[] = {
+		{
+			.buf = buf,
+			.len = len
+		},
+		{
+			.buf = crc,
+			.len = sizeof(crc)
 		}
-	}
+	};
+
+	const struct spi_buf_set rx = {
+		.buffers = rx_bufs,
+		.count = ARRAY_SIZE(rx_bufs),
+	};
 
-	err = sdhc_spi_rx_bytes(data, crc, sizeof(crc));
+	/* Read the data and the CRC in a single transfer */
+	err = sdhc_spi_trace(data, -1,
+			spi_transceive(data->spi, data->spi_cfg, &tx, &rx),
+			buf, len);
 	if (err != 0) {
 		return err;
 	}
@@ -437,35 +434,67 @@ static int sdhc_spi_rx_block(struct sdhc_spi_data *data,
 	return 0;
 }
 
-/* Transmits a SDHC data block */
-static int sdhc_spi_tx_block(struct sdhc_spi_data *data,
-	uint8_t *send, int len)
+/* Transmits a SDHC data block and returns the mapped data response */
+static int sdhc_spi_tx_block(struct sdhc_spi_data *data, uint8_t token,
+	const uint8_t *send, int len)
 {
-	uint8_t buf[SDHC_CRC16_SIZE];
+	uint8_t crc[SDHC_CRC16_SIZE];
+	uint8_t response;
 	int err;
 
-	/* Start the block */
-	buf[0] = SDHC_TOKEN_SINGLE;
-	err = sdhc_spi_tx(data, buf, 1);
-	if (err != 0) {
-		return err;
-	}
+	sys_put_be16(crc16_itu_t(0, send, len), crc);
 
-	/* Write the payload */
-	err = sdhc_spi_tx(data, send, len);
-	if (err != 0) {
-		return err;
-	}
+	/* The token, payload and CRC go out in a single transfer, followed
+	 * by the byte clocking in the data response.
+	 */
+	struct spi_buf tx_bufs[] = {
+		{
+			.buf = &token,
+			.len = 1
+		},
+		{
+			.buf = (uint8_t *)send,
+			.len = len
+		},
+		{
+			.buf = crc,
+			.len = sizeof(crc)
+		},
+		{
+			.buf = (uint8_t *)sdhc_ones,
+			.len = 1
+		}
+	};
+
+	const struct spi_buf_set tx = {
+		.buffers = tx_bufs,
+		.count = ARRAY_SIZE(tx_bufs),
+	};
+
+	struct spi_buf rx_bufs[] = {
+		{
+			.buf = NULL,
+			.len = 1 + len + sizeof(crc)
+		},
+		{
+			.buf = &response,
+			.len = 1
+		}
+	};
 
-	/* Build and write the trailing CRC */
-	sys_put_be16(crc16_itu_t(0, send, len), buf);
+	const struct spi_buf_set rx = {
+		.buffers = rx_bufs,
+		.count = ARRAY_SIZE(rx_bufs),
+	};
 
-	err = sdhc_spi_tx(data, buf, sizeof(buf));
+	err = sdhc_spi_trace(data, 1,
+			spi_transceive(data->spi, data->spi_cfg, &tx, &rx),
+			send, len);
 	if (err != 0) {
 		return err;
 	}
 
-	return sdhc_map_data_status(sdhc_spi_rx_u8(data));
+	return sdhc_map_data_status(response);
 }
 
 static int sdhc_spi_recover(struct sdhc_spi_data *data)
@@ -742,7 +771,7 @@ static int sdhc_spi_write(struct sdhc_spi_data *data,
 			goto error;
 		}
 
-		err = sdhc_spi_tx_block(data, (uint8_t *)buf,
+		err = sdhc_spi_tx_block(data, SDHC_TOKEN_SINGLE, buf,
 			SDMMC_DEFAULT_BLOCK_SIZE);
 		if (err != 0) {
 			goto error;
@@ -776,7 +805,6 @@ static int sdhc_spi_write_multi(struct sdhc_spi_data *data,
 {
 	int err;
 	uint32_t addr;
-	uint8_t block[SDHC_CRC16_SIZE];
 
 	err = sdhc_map_disk_status(data->status);
 	if (err != 0) {
@@ -789,6 +817,17 @@ static int sdhc_spi_write_multi(struct sdhc_spi_data *data,
 		addr = sector * SDMMC_DEFAULT_BLOCK_SIZE;
 	}
 
+	/* Tell the card how many blocks follow, so that it can erase them
+	 * ahead of the data. This is only a hint: the write goes on without
+	 * it if the card rejects the command.
+	 */
+	sdhc_spi_cmd_r1_raw(data, SDHC_APP_CMD, 0);
+	err = sdhc_spi_cmd_r1(data, SDHC_APP_SET_WRITE_BLK_ERASE_CNT,
+			      MIN(count, SDHC_ERASE_CNT_MAX));
+	if (err != 0) {
+		LOG_DBG("pre-erase of %u blocks failed (%d)", count, err);
+	}
+
 	err = sdhc_spi_cmd_r1(data, SDHC_WRITE_MULTIPLE_BLOCK, addr);
 	if (err < 0) {
 		goto exit;
@@ -796,29 +835,8 @@ static int sdhc_spi_write_multi(struct sdhc_spi_data *data,
 
 	/* Write the blocks */
 	for (; count != 0U; count--) {
-		/* Start the block */
-		block[0] = SDHC_TOKEN_MULTI_WRITE;
-		err = sdhc_spi_tx(data, block, 1);
-		if (err != 0) {
-			goto exit;
-		}
-
-		/* Write the payload */
-		err = sdhc_spi_tx(data, buf, SDMMC_DEFAULT_BLOCK_SIZE);
-		if (err != 0) {
-			goto exit;
-		}
-
-		/* Build and write the trailing CRC */
-		sys_put_be16(crc16_itu_t(0, buf, SDMMC_DEFAULT_BLOCK_SIZE),
-			     block);
-
-		err = sdhc_spi_tx(data, block, sizeof(block));
-		if (err != 0) {
-			goto exit;
-		}
-
-		err = sdhc_map_data_status(sdhc_spi_rx_u8(data));
+		err = sdhc_spi_tx_block(data, SDHC_TOKEN_MULTI_WRITE, buf,
+			SDMMC_DEFAULT_BLOCK_SIZE);
 		if (err != 0) {
 			goto exit;
 		}
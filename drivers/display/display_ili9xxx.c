@@ -25,6 +25,21 @@ struct ili9xxx_data {
 	uint8_t bytes_per_pixel;
 	enum display_pixel_format pixel_format;
 	enum display_orientation orientation;
+#ifdef CONFIG_DISPLAY_ASYNC_WRITE
+	const struct device *dev;
+	struct spi_buf async_buf;
+	struct spi_buf_set async_bufs;
+	struct k_poll_signal async_sig;
+	struct k_poll_event async_evt;
+	struct k_work_poll async_work;
+	/* Rows of the rectangle left to transfer, one transfer per row when
+	 * the pitch exceeds the width
+	 */
+	uint16_t async_rows;
+	uint32_t async_stride;
+	display_write_callback_t async_cb;
+	void *async_user_data;
+#endif
 };
 
 int ili9xxx_transmit(const struct device *dev, uint8_t cmd, const void *tx_data,
@@ -180,6 +195,100 @@ static int ili9xxx_write(const struct device *dev, const uint16_t x,
 	return 0;
 }
 
+#ifdef CONFIG_DISPLAY_ASYNC_WRITE
+static int ili9xxx_async_next(struct ili9xxx_data *data)
+{
+	int r;
+
+	k_poll_signal_reset(&data->async_sig);
+	data->async_evt.state = K_POLL_STATE_NOT_READY;
+
+	r = spi_write_async(data->spi_dev, &data->spi_config,
+			    &data->async_bufs, &data->async_sig);
+	if (r < 0) {
+		return r;
+	}
+
+	data->async_buf.buf = (uint8_t *)data->async_buf.buf +
+			      data->async_stride;
+	data->async_rows--;
+
+	return k_work_poll_submit(&data->async_work, &data->async_evt, 1,
+				  K_FOREVER);
+}
+
+static void ili9xxx_async_work_handler(struct k_work *work)
+{
+	struct k_work_poll *pwork = CONTAINER_OF(work, struct k_work_poll,
+						 work);
+	struct ili9xxx_data *data = CONTAINER_OF(pwork, struct ili9xxx_data,
+						 async_work);
+	unsigned int signaled;
+	int r;
+
+	k_poll_signal_check(&data->async_sig, &signaled, &r);
+
+	if (r == 0 && data->async_rows > 0U) {
+		r = ili9xxx_async_next(data);
+		if (r == 0) {
+			return;
+		}
+	}
+
+	data->async_cb(data->dev, r, data->async_user_data);
+}
+
+static int ili9xxx_write_async(const struct device *dev, const uint16_t x,
+			       const uint16_t y,
+			       const struct display_buffer_descriptor *desc,
+			       const void *buf,
+			       display_write_callback_t callback,
+			       void *user_data)
+{
+	const struct ili9xxx_config *config =
+		(struct ili9xxx_config *)dev->config;
+	struct ili9xxx_data *data = (struct ili9xxx_data *)dev->data;
+
+	int r;
+
+	__ASSERT(desc->width <= desc->pitch, "Pitch is smaller than width");
+	__ASSERT((desc->pitch * data->bytes_per_pixel * desc->height) <=
+			 desc->buf_size,
+		 "Input buffer to small");
+
+	LOG_DBG("Writing %dx%d (w,h) @ %dx%d (x,y) asynchronously",
+		desc->width, desc->height, x, y);
+	r = ili9xxx_set_mem_area(dev, x, y, desc->width, desc->height);
+	if (r < 0) {
+		return r;
+	}
+
+	r = ili9xxx_transmit(dev, ILI9XXX_RAMWR, NULL, 0);
+	if (r < 0) {
+		return r;
+	}
+
+	gpio_pin_set(data->command_data_gpio, config->cmd_data_pin,
+		     ILI9XXX_DATA);
+
+	data->async_buf.buf = (void *)buf;
+	if (desc->pitch > desc->width) {
+		data->async_buf.len = desc->width * data->bytes_per_pixel;
+		data->async_rows = desc->height;
+	} else {
+		data->async_buf.len = desc->width * data->bytes_per_pixel *
+				      desc->height;
+		data->async_rows = 1U;
+	}
+
+	data->async_stride = desc->pitch * data->bytes_per_pixel;
+	data->async_cb = callback;
+	data->async_user_data = user_data;
+
+	return ili9xxx_async_next(data);
+}
+#endif /* CONFIG_DISPLAY_ASYNC_WRITE */
+
 static int ili9xxx_read(const struct device *dev, const uint16_t x,
 			const uint16_t y,
 			const struct display_buffer_descriptor *desc, void *buf)
@@ -372,6 +481,16 @@ static int ili9xxx_init(const struct device *dev)
 		return -ENODEV;
 	}
 
+#ifdef CONFIG_DISPLAY_ASYNC_WRITE
+	data->dev = dev;
+	data->async_bufs.buffers = &data->async_buf;
+	data->async_bufs.count = 1U;
+	k_poll_signal_init(&data->async_sig);
+	k_poll_event_init(&data->async_evt, K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &data->async_sig);
+	k_work_poll_init(&data->async_work, ili9xxx_async_work_handler);
+#endif
+
 	data->spi_config.frequency = config->spi_max_freq;
 	data->spi_config.operation = SPI_OP_MODE_MASTER | SPI_WORD_SET(8U);
 	data->spi_config.slave = config->spi_addr;
@@ -447,6 +566,9 @@ static const struct display_driver_api ili9xxx_api = {
 	.get_capabilities = ili9xxx_get_capabilities,
 	.set_pixel_format = ili9xxx_set_pixel_format,
 	.set_orientation = ili9xxx_set_orientation,
+#ifdef CONFIG_DISPLAY_ASYNC_WRITE
+	.write_async = ili9xxx_write_async,
+#endif
 };
 
 #define INST_DT_ILI9XXX(n, t) DT_INST(n, ilitek_ili##t)
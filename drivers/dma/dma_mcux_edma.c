@@ -44,6 +44,7 @@ struct call_back {
 	dma_callback_t dma_callback;
 	enum dma_channel_direction dir;
 	bool busy;
+	bool cyclic;
 };
 
 struct dma_mcux_edma_data {
@@ -69,13 +70,16 @@ struct dma_mcux_edma_data {
 static void nxp_edma_callback(edma_handle_t *handle, void *param,
 			      bool transferDone, uint32_t tcds)
 {
-	int ret = 1;
+	int ret = DMA_STATUS_BLOCK;
 	struct call_back *data = (struct call_back *)param;
 	uint32_t channel = handle->channel;
 
-	if (transferDone) {
+	if (transferDone && data->cyclic) {
+		/* The major loop restarted, tell its next end from its half */
+		handle->base->CDNE = channel;
+	} else if (transferDone) {
 		data->busy = false;
-		ret = 0;
+		ret = DMA_STATUS_COMPLETE;
 	}
 	LOG_DBG("transfer %d", tcds);
 	data->dma_callback(data->dev, data->user_data, channel, ret);
@@ -270,10 +274,19 @@ static int dma_mcux_edma_configure(const struct device *dev, uint32_t channel,
 	EDMA_EnableChannelInterrupts(DEV_BASE(dev), channel,
 				     kEDMA_ErrorInterruptEnable);
 
-	if (block_config->source_gather_en || block_config->dest_scatter_en) {
+	data->cyclic = config->cyclic;
+
+	if (config->block_count > 1 ||
+	    block_config->source_gather_en || block_config->dest_scatter_en) {
 		if (config->block_count > CONFIG_DMA_TCD_QUEUE_SIZE) {
 			LOG_ERR("please config DMA_TCD_QUEUE_SIZE as %d",
 				config->block_count);
+			irq_unlock(key);
+			return -EINVAL;
+		}
+		if (config->cyclic && config->block_count < 2) {
+			LOG_ERR("cyclic list needs 2 blocks at least");
+			irq_unlock(key);
 			return -EINVAL;
 		}
 		EDMA_InstallTCDMemory(p_handle, tcdpool[channel],
@@ -290,6 +303,24 @@ static int dma_mcux_edma_configure(const struct device *dev, uint32_t channel,
 			EDMA_SubmitTransfer(p_handle, &(data->transferConfig));
 			block_config = block_config->next_block;
 		}
+
+		if (config->half_complete_callback_en) {
+			for (int i = 0; i < config->block_count; i++) {
+				tcdpool[channel][i].CSR |= DMA_CSR_INTHALF_MASK;
+			}
+		}
+
+		if (config->cyclic) {
+			/* Link the last TCD back to the first one, the
+			 * hardware then loops over the list by itself.
+			 */
+			edma_tcd_t *last =
+				&tcdpool[channel][config->block_count - 1];
+
+			last->DLAST_SGA = (uint32_t)&tcdpool[channel][0];
+			last->CSR = (last->CSR | DMA_CSR_ESG_MASK) &
+				    ~DMA_CSR_DREQ_MASK;
+		}
 	} else {
 		/* block_count shall be 1 */
 		status_t ret;
@@ -308,9 +339,31 @@ static int dma_mcux_edma_configure(const struct device *dev, uint32_t channel,
 		if (ret != kStatus_Success) {
 			LOG_ERR("submit error 0x%x", ret);
 		}
+
+		if (config->cyclic) {
+			/* Rewind the incremented addresses at the end of the
+			 * major loop and keep the request enabled.
+			 */
+			if (transfer_type == kEDMA_MemoryToMemory ||
+			    transfer_type == kEDMA_MemoryToPeripheral) {
+				tcdRegs->SLAST =
+					-(int32_t)block_config->block_size;
+			}
+			if (transfer_type == kEDMA_MemoryToMemory ||
+			    transfer_type == kEDMA_PeripheralToMemory) {
+				tcdRegs->DLAST_SGA =
+					-(int32_t)block_config->block_size;
+			}
+			tcdRegs->CSR &= ~DMA_CSR_DREQ_MASK;
+		}
 		LOG_DBG("data csr is 0x%x", tcdRegs->CSR);
 	}
 
+	if (config->half_complete_callback_en) {
+		EDMA_EnableChannelInterrupts(DEV_BASE(dev), channel,
+					     kEDMA_HalfInterruptEnable);
+	}
+
 	if (config->dest_chaining_en) {
 		LOG_DBG("link major channel %d", config->linked_channel);
 		EDMA_SetChannelLink(DEV_BASE(dev), channel, kEDMA_MajorLink,
@@ -414,6 +467,21 @@ static bool dma_mcux_edma_channel_filter(const struct device *dev,
 	return true;
 }
 
+static int dma_mcux_edma_get_caps(const struct device *dev,
+				  struct dma_caps *caps)
+{
+	ARG_UNUSED(dev);
+
+	caps->flags = DMA_CAPS_CYCLIC | DMA_CAPS_CYCLIC_LIST |
+		      DMA_CAPS_HALF_COMPLETE | DMA_CAPS_SCATTER_GATHER;
+	caps->max_block_count = CONFIG_DMA_TCD_QUEUE_SIZE;
+	/* Major loop count, with a minor loop of one data unit */
+	caps->max_block_size = DMA_CITER_ELINKNO_CITER_MASK >>
+			       DMA_CITER_ELINKNO_CITER_SHIFT;
+
+	return 0;
+}
+
 static const struct dma_driver_api dma_mcux_edma_api = {
 	.reload = dma_mcux_edma_reload,
 	.config = dma_mcux_edma_configure,
@@ -421,6 +489,7 @@ static const struct dma_driver_api dma_mcux_edma_api = {
 	.stop = dma_mcux_edma_stop,
 	.get_status = dma_mcux_edma_get_status,
 	.chan_filter = dma_mcux_edma_channel_filter,
+	.get_caps = dma_mcux_edma_get_caps,
 };
 
 static int dma_mcux_edma_init(const struct device *dev)
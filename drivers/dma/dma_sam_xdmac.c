@@ -26,10 +26,20 @@ LOG_MODULE_REGISTER(dma_sam_xdmac);
 #define XDMAC_INT_ERR (XDMAC_CIE_RBIE | XDMAC_CIE_WBIE | XDMAC_CIE_ROIE)
 #define DMA_CHANNELS_NO  XDMACCHID_NUMBER
 
+#if __DCACHE_PRESENT == 1
+#define DCACHE_CLEAN(addr, size) \
+	SCB_CleanDCache_by_Addr((uint32_t *)addr, size)
+#else
+#define DCACHE_CLEAN(addr, size) {; }
+#endif
+
 /* DMA channel configuration */
 struct sam_xdmac_channel_cfg {
 	void *user_data;
 	dma_callback_t callback;
+	/* Linked list of the blocks of a transfer, fetched by the controller */
+	struct sam_xdmac_linked_list_desc_view1
+		desc[CONFIG_DMA_SAM_XDMAC_DESC_COUNT] __aligned(32);
 };
 
 /* Device constant configuration parameters */
@@ -58,7 +68,8 @@ static void sam_xdmac_isr(const struct device *dev)
 	Xdmac *const xdmac = dev_cfg->regs;
 	struct sam_xdmac_channel_cfg *channel_cfg;
 	uint32_t isr_status;
-	uint32_t err;
+	uint32_t cis;
+	int status;
 
 	/* Get global interrupt status */
 	isr_status = xdmac->XDMAC_GIS;
@@ -70,13 +81,22 @@ static void sam_xdmac_isr(const struct device *dev)
 
 		channel_cfg = &dev_data->dma_channels[channel];
 
-		/* Get channel errors */
-		err = xdmac->XDMAC_CHID[channel].XDMAC_CIS & XDMAC_INT_ERR;
+		/* Reading the status clears it */
+		cis = xdmac->XDMAC_CHID[channel].XDMAC_CIS;
+
+		if (cis & XDMAC_INT_ERR) {
+			status = -EIO;
+		} else if (cis & XDMAC_CIS_LIS) {
+			status = DMA_STATUS_COMPLETE;
+		} else {
+			/* End of a block of a list, which goes on */
+			status = DMA_STATUS_BLOCK;
+		}
 
 		/* Execute callback */
 		if (channel_cfg->callback) {
 			channel_cfg->callback(dev, channel_cfg->user_data,
-					      channel, err);
+					      channel, status);
 		}
 	}
 }
@@ -175,6 +195,40 @@ int sam_xdmac_transfer_configure(const struct device *dev, uint32_t channel,
 	return 0;
 }
 
+/* Each descriptor loads the addresses and length of a block. The last one
+ * ends the list, or links back to the first one in cyclic mode.
+ */
+static void sam_xdmac_desc_fill(struct sam_xdmac_channel_cfg *channel_cfg,
+				const struct dma_config *cfg,
+				uint32_t data_size)
+{
+	struct sam_xdmac_linked_list_desc_view1 *desc = channel_cfg->desc;
+	struct dma_block_config *block = cfg->head_block;
+	uint32_t i;
+
+	for (i = 0U; i < cfg->block_count; i++) {
+		bool last = (i == cfg->block_count - 1U);
+
+		desc[i].mbr_sa = block->source_address;
+		desc[i].mbr_da = block->dest_address;
+		desc[i].mbr_ubc = (block->block_size >> data_size)
+			| XDMA_UBC_NVIEW_NDV1
+			| XDMA_UBC_NSEN_UPDATED
+			| XDMA_UBC_NDEN_UPDATED;
+
+		if (!last || cfg->cyclic) {
+			desc[i].mbr_nda = (uint32_t)&desc[last ? 0 : i + 1];
+			desc[i].mbr_ubc |= XDMA_UBC_NDE_FETCH_EN;
+		} else {
+			desc[i].mbr_nda = 0U;
+		}
+
+		block = block->next_block;
+	}
+
+	DCACHE_CLEAN(desc, cfg->block_count * sizeof(desc[0]));
+}
+
 static int sam_xdmac_config(const struct device *dev, uint32_t channel,
 			    struct dma_config *cfg)
 {
@@ -198,12 +252,19 @@ static int sam_xdmac_config(const struct device *dev, uint32_t channel,
 		return -EINVAL;
 	}
 
-	if (cfg->block_count != 1U) {
-		LOG_ERR("Only single block transfer is currently supported."
-			    " Please submit a patch.");
+	if (cfg->block_count == 0U ||
+	    cfg->block_count > CONFIG_DMA_SAM_XDMAC_DESC_COUNT) {
+		LOG_ERR("Up to %d blocks per transfer, see "
+			"CONFIG_DMA_SAM_XDMAC_DESC_COUNT",
+			CONFIG_DMA_SAM_XDMAC_DESC_COUNT);
 		return -EINVAL;
 	}
 
+	if (cfg->half_complete_callback_en) {
+		LOG_ERR("Half block interrupts are not supported");
+		return -ENOTSUP;
+	}
+
 	burst_size = find_msb_set(cfg->source_burst_length) - 1;
 	LOG_DBG("burst_size=%d", burst_size);
 	data_size = find_msb_set(cfg->source_data_size) - 1;
@@ -247,8 +308,13 @@ static int sam_xdmac_config(const struct device *dev, uint32_t channel,
 	channel_cfg.ds_msp = 0U;
 	channel_cfg.sus = 0U;
 	channel_cfg.dus = 0U;
+	/* A cyclic list never ends, only the ends of its blocks can be
+	 * reported.
+	 */
 	channel_cfg.cie =
-		  (cfg->complete_callback_en ? XDMAC_CIE_BIE : XDMAC_CIE_LIE)
+		  (cfg->complete_callback_en || cfg->cyclic ?
+			XDMAC_CIE_BIE : 0)
+		| XDMAC_CIE_LIE
 		| (cfg->error_callback_en ? XDMAC_INT_ERR : 0);
 
 	ret = sam_xdmac_channel_configure(dev, channel, &channel_cfg);
@@ -262,7 +328,20 @@ static int sam_xdmac_config(const struct device *dev, uint32_t channel,
 	(void)memset(&transfer_cfg, 0, sizeof(transfer_cfg));
 	transfer_cfg.sa = cfg->head_block->source_address;
 	transfer_cfg.da = cfg->head_block->dest_address;
-	transfer_cfg.ublen = cfg->head_block->block_size >> data_size;
+
+	if (cfg->block_count == 1U && !cfg->cyclic) {
+		transfer_cfg.ublen = cfg->head_block->block_size >> data_size;
+	} else {
+		sam_xdmac_desc_fill(&dev_data->dma_channels[channel], cfg,
+				    data_size);
+		transfer_cfg.nda =
+			(uint32_t)&dev_data->dma_channels[channel].desc[0];
+		transfer_cfg.ndc =
+			  XDMAC_CNDC_NDE_DSCR_FETCH_EN
+			| XDMAC_CNDC_NDSUP_SRC_PARAMS_UPDATED
+			| XDMAC_CNDC_NDDUP_DST_PARAMS_UPDATED
+			| XDMAC_CNDC_NDVIEW_NDV1;
+	}
 
 	ret = sam_xdmac_transfer_configure(dev, channel, &transfer_cfg);
 
@@ -339,8 +418,23 @@ static int sam_xdmac_initialize(const struct device *dev)
 	return 0;
 }
 
+static int sam_xdmac_get_caps(const struct device *dev,
+			      struct dma_caps *caps)
+{
+	ARG_UNUSED(dev);
+
+	caps->flags = DMA_CAPS_CYCLIC | DMA_CAPS_CYCLIC_LIST |
+		      DMA_CAPS_SCATTER_GATHER;
+	caps->max_block_count = CONFIG_DMA_SAM_XDMAC_DESC_COUNT;
+	/* Microblock length */
+	caps->max_block_size = XDMAC_CUBC_UBLEN_Msk >> XDMAC_CUBC_UBLEN_Pos;
+
+	return 0;
+}
+
 static const struct dma_driver_api sam_xdmac_driver_api = {
 	.config = sam_xdmac_config,
+	.get_caps = sam_xdmac_get_caps,
 	.start = sam_xdmac_transfer_start,
 	.stop = sam_xdmac_transfer_stop,
 };
@@ -80,6 +80,59 @@ static void dma_stm32_clear_stream_irq(const struct device *dev, uint32_t id)
 	stm32_dma_clear_stream_irq(dma, id);
 }
 
+static int dma_stm32_disable_stream(DMA_TypeDef *dma, uint32_t id)
+{
+	int count = 0;
+
+	for (;;) {
+		if (stm32_dma_disable_stream(dma, id) == 0) {
+			return 0;
+		}
+		/* After trying for 5 seconds, give up */
+		if (count++ > (5 * 1000)) {
+			return -EBUSY;
+		}
+		k_sleep(K_MSEC(1));
+	}
+
+	return 0;
+}
+
+static int dma_stm32_transfer_load(DMA_TypeDef *dma, uint32_t id,
+				   struct dma_stm32_stream *stream,
+				   uint32_t src, uint32_t dst, size_t size)
+{
+	if (dma_stm32_disable_stream(dma, id) != 0) {
+		return -EBUSY;
+	}
+
+	switch (stream->direction) {
+	case MEMORY_TO_PERIPHERAL:
+		LL_DMA_SetMemoryAddress(dma, dma_stm32_id_to_stream(id), src);
+		LL_DMA_SetPeriphAddress(dma, dma_stm32_id_to_stream(id), dst);
+		break;
+	case MEMORY_TO_MEMORY:
+	case PERIPHERAL_TO_MEMORY:
+		LL_DMA_SetPeriphAddress(dma, dma_stm32_id_to_stream(id), src);
+		LL_DMA_SetMemoryAddress(dma, dma_stm32_id_to_stream(id), dst);
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	if (stream->source_periph) {
+		LL_DMA_SetDataLength(dma, dma_stm32_id_to_stream(id),
+				     size / stream->src_size);
+	} else {
+		LL_DMA_SetDataLength(dma, dma_stm32_id_to_stream(id),
+				     size / stream->dst_size);
+	}
+
+	stm32_dma_enable_stream(dma, id);
+
+	return 0;
+}
+
 static void dma_stm32_irq_handler(const struct device *dev, uint32_t id)
 {
 	const struct dma_stm32_config *config = dev->config;
@@ -107,7 +160,9 @@ static void dma_stm32_irq_handler(const struct device *dev, uint32_t id)
 		if (!stream->hal_override) {
 			dma_stm32_clear_ht(dma, id);
 		}
-		stream->dma_callback(dev, stream->user_data, callback_arg, 0);
+		stream->busy = true;
+		stream->dma_callback(dev, stream->user_data, callback_arg,
+				     DMA_STATUS_BLOCK);
 	} else if (stm32_dma_is_tc_irq_active(dma, id)) {
 #ifdef CONFIG_DMAMUX_STM32
 		stream->busy = false;
@@ -116,7 +171,38 @@ static void dma_stm32_irq_handler(const struct device *dev, uint32_t id)
 		if (!stream->hal_override) {
 			dma_stm32_clear_tc(dma, id);
 		}
-		stream->dma_callback(dev, stream->user_data, callback_arg, 0);
+
+		if (stream->cyclic) {
+			stream->busy = true;
+			stream->dma_callback(dev, stream->user_data,
+					     callback_arg, DMA_STATUS_BLOCK);
+			return;
+		}
+
+		/* The controller has no descriptors, the blocks of a list
+		 * are loaded one after the other from here. The stream was
+		 * disabled by the hardware at the end of the block, so that
+		 * loading the next one does not wait.
+		 */
+		if (stream->next_block != NULL) {
+			struct dma_block_config *block = stream->next_block;
+
+			stream->next_block = block->next_block;
+			stream->busy = true;
+			dma_stm32_transfer_load(dma, id, stream,
+						block->source_address,
+						block->dest_address,
+						block->block_size);
+			if (stream->complete_callback_en) {
+				stream->dma_callback(dev, stream->user_data,
+						     callback_arg,
+						     DMA_STATUS_BLOCK);
+			}
+			return;
+		}
+
+		stream->dma_callback(dev, stream->user_data, callback_arg,
+				     DMA_STATUS_COMPLETE);
 	} else if (stm32_dma_is_unexpected_irq_happened(dma, id)) {
 		LOG_ERR("Unexpected irq happened.");
 		stream->dma_callback(dev, stream->user_data,
@@ -237,24 +323,6 @@ static int dma_stm32_get_periph_increment(enum dma_addr_adj increment,
 	return 0;
 }
 
-static int dma_stm32_disable_stream(DMA_TypeDef *dma, uint32_t id)
-{
-	int count = 0;
-
-	for (;;) {
-		if (stm32_dma_disable_stream(dma, id) == 0) {
-			return 0;
-		}
-		/* After trying for 5 seconds, give up */
-		if (count++ > (5 * 1000)) {
-			return -EBUSY;
-		}
-		k_sleep(K_MSEC(1));
-	}
-
-	return 0;
-}
-
 DMA_STM32_EXPORT_API int dma_stm32_configure(const struct device *dev,
 					     uint32_t id,
 					     struct dma_config *config)
@@ -299,10 +367,19 @@ DMA_STM32_EXPORT_API int dma_stm32_configure(const struct device *dev,
 
 	dma_stm32_clear_stream_irq(dev, id);
 
-	if (config->head_block->block_size > DMA_STM32_MAX_DATA_ITEMS) {
-		LOG_ERR("Data size too big: %d\n",
-		       config->head_block->block_size);
-		return -EINVAL;
+	for (struct dma_block_config *block = config->head_block;
+	     block != NULL; block = block->next_block) {
+		if (block->block_size > DMA_STM32_MAX_DATA_ITEMS) {
+			LOG_ERR("Data size too big: %d\n", block->block_size);
+			return -EINVAL;
+		}
+	}
+
+	/* The circular mode reloads the addresses of a single block. */
+	if ((config->cyclic || config->head_block->source_reload_en) &&
+	    config->head_block->next_block != NULL) {
+		LOG_ERR("Cyclic transfers of a single block only.");
+		return -ENOTSUP;
 	}
 
 #ifdef CONFIG_DMA_STM32_V1
@@ -345,6 +422,10 @@ DMA_STM32_EXPORT_API int dma_stm32_configure(const struct device *dev,
 	stream->user_data       = config->user_data;
 	stream->src_size	= config->source_data_size;
 	stream->dst_size	= config->dest_data_size;
+	stream->cyclic		= config->cyclic ||
+				  config->head_block->source_reload_en;
+	stream->complete_callback_en = config->complete_callback_en;
+	stream->next_block	= config->head_block->next_block;
 
 	/* check dest or source memory address, warn if 0 */
 	if ((config->head_block->source_address == 0)) {
@@ -409,7 +490,7 @@ DMA_STM32_EXPORT_API int dma_stm32_configure(const struct device *dev,
 		return ret;
 	}
 
-	if (config->head_block->source_reload_en) {
+	if (stream->cyclic) {
 		DMA_InitStruct.Mode = LL_DMA_MODE_CIRCULAR;
 	} else {
 		DMA_InitStruct.Mode = LL_DMA_MODE_NORMAL;
@@ -475,8 +556,11 @@ DMA_STM32_EXPORT_API int dma_stm32_configure(const struct device *dev,
 
 	LL_DMA_EnableIT_TC(dma, dma_stm32_id_to_stream(id));
 
-	/* Enable Half-Transfer irq if circular mode is enabled */
-	if (config->head_block->source_reload_en) {
+	/* Enable Half-Transfer irq if requested, or if circular mode is
+	 * enabled through the reload flags.
+	 */
+	if (config->half_complete_callback_en ||
+	    config->head_block->source_reload_en) {
 		LL_DMA_EnableIT_HT(dma, dma_stm32_id_to_stream(id));
 	}
 
@@ -509,35 +593,7 @@ DMA_STM32_EXPORT_API int dma_stm32_reload(const struct device *dev, uint32_t id,
 
 	stream = &config->streams[id];
 
-	if (dma_stm32_disable_stream(dma, id) != 0) {
-		return -EBUSY;
-	}
-
-	switch (stream->direction) {
-	case MEMORY_TO_PERIPHERAL:
-		LL_DMA_SetMemoryAddress(dma, dma_stm32_id_to_stream(id), src);
-		LL_DMA_SetPeriphAddress(dma, dma_stm32_id_to_stream(id), dst);
-		break;
-	case MEMORY_TO_MEMORY:
-	case PERIPHERAL_TO_MEMORY:
-		LL_DMA_SetPeriphAddress(dma, dma_stm32_id_to_stream(id), src);
-		LL_DMA_SetMemoryAddress(dma, dma_stm32_id_to_stream(id), dst);
-		break;
-	default:
-		return -EINVAL;
-	}
-
-	if (stream->source_periph) {
-		LL_DMA_SetDataLength(dma, dma_stm32_id_to_stream(id),
-				     size / stream->src_size);
-	} else {
-		LL_DMA_SetDataLength(dma, dma_stm32_id_to_stream(id),
-				     size / stream->dst_size);
-	}
-
-	stm32_dma_enable_stream(dma, id);
-
-	return 0;
+	return dma_stm32_transfer_load(dma, id, stream, src, dst, size);
 }
 
 DMA_STM32_EXPORT_API int dma_stm32_start(const struct device *dev, uint32_t id)
@@ -580,6 +636,8 @@ DMA_STM32_EXPORT_API int dma_stm32_stop(const struct device *dev, uint32_t id)
 #if defined(CONFIG_DMA_STM32_V1)
 	stm32_dma_disable_fifo_irq(dma, id);
 #endif
+	/* Do not load the next block of a list from a pending irq. */
+	stream->next_block = NULL;
 	dma_stm32_disable_stream(dma, id);
 	dma_stm32_clear_stream_irq(dev, id);
 
@@ -634,12 +692,26 @@ DMA_STM32_EXPORT_API int dma_stm32_get_status(const struct device *dev,
 	return 0;
 }
 
+static int dma_stm32_get_caps(const struct device *dev,
+			      struct dma_caps *caps)
+{
+	ARG_UNUSED(dev);
+
+	/* Lists of blocks are chained by the irq handler. */
+	caps->flags = DMA_CAPS_CYCLIC | DMA_CAPS_HALF_COMPLETE;
+	caps->max_block_count = UINT32_MAX;
+	caps->max_block_size = DMA_STM32_MAX_DATA_ITEMS;
+
+	return 0;
+}
+
 static const struct dma_driver_api dma_funcs = {
 	.reload		 = dma_stm32_reload,
 	.config		 = dma_stm32_configure,
 	.start		 = dma_stm32_start,
 	.stop		 = dma_stm32_stop,
 	.get_status	 = dma_stm32_get_status,
+	.get_caps	 = dma_stm32_get_caps,
 };
 
 #ifdef CONFIG_DMAMUX_STM32
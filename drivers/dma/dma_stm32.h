@@ -27,6 +27,10 @@ struct dma_stm32_stream {
 	uint32_t dst_size;
 	void *user_data; /* holds the client data */
 	dma_callback_t dma_callback;
+	bool cyclic;
+	bool complete_callback_en;
+	/* next block of the list, loaded at the end of the current one */
+	struct dma_block_config *next_block;
 };
 
 struct dma_stm32_data {
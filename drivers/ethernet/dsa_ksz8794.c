@@ -819,18 +819,26 @@ struct net_pkt *dsa_ksz8794_xmit_pkt(struct net_if *iface, struct net_pkt *pkt)
 		pad = DSA_MIN_L2_FRAME_SIZE - DSA_L2_FCS_SIZE - len;
 	}
 
-	buf = net_buf_alloc_len(net_buf_pool_get(pkt->buffer->pool_id),
-				pad + DSA_KSZ8794_INGRESS_TAG_LEN, K_NO_WAIT);
-	if (!buf) {
-		LOG_ERR("DSA cannot allocate new data buffer");
-		return NULL;
-	}
-
 	/*
-	 * Get the pointer to struct's net_buf_simple data and zero out the
-	 * padding and tag byte placeholder
+	 * The padding and the tag are written in place after the data of
+	 * the last fragment, and a fragment is only added for them when
+	 * there is no room left there.
 	 */
-	dbuf = net_buf_simple_tail(&(buf->b));
+	buf = net_buf_frag_last(pkt->buffer);
+	if (net_buf_tailroom(buf) < pad + DSA_KSZ8794_INGRESS_TAG_LEN) {
+		buf = net_buf_alloc_len(net_buf_pool_get(pkt->buffer->pool_id),
+					pad + DSA_KSZ8794_INGRESS_TAG_LEN,
+					K_NO_WAIT);
+		if (!buf) {
+			LOG_ERR("DSA cannot allocate new data buffer");
+			return NULL;
+		}
+
+		net_buf_frag_add(pkt->buffer, buf);
+	}
+
+	/* Zero out the padding and tag byte placeholder */
+	dbuf = net_buf_add(buf, pad + DSA_KSZ8794_INGRESS_TAG_LEN);
 	memset(dbuf, 0x0, pad + DSA_KSZ8794_INGRESS_TAG_LEN);
 
 	/*
@@ -857,12 +865,6 @@ struct net_pkt *dsa_ksz8794_xmit_pkt(struct net_if *iface, struct net_pkt *pkt)
 	/* The tail tag shall be placed after the padding (if present) */
 	dbuf[pad] = port_idx;
 
-	/* Set proper len member for the actual struct net_buf_simple */
-	net_buf_add(buf, pad + DSA_KSZ8794_INGRESS_TAG_LEN);
-
-	/* Append struct net_buf to packet data */
-	net_buf_frag_add(pkt->buffer, buf);
-
 	return pkt;
 }
 
@@ -883,6 +885,7 @@ static struct net_if *dsa_ksz8794_get_iface(struct net_if *iface,
 {
 	struct ethernet_context *ctx;
 	struct net_if *iface_sw;
+	struct net_buf *buf;
 	size_t plen;
 	uint8_t pnum;
 
@@ -891,14 +894,24 @@ static struct net_if *dsa_ksz8794_get_iface(struct net_if *iface,
 		return iface;
 	}
 
-	net_pkt_set_overwrite(pkt, true);
-	net_pkt_cursor_init(pkt);
-	plen = net_pkt_get_len(pkt);
+	/*
+	 * The tail tag is the last byte of the frame: take it from the
+	 * last fragment directly, instead of going through the whole
+	 * packet.
+	 */
+	buf = net_buf_frag_last(pkt->buffer);
+	if (buf->len >= DSA_KSZ8794_EGRESS_TAG_LEN) {
+		pnum = net_buf_remove_u8(buf);
+	} else {
+		net_pkt_set_overwrite(pkt, true);
+		net_pkt_cursor_init(pkt);
+		plen = net_pkt_get_len(pkt);
 
-	net_pkt_skip(pkt, plen - DSA_KSZ8794_EGRESS_TAG_LEN);
-	net_pkt_read_u8(pkt, &pnum);
+		net_pkt_skip(pkt, plen - DSA_KSZ8794_EGRESS_TAG_LEN);
+		net_pkt_read_u8(pkt, &pnum);
 
-	net_pkt_update_length(pkt, plen - DSA_KSZ8794_EGRESS_TAG_LEN);
+		net_pkt_update_length(pkt, plen - DSA_KSZ8794_EGRESS_TAG_LEN);
+	}
 
 	/*
 	 * NOTE:
@@ -913,9 +926,8 @@ static struct net_if *dsa_ksz8794_get_iface(struct net_if *iface,
 	iface_sw = net_if_get_by_index(pnum + 2);
 
 	ctx = net_if_l2_data(iface);
-	NET_DBG("TT - plen: %d pnum: %d pos: 0x%p dsa_port_idx: %d",
-		plen - DSA_KSZ8794_EGRESS_TAG_LEN, pnum,
-		net_pkt_cursor_get_pos(pkt), ctx->dsa_port_idx);
+	NET_DBG("TT - plen: %zu pnum: %d dsa_port_idx: %d",
+		net_pkt_get_len(pkt), pnum, ctx->dsa_port_idx);
 
 	return iface_sw;
 }
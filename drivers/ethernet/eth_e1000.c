@@ -46,6 +46,7 @@ static const char *e1000_reg_to_string(enum e1000_reg_t r)
 	_(ICR);
 	_(ICS);
 	_(IMS);
+	_(IMC);
 	_(RCTL);
 	_(TCTL);
 	_(RDBAL);
@@ -89,10 +90,17 @@ static enum ethernet_hw_caps e1000_caps(const struct device *dev)
 {
 	return
 #if IS_ENABLED(CONFIG_NET_VLAN)
-		ETHERNET_HW_VLAN |
+		ETHERNET_HW_VLAN | ETHERNET_HW_VLAN_TAG_STRIP |
+		ETHERNET_HW_VLAN_TAG_INSERT |
 #endif
 #if IS_ENABLED(CONFIG_ETH_E1000_PTP_CLOCK)
 		ETHERNET_PTP |
+#endif
+#if IS_ENABLED(CONFIG_ETH_E1000_HW_ACCELERATION)
+		ETHERNET_HW_TX_CHKSUM_OFFLOAD |
+#if IS_ENABLED(CONFIG_NET_TCP_TSO)
+		ETHERNET_HW_TX_TCP_SEGMENTATION |
+#endif
 #endif
 		ETHERNET_LINK_10BASE_T | ETHERNET_LINK_100BASE_T |
 		ETHERNET_LINK_1000BASE_T |
@@ -111,35 +119,201 @@ static const struct device *e1000_get_ptp_clock(const struct device *dev)
 }
 #endif
 
-static int e1000_tx(struct e1000_dev *dev, void *buf, size_t len)
+static volatile struct e1000_tx *e1000_tx_next(struct e1000_dev *dev)
 {
-	hexdump(buf, len, "%zu byte(s)", len);
+	volatile struct e1000_tx *desc = &dev->tx[dev->tx_tail];
 
-	dev->tx.addr = POINTER_TO_INT(buf);
-	dev->tx.len = len;
-	dev->tx.cmd = TDESC_EOP | TDESC_RS;
+	dev->tx_tail = (dev->tx_tail + 1) % E1000_TX_DESC_COUNT;
 
-	iow32(dev, TDT, 1);
+	return desc;
+}
+
+/* Hand the descriptors queued up to the tail to the controller, and wait
+ * for the one with the given status to be done
+ */
+static int e1000_tx_wait(struct e1000_dev *dev, volatile uint8_t *sta)
+{
+	iow32(dev, TDT, dev->tx_tail);
 
-	while (!(dev->tx.sta)) {
+	while (!(*sta)) {
 		k_yield();
 	}
 
-	LOG_DBG("tx.sta: 0x%02hx", dev->tx.sta);
+	LOG_DBG("tx.sta: 0x%02hx", *sta);
+
+	return (*sta & TDESC_STA_DD) ? 0 : -EIO;
+}
+
+/* The controller inserts the VLAN tag of the frame */
+static uint8_t e1000_tx_vlan(struct net_pkt *pkt, uint16_t *tci)
+{
+#if defined(CONFIG_NET_VLAN)
+	if (net_pkt_vlan_tag(pkt) != NET_VLAN_TAG_UNSPEC) {
+		*tci = net_pkt_vlan_tci(pkt);
+		return TDESC_VLE;
+	}
+#endif
+
+	*tci = 0U;
 
-	return (dev->tx.sta & TDESC_STA_DD) ? 0 : -EIO;
+	return 0U;
 }
 
+static int e1000_tx(struct e1000_dev *dev, struct net_pkt *pkt, void *buf,
+		    size_t len)
+{
+	volatile struct e1000_tx *desc = e1000_tx_next(dev);
+	uint16_t tci;
+	uint8_t vle = e1000_tx_vlan(pkt, &tci);
+
+	hexdump(buf, len, "%zu byte(s)", len);
+
+	desc->addr = POINTER_TO_INT(buf);
+	desc->len = len;
+	desc->cso = 0U;
+	desc->css = 0U;
+	desc->sta = 0U;
+	desc->special = tci;
+	desc->cmd = TDESC_EOP | TDESC_RS | vle;
+
+	return e1000_tx_wait(dev, &desc->sta);
+}
+
+#if defined(CONFIG_ETH_E1000_HW_ACCELERATION)
+static uint16_t e1000_csum(uint32_t sum, const uint8_t *data, size_t len)
+{
+	for (; len > 1; data += 2, len -= 2) {
+		sum += sys_get_be16(data);
+	}
+
+	if (len) {
+		sum += (uint32_t)data[0] << 8;
+	}
+
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return sum;
+}
+
+/* The stack leaves the checksums to the controller, which are set up in
+ * a context descriptor before the one of the frame. The TCP or UDP
+ * checksum gets seeded with the pseudo header, without the length if
+ * the controller splits the segment as it adds the length of each one.
+ */
+static int e1000_tx_offload(struct e1000_dev *dev, struct net_pkt *pkt,
+			    uint8_t *buf, size_t len)
+{
+	struct net_eth_hdr *eth = (struct net_eth_hdr *)buf;
+	volatile struct e1000_tx_ctx *ctx;
+	volatile struct e1000_tx_data *data;
+	uint16_t type = ntohs(eth->type);
+	uint16_t mss = net_pkt_tso_mss(pkt);
+	size_t l3 = sizeof(struct net_eth_hdr);
+	size_t l4, hdrlen = 0U;
+	uint8_t proto, cso = 0U;
+	uint8_t tucmd = 0U, popts = 0U;
+	uint16_t tci;
+	uint8_t vle;
+	uint32_t sum;
+
+	if (type == NET_ETH_PTYPE_IP) {
+		struct net_ipv4_hdr *ip = (struct net_ipv4_hdr *)(buf + l3);
+
+		l4 = l3 + (ip->vhl & 0x0f) * 4U;
+		proto = ip->proto;
+		sum = e1000_csum(0U, (uint8_t *)&ip->src,
+				 2 * sizeof(struct in_addr));
+		tucmd |= TUCMD_IP;
+		popts |= POPTS_IXSM;
+	} else if (type == NET_ETH_PTYPE_IPV6 &&
+		   net_pkt_ipv6_ext_len(pkt) == 0U) {
+		/* Only ICMPv6 and fragments come with extension headers */
+		struct net_ipv6_hdr *ip = (struct net_ipv6_hdr *)(buf + l3);
+
+		l4 = l3 + sizeof(struct net_ipv6_hdr);
+		proto = ip->nexthdr;
+		sum = e1000_csum(0U, ip->src.s6_addr,
+				 2 * sizeof(struct in6_addr));
+	} else {
+		return e1000_tx(dev, pkt, buf, len);
+	}
+
+	if (proto == IPPROTO_TCP) {
+		cso = offsetof(struct net_tcp_hdr, chksum);
+		hdrlen = l4 + (buf[l4 + offsetof(struct net_tcp_hdr, offset)]
+			       >> 4) * 4U;
+		tucmd |= TUCMD_TCP;
+	} else if (proto == IPPROTO_UDP) {
+		cso = offsetof(struct net_udp_hdr, chksum);
+		mss = 0U;
+	} else if (popts) {
+		/* Only the IPv4 header checksum then */
+		mss = 0U;
+	} else {
+		return e1000_tx(dev, pkt, buf, len);
+	}
+
+	if (cso) {
+		sum += proto;
+		if (!mss) {
+			sum += len - l4;
+		}
+
+		sys_put_be16(e1000_csum(sum, NULL, 0), buf + l4 + cso);
+		popts |= POPTS_TXSM;
+	}
+
+	hexdump(buf, len, "%zu byte(s), mss %u", len, mss);
+
+	ctx = (volatile struct e1000_tx_ctx *)e1000_tx_next(dev);
+	ctx->ipcss = l3;
+	ctx->ipcso = (tucmd & TUCMD_IP) ?
+		l3 + offsetof(struct net_ipv4_hdr, chksum) : 0U;
+	ctx->ipcse = (tucmd & TUCMD_IP) ? l4 - 1 : 0U;
+	ctx->tucss = cso ? l4 : 0U;
+	ctx->tucso = cso ? l4 + cso : 0U;
+	ctx->tucse = 0U;
+	ctx->paylen_cmd = (mss ? len - hdrlen : 0U) |
+		((tucmd | TDESC_DEXT | (mss ? TDESC_TSE : 0U)) << 24);
+	ctx->sta = 0U;
+	ctx->hdrlen = mss ? hdrlen : 0U;
+	ctx->mss = mss;
+
+	vle = e1000_tx_vlan(pkt, &tci);
+
+	data = (volatile struct e1000_tx_data *)e1000_tx_next(dev);
+	data->addr = POINTER_TO_INT(buf);
+	data->len_cmd = len | TDESC_DTYP_DATA |
+		((TDESC_EOP | TDESC_IFCS | TDESC_RS | TDESC_DEXT | vle |
+		  (mss ? TDESC_TSE : 0U)) << 24);
+	data->sta = 0U;
+	data->popts = popts;
+	data->special = tci;
+
+	return e1000_tx_wait(dev, &data->sta);
+}
+#endif /* CONFIG_ETH_E1000_HW_ACCELERATION */
+
 static int e1000_send(const struct device *ddev, struct net_pkt *pkt)
 {
 	struct e1000_dev *dev = ddev->data;
 	size_t len = net_pkt_get_len(pkt);
 
+	if (len > sizeof(dev->txb)) {
+		return -EMSGSIZE;
+	}
+
 	if (net_pkt_read(pkt, dev->txb, len)) {
 		return -EIO;
 	}
 
-	return e1000_tx(dev, dev->txb, len);
+#if defined(CONFIG_ETH_E1000_HW_ACCELERATION)
+	return e1000_tx_offload(dev, pkt, dev->txb, len);
+#else
+	return e1000_tx(dev, pkt, dev->txb, len);
+#endif
 }
 
 static struct net_pkt *e1000_rx(struct e1000_dev *dev)
@@ -176,52 +350,96 @@ static struct net_pkt *e1000_rx(struct e1000_dev *dev)
 		LOG_ERR("Out of memory for received frame");
 		net_pkt_unref(pkt);
 		pkt = NULL;
+		goto out;
+	}
+
+#if defined(CONFIG_NET_VLAN)
+	if (dev->rx.sta & RDESC_STA_VP) {
+		net_pkt_set_vlan_tci(pkt, dev->rx.special);
 	}
+#endif
 
 out:
 	return pkt;
 }
 
-static void e1000_isr(const struct device *ddev)
+static struct net_if *e1000_rx_iface(struct e1000_dev *dev,
+				     struct net_pkt *pkt)
 {
-	struct e1000_dev *dev = ddev->data;
-	uint32_t icr = ior32(dev, ICR); /* Cleared upon read */
 	uint16_t vlan_tag = NET_VLAN_TAG_UNSPEC;
 
-	icr &= ~(ICR_TXDW | ICR_TXQE);
+#if defined(CONFIG_NET_VLAN)
+	/* The tag was stripped by the controller */
+	if (net_pkt_vlan_tag(pkt) != NET_VLAN_TAG_UNSPEC) {
+		vlan_tag = net_pkt_vlan_tag(pkt);
 
-	if (icr & ICR_RXO) {
-		struct net_pkt *pkt = e1000_rx(dev);
+#if CONFIG_NET_TC_RX_COUNT > 1
+		enum net_priority prio;
 
-		icr &= ~ICR_RXO;
+		prio = net_vlan2priority(net_pkt_vlan_priority(pkt));
+		net_pkt_set_priority(pkt, prio);
+#endif
+	}
+#endif /* CONFIG_NET_VLAN */
 
-		if (pkt) {
-#if defined(CONFIG_NET_VLAN)
-			struct net_eth_hdr *hdr = NET_ETH_HDR(pkt);
+	return get_iface(dev, vlan_tag);
+}
 
-			if (ntohs(hdr->type) == NET_ETH_PTYPE_VLAN) {
-				struct net_eth_vlan_hdr *hdr_vlan =
-					(struct net_eth_vlan_hdr *)
-					NET_ETH_HDR(pkt);
+#if defined(CONFIG_ETH_POLL)
+static int e1000_poll_rx(struct eth_poll *poll, int budget)
+{
+	struct e1000_dev *dev = CONTAINER_OF(poll, struct e1000_dev, rx_poll);
+	struct net_pkt *pkt;
 
-				net_pkt_set_vlan_tci(
-					pkt, ntohs(hdr_vlan->vlan.tci));
-				vlan_tag = net_pkt_vlan_tag(pkt);
+	/* There is a single RX descriptor */
+	if (!(dev->rx.sta & RDESC_STA_DD)) {
+		return 0;
+	}
 
-#if CONFIG_NET_TC_RX_COUNT > 1
-				enum net_priority prio;
+	pkt = e1000_rx(dev);
+	/* Not to receive the frame twice if the next poll comes first */
+	dev->rx.sta = 0U;
 
-				prio = net_vlan2priority(
-						net_pkt_vlan_priority(pkt));
-				net_pkt_set_priority(pkt, prio);
-#endif
-			}
-#endif /* CONFIG_NET_VLAN */
+	if (pkt) {
+		eth_poll_rx(poll, e1000_rx_iface(dev, pkt), pkt);
+	} else {
+		eth_stats_update_errors_rx(
+			get_iface(dev, NET_VLAN_TAG_UNSPEC));
+	}
+
+	return 1;
+}
+
+static void e1000_poll_irq(struct eth_poll *poll, bool enable)
+{
+	struct e1000_dev *dev = CONTAINER_OF(poll, struct e1000_dev, rx_poll);
+
+	iow32(dev, enable ? IMS : IMC, IMS_RXO);
+}
+#endif /* CONFIG_ETH_POLL */
 
-			net_recv_data(get_iface(dev, vlan_tag), pkt);
+static void e1000_isr(const struct device *ddev)
+{
+	struct e1000_dev *dev = ddev->data;
+	uint32_t icr = ior32(dev, ICR); /* Cleared upon read */
+
+	icr &= ~(ICR_TXDW | ICR_TXQE);
+
+	if (icr & ICR_RXO) {
+		icr &= ~ICR_RXO;
+
+#if defined(CONFIG_ETH_POLL)
+		eth_poll_schedule(&dev->rx_poll);
+#else
+		struct net_pkt *pkt = e1000_rx(dev);
+
+		if (pkt) {
+			net_recv_data(e1000_rx_iface(dev, pkt), pkt);
 		} else {
-			eth_stats_update_errors_rx(get_iface(dev, vlan_tag));
+			eth_stats_update_errors_rx(
+			get_iface(dev, NET_VLAN_TAG_UNSPEC));
 		}
+#endif
 	}
 
 	if (icr) {
@@ -253,9 +471,9 @@ int e1000_probe(const struct device *ddev)
 
 	/* Setup TX descriptor */
 
-	iow32(dev, TDBAL, (uint32_t) &dev->tx);
+	iow32(dev, TDBAL, (uint32_t) dev->tx);
 	iow32(dev, TDBAH, 0);
-	iow32(dev, TDLEN, 1*16);
+	iow32(dev, TDLEN, (uint32_t)sizeof(dev->tx));
 
 	iow32(dev, TDH, 0);
 	iow32(dev, TDT, 0);
@@ -274,6 +492,10 @@ int e1000_probe(const struct device *ddev)
 	iow32(dev, RDH, 0);
 	iow32(dev, RDT, 1);
 
+#if defined(CONFIG_ETH_POLL)
+	eth_poll_init(&dev->rx_poll, e1000_poll_rx, e1000_poll_irq);
+#endif
+
 	iow32(dev, IMS, IMS_RXO);
 
 	ral = ior32(dev, RAL);
@@ -303,7 +525,11 @@ static void e1000_iface_init(struct net_if *iface)
 			DT_INST_IRQ(0, sense));
 
 		irq_enable(DT_INST_IRQN(0));
-		iow32(dev, CTRL, CTRL_SLU); /* Set link up */
+		/* Set link up, and have the controller strip and insert
+		 * the VLAN tags
+		 */
+		iow32(dev, CTRL, CTRL_SLU |
+		      (IS_ENABLED(CONFIG_NET_VLAN) ? CTRL_VME : 0U));
 		iow32(dev, RCTL, RCTL_EN | RCTL_MPE);
 	}
 
@@ -7,11 +7,16 @@
 #ifndef ETH_E1000_PRIV_H
 #define ETH_E1000_PRIV_H
 
+#if defined(CONFIG_ETH_POLL)
+#include "eth_poll.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 #define CTRL_SLU	(1 << 6) /* Set Link Up */
+#define CTRL_VME	(1 << 30) /* VLAN Mode Enable */
 
 #define TCTL_EN		(1 << 1)
 #define RCTL_EN		(1 << 1)
@@ -26,10 +31,34 @@ extern "C" {
 
 #define TDESC_EOP	     (1) /* End Of Packet */
 #define TDESC_RS	(1 << 3) /* Report Status */
+#define TDESC_VLE	(1 << 6) /* VLAN Packet Enable */
 
 #define RDESC_STA_DD	     (1) /* Descriptor Done */
+#define RDESC_STA_VP	(1 << 3) /* VLAN Tag Stripped */
 #define TDESC_STA_DD	     (1) /* Descriptor Done */
 
+#define TDESC_IFCS	(1 << 1) /* Insert FCS */
+#define TDESC_TSE	(1 << 2) /* TCP Segmentation Enable */
+#define TDESC_DEXT	(1 << 5) /* Descriptor Extension */
+#define TDESC_DTYP_DATA	(1 << 20) /* Data Descriptor Type */
+
+#define TUCMD_TCP	     (1) /* TCP, else UDP */
+#define TUCMD_IP	(1 << 1) /* IPv4, else IPv6 */
+
+#define POPTS_IXSM	     (1) /* Insert IP Checksum */
+#define POPTS_TXSM	(1 << 1) /* Insert TCP/UDP Checksum */
+
+/* TDLEN has to be a multiple of 128 bytes */
+#define E1000_TX_DESC_COUNT 8
+
+#if defined(CONFIG_ETH_E1000_HW_ACCELERATION) && defined(CONFIG_NET_TCP_TSO)
+/* A TCP segment to split, with the largest IPv4 and TCP headers */
+#define E1000_TX_BUF_SIZE (NET_ETH_MAX_HDR_SIZE + 60 + 60 + \
+			   CONFIG_NET_TCP_TSO_MAX_SIZE)
+#else
+#define E1000_TX_BUF_SIZE NET_ETH_MTU
+#endif
+
 #define ETH_ALEN 6	/* TODO: Add a global reusable definition in OS */
 
 enum e1000_reg_t {
@@ -37,6 +66,7 @@ enum e1000_reg_t {
 	ICR	= 0x00C0,	/* Interrupt Cause Read */
 	ICS	= 0x00C8,	/* Interrupt Cause Set */
 	IMS	= 0x00D0,	/* Interrupt Mask Set */
+	IMC	= 0x00D8,	/* Interrupt Mask Clear */
 	RCTL	= 0x0100,	/* Receive Control */
 	TCTL	= 0x0400,	/* Transmit Control */
 	RDBAL	= 0x2800,	/* Rx Descriptor Base Address Low */
@@ -64,6 +94,29 @@ struct e1000_tx {
 	uint16_t special;
 };
 
+/* TCP/IP Context Descriptor */
+struct e1000_tx_ctx {
+	uint8_t  ipcss;
+	uint8_t  ipcso;
+	uint16_t ipcse;
+	uint8_t  tucss;
+	uint8_t  tucso;
+	uint16_t tucse;
+	uint32_t paylen_cmd; /* PAYLEN, DTYP and TUCMD */
+	uint8_t  sta;
+	uint8_t  hdrlen;
+	uint16_t mss;
+};
+
+/* TCP/IP Data Descriptor */
+struct e1000_tx_data {
+	uint64_t addr;
+	uint32_t len_cmd; /* DTALEN, DTYP and DCMD */
+	uint8_t  sta;
+	uint8_t  popts;
+	uint16_t special;
+};
+
 /* Legacy RX Descriptor */
 struct e1000_rx {
 	uint64_t addr;
@@ -75,8 +128,9 @@ struct e1000_rx {
 };
 
 struct e1000_dev {
-	volatile struct e1000_tx tx __aligned(16);
+	volatile struct e1000_tx tx[E1000_TX_DESC_COUNT] __aligned(16);
 	volatile struct e1000_rx rx __aligned(16);
+	unsigned int tx_tail;
 	mm_reg_t address;
 	/* If VLAN is enabled, there can be multiple VLAN interfaces related to
 	 * this physical device. In that case, this iface pointer value is not
@@ -84,8 +138,11 @@ struct e1000_dev {
 	 */
 	struct net_if *iface;
 	uint8_t mac[ETH_ALEN];
-	uint8_t txb[NET_ETH_MTU];
+	uint8_t txb[E1000_TX_BUF_SIZE];
 	uint8_t rxb[NET_ETH_MTU];
+#if defined(CONFIG_ETH_POLL)
+	struct eth_poll rx_poll;
+#endif
 #if defined(CONFIG_ETH_E1000_PTP_CLOCK)
 	const struct device *ptp_clock;
 	float clk_ratio;
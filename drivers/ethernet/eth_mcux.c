@@ -49,6 +49,9 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <devicetree.h>
 
 #include "eth.h"
+#if defined(CONFIG_ETH_POLL)
+#include "eth_poll.h"
+#endif
 
 #define FREESCALE_OUI_B0 0x00
 #define FREESCALE_OUI_B1 0x04
@@ -142,6 +145,9 @@ struct eth_context {
 	void (*generate_mac)(uint8_t *);
 	struct k_work phy_work;
 	struct k_work_delayable delayed_phy_work;
+#if defined(CONFIG_ETH_POLL)
+	struct eth_poll rx_poll;
+#endif
 	/* TODO: FIXME. This Ethernet frame sized buffer is used for
 	 * interfacing with MCUX. How it works is that hardware uses
 	 * DMA scatter buffers to receive a frame, and then public
@@ -706,7 +712,8 @@ static int eth_tx(const struct device *dev, struct net_pkt *pkt)
 	return 0;
 }
 
-static void eth_rx(struct eth_context *context)
+/* Returns -EAGAIN if there is no frame to receive */
+static int eth_rx(struct eth_context *context)
 {
 	uint16_t vlan_tag = NET_VLAN_TAG_UNSPEC;
 	uint32_t frame_length = 0U;
@@ -722,6 +729,10 @@ static void eth_rx(struct eth_context *context)
 
 	status = ENET_GetRxFrameSize(&context->enet_handle,
 				     (uint32_t *)&frame_length, RING_ID);
+	if (status == kStatus_ENET_RxFrameEmpty) {
+		return -EAGAIN;
+	}
+
 	if (status) {
 		enet_data_error_stats_t error_stats;
 
@@ -816,12 +827,16 @@ static void eth_rx(struct eth_context *context)
 #if IS_ENABLED(CONFIG_NET_DSA)
 	iface = dsa_net_recv(iface, &pkt);
 #endif
+#if defined(CONFIG_ETH_POLL)
+	eth_poll_rx(&context->rx_poll, iface, pkt);
+#else
 	if (net_recv_data(iface, pkt) < 0) {
 		net_pkt_unref(pkt);
 		goto error;
 	}
+#endif
 
-	return;
+	return 0;
 flush:
 	/* Flush the current read buffer.  This operation can
 	 * only report failure if there is no frame to flush,
@@ -832,8 +847,39 @@ flush:
 	__ASSERT_NO_MSG(status == kStatus_Success);
 error:
 	eth_stats_update_errors_rx(get_iface(context, vlan_tag));
+
+	return 0;
 }
 
+#if defined(CONFIG_ETH_POLL)
+static int eth_poll_rx_frames(struct eth_poll *poll, int budget)
+{
+	struct eth_context *context =
+		CONTAINER_OF(poll, struct eth_context, rx_poll);
+	int count;
+
+	for (count = 0; count < budget; count++) {
+		if (eth_rx(context) == -EAGAIN) {
+			break;
+		}
+	}
+
+	return count;
+}
+
+static void eth_poll_irq(struct eth_poll *poll, bool enable)
+{
+	struct eth_context *context =
+		CONTAINER_OF(poll, struct eth_context, rx_poll);
+
+	if (enable) {
+		ENET_EnableInterrupts(context->base, kENET_RxFrameInterrupt);
+	} else {
+		ENET_DisableInterrupts(context->base, kENET_RxFrameInterrupt);
+	}
+}
+#endif /* CONFIG_ETH_POLL */
+
 #if defined(CONFIG_PTP_CLOCK_MCUX) && defined(CONFIG_NET_GPTP)
 static inline void ts_register_tx_event(struct eth_context *context,
 					 enet_frame_info_t *frameinfo)
@@ -878,7 +924,11 @@ static void eth_callback(ENET_Type *base, enet_handle_t *handle,
 
 	switch (event) {
 	case kENET_RxEvent:
+#if defined(CONFIG_ETH_POLL)
+		eth_poll_schedule(&context->rx_poll);
+#else
 		eth_rx(context);
+#endif
 		break;
 	case kENET_TxEvent:
 #if defined(CONFIG_PTP_CLOCK_MCUX) && defined(CONFIG_NET_GPTP)
@@ -1008,6 +1058,9 @@ static int eth_init(const struct device *dev)
 	k_work_init(&context->phy_work, eth_mcux_phy_work);
 	k_work_init_delayable(&context->delayed_phy_work,
 			      eth_mcux_delayed_phy_work);
+#if defined(CONFIG_ETH_POLL)
+	eth_poll_init(&context->rx_poll, eth_poll_rx_frames, eth_poll_irq);
+#endif
 
 	if (context->generate_mac) {
 		context->generate_mac(context->mac_addr);
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define LOG_MODULE_NAME eth_poll
+#define LOG_LEVEL CONFIG_ETHERNET_LOG_LEVEL
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+#include <kernel.h>
+#include <init.h>
+#include <net/net_core.h>
+#include <ethernet/eth_stats.h>
+
+#include "eth_poll.h"
+
+static K_KERNEL_STACK_DEFINE(eth_poll_stack, CONFIG_ETH_POLL_STACK_SIZE);
+static struct k_work_q eth_poll_queue;
+
+/* The frames of each interface are passed on together */
+static void poll_flush(struct eth_poll *poll)
+{
+	struct net_pkt **pkts = poll->batch;
+	struct net_if *iface;
+	int count;
+
+	while (pkts < &poll->batch[poll->count]) {
+		iface = net_pkt_iface(pkts[0]);
+
+		for (count = 1; &pkts[count] < &poll->batch[poll->count];
+		     count++) {
+			if (net_pkt_iface(pkts[count]) != iface) {
+				break;
+			}
+		}
+
+		if (net_recv_data_batch(iface, pkts, count) < 0) {
+			for (int i = 0; i < count; i++) {
+				net_pkt_unref(pkts[i]);
+				eth_stats_update_errors_rx(iface);
+			}
+		}
+
+		pkts += count;
+	}
+
+	poll->count = 0U;
+}
+
+static void poll_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct eth_poll *poll = CONTAINER_OF(dwork, struct eth_poll, work);
+	int count;
+
+	count = poll->rx(poll, CONFIG_ETH_POLL_BUDGET);
+	poll_flush(poll);
+
+	if (count >= CONFIG_ETH_POLL_BUDGET) {
+		/* There are likely more frames, poll again once the other
+		 * devices had their turn.
+		 */
+		k_work_reschedule_for_queue(&eth_poll_queue, dwork, K_NO_WAIT);
+		return;
+	}
+
+	if (CONFIG_ETH_POLL_COALESCE_US > 0 && count > 0) {
+		/* Frames are still coming: wait for a few of them instead of
+		 * taking an interrupt for each. The interrupts are enabled
+		 * again once a poll finds nothing.
+		 */
+		k_work_reschedule_for_queue(&eth_poll_queue, dwork,
+					    K_USEC(CONFIG_ETH_POLL_COALESCE_US));
+		return;
+	}
+
+	poll->irq(poll, true);
+}
+
+void eth_poll_init(struct eth_poll *poll, eth_poll_rx_t rx,
+		   eth_poll_irq_t irq)
+{
+	poll->rx = rx;
+	poll->irq = irq;
+	poll->count = 0U;
+
+	k_work_init_delayable(&poll->work, poll_handler);
+}
+
+void eth_poll_schedule(struct eth_poll *poll)
+{
+	poll->irq(poll, false);
+
+	k_work_reschedule_for_queue(&eth_poll_queue, &poll->work, K_NO_WAIT);
+}
+
+void eth_poll_rx(struct eth_poll *poll, struct net_if *iface,
+		 struct net_pkt *pkt)
+{
+	if (poll->count == ARRAY_SIZE(poll->batch)) {
+		LOG_DBG("More frames than the budget");
+		poll_flush(poll);
+	}
+
+	net_pkt_set_iface(pkt, iface);
+	poll->batch[poll->count++] = pkt;
+}
+
+static int eth_poll_queue_init(const struct device *dev)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "eth_poll",
+	};
+
+	ARG_UNUSED(dev);
+
+	k_work_queue_start(&eth_poll_queue, eth_poll_stack,
+			   K_KERNEL_STACK_SIZEOF(eth_poll_stack),
+			   K_PRIO_COOP(CONFIG_ETH_POLL_THREAD_PRIO), &cfg);
+
+	return 0;
+}
+
+SYS_INIT(eth_poll_queue_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Polled RX for Ethernet drivers.
+ *
+ * The first RX interrupt disables the RX interrupts of the device and
+ * schedules a poll. Each poll receives up to CONFIG_ETH_POLL_BUDGET frames,
+ * which are handed to the network stack together at the end of the poll
+ * with net_recv_data_batch(). The device is polled again as long as it
+ * fills the budget, and the RX interrupts are only enabled again once it is
+ * drained. All the polls run in a common work queue thread.
+ */
+
+#ifndef ZEPHYR_DRIVERS_ETHERNET_ETH_POLL_H_
+#define ZEPHYR_DRIVERS_ETHERNET_ETH_POLL_H_
+
+#include <kernel.h>
+#include <net/net_pkt.h>
+#include <net/net_if.h>
+
+struct eth_poll;
+
+/**
+ * @brief Receive the frames of a device.
+ *
+ * The frames are given to eth_poll_rx().
+ *
+ * @param poll Poll context of the device
+ * @param budget Maximum number of frames to receive
+ *
+ * @return Number of frames taken from the device, including the dropped ones.
+ */
+typedef int (*eth_poll_rx_t)(struct eth_poll *poll, int budget);
+
+/**
+ * @brief Enable or disable the RX interrupts of a device.
+ *
+ * A frame received while the interrupts are disabled must raise the
+ * interrupt once they are enabled again.
+ *
+ * @param poll Poll context of the device
+ * @param enable True to enable the interrupts
+ */
+typedef void (*eth_poll_irq_t)(struct eth_poll *poll, bool enable);
+
+struct eth_poll {
+	struct k_work_delayable work;
+	eth_poll_rx_t rx;
+	eth_poll_irq_t irq;
+	/* Frames received by the current poll */
+	struct net_pkt *batch[CONFIG_ETH_POLL_BUDGET];
+	uint16_t count;
+};
+
+/**
+ * @brief Initialize the poll context of a device.
+ *
+ * @param poll Poll context to initialize
+ * @param rx Callback receiving the frames
+ * @param irq Callback enabling the RX interrupts
+ */
+void eth_poll_init(struct eth_poll *poll, eth_poll_rx_t rx,
+		   eth_poll_irq_t irq);
+
+/**
+ * @brief Disable the RX interrupts and schedule a poll of the device.
+ *
+ * Called from the RX interrupt handler.
+ *
+ * @param poll Poll context of the device
+ */
+void eth_poll_schedule(struct eth_poll *poll);
+
+/**
+ * @brief Hand a received frame over to the network stack.
+ *
+ * Called from the RX callback. The frame is passed on at the end of the
+ * poll, or dropped if the network stack does not take it.
+ *
+ * @param poll Poll context of the device
+ * @param iface Interface receiving the frame
+ * @param pkt Received frame
+ */
+void eth_poll_rx(struct eth_poll *poll, struct net_if *iface,
+		 struct net_pkt *pkt);
+
+#endif /* ZEPHYR_DRIVERS_ETHERNET_ETH_POLL_H_ */
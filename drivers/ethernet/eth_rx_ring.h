@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Zero-copy RX for Ethernet drivers with a DMA descriptor ring.
+ *
+ * Each RX descriptor is given the data of a net_buf to receive into, and
+ * the net_buf of a completed descriptor is added to the received net_pkt
+ * as it is. A new net_buf is taken for the descriptor at the same time,
+ * so a descriptor is never left without a buffer: when none is left, the
+ * frame is dropped and the descriptor keeps its buffer.
+ */
+
+#ifndef ZEPHYR_DRIVERS_ETHERNET_ETH_RX_RING_H_
+#define ZEPHYR_DRIVERS_ETHERNET_ETH_RX_RING_H_
+
+#include <errno.h>
+#include <net/buf.h>
+#include <net/net_pkt.h>
+
+/* Define a pool of RX buffers of _data_size bytes, with the data placed
+ * with the _attr attributes, e.g. in a DMA capable memory section.
+ */
+#define ETH_RX_BUF_POOL_DEFINE(_name, _count, _data_size, _attr)	      \
+	static struct net_buf net_buf_##_name[_count] __noinit;	      \
+	static uint8_t net_buf_data_##_name[_count][_data_size] _attr;	      \
+	static const struct net_buf_pool_fixed net_buf_fixed_##_name = {      \
+		.data_size = _data_size,				      \
+		.data_pool = (uint8_t *)net_buf_data_##_name,		      \
+	};								      \
+	static const struct net_buf_data_alloc net_buf_fixed_alloc_##_name = {\
+		.cb = &net_buf_fixed_cb,				      \
+		.alloc_data = (void *)&net_buf_fixed_##_name,		      \
+	};								      \
+	static struct net_buf_pool _name __net_buf_align		      \
+			__in_section(_net_buf_pool, static, _name) =	      \
+		NET_BUF_POOL_INITIALIZER(_name, &net_buf_fixed_alloc_##_name, \
+					 net_buf_##_name, _count, NULL)
+
+struct eth_rx_ring {
+	/* Buffer given to each descriptor */
+	struct net_buf **bufs;
+	/* Pool of the buffers, NULL for the network RX data pool */
+	struct net_buf_pool *pool;
+	uint16_t count;
+};
+
+static inline struct net_buf *eth_rx_ring_alloc(struct eth_rx_ring *ring)
+{
+	if (ring->pool) {
+		return net_buf_alloc(ring->pool, K_NO_WAIT);
+	}
+
+	return net_pkt_get_reserve_rx_data(K_NO_WAIT);
+}
+
+static inline void eth_rx_ring_free(struct eth_rx_ring *ring)
+{
+	for (int i = 0; i < ring->count; i++) {
+		if (ring->bufs[i]) {
+			net_buf_unref(ring->bufs[i]);
+			ring->bufs[i] = NULL;
+		}
+	}
+}
+
+/**
+ * @brief Give a buffer to each descriptor of the ring.
+ *
+ * @param ring Ring to initialize
+ * @param bufs Array of count entries, for the buffers of the descriptors
+ * @param count Number of descriptors
+ * @param pool Pool to take the buffers from, NULL for the network RX data
+ *        pool
+ *
+ * @return 0 on success, -ENOBUFS if there are not enough buffers.
+ */
+static inline int eth_rx_ring_init(struct eth_rx_ring *ring,
+				   struct net_buf **bufs, uint16_t count,
+				   struct net_buf_pool *pool)
+{
+	ring->bufs = bufs;
+	ring->pool = pool;
+	ring->count = count;
+
+	for (int i = 0; i < count; i++) {
+		bufs[i] = NULL;
+	}
+
+	for (int i = 0; i < count; i++) {
+		bufs[i] = eth_rx_ring_alloc(ring);
+		if (!bufs[i]) {
+			eth_rx_ring_free(ring);
+			return -ENOBUFS;
+		}
+	}
+
+	return 0;
+}
+
+/* Buffer the descriptor idx receives into */
+static inline struct net_buf *eth_rx_ring_buf(struct eth_rx_ring *ring,
+					      uint16_t idx)
+{
+	return ring->bufs[idx];
+}
+
+/**
+ * @brief Take the buffer of a completed descriptor.
+ *
+ * The descriptor gets a new buffer, to be given to the hardware with
+ * eth_rx_ring_buf().
+ *
+ * @param ring Ring of the descriptor
+ * @param idx Index of the descriptor
+ * @param len Length of the data received in the buffer
+ *
+ * @return The buffer with the received data, or NULL if there is no new
+ * buffer for the descriptor. The descriptor then keeps its buffer, and the
+ * data is lost.
+ */
+static inline struct net_buf *eth_rx_ring_take(struct eth_rx_ring *ring,
+					       uint16_t idx, size_t len)
+{
+	struct net_buf *buf = ring->bufs[idx];
+	struct net_buf *new_buf;
+
+	new_buf = eth_rx_ring_alloc(ring);
+	if (!new_buf) {
+		return NULL;
+	}
+
+	ring->bufs[idx] = new_buf;
+	net_buf_add(buf, len);
+
+	return buf;
+}
+
+/**
+ * @brief Add the buffer of a completed descriptor to a received packet.
+ *
+ * @param ring Ring of the descriptor
+ * @param pkt Packet being received
+ * @param idx Index of the descriptor
+ * @param len Length of the data received in the buffer
+ *
+ * @return 0 on success, -ENOBUFS if the data was lost.
+ */
+static inline int eth_rx_ring_add_to_pkt(struct eth_rx_ring *ring,
+					 struct net_pkt *pkt, uint16_t idx,
+					 size_t len)
+{
+	struct net_buf *buf;
+
+	buf = eth_rx_ring_take(ring, idx, len);
+	if (!buf) {
+		return -ENOBUFS;
+	}
+
+	net_pkt_frag_add(pkt, buf);
+
+	return 0;
+}
+
+#endif /* ZEPHYR_DRIVERS_ETHERNET_ETH_RX_RING_H_ */
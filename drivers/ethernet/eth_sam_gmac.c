@@ -235,6 +235,10 @@ static struct net_pkt *tx_frame_list_que5[CONFIG_NET_PKT_TX_COUNT + 1];
 static int rx_descriptors_init(Gmac *gmac, struct gmac_queue *queue);
 static void tx_descriptors_init(Gmac *gmac, struct gmac_queue *queue);
 static int nonpriority_queue_init(Gmac *gmac, struct gmac_queue *queue);
+#if defined(CONFIG_ETH_POLL)
+static int eth_poll_rx_frames(struct eth_poll *poll, int budget);
+static void eth_poll_irq(struct eth_poll *poll, bool enable);
+#endif
 
 #if GMAC_PRIORITY_QUEUE_NUM >= 1
 static inline void set_receive_buf_queue_pointer(
@@ -283,6 +287,10 @@ static int priority_queue_init(Gmac *gmac, struct gmac_queue *queue)
 
 	tx_descriptors_init(gmac, queue);
 
+#if defined(CONFIG_ETH_POLL)
+	eth_poll_init(&queue->rx_poll, eth_poll_rx_frames, eth_poll_irq);
+#endif
+
 #if GMAC_MULTIPLE_TX_PACKETS == 0
 	k_sem_init(&queue->tx_sem, 0, 1);
 #else
@@ -429,19 +437,6 @@ static void ring_buf_put(struct ring_buf *rb, uint32_t val)
 }
 #endif
 
-/*
- * Free pre-reserved RX buffers
- */
-static void free_rx_bufs(struct net_buf **rx_frag_list, uint16_t len)
-{
-	for (int i = 0; i < len; i++) {
-		if (rx_frag_list[i]) {
-			net_buf_unref(rx_frag_list[i]);
-			rx_frag_list[i] = NULL;
-		}
-	}
-}
-
 /*
  * Set MAC Address for frame filtering logic
  */
@@ -464,24 +459,21 @@ static void mac_addr_set(Gmac *gmac, uint8_t index,
 static int rx_descriptors_init(Gmac *gmac, struct gmac_queue *queue)
 {
 	struct gmac_desc_list *rx_desc_list = &queue->rx_desc_list;
-	struct net_buf **rx_frag_list = queue->rx_frag_list;
 	struct net_buf *rx_buf;
 	uint8_t *rx_buf_addr;
 
-	__ASSERT_NO_MSG(rx_frag_list);
+	__ASSERT_NO_MSG(queue->rx_frag_list);
 
 	rx_desc_list->tail = 0U;
 
-	for (int i = 0; i < rx_desc_list->len; i++) {
-		rx_buf = net_pkt_get_reserve_rx_data(K_NO_WAIT);
-		if (rx_buf == NULL) {
-			free_rx_bufs(rx_frag_list, rx_desc_list->len);
-			LOG_ERR("Failed to reserve data net buffers");
-			return -ENOBUFS;
-		}
-
-		rx_frag_list[i] = rx_buf;
+	if (eth_rx_ring_init(&queue->rx_ring, queue->rx_frag_list,
+			     rx_desc_list->len, NULL) < 0) {
+		LOG_ERR("Failed to reserve data net buffers");
+		return -ENOBUFS;
+	}
 
+	for (int i = 0; i < rx_desc_list->len; i++) {
+		rx_buf = eth_rx_ring_buf(&queue->rx_ring, i);
 		rx_buf_addr = rx_buf->data;
 		__ASSERT(!((uint32_t)rx_buf_addr & ~GMAC_RXW0_ADDR),
 			 "Misaligned RX buffer address");
@@ -1189,6 +1181,10 @@ static int nonpriority_queue_init(Gmac *gmac, struct gmac_queue *queue)
 
 	tx_descriptors_init(gmac, queue);
 
+#if defined(CONFIG_ETH_POLL)
+	eth_poll_init(&queue->rx_poll, eth_poll_rx_frames, eth_poll_irq);
+#endif
+
 #if GMAC_MULTIPLE_TX_PACKETS == 0
 	/* Initialize TX semaphore. This semaphore is used to wait until the TX
 	 * data has been sent.
@@ -1233,12 +1229,9 @@ static struct net_pkt *frame_get(struct gmac_queue *queue)
 {
 	struct gmac_desc_list *rx_desc_list = &queue->rx_desc_list;
 	struct gmac_desc *rx_desc;
-	struct net_buf **rx_frag_list = queue->rx_frag_list;
 	struct net_pkt *rx_frame;
 	bool frame_is_complete;
 	struct net_buf *frag;
-	struct net_buf *new_frag;
-	struct net_buf *last_frag = NULL;
 	uint8_t *frag_data;
 	uint32_t frag_len;
 	uint32_t frame_len = 0U;
@@ -1283,7 +1276,7 @@ static struct net_pkt *frame_get(struct gmac_queue *queue)
 	 */
 	while ((rx_desc->w0 & GMAC_RXW0_OWNERSHIP)
 	       && !frame_is_complete) {
-		frag = rx_frag_list[tail];
+		frag = eth_rx_ring_buf(&queue->rx_ring, tail);
 		frag_data =
 			(uint8_t *)(rx_desc->w0 & GMAC_RXW0_ADDR);
 		__ASSERT(frag->data == frag_data,
@@ -1302,53 +1295,53 @@ static struct net_pkt *frame_get(struct gmac_queue *queue)
 			/* Assure cache coherency after DMA write operation */
 			dcache_invalidate((uint32_t)frag_data, frag->size);
 
-			/* Get a new data net buffer from the buffer pool */
-			new_frag = net_pkt_get_frag(rx_frame, K_NO_WAIT);
-			if (new_frag == NULL) {
+			/* Hand the fragment over, the descriptor gets a new
+			 * data net buffer from the buffer pool
+			 */
+			if (eth_rx_ring_add_to_pkt(&queue->rx_ring, rx_frame,
+						   tail, frag_len) < 0) {
 				queue->err_rx_frames_dropped++;
 				net_pkt_unref(rx_frame);
 				rx_frame = NULL;
-			} else {
-				net_buf_add(frag, frag_len);
-				if (!last_frag) {
-					net_pkt_frag_insert(rx_frame, frag);
-				} else {
-					net_buf_frag_insert(last_frag, frag);
-				}
-				last_frag = frag;
-				frag = new_frag;
-				rx_frag_list[tail] = frag;
 			}
 		}
 
 		/* Update buffer descriptor status word */
 		rx_desc->w1 = 0U;
-		/* Guarantee that status word is written before the address
-		 * word to avoid race condition.
-		 */
-		__DMB();  /* data memory barrier */
-		/* Update buffer descriptor address word */
-		wrap = (tail == rx_desc_list->len-1U ? GMAC_RXW0_WRAP : 0);
-		rx_desc->w0 = ((uint32_t)frag->data & GMAC_RXW0_ADDR) | wrap;
 
 		MODULO_INC(tail, rx_desc_list->len);
 		rx_desc = &rx_desc_list->buf[tail];
 	}
 
-	rx_desc_list->tail = tail;
+	/* Guarantee that the status words are written before the address
+	 * words to avoid race condition. One barrier covers all the
+	 * descriptors of the frame.
+	 */
+	__DMB();  /* data memory barrier */
+
+	/* Give the descriptors back to GMAC with their new buffers */
+	while (rx_desc_list->tail != tail) {
+		frag = eth_rx_ring_buf(&queue->rx_ring, rx_desc_list->tail);
+		wrap = (rx_desc_list->tail == rx_desc_list->len-1U ?
+			GMAC_RXW0_WRAP : 0);
+		rx_desc_list->buf[rx_desc_list->tail].w0 =
+			((uint32_t)frag->data & GMAC_RXW0_ADDR) | wrap;
+		MODULO_INC(rx_desc_list->tail, rx_desc_list->len);
+	}
+
 	LOG_DBG("Frame complete: rx=%p, tail=%d", rx_frame, tail);
 	__ASSERT_NO_MSG(frame_is_complete);
 
 	return rx_frame;
 }
 
-static void eth_rx(struct gmac_queue *queue)
+static struct net_if *rx_frame_iface(struct gmac_queue *queue,
+				     struct net_pkt *rx_frame)
 {
 	struct eth_sam_dev_data *dev_data =
 		CONTAINER_OF(queue, struct eth_sam_dev_data,
 			     queue_list[queue->que_idx]);
 	uint16_t vlan_tag = NET_VLAN_TAG_UNSPEC;
-	struct net_pkt *rx_frame;
 #if defined(CONFIG_NET_GPTP)
 	const struct device *const dev = net_if_get_device(dev_data->iface);
 	const struct eth_sam_dev_cfg *const cfg = DEV_CFG(dev);
@@ -1356,62 +1349,116 @@ static void eth_rx(struct gmac_queue *queue)
 	struct gptp_hdr *hdr;
 #endif
 
-	/* More than one frame could have been received by GMAC, get all
-	 * complete frames stored in the GMAC RX descriptor list.
-	 */
-	rx_frame = frame_get(queue);
-	while (rx_frame) {
-		LOG_DBG("ETH rx");
+	LOG_DBG("ETH rx");
 
 #if defined(CONFIG_NET_VLAN)
-		/* FIXME: Instead of this, use the GMAC register to get
-		 * the used VLAN tag.
-		 */
-		{
-			struct net_eth_hdr *hdr = NET_ETH_HDR(rx_frame);
+	/* FIXME: Instead of this, use the GMAC register to get
+	 * the used VLAN tag.
+	 */
+	{
+		struct net_eth_hdr *hdr = NET_ETH_HDR(rx_frame);
 
-			if (ntohs(hdr->type) == NET_ETH_PTYPE_VLAN) {
-				struct net_eth_vlan_hdr *hdr_vlan =
-					(struct net_eth_vlan_hdr *)
-					NET_ETH_HDR(rx_frame);
+		if (ntohs(hdr->type) == NET_ETH_PTYPE_VLAN) {
+			struct net_eth_vlan_hdr *hdr_vlan =
+				(struct net_eth_vlan_hdr *)
+				NET_ETH_HDR(rx_frame);
 
-				net_pkt_set_vlan_tci(rx_frame,
-						    ntohs(hdr_vlan->vlan.tci));
-				vlan_tag = net_pkt_vlan_tag(rx_frame);
+			net_pkt_set_vlan_tci(rx_frame,
+					    ntohs(hdr_vlan->vlan.tci));
+			vlan_tag = net_pkt_vlan_tag(rx_frame);
 
 #if CONFIG_NET_TC_RX_COUNT > 1
-				{
-					enum net_priority prio;
+			{
+				enum net_priority prio;
 
-					prio = net_vlan2priority(
-					      net_pkt_vlan_priority(rx_frame));
-					net_pkt_set_priority(rx_frame, prio);
-				}
-#endif
+				prio = net_vlan2priority(
+				      net_pkt_vlan_priority(rx_frame));
+				net_pkt_set_priority(rx_frame, prio);
 			}
+#endif
 		}
+	}
 #endif
 #if defined(CONFIG_NET_GPTP)
-		hdr = check_gptp_msg(get_iface(dev_data, vlan_tag), rx_frame,
-				     false);
+	hdr = check_gptp_msg(get_iface(dev_data, vlan_tag), rx_frame,
+			     false);
 
-		timestamp_rx_pkt(gmac, hdr, rx_frame);
+	timestamp_rx_pkt(gmac, hdr, rx_frame);
 
-		if (hdr) {
-			update_pkt_priority(hdr, rx_frame);
-		}
+	if (hdr) {
+		update_pkt_priority(hdr, rx_frame);
+	}
 #endif /* CONFIG_NET_GPTP */
 
-		if (net_recv_data(get_iface(dev_data, vlan_tag),
-				  rx_frame) < 0) {
-			eth_stats_update_errors_rx(get_iface(dev_data,
-							     vlan_tag));
+	return get_iface(dev_data, vlan_tag);
+}
+
+#if defined(CONFIG_ETH_POLL)
+static int eth_poll_rx_frames(struct eth_poll *poll, int budget)
+{
+	struct gmac_queue *queue = CONTAINER_OF(poll, struct gmac_queue,
+						rx_poll);
+	struct net_pkt *rx_frame;
+	int count;
+
+	for (count = 0; count < budget; count++) {
+		rx_frame = frame_get(queue);
+		if (!rx_frame) {
+			break;
+		}
+
+		eth_poll_rx(poll, rx_frame_iface(queue, rx_frame), rx_frame);
+	}
+
+	return count;
+}
+
+static void eth_poll_irq(struct eth_poll *poll, bool enable)
+{
+	struct gmac_queue *queue = CONTAINER_OF(poll, struct gmac_queue,
+						rx_poll);
+	Gmac *gmac = DEV_CFG(DEVICE_DT_INST_GET(0))->regs;
+
+#if GMAC_PRIORITY_QUEUE_NUM >= 1
+	if (queue->que_idx != GMAC_QUE_0) {
+		if (enable) {
+			gmac->GMAC_IERPQ[queue->que_idx - 1] = GMAC_IERPQ_RCOMP;
+		} else {
+			gmac->GMAC_IDRPQ[queue->que_idx - 1] = GMAC_IDRPQ_RCOMP;
+		}
+
+		return;
+	}
+#endif
+
+	if (enable) {
+		gmac->GMAC_IER = GMAC_IER_RCOMP;
+	} else {
+		gmac->GMAC_IDR = GMAC_IDR_RCOMP;
+	}
+}
+#else
+static void eth_rx(struct gmac_queue *queue)
+{
+	struct net_pkt *rx_frame;
+	struct net_if *iface;
+
+	/* More than one frame could have been received by GMAC, get all
+	 * complete frames stored in the GMAC RX descriptor list.
+	 */
+	rx_frame = frame_get(queue);
+	while (rx_frame) {
+		iface = rx_frame_iface(queue, rx_frame);
+
+		if (net_recv_data(iface, rx_frame) < 0) {
+			eth_stats_update_errors_rx(iface);
 			net_pkt_unref(rx_frame);
 		}
 
 		rx_frame = frame_get(queue);
 	}
 }
+#endif /* CONFIG_ETH_POLL */
 
 #if !defined(CONFIG_ETH_SAM_GMAC_FORCE_QUEUE) && \
 	((GMAC_ACTIVE_QUEUE_NUM != NET_TC_TX_COUNT) || \
@@ -1653,7 +1700,11 @@ static void queue0_isr(const struct device *dev)
 		LOG_DBG("rx.w1=0x%08x, tail=%d",
 			tail_desc->w1,
 			rx_desc_list->tail);
+#if defined(CONFIG_ETH_POLL)
+		eth_poll_schedule(&queue->rx_poll);
+#else
 		eth_rx(queue);
+#endif
 	}
 
 	/* TX packet */
@@ -1703,7 +1754,11 @@ static inline void priority_queue_isr(const struct device *dev,
 		LOG_DBG("rx.w1=0x%08x, tail=%d",
 			tail_desc->w1,
 			rx_desc_list->tail);
+#if defined(CONFIG_ETH_POLL)
+		eth_poll_schedule(&queue->rx_poll);
+#else
 		eth_rx(queue);
+#endif
 	}
 
 	/* TX packet */
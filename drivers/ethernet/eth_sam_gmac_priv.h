@@ -12,6 +12,11 @@
 
 #include <zephyr/types.h>
 
+#include "eth_rx_ring.h"
+#if defined(CONFIG_ETH_POLL)
+#include "eth_poll.h"
+#endif
+
 #define ATMEL_OUI_B0 0x00
 #define ATMEL_OUI_B1 0x04
 #define ATMEL_OUI_B2 0x25
@@ -240,6 +245,10 @@ struct gmac_queue {
 #endif
 
 	struct net_buf **rx_frag_list;
+	struct eth_rx_ring rx_ring;
+#if defined(CONFIG_ETH_POLL)
+	struct eth_poll rx_poll;
+#endif
 
 #if GMAC_MULTIPLE_TX_PACKETS == 1
 	struct ring_buf tx_frag_list;
@@ -30,6 +30,9 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 
 #include "eth.h"
 #include "eth_stm32_hal_priv.h"
+#if defined(CONFIG_ETH_STM32_HAL_RX_ZERO_COPY)
+#include "eth_rx_ring.h"
+#endif
 
 #if defined(CONFIG_ETH_STM32_HAL_USE_DTCM_FOR_DMA_BUFFER) && \
 	    !DT_NODE_HAS_STATUS(DT_CHOSEN(zephyr_dtcm), okay)
@@ -83,7 +86,16 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 
 static ETH_DMADescTypeDef dma_rx_desc_tab[ETH_RXBUFNB] __eth_stm32_desc;
 static ETH_DMADescTypeDef dma_tx_desc_tab[ETH_TXBUFNB] __eth_stm32_desc;
+#if defined(CONFIG_ETH_STM32_HAL_RX_ZERO_COPY)
+/* The RX descriptors receive straight into the net buffers of the frames */
+ETH_RX_BUF_POOL_DEFINE(eth_rx_pool,
+		       ETH_RXBUFNB + CONFIG_ETH_STM32_HAL_RX_ZERO_COPY_BUFS,
+		       ETH_RX_BUF_SIZE, __eth_stm32_buf);
+static struct net_buf *dma_rx_bufs[ETH_RXBUFNB];
+static struct eth_rx_ring dma_rx_ring;
+#else
 static uint8_t dma_rx_buffer[ETH_RXBUFNB][ETH_RX_BUF_SIZE] __eth_stm32_buf;
+#endif
 static uint8_t dma_tx_buffer[ETH_TXBUFNB][ETH_TX_BUF_SIZE] __eth_stm32_buf;
 
 #if defined(CONFIG_SOC_SERIES_STM32H7X)
@@ -341,7 +353,9 @@ static struct net_pkt *eth_rx(const struct device *dev, uint16_t *vlan_tag)
 #endif /* !CONFIG_SOC_SERIES_STM32H7X */
 	struct net_pkt *pkt;
 	size_t total_len;
+#if !defined(CONFIG_ETH_STM32_HAL_RX_ZERO_COPY)
 	uint8_t *dma_buffer;
+#endif
 	HAL_StatusTypeDef hal_ret = HAL_OK;
 
 	__ASSERT_NO_MSG(dev != NULL);
@@ -385,9 +399,38 @@ static struct net_pkt *eth_rx(const struct device *dev, uint16_t *vlan_tag)
 	}
 
 	total_len = heth->RxFrameInfos.length;
+#if !defined(CONFIG_ETH_STM32_HAL_RX_ZERO_COPY)
 	dma_buffer = (uint8_t *)heth->RxFrameInfos.buffer;
+#endif
 #endif /* CONFIG_SOC_SERIES_STM32H7X */
 
+#if defined(CONFIG_ETH_STM32_HAL_RX_ZERO_COPY)
+	pkt = net_pkt_rx_alloc_on_iface(get_iface(dev_data, *vlan_tag),
+					K_NO_WAIT);
+	if (!pkt) {
+		LOG_ERR("Failed to obtain RX buffer");
+		goto release_desc;
+	}
+
+	/* Hand the buffers of the segments over to the packet */
+	dma_rx_desc = heth->RxFrameInfos.FSRxDesc;
+	for (int i = 0; i < heth->RxFrameInfos.SegCount; i++) {
+		size_t len = MIN(total_len, ETH_RX_BUF_SIZE);
+
+		if (eth_rx_ring_add_to_pkt(&dma_rx_ring, pkt,
+					   dma_rx_desc - dma_rx_desc_tab,
+					   len) < 0) {
+			LOG_ERR("Failed to obtain RX buffer");
+			net_pkt_unref(pkt);
+			pkt = NULL;
+			goto release_desc;
+		}
+
+		total_len -= len;
+		dma_rx_desc = (ETH_DMADescTypeDef *)
+			(dma_rx_desc->Buffer2NextDescAddr);
+	}
+#else
 	pkt = net_pkt_rx_alloc_with_buffer(get_iface(dev_data, *vlan_tag),
 					   total_len, AF_UNSPEC, 0, K_NO_WAIT);
 	if (!pkt) {
@@ -401,6 +444,7 @@ static struct net_pkt *eth_rx(const struct device *dev, uint16_t *vlan_tag)
 		pkt = NULL;
 		goto release_desc;
 	}
+#endif /* CONFIG_ETH_STM32_HAL_RX_ZERO_COPY */
 
 release_desc:
 #if defined(CONFIG_SOC_SERIES_STM32H7X)
@@ -414,6 +458,12 @@ release_desc:
 	dma_rx_desc = heth->RxFrameInfos.FSRxDesc;
 	/* Set Own bit in Rx descriptors: gives the buffers back to DMA */
 	for (int i = 0; i < heth->RxFrameInfos.SegCount; i++) {
+#if defined(CONFIG_ETH_STM32_HAL_RX_ZERO_COPY)
+		/* The buffer must be set before the DMA owns the descriptor */
+		dma_rx_desc->Buffer1Addr = (uint32_t)eth_rx_ring_buf(
+			&dma_rx_ring, dma_rx_desc - dma_rx_desc_tab)->data;
+		__DMB();
+#endif
 		dma_rx_desc->Status |= ETH_DMARXDESC_OWN;
 		dma_rx_desc = (ETH_DMADescTypeDef *)
 			(dma_rx_desc->Buffer2NextDescAddr);
@@ -525,6 +575,53 @@ static void rx_thread(void *arg1, void *unused1, void *unused2)
 	}
 }
 
+#if defined(CONFIG_ETH_POLL)
+#if defined(CONFIG_SOC_SERIES_STM32H7X)
+#define ETH_DMA_IT_RX ETH_DMACIER_RIE
+#else
+#define ETH_DMA_IT_RX ETH_DMA_IT_R
+#endif
+
+static int eth_poll_rx_frames(struct eth_poll *poll, int budget)
+{
+	const struct device *dev = DEVICE_DT_INST_GET(0);
+	struct eth_stm32_hal_dev_data *dev_data =
+		CONTAINER_OF(poll, struct eth_stm32_hal_dev_data, rx_poll);
+	uint16_t vlan_tag = NET_VLAN_TAG_UNSPEC;
+	struct net_pkt *pkt;
+	int count;
+
+	for (count = 0; count < budget; count++) {
+		pkt = eth_rx(dev, &vlan_tag);
+		if (!pkt) {
+			break;
+		}
+
+		eth_poll_rx(poll, net_pkt_iface(pkt), pkt);
+	}
+
+	if (count > 0 && dev_data->link_up != true) {
+		dev_data->link_up = true;
+		net_eth_carrier_on(get_iface(dev_data, vlan_tag));
+	}
+
+	return count;
+}
+
+static void eth_poll_irq(struct eth_poll *poll, bool enable)
+{
+	struct eth_stm32_hal_dev_data *dev_data =
+		CONTAINER_OF(poll, struct eth_stm32_hal_dev_data, rx_poll);
+	ETH_HandleTypeDef *heth = &dev_data->heth;
+
+	if (enable) {
+		__HAL_ETH_DMA_ENABLE_IT(heth, ETH_DMA_IT_RX);
+	} else {
+		__HAL_ETH_DMA_DISABLE_IT(heth, ETH_DMA_IT_RX);
+	}
+}
+#endif /* CONFIG_ETH_POLL */
+
 static void eth_isr(const struct device *dev)
 {
 	struct eth_stm32_hal_dev_data *dev_data;
@@ -612,7 +709,12 @@ void HAL_ETH_RxCpltCallback(ETH_HandleTypeDef *heth_handle)
 
 	__ASSERT_NO_MSG(dev_data != NULL);
 
+#if defined(CONFIG_ETH_POLL)
+	/* The RX thread is left with the link status checks */
+	eth_poll_schedule(&dev_data->rx_poll);
+#else
 	k_sem_give(&dev_data->rx_int_sem);
+#endif
 }
 
 #if defined(CONFIG_ETH_STM32_HAL_RANDOM_MAC)
@@ -711,6 +813,10 @@ static int eth_initialize(const struct device *dev)
 	k_sem_init(&dev_data->tx_int_sem, 0, K_SEM_MAX_LIMIT);
 #endif /* CONFIG_SOC_SERIES_STM32H7X */
 
+#if defined(CONFIG_ETH_POLL)
+	eth_poll_init(&dev_data->rx_poll, eth_poll_rx_frames, eth_poll_irq);
+#endif
+
 	/* Start interruption-poll thread */
 	k_thread_create(&dev_data->rx_thread, dev_data->rx_thread_stack,
 			K_KERNEL_STACK_SIZEOF(dev_data->rx_thread_stack),
@@ -735,8 +841,26 @@ static int eth_initialize(const struct device *dev)
 #else
 	HAL_ETH_DMATxDescListInit(heth, dma_tx_desc_tab,
 		&dma_tx_buffer[0][0], ETH_TXBUFNB);
+#if defined(CONFIG_ETH_STM32_HAL_RX_ZERO_COPY)
+	if (eth_rx_ring_init(&dma_rx_ring, dma_rx_bufs, ETH_RXBUFNB,
+			     &eth_rx_pool) < 0) {
+		LOG_ERR("Failed to reserve RX buffers");
+		return -ENOBUFS;
+	}
+
+	/* The HAL expects contiguous buffers, point each descriptor to its
+	 * net buffer before the DMA is started.
+	 */
+	HAL_ETH_DMARxDescListInit(heth, dma_rx_desc_tab,
+		eth_rx_ring_buf(&dma_rx_ring, 0)->data, ETH_RXBUFNB);
+	for (int i = 0; i < ETH_RXBUFNB; i++) {
+		dma_rx_desc_tab[i].Buffer1Addr =
+			(uint32_t)eth_rx_ring_buf(&dma_rx_ring, i)->data;
+	}
+#else
 	HAL_ETH_DMARxDescListInit(heth, dma_rx_desc_tab,
 		&dma_rx_buffer[0][0], ETH_RXBUFNB);
+#endif
 
 	hal_ret = HAL_ETH_Start(heth);
 #endif /* CONFIG_SOC_SERIES_STM32H7X */
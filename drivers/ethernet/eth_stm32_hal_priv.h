@@ -9,6 +9,10 @@
 #include <kernel.h>
 #include <zephyr/types.h>
 
+#if defined(CONFIG_ETH_POLL)
+#include "eth_poll.h"
+#endif
+
 #define ST_OUI_B0 0x00
 #define ST_OUI_B1 0x80
 #define ST_OUI_B2 0xE1
@@ -48,6 +52,9 @@ struct eth_stm32_hal_dev_data {
 	K_KERNEL_STACK_MEMBER(rx_thread_stack,
 		CONFIG_ETH_STM32_HAL_RX_THREAD_STACK_SIZE);
 	struct k_thread rx_thread;
+#if defined(CONFIG_ETH_POLL)
+	struct eth_poll rx_poll;
+#endif
 	bool link_up;
 };
 
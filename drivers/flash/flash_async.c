@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <init.h>
+#include <errno.h>
+#include <sys/slist.h>
+#include <drivers/flash.h>
+
+static K_KERNEL_STACK_DEFINE(flash_async_stack, CONFIG_FLASH_ASYNC_STACK_SIZE);
+static struct k_work_q flash_async_queue;
+
+static sys_slist_t flash_async_ops;
+static struct k_spinlock flash_async_lock;
+
+static int flash_async_run(struct flash_async_op *op)
+{
+	switch (op->type) {
+	case FLASH_ASYNC_READ:
+		return flash_read(op->dev, op->offset, op->data, op->len);
+	case FLASH_ASYNC_WRITE:
+		return flash_write(op->dev, op->offset, op->data, op->len);
+	default:
+		return flash_erase(op->dev, op->offset, op->len);
+	}
+}
+
+static void flash_async_handler(struct k_work *work)
+{
+	struct k_poll_signal *signal;
+	struct flash_async_op *op;
+	flash_async_cb_t cb;
+	k_spinlock_key_t key;
+	sys_snode_t *node;
+	int rc;
+
+	ARG_UNUSED(work);
+
+	for (;;) {
+		key = k_spin_lock(&flash_async_lock);
+		node = sys_slist_get(&flash_async_ops);
+		k_spin_unlock(&flash_async_lock, key);
+
+		if (!node) {
+			break;
+		}
+
+		op = CONTAINER_OF(node, struct flash_async_op, node);
+		rc = flash_async_run(op);
+
+		/* The operation is given back by its completion, it may be
+		 * submitted again by the callback or by the thread waiting
+		 * for the signal.
+		 */
+		cb = op->cb;
+		signal = op->signal;
+
+		if (cb) {
+			cb(op->dev, op, rc);
+		}
+
+		if (signal) {
+			k_poll_signal_raise(signal, rc);
+		}
+	}
+}
+
+static K_WORK_DEFINE(flash_async_work, flash_async_handler);
+
+int flash_async_submit(const struct device *dev, struct flash_async_op *op)
+{
+	k_spinlock_key_t key;
+
+	if (op->type != FLASH_ASYNC_READ && op->type != FLASH_ASYNC_WRITE &&
+	    op->type != FLASH_ASYNC_ERASE) {
+		return -EINVAL;
+	}
+
+	op->dev = dev;
+
+	key = k_spin_lock(&flash_async_lock);
+	sys_slist_append(&flash_async_ops, &op->node);
+	k_spin_unlock(&flash_async_lock, key);
+
+	k_work_submit_to_queue(&flash_async_queue, &flash_async_work);
+
+	return 0;
+}
+
+static int flash_async_init(const struct device *dev)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "flash_async",
+	};
+
+	ARG_UNUSED(dev);
+
+	k_work_queue_start(&flash_async_queue, flash_async_stack,
+			   K_KERNEL_STACK_SIZEOF(flash_async_stack),
+			   K_PRIO_PREEMPT(CONFIG_FLASH_ASYNC_THREAD_PRIO), &cfg);
+
+	return 0;
+}
+
+SYS_INIT(flash_async_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -156,6 +156,27 @@ static int flash_range_is_valid(const struct device *dev, off_t offset,
 	return 1;
 }
 
+#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+/* Stall for the time of an operation of fixed_us, plus unit_ns for each of
+ * the units it covers.
+ */
+static uint32_t sim_stall(uint32_t fixed_us, uint32_t unit_ns, size_t units,
+			  bool yield)
+{
+	uint64_t us = fixed_us + ((uint64_t)unit_ns * units) / 1000U;
+
+	us = MIN(us, UINT32_MAX);
+
+	if (yield && !k_is_in_isr()) {
+		k_sleep(K_USEC(us));
+	} else {
+		k_busy_wait(us);
+	}
+
+	return us;
+}
+#endif
+
 static int flash_sim_read(const struct device *dev, const off_t offset,
 			  void *data,
 			  const size_t len)
@@ -179,9 +200,11 @@ static int flash_sim_read(const struct device *dev, const off_t offset,
 	STATS_INCN(flash_sim_stats, bytes_read, len);
 
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US);
-	STATS_INCN(flash_sim_stats, flash_read_time_us,
-		   CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US);
+	uint32_t time_us = sim_stall(CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US,
+				     CONFIG_FLASH_SIMULATOR_READ_BYTE_TIME_NS,
+				     len, false);
+
+	STATS_INCN(flash_sim_stats, flash_read_time_us, time_us);
 #endif
 
 	return 0;
@@ -249,10 +272,20 @@ static int flash_sim_write(const struct device *dev, const off_t offset,
 	STATS_INCN(flash_sim_stats, bytes_written, len);
 
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+	size_t pages = 0;
+
+	if (len > 0) {
+		pages = (offset + len - 1) /
+			CONFIG_FLASH_SIMULATOR_PROG_PAGE_SIZE -
+			offset / CONFIG_FLASH_SIMULATOR_PROG_PAGE_SIZE + 1;
+	}
+
 	/* wait before returning */
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US);
-	STATS_INCN(flash_sim_stats, flash_write_time_us,
-		   CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US);
+	uint32_t time_us = sim_stall(CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US,
+				     CONFIG_FLASH_SIMULATOR_PROG_PAGE_TIME_US *
+				     1000U, pages, false);
+
+	STATS_INCN(flash_sim_stats, flash_write_time_us, time_us);
 #endif
 
 	return 0;
@@ -303,9 +336,12 @@ static int flash_sim_erase(const struct device *dev, const off_t offset,
 
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
 	/* wait before returning */
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US);
-	STATS_INCN(flash_sim_stats, flash_erase_time_us,
-		   CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US);
+	uint32_t time_us = sim_stall(CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US,
+				     CONFIG_FLASH_SIMULATOR_ERASE_UNIT_TIME_US *
+				     1000U, len / FLASH_SIMULATOR_ERASE_UNIT,
+				     IS_ENABLED(CONFIG_FLASH_SIMULATOR_ERASE_SUSPEND));
+
+	STATS_INCN(flash_sim_stats, flash_erase_time_us, time_us);
 #endif
 
 	return 0;
@@ -334,6 +370,20 @@ flash_sim_get_parameters(const struct device *dev)
 	return &flash_sim_parameters;
 }
 
+#ifdef CONFIG_FLASH_MMAP
+static int flash_sim_mmap(const struct device *dev, off_t offset, size_t len,
+			  const void **addr)
+{
+	if (!flash_range_is_valid(dev, offset, len)) {
+		return -EINVAL;
+	}
+
+	*addr = MOCK_FLASH(offset);
+
+	return 0;
+}
+#endif
+
 static const struct flash_driver_api flash_sim_api = {
 	.read = flash_sim_read,
 	.write = flash_sim_write,
@@ -342,6 +392,9 @@ static const struct flash_driver_api flash_sim_api = {
 #ifdef CONFIG_FLASH_PAGE_LAYOUT
 	.page_layout = flash_sim_page_layout,
 #endif
+#ifdef CONFIG_FLASH_MMAP
+	.mmap = flash_sim_mmap,
+#endif
 };
 
 #ifdef CONFIG_ARCH_POSIX
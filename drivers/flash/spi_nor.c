@@ -44,6 +44,9 @@ LOG_MODULE_REGISTER(spi_nor, CONFIG_FLASH_LOG_LEVEL);
 
 #define SPI_NOR_MAX_ADDR_WIDTH 4
 
+/* Interval between the polls of the status register during an erase. */
+#define SPI_NOR_ERASE_POLL_MS 1
+
 #ifndef NSEC_PER_MSEC
 #define NSEC_PER_MSEC (NSEC_PER_USEC * USEC_PER_MSEC)
 #endif
@@ -112,6 +115,18 @@ struct spi_nor_config {
  */
 struct spi_nor_data {
 	struct k_sem sem;
+#ifdef CONFIG_SPI_NOR_ERASE_SUSPEND
+	/* Serializes the program and erase operations, as sem is given to
+	 * the reads while an erase is suspended.
+	 */
+	struct k_sem op_sem;
+
+	/* Number of reads waiting for sem. */
+	atomic_t readers;
+
+	/* Set if the BFP reports that erases cannot be suspended. */
+	bool no_erase_suspend;
+#endif /* CONFIG_SPI_NOR_ERASE_SUSPEND */
 #if DT_INST_NODE_HAS_PROP(0, has_dpd)
 	/* Low 32-bits of uptime counter at which device last entered
 	 * deep power-down.
@@ -275,6 +290,11 @@ static inline void delay_until_exit_dpd_ok(const struct device *const dev)
  */
 #define NOR_ACCESS_32BIT_ADDR BIT(2)
 
+/* Indicates that the address is followed by a dummy byte, i.e. 8 wait
+ * states, before the data.
+ */
+#define NOR_ACCESS_DUMMY BIT(3)
+
 /* Indicates that an access command is performing a write.  If not
  * provided access is a read.
  */
@@ -300,7 +320,7 @@ static int spi_nor_access(const struct device *const dev,
 	struct spi_nor_data *const driver_data = dev->data;
 	bool is_addressed = (access & NOR_ACCESS_ADDRESSED) != 0U;
 	bool is_write = (access & NOR_ACCESS_WRITE) != 0U;
-	uint8_t buf[5] = { 0 };
+	uint8_t buf[6] = { 0 };
 	struct spi_buf spi_buf[2] = {
 		{
 			.buf = buf,
@@ -335,9 +355,16 @@ static int spi_nor_access(const struct device *const dev,
 		}
 	};
 
+	if ((access & NOR_ACCESS_DUMMY) != 0U) {
+		spi_buf[0].len += 1;
+	}
+
+	/* A read only transmits the command, the controller clocks the
+	 * data in as a single transfer without a source buffer.
+	 */
 	const struct spi_buf_set tx_set = {
 		.buffers = spi_buf,
-		.count = (length != 0) ? 2 : 1,
+		.count = (is_write && (length != 0)) ? 2 : 1,
 	};
 
 	const struct spi_buf_set rx_set = {
@@ -496,6 +523,45 @@ static void release_device(const struct device *dev)
 	}
 }
 
+/* Acquire the device for a read, which may interrupt a suspendable erase. */
+static void acquire_device_read(const struct device *dev)
+{
+#ifdef CONFIG_SPI_NOR_ERASE_SUSPEND
+	struct spi_nor_data *const driver_data = dev->data;
+
+	atomic_inc(&driver_data->readers);
+	acquire_device(dev);
+	atomic_dec(&driver_data->readers);
+#else
+	acquire_device(dev);
+#endif /* CONFIG_SPI_NOR_ERASE_SUSPEND */
+}
+
+/* Take and give the ownership of the device for a program or erase
+ * operation, on top of acquire_device() and release_device().
+ */
+static void acquire_op(const struct device *dev)
+{
+#ifdef CONFIG_SPI_NOR_ERASE_SUSPEND
+	struct spi_nor_data *const driver_data = dev->data;
+
+	k_sem_take(&driver_data->op_sem, K_FOREVER);
+#endif /* CONFIG_SPI_NOR_ERASE_SUSPEND */
+	acquire_device(dev);
+}
+
+static void release_op(const struct device *dev)
+{
+#ifdef CONFIG_SPI_NOR_ERASE_SUSPEND
+	struct spi_nor_data *const driver_data = dev->data;
+
+	release_device(dev);
+	k_sem_give(&driver_data->op_sem);
+#else
+	release_device(dev);
+#endif /* CONFIG_SPI_NOR_ERASE_SUSPEND */
+}
+
 /**
  * @brief Read the status register.
  *
@@ -543,6 +609,91 @@ static int spi_nor_wrsr(const struct device *dev,
 	return ret;
 }
 
+#ifdef CONFIG_SPI_NOR_ERASE_SUSPEND
+static bool spi_nor_readers_waiting(const struct device *dev)
+{
+	struct spi_nor_data *const driver_data = dev->data;
+
+	return !driver_data->no_erase_suspend &&
+	       (atomic_get(&driver_data->readers) > 0);
+}
+
+/*
+ * @brief Suspend the erase in progress to let the waiting reads run
+ *
+ * @note The device must be externally acquired before invoking this
+ * function.  It is released to the reads and acquired again before the
+ * erase is resumed.
+ *
+ * @param dev The device structure
+ * @return 0 on success, negative errno code otherwise
+ */
+static int spi_nor_erase_suspend(const struct device *dev)
+{
+	struct spi_nor_data *const driver_data = dev->data;
+	int ret;
+
+	ret = spi_nor_cmd_write(dev, SPI_NOR_CMD_PES);
+	if (ret == 0) {
+		ret = spi_nor_wait_until_ready(dev);
+	}
+	if (ret != 0) {
+		return ret;
+	}
+
+	/* The semaphore is handed to the first waiting read, this thread
+	 * only gets it back behind the reads already waiting.
+	 */
+	k_sem_give(&driver_data->sem);
+	k_sem_take(&driver_data->sem, K_FOREVER);
+
+	return spi_nor_cmd_write(dev, SPI_NOR_CMD_PER);
+}
+#endif /* CONFIG_SPI_NOR_ERASE_SUSPEND */
+
+/*
+ * @brief Wait until the end of an erase
+ *
+ * The status register is polled every SPI_NOR_ERASE_POLL_MS, leaving the
+ * CPU to the other threads in between.  With
+ * CONFIG_SPI_NOR_ERASE_SUSPEND the erase is suspended at each poll while
+ * reads are waiting for the device.
+ *
+ * @param dev The device structure
+ * @param suspendable false for a chip erase, which cannot be suspended
+ * @return 0 on success, negative errno code otherwise
+ */
+static int spi_nor_wait_erase(const struct device *dev, bool suspendable)
+{
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_MULTITHREADING)) {
+		return spi_nor_wait_until_ready(dev);
+	}
+
+	while (true) {
+		ret = spi_nor_rdsr(dev);
+		if (ret < 0) {
+			return ret;
+		}
+		if ((ret & SPI_NOR_WIP_BIT) == 0) {
+			return 0;
+		}
+
+#ifdef CONFIG_SPI_NOR_ERASE_SUSPEND
+		if (suspendable && spi_nor_readers_waiting(dev)) {
+			ret = spi_nor_erase_suspend(dev);
+			if (ret != 0) {
+				return ret;
+			}
+		}
+#endif /* CONFIG_SPI_NOR_ERASE_SUSPEND */
+
+		/* Always let the erase progress until the next poll */
+		k_sleep(K_MSEC(SPI_NOR_ERASE_POLL_MS));
+	}
+}
+
 static int spi_nor_read(const struct device *dev, off_t addr, void *dest,
 			size_t size)
 {
@@ -554,9 +705,16 @@ static int spi_nor_read(const struct device *dev, off_t addr, void *dest,
 		return -EINVAL;
 	}
 
-	acquire_device(dev);
+	acquire_device_read(dev);
 
-	ret = spi_nor_cmd_addr_read(dev, SPI_NOR_CMD_READ, addr, dest, size);
+	if (IS_ENABLED(DT_INST_PROP(0, fast_read))) {
+		ret = spi_nor_access(dev, SPI_NOR_CMD_FAST_READ,
+				     NOR_ACCESS_ADDRESSED | NOR_ACCESS_DUMMY,
+				     addr, dest, size);
+	} else {
+		ret = spi_nor_cmd_addr_read(dev, SPI_NOR_CMD_READ, addr, dest,
+					    size);
+	}
 
 	release_device(dev);
 	return ret;
@@ -575,7 +733,7 @@ static int spi_nor_write(const struct device *dev, off_t addr,
 		return -EINVAL;
 	}
 
-	acquire_device(dev);
+	acquire_op(dev);
 	ret = spi_nor_write_protection_set(dev, false);
 	if (ret == 0) {
 		while (size > 0) {
@@ -613,7 +771,7 @@ static int spi_nor_write(const struct device *dev, off_t addr,
 		ret = ret2;
 	}
 
-	release_device(dev);
+	release_op(dev);
 	return ret;
 }
 
@@ -637,16 +795,19 @@ static int spi_nor_erase(const struct device *dev, off_t addr, size_t size)
 		return -EINVAL;
 	}
 
-	acquire_device(dev);
+	acquire_op(dev);
 	ret = spi_nor_write_protection_set(dev, false);
 
 	while ((size > 0) && (ret == 0)) {
+		bool suspendable = true;
+
 		spi_nor_cmd_write(dev, SPI_NOR_CMD_WREN);
 
 		if (size == flash_size) {
 			/* chip erase */
 			spi_nor_cmd_write(dev, SPI_NOR_CMD_CE);
 			size -= flash_size;
+			suspendable = false;
 		} else {
 			const struct jesd216_erase_type *erase_types =
 				dev_erase_types(dev);
@@ -674,7 +835,7 @@ static int spi_nor_erase(const struct device *dev, off_t addr, size_t size)
 				ret = -EINVAL;
 			}
 		}
-		spi_nor_wait_until_ready(dev);
+		spi_nor_wait_erase(dev, suspendable);
 	}
 
 	int ret2 = spi_nor_write_protection_set(dev, true);
@@ -683,7 +844,7 @@ static int spi_nor_erase(const struct device *dev, off_t addr, size_t size)
 		ret = ret2;
 	}
 
-	release_device(dev);
+	release_op(dev);
 
 	return ret;
 }
@@ -836,6 +997,15 @@ static int spi_nor_process_bfp(const struct device *dev,
 
 	LOG_DBG("Page size %u bytes", data->page_size);
 
+#ifdef CONFIG_SPI_NOR_ERASE_SUSPEND
+	if ((php->len_dw >= 12)
+	    && (sys_le32_to_cpu(bfp->dw10[2])
+		& JESD216_SFDP_BFP_DW12_SUSPRESSUP_FLG)) {
+		LOG_INF("%s: erase suspend not supported", dev->name);
+		data->no_erase_suspend = true;
+	}
+#endif /* CONFIG_SPI_NOR_ERASE_SUSPEND */
+
 	/* If 4-byte addressing is supported, switch to it. */
 	if (jesd216_bfp_addrbytes(bfp) != JESD216_SFDP_BFP_DW1_ADDRBYTES_VAL_3B) {
 		struct jesd216_bfp_dw16 dw16;
@@ -1118,6 +1288,9 @@ static int spi_nor_init(const struct device *dev)
 		struct spi_nor_data *const driver_data = dev->data;
 
 		k_sem_init(&driver_data->sem, 1, K_SEM_MAX_LIMIT);
+#ifdef CONFIG_SPI_NOR_ERASE_SUSPEND
+		k_sem_init(&driver_data->op_sem, 1, K_SEM_MAX_LIMIT);
+#endif /* CONFIG_SPI_NOR_ERASE_SUSPEND */
 	}
 
 	return spi_nor_configure(dev);
@@ -19,6 +19,7 @@
 #define SPI_NOR_CMD_WRSR        0x01    /* Write status register */
 #define SPI_NOR_CMD_RDSR        0x05    /* Read status register */
 #define SPI_NOR_CMD_READ        0x03    /* Read data */
+#define SPI_NOR_CMD_FAST_READ   0x0B    /* Read data at higher speed */
 #define SPI_NOR_CMD_WREN        0x06    /* Write enable */
 #define SPI_NOR_CMD_WRDI        0x04    /* Write disable */
 #define SPI_NOR_CMD_PP          0x02    /* Page program */
@@ -31,6 +32,8 @@
 #define SPI_NOR_CMD_4BA         0xB7    /* Enter 4-Byte Address Mode */
 #define SPI_NOR_CMD_DPD         0xB9    /* Deep Power Down */
 #define SPI_NOR_CMD_RDPD        0xAB    /* Release from Deep Power Down */
+#define SPI_NOR_CMD_PES         0x75    /* Program/Erase Suspend */
+#define SPI_NOR_CMD_PER         0x7A    /* Program/Erase Resume */
 
 /* Page, sector, and block size are standard, not configurable. */
 #define SPI_NOR_PAGE_SIZE    0x0100U
@@ -15,13 +15,41 @@ LOG_MODULE_REGISTER(i2c_nrfx_twim, CONFIG_I2C_LOG_LEVEL);
 
 #define I2C_TRANSFER_TIMEOUT_MSEC		K_MSEC(500)
 
+/* One more transaction than the asynchronous ones can be queued, for the
+ * synchronous transactions, which are serialized by transfer_sync.
+ */
+#ifdef CONFIG_I2C_CALLBACK
+#define TXN_QUEUE_SIZE (CONFIG_I2C_CALLBACK_QUEUE_SIZE + 1)
+#else
+#define TXN_QUEUE_SIZE 1
+#endif
+
+struct i2c_nrfx_twim_txn {
+	struct i2c_msg *msgs;
+	i2c_callback_t cb;
+	void *user_data;
+	uint16_t addr;
+	uint8_t num_msgs;
+};
+
 struct i2c_nrfx_twim_data {
 	struct k_sem transfer_sync;
 	struct k_sem completion_sync;
-	volatile nrfx_err_t res;
+	struct k_spinlock lock;
+	int sync_result;
 	uint32_t dev_config;
 	uint16_t concat_buf_size;
 	uint8_t *concat_buf;
+	/* Transactions waiting for the bus, the one in progress first. */
+	struct i2c_nrfx_twim_txn txns[TXN_QUEUE_SIZE];
+	uint8_t txn_head;
+	uint8_t txn_cnt;
+	/* Messages of the transaction in progress covered by the current
+	 * transfer.
+	 */
+	uint8_t msg_first;
+	uint8_t msg_last;
+	bool concat;
 #ifdef CONFIG_PM_DEVICE
 	enum pm_device_state pm_state;
 #endif
@@ -43,29 +71,34 @@ const struct i2c_nrfx_twim_config *get_dev_config(const struct device *dev)
 	return dev->config;
 }
 
-static int i2c_nrfx_twim_transfer(const struct device *dev,
-				  struct i2c_msg *msgs,
-				  uint8_t num_msgs, uint16_t addr)
+static inline struct i2c_nrfx_twim_txn *txn_current(
+	struct i2c_nrfx_twim_data *dev_data)
 {
-	int ret = 0;
+	return &dev_data->txns[dev_data->txn_head];
+}
+
+/* Starts the transfer of the next messages of the current transaction.
+ * Messages are merged into one transfer whenever possible, so that the
+ * peripheral runs them back to back without waiting for the CPU.
+ */
+static int xfer_start(const struct device *dev)
+{
+	struct i2c_nrfx_twim_data *dev_data = get_dev_data(dev);
+	const struct i2c_nrfx_twim_txn *txn = txn_current(dev_data);
+	struct i2c_msg *msgs = txn->msgs;
+	uint8_t *concat_buf = dev_data->concat_buf;
+	uint16_t concat_buf_size = dev_data->concat_buf_size;
 	uint32_t concat_len = 0;
-	uint8_t *concat_buf = get_dev_data(dev)->concat_buf;
-	uint16_t concat_buf_size = get_dev_data(dev)->concat_buf_size;
 	nrfx_twim_xfer_desc_t cur_xfer = {
-		.address = addr
+		.address = txn->addr
 	};
+	nrfx_err_t res;
+	uint32_t flags;
+	uint8_t i;
 
-	k_sem_take(&(get_dev_data(dev)->transfer_sync), K_FOREVER);
-
-	/* Dummy take on completion_sync sem to be sure that it is empty */
-	k_sem_take(&(get_dev_data(dev)->completion_sync), K_NO_WAIT);
-
-	nrfx_twim_enable(&get_dev_config(dev)->twim);
-
-	for (size_t i = 0; i < num_msgs; i++) {
+	for (i = dev_data->msg_first; ; i++) {
 		if (I2C_MSG_ADDR_10_BITS & msgs[i].flags) {
-			ret = -ENOTSUP;
-			break;
+			return -ENOTSUP;
 		}
 
 		/* Merge this fragment with the next if we have a buffer, this
@@ -74,7 +107,7 @@ static int i2c_nrfx_twim_transfer(const struct device *dev,
 		 * direction of the next fragment is the same as this one.
 		 */
 		bool concat_next = (concat_buf_size > 0)
-			&& ((i + 1) < num_msgs)
+			&& ((i + 1) < txn->num_msgs)
 			&& !(msgs[i].flags & I2C_MSG_STOP)
 			&& !(msgs[i + 1].flags & I2C_MSG_RESTART)
 			&& ((msgs[i].flags & I2C_MSG_READ)
@@ -88,8 +121,7 @@ static int i2c_nrfx_twim_transfer(const struct device *dev,
 			if ((concat_len + msgs[i].len) > concat_buf_size) {
 				LOG_ERR("concat-buf overflow: %u + %u > %u",
 					concat_len, msgs[i].len, concat_buf_size);
-				ret = -ENOSPC;
-				break;
+				return -ENOSPC;
 			}
 			if (!(msgs[i].flags & I2C_MSG_READ)) {
 				memcpy(concat_buf + concat_len,
@@ -99,35 +131,187 @@ static int i2c_nrfx_twim_transfer(const struct device *dev,
 			concat_len += msgs[i].len;
 		}
 
-		if (concat_next) {
-			continue;
+		if (!concat_next) {
+			break;
 		}
+	}
 
-		if (concat_len == 0) {
-			cur_xfer.p_primary_buf = msgs[i].buf;
-			cur_xfer.primary_length = msgs[i].len;
-		} else {
-			cur_xfer.p_primary_buf = concat_buf;
-			cur_xfer.primary_length = concat_len;
+	dev_data->msg_last = i;
+	dev_data->concat = (concat_len != 0);
+
+	if (concat_len == 0) {
+		cur_xfer.p_primary_buf = msgs[i].buf;
+		cur_xfer.primary_length = msgs[i].len;
+	} else {
+		cur_xfer.p_primary_buf = concat_buf;
+		cur_xfer.primary_length = concat_len;
+	}
+	cur_xfer.type = (msgs[i].flags & I2C_MSG_READ) ?
+		NRFX_TWIM_XFER_RX : NRFX_TWIM_XFER_TX;
+	flags = (msgs[i].flags & I2C_MSG_STOP) ? 0 : NRFX_TWIM_FLAG_TX_NO_STOP;
+
+	/* A write followed by a read ending the bus transaction, e.g. a
+	 * register read, is a single transfer: the peripheral issues the
+	 * repeated start and the stop by itself.
+	 */
+	if (cur_xfer.type == NRFX_TWIM_XFER_TX && concat_len == 0 &&
+	    flags != 0 && (i + 1) < txn->num_msgs &&
+	    (msgs[i + 1].flags & (I2C_MSG_READ | I2C_MSG_STOP |
+				  I2C_MSG_ADDR_10_BITS)) ==
+	    (I2C_MSG_READ | I2C_MSG_STOP)) {
+		cur_xfer.type = NRFX_TWIM_XFER_TXRX;
+		cur_xfer.p_secondary_buf = msgs[i + 1].buf;
+		cur_xfer.secondary_length = msgs[i + 1].len;
+		flags = 0;
+		dev_data->msg_last = i + 1;
+	}
+
+	res = nrfx_twim_xfer(&get_dev_config(dev)->twim, &cur_xfer, flags);
+	if (res != NRFX_SUCCESS) {
+		return (res == NRFX_ERROR_BUSY) ? -EBUSY : -EIO;
+	}
+
+	return 0;
+}
+
+static int txn_start(const struct device *dev)
+{
+	get_dev_data(dev)->msg_first = 0;
+	nrfx_twim_enable(&get_dev_config(dev)->twim);
+
+	return xfer_start(dev);
+}
+
+/* Completes the transaction in progress and starts the next queued one,
+ * before calling the callback of the completed one to keep the bus busy.
+ */
+static void txn_end(const struct device *dev, int result)
+{
+	struct i2c_nrfx_twim_data *dev_data = get_dev_data(dev);
+	struct i2c_nrfx_twim_txn txn;
+	k_spinlock_key_t key;
+	int next_result;
+	bool next;
+
+	do {
+		key = k_spin_lock(&dev_data->lock);
+		txn = *txn_current(dev_data);
+		dev_data->txn_head = (dev_data->txn_head + 1) % TXN_QUEUE_SIZE;
+		dev_data->txn_cnt--;
+		next = (dev_data->txn_cnt != 0);
+		if (!next) {
+			nrfx_twim_disable(&get_dev_config(dev)->twim);
 		}
-		cur_xfer.type = (msgs[i].flags & I2C_MSG_READ) ?
-			NRFX_TWIM_XFER_RX : NRFX_TWIM_XFER_TX;
-
-		nrfx_err_t res = nrfx_twim_xfer(&get_dev_config(dev)->twim,
-						&cur_xfer,
-						(msgs[i].flags & I2C_MSG_STOP) ?
-						 0 : NRFX_TWIM_FLAG_TX_NO_STOP);
-		if (res != NRFX_SUCCESS) {
-			if (res == NRFX_ERROR_BUSY) {
-				ret = -EBUSY;
-				break;
-			} else {
-				ret = -EIO;
-				break;
-			}
+		k_spin_unlock(&dev_data->lock, key);
+
+		next_result = next ? txn_start(dev) : 0;
+
+		txn.cb(dev, result, txn.user_data);
+
+		/* The next transaction could not be started. */
+		result = next_result;
+	} while (result != 0);
+}
+
+static int txn_submit(const struct device *dev, struct i2c_msg *msgs,
+		      uint8_t num_msgs, uint16_t addr, i2c_callback_t cb,
+		      void *user_data, uint8_t max_cnt)
+{
+	struct i2c_nrfx_twim_data *dev_data = get_dev_data(dev);
+	k_spinlock_key_t key;
+	bool start;
+	int ret;
+
+	if (num_msgs == 0) {
+		cb(dev, 0, user_data);
+		return 0;
+	}
+
+	key = k_spin_lock(&dev_data->lock);
+
+	if (dev_data->txn_cnt >= max_cnt) {
+		k_spin_unlock(&dev_data->lock, key);
+		return -EWOULDBLOCK;
+	}
+
+	dev_data->txns[(dev_data->txn_head + dev_data->txn_cnt) %
+		       TXN_QUEUE_SIZE] = (struct i2c_nrfx_twim_txn) {
+		.msgs = msgs,
+		.cb = cb,
+		.user_data = user_data,
+		.addr = addr,
+		.num_msgs = num_msgs,
+	};
+	dev_data->txn_cnt++;
+	start = (dev_data->txn_cnt == 1);
+
+	k_spin_unlock(&dev_data->lock, key);
+
+	if (start) {
+		ret = txn_start(dev);
+		if (ret != 0) {
+			txn_end(dev, ret);
 		}
+	}
+
+	return 0;
+}
+
+/* Fails all the queued transactions, the one in progress included. */
+static void bus_recover(const struct device *dev)
+{
+	struct i2c_nrfx_twim_data *dev_data = get_dev_data(dev);
+	const struct i2c_nrfx_twim_config *config = get_dev_config(dev);
+	struct i2c_nrfx_twim_txn txns[TXN_QUEUE_SIZE];
+	k_spinlock_key_t key;
+	uint8_t cnt;
+
+	/* Recovered with the lock held, not to have a queued transaction
+	 * started meanwhile.
+	 */
+	key = k_spin_lock(&dev_data->lock);
+	nrfx_twim_disable(&config->twim);
+	nrfx_twim_bus_recover(config->config.scl, config->config.sda);
+
+	cnt = dev_data->txn_cnt;
+	for (uint8_t i = 0; i < cnt; i++) {
+		txns[i] = dev_data->txns[(dev_data->txn_head + i) %
+					 TXN_QUEUE_SIZE];
+	}
+	dev_data->txn_cnt = 0;
+	k_spin_unlock(&dev_data->lock, key);
+
+	for (uint8_t i = 0; i < cnt; i++) {
+		txns[i].cb(dev, -EIO, txns[i].user_data);
+	}
+}
+
+static void sync_cb(const struct device *dev, int result, void *user_data)
+{
+	struct i2c_nrfx_twim_data *dev_data = get_dev_data(dev);
+
+	ARG_UNUSED(user_data);
 
-		ret = k_sem_take(&(get_dev_data(dev)->completion_sync),
+	dev_data->sync_result = result;
+	k_sem_give(&dev_data->completion_sync);
+}
+
+static int i2c_nrfx_twim_transfer(const struct device *dev,
+				  struct i2c_msg *msgs,
+				  uint8_t num_msgs, uint16_t addr)
+{
+	struct i2c_nrfx_twim_data *dev_data = get_dev_data(dev);
+	int ret;
+
+	k_sem_take(&dev_data->transfer_sync, K_FOREVER);
+
+	/* Dummy take on completion_sync sem to be sure that it is empty */
+	k_sem_take(&dev_data->completion_sync, K_NO_WAIT);
+
+	ret = txn_submit(dev, msgs, num_msgs, addr, sync_cb, NULL,
+			 TXN_QUEUE_SIZE);
+	if (ret == 0) {
+		ret = k_sem_take(&dev_data->completion_sync,
 				 I2C_TRANSFER_TIMEOUT_MSEC);
 		if (ret != 0) {
 			/* Whatever the frequency, completion_sync should have
@@ -146,68 +330,76 @@ static int i2c_nrfx_twim_transfer(const struct device *dev,
 			 * make sure everything has been done to restore the
 			 * bus from this error.
 			 */
-			LOG_ERR("Error on I2C line occurred for message %d", i);
-			nrfx_twim_disable(&get_dev_config(dev)->twim);
-			nrfx_twim_bus_recover(get_dev_config(dev)->config.scl,
-					      get_dev_config(dev)->config.sda);
+			LOG_ERR("Error on I2C line occurred");
+			bus_recover(dev);
 			ret = -EIO;
-			break;
-		}
-
-		res = get_dev_data(dev)->res;
-
-		if (res != NRFX_SUCCESS) {
-			LOG_ERR("Error 0x%08X occurred for message %d", res, i);
-			ret = -EIO;
-			break;
-		}
-
-		/* If concatenated messages were I2C_MSG_READ type, then
-		 * content of concatenation buffer has to be copied back into
-		 * buffers provided by user. */
-		if ((msgs[i].flags & I2C_MSG_READ)
-		    && cur_xfer.p_primary_buf == concat_buf) {
-			int j = i;
-
-			while (concat_len >= msgs[j].len) {
-				concat_len -= msgs[j].len;
-				memcpy(msgs[j].buf,
-				       concat_buf + concat_len,
-				       msgs[j].len);
-				j--;
-			}
-
+		} else {
+			ret = dev_data->sync_result;
 		}
-
-		concat_len = 0;
 	}
 
-	nrfx_twim_disable(&get_dev_config(dev)->twim);
-	k_sem_give(&(get_dev_data(dev)->transfer_sync));
+	k_sem_give(&dev_data->transfer_sync);
 
 	return ret;
 }
 
+#ifdef CONFIG_I2C_CALLBACK
+static int i2c_nrfx_twim_transfer_cb(const struct device *dev,
+				     struct i2c_msg *msgs,
+				     uint8_t num_msgs, uint16_t addr,
+				     i2c_callback_t cb, void *user_data)
+{
+	return txn_submit(dev, msgs, num_msgs, addr, cb, user_data,
+			  CONFIG_I2C_CALLBACK_QUEUE_SIZE);
+}
+#endif /* CONFIG_I2C_CALLBACK */
+
 static void event_handler(nrfx_twim_evt_t const *p_event, void *p_context)
 {
-	struct i2c_nrfx_twim_data *dev_data = p_context;
+	const struct device *dev = p_context;
+	struct i2c_nrfx_twim_data *dev_data = get_dev_data(dev);
+	struct i2c_nrfx_twim_txn *txn = txn_current(dev_data);
+	int ret;
 
-	switch (p_event->type) {
-	case NRFX_TWIM_EVT_DONE:
-		dev_data->res = NRFX_SUCCESS;
-		break;
-	case NRFX_TWIM_EVT_ADDRESS_NACK:
-		dev_data->res = NRFX_ERROR_DRV_TWI_ERR_ANACK;
-		break;
-	case NRFX_TWIM_EVT_DATA_NACK:
-		dev_data->res = NRFX_ERROR_DRV_TWI_ERR_DNACK;
-		break;
-	default:
-		dev_data->res = NRFX_ERROR_INTERNAL;
-		break;
+	/* Transactions failed by a bus recovery. */
+	if (dev_data->txn_cnt == 0) {
+		return;
 	}
 
-	k_sem_give(&dev_data->completion_sync);
+	if (p_event->type != NRFX_TWIM_EVT_DONE) {
+		LOG_ERR("Error %d occurred for message %d", p_event->type,
+			dev_data->msg_first);
+		txn_end(dev, -EIO);
+		return;
+	}
+
+	/* If concatenated messages were I2C_MSG_READ type, then
+	 * content of concatenation buffer has to be copied back into
+	 * buffers provided by user.
+	 */
+	if (dev_data->concat &&
+	    (txn->msgs[dev_data->msg_last].flags & I2C_MSG_READ)) {
+		uint32_t offset = 0;
+
+		for (uint8_t i = dev_data->msg_first;
+		     i <= dev_data->msg_last; i++) {
+			memcpy(txn->msgs[i].buf,
+			       dev_data->concat_buf + offset,
+			       txn->msgs[i].len);
+			offset += txn->msgs[i].len;
+		}
+	}
+
+	dev_data->msg_first = dev_data->msg_last + 1;
+	if (dev_data->msg_first == txn->num_msgs) {
+		txn_end(dev, 0);
+		return;
+	}
+
+	ret = xfer_start(dev);
+	if (ret != 0) {
+		txn_end(dev, ret);
+	}
 }
 
 static int i2c_nrfx_twim_configure(const struct device *dev,
@@ -238,15 +430,17 @@ static int i2c_nrfx_twim_configure(const struct device *dev,
 static const struct i2c_driver_api i2c_nrfx_twim_driver_api = {
 	.configure = i2c_nrfx_twim_configure,
 	.transfer  = i2c_nrfx_twim_transfer,
+#ifdef CONFIG_I2C_CALLBACK
+	.transfer_cb = i2c_nrfx_twim_transfer_cb,
+#endif
 };
 
 static int init_twim(const struct device *dev)
 {
-	struct i2c_nrfx_twim_data *dev_data = get_dev_data(dev);
 	nrfx_err_t result = nrfx_twim_init(&get_dev_config(dev)->twim,
 					   &get_dev_config(dev)->config,
 					   event_handler,
-					   dev_data);
+					   (void *)dev);
 	if (result != NRFX_SUCCESS) {
 		LOG_ERR("Failed to initialize device: %s",
 			dev->name);
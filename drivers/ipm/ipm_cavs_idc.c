@@ -229,6 +229,33 @@ DEVICE_DT_INST_DEFINE(0, &cavs_idc_init, NULL,
 		    &cavs_idc_driver_api);
 
 #ifdef CONFIG_SCHED_IPI_SUPPORTED
+void cavs_idc_sched_ipi(uint32_t cpu_bitmap)
+{
+	uint32_t curr_cpu_id = arch_curr_cpu()->id;
+	uint32_t reg;
+	int i;
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if ((i == curr_cpu_id) || ((cpu_bitmap & BIT(i)) == 0U)) {
+			continue;
+		}
+
+		/* A core still busy with our last message has not
+		 * returned from its IDC interrupt yet, and will
+		 * reschedule when it does
+		 */
+		reg = idc_read(IPC_IDCITC(i), curr_cpu_id);
+		if ((reg & IPC_IDCITC_BUSY) != 0) {
+			continue;
+		}
+
+		idc_write(IPC_IDCIETC(i), curr_cpu_id,
+			  IPM_CAVS_IDC_MSG_SCHED_IPI_DATA | IPC_IDCIETC_DONE);
+		idc_write(IPC_IDCITC(i), curr_cpu_id,
+			  IPM_CAVS_IDC_MSG_SCHED_IPI_ID | IPC_IDCITC_BUSY);
+	}
+}
+
 int cavs_idc_smp_init(const struct device *dev)
 {
 	/* Enable IDC for scheduler IPI */
@@ -30,6 +30,11 @@
 #define IPM_CAVS_IDC_MSG_SCHED_IPI_ID		\
 	(CAVS_IDC_TYPE(0x7FU) | CAVS_IDC_HEADER(0x495049U))
 
+/* Send the scheduler IPI to the cores in cpu_bitmap only, bypassing
+ * the IPM API which always broadcasts
+ */
+void cavs_idc_sched_ipi(uint32_t cpu_bitmap);
+
 static inline uint32_t idc_read(uint32_t reg, uint32_t core_id)
 {
 	return *((volatile uint32_t*)(IPC_DSP_BASE(core_id) + reg));
@@ -15,6 +15,7 @@ LOG_MODULE_REGISTER(modem_cmd_handler, CONFIG_MODEM_LOG_LEVEL);
 
 #include <kernel.h>
 #include <stddef.h>
+#include <spinlock.h>
 #include <net/buf.h>
 
 #include "modem_context.h"
@@ -95,6 +96,195 @@ static bool starts_with(struct net_buf *buf, const char *str)
 	return false;
 }
 
+static bool is_delim(const struct modem_cmd *cmd, uint8_t c)
+{
+	return c != '\0' && strchr(cmd->delim, c) != NULL;
+}
+
+/*
+ * Command prefix tree
+ *
+ * The response and unsolicited commands are indexed when the handler is
+ * initialized: each node stands for a character, its children for the
+ * characters which may follow it in the commands. A node refers to the
+ * first command ending there, in the order the tables are searched, and
+ * to the first direct command. A line is matched walking down the tree
+ * along its first characters: the earliest command met wins, as when the
+ * commands are compared one after the other.
+ */
+
+#if CONFIG_MODEM_CMD_HANDLER_TRIE_NODES > 0
+
+#define TRIE_NO_CMD		UINT16_MAX
+#define TRIE_CMD_SHIFT		14
+#define TRIE_CMD_INDEX_MASK	(BIT(TRIE_CMD_SHIFT) - 1)
+
+struct cmd_trie_node {
+	uint16_t child;
+	uint16_t sibling;
+	uint16_t cmd;
+	uint16_t direct;
+	char c;
+};
+
+/* Shared by the handlers. Node 0 is not used, 0 ends the lists. */
+static struct cmd_trie_node trie_nodes[CONFIG_MODEM_CMD_HANDLER_TRIE_NODES + 1];
+static uint16_t trie_nodes_used = 1U;
+static struct k_spinlock trie_lock;
+
+static uint16_t trie_node_alloc(char c)
+{
+	struct cmd_trie_node *node;
+
+	if (trie_nodes_used >= ARRAY_SIZE(trie_nodes)) {
+		return 0U;
+	}
+
+	node = &trie_nodes[trie_nodes_used];
+	node->child = 0U;
+	node->sibling = 0U;
+	node->cmd = TRIE_NO_CMD;
+	node->direct = TRIE_NO_CMD;
+	node->c = c;
+
+	return trie_nodes_used++;
+}
+
+static bool trie_insert(uint16_t root, const struct modem_cmd *cmd,
+			uint16_t ref)
+{
+	struct cmd_trie_node *node = &trie_nodes[root];
+	uint16_t idx;
+
+	for (int i = 0; i < cmd->cmd_len; i++) {
+		for (idx = node->child; idx != 0U;
+		     idx = trie_nodes[idx].sibling) {
+			if (trie_nodes[idx].c == cmd->cmd[i]) {
+				break;
+			}
+		}
+
+		if (idx == 0U) {
+			idx = trie_node_alloc(cmd->cmd[i]);
+			if (idx == 0U) {
+				return false;
+			}
+
+			trie_nodes[idx].sibling = node->child;
+			node->child = idx;
+		}
+
+		node = &trie_nodes[idx];
+	}
+
+	/* the commands are inserted in the order they are searched */
+	if (node->cmd == TRIE_NO_CMD) {
+		node->cmd = ref;
+	}
+
+	if (cmd->direct && node->direct == TRIE_NO_CMD) {
+		node->direct = ref;
+	}
+
+	return true;
+}
+
+static void trie_build(struct modem_cmd_handler_data *data)
+{
+	k_spinlock_key_t key = k_spin_lock(&trie_lock);
+	uint16_t used = trie_nodes_used;
+	uint16_t root;
+	int j, i;
+
+	root = trie_node_alloc('\0');
+	if (root == 0U) {
+		goto fail;
+	}
+
+	for (j = CMD_RESP; j < CMD_HANDLER; j++) {
+		if (!data->cmds[j] || data->cmds_len[j] == 0U) {
+			continue;
+		}
+
+		if (data->cmds_len[j] > TRIE_CMD_INDEX_MASK + 1) {
+			goto fail;
+		}
+
+		for (i = 0; i < data->cmds_len[j]; i++) {
+			if (!trie_insert(root, &data->cmds[j][i],
+					 (j << TRIE_CMD_SHIFT) | i)) {
+				goto fail;
+			}
+		}
+	}
+
+	data->trie_root = root;
+	k_spin_unlock(&trie_lock, key);
+
+	return;
+
+fail:
+	/* the tree is built with the lock held, drop its nodes */
+	trie_nodes_used = used;
+	data->trie_root = 0U;
+	k_spin_unlock(&trie_lock, key);
+
+	LOG_WRN("Commands not indexed, increase "
+		"CONFIG_MODEM_CMD_HANDLER_TRIE_NODES");
+}
+
+/* match the first len bytes of rx_buf against the tree */
+static const struct modem_cmd *trie_find(struct modem_cmd_handler_data *data,
+					 uint16_t len, bool direct)
+{
+	const struct cmd_trie_node *node = &trie_nodes[data->trie_root];
+	struct net_buf *buf = data->rx_buf;
+	uint16_t best = direct ? node->direct : node->cmd;
+	uint16_t pos = 0U, idx;
+
+	while (len-- > 0U && buf && buf->len && node->child != 0U) {
+		for (idx = node->child; idx != 0U;
+		     idx = trie_nodes[idx].sibling) {
+			if (trie_nodes[idx].c == *(buf->data + pos)) {
+				break;
+			}
+		}
+
+		if (idx == 0U) {
+			break;
+		}
+
+		node = &trie_nodes[idx];
+		best = MIN(best, direct ? node->direct : node->cmd);
+
+		if (++pos >= buf->len) {
+			buf = buf->frags;
+			pos = 0U;
+		}
+	}
+
+	if (best == TRIE_NO_CMD) {
+		return NULL;
+	}
+
+	return &data->cmds[best >> TRIE_CMD_SHIFT][best & TRIE_CMD_INDEX_MASK];
+}
+
+#else
+
+static inline void trie_build(struct modem_cmd_handler_data *data)
+{
+	data->trie_root = 0U;
+}
+
+static inline const struct modem_cmd *trie_find(
+		struct modem_cmd_handler_data *data, uint16_t len, bool direct)
+{
+	return NULL;
+}
+
+#endif /* CONFIG_MODEM_CMD_HANDLER_TRIE_NODES > 0 */
+
 /*
  * Cmd Handler Functions
  */
@@ -110,7 +300,7 @@ static int parse_params(struct modem_cmd_handler_data *data,  size_t match_len,
 			const struct modem_cmd *cmd,
 			uint8_t **argv, size_t argv_len, uint16_t *argc)
 {
-	int i, count = 0;
+	int count = 0;
 	size_t begin, end;
 
 	if (!data || !data->match_buf || !match_len || !cmd || !argv || !argc) {
@@ -120,18 +310,15 @@ static int parse_params(struct modem_cmd_handler_data *data,  size_t match_len,
 	begin = cmd->cmd_len;
 	end = cmd->cmd_len;
 	while (end < match_len) {
-		for (i = 0; i < strlen(cmd->delim); i++) {
-			if (data->match_buf[end] == cmd->delim[i]) {
-				/* mark a parameter beginning */
-				argv[*argc] = &data->match_buf[begin];
-				/* end parameter with NUL char */
-				data->match_buf[end] = '\0';
-				/* bump begin */
-				begin = end + 1;
-				count += 1;
-				(*argc)++;
-				break;
-			}
+		if (is_delim(cmd, data->match_buf[end])) {
+			/* mark a parameter beginning */
+			argv[*argc] = &data->match_buf[begin];
+			/* end parameter with NUL char */
+			data->match_buf[end] = '\0';
+			/* bump begin */
+			begin = end + 1;
+			count += 1;
+			(*argc)++;
 		}
 
 		if (count >= cmd->arg_count_max) {
@@ -176,6 +363,7 @@ static int process_cmd(const struct modem_cmd *cmd, size_t match_len,
 	int parsed_len = 0, ret = 0;
 	uint8_t *argv[CONFIG_MODEM_CMD_HANDLER_MAX_PARAM_COUNT];
 	uint16_t argc = 0U;
+	uint16_t len;
 
 	/* reset params */
 	memset(argv, 0, sizeof(argv[0]) * ARRAY_SIZE(argv));
@@ -193,10 +381,16 @@ static int process_cmd(const struct modem_cmd *cmd, size_t match_len,
 	/* skip cmd_len + parsed len */
 	data->rx_buf = net_buf_skip(data->rx_buf, cmd->cmd_len + parsed_len);
 
+	if (cmd->payload) {
+		/* the handler reads the payload from rx_buf */
+		len = MIN(net_buf_frags_len(data->rx_buf), UINT16_MAX);
+	} else {
+		len = match_len - cmd->cmd_len - parsed_len;
+	}
+
 	/* call handler */
 	if (cmd->func) {
-		ret = cmd->func(data, match_len - cmd->cmd_len - parsed_len,
-				argv, argc);
+		ret = cmd->func(data, len, argv, argc);
 		if (ret == -EAGAIN) {
 			/* wait for more data */
 			net_buf_push(data->rx_buf, cmd->cmd_len + parsed_len);
@@ -207,27 +401,39 @@ static int process_cmd(const struct modem_cmd *cmd, size_t match_len,
 }
 
 /*
- * check 3 arrays of commands for a match in match_buf:
+ * check 3 arrays of commands for a match on the first len bytes of rx_buf:
  * - response handlers[0]
  * - unsolicited handlers[1]
  * - current assigned handlers[2]
+ * The first two are looked up in the prefix tree, if they are indexed.
  */
 static const struct modem_cmd *find_cmd_match(
-		struct modem_cmd_handler_data *data)
+		struct modem_cmd_handler_data *data, uint16_t len, bool direct)
 {
-	int j, i;
+	const struct modem_cmd *cmd;
+	int j = 0, i;
+
+	if (data->trie_root != 0U) {
+		cmd = trie_find(data, len, direct);
+		if (cmd) {
+			return cmd;
+		}
+
+		j = CMD_HANDLER;
+	}
 
-	for (j = 0; j < ARRAY_SIZE(data->cmds); j++) {
+	for (; j < ARRAY_SIZE(data->cmds); j++) {
 		if (!data->cmds[j] || data->cmds_len[j] == 0U) {
 			continue;
 		}
 
 		for (i = 0; i < data->cmds_len[j]; i++) {
-			/* match on "empty" cmd */
-			if (strlen(data->cmds[j][i].cmd) == 0 ||
-			    strncmp(data->match_buf, data->cmds[j][i].cmd,
-				    data->cmds[j][i].cmd_len) == 0) {
-				return &data->cmds[j][i];
+			cmd = &data->cmds[j][i];
+
+			/* match start of cmd, "empty" cmd matches anything */
+			if ((!direct || cmd->direct) && cmd->cmd_len <= len &&
+			    starts_with(data->rx_buf, cmd->cmd)) {
+				return cmd;
 			}
 		}
 	}
@@ -235,27 +441,33 @@ static const struct modem_cmd *find_cmd_match(
 	return NULL;
 }
 
-static const struct modem_cmd *find_cmd_direct_match(
-		struct modem_cmd_handler_data *data)
+/*
+ * Length of the command and the parameters preceding its payload, up to
+ * the delimiter ending the last parameter, or len if the line ends first.
+ */
+static uint16_t payload_offset(struct modem_cmd_handler_data *data,
+			       const struct modem_cmd *cmd, uint16_t len)
 {
-	int j, i;
+	struct net_buf *buf = data->rx_buf;
+	uint16_t count = 0U, pos = 0U, i;
 
-	for (j = 0; j < ARRAY_SIZE(data->cmds); j++) {
-		if (!data->cmds[j] || data->cmds_len[j] == 0U) {
-			continue;
+	if (cmd->arg_count_max == 0U) {
+		return MIN(cmd->cmd_len, len);
+	}
+
+	for (i = 0U; i < len && buf && buf->len; i++) {
+		if (i >= cmd->cmd_len && is_delim(cmd, *(buf->data + pos)) &&
+		    ++count == cmd->arg_count_max) {
+			return i + 1;
 		}
 
-		for (i = 0; i < data->cmds_len[j]; i++) {
-			/* match start of cmd */
-			if (data->cmds[j][i].direct &&
-			    (data->cmds[j][i].cmd[0] == '\0' ||
-			     starts_with(data->rx_buf, data->cmds[j][i].cmd))) {
-				return &data->cmds[j][i];
-			}
+		if (++pos >= buf->len) {
+			buf = buf->frags;
+			pos = 0U;
 		}
 	}
 
-	return NULL;
+	return len;
 }
 
 static int cmd_handler_process_iface_data(struct modem_cmd_handler_data *data,
@@ -321,7 +533,7 @@ static void cmd_handler_process_rx_buf(struct modem_cmd_handler_data *data)
 			break;
 		}
 
-		cmd = find_cmd_direct_match(data);
+		cmd = find_cmd_match(data, UINT16_MAX, true);
 		if (cmd && cmd->func) {
 			ret = cmd->func(data, cmd->cmd_len, NULL, 0);
 			if (ret == -EAGAIN) {
@@ -347,24 +559,33 @@ static void cmd_handler_process_rx_buf(struct modem_cmd_handler_data *data)
 			break;
 		}
 
+		k_sem_take(&data->sem_parse_lock, K_FOREVER);
+
+		cmd = find_cmd_match(data, len, false);
+
+		/* a payload stays in rx_buf for the handler to read */
+		match_len = (cmd && cmd->payload) ?
+			    payload_offset(data, cmd, len) : len;
+
 		/* load match_buf with content up to the next CR/LF */
 		/* NOTE: keep room in match_buf for ending NUL char */
-		match_len = net_buf_linearize(data->match_buf,
-					      data->match_buf_len - 1,
-					      data->rx_buf, 0, len);
-		if ((data->match_buf_len - 1) < match_len) {
-			LOG_ERR("Match buffer size (%zu) is too small for "
-				"incoming command size: %zu!  Truncating!",
-				data->match_buf_len - 1, match_len);
+		if (cmd || IS_ENABLED(CONFIG_MODEM_CONTEXT_VERBOSE_DEBUG)) {
+			match_len = net_buf_linearize(data->match_buf,
+						      data->match_buf_len - 1,
+						      data->rx_buf, 0,
+						      match_len);
+			if ((data->match_buf_len - 1) < match_len) {
+				LOG_ERR("Match buffer size (%zu) is too small "
+					"for incoming command size: %zu!  "
+					"Truncating!", data->match_buf_len - 1,
+					match_len);
+			}
 		}
 
 #if defined(CONFIG_MODEM_CONTEXT_VERBOSE_DEBUG)
 		LOG_HEXDUMP_DBG(data->match_buf, match_len, "RECV");
 #endif
 
-		k_sem_take(&data->sem_parse_lock, K_FOREVER);
-
-		cmd = find_cmd_match(data);
 		if (cmd) {
 			LOG_DBG("match cmd [%s] (len:%zu)",
 				log_strdup(cmd->cmd), match_len);
@@ -449,6 +670,26 @@ int modem_cmd_handler_set_error(struct modem_cmd_handler_data *data,
 	return 0;
 }
 
+size_t modem_cmd_handler_payload_read(struct modem_cmd_handler_data *data,
+				      void *buf, size_t len)
+{
+	size_t read = 0;
+	uint16_t chunk;
+
+	while (data->rx_buf && read < len) {
+		chunk = MIN(data->rx_buf->len, len - read);
+		memcpy((uint8_t *)buf + read, data->rx_buf->data, chunk);
+		net_buf_pull(data->rx_buf, chunk);
+		read += chunk;
+
+		if (!data->rx_buf->len) {
+			data->rx_buf = net_buf_frag_del(NULL, data->rx_buf);
+		}
+	}
+
+	return read;
+}
+
 int modem_cmd_handler_update_cmds(struct modem_cmd_handler_data *data,
 				  const struct modem_cmd *handler_cmds,
 				  size_t handler_cmds_len,
@@ -666,6 +907,8 @@ int modem_cmd_handler_init(struct modem_cmd_handler *handler,
 		data->eol_len = strlen(data->eol);
 	}
 
+	trie_build(data);
+
 	handler->cmd_handler_data = data;
 	handler->process = cmd_handler_process;
 
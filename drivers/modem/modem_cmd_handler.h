@@ -45,6 +45,24 @@ static int name_(struct modem_cmd_handler_data *data, uint16_t len, \
 	.direct = false, \
 }
 
+/*
+ * A command followed by a payload on the same line, e.g. socket data: only
+ * the command and its acount_ parameters are copied to the match buffer.
+ * The handler is called with the receive buffer past the parameters and
+ * the number of bytes it holds, and reads the payload from it, e.g. with
+ * modem_cmd_handler_payload_read().
+ */
+#define MODEM_CMD_PAYLOAD(cmd_, func_cb_, acount_, adelim_) { \
+	.cmd = cmd_, \
+	.cmd_len = (uint16_t)sizeof(cmd_)-1, \
+	.func = func_cb_, \
+	.arg_count_min = acount_, \
+	.arg_count_max = acount_, \
+	.delim = adelim_, \
+	.direct = false, \
+	.payload = true, \
+}
+
 #define MODEM_CMD_DIRECT_DEFINE(name_) MODEM_CMD_DEFINE(name_)
 
 #define MODEM_CMD_DIRECT(cmd_, func_cb_) { \
@@ -73,6 +91,7 @@ struct modem_cmd {
 	uint16_t arg_count_min;
 	uint16_t arg_count_max;
 	bool direct;
+	bool payload;
 };
 
 #define SETUP_CMD(cmd_send_, match_cmd_, func_cb_, num_param_, delim_) { \
@@ -89,10 +108,17 @@ struct setup_cmd {
 	struct modem_cmd handle_cmd;
 };
 
+/*
+ * The response and unsolicited commands must be set before
+ * modem_cmd_handler_init(), which indexes them.
+ */
 struct modem_cmd_handler_data {
 	const struct modem_cmd *cmds[CMD_MAX];
 	size_t cmds_len[CMD_MAX];
 
+	/* root of the command prefix tree, 0 if none */
+	uint16_t trie_root;
+
 	char *match_buf;
 	size_t match_buf_len;
 
@@ -148,6 +174,22 @@ int modem_cmd_handler_update_cmds(struct modem_cmd_handler_data *data,
 				  size_t handler_cmds_len,
 				  bool reset_error_flag);
 
+/**
+ * @brief  read the payload of a command from the receive buffer
+ *
+ * Copies data from the receive buffer straight to the destination, e.g.
+ * a socket buffer, and consumes it.
+ *
+ * @param  *data: command handler data reference
+ * @param  *buf: destination buffer
+ * @param  len: number of bytes to read
+ *
+ * @retval number of bytes read, less than len if the receive buffer holds
+ *         less.
+ */
+size_t modem_cmd_handler_payload_read(struct modem_cmd_handler_data *data,
+				      void *buf, size_t len);
+
 /**
  * @brief  send AT command to interface w/o locking TX
  *
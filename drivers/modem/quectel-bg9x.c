@@ -160,9 +160,9 @@ static int on_cmd_sockread_common(int socket_fd,
 		goto exit;
 	}
 
-	ret = net_buf_linearize(sock_data->recv_buf, sock_data->recv_buf_len,
-				data->rx_buf, 0, (uint16_t)socket_data_length);
-	data->rx_buf = net_buf_skip(data->rx_buf, ret);
+	ret = modem_cmd_handler_payload_read(data, sock_data->recv_buf,
+					     MIN(sock_data->recv_buf_len,
+						 (size_t)socket_data_length));
 	sock_data->recv_read_len = ret;
 	if (ret != socket_data_length) {
 		LOG_ERR("Total copied data is different then received data!"
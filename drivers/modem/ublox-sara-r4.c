@@ -832,9 +832,9 @@ static int on_cmd_sockread_common(int socket_id,
 		goto exit;
 	}
 
-	ret = net_buf_linearize(sock_data->recv_buf, sock_data->recv_buf_len,
-				data->rx_buf, 0, (uint16_t)socket_data_length);
-	data->rx_buf = net_buf_skip(data->rx_buf, ret);
+	ret = modem_cmd_handler_payload_read(data, sock_data->recv_buf,
+					     MIN(sock_data->recv_buf_len,
+						 (size_t)socket_data_length));
 	sock_data->recv_read_len = ret;
 	if (ret != socket_data_length) {
 		LOG_ERR("Total copied data is different then received data!"
@@ -1622,8 +1622,8 @@ static ssize_t offload_recvfrom(void *obj, void *buf, size_t len,
 	struct modem_socket *sock = (struct modem_socket *)obj;
 	int ret, next_packet_size;
 	static const struct modem_cmd cmd[] = {
-		MODEM_CMD("+USORF: ", on_cmd_sockreadfrom, 4U, ","),
-		MODEM_CMD("+USORD: ", on_cmd_sockread, 2U, ","),
+		MODEM_CMD_PAYLOAD("+USORF: ", on_cmd_sockreadfrom, 4U, ","),
+		MODEM_CMD_PAYLOAD("+USORD: ", on_cmd_sockread, 2U, ","),
 	};
 	char sendbuf[sizeof("AT+USORF=#,#####\r")];
 	struct socket_read_data sock_data;
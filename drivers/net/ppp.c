@@ -28,7 +28,7 @@ LOG_MODULE_REGISTER(net_ppp, LOG_LEVEL);
 #include <net/net_if.h>
 #include <net/net_core.h>
 #include <sys/ring_buffer.h>
-#include <sys/crc.h>
+#include <sys/byteorder.h>
 #include <drivers/uart.h>
 #include <drivers/console/uart_mux.h>
 #include <random/rand32.h>
@@ -38,6 +38,13 @@ LOG_MODULE_REGISTER(net_ppp, LOG_LEVEL);
 
 #define UART_BUF_LEN CONFIG_NET_PPP_UART_BUF_LEN
 
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+#define PPP_SEND_BUF_LEN CONFIG_NET_PPP_ASYNC_UART_TX_BUF_LEN
+#define PPP_RX_DMA_BUF_LEN CONFIG_NET_PPP_ASYNC_UART_RX_BUF_LEN
+#else
+#define PPP_SEND_BUF_LEN UART_BUF_LEN
+#endif
+
 enum ppp_driver_state {
 	STATE_HDLC_FRAME_START,
 	STATE_HDLC_FRAME_ADDRESS,
@@ -63,7 +70,18 @@ struct ppp_driver_context {
 	uint8_t buf[UART_BUF_LEN];
 
 	/* ppp buf use when sending data */
-	uint8_t send_buf[UART_BUF_LEN];
+	uint8_t send_buf[PPP_SEND_BUF_LEN];
+
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+	/* The UART receives into one of these while the other one is
+	 * being copied to the ring buffer.
+	 */
+	uint8_t rx_dma_buf[2][PPP_RX_DMA_BUF_LEN];
+	uint8_t rx_dma_next;
+
+	/* Given when the send_buf has been transmitted */
+	struct k_sem tx_done;
+#endif
 
 	uint8_t mac_addr[6];
 	struct net_linkaddr ll_addr;
@@ -95,7 +113,125 @@ struct ppp_driver_context {
 
 static struct ppp_driver_context ppp_driver_context_data;
 
-static int ppp_save_byte(struct ppp_driver_context *ppp, uint8_t byte)
+/* FCS-16 lookup table, RFC 1662 appendix C.2 */
+static const uint16_t ppp_fcs_table[256] = {
+	0x0000, 0x1189, 0x2312, 0x329b, 0x4624, 0x57ad, 0x6536, 0x74bf,
+	0x8c48, 0x9dc1, 0xaf5a, 0xbed3, 0xca6c, 0xdbe5, 0xe97e, 0xf8f7,
+	0x1081, 0x0108, 0x3393, 0x221a, 0x56a5, 0x472c, 0x75b7, 0x643e,
+	0x9cc9, 0x8d40, 0xbfdb, 0xae52, 0xdaed, 0xcb64, 0xf9ff, 0xe876,
+	0x2102, 0x308b, 0x0210, 0x1399, 0x6726, 0x76af, 0x4434, 0x55bd,
+	0xad4a, 0xbcc3, 0x8e58, 0x9fd1, 0xeb6e, 0xfae7, 0xc87c, 0xd9f5,
+	0x3183, 0x200a, 0x1291, 0x0318, 0x77a7, 0x662e, 0x54b5, 0x453c,
+	0xbdcb, 0xac42, 0x9ed9, 0x8f50, 0xfbef, 0xea66, 0xd8fd, 0xc974,
+	0x4204, 0x538d, 0x6116, 0x709f, 0x0420, 0x15a9, 0x2732, 0x36bb,
+	0xce4c, 0xdfc5, 0xed5e, 0xfcd7, 0x8868, 0x99e1, 0xab7a, 0xbaf3,
+	0x5285, 0x430c, 0x7197, 0x601e, 0x14a1, 0x0528, 0x37b3, 0x263a,
+	0xdecd, 0xcf44, 0xfddf, 0xec56, 0x98e9, 0x8960, 0xbbfb, 0xaa72,
+	0x6306, 0x728f, 0x4014, 0x519d, 0x2522, 0x34ab, 0x0630, 0x17b9,
+	0xef4e, 0xfec7, 0xcc5c, 0xddd5, 0xa96a, 0xb8e3, 0x8a78, 0x9bf1,
+	0x7387, 0x620e, 0x5095, 0x411c, 0x35a3, 0x242a, 0x16b1, 0x0738,
+	0xffcf, 0xee46, 0xdcdd, 0xcd54, 0xb9eb, 0xa862, 0x9af9, 0x8b70,
+	0x8408, 0x9581, 0xa71a, 0xb693, 0xc22c, 0xd3a5, 0xe13e, 0xf0b7,
+	0x0840, 0x19c9, 0x2b52, 0x3adb, 0x4e64, 0x5fed, 0x6d76, 0x7cff,
+	0x9489, 0x8500, 0xb79b, 0xa612, 0xd2ad, 0xc324, 0xf1bf, 0xe036,
+	0x18c1, 0x0948, 0x3bd3, 0x2a5a, 0x5ee5, 0x4f6c, 0x7df7, 0x6c7e,
+	0xa50a, 0xb483, 0x8618, 0x9791, 0xe32e, 0xf2a7, 0xc03c, 0xd1b5,
+	0x2942, 0x38cb, 0x0a50, 0x1bd9, 0x6f66, 0x7eef, 0x4c74, 0x5dfd,
+	0xb58b, 0xa402, 0x9699, 0x8710, 0xf3af, 0xe226, 0xd0bd, 0xc134,
+	0x39c3, 0x284a, 0x1ad1, 0x0b58, 0x7fe7, 0x6e6e, 0x5cf5, 0x4d7c,
+	0xc60c, 0xd785, 0xe51e, 0xf497, 0x8028, 0x91a1, 0xa33a, 0xb2b3,
+	0x4a44, 0x5bcd, 0x6956, 0x78df, 0x0c60, 0x1de9, 0x2f72, 0x3efb,
+	0xd68d, 0xc704, 0xf59f, 0xe416, 0x90a9, 0x8120, 0xb3bb, 0xa232,
+	0x5ac5, 0x4b4c, 0x79d7, 0x685e, 0x1ce1, 0x0d68, 0x3ff3, 0x2e7a,
+	0xe70e, 0xf687, 0xc41c, 0xd595, 0xa12a, 0xb0a3, 0x8238, 0x93b1,
+	0x6b46, 0x7acf, 0x4854, 0x59dd, 0x2d62, 0x3ceb, 0x0e70, 0x1ff9,
+	0xf78f, 0xe606, 0xd49d, 0xc514, 0xb1ab, 0xa022, 0x92b9, 0x8330,
+	0x7bc7, 0x6a4e, 0x58d5, 0x495c, 0x3de3, 0x2c6a, 0x1ef1, 0x0f78,
+};
+
+static uint16_t ppp_fcs(uint16_t fcs, const uint8_t *data, size_t len)
+{
+	while (len--) {
+		fcs = (fcs >> 8) ^ ppp_fcs_table[(fcs ^ *data++) & 0xff];
+	}
+
+	return fcs;
+}
+
+#define PPP_ONES  0x01010101U
+#define PPP_HIGHS 0x80808080U
+
+/* Non-zero if any byte of the word is equal to byte */
+static inline uint32_t ppp_word_has_byte(uint32_t word, uint8_t byte)
+{
+	uint32_t x = word ^ (PPP_ONES * byte);
+
+	return (x - PPP_ONES) & ~x & PPP_HIGHS;
+}
+
+/* Non-zero if any byte of the word is less than n, n <= 0x80 */
+static inline uint32_t ppp_word_has_less(uint32_t word, uint8_t n)
+{
+	return (word - PPP_ONES * n) & ~word & PPP_HIGHS;
+}
+
+static inline bool ppp_needs_escape(uint8_t byte)
+{
+	return byte == 0x7e || byte == 0x7d || byte < 0x20;
+}
+
+/* Return the number of bytes at the start of data which can be sent as
+ * they are. All the control characters are escaped as the ACCM is not
+ * negotiated.
+ */
+static size_t ppp_plain_tx_len(const uint8_t *data, size_t len)
+{
+	size_t i = 0;
+	uint32_t word;
+
+	for (; i + sizeof(word) <= len; i += sizeof(word)) {
+		memcpy(&word, &data[i], sizeof(word));
+
+		if (ppp_word_has_byte(word, 0x7e) ||
+		    ppp_word_has_byte(word, 0x7d) ||
+		    ppp_word_has_less(word, 0x20)) {
+			break;
+		}
+	}
+
+	while (i < len && !ppp_needs_escape(data[i])) {
+		i++;
+	}
+
+	return i;
+}
+
+/* Return the number of bytes at the start of data which are neither flag
+ * nor escape bytes.
+ */
+static size_t ppp_plain_rx_len(const uint8_t *data, size_t len)
+{
+	size_t i = 0;
+	uint32_t word;
+
+	for (; i + sizeof(word) <= len; i += sizeof(word)) {
+		memcpy(&word, &data[i], sizeof(word));
+
+		if (ppp_word_has_byte(word, 0x7e) ||
+		    ppp_word_has_byte(word, 0x7d)) {
+			break;
+		}
+	}
+
+	while (i < len && data[i] != 0x7e && data[i] != 0x7d) {
+		i++;
+	}
+
+	return i;
+}
+
+static int ppp_save_bytes(struct ppp_driver_context *ppp,
+			  const uint8_t *data, size_t len)
 {
 	int ret;
 
@@ -118,33 +254,43 @@ static int ppp_save_byte(struct ppp_driver_context *ppp, uint8_t byte)
 	 * needed. Normally it would just print too much data.
 	 */
 	if (0) {
-		LOG_DBG("Saving byte %02x", byte);
+		LOG_HEXDUMP_DBG(data, len, "Saving bytes");
 	}
 
-	/* This is not very intuitive but we must allocate new buffer
-	 * before we write a byte to last available cursor position.
-	 */
-	if (ppp->available == 1) {
-		ret = net_pkt_alloc_buffer(ppp->pkt,
-					   CONFIG_NET_BUF_DATA_SIZE,
-					   AF_UNSPEC, K_NO_WAIT);
-		if (ret < 0) {
-			LOG_ERR("[%p] cannot allocate new data buffer", ppp);
-			goto out_of_mem;
+	while (len > 0) {
+		size_t count;
+
+		/* This is not very intuitive but we must allocate new buffer
+		 * before we write a byte to last available cursor position.
+		 */
+		if (ppp->available <= 1) {
+			ret = net_pkt_alloc_buffer(ppp->pkt,
+						   CONFIG_NET_BUF_DATA_SIZE,
+						   AF_UNSPEC, K_NO_WAIT);
+			if (ret < 0) {
+				LOG_ERR("[%p] cannot allocate new data buffer",
+					ppp);
+				goto out_of_mem;
+			}
+
+			ppp->available = net_pkt_available_buffer(ppp->pkt);
+			if (ppp->available <= 1) {
+				goto out_of_mem;
+			}
 		}
 
-		ppp->available = net_pkt_available_buffer(ppp->pkt);
-	}
+		count = MIN(len, ppp->available - 1);
 
-	if (ppp->available) {
-		ret = net_pkt_write_u8(ppp->pkt, byte);
+		ret = net_pkt_write(ppp->pkt, data, count);
 		if (ret < 0) {
 			LOG_ERR("[%p] Cannot write to pkt %p (%d)",
 				ppp, ppp->pkt, ret);
 			goto out_of_mem;
 		}
 
-		ppp->available--;
+		ppp->available -= count;
+		data += count;
+		len -= count;
 	}
 
 	return 0;
@@ -206,6 +352,16 @@ static int ppp_send_flush(struct ppp_driver_context *ppp, int off)
 	 */
 	if (IS_ENABLED(CONFIG_GSM_MUX)) {
 		(void)uart_fifo_fill(ppp->dev, buf, off);
+	} else if (IS_ENABLED(CONFIG_NET_PPP_ASYNC_UART)) {
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+		/* The send_buf is filled again only after the transfer is
+		 * done.
+		 */
+		if (off > 0 && uart_tx(ppp->dev, buf, off,
+				       SYS_FOREVER_MS) == 0) {
+			(void)k_sem_take(&ppp->tx_done, K_FOREVER);
+		}
+#endif
 	} else {
 		while (off--) {
 			uart_poll_out(ppp->dev, *buf++);
@@ -218,10 +374,13 @@ static int ppp_send_flush(struct ppp_driver_context *ppp, int off)
 static int ppp_send_bytes(struct ppp_driver_context *ppp,
 			  const uint8_t *data, int len, int off)
 {
-	int i;
+	while (len > 0) {
+		int count = MIN(len, (int)sizeof(ppp->send_buf) - off);
 
-	for (i = 0; i < len; i++) {
-		ppp->send_buf[off++] = data[i];
+		memcpy(&ppp->send_buf[off], data, count);
+		off += count;
+		data += count;
+		len -= count;
 
 		if (off >= sizeof(ppp->send_buf)) {
 			off = ppp_send_flush(ppp, off);
@@ -231,6 +390,34 @@ static int ppp_send_bytes(struct ppp_driver_context *ppp,
 	return off;
 }
 
+/* Send the data escaped, RFC 1662 ch. 4.2. The runs of bytes which need no
+ * escaping are copied as they are.
+ */
+static int ppp_send_escaped(struct ppp_driver_context *ppp,
+			    const uint8_t *data, size_t len, int off)
+{
+	uint8_t escaped[2];
+	size_t plain;
+
+	while (len > 0) {
+		plain = ppp_plain_tx_len(data, len);
+		if (plain > 0) {
+			off = ppp_send_bytes(ppp, data, plain, off);
+			data += plain;
+			len -= plain;
+			continue;
+		}
+
+		escaped[0] = 0x7d;
+		escaped[1] = *data++ ^ 0x20;
+		len--;
+
+		off = ppp_send_bytes(ppp, escaped, sizeof(escaped), off);
+	}
+
+	return off;
+}
+
 #if defined(CONFIG_PPP_CLIENT_CLIENTSERVER)
 
 #define CLIENT "CLIENT"
@@ -308,7 +495,7 @@ static int ppp_input_byte(struct ppp_driver_context *ppp, uint8_t byte)
 			 * the FCS. The address field will not be passed
 			 * to upper stack.
 			 */
-			ret = ppp_save_byte(ppp, byte);
+			ret = ppp_save_bytes(ppp, &byte, 1);
 			if (ret < 0) {
 				ppp_change_state(ppp, STATE_HDLC_FRAME_START);
 			}
@@ -339,7 +526,7 @@ static int ppp_input_byte(struct ppp_driver_context *ppp, uint8_t byte)
 				ppp->next_escaped = false;
 			}
 
-			ret = ppp_save_byte(ppp, byte);
+			ret = ppp_save_bytes(ppp, &byte, 1);
 			if (ret < 0) {
 				ppp_change_state(ppp, STATE_HDLC_FRAME_START);
 			}
@@ -367,12 +554,12 @@ static bool ppp_check_fcs(struct ppp_driver_context *ppp)
 		return false;
 	}
 
-	crc = crc16_ccitt(0xffff, buf->data, buf->len);
+	crc = ppp_fcs(0xffff, buf->data, buf->len);
 
 	buf = buf->frags;
 
 	while (buf) {
-		crc = crc16_ccitt(crc, buf->data, buf->len);
+		crc = ppp_fcs(crc, buf->data, buf->len);
 		buf = buf->frags;
 	}
 
@@ -434,38 +621,58 @@ static void ppp_process_msg(struct ppp_driver_context *ppp)
 	ppp->pkt = NULL;
 }
 
-#if defined(CONFIG_NET_TEST)
-static uint8_t *ppp_recv_cb(uint8_t *buf, size_t *off)
+static void ppp_input(struct ppp_driver_context *ppp, const uint8_t *data,
+		      size_t len)
 {
-	struct ppp_driver_context *ppp =
-		CONTAINER_OF(buf, struct ppp_driver_context, buf);
-	size_t i, len = *off;
+	size_t plain;
+	int ret;
 
-	for (i = 0; i < *off; i++) {
-		if (0) {
-			/* Extra debugging can be enabled separately if really
-			 * needed. Normally it would just print too much data.
-			 */
-			LOG_DBG("[%zd] %02x", i, buf[i]);
+	while (len > 0) {
+		/* Inside a frame, everything up to the next flag or escape
+		 * byte belongs to the frame as it is.
+		 */
+		if (ppp->state == STATE_HDLC_FRAME_DATA && !ppp->next_escaped) {
+			plain = ppp_plain_rx_len(data, len);
+			if (plain > 0) {
+				ret = ppp_save_bytes(ppp, data, plain);
+				if (ret < 0) {
+					ppp_change_state(ppp,
+							 STATE_HDLC_FRAME_START);
+				}
+
+				data += plain;
+				len -= plain;
+				continue;
+			}
 		}
 
-		if (ppp_input_byte(ppp, buf[i]) == 0) {
+		if (ppp_input_byte(ppp, *data++) == 0) {
 			/* Ignore empty or too short frames */
 			if (ppp->pkt && net_pkt_get_len(ppp->pkt) > 3) {
 				ppp_process_msg(ppp);
-				break;
 			}
 		}
+
+		len--;
 	}
+}
 
-	if (i == *off) {
-		*off = 0;
-	} else {
-		*off = len - i - 1;
+#if defined(CONFIG_NET_TEST)
+static uint8_t *ppp_recv_cb(uint8_t *buf, size_t *off)
+{
+	struct ppp_driver_context *ppp =
+		CONTAINER_OF(buf, struct ppp_driver_context, buf);
 
-		memmove(&buf[0], &buf[i + 1], *off);
+	if (0) {
+		/* Extra debugging can be enabled separately if really
+		 * needed. Normally it would just print too much data.
+		 */
+		LOG_HEXDUMP_DBG(buf, *off, "recv");
 	}
 
+	ppp_input(ppp, buf, *off);
+	*off = 0;
+
 	return buf;
 }
 
@@ -503,59 +710,16 @@ void ppp_driver_feed_data(uint8_t *data, int data_len)
 }
 #endif
 
-static bool calc_fcs(struct net_pkt *pkt, uint16_t *fcs, uint16_t protocol)
-{
-	struct net_buf *buf;
-	uint16_t crc;
-	uint16_t c;
-
-	buf = pkt->buffer;
-	if (!buf) {
-		return false;
-	}
-
-	/* HDLC Address and Control fields */
-	c = sys_cpu_to_be16(0xff << 8 | 0x03);
-
-	crc = crc16_ccitt(0xffff, (const uint8_t *)&c, sizeof(c));
-
-	if (protocol > 0) {
-		crc = crc16_ccitt(crc, (const uint8_t *)&protocol,
-				  sizeof(protocol));
-	}
-
-	while (buf) {
-		crc = crc16_ccitt(crc, buf->data, buf->len);
-		buf = buf->frags;
-	}
-
-	crc ^= 0xffff;
-	*fcs = crc;
-
-	return true;
-}
-
-static uint16_t ppp_escape_byte(uint8_t byte, int *offset)
-{
-	if (byte == 0x7e || byte == 0x7d || byte < 0x20) {
-		*offset = 0;
-		return (0x7d << 8) | (byte ^ 0x20);
-	}
-
-	*offset = 1;
-	return byte;
-}
-
 static int ppp_send(const struct device *dev, struct net_pkt *pkt)
 {
 	struct ppp_driver_context *ppp = dev->data;
 	struct net_buf *buf = pkt->buffer;
+	static const uint8_t addr_ctrl[] = { 0xff, 0x03 };
 	uint16_t protocol = 0;
 	int send_off = 0;
-	uint32_t sync_addr_ctrl;
-	uint16_t fcs, escaped;
+	uint8_t fcs[2];
+	uint16_t crc;
 	uint8_t byte;
-	int i, offset;
 
 #if defined(CONFIG_NET_TEST)
 	return 0;
@@ -595,26 +759,20 @@ static int ppp_send(const struct device *dev, struct net_pkt *pkt)
 		}
 	}
 
-	if (!calc_fcs(pkt, &fcs, protocol)) {
-		return -ENOMEM;
-	}
-
 	/* Sync, Address & Control fields */
-	sync_addr_ctrl = sys_cpu_to_be32(0x7e << 24 | 0xff << 16 |
-					 0x7d << 8 | 0x23);
-	send_off = ppp_send_bytes(ppp, (const uint8_t *)&sync_addr_ctrl,
-				  sizeof(sync_addr_ctrl), send_off);
+	byte = 0x7e;
+	send_off = ppp_send_bytes(ppp, &byte, 1, send_off);
+	send_off = ppp_send_escaped(ppp, addr_ctrl, sizeof(addr_ctrl),
+				    send_off);
+
+	crc = ppp_fcs(0xffff, addr_ctrl, sizeof(addr_ctrl));
 
 	if (protocol > 0) {
-		escaped = htons(ppp_escape_byte(protocol, &offset));
-		send_off = ppp_send_bytes(ppp, (uint8_t *)&escaped + offset,
-					  offset ? 1 : 2,
-					  send_off);
+		send_off = ppp_send_escaped(ppp, (const uint8_t *)&protocol,
+					    sizeof(protocol), send_off);
 
-		escaped = htons(ppp_escape_byte(protocol >> 8, &offset));
-		send_off = ppp_send_bytes(ppp, (uint8_t *)&escaped + offset,
-					  offset ? 1 : 2,
-					  send_off);
+		crc = ppp_fcs(crc, (const uint8_t *)&protocol,
+			      sizeof(protocol));
 	}
 
 	/* Note that we do not print the first four bytes and FCS bytes at the
@@ -626,27 +784,16 @@ static int ppp_send(const struct device *dev, struct net_pkt *pkt)
 	}
 
 	while (buf) {
-		for (i = 0; i < buf->len; i++) {
-			/* Escape illegal bytes */
-			escaped = htons(ppp_escape_byte(buf->data[i], &offset));
-			send_off = ppp_send_bytes(ppp,
-						  (uint8_t *)&escaped + offset,
-						  offset ? 1 : 2,
-						  send_off);
-		}
+		crc = ppp_fcs(crc, buf->data, buf->len);
+		send_off = ppp_send_escaped(ppp, buf->data, buf->len,
+					    send_off);
 
 		buf = buf->frags;
 	}
 
-	escaped = htons(ppp_escape_byte(fcs, &offset));
-	send_off = ppp_send_bytes(ppp, (uint8_t *)&escaped + offset,
-				  offset ? 1 : 2,
-				  send_off);
-
-	escaped = htons(ppp_escape_byte(fcs >> 8, &offset));
-	send_off = ppp_send_bytes(ppp, (uint8_t *)&escaped + offset,
-				  offset ? 1 : 2,
-				  send_off);
+	/* The FCS is sent least significant byte first */
+	sys_put_le16(crc ^ 0xffff, fcs);
+	send_off = ppp_send_escaped(ppp, fcs, sizeof(fcs), send_off);
 
 	byte = 0x7e;
 	send_off = ppp_send_bytes(ppp, &byte, 1, send_off);
@@ -660,7 +807,7 @@ static int ppp_send(const struct device *dev, struct net_pkt *pkt)
 static int ppp_consume_ringbuf(struct ppp_driver_context *ppp)
 {
 	uint8_t *data;
-	size_t len, tmp;
+	size_t len;
 	int ret;
 
 	len = ring_buf_get_claim(&ppp->rx_ringbuf, &data,
@@ -675,16 +822,7 @@ static int ppp_consume_ringbuf(struct ppp_driver_context *ppp)
 		LOG_HEXDUMP_DBG(data, len, ppp->dev->name);
 	}
 
-	tmp = len;
-
-	do {
-		if (ppp_input_byte(ppp, *data++) == 0) {
-			/* Ignore empty or too short frames */
-			if (ppp->pkt && net_pkt_get_len(ppp->pkt) > 3) {
-				ppp_process_msg(ppp);
-			}
-		}
-	} while (--tmp);
+	ppp_input(ppp, data, len);
 
 	ret = ring_buf_get_finish(&ppp->rx_ringbuf, len);
 	if (ret < 0) {
@@ -715,6 +853,9 @@ static int ppp_driver_init(const struct device *dev)
 #if !defined(CONFIG_NET_TEST)
 	ring_buf_init(&ppp->rx_ringbuf, sizeof(ppp->rx_buf), ppp->rx_buf);
 	k_work_init(&ppp->cb_work, ppp_isr_cb_work);
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+	k_sem_init(&ppp->tx_done, 0, 1);
+#endif
 
 	k_work_queue_start(&ppp->cb_workq, ppp_workq,
 			   K_KERNEL_STACK_SIZEOF(ppp_workq),
@@ -798,7 +939,75 @@ static struct net_stats_ppp *ppp_get_stats(const struct device *dev)
 }
 #endif
 
-#if !defined(CONFIG_NET_TEST)
+#if !defined(CONFIG_NET_TEST) && defined(CONFIG_NET_PPP_ASYNC_UART)
+static int ppp_uart_rx_enable(struct ppp_driver_context *context)
+{
+	context->rx_dma_next = 1;
+
+	return uart_rx_enable(context->dev, context->rx_dma_buf[0],
+			      sizeof(context->rx_dma_buf[0]),
+			      CONFIG_NET_PPP_ASYNC_UART_RX_TIMEOUT);
+}
+
+static void ppp_uart_callback(const struct device *dev,
+			      struct uart_event *evt, void *user_data)
+{
+	struct ppp_driver_context *context = user_data;
+	uint32_t ret;
+	int err;
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		k_sem_give(&context->tx_done);
+		break;
+
+	case UART_RX_RDY:
+		ret = ring_buf_put(&context->rx_ringbuf,
+				   evt->data.rx.buf + evt->data.rx.offset,
+				   evt->data.rx.len);
+		if (ret < evt->data.rx.len) {
+			LOG_ERR("Rx buffer doesn't have enough space. "
+				"Bytes pending: %zu, written: %u",
+				evt->data.rx.len, ret);
+		}
+
+		k_work_submit_to_queue(&context->cb_workq, &context->cb_work);
+		break;
+
+	case UART_RX_BUF_REQUEST:
+		err = uart_rx_buf_rsp(dev,
+				      context->rx_dma_buf[context->rx_dma_next],
+				      sizeof(context->rx_dma_buf[0]));
+		if (err < 0) {
+			LOG_ERR("Cannot provide RX buffer (%d)", err);
+		}
+
+		context->rx_dma_next ^= 1;
+		break;
+
+	case UART_RX_STOPPED:
+		LOG_DBG("RX stopped (%d)", evt->data.rx_stop.reason);
+		break;
+
+	case UART_RX_DISABLED:
+		/* Reception stops after an error, start it again */
+		if (atomic_get(&context->modem_init_done)) {
+			err = ppp_uart_rx_enable(context);
+			if (err < 0) {
+				LOG_ERR("Cannot enable RX (%d)", err);
+			}
+		}
+
+		break;
+
+	default:
+		break;
+	}
+}
+#endif /* !CONFIG_NET_TEST && CONFIG_NET_PPP_ASYNC_UART */
+
+#if !defined(CONFIG_NET_TEST) && !defined(CONFIG_NET_PPP_ASYNC_UART)
 static void ppp_uart_flush(const struct device *dev)
 {
 	uint8_t c;
@@ -831,7 +1040,7 @@ static void ppp_uart_isr(const struct device *uart, void *user_data)
 		k_work_submit_to_queue(&context->cb_workq, &context->cb_work);
 	}
 }
-#endif /* !CONFIG_NET_TEST */
+#endif /* !CONFIG_NET_TEST && !CONFIG_NET_PPP_ASYNC_UART */
 
 static int ppp_start(const struct device *dev)
 {
@@ -879,12 +1088,31 @@ static int ppp_start(const struct device *dev)
 			return -ENODEV;
 		}
 
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+		int ret;
+
+		ret = uart_callback_set(context->dev, ppp_uart_callback,
+					context);
+		if (ret < 0) {
+			LOG_ERR("Cannot set UART callback (%d)", ret);
+			context->modem_init_done = false;
+			return ret;
+		}
+
+		ret = ppp_uart_rx_enable(context);
+		if (ret < 0 && ret != -EBUSY) {
+			LOG_ERR("Cannot enable RX (%d)", ret);
+			context->modem_init_done = false;
+			return ret;
+		}
+#else
 		uart_irq_rx_disable(context->dev);
 		uart_irq_tx_disable(context->dev);
 		ppp_uart_flush(context->dev);
 		uart_irq_callback_user_data_set(context->dev, ppp_uart_isr,
 						context);
 		uart_irq_rx_enable(context->dev);
+#endif
 	}
 #endif /* !CONFIG_NET_TEST */
 
@@ -51,6 +51,9 @@ static struct intel_gna_config_desc __aligned(GNA_PG_SIZE_IN_BYTES)
 static struct intel_gna_page_table __aligned(GNA_PG_SIZE_IN_BYTES)
 	gna_page_table[GNA_NUM_PG_TABLES_NEEDED];
 
+static void intel_gna_start(struct intel_gna_data *gna,
+		struct intel_gna_pending_req *req);
+
 static void intel_gna_interrupt_handler(const struct device *dev)
 {
 	struct intel_gna_data *const gna = DEV_DATA(dev);
@@ -58,6 +61,11 @@ static void intel_gna_interrupt_handler(const struct device *dev)
 	volatile struct intel_gna_regs *regs = gna->regs;
 	struct intel_gna_pending_resp pending_resp;
 	struct intel_gna_pending_req pending_req;
+	struct gna_model_stats *stats;
+	uint32_t latency_us;
+	k_spinlock_key_t key;
+
+	pending_resp.response.result = GNA_RESULT_GENERIC_ERROR;
 
 	/* check for generic / virtual address out of range error */
 	if (regs->gnasts & (GNA_STS_VIRT_ADDR_OOR | GNA_STS_ERROR)) {
@@ -81,14 +89,23 @@ static void intel_gna_interrupt_handler(const struct device *dev)
 		pending_resp.response.result = GNA_RESULT_INFERENCE_COMPLETE;
 	}
 
+	key = k_spin_lock(&gna->lock);
+
 	if (k_msgq_get(&gna->request_queue, &pending_req, K_NO_WAIT) != 0) {
 		LOG_ERR("Pending request queue is empty");
 	} else {
-		SOC_DCACHE_INVALIDATE(pending_req.model->output,
-				pending_req.output_len);
-		/* copy output from the model buffer to applciation buffer */
-		memcpy(pending_req.output, pending_req.model->output,
-				pending_req.output_len);
+		if (pending_req.output_mapped) {
+			SOC_DCACHE_INVALIDATE(pending_req.output,
+					pending_req.output_len);
+		} else {
+			SOC_DCACHE_INVALIDATE(pending_req.model->output,
+					pending_req.output_len);
+			/* copy output from the model buffer to application
+			 * buffer
+			 */
+			memcpy(pending_req.output, pending_req.model->output,
+					pending_req.output_len);
+		}
 		pending_resp.response.output = pending_req.output;
 		pending_resp.response.output_len = pending_req.output_len;
 		pending_resp.callback = pending_req.callback;
@@ -102,7 +119,25 @@ static void intel_gna_interrupt_handler(const struct device *dev)
 			pending_resp.response.stats.stall_cycles = 0U;
 		}
 
-		k_msgq_put(&gna->response_queue, &pending_resp, K_NO_WAIT);
+		latency_us = k_cyc_to_us_floor32(k_cycle_get_32() -
+				pending_req.submit_cycles);
+		stats = &pending_req.model->stats;
+		stats->inferences++;
+		if (pending_resp.response.result !=
+				GNA_RESULT_INFERENCE_COMPLETE) {
+			stats->errors++;
+		}
+		stats->last_latency_us = latency_us;
+		stats->max_latency_us = MAX(stats->max_latency_us, latency_us);
+		stats->total_latency_us += latency_us;
+		stats->total_cycles +=
+			pending_resp.response.stats.total_cycles;
+		pending_req.model->pending--;
+
+		if (k_msgq_put(&gna->response_queue, &pending_resp,
+					K_NO_WAIT) != 0) {
+			LOG_ERR("Response queue is full");
+		}
 
 		k_work_submit(&gna->gna_work);
 	}
@@ -110,6 +145,13 @@ static void intel_gna_interrupt_handler(const struct device *dev)
 	/* clear GNA operation and disable interrupt */
 	regs->gnactrl |= GNA_CTRL_INTR_DISABLE | GNA_CTRL_ABORT_CLEAR;
 	gna->state = GNA_STATE_IDLE;
+
+	/* start the next request right away, its input is ready */
+	if (k_msgq_peek(&gna->request_queue, &pending_req) == 0) {
+		intel_gna_start(gna, &pending_req);
+	}
+
+	k_spin_unlock(&gna->lock, key);
 }
 
 static void gna_work_handler(struct k_work *work)
@@ -168,6 +210,82 @@ static int intel_gna_setup_page_table(void *physical, size_t size,
 	return 0;
 }
 
+/* Whether the GNA may access buf in place of the model region at va:
+ * it must lie in L2 SRAM at the same page offset.
+ */
+static bool intel_gna_mappable(uint32_t va, void *buf, size_t size)
+{
+	uint32_t addr = (uint32_t)buf;
+
+	return (GNA_PG_OFFSET(addr) == GNA_PG_OFFSET(va)) &&
+		(addr >= L2_SRAM_BASE) &&
+		((addr + size - L2_SRAM_BASE) <= L2_SRAM_SIZE);
+}
+
+/* Map the pages of the region at va to those of buf, unless they already
+ * are, and flush the updated page table entries.
+ */
+static void intel_gna_remap(uint32_t va, uint32_t *map, void *buf,
+		size_t size)
+{
+	uint32_t pages = GNA_NUM_PAGES(GNA_PG_OFFSET(va) + size);
+	uint32_t *entry;
+
+	if (*map == GNA_PG_BASE(buf)) {
+		return;
+	}
+
+	intel_gna_setup_page_table((void *)GNA_PG_BASE(buf),
+			GNA_PAGES_TO_BYTES(pages), (void *)GNA_PG_BASE(va));
+
+	entry = &gna_page_table[GNA_VA_PG_DIR(va)].entry[GNA_VA_PG_TABLE(va)];
+	SOC_DCACHE_FLUSH(entry, pages * sizeof(*entry));
+
+	*map = GNA_PG_BASE(buf);
+}
+
+/* Start an inference, called with the lock held while the GNA is idle */
+static void intel_gna_start(struct intel_gna_data *gna,
+		struct intel_gna_pending_req *req)
+{
+	volatile struct intel_gna_regs *regs = gna->regs;
+	struct intel_gna_model *handle = req->model;
+	struct gna_model_header *header = handle->model.header;
+	size_t input_size = header->bytes_per_input * header->num_input_nodes;
+	void *input;
+	void *output;
+
+	if (req->input_mapped) {
+		input = req->input;
+	} else {
+		/* copy input */
+		memcpy(handle->input, req->input, input_size);
+		input = handle->input;
+	}
+	SOC_DCACHE_FLUSH(input, input_size);
+	intel_gna_remap(handle->input_va, &handle->input_map, input,
+			input_size);
+
+	if (req->output_mapped) {
+		/* no dirty line may be written back over the results */
+		SOC_DCACHE_INVALIDATE(req->output, req->output_len);
+		output = req->output;
+	} else {
+		output = handle->output;
+	}
+	intel_gna_remap(handle->output_va, &handle->output_map, output,
+			req->output_len);
+
+	/* assign layer descriptor base address to configuration descriptor */
+	gna_config_desc.labase = (uint32_t)handle->vabase;
+	gna_config_desc.lacnt = (uint16_t)header->layer_count;
+	SOC_DCACHE_FLUSH(&gna_config_desc, sizeof(gna_config_desc));
+
+	gna->state = GNA_STATE_ACTIVE;
+	regs->gnactrl = (regs->gnactrl & ~GNA_CTRL_INTR_DISABLE) |
+		GNA_CTRL_ACCEL_START | GNA_CTRL_STATS_ENABLE_STALL;
+}
+
 static int intel_gna_initialize(const struct device *dev)
 {
 	struct intel_gna_data *const gna = DEV_DATA(dev);
@@ -369,6 +487,14 @@ static int intel_gna_register_model(const struct device *dev,
 	gna_model->output = (void *)((uint32_t)model->rw_region +
 			*(uint32_t *)((uint32_t)model->rw_region +
 				header->output_ptr_offset));
+	gna_model->input_va = (uint32_t)virtual_base +
+		((uint32_t)gna_model->input - (uint32_t)model->rw_region);
+	gna_model->output_va = (uint32_t)virtual_base +
+		((uint32_t)gna_model->output - (uint32_t)model->rw_region);
+	gna_model->input_map = GNA_PG_BASE(gna_model->input);
+	gna_model->output_map = GNA_PG_BASE(gna_model->output);
+	memset(&gna_model->stats, 0, sizeof(gna_model->stats));
+	gna_model->pending = 0U;
 	gna_model->registered = true;
 
 	LOG_INF("model->rw_region: %p", model->rw_region);
@@ -396,6 +522,11 @@ static int intel_gna_deregister_model(const struct device *dev,
 	}
 
 	gna_model = (struct intel_gna_model *)model_handle;
+	if (gna_model->pending != 0U) {
+		LOG_ERR("Model has %u pending requests", gna_model->pending);
+		return -EBUSY;
+	}
+
 	gna_model->registered = false;
 	k_mem_slab_free(&gna->model_slab, &model_handle);
 
@@ -407,15 +538,22 @@ static int intel_gna_infer(const struct device *dev,
 			   gna_callback callback)
 {
 	struct intel_gna_data *const gna = DEV_DATA(dev);
-	volatile struct intel_gna_regs *regs = gna->regs;
 	struct intel_gna_pending_req pending_req;
 	struct gna_model_header *header;
 	struct intel_gna_model *handle;
 	struct gna_model_info *model;
+	k_spinlock_key_t key;
 	size_t input_size;
+	bool map_io;
 	int ret;
 
 	LOG_DBG("device %p", dev);
+	if ((gna->state != GNA_STATE_IDLE) &&
+			(gna->state != GNA_STATE_ACTIVE)) {
+		LOG_ERR("Invalid state (%u)", gna->state);
+		return -EINVAL;
+	}
+
 	if (req == NULL) {
 		LOG_ERR("Invalid request pointer");
 		return -EINVAL;
@@ -447,35 +585,64 @@ static int intel_gna_infer(const struct device *dev,
 	header = model->header;
 	input_size = header->bytes_per_input * header->num_input_nodes;
 
+	map_io = (model->flags & GNA_MODEL_MAP_IO) != 0U;
+
 	pending_req.model = handle;
+	pending_req.input = req->input;
 	pending_req.output = req->output;
 	pending_req.output_len = header->bytes_per_output *
 		header->num_output_nodes;
 	pending_req.callback = callback;
+	pending_req.submit_cycles = k_cycle_get_32();
+	pending_req.input_mapped = map_io &&
+		intel_gna_mappable(handle->input_va, req->input, input_size);
+	pending_req.output_mapped = map_io &&
+		intel_gna_mappable(handle->output_va, req->output,
+				pending_req.output_len);
+
+	key = k_spin_lock(&gna->lock);
 
 	ret = k_msgq_put(&gna->request_queue, &pending_req, K_NO_WAIT);
 	if (ret) {
+		k_spin_unlock(&gna->lock, key);
 		LOG_ERR("Unable to queue request (code %d)", ret);
 		return ret;
 	}
 
-	if (gna->state != GNA_STATE_IDLE) {
-		/* multiple pending requests are not yet supported */
-		return -EBUSY;
+	handle->pending++;
+
+	/* otherwise started on completion of the requests ahead */
+	if (gna->state == GNA_STATE_IDLE) {
+		intel_gna_start(gna, &pending_req);
 	}
 
-	/* copy input */
-	memcpy(handle->input, req->input, input_size);
-	SOC_DCACHE_FLUSH(handle->input, input_size);
+	k_spin_unlock(&gna->lock, key);
 
-	/* assign layer descriptor base address to configuration descriptor */
-	gna_config_desc.labase = (uint32_t)handle->vabase;
-	gna_config_desc.lacnt = (uint16_t)header->layer_count;
-	SOC_DCACHE_FLUSH(&gna_config_desc, sizeof(gna_config_desc));
+	return 0;
+}
 
-	gna->state = GNA_STATE_ACTIVE;
-	regs->gnactrl = (regs->gnactrl & ~GNA_CTRL_INTR_DISABLE) |
-		GNA_CTRL_ACCEL_START | GNA_CTRL_STATS_ENABLE_STALL;
+static int intel_gna_model_stats_get(const struct device *dev,
+				     void *model_handle,
+				     struct gna_model_stats *stats,
+				     bool reset)
+{
+	struct intel_gna_data *const gna = DEV_DATA(dev);
+	struct intel_gna_model *handle;
+	k_spinlock_key_t key;
+
+	if ((model_handle == NULL) || (stats == NULL)) {
+		LOG_ERR("model_handle and/or stats is NULL");
+		return -EINVAL;
+	}
+
+	handle = (struct intel_gna_model *)model_handle;
+
+	key = k_spin_lock(&gna->lock);
+	*stats = handle->stats;
+	if (reset) {
+		memset(&handle->stats, 0, sizeof(handle->stats));
+	}
+	k_spin_unlock(&gna->lock, key);
 
 	return 0;
 }
@@ -518,6 +685,7 @@ static const struct gna_driver_api gna_driver_api = {
 	.register_model		= intel_gna_register_model,
 	.deregister_model	= intel_gna_deregister_model,
 	.infer			= intel_gna_infer,
+	.model_stats_get	= intel_gna_model_stats_get,
 };
 
 static struct intel_gna_data intel_gna_driver_data = {
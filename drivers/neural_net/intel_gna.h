@@ -158,14 +158,26 @@ struct intel_gna_model {
 	void			*input;
 	void			*output;
 	void			*vabase;
+	/* virtual addresses of the input and output seen by the GNA */
+	uint32_t		input_va;
+	uint32_t		output_va;
+	/* physical page the input and output are currently mapped to */
+	uint32_t		input_map;
+	uint32_t		output_map;
+	struct gna_model_stats	stats;
+	uint16_t		pending;
 	bool			registered;
 };
 
 struct intel_gna_pending_req {
 	struct intel_gna_model	*model;
+	void			*input;
 	void			*output;
 	size_t			output_len;
 	gna_callback		callback;
+	uint32_t		submit_cycles;
+	bool			input_mapped;
+	bool			output_mapped;
 };
 
 struct intel_gna_pending_resp {
@@ -194,6 +206,7 @@ struct intel_gna_data {
 	struct k_msgq			response_queue;
 	struct intel_gna_pending_resp	responses[GNA_REQUEST_QUEUE_LEN];
 	enum gna_state			state;
+	struct k_spinlock		lock;
 
 	struct gna_config		config;
 };
@@ -681,6 +681,31 @@ static int adxl372_attr_set_thresh(const struct device *dev,
 	}
 }
 
+#ifdef CONFIG_SENSOR_FIFO
+static int adxl372_attr_set_fifo_watermark(const struct device *dev,
+					   const struct sensor_value *val)
+{
+	const struct adxl372_dev_config *cfg = dev->config;
+	struct adxl372_data *data = dev->data;
+	int ret;
+
+	if (val->val1 <= 0 ||
+	    val->val1 > ADXL372_FIFO_MAX_SAMPLES / ADXL372_FIFO_FRAME_SAMPLES) {
+		return -EINVAL;
+	}
+
+	ret = adxl372_configure_fifo(dev, data->fifo_config.fifo_mode,
+				     data->fifo_config.fifo_format,
+				     val->val1 * ADXL372_FIFO_FRAME_SAMPLES);
+	if (ret) {
+		return ret;
+	}
+
+	/* The FIFO is configured in standby mode. */
+	return adxl372_set_op_mode(dev, cfg->op_mode);
+}
+#endif /* CONFIG_SENSOR_FIFO */
+
 static int adxl372_attr_set(const struct device *dev,
 			    enum sensor_channel chan,
 			    enum sensor_attribute attr,
@@ -692,6 +717,10 @@ static int adxl372_attr_set(const struct device *dev,
 	case SENSOR_ATTR_UPPER_THRESH:
 	case SENSOR_ATTR_LOWER_THRESH:
 		return adxl372_attr_set_thresh(dev, chan, attr, val);
+#ifdef CONFIG_SENSOR_FIFO
+	case SENSOR_ATTR_FIFO_WATERMARK:
+		return adxl372_attr_set_fifo_watermark(dev, val);
+#endif
 	default:
 		return -ENOTSUP;
 	}
@@ -719,6 +748,15 @@ static void adxl372_accel_convert(struct sensor_value *val, int16_t value)
 	val->val2 = micro_ms2 % 1000000;
 }
 
+#ifdef CONFIG_SENSOR_FIFO
+/* Same scale as adxl372_accel_convert(), in m/s^2 * 2^(31 - shift). */
+static int32_t adxl372_accel_to_q31(int16_t value)
+{
+	return (int64_t)value * SENSOR_G * BIT(31 - ADXL372_FIFO_SHIFT) /
+	       (160LL * 1000000LL);
+}
+#endif
+
 static int adxl372_channel_get(const struct device *dev,
 			       enum sensor_channel chan,
 			       struct sensor_value *val)
@@ -747,6 +785,82 @@ static int adxl372_channel_get(const struct device *dev,
 	return 0;
 }
 
+#ifdef CONFIG_SENSOR_FIFO
+static int adxl372_fifo_read(const struct device *dev, void *buf, size_t size)
+{
+	uint16_t entries, frames;
+	uint8_t status1;
+	int ret;
+
+	ret = adxl372_get_status(dev, &status1, NULL, &entries);
+	if (ret) {
+		return ret;
+	}
+
+	/* Only complete frames are read, the FIFO keeps the X, Y and Z
+	 * samples of a frame together.
+	 */
+	frames = MIN(entries / ADXL372_FIFO_FRAME_SAMPLES,
+		     size / ADXL372_FIFO_FRAME_SIZE);
+	if (frames == 0) {
+		return 0;
+	}
+
+	ret = adxl372_reg_read_multiple(dev, ADXL372_FIFO_DATA, buf,
+					frames * ADXL372_FIFO_FRAME_SIZE);
+
+	return ret ? ret : frames;
+}
+
+static int adxl372_fifo_decode(const struct device *dev,
+			       const void *buf, size_t size,
+			       enum sensor_channel chan,
+			       int32_t *values, size_t value_cnt,
+			       int8_t *shift)
+{
+	const uint8_t *frame = buf;
+	size_t frames = size / ADXL372_FIFO_FRAME_SIZE;
+	int first, axes;
+	int16_t sample;
+	int cnt = 0;
+
+	switch (chan) {
+	case SENSOR_CHAN_ACCEL_X:
+	case SENSOR_CHAN_ACCEL_Y:
+	case SENSOR_CHAN_ACCEL_Z:
+		first = chan - SENSOR_CHAN_ACCEL_X;
+		axes = 1;
+		break;
+	case SENSOR_CHAN_ACCEL_XYZ:
+		first = 0;
+		axes = 3;
+		break;
+	default:
+		return -ENOTSUP;
+	}
+
+	frames = MIN(frames, value_cnt / axes);
+
+	/* +/-200 g fits in 2^11 m/s^2. */
+	*shift = ADXL372_FIFO_SHIFT;
+
+	for (size_t i = 0; i < frames; i++) {
+		for (int axis = first; axis < first + axes; axis++) {
+			/* 12-bit left-aligned samples, the low bits hold
+			 * status flags.
+			 */
+			sample = (int16_t)(((frame[2 * axis] << 8) |
+					    frame[2 * axis + 1]) & 0xFFF0);
+			values[cnt++] = adxl372_accel_to_q31(sample);
+		}
+
+		frame += ADXL372_FIFO_FRAME_SIZE;
+	}
+
+	return cnt;
+}
+#endif /* CONFIG_SENSOR_FIFO */
+
 static const struct sensor_driver_api adxl372_api_funcs = {
 	.attr_set     = adxl372_attr_set,
 	.sample_fetch = adxl372_sample_fetch,
@@ -754,6 +868,10 @@ static const struct sensor_driver_api adxl372_api_funcs = {
 #ifdef CONFIG_ADXL372_TRIGGER
 	.trigger_set = adxl372_trigger_set,
 #endif
+#ifdef CONFIG_SENSOR_FIFO
+	.fifo_read = adxl372_fifo_read,
+	.fifo_decode = adxl372_fifo_decode,
+#endif
 
 };
 
@@ -1018,7 +1136,9 @@ static const struct adxl372_dev_config adxl372_config = {
 
 	.filter_settle = ADXL372_FILTER_SETTLE_370,
 	.fifo_config.fifo_mode = ADXL372_FIFO_STREAMED,
-	.fifo_config.fifo_format = ADXL372_XYZ_PEAK_FIFO,
+	/* Streams all samples in measurement mode, for sensor_fifo_read(). */
+	.fifo_config.fifo_format = IS_ENABLED(CONFIG_ADXL372_PEAK_DETECT_MODE) ?
+				   ADXL372_XYZ_PEAK_FIFO : ADXL372_XYZ_FIFO,
 	.fifo_config.fifo_samples = 128,
 
 	.op_mode = ADXL372_FULL_BW_MEASUREMENT,
@@ -116,6 +116,12 @@
 #define ADXL372_TIMING_EXT_SYNC_MSK		BIT(0)
 #define ADXL372_TIMING_EXT_SYNC_MODE(x)		(((x) & 0x1) << 0)
 
+/* ADXL372_FIFO_DATA */
+#define ADXL372_FIFO_MAX_SAMPLES		512
+#define ADXL372_FIFO_FRAME_SAMPLES		3
+#define ADXL372_FIFO_FRAME_SIZE			(ADXL372_FIFO_FRAME_SAMPLES * 2)
+#define ADXL372_FIFO_SHIFT			11
+
 /* ADXL372_FIFO_CTL */
 #define ADXL372_FIFO_CTL_FORMAT_MSK		GENMASK(5, 3)
 #define ADXL372_FIFO_CTL_FORMAT_MODE(x)		(((x) & 0x7) << 3)
@@ -297,6 +303,10 @@ struct adxl372_data {
 	struct sensor_trigger th_trigger;
 	sensor_trigger_handler_t drdy_handler;
 	struct sensor_trigger drdy_trigger;
+#ifdef CONFIG_SENSOR_FIFO
+	sensor_trigger_handler_t fifo_handler;
+	struct sensor_trigger fifo_trigger;
+#endif
 	const struct device *dev;
 
 #if defined(CONFIG_ADXL372_TRIGGER_OWN_THREAD)
@@ -46,6 +46,13 @@ static void adxl372_thread_cb(const struct device *dev)
 		drv_data->drdy_handler(dev, &drv_data->drdy_trigger);
 	}
 
+#ifdef CONFIG_SENSOR_FIFO
+	if ((drv_data->fifo_handler != NULL) &&
+		ADXL372_STATUS_1_FIFO_FULL(status1)) {
+		drv_data->fifo_handler(dev, &drv_data->fifo_trigger);
+	}
+#endif
+
 	gpio_pin_interrupt_configure(drv_data->gpio, cfg->int_gpio,
 				     GPIO_INT_EDGE_TO_ACTIVE);
 }
@@ -110,6 +117,13 @@ int adxl372_trigger_set(const struct device *dev,
 		drv_data->drdy_trigger = *trig;
 		int_mask = ADXL372_INT1_MAP_DATA_RDY_MSK;
 		break;
+#ifdef CONFIG_SENSOR_FIFO
+	case SENSOR_TRIG_FIFO_WATERMARK:
+		drv_data->fifo_handler = handler;
+		drv_data->fifo_trigger = *trig;
+		int_mask = ADXL372_INT1_MAP_FIFO_FULL_MSK;
+		break;
+#endif
 	default:
 		LOG_ERR("Unsupported sensor trigger");
 		ret = -ENOTSUP;
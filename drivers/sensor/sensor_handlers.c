@@ -57,3 +57,30 @@ static inline int z_vrfy_sensor_channel_get(const struct device *dev,
 					 (struct sensor_value *)val);
 }
 #include <syscalls/sensor_channel_get_mrsh.c>
+
+#ifdef CONFIG_SENSOR_FIFO
+static inline int z_vrfy_sensor_fifo_read(const struct device *dev,
+					  void *buf, size_t size)
+{
+	Z_OOPS(Z_SYSCALL_DRIVER_SENSOR(dev, fifo_read));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(buf, size));
+	return z_impl_sensor_fifo_read((const struct device *)dev, buf, size);
+}
+#include <syscalls/sensor_fifo_read_mrsh.c>
+
+static inline int z_vrfy_sensor_fifo_decode(const struct device *dev,
+					    const void *buf, size_t size,
+					    enum sensor_channel chan,
+					    int32_t *values, size_t value_cnt,
+					    int8_t *shift)
+{
+	Z_OOPS(Z_SYSCALL_DRIVER_SENSOR(dev, fifo_decode));
+	Z_OOPS(Z_SYSCALL_MEMORY_READ(buf, size));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(values, value_cnt,
+					    sizeof(int32_t)));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(shift, sizeof(*shift)));
+	return z_impl_sensor_fifo_decode((const struct device *)dev, buf,
+					 size, chan, values, value_cnt, shift);
+}
+#include <syscalls/sensor_fifo_decode_mrsh.c>
+#endif /* CONFIG_SENSOR_FIFO */
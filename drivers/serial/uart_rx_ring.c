@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <drivers/uart/rx_ring.h>
+
+/* ring_buf_put_finish() drops the claims which were not finished, claim the
+ * space of the buffers still owned by the driver again. It follows the
+ * committed data, as when it was first claimed.
+ */
+static void claims_restore(struct uart_rx_ring *ring)
+{
+	uint32_t size = ring->claimed;
+	uint8_t *data;
+	uint32_t len;
+
+	while (size > 0) {
+		len = ring_buf_put_claim(ring->rb, &data, size);
+		if (len == 0) {
+			break;
+		}
+
+		size -= len;
+	}
+}
+
+static uint32_t buf_claim(struct uart_rx_ring *ring, uint8_t **buf)
+{
+	uint32_t len = ring_buf_put_claim(ring->rb, buf, ring->chunk);
+
+	ring->claimed += len;
+
+	return len;
+}
+
+static void buf_provide(struct uart_rx_ring *ring)
+{
+	uint8_t *buf;
+	uint32_t len = buf_claim(ring, &buf);
+
+	ring->buf_wanted = (len == 0);
+	if (len > 0 && uart_rx_buf_rsp(ring->dev, buf, len) != 0) {
+		/* The reception ended meanwhile. */
+		ring->claimed -= len;
+		(void)ring_buf_put_finish(ring->rb, 0);
+		claims_restore(ring);
+	}
+}
+
+static int rx_start(struct uart_rx_ring *ring)
+{
+	uint8_t *buf;
+	uint32_t len;
+	int err;
+
+	ring->claimed = 0;
+	ring->buf_wanted = false;
+	ring->stopped = false;
+
+	len = buf_claim(ring, &buf);
+	if (len == 0) {
+		ring->stopped = true;
+		return -ENOMEM;
+	}
+
+	err = uart_rx_enable(ring->dev, buf, len, ring->timeout);
+	if (err) {
+		ring->claimed = 0;
+		(void)ring_buf_put_finish(ring->rb, 0);
+		ring->stopped = true;
+	}
+
+	return err;
+}
+
+static void event_handler(const struct device *dev, struct uart_event *evt,
+			  void *user_data)
+{
+	struct uart_rx_ring *ring = user_data;
+
+	switch (evt->type) {
+	case UART_RX_BUF_REQUEST:
+		buf_provide(ring);
+		return;
+	case UART_RX_BUF_RELEASED:
+		/* The buffers are parts of the ring buffer. */
+		return;
+	case UART_RX_RDY:
+		/* The buffers are filled in order, the data follows the data
+		 * committed before.
+		 */
+		ring->claimed -= evt->data.rx.len;
+		(void)ring_buf_put_finish(ring->rb, evt->data.rx.len);
+		claims_restore(ring);
+		break;
+	case UART_RX_DISABLED:
+		/* Give back the space the driver did not receive into. */
+		ring->claimed = 0;
+		ring->buf_wanted = false;
+		(void)ring_buf_put_finish(ring->rb, 0);
+		ring->stopped = ring->enabled;
+		break;
+	default:
+		break;
+	}
+
+	if (ring->callback) {
+		ring->callback(dev, evt, ring->user_data);
+	}
+}
+
+int uart_rx_ring_enable(struct uart_rx_ring *ring, const struct device *dev,
+			struct ring_buf *rb, uint32_t chunk, int32_t timeout,
+			uart_callback_t callback, void *user_data)
+{
+	int err;
+
+	ring->dev = dev;
+	ring->rb = rb;
+	ring->chunk = chunk;
+	ring->timeout = timeout;
+	ring->callback = callback;
+	ring->user_data = user_data;
+
+	err = uart_callback_set(dev, event_handler, ring);
+	if (err) {
+		return err;
+	}
+
+	ring->enabled = true;
+	err = rx_start(ring);
+	if (err) {
+		ring->enabled = false;
+	}
+
+	return err;
+}
+
+int uart_rx_ring_disable(struct uart_rx_ring *ring)
+{
+	ring->enabled = false;
+
+	return uart_rx_disable(ring->dev);
+}
+
+int uart_rx_ring_get_finish(struct uart_rx_ring *ring, uint32_t size)
+{
+	unsigned int key;
+	bool restart;
+	int err;
+
+	err = ring_buf_get_finish(ring->rb, size);
+	if (err) {
+		return err;
+	}
+
+	key = irq_lock();
+
+	if (ring->buf_wanted) {
+		buf_provide(ring);
+	}
+
+	restart = ring->enabled && ring->stopped;
+
+	irq_unlock(key);
+
+	if (restart) {
+		(void)rx_start(ring);
+	}
+
+	return 0;
+}
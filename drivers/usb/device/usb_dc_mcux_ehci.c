@@ -64,15 +64,24 @@ extern void USB_DeviceEhciIsrFunction(void *deviceHandle);
 /* The minimum value is 1 */
 #define EP_BUF_NUMOF_BLOCKS	((NUM_OF_EP_MAX + 3) / 4)
 
+/* Multi-packet buffers of the bulk IN endpoints */
+#define EP_BUF_BULK_SIZE	(CONFIG_USB_DC_NXP_EHCI_BULK_BUF_SIZE * \
+				 CONFIG_USB_DC_NXP_EHCI_BULK_BUF_COUNT)
+
 /* The max MPS is 1023 for FS, 1024 for HS. */
 #if defined(CONFIG_NOCACHE_MEMORY)
 #define EP_BUF_NONCACHED
-__nocache K_HEAP_DEFINE(ep_buf_pool, 1024 * EP_BUF_NUMOF_BLOCKS);
+__nocache K_HEAP_DEFINE(ep_buf_pool,
+			1024 * EP_BUF_NUMOF_BLOCKS + EP_BUF_BULK_SIZE);
 #else
-K_HEAP_DEFINE(ep_buf_pool, 1024 * EP_BUF_NUMOF_BLOCKS);
+K_HEAP_DEFINE(ep_buf_pool, 1024 * EP_BUF_NUMOF_BLOCKS + EP_BUF_BULK_SIZE);
 #endif
 
 static usb_ep_ctrl_data_t s_ep_ctrl[NUM_OF_EP_MAX];
+/* Size of the endpoint buffers, the max packet size or the size of the
+ * multi-packet buffers.
+ */
+static uint32_t ep_buf_len[NUM_OF_EP_MAX];
 static usb_device_struct_t dev_data;
 
 #if ((defined(USB_DEVICE_CONFIG_EHCI)) && (USB_DEVICE_CONFIG_EHCI > 0U))
@@ -211,13 +220,34 @@ int usb_dc_ep_configure(const struct usb_dc_ep_cfg_data *const cfg)
 		block->data = NULL;
 	}
 
-	block->data = k_heap_alloc(&ep_buf_pool, cfg->ep_mps, K_MSEC(10));
+	/*
+	 * A write on a bulk IN endpoint is sent as several packets at once,
+	 * split by the controller, when it gets a multi-packet buffer. Fall
+	 * back to a single packet buffer when they are all in use.
+	 */
+	ep_buf_len[ep_abs_idx] = cfg->ep_mps;
+	if ((cfg->ep_type == USB_DC_EP_BULK) && USB_EP_DIR_IS_IN(cfg->ep_addr) &&
+	    (CONFIG_USB_DC_NXP_EHCI_BULK_BUF_SIZE > cfg->ep_mps)) {
+		block->data = k_heap_alloc(&ep_buf_pool,
+					   CONFIG_USB_DC_NXP_EHCI_BULK_BUF_SIZE,
+					   K_NO_WAIT);
+		if (block->data != NULL) {
+			ep_buf_len[ep_abs_idx] =
+				CONFIG_USB_DC_NXP_EHCI_BULK_BUF_SIZE;
+		}
+	}
+
+	if (block->data == NULL) {
+		block->data = k_heap_alloc(&ep_buf_pool, cfg->ep_mps,
+					   K_MSEC(10));
+	}
+
 	if (block->data == NULL) {
 		LOG_ERR("Memory allocation time-out");
 		return -ENOMEM;
 	}
 
-	memset(block->data, 0, cfg->ep_mps);
+	memset(block->data, 0, ep_buf_len[ep_abs_idx]);
 	dev_data.eps[ep_abs_idx].ep_mps = cfg->ep_mps;
 	status = dev_data.interface->deviceControl(dev_data.controllerHandle,
 			kUSB_DeviceControlEndpointInit, &ep_init);
@@ -425,8 +455,8 @@ int usb_dc_ep_write(const uint8_t ep, const uint8_t *const data,
 		return -EINVAL;
 	}
 
-	if (data_len > dev_data.eps[ep_abs_idx].ep_mps) {
-		len_to_send = dev_data.eps[ep_abs_idx].ep_mps;
+	if (data_len > ep_buf_len[ep_abs_idx]) {
+		len_to_send = ep_buf_len[ep_abs_idx];
 	} else {
 		len_to_send = data_len;
 	}
@@ -7,8 +7,10 @@
 
 #include <drivers/video.h>
 
+/* Room for aligning each buffer */
 K_HEAP_DEFINE(video_buffer_pool,
-	      CONFIG_VIDEO_BUFFER_POOL_SZ_MAX *
+	      (CONFIG_VIDEO_BUFFER_POOL_SZ_MAX +
+	       CONFIG_VIDEO_BUFFER_POOL_ALIGN) *
 	      CONFIG_VIDEO_BUFFER_POOL_NUM_MAX);
 
 static struct video_buffer video_buf[CONFIG_VIDEO_BUFFER_POOL_NUM_MAX];
@@ -39,7 +41,9 @@ struct video_buffer *video_buffer_alloc(size_t size)
 	}
 
 	/* Alloc buffer memory */
-	block->data = k_heap_alloc(&video_buffer_pool, size, K_FOREVER);
+	block->data = k_heap_aligned_alloc(&video_buffer_pool,
+					   CONFIG_VIDEO_BUFFER_POOL_ALIGN,
+					   size, K_FOREVER);
 	if (block->data == NULL) {
 		return NULL;
 	}
@@ -47,6 +51,9 @@ struct video_buffer *video_buffer_alloc(size_t size)
 	vbuf->buffer = block->data;
 	vbuf->size = size;
 	vbuf->bytesused = 0;
+	atomic_set(&vbuf->refcount, 1);
+	vbuf->release_cb = NULL;
+	vbuf->release_user_data = NULL;
 
 	return vbuf;
 }
@@ -69,3 +76,19 @@ void video_buffer_release(struct video_buffer *vbuf)
 		k_heap_free(&video_buffer_pool, block->data);
 	}
 }
+
+void video_buffer_unref(struct video_buffer *vbuf)
+{
+	if (atomic_dec(&vbuf->refcount) != 1) {
+		return;
+	}
+
+	if (vbuf->release_cb == NULL) {
+		video_buffer_release(vbuf);
+		return;
+	}
+
+	/* The callback owns the buffer now. */
+	atomic_set(&vbuf->refcount, 1);
+	vbuf->release_cb(vbuf, vbuf->release_user_data);
+}
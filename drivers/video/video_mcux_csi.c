@@ -265,6 +265,13 @@ static int video_mcux_csi_enqueue(const struct device *dev,
 	to_read = data->csi_config.linePitch_Bytes * data->csi_config.height;
 	vbuf->bytesused = to_read;
 
+#ifdef CONFIG_HAS_MCUX_CACHE
+	/* The buffer may come back from a consumer which wrote to it, do not
+	 * let dirty lines be evicted over the captured frame.
+	 */
+	DCACHE_CleanInvalidateByRange((uint32_t)vbuf->buffer, to_read);
+#endif
+
 	ret = CSI_TransferSubmitEmptyBuffer(config->base, &data->csi_handle,
 					    (uint32_t)vbuf->buffer);
 	if (ret != kStatus_Success) {
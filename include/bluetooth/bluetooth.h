@@ -1689,6 +1689,42 @@ struct bt_le_scan_recv_info {
 	uint8_t secondary_phy;
 };
 
+/** Scan report filter options. */
+enum {
+	/** Match reports containing an AD structure of type @p ad_type. */
+	BT_LE_SCAN_FILTER_AD_TYPE = BIT(0),
+
+	/** Match reports listing the 16-bit service UUID @p uuid16. */
+	BT_LE_SCAN_FILTER_UUID16 = BIT(1),
+
+	/**
+	 * Match reports with manufacturer specific data of company
+	 * @p company_id.
+	 */
+	BT_LE_SCAN_FILTER_COMPANY_ID = BIT(2),
+};
+
+/**
+ * @brief Scan report filter.
+ *
+ * A report is passed to the listener if it matches all the options set.
+ * The filter is applied by the host before the listener is called, so
+ * reports which don't match aren't dispatched at all.
+ */
+struct bt_le_scan_filter {
+	/** Bit-field of BT_LE_SCAN_FILTER_* options. */
+	uint8_t options;
+
+	/** AD type to match with @ref BT_LE_SCAN_FILTER_AD_TYPE. */
+	uint8_t ad_type;
+
+	/** 16-bit UUID to match with @ref BT_LE_SCAN_FILTER_UUID16. */
+	uint16_t uuid16;
+
+	/** Company ID to match with @ref BT_LE_SCAN_FILTER_COMPANY_ID. */
+	uint16_t company_id;
+};
+
 /** Listener context for (LE) scanning. */
 struct bt_le_scan_cb {
 
@@ -1704,6 +1740,15 @@ struct bt_le_scan_cb {
 	/** @brief The scanner has stopped scanning after scan timeout. */
 	void (*timeout)(void);
 
+#if defined(CONFIG_BT_SCAN_FILTER)
+	/**
+	 * @brief Filter for the reports passed to @ref recv.
+	 *
+	 * If NULL, all reports are passed.
+	 */
+	const struct bt_le_scan_filter *filter;
+#endif /* CONFIG_BT_SCAN_FILTER */
+
 	sys_snode_t node;
 };
 
@@ -405,6 +405,24 @@ struct bt_conn_le_tx_power {
  */
 int bt_conn_get_info(const struct bt_conn *conn, struct bt_conn_info *info);
 
+/** @brief Set the TX scheduling of a connection
+ *
+ *  The connections with data to send take turns to send it to the
+ *  controller. A connection which has used its quota of controller buffers
+ *  does not get a turn until some of its packets are completed. A PDU
+ *  needing more than one ACL packet may take the connection over its quota.
+ *
+ *  Requires CONFIG_BT_CONN_TX_QUOTA.
+ *
+ *  @param conn Connection object.
+ *  @param quota Maximum number of controller ACL buffers the connection
+ *               can use, 0 for no limit.
+ *  @param weight Number of packets the connection sends in its turn.
+ *
+ *  @return Zero on success or (negative) error code on failure.
+ */
+int bt_conn_set_tx_sched(struct bt_conn *conn, uint8_t quota, uint8_t weight);
+
 /** @brief Get connection info for the remote device.
  *
  *  @param conn Connection object.
@@ -1178,6 +1178,46 @@ bool bt_gatt_is_subscribed(struct bt_conn *conn,
  */
 uint16_t bt_gatt_get_mtu(struct bt_conn *conn);
 
+/** @brief Statistics of an ATT bearer. */
+struct bt_gatt_bearer_stats {
+	/** L2CAP channel identifier of the bearer */
+	uint16_t cid;
+	/** ATT MTU of the bearer */
+	uint16_t mtu;
+	/** True for an Enhanced ATT bearer */
+	bool enhanced;
+	/** Number of requests sent */
+	uint32_t reqs;
+	/** Number of PDUs sent */
+	uint32_t pdus;
+	/** Time spent waiting for responses, in milliseconds */
+	uint32_t busy_ms;
+};
+
+/** @typedef bt_gatt_bearer_stats_func_t
+ *  @brief Bearer statistics callback function.
+ *
+ *  @param conn Connection object.
+ *  @param stats Statistics of the bearer.
+ *  @param user_data Data given to bt_gatt_bearer_stats_foreach().
+ */
+typedef void (*bt_gatt_bearer_stats_func_t)(struct bt_conn *conn,
+					    const struct bt_gatt_bearer_stats *stats,
+					    void *user_data);
+
+/** @brief Get the statistics of the ATT bearers of a connection
+ *
+ *  The requests are spread over all the connected bearers, the statistics
+ *  show how much each of them is used. Requires CONFIG_BT_EATT_STATS.
+ *
+ *  @param conn Connection object.
+ *  @param func Function called for each bearer.
+ *  @param user_data Data passed to the callback.
+ */
+void bt_gatt_bearer_stats_foreach(struct bt_conn *conn,
+				  bt_gatt_bearer_stats_func_t func,
+				  void *user_data);
+
 /** @} */
 
 /**
@@ -255,6 +255,40 @@ int isotp_recv(struct isotp_recv_ctx *ctx, uint8_t *data, size_t len,
 int isotp_recv_net(struct isotp_recv_ctx *ctx, struct net_buf **buffer,
 		   k_timeout_t timeout);
 
+/**
+ * @brief Receive the next message into a buffer
+ *
+ * The next message received by the context is reassembled straight into
+ * @p data, instead of the internal net-buffers, if it fits. The length of a
+ * message is then not limited by the pool of the net-buffers, so that it
+ * can be received in a single block (BS = 0) with a single flow control
+ * frame. Messages not fitting are received as if no buffer was given.
+ * The buffer is released once the message was received, or once an error
+ * occurred, and can then be given again for the next message.
+ *
+ * @param ctx  Context that is already bound.
+ * @param data Buffer the data is written to. It must be valid until
+ *             isotp_recv_buf_wait() returned.
+ * @param len  Size of the buffer.
+ */
+void isotp_recv_buf_set(struct isotp_recv_ctx *ctx, uint8_t *data,
+			size_t len);
+
+/**
+ * @brief Wait for a message received into the buffer
+ *
+ * This function waits for the message received into the buffer given with
+ * isotp_recv_buf_set().
+ *
+ * @param ctx     Context that is already bound.
+ * @param timeout Timeout for the reception.
+ *
+ * @retval Number of bytes received on success
+ * @retval ISOTP_RECV_TIMEOUT when "timeout" timed out
+ * @retval ISOTP_N_* on error
+ */
+int isotp_recv_buf_wait(struct isotp_recv_ctx *ctx, k_timeout_t timeout);
+
 /**
  * @brief Send data
  *
@@ -412,6 +446,11 @@ struct isotp_recv_ctx {
 	struct k_work work;
 	struct _timeout timeout;
 	struct k_fifo fifo;
+	uint8_t *user_buf;
+	size_t user_buf_size;
+	size_t user_buf_len;
+	int user_buf_err;
+	struct k_sem user_buf_sem;
 	struct isotp_msg_id rx_addr;
 	struct isotp_msg_id tx_addr;
 	struct isotp_fc_opts opts;
@@ -419,6 +458,7 @@ struct isotp_recv_ctx {
 	uint8_t bs;
 	uint8_t wft;
 	uint8_t sn_expected : 4;
+	uint8_t user_buf_rx : 1;
 };
 
 /** @endcond */
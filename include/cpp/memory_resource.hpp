@@ -0,0 +1,513 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief C++ memory resources backed by kernel memory objects
+ *
+ * Memory resources for the C++ containers of an application to allocate
+ * from a k_heap, a k_mem_slab or a buffer, instead of the global heap that
+ * operator new uses. They implement std::pmr::memory_resource when the
+ * standard C++ library provides it (C++17). Otherwise, a memory_resource
+ * class and a polymorphic_allocator template with the same interface are
+ * provided in the zephyr::pmr namespace.
+ *
+ * The header requires the standard C++ library (CONFIG_LIB_CPLUSPLUS).
+ * When an allocation fails, std::bad_alloc is thrown if C++ exceptions are
+ * enabled, otherwise nullptr is returned, as operator new does.
+ */
+
+#ifndef ZEPHYR_INCLUDE_CPP_MEMORY_RESOURCE_HPP_
+#define ZEPHYR_INCLUDE_CPP_MEMORY_RESOURCE_HPP_
+
+#include <kernel.h>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define Z_CPP_STD_PMR 1
+#endif
+#endif
+
+/**
+ * @defgroup cpp_memory_resource C++ memory resources
+ * @ingroup kernel_apis
+ * @{
+ */
+
+namespace zephyr {
+namespace pmr {
+
+#if defined(Z_CPP_STD_PMR)
+
+using memory_resource = std::pmr::memory_resource;
+
+template <class T>
+using polymorphic_allocator = std::pmr::polymorphic_allocator<T>;
+
+/** @brief Resource allocating with operator new. */
+inline memory_resource *new_delete_resource() noexcept
+{
+	return std::pmr::new_delete_resource();
+}
+
+#else
+
+/**
+ * @brief Memory resource interface
+ *
+ * Same interface as std::pmr::memory_resource.
+ */
+class memory_resource {
+public:
+	virtual ~memory_resource() = default;
+
+	void *allocate(size_t bytes,
+		       size_t alignment = alignof(std::max_align_t))
+	{
+		return do_allocate(bytes, alignment);
+	}
+
+	void deallocate(void *p, size_t bytes,
+			size_t alignment = alignof(std::max_align_t))
+	{
+		do_deallocate(p, bytes, alignment);
+	}
+
+	bool is_equal(const memory_resource &other) const noexcept
+	{
+		return do_is_equal(other);
+	}
+
+private:
+	virtual void *do_allocate(size_t bytes, size_t alignment) = 0;
+	virtual void do_deallocate(void *p, size_t bytes,
+				   size_t alignment) = 0;
+	virtual bool do_is_equal(const memory_resource &other)
+		const noexcept = 0;
+};
+
+inline bool operator==(const memory_resource &a,
+		       const memory_resource &b) noexcept
+{
+	return &a == &b || a.is_equal(b);
+}
+
+inline bool operator!=(const memory_resource &a,
+		       const memory_resource &b) noexcept
+{
+	return !(a == b);
+}
+
+/**
+ * @brief Allocator of a memory resource
+ *
+ * Same interface as std::pmr::polymorphic_allocator, for the containers of
+ * the standard C++ library, e.g. std::vector<T, polymorphic_allocator<T>>.
+ */
+template <class T>
+class polymorphic_allocator {
+public:
+	using value_type = T;
+
+	polymorphic_allocator(memory_resource *r) noexcept : res(r)
+	{
+	}
+
+	template <class U>
+	polymorphic_allocator(const polymorphic_allocator<U> &other) noexcept
+		: res(other.resource())
+	{
+	}
+
+	T *allocate(size_t n)
+	{
+		return static_cast<T *>(res->allocate(n * sizeof(T),
+						      alignof(T)));
+	}
+
+	void deallocate(T *p, size_t n)
+	{
+		res->deallocate(p, n * sizeof(T), alignof(T));
+	}
+
+	memory_resource *resource() const noexcept
+	{
+		return res;
+	}
+
+private:
+	memory_resource *res;
+};
+
+template <class T, class U>
+inline bool operator==(const polymorphic_allocator<T> &a,
+		       const polymorphic_allocator<U> &b) noexcept
+{
+	return *a.resource() == *b.resource();
+}
+
+template <class T, class U>
+inline bool operator!=(const polymorphic_allocator<T> &a,
+		       const polymorphic_allocator<U> &b) noexcept
+{
+	return !(a == b);
+}
+
+/** @cond INTERNAL_HIDDEN */
+class z_new_delete_resource : public memory_resource {
+private:
+	void *do_allocate(size_t bytes, size_t alignment) override
+	{
+		return ::operator new(bytes);
+	}
+
+	void do_deallocate(void *p, size_t bytes, size_t alignment) override
+	{
+		::operator delete(p);
+	}
+
+	bool do_is_equal(const memory_resource &other) const noexcept override
+	{
+		return this == &other;
+	}
+};
+/** @endcond */
+
+/** @brief Resource allocating with operator new. */
+inline memory_resource *new_delete_resource() noexcept
+{
+	static z_new_delete_resource res;
+
+	return &res;
+}
+
+#endif /* Z_CPP_STD_PMR */
+
+/** @cond INTERNAL_HIDDEN */
+inline void *z_pmr_checked(void *p)
+{
+#if defined(__cpp_exceptions)
+	if (p == nullptr) {
+		throw std::bad_alloc();
+	}
+#endif
+	return p;
+}
+/** @endcond */
+
+/**
+ * @brief Memory resource of a k_heap
+ *
+ * Allocations of any size and alignment, thread safe.
+ */
+class heap_resource : public memory_resource {
+public:
+	/**
+	 * @param heap Heap to allocate from.
+	 * @param timeout Time to wait for memory to be freed when the heap is
+	 *	  full.
+	 */
+	explicit heap_resource(struct k_heap *heap,
+			       k_timeout_t timeout = K_NO_WAIT) noexcept
+		: heap(heap), timeout(timeout)
+	{
+	}
+
+private:
+	void *do_allocate(size_t bytes, size_t alignment) override
+	{
+		return z_pmr_checked(k_heap_aligned_alloc(heap, alignment,
+							  bytes, timeout));
+	}
+
+	void do_deallocate(void *p, size_t bytes, size_t alignment) override
+	{
+		k_heap_free(heap, p);
+	}
+
+	bool do_is_equal(const memory_resource &other) const noexcept override
+	{
+		return this == &other;
+	}
+
+	struct k_heap *heap;
+	k_timeout_t timeout;
+};
+
+/**
+ * @brief Memory resource of a k_mem_slab
+ *
+ * Allocations of up to the block size of the slab, in constant time and
+ * with no fragmentation, thread safe. Suited to the node based containers,
+ * e.g. std::list, std::map, which allocate their elements one by one.
+ */
+class slab_resource : public memory_resource {
+public:
+	/**
+	 * @param slab Memory slab to allocate from.
+	 * @param timeout Time to wait for a block to be freed when the slab
+	 *	  is full.
+	 */
+	explicit slab_resource(struct k_mem_slab *slab,
+			       k_timeout_t timeout = K_NO_WAIT) noexcept
+		: slab(slab), timeout(timeout)
+	{
+	}
+
+private:
+	void *do_allocate(size_t bytes, size_t alignment) override
+	{
+		void *block;
+
+		if (bytes > slab->block_size ||
+		    k_mem_slab_alloc(slab, &block, timeout) != 0) {
+			return z_pmr_checked(nullptr);
+		}
+
+		/* Blocks are as aligned as the slab was defined */
+		if ((reinterpret_cast<uintptr_t>(block) & (alignment - 1)) !=
+		    0U) {
+			k_mem_slab_free(slab, &block);
+			return z_pmr_checked(nullptr);
+		}
+
+		return block;
+	}
+
+	void do_deallocate(void *p, size_t bytes, size_t alignment) override
+	{
+		k_mem_slab_free(slab, &p);
+	}
+
+	bool do_is_equal(const memory_resource &other) const noexcept override
+	{
+		return this == &other;
+	}
+
+	struct k_mem_slab *slab;
+	k_timeout_t timeout;
+};
+
+/**
+ * @brief Monotonic memory resource of a buffer
+ *
+ * Allocations are carved out of the buffer one after the other, and are
+ * only freed all at once, by release(). Allocating takes a few
+ * instructions, with no lock: the resource is not thread safe, e.g. an
+ * arena of a thread, see set_thread_resource(), or of the processing of a
+ * request.
+ */
+class monotonic_resource : public memory_resource {
+public:
+	/**
+	 * @param buffer Buffer to allocate from.
+	 * @param size Size of the buffer.
+	 */
+	monotonic_resource(void *buffer, size_t size) noexcept
+		: base(reinterpret_cast<uintptr_t>(buffer)), size(size),
+		  used(0U)
+	{
+	}
+
+	monotonic_resource(const monotonic_resource &) = delete;
+	monotonic_resource &operator=(const monotonic_resource &) = delete;
+
+	/** @brief Free all the allocations at once. */
+	void release() noexcept
+	{
+		used = 0U;
+	}
+
+	/** @brief Number of bytes of the buffer in use. */
+	size_t used_bytes() const noexcept
+	{
+		return used;
+	}
+
+private:
+	void *do_allocate(size_t bytes, size_t alignment) override
+	{
+		uintptr_t p = (base + used + alignment - 1U) & ~(alignment - 1U);
+
+		if (p - base > size || bytes > size - (p - base)) {
+			return z_pmr_checked(nullptr);
+		}
+
+		used = p - base + bytes;
+
+		return reinterpret_cast<void *>(p);
+	}
+
+	void do_deallocate(void *p, size_t bytes, size_t alignment) override
+	{
+	}
+
+	bool do_is_equal(const memory_resource &other) const noexcept override
+	{
+		return this == &other;
+	}
+
+	uintptr_t base;
+	size_t size;
+	size_t used;
+};
+
+/**
+ * @brief Monotonic memory resource with its own buffer
+ *
+ * @tparam Size Size of the buffer.
+ */
+template <size_t Size>
+class monotonic_arena : public monotonic_resource {
+public:
+	monotonic_arena() noexcept : monotonic_resource(buffer, Size)
+	{
+	}
+
+private:
+	alignas(std::max_align_t) uint8_t buffer[Size];
+};
+
+#if defined(CONFIG_THREAD_LOCAL_STORAGE)
+/** @cond INTERNAL_HIDDEN */
+inline memory_resource *&z_pmr_thread_slot() noexcept
+{
+	static thread_local memory_resource *res;
+
+	return res;
+}
+/** @endcond */
+
+/**
+ * @brief Get the memory resource of the current thread
+ *
+ * @return The resource set by set_thread_resource(), or
+ *	   new_delete_resource() if none is set.
+ */
+inline memory_resource *get_thread_resource() noexcept
+{
+	memory_resource *res = z_pmr_thread_slot();
+
+	return res != nullptr ? res : new_delete_resource();
+}
+
+/**
+ * @brief Set the memory resource of the current thread
+ *
+ * Set a resource, e.g. a monotonic_arena, for the code run by the current
+ * thread to allocate from with no lock, nor contention with the other
+ * threads, through get_thread_resource().
+ *
+ * @param res Resource, or nullptr for new_delete_resource().
+ *
+ * @return The previous resource of the thread, nullptr if none was set.
+ */
+inline memory_resource *set_thread_resource(memory_resource *res) noexcept
+{
+	memory_resource *prev = z_pmr_thread_slot();
+
+	z_pmr_thread_slot() = res;
+
+	return prev;
+}
+#endif /* CONFIG_THREAD_LOCAL_STORAGE */
+
+/**
+ * @brief Pool of objects in a k_mem_slab
+ *
+ * Construct objects of type T in place in the blocks of a memory slab, in
+ * constant time, e.g. for the objects of a fixed maximum count created and
+ * destroyed at run time. The slab is defined with one block per object:
+ *
+ * @code
+ * K_MEM_SLAB_DEFINE(msg_slab, sizeof(struct msg), 8, alignof(struct msg));
+ * static zephyr::pmr::object_slab<struct msg> msgs(&msg_slab);
+ * @endcode
+ *
+ * @tparam T Type of the objects.
+ */
+template <class T>
+class object_slab {
+public:
+	/** @param slab Memory slab of blocks of sizeof(T) bytes at least. */
+	explicit object_slab(struct k_mem_slab *slab) noexcept : slab(slab)
+	{
+	}
+
+	/**
+	 * @brief Construct an object, waiting for a free block if needed
+	 *
+	 * @param timeout Time to wait for a block to be freed.
+	 * @param args Arguments of the constructor of T.
+	 *
+	 * @return The object, or nullptr if no block is free.
+	 */
+	template <class... Args>
+	T *create_timeout(k_timeout_t timeout, Args &&... args)
+	{
+		void *block;
+
+		__ASSERT(slab->block_size >= sizeof(T), "slab blocks too small");
+
+		if (k_mem_slab_alloc(slab, &block, timeout) != 0) {
+			return nullptr;
+		}
+
+#if defined(__cpp_exceptions)
+		try {
+			return new (block) T(std::forward<Args>(args)...);
+		} catch (...) {
+			k_mem_slab_free(slab, &block);
+			throw;
+		}
+#else
+		return new (block) T(std::forward<Args>(args)...);
+#endif
+	}
+
+	/**
+	 * @brief Construct an object
+	 *
+	 * @param args Arguments of the constructor of T.
+	 *
+	 * @return The object, or nullptr if no block is free.
+	 */
+	template <class... Args>
+	T *create(Args &&... args)
+	{
+		return create_timeout(K_NO_WAIT, std::forward<Args>(args)...);
+	}
+
+	/**
+	 * @brief Destroy an object and free its block
+	 *
+	 * @param obj Object returned by create() or create_timeout().
+	 */
+	void destroy(T *obj)
+	{
+		void *block = obj;
+
+		obj->~T();
+		k_mem_slab_free(slab, &block);
+	}
+
+private:
+	struct k_mem_slab *slab;
+};
+
+} /* namespace pmr */
+} /* namespace zephyr */
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_CPP_MEMORY_RESOURCE_HPP_ */
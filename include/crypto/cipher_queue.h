@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Crypto request queue APIs
+ *
+ * Queue of cipher operations run by a thread of the crypto subsystem, for
+ * the submitter to carry on while its data are processed, and pool of
+ * sessions shared by the users of a same key.
+ *
+ * [Experimental] Users should note that the APIs can change
+ * as a part of ongoing development.
+ */
+
+#ifndef ZEPHYR_INCLUDE_CRYPTO_CIPHER_QUEUE_H_
+#define ZEPHYR_INCLUDE_CRYPTO_CIPHER_QUEUE_H_
+
+#include <kernel.h>
+#include <sys/slist.h>
+#include <crypto/cipher.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Crypto request queue APIs
+ * @defgroup crypto_cipher_queue Cipher request queue
+ * @ingroup crypto
+ * @{
+ */
+
+struct cipher_req;
+
+/**
+ * @brief Request completion callback
+ *
+ * Called from the queue thread once the request is processed. The request
+ * may be reused or freed from the callback.
+ *
+ * @param req    Completed request.
+ * @param status Result of the operation: 0 or a negative errno code.
+ */
+typedef void (*cipher_req_cb)(struct cipher_req *req, int status);
+
+/**
+ * @brief Cipher operation request
+ *
+ * To be filled by the caller before cipher_req_submit(). The request, its
+ * packets and buffers must be kept until completion.
+ */
+struct cipher_req {
+	/** Used by the queue. */
+	sys_snode_t node;
+
+	/** Session of the operation, set up for synchronous operations
+	 * (CAP_SYNC_OPS), e.g. with cipher_session_get().
+	 */
+	struct cipher_ctx *ctx;
+
+	/** Operation buffers: @a aead_pkt in CCM and GCM modes, @a pkt in the
+	 * other modes.
+	 */
+	union {
+		struct cipher_pkt *pkt;
+		struct cipher_aead_pkt *aead_pkt;
+	};
+
+	/** IV, counter or nonce of the operation, as taken by cipher_cbc_op(),
+	 * cipher_ctr_op(), cipher_ccm_op() and cipher_gcm_op(). Unused in ECB
+	 * mode.
+	 */
+	uint8_t *iv;
+
+	/** Completion callback, can be NULL. */
+	cipher_req_cb cb;
+
+	/** Signal raised with the result on completion, can be NULL. */
+	struct k_poll_signal *signal;
+
+	/** Free for the caller's use. */
+	void *user_data;
+
+	/** Result of the operation, valid on completion. */
+	int status;
+};
+
+/**
+ * @brief Submit a cipher operation request
+ *
+ * The request is queued behind the pending ones and processed by the queue
+ * thread, which notifies the completion through the callback and the signal
+ * of the request. The requests are processed in the order they are
+ * submitted.
+ *
+ * @param req Request to process.
+ *
+ * @retval 0 The request is queued.
+ * @retval -EINVAL The request has no session.
+ * @retval -ENOTSUP The session is not set up for synchronous operations.
+ */
+int cipher_req_submit(struct cipher_req *req);
+
+/**
+ * @brief Submit a batch of cipher operation requests
+ *
+ * Queue the requests appended to @a list, with their @a node, at once: the
+ * queue thread is woken up a single time for the batch, e.g. for all the
+ * records of a flight. The list is emptied.
+ *
+ * @param list List of the requests to process, in order.
+ *
+ * @retval 0 The requests are queued.
+ * @retval -EINVAL A request has no session. No request is queued.
+ * @retval -ENOTSUP A session is not set up for synchronous operations. No
+ *	    request is queued.
+ */
+int cipher_req_submit_list(sys_slist_t *list);
+
+/**
+ * @brief Get a session from the pool
+ *
+ * Return the open session of the pool matching the device, key, flags,
+ * mode parameters, algorithm, mode and operation, if any, for the users of
+ * a key to share the session, set up once. Otherwise a session is set up
+ * in a free entry of the pool, or in place of the least recently used
+ * session nobody holds.
+ *
+ * The key is copied: the caller may reuse its buffer.
+ *
+ * @param dev    Crypto device.
+ * @param params Key, key length, flags and mode parameters of the session,
+ *		 as set before cipher_begin_session(). Only raw keys
+ *		 (CAP_RAW_KEY) and synchronous operations (CAP_SYNC_OPS) are
+ *		 supported.
+ * @param algo   Algorithm of the session.
+ * @param mode   Cipher mode of the session.
+ * @param optype Whether the session encrypts or decrypts.
+ *
+ * @return The session, held until cipher_session_put(), or NULL if the
+ *	   parameters are not supported or all the sessions are held.
+ */
+struct cipher_ctx *cipher_session_get(const struct device *dev,
+				      const struct cipher_ctx *params,
+				      enum cipher_algo algo,
+				      enum cipher_mode mode,
+				      enum cipher_op optype);
+
+/**
+ * @brief Release a session of the pool
+ *
+ * The session is kept open, to be returned by the next cipher_session_get()
+ * with the same parameters, until its entry is needed for another session.
+ *
+ * @param ctx Session returned by cipher_session_get().
+ */
+void cipher_session_put(struct cipher_ctx *ctx);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_CRYPTO_CIPHER_QUEUE_H_ */
@@ -711,6 +711,193 @@ int json_obj_encode(const struct json_obj_descr *descr, size_t descr_len,
 int json_arr_encode(const struct json_obj_descr *descr, const void *val,
 		    json_append_bytes_t append_bytes, void *data);
 
+/**
+ * @brief Output buffer collecting the encoded JSON data before handing it
+ * over in large blocks, for example to a socket.
+ */
+struct json_buffered_writer {
+	/** Buffer collecting the data */
+	char *buf;
+
+	/** Size of the buffer */
+	size_t size;
+
+	/** Length of the data in the buffer */
+	size_t used;
+
+	/** Function writing the data when the buffer is full */
+	json_append_bytes_t flush;
+
+	/** Data pointer to be passed to the flush function */
+	void *flush_data;
+};
+
+/**
+ * @brief Initializes a buffered writer
+ *
+ * @param writer Buffered writer to initialize
+ *
+ * @param buf Buffer collecting the data
+ *
+ * @param size Size of the buffer
+ *
+ * @param flush Function writing the data when the buffer is full, or when
+ * json_buffered_flush() is called
+ *
+ * @param flush_data Data pointer to be passed to the flush function
+ */
+void json_buffered_writer_init(struct json_buffered_writer *writer,
+			       char *buf, size_t size,
+			       json_append_bytes_t flush, void *flush_data);
+
+/**
+ * @brief Appends bytes to a buffered writer. This can be given with the
+ * writer as data to json_obj_encode() and json_arr_encode().
+ *
+ * @param bytes Contents to write to the output
+ *
+ * @param len Number of bytes to append to output
+ *
+ * @param data Pointer to the struct json_buffered_writer
+ *
+ * @return 0 on success, or the error returned by the flush function.
+ */
+int json_buffered_append(const char *bytes, size_t len, void *data);
+
+/**
+ * @brief Writes the data left in a buffered writer
+ *
+ * @param writer Buffered writer
+ *
+ * @return 0 on success, or the error returned by the flush function.
+ */
+int json_buffered_flush(struct json_buffered_writer *writer);
+
+/** Maximum nesting of objects and arrays in a stream parser */
+#define JSON_STREAM_MAX_DEPTH 32
+
+struct json_stream_parser;
+
+/**
+ * @brief Callbacks of a stream parser, called as the parts of the JSON
+ * payload are parsed. Callbacks may be NULL. A callback returning a
+ * negative value stops the parsing, and the value is returned by
+ * json_stream_feed().
+ */
+struct json_stream_callbacks {
+	/** Start of an object (JSON_TOK_OBJECT_START) or of an array
+	 * (JSON_TOK_LIST_START).
+	 */
+	int (*on_start)(struct json_stream_parser *parser,
+			enum json_tokens type);
+
+	/** End of an object (JSON_TOK_OBJECT_END) or of an array
+	 * (JSON_TOK_LIST_END).
+	 */
+	int (*on_end)(struct json_stream_parser *parser,
+		      enum json_tokens type);
+
+	/** Key of the next value of an object, NUL terminated. */
+	int (*on_key)(struct json_stream_parser *parser, const char *key,
+		      size_t len);
+
+	/** Value (JSON_TOK_STRING, JSON_TOK_NUMBER, JSON_TOK_TRUE,
+	 * JSON_TOK_FALSE or JSON_TOK_NULL), NUL terminated. Strings are
+	 * given without the quotes, and are not unescaped.
+	 */
+	int (*on_value)(struct json_stream_parser *parser,
+			enum json_tokens type, const char *value,
+			size_t len);
+};
+
+/**
+ * @brief JSON stream parser. The fields are internal, except user_data and
+ * depth which can be used in the callbacks.
+ */
+struct json_stream_parser {
+	/** Callbacks */
+	const struct json_stream_callbacks *cb;
+
+	/** User data */
+	void *user_data;
+
+	/** Buffer holding the token being parsed */
+	char *buf;
+
+	/** Size of the token buffer */
+	size_t buf_size;
+
+	/** Length of the token being parsed */
+	size_t len;
+
+	/** Error stopping the parsing, 0 if none */
+	int error;
+
+	/** Containers being parsed, one bit per level set for objects */
+	uint32_t objects;
+
+	/** Number of containers being parsed */
+	uint8_t depth;
+
+	/** Next expected element */
+	uint8_t expect;
+
+	/** Token being parsed */
+	uint8_t token;
+
+	/** Position in the token being parsed, for literals and escapes */
+	uint8_t token_pos;
+};
+
+/**
+ * @brief Initializes a stream parser, which parses a JSON value given in
+ * any number of chunks with json_stream_feed().
+ *
+ * The same liberties as json_obj_parse() are taken with the format.
+ *
+ * @param parser Stream parser to initialize
+ *
+ * @param cb Callbacks called while parsing, must stay valid
+ *
+ * @param buf Buffer for the keys and values, which can be split across
+ * chunks. Its size limits the length of a key or value, it needs space for
+ * the terminating NUL character.
+ *
+ * @param buf_size Size of the buffer
+ *
+ * @param user_data User data for the callbacks
+ */
+void json_stream_init(struct json_stream_parser *parser,
+		      const struct json_stream_callbacks *cb,
+		      char *buf, size_t buf_size, void *user_data);
+
+/**
+ * @brief Parses a chunk of a JSON payload
+ *
+ * @param parser Stream parser
+ *
+ * @param data Chunk to parse
+ *
+ * @param len Length of the chunk
+ *
+ * @return 0 on success, -EINVAL if the payload is invalid, -ENOMEM if a key
+ * or value does not fit in the buffer, -E2BIG if the containers are nested
+ * too deeply, or the error of a callback. Once an error is returned, the
+ * following calls return it too.
+ */
+int json_stream_feed(struct json_stream_parser *parser, const char *data,
+		     size_t len);
+
+/**
+ * @brief Ends the parsing of a JSON payload
+ *
+ * @param parser Stream parser
+ *
+ * @return 0 if a complete value has been parsed, -EINVAL if the payload is
+ * incomplete, or the error returned by json_stream_feed().
+ */
+int json_stream_finish(struct json_stream_parser *parser);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DEBUG_BOOT_PROFILE_H_
+#define ZEPHYR_INCLUDE_DEBUG_BOOT_PROFILE_H_
+
+#include <zephyr/types.h>
+#include <sys/util.h>
+#include <timing/timing.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup boot_profile Boot profiling
+ *  @brief Time spent in every init entry and boot phase
+ *
+ *  The boot profile records the duration of the early boot phases, of
+ *  every init level and of every init entry, in cycles of the timing
+ *  functions. Other code may record its own steps with
+ *  boot_profile_begin() and boot_profile_end(). The records can be printed
+ *  and rendered as a timeline with scripts/tracing/boot_profile_timeline.py.
+ *  @{
+ */
+
+/** @brief Phase of the boot a record belongs to */
+enum boot_profile_level {
+	/** Before the kernel starts: BSS zeroing and data copy */
+	BOOT_PROFILE_EARLY,
+	/** Init levels, in the order they run */
+	BOOT_PROFILE_PRE_KERNEL_1,
+	BOOT_PROFILE_PRE_KERNEL_2,
+	BOOT_PROFILE_POST_KERNEL,
+	BOOT_PROFILE_APPLICATION,
+	BOOT_PROFILE_SMP,
+	/** Once main() was called */
+	BOOT_PROFILE_MAIN,
+};
+
+/** @brief Boot profile record */
+struct boot_profile_record {
+	/** Name of the device, of the level or of the step, NULL for an
+	 *  init entry without a device.
+	 */
+	const char *name;
+	/** Init function of an init entry, NULL otherwise */
+	const void *func;
+	/** Start, in cycles since the kernel started. The early phases,
+	 *  measured before the counter is set up for the kernel, end at 0.
+	 */
+	int32_t start;
+	/** Duration in cycles */
+	uint32_t cycles;
+	/** Phase of the boot, @ref boot_profile_level */
+	uint8_t level;
+};
+
+#ifdef CONFIG_BOOT_PROFILING
+
+/** @brief Start measuring a step of the boot.
+ *
+ *  @return Start of the step, to be given to boot_profile_end().
+ */
+static inline timing_t boot_profile_begin(void)
+{
+	return timing_counter_get();
+}
+
+/** @brief Record a step of the boot.
+ *
+ *  May be called from any context. The record is dropped if the table is
+ *  full.
+ *
+ *  @param name Name of the step, must remain valid.
+ *  @param start Value returned by boot_profile_begin().
+ */
+void boot_profile_end(const char *name, timing_t start);
+
+/** @brief Get the records.
+ *
+ *  The records are in the order the steps ended, except that the early
+ *  phases come first.
+ *
+ *  @param records Set to the table of records.
+ *
+ *  @return Number of records.
+ */
+uint32_t boot_profile_records_get(const struct boot_profile_record **records);
+
+/** @brief Get the number of records dropped because the table was full. */
+uint32_t boot_profile_dropped_get(void);
+
+/** @brief Print the records with printk(), one line per record. */
+void boot_profile_print(void);
+
+#else
+
+static inline timing_t boot_profile_begin(void)
+{
+	return 0;
+}
+
+static inline void boot_profile_end(const char *name, timing_t start)
+{
+	ARG_UNUSED(name);
+	ARG_UNUSED(start);
+}
+
+#endif /* CONFIG_BOOT_PROFILING */
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DEBUG_BOOT_PROFILE_H_ */
@@ -63,9 +63,13 @@ enum coredump_cmd_id {
 #include <toolchain.h>
 #include <arch/cpu.h>
 #include <sys/byteorder.h>
+#include <sys/util.h>
 
 #define COREDUMP_HDR_VER		1
 
+/* The data past the coredump header are compressed */
+#define COREDUMP_FLAG_COMPRESSED	BIT(0)
+
 #define	COREDUMP_ARCH_HDR_ID		'A'
 
 #define	COREDUMP_MEM_HDR_ID		'M'
@@ -93,6 +97,7 @@ struct coredump_hdr_t {
 	/* Pointer size in Log2 */
 	uint8_t		ptr_size_bits;
 
+	/* COREDUMP_FLAG_* */
 	uint8_t		flag;
 
 	/* Coredump Reason given */
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DEBUG_PROFILER_H_
+#define ZEPHYR_INCLUDE_DEBUG_PROFILER_H_
+
+#include <stdbool.h>
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup profiler Sampling profiler
+ *  @brief Statistical sampling profiler
+ *
+ *  The profiler periodically samples the code the CPU was executing when
+ *  its sampling interrupt fired. Each sample is recorded into a per-CPU
+ *  ring, from which it can be read back to build a profile, e.g. a flame
+ *  graph with scripts/tracing/profiler_fold.py.
+ *  @{
+ */
+
+/** IRQ number of the samples taken in thread context */
+#define PROFILER_IRQ_NONE -1
+
+/** IRQ number of the samples taken in an exception which is not an IRQ */
+#define PROFILER_IRQ_UNKNOWN -2
+
+/** @brief Profiler sample */
+struct profiler_sample {
+	/** Interrupted program counter, 0 if the sample was taken in an ISR */
+	uintptr_t pc;
+	/** Link register of the interrupted code, i.e. most likely the
+	 *  return address into its caller. 0 if the sample was taken in an
+	 *  ISR, or if not recorded.
+	 */
+	uintptr_t lr;
+	/** Interrupted thread, NULL if the sample was taken in an ISR */
+	void *thread;
+	/** IRQ interrupted by the sample, or @ref PROFILER_IRQ_NONE */
+	int16_t irq;
+};
+
+/** @brief Profiler sample callback function
+ *
+ *  @param cpu CPU the sample was taken on.
+ *  @param sample Sample.
+ *  @param user_data User data given to profiler_samples_get().
+ */
+typedef void (*profiler_sample_cb)(uint8_t cpu,
+				   const struct profiler_sample *sample,
+				   void *user_data);
+
+/** @brief Start sampling.
+ *
+ *  @param rate Sampling rate in Hz.
+ *
+ *  @retval 0 on success.
+ *  @retval -EINVAL if the sampling rate is 0 or above the tick rate.
+ */
+int profiler_start(uint32_t rate);
+
+/** @brief Stop sampling. */
+void profiler_stop(void);
+
+/** @brief Read out and remove the recorded samples.
+ *
+ *  @param cb Callback function called for every sample, oldest first.
+ *  @param user_data User data passed to the callback.
+ *
+ *  @return Number of samples read out.
+ */
+uint32_t profiler_samples_get(profiler_sample_cb cb, void *user_data);
+
+/** @brief Get the number of samples dropped because a ring was full.
+ *
+ *  @param reset Reset the counter after reading it.
+ *
+ *  @return Number of dropped samples.
+ */
+uint32_t profiler_dropped_get(bool reset);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DEBUG_PROFILER_H_ */
@@ -59,6 +59,19 @@ void thread_analyzer_run(thread_analyzer_cb cb);
  */
 void thread_analyzer_print(void);
 
+/** @brief Get the results of the continuous thread monitoring.
+ *
+ *  This function calls a given callback on every monitored thread with its
+ *  CPU utilization over the last monitoring window and its stack high-water
+ *  mark, as updated by the monitoring at the end of that window. Unlike
+ *  thread_analyzer_run(), it does not scan any stack.
+ *
+ *  Available with @kconfig{CONFIG_THREAD_ANALYZER_MONITOR}.
+ *
+ *  @param cb The callback function handler
+ */
+void thread_analyzer_monitor_get(thread_analyzer_cb cb);
+
 /** @} */
 
 #ifdef __cplusplus
@@ -43,6 +43,20 @@ extern "C" {
  */
 typedef int16_t device_handle_t;
 
+/**
+ * @brief Slot of the device name hash table
+ *
+ * With CONFIG_DEVICE_NAME_HASH, device_get_binding() finds the devices
+ * through a perfect hash of their names, with one slot per device,
+ * generated by gen_handles.py. Internal use only.
+ */
+struct z_device_name_slot {
+	/* Displacement of the names in the bucket of this index */
+	uint16_t disp;
+	/* Ordinal of the device whose name hashes to this index */
+	uint16_t ord;
+};
+
 /** @brief Flag value used in lists of device handles to separate
  * distinct groups.
  *
@@ -331,6 +345,20 @@ struct device_state {
 	 */
 	bool initialized : 1;
 
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+	/** Indicates the device may be initialized in parallel with other
+	 * devices, set from the zephyr,parallel-init devicetree property.
+	 */
+	bool parallel_init : 1;
+#endif
+
+#ifdef CONFIG_DEVICE_DEFERRED_INIT
+	/** Indicates the device is not initialized at boot, but on first
+	 * use, set from the zephyr,deferred-init devicetree property.
+	 */
+	bool deferred : 1;
+#endif
+
 #ifdef CONFIG_PM_DEVICE
 	/* Power management data */
 	struct pm_device pm;
@@ -537,6 +565,58 @@ size_t z_device_get_all_static(const struct device * *devices);
  */
 bool z_device_ready(const struct device *dev);
 
+/** @brief Initialize a device whose initialization was deferred.
+ *
+ * Devices whose devicetree node has the zephyr,deferred-init property are
+ * not initialized at boot with CONFIG_DEVICE_DEFERRED_INIT, but on first
+ * use: by device_get_binding(), device_is_ready(), pm_device_get(), or by
+ * this function. The devices they require are initialized first.
+ *
+ * A deferred device is initialized once, the following calls return the
+ * result of that initialization. Initializing it may block: it cannot be
+ * initialized from an ISR.
+ *
+ * @param dev pointer to the device.
+ *
+ * @retval 0 if the device is initialized.
+ * @retval -ENODEV if the device pointer is NULL, or the device is not
+ * deferred and not initialized yet.
+ * @retval -EWOULDBLOCK if called from an ISR before the device is
+ * initialized.
+ * @retval -errno negative error code returned by the initialization
+ * function of the device, limited to 8 bits.
+ */
+#ifdef CONFIG_DEVICE_DEFERRED_INIT
+int device_init(const struct device *dev);
+#else
+static inline int device_init(const struct device *dev)
+{
+	if (dev == NULL) {
+		return -ENODEV;
+	}
+
+	return dev->state->initialized ? -(int)dev->state->init_res : -ENODEV;
+}
+#endif
+
+/** @brief Determine whether a deferred device is still to be initialized.
+ *
+ * @param dev pointer to the device in question.
+ *
+ * @return true if the device is deferred and not initialized yet.
+ */
+static inline bool z_device_deferred(const struct device *dev)
+{
+#ifdef CONFIG_DEVICE_DEFERRED_INIT
+	return (dev != NULL) && dev->state->deferred &&
+	       !dev->state->initialized;
+#else
+	ARG_UNUSED(dev);
+
+	return false;
+#endif
+}
+
 /** @brief Determine whether a device is ready for use
  *
  * This is the implementation underlying `device_usable_check()`, without the
@@ -548,6 +628,10 @@ bool z_device_ready(const struct device *dev);
  */
 static inline int z_device_usable_check(const struct device *dev)
 {
+	if (z_device_deferred(dev)) {
+		return (device_init(dev) == 0) ? 0 : -ENODEV;
+	}
+
 	return z_device_ready(dev) ? 0 : -ENODEV;
 }
 
@@ -683,12 +767,27 @@ int device_busy_check(const struct device *chk_dev);
 #define Z_DEVICE_DEFINE_PM_SLOT(dev_name)
 #endif
 
+/* Each device adds one slot to the device name hash table of the initial
+ * build, so that the table gen_handles.py generates for the final build,
+ * in a distinct pass2 section, has the same size.
+ */
+#ifdef CONFIG_DEVICE_NAME_HASH
+#define Z_DEVICE_DEFINE_NAME_SLOT(dev_name)				\
+	static const struct z_device_name_slot				\
+	__aligned(sizeof(uint16_t))					\
+	_CONCAT(__devname_, DEVICE_NAME_GET(dev_name)) __used		\
+	__attribute__((__section__(".__device_names_pass1"))) = { 0 };
+#else
+#define Z_DEVICE_DEFINE_NAME_SLOT(dev_name)
+#endif
+
 /* Construct objects that are referenced from struct device.  These
  * include power management and dependency handles.
  */
 #define Z_DEVICE_DEFINE_PRE(node_id, dev_name, ...)			\
 	Z_DEVICE_DEFINE_HANDLES(node_id, dev_name, __VA_ARGS__)		\
-	Z_DEVICE_DEFINE_PM_SLOT(dev_name)
+	Z_DEVICE_DEFINE_PM_SLOT(dev_name)				\
+	Z_DEVICE_DEFINE_NAME_SLOT(dev_name)
 
 
 /* Initial build provides a record that associates the device object
@@ -738,7 +837,8 @@ BUILD_ASSERT(sizeof(device_handle_t) == 2, "fix the linker scripts");
  */
 #define Z_DEVICE_DEFINE(node_id, dev_name, drv_name, init_fn, pm_control_fn, \
 			data_ptr, cfg_ptr, level, prio, api_ptr, ...)	\
-	static struct device_state Z_DEVICE_STATE_NAME(dev_name);	\
+	static struct device_state Z_DEVICE_STATE_NAME(dev_name)	\
+		Z_DEVICE_STATE_INIT(node_id);				\
 	Z_DEVICE_DEFINE_PRE(node_id, dev_name, __VA_ARGS__)		\
 	COND_CODE_1(DT_NODE_EXISTS(node_id), (), (static))		\
 		const Z_DECL_ALIGN(struct device)			\
@@ -756,6 +856,29 @@ BUILD_ASSERT(sizeof(device_handle_t) == 2, "fix the linker scripts");
 	Z_INIT_ENTRY_DEFINE(DEVICE_NAME_GET(dev_name), init_fn,		\
 		(&DEVICE_NAME_GET(dev_name)), level, prio)
 
+#if defined(CONFIG_DEVICE_INIT_PARALLEL) || \
+	defined(CONFIG_DEVICE_DEFERRED_INIT)
+#define Z_DEVICE_STATE_INIT(node_id)					\
+	= { Z_DEVICE_STATE_PARALLEL_INIT(node_id)			\
+	    Z_DEVICE_STATE_DEFERRED_INIT(node_id) }
+#else
+#define Z_DEVICE_STATE_INIT(node_id)
+#endif
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+#define Z_DEVICE_STATE_PARALLEL_INIT(node_id)				\
+	.parallel_init = DT_PROP_OR(node_id, zephyr_parallel_init, 0),
+#else
+#define Z_DEVICE_STATE_PARALLEL_INIT(node_id)
+#endif
+
+#ifdef CONFIG_DEVICE_DEFERRED_INIT
+#define Z_DEVICE_STATE_DEFERRED_INIT(node_id)				\
+	.deferred = DT_PROP_OR(node_id, zephyr_deferred_init, 0),
+#else
+#define Z_DEVICE_STATE_DEFERRED_INIT(node_id)
+#endif
+
 #ifdef CONFIG_PM_DEVICE
 #define Z_DEVICE_DEFINE_PM_INIT(dev_name, pm_control_fn)		\
 	.pm_control = (pm_control_fn),				\
@@ -14,8 +14,14 @@
 extern "C" {
 #endif
 
+#ifdef CONFIG_IMG_ASYNC_WRITE
+#define FLASH_IMG_BUF_SIZE (2 * CONFIG_IMG_BLOCK_BUF_SIZE)
+#else
+#define FLASH_IMG_BUF_SIZE CONFIG_IMG_BLOCK_BUF_SIZE
+#endif
+
 struct flash_img_context {
-	uint8_t buf[CONFIG_IMG_BLOCK_BUF_SIZE];
+	uint8_t buf[FLASH_IMG_BUF_SIZE];
 	const struct flash_area *flash_area;
 	struct stream_flash_ctx stream;
 };
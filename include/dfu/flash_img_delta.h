@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DFU_FLASH_IMG_DELTA_H_
+#define ZEPHYR_INCLUDE_DFU_FLASH_IMG_DELTA_H_
+
+#include <dfu/flash_img.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Delta image update
+ * @defgroup flash_img_delta Delta image update
+ *
+ * A delta patch describes the new image as a sequence of commands applied
+ * to the image in the primary slot: copy a range of the current image, or
+ * insert literal bytes. The patch is decoded as it is downloaded, the new
+ * image being written to the upload slot through the image writer, so
+ * neither the patch nor the new image has to be buffered.
+ *
+ * All the fields of a patch are little endian. It starts with a header:
+ *
+ * - magic, 4 bytes: @ref FLASH_IMG_DELTA_MAGIC.
+ * - source size, 4 bytes: size of the image the patch applies to.
+ * - target size, 4 bytes: size of the new image.
+ * - reserved, 4 bytes: 0.
+ * - source SHA-256, 32 bytes: hash of the source size first bytes of the
+ *   primary slot.
+ * - target SHA-256, 32 bytes: hash of the new image.
+ *
+ * Followed by the commands, each starting with a one byte opcode:
+ *
+ * - @ref FLASH_IMG_DELTA_OP_COPY, offset (4 bytes), length (4 bytes): copy
+ *   length bytes of the source image at offset.
+ * - @ref FLASH_IMG_DELTA_OP_INSERT, length (4 bytes), followed by length
+ *   bytes written as they are.
+ *
+ * Data not starting with the magic is written as it is, so the same download
+ * path handles both the patches and the full images.
+ *
+ * @{
+ */
+
+/** Magic number of the patches, "ZDLT". */
+#define FLASH_IMG_DELTA_MAGIC 0x544c445aU
+
+/** Copy a range of the source image. */
+#define FLASH_IMG_DELTA_OP_COPY 0x01U
+/** Insert literal bytes. */
+#define FLASH_IMG_DELTA_OP_INSERT 0x02U
+
+/** Size of the patch header. */
+#define FLASH_IMG_DELTA_HDR_SIZE 80U
+
+/** @brief Delta image update context. */
+struct flash_img_delta {
+	struct flash_img_context *img;
+	/* Primary slot, open while a patch is applied. */
+	const struct flash_area *source;
+	uint8_t target_id;
+	uint8_t state;
+	/* The download starts with the magic. */
+	bool patch;
+	/* Header or command bytes received. */
+	uint8_t hdr_len;
+	uint8_t hdr[FLASH_IMG_DELTA_HDR_SIZE];
+	/* Bytes of the insert command still to receive. */
+	uint32_t insert_len;
+	uint32_t source_size;
+	uint32_t target_size;
+	uint8_t target_hash[32];
+	/* Bytes of the patch received. */
+	size_t received;
+	uint8_t buf[CONFIG_IMG_DELTA_BUF_SIZE];
+};
+
+/**
+ * @brief Initialize a delta image update.
+ *
+ * @param delta Context to be initialized.
+ * @param img Image writer, initialized with flash_img_init() or
+ *	      flash_img_init_id(), which receives the new image.
+ *
+ * @return 0 on success, negative errno code on fail.
+ */
+int flash_img_delta_init(struct flash_img_delta *delta,
+			 struct flash_img_context *img);
+
+/**
+ * @brief Process downloaded data.
+ *
+ * Same as flash_img_buffered_write(), except that a patch is applied to the
+ * image in the primary slot. The last call, with @p flush set, checks the
+ * size and the hash of the new image.
+ *
+ * @param delta Context.
+ * @param data Downloaded data.
+ * @param len Number of bytes.
+ * @param flush True for the last data of the download.
+ *
+ * @retval 0 on success.
+ * @retval -EBADMSG if the patch is malformed, or does not apply to the image
+ *		    in the primary slot.
+ * @retval -ENOTSUP if the new image is written to the primary slot.
+ * @retval -EIO if the new image does not match its hash.
+ * @retval -errno Other negative errno code of the image writer.
+ */
+int flash_img_delta_write(struct flash_img_delta *delta, const uint8_t *data,
+			  size_t len, bool flush);
+
+/**
+ * @brief Read the number of bytes downloaded.
+ *
+ * @param delta Context.
+ *
+ * @return Number of bytes given to flash_img_delta_write().
+ */
+static inline size_t flash_img_delta_bytes_received(
+	const struct flash_img_delta *delta)
+{
+	return delta->received;
+}
+
+/**
+ * @brief Check if the download is a patch.
+ *
+ * @param delta Context.
+ *
+ * @return True if the downloaded data started with the magic of the patches.
+ */
+static inline bool flash_img_delta_is_patch(
+	const struct flash_img_delta *delta)
+{
+	return delta->patch;
+}
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DFU_FLASH_IMG_DELTA_H_ */
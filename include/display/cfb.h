@@ -93,8 +93,11 @@ int cfb_print(const struct device *dev, char *str, uint16_t x, uint16_t y);
 /**
  * @brief Clear framebuffer.
  *
+ * Only the area drawn since the last clear is written to the display by
+ * the next cfb_framebuffer_finalize(), unless @p clear_display is set.
+ *
  * @param dev Pointer to device structure for driver instance
- * @param clear_display Clear the display as well
+ * @param clear_display Clear the whole display as well
  *
  * @return 0 on success, negative value otherwise
  */
@@ -113,6 +116,9 @@ int cfb_framebuffer_invert(const struct device *dev);
  * @brief Finalize framebuffer and write it to display RAM,
  * invert or reorder pixels if necessary.
  *
+ * Only the part of the framebuffer changed since the last finalize is
+ * written, in a single write of the pages it spans.
+ *
  * @param dev Pointer to device structure for driver instance
  *
  * @return 0 on success, negative value otherwise
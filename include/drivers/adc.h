@@ -15,6 +15,7 @@
 
 #include <device.h>
 #include <dt-bindings/adc/adc.h>
+#include <errno.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -321,6 +322,54 @@ struct adc_sequence {
 	bool calibrate;
 };
 
+/**
+ * @brief Type definition of the callback function called when a buffer of
+ *        a continuous sampling is full.
+ *
+ * It is called from the ADC interrupt. The buffer is owned by the application
+ * until it is handed back with adc_continuous_release(), which can be done
+ * from the callback itself.
+ *
+ * @param dev       Pointer to the device structure for the driver instance.
+ * @param buffer    Buffer full of samples.
+ * @param size      Size of the buffer, in bytes.
+ * @param overruns  Number of buffers of samples lost since the previous call,
+ *                  because no buffer was handed back in time.
+ * @param user_data User data of the continuous sampling configuration.
+ */
+typedef void (*adc_continuous_callback_t)(const struct device *dev,
+					  void *buffer, size_t size,
+					  uint32_t overruns, void *user_data);
+
+/**
+ * @brief Structure defining a continuous sampling.
+ */
+struct adc_continuous_cfg {
+	/**
+	 * Channels, resolution and oversampling of the samplings. The buffer,
+	 * options and calibration settings of the sequence are ignored.
+	 */
+	const struct adc_sequence *sequence;
+
+	/** Samplings per second, paced by a hardware timer. */
+	uint32_t sample_rate;
+
+	/**
+	 * Buffers filled alternately, while the application processes the
+	 * other one.
+	 */
+	void *buffers[2];
+
+	/** Size of each buffer, in bytes. */
+	size_t buffer_size;
+
+	/** Called when a buffer is full. */
+	adc_continuous_callback_t callback;
+
+	/** User data passed to the callback. */
+	void *user_data;
+};
+
 
 /**
  * @brief Type definition of ADC API function for configuring a channel.
@@ -345,6 +394,29 @@ typedef int (*adc_api_read_async)(const struct device *dev,
 				  const struct adc_sequence *sequence,
 				  struct k_poll_signal *async);
 
+/**
+ * @brief Type definition of ADC API function for starting a continuous
+ *        sampling.
+ * See adc_continuous_start() for argument descriptions.
+ */
+typedef int (*adc_api_continuous_start)(const struct device *dev,
+					const struct adc_continuous_cfg *cfg);
+
+/**
+ * @brief Type definition of ADC API function for stopping a continuous
+ *        sampling.
+ * See adc_continuous_stop() for argument descriptions.
+ */
+typedef int (*adc_api_continuous_stop)(const struct device *dev);
+
+/**
+ * @brief Type definition of ADC API function for handing back a buffer of
+ *        a continuous sampling.
+ * See adc_continuous_release() for argument descriptions.
+ */
+typedef int (*adc_api_continuous_release)(const struct device *dev,
+					  void *buffer);
+
 /**
  * @brief ADC driver API
  *
@@ -355,6 +427,11 @@ __subsystem struct adc_driver_api {
 	adc_api_read          read;
 #ifdef CONFIG_ADC_ASYNC
 	adc_api_read_async    read_async;
+#endif
+#ifdef CONFIG_ADC_CONTINUOUS
+	adc_api_continuous_start   continuous_start;
+	adc_api_continuous_stop    continuous_stop;
+	adc_api_continuous_release continuous_release;
 #endif
 	uint16_t ref_internal;	/* mV */
 };
@@ -453,6 +530,94 @@ static inline int z_impl_adc_read_async(const struct device *dev,
 }
 #endif /* CONFIG_ADC_ASYNC */
 
+#if defined(CONFIG_ADC_CONTINUOUS) || defined(__DOXYGEN__)
+/**
+ * @brief Start a continuous sampling.
+ *
+ * The samplings are triggered by a hardware timer and their results are
+ * transferred by DMA into the two buffers of the configuration in turn, so
+ * that no sample is lost while the application processes a full buffer, as
+ * long as it hands it back with adc_continuous_release() before the other one
+ * is full. Otherwise, the samples of the buffer being filled are overwritten
+ * and the loss is reported to the next callback.
+ *
+ * The device cannot be used for other reads until the sampling is stopped.
+ *
+ * @note This function is available only if @kconfig{CONFIG_ADC_CONTINUOUS}
+ * is selected.
+ *
+ * @param dev  Pointer to the device structure for the driver instance.
+ * @param cfg  Continuous sampling configuration.
+ *
+ * @retval 0        On success.
+ * @retval -EINVAL  If a parameter with an invalid value has been provided.
+ * @retval -ENOTSUP If the requested mode of operation is not supported.
+ * @retval -EBUSY   If the device is in use.
+ * @retval -ENOSYS  If continuous sampling is not implemented by the driver.
+ */
+static inline int adc_continuous_start(const struct device *dev,
+				       const struct adc_continuous_cfg *cfg)
+{
+	const struct adc_driver_api *api =
+				(const struct adc_driver_api *)dev->api;
+
+	if (api->continuous_start == NULL) {
+		return -ENOSYS;
+	}
+
+	return api->continuous_start(dev, cfg);
+}
+
+/**
+ * @brief Stop a continuous sampling.
+ *
+ * The samples of the buffer being filled are discarded, no callback is called
+ * once this function returned.
+ *
+ * @param dev  Pointer to the device structure for the driver instance.
+ *
+ * @retval 0        On success.
+ * @retval -EALREADY If no continuous sampling is running.
+ * @retval -ENOSYS  If continuous sampling is not implemented by the driver.
+ */
+static inline int adc_continuous_stop(const struct device *dev)
+{
+	const struct adc_driver_api *api =
+				(const struct adc_driver_api *)dev->api;
+
+	if (api->continuous_stop == NULL) {
+		return -ENOSYS;
+	}
+
+	return api->continuous_stop(dev);
+}
+
+/**
+ * @brief Hand back a buffer of a continuous sampling.
+ *
+ * Can be called from the callback or from any other context.
+ *
+ * @param dev     Pointer to the device structure for the driver instance.
+ * @param buffer  Buffer passed to the callback.
+ *
+ * @retval 0        On success.
+ * @retval -EINVAL  If the buffer is not owned by the application.
+ * @retval -ENOSYS  If continuous sampling is not implemented by the driver.
+ */
+static inline int adc_continuous_release(const struct device *dev,
+					 void *buffer)
+{
+	const struct adc_driver_api *api =
+				(const struct adc_driver_api *)dev->api;
+
+	if (api->continuous_release == NULL) {
+		return -ENOSYS;
+	}
+
+	return api->continuous_release(dev, buffer);
+}
+#endif /* CONFIG_ADC_CONTINUOUS */
+
 /**
  * @brief Get the internal reference voltage.
  *
@@ -44,7 +44,7 @@ extern "C" {
 #define DISK_IOCTL_RESERVED			3
 /** How many  sectors constitute a FLASH Erase block */
 #define DISK_IOCTL_GET_ERASE_BLOCK_SZ		4
-/** Commit any cached read/writes to disk */
+/** Commit any cached read/writes to disk, including the disk_access cache */
 #define DISK_IOCTL_CTRL_SYNC			5
 
 /**
@@ -74,6 +74,12 @@ struct disk_info {
 	const struct disk_operations *ops;
 	/** Device associated to this disk */
 	const struct device *dev;
+#if defined(CONFIG_DISK_CACHE)
+	/** Internally used number of sectors, 0 if the disk is not cached */
+	uint32_t cache_sector_count;
+	/** Internally used sector following the last read */
+	uint32_t cache_next;
+#endif
 };
 
 /**
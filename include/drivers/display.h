@@ -20,6 +20,7 @@
  */
 
 #include <device.h>
+#include <errno.h>
 #include <stddef.h>
 #include <zephyr/types.h>
 
@@ -133,6 +134,29 @@ typedef int (*display_write_api)(const struct device *dev, const uint16_t x,
 				 const struct display_buffer_descriptor *desc,
 				 const void *buf);
 
+/**
+ * @typedef display_write_callback_t
+ * @brief Callback called when an asynchronous write completed
+ *
+ * @param dev Pointer to device structure
+ * @param result 0 on success else negative errno code.
+ * @param user_data User data given to display_write_async()
+ */
+typedef void (*display_write_callback_t)(const struct device *dev, int result,
+					 void *user_data);
+
+/**
+ * @typedef display_write_async_api
+ * @brief Callback API for writing data to the display asynchronously
+ * See display_write_async() for argument description
+ */
+typedef int (*display_write_async_api)(const struct device *dev,
+				       const uint16_t x, const uint16_t y,
+				       const struct display_buffer_descriptor *desc,
+				       const void *buf,
+				       display_write_callback_t callback,
+				       void *user_data);
+
 /**
  * @typedef display_read_api
  * @brief Callback API for reading data from the display
@@ -208,6 +232,9 @@ struct display_driver_api {
 	display_get_capabilities_api get_capabilities;
 	display_set_pixel_format_api set_pixel_format;
 	display_set_orientation_api set_orientation;
+#ifdef CONFIG_DISPLAY_ASYNC_WRITE
+	display_write_async_api write_async;
+#endif
 };
 
 /**
@@ -232,6 +259,46 @@ static inline int display_write(const struct device *dev, const uint16_t x,
 	return api->write(dev, x, y, desc, buf);
 }
 
+/**
+ * @brief Write data to display asynchronously
+ *
+ * Same as display_write(), but the function returns once the transfer of the
+ * data started. The buffer must be kept unchanged and the device must not be
+ * used until @p callback is called, from the system work queue.
+ *
+ * @param dev Pointer to device structure
+ * @param x x Coordinate of the upper left corner where to write the buffer
+ * @param y y Coordinate of the upper left corner where to write the buffer
+ * @param desc Pointer to a structure describing the buffer layout, only used
+ *	       during the call
+ * @param buf Pointer to buffer array
+ * @param callback Function called when the write completed
+ * @param user_data User data passed to the callback
+ *
+ * @retval 0 on success else negative errno code.
+ * @retval -ENOSYS if the display does not support asynchronous writes.
+ */
+static inline int display_write_async(const struct device *dev,
+				      const uint16_t x, const uint16_t y,
+				      const struct display_buffer_descriptor *desc,
+				      const void *buf,
+				      display_write_callback_t callback,
+				      void *user_data)
+{
+#ifdef CONFIG_DISPLAY_ASYNC_WRITE
+	struct display_driver_api *api =
+		(struct display_driver_api *)dev->api;
+
+	if (api->write_async == NULL) {
+		return -ENOSYS;
+	}
+
+	return api->write_async(dev, x, y, desc, buf, callback, user_data);
+#else
+	return -ENOSYS;
+#endif
+}
+
 /**
  * @brief Read data from display
  *
@@ -107,6 +107,15 @@ struct dma_block_config {
 	uint16_t  reserved :          3;
 };
 
+/** The transfer completed. */
+#define DMA_STATUS_COMPLETE	0
+/**
+ * A block, or half of it, completed and the transfer goes on. See
+ * @a complete_callback_en, @a half_complete_callback_en and @a cyclic in
+ * @ref dma_config.
+ */
+#define DMA_STATUS_BLOCK	1
+
 /**
  * @typedef dma_callback_t
  * @brief Callback function for DMA transfer completion
@@ -117,7 +126,8 @@ struct dma_block_config {
  * @param dev Pointer to the DMA device calling the callback.
  * @param user_data A pointer to some user data or NULL
  * @param channel The channel number
- * @param status 0 on success, a negative errno otherwise
+ * @param status DMA_STATUS_COMPLETE or DMA_STATUS_BLOCK on success,
+ *               a negative errno otherwise
  */
 typedef void (*dma_callback_t)(const struct device *dev, void *user_data,
 			       uint32_t channel, int status);
@@ -148,7 +158,17 @@ typedef void (*dma_callback_t)(const struct device *dev, void *user_data,
  *     linked_channel       [ 20 : 26 ] - after channel count exhaust will
  *                                        initiate a channel service request
  *                                        at this channel
- *     reserved             [ 27 : 31 ]
+ *     cyclic               [ 27 ]      - 0-the transfer ends with its last
+ *                                          block
+ *                                        1-the last block is followed by the
+ *                                          first one, until the channel is
+ *                                          stopped. The callback is invoked
+ *                                          with DMA_STATUS_BLOCK at the end
+ *                                          of each block
+ *     half_complete_callback_en [ 28 ] - 0-disable, 1-callback also invoked
+ *                                          with DMA_STATUS_BLOCK at half of
+ *                                          each block
+ *     reserved             [ 29 : 31 ]
  *
  *     source_data_size    [ 0 : 15 ]   - width of source data (in bytes)
  *     dest_data_size      [ 16 : 31 ]  - width of dest data (in bytes)
@@ -173,7 +193,9 @@ struct dma_config {
 	uint32_t  source_chaining_en :   1;
 	uint32_t  dest_chaining_en :     1;
 	uint32_t  linked_channel   :     7;
-	uint32_t  reserved :             5;
+	uint32_t  cyclic :               1;
+	uint32_t  half_complete_callback_en : 1;
+	uint32_t  reserved :             3;
 	uint32_t  source_data_size :    16;
 	uint32_t  dest_data_size :      16;
 	uint32_t  source_burst_length : 16;
@@ -199,6 +221,32 @@ struct dma_status {
 	uint32_t pending_length;
 };
 
+/** The channels can run a single block cyclically. */
+#define DMA_CAPS_CYCLIC			BIT(0)
+/** The channels can run a list of blocks cyclically. */
+#define DMA_CAPS_CYCLIC_LIST		BIT(1)
+/** The callback can be invoked at half of each block. */
+#define DMA_CAPS_HALF_COMPLETE		BIT(2)
+/**
+ * The hardware fetches the next block of a list by itself, there is no gap
+ * between the blocks of a transfer.
+ */
+#define DMA_CAPS_SCATTER_GATHER		BIT(3)
+
+/**
+ * DMA controller capabilities, see dma_get_caps().
+ *
+ * flags			- DMA_CAPS_* flags
+ * max_block_count		- maximum number of blocks of a transfer
+ * max_block_size		- maximum size of a block, in data units of
+ * 				  the transfer
+ */
+struct dma_caps {
+	uint32_t flags;
+	uint32_t max_block_count;
+	uint32_t max_block_size;
+};
+
 /**
  * DMA context structure
  * Note: the dma_context shall be the first member
@@ -258,6 +306,9 @@ typedef int (*dma_api_get_status)(const struct device *dev, uint32_t channel,
 typedef bool (*dma_api_chan_filter)(const struct device *dev,
 				int channel, void *filter_param);
 
+typedef int (*dma_api_get_caps)(const struct device *dev,
+				struct dma_caps *caps);
+
 __subsystem struct dma_driver_api {
 	dma_api_config config;
 	dma_api_reload reload;
@@ -265,6 +316,7 @@ __subsystem struct dma_driver_api {
 	dma_api_stop stop;
 	dma_api_get_status get_status;
 	dma_api_chan_filter chan_filter;
+	dma_api_get_caps get_caps;
 };
 /**
  * @endcond
@@ -494,6 +546,32 @@ static inline int dma_get_status(const struct device *dev, uint32_t channel,
 	return -ENOSYS;
 }
 
+/**
+ * @brief Get the capabilities of a DMA controller
+ *
+ * Lets the users of a controller pick the transfer modes which avoid
+ * copying, e.g. cyclic transfers into a ring buffer, or block lists
+ * chained by the hardware.
+ *
+ * @param dev     Pointer to the device structure for the driver instance.
+ * @param caps    a non-NULL dma_caps object for storing the capabilities
+ *
+ * @retval 0 if successful.
+ * @retval -ENOSYS if the driver does not report its capabilities.
+ */
+static inline int dma_get_caps(const struct device *dev,
+			       struct dma_caps *caps)
+{
+	const struct dma_driver_api *api =
+		(const struct dma_driver_api *)dev->api;
+
+	if (api->get_caps) {
+		return api->get_caps(dev, caps);
+	}
+
+	return -ENOSYS;
+}
+
 /**
  * @brief Look-up generic width index to be used in registers
  *
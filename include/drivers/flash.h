@@ -24,6 +24,7 @@
 #include <stddef.h>
 #include <sys/types.h>
 #include <device.h>
+#include <sys/slist.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -127,6 +128,9 @@ typedef int (*flash_api_sfdp_read)(const struct device *dev, off_t offset,
 				   void *data, size_t len);
 typedef int (*flash_api_read_jedec_id)(const struct device *dev, uint8_t *id);
 
+typedef int (*flash_api_mmap)(const struct device *dev, off_t offset,
+			      size_t len, const void **addr);
+
 __subsystem struct flash_driver_api {
 	flash_api_read read;
 	flash_api_write write;
@@ -140,6 +144,9 @@ __subsystem struct flash_driver_api {
 	flash_api_sfdp_read sfdp_read;
 	flash_api_read_jedec_id read_jedec_id;
 #endif /* CONFIG_FLASH_JESD216_API */
+#if defined(CONFIG_FLASH_MMAP)
+	flash_api_mmap mmap;
+#endif /* CONFIG_FLASH_MMAP */
 };
 
 /**
@@ -464,6 +471,41 @@ static inline size_t z_impl_flash_get_write_block_size(const struct device *dev)
 }
 
 
+/**
+ * @brief Get the address of flash content in the memory map.
+ *
+ * Flash mapped in the address space of the CPU, e.g. the internal flash or
+ * a serial flash in XIP mode, can be read in place through the returned
+ * pointer instead of being copied with flash_read(). The content seen
+ * through the pointer changes with the writes and erases of the range.
+ *
+ * This is not a system call: the mapping is not granted to user mode
+ * threads.
+ *
+ * @param dev flash device
+ * @param offset offset of the range in the flash device
+ * @param len length of the range
+ * @param addr where the address of the range is stored
+ *
+ * @retval 0 on success
+ * @retval -ENOTSUP if the range is not memory-mapped
+ * @retval -EINVAL if the range is not within the flash device
+ */
+static inline int flash_mmap(const struct device *dev, off_t offset,
+			     size_t len, const void **addr)
+{
+#if defined(CONFIG_FLASH_MMAP)
+	const struct flash_driver_api *api =
+		(const struct flash_driver_api *)dev->api;
+
+	if (api->mmap != NULL) {
+		return api->mmap(dev, offset, len, addr);
+	}
+#endif /* CONFIG_FLASH_MMAP */
+
+	return -ENOTSUP;
+}
+
 /**
  *  @brief  Get pointer to flash_parameters structure
  *
@@ -485,6 +527,146 @@ static inline const struct flash_parameters *z_impl_flash_get_parameters(const s
 	return api->get_parameters(dev);
 }
 
+#if defined(CONFIG_FLASH_ASYNC)
+/** Type of an asynchronous flash operation */
+enum flash_async_type {
+	FLASH_ASYNC_READ,
+	FLASH_ASYNC_WRITE,
+	FLASH_ASYNC_ERASE,
+};
+
+struct k_poll_signal;
+struct flash_async_op;
+
+/**
+ *  @brief  Completion callback of an asynchronous flash operation
+ *
+ *  Called from the flash work queue thread once the operation is done.
+ *  The operation may be submitted again from the callback.
+ *
+ *  @param  dev             : flash device
+ *  @param  op              : completed operation
+ *  @param  result          : 0 on success, negative errno code on fail.
+ */
+typedef void (*flash_async_cb_t)(const struct device *dev,
+				 struct flash_async_op *op, int result);
+
+/**
+ *  @brief  Asynchronous flash operation
+ *
+ *  Owned by the flash work queue from its submission until its completion
+ *  is reported. The caller sets @a cb and/or @a signal before submitting
+ *  the operation; the other members are set by the submit functions.
+ */
+struct flash_async_op {
+	/** Node in the queue of operations (private) */
+	sys_snode_t node;
+	/** Device of the operation (private) */
+	const struct device *dev;
+	/** Type of the operation */
+	enum flash_async_type type;
+	/** Offset of the operation */
+	off_t offset;
+	/** Buffer to read into or to write, unused for erase */
+	void *data;
+	/** Number of bytes to read, write or erase */
+	size_t len;
+	/** Callback called on completion, may be NULL */
+	flash_async_cb_t cb;
+	/** Signal raised with the result on completion, may be NULL */
+	struct k_poll_signal *signal;
+	/** Available to the user */
+	void *user_data;
+};
+
+/**
+ *  @brief  Queue an asynchronous flash operation
+ *
+ *  The operations are run in the order they are submitted, by the flash work
+ *  queue thread, with the blocking flash API. Their result is given to the
+ *  callback and raised on the signal of the operation.
+ *
+ *  The operation must not be changed until its completion is reported. The
+ *  function is not available to user mode threads.
+ *
+ *  @param  dev             : flash device
+ *  @param  op              : operation, with its type, offset, data and len
+ *                            set
+ *
+ *  @return  0 on success, -EINVAL for an unknown type of operation.
+ */
+int flash_async_submit(const struct device *dev, struct flash_async_op *op);
+
+/**
+ *  @brief  Read data from flash asynchronously
+ *
+ *  @param  dev             : flash device
+ *  @param  offset          : Offset (byte aligned) to read
+ *  @param  data            : Buffer to store read data
+ *  @param  len             : Number of bytes to read.
+ *  @param  op              : operation to report the completion with
+ *
+ *  @return  0 on success, negative errno code on fail.
+ */
+static inline int flash_read_async(const struct device *dev, off_t offset,
+				   void *data, size_t len,
+				   struct flash_async_op *op)
+{
+	op->type = FLASH_ASYNC_READ;
+	op->offset = offset;
+	op->data = data;
+	op->len = len;
+
+	return flash_async_submit(dev, op);
+}
+
+/**
+ *  @brief  Write buffer into flash memory asynchronously
+ *
+ *  The data must be left unchanged until the completion is reported.
+ *
+ *  @param  dev             : flash device
+ *  @param  offset          : starting offset for the write
+ *  @param  data            : data to write
+ *  @param  len             : Number of bytes to write
+ *  @param  op              : operation to report the completion with
+ *
+ *  @return  0 on success, negative errno code on fail.
+ */
+static inline int flash_write_async(const struct device *dev, off_t offset,
+				    const void *data, size_t len,
+				    struct flash_async_op *op)
+{
+	op->type = FLASH_ASYNC_WRITE;
+	op->offset = offset;
+	op->data = (void *)data;
+	op->len = len;
+
+	return flash_async_submit(dev, op);
+}
+
+/**
+ *  @brief  Erase part or all of a flash memory asynchronously
+ *
+ *  @param  dev             : flash device
+ *  @param  offset          : erase area starting offset.
+ *  @param  size            : size of area to be erased.
+ *  @param  op              : operation to report the completion with
+ *
+ *  @return  0 on success, negative errno code on fail.
+ */
+static inline int flash_erase_async(const struct device *dev, off_t offset,
+				    size_t size, struct flash_async_op *op)
+{
+	op->type = FLASH_ASYNC_ERASE;
+	op->offset = offset;
+	op->data = NULL;
+	op->len = size;
+
+	return flash_async_submit(dev, op);
+}
+#endif /* CONFIG_FLASH_ASYNC */
+
 #ifdef __cplusplus
 }
 #endif
@@ -54,6 +54,15 @@ struct gna_model_header {
 	uint32_t	output_scaling_factor;
 };
 
+/**
+ * The input and output regions of the model start on page (4 KiB)
+ * boundaries, and no other data of the model lie in their pages. The
+ * inference requests then use their input and output buffers in place,
+ * when these are page aligned and in L2 SRAM, instead of copying them
+ * to and from the model.
+ */
+#define GNA_MODEL_MAP_IO	BIT(0)
+
 /**
  * GNA Neural Network model information to be provided by application
  * during model registration
@@ -62,6 +71,8 @@ struct gna_model_info {
 	struct gna_model_header *header;
 	void *rw_region;
 	void *ro_region;
+	/** GNA_MODEL_* flags */
+	uint32_t flags;
 };
 
 /**
@@ -83,6 +94,28 @@ struct gna_inference_stats {
 	uint32_t cycles_per_sec;
 };
 
+/**
+ * Statistics of the inferences performed on a model
+ *
+ * The throughput of the model is the number of inferences over the time
+ * elapsed between two reads of the statistics, and at most the number of
+ * inferences over the GNA time they took, total_cycles / cycles_per_sec.
+ */
+struct gna_model_stats {
+	/** Number of completed inferences */
+	uint32_t inferences;
+	/** Number of inferences completed with an error */
+	uint32_t errors;
+	/** Latency of the last inference, from request to completion, in us */
+	uint32_t last_latency_us;
+	/** Highest latency of an inference, in us */
+	uint32_t max_latency_us;
+	/** Sum of the latencies of the inferences, in us */
+	uint64_t total_latency_us;
+	/** GNA cycles spent performing the inferences */
+	uint64_t total_cycles;
+};
+
 /**
  * Result of an inference operation
  */
@@ -121,12 +154,17 @@ typedef int (*gna_api_deregister)(const struct device *dev,
 typedef int (*gna_api_infer)(const struct device *dev,
 			     struct gna_inference_req *req,
 			     gna_callback callback);
+typedef int (*gna_api_model_stats_get)(const struct device *dev,
+				       void *model_handle,
+				       struct gna_model_stats *stats,
+				       bool reset);
 
 struct gna_driver_api {
 	gna_api_config		configure;
 	gna_api_register	register_model;
 	gna_api_deregister	deregister_model;
 	gna_api_infer		infer;
+	gna_api_model_stats_get	model_stats_get;
 };
 
 /**
@@ -188,6 +226,7 @@ static inline int gna_register_model(const struct device *dev,
  * @param model Model handle output by gna_register_model API
  *
  * @retval 0 If de-registration of the model is successful.
+ * @retval -EBUSY If inference requests on the model are pending.
  * @retval A negative error code in case of a failure.
  */
 static inline int gna_deregister_model(const struct device *dev, void *model)
@@ -205,11 +244,19 @@ static inline int gna_deregister_model(const struct device *dev, void *model)
  * input data vector
  * A callback is provided for notification of inference completion
  *
+ * Requests made while the GNA is busy are queued, up to
+ * CONFIG_INTEL_GNA_MAX_PENDING_REQUESTS, and performed in order, each
+ * started as soon as the previous one completes. The input and output
+ * buffers must be kept until the completion callback: streaming
+ * applications alternate between two sets of buffers, filling one while
+ * the GNA works on the other.
+ *
  * @param dev Pointer to the device structure for the driver instance.
  * @param req Information required to perform inference on a neural network
  * @param callback A callback function to notify inference completion
  *
  * @retval 0 If the request is accepted
+ * @retval -ENOMSG If the queue of pending requests is full.
  * @retval A negative error code in case of a failure.
  */
 static inline int gna_infer(const struct device *dev,
@@ -222,6 +269,32 @@ static inline int gna_infer(const struct device *dev,
 	return api->infer(dev, req, callback);
 }
 
+/**
+ * @brief Get the inference statistics of a model
+ *
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param model Model handle output by gna_register_model API
+ * @param stats Statistics of the model
+ * @param reset Whether to reset the statistics once read
+ *
+ * @retval 0 If the statistics are read.
+ * @retval -ENOSYS If the driver does not gather statistics.
+ * @retval A negative error code in case of a failure.
+ */
+static inline int gna_model_stats_get(const struct device *dev, void *model,
+				      struct gna_model_stats *stats,
+				      bool reset)
+{
+	const struct gna_driver_api *api =
+		(const struct gna_driver_api *)dev->api;
+
+	if (api->model_stats_get == NULL) {
+		return -ENOSYS;
+	}
+
+	return api->model_stats_get(dev, model, stats, reset);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -133,6 +133,30 @@ typedef int (*i2c_api_slave_register_t)(const struct device *dev,
 typedef int (*i2c_api_slave_unregister_t)(const struct device *dev,
 					  struct i2c_slave_config *cfg);
 typedef int (*i2c_api_recover_bus_t)(const struct device *dev);
+/**
+ * @endcond
+ */
+
+/**
+ * @brief Function called when an asynchronous transfer completes.
+ *
+ * @param dev Pointer to the device structure of the I2C controller.
+ * @param result 0 if the transfer succeeded, a negative error code
+ * otherwise.
+ * @param user_data User data passed to i2c_transfer_cb().
+ */
+typedef void (*i2c_callback_t)(const struct device *dev, int result,
+			       void *user_data);
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+typedef int (*i2c_api_transfer_cb_t)(const struct device *dev,
+				     struct i2c_msg *msgs,
+				     uint8_t num_msgs,
+				     uint16_t addr,
+				     i2c_callback_t cb,
+				     void *user_data);
 
 __subsystem struct i2c_driver_api {
 	i2c_api_configure_t configure;
@@ -140,6 +164,9 @@ __subsystem struct i2c_driver_api {
 	i2c_api_slave_register_t slave_register;
 	i2c_api_slave_unregister_t slave_unregister;
 	i2c_api_recover_bus_t recover_bus;
+#ifdef CONFIG_I2C_CALLBACK
+	i2c_api_transfer_cb_t transfer_cb;
+#endif /* CONFIG_I2C_CALLBACK */
 };
 
 typedef int (*i2c_slave_api_register_t)(const struct device *dev);
@@ -357,6 +384,96 @@ static inline int z_impl_i2c_transfer(const struct device *dev,
 	return api->transfer(dev, msgs, num_msgs, addr);
 }
 
+#ifdef CONFIG_I2C_CALLBACK
+
+/**
+ * @brief Perform data transfer to another I2C device asynchronously.
+ *
+ * This routine starts the same transfer as i2c_transfer() and returns
+ * without waiting for it. The messages are performed back to back by the
+ * controller, and @a cb is called from its interrupt handler once they all
+ * were, or one of them failed.
+ *
+ * Transfers started while the bus is busy are queued by the driver, and
+ * performed in order right after the transfer in progress.
+ *
+ * The messages and their buffers must remain valid until the callback is
+ * called.
+ *
+ * @note This function is available only if @kconfig{CONFIG_I2C_CALLBACK}
+ * is selected.
+ *
+ * @param dev Pointer to the device structure for an I2C controller
+ * driver configured in master mode.
+ * @param msgs Array of messages to transfer.
+ * @param num_msgs Number of messages to transfer.
+ * @param addr Address of the I2C target device.
+ * @param cb Function called when the transfer completes.
+ * @param user_data User data passed to @a cb.
+ *
+ * @retval 0 If the transfer was started or queued.
+ * @retval -EWOULDBLOCK If the transfer queue of the bus is full.
+ * @retval -ENOSYS If asynchronous transfers are not supported by the
+ * driver.
+ */
+static inline int i2c_transfer_cb(const struct device *dev,
+				  struct i2c_msg *msgs, uint8_t num_msgs,
+				  uint16_t addr, i2c_callback_t cb,
+				  void *user_data)
+{
+	const struct i2c_driver_api *api =
+		(const struct i2c_driver_api *)dev->api;
+
+	if (api->transfer_cb == NULL) {
+		return -ENOSYS;
+	}
+
+	return api->transfer_cb(dev, msgs, num_msgs, addr, cb, user_data);
+}
+
+#ifdef CONFIG_POLL
+
+/** @cond INTERNAL_HIDDEN */
+static inline void z_i2c_transfer_signal_cb(const struct device *dev,
+					    int result, void *user_data)
+{
+	ARG_UNUSED(dev);
+
+	k_poll_signal_raise((struct k_poll_signal *)user_data, result);
+}
+/** @endcond */
+
+/**
+ * @brief Perform data transfer to another I2C device asynchronously,
+ * signalling its completion.
+ *
+ * Same as i2c_transfer_cb(), @a sig is raised with the result of the
+ * transfer when it completes.
+ *
+ * @note This function is available only if @kconfig{CONFIG_I2C_CALLBACK}
+ * and @kconfig{CONFIG_POLL} are selected.
+ *
+ * @param dev Pointer to the device structure for an I2C controller
+ * driver configured in master mode.
+ * @param msgs Array of messages to transfer.
+ * @param num_msgs Number of messages to transfer.
+ * @param addr Address of the I2C target device.
+ * @param sig Signal raised when the transfer completes.
+ *
+ * @return See i2c_transfer_cb().
+ */
+static inline int i2c_transfer_signal(const struct device *dev,
+				      struct i2c_msg *msgs, uint8_t num_msgs,
+				      uint16_t addr, struct k_poll_signal *sig)
+{
+	return i2c_transfer_cb(dev, msgs, num_msgs, addr,
+			       z_i2c_transfer_signal_cb, sig);
+}
+
+#endif /* CONFIG_POLL */
+
+#endif /* CONFIG_I2C_CALLBACK */
+
 /**
  * @brief Recover the I2C bus
  *
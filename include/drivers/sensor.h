@@ -233,6 +233,13 @@ enum sensor_trigger_type {
 	/** Trigger fires when a free fall is detected. */
 	SENSOR_TRIG_FREEFALL,
 
+	/**
+	 * Trigger fires when the FIFO of the sensor holds at least as many
+	 * frames as configured with the @ref SENSOR_ATTR_FIFO_WATERMARK
+	 * attribute.
+	 */
+	SENSOR_TRIG_FIFO_WATERMARK,
+
 	/**
 	 * Number of all common sensor triggers.
 	 */
@@ -294,6 +301,8 @@ enum sensor_attribute {
 	 * algorithms to calibrate itself on a certain axis, or all of them.
 	 */
 	SENSOR_ATTR_CALIB_TARGET,
+	/** FIFO watermark, in frames, see @ref SENSOR_TRIG_FIFO_WATERMARK. */
+	SENSOR_ATTR_FIFO_WATERMARK,
 
 	/**
 	 * Number of all common sensor attributes.
@@ -371,12 +380,38 @@ typedef int (*sensor_channel_get_t)(const struct device *dev,
 				    enum sensor_channel chan,
 				    struct sensor_value *val);
 
+
+/**
+ * @typedef sensor_fifo_read_t
+ * @brief Callback API for reading frames from the FIFO of a sensor
+ *
+ * See sensor_fifo_read() for argument description
+ */
+typedef int (*sensor_fifo_read_t)(const struct device *dev,
+				  void *buf, size_t size);
+
+/**
+ * @typedef sensor_fifo_decode_t
+ * @brief Callback API for decoding frames read from the FIFO of a sensor
+ *
+ * See sensor_fifo_decode() for argument description
+ */
+typedef int (*sensor_fifo_decode_t)(const struct device *dev,
+				    const void *buf, size_t size,
+				    enum sensor_channel chan,
+				    int32_t *values, size_t value_cnt,
+				    int8_t *shift);
+
 __subsystem struct sensor_driver_api {
 	sensor_attr_set_t attr_set;
 	sensor_attr_get_t attr_get;
 	sensor_trigger_set_t trigger_set;
 	sensor_sample_fetch_t sample_fetch;
 	sensor_channel_get_t channel_get;
+#ifdef CONFIG_SENSOR_FIFO
+	sensor_fifo_read_t fifo_read;
+	sensor_fifo_decode_t fifo_decode;
+#endif
 };
 
 /**
@@ -566,6 +601,115 @@ static inline int z_impl_sensor_channel_get(const struct device *dev,
 	return api->channel_get(dev, chan, val);
 }
 
+#ifdef CONFIG_SENSOR_FIFO
+
+/**
+ * @brief Read frames from the FIFO of a sensor
+ *
+ * Read as many complete frames as the FIFO of the sensor holds and @a buf
+ * can take, in as few bus transactions as possible. A frame holds the
+ * samples of all the channels recorded in the FIFO at one sampling time,
+ * in the raw format of the sensor. Frames are converted to values with
+ * @ref sensor_fifo_decode.
+ *
+ * This is typically called from the handler of the
+ * @ref SENSOR_TRIG_FIFO_WATERMARK trigger.
+ *
+ * @note This function is available only if @kconfig{CONFIG_SENSOR_FIFO}
+ * is selected.
+ *
+ * @param dev Pointer to the sensor device
+ * @param buf Buffer receiving the frames
+ * @param size Size of the buffer, in bytes
+ *
+ * @return Number of frames read if successful, negative errno code if
+ * failure.
+ */
+__syscall int sensor_fifo_read(const struct device *dev, void *buf,
+			       size_t size);
+
+static inline int z_impl_sensor_fifo_read(const struct device *dev,
+					  void *buf, size_t size)
+{
+	const struct sensor_driver_api *api =
+		(const struct sensor_driver_api *)dev->api;
+
+	if (api->fifo_read == NULL) {
+		return -ENOSYS;
+	}
+
+	return api->fifo_read(dev, buf, size);
+}
+
+/**
+ * @brief Decode frames read from the FIFO of a sensor
+ *
+ * Convert one channel of a batch of frames read with @ref sensor_fifo_read
+ * to Q31 fixed-point values, in the SI units of the channel. As many frames
+ * as @a buf holds and @a values can take are converted. All the values
+ * share the same scale, given by @a shift:
+ *
+ * value = values[i] * 2^(shift - 31)
+ *
+ * For vectorial channels, the values of all axes are stored for each
+ * frame, in X, Y and Z order.
+ *
+ * @note This function is available only if @kconfig{CONFIG_SENSOR_FIFO}
+ * is selected.
+ *
+ * @param dev Pointer to the sensor device
+ * @param buf Frames read from the FIFO
+ * @param size Size of the frames, in bytes
+ * @param chan The channel to decode
+ * @param values Where to store the values, one per frame and axis
+ * @param value_cnt Number of values @a values can take
+ * @param shift Where to store the scale of the values
+ *
+ * @return Number of values stored if successful, negative errno code if
+ * failure.
+ */
+__syscall int sensor_fifo_decode(const struct device *dev,
+				 const void *buf, size_t size,
+				 enum sensor_channel chan,
+				 int32_t *values, size_t value_cnt,
+				 int8_t *shift);
+
+static inline int z_impl_sensor_fifo_decode(const struct device *dev,
+					    const void *buf, size_t size,
+					    enum sensor_channel chan,
+					    int32_t *values, size_t value_cnt,
+					    int8_t *shift)
+{
+	const struct sensor_driver_api *api =
+		(const struct sensor_driver_api *)dev->api;
+
+	if (api->fifo_decode == NULL) {
+		return -ENOSYS;
+	}
+
+	return api->fifo_decode(dev, buf, size, chan, values, value_cnt,
+				shift);
+}
+
+/**
+ * @brief Helper function for converting a value decoded by
+ * @ref sensor_fifo_decode to float.
+ *
+ * @param value The Q31 value.
+ * @param shift The scale of the value.
+ *
+ * @return The converted value.
+ */
+static inline float sensor_q31_to_float(int32_t value, int8_t shift)
+{
+	float f = (float)value / 2147483648.0f;
+
+	return (shift >= 0) ? f * (float)(1LL << shift) :
+			      f / (float)(1LL << -shift);
+}
+
+#endif /* CONFIG_SENSOR_FIFO */
+
 /**
  * @brief The value of gravitational constant in micro m/s^2.
  */
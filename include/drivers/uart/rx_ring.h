@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Reception into a ring buffer with the asynchronous UART API
+ */
+
+#ifndef ZEPHYR_INCLUDE_DRIVERS_UART_RX_RING_H_
+#define ZEPHYR_INCLUDE_DRIVERS_UART_RX_RING_H_
+
+#include <drivers/uart.h>
+#include <sys/ring_buffer.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief UART ring buffer reception
+ * @defgroup uart_rx_ring UART ring buffer reception
+ * @ingroup uart_interface
+ *
+ * The buffers of the asynchronous reception are claimed from a ring buffer,
+ * so the driver receives straight into it and no buffer has to be supplied
+ * by the application. The data is committed to the ring buffer on every
+ * @ref uart_event_type::UART_RX_RDY event, which the driver generates when
+ * a buffer is full or when the line stayed idle for the reception timeout.
+ * The application then reads it with the ring buffer API, e.g.
+ * ring_buf_get_claim(), and frees it with uart_rx_ring_get_finish().
+ *
+ * @{
+ */
+
+/** @brief Ring buffer reception, see uart_rx_ring_enable(). */
+struct uart_rx_ring {
+	const struct device *dev;
+	struct ring_buf *rb;
+	uart_callback_t callback;
+	void *user_data;
+	int32_t timeout;
+	/* Maximum size of the buffers given to the driver. */
+	uint32_t chunk;
+	/* Bytes claimed for the driver, not received yet. */
+	uint32_t claimed;
+	/* The driver requested a buffer while the ring buffer was full. */
+	bool buf_wanted;
+	bool enabled;
+	/* The driver disabled the reception while it was enabled. */
+	bool stopped;
+};
+
+/**
+ * @brief Start receiving into a ring buffer.
+ *
+ * The callback of the device is set to the one of the ring buffer reception,
+ * which passes all the events to @p callback, except
+ * @ref uart_event_type::UART_RX_BUF_REQUEST and
+ * @ref uart_event_type::UART_RX_BUF_RELEASED. The data of the
+ * @ref uart_event_type::UART_RX_RDY events is already in the ring buffer when
+ * they are passed on.
+ *
+ * When the ring buffer is full, the driver is left without a buffer and
+ * disables the reception once the current one is full, with a
+ * @ref uart_event_type::UART_RX_DISABLED event. It is enabled again by
+ * uart_rx_ring_get_finish().
+ *
+ * @param ring Ring buffer reception.
+ * @param dev UART device.
+ * @param rb Ring buffer, in byte mode. Only the reception may put data in it.
+ * @param chunk Maximum size of the buffers given to the driver, a fraction of
+ *	        the ring buffer size, so that it keeps receiving while the
+ *	        application reads.
+ * @param timeout Inactivity period after which received data is reported,
+ *		  in microseconds. See uart_rx_enable().
+ * @param callback Callback called with the events of the device.
+ * @param user_data Data passed to the callback.
+ *
+ * @retval 0 on success.
+ * @retval -ENOMEM if the ring buffer is full.
+ * @retval -errno Other negative errno value of uart_callback_set() or
+ *		  uart_rx_enable().
+ */
+int uart_rx_ring_enable(struct uart_rx_ring *ring, const struct device *dev,
+			struct ring_buf *rb, uint32_t chunk, int32_t timeout,
+			uart_callback_t callback, void *user_data);
+
+/**
+ * @brief Stop receiving into a ring buffer.
+ *
+ * The reception is disabled as with uart_rx_disable(). The received data
+ * stays in the ring buffer.
+ *
+ * @param ring Ring buffer reception.
+ *
+ * @retval 0 on success.
+ * @retval -errno Negative errno value of uart_rx_disable().
+ */
+int uart_rx_ring_disable(struct uart_rx_ring *ring);
+
+/**
+ * @brief Free data read from the ring buffer.
+ *
+ * Same as ring_buf_get_finish(), it also gives the freed space to the driver
+ * if it waits for a buffer, or enables the reception again if it was
+ * disabled for lack of space. Must be called from a thread.
+ *
+ * @param ring Ring buffer reception.
+ * @param size Number of bytes to free.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if @p size exceeds the data claimed from the ring buffer.
+ */
+int uart_rx_ring_get_finish(struct uart_rx_ring *ring, uint32_t size);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DRIVERS_UART_RX_RING_H_ */
@@ -101,6 +101,11 @@ struct video_caps {
  * @param timestamp is a time reference in milliseconds at which the last data
  *        byte was actually received for input endpoints or to be consumed for
  *        output endpoints.
+ * @param refcount is the number of references to the buffer, see
+ *        video_buffer_ref().
+ * @param release_cb is called instead of freeing the buffer when its last
+ *        reference is dropped, see video_buffer_release_cb_set().
+ * @param release_user_data is the user data passed to release_cb.
  */
 struct video_buffer {
 	void *driver_data;
@@ -108,8 +113,27 @@ struct video_buffer {
 	uint32_t size;
 	uint32_t bytesused;
 	uint32_t timestamp;
+	atomic_t refcount;
+	void (*release_cb)(struct video_buffer *vbuf, void *user_data);
+	void *release_user_data;
 };
 
+/**
+ * @typedef video_buffer_release_cb_t
+ * @brief Callback called when the last reference to a video buffer is
+ *        dropped.
+ *
+ * The buffer is not freed, its reference count is 1 again, owned by the
+ * callback. The callback usually hands it back to the capture device with
+ * video_enqueue(). It is called from the context which dropped the last
+ * reference, possibly an ISR.
+ *
+ * @param vbuf The video buffer.
+ * @param user_data User data given to video_buffer_release_cb_set().
+ */
+typedef void (*video_buffer_release_cb_t)(struct video_buffer *vbuf,
+					  void *user_data);
+
 /**
  * @brief video_endpoint_id enum
  * Identify the video device endpoint.
@@ -542,6 +566,10 @@ static inline int video_set_signal(const struct device *dev,
 /**
  * @brief Allocate video buffer.
  *
+ * The memory of the buffer is aligned on CONFIG_VIDEO_BUFFER_POOL_ALIGN
+ * bytes, so that it can be used for DMA and its cache lines are not shared
+ * with other data. The buffer has one reference, owned by the caller.
+ *
  * @param size Size of the video buffer.
  *
  * @retval pointer to allocated video buffer
@@ -551,10 +579,63 @@ struct video_buffer *video_buffer_alloc(size_t size);
 /**
  * @brief Release a video buffer.
  *
+ * The buffer is freed whatever its references, see video_buffer_unref() for
+ * buffers shared between several consumers.
+ *
  * @param buf Pointer to the video buffer to release.
  */
 void video_buffer_release(struct video_buffer *buf);
 
+/**
+ * @brief Take a reference to a video buffer.
+ *
+ * Lets a frame dequeued from a capture device be handed to several
+ * consumers, e.g. a display, a network connection and an inference engine,
+ * without copying it. Each consumer drops its reference with
+ * video_buffer_unref() when done with the frame. The consumers must not
+ * write to the buffer.
+ *
+ * @param vbuf Pointer to the video buffer.
+ *
+ * @return The video buffer.
+ */
+static inline struct video_buffer *video_buffer_ref(struct video_buffer *vbuf)
+{
+	atomic_inc(&vbuf->refcount);
+
+	return vbuf;
+}
+
+/**
+ * @brief Drop a reference to a video buffer.
+ *
+ * When the last reference is dropped, the release callback of the buffer is
+ * called if any, otherwise the buffer is freed. May be called from an ISR
+ * if the release callback can.
+ *
+ * @param vbuf Pointer to the video buffer.
+ */
+void video_buffer_unref(struct video_buffer *vbuf);
+
+/**
+ * @brief Set the release callback of a video buffer.
+ *
+ * For instance, a callback re-enqueuing the buffer into the capture device
+ * makes the frames go back to the capture as soon as their last consumer is
+ * done with them.
+ *
+ * @param vbuf Pointer to the video buffer.
+ * @param cb Callback, NULL to free the buffer on its last reference.
+ * @param user_data User data passed to the callback.
+ */
+static inline void video_buffer_release_cb_set(struct video_buffer *vbuf,
+					       video_buffer_release_cb_t cb,
+					       void *user_data)
+{
+	vbuf->release_cb = cb;
+	vbuf->release_user_data = user_data;
+}
+
 
 /* fourcc - four-character-code */
 #define video_fourcc(a, b, c, d)\
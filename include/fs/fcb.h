@@ -129,6 +129,12 @@ struct fcb {
 	/**< The value flash takes when it is erased. This is read from
 	 * flash parameters and initialized upon call to fcb_init.
 	 */
+#ifdef CONFIG_FCB_INDEX
+	uint32_t f_index[CONFIG_FCB_INDEX_MAX_SECTORS];
+	/**< Offset in each sector up to which the elements have been
+	 * checked, internal state
+	 */
+#endif
 };
 
 /**
@@ -214,6 +220,46 @@ typedef int (*fcb_walk_cb)(struct fcb_entry_ctx *loc_ctx, void *arg);
 int fcb_walk(struct fcb *fcb, struct flash_sector *sector, fcb_walk_cb cb,
 	     void *cb_arg);
 
+/**
+ * FCB bulk walk callback function type.
+ *
+ * Type of function which is expected to be called while walking over fcb
+ * entries thanks to a @ref fcb_walk_bulk call.
+ *
+ * @param[in] loc_ctx entry location information (full context)
+ * @param[in] data    entry data, already read from flash, or NULL if the
+ *                    entry is larger than the read buffer. The data is then
+ *                    read using flash_area_read(), as with @ref fcb_walk.
+ * @param[in,out] arg callback context, transferred from @ref fcb_walk_bulk.
+ *
+ * @return 0 continue walking, non-zero stop walking.
+ */
+typedef int (*fcb_bulk_walk_cb)(struct fcb_entry_ctx *loc_ctx,
+				const uint8_t *data, void *arg);
+
+/**
+ * Walk over all entries in the FCB sector, reading several of them at once
+ *
+ * Works as @ref fcb_walk, but the entries are read from flash one buffer at
+ * a time, and given to the callback with their data.
+ *
+ * @param[in] fcb        FCB instance structure.
+ * @param[in] sector     fcb sector to be walked. If null, traverse entire
+ *                       storage.
+ * @param[in] buf        buffer to read the entries into.
+ * @param[in] buf_len    length of the buffer, at least 2 bytes.
+ * @param[in] cb         pointer to the function which gets called for every
+ *                       entry. If cb wants to stop the walk, it should return
+ *                       non-zero value.
+ * @param[in,out] cb_arg callback context, transferred to the callback
+ *                       implementation.
+ *
+ * @return 0 on success, negative on failure (or transferred form callback
+ *         return-value), positive transferred form callback return-value
+ */
+int fcb_walk_bulk(struct fcb *fcb, struct flash_sector *sector, uint8_t *buf,
+		  size_t buf_len, fcb_bulk_walk_cb cb, void *cb_arg);
+
 /**
  * Get next fcb entry location.
  *
@@ -127,6 +127,17 @@ struct fs_dirent {
 	size_t size;
 };
 
+/**
+ * @brief Buffer of a vectored read or write
+ *
+ * @param base Pointer to the data buffer
+ * @param len Number of bytes in the buffer
+ */
+struct fs_iovec {
+	void *base;
+	size_t len;
+};
+
 /**
  * @brief Structure to receive volume statistics
  *
@@ -365,6 +376,40 @@ ssize_t fs_read(struct fs_file_t *zfp, void *ptr, size_t size);
  */
 ssize_t fs_write(struct fs_file_t *zfp, const void *ptr, size_t size);
 
+/**
+ * @brief Read file into several buffers
+ *
+ * Reads data into the @p iovcnt buffers of @p iov, filling each buffer before
+ * moving to the next one, as successive fs_read() calls would. The read stops
+ * at the first buffer which could not be filled.
+ *
+ * @param zfp Pointer to the file object
+ * @param iov Array of buffers
+ * @param iovcnt Number of buffers in @p iov
+ *
+ * @retval >=0 a number of bytes read, on success;
+ * @retval <0 a negative errno code on error, if no byte has been read.
+ */
+ssize_t fs_readv(struct fs_file_t *zfp, const struct fs_iovec *iov,
+		 int iovcnt);
+
+/**
+ * @brief Write file from several buffers
+ *
+ * Writes the data of the @p iovcnt buffers of @p iov in order, as successive
+ * fs_write() calls would. The write stops at the first buffer which could not
+ * be written completely.
+ *
+ * @param zfp Pointer to the file object
+ * @param iov Array of buffers
+ * @param iovcnt Number of buffers in @p iov
+ *
+ * @retval >=0 a number of bytes written, on success;
+ * @retval <0 a negative errno code on error, if no byte has been written.
+ */
+ssize_t fs_writev(struct fs_file_t *zfp, const struct fs_iovec *iov,
+		  int iovcnt);
+
 /**
  * @brief Seek file
  *
@@ -420,6 +465,25 @@ off_t fs_tell(struct fs_file_t *zfp);
  */
 int fs_truncate(struct fs_file_t *zfp, off_t length);
 
+/**
+ * @brief Allocate contiguous storage for an empty file
+ *
+ * Extends an empty file to @p length bytes stored contiguously on the
+ * volume, so that the file can later be read or written in large transfers
+ * without allocating or walking the storage of the file. The content of the
+ * file is not initialized.
+ *
+ * @param zfp Pointer to the file object
+ * @param length New size of the file in bytes
+ *
+ * @retval 0 on success;
+ * @retval -EINVAL when the file is not empty;
+ * @retval -ENOSPC when there is not enough contiguous free space;
+ * @retval -ENOTSUP when not implemented by underlying file system driver;
+ * @retval <0 an other negative errno code on error.
+ */
+int fs_allocate(struct fs_file_t *zfp, off_t length);
+
 /**
  * @brief Flush cached write data buffers of an open file
  *
@@ -436,6 +500,78 @@ int fs_truncate(struct fs_file_t *zfp, off_t length);
  */
 int fs_sync(struct fs_file_t *zfp);
 
+#if defined(CONFIG_FILE_SYSTEM_AIO) || defined(__DOXYGEN__)
+struct k_poll_signal;
+
+/** @brief Operation of an asynchronous request */
+enum fs_aio_type {
+	/** Read with fs_readv() */
+	FS_AIO_READ,
+	/** Write with fs_writev() */
+	FS_AIO_WRITE,
+	/** Flush with fs_sync() */
+	FS_AIO_SYNC,
+};
+
+struct fs_aio;
+
+/**
+ * @brief Completion callback of an asynchronous request
+ *
+ * Called from the thread which has run the request. The request may be
+ * submitted again from the callback.
+ *
+ * @param aio Completed request
+ * @param result Return value of the operation
+ */
+typedef void (*fs_aio_cb_t)(struct fs_aio *aio, ssize_t result);
+
+/**
+ * @brief Asynchronous file request
+ *
+ * @param node Reserved for the request queue
+ * @param zfp Pointer to the file object
+ * @param type Operation to run
+ * @param iov Buffers of a read or write, which shall stay valid until the
+ *        request completes
+ * @param iovcnt Number of buffers in @p iov
+ * @param cb Completion callback, or NULL
+ * @param signal Signal raised with the result once the request completes,
+ *        or NULL
+ * @param result Return value of the operation, -EINPROGRESS until it
+ *        completes
+ * @param user_data User data for the callback
+ */
+struct fs_aio {
+	void *node;
+	struct fs_file_t *zfp;
+	enum fs_aio_type type;
+	const struct fs_iovec *iov;
+	int iovcnt;
+	fs_aio_cb_t cb;
+	struct k_poll_signal *signal;
+	ssize_t result;
+	void *user_data;
+};
+
+/**
+ * @brief Submit an asynchronous file request
+ *
+ * The request is run by one of the CONFIG_FILE_SYSTEM_AIO_THREADS file
+ * system threads. The requests on a file are always run by the same thread,
+ * in the order they were submitted, so they move the file position as the
+ * synchronous calls would. The file shall not be accessed otherwise until
+ * its requests have completed.
+ *
+ * @param aio Request to submit, which shall not be pending
+ *
+ * @retval 0 on success;
+ * @retval -EBADF when the file is not open;
+ * @retval -EINVAL when the request is invalid.
+ */
+int fs_aio_submit(struct fs_aio *aio);
+#endif /* CONFIG_FILE_SYSTEM_AIO */
+
 /**
  * @brief Directory create
  *
@@ -25,6 +25,8 @@ extern "C" {
  * @param lseek Moves the file position to a new location in the file
  * @param tell Retrieves the current position in the file
  * @param truncate Truncates/expands the file to the new length
+ * @param allocate Allocates contiguous storage of the new length for an
+ *        empty file
  * @param sync Flushes the cache of an open file
  * @param close Flushes the associated stream and closes the file
  * @param opendir Opens an existing directory specified by the path
@@ -49,6 +51,7 @@ struct fs_file_system_t {
 	int (*lseek)(struct fs_file_t *filp, off_t off, int whence);
 	off_t (*tell)(struct fs_file_t *filp);
 	int (*truncate)(struct fs_file_t *filp, off_t length);
+	int (*allocate)(struct fs_file_t *filp, off_t length);
 	int (*sync)(struct fs_file_t *filp);
 	int (*close)(struct fs_file_t *filp);
 	/* Directory operations */
@@ -17,6 +17,16 @@
 extern "C" {
 #endif
 
+/** @brief Hits and misses of the block cache of a littlefs mount */
+struct fs_littlefs_cache_stats {
+	/** Reads served from the cache */
+	uint32_t hits;
+	/** Reads which had to load a line from flash */
+	uint32_t misses;
+};
+
+struct fs_littlefs_block_cache;
+
 /** @brief Filesystem info structure for LittleFS mount */
 struct fs_littlefs {
 	/* Defaulted in driver, customizable before mount. */
@@ -37,6 +47,14 @@ struct fs_littlefs {
 	struct lfs lfs;
 	const struct flash_area *area;
 	struct k_mutex mutex;
+
+#ifdef CONFIG_FS_LITTLEFS_BLOCK_CACHE
+	/* Cache shared by the files of the mount, allocated at mount. */
+	struct fs_littlefs_block_cache *block_cache;
+
+	/* Counted since the mount. */
+	struct fs_littlefs_cache_stats cache_stats;
+#endif
 };
 
 /** @brief Define a littlefs configuration with customized size
@@ -43,6 +43,11 @@ extern "C" {
  * @param write_block_size Alignment size
  * @param nvs_lock Mutex
  * @param flash_device Flash Device
+ * @param lookup_cache Address of the last allocation table entry of the IDs
+ * sharing each cache entry
+ * @param gc_work Work item erasing the sector released by garbage collection
+ * @param gc_erase_addr Next address to erase in the sector released by
+ * garbage collection
  */
 struct nvs_fs {
 	off_t offset;		/* filesystem offset in flash */
@@ -57,6 +62,26 @@ struct nvs_fs {
 	struct k_mutex nvs_lock;
 	const struct device *flash_device;
 	const struct flash_parameters *flash_parameters;
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
+#endif
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	struct k_work gc_work;
+	uint32_t gc_erase_addr;
+#endif
+};
+
+/**
+ * @brief Non-volatile Storage entry of a batch write
+ *
+ * @param id Id of the entry
+ * @param data Pointer to the data to be written
+ * @param len Number of bytes to be written, 0 to delete the entry
+ */
+struct nvs_batch_entry {
+	uint16_t id;
+	const void *data;
+	size_t len;
 };
 
 /**
@@ -120,6 +145,26 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len);
  */
 int nvs_delete(struct nvs_fs *fs, uint16_t id);
 
+/**
+ * @brief nvs_write_batch
+ *
+ * Write several entries to the file system at once. Either all the entries
+ * are written, or none of them is, also in case of a power loss during the
+ * write. Entries with a zero length are deleted.
+ *
+ * Unlike nvs_write(), the entries are written even if their data is
+ * unchanged. The batch must fit in a single sector.
+ *
+ * @param fs Pointer to file system
+ * @param entries Entries to be written, in order
+ * @param count Number of entries
+ * @retval 0 Success
+ * @retval -EINVAL if the batch does not fit in a sector
+ * @retval -ERRNO errno code if error
+ */
+int nvs_write_batch(struct nvs_fs *fs, const struct nvs_batch_entry *entries,
+		    size_t count);
+
 /**
  * @brief nvs_read
  *
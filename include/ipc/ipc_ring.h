@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_IPC_IPC_RING_H_
+#define ZEPHYR_INCLUDE_IPC_IPC_RING_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Shared memory ring IPC service API
+ * @defgroup ipc_ring_api Shared memory ring IPC service APIs
+ *
+ * A lightweight alternative to the RPMsg service, for links that do not
+ * need OpenAMP. Each core writes its messages to a single producer, single
+ * consumer ring in the shared memory, read by the other core, and rings
+ * the other core through the IPM device. The messages are given to the
+ * endpoint callbacks straight from the shared memory.
+ *
+ * The endpoints are matched by name, as with the RPMsg service, and may be
+ * registered at any time. A core restarting on its own is not supported:
+ * both cores must restart together.
+ *
+ * @{
+ */
+
+/**
+ * @brief Endpoint callback.
+ *
+ * Called from the work queue of the service. The data are in the shared
+ * memory, and are only valid until the callback returns.
+ *
+ * @param data Received data.
+ * @param len Number of bytes received.
+ * @param priv Private data given to @ref ipc_ring_register_endpoint.
+ */
+typedef void (*ipc_ring_ept_cb)(const void *data, size_t len, void *priv);
+
+/**
+ * @brief Register IPC endpoint
+ *
+ * Registers IPC endpoint to enable communication with a remote device.
+ * The endpoint is bound once the remote device registered an endpoint of
+ * the same name.
+ *
+ * @param name String containing the name of the endpoint. Must be identical
+ *             on both devices.
+ * @param cb Callback executed when data are available on given endpoint
+ * @param priv Private data passed to the callback.
+ *
+ * @retval >=0 id of registered endpoint on success;
+ * @retval -ENOMEM when there is not enough slots to register the endpoint.
+ */
+int ipc_ring_register_endpoint(const char *name, ipc_ring_ept_cb cb,
+			       void *priv);
+
+/**
+ * @brief Send data using given IPC endpoint
+ *
+ * The data are copied to the ring, the function does not wait. It may be
+ * called from an ISR.
+ *
+ * @param endpoint_id Id of registered endpoint, obtained by
+ *                    @ref ipc_ring_register_endpoint
+ * @param data Pointer to the buffer to send
+ * @param len Number of bytes to send.
+ *
+ * @retval >=0 number of sent bytes;
+ * @retval -EINVAL if the endpoint id is not valid;
+ * @retval -ENOTCONN if the endpoint is not bound;
+ * @retval -EMSGSIZE if the message can never fit in the ring;
+ * @retval -ENOMEM if the ring is full, the remote device has not read
+ *                 the previous messages yet.
+ */
+int ipc_ring_send(int endpoint_id, const void *data, size_t len);
+
+/**
+ * @brief Check if endpoint is bound.
+ *
+ * @param endpoint_id Id of registered endpoint, obtained by
+ *                    @ref ipc_ring_register_endpoint
+ *
+ * @retval true endpoint is bound
+ * @retval false endpoint not bound
+ */
+bool ipc_ring_endpoint_is_bound(int endpoint_id);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_IPC_IPC_RING_H_ */
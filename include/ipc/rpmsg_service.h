@@ -52,6 +52,60 @@ int rpmsg_service_register_endpoint(const char *name, rpmsg_ept_cb cb);
  */
 int rpmsg_service_send(int endpoint_id, const void *data, size_t len);
 
+/**
+ * @brief Get a buffer to send data using given IPC endpoint
+ *
+ * The buffer is taken from the shared memory, so the data written to it are
+ * sent by @ref rpmsg_service_send_nocopy without being copied. Once obtained,
+ * the buffer must be sent.
+ *
+ * @param endpoint_id Id of registered endpoint, obtained by
+ *                    @ref rpmsg_service_register_endpoint
+ * @param len Set to the size of the buffer.
+ * @param wait Wait for a buffer to be available, instead of failing at once.
+ *
+ * @retval pointer to the buffer on success;
+ * @retval NULL if no buffer is available.
+ */
+void *rpmsg_service_get_tx_buffer(int endpoint_id, uint32_t *len, bool wait);
+
+/**
+ * @brief Send a buffer using given IPC endpoint
+ *
+ * @param endpoint_id Id of registered endpoint, obtained by
+ *                    @ref rpmsg_service_register_endpoint
+ * @param data Buffer obtained by @ref rpmsg_service_get_tx_buffer
+ * @param len Number of bytes to send, at most the size of the buffer.
+ *
+ * @retval >=0 number of sent bytes;
+ * @retval <0 an error code, reported by rpmsg.
+ */
+int rpmsg_service_send_nocopy(int endpoint_id, const void *data, size_t len);
+
+/**
+ * @brief Hold a received buffer
+ *
+ * Called from the endpoint callback, keeps the data given to the callback
+ * valid after it returns, so that they need not be copied out of the shared
+ * memory. The buffer must be released with
+ * @ref rpmsg_service_release_rx_buffer, the other domain cannot use it
+ * meanwhile.
+ *
+ * @param endpoint_id Id of registered endpoint, obtained by
+ *                    @ref rpmsg_service_register_endpoint
+ * @param data Data given to the endpoint callback.
+ */
+void rpmsg_service_hold_rx_buffer(int endpoint_id, void *data);
+
+/**
+ * @brief Release a received buffer
+ *
+ * @param endpoint_id Id of registered endpoint, obtained by
+ *                    @ref rpmsg_service_register_endpoint
+ * @param data Data held with @ref rpmsg_service_hold_rx_buffer.
+ */
+void rpmsg_service_release_rx_buffer(int endpoint_id, void *data);
+
 /**
  * @brief Check if endpoint is bound.
  *
@@ -569,6 +569,30 @@ static inline k_ticks_t z_impl_k_thread_timeout_remaining_ticks(
 	return z_timeout_remaining(&t->base.timeout);
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+
+/**
+ * @brief Set the timer slack of a thread
+ *
+ * The sleeps and timed waits of the thread may then end up to @a slack
+ * later than requested, never earlier, so that their expiry shares the
+ * timer interrupt of another timeout. It takes effect from the next
+ * timeout of the thread. POSIX timers created by the thread inherit it.
+ *
+ * @param t Thread
+ * @param slack Allowed delay, K_NO_WAIT (the default) for none
+ */
+__syscall void k_thread_timeout_slack_set(struct k_thread *t,
+					  k_timeout_t slack);
+
+static inline void z_impl_k_thread_timeout_slack_set(struct k_thread *t,
+						     k_timeout_t slack)
+{
+	t->base.timeout.slack = (int32_t)CLAMP(slack.ticks, 0, INT32_MAX);
+}
+
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 #endif /* CONFIG_SYS_CLOCK_EXISTS */
 
 /**
@@ -1511,6 +1535,33 @@ static inline void *z_impl_k_timer_user_data_get(const struct k_timer *timer)
 	return timer->user_data;
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+
+/**
+ * @brief Set the slack of a timer.
+ *
+ * The expiries of the timer may then happen up to @a slack later than
+ * scheduled, never earlier, so that they share the timer interrupt of
+ * other timeouts. The period of a periodic timer does not drift: each
+ * expiry is still scheduled from the previous one. Timers with loose
+ * precision requirements should set a slack, so that the system wakes up
+ * once for many of them. It takes effect from the next expiry scheduled.
+ *
+ * @param timer     Address of timer.
+ * @param slack     Allowed delay, K_NO_WAIT (the default) for none.
+ *
+ * @return N/A
+ */
+__syscall void k_timer_slack_set(struct k_timer *timer, k_timeout_t slack);
+
+static inline void z_impl_k_timer_slack_set(struct k_timer *timer,
+					    k_timeout_t slack)
+{
+	timer->timeout.slack = (int32_t)CLAMP(slack.ticks, 0, INT32_MAX);
+}
+
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 /** @} */
 
 /**
@@ -1792,6 +1843,37 @@ extern int k_queue_append_list(struct k_queue *queue, void *head, void *tail);
  */
 extern int k_queue_merge_slist(struct k_queue *queue, sys_slist_t *list);
 
+/**
+ * @brief Atomically get a list of elements from a queue.
+ *
+ * This routine removes up to @a max data items from @a queue in one
+ * operation, and appends them to @a list, in the order they are in the
+ * queue. The first word of each data item is reserved for the kernel's use,
+ * and is used as the node of @a list.
+ *
+ * If @a queue is empty, the calling thread waits for a data item as
+ * k_queue_get() does. Once it is given one, the data items added to the
+ * queue in the meantime are taken with it.
+ *
+ * @note The data items must not have been added with k_queue_alloc_append()
+ * or k_queue_alloc_prepend().
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param queue Address of the queue.
+ * @param list Pointer to sys_slist_t object the data items are appended to.
+ * @param max Maximum number of data items to get, SIZE_MAX for all of them.
+ * @param timeout Non-negative waiting period to obtain a first data item
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of data items appended to @a list; 0 if returned without
+ * waiting, or waiting period timed out.
+ */
+extern int k_queue_get_batch(struct k_queue *queue, sys_slist_t *list,
+			     size_t max, k_timeout_t timeout);
+
 /**
  * @brief Get an element from a queue.
  *
@@ -2154,6 +2236,59 @@ struct k_fifo {
 	ret; \
 	})
 
+/**
+ * @brief Atomically get a list of elements from a FIFO queue.
+ *
+ * This routine removes up to @a max data items from @a fifo in one
+ * operation, and appends them to @a list, in a "first in, first out"
+ * manner. The first word of each data item is reserved for the kernel's
+ * use. If @a fifo is empty, the calling thread waits for a first data item
+ * as k_fifo_get() does.
+ *
+ * @note The data items must not have been added with k_fifo_alloc_put().
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param fifo Address of the FIFO queue.
+ * @param list Pointer to sys_slist_t object the data items are appended to.
+ * @param max Maximum number of data items to get.
+ * @param timeout Waiting period to obtain a first data item,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of data items appended to @a list; 0 if returned without
+ * waiting, or waiting period timed out.
+ */
+#define k_fifo_get_batch(fifo, list, max, timeout) \
+	({ \
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_fifo, get_batch, fifo, list, max, timeout); \
+	int ret = k_queue_get_batch(&(fifo)->_queue, list, max, timeout); \
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_fifo, get_batch, fifo, list, max, timeout, ret); \
+	ret; \
+	})
+
+/**
+ * @brief Atomically get all the elements of a FIFO queue.
+ *
+ * This routine removes all the data items of @a fifo in one operation, as
+ * k_fifo_get_batch() does with no limit on the number of data items.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param fifo Address of the FIFO queue.
+ * @param list Pointer to sys_slist_t object the data items are appended to.
+ * @param timeout Waiting period to obtain a first data item,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of data items appended to @a list; 0 if returned without
+ * waiting, or waiting period timed out.
+ */
+#define k_fifo_get_all(fifo, list, timeout) \
+	k_fifo_get_batch(fifo, list, SIZE_MAX, timeout)
+
 /**
  * @brief Query a FIFO queue to see if it has data available.
  *
@@ -2334,6 +2469,38 @@ struct k_lifo {
 	ret; \
 	})
 
+/**
+ * @brief Atomically get a list of elements from a LIFO queue.
+ *
+ * This routine removes up to @a max data items from @a lifo in one
+ * operation, and appends them to @a list, in a "last in, first out"
+ * manner. The first word of each data item is reserved for the kernel's
+ * use. If @a lifo is empty, the calling thread waits for a first data item
+ * as k_lifo_get() does.
+ *
+ * @note The data items must not have been added with k_lifo_alloc_put().
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param lifo Address of the LIFO queue.
+ * @param list Pointer to sys_slist_t object the data items are appended to.
+ * @param max Maximum number of data items to get, SIZE_MAX for all of them.
+ * @param timeout Waiting period to obtain a first data item,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of data items appended to @a list; 0 if returned without
+ * waiting, or waiting period timed out.
+ */
+#define k_lifo_get_batch(lifo, list, max, timeout) \
+	({ \
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_lifo, get_batch, lifo, list, max, timeout); \
+	int ret = k_queue_get_batch(&(lifo)->_queue, list, max, timeout); \
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_lifo, get_batch, lifo, list, max, timeout, ret); \
+	ret; \
+	})
+
 /**
  * @brief Statically define and initialize a LIFO queue.
  *
@@ -3053,6 +3220,44 @@ void k_work_queue_start(struct k_work_q *queue,
  */
 static inline k_tid_t k_work_queue_thread_get(struct k_work_q *queue);
 
+/** @brief Add a worker thread to a work queue.
+ *
+ * Creates and starts an additional thread that processes items from @p
+ * queue alongside the queue's own thread, turning the queue into a pool.
+ * Items still never run concurrently with themselves: an item
+ * resubmitted while running is only picked up once the running
+ * invocation completes, and flushes wait for that completion.  Items
+ * submitted to a pool are otherwise processed in parallel and may
+ * complete out of order.
+ *
+ * The queue must have been started with k_work_queue_start().  At most
+ * CONFIG_WORKQUEUE_POOL_MAX_THREADS threads, including the queue's own
+ * thread, can serve a queue.
+ *
+ * @note Requires CONFIG_WORKQUEUE_POOL.
+ *
+ * @param queue pointer to the queue structure.
+ *
+ * @param thread pointer to an unused thread object.
+ *
+ * @param stack pointer to the worker thread stack area.
+ *
+ * @param stack_size size of the the worker thread stack area, in bytes.
+ *
+ * @param prio initial thread priority
+ *
+ * @param cpu CPU on which the worker thread is to run, or -1 to let
+ * it run on any CPU.  Pinning requires CONFIG_SCHED_CPU_MASK.
+ *
+ * @retval 0 if the thread was added
+ * @retval -ENODEV if the queue has not been started
+ * @retval -ENOMEM if the queue already has the maximum number of threads
+ * @retval -EINVAL if @p cpu is not a valid CPU or pinning is unsupported
+ */
+int k_work_queue_thread_add(struct k_work_q *queue, struct k_thread *thread,
+			    k_thread_stack_t *stack, size_t stack_size,
+			    int prio, int cpu);
+
 /** @brief Wait until the work queue has drained, optionally plugging it.
  *
  * This blocks submission to the work queue except when coming from queue
@@ -3518,6 +3723,12 @@ struct k_work_delayable {
 struct z_work_flusher {
 	struct k_work work;
 	struct k_sem sem;
+#ifdef CONFIG_WORKQUEUE_POOL
+	/* The flushed item, which must not be running when the
+	 * flusher is processed.
+	 */
+	struct k_work *target;
+#endif
 };
 
 /* Record used to wait for work to complete a cancellation.
@@ -3604,6 +3815,17 @@ struct k_work_q {
 
 	/* Flags describing queue state. */
 	uint32_t flags;
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	/* Additional threads added by k_work_queue_thread_add(). */
+	struct k_thread *pool[CONFIG_WORKQUEUE_POOL_MAX_THREADS - 1];
+
+	/* Number of entries used in pool. */
+	uint8_t pool_size;
+
+	/* Number of threads currently running an item. */
+	uint8_t busy;
+#endif
 };
 
 /* Provide the implementation for inline functions declared above */
@@ -4129,6 +4351,15 @@ struct k_msgq {
 
 	/** Message queue */
 	uint8_t flags;
+
+#ifdef CONFIG_MSGQ_SPSC
+	/** Number of messages ever written (SPSC mode) */
+	atomic_t spsc_head;
+	/** Number of messages ever read (SPSC mode) */
+	atomic_t spsc_tail;
+	/** Set while a thread may be pending on the queue (SPSC mode) */
+	atomic_t spsc_waiters;
+#endif
 };
 /**
  * @cond INTERNAL_HIDDEN
@@ -4154,6 +4385,28 @@ struct k_msgq {
 
 
 #define K_MSGQ_FLAG_ALLOC	BIT(0)
+#define K_MSGQ_FLAG_SPSC	BIT(1)
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+static inline uint32_t z_msgq_used_msgs(struct k_msgq *msgq)
+{
+#ifdef CONFIG_MSGQ_SPSC
+	if ((msgq->flags & K_MSGQ_FLAG_SPSC) != 0U) {
+		/* Read the tail first so the result can't go negative */
+		uint32_t tail = (uint32_t)atomic_get(&msgq->spsc_tail);
+
+		return (uint32_t)atomic_get(&msgq->spsc_head) - tail;
+	}
+#endif
+	return msgq->used_msgs;
+}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
 
 /**
  * @brief Message Queue Attributes
@@ -4216,6 +4469,29 @@ struct k_msgq_attrs {
 void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 		 uint32_t max_msgs);
 
+/**
+ * @brief Initialize a single-producer, single-consumer message queue.
+ *
+ * This routine initializes a message queue like k_msgq_init(), but marks
+ * it as only ever being written by one context and read by another.
+ * Puts and gets then synchronize through atomic head and tail counters
+ * and only take the queue's lock when a thread has to pend, or has to be
+ * woken up, because the queue is full or empty.
+ *
+ * The caller is responsible for there never being more than one writer
+ * and one reader at a time.  k_msgq_peek() and k_msgq_purge() count as
+ * reads.
+ *
+ * @param msgq Address of the message queue.
+ * @param buffer Pointer to ring buffer that holds queued messages.
+ * @param msg_size Message size (in bytes).
+ * @param max_msgs Maximum number of messages that can be queued.
+ *
+ * @return N/A
+ */
+void k_msgq_spsc_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
+		      uint32_t max_msgs);
+
 /**
  * @brief Initialize a message queue.
  *
@@ -4352,7 +4628,7 @@ __syscall void  k_msgq_get_attrs(struct k_msgq *msgq,
 
 static inline uint32_t z_impl_k_msgq_num_free_get(struct k_msgq *msgq)
 {
-	return msgq->max_msgs - msgq->used_msgs;
+	return msgq->max_msgs - z_msgq_used_msgs(msgq);
 }
 
 /**
@@ -4368,7 +4644,7 @@ __syscall uint32_t k_msgq_num_used_get(struct k_msgq *msgq);
 
 static inline uint32_t z_impl_k_msgq_num_used_get(struct k_msgq *msgq)
 {
-	return msgq->used_msgs;
+	return z_msgq_used_msgs(msgq);
 }
 
 /** @} */
@@ -4563,6 +4839,8 @@ struct k_pipe {
  * @cond INTERNAL_HIDDEN
  */
 #define K_PIPE_FLAG_ALLOC	BIT(0)	/** Buffer was allocated */
+#define K_PIPE_FLAG_PUT_CLAIM	BIT(1)	/** Buffer space is claimed */
+#define K_PIPE_FLAG_GET_CLAIM	BIT(2)	/** Buffer data is claimed */
 
 #define Z_PIPE_INITIALIZER(obj, pipe_buffer, pipe_buffer_size)     \
 	{                                                           \
@@ -4661,6 +4939,7 @@ __syscall int k_pipe_alloc_init(struct k_pipe *pipe, size_t size);
  *                or one of the special values K_NO_WAIT and K_FOREVER.
  *
  * @retval 0 At least @a min_xfer bytes of data were written.
+ * @retval -EBUSY A put claim is outstanding on the pipe.
  * @retval -EIO Returned without waiting; zero data bytes were written.
  * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
  *                 minus one data bytes were written.
@@ -4684,6 +4963,7 @@ __syscall int k_pipe_put(struct k_pipe *pipe, void *data,
  *
  * @retval 0 At least @a min_xfer bytes of data were read.
  * @retval -EINVAL invalid parameters supplied
+ * @retval -EBUSY A get claim is outstanding on the pipe.
  * @retval -EIO Returned without waiting; zero data bytes were read.
  * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
  *                 minus one data bytes were read.
@@ -4712,12 +4992,113 @@ __syscall size_t k_pipe_read_avail(struct k_pipe *pipe);
  */
 __syscall size_t k_pipe_write_avail(struct k_pipe *pipe);
 
+/**
+ * @brief Claim space in a pipe's buffer for writing.
+ *
+ * This routine provides direct access to the free space at the write end
+ * of the pipe's buffer, so that data can be produced in place instead of
+ * being copied in by k_pipe_put(). The data becomes visible to readers
+ * once it is committed with k_pipe_put_finish().
+ *
+ * The claimed area is contiguous, so it may be smaller than requested
+ * even if the pipe has more free space, when the free space wraps around
+ * the end of the buffer. Claiming never waits for space to become
+ * available.
+ *
+ * Only one put claim can be outstanding on a pipe at a time, and
+ * k_pipe_put() fails with -EBUSY while it is. This routine is not
+ * available to user mode threads, which cannot access the pipe's buffer.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Set to the start of the claimed area.
+ * @param size Requested size (in bytes).
+ *
+ * @return Size of the claimed area, zero if the pipe's buffer is full,
+ *	   the pipe is unbuffered or a put claim is already outstanding.
+ */
+size_t k_pipe_put_claim(struct k_pipe *pipe, uint8_t **data, size_t size);
+
+/**
+ * @brief Commit data written to a claimed area of a pipe's buffer.
+ *
+ * This routine ends the put claim made with k_pipe_put_claim(),
+ * committing the first @a size bytes of the claimed area. Readers waiting
+ * in k_pipe_get() are served from the committed data as if it had been
+ * written with k_pipe_put().
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes written to the claimed area, may be zero.
+ *
+ * @retval 0 Data committed.
+ * @retval -EINVAL No put claim is outstanding or @a size exceeds the
+ *		   contiguous free space at the write end of the buffer.
+ */
+int k_pipe_put_finish(struct k_pipe *pipe, size_t size);
+
+/**
+ * @brief Claim data in a pipe's buffer for reading.
+ *
+ * This routine provides direct access to the data at the read end of the
+ * pipe's buffer, so that it can be consumed in place instead of being
+ * copied out by k_pipe_get(). The space is only released to writers once
+ * the data is consumed with k_pipe_get_finish().
+ *
+ * The claimed area is contiguous, so it may be smaller than requested
+ * even if the pipe holds more data, when the data wraps around the end
+ * of the buffer. Claiming never waits for data to become available, and
+ * only covers data already in the buffer, not data of writers waiting
+ * in k_pipe_put().
+ *
+ * Only one get claim can be outstanding on a pipe at a time, and
+ * k_pipe_get() fails with -EBUSY while it is. This routine is not
+ * available to user mode threads, which cannot access the pipe's buffer.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Set to the start of the claimed area.
+ * @param size Requested size (in bytes).
+ *
+ * @return Size of the claimed area, zero if the pipe's buffer is empty,
+ *	   the pipe is unbuffered or a get claim is already outstanding.
+ */
+size_t k_pipe_get_claim(struct k_pipe *pipe, uint8_t **data, size_t size);
+
+/**
+ * @brief Release data read from a claimed area of a pipe's buffer.
+ *
+ * This routine ends the get claim made with k_pipe_get_claim(), removing
+ * the first @a size bytes of the claimed area from the pipe. Writers
+ * waiting in k_pipe_put() then get their data moved into the freed space
+ * as if it had been read with k_pipe_get().
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes consumed from the claimed area, may be zero.
+ *
+ * @retval 0 Data released.
+ * @retval -EINVAL No get claim is outstanding or @a size exceeds the
+ *		   contiguous data at the read end of the buffer.
+ */
+int k_pipe_get_finish(struct k_pipe *pipe, size_t size);
+
 /** @} */
 
 /**
  * @cond INTERNAL_HIDDEN
  */
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+/* Per-CPU magazines of free blocks, chained through their first word.
+ * Only ever touched by the owning CPU with interrupts locked.
+ */
+struct z_mem_slab_cpu_cache {
+	char *loaded;
+	char *previous;
+	uint16_t loaded_count;
+	uint16_t previous_count;
+	uint32_t hits;
+	uint32_t misses;
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
@@ -4729,7 +5110,15 @@ struct k_mem_slab {
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	uint32_t max_used;
 #endif
-
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	/* Full magazines, linked through the second word of the first
+	 * block of each
+	 */
+	char *depot;
+	/* Magazine capacity, zero if the slab is not cached */
+	uint16_t rounds;
+	struct z_mem_slab_cpu_cache cache[CONFIG_MP_NUM_CPUS];
+#endif
 };
 
 #define Z_MEM_SLAB_INITIALIZER(obj, slab_buffer, slab_block_size, \
@@ -4843,6 +5232,23 @@ extern int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem,
  */
 extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
 
+/** @cond INTERNAL_HIDDEN */
+static inline uint32_t z_mem_slab_num_cached(struct k_mem_slab *slab)
+{
+	uint32_t cached = 0U;
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		cached += slab->cache[i].loaded_count +
+			  slab->cache[i].previous_count;
+	}
+#else
+	ARG_UNUSED(slab);
+#endif
+	return cached;
+}
+/** @endcond */
+
 /**
  * @brief Get the number of used blocks in a memory slab.
  *
@@ -4855,7 +5261,7 @@ extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
-	return slab->num_used;
+	return slab->num_used - z_mem_slab_num_cached(slab);
 }
 
 /**
@@ -4890,9 +5296,39 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->num_blocks - slab->num_used;
+	return slab->num_blocks - k_mem_slab_num_used_get(slab);
 }
 
+#if defined(CONFIG_MEM_SLAB_CPU_CACHE) || defined(__DOXYGEN__)
+/**
+ * @brief Memory slab per-CPU cache statistics
+ */
+struct k_mem_slab_cache_stats {
+	/** Allocations served from a per-CPU cache */
+	uint32_t hits;
+	/** Allocations that had to go to the shared free list */
+	uint32_t misses;
+	/** Free blocks currently held in per-CPU caches */
+	uint32_t cached;
+};
+
+/**
+ * @brief Get the per-CPU cache statistics of a memory slab.
+ *
+ * The counters of all CPUs are summed up.  As they are sampled without
+ * synchronization with other CPUs, the result is only approximate
+ * while the slab is in use.
+ *
+ * @param slab Address of the memory slab.
+ * @param stats Pointer to the structure to fill in.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL invalid parameters
+ */
+int k_mem_slab_cache_stats_get(struct k_mem_slab *slab,
+			       struct k_mem_slab_cache_stats *stats);
+#endif
+
 /** @} */
 
 /**
@@ -4980,6 +5416,19 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes,
  */
 void k_heap_free(struct k_heap *h, void *mem);
 
+/**
+ * @brief Get runtime statistics of a k_heap
+ *
+ * Thread-safe wrapper around sys_heap_runtime_stats_get().  Requires
+ * CONFIG_SYS_HEAP_RUNTIME_STATS.
+ *
+ * @param h Heap to query
+ * @param stats Struct into which to store the statistics
+ * @return 0 on success, -EINVAL on a NULL argument
+ */
+int k_heap_runtime_stats_get(struct k_heap *h,
+			     struct sys_heap_runtime_stats *stats);
+
 /* Hand-calculated minimum heap sizes needed to return a successful
  * 1-byte allocation.  See details in lib/os/heap.[ch]
  */
@@ -5387,6 +5836,96 @@ __syscall void k_poll_signal_check(struct k_poll_signal *sig,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *sig, int result);
 
+/**
+ * @brief Poll set
+ *
+ * A group of poll events that stay registered with their objects across
+ * waits. See k_poll_set_init().
+ */
+struct k_poll_set {
+	/** PRIVATE - DO NOT TOUCH */
+	struct z_poller poller;
+
+	/** PRIVATE - DO NOT TOUCH */
+	struct k_spinlock lock;
+
+	/** PRIVATE - DO NOT TOUCH */
+	_wait_q_t wait_q;
+
+	/** PRIVATE - DO NOT TOUCH */
+	sys_dlist_t ready;
+};
+
+/**
+ * @brief Initialize a poll set.
+ *
+ * Unlike k_poll(), which registers and unregisters all of its events on
+ * every call, a poll set keeps its events registered with their objects
+ * until they are removed from it. An event that becomes ready is queued
+ * to the set, so k_poll_set_wait() only has to look at the events that
+ * are ready rather than at all of them.
+ *
+ * Poll sets are not available to user mode threads.
+ *
+ * @param set Poll set to initialize.
+ *
+ * @return N/A
+ */
+void k_poll_set_init(struct k_poll_set *set);
+
+/**
+ * @brief Add an event to a poll set.
+ *
+ * The event must have been initialized with k_poll_event_init() or
+ * K_POLL_EVENT_INITIALIZER() and must not be registered elsewhere. The
+ * event and its object must stay valid until the event is removed with
+ * k_poll_set_remove().
+ *
+ * @param set Poll set.
+ * @param event Event to add.
+ *
+ * @retval 0 Event added.
+ * @retval -EINVAL The event is of type K_POLL_TYPE_IGNORE.
+ * @retval -EBUSY The event is already registered.
+ */
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Remove an event from a poll set.
+ *
+ * @param set Poll set.
+ * @param event Event to remove.
+ *
+ * @retval 0 Event removed.
+ * @retval -EINVAL The event is not in @a set.
+ */
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Wait for events of a poll set to be ready.
+ *
+ * This routine waits until at least one event of the set is ready and
+ * returns up to @a max_events ready events, with their state field
+ * updated as by k_poll(). Readiness is level triggered: an event whose
+ * condition still holds when it is returned, e.g. because the semaphore
+ * was not taken, is returned again by the next call.
+ *
+ * The ready events are handed out in the order they became ready. Any
+ * number of threads may wait on the same set, each call then returning
+ * events not returned by any other call since they became ready.
+ *
+ * @param set Poll set to wait on.
+ * @param events Array filled with pointers to the ready events.
+ * @param max_events Size of @a events.
+ * @param timeout Waiting period for an event to be ready,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of ready events stored in @a events, or -EAGAIN if none
+ *	   was ready before the timeout.
+ */
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **events,
+		    int max_events, k_timeout_t timeout);
+
 /**
  * @internal
  */
@@ -5626,6 +6165,21 @@ int k_thread_runtime_stats_get(k_tid_t thread,
  */
 int k_thread_runtime_stats_all_get(k_thread_runtime_stats_t *stats);
 
+#ifdef CONFIG_SCHED_LATENCY_STATS
+/**
+ * @brief Get the scheduling latency histogram of a priority level
+ *
+ * Covers all threads that were switched in at priority @a prio.
+ * Latencies of individual threads are part of their runtime
+ * statistics, see k_thread_runtime_stats_get().
+ *
+ * @param prio Thread priority.
+ * @param stats Pointer to struct to copy statistics into.
+ * @return -EINVAL if null pointer or invalid priority, otherwise 0
+ */
+int k_sched_latency_stats_get(int prio, struct k_sched_latency_stats *stats);
+#endif
+
 #endif
 
 #ifdef __cplusplus
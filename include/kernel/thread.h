@@ -166,6 +166,23 @@ struct _thread_userspace_local_data {
 #endif
 
 #ifdef CONFIG_THREAD_RUNTIME_STATS
+#ifdef CONFIG_SCHED_LATENCY_STATS
+/**
+ * @brief Scheduling latency histogram
+ *
+ * Latencies are in hardware clock cycles.  Bin 0 counts latencies
+ * below two cycles, bin n those from 2^n up to 2^(n+1) cycles and
+ * the last bin everything longer than that.
+ */
+struct k_sched_latency_stats {
+	/** Number of latencies falling into each bin */
+	uint32_t counts[CONFIG_SCHED_LATENCY_STATS_NUM_BINS];
+
+	/** Longest latency seen */
+	uint32_t max;
+};
+#endif
+
 struct k_thread_runtime_stats {
 	/* Thread execution cycles */
 #ifdef CONFIG_THREAD_RUNTIME_STATS_USE_TIMING_FUNCTIONS
@@ -173,6 +190,17 @@ struct k_thread_runtime_stats {
 #else
 	uint64_t execution_cycles;
 #endif
+
+#ifdef CONFIG_SCHED_LATENCY_STATS
+	/* Number of times switched in */
+	uint32_t switches;
+
+	/* Number of times switched out while still runnable */
+	uint32_t preemptions;
+
+	/* Time from being made ready to being switched in */
+	struct k_sched_latency_stats latency;
+#endif
 };
 
 typedef struct k_thread_runtime_stats k_thread_runtime_stats_t;
@@ -185,6 +213,11 @@ struct _thread_runtime_stats {
 	uint32_t last_switched_in;
 #endif
 
+#ifdef CONFIG_SCHED_LATENCY_STATS
+	/* Cycle count when last made ready, 0 if not waiting to run */
+	uint32_t last_readied;
+#endif
+
 	k_thread_runtime_stats_t stats;
 };
 #endif
@@ -232,6 +232,14 @@ struct _timeout {
 #else
 	int32_t dticks;
 #endif
+#ifdef CONFIG_TIMEOUT_SLACK
+	/* Ticks the expiry may be delayed by to share a timer interrupt */
+	int32_t slack;
+#endif
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	/* CPU whose timeout queue holds the timeout */
+	uint8_t cpu;
+#endif
 };
 
 #ifdef __cplusplus
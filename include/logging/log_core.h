@@ -289,6 +289,44 @@ static inline char z_log_minimal_level_to_char(int level)
 
 #define Z_LOG_INST(_inst) COND_CODE_1(CONFIG_LOG, (_inst), NULL)
 
+/*****************************************************************************/
+/****************** Rate limiting ********************************************/
+/*****************************************************************************/
+
+/** @brief Rate limiting state of a logging call site. */
+struct log_ratelimit {
+	/** Time at which the next message is due, in milliseconds. */
+	uint32_t tat;
+	/** Number of messages suppressed since the last report. */
+	uint32_t suppressed;
+	/** Format string of the call site, for the reports. */
+	const char *fmt;
+};
+
+/** @brief Check the rate limit of a logging call site.
+ *
+ * Reports the messages suppressed since the last message which passed.
+ *
+ * @param rl	Rate limiting state of the call site.
+ * @param fmt	Format string of the message.
+ *
+ * @return True if the message shall be logged, false if suppressed.
+ */
+bool z_log_ratelimit_check(struct log_ratelimit *rl, const char *fmt);
+
+/* Each call site gets its own state, gathered in an iterable section for
+ * the periodic report of the suppressed messages. Messages from user mode
+ * are not limited, the state is not accessible there.
+ */
+#ifdef CONFIG_LOG_RATELIMIT
+#define Z_LOG_RATELIMIT_CHECK(_is_user_context, _str) ({ \
+	static Z_STRUCT_SECTION_ITERABLE(log_ratelimit, _log_ratelimit); \
+	(_is_user_context) || z_log_ratelimit_check(&_log_ratelimit, _str); \
+})
+#else
+#define Z_LOG_RATELIMIT_CHECK(_is_user_context, _str) true
+#endif
+
 /*****************************************************************************/
 /****************** Macros for standard logging ******************************/
 /*****************************************************************************/
@@ -308,6 +346,10 @@ static inline char z_log_minimal_level_to_char(int level)
 	    _level > Z_LOG_RUNTIME_FILTER(filters)) { \
 		break; \
 	} \
+	if (!Z_LOG_RATELIMIT_CHECK(is_user_context, \
+				   GET_ARG_N(1, __VA_ARGS__))) { \
+		break; \
+	} \
 	if (IS_ENABLED(CONFIG_LOG2)) { \
 		int _mode; \
 		void *_src = IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ? \
@@ -360,6 +402,9 @@ static inline char z_log_minimal_level_to_char(int level)
 	    _level > Z_LOG_RUNTIME_FILTER(filters)) { \
 		break; \
 	} \
+	if (!Z_LOG_RATELIMIT_CHECK(is_user_context, _str)) { \
+		break; \
+	} \
 	if (IS_ENABLED(CONFIG_LOG2)) { \
 		int mode; \
 		void *_src = IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ? \
@@ -169,6 +169,29 @@ void log_backend_enable(struct log_backend const *const backend,
  */
 void log_backend_disable(struct log_backend const *const backend);
 
+/**
+ * @brief Set the rate limit of the log messages.
+ *
+ * Every logging call site can log up to @p burst messages at once, then
+ * @p rate messages per second. Requires @kconfig{CONFIG_LOG_RATELIMIT}.
+ *
+ * @param rate	Messages per second, 0 to disable rate limiting.
+ * @param burst	Number of messages logged at once.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if the rate is above 1000 messages per second, or the
+ *	   burst is 0 or above 65535.
+ */
+int log_ratelimit_set(uint32_t rate, uint32_t burst);
+
+/**
+ * @brief Get the rate limit of the log messages.
+ *
+ * @param rate	Location for the number of messages per second.
+ * @param burst	Location for the number of messages logged at once.
+ */
+void log_ratelimit_get(uint32_t *rate, uint32_t *burst);
+
 #if defined(CONFIG_LOG) && !defined(CONFIG_LOG_MINIMAL)
 #define LOG_CORE_INIT() log_core_init()
 #define LOG_INIT() log_init()
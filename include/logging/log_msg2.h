@@ -256,6 +256,33 @@ do { \
 	z_log_msg2_static_create((void *)_source, _desc, _msg->data, _data); \
 } while (0)
 
+/* Same as Z_LOG_MSG2_STACK_CREATE for strings with string arguments. Their
+ * location in the package is found at compile time, transient ones are
+ * copied into the message without parsing the format string.
+ */
+#define Z_LOG_MSG2_STACK_CREATE_STRS(_domain_id, _source, _level, _data, \
+				     _dlen, ...) \
+do { \
+	int _plen; \
+	uint8_t _str_pos[NUM_VA_ARGS_LESS_1(__VA_ARGS__) + 1]; \
+	unsigned int _str_cnt; \
+	CBPRINTF_STATIC_PACKAGE(NULL, 0, _plen, \
+				Z_LOG_MSG2_ALIGN_OFFSET, __VA_ARGS__); \
+	struct log_msg2 *_msg; \
+	Z_LOG_MSG2_ON_STACK_ALLOC(_msg, Z_LOG_MSG2_LEN(_plen, 0)); \
+	CBPRINTF_STATIC_PACKAGE_STR_POS(_msg->data, _plen, _plen, \
+					Z_LOG_MSG2_ALIGN_OFFSET, _str_pos, \
+					_str_cnt, __VA_ARGS__); \
+	struct log_msg2_desc _desc = \
+		Z_LOG_MSG_DESC_INITIALIZER(_domain_id, _level, \
+					   (uint32_t)_plen, _dlen); \
+	LOG_MSG2_DBG("creating message on stack: package len: %d, " \
+		     "strings: %u, data len: %d\n", \
+		     _plen, _str_cnt, (int)(_dlen)); \
+	z_log_msg2_static_create_strs((void *)_source, _desc, _msg->data, \
+				      _str_pos, _str_cnt, _data); \
+} while (0)
+
 #if CONFIG_LOG_SPEED
 #define Z_LOG_MSG2_SIMPLE_CREATE(_domain_id, _source, _level, ...) do { \
 	int _plen; \
@@ -337,8 +364,12 @@ do { \
  * - at compile time message size is determined, string package is created on
  *   stack, message is created in function call. String package can only be
  *   created on stack if it does not contain unexpected pointers to strings.
+ * - as above, for strings with string pointer arguments. Their location in
+ *   the package is known at compile time, transient strings are copied into
+ *   the message in the function call.
  * - string package is created at runtime. This mode has no limitations but
- *   it is significantly slower.
+ *   it is significantly slower. It is only used when _Generic is not
+ *   supported.
  *
  * @param _try_0cpy If positive then, if possible, message content is written
  * directly to message. If 0 then, if possible, string package is created on
@@ -395,12 +426,18 @@ do { \
 			  _level, _data, _dlen, ...) \
 do { \
 	Z_LOG_MSG2_STR_VAR(_fmt, ##__VA_ARGS__); \
-	if (CBPRINTF_MUST_RUNTIME_PACKAGE(_cstr_cnt, __VA_ARGS__)) { \
+	if (!Z_C_GENERIC) { \
 		LOG_MSG2_DBG("create runtime message\n");\
 		z_log_msg2_runtime_create(_domain_id, (void *)_source, \
 					  _level, (uint8_t *)_data, _dlen,\
 					  Z_LOG_FMT_ARGS(_fmt, ##__VA_ARGS__));\
 		_mode = Z_LOG_MSG2_MODE_RUNTIME; \
+	} else if (CBPRINTF_MUST_RUNTIME_PACKAGE(_cstr_cnt, __VA_ARGS__)) { \
+		LOG_MSG2_DBG("create on stack message with strings\n");\
+		Z_LOG_MSG2_STACK_CREATE_STRS(_domain_id, _source, _level, \
+					     _data, _dlen, \
+					     Z_LOG_FMT_ARGS(_fmt, ##__VA_ARGS__)); \
+		_mode = Z_LOG_MSG2_MODE_FROM_STACK; \
 	} else if (IS_ENABLED(CONFIG_LOG_SPEED) && _try_0cpy && ((_dlen) == 0)) {\
 		LOG_MSG2_DBG("create zero-copy message\n");\
 		Z_LOG_MSG2_SIMPLE_CREATE(_domain_id, _source, \
@@ -462,6 +499,30 @@ __syscall void z_log_msg2_static_create(const void *source,
 					const struct log_msg2_desc desc,
 					uint8_t *package, const void *data);
 
+/** @brief Create message from a string package with string arguments.
+ *
+ * Strings given by @p str_pos which are not in read only memory are copied
+ * into the message.
+ *
+ * @param source Source.
+ *
+ * @param desc Message descriptor, without the copied strings.
+ *
+ * @param package Package built by CBPRINTF_STATIC_PACKAGE_STR_POS().
+ *
+ * @param str_pos Word indexes of the string arguments in the package.
+ *
+ * @param str_cnt Number of string arguments.
+ *
+ * @param data Data.
+ */
+__syscall void z_log_msg2_static_create_strs(const void *source,
+					     const struct log_msg2_desc desc,
+					     uint8_t *package,
+					     const uint8_t *str_pos,
+					     uint32_t str_cnt,
+					     const void *data);
+
 /** @brief Create message at runtime.
  *
  * Function allows to build any log message based on input data. Processing
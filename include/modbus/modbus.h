@@ -360,6 +360,68 @@ struct modbus_user_callbacks {
 	int (*holding_reg_wr_fp)(uint16_t addr, float reg);
 };
 
+/** Type of the registers of a register map block */
+enum modbus_reg_type {
+	/** Holding registers, read and written with FC03, FC06 and FC16 */
+	MODBUS_REG_HOLDING,
+	/** Input registers, read with FC04 */
+	MODBUS_REG_INPUT,
+};
+
+/**
+ * @brief Block of a Modbus server register map
+ *
+ * A block maps @a count registers from the address @a addr, either to the
+ * array @a regs, read and written in place, or to the bulk handlers
+ * @a read and @a write, called for all the registers of the block a
+ * request accesses at once, instead of once per register. A handler takes
+ * precedence over the array: a write handler may still store the values
+ * in @a regs, read by the server.
+ */
+struct modbus_reg_block {
+	/** Type of the registers */
+	enum modbus_reg_type type;
+	/** Address of the first register */
+	uint16_t addr;
+	/** Number of registers */
+	uint16_t count;
+	/** Register values, can be NULL if @a read is set */
+	uint16_t *regs;
+	/**
+	 * Bulk read handler, can be NULL. It stores the values of
+	 * @p num_regs registers from @p addr in @p regs, and returns 0 or
+	 * a negative errno code.
+	 */
+	int (*read)(const struct modbus_reg_block *block, uint16_t addr,
+		    uint16_t *regs, uint16_t num_regs);
+	/**
+	 * Bulk write handler of holding registers, can be NULL. It writes
+	 * the values of @p num_regs registers from @p addr, and returns 0 or
+	 * a negative errno code. The registers are read-only if neither it
+	 * nor @a regs is set.
+	 */
+	int (*write)(const struct modbus_reg_block *block, uint16_t addr,
+		     const uint16_t *regs, uint16_t num_regs);
+	/** Free for the handlers' use */
+	void *user_data;
+};
+
+/**
+ * @brief Initializer of a register map block of an array of registers
+ *
+ * @param _type  Type of the registers, MODBUS_REG_HOLDING or
+ *               MODBUS_REG_INPUT.
+ * @param _addr  Address of the first register.
+ * @param _array Array of uint16_t register values.
+ */
+#define MODBUS_REG_BLOCK_ARRAY(_type, _addr, _array)			\
+	{								\
+		.type = (_type),					\
+		.addr = (_addr),					\
+		.count = ARRAY_SIZE(_array),				\
+		.regs = (_array),					\
+	}
+
 /**
  * @brief Get Modbus interface index according to interface name
  *
@@ -414,6 +476,17 @@ struct modbus_serial_param {
 struct modbus_server_param {
 	/** Pointer to the User Callback structure */
 	struct modbus_user_callbacks *user_cb;
+	/**
+	 * Register map of the server, can be NULL. The blocks are sorted
+	 * by type, then by address, and the blocks of a type do not
+	 * overlap. The registers of a request are looked up in the map
+	 * first, and only those of the requests starting out of the map
+	 * are accessed through the callbacks. A request starting in the
+	 * map must only access registers of the map, in adjacent blocks.
+	 */
+	const struct modbus_reg_block *reg_map;
+	/** Number of blocks of @a reg_map */
+	size_t reg_map_size;
 	/** Modbus unit ID of the server */
 	uint8_t unit_id;
 };
@@ -14,6 +14,7 @@
 #include <zephyr/types.h>
 #include <sys/util.h>
 #include <zephyr.h>
+#include <sys/dma_mem.h>
 
 #ifndef CONFIG_NET_BUF_USER_DATA_SIZE
 #define CONFIG_NET_BUF_USER_DATA_SIZE 0
@@ -1124,6 +1125,38 @@ extern const struct net_buf_data_cb net_buf_fixed_cb;
 		NET_BUF_POOL_INITIALIZER(_name, &net_buf_fixed_alloc_##_name, \
 					 net_buf_##_name, _count, _destroy)
 
+/**
+ * @def NET_BUF_POOL_DMA_DEFINE
+ * @brief Define a new pool for buffers with DMA capable payloads
+ *
+ * As NET_BUF_POOL_FIXED_DEFINE, with the data payloads in DMA memory (see
+ * include/sys/dma_mem.h): each payload is aligned on a cache line and sized
+ * in whole lines, for drivers to perform DMA transfers on it in place. It
+ * requires CONFIG_DMA_MEM.
+ *
+ * @param _name      Name of the pool variable.
+ * @param _count     Number of buffers in the pool.
+ * @param _data_size Maximum data payload per buffer, rounded up to whole
+ *                   cache lines.
+ * @param _destroy   Optional destroy callback when buffer is freed.
+ */
+#define NET_BUF_POOL_DMA_DEFINE(_name, _count, _data_size, _destroy)          \
+	static struct net_buf net_buf_##_name[_count] __noinit;               \
+	static uint8_t __dma_mem                                              \
+		net_buf_data_##_name[_count][DMA_MEM_ROUND_UP(_data_size)];   \
+	static const struct net_buf_pool_fixed net_buf_fixed_##_name = {      \
+		.data_size = DMA_MEM_ROUND_UP(_data_size),                    \
+		.data_pool = (uint8_t *)net_buf_data_##_name,                 \
+	};                                                                    \
+	static const struct net_buf_data_alloc net_buf_fixed_alloc_##_name = {\
+		.cb = &net_buf_fixed_cb,                                      \
+		.alloc_data = (void *)&net_buf_fixed_##_name,                 \
+	};                                                                    \
+	static struct net_buf_pool _name __net_buf_align                      \
+			__in_section(_net_buf_pool, static, _name) =          \
+		NET_BUF_POOL_INITIALIZER(_name, &net_buf_fixed_alloc_##_name, \
+					 net_buf_##_name, _count, _destroy)
+
 /** @cond INTERNAL_HIDDEN */
 extern const struct net_buf_data_cb net_buf_var_cb;
 /** @endcond */
@@ -26,6 +26,30 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief Rule of a capture filter.
+ *
+ * @details A field of the packet, counted from the start of the data
+ * captured, is compared with a value. A packet is captured when all the
+ * rules of the filter match.
+ */
+struct net_capture_filter {
+	/** Offset of the field in the packet */
+	uint16_t offset;
+
+	/** Length of the field, 1, 2 or 4 bytes */
+	uint8_t len;
+
+	/** Match when the field is different from the value */
+	bool negate;
+
+	/** Bits of the field that are compared */
+	uint32_t mask;
+
+	/** Value of the field, in host byte order */
+	uint32_t value;
+};
+
 /** @cond INTERNAL_HIDDEN */
 
 struct net_if;
@@ -49,6 +73,15 @@ struct net_capture_interface_api {
 	/** Send captured data */
 	int (*send)(const struct device *dev, struct net_if *iface,
 		    struct net_pkt *pkt);
+
+	/** Set the filter of captured packets */
+	int (*set_filter)(const struct device *dev,
+			  const struct net_capture_filter *filter,
+			  int count);
+
+	/** Switch to or from the ring buffer mode */
+	int (*set_ring)(const struct device *dev, bool enable,
+			uint16_t snaplen);
 };
 
 /** @endcond */
@@ -193,6 +226,71 @@ static inline int net_capture_send(const struct device *dev,
 #endif
 }
 
+/**
+ * @brief Set the filter of captured packets.
+ *
+ * @details Only the packets matching all the rules of the filter are
+ * captured. The rules are copied, and a count of 0 captures all the
+ * packets again.
+ *
+ * @param dev Network capture device
+ * @param filter Rules of the filter
+ * @param count Number of rules, at most CONFIG_NET_CAPTURE_FILTER_COUNT
+ *
+ * @return 0 if ok, <0 if the filter is invalid
+ */
+static inline int net_capture_set_filter(const struct device *dev,
+					 const struct net_capture_filter *filter,
+					 int count)
+{
+#if defined(CONFIG_NET_CAPTURE)
+	const struct net_capture_interface_api *api =
+		(const struct net_capture_interface_api *)dev->api;
+
+	return api->set_filter(dev, filter, count);
+#else
+	ARG_UNUSED(dev);
+	ARG_UNUSED(filter);
+	ARG_UNUSED(count);
+
+	return -ENOTSUP;
+#endif
+}
+
+/**
+ * @brief Switch the capture device to or from the ring buffer mode.
+ *
+ * @details In ring buffer mode, the captured packets are copied to a
+ * ring buffer of the device instead of being cloned. They are sent to the
+ * tunnel peer in batches, as several pcap packet records per UDP datagram,
+ * with the pcap fields in network byte order. When the ring buffer is
+ * full, the packets are dropped. The mode can only be changed while
+ * capturing is disabled.
+ *
+ * @param dev Network capture device
+ * @param enable True to use the ring buffer, false to clone the packets
+ * @param snaplen How many bytes of each packet to capture, 0 for all of
+ *        them. The records are also cut to fit in a datagram.
+ *
+ * @return 0 if ok, <0 if the mode cannot be changed
+ */
+static inline int net_capture_set_ring(const struct device *dev, bool enable,
+				       uint16_t snaplen)
+{
+#if defined(CONFIG_NET_CAPTURE)
+	const struct net_capture_interface_api *api =
+		(const struct net_capture_interface_api *)dev->api;
+
+	return api->set_ring(dev, enable, snaplen);
+#else
+	ARG_UNUSED(dev);
+	ARG_UNUSED(enable);
+	ARG_UNUSED(snaplen);
+
+	return -ENOTSUP;
+#endif
+}
+
 /** @cond INTERNAL_HIDDEN */
 
 /**
@@ -218,7 +316,10 @@ struct net_capture_info {
 	struct net_if *tunnel_iface;
 	struct sockaddr *peer;
 	struct sockaddr *local;
+	uint32_t captured;
+	uint32_t dropped;
 	bool is_enabled;
+	bool is_ring;
 };
 
 /**
@@ -73,6 +73,9 @@ enum coap_method {
 	COAP_METHOD_POST = 2,
 	COAP_METHOD_PUT = 3,
 	COAP_METHOD_DELETE = 4,
+	COAP_METHOD_FETCH = 5,
+	COAP_METHOD_PATCH = 6,
+	COAP_METHOD_IPATCH = 7,
 };
 
 #define COAP_REQUEST_MASK 0x07
@@ -211,6 +214,33 @@ struct coap_resource {
 	int age;
 };
 
+/**
+ * @brief Node of the path trie of a resource index.
+ */
+struct coap_resource_index_node {
+	/** Path segment, points into the path of a resource */
+	const char *segment;
+	/** Length of the segment */
+	uint16_t len;
+	/** Position of the first child, the children are sorted */
+	uint16_t first_child;
+	/** Number of children */
+	uint16_t num_children;
+	/** Position of the resource in the array plus one, 0 if none */
+	uint16_t resource;
+};
+
+/**
+ * @brief Index of an array of CoAP resources by path, see
+ * coap_resource_index_init().
+ */
+struct coap_resource_index {
+	struct coap_resource *resources;
+	struct coap_resource_index_node *nodes;
+	uint16_t num_nodes;
+	bool wildcards;
+};
+
 /**
  * @brief Represents a remote device that is observing a local resource.
  */
@@ -514,6 +544,61 @@ int coap_handle_request(struct coap_packet *cpkt,
 			uint8_t opt_num,
 			struct sockaddr *addr, socklen_t addr_len);
 
+/**
+ * @brief Builds an index of the paths of an array of resources, to find
+ * the resource of a request without comparing its path with every resource.
+ *
+ * A node is used for each distinct path prefix, so @a max_nodes is at most
+ * one plus the total number of path segments. The resources shall not be
+ * added or changed while the index is used.
+ *
+ * @param index Index to initialize
+ * @param resources Array of known resources, terminated by a resource
+ *        with a NULL path
+ * @param nodes Array of nodes for the index
+ * @param max_nodes Size of the array of nodes
+ *
+ * @return 0 in case of success, -ENOMEM if there are not enough nodes.
+ */
+int coap_resource_index_init(struct coap_resource_index *index,
+			     struct coap_resource *resources,
+			     struct coap_resource_index_node *nodes,
+			     size_t max_nodes);
+
+/**
+ * @brief Returns the resource matching the path of a request. As with
+ * coap_handle_request(), the first resource of the array matching the path
+ * is returned.
+ *
+ * @param index Index of the resources
+ * @param options Parsed options from coap_packet_parse()
+ * @param opt_num Number of options
+ *
+ * @return A pointer to the resource, NULL if none matches.
+ */
+struct coap_resource *coap_resource_index_find(
+	const struct coap_resource_index *index,
+	struct coap_option *options, uint8_t opt_num);
+
+/**
+ * @brief Same as coap_handle_request(), with the resource found through
+ * an index.
+ *
+ * @param cpkt Packet received
+ * @param index Index of the resources, see coap_resource_index_init()
+ * @param options Parsed options from coap_packet_parse()
+ * @param opt_num Number of options
+ * @param addr Peer address
+ * @param addr_len Peer address length
+ *
+ * @return 0 in case of success or negative in case of error.
+ */
+int coap_handle_request_index(struct coap_packet *cpkt,
+			      const struct coap_resource_index *index,
+			      struct coap_option *options,
+			      uint8_t opt_num,
+			      struct sockaddr *addr, socklen_t addr_len);
+
 /**
  * Represents the size of each block that will be transferred using
  * block-wise transfers [RFC7959]:
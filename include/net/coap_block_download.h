@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief CoAP block-wise download with several blocks requested at once.
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_COAP_BLOCK_DOWNLOAD_H_
+#define ZEPHYR_INCLUDE_NET_COAP_BLOCK_DOWNLOAD_H_
+
+#include <net/coap.h>
+
+/**
+ * @addtogroup coap COAP Library
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct coap_block_download;
+
+/**
+ * @brief Callback to build and send the request for a block.
+ *
+ * The request shall use the given token, and contain the Block2 option
+ * appended with coap_append_block2_option() from @a block. The request for
+ * the first block (@a block current offset 0) should also contain a Size2
+ * option of 0, so that the server reports the size of the resource: the
+ * blocks are only requested in parallel once it is known.
+ *
+ * @param download Download requesting the block
+ * @param block Block to request
+ * @param token Token of the request
+ * @param tkl Length of the token
+ * @param user_data User data given to coap_block_download_init()
+ *
+ * @return 0 in case of success or negative in case of error.
+ */
+typedef int (*coap_block_request_t)(struct coap_block_download *download,
+				    struct coap_block_context *block,
+				    const uint8_t *token, uint8_t tkl,
+				    void *user_data);
+
+/**
+ * @brief Callback receiving the downloaded data.
+ *
+ * With a reassembly buffer, the data is given in order. Otherwise, the blocks
+ * are given as they are received, possibly out of order.
+ *
+ * @param download Download receiving the data
+ * @param offset Offset of the data in the resource
+ * @param data Data received
+ * @param len Length of the data
+ * @param last True for the last data of the download
+ * @param user_data User data given to coap_block_download_init()
+ *
+ * @return 0 in case of success or negative in case of error, which fails
+ * the download.
+ */
+typedef int (*coap_block_sink_t)(struct coap_block_download *download,
+				 size_t offset, const uint8_t *data,
+				 uint16_t len, bool last, void *user_data);
+
+/**
+ * @brief Request of a block waiting for its response.
+ */
+struct coap_block_download_slot {
+	uint32_t num;
+	uint16_t len;
+	uint8_t state;
+	uint8_t token[8];
+};
+
+/**
+ * @brief State of a block-wise download of a resource, with Block2.
+ */
+struct coap_block_download {
+	coap_block_request_t request;
+	coap_block_sink_t sink;
+	void *user_data;
+	uint8_t *buf;
+	size_t buf_len;
+	size_t total_size;
+	uint32_t next_num;
+	uint32_t deliver_num;
+	uint32_t last_num;
+	enum coap_block_size block_size;
+	uint8_t window;
+	bool negotiated;
+	struct coap_block_download_slot
+		slots[CONFIG_COAP_BLOCK_DOWNLOAD_MAX_WINDOW];
+};
+
+/**
+ * @brief Initializes a block-wise download.
+ *
+ * @param download Download to initialize
+ * @param block_size Preferred block size, the server may choose a smaller
+ *        one in its first response
+ * @param window Number of blocks requested at the same time, at most
+ *        CONFIG_COAP_BLOCK_DOWNLOAD_MAX_WINDOW
+ * @param buf Buffer to reorder the blocks received out of order, at least
+ *        @a window blocks of @a block_size, NULL to give the blocks to
+ *        @a sink as they are received
+ * @param buf_len Length of the buffer
+ * @param request Callback sending the requests
+ * @param sink Callback receiving the data
+ * @param user_data User data given to the callbacks
+ *
+ * @return 0 in case of success or negative in case of error.
+ */
+int coap_block_download_init(struct coap_block_download *download,
+			     enum coap_block_size block_size, uint8_t window,
+			     uint8_t *buf, size_t buf_len,
+			     coap_block_request_t request,
+			     coap_block_sink_t sink, void *user_data);
+
+/**
+ * @brief Starts the download by requesting the first block.
+ *
+ * @param download Download to start
+ *
+ * @return 0 in case of success or negative in case of error.
+ */
+int coap_block_download_start(struct coap_block_download *download);
+
+/**
+ * @brief Handles a response to one of the requests of the download, and
+ * requests the next blocks.
+ *
+ * @param download Download the response belongs to
+ * @param response Response received
+ *
+ * @return 0 in case of success, -ENOENT if the response does not match a
+ * request of the download, -ENOMSG if the server returned an error,
+ * -EBADMSG for an invalid response, or the error of a callback.
+ */
+int coap_block_download_response(struct coap_block_download *download,
+				 const struct coap_packet *response);
+
+/**
+ * @brief Requests the block of a request which got no response again,
+ * with a new token.
+ *
+ * @param download Download the request belongs to
+ * @param token Token of the request
+ * @param tkl Length of the token
+ *
+ * @return 0 in case of success, -ENOENT if the token does not match a
+ * request of the download, or the error of the request callback.
+ */
+int coap_block_download_retry(struct coap_block_download *download,
+			      const uint8_t *token, uint8_t tkl);
+
+/**
+ * @brief Returns whether all the blocks have been received.
+ *
+ * @param download Download to check
+ *
+ * @return True once the sink has got the last data.
+ */
+bool coap_block_download_is_done(const struct coap_block_download *download);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_COAP_BLOCK_DOWNLOAD_H_ */
@@ -15,6 +15,7 @@
 
 #include <net/net_ip.h>
 #include <net/net_context.h>
+#include <net/net_mgmt.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -242,6 +243,44 @@ struct dns_resolve_context {
 		uint16_t query_hash;
 	} queries[CONFIG_DNS_NUM_CONCUR_QUERIES];
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	/** Answers received earlier, replayed to the callers of
+	 * dns_resolve_name() until their TTL expires.
+	 *
+	 * Contents of this structure can be inspected and changed only when
+	 * the lock is held.
+	 */
+	struct dns_cache_entry {
+		/** Time when the entry expires, in ms of uptime. An entry
+		 * is unused if it has expired.
+		 */
+		int64_t expires;
+
+		/** Name that was resolved, as given by the caller */
+		char name[CONFIG_DNS_RESOLVER_CACHE_NAME_LEN + 1];
+
+		/** Query type */
+		enum dns_query_type query_type;
+
+		/** Status to report after the addresses, DNS_EAI_ALLDONE
+		 * or DNS_EAI_NODATA if the name does not exist.
+		 */
+		int status;
+
+		/** Number of resolved addresses */
+		uint8_t count;
+
+		/** Resolved addresses */
+		struct sockaddr addr[CONFIG_DNS_RESOLVER_AI_MAX_ENTRIES];
+	} cache[CONFIG_DNS_RESOLVER_CACHE_SIZE];
+
+	/** Number of queries answered from the cache */
+	uint32_t cache_hits;
+
+	/** Number of queries that had to be sent to a server */
+	uint32_t cache_misses;
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 	/** Is this context in use */
 	enum dns_resolve_context_state state;
 };
@@ -377,6 +416,19 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 		     void *user_data,
 		     int32_t timeout);
 
+/**
+ * @brief Flush the DNS answer cache.
+ *
+ * @details Forgets all the answers cached in the context, so that the
+ * following queries are sent to the DNS servers. This does nothing unless
+ * CONFIG_DNS_RESOLVER_CACHE is enabled.
+ *
+ * @param ctx DNS context
+ *
+ * @return 0 if ok, <0 if error.
+ */
+int dns_resolve_cache_flush(struct dns_resolve_context *ctx);
+
 /**
  * @brief Get default DNS context.
  *
@@ -458,6 +510,26 @@ static inline int dns_cancel_addr_info(uint16_t dns_id)
 #if defined(CONFIG_DNS_RESOLVER)
 void dns_init_resolver(void);
 
+/* Management part definitions */
+
+#define _NET_DNS_LAYER	NET_MGMT_LAYER_L4
+#define _NET_DNS_CODE	0x115
+#define _NET_DNS_BASE	(NET_MGMT_LAYER(_NET_DNS_LAYER) |	\
+			 NET_MGMT_LAYER_CODE(_NET_DNS_CODE))
+
+enum net_request_dns_cmd {
+	NET_REQUEST_DNS_CMD_CACHE_FLUSH = 1,
+};
+
+/* Flushes the answer cache of the DNS context given as data, with len set
+ * to sizeof(struct dns_resolve_context), or of the default context if
+ * data is NULL.
+ */
+#define NET_REQUEST_DNS_CACHE_FLUSH				\
+	(_NET_DNS_BASE | NET_REQUEST_DNS_CMD_CACHE_FLUSH)
+
+NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_DNS_CACHE_FLUSH);
+
 #else
 #define dns_init_resolver(...)
 #endif /* CONFIG_DNS_RESOLVER */
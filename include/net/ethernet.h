@@ -160,6 +160,18 @@ enum ethernet_hw_caps {
 
 	/** TXTIME supported */
 	ETHERNET_TXTIME			= BIT(19),
+
+	/** TCP segmentation offload (TSO) supported. TCP segments carrying
+	 * more than one MSS of data, as given by net_pkt_tso_mss(), are
+	 * split by the hardware. Only used together with
+	 * ETHERNET_HW_TX_CHKSUM_OFFLOAD.
+	 */
+	ETHERNET_HW_TX_TCP_SEGMENTATION	= BIT(20),
+
+	/** VLAN Tag insertion. The tag of net_pkt_vlan_tci() is inserted by
+	 * the hardware, the Ethernet header is built without it.
+	 */
+	ETHERNET_HW_VLAN_TAG_INSERT	= BIT(21),
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -519,6 +531,14 @@ struct ethernet_context {
 	 * of network interfaces.
 	 */
 	ATOMIC_DEFINE(interfaces, NET_VLAN_MAX_COUNT);
+
+#if defined(CONFIG_NET_VLAN_TAG_MAP)
+	/** Index + 1 in the vlan array of each enabled VLAN tag, 0 if the
+	 * tag is not enabled. Finds the interface of a received frame
+	 * without going through the vlan array.
+	 */
+	uint8_t vlan_map[NET_VLAN_TAG_UNSPEC + 1];
+#endif
 #endif
 
 	/** Carrier ON/OFF handler worker. This is used to create
@@ -573,6 +593,14 @@ struct ethernet_context {
 	int8_t vlan_enabled;
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_ETHERNET) && \
+	defined(CONFIG_NET_STATISTICS_PER_CPU)
+	/** Per CPU counters of the L2, added to the driver statistics
+	 * when these are read.
+	 */
+	struct net_stats_eth_cpu stats_cpu[CONFIG_MP_NUM_CPUS];
+#endif
+
 	/** Is network carrier up */
 	bool is_net_carrier_up : 1;
 
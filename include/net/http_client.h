@@ -109,6 +109,15 @@ struct http_response {
 	/** Where the body starts */
 	uint8_t *body_start;
 
+	/** Start of the body fragment given to the response callback, in
+	 * recv_buf. The fragments do not contain the chunk headers of a
+	 * chunked response. NULL if there is no body data in the callback.
+	 */
+	uint8_t *body_frag_start;
+
+	/** Length of the body fragment given to the response callback */
+	size_t body_frag_len;
+
 	/** Where the response is stored, this is to be
 	 * provided by the user.
 	 */
@@ -290,6 +299,129 @@ struct http_request {
 int http_client_req(int sock, struct http_request *req,
 		    int32_t timeout, void *user_data);
 
+#if defined(CONFIG_HTTP_CLIENT_POOL)
+
+#if !defined(HTTP_CLIENT_POOL_HOST_LEN)
+#define HTTP_CLIENT_POOL_HOST_LEN	64
+#endif
+
+#if !defined(HTTP_CLIENT_POOL_PORT_LEN)
+#define HTTP_CLIENT_POOL_PORT_LEN	6
+#endif
+
+/**
+ * @typedef http_client_connect_cb_t
+ * @brief Callback used by a connection pool to create a connection.
+ *
+ * The application creates the socket, sets it up (for example the TLS
+ * credentials and host name) and connects it to the server.
+ *
+ * @param host Host name of the server, as set in the request
+ * @param port Port of the server, as set in the request, may be NULL
+ * @param user_data User data given to http_client_pool_init()
+ *
+ * @return Connected socket, or <0 if error.
+ */
+typedef int (*http_client_connect_cb_t)(const char *host, const char *port,
+					void *user_data);
+
+/** Connection of an HTTP client pool, the application should not touch it */
+struct http_client_conn {
+	/** Connected socket, -1 if not connected */
+	int sock;
+
+	/** Uptime in milliseconds when the connection became idle */
+	int64_t idle_since;
+
+	/** Host name of the server */
+	char host[HTTP_CLIENT_POOL_HOST_LEN];
+
+	/** Port of the server, empty if not given */
+	char port[HTTP_CLIENT_POOL_PORT_LEN];
+
+	/** Connection used by a request */
+	bool busy;
+};
+
+/**
+ * HTTP client connection pool. The connections are kept open between the
+ * requests to a same host and port, while the server keeps them alive.
+ */
+struct http_client_pool {
+	/** Callback creating the connections */
+	http_client_connect_cb_t connect;
+
+	/** User data given to the connect callback */
+	void *user_data;
+
+	/** Lock of the connections */
+	struct k_mutex lock;
+
+	/** Connections */
+	struct http_client_conn conns[CONFIG_HTTP_CLIENT_POOL_CONNECTIONS];
+};
+
+/**
+ * @brief Initialize an HTTP client connection pool.
+ *
+ * @param pool Connection pool
+ * @param connect Callback creating the connections
+ * @param user_data User data given to the connect callback
+ */
+void http_client_pool_init(struct http_client_pool *pool,
+			   http_client_connect_cb_t connect, void *user_data);
+
+/**
+ * @brief Do a HTTP request on a connection of the pool, to the host and port
+ * of the request. An idle connection to the server is used if there is one,
+ * otherwise a new connection is created. The connection is kept open after
+ * the response if the server allows it, and closed once it has been idle for
+ * CONFIG_HTTP_CLIENT_POOL_IDLE_TIMEOUT milliseconds.
+ *
+ * If an idle connection was closed by the server, the request is sent again
+ * on a new connection, unless its payload is given by a callback.
+ *
+ * @param pool Connection pool
+ * @param req HTTP request information
+ * @param timeout Max timeout to wait for the data, in milliseconds.
+ * @param user_data User specified data that is passed to the callback.
+ *
+ * @return <0 if error, -ECONNRESET if the connection was closed before the
+ * response, >=0 amount of data sent to the server
+ */
+int http_client_pool_req(struct http_client_pool *pool,
+			 struct http_request *req, int32_t timeout,
+			 void *user_data);
+
+/**
+ * @brief Pipeline HTTP requests on a connection of the pool. All the requests
+ * are sent before waiting for the responses, which are received in order.
+ * The requests shall have the same host and port, and the receive buffers
+ * the same length. Pipelining should only be used for requests which can be
+ * repeated safely, and without large payloads.
+ *
+ * @param pool Connection pool
+ * @param reqs Array of HTTP requests
+ * @param count Number of requests
+ * @param timeout Max timeout to wait for each response, in milliseconds.
+ * @param user_data User specified data that is passed to the callbacks.
+ *
+ * @return <0 if error, >=0 number of requests which got a complete response
+ * (the first ones of the array). The other requests are to be sent again.
+ */
+int http_client_pool_pipeline(struct http_client_pool *pool,
+			      struct http_request *reqs, size_t count,
+			      int32_t timeout, void *user_data);
+
+/**
+ * @brief Close the idle connections of the pool.
+ *
+ * @param pool Connection pool
+ */
+void http_client_pool_close(struct http_client_pool *pool);
+
+#endif /* CONFIG_HTTP_CLIENT_POOL */
+
 #ifdef __cplusplus
 }
 #endif
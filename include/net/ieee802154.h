@@ -70,7 +70,8 @@ struct ieee802154_context {
 	uint8_t ack_received	: 1;
 	uint8_t ack_requested	: 1;
 	uint8_t associated		: 1;
-	uint8_t _unused		: 5;
+	uint8_t tx_burst		: 1;
+	uint8_t _unused		: 4;
 };
 
 #define IEEE802154_L2_CTX_TYPE	struct ieee802154_context
@@ -331,6 +331,22 @@ struct mqtt_client;
 typedef void (*mqtt_evt_cb_t)(struct mqtt_client *client,
 			      const struct mqtt_evt *evt);
 
+/**
+ * @brief Callback providing the payload of a message published with
+ *        mqtt_publish_stream().
+ *
+ * @param[in] client Identifies the client sending the message.
+ * @param[in] user_data User data given to mqtt_publish_stream().
+ * @param[in] offset Offset of the requested data in the payload.
+ * @param[out] buf Buffer to copy the data to.
+ * @param[in] len Number of bytes requested.
+ *
+ * @return Number of bytes copied, between 1 and @p len, or a negative error
+ *         code (errno.h).
+ */
+typedef int (*mqtt_payload_cb_t)(struct mqtt_client *client, void *user_data,
+				 uint32_t offset, uint8_t *buf, uint32_t len);
+
 /** @brief TLS configuration for secure MQTT transports. */
 struct mqtt_sec_config {
 	/** Indicates the preference for peer verification. */
@@ -442,6 +458,25 @@ struct mqtt_transport {
 };
 
 /** @brief MQTT internal state. */
+#if defined(CONFIG_MQTT_LIB_INFLIGHT)
+/** @brief Publish message waiting for an acknowledgment. */
+struct mqtt_inflight_msg {
+	/** Internal. Copy of the publish parameters. The topic and the payload
+	 *  are not copied.
+	 */
+	struct mqtt_publish_param param;
+
+	/** Internal. Payload source of a streamed message, NULL otherwise. */
+	mqtt_payload_cb_t payload_cb;
+
+	/** Internal. User data of the payload source. */
+	void *user_data;
+
+	/** Internal. Packet type expected from the broker, 0 if unused. */
+	uint8_t ack_type;
+};
+#endif /* CONFIG_MQTT_LIB_INFLIGHT */
+
 struct mqtt_internal {
 	/** Internal. Mutex to protect access to the client instance. */
 	struct sys_mutex mutex;
@@ -459,6 +494,16 @@ struct mqtt_internal {
 
 	/** Internal. Remaining payload length to read. */
 	uint32_t remaining_payload;
+
+#if defined(CONFIG_MQTT_LIB_INFLIGHT)
+	/** Internal. QoS 1 and QoS 2 messages not acknowledged yet. Kept
+	 *  between connections.
+	 */
+	struct mqtt_inflight_msg inflight[CONFIG_MQTT_LIB_INFLIGHT_MAX];
+
+	/** Internal. Last message id assigned to a publish message. */
+	uint16_t last_message_id;
+#endif /* CONFIG_MQTT_LIB_INFLIGHT */
 };
 
 /**
@@ -594,10 +639,43 @@ int mqtt_connect(struct mqtt_client *client);
  *                  Shall not be NULL.
  *
  * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ *
+ * @note With @kconfig{CONFIG_MQTT_LIB_INFLIGHT}, QoS 1 and QoS 2 messages are
+ *       kept until they are acknowledged, and the topic and payload buffers
+ *       shall remain valid until then (@ref MQTT_EVT_PUBACK or
+ *       @ref MQTT_EVT_PUBCOMP). A message id of 0 lets the library pick an
+ *       unused one. The PUBREL is sent by the library. If all in-flight
+ *       entries are in use, -EAGAIN is returned.
  */
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param);
 
+/**
+ * @brief API to publish messages with a payload read from a callback.
+ *
+ * The payload is copied in chunks to the transmit buffer, after the header
+ * of the message, so that payloads larger than the transmit buffer (for
+ * example, stored in flash) can be published without being in RAM. The
+ * call returns once the whole message has been written.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ * @param[in] param Parameters to be used for the publish message. The
+ *                  payload length gives the length of the payload, the
+ *                  payload data is not used. Shall not be NULL.
+ * @param[in] payload_cb Callback providing the payload. Shall not be NULL.
+ * @param[in] user_data User data given to @p payload_cb.
+ *
+ * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ *         The connection is closed if the payload could not be completed.
+ *
+ * @note With @kconfig{CONFIG_MQTT_LIB_INFLIGHT}, @p payload_cb may be called
+ *       again to resend the message, until it is acknowledged.
+ */
+int mqtt_publish_stream(struct mqtt_client *client,
+			const struct mqtt_publish_param *param,
+			mqtt_payload_cb_t payload_cb, void *user_data);
+
 /**
  * @brief API used by client to send acknowledgment on receiving QoS1 publish
  *        message. Should be called on reception of @ref MQTT_EVT_PUBLISH with
@@ -635,6 +713,10 @@ int mqtt_publish_qos2_receive(struct mqtt_client *client,
  * @param[in] param Identifies message being released.
  *
  * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ *
+ * @note With @kconfig{CONFIG_MQTT_LIB_INFLIGHT}, the library already sent
+ *       the PUBREL when @ref MQTT_EVT_PUBREC is notified. Calling this
+ *       function for such a message sends nothing and returns 0.
  */
 int mqtt_publish_qos2_release(struct mqtt_client *client,
 			      const struct mqtt_pubrel_param *param);
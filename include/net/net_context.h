@@ -990,6 +990,42 @@ int net_context_sendmsg(struct net_context *context,
 			k_timeout_t timeout,
 			void *user_data);
 
+/**
+ * @brief Send a chain of network buffers without copying it.
+ *
+ * @details This function works like net_context_sendto(), but the data
+ * is sent from the given buffers instead of being copied to buffers of
+ * the stack. The buffers can hold data of their own or refer to memory
+ * of the caller, see net_buf_alloc_with_data(), for instance in flash or
+ * used for DMA. On success, the stack takes over the reference to the
+ * chain and releases it once the data is sent, or acknowledged for TCP,
+ * which calls the destroy callback of the buffer pool: this is when the
+ * memory can be reused. The buffers must not be modified until then.
+ * On error, the reference stays with the caller.
+ * If dst_addr is NULL, the data is sent to the address set by
+ * net_context_connect().
+ *
+ * Only UDP and TCP are supported. A UDP datagram is sent as a whole or
+ * not at all.
+ *
+ * @param context The network context to use.
+ * @param frags The data to send.
+ * @param dst_addr Destination address, or NULL.
+ * @param addrlen Length of the address.
+ * @param cb Caller-supplied callback function.
+ * @param timeout Currently this value is not used.
+ * @param user_data Caller-supplied user data.
+ *
+ * @return numbers of bytes sent on success, a negative errno otherwise
+ */
+int net_context_sendto_buf(struct net_context *context,
+			   struct net_buf *frags,
+			   const struct sockaddr *dst_addr,
+			   socklen_t addrlen,
+			   net_context_send_cb_t cb,
+			   k_timeout_t timeout,
+			   void *user_data);
+
 /**
  * @brief Receive network data from a peer specified by context.
  *
@@ -1060,6 +1096,7 @@ enum net_context_option {
 	NET_OPT_SOCKS5		= 3,
 	NET_OPT_RCVTIMEO        = 4,
 	NET_OPT_SNDTIMEO        = 5,
+	NET_OPT_TCP_CONGESTION  = 6,
 };
 
 /**
@@ -117,6 +117,24 @@ enum net_verdict {
  */
 int net_recv_data(struct net_if *iface, struct net_pkt *pkt);
 
+/**
+ * @brief Called by lower network stack or network device driver when
+ * several network packets have been received. The packets are pushed up in
+ * the network stack together, so each traffic class queue is only locked
+ * and woken up once for its packets.
+ *
+ * @param iface Network interface where the packets were received.
+ * @param pkts Array of network packets. It is used as scratch space, its
+ *        content is undefined on return.
+ * @param count Number of packets in the array.
+ *
+ * @return Number of packets queued if ok, <0 if error. On error, none of
+ * the packets is taken and the array is left as it is. Otherwise all of
+ * them are taken: the empty ones are dropped.
+ */
+int net_recv_data_batch(struct net_if *iface, struct net_pkt **pkts,
+			size_t count);
+
 /**
  * @brief Send data to network.
  *
@@ -472,6 +472,16 @@ struct net_if {
 #if defined(CONFIG_NET_STATISTICS_PER_INTERFACE)
 	/** Network statistics related to this network interface */
 	struct net_stats stats;
+
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+	/** Per CPU copies of the statistics, summed to stats when read.
+	 * These are not cache line aligned as the interfaces are placed
+	 * in an iterable section.
+	 */
+	struct {
+		struct net_stats stats;
+	} stats_cpu[CONFIG_MP_NUM_CPUS];
+#endif
 #endif /* CONFIG_NET_STATISTICS_PER_INTERFACE */
 
 	/** Network interface instance configuration */
@@ -616,6 +626,19 @@ static inline const struct device *net_if_get_device(struct net_if *iface)
  */
 void net_if_queue_tx(struct net_if *iface, struct net_pkt *pkt);
 
+/**
+ * @brief Queue several packets to the net interface TX queues
+ *
+ * Consecutive packets of the same traffic class are queued together.
+ *
+ * @param iface Pointer to a network interface structure
+ * @param pkts Array of net packets to queue. It is used as scratch space,
+ *        its content is undefined on return.
+ * @param count Number of packets in the array
+ */
+void net_if_queue_tx_batch(struct net_if *iface, struct net_pkt **pkts,
+			   size_t count);
+
 /**
  * @brief Return the IP offload status
  *
@@ -1964,6 +1987,17 @@ bool net_if_need_calc_rx_checksum(struct net_if *iface);
  */
 bool net_if_need_calc_tx_checksum(struct net_if *iface);
 
+/**
+ * @brief Check if TCP segments longer than the MSS can be handed to the
+ * network device, which splits them itself when sending. This requires
+ * the device to also calculate the checksums.
+ *
+ * @param iface Network interface
+ *
+ * @return True if TCP segmentation can be offloaded, false otherwise.
+ */
+bool net_if_supports_tx_tso(struct net_if *iface);
+
 /**
  * @brief Get interface according to index
  *
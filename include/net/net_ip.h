@@ -236,6 +236,24 @@ struct msghdr {
 	int           msg_flags;      /* flags on received message */
 };
 
+struct mmsghdr {
+	struct msghdr msg_hdr;        /* message */
+	unsigned int  msg_len;        /* bytes sent or received */
+};
+
+/* Ancillary data of IP_PKTINFO */
+struct in_pktinfo {
+	int            ipi_ifindex;   /* interface index */
+	struct in_addr ipi_spec_dst;  /* local address */
+	struct in_addr ipi_addr;      /* destination address */
+};
+
+/* Ancillary data of IPV6_PKTINFO */
+struct in6_pktinfo {
+	struct in6_addr ipi6_addr;    /* destination address */
+	int             ipi6_ifindex; /* interface index */
+};
+
 struct cmsghdr {
 	socklen_t cmsg_len;    /* Number of bytes, including header */
 	int       cmsg_level;  /* Originating protocol */
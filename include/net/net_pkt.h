@@ -121,6 +121,25 @@ struct net_pkt {
 	uint64_t txtime;
 #endif /* CONFIG_NET_PKT_TXTIME */
 
+#if defined(CONFIG_NET_TCP_TSO)
+	/** MSS the driver splits this TCP segment to, 0 if not to be split */
+	uint16_t tso_mss;
+#endif /* CONFIG_NET_TCP_TSO */
+
+#if defined(CONFIG_NET_RX_FLOW_STEERING)
+	/** Flow hash given by the driver (such as an RSS hash), 0 if none */
+	uint32_t rx_hash;
+#endif /* CONFIG_NET_RX_FLOW_STEERING */
+
+#if defined(CONFIG_NET_PKT_RX_LATENCY)
+	struct {
+		/** Time in cycles when the previous RX stage ended */
+		uint32_t time;
+		/** Next RX stage to collect plus one, 0 if not collected */
+		uint8_t stage;
+	} rx_latency;
+#endif /* CONFIG_NET_PKT_RX_LATENCY */
+
 	/** Reference counter */
 	atomic_t atomic_ref;
 
@@ -184,6 +203,10 @@ struct net_pkt {
 	uint8_t captured : 1; /* Set to 1 if this packet is already being
 			       * captured
 			       */
+	uint8_t l2_processed : 1; /* Set to 1 if this packet was already
+				   * processed by the L2 and is passed back
+				   * to the stack by it
+				   */
 
 	union {
 		/* IPv6 hop limit or IPv4 ttl for this network packet.
@@ -234,6 +257,11 @@ struct net_pkt {
 	uint8_t ipv6_next_hdr;	/* What is the very first next header */
 #endif /* CONFIG_NET_IPV6 */
 
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+	uint16_t ipv4_fragment_offset;	/* Fragment offset of this packet */
+	uint8_t ipv4_fragment_flags;	/* Fragment flags of this packet */
+#endif /* CONFIG_NET_IPV4_FRAGMENT */
+
 #if defined(CONFIG_IEEE802154)
 	uint8_t ieee802154_rssi; /* Received Signal Strength Indication */
 	uint8_t ieee802154_lqi;  /* Link Quality Indicator */
@@ -341,6 +369,17 @@ static inline void net_pkt_set_captured(struct net_pkt *pkt, bool is_captured)
 	pkt->captured = is_captured;
 }
 
+static inline bool net_pkt_is_l2_processed(struct net_pkt *pkt)
+{
+	return !!(pkt->l2_processed);
+}
+
+static inline void net_pkt_set_l2_processed(struct net_pkt *pkt,
+					    bool is_l2_processed)
+{
+	pkt->l2_processed = is_l2_processed;
+}
+
 static inline uint8_t net_pkt_ip_hdr_len(struct net_pkt *pkt)
 {
 	return pkt->ip_hdr_len;
@@ -685,6 +724,58 @@ static inline void net_pkt_set_ipv6_fragment_id(struct net_pkt *pkt,
 }
 #endif /* CONFIG_NET_IPV6_FRAGMENT */
 
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+static inline uint16_t net_pkt_ipv4_fragment_offset(struct net_pkt *pkt)
+{
+	return pkt->ipv4_fragment_offset;
+}
+
+static inline void net_pkt_set_ipv4_fragment_offset(struct net_pkt *pkt,
+						    uint16_t offset)
+{
+	pkt->ipv4_fragment_offset = offset;
+}
+
+static inline uint8_t net_pkt_ipv4_fragment_flags(struct net_pkt *pkt)
+{
+	return pkt->ipv4_fragment_flags;
+}
+
+static inline void net_pkt_set_ipv4_fragment_flags(struct net_pkt *pkt,
+						   uint8_t flags)
+{
+	pkt->ipv4_fragment_flags = flags;
+}
+#else /* CONFIG_NET_IPV4_FRAGMENT */
+static inline uint16_t net_pkt_ipv4_fragment_offset(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_ipv4_fragment_offset(struct net_pkt *pkt,
+						    uint16_t offset)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(offset);
+}
+
+static inline uint8_t net_pkt_ipv4_fragment_flags(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_ipv4_fragment_flags(struct net_pkt *pkt,
+						   uint8_t flags)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(flags);
+}
+#endif /* CONFIG_NET_IPV4_FRAGMENT */
+
 static inline uint8_t net_pkt_priority(struct net_pkt *pkt)
 {
 	return pkt->priority;
@@ -858,6 +949,77 @@ static inline void net_pkt_set_txtime(struct net_pkt *pkt, uint64_t txtime)
 }
 #endif /* CONFIG_NET_PKT_TXTIME */
 
+#if defined(CONFIG_NET_TCP_TSO)
+static inline uint16_t net_pkt_tso_mss(struct net_pkt *pkt)
+{
+	return pkt->tso_mss;
+}
+
+static inline void net_pkt_set_tso_mss(struct net_pkt *pkt, uint16_t mss)
+{
+	pkt->tso_mss = mss;
+}
+#else
+static inline uint16_t net_pkt_tso_mss(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_tso_mss(struct net_pkt *pkt, uint16_t mss)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(mss);
+}
+#endif /* CONFIG_NET_TCP_TSO */
+
+#if defined(CONFIG_NET_RX_FLOW_STEERING)
+static inline uint32_t net_pkt_rx_hash(struct net_pkt *pkt)
+{
+	return pkt->rx_hash;
+}
+
+static inline void net_pkt_set_rx_hash(struct net_pkt *pkt, uint32_t hash)
+{
+	pkt->rx_hash = hash;
+}
+#else
+static inline uint32_t net_pkt_rx_hash(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_rx_hash(struct net_pkt *pkt, uint32_t hash)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(hash);
+}
+#endif /* CONFIG_NET_RX_FLOW_STEERING */
+
+#if defined(CONFIG_NET_PKT_RX_LATENCY)
+/**
+ * @brief Mark the end of a stage of the RX path for a packet
+ *
+ * The time spent in the stage goes to its latency histogram. Stages that
+ * are marked again, or after a later stage, are ignored.
+ *
+ * @param pkt Network packet
+ * @param stage Stage that ends
+ */
+void net_pkt_rx_stage_mark(struct net_pkt *pkt,
+			   enum net_stats_rx_stage stage);
+#else
+static inline void net_pkt_rx_stage_mark(struct net_pkt *pkt,
+					 enum net_stats_rx_stage stage)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(stage);
+}
+#endif /* CONFIG_NET_PKT_RX_LATENCY */
+
 #if defined(CONFIG_NET_PKT_TXTIME_STATS_DETAIL) || \
 	defined(CONFIG_NET_PKT_RXTIME_STATS_DETAIL)
 static inline uint32_t *net_pkt_stats_tick(struct net_pkt *pkt)
@@ -1446,6 +1608,37 @@ void net_pkt_get_info(struct k_mem_slab **rx,
 		      struct net_buf_pool **rx_data,
 		      struct net_buf_pool **tx_data);
 
+/**
+ * @brief Data buffer allocation statistics of the RX or TX packets.
+ */
+struct net_pkt_buf_stats {
+	/** Number of successful data allocations */
+	uint32_t allocs;
+	/** Number of buffers the allocations were made of */
+	uint32_t bufs;
+	/** Number of allocations made of more than one buffer */
+	uint32_t split;
+	/** Number of failed allocations */
+	uint32_t failed;
+	/** Number of bytes requested */
+	uint64_t requested;
+	/** Number of bytes of buffer data taken by the allocations */
+	uint64_t allocated;
+};
+
+/**
+ * @brief Get the data buffer allocation statistics of the RX and TX
+ * packets.
+ *
+ * @details Requires CONFIG_NET_PKT_BUF_STATS. The packets allocated from
+ * the context TX pools are counted as TX packets.
+ *
+ * @param rx Statistics of the RX packets are returned, if not NULL.
+ * @param tx Statistics of the TX packets are returned, if not NULL.
+ */
+void net_pkt_get_buf_stats(struct net_pkt_buf_stats *rx,
+			   struct net_pkt_buf_stats *tx);
+
 /** @cond INTERNAL_HIDDEN */
 
 #if defined(CONFIG_NET_DEBUG_NET_PKT_ALLOC)
@@ -235,6 +235,45 @@ struct net_stats_rx_time {
 	net_stats_t count;
 };
 
+/**
+ * @brief Stages of the RX path whose latency is collected
+ *
+ * The time of each stage goes from the end of the previous stage, or from
+ * the allocation of the packet for the first one.
+ */
+enum net_stats_rx_stage {
+	/** Until the driver passes the packet to net_recv_data() */
+	NET_STATS_RX_STAGE_DRIVER,
+	/** Waiting in the RX traffic class queue */
+	NET_STATS_RX_STAGE_TC,
+	/** L2 processing */
+	NET_STATS_RX_STAGE_L2,
+	/** IPv4 or IPv6 processing */
+	NET_STATS_RX_STAGE_IP,
+	/** Transport processing, until the packet is queued to the socket */
+	NET_STATS_RX_STAGE_TRANSPORT,
+	/** Waiting in the socket queue until the application reads it */
+	NET_STATS_RX_STAGE_SOCKET,
+
+	/** @cond INTERNAL_HIDDEN */
+	NET_STATS_RX_STAGE_COUNT
+	/** @endcond */
+};
+
+/** Number of buckets of the RX latency histograms. Bucket 0 counts the
+ * times below 1 us, bucket i the times from 2^(i - 1) to 2^i - 1 us and
+ * the last bucket everything longer.
+ */
+#define NET_STATS_RX_LATENCY_BUCKETS 14
+
+/**
+ * @brief RX latency histogram of one stage
+ */
+struct net_stats_rx_latency {
+	/** Number of packets per time range */
+	net_stats_t hist[NET_STATS_RX_LATENCY_BUCKETS];
+};
+
 #if NET_TC_TX_COUNT == 0
 #define NET_TC_TX_STATS_COUNT 1
 #else
@@ -369,8 +408,34 @@ struct net_stats {
 #if defined(CONFIG_NET_STATISTICS_POWER_MANAGEMENT)
 	struct net_stats_pm pm;
 #endif
+
+#if defined(CONFIG_NET_PKT_RX_LATENCY)
+	/** Latency histograms of the RX path stages */
+	struct net_stats_rx_latency rx_latency[NET_STATS_RX_STAGE_COUNT];
+#endif
 };
 
+/** @cond INTERNAL_HIDDEN */
+
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+/* The copies of the statistics of the CPUs are kept in separate cache
+ * lines.
+ */
+#define NET_STATS_CPU_ALIGN 64
+
+#if defined(CONFIG_SMP)
+#define NET_STATS_CPU_ID() (arch_curr_cpu()->id)
+#else
+#define NET_STATS_CPU_ID() 0
+#endif
+
+struct net_stats_cpu {
+	struct net_stats stats;
+} __aligned(NET_STATS_CPU_ALIGN);
+#endif /* CONFIG_NET_STATISTICS_PER_CPU */
+
+/** @endcond */
+
 /**
  * @brief Ethernet error statistics
  */
@@ -458,6 +523,21 @@ struct net_stats_eth {
 #endif
 };
 
+/** @cond INTERNAL_HIDDEN */
+
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+/* The counters of struct net_stats_eth updated by the Ethernet L2 */
+struct net_stats_eth_cpu {
+	struct net_stats_bytes bytes;
+	struct net_stats_pkts pkts;
+	struct net_stats_pkts broadcast;
+	struct net_stats_pkts multicast;
+	struct net_stats_pkts errors;
+} __aligned(NET_STATS_CPU_ALIGN);
+#endif /* CONFIG_NET_STATISTICS_PER_CPU */
+
+/** @endcond */
+
 /**
  * @brief All PPP specific statistics
  */
@@ -472,6 +552,16 @@ struct net_stats_ppp {
 	net_stats_t chkerr;
 };
 
+/** @cond INTERNAL_HIDDEN */
+
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+struct net_stats_ppp_cpu {
+	struct net_stats_ppp stats;
+} __aligned(NET_STATS_CPU_ALIGN);
+#endif /* CONFIG_NET_STATISTICS_PER_CPU */
+
+/** @endcond */
+
 #if defined(CONFIG_NET_STATISTICS_USER_API)
 /* Management part definitions */
 
@@ -493,7 +583,8 @@ enum net_request_stats_cmd {
 	NET_REQUEST_STATS_CMD_GET_TCP,
 	NET_REQUEST_STATS_CMD_GET_ETHERNET,
 	NET_REQUEST_STATS_CMD_GET_PPP,
-	NET_REQUEST_STATS_CMD_GET_PM
+	NET_REQUEST_STATS_CMD_GET_PM,
+	NET_REQUEST_STATS_CMD_GET_RX_LATENCY
 };
 
 #define NET_REQUEST_STATS_GET_ALL				\
@@ -581,6 +672,13 @@ NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_STATS_GET_PPP);
 NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_STATS_GET_PM);
 #endif /* CONFIG_NET_STATISTICS_POWER_MANAGEMENT */
 
+#if defined(CONFIG_NET_PKT_RX_LATENCY)
+#define NET_REQUEST_STATS_GET_RX_LATENCY			\
+	(_NET_STATS_BASE | NET_REQUEST_STATS_CMD_GET_RX_LATENCY)
+
+NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_STATS_GET_RX_LATENCY);
+#endif /* CONFIG_NET_PKT_RX_LATENCY */
+
 /**
  * @}
  */
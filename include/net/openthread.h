@@ -31,13 +31,6 @@ extern "C" {
 /**
  * @cond INTERNAL_HIDDEN
  */
-/**
- * @brief Type of pkt_list
- */
-struct pkt_list_elem {
-	struct net_pkt *pkt;
-};
-
 /**
  * @brief OpenThread l2 private data.
  */
@@ -48,18 +41,6 @@ struct openthread_context {
 	/** Pointer to OpenThread network interface */
 	struct net_if *iface;
 
-	/** Index indicates the head of pkt_list ring buffer */
-	uint16_t pkt_list_in_idx;
-
-	/** Index indicates the tail of pkt_list ring buffer */
-	uint16_t pkt_list_out_idx;
-
-	/** Flag indicates that pkt_list is full */
-	uint8_t pkt_list_full;
-
-	/** Array for storing net_pkt for OpenThread internal usage */
-	struct pkt_list_elem pkt_list[CONFIG_OPENTHREAD_PKT_LIST_SIZE];
-
 	/** A mutex to protect API calls from being preempted. */
 	struct k_mutex api_lock;
 
@@ -520,6 +520,14 @@ struct ppp_context {
 
 	/** PAP open status (open / closed) */
 	uint16_t is_pap_open : 1;
+
+#if defined(CONFIG_NET_STATISTICS_PPP) && \
+	defined(CONFIG_NET_STATISTICS_PER_CPU)
+	/** Per CPU counters of the L2, added to the driver statistics
+	 * when these are read.
+	 */
+	struct net_stats_ppp_cpu stats_cpu[CONFIG_MP_NUM_CPUS];
+#endif
 };
 
 /**
@@ -61,8 +61,14 @@ struct zsock_pollfd {
 #define ZSOCK_MSG_TRUNC 0x20
 /** zsock_recv/zsock_send: Override operation to non-blocking */
 #define ZSOCK_MSG_DONTWAIT 0x40
+/** zsock_recvmsg: ancillary data was discarded for lack of space
+ *  (output value only)
+ */
+#define ZSOCK_MSG_CTRUNC 0x08
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_recvmmsg: Operate non-blocking once a datagram was received */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 
 /* Well-known values, e.g. from Linux man 2 shutdown:
  * "The constants SHUT_RD, SHUT_WR, SHUT_RDWR have the value 0, 1, 2,
@@ -138,6 +144,18 @@ struct zsock_pollfd {
  */
 #define TLS_DTLS_HANDSHAKE_TIMEOUT_MIN 8
 #define TLS_DTLS_HANDSHAKE_TIMEOUT_MAX 9
+/** Socket option to enable session caching. For a client socket, the
+ *  session established with a server is stored, and resumed when
+ *  connecting to the same host and port again. For a server socket, the
+ *  sessions of the clients are cached, and session tickets issued to
+ *  them if supported. It accepts and returns an integer, with values
+ *  TLS_SESSION_CACHE_DISABLED (default) and TLS_SESSION_CACHE_ENABLED.
+ */
+#define TLS_SESSION_CACHE 10
+/** Write-only socket option to purge the sessions stored by clients.
+ *  The option value is ignored.
+ */
+#define TLS_SESSION_CACHE_PURGE 11
 
 /** @} */
 
@@ -150,6 +168,10 @@ struct zsock_pollfd {
 #define TLS_DTLS_ROLE_CLIENT 0 /**< Client role in a DTLS session. */
 #define TLS_DTLS_ROLE_SERVER 1 /**< Server role in a DTLS session. */
 
+/* Valid values for TLS_SESSION_CACHE option */
+#define TLS_SESSION_CACHE_DISABLED 0 /**< Disable TLS session caching. */
+#define TLS_SESSION_CACHE_ENABLED 1 /**< Enable TLS session caching. */
+
 struct zsock_addrinfo {
 	struct zsock_addrinfo *ai_next;
 	int ai_flags;
@@ -235,6 +257,77 @@ __syscall int zsock_socket(int family, int type, int proto);
  */
 __syscall int zsock_socketpair(int family, int type, int proto, int *sv);
 
+/**
+ * @brief Claim received data of a socketpair endpoint in place
+ *
+ * @details
+ * Zero-copy alternative to zsock_recv(): @p data is set to the next bytes
+ * of the receive queue of @p sock, to be processed in place and released
+ * with zsock_socketpair_recv_finish(). The data may wrap around the end of
+ * the queue, the claim then stops there. The endpoint is locked until the
+ * claim is finished.
+ *
+ * The call does not wait for data, poll() can be used for that.
+ * It is only available to supervisor threads.
+ *
+ * @param sock Socketpair endpoint.
+ *
+ * @param data Set to the claimed data.
+ *
+ * @param max_len Maximum number of bytes to claim.
+ *
+ * @return Number of bytes claimed, 0 at end-of-file, or -1 with errno set
+ * (EAGAIN when no data was received).
+ */
+ssize_t zsock_socketpair_recv_claim(int sock, void **data, size_t max_len);
+
+/**
+ * @brief Release data claimed with zsock_socketpair_recv_claim()
+ *
+ * @param sock Socketpair endpoint.
+ *
+ * @param len Number of bytes consumed, at most the number claimed. The
+ * others remain in the queue.
+ *
+ * @return 0 on success, or -1 with errno set.
+ */
+int zsock_socketpair_recv_finish(int sock, size_t len);
+
+/**
+ * @brief Claim space to send data to the other socketpair endpoint in place
+ *
+ * @details
+ * Zero-copy alternative to zsock_send(): @p data is set to free space in
+ * the receive queue of the other endpoint, to be filled in place and sent
+ * with zsock_socketpair_send_commit(). Both endpoints are locked until the
+ * claim is committed.
+ *
+ * The call does not wait for space, poll() can be used for that.
+ * It is only available to supervisor threads.
+ *
+ * @param sock Socketpair endpoint.
+ *
+ * @param data Set to the claimed space.
+ *
+ * @param max_len Maximum number of bytes to claim.
+ *
+ * @return Number of bytes claimed, or -1 with errno set (EAGAIN when the
+ * queue is full, EPIPE when the other endpoint is closed).
+ */
+ssize_t zsock_socketpair_send_claim(int sock, void **data, size_t max_len);
+
+/**
+ * @brief Send data written to space claimed with
+ * zsock_socketpair_send_claim()
+ *
+ * @param sock Socketpair endpoint.
+ *
+ * @param len Number of bytes written, at most the number claimed.
+ *
+ * @return 0 on success, or -1 with errno set.
+ */
+int zsock_socketpair_send_commit(int sock, size_t len);
+
 /**
  * @brief Close a network socket
  *
@@ -404,6 +497,145 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+/**
+ * @brief Receive a message from an arbitrary network address
+ *
+ * @details
+ * @rst
+ * See `POSIX.1-2017 article
+ * <http://pubs.opengroup.org/onlinepubs/9699919799/functions/recvmsg.html>`__
+ * for normative description.
+ * Ancillary data is returned for the packet info and timestamp socket
+ * options (IP_PKTINFO, IPV6_RECVPKTINFO and SO_TIMESTAMPNS) enabled on the
+ * socket. Sockets which only implement ``recvfrom()`` support a single
+ * buffer and never return ancillary data.
+ * This function is also exposed as ``recvmsg()``
+ * if :kconfig:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ */
+__syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
+
+/**
+ * @brief Send multiple messages on a socket
+ *
+ * @details
+ * @rst
+ * Like calling ``zsock_sendmsg()`` for each of the ``vlen`` messages of
+ * ``msgvec`` in turn, but with one system call and socket lookup. The
+ * number of bytes sent is stored in the ``msg_len`` field of each message.
+ * Sending stops at the first error, which is only reported if no message
+ * was sent, as with Linux ``sendmmsg()``.
+ * This function is also exposed as ``sendmmsg()``
+ * if :kconfig:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @return Number of messages sent, or -1 with errno set.
+ */
+__syscall int zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/**
+ * @brief Receive multiple messages from a socket
+ *
+ * @details
+ * @rst
+ * Like calling ``zsock_recvmsg()`` for each of the ``vlen`` messages of
+ * ``msgvec`` in turn, but with one system call and socket lookup. The
+ * number of bytes received is stored in the ``msg_len`` field of each
+ * message. With ZSOCK_MSG_WAITFORONE, only the first message is waited for.
+ * Receiving stops at the first error, which is only reported if no message
+ * was received. Unlike Linux ``recvmmsg()``, there is no timeout argument,
+ * the receive timeout of the socket applies to each message instead.
+ * This function is also exposed as ``recvmmsg()``
+ * if :kconfig:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @return Number of messages received, or -1 with errno set.
+ */
+__syscall int zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+struct net_buf;
+
+/**
+ * @brief Receive data without copying it
+ *
+ * @details
+ * Like zsock_recvfrom(), but instead of copying the data to a caller
+ * buffer, the network buffer fragments holding it are handed over to
+ * the caller, who must release them with net_buf_unref() when done.
+ * The fragments may be shared with other packets and must not be
+ * written to. A call returns one datagram, or for a stream socket the
+ * data of one received segment, so the length is only bounded by the
+ * size of those. ZSOCK_MSG_PEEK is not supported.
+ *
+ * As the fragments are kernel objects, this is only available to
+ * supervisor threads, and only for native IP sockets.
+ *
+ * @param sock Socket to receive from
+ * @param frags Set to the fragment chain holding the data, NULL if
+ *        there is none
+ * @param flags ZSOCK_MSG_DONTWAIT or 0
+ * @param src_addr Source address of the datagram, or NULL
+ * @param addrlen Value-result length of src_addr, or NULL
+ *
+ * @return Number of bytes received, 0 at the end of a stream, or -1
+ *         with errno set.
+ */
+ssize_t zsock_recvfrom_buf(int sock, struct net_buf **frags, int flags,
+			   struct sockaddr *src_addr, socklen_t *addrlen);
+
+/**
+ * @brief Receive data from a connected peer without copying it
+ *
+ * @details
+ * See zsock_recvfrom_buf().
+ */
+static inline ssize_t zsock_recv_buf(int sock, struct net_buf **frags,
+				     int flags)
+{
+	return zsock_recvfrom_buf(sock, frags, flags, NULL, NULL);
+}
+
+/**
+ * @brief Send data without copying it
+ *
+ * @details
+ * Like zsock_sendto(), but the data is sent from the given network
+ * buffer fragments, which may refer to memory of the caller, see
+ * net_buf_alloc_with_data(). On success, the socket takes over the
+ * reference to the whole chain and releases it once the data has been
+ * sent, or acknowledged by the peer for a stream socket. The destroy
+ * callback of the buffer pool then tells when the memory can be reused,
+ * until which it must not be modified. On error, the caller keeps the
+ * reference. All of the data is queued, or none of it.
+ *
+ * This is only available to supervisor threads, and only for native
+ * UDP and TCP sockets.
+ *
+ * @param sock Socket to send to
+ * @param frags Fragment chain holding the data
+ * @param flags ZSOCK_MSG_DONTWAIT or 0
+ * @param dest_addr Destination address, or NULL for a connected socket
+ * @param addrlen Length of dest_addr
+ *
+ * @return Number of bytes sent, or -1 with errno set.
+ */
+ssize_t zsock_sendto_buf(int sock, struct net_buf *frags, int flags,
+			 const struct sockaddr *dest_addr, socklen_t addrlen);
+
+/**
+ * @brief Send data to a connected peer without copying it
+ *
+ * @details
+ * See zsock_sendto_buf().
+ */
+static inline ssize_t zsock_send_buf(int sock, struct net_buf *frags,
+				     int flags)
+{
+	return zsock_sendto_buf(sock, frags, flags, NULL, 0);
+}
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -724,6 +956,23 @@ static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 	return zsock_recvfrom(sock, buf, max_len, flags, src_addr, addrlen);
 }
 
+static inline ssize_t recvmsg(int sock, struct msghdr *msg, int flags)
+{
+	return zsock_recvmsg(sock, msg, flags);
+}
+
+static inline int sendmmsg(int sock, struct mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
+static inline int recvmmsg(int sock, struct mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
 	return zsock_poll(fds, nfds, timeout);
@@ -799,7 +1048,9 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 #define MSG_PEEK ZSOCK_MSG_PEEK
 #define MSG_TRUNC ZSOCK_MSG_TRUNC
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
+#define MSG_CTRUNC ZSOCK_MSG_CTRUNC
 #define MSG_WAITALL ZSOCK_MSG_WAITALL
+#define MSG_WAITFORONE ZSOCK_MSG_WAITFORONE
 
 #define SHUT_RD ZSOCK_SHUT_RD
 #define SHUT_WR ZSOCK_SHUT_WR
@@ -846,6 +1097,11 @@ struct ifreq {
 /** sockopt: Bind a socket to an interface */
 #define SO_BINDTODEVICE	25
 
+/** sockopt: Timestamp RX packets, see SCM_TIMESTAMPNS */
+#define SO_TIMESTAMPNS 35
+/** Ancillary data: RX timestamp of the packet, as a struct net_ptp_time */
+#define SCM_TIMESTAMPNS SO_TIMESTAMPNS
+
 /** sockopt: Timestamp TX packets */
 #define SO_TIMESTAMPING 37
 /** sockopt: Protocol used with the socket */
@@ -854,10 +1110,20 @@ struct ifreq {
 /* Socket options for IPPROTO_TCP level */
 /** sockopt: Disable TCP buffering (ignored, for compatibility) */
 #define TCP_NODELAY 1
+/** sockopt: Name of the congestion control algorithm, as with Linux */
+#define TCP_CONGESTION 13
+
+/* Socket options for IPPROTO_IP level */
+/** sockopt: Return a struct in_pktinfo with each datagram received */
+#define IP_PKTINFO 8
 
 /* Socket options for IPPROTO_IPV6 level */
 /** sockopt: Don't support IPv4 access (ignored, for compatibility) */
 #define IPV6_V6ONLY 26
+/** sockopt: Return a struct in6_pktinfo with each datagram received */
+#define IPV6_RECVPKTINFO 49
+/** Ancillary data: destination address and interface of a datagram */
+#define IPV6_PKTINFO 50
 
 /** sockopt: Socket priority */
 #define SO_PRIORITY 12
@@ -870,6 +1136,87 @@ struct ifreq {
 /** sockopt: Enable SOCKS5 for Socket */
 #define SO_SOCKS5 60
 
+/** sockopt: Packet socket level option */
+#define SOL_PACKET 263
+
+/* Socket options for SOL_PACKET level */
+/** sockopt: Set up the RX frame ring, see struct tpacket_req */
+#define PACKET_RX_RING 5
+/** sockopt: Packet and drop counters of the RX ring, see struct tpacket_stats */
+#define PACKET_STATISTICS 6
+/** sockopt: Set up the TX frame ring, see struct tpacket_req */
+#define PACKET_TX_RING 13
+
+/* Status of a frame in the RX ring */
+/** The frame belongs to the stack */
+#define TP_STATUS_KERNEL 0
+/** The frame holds a packet for the application */
+#define TP_STATUS_USER BIT(0)
+/** Packets were dropped since the previous frame, the ring was full */
+#define TP_STATUS_LOSING BIT(2)
+
+/* Status of a frame in the TX ring */
+/** The frame belongs to the application */
+#define TP_STATUS_AVAILABLE 0
+/** The frame holds a packet to be sent by the next send() call */
+#define TP_STATUS_SEND_REQUEST BIT(0)
+/** The frame is being sent */
+#define TP_STATUS_SENDING BIT(1)
+/** The packet was not sent, it does not fit in the frame */
+#define TP_STATUS_WRONG_FORMAT BIT(2)
+
+/**
+ * @brief Header at the start of each frame of a packet socket ring.
+ *
+ * In the RX ring, the header is followed by a struct sockaddr_ll
+ * describing the source of the packet, and the packet itself is at
+ * tp_mac bytes from the start of the frame. In the TX ring, the packet
+ * to send is at TPACKET_HDRLEN - sizeof(struct sockaddr_ll) bytes, and
+ * only tp_len needs to be set.
+ *
+ * The owner of a frame is given by tp_status, which must be read and
+ * written atomically, with acquire and release semantics.
+ */
+struct tpacket_hdr {
+	uint32_t tp_status;  /**< TP_STATUS_* flags */
+	uint32_t tp_len;     /**< Length of the packet */
+	uint32_t tp_snaplen; /**< Length of the packet stored in the frame */
+	uint16_t tp_mac;     /**< Offset of the packet in the frame */
+	uint16_t tp_reserved;
+	uint32_t tp_sec;     /**< Uptime when the packet was received, s */
+	uint32_t tp_usec;    /**< and us */
+};
+
+/** Alignment of the frames and of the data in frames */
+#define TPACKET_ALIGNMENT 16
+/** Align the given size to TPACKET_ALIGNMENT */
+#define TPACKET_ALIGN(x) ROUND_UP(x, TPACKET_ALIGNMENT)
+/** Length of the frame headers in the RX ring */
+#define TPACKET_HDRLEN (TPACKET_ALIGN(sizeof(struct tpacket_hdr)) + \
+			sizeof(struct sockaddr_ll))
+
+/**
+ * @brief Frame ring set up with PACKET_RX_RING or PACKET_TX_RING.
+ *
+ * As there is no mmap() to get the ring from the stack, the application
+ * provides its memory, which must stay valid until the ring is released
+ * or the socket closed. The ring is released by setting the option with
+ * tp_frame_nr at 0.
+ */
+struct tpacket_req {
+	void *tp_ring;              /**< tp_frame_size * tp_frame_nr bytes,
+				     *   aligned to TPACKET_ALIGNMENT
+				     */
+	unsigned int tp_frame_size; /**< A multiple of TPACKET_ALIGNMENT */
+	unsigned int tp_frame_nr;   /**< Number of frames in the ring */
+};
+
+/** Value of the PACKET_STATISTICS option, reset when read */
+struct tpacket_stats {
+	unsigned int tp_packets; /**< Packets received, with the drops */
+	unsigned int tp_drops;   /**< Packets dropped, the ring was full */
+};
+
 /** @cond INTERNAL_HIDDEN */
 /**
  * @brief Registration information for a given BSD socket family.
@@ -151,6 +151,33 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 		       enum websocket_opcode opcode, bool mask, bool final,
 		       int32_t timeout);
 
+/** Maximum number of buffers given to websocket_send_msg_iov() */
+#define WEBSOCKET_MAX_IOV 8
+
+/**
+ * @brief Send websocket msg to peer, with the payload gathered from several
+ * buffers.
+ *
+ * @details The function will automatically add websocket header to the
+ * message. The buffers are sent as they are if the message is not masked,
+ * without being copied in a single buffer first.
+ *
+ * @param ws_sock Websocket id returned by websocket_connect().
+ * @param iov Buffers holding the data to send.
+ * @param iovcnt Number of buffers, at most WEBSOCKET_MAX_IOV.
+ * @param opcode Operation code (text, binary, ping, pong, close)
+ * @param mask Mask the data, see RFC 6455 for details
+ * @param final Is this final message for this message send, see
+ *        websocket_send_msg().
+ * @param timeout How long to try to send the message. The value is in
+ *        milliseconds. Value SYS_FOREVER_MS means to wait forever.
+ *
+ * @return <0 if error, >=0 amount of bytes sent
+ */
+int websocket_send_msg_iov(int ws_sock, const struct iovec *iov,
+			   size_t iovcnt, enum websocket_opcode opcode,
+			   bool mask, bool final, int32_t timeout);
+
 /**
  * @brief Receive websocket msg from peer.
  *
@@ -90,6 +90,8 @@ struct pm_device {
 	enum pm_device_state state;
 	/** Work object for asynchronous calls */
 	struct k_work_delayable work;
+	/** Delay before an asynchronous suspend */
+	k_timeout_t autosuspend_delay;
 	/** Event conditional var to listen to the sync request events */
 	struct k_condvar condvar;
 };
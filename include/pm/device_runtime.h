@@ -103,6 +103,21 @@ int pm_device_get(const struct device *dev);
  */
 int pm_device_put_async(const struct device *dev);
 
+/**
+ * @brief Set the autosuspend delay of a device
+ *
+ * When @ref pm_device_put_async releases the last usage of the device, the
+ * device is only suspended after the delay, unless it is used again in the
+ * meantime. This saves the suspend and resume of devices released and used
+ * again shortly after. The default delay is K_NO_WAIT.
+ *
+ * @param dev Pointer to device structure of the specific device driver
+ * the caller is interested in.
+ * @param delay Delay before the device is suspended.
+ */
+void pm_device_autosuspend_delay_set(const struct device *dev,
+				     k_timeout_t delay);
+
 /**
  * @brief Call device suspend synchronously based on usage count
  *
@@ -134,6 +149,45 @@ int pm_device_put(const struct device *dev);
  */
 int pm_device_wait(const struct device *dev, k_timeout_t timeout);
 
+/**
+ * @brief Call the resume of several devices synchronously
+ *
+ * Same as @ref pm_device_get for every device, but the devices are
+ * resumed concurrently as far as their dependencies allow: a device is
+ * only resumed once the devices of the batch it requires, as listed in
+ * the devicetree, are active. A device whose required device failed to
+ * resume is not resumed.
+ *
+ * The devices are resumed concurrently with
+ * @kconfig{CONFIG_PM_DEVICE_RUNTIME_PARALLEL}, one after the other
+ * otherwise.
+ *
+ * @param devs Devices to resume.
+ * @param count Number of devices, up to
+ * @kconfig{CONFIG_PM_DEVICE_RUNTIME_BATCH_MAX}.
+ * @retval 0 If successful.
+ * @retval -EINVAL If there are too many devices.
+ * @retval Errno Negative errno code of the first device that failed. The
+ * devices already resumed are then suspended back.
+ */
+int pm_device_get_many(const struct device *const *devs, size_t count);
+
+/**
+ * @brief Call the suspend of several devices synchronously
+ *
+ * Same as @ref pm_device_put for every device, but the devices are
+ * suspended concurrently as far as their dependencies allow: a device is
+ * only suspended once the devices of the batch requiring it are suspended.
+ *
+ * @param devs Devices to suspend.
+ * @param count Number of devices, up to
+ * @kconfig{CONFIG_PM_DEVICE_RUNTIME_BATCH_MAX}.
+ * @retval 0 If successful.
+ * @retval -EINVAL If there are too many devices.
+ * @retval Errno Negative errno code of the first device that failed.
+ */
+int pm_device_put_many(const struct device *const *devs, size_t count);
+
 #else
 static inline void pm_device_enable(const struct device *dev) { }
 static inline void pm_device_disable(const struct device *dev) { }
@@ -143,6 +197,12 @@ static inline int pm_device_put(const struct device *dev) { return -ENOSYS; }
 static inline int pm_device_put_async(const struct device *dev) { return -ENOSYS; }
 static inline int pm_device_wait(const struct device *dev,
 		k_timeout_t timeout) { return -ENOSYS; }
+static inline void pm_device_autosuspend_delay_set(const struct device *dev,
+		k_timeout_t delay) { }
+static inline int pm_device_get_many(const struct device *const *devs,
+		size_t count) { return -ENOSYS; }
+static inline int pm_device_put_many(const struct device *const *devs,
+		size_t count) { return -ENOSYS; }
 #endif
 
 /** @} */
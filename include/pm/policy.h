@@ -7,6 +7,8 @@
 #ifndef ZEPHYR_INCLUDE_PM_POLICY_H_
 #define ZEPHYR_INCLUDE_PM_POLICY_H_
 
+#include <stdint.h>
+#include <sys/slist.h>
 #include <pm/state.h>
 
 #ifdef __cplusplus
@@ -26,6 +28,56 @@ extern "C" {
  */
 struct pm_state_info pm_policy_next_state(int32_t ticks);
 
+/**
+ * @brief Latency requirement
+ *
+ * A device, or any other user, that must be served within a given time
+ * after an event registers a latency requirement: the policies do not
+ * select power states whose exit latency exceeds the strictest
+ * requirement.
+ *
+ * The fields are internal to the power subsystem.
+ */
+struct pm_policy_latency_request {
+	sys_snode_t node;
+	uint32_t value_us;
+};
+
+/**
+ * @brief Add a latency requirement.
+ *
+ * @param req Latency request, must remain valid until removed.
+ * @param value_us Maximum exit latency allowed, in microseconds.
+ */
+void pm_policy_latency_request_add(struct pm_policy_latency_request *req,
+				   uint32_t value_us);
+
+/**
+ * @brief Update a latency requirement.
+ *
+ * @param req Latency request, previously added.
+ * @param value_us New maximum exit latency allowed, in microseconds.
+ */
+void pm_policy_latency_request_update(struct pm_policy_latency_request *req,
+				      uint32_t value_us);
+
+/**
+ * @brief Remove a latency requirement.
+ *
+ * @param req Latency request, previously added.
+ */
+void pm_policy_latency_request_remove(struct pm_policy_latency_request *req);
+
+/**
+ * @brief Get the strictest latency requirement.
+ *
+ * To be used by the policies, including the application ones.
+ *
+ * @return Maximum exit latency allowed, in microseconds, UINT32_MAX if
+ *         there is no requirement.
+ */
+uint32_t pm_policy_latency_max_get(void);
+
 
 #ifdef __cplusplus
 }
@@ -19,6 +19,11 @@ extern "C" {
 
 typedef void *mqd_t;
 
+#ifndef MQ_PRIO_MAX
+/** Number of message priorities */
+#define MQ_PRIO_MAX 32
+#endif
+
 typedef struct mq_attr {
 	long mq_flags;
 	long mq_maxmsg;
@@ -82,9 +82,14 @@ typedef struct pthread_barrierattr {
 typedef uint32_t pthread_rwlockattr_t;
 
 typedef struct pthread_rwlock_obj {
-	struct k_sem rd_sem;
-	struct k_sem wr_sem;
-	struct k_sem reader_active;/* blocks WR till reader has acquired lock */
+	/* Number of readers, and writer and waiters flags */
+	atomic_t state;
+	_wait_q_t rd_wait_q;
+	_wait_q_t wr_wait_q;
+	struct k_spinlock lock;/* protects the waiters */
+	uint16_t rd_waiting;
+	uint16_t wr_waiting;
+	bool prefer_writer;
 	int32_t status;
 	k_tid_t wr_owner;
 } pthread_rwlock_t;
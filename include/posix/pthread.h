@@ -7,6 +7,7 @@
 #ifndef ZEPHYR_INCLUDE_POSIX_PTHREAD_H_
 #define ZEPHYR_INCLUDE_POSIX_PTHREAD_H_
 
+#include <errno.h>
 #include <kernel.h>
 #include <wait_q.h>
 #include <posix/time.h>
@@ -457,6 +458,11 @@ static inline int pthread_equal(pthread_t pt1, pthread_t pt2)
 	return (pt1 == pt2);
 }
 
+/* Read-write lock kinds, as in glibc */
+#define PTHREAD_RWLOCK_PREFER_READER_NP              0
+#define PTHREAD_RWLOCK_PREFER_WRITER_NP              1
+#define PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP 2
+
 /**
  * @brief Destroy the read-write lock attributes object.
  *
@@ -474,6 +480,44 @@ static inline int pthread_rwlockattr_destroy(pthread_rwlockattr_t *attr)
  */
 static inline int pthread_rwlockattr_init(pthread_rwlockattr_t *attr)
 {
+	*attr = PTHREAD_RWLOCK_PREFER_READER_NP;
+	return 0;
+}
+
+/**
+ * @brief Set the kind of the read-write lock.
+ *
+ * The readers are preferred by default: a reader gets the lock while
+ * other readers hold it, even if writers wait. With
+ * PTHREAD_RWLOCK_PREFER_WRITER_NP or
+ * PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP, the readers wait for the
+ * writers waiting before them, which may deadlock a thread taking a read
+ * lock it already holds.
+ *
+ * Non-portable, as in glibc.
+ */
+static inline int pthread_rwlockattr_setkind_np(pthread_rwlockattr_t *attr,
+						int pref)
+{
+	if (pref != PTHREAD_RWLOCK_PREFER_READER_NP &&
+	    pref != PTHREAD_RWLOCK_PREFER_WRITER_NP &&
+	    pref != PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP) {
+		return EINVAL;
+	}
+
+	*attr = pref;
+	return 0;
+}
+
+/**
+ * @brief Get the kind of the read-write lock.
+ *
+ * Non-portable, as in glibc.
+ */
+static inline int pthread_rwlockattr_getkind_np(
+	const pthread_rwlockattr_t *attr, int *pref)
+{
+	*pref = *attr;
 	return 0;
 }
 
@@ -557,6 +601,22 @@ int pthread_setname_np(pthread_t thread, const char *name);
  */
 int pthread_getname_np(pthread_t thread, char *name, size_t len);
 
+/**
+ * @brief Set the timer slack of POSIX thread.
+ *
+ * Non-portable, extension function. The sleeps and timed waits of the
+ * thread, and the timers it creates afterwards, may expire up to
+ * @a slack later than requested, so that their expiries share a wake-up
+ * of the system. Ignored unless @kconfig{CONFIG_TIMEOUT_SLACK} is enabled.
+ *
+ * @param thread POSIX thread to set the timer slack of
+ * @param slack Allowed delay
+ * @retval 0 Success
+ * @retval ESRCH Thread does not exist
+ * @retval EINVAL Invalid slack
+ */
+int pthread_settimerslack_np(pthread_t thread, const struct timespec *slack);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Entropy pool header file
+ */
+
+#ifndef ZEPHYR_INCLUDE_RANDOM_ENTROPY_POOL_H_
+#define ZEPHYR_INCLUDE_RANDOM_ENTROPY_POOL_H_
+
+#include <zephyr/types.h>
+#include <stddef.h>
+
+/**
+ * @brief Entropy pool
+ * @defgroup entropy_pool Entropy pool
+ * @ingroup random_api
+ *
+ * A reservoir of bytes read from the entropy device, refilled in batches
+ * by a background thread whenever it falls below a threshold. Reading it
+ * never waits for the hardware, so that the random number generators
+ * seeded from it do not stall when several users want entropy at once.
+ *
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Take bytes from the entropy pool.
+ *
+ * The bytes are taken only if the pool holds enough of them. Never blocks,
+ * may be called from an ISR.
+ *
+ * @param dst Buffer receiving the bytes.
+ * @param len Number of bytes.
+ *
+ * @retval 0 on success.
+ * @retval -EAGAIN if the pool holds fewer than @p len bytes, nothing was
+ *		   taken.
+ */
+int entropy_pool_get(uint8_t *dst, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_RANDOM_ENTROPY_POOL_H_ */
@@ -56,6 +56,15 @@ extern "C" {
  */
 typedef ssize_t (*settings_read_cb)(void *cb_arg, void *data, size_t len);
 
+/**
+ * Flag of the handlers whose values are not needed at boot.
+ *
+ * Their values are not loaded by @ref settings_load, but by
+ * @ref settings_load_deferred, or on first access by loading their subtree
+ * with @ref settings_load_subtree.
+ */
+#define SETTINGS_HANDLER_DEFERRED BIT(0)
+
 /**
  * @struct settings_handler
  * Config handlers for subtree implement a set of handler functions.
@@ -118,6 +127,9 @@ struct settings_handler {
 	 * Return: 0 on success, non-zero on failure.
 	 */
 
+	uint8_t flags;
+	/**< Loading flags, see @ref SETTINGS_HANDLER_DEFERRED. */
+
 	sys_snode_t node;
 	/**< Linked list node info for module internal usage. */
 };
@@ -181,6 +193,9 @@ struct settings_handler_static {
 	 *
 	 * Return: 0 on success, non-zero on failure.
 	 */
+
+	uint8_t flags;
+	/**< Loading flags, see @ref SETTINGS_HANDLER_DEFERRED. */
 };
 
 /**
@@ -199,6 +214,22 @@ struct settings_handler_static {
 
 #define SETTINGS_STATIC_HANDLER_DEFINE(_hname, _tree, _get, _set, _commit,   \
 				       _export)				     \
+	Z_SETTINGS_STATIC_HANDLER_DEFINE(_hname, _tree, _get, _set, _commit, \
+					 _export, 0)
+
+/**
+ * Define a static handler for settings items not needed at boot
+ *
+ * As SETTINGS_STATIC_HANDLER_DEFINE(), with the handler flagged with
+ * @ref SETTINGS_HANDLER_DEFERRED.
+ */
+#define SETTINGS_STATIC_HANDLER_DEFINE_DEFERRED(_hname, _tree, _get, _set,   \
+						_commit, _export)	     \
+	Z_SETTINGS_STATIC_HANDLER_DEFINE(_hname, _tree, _get, _set, _commit, \
+					 _export, SETTINGS_HANDLER_DEFERRED)
+
+#define Z_SETTINGS_STATIC_HANDLER_DEFINE(_hname, _tree, _get, _set, _commit, \
+					 _export, _flags)		     \
 	const Z_STRUCT_SECTION_ITERABLE(settings_handler_static,	     \
 					settings_handler_ ## _hname) = {     \
 		.name = _tree,						     \
@@ -206,6 +237,7 @@ struct settings_handler_static {
 		.h_set = _set,						     \
 		.h_commit = _commit,					     \
 		.h_export = _export,					     \
+		.flags = _flags,					     \
 	}
 
 /**
@@ -233,10 +265,22 @@ int settings_register(struct settings_handler *cf);
  * serialized item subtrees registered earlier will be called for encountered
  * values.
  *
+ * The handlers flagged with @ref SETTINGS_HANDLER_DEFERRED are skipped.
+ * With CONFIG_SETTINGS_DEFERRED_LOAD_BACKGROUND, they are then loaded from
+ * the system work queue.
+ *
  * @return 0 on success, non-zero on failure.
  */
 int settings_load(void);
 
+/**
+ * Load the values of the handlers flagged with @ref SETTINGS_HANDLER_DEFERRED
+ * and commit them.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int settings_load_deferred(void);
+
 /**
  * Load limited set of serialized items from registered persistence sources.
  * Handlers for serialized item subtrees registered earlier will be called for
@@ -321,6 +365,70 @@ int settings_save(void);
  */
 int settings_save_one(const char *name, const void *value, size_t val_len);
 
+/**
+ * Settings item of settings_save_batch().
+ */
+struct settings_batch_item {
+	const char *name;
+	/**< Name/key of the settings item. */
+
+	const void *value;
+	/**< Value of the settings item, NULL to delete it. */
+
+	size_t val_len;
+	/**< Length of the value. */
+};
+
+/**
+ * Write several serialized values to persisted storage at once.
+ *
+ * With a backend supporting it (NVS), either all the items are written or
+ * none of them is, and they are written with fewer flash operations than
+ * with settings_save_one(). Other backends write the items one by one, up
+ * to the first failure.
+ *
+ * @param items Items to write, in order. An item with a NULL value or a
+ * zero length is deleted.
+ * @param count Number of items.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int settings_save_batch(const struct settings_batch_item *items, size_t count);
+
+/**
+ * Write a single serialized value to persisted storage later.
+ *
+ * With CONFIG_SETTINGS_WRITEBACK, the value is kept in RAM and written
+ * CONFIG_SETTINGS_WRITEBACK_DELAY milliseconds after the oldest value not
+ * written yet, together with the other deferred values. Saving the same
+ * item again before that only replaces the value in RAM. The deferred
+ * values are also written by settings_flush(), settings_commit() and before
+ * loading the settings. A later settings_save_one() or settings_delete() of
+ * the item overrides its deferred value.
+ *
+ * Items with a longer name or value than the write-back cache takes, or
+ * without CONFIG_SETTINGS_WRITEBACK, are written at once as with
+ * settings_save_one().
+ *
+ * @param name Name/key of the settings item.
+ * @param value Pointer to the value of the settings item, NULL to delete
+ * the item. The value is copied.
+ * @param val_len Length of the value.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int settings_save_one_deferred(const char *name, const void *value,
+			       size_t val_len);
+
+/**
+ * Write all the values deferred by settings_save_one_deferred() to
+ * persisted storage, e.g. on a power failure notification.
+ *
+ * @return 0 on success, non-zero on failure. On failure the values are kept
+ * in RAM, to be written again later.
+ */
+int settings_flush(void);
+
 /**
  * Delete a single serialized in persisted storage.
  *
@@ -402,6 +510,14 @@ struct settings_load_arg {
 	 * Parameter to be passed to the callback function.
 	 */
 	void *param;
+	/**
+	 * @brief Load the deferred handlers
+	 *
+	 * When the whole tree is loaded with the registered functions, only
+	 * the handlers flagged with @ref SETTINGS_HANDLER_DEFERRED are called
+	 * if true, all the other ones otherwise.
+	 */
+	bool deferred;
 };
 
 /**
@@ -443,6 +559,18 @@ struct settings_store_itf {
 	 *  - val_len - Length of value in bytes.
 	 */
 
+	int (*csi_save_batch)(struct settings_store *cs,
+			      const struct settings_batch_item *items,
+			      size_t count);
+	/**< Save several key-value pairs to storage at once. Optional, the
+	 * pairs are saved with csi_save otherwise.
+	 *
+	 * Parameters:
+	 *  - cs - Corresponding backend handler node
+	 *  - items - Key-value pairs
+	 *  - count - Number of key-value pairs
+	 */
+
 	int (*csi_save_end)(struct settings_store *cs);
 	/**< Handler called after an export operation.
 	 *
@@ -592,6 +592,18 @@ struct shell_transport_api {
 	 */
 	void (*update)(const struct shell_transport *transport);
 
+	/**
+	 * @brief Function called when the shell output is idle.
+	 *
+	 * Called once a burst of output was written, e.g. when a command
+	 * returned. Optional, a transport which buffers the output to send
+	 * it in bigger chunks can send what it holds without waiting for
+	 * more data.
+	 *
+	 * @param[in] transport Pointer to the transfer instance.
+	 */
+	void (*flush)(const struct shell_transport *transport);
+
 };
 
 struct shell_transport {
@@ -766,7 +778,8 @@ extern void z_shell_print_stream(const void *user_ctx, const char *data,
 	Z_SHELL_HISTORY_DEFINE(_name##_history, CONFIG_SHELL_HISTORY_BUFFER); \
 	Z_SHELL_FPRINTF_DEFINE(_name##_fprintf, &_name, _name##_out_buffer,   \
 			     CONFIG_SHELL_PRINTF_BUFF_SIZE,		      \
-			     true, z_shell_print_stream);		      \
+			     IS_ENABLED(CONFIG_SHELL_PRINTF_AUTOFLUSH),	      \
+			     z_shell_print_stream);			      \
 	LOG_INSTANCE_REGISTER(shell, _name, CONFIG_SHELL_LOG_LEVEL);	      \
 	Z_SHELL_STATS_DEFINE(_name);					      \
 	static K_KERNEL_STACK_DEFINE(_name##_stack, CONFIG_SHELL_STACK_SIZE); \
@@ -21,6 +21,8 @@ typedef void (*shell_fprintf_fwrite)(const void *user_ctx,
 
 struct shell_fprintf_control_block {
 	size_t buffer_cnt;
+	/* Lines in the buffer, see CONFIG_SHELL_PRINTF_FLUSH_LINES. */
+	uint16_t line_cnt;
 	bool autoflush;
 };
 /**
@@ -41,7 +43,8 @@ struct shell_fprintf {
  * @param _user_ctx	Pointer to user data.
  * @param _buf		Pointer to output buffer
  * @param _size		Size of output buffer.
- * @param _autoflush	Indicator if buffer shall be automatically flush.
+ * @param _autoflush	Indicator if buffer shall be flushed after every
+ *			print.
  * @param _fwrite	Pointer to function sending data stream.
  */
 #define Z_SHELL_FPRINTF_DEFINE(_name, _user_ctx, _buf, _size,	\
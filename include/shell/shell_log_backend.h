@@ -68,12 +68,25 @@ int z_shell_log_backend_output_func(uint8_t *data, size_t length, void *ctx);
  *  @param _name Shell name.
  */
 #ifdef CONFIG_SHELL_LOG_BACKEND
+/* The print buffer is empty between prints only if every print is flushed,
+ * the log output needs a buffer of its own otherwise.
+ */
+#ifdef CONFIG_SHELL_PRINTF_AUTOFLUSH
+#define Z_SHELL_LOG_OUT_BUF_DEFINE(_name, _size)
+#define Z_SHELL_LOG_OUT_BUF(_name, _buf) _buf
+#else
+#define Z_SHELL_LOG_OUT_BUF_DEFINE(_name, _size) \
+	static uint8_t _name##_log_out_buf[_size]
+#define Z_SHELL_LOG_OUT_BUF(_name, _buf) _name##_log_out_buf
+#endif
+
 #define Z_SHELL_LOG_BACKEND_DEFINE(_name, _buf, _size, _queue_size, _timeout) \
 	LOG_BACKEND_DEFINE(_name##_backend, log_backend_shell_api, false); \
 	K_MSGQ_DEFINE(_name##_msgq, sizeof(struct shell_log_backend_msg), \
 			_queue_size, sizeof(void *)); \
+	Z_SHELL_LOG_OUT_BUF_DEFINE(_name, _size); \
 	LOG_OUTPUT_DEFINE(_name##_log_output, z_shell_log_backend_output_func,\
-			  _buf, _size); \
+			  Z_SHELL_LOG_OUT_BUF(_name, _buf), _size); \
 	static struct shell_log_backend_control_block _name##_control_block; \
 	static uint32_t __aligned(Z_LOG_MSG2_ALIGNMENT) _name##_buf[128]; \
 	const struct mpsc_pbuf_buffer_config _name##_mpsc_buffer_config = { \
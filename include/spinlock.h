@@ -28,8 +28,27 @@ struct z_spinlock_key {
  */
 struct k_spinlock {
 #ifdef CONFIG_SMP
+#ifdef CONFIG_SPIN_LOCK_TICKET
+	/* Next ticket to hand out, and the ticket now holding the lock */
+	atomic_t next;
+	atomic_t owner;
+#else
 	atomic_t locked;
 #endif
+#endif
+
+#ifdef CONFIG_SPIN_LOCK_STATS
+	/* Contention statistics, only written by the lock holder.  A
+	 * lock is added to the list walked by z_spin_stats_foreach()
+	 * the first time it is found contended, and must not be zeroed
+	 * or re-initialized after that.
+	 */
+	struct k_spinlock *stats_next;
+	bool stats_listed;
+	uint32_t contended;
+	uint32_t spins;
+	uint32_t max_spins;
+#endif
 
 #ifdef CONFIG_SPIN_VALIDATE
 	/* Stores the thread that holds the lock with the locking CPU
@@ -73,6 +92,19 @@ bool z_spin_lock_mem_coherent(struct k_spinlock *l);
 
 #endif /* CONFIG_SPIN_VALIDATE */
 
+#ifdef CONFIG_SPIN_LOCK_STATS
+void z_spin_lock_contended(struct k_spinlock *l, uint32_t spins);
+
+typedef void (*z_spin_stats_cb_t)(struct k_spinlock *l, void *user_data);
+
+/* Calls cb for each lock that has been contended so far, without
+ * holding it.  Locks in memory that is reused for something else
+ * (e.g. freed kernel objects) must not be contended while stats
+ * are enabled.
+ */
+void z_spin_stats_foreach(z_spin_stats_cb_t cb, void *user_data);
+#endif
+
 /**
  * @brief Spinlock key type
  *
@@ -133,9 +165,27 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 #endif
 
 #ifdef CONFIG_SMP
+#ifdef CONFIG_SPIN_LOCK_STATS
+	uint32_t spins = 0U;
+#endif
+#ifdef CONFIG_SPIN_LOCK_TICKET
+	/* CPUs get the lock in the order they asked for it */
+	atomic_val_t ticket = atomic_inc(&l->next);
+
+	while (atomic_get(&l->owner) != ticket) {
+#else
 	while (!atomic_cas(&l->locked, 0, 1)) {
+#endif
+#ifdef CONFIG_SPIN_LOCK_STATS
+		spins++;
+#endif
+	}
+#ifdef CONFIG_SPIN_LOCK_STATS
+	if (spins != 0U) {
+		z_spin_lock_contended(l, spins);
 	}
 #endif
+#endif /* CONFIG_SMP */
 
 #ifdef CONFIG_SPIN_VALIDATE
 	z_spin_lock_set_owner(l);
@@ -143,6 +193,30 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 	return k;
 }
 
+/* Internal function: hands the lock over to the next CPU, if any */
+static ALWAYS_INLINE void z_spin_lock_handoff(struct k_spinlock *l)
+{
+#ifdef CONFIG_SMP
+#ifdef CONFIG_SPIN_LOCK_TICKET
+	/* Only the holder writes owner, but the atomic op doubles as
+	 * the memory barrier releasing the protected data.
+	 */
+	(void)atomic_inc(&l->owner);
+#else
+	/* Strictly we don't need atomic_clear() here (which is an
+	 * exchange operation that returns the old value).  We are always
+	 * setting a zero and (because we hold the lock) know the existing
+	 * state won't change due to a race.  But some architectures need
+	 * a memory barrier when used like this, and we don't have a
+	 * Zephyr framework for that.
+	 */
+	atomic_clear(&l->locked);
+#endif
+#else
+	ARG_UNUSED(l);
+#endif
+}
+
 /**
  * @brief Unlock a spin lock
  *
@@ -172,16 +246,7 @@ static ALWAYS_INLINE void k_spin_unlock(struct k_spinlock *l,
 	__ASSERT(z_spin_unlock_valid(l), "Not my spinlock %p", l);
 #endif
 
-#ifdef CONFIG_SMP
-	/* Strictly we don't need atomic_clear() here (which is an
-	 * exchange operation that returns the old value).  We are always
-	 * setting a zero and (because we hold the lock) know the existing
-	 * state won't change due to a race.  But some architectures need
-	 * a memory barrier when used like this, and we don't have a
-	 * Zephyr framework for that.
-	 */
-	atomic_clear(&l->locked);
-#endif
+	z_spin_lock_handoff(l);
 	arch_irq_unlock(key.key);
 }
 
@@ -194,9 +259,7 @@ static ALWAYS_INLINE void k_spin_release(struct k_spinlock *l)
 #ifdef CONFIG_SPIN_VALIDATE
 	__ASSERT(z_spin_unlock_valid(l), "Not my spinlock %p", l);
 #endif
-#ifdef CONFIG_SMP
-	atomic_clear(&l->locked);
-#endif
+	z_spin_lock_handoff(l);
 }
 
 #ifdef __cplusplus
@@ -46,6 +46,12 @@
  *     s<stat-idx>
  *
  * E.g., "s0", "s1", etc.
+ *
+ * Histograms record the distribution of a value, e.g. a latency, instead of
+ * counting events.  Each histogram is registered as a statistics group whose
+ * entries summarize the recorded values (count, min, max, mean and
+ * percentiles), computed whenever the group is walked.  They can therefore be
+ * retrieved in the same way as the other statistics.
  */
 
 #ifndef ZEPHYR_INCLUDE_STATS_STATS_H_
@@ -53,6 +59,8 @@
 
 #include <stddef.h>
 #include <zephyr/types.h>
+#include <toolchain.h>
+#include <sys/util.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -67,7 +75,7 @@ struct stats_hdr {
 	const char *s_name;
 	uint8_t s_size;
 	uint16_t s_cnt;
-	uint8_t s_pad1;
+	uint8_t s_flags;
 #ifdef CONFIG_STATS_NAMES
 	const struct stats_name_map *s_map;
 	int s_map_cnt;
@@ -75,6 +83,9 @@ struct stats_hdr {
 	struct stats_hdr *s_next;
 };
 
+/** The statistics group is a histogram (@ref stats_histogram). */
+#define STATS_HDR_F_HISTOGRAM BIT(0)
+
 /**
  * @brief Declares a stat group struct.
  *
@@ -336,6 +347,176 @@ struct stats_hdr *stats_group_get_next(const struct stats_hdr *cur);
  */
 struct stats_hdr *stats_group_find(const char *name);
 
+/** Number of sub-buckets of each power of two range of a histogram. */
+#define STATS_HISTOGRAM_SUB_CNT BIT(CONFIG_STATS_HISTOGRAM_SUB_BUCKET_BITS)
+
+/**
+ * @brief Number of buckets of a histogram recording values of up to @p bits__
+ * bits.
+ *
+ * Values below @ref STATS_HISTOGRAM_SUB_CNT each have their own bucket, every
+ * power of two range above is split into @ref STATS_HISTOGRAM_SUB_CNT
+ * buckets of equal width.
+ */
+#define STATS_HISTOGRAM_BUCKETS(bits__) \
+	(((bits__) - CONFIG_STATS_HISTOGRAM_SUB_BUCKET_BITS + 1) * \
+	 STATS_HISTOGRAM_SUB_CNT)
+
+/**
+ * @brief Summary of a histogram, the entries of its statistics group.
+ *
+ * The percentiles are the highest value of the bucket holding them, which is
+ * at most 1 / @ref STATS_HISTOGRAM_SUB_CNT above the exact value.
+ */
+struct stats_histogram_summary {
+	uint32_t count;
+	uint32_t min;
+	uint32_t max;
+	uint32_t mean;
+	uint32_t p50;
+	uint32_t p90;
+	uint32_t p99;
+	uint32_t p999;
+};
+
+/**
+ * @brief Histogram statistics group.
+ *
+ * Define with STATS_HISTOGRAM_DEFINE(), the fields are internal.
+ */
+struct stats_histogram {
+	struct stats_hdr s_hdr;
+	struct stats_histogram_summary summary;
+	uint64_t sum;
+	uint32_t count;
+	uint32_t min;
+	uint32_t max;
+	uint16_t bucket_cnt;
+	uint32_t *buckets;
+};
+
+/**
+ * @brief Defines a histogram.
+ *
+ * Recording costs a constant time whatever the number of buckets.  Values
+ * above the range of the histogram are counted in its last bucket.
+ *
+ * @param name__                The name of the histogram variable.
+ * @param bits__                The number of bits of the recorded values,
+ *                                  up to 32.
+ */
+#define STATS_HISTOGRAM_DEFINE(name__, bits__)				  \
+	BUILD_ASSERT((bits__) > CONFIG_STATS_HISTOGRAM_SUB_BUCKET_BITS && \
+		     (bits__) <= 32);					  \
+	static uint32_t							  \
+	stats_histogram_buckets_##name__[STATS_HISTOGRAM_BUCKETS(bits__)]; \
+	struct stats_histogram name__ = {				  \
+		.bucket_cnt = STATS_HISTOGRAM_BUCKETS(bits__),		  \
+		.buckets = stats_histogram_buckets_##name__,		  \
+	}
+
+/**
+ * @brief Records a value into a histogram.
+ *
+ * Compiled out if CONFIG_STATS is not defined.
+ *
+ * @param hist__                The histogram.
+ * @param value__               The value to record.
+ */
+#define STATS_HISTOGRAM_RECORD(hist__, value__) \
+	stats_histogram_record(&(hist__), (value__))
+
+/**
+ * @brief Initializes and registers a histogram as a statistics group.
+ *
+ * @param hist__                The histogram to initialize and register.
+ * @param name__                The name of the statistics group to register.
+ *                                  This name must be unique among all
+ *                                  statistics groups.
+ *
+ * @return                      0 on success; negative error code on failure.
+ */
+#define STATS_HISTOGRAM_INIT_AND_REG(hist__, name__) \
+	stats_histogram_init_and_reg(&(hist__), (name__))
+
+/**
+ * @brief Initializes and registers a histogram as a statistics group.
+ *
+ * Note: it is recommended to use the STATS_HISTOGRAM_INIT_AND_REG macro
+ * instead of this function.
+ *
+ * @param hist                  The histogram to initialize and register.
+ * @param name                  The name of the statistics group to register.
+ *
+ * @return                      0 on success; negative error code on failure.
+ */
+int stats_histogram_init_and_reg(struct stats_histogram *hist,
+				 const char *name);
+
+/**
+ * @brief Records a value into a histogram.
+ *
+ * As for the other statistics, recording is not atomic: values recorded
+ * concurrently into the same histogram from different contexts may be lost.
+ *
+ * @param hist                  The histogram.
+ * @param value                 The value to record.
+ */
+void stats_histogram_record(struct stats_histogram *hist, uint32_t value);
+
+/**
+ * @brief Computes a percentile of the recorded values.
+ *
+ * @param hist                  The histogram.
+ * @param permille              The percentile, in tenths of a percent
+ *                                  (e.g. 999 for the 99.9th percentile).
+ *
+ * @return                      The percentile, 0 if no value was recorded.
+ */
+uint32_t stats_histogram_percentile(const struct stats_histogram *hist,
+				    uint16_t permille);
+
+/**
+ * @brief Computes the summary of the recorded values.
+ *
+ * The summary is also refreshed whenever the histogram group is walked with
+ * stats_walk().
+ *
+ * @param hist                  The histogram.
+ * @param summary               Summary to fill.
+ */
+void stats_histogram_summary_get(const struct stats_histogram *hist,
+				 struct stats_histogram_summary *summary);
+
+/** @typedef stats_histogram_bucket_fn
+ * @brief Function that gets applied to every non-empty histogram bucket.
+ *
+ * @param hist                  The histogram being walked.
+ * @param arg                   Optional argument.
+ * @param low                   The lowest value of the bucket.
+ * @param high                  The highest value of the bucket.
+ * @param cnt                   The number of values recorded in the bucket.
+ *
+ * @return                      0 if the walk should proceed;
+ *                              nonzero to abort the walk.
+ */
+typedef int stats_histogram_bucket_fn(struct stats_histogram *hist, void *arg,
+				      uint32_t low, uint32_t high,
+				      uint32_t cnt);
+
+/**
+ * @brief Applies a function to every non-empty bucket of a histogram.
+ *
+ * @param hist                  The histogram.
+ * @param walk_cb               The function to apply to each bucket.
+ * @param arg                   Optional argument to pass to the callback.
+ *
+ * @return                      0 if the walk completed;
+ *                              nonzero if the walk was aborted.
+ */
+int stats_histogram_bucket_walk(struct stats_histogram *hist,
+				stats_histogram_bucket_fn *walk_cb, void *arg);
+
 #else /* CONFIG_STATS */
 
 #define STATS_SECT_START(group__) \
@@ -352,6 +533,13 @@ struct stats_hdr *stats_group_find(const char *name);
 #define STATS_CLEAR(group__, var__)
 #define STATS_INIT_AND_REG(group__, size__, name__) (0)
 
+struct stats_histogram {
+};
+
+#define STATS_HISTOGRAM_DEFINE(name__, bits__) struct stats_histogram name__
+#define STATS_HISTOGRAM_RECORD(hist__, value__)
+#define STATS_HISTOGRAM_INIT_AND_REG(hist__, name__) (0)
+
 #endif /* !CONFIG_STATS */
 
 #ifdef CONFIG_STATS_NAMES
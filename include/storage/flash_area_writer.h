@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Public API for sequential writes to a flash area
+ */
+
+#ifndef ZEPHYR_INCLUDE_STORAGE_FLASH_AREA_WRITER_H_
+#define ZEPHYR_INCLUDE_STORAGE_FLASH_AREA_WRITER_H_
+
+/**
+ * @brief Sequential flash area writes with pages erased ahead
+ *
+ * @defgroup flash_area_writer Flash area writer interface
+ * @ingroup flash_area_api
+ * @{
+ */
+
+#include <kernel.h>
+#include <sys/atomic.h>
+#include <storage/flash_map.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Define the erased page bitmap of a writer.
+ *
+ * @param name Name of the bitmap
+ * @param pages Maximum number of pages in the area
+ */
+#define FLASH_AREA_WRITER_BITMAP_DEFINE(name, pages) ATOMIC_DEFINE(name, pages)
+
+/**
+ * @brief Structure for flash area writer context
+ *
+ * Users should treat these structures as opaque values and only interact
+ * with them through the below API, except for reading the write offset.
+ */
+struct flash_area_writer {
+	const struct flash_area *fa; /* Area written */
+	const struct device *fdev; /* Flash device of the area */
+	atomic_t *erased; /* Pages erased and not written since */
+	size_t page_count; /* Number of pages in the area */
+	uint32_t first_page; /* Index of the first page in the device */
+	uint32_t cur_page; /* Page being filled */
+	off_t offset; /* Offset of the next write in the area */
+	uint8_t ahead; /* Pages kept erased after the one being filled */
+	int erase_err; /* Error of the last erase done ahead */
+	struct k_mutex lock; /* Serializes the writes and the erases */
+	struct k_work work; /* Erases the pages ahead */
+};
+
+/**
+ * @brief Initialize a writer of a flash area.
+ *
+ * The area shall start and end at page boundaries. The writes start at its
+ * beginning, and all its pages are considered as not erased; see
+ * flash_area_writer_scan().
+ *
+ * @param w Writer to initialize
+ * @param fa Flash area to write
+ * @param erased Bitmap defined with FLASH_AREA_WRITER_BITMAP_DEFINE()
+ * @param max_pages Number of pages of the bitmap
+ * @param ahead Number of pages erased in the background ahead of the page
+ *        being written, 0 to only erase a page when the writes reach it
+ *
+ * @return 0 on success, -EINVAL if the area is not page aligned, -ENOMEM if
+ * the bitmap is too small for the area, other negative errno code on fail.
+ */
+int flash_area_writer_init(struct flash_area_writer *w,
+			   const struct flash_area *fa, atomic_t *erased,
+			   size_t max_pages, uint8_t ahead);
+
+/**
+ * @brief Find the already erased pages of the area.
+ *
+ * Reads the pages of the area which are not known to be erased, so that
+ * the writer does not erase them again.
+ *
+ * @param w Writer of the area
+ *
+ * @return 0 on success, negative errno code on fail.
+ */
+int flash_area_writer_scan(struct flash_area_writer *w);
+
+/**
+ * @brief Write data at the write offset of the area.
+ *
+ * A page is erased when the writes enter it, unless it is already erased.
+ * The data length shall respect the write block size of the device, see
+ * flash_area_align().
+ *
+ * @param w Writer of the area
+ * @param data Data to write
+ * @param len Length of the data
+ *
+ * @return 0 on success, -ENOSPC if the data does not fit in the area,
+ * other negative errno code on fail, including the error of an erase done
+ * ahead.
+ */
+int flash_area_writer_write(struct flash_area_writer *w, const void *data,
+			    size_t len);
+
+/**
+ * @brief Move the write offset of the area.
+ *
+ * When the offset is not at the beginning of a page, the writes continue in
+ * its page without erasing it.
+ *
+ * @param w Writer of the area
+ * @param off New write offset in the area
+ *
+ * @return 0 on success, -EINVAL if the offset is outside of the area.
+ */
+int flash_area_writer_seek(struct flash_area_writer *w, off_t off);
+
+/**
+ * @brief Erase a range of the area, skipping the pages already erased.
+ *
+ * The range shall start and end at page boundaries.
+ *
+ * @param w Writer of the area
+ * @param off Offset of the range in the area
+ * @param len Length of the range
+ *
+ * @return 0 on success, negative errno code on fail.
+ */
+int flash_area_writer_erase(struct flash_area_writer *w, off_t off,
+			    size_t len);
+
+/**
+ * @brief Wait for the erases done ahead.
+ *
+ * Shall be called before the writer is released.
+ *
+ * @param w Writer of the area
+ *
+ * @return 0 on success, or the error of an erase done ahead.
+ */
+int flash_area_writer_sync(struct flash_area_writer *w);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_STORAGE_FLASH_AREA_WRITER_H_ */
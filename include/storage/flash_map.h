@@ -149,6 +149,23 @@ void flash_area_close(const struct flash_area *fa);
 int flash_area_read(const struct flash_area *fa, off_t off, void *dst,
 		    size_t len);
 
+/**
+ * @brief Get the address of flash area data in the memory map
+ *
+ * Gives direct read access to the data of a flash area on a memory-mapped
+ * flash device, see flash_mmap().
+ *
+ * @param[in]  fa   Flash area
+ * @param[in]  off  Offset relative from beginning of flash area
+ * @param[in]  len  Number of bytes to access
+ * @param[out] addr Address of the data
+ *
+ * @return  0 on success, -ENOTSUP if the flash device is not memory-mapped,
+ *          other negative errno code on fail.
+ */
+int flash_area_mmap(const struct flash_area *fa, off_t off, size_t len,
+		    const void **addr);
+
 /**
  * @brief Write data to flash area
  *
@@ -181,6 +198,21 @@ int flash_area_write(const struct flash_area *fa, off_t off, const void *src,
  */
 int flash_area_erase(const struct flash_area *fa, off_t off, size_t len);
 
+/**
+ * @brief Check whether a flash area range is erased
+ *
+ * Reads the range back and compares it with the erase value of the flash
+ * device, see flash_area_erased_val().
+ *
+ * @param[in] fa  Flash area
+ * @param[in] off Offset relative from beginning of flash area.
+ * @param[in] len Number of bytes to check
+ *
+ * @return  1 if the range is erased, 0 if it is not, negative errno code on
+ *          fail.
+ */
+int flash_area_is_erased(const struct flash_area *fa, off_t off, size_t len);
+
 /**
  * @brief Get write block size of the flash area
  *
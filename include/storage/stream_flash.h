@@ -21,6 +21,7 @@
  */
 
 #include <stdbool.h>
+#include <kernel.h>
 #include <drivers/flash.h>
 
 #ifdef __cplusplus
@@ -62,6 +63,16 @@ struct stream_flash_ctx {
 #ifdef CONFIG_STREAM_FLASH_ERASE
 	off_t last_erased_page_start_offset; /* Last erased offset */
 #endif
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	bool async; /* Buffer programmed while the other one is filled */
+	uint8_t *alt_buf; /* Other half of the write buffer */
+	uint8_t *wr_buf; /* Buffer being programmed */
+	size_t wr_bytes; /* Number of bytes in the buffer being programmed */
+	size_t bytes_queued; /* Bytes written or being programmed */
+	int wr_err; /* Error of the last programmed buffer */
+	struct k_work work; /* Programs wr_buf */
+	struct k_sem idle; /* Available while no buffer is programmed */
+#endif
 };
 
 /**
@@ -83,6 +94,29 @@ struct stream_flash_ctx {
 int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 		      uint8_t *buf, size_t buf_len, size_t offset, size_t size,
 		      stream_flash_callback_t cb);
+/**
+ * @brief Program the write buffer while the next one is filled.
+ *
+ * The write buffer given to @ref stream_flash_init is split in two halves.
+ * When a half is full, it is programmed by a common work queue thread and
+ * the next data goes to the other half. The thread also erases the page of
+ * the next half ahead of time, with CONFIG_STREAM_FLASH_ERASE. A write only
+ * waits when both halves are full.
+ *
+ * The callback is then called from the work queue thread, and a write or
+ * flush returns the errors of the previous programming. A flush waits for
+ * all the data to be programmed.
+ *
+ * This function should be called directly after @ref stream_flash_init.
+ *
+ * @param ctx context
+ *
+ * @return non-negative on success, negative errno code on fail: -EFAULT if
+ *         half of the write buffer is not a multiple of the flash device
+ *         write-block-size.
+ */
+int stream_flash_async_enable(struct stream_flash_ctx *ctx);
+
 /**
  * @brief Read number of bytes written to the flash.
  *
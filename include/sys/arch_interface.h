@@ -389,6 +389,18 @@ static inline struct _cpu *arch_curr_cpu(void);
  * This will invoke z_sched_ipi() on other CPUs in the system.
  */
 void arch_sched_ipi(void);
+
+#ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
+/**
+ * Send an interrupt to a set of CPUs
+ *
+ * This will invoke z_sched_ipi() on the CPUs whose IDs are set in
+ * @a cpu_bitmap.
+ *
+ * @param cpu_bitmap Bitmap of CPU IDs, never including the current CPU
+ */
+void arch_sched_directed_ipi(uint32_t cpu_bitmap);
+#endif
 #endif /* CONFIG_SMP */
 
 /** @} */
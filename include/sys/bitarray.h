@@ -26,6 +26,9 @@ struct sys_bitarray {
 	/* Bundle of bits */
 	uint32_t *bundles;
 
+	/* All the bits below are set: allocations search from there */
+	uint32_t first_free;
+
 	/* Spinlock guarding access to this bit array */
 	struct k_spinlock lock;
 };
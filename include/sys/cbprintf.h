@@ -133,6 +133,64 @@ typedef int (*cbprintf_cb)(/* int c, void *ctx */);
 	Z_CBPRINTF_STATIC_PACKAGE(packaged, inlen, outlen, \
 				  align_offset, __VA_ARGS__)
 
+/** @brief Statically package string, locating its string arguments.
+ *
+ * Same as CBPRINTF_STATIC_PACKAGE() but the word index of each character
+ * pointer argument (except the format string) is also recorded, as found at
+ * compile time. The package can then be completed with copies of the
+ * transient strings by cbprintf_package_copy(), without parsing the format
+ * string. Character pointers are therefore always taken as strings, they
+ * must be cast to void pointers to be printed with %p.
+ *
+ * If _Generic is not supported then runtime packaging is performed, which
+ * already copies the transient strings, and no index is recorded.
+ *
+ * @param packaged pointer to where the packaged data can be stored.
+ *
+ * @param inlen set to the number of bytes available at @p packaged.
+ *
+ * @param outlen variable updated to the number of bytes required to completely
+ * store the packed information.
+ *
+ * @param align_offset input buffer alignment offset in bytes.
+ *
+ * @param str_pos uint8_t array with room for one index per argument.
+ *
+ * @param str_cnt unsigned int variable updated to the number of indexes
+ * stored in @p str_pos.
+ *
+ * @param ... formatted string with arguments. Format string must be constant.
+ */
+#define CBPRINTF_STATIC_PACKAGE_STR_POS(packaged, inlen, outlen, align_offset, \
+					str_pos, str_cnt, ... /* fmt, ... */) \
+	Z_CBPRINTF_STATIC_PACKAGE_STR_POS(packaged, inlen, outlen, \
+					  align_offset, str_pos, str_cnt, \
+					  __VA_ARGS__)
+
+/** @brief Copy a static package, appending its transient strings.
+ *
+ * Strings given by @p str_pos which are not in read only memory are copied
+ * at the end of the package, as cbvprintf_package() does, so that the
+ * package remains valid once they are gone.
+ *
+ * @param out destination buffer. Pass a null pointer to only calculate the
+ * space required.
+ *
+ * @param len number of bytes available at @p out. Ignored if @p out is null.
+ *
+ * @param in package built by CBPRINTF_STATIC_PACKAGE_STR_POS().
+ *
+ * @param str_pos word indexes of the string arguments in the package.
+ *
+ * @param str_cnt number of indexes in @p str_pos.
+ *
+ * @retval nonegative the number of bytes stored at @p out, or required when
+ * @p out is null.
+ * @retval -ENOSPC if @p out was not null and the space required exceeds @p len.
+ */
+int cbprintf_package_copy(void *out, size_t len, const void *in,
+			  const uint8_t *str_pos, unsigned int str_cnt);
+
 /** @brief Capture state required to output formatted data later.
  *
  * Like cbprintf() but instead of processing the arguments and emitting the
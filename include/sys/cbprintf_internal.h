@@ -275,12 +275,20 @@ extern "C" {
 
 /** @brief Package single argument.
  *
- * Macro is called in a loop for each argument in the string.
+ * Macro is called in a loop for each argument in the string. Word index of
+ * character pointer arguments, other than the format string, is recorded if
+ * requested.
  *
  * @param arg argument.
  */
-#define Z_CBPRINTF_PACK_ARG(arg) \
-	Z_CBPRINTF_PACK_ARG2(_pbuf, _pkg_len, _pkg_offset, _pmax, arg)
+#define Z_CBPRINTF_PACK_ARG(arg) do { \
+	Z_CBPRINTF_PACK_ARG2(_pbuf, _pkg_len, _pkg_offset, _pmax, arg); \
+	if (_s_pos != NULL && _pkg_argc > 0 && Z_CBPRINTF_IS_PCHAR(arg)) { \
+		_s_pos[_s_cnt++] = \
+			(uint8_t)((_pkg_len - sizeof(char *)) / sizeof(int)); \
+	} \
+	_pkg_argc++; \
+} while (0)
 
 /** @brief Package descriptor.
  *
@@ -322,9 +330,16 @@ union z_cbprintf_hdr {
  * @param _align_offset Input buffer alignment offset in words. Where offset 0
  * means that buffer is aligned to CBPRINTF_PACKAGE_ALIGNMENT.
  *
+ * @param _str_pos Buffer for the word indexes of the string arguments, with
+ * room for one index per argument. Null if not needed.
+ *
+ * @param _str_cnt Pointer to the variable updated to the number of indexes
+ * stored in @p _str_pos. Null if not needed.
+ *
  * @param ... String with variable list of arguments.
  */
 #define Z_CBPRINTF_STATIC_PACKAGE_GENERIC(buf, _inlen, _outlen, _align_offset, \
+					  _str_pos, _str_cnt, \
 					  ... /* fmt, ... */) \
 do { \
 	_Pragma("GCC diagnostic push") \
@@ -344,6 +359,10 @@ do { \
 	size_t _pmax = (buf != NULL) ? _inlen : INT32_MAX; \
 	int _pkg_len = 0; \
 	int _pkg_offset = _align_offset; \
+	uint8_t *_s_pos = _str_pos; \
+	unsigned int *_s_cnt_out = _str_cnt; \
+	unsigned int _s_cnt = 0; \
+	int _pkg_argc = 0; \
 	union z_cbprintf_hdr *_len_loc; \
 	/* package starts with string address and field with length */ \
 	if (_pmax < sizeof(union z_cbprintf_hdr)) { \
@@ -367,6 +386,9 @@ do { \
 		}; \
 		*_len_loc = hdr; \
 	} \
+	if (_s_cnt_out != NULL) { \
+		*_s_cnt_out = _s_cnt; \
+	} \
 	_Pragma("GCC diagnostic pop") \
 } while (0)
 
@@ -374,7 +396,14 @@ do { \
 #define Z_CBPRINTF_STATIC_PACKAGE(packaged, inlen, outlen, align_offset, \
 				  ... /* fmt, ... */) \
 	Z_CBPRINTF_STATIC_PACKAGE_GENERIC(packaged, inlen, outlen, \
-					  align_offset, __VA_ARGS__)
+					  align_offset, NULL, NULL, __VA_ARGS__)
+
+#define Z_CBPRINTF_STATIC_PACKAGE_STR_POS(packaged, inlen, outlen, \
+					  align_offset, str_pos, str_cnt, \
+					  ... /* fmt, ... */) \
+	Z_CBPRINTF_STATIC_PACKAGE_GENERIC(packaged, inlen, outlen, \
+					  align_offset, str_pos, &(str_cnt), \
+					  __VA_ARGS__)
 #else
 #define Z_CBPRINTF_STATIC_PACKAGE(packaged, inlen, outlen, align_offset, \
 				  ... /* fmt, ... */) \
@@ -386,6 +415,16 @@ do { \
 		outlen = cbprintf_package(NULL, align_offset, __VA_ARGS__); \
 	} \
 } while (0)
+
+/* Runtime package already holds copies of the transient strings. */
+#define Z_CBPRINTF_STATIC_PACKAGE_STR_POS(packaged, inlen, outlen, \
+					  align_offset, str_pos, str_cnt, \
+					  ... /* fmt, ... */) \
+do { \
+	Z_CBPRINTF_STATIC_PACKAGE(packaged, inlen, outlen, align_offset, \
+				  __VA_ARGS__); \
+	str_cnt = 0; \
+} while (0)
 #endif /* Z_C_GENERIC */
 
 #ifdef __cplusplus
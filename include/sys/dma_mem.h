@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_DMA_MEM_H_
+#define ZEPHYR_INCLUDE_SYS_DMA_MEM_H_
+
+#include <kernel.h>
+#include <sys/util.h>
+#include <linker/section_tags.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup dma_mem DMA memory
+ * @ingroup os_services
+ *
+ * Buffers shared with DMA capable devices whose accesses are not coherent
+ * with the data cache of the CPU. The buffers are aligned on cache lines
+ * and sized in whole lines, for the cache maintenance of a buffer not to
+ * touch its neighbours: drivers can then work on them in place, without
+ * bounce buffers. With CONFIG_DMA_MEM_NOCACHE, the buffers are placed in
+ * the non-cacheable memory of CONFIG_NOCACHE_MEMORY instead, and need no
+ * maintenance at all.
+ *
+ * @{
+ */
+
+/** @brief Alignment of the DMA buffers, a multiple of the cache line size. */
+#define DMA_MEM_ALIGN CONFIG_DMA_MEM_ALIGN
+
+/**
+ * @brief Round a size up to whole DMA buffer alignment units.
+ *
+ * @param size Size in bytes.
+ */
+#define DMA_MEM_ROUND_UP(size) ROUND_UP(size, DMA_MEM_ALIGN)
+
+/**
+ * @brief Place a variable in DMA memory.
+ *
+ * The variable is aligned on DMA_MEM_ALIGN and is not initialized. Its
+ * size should be a multiple of DMA_MEM_ALIGN.
+ */
+#if defined(CONFIG_DMA_MEM_NOCACHE)
+#define __dma_mem __nocache __aligned(DMA_MEM_ALIGN)
+#else
+#define __dma_mem __noinit __aligned(DMA_MEM_ALIGN)
+#endif
+
+/**
+ * @brief Define a DMA buffer.
+ *
+ * @param name Name of the buffer, an array of uint8_t.
+ * @param size Size of the buffer, rounded up to whole alignment units.
+ */
+#define DMA_MEM_BUF_DEFINE(name, size) \
+	uint8_t __dma_mem name[DMA_MEM_ROUND_UP(size)]
+
+/**
+ * @brief Define a memory slab of DMA buffers.
+ *
+ * As K_MEM_SLAB_DEFINE(), with the blocks in DMA memory, each aligned on
+ * DMA_MEM_ALIGN and sized in whole alignment units. The blocks are
+ * allocated and freed with k_mem_slab_alloc() and k_mem_slab_free().
+ *
+ * @param name Name of the memory slab.
+ * @param block_size Size of each block in bytes.
+ * @param num_blocks Number of blocks.
+ */
+#define DMA_MEM_SLAB_DEFINE(name, block_size, num_blocks) \
+	char __dma_mem _dma_mem_slab_buf_##name[(num_blocks) * \
+					DMA_MEM_ROUND_UP(block_size)]; \
+	Z_STRUCT_SECTION_ITERABLE(k_mem_slab, name) = \
+		Z_MEM_SLAB_INITIALIZER(name, _dma_mem_slab_buf_##name, \
+				       DMA_MEM_ROUND_UP(block_size), num_blocks)
+
+/** @brief Memory range, e.g. an element of a scatter-gather list. */
+struct dma_mem_range {
+	/** Start of the range. */
+	void *addr;
+	/** Length of the range in bytes. */
+	size_t len;
+};
+
+/**
+ * @brief Perform the data cache maintenance of memory ranges.
+ *
+ * The ranges are extended to whole alignment units, and the ones adjacent
+ * or overlapping in the order of the array are merged, so that the cache
+ * lines of a scatter-gather list of contiguous buffers are walked once.
+ * The ranges in non-cacheable memory are skipped. Above
+ * CONFIG_DMA_MEM_SYNC_ALL_THRESHOLD bytes, the whole data cache is written
+ * back instead, unless it is only to be invalidated.
+ *
+ * The ranges to invalidate must be aligned on DMA_MEM_ALIGN and sized in
+ * whole alignment units, as the data sharing their cache lines would be
+ * lost otherwise.
+ *
+ * @param ranges Memory ranges.
+ * @param count Number of ranges.
+ * @param op K_CACHE_WB before the device reads the memory, K_CACHE_INVD
+ *	  after it wrote it, or K_CACHE_WB_INVD.
+ *
+ * @retval 0 on success, or if there is no data cache to manage.
+ * @retval -errno on failure of the architecture cache operation.
+ */
+int dma_mem_sync(const struct dma_mem_range *ranges, size_t count, int op);
+
+/**
+ * @brief Perform the data cache maintenance of a DMA buffer.
+ *
+ * @param addr Start of the buffer.
+ * @param len Length of the buffer in bytes.
+ * @param op Cache operation, as for dma_mem_sync().
+ *
+ * @return As dma_mem_sync().
+ */
+static inline int dma_mem_sync_buf(void *addr, size_t len, int op)
+{
+	const struct dma_mem_range range = { .addr = addr, .len = len };
+
+	return dma_mem_sync(&range, 1, op);
+}
+
+/**
+ * @brief Check whether memory needs no cache maintenance for DMA.
+ *
+ * @param addr Start of the memory range.
+ * @param len Length of the memory range in bytes.
+ *
+ * @return true if the range is in non-cacheable memory, or if the data
+ *	   cache is not managed (CONFIG_CACHE_MANAGEMENT disabled).
+ */
+bool dma_mem_is_coherent(const void *addr, size_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_DMA_MEM_H_ */
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ * @brief FNV-1a hash functions
+ *
+ * 32-bit Fowler-Noll-Vo hash, variant 1a. It is not a cryptographic
+ * hash, but it is cheap and spreads short keys such as names or
+ * addresses well over hash table buckets.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_FNV1A_H_
+#define ZEPHYR_INCLUDE_SYS_FNV1A_H_
+
+#include <zephyr/types.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Value to start a hash with, the FNV offset basis */
+#define FNV1A_32_INIT 2166136261U
+
+/** FNV prime for 32-bit hashes */
+#define FNV1A_32_PRIME 16777619U
+
+/**
+ * @brief Add a byte to a FNV-1a hash
+ *
+ * @param hash Hash so far, FNV1A_32_INIT to start a new one.
+ * @param byte Byte to add.
+ *
+ * @return The updated hash.
+ */
+static inline uint32_t fnv1a_32_byte(uint32_t hash, uint8_t byte)
+{
+	return (hash ^ byte) * FNV1A_32_PRIME;
+}
+
+/**
+ * @brief Add a buffer to a FNV-1a hash
+ *
+ * @param hash Hash so far, FNV1A_32_INIT to start a new one.
+ * @param data Bytes to add.
+ * @param len Number of bytes to add.
+ *
+ * @return The updated hash.
+ */
+static inline uint32_t fnv1a_32_update(uint32_t hash, const void *data,
+				       size_t len)
+{
+	const uint8_t *ptr = data;
+
+	while (len--) {
+		hash = fnv1a_32_byte(hash, *ptr++);
+	}
+
+	return hash;
+}
+
+/**
+ * @brief Add a string, without its terminating NUL, to a FNV-1a hash
+ *
+ * @param hash Hash so far, FNV1A_32_INIT to start a new one.
+ * @param str String to add.
+ *
+ * @return The updated hash.
+ */
+static inline uint32_t fnv1a_32_str(uint32_t hash, const char *str)
+{
+	while (*str != '\0') {
+		hash = fnv1a_32_byte(hash, (uint8_t)*str++);
+	}
+
+	return hash;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_FNV1A_H_ */
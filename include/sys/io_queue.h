@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_IO_QUEUE_H_
+#define ZEPHYR_INCLUDE_SYS_IO_QUEUE_H_
+
+#include <kernel.h>
+#include <device.h>
+#include <sys/atomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup io_queue Device I/O queues
+ * @ingroup os_services
+ *
+ * Device I/O queues let a thread queue chains of bus operations and reap
+ * their completions in batches, instead of blocking on every operation.
+ *
+ * The submitting thread acquires submission entries from the ring of an
+ * I/O queue, fills them in and submits them. The operations are performed,
+ * in order, by the executor the queue is bound to. Each completion is
+ * posted to the completion ring of the queue, at the index of its
+ * submission, and signalled through a @ref k_poll_signal and an optional
+ * callback.
+ *
+ * An executor runs the operations of the queues bound to it one at a time,
+ * from its own thread. Operations on different buses proceed in parallel
+ * when their queues are bound to different executors, so that one thread
+ * can keep several buses busy at once.
+ *
+ * @{
+ */
+
+struct io_queue;
+struct io_sqe;
+struct spi_config;
+struct spi_buf_set;
+struct i2c_msg;
+
+/** @brief Operations of the submission entries. */
+enum io_op {
+	/** No operation, completes with 0. */
+	IO_OP_NOP,
+	/** spi_transceive() on the device of the entry. */
+	IO_OP_SPI_TRANSCEIVE,
+	/** i2c_transfer() on the device of the entry. */
+	IO_OP_I2C_TRANSFER,
+	/** Call a function from the executor, e.g. a device specific
+	 *  operation such as sensor_sample_fetch().
+	 */
+	IO_OP_CALLBACK,
+};
+
+/**
+ * @brief The next entry is part of the same chain.
+ *
+ * The entries following a failed entry in its chain are not performed,
+ * they complete with -ECANCELED.
+ */
+#define IO_SQE_CHAINED BIT(0)
+
+/**
+ * @brief Function performed by an @ref IO_OP_CALLBACK entry.
+ *
+ * @param sqe The submission entry.
+ *
+ * @return Result of the entry.
+ */
+typedef int (*io_op_callback_t)(const struct io_sqe *sqe);
+
+/** @brief Submission entry. */
+struct io_sqe {
+	/** Operation, see @ref io_op. */
+	uint8_t op;
+	/** Flags, e.g. @ref IO_SQE_CHAINED. */
+	uint8_t flags;
+	/** Device the operation applies to. */
+	const struct device *dev;
+	/** User data, returned in the completion entry. */
+	void *user_data;
+	union {
+		/** @ref IO_OP_SPI_TRANSCEIVE parameters. */
+		struct {
+			const struct spi_config *config;
+			const struct spi_buf_set *tx_bufs;
+			const struct spi_buf_set *rx_bufs;
+		} spi;
+		/** @ref IO_OP_I2C_TRANSFER parameters. */
+		struct {
+			struct i2c_msg *msgs;
+			uint8_t num_msgs;
+			uint16_t addr;
+		} i2c;
+		/** @ref IO_OP_CALLBACK parameters. */
+		struct {
+			io_op_callback_t func;
+			void *arg;
+		} callback;
+	};
+};
+
+/** @brief Completion entry. */
+struct io_cqe {
+	/** Result of the operation: 0 or a negative error code. */
+	int result;
+	/** User data of the submission entry. */
+	void *user_data;
+};
+
+/**
+ * @brief Completion callback.
+ *
+ * Called from the executor thread after every completion was posted, before
+ * the signal of the queue is raised.
+ *
+ * @param queue The I/O queue.
+ * @param cqe The completion entry.
+ */
+typedef void (*io_queue_callback_t)(struct io_queue *queue,
+				    const struct io_cqe *cqe);
+
+/** @brief Executor, performing the operations of the queues bound to it. */
+struct io_executor {
+	/** Queues with submitted entries. */
+	struct k_fifo pending;
+};
+
+/** @brief Device I/O queue, defined with IO_QUEUE_DEFINE(). */
+struct io_queue {
+	/* Reserved for the pending FIFO of the executor. */
+	void *fifo_reserved;
+	struct io_executor *executor;
+	struct io_sqe *sq;
+	struct io_cqe *cq;
+	/* Ring size, a power of two. */
+	uint32_t size;
+	/* Entries acquired by the submitter. */
+	uint32_t sq_acquired;
+	/* Entries submitted. */
+	atomic_t sq_tail;
+	/* Entries performed, owned by the executor. */
+	uint32_t sq_head;
+	/* Entries completed. */
+	atomic_t cq_tail;
+	/* Completions reaped. */
+	atomic_t cq_head;
+	/* Set while the queue is in the pending FIFO of its executor. */
+	atomic_t scheduled;
+	/* The current chain failed, owned by the executor. */
+	bool chain_failed;
+	/** Raised on every completion, with its result. */
+	struct k_poll_signal signal;
+	/** Optional completion callback. */
+	io_queue_callback_t callback;
+};
+
+/** @cond INTERNAL_HIDDEN */
+void z_io_executor_thread(void *executor, void *p2, void *p3);
+/** @endcond */
+
+/**
+ * @brief Define an executor.
+ *
+ * @param name Name of the executor.
+ * @param stack_size Stack size of its thread.
+ * @param prio Priority of its thread.
+ */
+#define IO_EXECUTOR_DEFINE(name, stack_size, prio)			\
+	struct io_executor name = {					\
+		.pending = Z_FIFO_INITIALIZER(name.pending),		\
+	};								\
+	K_THREAD_DEFINE(name##_thread, stack_size, z_io_executor_thread, \
+			&name, NULL, NULL, prio, 0, 0)
+
+/**
+ * @brief Define an I/O queue.
+ *
+ * @param name Name of the queue.
+ * @param exec Executor performing the operations of the queue.
+ * @param sz Number of entries of its rings, a power of two. It bounds the
+ *	     number of entries submitted and not reaped yet.
+ */
+#define IO_QUEUE_DEFINE(name, exec, sz)					\
+	BUILD_ASSERT(((sz) != 0) && (((sz) & ((sz) - 1)) == 0),		\
+		     "I/O queue size must be a power of two");		\
+	static struct io_sqe name##_sq[sz];				\
+	static struct io_cqe name##_cq[sz];				\
+	struct io_queue name = {					\
+		.executor = &(exec),					\
+		.sq = name##_sq,					\
+		.cq = name##_cq,					\
+		.size = (sz),						\
+		.signal = K_POLL_SIGNAL_INITIALIZER(name.signal),	\
+	}
+
+/**
+ * @brief Set the completion callback of a queue.
+ *
+ * @param queue The I/O queue.
+ * @param callback Callback, NULL to remove it.
+ */
+static inline void io_queue_callback_set(struct io_queue *queue,
+					 io_queue_callback_t callback)
+{
+	queue->callback = callback;
+}
+
+/**
+ * @brief Acquire a submission entry.
+ *
+ * The entry is zeroed, and only handed to the executor by
+ * io_queue_submit(). Only one thread may acquire and submit entries of a
+ * given queue.
+ *
+ * @param queue The I/O queue.
+ *
+ * @return Submission entry, NULL if as many entries as the queue size were
+ *	   submitted and not reaped yet.
+ */
+struct io_sqe *io_queue_sqe_acquire(struct io_queue *queue);
+
+/**
+ * @brief Submit the acquired entries to the executor.
+ *
+ * @param queue The I/O queue.
+ *
+ * @return Number of entries submitted.
+ */
+uint32_t io_queue_submit(struct io_queue *queue);
+
+/**
+ * @brief Reap completions.
+ *
+ * Completions are reaped in submission order. Only one thread may reap the
+ * completions of a given queue.
+ *
+ * @param queue The I/O queue.
+ * @param cqes Array receiving the completion entries.
+ * @param max Maximum number of entries to reap.
+ *
+ * @return Number of entries reaped.
+ */
+uint32_t io_queue_reap(struct io_queue *queue, struct io_cqe *cqes,
+		       uint32_t max);
+
+/**
+ * @brief Wait for completions.
+ *
+ * @param queue The I/O queue.
+ * @param count Number of completions to wait for, not reaped yet.
+ * @param timeout Waiting period.
+ *
+ * @retval 0 if count completions are ready to be reaped.
+ * @retval -EAGAIN if the waiting period timed out.
+ */
+int io_queue_wait(struct io_queue *queue, uint32_t count,
+		  k_timeout_t timeout);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_IO_QUEUE_H_ */
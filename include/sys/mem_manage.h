@@ -105,6 +105,34 @@ struct k_mem_paging_stats_t {
 		/** Number of dirty pages selected for eviction */
 		unsigned long			dirty;
 	} eviction;
+
+#ifdef CONFIG_DEMAND_PAGING_PREFETCH
+	struct {
+		/** Number of pages paged in by fault-around */
+		unsigned long			around;
+
+		/** Number of pages paged in ahead of sequential accesses */
+		unsigned long			sequential;
+	} prefetch;
+#endif /* CONFIG_DEMAND_PAGING_PREFETCH */
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+};
+
+struct k_mem_paging_working_set_t {
+#ifdef CONFIG_DEMAND_PAGING_STATS
+	/** Number of page frames holding data pages that can be evicted */
+	unsigned long			resident;
+
+	/** Number of those data pages accessed since the eviction
+	 * algorithm last cleared their accessed state
+	 */
+	unsigned long			accessed;
+
+	/** Number of those data pages modified since being paged in */
+	unsigned long			dirty;
+
+	/** Number of page frames pinned in memory */
+	unsigned long			pinned;
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 };
 
@@ -442,6 +470,32 @@ void k_mem_pin(void *addr, size_t size);
  */
 void k_mem_unpin(void *addr, size_t size);
 
+/**
+ * Set the page fault prefetch policy
+ *
+ * Only available if CONFIG_DEMAND_PAGING_PREFETCH is enabled. Initial
+ * values are CONFIG_DEMAND_PAGING_FAULT_AROUND_PAGES and
+ * CONFIG_DEMAND_PAGING_PREFETCH_MAX_PAGES.
+ *
+ * @param around Number of pages, including the faulting one, in the aligned
+ *        window paged in on a page fault, 0 or 1 to disable fault-around
+ * @param sequential_max Maximum number of pages paged in ahead of a fault
+ *        continuing a sequential access pattern, 0 to disable
+ * @retval 0 Success
+ * @retval -EINVAL A window is larger than 32 pages or half of the page
+ *         frames
+ */
+int k_mem_paging_prefetch_set(size_t around, size_t sequential_max);
+
+/**
+ * Get the page fault prefetch policy
+ *
+ * @param[out] around Size of the fault-around window, in pages
+ * @param[out] sequential_max Maximum number of pages prefetched ahead of
+ *             sequential accesses
+ */
+void k_mem_paging_prefetch_get(size_t *around, size_t *sequential_max);
+
 /**
  * Get the paging statistics since system startup
  *
@@ -466,6 +520,23 @@ __syscall
 void k_mem_paging_thread_stats_get(struct k_thread *thread,
 				   struct k_mem_paging_stats_t *stats);
 
+/**
+ * Get a snapshot of the working set
+ *
+ * This populates the working set struct being passed in as argument
+ * with the current state of all page frames.
+ *
+ * The number of accessed data pages approximates the working set: it is
+ * the number of pages touched since the eviction algorithm last looked
+ * at them. If that is close to the number of resident pages, the
+ * working set does not fit in memory and the system is likely to
+ * thrash.
+ *
+ * @param[in,out] ws Working set struct to be filled.
+ */
+__syscall void k_mem_paging_working_set_get(
+	struct k_mem_paging_working_set_t *ws);
+
 /**
  * Get the eviction timing histogram
  *
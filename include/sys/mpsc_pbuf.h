@@ -38,7 +38,12 @@ extern "C" {
  *
  * Reading packets is performed in two steps. First packet is claimed. Claiming
  * returns pointer to the packet within the buffer. Packet is freed when no
- * longer in use.
+ * longer in use. Consecutive packets can be claimed and freed in batches, with
+ * a single lock round trip for the whole batch.
+ *
+ * Packets may be claimed by several consumers and freed in any order. Space of
+ * a packet freed before the ones preceding it is given back once all preceding
+ * packets are freed.
  */
 
 /**@defgroup MPSC_PBUF_FLAGS MPSC packet buffer flags
@@ -225,6 +230,36 @@ union mpsc_pbuf_generic *mpsc_pbuf_claim(struct mpsc_pbuf_buffer *buffer);
 void mpsc_pbuf_free(struct mpsc_pbuf_buffer *buffer,
 		    union mpsc_pbuf_generic *packet);
 
+/** @brief Claim up to @p max consecutive pending packets.
+ *
+ * Packets are claimed in the order they were committed, under a single lock
+ * round trip. Claiming stops at the first packet which is not committed yet.
+ *
+ * @param buffer Buffer.
+ *
+ * @param packets Array filled with the claimed packets.
+ *
+ * @param max Size of @p packets.
+ *
+ * @return Number of claimed packets.
+ */
+uint32_t mpsc_pbuf_claim_batch(struct mpsc_pbuf_buffer *buffer,
+			       union mpsc_pbuf_generic **packets, uint32_t max);
+
+/** @brief Free packets.
+ *
+ * Equivalent to freeing each packet with @ref mpsc_pbuf_free, under a single
+ * lock round trip.
+ *
+ * @param buffer Buffer.
+ *
+ * @param packets Packets, in the order they were claimed.
+ *
+ * @param n Number of packets.
+ */
+void mpsc_pbuf_free_batch(struct mpsc_pbuf_buffer *buffer,
+			  union mpsc_pbuf_generic **packets, uint32_t n);
+
 /** @brief Check if there are any message pending.
  *
  * @param buffer Buffer.
@@ -11,8 +11,8 @@
  * sys_mutex behaves almost exactly like k_mutex, with the added advantage
  * that a sys_mutex instance can reside in user memory.
  *
- * Further enhancements will support locking/unlocking uncontended sys_mutexes
- * with simple atomic ops instead of syscalls, similar to Linux's
+ * With CONFIG_SYS_MUTEX_FAST, uncontended sys_mutexes are locked and
+ * unlocked with simple atomic ops instead of syscalls, similar to Linux's
  * FUTEX_LOCK_PI and FUTEX_UNLOCK_PI
  */
 
@@ -24,13 +24,22 @@ extern "C" {
 #include <sys/atomic.h>
 #include <zephyr/types.h>
 #include <sys_clock.h>
+#ifdef CONFIG_SYS_MUTEX_FAST
+#include <kernel.h>
+#include <errno.h>
+#endif
 
 struct sys_mutex {
-	/* Currently unused, but will be used to store state for fast mutexes
-	 * that can be locked/unlocked with atomic ops if there is no
-	 * contention
+	/* With CONFIG_SYS_MUTEX_FAST, NULL if the mutex is free, the owner
+	 * thread if it was locked without a syscall, or 1 if the kernel
+	 * side k_mutex is in charge.  Unused otherwise.
 	 */
-	atomic_t val;
+	atomic_ptr_t val;
+#ifdef CONFIG_SYS_MUTEX_FAST
+	/* Only ever written by the owner */
+	k_tid_t holder;
+	uint32_t lock_count;
+#endif
 };
 
 /**
@@ -69,10 +78,16 @@ struct sys_mutex {
  */
 static inline void sys_mutex_init(struct sys_mutex *mutex)
 {
+#ifdef CONFIG_SYS_MUTEX_FAST
+	atomic_ptr_set(&mutex->val, NULL);
+	mutex->holder = NULL;
+	mutex->lock_count = 0U;
+#else
 	ARG_UNUSED(mutex);
+#endif
 
-	/* Nothing to do, kernel-side data structures are initialized at
-	 * boot
+	/* Nothing else to do, kernel-side data structures are initialized
+	 * at boot
 	 */
 }
 
@@ -81,6 +96,20 @@ __syscall int z_sys_mutex_kernel_lock(struct sys_mutex *mutex,
 
 __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
 
+#ifdef CONFIG_SYS_MUTEX_FAST
+extern __thread k_tid_t z_sys_mutex_self;
+
+/* k_current_get() is a syscall for user threads, so cache its result */
+static inline k_tid_t z_sys_mutex_current(void)
+{
+	if (z_sys_mutex_self == NULL) {
+		z_sys_mutex_self = k_current_get();
+	}
+
+	return z_sys_mutex_self;
+}
+#endif
+
 /**
  * @brief Lock a mutex.
  *
@@ -103,8 +132,33 @@ __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
  */
 static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 {
+#ifdef CONFIG_SYS_MUTEX_FAST
+	k_tid_t self = z_sys_mutex_current();
+	int ret = 0;
+
+	if (mutex->holder == self) {
+		mutex->lock_count++;
+		return 0;
+	}
+
+	if (!atomic_ptr_cas(&mutex->val, NULL, self)) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -EBUSY;
+		}
+
+		ret = z_sys_mutex_kernel_lock(mutex, timeout);
+	}
+
+	if (ret == 0) {
+		mutex->holder = self;
+		mutex->lock_count = 1U;
+	}
+
+	return ret;
+#else
 	/* For now, make the syscall unconditionally */
 	return z_sys_mutex_kernel_lock(mutex, timeout);
+#endif
 }
 
 /**
@@ -126,8 +180,35 @@ static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
  */
 static inline int sys_mutex_unlock(struct sys_mutex *mutex)
 {
+#ifdef CONFIG_SYS_MUTEX_FAST
+	k_tid_t self = z_sys_mutex_current();
+	int ret;
+
+	if (mutex->holder != self) {
+		return mutex->holder == NULL ? -EINVAL : -EPERM;
+	}
+
+	if (--mutex->lock_count > 0U) {
+		return 0;
+	}
+
+	mutex->holder = NULL;
+	if (atomic_ptr_cas(&mutex->val, self, NULL)) {
+		return 0;
+	}
+
+	/* Someone is waiting, the kernel picks the next owner */
+	ret = z_sys_mutex_kernel_unlock(mutex);
+	if (ret != 0) {
+		mutex->holder = self;
+		mutex->lock_count = 1U;
+	}
+
+	return ret;
+#else
 	/* For now, make the syscall unconditionally */
 	return z_sys_mutex_kernel_unlock(mutex);
+#endif
 }
 
 #include <syscalls/mutex.h>
@@ -11,6 +11,7 @@
 /* Zephyr Pooled Parallel Preemptible Priority-based Work Queues */
 
 struct k_p4wq_work;
+struct z_p4wq_subq;
 
 /**
  * P4 Queue handler callback
@@ -24,6 +25,10 @@ typedef void (*k_p4wq_handler_t)(struct k_p4wq_work *work);
  * priority and deadline fields are interpreted as thread scheduling
  * priorities, exactly as per k_thread_priority_set() and
  * k_thread_deadline_set().
+ *
+ * The fields reserved for the implementation must be zeroed before the
+ * item is first submitted or cancelled, e.g. by a static definition or
+ * a memset() of a stack item.
  */
 struct k_p4wq_work {
 	/* Filled out by submitting code */
@@ -40,18 +45,39 @@ struct k_p4wq_work {
 	};
 	struct k_thread *thread;
 	struct k_p4wq *queue;
+	struct z_p4wq_subq *subq;
 };
 
 #define K_P4WQ_QUEUE_PER_THREAD		BIT(0)
 #define K_P4WQ_DELAYED_START		BIT(1)
 #define K_P4WQ_USER_CPU_MASK		BIT(2)
 
+#ifdef CONFIG_P4WQ_PER_CPU
+#define Z_P4WQ_NUM_SUBQ CONFIG_MP_NUM_CPUS
+#else
+#define Z_P4WQ_NUM_SUBQ 1
+#endif
+
+/* Pending and active items submitted on one CPU (or all of them
+ * without CONFIG_P4WQ_PER_CPU)
+ */
+struct z_p4wq_subq {
+	struct k_spinlock lock;
+
+	/* Work items waiting for processing */
+	struct rbtree queue;
+
+	/* Work items in progress */
+	sys_dlist_t active;
+};
+
 /**
  * @brief P4 Queue
  *
  * Kernel pooled parallel preemptible priority-based work queue
  */
 struct k_p4wq {
+	/* Protects waitq, i.e. the sleeping and waking of threads */
 	struct k_spinlock lock;
 
 	/* Pending threads waiting for work items
@@ -65,11 +91,7 @@ struct k_p4wq {
 	 */
 	_wait_q_t waitq;
 
-	/* Work items waiting for processing */
-	struct rbtree queue;
-
-	/* Work items in progress */
-	sys_dlist_t active;
+	struct z_p4wq_subq subq[Z_P4WQ_NUM_SUBQ];
 
 	/* K_P4WQ_* flags above */
 	uint32_t flags;
@@ -173,6 +195,11 @@ void k_p4wq_add_thread(struct k_p4wq *queue, struct k_thread *thread,
  * higher-priority work items are available.  The handler may be
  * invoked on any CPU.
  *
+ * With CONFIG_P4WQ_PER_CPU the item is queued on the submitting
+ * CPU's sub-queue and preferably run by a thread on that CPU.
+ * Threads only take items from other CPUs' sub-queues when their own
+ * one is empty, so priority order is only guaranteed per CPU.
+ *
  * The caller must not mutate the struct while it is stored in the
  * queue.  The memory should remain unchanged until k_p4wq_cancel() is
  * called or until the entry to the handler function.
@@ -195,6 +222,9 @@ void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item);
  * removed.  If the function returns false, either the item was never
  * submitted, has already been executed, or is still running.
  *
+ * An item that was never submitted must have been zeroed, see
+ * struct k_p4wq_work.
+ *
  * @return true if the item was successfully removed, otherwise false
  */
 bool k_p4wq_cancel(struct k_p4wq *queue, struct k_p4wq_work *item);
@@ -406,6 +406,137 @@ int ring_buf_get_finish(struct ring_buf *buf, uint32_t size);
  */
 uint32_t ring_buf_get(struct ring_buf *buf, uint8_t *data, uint32_t size);
 
+/**
+ * @brief A ring buffer of records, for several producers and one consumer
+ *
+ * Producers reserve room for a record with a single atomic operation on
+ * the write index, fill it in, then commit it: threads, ISRs and other
+ * CPUs may produce at the same time without any lock. The records are
+ * consumed in the order they were reserved, a record being only available
+ * once committed: a producer preempted between reserve and commit delays
+ * the records reserved after its own.
+ */
+struct ring_buf_mpsc {
+	atomic_t wr_idx;  /**< Words reserved by the producers */
+	atomic_t rd_idx;  /**< Words freed by the consumer */
+	atomic_t dropped; /**< Records which did not fit */
+	uint32_t mask;    /**< Size of buf in 32-bit words, minus 1 */
+	atomic_t *buf;    /**< Memory region for the records */
+};
+
+/**
+ * @brief Statically define and initialize a multi-producer ring buffer.
+ *
+ * @param name Name of the ring buffer.
+ * @param pow Ring buffer size exponent: it holds 2^pow 32-bit words.
+ */
+#define RING_BUF_MPSC_DECLARE_POW2(name, pow) \
+	BUILD_ASSERT(BIT(pow) < RING_BUFFER_MAX_SIZE, \
+		RING_BUFFER_SIZE_ASSERT_MSG); \
+	static atomic_t _ring_buffer_data_##name[BIT(pow)]; \
+	struct ring_buf_mpsc name = { \
+		.mask = BIT(pow) - 1, \
+		.buf = _ring_buffer_data_##name \
+	}
+
+/**
+ * @brief Initialize a multi-producer ring buffer.
+ *
+ * @param buf Address of ring buffer.
+ * @param size32 Size of the data space, in 32-bit words, a power of 2.
+ * @param data Ring buffer data space.
+ */
+void ring_buf_mpsc_init(struct ring_buf_mpsc *buf, uint32_t size32,
+			uint32_t *data);
+
+/**
+ * @brief Reserve room for a record.
+ *
+ * May be called from any context, concurrently with other producers and
+ * the consumer. The record takes 4 bytes plus @a size rounded up to
+ * 4 bytes in the buffer, and its data must fit contiguously.
+ *
+ * @param buf Address of ring buffer.
+ * @param size Size of the record data, in bytes.
+ *
+ * @return Address of the record data, word aligned, to be committed with
+ *	   ring_buf_mpsc_commit(). NULL if the buffer is too full, the
+ *	   record is then counted as dropped.
+ */
+void *ring_buf_mpsc_reserve(struct ring_buf_mpsc *buf, uint32_t size);
+
+/**
+ * @brief Make a reserved record available to the consumer.
+ *
+ * @param buf Address of ring buffer.
+ * @param data Record data, as returned by ring_buf_mpsc_reserve().
+ */
+void ring_buf_mpsc_commit(struct ring_buf_mpsc *buf, void *data);
+
+/**
+ * @brief Write a record.
+ *
+ * Reserve, copy and commit in one call.
+ *
+ * @param buf Address of ring buffer.
+ * @param data Record data.
+ * @param size Size of the record data, in bytes.
+ *
+ * @retval 0 Record written.
+ * @retval -ENOMEM The buffer is too full.
+ */
+int ring_buf_mpsc_put(struct ring_buf_mpsc *buf, const void *data,
+		      uint32_t size);
+
+/**
+ * @brief Get the next committed record, in place.
+ *
+ * Only one context may consume the records.
+ *
+ * @param buf Address of ring buffer.
+ * @param size Size of the record data, in bytes.
+ *
+ * @return Address of the record data, to be freed with
+ *	   ring_buf_mpsc_free() before the next claim. NULL if the next
+ *	   record is not committed yet or the buffer is empty.
+ */
+void *ring_buf_mpsc_claim(struct ring_buf_mpsc *buf, uint32_t *size);
+
+/**
+ * @brief Free the record claimed last.
+ *
+ * @param buf Address of ring buffer.
+ * @param data Record data, as returned by ring_buf_mpsc_claim().
+ */
+void ring_buf_mpsc_free(struct ring_buf_mpsc *buf, void *data);
+
+/**
+ * @brief Read the next committed record.
+ *
+ * Claim, copy and free in one call.
+ *
+ * @param buf Address of ring buffer.
+ * @param data Output buffer.
+ * @param size Size of the output buffer, in bytes.
+ *
+ * @return Size of the record data, in bytes. -EAGAIN if there is no
+ *	   record available, -EMSGSIZE if the record is larger than the
+ *	   output buffer; it is then left in the ring buffer.
+ */
+int ring_buf_mpsc_get(struct ring_buf_mpsc *buf, void *data, uint32_t size);
+
+/**
+ * @brief Get the number of records dropped because the buffer was full.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return Number of records dropped.
+ */
+static inline uint32_t ring_buf_mpsc_dropped_get(struct ring_buf_mpsc *buf)
+{
+	return (uint32_t)atomic_get(&buf->dropped);
+}
+
 /**
  * @}
  */
@@ -52,6 +52,30 @@ struct sys_heap {
 	struct z_heap *heap;
 	void *init_mem;
 	size_t init_bytes;
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	size_t allocated_bytes;
+	size_t max_allocated_bytes;
+#endif
+};
+
+/**
+ * @brief sys_heap runtime statistics
+ *
+ * All byte counts are in terms of usable chunk memory, i.e. they
+ * include the rounding of each request up to whole chunks but not
+ * the chunk headers.
+ */
+struct sys_heap_runtime_stats {
+	/** Bytes in free chunks */
+	size_t free_bytes;
+	/** Bytes in allocated chunks */
+	size_t allocated_bytes;
+	/** Highest value of allocated_bytes since init or last reset */
+	size_t max_allocated_bytes;
+	/** Size of the largest single free chunk, i.e. the largest
+	 * allocation that can currently succeed
+	 */
+	size_t largest_free_bytes;
 };
 
 struct z_heap_stress_result {
@@ -201,6 +225,47 @@ void sys_heap_stress(void *(*alloc_fn)(void *arg, size_t bytes),
 		     int target_percent,
 		     struct z_heap_stress_result *result);
 
+/** @brief Get sys_heap runtime statistics
+ *
+ * Fills @a stats with the current usage of the heap.  The free space
+ * is gathered from the free lists and takes time proportional to the
+ * number of free chunks.  Requires CONFIG_SYS_HEAP_RUNTIME_STATS.
+ *
+ * @note Like the rest of the sys_heap API this is unsynchronized, the
+ * caller must provide locking.
+ *
+ * @param heap Heap to query
+ * @param stats Struct into which to store the statistics
+ * @return 0 on success, -EINVAL on a NULL argument
+ */
+int sys_heap_runtime_stats_get(struct sys_heap *heap,
+			       struct sys_heap_runtime_stats *stats);
+
+/** @brief Reset the sys_heap allocation watermark
+ *
+ * Sets max_allocated_bytes to the number of bytes currently
+ * allocated.  Requires CONFIG_SYS_HEAP_RUNTIME_STATS.
+ *
+ * @param heap Heap to reset
+ * @return 0 on success, -EINVAL on a NULL argument
+ */
+int sys_heap_runtime_stats_reset_max(struct sys_heap *heap);
+
+/** @brief Get sys_heap free list occupancy
+ *
+ * Stores the number of free chunks in each power-of-two size bucket
+ * of the heap into @a counts.  Bucket @a i holds chunks of at least
+ * 2^i and less than 2^(i+1) chunk units above the minimum chunk size.
+ *
+ * @param heap Heap to query
+ * @param counts Array to receive the per-bucket chunk counts
+ * @param max_buckets Number of entries in @a counts
+ * @return Number of buckets of the heap (which may exceed
+ *         @a max_buckets), or -EINVAL on a NULL argument
+ */
+int sys_heap_bucket_stats_get(struct sys_heap *heap, uint32_t *counts,
+			      int max_buckets);
+
 /** @brief Print heap internal structure information to the console
  *
  * Print information on the heap structure such as its size, chunk buckets,
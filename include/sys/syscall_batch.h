@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_SYSCALL_BATCH_H_
+#define ZEPHYR_INCLUDE_SYS_SYSCALL_BATCH_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <syscall.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup syscall_batch_apis System Call Batching APIs
+ * @ingroup usermode_apis
+ * @{
+ */
+
+/**
+ * @brief Descriptor of one system call in a batch
+ *
+ * The arguments are laid out exactly as the generated system call
+ * wrappers in <syscalls/...h> pass them to arch_syscall_invoke6():
+ * each argument is cast to uintptr_t, 64-bit arguments take two slots
+ * on 32-bit targets (low word first), and system calls with more than
+ * six argument slots or a 64-bit return value take a pointer to the
+ * remaining slots or to the return value in the last slot.
+ */
+struct k_syscall_desc {
+	/** System call ID, one of the K_SYSCALL_* values */
+	uintptr_t id;
+
+	/** Marshalled arguments */
+	uintptr_t args[6];
+
+	/** Return value, written back when the call has been executed */
+	uintptr_t ret;
+};
+
+/**
+ * @brief Initializer for a system call descriptor
+ *
+ * @param _id System call ID, for example K_SYSCALL_K_SEM_GIVE
+ * @param ... Up to six marshalled arguments
+ */
+#define K_SYSCALL_DESC_INITIALIZER(_id, ...) \
+	{ \
+	.id = (_id), \
+	.args = { __VA_ARGS__ }, \
+	.ret = 0, \
+	}
+
+/**
+ * @brief Execute a batch of system calls with a single privilege switch
+ *
+ * Runs the system calls described by @a descs in order, exactly as if
+ * they had been made one after another by the calling thread, and
+ * stores the value each returns in its descriptor.  As each call is
+ * verified individually, an invalid argument has the same effect as in
+ * a regular system call, which usually means the calling thread is
+ * terminated.  Calls that block do so as usual before the next one in
+ * the batch is made.
+ *
+ * Batches cannot be nested.
+ *
+ * @param descs Array of system call descriptors, in user memory
+ * @param count Number of descriptors in @a descs
+ *
+ * @return The number of calls executed, which is short of @a count when
+ *         a descriptor names an invalid system call, or -ENOTSUP when
+ *         not called from user mode.
+ */
+__syscall int k_syscall_batch(struct k_syscall_desc *descs, size_t count);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#include <syscalls/syscall_batch.h>
+
+#endif /* ZEPHYR_INCLUDE_SYS_SYSCALL_BATCH_H_ */
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_VECMATH_H_
+#define ZEPHYR_INCLUDE_SYS_VECMATH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup vecmath Vector math
+ * @ingroup os_services
+ *
+ * Fixed point vector kernels for drivers and applications, e.g. sensor
+ * sample decoding or audio filtering. On Cortex-M, they are performed by
+ * CMSIS-DSP (CONFIG_VECMATH_CMSIS_DSP), with its SIMD or Helium variants
+ * where the CPU has them. Elsewhere, portable C implementations give the
+ * same results, bit for bit.
+ *
+ * Samples are in the Q15 (int16_t) and Q31 (int32_t) formats, as in
+ * CMSIS-DSP.
+ *
+ * @{
+ */
+
+/**
+ * @brief Length of the coefficient array of a Q15 FIR filter.
+ *
+ * The coefficients past the taps of the filter are read by the vector
+ * implementations and must be zero.
+ *
+ * @param taps Number of taps of the filter.
+ */
+#define VECMATH_FIR_Q15_COEFFS_LEN(taps) ROUND_UP(taps, 8)
+
+/**
+ * @brief Length of the state array of a Q15 FIR filter.
+ *
+ * @param taps Number of taps of the filter.
+ * @param block Largest number of samples filtered at once.
+ */
+#define VECMATH_FIR_Q15_STATE_LEN(taps, block) \
+	((taps) + ROUND_UP(block, 8) + (block) - 1)
+
+/** @brief Q15 FIR filter. */
+struct vecmath_fir_q15 {
+	const int16_t *coeffs;
+	int16_t *state;
+	uint16_t taps;
+	uint16_t block;
+};
+
+/**
+ * @brief Dot product of Q15 vectors.
+ *
+ * The products are accumulated on 64 bits, with no loss of precision.
+ *
+ * @param a First vector.
+ * @param b Second vector.
+ * @param len Number of elements of the vectors.
+ *
+ * @return Sum of the products, in the Q34.30 format.
+ */
+int64_t vecmath_dot_q15(const int16_t *a, const int16_t *b, size_t len);
+
+/**
+ * @brief Copy a Q15 vector, scaling it.
+ *
+ * Each element is multiplied by @p scale, shifted left by @p shift and
+ * saturated: dst[i] = sat(src[i] * scale * 2^shift). The vectors may be
+ * the same for an in-place scaling.
+ *
+ * @param dst Destination vector.
+ * @param src Source vector.
+ * @param scale Scale factor, in the Q15 format.
+ * @param shift Number of bits to shift the products by, to the right if
+ *	  negative, from -16 to 15.
+ * @param len Number of elements of the vectors.
+ */
+void vecmath_copy_scale_q15(int16_t *dst, const int16_t *src, int16_t scale,
+			    int8_t shift, size_t len);
+
+/**
+ * @brief Convert a Q15 vector to Q31.
+ *
+ * @param dst Destination vector.
+ * @param src Source vector.
+ * @param len Number of elements of the vectors.
+ */
+void vecmath_q15_to_q31(int32_t *dst, const int16_t *src, size_t len);
+
+/**
+ * @brief Convert a Q31 vector to Q15.
+ *
+ * The 16 least significant bits of the elements are truncated.
+ *
+ * @param dst Destination vector.
+ * @param src Source vector.
+ * @param len Number of elements of the vectors.
+ */
+void vecmath_q31_to_q15(int16_t *dst, const int32_t *src, size_t len);
+
+/**
+ * @brief Initialize a Q15 FIR filter.
+ *
+ * The filter computes y[n] = b[0] * x[n] + ... + b[taps - 1] *
+ * x[n - taps + 1], accumulated on 64 bits, truncated to Q15 and saturated.
+ *
+ * @param fir Filter.
+ * @param coeffs Coefficients in time reversed order, b[taps - 1] first,
+ *	  in an array of VECMATH_FIR_Q15_COEFFS_LEN(taps) elements, zero
+ *	  padded. The array is used by the filter until it is no longer
+ *	  needed.
+ * @param taps Number of taps. It must be even, and at least 4: a zero tap
+ *	  is added to filters of an odd number of taps.
+ * @param state Array of VECMATH_FIR_Q15_STATE_LEN(taps, block) elements,
+ *	  used by the filter until it is no longer needed.
+ * @param block Largest number of samples filtered at once.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if the number of taps is not supported.
+ */
+int vecmath_fir_q15_init(struct vecmath_fir_q15 *fir, const int16_t *coeffs,
+			 uint16_t taps, int16_t *state, uint16_t block);
+
+/**
+ * @brief Filter Q15 samples.
+ *
+ * The filter state carries the previous samples over from a call to the
+ * next, for the samples of a stream to be filtered block by block.
+ *
+ * @param fir Filter.
+ * @param dst Filtered samples.
+ * @param src Samples to filter.
+ * @param len Number of samples, at most the block size of the filter.
+ */
+void vecmath_fir_q15(struct vecmath_fir_q15 *fir, int16_t *dst,
+		     const int16_t *src, size_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_VECMATH_H_ */
@@ -25,6 +25,13 @@ extern "C" {
 static inline void z_init_timeout(struct _timeout *to)
 {
 	sys_dnode_init(&to->node);
+#ifdef CONFIG_TIMEOUT_SLACK
+	to->slack = 0;
+#endif
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	/* Queue locked to abort or query the timeout until it is added */
+	to->cpu = 0;
+#endif
 }
 
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
@@ -58,6 +65,10 @@ int32_t z_get_next_timeout_expiry(void);
 
 void z_set_timeout_expiry(int32_t ticks, bool is_idle);
 
+#ifdef CONFIG_TIMEOUT_PER_CPU
+void z_timeout_ipi(void);
+#endif
+
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout);
 
 #else
@@ -257,6 +257,13 @@
  */
 #define sys_port_trace_k_thread_sched_ready(thread)
 
+/**
+ * @brief Trace the scheduling latency of a thread being switched in
+ * @param thread Thread object
+ * @param cycles Cycles spent ready to run, see CONFIG_SCHED_LATENCY_STATS
+ */
+#define sys_port_trace_k_thread_sched_latency(thread, cycles)
+
 /**
  * @brief Trace implicit thread pend invocation by the scheduler
  * @param thread Thread object
@@ -1042,6 +1049,31 @@
  */
 #define sys_port_trace_k_queue_get_exit(queue, timeout, ret)
 
+/**
+ * @brief Trace Queue get batch attempt enter
+ * @param queue Queue object
+ * @param max Maximum number of items
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_queue_get_batch_enter(queue, max, timeout)
+
+/**
+ * @brief Trace Queue get batch attempt blocking
+ * @param queue Queue object
+ * @param max Maximum number of items
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_queue_get_batch_blocking(queue, max, timeout)
+
+/**
+ * @brief Trace Queue get batch attempt outcome
+ * @param queue Queue object
+ * @param max Maximum number of items
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_queue_get_batch_exit(queue, max, timeout, ret)
+
 /**
  * @brief Trace Queue remove enter
  * @param queue Queue object
@@ -1195,6 +1227,25 @@
  */
 #define sys_port_trace_k_fifo_get_exit(fifo, timeout, ret)
 
+/**
+ * @brief Trace FIFO Queue get batch entry
+ * @param fifo FIFO object
+ * @param list Syslist object
+ * @param max Maximum number of items
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_fifo_get_batch_enter(fifo, list, max, timeout)
+
+/**
+ * @brief Trace FIFO Queue get batch exit
+ * @param fifo FIFO object
+ * @param list Syslist object
+ * @param max Maximum number of items
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_fifo_get_batch_exit(fifo, list, max, timeout, ret)
+
 /**
  * @brief Trace FIFO Queue peek head entry
  * @param fifo FIFO object
@@ -1291,6 +1342,25 @@
  */
 #define sys_port_trace_k_lifo_get_exit(lifo, timeout, ret)
 
+/**
+ * @brief Trace LIFO Queue get batch entry
+ * @param lifo LIFO object
+ * @param list Syslist object
+ * @param max Maximum number of items
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_lifo_get_batch_enter(lifo, list, max, timeout)
+
+/**
+ * @brief Trace LIFO Queue get batch exit
+ * @param lifo LIFO object
+ * @param list Syslist object
+ * @param max Maximum number of items
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_lifo_get_batch_exit(lifo, list, max, timeout, ret)
+
 /**
  * @}
  */ /* end of lifo_tracing_apis */
@@ -1919,6 +1989,23 @@
 
 #define sys_port_trace_pm_device_disable_exit(dev)
 
+/**
+ * @brief Trace the end of a stage of the network RX path
+ * @param pkt Network packet
+ * @param stage Stage, see enum net_stats_rx_stage
+ * @param usec Time spent in the stage in microseconds
+ */
+#define sys_port_trace_net_pkt_rx_stage(pkt, stage, usec)
+
+/**
+ * @brief Trace a profiler sample
+ * @param thread Interrupted thread, NULL in an ISR
+ * @param pc Interrupted program counter
+ * @param lr Link register of the interrupted code
+ * @param irq Interrupted IRQ, PROFILER_IRQ_NONE in a thread
+ */
+#define sys_port_trace_profiler_sample(thread, pc, lr, irq)
+
 
 #if defined CONFIG_PERCEPIO_TRACERECORDER
 #include "tracing_tracerecorder.h"
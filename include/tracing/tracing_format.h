@@ -72,6 +72,15 @@ void tracing_format_raw_data(uint8_t *data, uint32_t length);
  */
 void tracing_format_data(tracing_data_t *tracing_data_array, uint32_t count);
 
+/**
+ * @brief Output the flight recorder.
+ *
+ * Outputs the packets recorded during the last
+ * CONFIG_TRACING_FLIGHT_RECORDER_WINDOW milliseconds. Nothing is recorded
+ * until they have all been output.
+ */
+void tracing_flight_recorder_trigger(void);
+
 #ifdef __cplusplus
 }
 #endif
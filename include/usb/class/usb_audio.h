@@ -203,6 +203,19 @@ typedef void (*usb_audio_data_completion_cb_t)(const struct device *dev,
 typedef void (*usb_audio_feature_updated_cb_t)(const struct device *dev,
 					       const struct usb_audio_fu_evt *evt);
 
+/**
+ * @brief Callback type used to inform the app that a memory slab block was
+ *	  successfully send/received.
+ *
+ * @param dev	The device for which the callback was called.
+ * @param block Pointer to the memory slab block that was successfully
+ *		send/received. The application owns the block and is
+ *		responsible for freeing it, e.g. by passing it to i2s_write().
+ * @param size	Amount of data that were successfully send/received.
+ */
+typedef void (*usb_audio_block_completion_cb_t)(const struct device *dev,
+						void *block, size_t size);
+
 /**
  * @brief Audio callbacks used to interact with audio devices by user App.
  *
@@ -231,6 +244,42 @@ struct usb_audio_ops {
 
 	/* Callback called when features were modified by the Host */
 	usb_audio_feature_updated_cb_t feature_update_cb;
+
+#ifdef CONFIG_USB_AUDIO_MEM_SLAB
+	/* Callback called when a block given to usb_audio_send_block() was
+	 * successfully written. Applicable for headset and microphone.
+	 */
+	usb_audio_block_completion_cb_t block_written_cb;
+
+	/* Callback called when data were received into a block of the slab
+	 * set with usb_audio_rx_slab_set(). Applicable for headset and
+	 * headphones.
+	 */
+	usb_audio_block_completion_cb_t block_received_cb;
+#endif
+};
+
+/**
+ * @brief Statistics of the memory slab block transfers.
+ *
+ * The depths are the numbers of blocks of the slab in use when a block is
+ * received or sent. When the slab is shared with I2S they are the frames
+ * queued between USB and I2S, which multiplied by the frame duration give
+ * the latency of the path.
+ */
+struct usb_audio_block_stats {
+	/* Blocks received from the Host. */
+	uint32_t rx_blocks;
+	/* Frames dropped because no block of the RX slab was free. */
+	uint32_t rx_dropped;
+	/* Maximum number of blocks of the RX slab in use. */
+	uint32_t rx_depth_max;
+	/* Blocks sent to the Host. */
+	uint32_t tx_blocks;
+	/* Blocks which could not be sent. */
+	uint32_t tx_errors;
+	/* Maximum number of blocks of the TX slab in use. */
+	uint32_t tx_depth_max;
 };
 
 /** @brief Get the frame size that is accepted by the Host.
@@ -284,4 +333,55 @@ void usb_audio_register(const struct device *dev,
 int usb_audio_send(const struct device *dev, struct net_buf *buffer,
 		   size_t len);
 
+#if defined(CONFIG_USB_AUDIO_MEM_SLAB) || defined(__DOXYGEN__)
+/**
+ * @brief Receive data into memory slab blocks
+ *
+ * Data received by the device is read straight into blocks allocated from
+ * @p slab and passed to the block_received_cb callback instead of
+ * data_received_cb. Using the TX slab of an I2S device lets the application
+ * hand the blocks over to i2s_write() without copying them.
+ *
+ * @param dev  USB Audio device which receives the data
+ *	       over its ISO OUT endpoint
+ * @param slab Memory slab whose blocks are at least as large as the
+ *	       endpoint, NULL to receive into net_buf chunks again.
+ *
+ * @return 0 on success, negative error on fail
+ */
+int usb_audio_rx_slab_set(const struct device *dev, struct k_mem_slab *slab);
+
+/**
+ * @brief Send a memory slab block using USB Audio device
+ *
+ * Same as usb_audio_send(), for data held in a block of a memory slab, e.g.
+ * one obtained with i2s_read(). After the block was sent successfully it is
+ * passed to the block_written_cb callback if the application uses one or
+ * automatically freed to @p slab otherwise. In case of sending error the
+ * block is still owned by the user.
+ *
+ * @param dev   USB Audio device which will send the data
+ *		over its ISO IN endpoint
+ * @param block Block to be send.
+ * @param len   Length of the data to be send, see
+ *		usb_audio_get_in_frame_size().
+ * @param slab  Memory slab the block belongs to.
+ *
+ * @return 0 on success, negative error on fail
+ */
+int usb_audio_send_block(const struct device *dev, void *block, size_t len,
+			 struct k_mem_slab *slab);
+
+/**
+ * @brief Get the statistics of the memory slab block transfers
+ *
+ * @param dev   USB Audio device
+ * @param stats Structure filled with the statistics.
+ * @param reset Reset the statistics once read.
+ */
+void usb_audio_block_stats_get(const struct device *dev,
+			       struct usb_audio_block_stats *stats,
+			       bool reset);
+#endif /* CONFIG_USB_AUDIO_MEM_SLAB */
+
 #endif /* ZEPHYR_INCLUDE_USB_CLASS_AUDIO_H_ */
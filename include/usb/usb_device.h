@@ -360,6 +360,7 @@ typedef void (*usb_transfer_callback)(uint8_t ep, int tsize, void *priv);
 #define USB_TRANS_READ       BIT(0)   /** Read transfer flag */
 #define USB_TRANS_WRITE      BIT(1)   /** Write transfer flag */
 #define USB_TRANS_NO_ZLP     BIT(2)   /** No zero-length packet flag */
+#define USB_TRANS_QUEUE      BIT(3)   /** Queue behind ongoing transfers */
 
 /**
  * @brief Transfer management endpoint callback
@@ -376,6 +377,12 @@ void usb_transfer_ep_callback(uint8_t ep, enum usb_dc_ep_cb_status_code);
  * and can be executed in IRQ context. The provided callback will be called
  * on transfer completion (or error) in thread context.
  *
+ * Only one transfer per endpoint is started at a time. With the
+ * USB_TRANS_QUEUE flag, a transfer on an endpoint which has ongoing
+ * transfers is queued and started as soon as the previous one completes,
+ * instead of failing with -EBUSY. Every queued transfer takes one of the
+ * CONFIG_USB_MAX_NUM_TRANSFERS slots.
+ *
  * @param[in]  ep           Endpoint address corresponding to the one
  *                          listed in the device configuration table
  * @param[in]  data         Pointer to data buffer to write-to/read-from
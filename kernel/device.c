@@ -7,7 +7,10 @@
 #include <string.h>
 #include <device.h>
 #include <sys/atomic.h>
+#include <sys/fnv1a.h>
 #include <syscall_handler.h>
+#include <kernel_internal.h>
+#include <debug/boot_profile.h>
 
 extern const struct init_entry __init_start[];
 extern const struct init_entry __init_PRE_KERNEL_1_start[];
@@ -25,6 +28,43 @@ extern const struct device __device_end[];
 
 extern uint32_t __device_init_status_start[];
 
+#ifdef CONFIG_DEVICE_DEFERRED_INIT
+/* The devices required by a device initialized at boot are initialized at
+ * boot too. The passes go from the last device, as devices mostly follow
+ * the devices they require, and repeat until no flag is cleared, for the
+ * chains of requirements that do not.
+ */
+static void deferred_required_clear(void)
+{
+	bool changed;
+
+	do {
+		changed = false;
+
+		for (size_t i = __device_end - __device_start; i-- > 0;) {
+			const struct device *dev = &__device_start[i];
+			const device_handle_t *deps;
+			size_t count = 0;
+
+			if (dev->state->deferred) {
+				continue;
+			}
+
+			deps = device_required_handles_get(dev, &count);
+			for (size_t j = 0; j < count; j++) {
+				const struct device *dep =
+					device_from_handle(deps[j]);
+
+				if (dep != NULL && dep->state->deferred) {
+					dep->state->deferred = false;
+					changed = true;
+				}
+			}
+		}
+	} while (changed);
+}
+#endif /* CONFIG_DEVICE_DEFERRED_INIT */
+
 static inline void device_pm_state_init(const struct device *dev)
 {
 #ifdef CONFIG_PM_DEVICE
@@ -51,8 +91,168 @@ void z_device_state_init(void)
 		z_object_init(dev);
 		++dev;
 	}
+
+#ifdef CONFIG_DEVICE_DEFERRED_INIT
+	deferred_required_clear();
+#endif
 }
 
+static void init_entry_run(const struct init_entry *entry)
+{
+	const struct device *dev = entry->dev;
+	timing_t start = boot_profile_begin();
+	int rc = entry->init(dev);
+
+	z_boot_profile_entry_end(entry, start);
+
+	if (dev != NULL) {
+		/* Mark device initialized.  If initialization
+		 * failed, record the error condition.
+		 */
+		if (rc != 0) {
+			if (rc < 0) {
+				rc = -rc;
+			}
+			if (rc > UINT8_MAX) {
+				rc = UINT8_MAX;
+			}
+			dev->state->init_res = rc;
+		}
+		dev->state->initialized = true;
+	}
+}
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+
+#define PARALLEL_THREADS CONFIG_DEVICE_INIT_PARALLEL_THREADS
+
+static K_THREAD_STACK_ARRAY_DEFINE(parallel_stacks, PARALLEL_THREADS,
+				   CONFIG_DEVICE_INIT_PARALLEL_STACK_SIZE);
+
+static struct {
+	struct k_thread thread;
+	/* Entry initialized by the thread, NULL if the slot is free. */
+	const struct init_entry *entry;
+	bool done;
+} parallel_slots[PARALLEL_THREADS];
+
+/* Protects the slots, signalled when a parallel entry is done. */
+static K_MUTEX_DEFINE(parallel_lock);
+static K_CONDVAR_DEFINE(parallel_done);
+
+/* Called with parallel_lock held. */
+static bool parallel_pending(const struct device *dev)
+{
+	for (int i = 0; i < PARALLEL_THREADS; i++) {
+		if (parallel_slots[i].entry != NULL &&
+		    parallel_slots[i].entry->dev == dev &&
+		    !parallel_slots[i].done) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void parallel_thread(void *p1, void *p2, void *p3)
+{
+	const struct init_entry *entry = p1;
+	bool *done = p2;
+	const device_handle_t *deps;
+	size_t count = 0;
+
+	ARG_UNUSED(p3);
+
+	/* The required devices started earlier may still be initializing,
+	 * the others are initialized already.
+	 */
+	deps = device_required_handles_get(entry->dev, &count);
+
+	k_mutex_lock(&parallel_lock, K_FOREVER);
+	for (size_t i = 0; i < count; i++) {
+		const struct device *dep = device_from_handle(deps[i]);
+
+		while (dep != NULL && parallel_pending(dep)) {
+			k_condvar_wait(&parallel_done, &parallel_lock,
+				       K_FOREVER);
+		}
+	}
+	k_mutex_unlock(&parallel_lock);
+
+	init_entry_run(entry);
+
+	k_mutex_lock(&parallel_lock, K_FOREVER);
+	*done = true;
+	k_condvar_broadcast(&parallel_done);
+	k_mutex_unlock(&parallel_lock);
+}
+
+/* Wait for the thread of a slot to end, and free the slot. */
+static void parallel_slot_free(int i)
+{
+	k_mutex_lock(&parallel_lock, K_FOREVER);
+	while (!parallel_slots[i].done) {
+		k_condvar_wait(&parallel_done, &parallel_lock, K_FOREVER);
+	}
+	k_mutex_unlock(&parallel_lock);
+
+	(void)k_thread_join(&parallel_slots[i].thread, K_FOREVER);
+	parallel_slots[i].entry = NULL;
+}
+
+static void parallel_start(const struct init_entry *entry)
+{
+	int i;
+
+	/* Take a free slot, or the first one to be done. */
+	k_mutex_lock(&parallel_lock, K_FOREVER);
+	while (true) {
+		for (i = 0; i < PARALLEL_THREADS; i++) {
+			if (parallel_slots[i].entry == NULL ||
+			    parallel_slots[i].done) {
+				break;
+			}
+		}
+
+		if (i < PARALLEL_THREADS) {
+			break;
+		}
+
+		k_condvar_wait(&parallel_done, &parallel_lock, K_FOREVER);
+	}
+	k_mutex_unlock(&parallel_lock);
+
+	if (parallel_slots[i].entry != NULL) {
+		parallel_slot_free(i);
+	}
+
+	parallel_slots[i].entry = entry;
+	parallel_slots[i].done = false;
+
+	k_thread_create(&parallel_slots[i].thread, parallel_stacks[i],
+			K_THREAD_STACK_SIZEOF(parallel_stacks[i]),
+			parallel_thread, (void *)entry,
+			&parallel_slots[i].done, NULL,
+			k_thread_priority_get(k_current_get()), 0, K_NO_WAIT);
+}
+
+static void parallel_wait_all(void)
+{
+	for (int i = 0; i < PARALLEL_THREADS; i++) {
+		if (parallel_slots[i].entry != NULL) {
+			parallel_slot_free(i);
+		}
+	}
+}
+
+static bool parallel_level(int32_t level)
+{
+	return level == _SYS_INIT_LEVEL_POST_KERNEL ||
+	       level == _SYS_INIT_LEVEL_APPLICATION;
+}
+
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
+
 /**
  * @brief Execute all the init entry initialization functions at a given level
  *
@@ -78,29 +278,164 @@ void z_sys_init_run_level(int32_t level)
 		__init_end,
 	};
 	const struct init_entry *entry;
+	timing_t start = z_boot_profile_level_begin(level);
 
 	for (entry = levels[level]; entry < levels[level+1]; entry++) {
-		const struct device *dev = entry->dev;
-		int rc = entry->init(dev);
-
-		if (dev != NULL) {
-			/* Mark device initialized.  If initialization
-			 * failed, record the error condition.
-			 */
-			if (rc != 0) {
-				if (rc < 0) {
-					rc = -rc;
-				}
-				if (rc > UINT8_MAX) {
-					rc = UINT8_MAX;
-				}
-				dev->state->init_res = rc;
+		/* Initialized on first use, see device_init(). */
+		if (z_device_deferred(entry->dev)) {
+			continue;
+		}
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+		if (parallel_level(level)) {
+			if (entry->dev != NULL &&
+			    entry->dev->state->parallel_init) {
+				parallel_start(entry);
+				continue;
 			}
-			dev->state->initialized = true;
+
+			/* Nothing is known of what other entries need. */
+			parallel_wait_all();
 		}
+#endif
+		init_entry_run(entry);
+	}
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+	if (parallel_level(level)) {
+		parallel_wait_all();
 	}
+#endif
+
+	z_boot_profile_level_end(level, start);
 }
 
+#ifdef CONFIG_DEVICE_DEFERRED_INIT
+static K_MUTEX_DEFINE(deferred_lock);
+
+static const struct init_entry *init_entry_find(const struct device *dev)
+{
+	const struct init_entry *entry;
+
+	for (entry = __init_start; entry < __init_end; entry++) {
+		if (entry->dev == dev) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static void deferred_init(const struct device *dev)
+{
+	const struct init_entry *entry;
+	const device_handle_t *deps;
+	size_t count = 0;
+
+	if (dev->state->initialized) {
+		return;
+	}
+
+	/* The required devices may be deferred too. */
+	deps = device_required_handles_get(dev, &count);
+	for (size_t i = 0; i < count; i++) {
+		const struct device *dep = device_from_handle(deps[i]);
+
+		if (z_device_deferred(dep)) {
+			deferred_init(dep);
+		}
+	}
+
+	entry = init_entry_find(dev);
+	if (entry != NULL) {
+		init_entry_run(entry);
+	}
+}
+
+int device_init(const struct device *dev)
+{
+	if (dev == NULL) {
+		return -ENODEV;
+	}
+
+	if (z_device_deferred(dev)) {
+		if (k_is_in_isr()) {
+			return -EWOULDBLOCK;
+		}
+
+		if (k_is_pre_kernel()) {
+			deferred_init(dev);
+		} else {
+			(void)k_mutex_lock(&deferred_lock, K_FOREVER);
+			deferred_init(dev);
+			(void)k_mutex_unlock(&deferred_lock);
+		}
+	}
+
+	return dev->state->initialized ? -(int)dev->state->init_res : -ENODEV;
+}
+#endif /* CONFIG_DEVICE_DEFERRED_INIT */
+
+/* Ready to be returned by device_get_binding(), a deferred device being
+ * initialized on first use.
+ */
+static bool binding_ready(const struct device *dev)
+{
+	if (z_device_deferred(dev)) {
+		return device_init(dev) == 0;
+	}
+
+	return z_device_ready(dev);
+}
+
+#ifdef CONFIG_DEVICE_NAME_HASH
+extern const struct z_device_name_slot __device_names_start[];
+
+/* Must match the hash of gen_handles.py: FNV-1a of the name, then a
+ * different finalizer for every displacement.
+ */
+static uint32_t name_hash(const char *name)
+{
+	return fnv1a_32_str(FNV1A_32_INIT, name);
+}
+
+static uint32_t name_hash_mix(uint32_t hash, uint16_t disp)
+{
+	hash ^= disp * 0x9e3779b9U;
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6bU;
+	hash ^= hash >> 13;
+	hash *= 0xc2b2ae35U;
+	hash ^= hash >> 16;
+
+	return hash;
+}
+
+/* The device the name hashes to, if it has that name and is ready. */
+static const struct device *name_hash_lookup(const char *name)
+{
+	size_t count = __device_end - __device_start;
+	uint32_t hash = name_hash(name);
+	const struct device *dev;
+	uint16_t disp;
+
+	if (count == 0) {
+		return NULL;
+	}
+
+	disp = __device_names_start[name_hash_mix(hash, 0) % count].disp;
+	dev = &__device_start[
+		__device_names_start[name_hash_mix(hash, disp) % count].ord];
+
+	if ((dev->name == name || strcmp(name, dev->name) == 0) &&
+	    binding_ready(dev)) {
+		return dev;
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_DEVICE_NAME_HASH */
+
 const struct device *z_impl_device_get_binding(const char *name)
 {
 	const struct device *dev;
@@ -112,19 +447,30 @@ const struct device *z_impl_device_get_binding(const char *name)
 		return NULL;
 	}
 
+#ifdef CONFIG_DEVICE_NAME_HASH
+	/* Every device name hashes to its own slot. Names which are not
+	 * device names, and devices sharing their name with a device that
+	 * is not ready, are left to the search below.
+	 */
+	dev = name_hash_lookup(name);
+	if (dev != NULL) {
+		return dev;
+	}
+#endif
+
 	/* Split the search into two loops: in the common scenario, where
 	 * device names are stored in ROM (and are referenced by the user
 	 * with CONFIG_* macros), only cheap pointer comparisons will be
 	 * performed. Reserve string comparisons for a fallback.
 	 */
 	for (dev = __device_start; dev != __device_end; dev++) {
-		if (z_device_ready(dev) && (dev->name == name)) {
+		if ((dev->name == name) && binding_ready(dev)) {
 			return dev;
 		}
 	}
 
 	for (dev = __device_start; dev != __device_end; dev++) {
-		if (z_device_ready(dev) && (strcmp(name, dev->name) == 0)) {
+		if ((strcmp(name, dev->name) == 0) && binding_ready(dev)) {
 			return dev;
 		}
 	}
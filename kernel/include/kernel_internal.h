@@ -20,6 +20,8 @@
 
 #ifndef _ASMLANGUAGE
 
+#include <timing/types.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -56,6 +58,64 @@ static inline void z_bss_zero_pinned(void)
 
 FUNC_NORETURN void z_cstart(void);
 
+/* Boot profiling hooks, implemented in subsys/debug/boot_profile.c */
+#define Z_BOOT_PROFILE_BSS_ZERO 0
+#define Z_BOOT_PROFILE_DATA_COPY 1
+#define Z_BOOT_PROFILE_EARLY_PHASES 2
+
+struct init_entry;
+
+#ifdef CONFIG_BOOT_PROFILING
+timing_t z_boot_profile_early_begin(void);
+void z_boot_profile_early_end(int phase, timing_t start);
+void z_boot_profile_init(void);
+timing_t z_boot_profile_level_begin(int32_t level);
+void z_boot_profile_level_end(int32_t level, timing_t start);
+void z_boot_profile_entry_end(const struct init_entry *entry, timing_t start);
+void z_boot_profile_done(void);
+#else
+static inline timing_t z_boot_profile_early_begin(void)
+{
+	return 0;
+}
+
+static inline void z_boot_profile_early_end(int phase, timing_t start)
+{
+	ARG_UNUSED(phase);
+	ARG_UNUSED(start);
+}
+
+static inline void z_boot_profile_init(void)
+{
+	/* Do nothing */
+}
+
+static inline timing_t z_boot_profile_level_begin(int32_t level)
+{
+	ARG_UNUSED(level);
+
+	return 0;
+}
+
+static inline void z_boot_profile_level_end(int32_t level, timing_t start)
+{
+	ARG_UNUSED(level);
+	ARG_UNUSED(start);
+}
+
+static inline void z_boot_profile_entry_end(const struct init_entry *entry,
+					    timing_t start)
+{
+	ARG_UNUSED(entry);
+	ARG_UNUSED(start);
+}
+
+static inline void z_boot_profile_done(void)
+{
+	/* Do nothing */
+}
+#endif /* CONFIG_BOOT_PROFILING */
+
 void z_device_state_init(void);
 
 extern FUNC_NORETURN void z_thread_entry(k_thread_entry_t entry,
@@ -181,6 +241,18 @@ void z_mem_domain_exit_thread(struct k_thread *thread);
 extern struct k_spinlock z_mem_domain_lock;
 #endif /* CONFIG_USERSPACE */
 
+#ifdef CONFIG_SYS_MUTEX_FAST
+/* Slow paths of a mutex whose uncontended state is kept in a lock word,
+ * which holds NULL when free or the owning thread if it was locked without
+ * entering the kernel.  Once the kernel mutex backing it is involved the
+ * word is set to 1 until the kernel mutex is released with no waiters.
+ * Recursive locking is expected to be handled by the caller.
+ */
+int z_mutex_word_lock(struct k_mutex *mutex, atomic_ptr_t *word,
+		      k_timeout_t timeout);
+int z_mutex_word_unlock(struct k_mutex *mutex, atomic_ptr_t *word);
+#endif
+
 #ifdef CONFIG_GDBSTUB
 struct gdb_ctx;
 
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_KERNEL_INCLUDE_TIMEOUT_WHEEL_H_
+#define ZEPHYR_KERNEL_INCLUDE_TIMEOUT_WHEEL_H_
+
+/**
+ * @file
+ * @brief Hierarchical timing wheel backend for the kernel timeout queue
+ *
+ * Internal to kernel/timeout.c, which provides all locking.  When this
+ * backend is in use the dticks field of a queued struct _timeout holds
+ * the absolute expiry tick instead of a delta to its predecessor.
+ */
+
+#include <kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Queue a timeout whose absolute expiry (to->dticks) is after now */
+void z_timeout_wheel_add(struct _timeout *to, uint64_t now);
+
+/* Unlink a queued timeout */
+void z_timeout_wheel_remove(struct _timeout *to);
+
+/* Earliest tick after now at which the wheel needs servicing, i.e. a
+ * timeout expiry or a cascade of a higher level slot.  UINT64_MAX if
+ * the wheel is empty.  Never later than the earliest expiry.
+ */
+uint64_t z_timeout_wheel_next(uint64_t now);
+
+/* Performs any cascading due at the tick now, then dequeues and
+ * returns one timeout expiring at that tick, or NULL if there is none.
+ * Must be called for every tick returned by z_timeout_wheel_next().
+ */
+struct _timeout *z_timeout_wheel_expire(uint64_t now);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_KERNEL_INCLUDE_TIMEOUT_WHEEL_H_ */
@@ -94,6 +94,8 @@ extern void idle(void *unused1, void *unused2, void *unused3);
 __boot_func
 void z_bss_zero(void)
 {
+	timing_t start = z_boot_profile_early_begin();
+
 	(void)memset(__bss_start, 0, __bss_end - __bss_start);
 #if DT_NODE_HAS_STATUS(DT_CHOSEN(zephyr_ccm), okay)
 	(void)memset(&__ccm_bss_start, 0,
@@ -112,6 +114,8 @@ void z_bss_zero(void)
 	(void)memset(&__gcov_bss_start, 0,
 		 ((uintptr_t) &__gcov_bss_end - (uintptr_t) &__gcov_bss_start));
 #endif
+
+	z_boot_profile_early_end(Z_BOOT_PROFILE_BSS_ZERO, start);
 }
 
 #ifdef CONFIG_LINKER_USE_BOOT_SECTION
@@ -219,6 +223,8 @@ static void bg_thread_main(void *unused1, void *unused2, void *unused3)
 	z_sys_init_run_level(_SYS_INIT_LEVEL_SMP);
 #endif
 
+	z_boot_profile_done();
+
 	extern void main(void);
 
 	main();
@@ -418,6 +424,9 @@ FUNC_NORETURN void z_cstart(void)
 
 	LOG_CORE_INIT();
 
+	/* start timing the boot as early as the kernel can */
+	z_boot_profile_init();
+
 	/* perform any architecture-specific initialization */
 	arch_kernel_init();
 
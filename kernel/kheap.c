@@ -8,6 +8,39 @@
 #include <ksched.h>
 #include <wait_q.h>
 #include <init.h>
+#include <stats/stats.h>
+
+#if defined(CONFIG_SYS_HEAP_RUNTIME_STATS) && defined(CONFIG_STATS)
+STATS_SECT_START(k_heap_stats)
+STATS_SECT_ENTRY32(allocs)
+STATS_SECT_ENTRY32(alloc_fails)
+STATS_SECT_ENTRY32(frees)
+STATS_SECT_END;
+
+STATS_NAME_START(k_heap_stats)
+STATS_NAME(k_heap_stats, allocs)
+STATS_NAME(k_heap_stats, alloc_fails)
+STATS_NAME(k_heap_stats, frees)
+STATS_NAME_END(k_heap_stats);
+
+/* Counts across all k_heaps, per-heap figures come from
+ * k_heap_runtime_stats_get()
+ */
+static STATS_SECT_DECL(k_heap_stats) k_heap_stats;
+
+static int k_heap_stats_init(const struct device *unused)
+{
+	ARG_UNUSED(unused);
+
+	return STATS_INIT_AND_REG(k_heap_stats, STATS_SIZE_32, "k_heap");
+}
+
+SYS_INIT(k_heap_stats_init, APPLICATION, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#define HEAP_STATS_INC(var) STATS_INC(k_heap_stats, var)
+#else
+#define HEAP_STATS_INC(var)
+#endif
 
 void k_heap_init(struct k_heap *h, void *mem, size_t bytes)
 {
@@ -65,6 +98,12 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 		key = k_spin_lock(&h->lock);
 	}
 
+	if (ret != NULL) {
+		HEAP_STATS_INC(allocs);
+	} else {
+		HEAP_STATS_INC(alloc_fails);
+	}
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, h, timeout, ret);
 
 	k_spin_unlock(&h->lock, key);
@@ -87,6 +126,9 @@ void k_heap_free(struct k_heap *h, void *mem)
 	k_spinlock_key_t key = k_spin_lock(&h->lock);
 
 	sys_heap_free(&h->heap, mem);
+	if (mem != NULL) {
+		HEAP_STATS_INC(frees);
+	}
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, h);
 	if (IS_ENABLED(CONFIG_MULTITHREADING) && z_unpend_all(&h->wait_q) != 0) {
@@ -95,3 +137,19 @@ void k_heap_free(struct k_heap *h, void *mem)
 		k_spin_unlock(&h->lock, key);
 	}
 }
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+int k_heap_runtime_stats_get(struct k_heap *h,
+			     struct sys_heap_runtime_stats *stats)
+{
+	if (h == NULL) {
+		return -EINVAL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&h->lock);
+	int ret = sys_heap_runtime_stats_get(&h->heap, stats);
+
+	k_spin_unlock(&h->lock, key);
+	return ret;
+}
+#endif
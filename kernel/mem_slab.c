@@ -14,6 +14,7 @@
 #include <ksched.h>
 #include <init.h>
 #include <sys/check.h>
+#include <string.h>
 
 /**
  * @brief Initialize kernel memory slab subsystem.
@@ -42,6 +43,21 @@ static int create_free_list(struct k_mem_slab *slab)
 		slab->free_list = p;
 		p += slab->block_size;
 	}
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	/* Keep at least half of the blocks out of the per-CPU caches
+	 * (each holding two magazines), so that the caches of other
+	 * CPUs cannot starve an allocator for long.  Depot links need
+	 * a second word in each block.
+	 */
+	slab->depot = NULL;
+	slab->rounds = MIN(CONFIG_MEM_SLAB_CPU_CACHE_SIZE,
+			   slab->num_blocks / (4U * CONFIG_MP_NUM_CPUS));
+	if (slab->rounds < 2U || slab->block_size < 2U * sizeof(void *)) {
+		slab->rounds = 0U;
+	}
+	(void)memset(slab->cache, 0, sizeof(slab->cache));
+#endif
 	return 0;
 }
 
@@ -100,13 +116,175 @@ out:
 	return rc;
 }
 
-int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+#define DEPOT_NEXT(magazine) (((char **)(magazine))[1])
+
+static inline void swap_magazines(struct z_mem_slab_cpu_cache *cache)
+{
+	char *list = cache->loaded;
+	uint16_t count = cache->loaded_count;
+
+	cache->loaded = cache->previous;
+	cache->loaded_count = cache->previous_count;
+	cache->previous = list;
+	cache->previous_count = count;
+}
+
+/* Moves a full magazine from the depot, or up to a magazine worth of
+ * blocks from the free list, into the empty loaded magazine.
+ */
+static void cache_refill(struct k_mem_slab *slab,
+			 struct z_mem_slab_cpu_cache *cache)
 {
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	uint16_t count = 0U;
+
+	if (slab->depot != NULL) {
+		cache->loaded = slab->depot;
+		slab->depot = DEPOT_NEXT(slab->depot);
+		count = slab->rounds;
+	} else if (slab->free_list != NULL) {
+		char *last = slab->free_list;
+
+		cache->loaded = last;
+		for (count = 1U; count < slab->rounds; count++) {
+			if (*(char **)last == NULL) {
+				break;
+			}
+			last = *(char **)last;
+		}
+		slab->free_list = *(char **)last;
+		*(char **)last = NULL;
+	}
+	cache->loaded_count = count;
+	slab->num_used += count;
+
+	k_spin_unlock(&slab->lock, key);
+}
+
+static bool cache_alloc(struct k_mem_slab *slab, void **mem)
+{
+	struct z_mem_slab_cpu_cache *cache;
+	unsigned int key;
+	bool ret = false;
+
+	if (slab->rounds == 0U) {
+		return false;
+	}
+
+	key = arch_irq_lock();
+	cache = &slab->cache[_current_cpu->id];
+
+	if (cache->loaded_count == 0U) {
+		if (cache->previous_count != 0U) {
+			swap_magazines(cache);
+			cache->hits++;
+		} else {
+			cache_refill(slab, cache);
+			cache->misses++;
+		}
+	} else {
+		cache->hits++;
+	}
+
+	if (cache->loaded_count != 0U) {
+		*mem = cache->loaded;
+		cache->loaded = *(char **)cache->loaded;
+		cache->loaded_count--;
+		ret = true;
+	}
+
+	arch_irq_unlock(key);
+
+	return ret;
+}
+
+static bool cache_free(struct k_mem_slab *slab, void **mem)
+{
+	struct z_mem_slab_cpu_cache *cache;
+	unsigned int key;
+
+	/* Blocked allocators must get freed blocks directly.  This is
+	 * checked without the lock, a waiter racing with us will get
+	 * the next block freed through the slow path instead.
+	 */
+	if (slab->rounds == 0U || z_waitq_head(&slab->wait_q) != NULL) {
+		return false;
+	}
+
+	key = arch_irq_lock();
+	cache = &slab->cache[_current_cpu->id];
+
+	if (cache->loaded_count == slab->rounds) {
+		if (cache->previous_count == slab->rounds) {
+			k_spinlock_key_t lock_key = k_spin_lock(&slab->lock);
+
+			DEPOT_NEXT(cache->previous) = slab->depot;
+			slab->depot = cache->previous;
+			slab->num_used -= slab->rounds;
+
+			k_spin_unlock(&slab->lock, lock_key);
+
+			cache->previous = NULL;
+			cache->previous_count = 0U;
+		}
+		swap_magazines(cache);
+	}
+
+	*(char **)*mem = cache->loaded;
+	cache->loaded = *mem;
+	cache->loaded_count++;
+
+	arch_irq_unlock(key);
+
+	return true;
+}
+
+int k_mem_slab_cache_stats_get(struct k_mem_slab *slab,
+			       struct k_mem_slab_cache_stats *stats)
+{
+	if ((slab == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	stats->hits = 0U;
+	stats->misses = 0U;
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		stats->hits += slab->cache[i].hits;
+		stats->misses += slab->cache[i].misses;
+	}
+	stats->cached = z_mem_slab_num_cached(slab);
+
+	return 0;
+}
+#else
+#define cache_alloc(slab, mem) false
+#define cache_free(slab, mem) false
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
+int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
 	int result;
 
+	if (cache_alloc(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+		return 0;
+	}
+
+	key = k_spin_lock(&slab->lock);
+
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (slab->free_list == NULL && slab->depot != NULL) {
+		/* Magazines are NULL terminated chains */
+		slab->free_list = slab->depot;
+		slab->depot = DEPOT_NEXT(slab->depot);
+	}
+#endif
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
@@ -114,7 +292,8 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 		slab->num_used++;
 
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-		slab->max_used = MAX(slab->num_used, slab->max_used);
+		slab->max_used = MAX(k_mem_slab_num_used_get(slab),
+				     slab->max_used);
 #endif
 
 		result = 0;
@@ -146,7 +325,15 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key;
+
+	if (cache_free(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+		return;
+	}
+
+	key = k_spin_lock(&slab->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
 	if (slab->free_list == NULL && IS_ENABLED(CONFIG_MULTITHREADING)) {
@@ -226,10 +226,10 @@ static void virt_region_init(void)
 	virt_region_inited = true;
 }
 
-static void *virt_region_alloc(size_t size)
+static void *virt_region_alloc(size_t size, size_t align)
 {
-	uintptr_t dest_addr;
-	size_t offset;
+	uintptr_t dest_addr, aligned_dest_addr;
+	size_t alloc_size, offset;
 	size_t num_bits;
 	int ret;
 
@@ -237,11 +237,18 @@ static void *virt_region_alloc(size_t size)
 		virt_region_init();
 	}
 
-	num_bits = size / CONFIG_MMU_PAGE_SIZE;
+	/* Over-allocate so that an aligned region of the requested size is
+	 * always found within, the excess is returned below
+	 */
+	alloc_size = size + align - CONFIG_MMU_PAGE_SIZE;
+	num_bits = alloc_size / CONFIG_MMU_PAGE_SIZE;
 	ret = sys_bitarray_alloc(&virt_region_bitmap, num_bits, &offset);
 	if (ret != 0) {
-		LOG_ERR("insufficient virtual address space (requested %zu)",
-			size);
+		/* Callers asking for more alignment have a fallback */
+		if (align == CONFIG_MMU_PAGE_SIZE) {
+			LOG_ERR("insufficient virtual address space (requested %zu)",
+				size);
+		}
 		return NULL;
 	}
 
@@ -249,15 +256,40 @@ static void *virt_region_alloc(size_t size)
 	 * virtual address. So here we need to go downwards (backwards?)
 	 * to get the starting address of the allocated region.
 	 */
-	dest_addr = virt_from_bitmap_offset(offset, size);
+	dest_addr = virt_from_bitmap_offset(offset, alloc_size);
 
 	/* Need to make sure this does not step into kernel memory */
 	if (dest_addr < POINTER_TO_UINT(Z_VIRT_REGION_START_ADDR)) {
-		(void)sys_bitarray_free(&virt_region_bitmap, size, offset);
+		(void)sys_bitarray_free(&virt_region_bitmap, num_bits, offset);
 		return NULL;
 	}
 
-	return UINT_TO_POINTER(dest_addr);
+	aligned_dest_addr = ROUND_UP(dest_addr, align);
+
+	/* Free the unused pages before and after the aligned region */
+	if (aligned_dest_addr > dest_addr) {
+		size_t head = aligned_dest_addr - dest_addr;
+
+		(void)sys_bitarray_free(&virt_region_bitmap,
+					head / CONFIG_MMU_PAGE_SIZE,
+					virt_to_bitmap_offset(
+						UINT_TO_POINTER(dest_addr),
+						head));
+	}
+
+	if (aligned_dest_addr + size < dest_addr + alloc_size) {
+		size_t tail = dest_addr + alloc_size -
+			      (aligned_dest_addr + size);
+
+		(void)sys_bitarray_free(&virt_region_bitmap,
+					tail / CONFIG_MMU_PAGE_SIZE,
+					virt_to_bitmap_offset(
+						UINT_TO_POINTER(
+						    aligned_dest_addr + size),
+						tail));
+	}
+
+	return UINT_TO_POINTER(aligned_dest_addr);
 }
 
 static void virt_region_free(void *vaddr, size_t size)
@@ -492,7 +524,7 @@ void *k_mem_map(size_t size, uint32_t flags)
 	 */
 	total_size = size + CONFIG_MMU_PAGE_SIZE * 2;
 
-	dst = virt_region_alloc(total_size);
+	dst = virt_region_alloc(total_size, CONFIG_MMU_PAGE_SIZE);
 	if (dst == NULL) {
 		/* Address space has no free region */
 		goto out;
@@ -630,6 +662,37 @@ size_t k_mem_free_get(void)
 	return ret * (size_t)CONFIG_MMU_PAGE_SIZE;
 }
 
+/* Obtain virtual memory for mapping size bytes at phys. If the region
+ * spans at least one large page, the virtual address is chosen congruent
+ * to phys modulo CONFIG_MMU_LARGE_PAGE_SIZE, so that arch_mem_map() can
+ * use large pages for all the aligned parts of it.
+ */
+static uint8_t *phys_map_virt_alloc(uintptr_t phys, size_t size)
+{
+#if CONFIG_MMU_LARGE_PAGE_SIZE > CONFIG_MMU_PAGE_SIZE
+	const size_t large = CONFIG_MMU_LARGE_PAGE_SIZE;
+	size_t phys_offset = phys % large;
+	uint8_t *base;
+
+	if (ROUND_UP(phys, large) + large <= phys + size) {
+		base = virt_region_alloc(size + phys_offset, large);
+		if (base != NULL) {
+			if (phys_offset != 0U) {
+				virt_region_free(base, phys_offset);
+			}
+
+			return base + phys_offset;
+		}
+
+		/* Virtual address space is too fragmented, use regular
+		 * pages instead
+		 */
+	}
+#endif /* CONFIG_MMU_LARGE_PAGE_SIZE > CONFIG_MMU_PAGE_SIZE */
+
+	return virt_region_alloc(size, CONFIG_MMU_PAGE_SIZE);
+}
+
 /* This may be called from arch early boot code before z_cstart() is invoked.
  * Data will be copied and BSS zeroed, but this must not rely on any
  * initialization functions being called prior to work correctly.
@@ -651,7 +714,7 @@ void z_phys_map(uint8_t **virt_ptr, uintptr_t phys, size_t size, uint32_t flags)
 
 	key = k_spin_lock(&z_mm_lock);
 	/* Obtain an appropriately sized chunk of virtual memory */
-	dest_addr = virt_region_alloc(aligned_size);
+	dest_addr = phys_map_virt_alloc(aligned_phys, aligned_size);
 	if (!dest_addr) {
 		goto fail;
 	}
@@ -1145,6 +1208,29 @@ static inline void paging_stats_eviction_inc(struct k_thread *faulting_thread,
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 }
 
+#ifdef CONFIG_DEMAND_PAGING_PREFETCH
+static inline void paging_stats_prefetch_inc(struct k_thread *faulting_thread,
+					     bool sequential)
+{
+#ifdef CONFIG_DEMAND_PAGING_STATS
+	if (sequential) {
+		paging_stats.prefetch.sequential++;
+	} else {
+		paging_stats.prefetch.around++;
+	}
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+	if (sequential) {
+		faulting_thread->paging_stats.prefetch.sequential++;
+	} else {
+		faulting_thread->paging_stats.prefetch.around++;
+	}
+#else
+	ARG_UNUSED(faulting_thread);
+#endif /* CONFIG_DEMAND_PAGING_THREAD_STATS */
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+}
+#endif /* CONFIG_DEMAND_PAGING_PREFETCH */
+
 static inline struct z_page_frame *do_eviction_select(bool *dirty)
 {
 	struct z_page_frame *pf;
@@ -1179,7 +1265,13 @@ static inline struct z_page_frame *do_eviction_select(bool *dirty)
 	return pf;
 }
 
-static bool do_page_fault(void *addr, bool pin)
+/*
+ * Page in the data page at addr. If prefetch is set, this is on behalf of
+ * a fault on another page: no page fault is accounted for, the return value
+ * tells whether a page-in was actually done, and the page frame is left
+ * busy for z_page_fault() to release.
+ */
+static bool do_page_fault(void *addr, bool pin, bool prefetch)
 {
 	struct z_page_frame *pf;
 	int key, ret;
@@ -1239,7 +1331,9 @@ static bool do_page_fault(void *addr, bool pin)
 	}
 	result = true;
 
-	paging_stats_faults_inc(faulting_thread, key);
+	if (!prefetch) {
+		paging_stats_faults_inc(faulting_thread, key);
+	}
 
 	if (status == ARCH_PAGE_LOCATION_PAGED_IN) {
 		if (pin) {
@@ -1249,7 +1343,8 @@ static bool do_page_fault(void *addr, bool pin)
 			pf = z_phys_to_page_frame(phys);
 			pf->flags |= Z_PAGE_FRAME_PINNED;
 		}
-		/* We raced before locking IRQs, re-try */
+		/* We raced before locking IRQs, re-try. Nothing to prefetch. */
+		result = !prefetch;
 		goto out;
 	}
 	__ASSERT(status == ARCH_PAGE_LOCATION_PAGED_OUT,
@@ -1287,6 +1382,9 @@ static bool do_page_fault(void *addr, bool pin)
 	if (pin) {
 		pf->flags |= Z_PAGE_FRAME_PINNED;
 	}
+	if (prefetch) {
+		pf->flags |= Z_PAGE_FRAME_BUSY;
+	}
 	pf->flags |= Z_PAGE_FRAME_MAPPED;
 	pf->addr = addr;
 	arch_mem_page_in(addr, z_page_frame_to_phys(pf));
@@ -1304,7 +1402,7 @@ static void do_page_in(void *addr)
 {
 	bool ret;
 
-	ret = do_page_fault(addr, false);
+	ret = do_page_fault(addr, false, false);
 	__ASSERT(ret, "unmapped memory address %p", addr);
 	(void)ret;
 }
@@ -1321,7 +1419,7 @@ static void do_mem_pin(void *addr)
 {
 	bool ret;
 
-	ret = do_page_fault(addr, true);
+	ret = do_page_fault(addr, true, false);
 	__ASSERT(ret, "unmapped memory address %p", addr);
 	(void)ret;
 }
@@ -1334,10 +1432,148 @@ void k_mem_pin(void *addr, size_t size)
 	virt_region_foreach(addr, size, do_mem_pin);
 }
 
+#ifdef CONFIG_DEMAND_PAGING_PREFETCH
+/* Both windows fit in the mask of pages held by z_page_fault() */
+#define PREFETCH_PAGES_MAX	32U
+
+static size_t prefetch_around = CONFIG_DEMAND_PAGING_FAULT_AROUND_PAGES;
+static size_t prefetch_sequential_max = CONFIG_DEMAND_PAGING_PREFETCH_MAX_PAGES;
+
+/* Page right after the last window paged in, a fault there continues a
+ * sequential access pattern, and the number of pages prefetched ahead
+ * for it
+ */
+static uint8_t *sequential_next;
+static size_t sequential_window;
+
+int k_mem_paging_prefetch_set(size_t around, size_t sequential_max)
+{
+	int key;
+
+	if (around > PREFETCH_PAGES_MAX || around > Z_NUM_PAGE_FRAMES / 2U ||
+	    sequential_max >= PREFETCH_PAGES_MAX ||
+	    sequential_max >= Z_NUM_PAGE_FRAMES / 2U) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+	prefetch_around = around;
+	prefetch_sequential_max = sequential_max;
+	sequential_next = NULL;
+	sequential_window = 0U;
+	irq_unlock(key);
+
+	return 0;
+}
+
+void k_mem_paging_prefetch_get(size_t *around, size_t *sequential_max)
+{
+	int key = irq_lock();
+
+	*around = prefetch_around;
+	*sequential_max = prefetch_sequential_max;
+	irq_unlock(key);
+}
+
+/* Work out the window of pages to bring in along with the faulting one,
+ * returning whether this is a sequential access
+ */
+static bool prefetch_window_get(uint8_t *page, uint8_t **start,
+				uint8_t **end)
+{
+	size_t pages = MAX(prefetch_around, 1U);
+	bool sequential = false;
+	int key = irq_lock();
+
+	if (prefetch_sequential_max != 0U && page == sequential_next) {
+		/* Ramp up while the pattern holds */
+		sequential_window = MIN(MAX(sequential_window * 2U, pages),
+					prefetch_sequential_max);
+		*start = page;
+		*end = page + ((sequential_window + 1U) * CONFIG_MMU_PAGE_SIZE);
+		sequential = true;
+	} else {
+		/* Aligned window of fault-around pages */
+		size_t offset = page - Z_VIRT_RAM_START;
+
+		sequential_window = 0U;
+		offset -= offset % (pages * CONFIG_MMU_PAGE_SIZE);
+		*start = Z_VIRT_RAM_START + offset;
+		*end = *start + (pages * CONFIG_MMU_PAGE_SIZE);
+	}
+
+	if (*end > Z_VIRT_RAM_END) {
+		*end = Z_VIRT_RAM_END;
+	}
+	sequential_next = *end;
+	irq_unlock(key);
+
+	return sequential;
+}
+
+bool z_page_fault(void *addr)
+{
+	uint8_t *page = (uint8_t *)ROUND_DOWN(addr, CONFIG_MMU_PAGE_SIZE);
+	uint8_t *start, *end, *pos;
+	uint32_t held = 0U;
+	bool sequential, result;
+	uintptr_t flags, phys;
+	int key;
+
+	if (page < Z_VIRT_RAM_START || page >= Z_VIRT_RAM_END) {
+		return do_page_fault(addr, false, false);
+	}
+
+	sequential = prefetch_window_get(page, &start, &end);
+
+	/* Neighbouring pages are paged in first and their page frames kept
+	 * busy, so that neither paging them in nor paging in the faulting
+	 * page can evict any of them
+	 */
+	for (pos = start; pos < end; pos += CONFIG_MMU_PAGE_SIZE) {
+		if (pos == page) {
+			continue;
+		}
+
+		if (do_page_fault(pos, false, true)) {
+			held |= BIT((pos - start) / CONFIG_MMU_PAGE_SIZE);
+			paging_stats_prefetch_inc(_current_cpu->current,
+						  sequential);
+		} else if (sequential &&
+			   arch_page_location_get(pos, &phys) ==
+			   ARCH_PAGE_LOCATION_BAD) {
+			/* End of the mapping */
+			break;
+		}
+	}
+
+	result = do_page_fault(addr, false, false);
+
+	key = irq_lock();
+	for (pos = start; held != 0U; pos += CONFIG_MMU_PAGE_SIZE) {
+		uint32_t bit = BIT((pos - start) / CONFIG_MMU_PAGE_SIZE);
+
+		if ((held & bit) == 0U) {
+			continue;
+		}
+		held &= ~bit;
+
+		flags = arch_page_info_get(pos, &phys, false);
+		__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0U,
+			 "prefetched page %p was evicted", pos);
+		(void)flags;
+		z_phys_to_page_frame(phys)->flags &= ~Z_PAGE_FRAME_BUSY;
+	}
+	irq_unlock(key);
+
+	return result;
+}
+#else
 bool z_page_fault(void *addr)
 {
-	return do_page_fault(addr, false);
+	return do_page_fault(addr, false, false);
 }
+#endif /* CONFIG_DEMAND_PAGING_PREFETCH */
 
 static void do_mem_unpin(void *addr)
 {
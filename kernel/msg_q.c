@@ -48,12 +48,220 @@ void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 #ifdef CONFIG_POLL
 	sys_dlist_init(&msgq->poll_events);
 #endif	/* CONFIG_POLL */
+#ifdef CONFIG_MSGQ_SPSC
+	atomic_clear(&msgq->spsc_head);
+	atomic_clear(&msgq->spsc_tail);
+	atomic_clear(&msgq->spsc_waiters);
+#endif
 
 	SYS_PORT_TRACING_OBJ_INIT(k_msgq, msgq);
 
 	z_object_init(msgq);
 }
 
+#ifdef CONFIG_MSGQ_SPSC
+/* Single-producer, single-consumer mode.
+ *
+ * The writer owns write_ptr and spsc_head, the reader owns read_ptr and
+ * spsc_tail, and each side only bumps its own counter, once it is done
+ * copying the message.  The lock is only needed to pend or wake up a
+ * thread: a side about to pend sets spsc_waiters before re-checking the
+ * counters under the lock, while the other side checks spsc_waiters
+ * after bumping its counter, so either the waiter sees the new message
+ * (or free slot) or the other side sees the waiter.  The flag is only
+ * cleared under the lock, once the wait queue is found empty.
+ *
+ * With one thread on either side, a thread found pending after a write
+ * must be the reader and one found pending after a read the writer, and
+ * it gets its operation completed on its behalf, as in the locked code.
+ */
+
+static inline bool spsc_empty(struct k_msgq *msgq)
+{
+	return z_msgq_used_msgs(msgq) == 0U;
+}
+
+static inline bool spsc_full(struct k_msgq *msgq)
+{
+	return z_msgq_used_msgs(msgq) >= msgq->max_msgs;
+}
+
+static void spsc_write(struct k_msgq *msgq, const void *data)
+{
+	(void)memcpy(msgq->write_ptr, data, msgq->msg_size);
+	msgq->write_ptr += msgq->msg_size;
+	if (msgq->write_ptr == msgq->buffer_end) {
+		msgq->write_ptr = msgq->buffer_start;
+	}
+	(void)atomic_inc(&msgq->spsc_head);
+}
+
+static void spsc_read(struct k_msgq *msgq, void *data)
+{
+	(void)memcpy(data, msgq->read_ptr, msgq->msg_size);
+	msgq->read_ptr += msgq->msg_size;
+	if (msgq->read_ptr == msgq->buffer_end) {
+		msgq->read_ptr = msgq->buffer_start;
+	}
+	(void)atomic_inc(&msgq->spsc_tail);
+}
+
+static inline bool spsc_contended(struct k_msgq *msgq, bool writer)
+{
+	bool contended = atomic_get(&msgq->spsc_waiters) != 0;
+
+#ifdef CONFIG_POLL
+	/* Only writes signal poll events */
+	contended = contended ||
+		(writer && !sys_dlist_is_empty(&msgq->poll_events));
+#else
+	ARG_UNUSED(writer);
+#endif
+
+	return contended;
+}
+
+static void spsc_unlock(struct k_msgq *msgq, k_spinlock_key_t key,
+			bool woken)
+{
+	if (z_waitq_head(&msgq->wait_q) == NULL) {
+		atomic_clear(&msgq->spsc_waiters);
+	}
+
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+}
+
+/* Called with the lock held after a write, releases it */
+static void spsc_wake_reader(struct k_msgq *msgq, k_spinlock_key_t key)
+{
+	struct k_thread *pending_thread;
+
+	pending_thread = z_unpend_first_thread(&msgq->wait_q);
+	if (pending_thread != NULL) {
+		spsc_read(msgq, pending_thread->base.swap_data);
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+	} else {
+#ifdef CONFIG_POLL
+		handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+#endif /* CONFIG_POLL */
+	}
+
+	spsc_unlock(msgq, key, pending_thread != NULL);
+}
+
+/* Called with the lock held after a read, releases it */
+static void spsc_wake_writer(struct k_msgq *msgq, k_spinlock_key_t key)
+{
+	struct k_thread *pending_thread;
+
+	pending_thread = z_unpend_first_thread(&msgq->wait_q);
+	if (pending_thread != NULL) {
+		spsc_write(msgq, pending_thread->base.swap_data);
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+	}
+
+	spsc_unlock(msgq, key, pending_thread != NULL);
+}
+
+static int spsc_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+
+	if (!spsc_full(msgq)) {
+		spsc_write(msgq, data);
+		if (spsc_contended(msgq, true)) {
+			key = k_spin_lock(&msgq->lock);
+			spsc_wake_reader(msgq, key);
+		}
+		return 0;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return -ENOMSG;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+	atomic_set(&msgq->spsc_waiters, 1);
+
+	if (spsc_full(msgq)) {
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, put, msgq, timeout);
+
+		/* the reader completes the put when it makes room */
+		_current->base.swap_data = (void *) data;
+
+		return z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+	}
+
+	/* the reader made room in the meantime */
+	spsc_write(msgq, data);
+	spsc_wake_reader(msgq, key);
+
+	return 0;
+}
+
+static int spsc_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+
+	if (!spsc_empty(msgq)) {
+		spsc_read(msgq, data);
+		if (spsc_contended(msgq, false)) {
+			key = k_spin_lock(&msgq->lock);
+			spsc_wake_writer(msgq, key);
+		}
+		return 0;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return -ENOMSG;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+	atomic_set(&msgq->spsc_waiters, 1);
+
+	if (spsc_empty(msgq)) {
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get, msgq, timeout);
+
+		/* the writer completes the get when it adds a message */
+		_current->base.swap_data = data;
+
+		return z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+	}
+
+	/* the writer added a message in the meantime */
+	spsc_read(msgq, data);
+	spsc_wake_writer(msgq, key);
+
+	return 0;
+}
+
+static void spsc_purge(struct k_msgq *msgq)
+{
+	uint32_t used = z_msgq_used_msgs(msgq);
+	size_t idx = (msgq->read_ptr - msgq->buffer_start) / msgq->msg_size;
+
+	/* Only drop what was there on entry, the writer may still be
+	 * adding messages.
+	 */
+	idx = (idx + used) % msgq->max_msgs;
+	msgq->read_ptr = msgq->buffer_start + idx * msgq->msg_size;
+	(void)atomic_add(&msgq->spsc_tail, (atomic_val_t)used);
+}
+
+void k_msgq_spsc_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
+		      uint32_t max_msgs)
+{
+	k_msgq_init(msgq, buffer, msg_size, max_msgs);
+	msgq->flags = K_MSGQ_FLAG_SPSC;
+}
+#endif /* CONFIG_MSGQ_SPSC */
+
 int z_impl_k_msgq_alloc_init(struct k_msgq *msgq, size_t msg_size,
 			    uint32_t max_msgs)
 {
@@ -121,6 +329,15 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 	k_spinlock_key_t key;
 	int result;
 
+#ifdef CONFIG_MSGQ_SPSC
+	if ((msgq->flags & K_MSGQ_FLAG_SPSC) != 0U) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
+		result = spsc_put(msgq, data, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
+		return result;
+	}
+#endif /* CONFIG_MSGQ_SPSC */
+
 	key = k_spin_lock(&msgq->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
@@ -189,7 +406,7 @@ void z_impl_k_msgq_get_attrs(struct k_msgq *msgq, struct k_msgq_attrs *attrs)
 {
 	attrs->msg_size = msgq->msg_size;
 	attrs->max_msgs = msgq->max_msgs;
-	attrs->used_msgs = msgq->used_msgs;
+	attrs->used_msgs = z_msgq_used_msgs(msgq);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -211,6 +428,15 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 	struct k_thread *pending_thread;
 	int result;
 
+#ifdef CONFIG_MSGQ_SPSC
+	if ((msgq->flags & K_MSGQ_FLAG_SPSC) != 0U) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
+		result = spsc_get(msgq, data, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
+		return result;
+	}
+#endif /* CONFIG_MSGQ_SPSC */
+
 	key = k_spin_lock(&msgq->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
@@ -286,6 +512,22 @@ int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 	k_spinlock_key_t key;
 	int result;
 
+#ifdef CONFIG_MSGQ_SPSC
+	if ((msgq->flags & K_MSGQ_FLAG_SPSC) != 0U) {
+		/* a peek is a read that leaves the tail alone */
+		if (spsc_empty(msgq)) {
+			result = -ENOMSG;
+		} else {
+			(void)memcpy(data, msgq->read_ptr, msgq->msg_size);
+			result = 0;
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC(k_msgq, peek, msgq, result);
+
+		return result;
+	}
+#endif /* CONFIG_MSGQ_SPSC */
+
 	key = k_spin_lock(&msgq->lock);
 
 	if (msgq->used_msgs > 0U) {
@@ -330,6 +572,15 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 		z_ready_thread(pending_thread);
 	}
 
+#ifdef CONFIG_MSGQ_SPSC
+	if ((msgq->flags & K_MSGQ_FLAG_SPSC) != 0U) {
+		spsc_purge(msgq);
+		atomic_clear(&msgq->spsc_waiters);
+		z_reschedule(&msgq->lock, key);
+		return;
+	}
+#endif /* CONFIG_MSGQ_SPSC */
+
 	msgq->used_msgs = 0;
 	msgq->read_ptr = msgq->write_ptr;
 
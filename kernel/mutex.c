@@ -31,6 +31,7 @@
 #include <toolchain.h>
 #include <ksched.h>
 #include <wait_q.h>
+#include <kernel_internal.h>
 #include <errno.h>
 #include <init.h>
 #include <syscall_handler.h>
@@ -92,48 +93,16 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
-int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
+/* Pends the current thread on a mutex owned by another thread, lending
+ * it our priority until we either get the mutex or time out.  Called
+ * with the lock held, which is released.
+ */
+static int mutex_pend(struct k_mutex *mutex, k_timeout_t timeout,
+		      k_spinlock_key_t key)
 {
 	int new_prio;
-	k_spinlock_key_t key;
 	bool resched = false;
 
-	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
-
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mutex, lock, mutex, timeout);
-
-	key = k_spin_lock(&lock);
-
-	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
-
-		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
-					_current->base.prio :
-					mutex->owner_orig_prio;
-
-		mutex->lock_count++;
-		mutex->owner = _current;
-
-		LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
-			_current, mutex, mutex->lock_count,
-			mutex->owner_orig_prio);
-
-		k_spin_unlock(&lock, key);
-
-		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
-
-		return 0;
-	}
-
-	if (unlikely(K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
-		k_spin_unlock(&lock, key);
-
-		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, -EBUSY);
-
-		return -EBUSY;
-	}
-
-	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mutex, lock, mutex, timeout);
-
 	new_prio = new_prio_for_inheritance(_current->base.prio,
 					    mutex->owner->base.prio);
 
@@ -151,7 +120,6 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		got_mutex ? 'y' : 'n');
 
 	if (got_mutex == 0) {
-		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
 		return 0;
 	}
 
@@ -177,11 +145,57 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		k_spin_unlock(&lock, key);
 	}
 
-	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, -EAGAIN);
-
 	return -EAGAIN;
 }
 
+int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	int ret;
+
+	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mutex, lock, mutex, timeout);
+
+	key = k_spin_lock(&lock);
+
+	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
+
+		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
+					_current->base.prio :
+					mutex->owner_orig_prio;
+
+		mutex->lock_count++;
+		mutex->owner = _current;
+
+		LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
+			_current, mutex, mutex->lock_count,
+			mutex->owner_orig_prio);
+
+		k_spin_unlock(&lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
+
+		return 0;
+	}
+
+	if (unlikely(K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
+		k_spin_unlock(&lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, -EBUSY);
+
+		return -EBUSY;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mutex, lock, mutex, timeout);
+
+	ret = mutex_pend(mutex, timeout, key);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, ret);
+
+	return ret;
+}
+
 #ifdef CONFIG_USERSPACE
 static inline int z_vrfy_k_mutex_lock(struct k_mutex *mutex,
 				      k_timeout_t timeout)
@@ -279,3 +293,116 @@ static inline int z_vrfy_k_mutex_unlock(struct k_mutex *mutex)
 }
 #include <syscalls/k_mutex_unlock_mrsh.c>
 #endif
+
+#ifdef CONFIG_SYS_MUTEX_FAST
+/* A lock word never holds this value as a thread pointer, since threads
+ * are word aligned.
+ */
+#define WORD_KERNEL ((void *)1)
+
+static bool word_owner_valid(struct k_thread *owner)
+{
+	struct z_object *ko = z_object_find(owner);
+
+	return ko != NULL && ko->type == K_OBJ_THREAD &&
+	       (ko->flags & K_OBJ_FLAG_INITIALIZED) != 0U &&
+	       (owner->base.thread_state & _THREAD_DEAD) == 0U;
+}
+
+int z_mutex_word_lock(struct k_mutex *mutex, atomic_ptr_t *word,
+		      k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	void *val;
+	struct k_thread *owner;
+
+	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
+
+	for (;;) {
+		val = atomic_ptr_get(word);
+		owner = val;
+
+		if (val != NULL && K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -EBUSY;
+		}
+
+		/* The word lives in user memory, so it may name anything */
+		if (val != NULL && val != WORD_KERNEL &&
+		    (owner == _current || !word_owner_valid(owner))) {
+			return -EINVAL;
+		}
+
+		key = k_spin_lock(&lock);
+
+		/* Only the swap to WORD_KERNEL, done under the lock,
+		 * hands the mutex over to the kernel, which then keeps
+		 * it until it is released with no waiters.
+		 */
+		if (val == WORD_KERNEL && atomic_ptr_get(word) == WORD_KERNEL) {
+			break;
+		}
+		if (val != WORD_KERNEL && atomic_ptr_cas(word, val, WORD_KERNEL)) {
+			break;
+		}
+
+		k_spin_unlock(&lock, key);
+	}
+
+	if (val == NULL || (val == WORD_KERNEL && mutex->owner == NULL)) {
+		/* The latter can only be the result of a forged lock word */
+		mutex->lock_count = 1U;
+		mutex->owner = _current;
+		mutex->owner_orig_prio = _current->base.prio;
+		k_spin_unlock(&lock, key);
+
+		return 0;
+	}
+
+	if (val != WORD_KERNEL) {
+		/* Record the owner of the uncontended mutex so it can
+		 * inherit our priority
+		 */
+		mutex->lock_count = 1U;
+		mutex->owner = owner;
+		mutex->owner_orig_prio = owner->base.prio;
+	} else if (mutex->owner == _current) {
+		/* Recursive locking is handled in user memory */
+		k_spin_unlock(&lock, key);
+
+		return -EINVAL;
+	}
+
+	return mutex_pend(mutex, timeout, key);
+}
+
+int z_mutex_word_unlock(struct k_mutex *mutex, atomic_ptr_t *word)
+{
+	struct k_thread *new_owner;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (mutex->owner != _current) {
+		k_spin_unlock(&lock, key);
+
+		return mutex->owner == NULL ? -EINVAL : -EPERM;
+	}
+
+	adjust_owner_prio(mutex, mutex->owner_orig_prio);
+
+	new_owner = z_unpend_first_thread(&mutex->wait_q);
+	mutex->owner = new_owner;
+
+	if (new_owner != NULL) {
+		mutex->owner_orig_prio = new_owner->base.prio;
+		arch_thread_return_value_set(new_owner, 0);
+		z_ready_thread(new_owner);
+		z_reschedule(&lock, key);
+	} else {
+		/* Back to the uncontended state */
+		mutex->lock_count = 0U;
+		atomic_ptr_set(word, NULL);
+		k_spin_unlock(&lock, key);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SYS_MUTEX_FAST */
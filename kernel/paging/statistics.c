@@ -9,6 +9,8 @@
 #include <syscall_handler.h>
 #include <toolchain.h>
 #include <sys/mem_manage.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
 
 extern struct k_mem_paging_stats_t paging_stats;
 
@@ -108,6 +110,54 @@ void z_vrfy_k_mem_paging_stats_get(struct k_mem_paging_stats_t *stats)
 #include <syscalls/k_mem_paging_stats_get_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+void z_impl_k_mem_paging_working_set_get(
+	struct k_mem_paging_working_set_t *ws)
+{
+	struct k_mem_paging_working_set_t snap = { 0 };
+	struct z_page_frame *pf;
+	uintptr_t flags, phys;
+	int key;
+
+	if (ws == NULL) {
+		return;
+	}
+
+	/* Page frames are only stable with IRQs locked */
+	key = irq_lock();
+	Z_PAGE_FRAME_FOREACH(phys, pf) {
+		if (z_page_frame_is_pinned(pf)) {
+			snap.pinned++;
+		}
+
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		flags = arch_page_info_get(pf->addr, NULL, false);
+		snap.resident++;
+		if ((flags & ARCH_DATA_PAGE_ACCESSED) != 0UL) {
+			snap.accessed++;
+		}
+		if ((flags & ARCH_DATA_PAGE_DIRTY) != 0UL) {
+			snap.dirty++;
+		}
+	}
+	irq_unlock(key);
+
+	*ws = snap;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline
+void z_vrfy_k_mem_paging_working_set_get(
+	struct k_mem_paging_working_set_t *ws)
+{
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(ws, sizeof(*ws)));
+	z_impl_k_mem_paging_working_set_get(ws);
+}
+#include <syscalls/k_mem_paging_working_set_get_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 #ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
 void z_impl_k_mem_paging_thread_stats_get(struct k_thread *thread,
 					  struct k_mem_paging_stats_t *stats)
@@ -420,6 +420,15 @@ int z_pipe_put_internal(struct k_pipe *pipe, struct k_pipe_async *async_desc,
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
+	if ((pipe->flags & K_PIPE_FLAG_PUT_CLAIM) != 0U) {
+		k_spin_unlock(&pipe->lock, key);
+		*bytes_written = 0;
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, put, pipe, timeout, -EBUSY);
+
+		return -EBUSY;
+	}
+
 	/*
 	 * Create a list of "working readers" into which the data will be
 	 * directly copied.
@@ -563,6 +572,15 @@ int z_impl_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
+	if ((pipe->flags & K_PIPE_FLAG_GET_CLAIM) != 0U) {
+		k_spin_unlock(&pipe->lock, key);
+		*bytes_read = 0;
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, get, pipe, timeout, -EBUSY);
+
+		return -EBUSY;
+	}
+
 	/*
 	 * Create a list of "working readers" into which the data will be
 	 * directly copied.
@@ -825,3 +843,197 @@ size_t z_vrfy_k_pipe_write_avail(struct k_pipe *pipe)
 }
 #include <syscalls/k_pipe_write_avail_mrsh.c>
 #endif
+
+/**
+ * @brief Contiguous free space at the write end of the pipe's buffer
+ */
+static inline size_t pipe_put_run(struct k_pipe *pipe)
+{
+	return MIN(pipe->size - pipe->bytes_used,
+		   pipe->size - pipe->write_index);
+}
+
+/**
+ * @brief Contiguous data at the read end of the pipe's buffer
+ */
+static inline size_t pipe_get_run(struct k_pipe *pipe)
+{
+	return MIN(pipe->bytes_used, pipe->size - pipe->read_index);
+}
+
+size_t k_pipe_put_claim(struct k_pipe *pipe, uint8_t **data, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	size_t claimed = 0;
+
+	if ((pipe->buffer != NULL) &&
+	    ((pipe->flags & K_PIPE_FLAG_PUT_CLAIM) == 0U)) {
+		claimed = MIN(size, pipe_put_run(pipe));
+	}
+
+	if (claimed != 0U) {
+		pipe->flags |= K_PIPE_FLAG_PUT_CLAIM;
+		*data = pipe->buffer + pipe->write_index;
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return claimed;
+}
+
+int k_pipe_put_finish(struct k_pipe *pipe, size_t size)
+{
+	struct k_thread    *reader;
+	struct k_thread    *thread;
+	struct k_pipe_desc *desc;
+	sys_dlist_t    xfer_list;
+	size_t         bytes_copied;
+
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	/*
+	 * Nothing else writes to the pipe's buffer while the claim is
+	 * outstanding, so the write end can only have grown since then.
+	 */
+	CHECKIF(((pipe->flags & K_PIPE_FLAG_PUT_CLAIM) == 0U) ||
+		(size > pipe_put_run(pipe))) {
+		k_spin_unlock(&pipe->lock, key);
+
+		return -EINVAL;
+	}
+
+	pipe->flags &= ~K_PIPE_FLAG_PUT_CLAIM;
+	pipe->bytes_used += size;
+	pipe->write_index += size;
+	if (pipe->write_index == pipe->size) {
+		pipe->write_index = 0;
+	}
+
+	/*
+	 * Readers only wait on an empty buffer, so any waiting readers
+	 * are owed the data just committed. Hand it over the way
+	 * k_pipe_get() would have, from a working set of readers.
+	 */
+	(void)pipe_xfer_prepare(&xfer_list, &reader, &pipe->wait_q.readers,
+				 0, pipe->bytes_used, 0, K_FOREVER);
+
+	z_sched_lock();
+	k_spin_unlock(&pipe->lock, key);
+
+	thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	while (thread != NULL) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = pipe_buffer_get(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		/* The thread's read request has been satisfied. Ready it. */
+		z_ready_thread(thread);
+
+		thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	}
+
+	if (reader != NULL) {
+		desc = (struct k_pipe_desc *)reader->base.swap_data;
+		bytes_copied = pipe_buffer_get(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+	}
+
+	k_sched_unlock();
+
+	return 0;
+}
+
+size_t k_pipe_get_claim(struct k_pipe *pipe, uint8_t **data, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	size_t claimed = 0;
+
+	if ((pipe->buffer != NULL) &&
+	    ((pipe->flags & K_PIPE_FLAG_GET_CLAIM) == 0U)) {
+		claimed = MIN(size, pipe_get_run(pipe));
+	}
+
+	if (claimed != 0U) {
+		pipe->flags |= K_PIPE_FLAG_GET_CLAIM;
+		*data = pipe->buffer + pipe->read_index;
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return claimed;
+}
+
+int k_pipe_get_finish(struct k_pipe *pipe, size_t size)
+{
+	struct k_thread    *writer;
+	struct k_thread    *thread;
+	struct k_pipe_desc *desc;
+	sys_dlist_t    xfer_list;
+	size_t         bytes_copied;
+
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	/*
+	 * Nothing else reads from the pipe's buffer while the claim is
+	 * outstanding, so the read end can only have grown since then.
+	 */
+	CHECKIF(((pipe->flags & K_PIPE_FLAG_GET_CLAIM) == 0U) ||
+		(size > pipe_get_run(pipe))) {
+		k_spin_unlock(&pipe->lock, key);
+
+		return -EINVAL;
+	}
+
+	pipe->flags &= ~K_PIPE_FLAG_GET_CLAIM;
+	pipe->bytes_used -= size;
+	pipe->read_index += size;
+	if (pipe->read_index == pipe->size) {
+		pipe->read_index = 0;
+	}
+
+	/*
+	 * Writers only wait on a full buffer, so refill the space just
+	 * released from a working set of waiting writers, as k_pipe_get()
+	 * would have.
+	 */
+	(void)pipe_xfer_prepare(&xfer_list, &writer, &pipe->wait_q.writers,
+				 0, pipe->size - pipe->bytes_used, 0,
+				 K_FOREVER);
+
+	z_sched_lock();
+	k_spin_unlock(&pipe->lock, key);
+
+	thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	while (thread != NULL) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = pipe_buffer_put(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer         += bytes_copied;
+		desc->bytes_to_xfer  -= bytes_copied;
+
+		/* Write request has been satisfied */
+		pipe_thread_ready(thread);
+
+		thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	}
+
+	if (writer != NULL) {
+		desc = (struct k_pipe_desc *)writer->base.swap_data;
+		bytes_copied = pipe_buffer_put(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer         += bytes_copied;
+		desc->bytes_to_xfer  -= bytes_copied;
+	}
+
+	k_sched_unlock();
+
+	return 0;
+}
@@ -34,10 +34,11 @@
  */
 static struct k_spinlock lock;
 
-enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED };
+enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED, MODE_SET };
 
 static int signal_poller(struct k_poll_event *event, uint32_t state);
 static int signal_triggered_work(struct k_poll_event *event, uint32_t status);
+static void signal_poll_set(struct k_poll_event *event, uint32_t state);
 
 void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 		       int mode, void *obj)
@@ -81,7 +82,7 @@ static inline bool is_condition_met(struct k_poll_event *event, uint32_t *state)
 		}
 		break;
 	case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
-		if (event->msgq->used_msgs > 0) {
+		if (z_msgq_used_msgs(event->msgq) > 0) {
 			*state = K_POLL_STATE_MSGQ_DATA_AVAILABLE;
 			return true;
 		}
@@ -101,6 +102,22 @@ static struct k_thread *poller_thread(struct z_poller *p)
 	return p ? CONTAINER_OF(p, struct k_thread, poller) : NULL;
 }
 
+/* Poll sets have no thread of their own and rank below all threads */
+static bool poller_ranks_higher(struct z_poller *poller,
+				struct z_poller *other)
+{
+	if (poller->mode == MODE_SET) {
+		return false;
+	}
+
+	if (other->mode == MODE_SET) {
+		return true;
+	}
+
+	return z_sched_prio_cmp(poller_thread(poller),
+				poller_thread(other)) > 0;
+}
+
 static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 			     struct z_poller *poller)
 {
@@ -108,15 +125,13 @@ static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
 	if ((pending == NULL) ||
-		(z_sched_prio_cmp(poller_thread(pending->poller),
-							   poller_thread(poller)) > 0)) {
+	    poller_ranks_higher(pending->poller, poller)) {
 		sys_dlist_append(events, &event->_node);
 		return;
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (z_sched_prio_cmp(poller_thread(poller),
-					poller_thread(pending->poller)) > 0) {
+		if (poller_ranks_higher(poller, pending->poller)) {
 			sys_dlist_insert(&pending->_node, &event->_node);
 			return;
 		}
@@ -427,6 +442,10 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 			retcode = signal_poller(event, state);
 		} else if (poller->mode == MODE_TRIGGERED) {
 			retcode = signal_triggered_work(event, state);
+		} else if (poller->mode == MODE_SET) {
+			/* The event stays registered with the set */
+			signal_poll_set(event, state);
+			return 0;
 		} else {
 			/* Poller is not poll or triggered mode. No action needed.*/
 			;
@@ -786,3 +805,177 @@ int k_work_poll_cancel(struct k_work_poll *work)
 
 	return retval;
 }
+
+/* must be called with the set's lock held */
+static void poll_set_queue(struct k_poll_set *set, struct k_poll_event *event)
+{
+	struct k_thread *thread;
+
+	sys_dlist_append(&set->ready, &event->_node);
+
+	thread = z_unpend_first_thread(&set->wait_q);
+	if (thread != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+}
+
+/* must be called with interrupts locked */
+static void signal_poll_set(struct k_poll_event *event, uint32_t state)
+{
+	struct k_poll_set *set =
+		CONTAINER_OF(event->poller, struct k_poll_set, poller);
+	k_spinlock_key_t key = k_spin_lock(&set->lock);
+
+	/* The object already unlinked the event from its list */
+	event->state |= state;
+	poll_set_queue(set, event);
+
+	k_spin_unlock(&set->lock, key);
+}
+
+/*
+ * Hand out up to max_events ready events, re-checking each one: events
+ * still ready stay queued, the others get registered with their object
+ * again. Must be called with both the poll lock and the set's lock held.
+ */
+static int poll_set_harvest(struct k_poll_set *set,
+			    struct k_poll_event **events, int max_events)
+{
+	struct k_poll_event *event;
+	sys_dlist_t still_ready;
+	uint32_t state, cur;
+	int num_events = 0;
+
+	sys_dlist_init(&still_ready);
+
+	while (num_events < max_events) {
+		event = (struct k_poll_event *)sys_dlist_get(&set->ready);
+		if (event == NULL) {
+			break;
+		}
+
+		/* A cancellation doesn't show in the object's state */
+		state = event->state & K_POLL_STATE_CANCELLED;
+		if (is_condition_met(event, &cur)) {
+			state |= cur;
+			sys_dlist_append(&still_ready, &event->_node);
+		} else {
+			register_event(event, &set->poller);
+		}
+
+		event->state = state;
+		if (state != K_POLL_STATE_NOT_READY) {
+			events[num_events++] = event;
+		}
+	}
+
+	while ((event = (struct k_poll_event *)sys_dlist_get(&still_ready))
+	       != NULL) {
+		sys_dlist_append(&set->ready, &event->_node);
+	}
+
+	return num_events;
+}
+
+void k_poll_set_init(struct k_poll_set *set)
+{
+	set->poller.is_polling = false;
+	set->poller.mode = MODE_SET;
+	set->lock = (struct k_spinlock) {};
+	z_waitq_init(&set->wait_q);
+	sys_dlist_init(&set->ready);
+}
+
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key, set_key;
+	uint32_t state;
+	int ret = 0;
+
+	if (event->type == K_POLL_TYPE_IGNORE) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+	set_key = k_spin_lock(&set->lock);
+
+	if (event->poller != NULL) {
+		ret = -EBUSY;
+	} else if (is_condition_met(event, &state)) {
+		event->poller = &set->poller;
+		event->state = state;
+		poll_set_queue(set, event);
+	} else {
+		event->state = K_POLL_STATE_NOT_READY;
+		register_event(event, &set->poller);
+	}
+
+	k_spin_unlock(&set->lock, set_key);
+	k_spin_unlock(&lock, key);
+
+	return ret;
+}
+
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key, set_key;
+	int ret = 0;
+
+	key = k_spin_lock(&lock);
+	set_key = k_spin_lock(&set->lock);
+
+	if (event->poller != &set->poller) {
+		ret = -EINVAL;
+	} else {
+		/* Unlinks it from either its object or the ready list */
+		clear_event_registration(event);
+	}
+
+	k_spin_unlock(&set->lock, set_key);
+	k_spin_unlock(&lock, key);
+
+	return ret;
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **events,
+		    int max_events, k_timeout_t timeout)
+{
+	uint64_t end = sys_clock_timeout_end_calc(timeout);
+	k_spinlock_key_t key, set_key;
+	int num_events;
+
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+	__ASSERT(events != NULL, "NULL events\n");
+	__ASSERT(max_events > 0, "no room for events\n");
+
+	for (;;) {
+		key = k_spin_lock(&lock);
+		set_key = k_spin_lock(&set->lock);
+		num_events = poll_set_harvest(set, events, max_events);
+		k_spin_unlock(&set->lock, set_key);
+		k_spin_unlock(&lock, key);
+
+		if (num_events > 0) {
+			return num_events;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			int64_t left = end - sys_clock_tick_get();
+
+			if (left <= 0) {
+				return -EAGAIN;
+			}
+			timeout = K_TICKS(left);
+		}
+
+		/* Events readied since the harvest are queued by now */
+		set_key = k_spin_lock(&set->lock);
+		if (sys_dlist_is_empty(&set->ready)) {
+			(void)z_pend_curr(&set->lock, set_key, &set->wait_q,
+					  timeout);
+		} else {
+			k_spin_unlock(&set->lock, set_key);
+		}
+	}
+}
@@ -348,6 +348,64 @@ void *z_impl_k_queue_get(struct k_queue *queue, k_timeout_t timeout)
 	return (ret != 0) ? NULL : _current->base.swap_data;
 }
 
+int k_queue_get_batch(struct k_queue *queue, sys_slist_t *list, size_t max,
+		      k_timeout_t timeout)
+{
+	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+	sys_sfnode_t *node;
+	int count = 0;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_queue, get_batch, queue, max, timeout);
+
+	if (unlikely(max == 0U)) {
+		k_spin_unlock(&queue->lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, get_batch, queue, max, timeout, 0);
+
+		return 0;
+	}
+
+	if (sys_sflist_is_empty(&queue->data_q)) {
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_queue, get_batch, queue, max, timeout);
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&queue->lock, key);
+
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, get_batch, queue, max, timeout, 0);
+
+			return 0;
+		}
+
+		if (z_pend_curr(&queue->lock, key, &queue->wait_q, timeout) != 0) {
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, get_batch, queue, max, timeout, 0);
+
+			return 0;
+		}
+
+		/* Handed the first item, take what was queued behind it */
+		sys_slist_append(list, _current->base.swap_data);
+		count = 1;
+
+		key = k_spin_lock(&queue->lock);
+	}
+
+	while (((size_t)count < max) && !sys_sflist_is_empty(&queue->data_q)) {
+		node = sys_sflist_get_not_empty(&queue->data_q);
+
+		__ASSERT(sys_sfnode_flags_get(node) == 0U,
+			 "queue %p has an item added by an alloc function", queue);
+
+		sys_slist_append(list, (sys_snode_t *)node);
+		count++;
+	}
+
+	k_spin_unlock(&queue->lock, key);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, get_batch, queue, max, timeout, count);
+
+	return count;
+}
+
 bool k_queue_remove(struct k_queue *queue, void *data)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_queue, remove, queue);
@@ -464,6 +464,50 @@ static bool thread_active_elsewhere(struct k_thread *thread)
 	return false;
 }
 
+#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
+/* The other CPUs that would switch to the thread if they rescheduled
+ * right now: those it may run on whose current thread it preempts.
+ * Called with sched_spinlock held, so their current threads cannot
+ * change under us.
+ */
+static uint32_t preempt_ipi_mask(struct k_thread *thread)
+{
+	uint32_t mask = 0U;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct k_thread *curr = _kernel.cpus[i].current;
+
+		if ((i == _current_cpu->id) || (curr == NULL)) {
+			continue;
+		}
+#ifdef CONFIG_SCHED_CPU_MASK
+		if ((thread->base.cpu_mask & BIT(i)) == 0U) {
+			continue;
+		}
+#endif
+		if ((is_preempt(curr) || is_metairq(thread)) &&
+		    (z_sched_prio_cmp(thread, curr) > 0)) {
+			mask |= BIT(i);
+		}
+	}
+
+	return mask;
+}
+
+static void sched_ipi(uint32_t mask)
+{
+	if (mask == 0U) {
+		return;
+	}
+
+#ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
+	arch_sched_directed_ipi(mask);
+#else
+	arch_sched_ipi();
+#endif
+}
+#endif
+
 static void ready_thread(struct k_thread *thread)
 {
 #ifdef CONFIG_KERNEL_COHERENCE
@@ -476,10 +520,13 @@ static void ready_thread(struct k_thread *thread)
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
+#ifdef CONFIG_SCHED_LATENCY_STATS
+		thread->rt_stats.last_readied = k_cycle_get_32();
+#endif
 		queue_thread(&_kernel.ready_q.runq, thread);
 		update_cache(0);
 #if defined(CONFIG_SMP) &&  defined(CONFIG_SCHED_IPI_SUPPORTED)
-		arch_sched_ipi();
+		sched_ipi(preempt_ipi_mask(thread));
 #endif
 	}
 }
@@ -768,7 +815,18 @@ void z_thread_priority_set(struct k_thread *thread, int prio)
 	bool need_sched = z_set_prio(thread, prio);
 
 #if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
-	arch_sched_ipi();
+	/* Either the CPU running the thread may now prefer another
+	 * one, or other CPUs may now prefer the thread
+	 */
+	if (need_sched) {
+		LOCKED(&sched_spinlock) {
+			if (thread_active_elsewhere(thread)) {
+				sched_ipi(BIT(thread->base.cpu));
+			} else if (z_is_thread_queued(thread)) {
+				sched_ipi(preempt_ipi_mask(thread));
+			}
+		}
+	}
 #endif
 
 	if (need_sched && _current->base.sched_locked == 0U) {
@@ -889,6 +947,10 @@ void *z_get_next_switch_handle(void *interrupted)
 			z_reset_time_slice();
 #endif
 			_current_cpu->swap_ok = 0;
+			/* As in do_swap(): directed IPIs and per-CPU
+			 * timeouts go to the CPU recorded here.
+			 */
+			new_thread->base.cpu = _current_cpu->id;
 			set_current(new_thread);
 
 #ifdef CONFIG_SPIN_VALIDATE
@@ -1331,10 +1393,6 @@ void z_impl_k_wakeup(k_tid_t thread)
 	z_mark_thread_as_not_suspended(thread);
 	z_ready_thread(thread);
 
-#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
-	arch_sched_ipi();
-#endif
-
 	if (!arch_is_in_isr()) {
 		z_reschedule_unlocked();
 	}
@@ -1353,6 +1411,9 @@ void z_sched_ipi(void)
 #ifdef CONFIG_TRACE_SCHED_IPI
 	z_trace_sched_ipi();
 #endif
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	z_timeout_ipi();
+#endif
 }
 #endif
 
@@ -1513,7 +1574,7 @@ void z_thread_abort(struct k_thread *thread)
 		thread->base.thread_state |= _THREAD_ABORTING;
 
 #ifdef CONFIG_SCHED_IPI_SUPPORTED
-		arch_sched_ipi();
+		sched_ipi(BIT(thread->base.cpu));
 #endif
 	}
 
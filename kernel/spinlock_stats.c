@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <spinlock.h>
+
+/* Singly linked through stats_next.  Locks are only ever pushed, and
+ * never removed, so it can be walked without a lock of its own.
+ */
+static atomic_ptr_t stats_list;
+
+void z_spin_lock_contended(struct k_spinlock *l, uint32_t spins)
+{
+	/* We hold l, so its statistics are ours to update */
+	l->contended++;
+	l->spins += spins;
+	if (spins > l->max_spins) {
+		l->max_spins = spins;
+	}
+
+	if (!l->stats_listed) {
+		struct k_spinlock *head;
+
+		l->stats_listed = true;
+
+		/* A listed lock which was zeroed again lost its flag, and
+		 * its link: pushing it again would make a cycle.
+		 */
+		for (head = atomic_ptr_get(&stats_list); head != NULL;
+		     head = head->stats_next) {
+			if (head == l) {
+				__ASSERT(false, "spinlock %p re-initialized "
+					 "after it was contended", l);
+				return;
+			}
+		}
+
+		do {
+			head = atomic_ptr_get(&stats_list);
+			l->stats_next = head;
+		} while (!atomic_ptr_cas(&stats_list, head, l));
+	}
+}
+
+void z_spin_stats_foreach(z_spin_stats_cb_t cb, void *user_data)
+{
+	for (struct k_spinlock *l = atomic_ptr_get(&stats_list); l != NULL;
+	     l = l->stats_next) {
+		cb(l, user_data);
+	}
+}
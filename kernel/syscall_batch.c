@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <syscall_handler.h>
+#include <sys/speculation.h>
+#include <sys/syscall_batch.h>
+
+int z_impl_k_syscall_batch(struct k_syscall_desc *descs, size_t count)
+{
+	void *ssf = _current->syscall_frame;
+	size_t i;
+
+	/* The marshalling functions below need a user syscall frame to
+	 * report errors, and supervisor threads have no use for this
+	 */
+	if (!z_is_in_user_syscall()) {
+		return -ENOTSUP;
+	}
+
+	for (i = 0; i < count; i++) {
+		struct k_syscall_desc desc = descs[i];
+		uintptr_t *a = desc.args;
+
+		if (desc.id >= K_SYSCALL_LIMIT ||
+		    desc.id == K_SYSCALL_K_SYSCALL_BATCH) {
+			break;
+		}
+
+		desc.id = k_array_index_sanitize(desc.id, K_SYSCALL_LIMIT);
+
+		/* Exactly what the arch syscall entry does, except that
+		 * the verification functions use the frame of this call
+		 * should they need to oops
+		 */
+		descs[i].ret = _k_syscall_table[desc.id](a[0], a[1], a[2], a[3],
+							 a[4], a[5], ssf);
+
+		/* Reset by the marshalling function on its way out */
+		_current->syscall_frame = ssf;
+	}
+
+	return i;
+}
+
+static inline int z_vrfy_k_syscall_batch(struct k_syscall_desc *descs,
+					 size_t count)
+{
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(descs, count,
+					    sizeof(struct k_syscall_desc)));
+
+	return z_impl_k_syscall_batch(descs, count);
+}
+#include <syscalls/k_syscall_batch_mrsh.c>
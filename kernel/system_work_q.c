@@ -19,6 +19,13 @@ static K_KERNEL_STACK_DEFINE(sys_work_q_stack,
 
 struct k_work_q k_sys_work_q;
 
+#if CONFIG_SYSTEM_WORKQUEUE_THREADS > 1
+static K_KERNEL_STACK_ARRAY_DEFINE(sys_work_q_pool_stacks,
+				   CONFIG_SYSTEM_WORKQUEUE_THREADS - 1,
+				   CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE);
+static struct k_thread sys_work_q_pool_threads[CONFIG_SYSTEM_WORKQUEUE_THREADS - 1];
+#endif
+
 static int k_sys_work_q_init(const struct device *dev)
 {
 	ARG_UNUSED(dev);
@@ -31,6 +38,17 @@ static int k_sys_work_q_init(const struct device *dev)
 			    sys_work_q_stack,
 			    K_KERNEL_STACK_SIZEOF(sys_work_q_stack),
 			    CONFIG_SYSTEM_WORKQUEUE_PRIORITY, &cfg);
+
+#if CONFIG_SYSTEM_WORKQUEUE_THREADS > 1
+	for (int i = 0; i < ARRAY_SIZE(sys_work_q_pool_threads); i++) {
+		(void)k_work_queue_thread_add(&k_sys_work_q,
+				&sys_work_q_pool_threads[i],
+				sys_work_q_pool_stacks[i],
+				K_KERNEL_STACK_SIZEOF(sys_work_q_pool_stacks[i]),
+				CONFIG_SYSTEM_WORKQUEUE_PRIORITY, -1);
+	}
+#endif
+
 	return 0;
 }
 
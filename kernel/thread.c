@@ -35,6 +35,14 @@ LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
 k_thread_runtime_stats_t threads_runtime_stats;
 #endif
 
+#ifdef CONFIG_SCHED_LATENCY_STATS
+#define SCHED_PRIO_LEVELS (K_LOWEST_THREAD_PRIO - K_HIGHEST_THREAD_PRIO + 1)
+
+/* Protects the shared histograms, threads only update their own */
+static struct k_spinlock sched_latency_lock;
+static struct k_sched_latency_stats sched_latency_prio[SCHED_PRIO_LEVELS];
+#endif
+
 #ifdef CONFIG_THREAD_MONITOR
 /* This lock protects the linked list of active threads; i.e. the
  * initial _kernel.threads pointer and the linked list made up of
@@ -777,6 +785,8 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 
 #ifdef CONFIG_SMP
 	thread_base->is_idle = 0;
+	/* Recorded each time the thread is switched in */
+	thread_base->cpu = 0;
 #endif
 
 	/* swap_data does not need to be initialized */
@@ -999,9 +1009,75 @@ static inline k_ticks_t z_vrfy_k_thread_timeout_expires_ticks(
 	return z_impl_k_thread_timeout_expires_ticks(t);
 }
 #include <syscalls/k_thread_timeout_expires_ticks_mrsh.c>
+
+#ifdef CONFIG_TIMEOUT_SLACK
+static inline void z_vrfy_k_thread_timeout_slack_set(struct k_thread *t,
+						     k_timeout_t slack)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(t, K_OBJ_THREAD));
+	z_impl_k_thread_timeout_slack_set(t, slack);
+}
+#include <syscalls/k_thread_timeout_slack_set_mrsh.c>
+#endif
 #endif
 
 #ifdef CONFIG_INSTRUMENT_THREAD_SWITCHING
+#ifdef CONFIG_SCHED_LATENCY_STATS
+static void sched_latency_add(struct k_sched_latency_stats *stats,
+			      uint32_t cycles)
+{
+	/* Bin n holds latencies of [2^n, 2^(n+1)) cycles */
+	int bin = (cycles < 2U) ? 0 : (31 - __builtin_clz(cycles));
+
+	stats->counts[MIN(bin, CONFIG_SCHED_LATENCY_STATS_NUM_BINS - 1)]++;
+	stats->max = MAX(stats->max, cycles);
+}
+
+static void sched_latency_switched_in(struct k_thread *thread)
+{
+	uint32_t readied = thread->rt_stats.last_readied;
+	uint32_t latency;
+	k_spinlock_key_t key;
+
+	thread->rt_stats.stats.switches++;
+
+	if (readied == 0U) {
+		/* Was never made ready, e.g. the first thread at boot */
+		return;
+	}
+
+	latency = k_cycle_get_32() - readied;
+	thread->rt_stats.last_readied = 0U;
+	sched_latency_add(&thread->rt_stats.stats.latency, latency);
+
+	key = k_spin_lock(&sched_latency_lock);
+	threads_runtime_stats.switches++;
+	sched_latency_add(&threads_runtime_stats.latency, latency);
+	sched_latency_add(&sched_latency_prio[thread->base.prio -
+					      K_HIGHEST_THREAD_PRIO], latency);
+	k_spin_unlock(&sched_latency_lock, key);
+
+	SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_latency, thread, latency);
+}
+
+static void sched_latency_switched_out(struct k_thread *thread)
+{
+	/* A thread switched out while runnable waits on the run queue
+	 * just like one that was woken up
+	 */
+	if (z_is_thread_ready(thread)) {
+		thread->rt_stats.stats.preemptions++;
+		thread->rt_stats.last_readied = k_cycle_get_32();
+
+		LOCKED(&sched_latency_lock) {
+			threads_runtime_stats.preemptions++;
+		}
+	} else {
+		thread->rt_stats.last_readied = 0U;
+	}
+}
+#endif /* CONFIG_SCHED_LATENCY_STATS */
+
 void z_thread_mark_switched_in(void)
 {
 #ifdef CONFIG_TRACING
@@ -1018,6 +1094,9 @@ void z_thread_mark_switched_in(void)
 	thread->rt_stats.last_switched_in = k_cycle_get_32();
 #endif /* CONFIG_THREAD_RUNTIME_STATS_USE_TIMING_FUNCTIONS */
 
+#ifdef CONFIG_SCHED_LATENCY_STATS
+	sched_latency_switched_in(thread);
+#endif
 #endif /* CONFIG_THREAD_RUNTIME_STATS */
 }
 
@@ -1045,6 +1124,10 @@ void z_thread_mark_switched_out(void)
 		return;
 	}
 
+#ifdef CONFIG_SCHED_LATENCY_STATS
+	sched_latency_switched_out(thread);
+#endif
+
 #ifdef CONFIG_THREAD_RUNTIME_STATS_USE_TIMING_FUNCTIONS
 	now = timing_counter_get();
 	diff = timing_cycles_get(&thread->rt_stats.last_switched_in, &now);
@@ -1091,4 +1174,22 @@ int k_thread_runtime_stats_all_get(k_thread_runtime_stats_t *stats)
 }
 #endif /* CONFIG_THREAD_RUNTIME_STATS */
 
+#ifdef CONFIG_SCHED_LATENCY_STATS
+int k_sched_latency_stats_get(int prio, struct k_sched_latency_stats *stats)
+{
+	if ((stats == NULL) || (prio < K_HIGHEST_THREAD_PRIO) ||
+	    (prio > K_LOWEST_THREAD_PRIO)) {
+		return -EINVAL;
+	}
+
+	LOCKED(&sched_latency_lock) {
+		(void)memcpy(stats,
+			     &sched_latency_prio[prio - K_HIGHEST_THREAD_PRIO],
+			     sizeof(*stats));
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SCHED_LATENCY_STATS */
+
 #endif /* CONFIG_INSTRUMENT_THREAD_SWITCHING */
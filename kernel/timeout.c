@@ -8,21 +8,26 @@
 #include <spinlock.h>
 #include <ksched.h>
 #include <timeout_q.h>
+#include <timeout_wheel.h>
 #include <syscall_handler.h>
 #include <drivers/timer/system_timer.h>
 #include <sys_clock.h>
 
 static uint64_t curr_tick;
 
+#if !defined(CONFIG_TIMEOUT_QUEUE_WHEEL) && !defined(CONFIG_TIMEOUT_PER_CPU)
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif
 
 static struct k_spinlock timeout_lock;
 
 #define MAX_WAIT (IS_ENABLED(CONFIG_SYSTEM_CLOCK_SLOPPY_IDLE) \
 		  ? K_TICKS_FOREVER : INT_MAX)
 
+#ifndef CONFIG_TIMEOUT_PER_CPU
 /* Cycles left to process in the currently-executing sys_clock_announce() */
 static int announce_remaining;
+#endif
 
 #if defined(CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME)
 int z_clock_hw_cycles_per_sec = CONFIG_SYS_CLOCK_HW_CYCLES_PER_SEC;
@@ -36,6 +41,9 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifndef CONFIG_TIMEOUT_PER_CPU
+
+#ifndef CONFIG_TIMEOUT_QUEUE_WHEEL
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -50,13 +58,42 @@ static struct _timeout *next(struct _timeout *t)
 	return n == NULL ? NULL : CONTAINER_OF(n, struct _timeout, node);
 }
 
+#endif /* !CONFIG_TIMEOUT_QUEUE_WHEEL */
+
+#ifdef CONFIG_TIMEOUT_SLACK
+/* Ticks from curr_tick to the latest expiry of the first timeout given
+ * the slack of the ones that are due by then: they all expire at that
+ * point, with a single timer interrupt.
+ */
+static int64_t slack_deadline(void)
+{
+	struct _timeout *t = first();
+	int64_t expiry = t->dticks;
+	int64_t deadline = expiry + t->slack;
+
+	for (t = next(t); t != NULL; t = next(t)) {
+		expiry += t->dticks;
+		if (expiry > deadline) {
+			break;
+		}
+		deadline = MIN(deadline, expiry + t->slack);
+	}
+
+	return deadline;
+}
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 static void remove_timeout(struct _timeout *t)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	z_timeout_wheel_remove(t);
+#else
 	if (next(t) != NULL) {
 		next(t)->dticks += t->dticks;
 	}
 
 	sys_dlist_remove(&t->node);
+#endif
 }
 
 static int32_t elapsed(void)
@@ -66,10 +103,20 @@ static int32_t elapsed(void)
 
 static int32_t next_timeout(void)
 {
-	struct _timeout *to = first();
 	int32_t ticks_elapsed = elapsed();
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	uint64_t next = z_timeout_wheel_next(curr_tick);
+	int32_t ret = next == UINT64_MAX ? MAX_WAIT
+		: CLAMP((int64_t)(next - curr_tick) - ticks_elapsed,
+			0, MAX_WAIT);
+#elif defined(CONFIG_TIMEOUT_SLACK)
+	int32_t ret = first() == NULL ? MAX_WAIT
+		: CLAMP(slack_deadline() - ticks_elapsed, 0, MAX_WAIT);
+#else
+	struct _timeout *to = first();
 	int32_t ret = to == NULL ? MAX_WAIT
 		: CLAMP(to->dticks - ticks_elapsed, 0, MAX_WAIT);
+#endif
 
 #ifdef CONFIG_TIMESLICING
 	if (_current_cpu->slice_ticks && _current_cpu->slice_ticks < ret) {
@@ -94,7 +141,7 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	to->fn = fn;
 
 	LOCKED(&timeout_lock) {
-		struct _timeout *t;
+		bool earliest;
 
 		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
 		    Z_TICK_ABS(timeout.ticks) >= 0) {
@@ -105,6 +152,26 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 			to->dticks = timeout.ticks + 1 + elapsed();
 		}
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+		/* The wheel tracks absolute expiry ticks.  Its next
+		 * event may also be a cascade point, so reprogram the
+		 * timer whenever that moves rather than only when this
+		 * is the very next timeout to expire.
+		 */
+		uint64_t prev = z_timeout_wheel_next(curr_tick);
+
+		to->dticks += curr_tick;
+		z_timeout_wheel_add(to, curr_tick);
+		earliest = z_timeout_wheel_next(curr_tick) != prev;
+#else
+		struct _timeout *t;
+#ifdef CONFIG_TIMEOUT_SLACK
+		/* A timeout behind the first may still advance the
+		 * interrupt, when its slack is smaller.
+		 */
+		int64_t prev = first() == NULL ? INT64_MAX : slack_deadline();
+#endif
+
 		for (t = first(); t != NULL; t = next(t)) {
 			if (t->dticks > to->dticks) {
 				t->dticks -= to->dticks;
@@ -118,7 +185,14 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 			sys_dlist_append(&timeout_list, &to->node);
 		}
 
-		if (to == first()) {
+#ifdef CONFIG_TIMEOUT_SLACK
+		earliest = slack_deadline() < prev;
+#else
+		earliest = to == first();
+#endif
+#endif
+
+		if (earliest) {
 #if CONFIG_TIMESLICING
 			/*
 			 * This is not ideal, since it does not
@@ -164,12 +238,16 @@ static k_ticks_t timeout_rem(const struct _timeout *timeout)
 		return 0;
 	}
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	ticks = timeout->dticks - curr_tick;
+#else
 	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
 		ticks += t->dticks;
 		if (timeout == t) {
 			break;
 		}
 	}
+#endif
 
 	return ticks - elapsed();
 }
@@ -240,6 +318,22 @@ void sys_clock_announce(int32_t ticks)
 
 	announce_remaining = ticks;
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	for (uint64_t next = z_timeout_wheel_next(curr_tick);
+	     next <= curr_tick + announce_remaining;
+	     next = z_timeout_wheel_next(curr_tick)) {
+		struct _timeout *t;
+
+		announce_remaining -= next - curr_tick;
+		curr_tick = next;
+
+		while ((t = z_timeout_wheel_expire(curr_tick)) != NULL) {
+			k_spin_unlock(&timeout_lock, key);
+			t->fn(t);
+			key = k_spin_lock(&timeout_lock);
+		}
+	}
+#else
 	while (first() != NULL && first()->dticks <= announce_remaining) {
 		struct _timeout *t = first();
 		int dt = t->dticks;
@@ -257,6 +351,7 @@ void sys_clock_announce(int32_t ticks)
 	if (first() != NULL) {
 		first()->dticks -= announce_remaining;
 	}
+#endif
 
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
@@ -266,6 +361,315 @@ void sys_clock_announce(int32_t ticks)
 	k_spin_unlock(&timeout_lock, key);
 }
 
+#else /* CONFIG_TIMEOUT_PER_CPU */
+
+/* Timeouts of each CPU, sorted by absolute expiry tick (dticks), and
+ * expired by the timer interrupt of that CPU.  The timer drivers program
+ * a comparator local to the CPU calling sys_clock_set_timeout().  The
+ * global timeout_lock only covers curr_tick, and is taken with the lock
+ * of a queue held, never the other way around.
+ */
+struct timeout_queue {
+	sys_dlist_t list;
+	struct k_spinlock lock;
+	/* Set when another CPU queued a timeout ahead of the others */
+	bool rearm;
+};
+
+#define TIMEOUT_QUEUE_INIT(i, _) \
+	[i] = { .list = SYS_DLIST_STATIC_INIT(&timeout_queues[i].list) },
+
+static struct timeout_queue timeout_queues[CONFIG_MP_NUM_CPUS] = {
+	UTIL_LISTIFY(CONFIG_MP_NUM_CPUS, TIMEOUT_QUEUE_INIT, _)
+};
+
+static struct _timeout *first(struct timeout_queue *q)
+{
+	sys_dnode_t *t = sys_dlist_peek_head(&q->list);
+
+	return t == NULL ? NULL : CONTAINER_OF(t, struct _timeout, node);
+}
+
+/* Current tick, and the last announced one in @p announced if not NULL */
+static uint64_t tick_now(uint64_t *announced)
+{
+	uint64_t t = 0U;
+
+	LOCKED(&timeout_lock) {
+		if (announced != NULL) {
+			*announced = curr_tick;
+		}
+		t = curr_tick + sys_clock_elapsed();
+	}
+
+	return t;
+}
+
+/* Must be called with the queue of the current CPU locked */
+static int32_t next_timeout(struct timeout_queue *q)
+{
+	struct _timeout *to = first(q);
+	int32_t ret = to == NULL ? MAX_WAIT
+		: CLAMP((int64_t)(to->dticks - tick_now(NULL)), 0, MAX_WAIT);
+
+#ifdef CONFIG_TIMESLICING
+	if (_current_cpu->slice_ticks && _current_cpu->slice_ticks < ret) {
+		ret = _current_cpu->slice_ticks;
+	}
+#endif
+	return ret;
+}
+
+/* CPU whose queue a new timeout goes to: for a thread timeout, the CPU
+ * the thread is pinned to or last ran on, for the thread to be woken up
+ * there.  Otherwise the current CPU.
+ */
+static int timeout_cpu(struct _timeout *to)
+{
+#ifdef CONFIG_SCHED_IPI_SUPPORTED
+	if (to->fn == z_thread_timeout) {
+		struct k_thread *thread = CONTAINER_OF(to, struct k_thread,
+						       base.timeout);
+
+#ifdef CONFIG_SCHED_CPU_MASK
+		uint8_t mask = thread->base.cpu_mask;
+
+		if (mask != 0U && (mask & (mask - 1U)) == 0U) {
+			return find_lsb_set(mask) - 1;
+		}
+#endif
+		if (z_has_thread_started(thread)) {
+			return thread->base.cpu;
+		}
+	}
+#endif
+	return _current_cpu->id;
+}
+
+void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
+		   k_timeout_t timeout)
+{
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		return;
+	}
+
+#ifdef CONFIG_KERNEL_COHERENCE
+	__ASSERT_NO_MSG(arch_mem_coherent(to));
+#endif
+
+	__ASSERT(!sys_dnode_is_linked(&to->node), "");
+	to->fn = fn;
+
+	/* Stay on this CPU until its timer is programmed */
+	unsigned int irq_key = arch_irq_lock();
+	int cpu = timeout_cpu(to);
+	struct timeout_queue *q = &timeout_queues[cpu];
+	bool ipi = false;
+
+	LOCKED(&q->lock) {
+		struct _timeout *t;
+		uint64_t announced;
+		uint64_t now = tick_now(&announced);
+
+		if (Z_TICK_ABS(timeout.ticks) >= 0) {
+			to->dticks = MAX(announced + 1,
+					 (uint64_t)Z_TICK_ABS(timeout.ticks));
+		} else {
+			to->dticks = now + timeout.ticks + 1;
+		}
+
+		to->cpu = cpu;
+
+		for (t = first(q); t != NULL;
+		     t = SYS_DLIST_PEEK_NEXT_CONTAINER(&q->list, t, node)) {
+			if (t->dticks > to->dticks) {
+				sys_dlist_insert(&t->node, &to->node);
+				break;
+			}
+		}
+
+		if (t == NULL) {
+			sys_dlist_append(&q->list, &to->node);
+		}
+
+		if (to == first(q)) {
+			if (cpu == _current_cpu->id) {
+				sys_clock_set_timeout(next_timeout(q), false);
+			} else {
+				q->rearm = true;
+				ipi = true;
+			}
+		}
+	}
+
+#ifdef CONFIG_SCHED_IPI_SUPPORTED
+	if (ipi) {
+#ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
+		arch_sched_directed_ipi(BIT(cpu));
+#else
+		arch_sched_ipi();
+#endif
+	}
+#else
+	ARG_UNUSED(ipi);
+#endif
+
+	arch_irq_unlock(irq_key);
+}
+
+/* Reprogram the timer of the current CPU after another CPU queued the
+ * first timeout of its queue, from the scheduler IPI.
+ */
+void z_timeout_ipi(void)
+{
+	struct timeout_queue *q = &timeout_queues[_current_cpu->id];
+
+	LOCKED(&q->lock) {
+		if (q->rearm) {
+			q->rearm = false;
+			sys_clock_set_timeout(next_timeout(q), false);
+		}
+	}
+}
+
+/* Lock the queue holding a timeout, which may be another CPU's one */
+static struct timeout_queue *queue_lock(const struct _timeout *to,
+					k_spinlock_key_t *key)
+{
+	while (true) {
+		int cpu = to->cpu;
+		struct timeout_queue *q = &timeout_queues[cpu];
+
+		__ASSERT(cpu < CONFIG_MP_NUM_CPUS, "timeout %p not initialized",
+			 to);
+
+		*key = k_spin_lock(&q->lock);
+		if (to->cpu == cpu) {
+			return q;
+		}
+		k_spin_unlock(&q->lock, *key);
+	}
+}
+
+int z_abort_timeout(struct _timeout *to)
+{
+	k_spinlock_key_t key;
+	struct timeout_queue *q = queue_lock(to, &key);
+	int ret = -EINVAL;
+
+	/* The timer of the queue's CPU may be left programmed for this
+	 * timeout: its interrupt then finds nothing to expire.
+	 */
+	if (sys_dnode_is_linked(&to->node)) {
+		sys_dlist_remove(&to->node);
+		ret = 0;
+	}
+
+	k_spin_unlock(&q->lock, key);
+
+	return ret;
+}
+
+k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
+{
+	k_spinlock_key_t key;
+	struct timeout_queue *q = queue_lock(timeout, &key);
+	k_ticks_t ticks = 0;
+
+	if (!z_is_inactive_timeout(timeout)) {
+		ticks = timeout->dticks - tick_now(NULL);
+	}
+
+	k_spin_unlock(&q->lock, key);
+
+	return ticks;
+}
+
+k_ticks_t z_timeout_expires(const struct _timeout *timeout)
+{
+	k_spinlock_key_t key;
+	struct timeout_queue *q = queue_lock(timeout, &key);
+	k_ticks_t ticks;
+
+	ticks = z_is_inactive_timeout(timeout) ? tick_now(NULL)
+		: timeout->dticks;
+
+	k_spin_unlock(&q->lock, key);
+
+	return ticks;
+}
+
+int32_t z_get_next_timeout_expiry(void)
+{
+	int32_t ret = (int32_t) K_TICKS_FOREVER;
+	unsigned int irq_key = arch_irq_lock();
+	struct timeout_queue *q = &timeout_queues[_current_cpu->id];
+
+	LOCKED(&q->lock) {
+		ret = next_timeout(q);
+	}
+
+	arch_irq_unlock(irq_key);
+
+	return ret;
+}
+
+void z_set_timeout_expiry(int32_t ticks, bool is_idle)
+{
+	unsigned int irq_key = arch_irq_lock();
+	struct timeout_queue *q = &timeout_queues[_current_cpu->id];
+
+	LOCKED(&q->lock) {
+		int next_to = next_timeout(q);
+
+		/* As above, on SMP, the timeout is set unless one is
+		 * about to expire.
+		 */
+		if (next_to > 1) {
+			sys_clock_set_timeout(MIN(ticks, next_to), is_idle);
+		}
+	}
+
+	arch_irq_unlock(irq_key);
+}
+
+void sys_clock_announce(int32_t ticks)
+{
+	struct timeout_queue *q = &timeout_queues[_current_cpu->id];
+	struct _timeout *t;
+	uint64_t now = 0U;
+
+#ifdef CONFIG_TIMESLICING
+	z_time_slice(ticks);
+#endif
+
+	LOCKED(&timeout_lock) {
+		curr_tick += ticks;
+		now = curr_tick;
+	}
+
+	/* Only the timeouts of this CPU: the others are expired by the
+	 * timer interrupts of their CPUs.
+	 */
+	k_spinlock_key_t key = k_spin_lock(&q->lock);
+
+	q->rearm = false;
+
+	while ((t = first(q)) != NULL && t->dticks <= now) {
+		sys_dlist_remove(&t->node);
+
+		k_spin_unlock(&q->lock, key);
+		t->fn(t);
+		key = k_spin_lock(&q->lock);
+	}
+
+	sys_clock_set_timeout(next_timeout(q), false);
+
+	k_spin_unlock(&q->lock, key);
+}
+
+#endif /* CONFIG_TIMEOUT_PER_CPU */
+
 int64_t sys_clock_tick_get(void)
 {
 	uint64_t t = 0U;
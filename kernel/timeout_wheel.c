@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <sys/dlist.h>
+#include <timeout_wheel.h>
+
+/* Hashed hierarchical timing wheel (Varghese & Lauck).
+ *
+ * Each level has SLOTS lists and covers SLOT_BITS bits ("digits") of
+ * the absolute expiry tick.  A timeout is stored at the level of the
+ * most significant digit in which its expiry differs from the current
+ * tick, in the slot given by its own digit at that level.  Entries in
+ * level 0 therefore all expire exactly at the tick of their slot, and
+ * entries at higher levels are redistributed ("cascaded") into lower
+ * levels when the current tick reaches the start of their slot.
+ * Expiries too far in the future for the wheel land in an unsorted
+ * overflow list that is cascaded each time the whole wheel wraps.
+ *
+ * As every entry shares all digits above its level with the current
+ * tick, the occupied slots of a level are always ahead of the current
+ * digit, so a per-level bitmap is enough to find the next event.
+ *
+ * List heads are only valid while their occupancy bit is set, which
+ * spares us an initialization pass over the wheel.
+ */
+
+#define SLOT_BITS CONFIG_TIMEOUT_QUEUE_WHEEL_SLOT_BITS
+#define SLOTS BIT(SLOT_BITS)
+#define SLOT_MASK (SLOTS - 1)
+#define LEVELS CONFIG_TIMEOUT_QUEUE_WHEEL_LEVELS
+#define WHEEL_MASK (BIT64(SLOT_BITS * LEVELS) - 1)
+
+BUILD_ASSERT(SLOT_BITS * LEVELS <= 30, "timing wheel span too large");
+
+static sys_dlist_t wheel[LEVELS][SLOTS];
+static uint32_t occupied[LEVELS];
+
+static sys_dlist_t overflow;
+static bool overflow_used;
+
+/* Last tick for which cascading has been done */
+static uint64_t cascaded_tick;
+
+static inline uint32_t digit(uint64_t tick, int level)
+{
+	return (uint32_t)(tick >> (level * SLOT_BITS)) & SLOT_MASK;
+}
+
+static void slot_append(int level, uint32_t slot, struct _timeout *to)
+{
+	sys_dlist_t *list = &wheel[level][slot];
+
+	if ((occupied[level] & BIT(slot)) == 0U) {
+		occupied[level] |= BIT(slot);
+		sys_dlist_init(list);
+	}
+	sys_dlist_append(list, &to->node);
+}
+
+void z_timeout_wheel_add(struct _timeout *to, uint64_t now)
+{
+	uint64_t expiry = (uint64_t)to->dticks;
+	uint64_t diff = expiry ^ now;
+	int level;
+
+	__ASSERT_NO_MSG(expiry >= now);
+
+	if ((diff & ~WHEEL_MASK) != 0U) {
+		if (!overflow_used) {
+			overflow_used = true;
+			sys_dlist_init(&overflow);
+		}
+		sys_dlist_append(&overflow, &to->node);
+		return;
+	}
+
+	level = diff == 0U ? 0 : (find_msb_set((uint32_t)diff) - 1) / SLOT_BITS;
+	slot_append(level, digit(expiry, level), to);
+}
+
+void z_timeout_wheel_remove(struct _timeout *to)
+{
+	sys_dnode_t *next = to->node.next;
+
+	sys_dlist_remove(&to->node);
+
+	/* Only an emptied list head points back to itself */
+	if (next->next != next) {
+		return;
+	}
+
+	if (next == &overflow) {
+		overflow_used = false;
+	} else {
+		size_t idx = next - &wheel[0][0];
+
+		occupied[idx / SLOTS] &= ~BIT(idx % SLOTS);
+	}
+}
+
+uint64_t z_timeout_wheel_next(uint64_t now)
+{
+	for (int level = 0; level < LEVELS; level++) {
+		int shift = level * SLOT_BITS;
+		uint32_t d = digit(now, level);
+		/* Level 0 holds exact expiries, so an entry in the
+		 * current slot is due right now.  Above that, the
+		 * current slot of a level is always empty.
+		 */
+		uint32_t ahead = level == 0 ? (~0U << d) : (~1U << d);
+		uint32_t pending = occupied[level] & ahead;
+
+		/* Lower levels always expire before the next slot of a
+		 * higher level begins, so the first hit is the answer.
+		 */
+		if (pending != 0U) {
+			uint64_t slot = find_lsb_set(pending) - 1;
+
+			return (now & ~(BIT64(shift + SLOT_BITS) - 1)) |
+			       (slot << shift);
+		}
+	}
+
+	return overflow_used ? ((now | WHEEL_MASK) + 1) : UINT64_MAX;
+}
+
+static void cascade(sys_dlist_t *list, uint64_t now)
+{
+	sys_dlist_t pending;
+	sys_dnode_t *node;
+
+	/* Entries may be put back on the overflow list, so detach
+	 * them all first.
+	 */
+	sys_dlist_init(&pending);
+	while ((node = sys_dlist_get(list)) != NULL) {
+		sys_dlist_append(&pending, node);
+	}
+
+	while ((node = sys_dlist_get(&pending)) != NULL) {
+		z_timeout_wheel_add(CONTAINER_OF(node, struct _timeout, node),
+				    now);
+	}
+}
+
+struct _timeout *z_timeout_wheel_expire(uint64_t now)
+{
+	uint32_t d = digit(now, 0);
+	sys_dnode_t *node;
+
+	if (cascaded_tick != now) {
+		cascaded_tick = now;
+
+		if ((now & WHEEL_MASK) == 0U && overflow_used) {
+			overflow_used = false;
+			cascade(&overflow, now);
+		}
+
+		for (int level = LEVELS - 1; level > 0; level--) {
+			uint32_t slot = digit(now, level);
+
+			if ((now & (BIT64(level * SLOT_BITS) - 1)) != 0U ||
+			    (occupied[level] & BIT(slot)) == 0U) {
+				continue;
+			}
+
+			occupied[level] &= ~BIT(slot);
+			cascade(&wheel[level][slot], now);
+		}
+	}
+
+	if ((occupied[0] & BIT(d)) == 0U) {
+		return NULL;
+	}
+
+	node = sys_dlist_get(&wheel[0][d]);
+	if (sys_dlist_is_empty(&wheel[0][d])) {
+		occupied[0] &= ~BIT(d);
+	}
+
+	return CONTAINER_OF(node, struct _timeout, node);
+}
@@ -8,7 +8,6 @@
 #include <kernel.h>
 #include <string.h>
 #include <sys/math_extras.h>
-#include <sys/rb.h>
 #include <kernel_structs.h>
 #include <sys/sys_io.h>
 #include <ksched.h>
@@ -46,7 +45,7 @@ LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
  * not.
  */
 #ifdef CONFIG_DYNAMIC_OBJECTS
-static struct k_spinlock lists_lock;       /* kobj rbtree/dlist */
+static struct k_spinlock lists_lock;       /* kobj hash table/dlist */
 static struct k_spinlock objfree_lock;     /* k_object_free */
 #endif
 static struct k_spinlock obj_lock;         /* kobj struct data */
@@ -135,7 +134,6 @@ uint8_t *z_priv_stack_find(k_thread_stack_t *stack)
 struct dyn_obj {
 	struct z_object kobj;
 	sys_dnode_t dobj_list;
-	struct rbnode node; /* must be immediately before data member */
 
 	/* The object itself */
 	uint8_t data[] __aligned(DYN_OBJ_DATA_ALIGN_K_THREAD);
@@ -145,15 +143,18 @@ extern struct z_object *z_object_gperf_find(const void *obj);
 extern void z_object_gperf_wordlist_foreach(_wordlist_cb_func_t func,
 					     void *context);
 
-static bool node_lessthan(struct rbnode *a, struct rbnode *b);
-
 /*
- * Red/black tree of allocated kernel objects, for reasonably fast lookups
- * based on object pointer values.
+ * Open addressing hash table of allocated kernel objects, for constant time
+ * lookups based on object pointer values. Linear probing is used, with
+ * backward shift deletion so that there are no tombstones. The table holds
+ * BIT(obj_table_bits) slots when allocated, and is kept between 1/8 and 1/2
+ * full.
  */
-static struct rbtree obj_rb_tree = {
-	.lessthan_fn = node_lessthan
-};
+#define OBJ_TABLE_MIN_BITS 4
+
+static struct dyn_obj **obj_table;
+static uint8_t obj_table_bits;
+static size_t obj_count;
 
 /*
  * Linked list of allocated kernel objects, for iteration over all allocated
@@ -162,8 +163,7 @@ static struct rbtree obj_rb_tree = {
 static sys_dlist_t obj_list = SYS_DLIST_STATIC_INIT(&obj_list);
 
 /*
- * TODO: Write some hash table code that will replace both obj_rb_tree
- * and obj_list.
+ * TODO: Iterate over obj_table instead, so that obj_list can go.
  */
 
 static size_t obj_size_get(enum k_objects otype)
@@ -200,40 +200,128 @@ static size_t obj_align_get(enum k_objects otype)
 	return ret;
 }
 
-static bool node_lessthan(struct rbnode *a, struct rbnode *b)
+static inline size_t obj_hash(const struct dyn_obj *dyn, uint8_t bits)
 {
-	return a < b;
+	/* Fibonacci hashing of the pointer, without its alignment bits */
+	uint32_t h = (uint32_t)((uintptr_t)dyn / sizeof(void *)) * 2654435769U;
+
+	return h >> (32U - bits);
 }
 
-static inline struct dyn_obj *node_to_dyn_obj(struct rbnode *node)
+static void obj_table_insert(struct dyn_obj **table, uint8_t bits,
+			     struct dyn_obj *dyn)
 {
-	return CONTAINER_OF(node, struct dyn_obj, node);
+	size_t mask = BIT(bits) - 1U;
+	size_t i = obj_hash(dyn, bits);
+
+	while (table[i] != NULL) {
+		i = (i + 1U) & mask;
+	}
+	table[i] = dyn;
 }
 
-static inline struct rbnode *dyn_obj_to_node(void *obj)
+/*
+ * Rehash the table into one of BIT(bits) slots. Returns the previous table,
+ * which is for the caller to free once it has released its locks, or NULL.
+ * Nothing changes if the new table cannot be allocated, which only matters
+ * to callers growing a full table.
+ *
+ * The table is allocated from the same pool as the objects it indexes.
+ */
+static struct dyn_obj **obj_table_resize(uint8_t bits)
 {
-	struct dyn_obj *dobj = CONTAINER_OF(obj, struct dyn_obj, data);
+	struct dyn_obj **old = obj_table;
+	struct dyn_obj **table;
+	size_t size = (old == NULL) ? 0 : BIT(obj_table_bits);
+
+	table = z_thread_malloc(BIT(bits) * sizeof(*table));
+	if (table == NULL) {
+		return NULL;
+	}
 
-	return &dobj->node;
+	(void)memset(table, 0, BIT(bits) * sizeof(*table));
+	for (size_t i = 0; i < size; i++) {
+		if (old[i] != NULL) {
+			obj_table_insert(table, bits, old[i]);
+		}
+	}
+
+	obj_table = table;
+	obj_table_bits = bits;
+
+	return old;
+}
+
+/* Size the table for count objects, returns a table to free as
+ * obj_table_resize() does
+ */
+static struct dyn_obj **obj_table_fit(size_t count)
+{
+	if (obj_table == NULL) {
+		return obj_table_resize(OBJ_TABLE_MIN_BITS);
+	}
+
+	if (count * 2U > BIT(obj_table_bits)) {
+		return obj_table_resize(obj_table_bits + 1U);
+	}
+
+	if (obj_table_bits > OBJ_TABLE_MIN_BITS &&
+	    count < BIT(obj_table_bits - 3U)) {
+		return obj_table_resize(obj_table_bits - 1U);
+	}
+
+	return NULL;
+}
+
+static void obj_table_remove(struct dyn_obj *dyn)
+{
+	size_t mask = BIT(obj_table_bits) - 1U;
+	size_t i = obj_hash(dyn, obj_table_bits);
+	size_t j;
+
+	while (obj_table[i] != dyn) {
+		i = (i + 1U) & mask;
+	}
+
+	/* Fill the hole with the next entry of the run that doesn't sit
+	 * between the hole and its home slot, until the run ends.
+	 */
+	for (j = (i + 1U) & mask; obj_table[j] != NULL; j = (j + 1U) & mask) {
+		size_t home = obj_hash(obj_table[j], obj_table_bits);
+
+		if (((j - home) & mask) >= ((j - i) & mask)) {
+			obj_table[i] = obj_table[j];
+			i = j;
+		}
+	}
+	obj_table[i] = NULL;
+	obj_count--;
 }
 
 static struct dyn_obj *dyn_object_find(void *obj)
 {
-	struct rbnode *node;
-	struct dyn_obj *ret;
+	struct dyn_obj *dyn;
+	struct dyn_obj *ret = NULL;
 
 	/* For any dynamically allocated kernel object, the object
 	 * pointer is just a member of the conatining struct dyn_obj,
-	 * so just a little arithmetic is necessary to locate the
-	 * corresponding struct rbnode
+	 * so just a little arithmetic is necessary to locate it. It
+	 * is only dereferenced once found in the table.
 	 */
-	node = dyn_obj_to_node(obj);
+	dyn = CONTAINER_OF(obj, struct dyn_obj, data);
 
 	k_spinlock_key_t key = k_spin_lock(&lists_lock);
-	if (rb_contains(&obj_rb_tree, node)) {
-		ret = node_to_dyn_obj(node);
-	} else {
-		ret = NULL;
+
+	if (obj_table != NULL) {
+		size_t mask = BIT(obj_table_bits) - 1U;
+
+		for (size_t i = obj_hash(dyn, obj_table_bits);
+		     obj_table[i] != NULL; i = (i + 1U) & mask) {
+			if (obj_table[i] == dyn) {
+				ret = dyn;
+				break;
+			}
+		}
 	}
 	k_spin_unlock(&lists_lock, key);
 
@@ -318,12 +406,26 @@ struct z_object *z_dynamic_object_aligned_create(size_t align, size_t size)
 	dyn->kobj.flags = 0;
 	(void)memset(dyn->kobj.perms, 0, CONFIG_MAX_THREAD_BYTES);
 
+	struct dyn_obj **old;
 	k_spinlock_key_t key = k_spin_lock(&lists_lock);
 
-	rb_insert(&obj_rb_tree, &dyn->node);
+	old = obj_table_fit(obj_count + 1U);
+
+	/* Growing may fail, which is fine until the table fills up */
+	if (obj_table == NULL || obj_count + 1U >= BIT(obj_table_bits)) {
+		k_spin_unlock(&lists_lock, key);
+		LOG_ERR("could not index kernel object, out of memory");
+		k_free(dyn);
+		return NULL;
+	}
+
+	obj_table_insert(obj_table, obj_table_bits, dyn);
+	obj_count++;
 	sys_dlist_append(&obj_list, &dyn->dobj_list);
 	k_spin_unlock(&lists_lock, key);
 
+	k_free(old);
+
 	return &dyn->kobj;
 }
 
@@ -384,6 +486,7 @@ void *z_impl_k_object_alloc(enum k_objects otype)
 void k_object_free(void *obj)
 {
 	struct dyn_obj *dyn;
+	struct dyn_obj **old = NULL;
 
 	/* This function is intentionally not exposed to user mode.
 	 * There's currently no robust way to track that an object isn't
@@ -394,8 +497,12 @@ void k_object_free(void *obj)
 
 	dyn = dyn_object_find(obj);
 	if (dyn != NULL) {
-		rb_remove(&obj_rb_tree, &dyn->node);
+		k_spinlock_key_t lists_key = k_spin_lock(&lists_lock);
+
+		obj_table_remove(dyn);
+		old = obj_table_fit(obj_count);
 		sys_dlist_remove(&dyn->dobj_list);
+		k_spin_unlock(&lists_lock, lists_key);
 
 		if (dyn->kobj.type == K_OBJ_THREAD) {
 			thread_idx_free(dyn->kobj.data.thread_id);
@@ -406,6 +513,7 @@ void k_object_free(void *obj)
 	if (dyn != NULL) {
 		k_free(dyn);
 	}
+	k_free(old);
 }
 
 struct z_object *z_object_find(const void *obj)
@@ -498,7 +606,10 @@ static void unref_check(struct z_object *ko, uintptr_t index)
 		break;
 	}
 
-	rb_remove(&obj_rb_tree, &dyn->node);
+	/* Our caller may be holding lists_lock, so the table is only
+	 * resized by the next allocation or k_object_free()
+	 */
+	obj_table_remove(dyn);
 	sys_dlist_remove(&dyn->dobj_list);
 	k_free(dyn);
 out:
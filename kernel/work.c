@@ -184,6 +184,9 @@ static void queue_flusher_locked(struct k_work_q *queue,
 	}
 
 	init_flusher(flusher);
+#ifdef CONFIG_WORKQUEUE_POOL
+	flusher->target = work;
+#endif
 	if (in_list) {
 		sys_slist_insert(&queue->pending, &work->node,
 				 &flusher->work.node);
@@ -207,6 +210,109 @@ static inline void queue_remove_locked(struct k_work_q *queue,
 	}
 }
 
+/* Test whether a thread is one of the threads serving a queue.
+ *
+ * Invoked with work lock held.
+ */
+static inline bool queue_is_worker_locked(const struct k_work_q *queue,
+					  const struct k_thread *thread)
+{
+	if (thread == &queue->thread) {
+		return true;
+	}
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	for (int i = 0; i < queue->pool_size; i++) {
+		if (thread == queue->pool[i]) {
+			return true;
+		}
+	}
+#endif
+
+	return false;
+}
+
+#ifdef CONFIG_WORKQUEUE_POOL
+/* Test whether a pending item may be started by a pool thread: it must
+ * not be running on another thread, and a flusher must not overtake
+ * the running item it is waiting for.
+ *
+ * Invoked with work lock held.
+ */
+static inline bool work_startable_locked(const struct k_work *work)
+{
+	if (flag_test(&work->flags, K_WORK_RUNNING_BIT)) {
+		return false;
+	}
+
+	if (work->handler == handle_flush) {
+		const struct z_work_flusher *flusher =
+			CONTAINER_OF(work, struct z_work_flusher, work);
+
+		return !flag_test(&flusher->target->flags, K_WORK_RUNNING_BIT);
+	}
+
+	return true;
+}
+#endif
+
+/* Remove the next item to be processed from a queue.
+ *
+ * Invoked with work lock held.
+ *
+ * @return the work item, or null if there is none that can be started
+ * now.
+ */
+static struct k_work *queue_take_locked(struct k_work_q *queue)
+{
+	sys_snode_t *node = NULL;
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	if (queue->pool_size > 0) {
+		sys_snode_t *prev = NULL;
+
+		SYS_SLIST_FOR_EACH_NODE(&queue->pending, node) {
+			if (work_startable_locked(CONTAINER_OF(node,
+							       struct k_work,
+							       node))) {
+				sys_slist_remove(&queue->pending, prev, node);
+				break;
+			}
+			prev = node;
+		}
+	} else
+#endif
+	{
+		node = sys_slist_get(&queue->pending);
+	}
+
+	return (node != NULL) ? CONTAINER_OF(node, struct k_work, node) : NULL;
+}
+
+/* Record that a queue thread started or finished processing an item.
+ *
+ * Invoked with work lock held.
+ */
+static inline void queue_busy_locked(struct k_work_q *queue, bool busy)
+{
+#ifdef CONFIG_WORKQUEUE_POOL
+	if (busy) {
+		queue->busy++;
+	} else {
+		__ASSERT_NO_MSG(queue->busy > 0);
+		if (--queue->busy != 0U) {
+			return;
+		}
+	}
+#endif
+
+	if (busy) {
+		flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+	} else {
+		flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+	}
+}
+
 /* Potentially notify a queue that it needs to look for pending work.
  *
  * This may make the work queue thread ready, but as the lock is held it
@@ -256,7 +362,7 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	}
 
 	int ret = -EBUSY;
-	bool chained = (_current == &queue->thread) && !k_is_in_isr();
+	bool chained = queue_is_worker_locked(queue, _current) && !k_is_in_isr();
 	bool draining = flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 	bool plugged = flag_test(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
 
@@ -582,24 +688,24 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 	struct k_work_q *queue = (struct k_work_q *)workq_ptr;
 
 	while (true) {
-		sys_snode_t *node;
-		struct k_work *work = NULL;
+		struct k_work *work;
 		k_work_handler_t handler = NULL;
 		k_spinlock_key_t key = k_spin_lock(&lock);
 
 		/* Check for and prepare any new work. */
-		node = sys_slist_get(&queue->pending);
-		if (node != NULL) {
+		work = queue_take_locked(queue);
+		if (work != NULL) {
 			/* Mark that there's some work active that's
 			 * not on the pending list.
 			 */
-			flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
-			work = CONTAINER_OF(node, struct k_work, node);
+			queue_busy_locked(queue, true);
 			flag_set(&work->flags, K_WORK_RUNNING_BIT);
 			flag_clear(&work->flags, K_WORK_QUEUED_BIT);
 			handler = work->handler;
-		} else if (flag_test_and_clear(&queue->flags,
-					       K_WORK_QUEUE_DRAIN_BIT)) {
+		} else if (sys_slist_is_empty(&queue->pending)
+			   && !flag_test(&queue->flags, K_WORK_QUEUE_BUSY_BIT)
+			   && flag_test_and_clear(&queue->flags,
+						  K_WORK_QUEUE_DRAIN_BIT)) {
 			/* Not busy and draining: move threads waiting for
 			 * drain to ready state.  The held spinlock inhibits
 			 * immediate reschedule; released threads get their
@@ -611,8 +717,9 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 */
 			(void)z_sched_wake_all(&queue->drainq, 1, NULL);
 		} else {
-			/* No work is available and no queue state requires
-			 * special handling.
+			/* No work is available, or in a pool what is
+			 * pending has to wait for other threads, and no
+			 * queue state requires special handling.
 			 */
 			;
 		}
@@ -649,7 +756,18 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 				finalize_cancel_locked(work);
 			}
 
-			flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+			queue_busy_locked(queue, false);
+
+#ifdef CONFIG_WORKQUEUE_POOL
+			/* Items held back while this one ran may now be
+			 * started by another idle thread.
+			 */
+			if ((queue->pool_size > 0)
+			    && !sys_slist_is_empty(&queue->pending)) {
+				(void)notify_queue_locked(queue);
+			}
+#endif
+
 			yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
 			k_spin_unlock(&lock, key);
 
@@ -679,6 +797,10 @@ void k_work_queue_start(struct k_work_q *queue,
 	sys_slist_init(&queue->pending);
 	z_waitq_init(&queue->notifyq);
 	z_waitq_init(&queue->drainq);
+#ifdef CONFIG_WORKQUEUE_POOL
+	queue->pool_size = 0;
+	queue->busy = 0;
+#endif
 
 	if ((cfg != NULL) && cfg->no_yield) {
 		flags |= K_WORK_QUEUE_NO_YIELD;
@@ -703,6 +825,61 @@ void k_work_queue_start(struct k_work_q *queue,
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+int k_work_queue_thread_add(struct k_work_q *queue, struct k_thread *thread,
+			    k_thread_stack_t *stack, size_t stack_size,
+			    int prio, int cpu)
+{
+	__ASSERT_NO_MSG(queue);
+	__ASSERT_NO_MSG(thread);
+	__ASSERT_NO_MSG(stack);
+
+	if (!IS_ENABLED(CONFIG_SCHED_CPU_MASK) && (cpu >= 0)) {
+		return -EINVAL;
+	}
+	if (cpu >= CONFIG_MP_NUM_CPUS) {
+		return -EINVAL;
+	}
+
+	int ret = 0;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT)) {
+		ret = -ENODEV;
+	} else if (queue->pool_size >= ARRAY_SIZE(queue->pool)) {
+		ret = -ENOMEM;
+	} else {
+		/* Reserve the slot, the thread doesn't run until started */
+		queue->pool[queue->pool_size++] = thread;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (ret != 0) {
+		return ret;
+	}
+
+	(void)k_thread_create(thread, stack, stack_size,
+			      work_queue_main, queue, NULL, NULL,
+			      prio, 0, K_FOREVER);
+
+#ifdef CONFIG_THREAD_NAME
+	k_thread_name_set(thread, k_thread_name_get(&queue->thread));
+#endif
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	if (cpu >= 0) {
+		(void)k_thread_cpu_mask_clear(thread);
+		(void)k_thread_cpu_mask_enable(thread, cpu);
+	}
+#endif
+
+	k_thread_start(thread);
+
+	return 0;
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 int k_work_queue_drain(struct k_work_q *queue,
 		       bool plug)
 {
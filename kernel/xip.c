@@ -10,6 +10,7 @@
 #include <kernel.h>
 #include <string.h>
 #include <linker/linker-defs.h>
+#include <kernel_internal.h>
 
 #ifdef CONFIG_STACK_CANARIES
 extern volatile uintptr_t __stack_chk_guard;
@@ -25,6 +26,8 @@ extern volatile uintptr_t __stack_chk_guard;
  */
 void z_data_copy(void)
 {
+	timing_t start = z_boot_profile_early_begin();
+
 	(void)memcpy(&__data_ram_start, &__data_rom_start,
 		 __data_ram_end - __data_ram_start);
 #ifdef CONFIG_ARCH_HAS_RAMFUNC_SUPPORT
@@ -72,4 +75,6 @@ void z_data_copy(void)
 		 _app_smem_end - _app_smem_start);
 #endif /* CONFIG_STACK_CANARIES */
 #endif /* CONFIG_USERSPACE */
+
+	z_boot_profile_early_end(Z_BOOT_PROFILE_DATA_COPY, start);
 }
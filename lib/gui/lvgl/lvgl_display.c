@@ -6,6 +6,30 @@
 
 #include "lvgl_display.h"
 
+#ifdef CONFIG_LVGL_ASYNC_FLUSH
+static void lvgl_flush_done(const struct device *dev, int result,
+		void *user_data)
+{
+	lv_disp_flush_ready((lv_disp_drv_t *)user_data);
+}
+#endif
+
+void lvgl_flush_write(struct _disp_drv_t *disp_drv, const lv_area_t *area,
+		const struct display_buffer_descriptor *desc, const void *buf)
+{
+	const struct device *display_dev = (const struct device *)disp_drv->user_data;
+
+#ifdef CONFIG_LVGL_ASYNC_FLUSH
+	if (display_write_async(display_dev, area->x1, area->y1, desc, buf,
+				lvgl_flush_done, disp_drv) == 0) {
+		return;
+	}
+#endif
+
+	display_write(display_dev, area->x1, area->y1, desc, buf);
+	lv_disp_flush_ready(disp_drv);
+}
+
 int set_lvgl_rendering_cb(lv_disp_drv_t *disp_drv)
 {
 	int err = 0;
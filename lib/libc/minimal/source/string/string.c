@@ -253,6 +253,137 @@ int memcmp(const void *m1, const void *m2, size_t n)
 	return *c1 - *c2;
 }
 
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+
+#define WORD_SIZE sizeof(mem_word_t)
+#define WORD_MASK (WORD_SIZE - 1)
+
+#if defined(CONFIG_MINIMAL_LIBC_STRING_ARCH) && defined(CONFIG_X86)
+#if defined(CONFIG_64BIT)
+#define REP_MOVS_WORD "rep movsq"
+#else
+#define REP_MOVS_WORD "rep movsl"
+#endif
+#endif
+
+/* Copy words between aligned buffers, n is a multiple of the word size */
+static inline void copy_words(mem_word_t *d_word, const mem_word_t *s_word,
+			      size_t n)
+{
+#if defined(CONFIG_MINIMAL_LIBC_STRING_ARCH) && \
+	defined(CONFIG_ARMV7_M_ARMV8_M_MAINLINE)
+	while (n >= 4 * WORD_SIZE) {
+		__asm__ volatile ("ldmia %1!, {r3, r4, r5, r12}\n\t"
+				  "stmia %0!, {r3, r4, r5, r12}"
+				  : "+r" (d_word), "+r" (s_word)
+				  :
+				  : "r3", "r4", "r5", "r12", "memory");
+		n -= 4 * WORD_SIZE;
+	}
+#else
+	while (n >= 4 * WORD_SIZE) {
+		d_word[0] = s_word[0];
+		d_word[1] = s_word[1];
+		d_word[2] = s_word[2];
+		d_word[3] = s_word[3];
+		d_word += 4;
+		s_word += 4;
+		n -= 4 * WORD_SIZE;
+	}
+#endif
+
+	while (n > 0) {
+		*(d_word++) = *(s_word++);
+		n -= WORD_SIZE;
+	}
+}
+
+/*
+ * Copy words to an aligned buffer from an unaligned one, n is a multiple of
+ * the word size. The source is read as aligned words, each destination word
+ * being made of the end of one and the start of the next. The last source
+ * word may extend past the end of the source, never past its aligned word.
+ */
+static inline void copy_words_shifted(mem_word_t *d_word,
+				      const unsigned char *s_byte, size_t n)
+{
+	unsigned int off = (uintptr_t)s_byte & WORD_MASK;
+	const mem_word_t *s_word = (const mem_word_t *)(s_byte - off);
+	unsigned int shift = off * 8U;
+	mem_word_t prev = *(s_word++);
+	mem_word_t next;
+
+	while (n > 0) {
+		next = *(s_word++);
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		*(d_word++) = (prev << shift) |
+			      (next >> (Z_MEM_WORD_T_WIDTH - shift));
+#else
+		*(d_word++) = (prev >> shift) |
+			      (next << (Z_MEM_WORD_T_WIDTH - shift));
+#endif
+		prev = next;
+		n -= WORD_SIZE;
+	}
+}
+
+#endif /* !CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE */
+
+/* Copy forward, also used by memmove() when the destination is first */
+static void copy_forward(unsigned char *d_byte, const unsigned char *s_byte,
+			 size_t n)
+{
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+#if defined(CONFIG_MINIMAL_LIBC_STRING_ARCH) && defined(CONFIG_X86)
+	size_t words = n / WORD_SIZE;
+
+	n &= WORD_MASK;
+
+	__asm__ volatile (REP_MOVS_WORD "\n\t"
+			  "mov %3, %2\n\t"
+			  "rep movsb"
+			  : "+D" (d_byte), "+S" (s_byte), "+c" (words)
+			  : "r" (n)
+			  : "memory");
+	return;
+#else
+	size_t words;
+
+	if (n >= 2 * WORD_SIZE) {
+		/* do byte-sized copying until the destination is aligned */
+
+		while (((uintptr_t)d_byte) & WORD_MASK) {
+			*(d_byte++) = *(s_byte++);
+			n--;
+		}
+
+		/* do word-sized copying as long as possible */
+
+		words = n & ~WORD_MASK;
+
+		if ((((uintptr_t)s_byte) & WORD_MASK) == 0) {
+			copy_words((mem_word_t *)d_byte,
+				   (const mem_word_t *)s_byte, words);
+		} else {
+			copy_words_shifted((mem_word_t *)d_byte, s_byte,
+					   words);
+		}
+
+		d_byte += words;
+		s_byte += words;
+		n -= words;
+	}
+#endif
+#endif
+
+	/* do byte-sized copying until finished */
+
+	while (n > 0) {
+		*(d_byte++) = *(s_byte++);
+		n--;
+	}
+}
+
 /**
  *
  * @brief Copy bytes in memory with overlapping areas
@@ -271,18 +402,31 @@ void *memmove(void *d, const void *s, size_t n)
 		 * Copy backwards to prevent the premature corruption of <src>.
 		 */
 
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+		if ((((uintptr_t)dest ^ (uintptr_t)src) & WORD_MASK) == 0) {
+			while (((uintptr_t)(dest + n)) & WORD_MASK) {
+				if (n == 0) {
+					return d;
+				}
+				n--;
+				dest[n] = src[n];
+			}
+
+			while (n >= WORD_SIZE) {
+				n -= WORD_SIZE;
+				*(mem_word_t *)(dest + n) =
+					*(const mem_word_t *)(src + n);
+			}
+		}
+#endif
+
 		while (n > 0) {
 			n--;
 			dest[n] = src[n];
 		}
 	} else {
 		/* It is safe to perform a forward-copy */
-		while (n > 0) {
-			*dest = *src;
-			dest++;
-			src++;
-			n--;
-		}
+		copy_forward(d, s, n);
 	}
 
 	return d;
@@ -297,47 +441,7 @@ void *memmove(void *d, const void *s, size_t n)
 
 void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
 {
-	/* attempt word-sized copying only if buffers have identical alignment */
-
-	unsigned char *d_byte = (unsigned char *)d;
-	const unsigned char *s_byte = (const unsigned char *)s;
-
-#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
-	const uintptr_t mask = sizeof(mem_word_t) - 1;
-
-	if ((((uintptr_t)d ^ (uintptr_t)s_byte) & mask) == 0) {
-
-		/* do byte-sized copying until word-aligned or finished */
-
-		while (((uintptr_t)d_byte) & mask) {
-			if (n == 0) {
-				return d;
-			}
-			*(d_byte++) = *(s_byte++);
-			n--;
-		}
-
-		/* do word-sized copying as long as possible */
-
-		mem_word_t *d_word = (mem_word_t *)d_byte;
-		const mem_word_t *s_word = (const mem_word_t *)s_byte;
-
-		while (n >= sizeof(mem_word_t)) {
-			*(d_word++) = *(s_word++);
-			n -= sizeof(mem_word_t);
-		}
-
-		d_byte = (unsigned char *)d_word;
-		s_byte = (unsigned char *)s_word;
-	}
-#endif
-
-	/* do byte-sized copying until finished */
-
-	while (n > 0) {
-		*(d_byte++) = *(s_byte++);
-		n--;
-	}
+	copy_forward(d, s, n);
 
 	return d;
 }
@@ -357,7 +461,13 @@ void *memset(void *buf, int c, size_t n)
 	unsigned char c_byte = (unsigned char)c;
 
 #if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
-	while (((uintptr_t)d_byte) & (sizeof(mem_word_t) - 1)) {
+#if defined(CONFIG_MINIMAL_LIBC_STRING_ARCH) && defined(CONFIG_X86)
+	__asm__ volatile ("rep stosb"
+			  : "+D" (d_byte), "+c" (n)
+			  : "a" (c_byte)
+			  : "memory");
+#else
+	while (((uintptr_t)d_byte) & WORD_MASK) {
 		if (n == 0) {
 			return buf;
 		}
@@ -376,14 +486,24 @@ void *memset(void *buf, int c, size_t n)
 	c_word |= c_word << 32;
 #endif
 
-	while (n >= sizeof(mem_word_t)) {
+	while (n >= 4 * WORD_SIZE) {
+		d_word[0] = c_word;
+		d_word[1] = c_word;
+		d_word[2] = c_word;
+		d_word[3] = c_word;
+		d_word += 4;
+		n -= 4 * WORD_SIZE;
+	}
+
+	while (n >= WORD_SIZE) {
 		*(d_word++) = c_word;
-		n -= sizeof(mem_word_t);
+		n -= WORD_SIZE;
 	}
 
 	/* do byte-sized initialization until finished */
 
 	d_byte = (unsigned char *)d_word;
+#endif
 #endif
 
 	while (n > 0) {
@@ -162,6 +162,42 @@ mismatch:
 	return false;
 }
 
+/*
+ * Find the first set or clear bit, a bundle at a time.
+ *
+ * @param bitarray Bitarray struct
+ * @param bit      Bit location to start from
+ * @param set      True to find a set bit, false a clear one
+ *
+ * @return Location of the bit, or the number of bits of the
+ *         bitarray if there is none
+ */
+static size_t find_next_bit(sys_bitarray_t *bitarray, size_t bit, bool set)
+{
+	size_t idx = bit / bundle_bitness(bitarray);
+	uint32_t bundle;
+
+	if (bit >= bitarray->num_bits) {
+		return bitarray->num_bits;
+	}
+
+	bundle = set ? bitarray->bundles[idx] : ~bitarray->bundles[idx];
+	bundle &= ~(BIT(bit % bundle_bitness(bitarray)) - 1);
+
+	while (bundle == 0U) {
+		if (++idx >= bitarray->num_bundles) {
+			return bitarray->num_bits;
+		}
+
+		/* Full bundles are skipped with a single comparison */
+		bundle = set ? bitarray->bundles[idx] : ~bitarray->bundles[idx];
+	}
+
+	bit = idx * bundle_bitness(bitarray) + find_lsb_set(bundle) - 1;
+
+	return MIN(bit, bitarray->num_bits);
+}
+
 /*
  * Set or clear a region of bits.
  *
@@ -181,6 +217,10 @@ static void set_region(sys_bitarray_t *bitarray, size_t offset,
 	int idx;
 	struct bundle_data bdata;
 
+	if (!to_set) {
+		bitarray->first_free = MIN(bitarray->first_free, offset);
+	}
+
 	if (bd == NULL) {
 		bd = &bdata;
 		setup_bundle_data(bitarray, bd, offset, num_bits);
@@ -261,6 +301,7 @@ int sys_bitarray_clear_bit(sys_bitarray_t *bitarray, size_t bit)
 	off = bit % bundle_bitness(bitarray);
 
 	bitarray->bundles[idx] &= ~BIT(off);
+	bitarray->first_free = MIN(bitarray->first_free, bit);
 
 	ret = 0;
 
@@ -373,6 +414,7 @@ int sys_bitarray_test_and_clear_bit(sys_bitarray_t *bitarray, size_t bit, int *p
 	}
 
 	bitarray->bundles[idx] &= ~BIT(off);
+	bitarray->first_free = MIN(bitarray->first_free, bit);
 
 	ret = 0;
 
@@ -385,11 +427,8 @@ int sys_bitarray_alloc(sys_bitarray_t *bitarray, size_t num_bits,
 		       size_t *offset)
 {
 	k_spinlock_key_t key;
-	uint32_t bit_idx;
 	int ret;
-	struct bundle_data bd;
 	size_t off_start, off_end;
-	size_t mismatch;
 
 	key = k_spin_lock(&bitarray->lock);
 
@@ -405,48 +444,28 @@ int sys_bitarray_alloc(sys_bitarray_t *bitarray, size_t num_bits,
 		goto out;
 	}
 
-	bit_idx = 0;
-
-	/* Find the first non-allocated bit by looking at bundles
-	 * instead of individual bits.
-	 *
-	 * On RISC-V 64-bit, it complains about undefined reference to `ffs`.
-	 * So don't use this on RISCV64.
+	/* Look for a run of clear bits long enough, a word at a time: from
+	 * the start of a run, the next set bit tells its length, and the
+	 * next clear bit from there where the following run starts.
 	 */
-	for (ret = 0; ret < bitarray->num_bundles; ret++) {
-		if (~bitarray->bundles[ret] == 0U) {
-			/* bundle is all 1s => all allocated, skip */
-			bit_idx += bundle_bitness(bitarray);
-			continue;
-		}
-
-		if (bitarray->bundles[ret] != 0U) {
-			/* Find the first free bit in bundle if not all free */
-			off_start = find_lsb_set(~bitarray->bundles[ret]) - 1;
-			bit_idx += off_start;
-		}
-
-		break;
-	}
-
-	off_end = bitarray->num_bits - num_bits;
 	ret = -ENOSPC;
-	while (bit_idx <= off_end) {
-		if (match_region(bitarray, bit_idx, num_bits, false,
-				 &bd, &mismatch)) {
-			off_end = bit_idx + num_bits - 1;
-
-			set_region(bitarray, bit_idx, num_bits, true, &bd);
+	off_start = find_next_bit(bitarray, bitarray->first_free, false);
+	bitarray->first_free = off_start;
+
+	while (off_start + num_bits <= bitarray->num_bits) {
+		off_end = find_next_bit(bitarray, off_start, true);
+		if (off_end - off_start >= num_bits) {
+			set_region(bitarray, off_start, num_bits, true, NULL);
+			if (off_start == bitarray->first_free) {
+				bitarray->first_free = off_start + num_bits;
+			}
 
-			*offset = bit_idx;
+			*offset = off_start;
 			ret = 0;
 			break;
 		}
 
-		/* Fast-forward to the bit just after
-		 * the mismatched bit.
-		 */
-		bit_idx = mismatch + 1;
+		off_start = find_next_bit(bitarray, off_end, false);
 	}
 
 out:
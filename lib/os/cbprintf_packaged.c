@@ -511,6 +511,62 @@ int cbprintf_package(void *packaged, size_t len, const char *format, ...)
 	return ret;
 }
 
+int cbprintf_package_copy(void *out, size_t len, const void *in,
+			  const uint8_t *str_pos, unsigned int str_cnt)
+{
+	const uint8_t *in_buf = in;
+	uint8_t *buf = out;
+	size_t args_size = in_buf[0] * sizeof(int);
+	size_t total = args_size;
+	unsigned int s_nbr = 0;
+	unsigned int i;
+
+	/* Only packages without appended strings are expected. */
+	__ASSERT_NO_MSG(in_buf[1] == 0);
+
+	for (i = 0; i < str_cnt; i++) {
+		const char *s = *(const char **)(in_buf + str_pos[i] * sizeof(int));
+
+		if (s != NULL && !ptr_in_rodata(s)) {
+			/* position prefix, string and its terminating '\0' */
+			total += 1 + strlen(s) + 1;
+		}
+	}
+
+	if (!buf) {
+		return total;
+	}
+
+	if (total > len) {
+		return -ENOSPC;
+	}
+
+	memcpy(buf, in_buf, args_size);
+	buf += args_size;
+
+	for (i = 0; i < str_cnt; i++) {
+		char **ps = (char **)((uint8_t *)out + str_pos[i] * sizeof(int));
+		const char *s = *ps;
+		size_t size;
+
+		if (s == NULL || ptr_in_rodata(s)) {
+			continue;
+		}
+
+		size = strlen(s) + 1;
+		/* clear the in-buffer pointer, as cbvprintf_package() does */
+		*ps = NULL;
+		*buf++ = str_pos[i];
+		memcpy(buf, s, size);
+		buf += size;
+		s_nbr++;
+	}
+
+	((uint8_t *)out)[1] = s_nbr;
+
+	return total;
+}
+
 int cbpprintf(cbprintf_cb out, void *ctx, void *packaged)
 {
 	char *buf = packaged, *fmt, *s, **ps;
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_INCLUDE_LIB_OS_CRC32_PRIV_H_
+#define ZEPHYR_INCLUDE_LIB_OS_CRC32_PRIV_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/byteorder.h>
+
+/* Update a reflected CRC32 register, without the initial and final
+ * inversions of the algorithms.
+ */
+uint32_t z_crc32_ieee_slice_by_8(uint32_t crc, const uint8_t *data, size_t len);
+uint32_t z_crc32c_slice_by_8(uint32_t crc, const uint8_t *data, size_t len);
+
+#ifdef CONFIG_CRC_ARMV8
+
+/* The CRC32 instructions are optional in ARMv8.0: the assembler is told
+ * they exist, the CPU is required to have them by the Kconfig option.
+ */
+#define Z_CRC32_ARMV8(name, insn_x, insn_b)				\
+static inline uint32_t name(uint32_t crc, const uint8_t *data, size_t len) \
+{									\
+	for (; len >= 8; len -= 8, data += 8) {				\
+		__asm__(".arch_extension crc\n\t"			\
+			insn_x " %w0, %w0, %x1"				\
+			: "+r" (crc) : "r" (sys_get_le64(data)));	\
+	}								\
+									\
+	for (; len > 0; len--, data++) {				\
+		__asm__(".arch_extension crc\n\t"			\
+			insn_b " %w0, %w0, %w1"				\
+			: "+r" (crc) : "r" ((uint32_t)*data));		\
+	}								\
+									\
+	return crc;							\
+}
+
+Z_CRC32_ARMV8(z_crc32_ieee_armv8, "crc32x", "crc32b")
+Z_CRC32_ARMV8(z_crc32c_armv8, "crc32cx", "crc32cb")
+
+#endif /* CONFIG_CRC_ARMV8 */
+
+#endif /* ZEPHYR_INCLUDE_LIB_OS_CRC32_PRIV_H_ */
@@ -5,6 +5,7 @@
  */
 
 #include <sys/crc.h>
+#include "crc32_priv.h"
 
 uint32_t crc32_ieee(const uint8_t *data, size_t len)
 {
@@ -13,6 +14,11 @@ uint32_t crc32_ieee(const uint8_t *data, size_t len)
 
 uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
 {
+#if defined(CONFIG_CRC_ARMV8)
+	return ~z_crc32_ieee_armv8(~crc, data, len);
+#elif defined(CONFIG_CRC_SLICE_BY_8)
+	return ~z_crc32_ieee_slice_by_8(~crc, data, len);
+#else
 	/* crc table generated from polynomial 0xedb88320 */
 	static const uint32_t table[16] = {
 		0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac,
@@ -31,4 +37,5 @@ uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
 	}
 
 	return (~crc);
+#endif
 }
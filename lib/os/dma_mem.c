@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cache.h>
+#include <sys/__assert.h>
+#include <sys/dma_mem.h>
+#include <linker/linker-defs.h>
+
+BUILD_ASSERT((DMA_MEM_ALIGN & (DMA_MEM_ALIGN - 1)) == 0,
+	     "DMA_MEM_ALIGN must be a power of two");
+#if defined(CONFIG_DCACHE_LINE_SIZE)
+BUILD_ASSERT(CONFIG_DCACHE_LINE_SIZE == 0 ||
+	     DMA_MEM_ALIGN % CONFIG_DCACHE_LINE_SIZE == 0,
+	     "DMA_MEM_ALIGN must be a multiple of the cache line size");
+#endif
+
+bool dma_mem_is_coherent(const void *addr, size_t len)
+{
+#if defined(CONFIG_NOCACHE_MEMORY)
+	uintptr_t start = POINTER_TO_UINT(addr);
+
+	if (start >= POINTER_TO_UINT(_nocache_ram_start) &&
+	    start + len <= POINTER_TO_UINT(_nocache_ram_end)) {
+		return true;
+	}
+#endif
+
+	return !IS_ENABLED(CONFIG_CACHE_MANAGEMENT);
+}
+
+#if defined(CONFIG_CACHE_MANAGEMENT)
+static int sync_all(const struct dma_mem_range *ranges, size_t count, int op)
+{
+	size_t total = 0;
+
+	/* Invalidating the whole cache would lose unrelated dirty data */
+	if (CONFIG_DMA_MEM_SYNC_ALL_THRESHOLD == 0 || op == K_CACHE_INVD) {
+		return -EAGAIN;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		total += ranges[i].len;
+	}
+
+	if (total < CONFIG_DMA_MEM_SYNC_ALL_THRESHOLD) {
+		return -EAGAIN;
+	}
+
+	return cache_data_all(op);
+}
+#endif
+
+int dma_mem_sync(const struct dma_mem_range *ranges, size_t count, int op)
+{
+#if defined(CONFIG_CACHE_MANAGEMENT)
+	uintptr_t start = 0, end = 0;
+	int ret;
+
+	ret = sync_all(ranges, count, op);
+	if (ret != -EAGAIN) {
+		return ret;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		uintptr_t addr = POINTER_TO_UINT(ranges[i].addr);
+		uintptr_t s = ROUND_DOWN(addr, DMA_MEM_ALIGN);
+		uintptr_t e = ROUND_UP(addr + ranges[i].len, DMA_MEM_ALIGN);
+
+		if (ranges[i].len == 0 ||
+		    dma_mem_is_coherent(ranges[i].addr, ranges[i].len)) {
+			continue;
+		}
+
+		__ASSERT(op != K_CACHE_INVD ||
+			 (s == addr && e == addr + ranges[i].len),
+			 "Invalidating partial cache lines at %p",
+			 ranges[i].addr);
+
+		/* Extend the pending run with the ranges it touches */
+		if (end != 0 && s <= end && e >= start) {
+			start = MIN(start, s);
+			end = MAX(end, e);
+			continue;
+		}
+
+		if (end != 0) {
+			ret = cache_data_range(UINT_TO_POINTER(start),
+					       end - start, op);
+			if (ret != 0) {
+				return ret;
+			}
+		}
+
+		start = s;
+		end = e;
+	}
+
+	if (end != 0) {
+		return cache_data_range(UINT_TO_POINTER(start), end - start,
+					op);
+	}
+#else
+	ARG_UNUSED(ranges);
+	ARG_UNUSED(count);
+	ARG_UNUSED(op);
+#endif
+
+	return 0;
+}
@@ -72,6 +72,21 @@ bool sys_heap_validate(struct sys_heap *heap)
 	struct z_heap *h = heap->heap;
 	chunkid_t c;
 
+	/* Binned chunks are marked used, so the walks below treat them
+	 * as allocated.  Just check the bins hold sane chunks of the
+	 * right size, without cycles.
+	 */
+	for (int i = 0; i < fast_bin_count(h); i++) {
+		uint32_t n = 0;
+
+		for (c = fast_bins(h)[i]; c != 0U; c = next_free_chunk(h, c)) {
+			VALIDATE(valid_chunk(h, c));
+			VALIDATE(chunk_used(h, c));
+			VALIDATE(chunk_size(h, c) == min_chunk_size(h) + i);
+			VALIDATE(++n < h->end_chunk);
+		}
+	}
+
 	/*
 	 * Walk through the chunks linearly, verifying sizes and end pointer.
 	 */
@@ -309,6 +324,23 @@ void sys_heap_stress(void *(*alloc_fn)(void *arg, size_t bytes),
 	}
 }
 
+/* True if c sits in a fast bin (and so is free despite its used bit) */
+static bool in_fast_bin(struct z_heap *h, chunkid_t c)
+{
+	chunksz_t idx = chunk_size(h, c) - min_chunk_size(h);
+
+	if (idx >= (chunksz_t)fast_bin_count(h)) {
+		return false;
+	}
+	for (chunkid_t b = fast_bins(h)[idx]; b != 0U;
+	     b = next_free_chunk(h, b)) {
+		if (b == c) {
+			return true;
+		}
+	}
+	return false;
+}
+
 /*
  * Print heap info for debugging / analysis purpose
  */
@@ -348,7 +380,11 @@ void heap_print_info(struct z_heap *h, bool dump_chunks)
 	}
 	free_bytes = allocated_bytes = 0;
 	for (chunkid_t c = 0; ; c = right_chunk(h, c)) {
-		if (chunk_used(h, c)) {
+		bool binned = chunk_used(h, c) && in_fast_bin(h, c);
+
+		if (binned) {
+			free_bytes += chunksz_to_bytes(h, chunk_size(h, c));
+		} else if (chunk_used(h, c)) {
 			if ((c != 0) && (c != h->end_chunk)) {
 				/* 1st and last are always allocated for internal purposes */
 				allocated_bytes += chunksz_to_bytes(h, chunk_size(h, c));
@@ -361,7 +397,8 @@ void heap_print_info(struct z_heap *h, bool dump_chunks)
 		if (dump_chunks) {
 			printk("chunk %4d: [%c] size=%-4d left=%-4d right=%d\n",
 			       c,
-			       chunk_used(h, c) ? '*'
+			       binned ? 'b'
+			       : chunk_used(h, c) ? '*'
 			       : solo_free_header(h, c) ? '.'
 			       : '-',
 			       chunk_size(h, c),
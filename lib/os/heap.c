@@ -18,6 +18,27 @@ static void *chunk_mem(struct z_heap *h, chunkid_t c)
 	return ret;
 }
 
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+static inline void stats_add(struct sys_heap *heap, chunkid_t c)
+{
+	struct z_heap *h = heap->heap;
+
+	heap->allocated_bytes += chunksz_to_bytes(h, chunk_size(h, c));
+	heap->max_allocated_bytes = MAX(heap->max_allocated_bytes,
+					heap->allocated_bytes);
+}
+
+static inline void stats_sub(struct sys_heap *heap, chunkid_t c)
+{
+	struct z_heap *h = heap->heap;
+
+	heap->allocated_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
+}
+#else
+static inline void stats_add(struct sys_heap *heap, chunkid_t c) { }
+static inline void stats_sub(struct sys_heap *heap, chunkid_t c) { }
+#endif
+
 static void free_list_remove_bidx(struct z_heap *h, chunkid_t c, int bidx)
 {
 	struct z_heap_bucket *b = &h->buckets[bidx];
@@ -127,6 +148,53 @@ static void free_chunk(struct z_heap *h, chunkid_t c)
 	free_list_add(h, c);
 }
 
+/* Fast bin index for a chunk size, or -1 if it doesn't have one */
+static inline int fast_bin_idx(struct z_heap *h, chunksz_t sz)
+{
+	chunksz_t idx = sz - min_chunk_size(h);
+
+	return idx < (chunksz_t)fast_bin_count(h) ? (int)idx : -1;
+}
+
+static void fast_bin_push(struct z_heap *h, chunkid_t c, int fidx)
+{
+	chunkid_t *bins = fast_bins(h);
+
+	set_next_free_chunk(h, c, bins[fidx]);
+	bins[fidx] = c;
+}
+
+static chunkid_t fast_bin_pop(struct z_heap *h, int fidx)
+{
+	chunkid_t *bins = fast_bins(h);
+	chunkid_t c = bins[fidx];
+
+	if (c != 0U) {
+		CHECK(chunk_used(h, c));
+		bins[fidx] = next_free_chunk(h, c);
+		set_chunk_used(h, c, false);
+	}
+	return c;
+}
+
+/* Empties the fast bins into the free lists, merging as usual.
+ * Returns true if anything was released.
+ */
+static bool fast_bins_flush(struct z_heap *h)
+{
+	bool released = false;
+
+	for (int i = 0; i < fast_bin_count(h); i++) {
+		chunkid_t c;
+
+		while ((c = fast_bin_pop(h, i)) != 0U) {
+			free_chunk(h, c);
+			released = true;
+		}
+	}
+	return released;
+}
+
 /*
  * Return the closest chunk ID corresponding to given memory pointer.
  * Here "closest" is only meaningful in the context of sys_heap_aligned_alloc()
@@ -163,11 +231,30 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 		 "corrupted heap bounds (buffer overflow?) for memory at %p",
 		 mem);
 
+	stats_sub(heap, c);
+
+	int fidx = fast_bin_idx(h, chunk_size(h, c));
+
+	if (fidx >= 0) {
+#ifdef CONFIG_ASSERT
+		/* Binned chunks stay marked used, so the check above
+		 * can't see them being freed twice.  Look in the bin.
+		 */
+		for (chunkid_t b = fast_bins(h)[fidx]; b != 0U;
+		     b = next_free_chunk(h, b)) {
+			__ASSERT(b != c, "double-free of memory at %p", mem);
+		}
+#endif
+		/* Stays marked used, no merging until flushed */
+		fast_bin_push(h, c, fidx);
+		return;
+	}
+
 	set_chunk_used(h, c, false);
 	free_chunk(h, c);
 }
 
-static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
+static chunkid_t alloc_chunk_buckets(struct z_heap *h, chunksz_t sz)
 {
 	int bi = bucket_idx(h, sz);
 	struct z_heap_bucket *b = &h->buckets[bi];
@@ -219,6 +306,29 @@ static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 	return 0;
 }
 
+static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
+{
+	int fidx = fast_bin_idx(h, sz);
+	chunkid_t c;
+
+	if (fidx >= 0) {
+		c = fast_bin_pop(h, fidx);
+		if (c != 0U) {
+			return c;
+		}
+	}
+
+	c = alloc_chunk_buckets(h, sz);
+
+	/* Under memory pressure, give the binned chunks back to the
+	 * heap and try again.
+	 */
+	if (c == 0U && fast_bins_flush(h)) {
+		c = alloc_chunk_buckets(h, sz);
+	}
+	return c;
+}
+
 void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 {
 	struct z_heap *h = heap->heap;
@@ -240,6 +350,7 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 	}
 
 	set_chunk_used(h, c, true);
+	stats_add(heap, c);
 	return chunk_mem(h, c);
 }
 
@@ -307,6 +418,7 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 	}
 
 	set_chunk_used(h, c, true);
+	stats_add(heap, c);
 	return mem;
 }
 
@@ -342,8 +454,10 @@ void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 		return ptr;
 	} else if (chunk_size(h, c) > chunks_need) {
 		/* Shrink in place, split off and free unused suffix */
+		stats_sub(heap, c);
 		split_chunks(h, c, c + chunks_need);
 		set_chunk_used(h, c, true);
+		stats_add(heap, c);
 		free_chunk(h, c + chunks_need);
 		return ptr;
 	} else if (!chunk_used(h, rc) &&
@@ -352,6 +466,7 @@ void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 		chunkid_t split_size = chunks_need - chunk_size(h, c);
 
 		free_list_remove(h, rc);
+		stats_sub(heap, c);
 
 		if (split_size < chunk_size(h, rc)) {
 			split_chunks(h, rc, rc + split_size);
@@ -360,6 +475,7 @@ void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 
 		merge_chunks(h, c, rc);
 		set_chunk_used(h, c, true);
+		stats_add(heap, c);
 		return ptr;
 	} else {
 		;
@@ -396,12 +512,18 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 
 	struct z_heap *h = (struct z_heap *)addr;
 	heap->heap = h;
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	heap->allocated_bytes = 0;
+	heap->max_allocated_bytes = 0;
+#endif
 	h->end_chunk = heap_sz;
 	h->avail_buckets = 0;
 
 	int nb_buckets = bucket_idx(h, heap_sz) + 1;
+	int nb_fast_bins = fast_bin_count(h);
 	chunksz_t chunk0_size = chunksz(sizeof(struct z_heap) +
-				     nb_buckets * sizeof(struct z_heap_bucket));
+				     nb_buckets * sizeof(struct z_heap_bucket) +
+				     nb_fast_bins * sizeof(chunkid_t));
 
 	__ASSERT(chunk0_size + min_chunk_size(h) <= heap_sz, "heap size is too small");
 
@@ -409,6 +531,10 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 		h->buckets[i].next = 0;
 	}
 
+	for (int i = 0; i < nb_fast_bins; i++) {
+		fast_bins(h)[i] = 0;
+	}
+
 	/* chunk containing our struct z_heap */
 	set_chunk_size(h, 0, chunk0_size);
 	set_left_chunk_size(h, 0, 0);
@@ -425,3 +551,83 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 
 	free_list_add(h, chunk0_size);
 }
+
+int sys_heap_bucket_stats_get(struct sys_heap *heap, uint32_t *counts,
+			      int max_buckets)
+{
+	if (heap == NULL || (counts == NULL && max_buckets > 0)) {
+		return -EINVAL;
+	}
+
+	struct z_heap *h = heap->heap;
+	int nb_buckets = bucket_idx(h, h->end_chunk) + 1;
+
+	for (int i = 0; i < MIN(nb_buckets, max_buckets); i++) {
+		chunkid_t first = h->buckets[i].next, c = first;
+		uint32_t n = 0;
+
+		if (first != 0U) {
+			do {
+				n++;
+				c = next_free_chunk(h, c);
+			} while (c != first);
+		}
+		counts[i] = n;
+	}
+
+	return nb_buckets;
+}
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+int sys_heap_runtime_stats_get(struct sys_heap *heap,
+			       struct sys_heap_runtime_stats *stats)
+{
+	if (heap == NULL || stats == NULL) {
+		return -EINVAL;
+	}
+
+	struct z_heap *h = heap->heap;
+	int nb_buckets = bucket_idx(h, h->end_chunk) + 1;
+	chunksz_t largest = 0;
+	size_t free_bytes = 0;
+
+	for (int i = 0; i < nb_buckets; i++) {
+		chunkid_t first = h->buckets[i].next, c = first;
+
+		if (first != 0U) {
+			do {
+				free_bytes += chunksz_to_bytes(h, chunk_size(h, c));
+				largest = MAX(largest, chunk_size(h, c));
+				c = next_free_chunk(h, c);
+			} while (c != first);
+		}
+	}
+
+	/* Binned chunks are free as far as the user is concerned */
+	for (int i = 0; i < fast_bin_count(h); i++) {
+		for (chunkid_t c = fast_bins(h)[i]; c != 0U;
+		     c = next_free_chunk(h, c)) {
+			free_bytes += chunksz_to_bytes(h, chunk_size(h, c));
+			largest = MAX(largest, chunk_size(h, c));
+		}
+	}
+
+	stats->free_bytes = free_bytes;
+	stats->allocated_bytes = heap->allocated_bytes;
+	stats->max_allocated_bytes = heap->max_allocated_bytes;
+	stats->largest_free_bytes = largest ? chunksz_to_bytes(h, largest) : 0;
+
+	return 0;
+}
+
+int sys_heap_runtime_stats_reset_max(struct sys_heap *heap)
+{
+	if (heap == NULL) {
+		return -EINVAL;
+	}
+
+	heap->max_allocated_bytes = heap->allocated_bytes;
+
+	return 0;
+}
+#endif /* CONFIG_SYS_HEAP_RUNTIME_STATS */
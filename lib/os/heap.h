@@ -45,6 +45,13 @@
  * obviously.  This memory is part of the user's buffer when
  * allocated.
  *
+ * With CONFIG_SYS_HEAP_FAST_BINS, freed chunks of the smallest sizes
+ * are instead pushed onto exact-size "fast bin" stacks, singly linked
+ * through FREE_NEXT.  They keep their USED bit so that neighbors never
+ * merge with them, and are only returned to the free lists proper
+ * when the bins get flushed.  The bin heads follow the bucket array
+ * in chunk0.
+ *
  * The field order is so that allocated buffers are immediately bounded
  * by SIZE_AND_USED of the current chunk at the bottom, and LEFT_SIZE of
  * the following chunk at the top. This ordering allows for quick buffer
@@ -242,6 +249,22 @@ static inline int bucket_idx(struct z_heap *h, chunksz_t sz)
 	return 31 - __builtin_clz(usable_sz);
 }
 
+static inline int fast_bin_count(struct z_heap *h)
+{
+#ifdef CONFIG_SYS_HEAP_FAST_BINS
+	/* Tiny heaps can't spare chunk0 space for the bin heads */
+	if (h->end_chunk >= 8U * CONFIG_SYS_HEAP_FAST_BIN_COUNT) {
+		return CONFIG_SYS_HEAP_FAST_BIN_COUNT;
+	}
+#endif
+	return 0;
+}
+
+static inline chunkid_t *fast_bins(struct z_heap *h)
+{
+	return &h->buckets[bucket_idx(h, h->end_chunk) + 1].next;
+}
+
 static inline bool size_too_big(struct z_heap *h, size_t bytes)
 {
 	/*
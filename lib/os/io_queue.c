@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sys/io_queue.h>
+#include <drivers/spi.h>
+#include <drivers/i2c.h>
+#include <string.h>
+
+/* The ring indices are free running, they are masked on access only. */
+#define RING_IDX(queue, idx) ((idx) & ((queue)->size - 1U))
+
+struct io_sqe *io_queue_sqe_acquire(struct io_queue *queue)
+{
+	struct io_sqe *sqe;
+
+	/* An entry is reusable once its completion was reaped. */
+	if (queue->sq_acquired - (uint32_t)atomic_get(&queue->cq_head) >=
+	    queue->size) {
+		return NULL;
+	}
+
+	sqe = &queue->sq[RING_IDX(queue, queue->sq_acquired)];
+	memset(sqe, 0, sizeof(*sqe));
+	queue->sq_acquired++;
+
+	return sqe;
+}
+
+static void queue_schedule(struct io_queue *queue)
+{
+	/* A queue is in the pending FIFO of its executor at most once. */
+	if (atomic_cas(&queue->scheduled, 0, 1)) {
+		k_fifo_put(&queue->executor->pending, queue);
+	}
+}
+
+uint32_t io_queue_submit(struct io_queue *queue)
+{
+	uint32_t cnt = queue->sq_acquired - (uint32_t)atomic_get(&queue->sq_tail);
+
+	if (cnt != 0) {
+		atomic_set(&queue->sq_tail, queue->sq_acquired);
+		queue_schedule(queue);
+	}
+
+	return cnt;
+}
+
+uint32_t io_queue_reap(struct io_queue *queue, struct io_cqe *cqes,
+		       uint32_t max)
+{
+	uint32_t head = atomic_get(&queue->cq_head);
+	uint32_t cnt = MIN((uint32_t)atomic_get(&queue->cq_tail) - head, max);
+
+	for (uint32_t i = 0; i < cnt; i++) {
+		cqes[i] = queue->cq[RING_IDX(queue, head + i)];
+	}
+
+	atomic_set(&queue->cq_head, head + cnt);
+
+	return cnt;
+}
+
+static bool completions_ready(struct io_queue *queue, uint32_t count)
+{
+	return (uint32_t)atomic_get(&queue->cq_tail) -
+	       (uint32_t)atomic_get(&queue->cq_head) >= count;
+}
+
+int io_queue_wait(struct io_queue *queue, uint32_t count,
+		  k_timeout_t timeout)
+{
+	int64_t end = sys_clock_timeout_end_calc(timeout);
+	struct k_poll_event event = K_POLL_EVENT_INITIALIZER(
+		K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &queue->signal);
+	int64_t remaining;
+
+	for (;;) {
+		/* Reset before checking, not to miss a completion posted
+		 * in between.
+		 */
+		k_poll_signal_reset(&queue->signal);
+		if (completions_ready(queue, count)) {
+			return 0;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			(void)k_poll(&event, 1, K_FOREVER);
+		} else {
+			remaining = end - sys_clock_tick_get();
+			if (remaining <= 0) {
+				return -EAGAIN;
+			}
+
+			(void)k_poll(&event, 1, K_TICKS(remaining));
+		}
+
+		event.state = K_POLL_STATE_NOT_READY;
+	}
+}
+
+static int sqe_perform(const struct io_sqe *sqe)
+{
+	switch (sqe->op) {
+	case IO_OP_NOP:
+		return 0;
+#ifdef CONFIG_SPI
+	case IO_OP_SPI_TRANSCEIVE:
+		return spi_transceive(sqe->dev, sqe->spi.config,
+				      sqe->spi.tx_bufs, sqe->spi.rx_bufs);
+#endif
+#ifdef CONFIG_I2C
+	case IO_OP_I2C_TRANSFER:
+		return i2c_transfer(sqe->dev, sqe->i2c.msgs,
+				    sqe->i2c.num_msgs, sqe->i2c.addr);
+#endif
+	case IO_OP_CALLBACK:
+		return sqe->callback.func(sqe);
+	default:
+		return -ENOTSUP;
+	}
+}
+
+static void cqe_post(struct io_queue *queue, const struct io_sqe *sqe,
+		     int result)
+{
+	struct io_cqe *cqe = &queue->cq[RING_IDX(queue, queue->sq_head)];
+
+	cqe->result = result;
+	cqe->user_data = sqe->user_data;
+
+	/* The entry may be reacquired as soon as its completion is. */
+	queue->sq_head++;
+	atomic_inc(&queue->cq_tail);
+
+	if (queue->callback != NULL) {
+		queue->callback(queue, cqe);
+	}
+
+	k_poll_signal_raise(&queue->signal, result);
+}
+
+/* Performs the entries of the current chain of a queue, then puts the queue
+ * back at the end of the pending FIFO if more entries were submitted, so that
+ * the queues bound to an executor get their turns chain by chain.
+ */
+static void queue_process(struct io_queue *queue)
+{
+	const struct io_sqe *sqe;
+	bool chained;
+	int result;
+
+	/* Cleared first: entries submitted from now on reschedule it. */
+	atomic_clear(&queue->scheduled);
+
+	while (queue->sq_head != (uint32_t)atomic_get(&queue->sq_tail)) {
+		sqe = &queue->sq[RING_IDX(queue, queue->sq_head)];
+		chained = (sqe->flags & IO_SQE_CHAINED) != 0;
+
+		if (queue->chain_failed) {
+			result = -ECANCELED;
+		} else {
+			result = sqe_perform(sqe);
+		}
+
+		queue->chain_failed = chained && (result < 0);
+
+		cqe_post(queue, sqe, result);
+
+		if (!chained) {
+			break;
+		}
+	}
+
+	if (queue->sq_head != (uint32_t)atomic_get(&queue->sq_tail)) {
+		queue_schedule(queue);
+	}
+}
+
+void z_io_executor_thread(void *executor, void *p2, void *p3)
+{
+	struct io_executor *exec = executor;
+	struct io_queue *queue;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		queue = k_fifo_get(&exec->pending, K_FOREVER);
+		queue_process(queue);
+	}
+}
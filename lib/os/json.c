@@ -626,20 +626,34 @@ static int json_escape_internal(const char *str,
 				void *data)
 {
 	const char *cur;
+	const char *run;
 	int ret = 0;
 
-	for (cur = str; ret == 0 && *cur; cur++) {
+	for (cur = str, run = str; ret == 0 && *cur; cur++) {
 		char escaped = escape_as(*cur);
 
 		if (escaped) {
 			char bytes[2] = { '\\', escaped };
 
+			/* Characters which need no escaping are appended
+			 * together.
+			 */
+			if (cur > run) {
+				ret = append_bytes(run, cur - run, data);
+				if (ret < 0) {
+					return ret;
+				}
+			}
+
 			ret = append_bytes(bytes, 2, data);
-		} else {
-			ret = append_bytes(cur, 1, data);
+			run = cur + 1;
 		}
 	}
 
+	if (ret == 0 && cur > run) {
+		ret = append_bytes(run, cur - run, data);
+	}
+
 	return ret;
 }
 
@@ -936,3 +950,389 @@ ssize_t json_calc_encoded_len(const struct json_obj_descr *descr,
 
 	return total;
 }
+
+void json_buffered_writer_init(struct json_buffered_writer *writer,
+			       char *buf, size_t size,
+			       json_append_bytes_t flush, void *flush_data)
+{
+	writer->buf = buf;
+	writer->size = size;
+	writer->used = 0;
+	writer->flush = flush;
+	writer->flush_data = flush_data;
+}
+
+int json_buffered_flush(struct json_buffered_writer *writer)
+{
+	int ret;
+
+	if (writer->used == 0) {
+		return 0;
+	}
+
+	ret = writer->flush(writer->buf, writer->used, writer->flush_data);
+	writer->used = 0;
+
+	return ret;
+}
+
+int json_buffered_append(const char *bytes, size_t len, void *data)
+{
+	struct json_buffered_writer *writer = data;
+	size_t copy;
+	int ret;
+
+	while (len > 0) {
+		if (writer->used == writer->size) {
+			ret = json_buffered_flush(writer);
+			if (ret < 0) {
+				return ret;
+			}
+		}
+
+		/* Data larger than the buffer skips it */
+		if (writer->used == 0 && len >= writer->size) {
+			return writer->flush(bytes, len, writer->flush_data);
+		}
+
+		copy = MIN(len, writer->size - writer->used);
+		memcpy(writer->buf + writer->used, bytes, copy);
+		writer->used += copy;
+		bytes += copy;
+		len -= copy;
+	}
+
+	return 0;
+}
+
+enum json_stream_expect {
+	EXPECT_VALUE,
+	EXPECT_VALUE_OR_END,
+	EXPECT_KEY,
+	EXPECT_KEY_OR_END,
+	EXPECT_COLON,
+	EXPECT_COMMA_OR_END,
+	EXPECT_DONE,
+};
+
+/* Token of a key being parsed, JSON_TOK_STRING being used for values */
+#define STREAM_TOK_KEY JSON_TOK_COLON
+
+static const char *stream_literal(uint8_t token)
+{
+	switch (token) {
+	case JSON_TOK_TRUE:
+		return "true";
+	case JSON_TOK_FALSE:
+		return "false";
+	default:
+		return "null";
+	}
+}
+
+void json_stream_init(struct json_stream_parser *parser,
+		      const struct json_stream_callbacks *cb,
+		      char *buf, size_t buf_size, void *user_data)
+{
+	(void)memset(parser, 0, sizeof(*parser));
+
+	parser->cb = cb;
+	parser->buf = buf;
+	parser->buf_size = buf_size;
+	parser->user_data = user_data;
+	parser->expect = EXPECT_VALUE;
+	parser->token = JSON_TOK_NONE;
+}
+
+static int stream_append(struct json_stream_parser *parser, char chr)
+{
+	if (parser->len + 1 >= parser->buf_size) {
+		return -ENOMEM;
+	}
+
+	parser->buf[parser->len++] = chr;
+
+	return 0;
+}
+
+static bool stream_in_object(struct json_stream_parser *parser)
+{
+	return parser->depth > 0 &&
+	       (parser->objects & BIT(parser->depth - 1));
+}
+
+static void stream_value_done(struct json_stream_parser *parser)
+{
+	parser->expect = parser->depth ? EXPECT_COMMA_OR_END : EXPECT_DONE;
+}
+
+static int stream_token_done(struct json_stream_parser *parser)
+{
+	enum json_tokens token = parser->token;
+	int ret = 0;
+
+	if (token == JSON_TOK_NUMBER &&
+	    !isdigit((unsigned char)parser->buf[parser->len - 1])) {
+		return -EINVAL;
+	}
+
+	parser->buf[parser->len] = '\0';
+	parser->token = JSON_TOK_NONE;
+
+	if (token == STREAM_TOK_KEY) {
+		parser->expect = EXPECT_COLON;
+
+		if (parser->cb->on_key) {
+			ret = parser->cb->on_key(parser, parser->buf,
+						 parser->len);
+		}
+	} else {
+		stream_value_done(parser);
+
+		if (parser->cb->on_value) {
+			ret = parser->cb->on_value(parser, token, parser->buf,
+						   parser->len);
+		}
+	}
+
+	parser->len = 0;
+
+	return ret;
+}
+
+static int stream_container(struct json_stream_parser *parser, char chr)
+{
+	bool object = chr == JSON_TOK_OBJECT_START ||
+		      chr == JSON_TOK_OBJECT_END;
+
+	if (chr == JSON_TOK_OBJECT_START || chr == JSON_TOK_LIST_START) {
+		if (parser->expect != EXPECT_VALUE &&
+		    parser->expect != EXPECT_VALUE_OR_END) {
+			return -EINVAL;
+		}
+
+		if (parser->depth == JSON_STREAM_MAX_DEPTH) {
+			return -E2BIG;
+		}
+
+		WRITE_BIT(parser->objects, parser->depth, object);
+		parser->depth++;
+		parser->expect = object ? EXPECT_KEY_OR_END :
+					  EXPECT_VALUE_OR_END;
+
+		return parser->cb->on_start ?
+		       parser->cb->on_start(parser, (enum json_tokens)chr) : 0;
+	}
+
+	if (parser->depth == 0 || stream_in_object(parser) != object ||
+	    (parser->expect != EXPECT_COMMA_OR_END &&
+	     parser->expect != (object ? EXPECT_KEY_OR_END :
+					 EXPECT_VALUE_OR_END))) {
+		return -EINVAL;
+	}
+
+	parser->depth--;
+	stream_value_done(parser);
+
+	return parser->cb->on_end ?
+	       parser->cb->on_end(parser, (enum json_tokens)chr) : 0;
+}
+
+static int stream_string(struct json_stream_parser *parser, char chr)
+{
+	if (parser->token_pos > 0) {
+		/* In an escape sequence, a 'u' is followed by 4 digits */
+		if (parser->token_pos == 1) {
+			switch (chr) {
+			case '"':
+			case '\\':
+			case '/':
+			case 'b':
+			case 'f':
+			case 'n':
+			case 'r':
+			case 't':
+				parser->token_pos = 0;
+				break;
+			case 'u':
+				parser->token_pos = 5;
+				break;
+			default:
+				return -EINVAL;
+			}
+		} else if (!isxdigit((unsigned char)chr)) {
+			return -EINVAL;
+		} else if (--parser->token_pos == 1) {
+			parser->token_pos = 0;
+		}
+
+		return stream_append(parser, chr);
+	}
+
+	if (chr == '"') {
+		return stream_token_done(parser);
+	}
+
+	if (chr == '\\') {
+		parser->token_pos = 1;
+	}
+
+	return stream_append(parser, chr);
+}
+
+static int stream_start_value(struct json_stream_parser *parser,
+			      uint8_t token)
+{
+	if (parser->expect != EXPECT_VALUE &&
+	    parser->expect != EXPECT_VALUE_OR_END) {
+		return -EINVAL;
+	}
+
+	parser->token = token;
+	parser->token_pos = 0;
+
+	return 0;
+}
+
+static int stream_char(struct json_stream_parser *parser, char chr)
+{
+	switch (parser->token) {
+	case JSON_TOK_STRING:
+	case STREAM_TOK_KEY:
+		return stream_string(parser, chr);
+	case JSON_TOK_TRUE:
+	case JSON_TOK_FALSE:
+	case JSON_TOK_NULL: {
+		const char *literal = stream_literal(parser->token);
+
+		int ret;
+
+		if (chr != literal[++parser->token_pos]) {
+			return -EINVAL;
+		}
+
+		ret = stream_append(parser, chr);
+		if (ret < 0 || literal[parser->token_pos + 1] != '\0') {
+			return ret;
+		}
+
+		return stream_token_done(parser);
+	}
+	case JSON_TOK_NUMBER: {
+		int ret;
+
+		if (isdigit((unsigned char)chr) || chr == '.' ||
+		    chr == 'e' || chr == 'E' || chr == '+' || chr == '-') {
+			return stream_append(parser, chr);
+		}
+
+		/* The number ends with the character after it */
+		ret = stream_token_done(parser);
+		if (ret < 0) {
+			return ret;
+		}
+
+		break;
+	}
+	default:
+		break;
+	}
+
+	switch (chr) {
+	case '{':
+	case '}':
+	case '[':
+	case ']':
+		return stream_container(parser, chr);
+	case ',':
+		if (parser->expect != EXPECT_COMMA_OR_END) {
+			return -EINVAL;
+		}
+
+		parser->expect = stream_in_object(parser) ?
+				 EXPECT_KEY : EXPECT_VALUE;
+		return 0;
+	case ':':
+		if (parser->expect != EXPECT_COLON) {
+			return -EINVAL;
+		}
+
+		parser->expect = EXPECT_VALUE;
+		return 0;
+	case '"':
+		if (parser->expect == EXPECT_KEY ||
+		    parser->expect == EXPECT_KEY_OR_END) {
+			parser->token = STREAM_TOK_KEY;
+			parser->token_pos = 0;
+			return 0;
+		}
+
+		return stream_start_value(parser, JSON_TOK_STRING);
+	case 't':
+	case 'f':
+	case 'n':
+		if (stream_start_value(parser, chr) < 0) {
+			return -EINVAL;
+		}
+
+		return stream_append(parser, chr);
+	default:
+		if (isspace((unsigned char)chr)) {
+			return 0;
+		}
+
+		if (isdigit((unsigned char)chr) || chr == '-') {
+			if (stream_start_value(parser, JSON_TOK_NUMBER) < 0) {
+				return -EINVAL;
+			}
+
+			return stream_append(parser, chr);
+		}
+
+		return -EINVAL;
+	}
+}
+
+int json_stream_feed(struct json_stream_parser *parser, const char *data,
+		     size_t len)
+{
+	int ret;
+
+	if (parser->error) {
+		return parser->error;
+	}
+
+	for (size_t i = 0; i < len; i++) {
+		ret = stream_char(parser, data[i]);
+		if (ret < 0) {
+			parser->error = ret;
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+int json_stream_finish(struct json_stream_parser *parser)
+{
+	int ret;
+
+	if (parser->error) {
+		return parser->error;
+	}
+
+	/* A number at the top level has no character ending it */
+	if (parser->token == JSON_TOK_NUMBER) {
+		ret = stream_token_done(parser);
+		if (ret < 0) {
+			parser->error = ret;
+			return ret;
+		}
+	}
+
+	if (parser->expect != EXPECT_DONE) {
+		parser->error = -EINVAL;
+	}
+
+	return parser->error;
+}
@@ -154,14 +154,31 @@ static union mpsc_pbuf_generic *drop_item_locked(struct mpsc_pbuf_buffer *buffer
 	} else if (allow_drop) {
 		if (item->hdr.busy) {
 			/* item is currently processed and cannot be overwritten. */
+			uint32_t next_rd_idx = idx_inc(buffer, buffer->rd_idx, rd_wlen);
+
+			/* Packets claimed along with it, as part of a batch, are
+			 * kept as well. Get next item followed the claimed ones.
+			 */
+			item = (union mpsc_pbuf_generic *)&buffer->buf[next_rd_idx];
+			while (next_rd_idx != buffer->tmp_rd_idx &&
+			       next_rd_idx != buffer->wr_idx && item->hdr.busy) {
+				skip_wlen = get_skip(item);
+				skip_wlen = skip_wlen ? skip_wlen : buffer->get_wlen(item);
+				rd_wlen += skip_wlen;
+				next_rd_idx = idx_inc(buffer, next_rd_idx, skip_wlen);
+				item = (union mpsc_pbuf_generic *)
+					&buffer->buf[next_rd_idx];
+			}
+
+			if (next_rd_idx == buffer->wr_idx) {
+				/* All committed packets are claimed. */
+				return NULL;
+			}
+
 			add_skip_item(buffer, free_wlen + 1);
 			buffer->wr_idx = idx_inc(buffer, buffer->wr_idx, rd_wlen);
 			buffer->tmp_wr_idx = idx_inc(buffer, buffer->tmp_wr_idx, rd_wlen);
 
-			/* Get next itme followed the busy one. */
-			uint32_t next_rd_idx = idx_inc(buffer, buffer->rd_idx, rd_wlen);
-
-			item = (union mpsc_pbuf_generic *)&buffer->buf[next_rd_idx];
 			skip_wlen = get_skip(item);
 			if (skip_wlen) {
 				rd_wlen += skip_wlen;
@@ -395,73 +412,142 @@ void mpsc_pbuf_put_data(struct mpsc_pbuf_buffer *buffer, uint32_t *data,
 	} while (cont);
 }
 
-union mpsc_pbuf_generic *mpsc_pbuf_claim(struct mpsc_pbuf_buffer *buffer)
+/* Returns the next committed packet, marked as claimed, or null. Skip
+ * packets met on the way are consumed.
+ */
+static union mpsc_pbuf_generic *claim_locked(struct mpsc_pbuf_buffer *buffer)
 {
 	union mpsc_pbuf_generic *item;
-	bool cont;
-
-	do {
-		uint32_t a;
-		k_spinlock_key_t key;
-		bool wrap;
+	uint32_t a;
 
-		cont = false;
-		key = k_spin_lock(&buffer->lock);
-		wrap = available(buffer, &a);
+	while (true) {
+		(void)available(buffer, &a);
 		item = (union mpsc_pbuf_generic *)
 			&buffer->buf[buffer->tmp_rd_idx];
 
 		if (!a || is_invalid(item)) {
-			item = NULL;
-		} else {
-			uint32_t skip = get_skip(item);
+			return NULL;
+		}
 
-			if (skip || !is_valid(item)) {
-				uint32_t inc =
-					skip ? skip : buffer->get_wlen(item);
+		uint32_t skip = get_skip(item);
 
-				buffer->tmp_rd_idx =
-				      idx_inc(buffer, buffer->tmp_rd_idx, inc);
-				buffer->rd_idx =
-					idx_inc(buffer, buffer->rd_idx, inc);
-				cont = true;
-			} else {
-				item->hdr.busy = 1;
-				buffer->tmp_rd_idx =
-					idx_inc(buffer, buffer->tmp_rd_idx,
-						buffer->get_wlen(item));
-			}
+		if (!skip && is_valid(item)) {
+			item->hdr.busy = 1;
+			buffer->tmp_rd_idx = idx_inc(buffer, buffer->tmp_rd_idx,
+						     buffer->get_wlen(item));
+			return item;
 		}
 
-		if (!cont) {
-			MPSC_PBUF_DBG(buffer, "claimed: %p ", item);
+		uint32_t inc = skip ? skip : buffer->get_wlen(item);
+
+		/* Packets claimed before may still be in use: the skip packet
+		 * is then released along with them.
+		 */
+		if (buffer->tmp_rd_idx == buffer->rd_idx) {
+			buffer->rd_idx = idx_inc(buffer, buffer->rd_idx, inc);
 		}
-		k_spin_unlock(&buffer->lock, key);
-	} while (cont);
+		buffer->tmp_rd_idx = idx_inc(buffer, buffer->tmp_rd_idx, inc);
+	}
+}
+
+/* Packets may be freed in any order, by several consumers. A packet is
+ * released only once the packets preceding it are, until then it is turned
+ * into a skip packet.
+ */
+static void free_locked(struct mpsc_pbuf_buffer *buffer,
+			union mpsc_pbuf_generic *item)
+{
+	uint32_t wlen = buffer->get_wlen(item);
+
+	item->hdr.valid = 0;
+	if ((uint32_t *)item != &buffer->buf[buffer->rd_idx]) {
+		item->skip.len = wlen;
+		return;
+	}
+
+	item->hdr.busy = 0;
+	if (buffer->tmp_rd_idx == buffer->rd_idx) {
+		/* Packet was overwritten around while claimed. */
+		buffer->tmp_rd_idx = idx_inc(buffer, buffer->tmp_rd_idx, wlen);
+	}
+	buffer->rd_idx = idx_inc(buffer, buffer->rd_idx, wlen);
+
+	/* Release the packets freed before the ones preceding them. */
+	while (buffer->rd_idx != buffer->tmp_rd_idx) {
+		uint32_t skip = get_skip(
+			(union mpsc_pbuf_generic *)&buffer->buf[buffer->rd_idx]);
+
+		if (!skip) {
+			break;
+		}
+
+		buffer->rd_idx = idx_inc(buffer, buffer->rd_idx, skip);
+	}
+}
+
+union mpsc_pbuf_generic *mpsc_pbuf_claim(struct mpsc_pbuf_buffer *buffer)
+{
+	union mpsc_pbuf_generic *item;
+	k_spinlock_key_t key = k_spin_lock(&buffer->lock);
+
+	item = claim_locked(buffer);
+	MPSC_PBUF_DBG(buffer, "claimed: %p ", item);
+	k_spin_unlock(&buffer->lock, key);
 
 	return item;
 }
 
+uint32_t mpsc_pbuf_claim_batch(struct mpsc_pbuf_buffer *buffer,
+			       union mpsc_pbuf_generic **packets, uint32_t max)
+{
+	uint32_t n = 0;
+	k_spinlock_key_t key = k_spin_lock(&buffer->lock);
+
+	while (n < max) {
+		packets[n] = claim_locked(buffer);
+		if (packets[n] == NULL) {
+			break;
+		}
+		n++;
+	}
+
+	MPSC_PBUF_DBG(buffer, "claimed %d ", (int)n);
+	k_spin_unlock(&buffer->lock, key);
+
+	return n;
+}
+
 void mpsc_pbuf_free(struct mpsc_pbuf_buffer *buffer,
 		     union mpsc_pbuf_generic *item)
 {
-	uint32_t wlen = buffer->get_wlen(item);
 	k_spinlock_key_t key = k_spin_lock(&buffer->lock);
 
-	item->hdr.valid = 0;
-	if (!(buffer->flags & MPSC_PBUF_MODE_OVERWRITE) ||
-		 ((uint32_t *)item == &buffer->buf[buffer->rd_idx])) {
-		item->hdr.busy = 0;
-		buffer->rd_idx = idx_inc(buffer, buffer->rd_idx, wlen);
-	} else {
-		item->skip.len = wlen;
-	}
+	free_locked(buffer, item);
 	MPSC_PBUF_DBG(buffer, "freed: %p ", item);
 
 	k_spin_unlock(&buffer->lock, key);
 	k_sem_give(&buffer->sem);
 }
 
+void mpsc_pbuf_free_batch(struct mpsc_pbuf_buffer *buffer,
+			  union mpsc_pbuf_generic **packets, uint32_t n)
+{
+	k_spinlock_key_t key;
+
+	if (n == 0) {
+		return;
+	}
+
+	key = k_spin_lock(&buffer->lock);
+	for (uint32_t i = 0; i < n; i++) {
+		free_locked(buffer, packets[i]);
+	}
+	MPSC_PBUF_DBG(buffer, "freed %d ", (int)n);
+
+	k_spin_unlock(&buffer->lock, key);
+	k_sem_give(&buffer->sem);
+}
+
 bool mpsc_pbuf_is_pending(struct mpsc_pbuf_buffer *buffer)
 {
 	uint32_t a;
@@ -8,6 +8,11 @@
 #include <sys/mutex.h>
 #include <syscall_handler.h>
 #include <kernel_structs.h>
+#include <kernel_internal.h>
+
+#ifdef CONFIG_SYS_MUTEX_FAST
+__thread k_tid_t z_sys_mutex_self;
+#endif
 
 static struct k_mutex *get_k_mutex(struct sys_mutex *mutex)
 {
@@ -23,9 +28,9 @@ static struct k_mutex *get_k_mutex(struct sys_mutex *mutex)
 
 static bool check_sys_mutex_addr(struct sys_mutex *addr)
 {
-	/* sys_mutex memory is never touched, just used to lookup the
-	 * underlying k_mutex, but we don't want threads using mutexes
-	 * that are outside their memory domain
+	/* sys_mutex memory is only used to lookup the underlying k_mutex
+	 * (and to sync the lock word with it for fast mutexes), but we don't
+	 * want threads using mutexes that are outside their memory domain
 	 */
 	return Z_SYSCALL_MEMORY_WRITE(addr, sizeof(struct sys_mutex));
 }
@@ -38,7 +43,11 @@ int z_impl_z_sys_mutex_kernel_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_SYS_MUTEX_FAST
+	return z_mutex_word_lock(kernel_mutex, &mutex->val, timeout);
+#else
 	return k_mutex_lock(kernel_mutex, timeout);
+#endif
 }
 
 static inline int z_vrfy_z_sys_mutex_kernel_lock(struct sys_mutex *mutex,
@@ -60,7 +69,11 @@ int z_impl_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_SYS_MUTEX_FAST
+	return z_mutex_word_unlock(kernel_mutex, &mutex->val);
+#else
 	return k_mutex_unlock(kernel_mutex);
+#endif
 }
 
 static inline int z_vrfy_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
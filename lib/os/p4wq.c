@@ -70,43 +70,148 @@ static inline bool item_lessthan(struct k_p4wq_work *a, struct k_p4wq_work *b)
 	return false;
 }
 
+/* Sub-queue for the current CPU.  Just a locality hint, the caller
+ * may migrate at any time.
+ */
+static inline struct z_p4wq_subq *local_subq(struct k_p4wq *queue)
+{
+#if defined(CONFIG_P4WQ_PER_CPU) && defined(CONFIG_SMP)
+	return &queue->subq[arch_curr_cpu()->id];
+#else
+	return &queue->subq[0];
+#endif
+}
+
+static inline struct k_p4wq_work *subq_max(struct z_p4wq_subq *sq)
+{
+	struct rbnode *r = rb_get_max(&sq->queue);
+
+	return r ? CONTAINER_OF(r, struct k_p4wq_work, rbnode) : NULL;
+}
+
+/* Move the highest priority item of a sub-queue to its active list,
+ * running at the item's priority.
+ */
+static struct k_p4wq_work *subq_take(struct z_p4wq_subq *sq)
+{
+	k_spinlock_key_t k = k_spin_lock(&sq->lock);
+	struct k_p4wq_work *w = subq_max(sq);
+
+	if (w) {
+		rb_remove(&sq->queue, &w->rbnode);
+		w->thread = _current;
+		w->subq = sq;
+		sys_dlist_append(&sq->active, &w->dlnode);
+		set_prio(_current, w);
+		thread_clear_requeued(_current);
+	}
+
+	k_spin_unlock(&sq->lock, k);
+	return w;
+}
+
+/* Local work first, otherwise steal the highest priority item
+ * pending on another CPU.
+ */
+static struct k_p4wq_work *next_item(struct k_p4wq *queue)
+{
+	struct z_p4wq_subq *local = local_subq(queue);
+	struct k_p4wq_work *w = subq_take(local);
+
+	while (!w && Z_P4WQ_NUM_SUBQ > 1) {
+		struct z_p4wq_subq *best = NULL;
+		struct k_p4wq_work *bw = NULL;
+
+		for (int i = 0; i < Z_P4WQ_NUM_SUBQ; i++) {
+			struct z_p4wq_subq *sq = &queue->subq[i];
+
+			if (sq == local) {
+				continue;
+			}
+
+			k_spinlock_key_t k = k_spin_lock(&sq->lock);
+			struct k_p4wq_work *sw = subq_max(sq);
+
+			if (sw && (!bw || item_lessthan(bw, sw))) {
+				best = sq;
+				bw = sw;
+			}
+			k_spin_unlock(&sq->lock, k);
+		}
+
+		if (!best) {
+			break;
+		}
+
+		/* The item may be gone by now, steal whatever is
+		 * there or look again.
+		 */
+		w = subq_take(best);
+	}
+
+	return w;
+}
+
+static bool queue_empty(struct k_p4wq *queue)
+{
+	bool empty = true;
+
+	for (int i = 0; empty && i < Z_P4WQ_NUM_SUBQ; i++) {
+		struct z_p4wq_subq *sq = &queue->subq[i];
+		k_spinlock_key_t k = k_spin_lock(&sq->lock);
+
+		empty = rb_get_max(&sq->queue) == NULL;
+		k_spin_unlock(&sq->lock, k);
+	}
+
+	return empty;
+}
+
 static FUNC_NORETURN void p4wq_loop(void *p0, void *p1, void *p2)
 {
 	ARG_UNUSED(p1);
 	ARG_UNUSED(p2);
 	struct k_p4wq *queue = p0;
-	k_spinlock_key_t k = k_spin_lock(&queue->lock);
 
 	while (true) {
-		struct rbnode *r = rb_get_max(&queue->queue);
-
-		if (r) {
-			struct k_p4wq_work *w
-				= CONTAINER_OF(r, struct k_p4wq_work, rbnode);
-
-			rb_remove(&queue->queue, r);
-			w->thread = _current;
-			sys_dlist_append(&queue->active, &w->dlnode);
-			set_prio(_current, w);
-			thread_clear_requeued(_current);
+		struct k_p4wq_work *w = next_item(queue);
 
-			k_spin_unlock(&queue->lock, k);
+		if (w) {
+			/* A resubmitted item may already run or be done
+			 * on another thread once the handler returns, so
+			 * its sub-queue is read before.
+			 */
+			struct z_p4wq_subq *sq = w->subq;
 
 			w->handler(w);
 
-			k = k_spin_lock(&queue->lock);
+			k_spinlock_key_t k = k_spin_lock(&sq->lock);
 
 			/* Remove from the active list only if it
-			 * wasn't resubmitted already
+			 * wasn't resubmitted already, the item is not
+			 * ours anymore otherwise.
 			 */
 			if (!thread_was_requeued(_current)) {
 				sys_dlist_remove(&w->dlnode);
 				w->thread = NULL;
+				w->subq = NULL;
 				k_sem_give(&w->done_sem);
 			}
+
+			k_spin_unlock(&sq->lock, k);
 		} else {
-			z_pend_curr(&queue->lock, k, &queue->waitq, K_FOREVER);
-			k = k_spin_lock(&queue->lock);
+			/* Submitters only wake threads under the queue
+			 * lock, so an item queued after this check is
+			 * guaranteed to find us pended.
+			 */
+			k_spinlock_key_t k = k_spin_lock(&queue->lock);
+
+			if (queue_empty(queue)) {
+				z_pend_curr(&queue->lock, k, &queue->waitq,
+					    K_FOREVER);
+			} else {
+				k_spin_unlock(&queue->lock, k);
+			}
 		}
 	}
 }
@@ -125,8 +230,10 @@ void k_p4wq_init(struct k_p4wq *queue)
 {
 	memset(queue, 0, sizeof(*queue));
 	z_waitq_init(&queue->waitq);
-	queue->queue.lessthan_fn = rb_lessthan;
-	sys_dlist_init(&queue->active);
+	for (int i = 0; i < Z_P4WQ_NUM_SUBQ; i++) {
+		queue->subq[i].queue.lessthan_fn = rb_lessthan;
+		sys_dlist_init(&queue->subq[i].active);
+	}
 }
 
 void k_p4wq_add_thread(struct k_p4wq *queue, struct k_thread *thread,
@@ -216,7 +323,9 @@ SYS_INIT(static_init, APPLICATION, 99);
 
 void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
 {
-	k_spinlock_key_t k = k_spin_lock(&queue->lock);
+	struct z_p4wq_subq *sq = local_subq(queue);
+	k_spinlock_key_t k;
+	bool is_max;
 
 	/* Input is a delta time from now (to match
 	 * k_thread_deadline_set()), but we store and use the absolute
@@ -224,25 +333,34 @@ void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
 	 */
 	item->deadline += k_cycle_get_32();
 
-	/* Resubmission from within handler?  Remove from active list */
+	/* Resubmission from within handler?  Remove from active list.
+	 * Only the running thread itself sets item->thread to _current,
+	 * so this test is safe outside the lock.
+	 */
 	if (item->thread == _current) {
+		k = k_spin_lock(&item->subq->lock);
 		sys_dlist_remove(&item->dlnode);
 		thread_set_requeued(_current);
 		item->thread = NULL;
+		k_spin_unlock(&item->subq->lock, k);
 	} else {
 		k_sem_init(&item->done_sem, 0, 1);
 	}
 	__ASSERT_NO_MSG(item->thread == NULL);
 
-	rb_insert(&queue->queue, &item->rbnode);
+	k = k_spin_lock(&sq->lock);
+	rb_insert(&sq->queue, &item->rbnode);
 	item->queue = queue;
+	item->subq = sq;
+	is_max = rb_get_max(&sq->queue) == &item->rbnode;
+	k_spin_unlock(&sq->lock, k);
 
 	/* If there were other items already ahead of it in the queue,
 	 * then we don't need to revisit active thread state and can
 	 * return.
 	 */
-	if (rb_get_max(&queue->queue) != &item->rbnode) {
-		goto out;
+	if (!is_max) {
+		return;
 	}
 
 	/* Check the list of active (running or preempted) items, if
@@ -253,20 +371,26 @@ void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
 	struct k_p4wq_work *wi;
 	uint32_t n_beaten_by = 0, active_target = CONFIG_MP_NUM_CPUS;
 
-	SYS_DLIST_FOR_EACH_CONTAINER(&queue->active, wi, dlnode) {
-		/*
-		 * item_lessthan(a, b) == true means a has lower priority than b
-		 * !item_lessthan(a, b) counts all work items with higher or
-		 * equal priority
-		 */
-		if (!item_lessthan(wi, item)) {
-			n_beaten_by++;
+	for (int i = 0; i < Z_P4WQ_NUM_SUBQ; i++) {
+		struct z_p4wq_subq *asq = &queue->subq[i];
+
+		k = k_spin_lock(&asq->lock);
+		SYS_DLIST_FOR_EACH_CONTAINER(&asq->active, wi, dlnode) {
+			/*
+			 * item_lessthan(a, b) == true means a has lower
+			 * priority than b !item_lessthan(a, b) counts all
+			 * work items with higher or equal priority
+			 */
+			if (!item_lessthan(wi, item)) {
+				n_beaten_by++;
+			}
 		}
+		k_spin_unlock(&asq->lock, k);
 	}
 
 	if (n_beaten_by >= active_target) {
 		/* Too many already have higher priority, not preempting */
-		goto out;
+		return;
 	}
 
 	/* Grab a thread, set its priority and queue it.  If there are
@@ -274,33 +398,38 @@ void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
 	 * error: we are breaking our promise about run order.
 	 * Complain.
 	 */
+	k = k_spin_lock(&queue->lock);
+
 	struct k_thread *th = z_unpend_first_thread(&queue->waitq);
 
 	if (th == NULL) {
 		LOG_WRN("Out of worker threads, priority guarantee violated");
-		goto out;
+		k_spin_unlock(&queue->lock, k);
+		return;
 	}
 
 	set_prio(th, item);
 	z_ready_thread(th);
 	z_reschedule(&queue->lock, k);
-
-	return;
-
-out:
-	k_spin_unlock(&queue->lock, k);
 }
 
 bool k_p4wq_cancel(struct k_p4wq *queue, struct k_p4wq_work *item)
 {
-	k_spinlock_key_t k = k_spin_lock(&queue->lock);
-	bool ret = rb_contains(&queue->queue, &item->rbnode);
+	struct z_p4wq_subq *sq = item->subq;
+
+	if (sq == NULL) {
+		return false;
+	}
+
+	k_spinlock_key_t k = k_spin_lock(&sq->lock);
+	bool ret = rb_contains(&sq->queue, &item->rbnode);
 
 	if (ret) {
-		rb_remove(&queue->queue, &item->rbnode);
+		rb_remove(&sq->queue, &item->rbnode);
+		item->subq = NULL;
 		k_sem_give(&item->done_sem);
 	}
 
-	k_spin_unlock(&queue->lock, k);
+	k_spin_unlock(&sq->lock, k);
 	return ret;
 }
@@ -284,3 +284,141 @@ uint32_t ring_buf_get(struct ring_buf *buf, uint8_t *data, uint32_t size)
 
 	return total_size;
 }
+
+/* Header word of the records of the multi-producer ring buffer: the data
+ * size in bytes, a flag set once committed and a flag marking the padding
+ * left at the end of the buffer when a record does not fit there. The
+ * consumer zeroes the records it frees, so that the header of a record
+ * being reserved never reads as committed.
+ */
+#define MPSC_COMMITTED BIT(0)
+#define MPSC_PAD       BIT(1)
+#define MPSC_SIZE_SHIFT 2
+
+static inline uint32_t mpsc_wlen(uint32_t size)
+{
+	return 1U + DIV_ROUND_UP(size, sizeof(atomic_t));
+}
+
+void ring_buf_mpsc_init(struct ring_buf_mpsc *buf, uint32_t size32,
+			uint32_t *data)
+{
+	__ASSERT(IS_POWER_OF_TWO(size32) && size32 < RING_BUFFER_MAX_SIZE,
+		 "Size must be a power of 2");
+
+	(void)memset(data, 0, size32 * sizeof(uint32_t));
+	atomic_set(&buf->wr_idx, 0);
+	atomic_set(&buf->rd_idx, 0);
+	atomic_set(&buf->dropped, 0);
+	buf->mask = size32 - 1U;
+	buf->buf = (atomic_t *)data;
+}
+
+void *ring_buf_mpsc_reserve(struct ring_buf_mpsc *buf, uint32_t size)
+{
+	uint32_t wlen = mpsc_wlen(size);
+	uint32_t wr, rd, off, pad;
+
+	do {
+		wr = (uint32_t)atomic_get(&buf->wr_idx);
+		rd = (uint32_t)atomic_get(&buf->rd_idx);
+		off = wr & buf->mask;
+
+		/* The data must be contiguous: skip the end of the buffer */
+		pad = (off + wlen > buf->mask + 1U) ? buf->mask + 1U - off : 0U;
+
+		if ((wr - rd) + pad + wlen > buf->mask + 1U) {
+			atomic_inc(&buf->dropped);
+			return NULL;
+		}
+	} while (!atomic_cas(&buf->wr_idx, (atomic_val_t)wr,
+			     (atomic_val_t)(wr + pad + wlen)));
+
+	if (pad != 0U) {
+		atomic_set(&buf->buf[off],
+			   (((pad - 1U) * sizeof(atomic_t)) << MPSC_SIZE_SHIFT) |
+			   MPSC_PAD | MPSC_COMMITTED);
+		off = 0U;
+	}
+
+	atomic_set(&buf->buf[off], size << MPSC_SIZE_SHIFT);
+
+	return &buf->buf[off + 1U];
+}
+
+void ring_buf_mpsc_commit(struct ring_buf_mpsc *buf, void *data)
+{
+	ARG_UNUSED(buf);
+
+	(void)atomic_or((atomic_t *)data - 1, MPSC_COMMITTED);
+}
+
+int ring_buf_mpsc_put(struct ring_buf_mpsc *buf, const void *data,
+		      uint32_t size)
+{
+	void *rec = ring_buf_mpsc_reserve(buf, size);
+
+	if (rec == NULL) {
+		return -ENOMEM;
+	}
+
+	(void)memcpy(rec, data, size);
+	ring_buf_mpsc_commit(buf, rec);
+
+	return 0;
+}
+
+void *ring_buf_mpsc_claim(struct ring_buf_mpsc *buf, uint32_t *size)
+{
+	uint32_t rd, hdr;
+
+	while (true) {
+		rd = (uint32_t)atomic_get(&buf->rd_idx);
+		if (rd == (uint32_t)atomic_get(&buf->wr_idx)) {
+			return NULL;
+		}
+
+		hdr = (uint32_t)atomic_get(&buf->buf[rd & buf->mask]);
+		if ((hdr & MPSC_COMMITTED) == 0U) {
+			return NULL;
+		}
+
+		if ((hdr & MPSC_PAD) == 0U) {
+			*size = hdr >> MPSC_SIZE_SHIFT;
+			return &buf->buf[(rd & buf->mask) + 1U];
+		}
+
+		ring_buf_mpsc_free(buf, &buf->buf[(rd & buf->mask) + 1U]);
+	}
+}
+
+void ring_buf_mpsc_free(struct ring_buf_mpsc *buf, void *data)
+{
+	atomic_t *hdr = (atomic_t *)data - 1;
+	uint32_t wlen = mpsc_wlen((uint32_t)atomic_get(hdr) >> MPSC_SIZE_SHIFT);
+
+	__ASSERT(hdr == &buf->buf[(uint32_t)atomic_get(&buf->rd_idx) &
+				  buf->mask], "Records are freed in order");
+
+	(void)memset(hdr, 0, wlen * sizeof(atomic_t));
+	(void)atomic_add(&buf->rd_idx, (atomic_val_t)wlen);
+}
+
+int ring_buf_mpsc_get(struct ring_buf_mpsc *buf, void *data, uint32_t size)
+{
+	uint32_t rec_size;
+	void *rec = ring_buf_mpsc_claim(buf, &rec_size);
+
+	if (rec == NULL) {
+		return -EAGAIN;
+	}
+
+	if (rec_size > size) {
+		return -EMSGSIZE;
+	}
+
+	(void)memcpy(data, rec, rec_size);
+	ring_buf_mpsc_free(buf, rec);
+
+	return (int)rec_size;
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <sys/__assert.h>
+#include <sys/vecmath.h>
+
+#ifdef CONFIG_VECMATH_CMSIS_DSP
+#include <arm_math.h>
+#endif
+
+static inline int16_t sat_q15(int64_t value)
+{
+	return (int16_t)CLAMP(value, INT16_MIN, INT16_MAX);
+}
+
+int64_t vecmath_dot_q15(const int16_t *a, const int16_t *b, size_t len)
+{
+	int64_t sum = 0;
+
+#ifdef CONFIG_VECMATH_CMSIS_DSP
+	arm_dot_prod_q15(a, b, len, &sum);
+#else
+	for (size_t i = 0; i < len; i++) {
+		sum += (int32_t)a[i] * b[i];
+	}
+#endif
+
+	return sum;
+}
+
+void vecmath_copy_scale_q15(int16_t *dst, const int16_t *src, int16_t scale,
+			    int8_t shift, size_t len)
+{
+#ifdef CONFIG_VECMATH_CMSIS_DSP
+	arm_scale_q15(src, scale, shift, dst, len);
+#else
+	int8_t rshift = 15 - shift;
+
+	for (size_t i = 0; i < len; i++) {
+		dst[i] = sat_q15(((int32_t)src[i] * scale) >> rshift);
+	}
+#endif
+}
+
+void vecmath_q15_to_q31(int32_t *dst, const int16_t *src, size_t len)
+{
+#ifdef CONFIG_VECMATH_CMSIS_DSP
+	arm_q15_to_q31(src, dst, len);
+#else
+	for (size_t i = 0; i < len; i++) {
+		dst[i] = (int32_t)((uint32_t)(int32_t)src[i] << 16);
+	}
+#endif
+}
+
+void vecmath_q31_to_q15(int16_t *dst, const int32_t *src, size_t len)
+{
+#ifdef CONFIG_VECMATH_CMSIS_DSP
+	arm_q31_to_q15(src, dst, len);
+#else
+	for (size_t i = 0; i < len; i++) {
+		dst[i] = (int16_t)(src[i] >> 16);
+	}
+#endif
+}
+
+int vecmath_fir_q15_init(struct vecmath_fir_q15 *fir, const int16_t *coeffs,
+			 uint16_t taps, int16_t *state, uint16_t block)
+{
+	/* The limits of the CMSIS-DSP implementation, kept everywhere for
+	 * the filters to behave the same on all the platforms.
+	 */
+	if (taps < 4U || (taps % 2U) != 0U) {
+		return -EINVAL;
+	}
+
+	fir->coeffs = coeffs;
+	fir->state = state;
+	fir->taps = taps;
+	fir->block = block;
+
+#ifdef CONFIG_VECMATH_CMSIS_DSP
+	arm_fir_instance_q15 arm;
+
+	(void)arm_fir_init_q15(&arm, taps, coeffs, state, block);
+#else
+	memset(state, 0, (taps - 1U) * sizeof(*state));
+#endif
+
+	return 0;
+}
+
+void vecmath_fir_q15(struct vecmath_fir_q15 *fir, int16_t *dst,
+		     const int16_t *src, size_t len)
+{
+	__ASSERT_NO_MSG(len <= fir->block);
+
+#ifdef CONFIG_VECMATH_CMSIS_DSP
+	arm_fir_instance_q15 arm = {
+		.numTaps = fir->taps,
+		.pState = fir->state,
+		.pCoeffs = fir->coeffs,
+	};
+
+	arm_fir_q15(&arm, src, dst, len);
+#else
+	/* The previous taps - 1 samples, followed by the new ones */
+	int16_t *samples = fir->state;
+	size_t history = fir->taps - 1U;
+
+	memcpy(&samples[history], src, len * sizeof(*src));
+
+	for (size_t i = 0; i < len; i++) {
+		int64_t acc = 0;
+
+		for (size_t k = 0; k < fir->taps; k++) {
+			acc += (int32_t)fir->coeffs[k] * samples[i + k];
+		}
+
+		dst[i] = sat_q15(acc >> 15);
+	}
+
+	memmove(samples, &samples[len], history * sizeof(*samples));
+#endif
+}
@@ -4,21 +4,55 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <kernel.h>
+#include <ksched.h>
+#include <wait_q.h>
 #include <errno.h>
 #include <string.h>
 #include <sys/atomic.h>
+#include <sys/fnv1a.h>
 #include <posix/time.h>
 #include <posix/mqueue.h>
 
+/* Number of buckets of the table of queue names */
+#define MQ_NAME_BUCKETS 16
+
+/* Message slot, in the free list or in the list of its priority */
+struct mqueue_msg {
+	struct mqueue_msg *next;
+	size_t len;
+	char data[];
+};
+
+/* Message of a thread waiting to send or to receive */
+struct mqueue_wait {
+	char *buf;
+	size_t len;
+	unsigned int prio;
+};
+
 typedef struct mqueue_object {
 	sys_snode_t snode;
 	char *mem_buffer;
 	char *mem_obj;
-	struct k_msgq queue;
+	struct k_spinlock lock;
+	_wait_q_t send_wait_q;
+	_wait_q_t recv_wait_q;
+	struct mqueue_msg *free;
+	/* FIFO of the messages of each priority, with a bit set in
+	 * prio_bitmap when not empty: the next message is found in O(1).
+	 */
+	struct mqueue_msg *head[MQ_PRIO_MAX];
+	struct mqueue_msg *tail[MQ_PRIO_MAX];
+	uint32_t prio_bitmap;
+	size_t msg_size;
+	long max_msgs;
+	long used_msgs;
 	atomic_t ref_count;
 	char *name;
 } mqueue_object;
 
+BUILD_ASSERT(MQ_PRIO_MAX <= 32, "prio_bitmap holds 32 priorities");
+
 typedef struct mqueue_desc {
 	char *mem_desc;
 	mqueue_object *mqueue;
@@ -27,15 +61,16 @@ typedef struct mqueue_desc {
 
 K_SEM_DEFINE(mq_sem, 1, 1);
 
-/* Initialize the list */
-sys_slist_t mq_list = SYS_SLIST_STATIC_INIT(&mq_list);
+/* Queues by name, in buckets of a hash table */
+static sys_slist_t mq_table[MQ_NAME_BUCKETS];
 
 int64_t timespec_to_timeoutms(const struct timespec *abstime);
-static mqueue_object *find_in_list(const char *name);
+static sys_slist_t *name_bucket(const char *name);
+static mqueue_object *find_in_table(const char *name);
 static int32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_len,
-			  k_timeout_t timeout);
+			  unsigned int msg_prio, k_timeout_t timeout);
 static int receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
-			   k_timeout_t timeout);
+			   unsigned int *msg_prio, k_timeout_t timeout);
 static void remove_mq(mqueue_object *msg_queue);
 
 #if defined(__sparc__)
@@ -63,6 +98,7 @@ mqd_t mq_open(const char *name, int oflags, ...)
 	mode_t mode;
 	mq_attr *attrs = NULL;
 	long msg_size = 0U, max_msgs = 0U;
+	size_t slot_size;
 	mqueue_object *msg_queue;
 	mqueue_desc *msg_queue_desc = NULL, *mqd = (mqueue_desc *)(-1);
 	char *mq_desc_ptr, *mq_obj_ptr, *mq_buf_ptr, *mq_name_ptr;
@@ -92,7 +128,7 @@ mqd_t mq_open(const char *name, int oflags, ...)
 
 	/* Check if queue already exists */
 	k_sem_take(&mq_sem, K_FOREVER);
-	msg_queue = find_in_list(name);
+	msg_queue = find_in_table(name);
 	k_sem_give(&mq_sem);
 
 	if ((msg_queue != NULL) && (oflags & O_CREAT) != 0 &&
@@ -147,21 +183,33 @@ mqd_t mq_open(const char *name, int oflags, ...)
 
 		strcpy(msg_queue->name, name);
 
-		mq_buf_ptr = k_malloc(msg_size * max_msgs * sizeof(uint8_t));
+		slot_size = ROUND_UP(sizeof(struct mqueue_msg) + msg_size,
+				     sizeof(void *));
+		mq_buf_ptr = k_malloc(slot_size * max_msgs);
 		if (mq_buf_ptr != NULL) {
-			(void)memset(mq_buf_ptr, 0,
-				     msg_size * max_msgs * sizeof(uint8_t));
+			(void)memset(mq_buf_ptr, 0, slot_size * max_msgs);
 			msg_queue->mem_buffer = mq_buf_ptr;
 		} else {
 			goto free_mq_buffer;
 		}
 
 		(void)atomic_set(&msg_queue->ref_count, 1);
-		/* initialize zephyr message queue */
-		k_msgq_init(&msg_queue->queue, msg_queue->mem_buffer, msg_size,
-			    max_msgs);
+		/* initialize the message slots, all free */
+		z_waitq_init(&msg_queue->send_wait_q);
+		z_waitq_init(&msg_queue->recv_wait_q);
+		msg_queue->msg_size = msg_size;
+		msg_queue->max_msgs = max_msgs;
+		for (long i = max_msgs - 1; i >= 0; i--) {
+			struct mqueue_msg *msg = (struct mqueue_msg *)
+				&mq_buf_ptr[i * slot_size];
+
+			msg->next = msg_queue->free;
+			msg_queue->free = msg;
+		}
+
 		k_sem_take(&mq_sem, K_FOREVER);
-		sys_slist_append(&mq_list, (sys_snode_t *)&(msg_queue->snode));
+		sys_slist_append(name_bucket(name),
+				 (sys_snode_t *)&(msg_queue->snode));
 		k_sem_give(&mq_sem);
 
 	} else {
@@ -218,7 +266,7 @@ int mq_unlink(const char *name)
 	mqueue_object *msg_queue;
 
 	k_sem_take(&mq_sem, K_FOREVER);
-	msg_queue = find_in_list(name);
+	msg_queue = find_in_table(name);
 
 	if (msg_queue == NULL) {
 		k_sem_give(&mq_sem);
@@ -226,6 +274,9 @@ int mq_unlink(const char *name)
 		return -1;
 	}
 
+	/* The name is free from now on, the queue goes once closed */
+	sys_slist_find_and_remove(name_bucket(name),
+				  (sys_snode_t *)msg_queue);
 	k_free(msg_queue->name);
 	msg_queue->name = NULL;
 	k_sem_give(&mq_sem);
@@ -236,7 +287,8 @@ int mq_unlink(const char *name)
 /**
  * @brief Send a message to a message queue.
  *
- * All messages in message queue are of equal priority.
+ * The messages are received by decreasing priority, then in the order
+ * they were sent.
  *
  * See IEEE 1003.1
  */
@@ -245,13 +297,14 @@ int mq_send(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
 {
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
 
-	return send_message(mqd, msg_ptr, msg_len, K_FOREVER);
+	return send_message(mqd, msg_ptr, msg_len, msg_prio, K_FOREVER);
 }
 
 /**
  * @brief Send message to a message queue within abstime time.
  *
- * All messages in message queue are of equal priority.
+ * The messages are received by decreasing priority, then in the order
+ * they were sent.
  *
  * See IEEE 1003.1
  */
@@ -261,13 +314,13 @@ int mq_timedsend(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
 	int32_t timeout = (int32_t) timespec_to_timeoutms(abstime);
 
-	return send_message(mqd, msg_ptr, msg_len, K_MSEC(timeout));
+	return send_message(mqd, msg_ptr, msg_len, msg_prio, K_MSEC(timeout));
 }
 
 /**
  * @brief Receive a message from a message queue.
  *
- * All messages in message queue are of equal priority.
+ * The oldest message of the highest priority is received.
  *
  * See IEEE 1003.1
  */
@@ -276,13 +329,13 @@ int mq_receive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 {
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
 
-	return receive_message(mqd, msg_ptr, msg_len, K_FOREVER);
+	return receive_message(mqd, msg_ptr, msg_len, msg_prio, K_FOREVER);
 }
 
 /**
  * @brief Receive message from a message queue within abstime time.
  *
- * All messages in message queue are of equal priority.
+ * The oldest message of the highest priority is received.
  *
  * See IEEE 1003.1
  */
@@ -292,7 +345,8 @@ int mq_timedreceive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
 	int32_t timeout = (int32_t) timespec_to_timeoutms(abstime);
 
-	return receive_message(mqd, msg_ptr, msg_len, K_MSEC(timeout));
+	return receive_message(mqd, msg_ptr, msg_len, msg_prio,
+			       K_MSEC(timeout));
 }
 
 /**
@@ -303,20 +357,21 @@ int mq_timedreceive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 int mq_getattr(mqd_t mqdes, struct mq_attr *mqstat)
 {
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
-	struct k_msgq_attrs attrs;
+	mqueue_object *mq;
+	k_spinlock_key_t key;
 
 	if (mqd == NULL) {
 		errno = EBADF;
 		return -1;
 	}
 
-	k_sem_take(&mq_sem, K_FOREVER);
-	k_msgq_get_attrs(&mqd->mqueue->queue, &attrs);
+	mq = mqd->mqueue;
+	key = k_spin_lock(&mq->lock);
 	mqstat->mq_flags = mqd->flags;
-	mqstat->mq_maxmsg = attrs.max_msgs;
-	mqstat->mq_msgsize = attrs.msg_size;
-	mqstat->mq_curmsgs = attrs.used_msgs;
-	k_sem_give(&mq_sem);
+	mqstat->mq_maxmsg = mq->max_msgs;
+	mqstat->mq_msgsize = mq->msg_size;
+	mqstat->mq_curmsgs = mq->used_msgs;
+	k_spin_unlock(&mq->lock, key);
 	return 0;
 }
 
@@ -352,87 +407,217 @@ int mq_setattr(mqd_t mqdes, const struct mq_attr *mqstat,
 }
 
 /* Internal functions */
-static mqueue_object *find_in_list(const char *name)
+static sys_slist_t *name_bucket(const char *name)
 {
-	sys_snode_t *mq;
-	mqueue_object *msg_queue;
+	uint32_t hash = fnv1a_32_str(FNV1A_32_INIT, name);
 
-	mq = mq_list.head;
+	return &mq_table[hash % MQ_NAME_BUCKETS];
+}
+
+static mqueue_object *find_in_table(const char *name)
+{
+	mqueue_object *msg_queue;
 
-	while (mq != NULL) {
-		msg_queue = (mqueue_object *)mq;
+	SYS_SLIST_FOR_EACH_CONTAINER(name_bucket(name), msg_queue, snode) {
 		if (strcmp(msg_queue->name, name) == 0) {
 			return msg_queue;
 		}
-
-		mq = mq->next;
 	}
 
 	return NULL;
 }
 
+/* Called with the queue lock held. */
+static void msg_enqueue(mqueue_object *mq, struct mqueue_msg *msg,
+			unsigned int prio)
+{
+	msg->next = NULL;
+	if (mq->tail[prio] != NULL) {
+		mq->tail[prio]->next = msg;
+	} else {
+		mq->head[prio] = msg;
+	}
+	mq->tail[prio] = msg;
+	mq->prio_bitmap |= BIT(prio);
+}
+
+/* Called with the queue lock held, with at least one message queued. */
+static struct mqueue_msg *msg_dequeue(mqueue_object *mq, unsigned int *prio)
+{
+	struct mqueue_msg *msg;
+
+	*prio = 31U - __builtin_clz(mq->prio_bitmap);
+	msg = mq->head[*prio];
+	mq->head[*prio] = msg->next;
+	if (msg->next == NULL) {
+		mq->tail[*prio] = NULL;
+		mq->prio_bitmap &= ~BIT(*prio);
+	}
+
+	return msg;
+}
+
 static int32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_len,
-			  k_timeout_t timeout)
+			  unsigned int msg_prio, k_timeout_t timeout)
 {
-	int32_t ret = -1;
+	struct mqueue_wait wait;
+	struct mqueue_msg *msg;
+	struct k_thread *thread;
+	mqueue_object *mq;
+	k_spinlock_key_t key;
 
 	if (mqd == NULL) {
 		errno = EBADF;
-		return ret;
+		return -1;
 	}
 
+	mq = mqd->mqueue;
+
 	if ((mqd->flags & O_NONBLOCK) != 0U) {
 		timeout = K_NO_WAIT;
 	}
 
-	if (msg_len >  mqd->mqueue->queue.msg_size) {
+	if (msg_len > mq->msg_size) {
 		errno = EMSGSIZE;
-		return ret;
+		return -1;
 	}
 
-	if (k_msgq_put(&mqd->mqueue->queue, (void *)msg_ptr, timeout) != 0) {
-		errno = K_TIMEOUT_EQ(timeout, K_NO_WAIT) ? EAGAIN : ETIMEDOUT;
-		return ret;
+	if (msg_prio >= MQ_PRIO_MAX) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	key = k_spin_lock(&mq->lock);
+
+	/* A receiver waits: the queue is empty, the message goes straight
+	 * to its buffer.
+	 */
+	thread = z_unpend_first_thread(&mq->recv_wait_q);
+	if (thread != NULL) {
+		struct mqueue_wait *recv = thread->base.swap_data;
+
+		(void)memcpy(recv->buf, msg_ptr, msg_len);
+		recv->len = msg_len;
+		recv->prio = msg_prio;
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+		z_reschedule(&mq->lock, key);
+		return 0;
+	}
+
+	msg = mq->free;
+	if (msg != NULL) {
+		mq->free = msg->next;
+		(void)memcpy(msg->data, msg_ptr, msg_len);
+		msg->len = msg_len;
+		msg_enqueue(mq, msg, msg_prio);
+		mq->used_msgs++;
+		k_spin_unlock(&mq->lock, key);
+		return 0;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		k_spin_unlock(&mq->lock, key);
+		errno = EAGAIN;
+		return -1;
+	}
+
+	/* Wait for a receiver to queue the message in the slot it frees */
+	wait.buf = (char *)msg_ptr;
+	wait.len = msg_len;
+	wait.prio = msg_prio;
+	_current->base.swap_data = &wait;
+	if (z_pend_curr(&mq->lock, key, &mq->send_wait_q, timeout) != 0) {
+		errno = ETIMEDOUT;
+		return -1;
 	}
 
 	return 0;
 }
 
-static int32_t receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
-			     k_timeout_t timeout)
+static int receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
+			   unsigned int *msg_prio, k_timeout_t timeout)
 {
-	int ret = -1;
+	struct mqueue_wait wait;
+	struct mqueue_msg *msg;
+	struct k_thread *thread;
+	mqueue_object *mq;
+	k_spinlock_key_t key;
+	unsigned int prio;
+	int ret;
 
 	if (mqd == NULL) {
 		errno = EBADF;
-		return ret;
+		return -1;
 	}
 
-	if (msg_len < mqd->mqueue->queue.msg_size) {
+	mq = mqd->mqueue;
+
+	if (msg_len < mq->msg_size) {
 		errno = EMSGSIZE;
-		return ret;
+		return -1;
 	}
 
 	if ((mqd->flags & O_NONBLOCK) != 0U) {
 		timeout = K_NO_WAIT;
 	}
 
-	if (k_msgq_get(&mqd->mqueue->queue, (void *)msg_ptr, timeout) != 0) {
-		errno = K_TIMEOUT_EQ(timeout, K_NO_WAIT) ? EAGAIN : ETIMEDOUT;
-	} else {
-		ret = mqd->mqueue->queue.msg_size;
+	key = k_spin_lock(&mq->lock);
+
+	if (mq->prio_bitmap != 0U) {
+		msg = msg_dequeue(mq, &prio);
+		(void)memcpy(msg_ptr, msg->data, msg->len);
+		ret = (int)msg->len;
+
+		if (msg_prio != NULL) {
+			*msg_prio = prio;
+		}
+
+		/* A sender waits: its message takes the slot */
+		thread = z_unpend_first_thread(&mq->send_wait_q);
+		if (thread != NULL) {
+			struct mqueue_wait *send = thread->base.swap_data;
+
+			(void)memcpy(msg->data, send->buf, send->len);
+			msg->len = send->len;
+			msg_enqueue(mq, msg, send->prio);
+			arch_thread_return_value_set(thread, 0);
+			z_ready_thread(thread);
+			z_reschedule(&mq->lock, key);
+			return ret;
+		}
+
+		msg->next = mq->free;
+		mq->free = msg;
+		mq->used_msgs--;
+		k_spin_unlock(&mq->lock, key);
+		return ret;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		k_spin_unlock(&mq->lock, key);
+		errno = EAGAIN;
+		return -1;
 	}
 
-	return ret;
+	/* Wait for a sender to copy its message to the buffer */
+	wait.buf = msg_ptr;
+	_current->base.swap_data = &wait;
+	if (z_pend_curr(&mq->lock, key, &mq->recv_wait_q, timeout) != 0) {
+		errno = ETIMEDOUT;
+		return -1;
+	}
+
+	if (msg_prio != NULL) {
+		*msg_prio = wait.prio;
+	}
+
+	return (int)wait.len;
 }
 
 static void remove_mq(mqueue_object *msg_queue)
 {
 	if (atomic_cas(&msg_queue->ref_count, 0, 0)) {
-		k_sem_take(&mq_sem, K_FOREVER);
-		sys_slist_find_and_remove(&mq_list, (sys_snode_t *) msg_queue);
-		k_sem_give(&mq_sem);
-
 		/* Free mq buffer and pbject */
 		k_free(msg_queue->mem_buffer);
 		k_free(msg_queue->mem_obj);
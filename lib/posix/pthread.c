@@ -621,6 +621,27 @@ int pthread_setname_np(pthread_t thread, const char *name)
 #endif
 }
 
+int pthread_settimerslack_np(pthread_t thread, const struct timespec *slack)
+{
+	k_tid_t kthread = (k_tid_t)thread;
+
+	if (kthread == NULL) {
+		return ESRCH;
+	}
+
+	if (slack == NULL || slack->tv_sec < 0 || slack->tv_nsec < 0 ||
+	    slack->tv_nsec >= NSEC_PER_SEC) {
+		return EINVAL;
+	}
+
+#ifdef CONFIG_TIMEOUT_SLACK
+	k_thread_timeout_slack_set(kthread,
+				   K_USEC((int64_t)slack->tv_sec * USEC_PER_SEC +
+					  slack->tv_nsec / NSEC_PER_USEC));
+#endif
+	return 0;
+}
+
 int pthread_getname_np(pthread_t thread, char *name, size_t len)
 {
 #ifdef CONFIG_THREAD_NAME
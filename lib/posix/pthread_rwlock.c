@@ -4,18 +4,31 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <kernel.h>
+#include <ksched.h>
+#include <wait_q.h>
 #include <errno.h>
 #include <posix/time.h>
 #include <posix/posix_types.h>
+#include <posix/pthread.h>
 
 #define INITIALIZED 1
 #define NOT_INITIALIZED 0
 
-#define CONCURRENT_READER_LIMIT  (CONFIG_MAX_PTHREAD_COUNT + 1)
+/*
+ * The state of the lock is a single word: the number of readers holding
+ * the lock, a flag set while a writer holds it, and a flag set while
+ * threads wait for it. While no thread waits, the lock is taken and
+ * released with a single atomic operation on the state. The waiting
+ * threads are parked on wait queues, under the spinlock of the lock, and
+ * are handed the lock over when they are woken up.
+ */
+#define STATE_READERS_MASK (BIT(30) - 1)
+#define STATE_WRITER       BIT(30)
+#define STATE_WAITERS      BIT(31)
 
 int64_t timespec_to_timeoutms(const struct timespec *abstime);
-static uint32_t read_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout);
-static uint32_t write_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout);
+static int read_lock_acquire(pthread_rwlock_t *rwlock, k_timeout_t timeout);
+static int write_lock_acquire(pthread_rwlock_t *rwlock, k_timeout_t timeout);
 
 /**
  * @brief Initialize read-write lock object.
@@ -25,10 +38,13 @@ static uint32_t write_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout);
 int pthread_rwlock_init(pthread_rwlock_t *rwlock,
 			const pthread_rwlockattr_t *attr)
 {
-	k_sem_init(&rwlock->rd_sem, CONCURRENT_READER_LIMIT,
-		   CONCURRENT_READER_LIMIT);
-	k_sem_init(&rwlock->wr_sem, 1, 1);
-	k_sem_init(&rwlock->reader_active, 1, 1);
+	atomic_set(&rwlock->state, 0);
+	z_waitq_init(&rwlock->rd_wait_q);
+	z_waitq_init(&rwlock->wr_wait_q);
+	rwlock->rd_waiting = 0U;
+	rwlock->wr_waiting = 0U;
+	rwlock->prefer_writer = (attr != NULL) &&
+				(*attr != PTHREAD_RWLOCK_PREFER_READER_NP);
 	rwlock->wr_owner = NULL;
 	rwlock->status = INITIALIZED;
 	return 0;
@@ -45,7 +61,7 @@ int pthread_rwlock_destroy(pthread_rwlock_t *rwlock)
 		return EINVAL;
 	}
 
-	if (rwlock->wr_owner != NULL) {
+	if (atomic_get(&rwlock->state) != 0) {
 		return EBUSY;
 	}
 
@@ -60,9 +76,6 @@ int pthread_rwlock_destroy(pthread_rwlock_t *rwlock)
 /**
  * @brief Lock a read-write lock object for reading.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_rdlock(pthread_rwlock_t *rwlock)
@@ -71,22 +84,18 @@ int pthread_rwlock_rdlock(pthread_rwlock_t *rwlock)
 		return EINVAL;
 	}
 
-	return read_lock_acquire(rwlock, SYS_FOREVER_MS);
+	return read_lock_acquire(rwlock, K_FOREVER);
 }
 
 /**
  * @brief Lock a read-write lock object for reading within specific time.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_timedrdlock(pthread_rwlock_t *rwlock,
 			       const struct timespec *abstime)
 {
 	int32_t timeout;
-	uint32_t ret = 0U;
 
 	if (rwlock->status == NOT_INITIALIZED || abstime->tv_nsec < 0 ||
 	    abstime->tv_nsec > NSEC_PER_SEC) {
@@ -95,19 +104,16 @@ int pthread_rwlock_timedrdlock(pthread_rwlock_t *rwlock,
 
 	timeout = (int32_t) timespec_to_timeoutms(abstime);
 
-	if (read_lock_acquire(rwlock, timeout) != 0U) {
-		ret = ETIMEDOUT;
+	if (read_lock_acquire(rwlock, SYS_TIMEOUT_MS(timeout)) != 0) {
+		return ETIMEDOUT;
 	}
 
-	return ret;
+	return 0;
 }
 
 /**
  * @brief Lock a read-write lock object for reading immedately.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
@@ -116,14 +122,14 @@ int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
 		return EINVAL;
 	}
 
-	return read_lock_acquire(rwlock, 0);
+	return read_lock_acquire(rwlock, K_NO_WAIT);
 }
 
 /**
  * @brief Lock a read-write lock object for writing.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
+ * By default, the writer waits for the readers coming after it, see
+ * pthread_rwlockattr_setkind_np().
  *
  * See IEEE 1003.1
  */
@@ -133,14 +139,14 @@ int pthread_rwlock_wrlock(pthread_rwlock_t *rwlock)
 		return EINVAL;
 	}
 
-	return write_lock_acquire(rwlock, SYS_FOREVER_MS);
+	return write_lock_acquire(rwlock, K_FOREVER);
 }
 
 /**
  * @brief Lock a read-write lock object for writing within specific time.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
+ * By default, the writer waits for the readers coming after it, see
+ * pthread_rwlockattr_setkind_np().
  *
  * See IEEE 1003.1
  */
@@ -148,7 +154,7 @@ int pthread_rwlock_timedwrlock(pthread_rwlock_t *rwlock,
 			       const struct timespec *abstime)
 {
 	int32_t timeout;
-	uint32_t ret = 0U;
+	int ret;
 
 	if (rwlock->status == NOT_INITIALIZED || abstime->tv_nsec < 0 ||
 	    abstime->tv_nsec > NSEC_PER_SEC) {
@@ -157,7 +163,8 @@ int pthread_rwlock_timedwrlock(pthread_rwlock_t *rwlock,
 
 	timeout = (int32_t) timespec_to_timeoutms(abstime);
 
-	if (write_lock_acquire(rwlock, timeout) != 0U) {
+	ret = write_lock_acquire(rwlock, SYS_TIMEOUT_MS(timeout));
+	if (ret == EBUSY) {
 		ret = ETIMEDOUT;
 	}
 
@@ -167,9 +174,6 @@ int pthread_rwlock_timedwrlock(pthread_rwlock_t *rwlock,
 /**
  * @brief Lock a read-write lock object for writing immedately.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
@@ -178,7 +182,49 @@ int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
 		return EINVAL;
 	}
 
-	return write_lock_acquire(rwlock, 0);
+	return write_lock_acquire(rwlock, K_NO_WAIT);
+}
+
+/* Hand the lock over to the waiting threads it can be granted to: a
+ * writer once the lock is free, or all the waiting readers while no
+ * writer holds it. Called with the spinlock held and the waiters flag
+ * set, which keeps the other threads off the atomic paths but the release
+ * of the readers.
+ */
+static void waiters_wake(pthread_rwlock_t *rwlock)
+{
+	atomic_val_t state = atomic_get(&rwlock->state);
+	struct k_thread *thread;
+
+	if ((state & (STATE_WRITER | STATE_READERS_MASK)) == 0 &&
+	    rwlock->wr_waiting > 0U &&
+	    (rwlock->prefer_writer || rwlock->rd_waiting == 0U)) {
+		thread = z_unpend_first_thread(&rwlock->wr_wait_q);
+		if (thread != NULL) {
+			rwlock->wr_waiting--;
+			rwlock->wr_owner = thread;
+			atomic_set(&rwlock->state, STATE_WRITER | STATE_WAITERS);
+			arch_thread_return_value_set(thread, 0);
+			z_ready_thread(thread);
+			goto out;
+		}
+	}
+
+	if ((state & STATE_WRITER) == 0 &&
+	    (!rwlock->prefer_writer || rwlock->wr_waiting == 0U)) {
+		while ((thread = z_unpend_first_thread(&rwlock->rd_wait_q)) !=
+		       NULL) {
+			rwlock->rd_waiting--;
+			(void)atomic_inc(&rwlock->state);
+			arch_thread_return_value_set(thread, 0);
+			z_ready_thread(thread);
+		}
+	}
+
+out:
+	if (rwlock->rd_waiting == 0U && rwlock->wr_waiting == 0U) {
+		(void)atomic_and(&rwlock->state, ~STATE_WAITERS);
+	}
 }
 
 /**
@@ -189,6 +235,9 @@ int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
  */
 int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
 {
+	k_spinlock_key_t key;
+	atomic_val_t state;
+
 	if (rwlock->status == NOT_INITIALIZED) {
 		return EINVAL;
 	}
@@ -196,66 +245,140 @@ int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
 	if (k_current_get() == rwlock->wr_owner) {
 		/* Write unlock */
 		rwlock->wr_owner = NULL;
-		k_sem_give(&rwlock->reader_active);
-		k_sem_give(&rwlock->wr_sem);
-	} else {
-		/* Read unlock */
-		if (k_sem_count_get(&rwlock->rd_sem) ==
-				    (CONCURRENT_READER_LIMIT - 1)) {
-			/* Last read lock, unlock writer */
-			k_sem_give(&rwlock->reader_active);
+		if (atomic_cas(&rwlock->state, STATE_WRITER, 0)) {
+			return 0;
 		}
 
-		k_sem_give(&rwlock->rd_sem);
+		key = k_spin_lock(&rwlock->lock);
+		(void)atomic_and(&rwlock->state, ~STATE_WRITER);
+		waiters_wake(rwlock);
+		z_reschedule(&rwlock->lock, key);
+		return 0;
+	}
+
+	/* Read unlock */
+	do {
+		state = atomic_get(&rwlock->state);
+		if ((state & STATE_READERS_MASK) == 0) {
+			return EPERM;
+		}
+	} while (!atomic_cas(&rwlock->state, state, state - 1));
+
+	if ((state & STATE_WAITERS) != 0 &&
+	    (state & STATE_READERS_MASK) == 1) {
+		/* Last reader, a writer waits */
+		key = k_spin_lock(&rwlock->lock);
+		waiters_wake(rwlock);
+		z_reschedule(&rwlock->lock, key);
 	}
+
 	return 0;
 }
 
-
-static uint32_t read_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout)
+static int read_lock_acquire(pthread_rwlock_t *rwlock, k_timeout_t timeout)
 {
-	uint32_t ret = 0U;
-
-	if (k_sem_take(&rwlock->wr_sem, SYS_TIMEOUT_MS(timeout)) == 0) {
-		k_sem_take(&rwlock->reader_active, K_NO_WAIT);
-		k_sem_take(&rwlock->rd_sem, K_NO_WAIT);
-		k_sem_give(&rwlock->wr_sem);
-	} else {
-		ret = EBUSY;
+	atomic_val_t state = atomic_get(&rwlock->state);
+	k_spinlock_key_t key;
+	int ret;
+
+	if ((state & (STATE_WRITER | STATE_WAITERS)) == 0 &&
+	    atomic_cas(&rwlock->state, state, state + 1)) {
+		return 0;
 	}
 
-	return ret;
+	key = k_spin_lock(&rwlock->lock);
+
+	while (true) {
+		state = atomic_get(&rwlock->state);
+
+		if ((state & STATE_WRITER) == 0 &&
+		    (!rwlock->prefer_writer || rwlock->wr_waiting == 0U)) {
+			if (atomic_cas(&rwlock->state, state, state + 1)) {
+				k_spin_unlock(&rwlock->lock, key);
+				return 0;
+			}
+			continue;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&rwlock->lock, key);
+			return EBUSY;
+		}
+
+		/* From now on, the unlocks wake the waiters up */
+		if (atomic_cas(&rwlock->state, state, state | STATE_WAITERS)) {
+			break;
+		}
+	}
+
+	rwlock->rd_waiting++;
+	ret = z_pend_curr(&rwlock->lock, key, &rwlock->rd_wait_q, timeout);
+	if (ret == 0) {
+		/* Woken up with the lock */
+		return 0;
+	}
+
+	key = k_spin_lock(&rwlock->lock);
+	rwlock->rd_waiting--;
+	waiters_wake(rwlock);
+	z_reschedule(&rwlock->lock, key);
+
+	return EBUSY;
 }
 
-static uint32_t write_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout)
+static int write_lock_acquire(pthread_rwlock_t *rwlock, k_timeout_t timeout)
 {
-	uint32_t ret = 0U;
-	int64_t elapsed_time, st_time = k_uptime_get();
-	k_timeout_t k_timeout;
-
-	k_timeout = SYS_TIMEOUT_MS(timeout);
-
-	/* waiting for release of write lock */
-	if (k_sem_take(&rwlock->wr_sem, k_timeout) == 0) {
-		/* update remaining timeout time for 2nd sem */
-		if (timeout != SYS_FOREVER_MS) {
-			elapsed_time = k_uptime_get() - st_time;
-			timeout = timeout <= elapsed_time ? 0 :
-				  timeout - elapsed_time;
+	atomic_val_t state;
+	k_spinlock_key_t key;
+	int ret;
+
+	if (atomic_cas(&rwlock->state, 0, STATE_WRITER)) {
+		rwlock->wr_owner = k_current_get();
+		return 0;
+	}
+
+	if (rwlock->wr_owner == k_current_get()) {
+		return EDEADLK;
+	}
+
+	key = k_spin_lock(&rwlock->lock);
+
+	while (true) {
+		state = atomic_get(&rwlock->state);
+
+		if ((state & (STATE_WRITER | STATE_READERS_MASK)) == 0) {
+			if (atomic_cas(&rwlock->state, state,
+				       state | STATE_WRITER)) {
+				rwlock->wr_owner = k_current_get();
+				k_spin_unlock(&rwlock->lock, key);
+				return 0;
+			}
+			continue;
 		}
 
-		k_timeout = SYS_TIMEOUT_MS(timeout);
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&rwlock->lock, key);
+			return EBUSY;
+		}
 
-		/* waiting for reader to complete operation */
-		if (k_sem_take(&rwlock->reader_active, k_timeout) == 0) {
-			rwlock->wr_owner = k_current_get();
-		} else {
-			k_sem_give(&rwlock->wr_sem);
-			ret = EBUSY;
+		/* From now on, the unlocks wake the waiters up */
+		if (atomic_cas(&rwlock->state, state, state | STATE_WAITERS)) {
+			break;
 		}
+	}
 
-	} else {
-		ret = EBUSY;
+	rwlock->wr_waiting++;
+	ret = z_pend_curr(&rwlock->lock, key, &rwlock->wr_wait_q, timeout);
+	if (ret == 0) {
+		/* Woken up with the lock, wr_owner set by the waker */
+		return 0;
 	}
-	return ret;
+
+	/* The readers waiting behind this writer may now get the lock */
+	key = k_spin_lock(&rwlock->lock);
+	rwlock->wr_waiting--;
+	waiters_wake(rwlock);
+	z_reschedule(&rwlock->lock, key);
+
+	return EBUSY;
 }
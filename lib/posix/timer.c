@@ -78,6 +78,11 @@ int timer_create(clockid_t clockid, struct sigevent *evp, timer_t *timerid)
 		k_timer_init(&timer->ztimer, zephyr_timer_wrapper, NULL);
 	}
 
+#ifdef CONFIG_TIMEOUT_SLACK
+	/* Timers inherit the timer slack of the thread creating them */
+	timer->ztimer.timeout.slack = k_current_get()->base.timeout.slack;
+#endif
+
 	*timerid = (timer_t)timer;
 
 	return 0;
@@ -201,3 +206,29 @@ int timer_delete(timer_t timerid)
 
 	return 0;
 }
+
+/**
+ * @brief Set the slack of a per-process timer.
+ *
+ * Non-portable, extension function. The expiries of the timer may happen
+ * up to slack later than scheduled, so that they share a wake-up of the
+ * system with other timeouts. Ignored unless CONFIG_TIMEOUT_SLACK is
+ * enabled.
+ */
+int timer_setslack_np(timer_t timerid, const struct timespec *slack)
+{
+	struct timer_obj *timer = (struct timer_obj *) timerid;
+
+	if (timer == NULL || slack == NULL || slack->tv_sec < 0 ||
+	    slack->tv_nsec < 0 || slack->tv_nsec >= NSEC_PER_SEC) {
+		errno = EINVAL;
+		return -1;
+	}
+
+#ifdef CONFIG_TIMEOUT_SLACK
+	k_timer_slack_set(&timer->ztimer,
+			  K_USEC((int64_t)slack->tv_sec * USEC_PER_SEC +
+				 slack->tv_nsec / NSEC_PER_USEC));
+#endif
+	return 0;
+}
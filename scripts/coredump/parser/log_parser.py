@@ -4,6 +4,7 @@
 #
 # SPDX-License-Identifier: Apache-2.0
 
+import io
 import logging
 import struct
 
@@ -13,6 +14,10 @@ COREDUMP_HDR_ID = b'ZE'
 COREDUMP_HDR_VER = 1
 LOG_HDR_STRUCT = "<ccHHBBI"
 LOG_HDR_SIZE = struct.calcsize(LOG_HDR_STRUCT)
+COREDUMP_FLAG_COMPRESSED = 0x1
+
+# Shortest match of the compressed data
+LZ_MATCH_MIN = 3
 
 COREDUMP_ARCH_HDR_ID = b'A'
 LOG_ARCH_HDR_STRUCT = "<cHH"
@@ -45,6 +50,34 @@ def reason_string(reason):
     return ret
 
 
+def decompress(data):
+    """
+    Decompress the data past the header of a compressed coredump: blocks
+    of literal bytes and of matches repeating the output.
+    """
+    out = bytearray()
+    i = 0
+
+    while i < len(data):
+        ctrl = data[i]
+        i += 1
+
+        if ctrl < 0x80:
+            out += data[i:i + ctrl + 1]
+            i += ctrl + 1
+        else:
+            length = (ctrl & 0x7f) + LZ_MATCH_MIN
+            dist = data[i] | (data[i + 1] << 8)
+            i += 2
+
+            # The match may overlap its own output
+            start = len(out) - dist
+            for k in range(length):
+                out.append(out[start + k])
+
+    return bytes(out)
+
+
 class CoredumpLogFile:
     """
     Process the binary coredump file for register block
@@ -142,6 +175,12 @@ class CoredumpLogFile:
         logger.info("Reason: {0}".format(reason_string(reason)))
         logger.info(f"Pointer size {ptr_size}")
 
+        if flags & COREDUMP_FLAG_COMPRESSED:
+            data = decompress(self.fd.read())
+            self.fd.close()
+            self.fd = io.BytesIO(data)
+            logger.info(f"Decompressed size {len(data)}")
+
         del id1, id2, hdr_ver, tgt_code, ptr_size, flags, reason
 
         while True:
@@ -68,6 +68,10 @@ def parse_args():
     parser.add_argument("-v", "--verbose", action="store_true",
                         help="Print extra debugging information")
 
+    parser.add_argument("--name-hash", action="store_true",
+                        help="Also generate the device name hash table \
+                        (CONFIG_DEVICE_NAME_HASH)")
+
     parser.add_argument("-z", "--zephyr-base",
                         help="Path to current Zephyr base. If this argument \
                         is not provided the environment will be checked for \
@@ -97,6 +101,15 @@ def symbol_data(elf, sym):
             offset = addr - section['sh_addr']
             return bytes(section.data()[offset:offset + len])
 
+def string_at(elf, addr):
+    for section in elf.iter_sections():
+        start = section['sh_addr']
+        end = start + section['sh_size']
+
+        if start <= addr < end and section['sh_type'] != 'SHT_NOBITS':
+            data = section.data()[addr - start:]
+            return data[:data.index(b'\0')].decode('utf-8', 'replace')
+
 def symbol_handle_data(elf, sym):
     data = symbol_data(elf, sym)
     if data:
@@ -149,6 +162,64 @@ class Device:
             self.__handles = struct.unpack(format, data[offset:offset + size])[0]
         return self.__handles
 
+# These match name_hash() and name_hash_mix() in kernel/device.c
+def name_hash(name):
+    hash = 2166136261
+    for c in name.encode('utf-8'):
+        hash ^= c
+        hash = (hash * 16777619) & 0xffffffff
+    return hash
+
+def name_hash_mix(hash, disp):
+    hash ^= (disp * 0x9e3779b9) & 0xffffffff
+    hash ^= hash >> 16
+    hash = (hash * 0x85ebca6b) & 0xffffffff
+    hash ^= hash >> 13
+    hash = (hash * 0xc2b2ae35) & 0xffffffff
+    hash ^= hash >> 16
+    return hash
+
+def name_hash_table(names):
+    """Build a perfect hash of the device names, by hash and displace.
+
+    Returns one (displacement, ordinal) pair per device: the names of the
+    bucket at index i are placed with displacement i, and the device whose
+    name hashes to index i with that displacement has the given ordinal.
+    """
+    count = len(names)
+    disps = [0] * count
+    ords = [None] * count
+
+    # A name shared by several devices designates the first of them.
+    hashes = {}
+    for ordinal, name in enumerate(names):
+        if name is not None and name not in hashes:
+            hashes[name] = (name_hash(name), ordinal)
+
+    buckets = [[] for _ in range(count)]
+    for hash, ordinal in hashes.values():
+        buckets[name_hash_mix(hash, 0) % count].append((hash, ordinal))
+
+    # Largest buckets first, while most slots are free.
+    for index in sorted(range(count), key=lambda i: -len(buckets[i])):
+        bucket = buckets[index]
+        if not bucket:
+            break
+        for disp in range(0x10000):
+            slots = [name_hash_mix(hash, disp) % count for hash, _ in bucket]
+            if (len(set(slots)) == len(slots) and
+                    all(ords[slot] is None for slot in slots)):
+                break
+        else:
+            sys.exit("No perfect hash of the device names found")
+
+        disps[index] = disp
+        for slot, (_, ordinal) in zip(slots, bucket):
+            ords[slot] = ordinal
+
+    return [(disp, ordinal if ordinal is not None else 0)
+            for disp, ordinal in zip(disps, ords)]
+
 class Handles:
     def __init__(self, sym, addr, handles, node):
         self.sym = sym
@@ -327,5 +398,26 @@ def main():
 
             fp.write('\n'.join(lines))
 
+        if args.name_hash:
+            # The devices are in ordinal order. The name is the first
+            # field of the device struct.
+            names = []
+            for dev in devices:
+                data = symbol_data(elf, dev.sym)
+                format = "<" if elf.little_endian else ">"
+                format += "I" if elf.elfclass == 32 else "Q"
+                addr = struct.unpack_from(format, data)[0]
+                names.append(string_at(elf, addr) if addr else None)
+
+            slots = name_hash_table(names)
+            fp.write('\n/* Device name hash table, see name_hash_lookup() */\n')
+            fp.write('const struct z_device_name_slot __aligned(2) '
+                     '__attribute__((__section__(".__device_names_pass2")))\n')
+            fp.write('z_device_names[] = {\n')
+            for index, (disp, ordinal) in enumerate(slots):
+                fp.write('\t{ %d, %d }, /* %d: %s */\n' %
+                         (disp, ordinal, index, names[ordinal]))
+            fp.write('};\n')
+
 if __name__ == "__main__":
     main()
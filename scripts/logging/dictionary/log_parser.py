@@ -8,12 +8,14 @@
 Log Parser for Dictionary-based Logging
 
 This uses the JSON database file to decode the input binary
-log data and print the log messages.
+log data and print the log messages. The log data is read from a file,
+or received live from the networking backend with --udp.
 """
 
 import argparse
 import binascii
 import logging
+import socket
 import sys
 
 import dictionary_parser
@@ -31,7 +33,10 @@ def parse_args():
     argparser = argparse.ArgumentParser()
 
     argparser.add_argument("dbfile", help="Dictionary Logging Database file")
-    argparser.add_argument("logfile", help="Log Data file")
+    argparser.add_argument("logfile", nargs="?", help="Log Data file")
+    argparser.add_argument("--udp", type=int, metavar="PORT",
+                           help="Receive log data from the networking "
+                                "backend on this UDP port instead of a file")
     argparser.add_argument("--hex", action="store_true",
                            help="Log Data file is in hexadecimal strings")
     argparser.add_argument("--rawhex", action="store_true",
@@ -42,10 +47,37 @@ def parse_args():
     return argparser.parse_args()
 
 
+def receive_udp(database, port, debug):
+    """Decode the log messages received on a UDP port, one per datagram"""
+    log_parser = dictionary_parser.get_parser(database)
+    if log_parser is None:
+        logger.error("ERROR: Cannot find a suitable parser matching database version!")
+        sys.exit(1)
+
+    sock = socket.socket(socket.AF_INET6, socket.SOCK_DGRAM)
+    # Accept IPv4 senders too, as IPv4-mapped addresses.
+    sock.setsockopt(socket.IPPROTO_IPV6, socket.IPV6_V6ONLY, 0)
+    sock.bind(("::", port))
+
+    try:
+        while True:
+            logdata, _ = sock.recvfrom(65535)
+            if not log_parser.parse_log_data(logdata, debug=debug):
+                logger.error("ERROR: cannot parse %d bytes of log data", len(logdata))
+    except KeyboardInterrupt:
+        pass
+    finally:
+        sock.close()
+
+
 def main():
     """Main function of log parser"""
     args = parse_args()
 
+    if (args.logfile is None) == (args.udp is None):
+        logger.error("ERROR: Give either a log data file or --udp, exiting...")
+        sys.exit(1)
+
     # Setup logging for parser
     logging.basicConfig(format=LOGGER_FORMAT)
     if args.debug:
@@ -59,6 +91,10 @@ def main():
         logger.error("ERROR: Cannot open database file: %s, exiting...", args.dbfile)
         sys.exit(1)
 
+    if args.udp is not None:
+        receive_udp(database, args.udp, args.debug)
+        return
+
     # Open log data file for reading
     if args.hex:
         if args.rawhex:
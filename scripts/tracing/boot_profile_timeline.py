@@ -0,0 +1,203 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2021 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Script to render the boot profile (CONFIG_BOOT_PROFILING) as a timeline.
+
+The records are read from the boot log (CONFIG_BOOT_PROFILING_PRINT) or from
+the output of the "boot_profile" shell command, one line per record:
+
+    boot_profile freq <Hz> dropped <count>
+    boot_profile <level> <start cycles> <cycles> <init function> <name>
+
+Init entries without a device are named after their init function, resolved
+with the symbol table of the Zephyr ELF file when given.
+
+    ./scripts/tracing/boot_profile_timeline.py -e build/zephyr/zephyr.elf \\
+      boot.log
+
+By default the timeline is printed as text. With --chrome, it is written in
+the Trace Event format, which chrome://tracing and Perfetto open.
+"""
+
+import argparse
+import bisect
+import json
+import re
+import sys
+
+HEADER_RE = re.compile(r'boot_profile freq (\d+) dropped (\d+)')
+RECORD_RE = re.compile(r'boot_profile ([A-Z_0-9]+) (-?\d+) (\d+) (\S+) (.+)$')
+
+# Phases of the boot, in the order they run.
+LEVELS = ["EARLY", "PRE_KERNEL_1", "PRE_KERNEL_2", "POST_KERNEL",
+          "APPLICATION", "SMP", "MAIN"]
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+            description=__doc__,
+            formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("log",
+            help="boot log, or output of the 'boot_profile' shell command")
+    parser.add_argument("-e", "--elf",
+            help="Zephyr ELF file, to name the init functions")
+    parser.add_argument("-c", "--chrome", metavar="FILE",
+            help="write the timeline in the Trace Event format to FILE")
+    parser.add_argument("-w", "--width", type=int, default=60,
+            help="width of the text timeline, in characters")
+    parser.add_argument("-m", "--min-us", type=float, default=0.0,
+            help="hide the init entries shorter than this, in us")
+    return parser.parse_args()
+
+class Symbols:
+    def __init__(self, elf_path):
+        from elftools.elf.elffile import ELFFile
+        from elftools.elf.sections import SymbolTableSection
+
+        funcs = {}
+
+        with open(elf_path, 'rb') as f:
+            elf = ELFFile(f)
+            for section in elf.iter_sections():
+                if not isinstance(section, SymbolTableSection):
+                    continue
+                for sym in section.iter_symbols():
+                    if (sym['st_info']['type'] == 'STT_FUNC' and
+                            sym['st_value'] != 0):
+                        # Thumb function symbols have the LSB set.
+                        funcs[sym['st_value'] & ~1] = sym.name
+
+        self.addrs = sorted(funcs)
+        self.names = [funcs[addr] for addr in self.addrs]
+
+    def lookup(self, addr):
+        addr &= ~1
+        i = bisect.bisect_left(self.addrs, addr)
+        if i < len(self.addrs) and self.addrs[i] == addr:
+            return self.names[i]
+        return None
+
+def parse_func(func):
+    try:
+        return int(func, 16)
+    except ValueError:
+        # NULL pointers print as "(nil)".
+        return 0
+
+def read_log(path):
+    freq = None
+    dropped = 0
+    records = []
+
+    with open(path, 'r', errors='replace') as f:
+        for line in f:
+            m = HEADER_RE.search(line)
+            if m:
+                # A new profile, e.g. printed at boot then from the shell.
+                freq = int(m.group(1))
+                dropped = int(m.group(2))
+                records = []
+                continue
+            m = RECORD_RE.search(line)
+            if m:
+                records.append({
+                    "level": m.group(1),
+                    "start": int(m.group(2)),
+                    "cycles": int(m.group(3)),
+                    "func": parse_func(m.group(4)),
+                    "name": m.group(5).strip(),
+                })
+
+    if freq is None:
+        sys.exit(f"No boot profile found in {path}")
+
+    return freq, dropped, records
+
+def record_name(record, symbols):
+    if record["func"] == 0:
+        return record["name"]
+
+    func = symbols.lookup(record["func"]) if symbols else None
+    if func is None:
+        func = hex(record["func"])
+    if record["name"] == "-":
+        return func
+    return f"{record['name']} ({func})"
+
+def is_span(record):
+    """Init levels and early phases, as opposed to the steps within."""
+    return record["func"] == 0 and (record["level"] == "EARLY" or
+                                    record["name"] == record["level"])
+
+def print_timeline(records, freq, width, min_us):
+    to_us = lambda cycles: cycles * 1e6 / freq
+
+    begin = min(r["start"] for r in records)
+    end = max(r["start"] + r["cycles"] for r in records)
+    scale = width / max(end - begin, 1)
+
+    print(f"{'start us':>10} {'us':>10}  {'':{width}}  name")
+    for r in records:
+        if not is_span(r) and to_us(r["cycles"]) < min_us:
+            continue
+
+        col = int((r["start"] - begin) * scale)
+        length = max(1, int(r["cycles"] * scale))
+        bar = " " * col + ("=" if is_span(r) else "#") * length
+        indent = "" if is_span(r) else "  "
+
+        print(f"{to_us(r['start']):10.1f} {to_us(r['cycles']):10.1f}  "
+              f"{bar[:width]:{width}}  {indent}{r['display']}")
+
+    print(f"total {to_us(end - begin):.1f} us")
+
+def write_chrome(path, records, freq):
+    events = []
+    to_us = lambda cycles: cycles * 1e6 / freq
+
+    begin = min(r["start"] for r in records)
+    for r in records:
+        events.append({
+            "name": r["display"],
+            "cat": r["level"],
+            "ph": "X",
+            "ts": to_us(r["start"] - begin),
+            "dur": to_us(r["cycles"]),
+            "pid": 0,
+            # The spans on their own row, the steps below.
+            "tid": 0 if is_span(r) else 1,
+        })
+
+    with open(path, 'w') as f:
+        json.dump({"traceEvents": events, "displayTimeUnit": "ns"}, f,
+                  indent=1)
+
+def main():
+    args = parse_args()
+    symbols = Symbols(args.elf) if args.elf else None
+
+    freq, dropped, records = read_log(args.log)
+    if not records:
+        sys.exit("The boot profile holds no records")
+
+    for r in records:
+        r["display"] = record_name(r, symbols)
+
+    # Spans first when they start with their first step.
+    records.sort(key=lambda r: (r["start"], not is_span(r),
+                                LEVELS.index(r["level"])
+                                if r["level"] in LEVELS else len(LEVELS)))
+
+    if args.chrome:
+        write_chrome(args.chrome, records, freq)
+    else:
+        print_timeline(records, freq, args.width, args.min_us)
+
+    if dropped:
+        print(f"warning: {dropped} records were dropped, increase "
+              "CONFIG_BOOT_PROFILING_RECORDS", file=sys.stderr)
+
+if __name__ == "__main__":
+    main()
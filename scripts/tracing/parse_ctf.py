@@ -43,6 +43,9 @@ def main():
     msg_it = bt2.TraceCollectionMessageIterator(args.trace)
     last_event_ns_from_origin = None
     timeline = []
+    # CPU the events come from, as told by cpu_id events when the target
+    # records into per-CPU buffers.
+    current_cpu = None
 
     def get_thread(name):
         for t in timeline:
@@ -65,6 +68,10 @@ def main():
 
         dt = datetime.datetime.fromtimestamp(ns_from_origin / 1e9)
 
+        if event.name == 'cpu_id':
+            current_cpu = event.payload_field.get("cpu", None)
+            continue
+
         if event.name in [
                 'thread_switched_out',
                 'thread_switched_in',
@@ -76,7 +83,7 @@ def main():
                 'thread_abort'
                 ]:
 
-            cpu = event.payload_field.get("cpu", None)
+            cpu = event.payload_field.get("cpu", current_cpu)
             thread_id = event.payload_field.get("thread_id", None)
             thread_name = event.payload_field.get("name", None)
 
@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2021 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Script to fold the samples of the sampling profiler (CONFIG_PROFILER) into
+the collapsed stack format read by flame graph tools, one line per distinct
+stack:
+
+    <thread>;<caller>;<function> <count>
+
+The samples are read either from the output of the "profiler dump" shell
+command, or from a CTF trace recorded with CONFIG_PROFILER_TRACING.
+Addresses are resolved with the symbol table of the Zephyr ELF file.
+
+    ./scripts/tracing/profiler_fold.py -e build/zephyr/zephyr.elf \\
+      -d dump.txt > profile.folded
+    flamegraph.pl profile.folded > profile.svg
+"""
+
+import argparse
+import bisect
+import collections
+import re
+import sys
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.sections import SymbolTableSection
+
+# Values of PROFILER_IRQ_NONE and PROFILER_IRQ_UNKNOWN
+IRQ_NONE = -1
+IRQ_UNKNOWN = -2
+
+SAMPLE_RE = re.compile(r'sample (\d+) (\S+) (-?\d+) (0x[0-9a-fA-F]+) '
+                       r'(0x[0-9a-fA-F]+)')
+THREAD_RE = re.compile(r'thread (\S+) (.+)$')
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+            description=__doc__,
+            formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("-e", "--elf", required=True,
+            help="Zephyr ELF file")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("-d", "--dump",
+            help="output of the 'profiler dump' shell command")
+    source.add_argument("-t", "--trace",
+            help="CTF trace (directory with metadata and trace file)")
+    parser.add_argument("--no-caller", action="store_true",
+            help="do not add the caller found in the link register")
+    parser.add_argument("--per-cpu", action="store_true",
+            help="add the CPU as the root of the stacks")
+    return parser.parse_args()
+
+class Symbols:
+    def __init__(self, elf_path):
+        self.addrs = []
+        self.names = []
+
+        with open(elf_path, 'rb') as f:
+            elf = ELFFile(f)
+            funcs = []
+            for section in elf.iter_sections():
+                if not isinstance(section, SymbolTableSection):
+                    continue
+                for sym in section.iter_symbols():
+                    if (sym['st_info']['type'] == 'STT_FUNC' and
+                            sym['st_value'] != 0):
+                        # Thumb function symbols have the LSB set.
+                        funcs.append((sym['st_value'] & ~1,
+                                      sym['st_size'], sym.name))
+
+        for addr, size, name in sorted(funcs):
+            self.addrs.append(addr)
+            self.names.append((name, addr + size))
+
+    def lookup(self, addr):
+        addr &= ~1
+        i = bisect.bisect_right(self.addrs, addr) - 1
+        if i < 0:
+            return None
+        name, end = self.names[i]
+        if addr >= end and end != self.addrs[i]:
+            return None
+        return name
+
+def samples_from_dump(path):
+    threads = {}
+    samples = []
+
+    with open(path, 'r', errors='replace') as f:
+        for line in f:
+            m = SAMPLE_RE.search(line)
+            if m:
+                samples.append((int(m.group(1)), m.group(2),
+                                int(m.group(3)), int(m.group(4), 16),
+                                int(m.group(5), 16)))
+                continue
+            m = THREAD_RE.search(line)
+            if m:
+                threads[m.group(1)] = m.group(2).strip()
+
+    return samples, threads
+
+def samples_from_trace(path):
+    try:
+        import bt2
+    except ImportError:
+        sys.exit("Missing dependency: You need to install python bindings of babletrace.")
+
+    threads = {}
+    samples = []
+    current_cpu = 0
+
+    for msg in bt2.TraceCollectionMessageIterator(path):
+        if type(msg) is not bt2._EventMessageConst:
+            continue
+        event = msg.event
+        if event.name == 'cpu_id':
+            current_cpu = int(event.payload_field['cpu'])
+        elif event.name == 'profiler_sample':
+            samples.append((current_cpu,
+                            hex(int(event.payload_field['thread_id'])),
+                            int(event.payload_field['irq']),
+                            int(event.payload_field['pc']),
+                            int(event.payload_field['lr'])))
+        elif 'thread_id' in event.payload_field and \
+                'name' in event.payload_field:
+            name = str(event.payload_field['name'])
+            if name:
+                threads[hex(int(event.payload_field['thread_id']))] = name
+
+    return samples, threads
+
+def thread_key(thread):
+    try:
+        return hex(int(thread, 16))
+    except ValueError:
+        return thread
+
+def main():
+    args = parse_args()
+    symbols = Symbols(args.elf)
+
+    if args.dump:
+        samples, threads = samples_from_dump(args.dump)
+    else:
+        samples, threads = samples_from_trace(args.trace)
+
+    threads = {thread_key(k): v for k, v in threads.items()}
+    stacks = collections.Counter()
+
+    for cpu, thread, irq, pc, lr in samples:
+        frames = [f"cpu{cpu}"] if args.per_cpu else []
+
+        if irq == IRQ_NONE:
+            frames.append(threads.get(thread_key(thread), thread))
+            func = symbols.lookup(pc) or hex(pc)
+            caller = symbols.lookup(lr) if lr and not args.no_caller \
+                else None
+            # LR is the return address into the caller until the function
+            # calls another one, e.g. in leaf functions, it is stale after.
+            if caller and caller != func:
+                frames.append(caller)
+            frames.append(func)
+        elif irq == IRQ_UNKNOWN:
+            frames.append("[exception]")
+        else:
+            frames.append(f"[irq {irq}]")
+
+        stacks[";".join(frames)] += 1
+
+    for stack, count in sorted(stacks.items()):
+        print(f"{stack} {count}")
+
+if __name__ == "__main__":
+    main()
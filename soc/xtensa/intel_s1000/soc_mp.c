@@ -202,4 +202,11 @@ void soc_sched_ipi(void)
 			 IPM_CAVS_IDC_MSG_SCHED_IPI_DATA, 0);
 	}
 }
+
+void arch_sched_directed_ipi(uint32_t cpu_bitmap)
+{
+	if (likely(idc != NULL)) {
+		cavs_idc_sched_ipi(cpu_bitmap);
+	}
+}
 #endif
@@ -290,6 +290,24 @@ BUILD_ASSERT(sizeof(struct ticker_user_op) == TICKER_USER_OP_T_SIZE);
 #define TICKER_INSTANCE_MAX 1
 static struct ticker_instance _instance[TICKER_INSTANCE_MAX];
 
+#if defined(CONFIG_BT_TICKER_ENQUEUE_INDEX)
+#define TICKER_ENQUEUE_INDEX_SIZE 16
+
+/* Sparse index of the active ticker node list, with every few nodes and
+ * their ticks to expire from ticks_base. The nodes keep their expiry while
+ * they are in the list, so the index stays valid as long as the nodes
+ * which are dequeued or expire are removed from it.
+ */
+static struct {
+	uint8_t  count;			/* Number of indexed nodes */
+	uint8_t  count_built;		/* Number of nodes indexed by build */
+	uint8_t  inserts;		/* Nodes enqueued since last build */
+	uint32_t ticks_base;		/* Ticks current at last update */
+	uint8_t  id[TICKER_ENQUEUE_INDEX_SIZE];
+	uint32_t ticks[TICKER_ENQUEUE_INDEX_SIZE];
+} enqueue_index;
+#endif /* CONFIG_BT_TICKER_ENQUEUE_INDEX */
+
 /*****************************************************************************
  * Static Functions
  ****************************************************************************/
@@ -465,6 +483,176 @@ static void ticker_by_next_slot_get(struct ticker_instance *instance,
 }
 
 #if !defined(CONFIG_BT_TICKER_LOW_LAT)
+#if defined(CONFIG_BT_TICKER_ENQUEUE_INDEX)
+/**
+ * @brief Build the enqueue index
+ *
+ * @details Walks the ticker node list to count the nodes, then samples
+ * them evenly into the index with their ticks to expire accumulated from
+ * the head.
+ *
+ * @param instance Pointer to ticker instance
+ * @internal
+ */
+static void ticker_enqueue_index_build(struct ticker_instance *instance)
+{
+	struct ticker_node *node;
+	uint32_t ticks_to_expire;
+	uint8_t current;
+	uint8_t stride;
+	uint8_t count;
+
+	node = &instance->nodes[0];
+
+	count = 0U;
+	current = instance->ticker_id_head;
+	while (current != TICKER_NULL) {
+		count++;
+		current = node[current].next;
+	}
+
+	stride = count / TICKER_ENQUEUE_INDEX_SIZE + 1;
+	ticks_to_expire = 0U;
+	count = 0U;
+
+	enqueue_index.count = 0U;
+	enqueue_index.inserts = 0U;
+	enqueue_index.ticks_base = instance->ticks_current;
+
+	current = instance->ticker_id_head;
+	while ((current != TICKER_NULL) &&
+	       (enqueue_index.count < TICKER_ENQUEUE_INDEX_SIZE)) {
+		ticks_to_expire += node[current].ticks_to_expire;
+
+		if (++count == stride) {
+			enqueue_index.id[enqueue_index.count] = current;
+			enqueue_index.ticks[enqueue_index.count] =
+				ticks_to_expire;
+			enqueue_index.count++;
+			count = 0U;
+		}
+
+		current = node[current].next;
+	}
+
+	enqueue_index.count_built = enqueue_index.count;
+}
+
+/**
+ * @brief Remove entries from the enqueue index
+ *
+ * @param first Index of first entry to remove
+ * @param count Number of entries to remove
+ * @internal
+ */
+static void ticker_enqueue_index_remove(uint8_t first, uint8_t count)
+{
+	uint8_t i;
+
+	enqueue_index.count -= count;
+
+	for (i = first; i < enqueue_index.count; i++) {
+		enqueue_index.id[i] = enqueue_index.id[i + count];
+		enqueue_index.ticks[i] = enqueue_index.ticks[i + count];
+	}
+}
+
+/**
+ * @brief Update the enqueue index before enqueuing
+ *
+ * @details Moves the index to the current ticks, removing the nodes which
+ * have expired since. The index is rebuilt when half of the nodes it was
+ * built with are gone, or when enough nodes have been enqueued between
+ * the indexed ones to make the walk from them long.
+ *
+ * @param instance Pointer to ticker instance
+ * @internal
+ */
+static void ticker_enqueue_index_update(struct ticker_instance *instance)
+{
+	uint32_t ticks_elapsed;
+	uint8_t expired;
+	uint8_t i;
+
+	ticks_elapsed = ticker_ticks_diff_get(instance->ticks_current,
+					      enqueue_index.ticks_base);
+	enqueue_index.ticks_base = instance->ticks_current;
+
+	expired = 0U;
+	for (i = 0U; i < enqueue_index.count; i++) {
+		if (enqueue_index.ticks[i] <= ticks_elapsed) {
+			expired++;
+		} else {
+			enqueue_index.ticks[i] -= ticks_elapsed;
+		}
+	}
+
+	ticker_enqueue_index_remove(0U, expired);
+
+	if ((enqueue_index.count < (enqueue_index.count_built / 2U)) ||
+	    (enqueue_index.inserts > (instance->count_node / 2U))) {
+		ticker_enqueue_index_build(instance);
+	}
+}
+
+/**
+ * @brief Remove dequeued ticker node from the enqueue index
+ *
+ * @param id Ticker node id being dequeued
+ * @internal
+ */
+static void ticker_enqueue_index_dequeue(uint8_t id)
+{
+	uint8_t i;
+
+	for (i = 0U; i < enqueue_index.count; i++) {
+		if (enqueue_index.id[i] == id) {
+			ticker_enqueue_index_remove(i, 1U);
+			break;
+		}
+	}
+}
+
+/**
+ * @brief Find the enqueue start point
+ *
+ * @details Binary searches the enqueue index for the last indexed node
+ * expiring strictly before ticks_to_expire. All nodes up to and including
+ * it expire before the new node, so the enqueue walk can start after it.
+ *
+ * @param ticks_to_expire Ticks to expire of the node to enqueue
+ * @param ticks           Pointer to return the ticks to expire of the
+ *                        found node
+ *
+ * @return Id of found node, or TICKER_NULL to start from the head
+ * @internal
+ */
+static uint8_t ticker_enqueue_index_find(uint32_t ticks_to_expire,
+					 uint32_t *ticks)
+{
+	uint8_t low, high, mid;
+
+	low = 0U;
+	high = enqueue_index.count;
+	while (low < high) {
+		mid = (low + high) / 2U;
+		if (enqueue_index.ticks[mid] < ticks_to_expire) {
+			low = mid + 1U;
+		} else {
+			high = mid;
+		}
+	}
+
+	if (!low) {
+		return TICKER_NULL;
+	}
+
+	*ticks = enqueue_index.ticks[low - 1U];
+
+	return enqueue_index.id[low - 1U];
+}
+#endif /* CONFIG_BT_TICKER_ENQUEUE_INDEX */
+
 /**
  * @brief Enqueue ticker node
  *
@@ -486,6 +674,9 @@ static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
 	uint32_t ticks_to_expire;
 	uint8_t previous;
 	uint8_t current;
+#if defined(CONFIG_BT_TICKER_ENQUEUE_INDEX)
+	uint32_t ticks_index;
+#endif /* CONFIG_BT_TICKER_ENQUEUE_INDEX */
 
 	node = &instance->nodes[0];
 	ticker_new = &node[id];
@@ -497,6 +688,16 @@ static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
 	 */
 	previous = TICKER_NULL;
 
+#if defined(CONFIG_BT_TICKER_ENQUEUE_INDEX)
+	enqueue_index.inserts++;
+
+	previous = ticker_enqueue_index_find(ticks_to_expire, &ticks_index);
+	if (previous != TICKER_NULL) {
+		ticks_to_expire -= ticks_index;
+		current = node[previous].next;
+	}
+#endif /* CONFIG_BT_TICKER_ENQUEUE_INDEX */
+
 	while ((current != TICKER_NULL) && (ticks_to_expire >=
 		(ticks_to_expire_current =
 		(ticker_current = &node[current])->ticks_to_expire))) {
@@ -680,6 +881,10 @@ static uint32_t ticker_dequeue(struct ticker_instance *instance, uint8_t id)
 		return 0;
 	}
 
+#if defined(CONFIG_BT_TICKER_ENQUEUE_INDEX)
+	ticker_enqueue_index_dequeue(id);
+#endif /* CONFIG_BT_TICKER_ENQUEUE_INDEX */
+
 	if (previous == current) {
 		/* Ticker is the first in the list */
 		instance->ticker_id_head = ticker_current->next;
@@ -1748,6 +1953,10 @@ static inline uint32_t ticker_job_insert(struct ticker_instance *instance,
 {
 	ARG_UNUSED(insert_head);
 
+#if defined(CONFIG_BT_TICKER_ENQUEUE_INDEX)
+	ticker_enqueue_index_update(instance);
+#endif /* CONFIG_BT_TICKER_ENQUEUE_INDEX */
+
 	/* Prepare to insert */
 	ticker->next = TICKER_NULL;
 
@@ -1956,6 +2165,12 @@ static uint8_t ticker_job_reschedule_in_window(struct ticker_instance *instance,
 			nodes[ticker_id_prev].next = ticker_id_head;
 		}
 
+#if defined(CONFIG_BT_TICKER_ENQUEUE_INDEX)
+		/* Nodes were moved, rebuild the index on next enqueue */
+		enqueue_index.count = 0U;
+		enqueue_index.count_built = 1U;
+#endif /* CONFIG_BT_TICKER_ENQUEUE_INDEX */
+
 		/* Remove latency added in ticker_worker */
 		ticker->lazy_current--;
 
@@ -2186,8 +2401,7 @@ static inline void ticker_job_list_insert(struct ticker_instance *instance,
 				}
 			}
 		}
-	}
-}
+	}}
 
 /**
  * @brief Perform inquiry for specific user operation
@@ -2570,6 +2784,10 @@ uint32_t ticker_init(uint8_t instance_index, uint8_t count_node, void *node,
 	instance->sched_cb = sched_cb;
 	instance->trigger_set_cb = trigger_set_cb;
 
+#if defined(CONFIG_BT_TICKER_ENQUEUE_INDEX)
+	enqueue_index.count = 0U;
+#endif /* CONFIG_BT_TICKER_ENQUEUE_INDEX */
+
 	instance->ticker_id_head = TICKER_NULL;
 	instance->ticker_id_slot_previous = TICKER_NULL;
 	instance->ticks_slot_previous = 0U;
@@ -90,6 +90,13 @@ struct bt_att_chan {
 	struct k_work_delayable	timeout_work;
 	void (*sent)(struct bt_att_chan *chan);
 	sys_snode_t		node;
+#if defined(CONFIG_BT_EATT_STATS)
+	uint32_t		reqs;
+	uint32_t		pdus;
+	uint32_t		busy_ms;
+	/* Uptime when the pending request was sent */
+	uint32_t		req_time;
+#endif /* CONFIG_BT_EATT_STATS */
 };
 
 /* ATT connection specific data */
@@ -115,6 +122,28 @@ static struct bt_att_req cancel;
 typedef void (*bt_att_chan_sent_t)(struct bt_att_chan *chan);
 
 static bt_att_chan_sent_t chan_cb(struct net_buf *buf);
+
+static inline void att_chan_stats_pdu(struct bt_att_chan *chan)
+{
+#if defined(CONFIG_BT_EATT_STATS)
+	chan->pdus++;
+#endif /* CONFIG_BT_EATT_STATS */
+}
+
+static inline void att_chan_stats_req(struct bt_att_chan *chan)
+{
+#if defined(CONFIG_BT_EATT_STATS)
+	chan->reqs++;
+	chan->req_time = k_uptime_get_32();
+#endif /* CONFIG_BT_EATT_STATS */
+}
+
+static inline void att_chan_stats_rsp(struct bt_att_chan *chan)
+{
+#if defined(CONFIG_BT_EATT_STATS)
+	chan->busy_ms += k_uptime_get_32() - chan->req_time;
+#endif /* CONFIG_BT_EATT_STATS */
+}
 static bt_conn_tx_cb_t att_cb(bt_att_chan_sent_t cb);
 
 static void att_chan_mtu_updated(struct bt_att_chan *updated_chan);
@@ -151,15 +180,6 @@ static int chan_send(struct bt_att_chan *chan, struct net_buf *buf,
 
 	if (IS_ENABLED(CONFIG_BT_EATT) &&
 	    atomic_test_bit(chan->flags, ATT_ENHANCED)) {
-		/* Check if sent is pending already, if it does it cannot be
-		 * modified so the operation will need to be queued.
-		 */
-		if (atomic_test_and_set_bit(chan->flags, ATT_PENDING_SENT)) {
-			return -EAGAIN;
-		}
-
-		chan->sent = cb ? cb : chan_cb(buf);
-
 		if (hdr->code == BT_ATT_OP_SIGNED_WRITE_CMD) {
 			return -ENOTSUP;
 		}
@@ -171,14 +191,26 @@ static int chan_send(struct bt_att_chan *chan, struct net_buf *buf,
 			return -EAGAIN;
 		}
 
+		/* Check if sent is pending already, if it does it cannot be
+		 * modified so the operation will need to be queued.
+		 */
+		if (atomic_test_and_set_bit(chan->flags, ATT_PENDING_SENT)) {
+			return -EAGAIN;
+		}
+
+		chan->sent = cb ? cb : chan_cb(buf);
+
 		/* bt_l2cap_chan_send does actually return the number of bytes
 		 * that could be sent immediatelly.
 		 */
 		err = bt_l2cap_chan_send(&chan->chan.chan, buf);
 		if (err < 0) {
+			atomic_clear_bit(chan->flags, ATT_PENDING_SENT);
 			return err;
 		}
 
+		att_chan_stats_pdu(chan);
+
 		return 0;
 	}
 
@@ -203,6 +235,8 @@ static int chan_send(struct bt_att_chan *chan, struct net_buf *buf,
 	if (err) {
 		/* In case of an error has occurred restore the buffer state */
 		net_buf_simple_restore(&buf->b, &state);
+	} else {
+		att_chan_stats_pdu(chan);
 	}
 
 	return err;
@@ -249,11 +283,17 @@ static int chan_req_send(struct bt_att_chan *chan, struct bt_att_req *req)
 
 	err = chan_send(chan, buf, NULL);
 	if (err) {
-		/* We still have the ownership of the buffer */
+		/* We still have the ownership of the buffer, and the request
+		 * goes back to the queue so the channel is free again.
+		 */
 		req->buf = buf;
+		chan->req = NULL;
+		return err;
 	}
 
-	return err;
+	att_chan_stats_req(chan);
+
+	return 0;
 }
 
 static void bt_att_sent(struct bt_l2cap_chan *ch)
@@ -445,27 +485,31 @@ static int bt_att_chan_send(struct bt_att_chan *chan, struct net_buf *buf,
 	return chan_send(chan, buf, cb);
 }
 
+/* Send the queued PDUs on the channels which can take them, so that a
+ * stream of commands is spread over all the bearers.
+ */
 static void att_send_process(struct bt_att *att)
 {
 	struct bt_att_chan *chan, *tmp;
 	struct net_buf *buf;
-	int err = -ENOENT;
+	int err;
 
-	buf = net_buf_get(&att->tx_queue, K_NO_WAIT);
-	if (!buf) {
-		return;
-	}
+	while ((buf = net_buf_get(&att->tx_queue, K_NO_WAIT))) {
+		err = -ENOENT;
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&att->chans, chan, tmp, node) {
-		err = bt_att_chan_send(chan, buf, NULL);
-		if (err >= 0) {
-			break;
+		SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&att->chans, chan, tmp,
+						  node) {
+			err = bt_att_chan_send(chan, buf, NULL);
+			if (err >= 0) {
+				break;
+			}
 		}
-	}
 
-	if (err < 0) {
-		/* Push it back if it could not be send */
-		k_queue_prepend(&att->tx_queue._queue, buf);
+		if (err < 0) {
+			/* Push it back if it could not be send */
+			k_queue_prepend(&att->tx_queue._queue, buf);
+			return;
+		}
 	}
 }
 
@@ -573,7 +617,7 @@ static int bt_att_chan_req_send(struct bt_att_chan *chan,
 	return chan_req_send(chan, req);
 }
 
-static void att_req_send_process(struct bt_att *att)
+static bool att_req_send_next(struct bt_att *att)
 {
 	sys_snode_t *node;
 	struct bt_att_chan *chan, *tmp;
@@ -581,7 +625,7 @@ static void att_req_send_process(struct bt_att *att)
 	/* Pull next request from the list */
 	node = sys_slist_get(&att->reqs);
 	if (!node) {
-		return;
+		return false;
 	}
 
 	BT_DBG("req %p", ATT_REQ(node));
@@ -590,13 +634,25 @@ static void att_req_send_process(struct bt_att *att)
 		/* If there is nothing pending use the channel */
 		if (!chan->req) {
 			if (bt_att_chan_req_send(chan, ATT_REQ(node)) >= 0) {
-				return;
+				return true;
 			}
 		}
 	}
 
 	/* Prepend back to the list as it could not be sent */
 	sys_slist_prepend(&att->reqs, node);
+
+	return false;
+}
+
+/* Each bearer has at most one request pending, the queued requests are
+ * given to all the bearers which are free so that they are handled by the
+ * peer in parallel.
+ */
+static void att_req_send_process(struct bt_att *att)
+{
+	while (att_req_send_next(att)) {
+	}
 }
 
 static uint8_t att_handle_rsp(struct bt_att_chan *chan, void *pdu, uint16_t len,
@@ -616,6 +672,8 @@ static uint8_t att_handle_rsp(struct bt_att_chan *chan, void *pdu, uint16_t len,
 		goto process;
 	}
 
+	att_chan_stats_rsp(chan);
+
 	/* Check if request has been cancelled */
 	if (chan->req == &cancel) {
 		chan->req = NULL;
@@ -2744,7 +2802,6 @@ static void bt_att_encrypt_change(struct bt_l2cap_chan *chan,
 static void bt_att_status(struct bt_l2cap_chan *ch, atomic_t *status)
 {
 	struct bt_att_chan *chan = ATT_CHAN(ch);
-	sys_snode_t *node;
 
 	BT_DBG("chan %p status %p", ch, status);
 
@@ -2762,18 +2819,7 @@ static void bt_att_status(struct bt_l2cap_chan *ch, atomic_t *status)
 		return;
 	}
 
-	/* Pull next request from the list */
-	node = sys_slist_get(&chan->att->reqs);
-	if (!node) {
-		return;
-	}
-
-	if (bt_att_chan_req_send(chan, ATT_REQ(node)) >= 0) {
-		return;
-	}
-
-	/* Prepend back to the list as it could not be sent */
-	sys_slist_prepend(&chan->att->reqs, node);
+	att_req_send_process(chan->att);
 }
 
 static void bt_att_released(struct bt_l2cap_chan *ch)
@@ -2949,6 +2995,36 @@ void bt_att_init(void)
 	}
 }
 
+#if defined(CONFIG_BT_EATT_STATS)
+void bt_att_stats_foreach(struct bt_conn *conn,
+			  bt_gatt_bearer_stats_func_t func, void *user_data)
+{
+	struct bt_att_chan *chan, *tmp;
+	struct bt_gatt_bearer_stats stats;
+	struct bt_att *att;
+
+	att = att_get(conn);
+	if (!att) {
+		return;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&att->chans, chan, tmp, node) {
+		stats.cid = chan->chan.tx.cid;
+		stats.mtu = chan->chan.tx.mtu;
+		stats.enhanced = atomic_test_bit(chan->flags, ATT_ENHANCED);
+		stats.reqs = chan->reqs;
+		stats.pdus = chan->pdus;
+		stats.busy_ms = chan->busy_ms;
+
+		if (chan->req && chan->req != &cancel) {
+			stats.busy_ms += k_uptime_get_32() - chan->req_time;
+		}
+
+		func(conn, &stats, user_data);
+	}
+}
+#endif /* CONFIG_BT_EATT_STATS */
+
 uint16_t bt_att_get_mtu(struct bt_conn *conn)
 {
 	struct bt_att_chan *chan, *tmp;
@@ -6,6 +6,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <bluetooth/gatt.h>
+
 #define BT_EATT_PSM		0x27
 #define BT_ATT_DEFAULT_LE_MTU	23
 #define BT_ATT_TIMEOUT		K_SECONDS(30)
@@ -304,3 +306,7 @@ int bt_eatt_connect(struct bt_conn *conn, uint8_t num_channels);
 
 /* Disconnect EATT channels */
 int bt_eatt_disconnect(struct bt_conn *conn);
+
+/* Report the statistics of the ATT channels */
+void bt_att_stats_foreach(struct bt_conn *conn,
+			  bt_gatt_bearer_stats_func_t func, void *user_data);
@@ -95,6 +95,42 @@ struct k_sem *bt_conn_get_pkts(struct bt_conn *conn)
 	return &bt_dev.le.acl_pkts;
 }
 
+static struct k_poll_signal conn_change =
+		K_POLL_SIGNAL_INITIALIZER(conn_change);
+
+static inline bool conn_tx_quota_reached(struct bt_conn *conn)
+{
+#if defined(CONFIG_BT_CONN_TX_QUOTA)
+	return conn->tx_quota && atomic_get(&conn->tx_pkts) >= conn->tx_quota;
+#else
+	return false;
+#endif /* CONFIG_BT_CONN_TX_QUOTA */
+}
+
+static inline void conn_pkt_take(struct bt_conn *conn)
+{
+	/* Wait until the controller can accept ACL packets */
+	k_sem_take(bt_conn_get_pkts(conn), K_FOREVER);
+
+#if defined(CONFIG_BT_CONN_TX_QUOTA)
+	atomic_inc(&conn->tx_pkts);
+#endif /* CONFIG_BT_CONN_TX_QUOTA */
+}
+
+void bt_conn_pkt_done(struct bt_conn *conn)
+{
+#if defined(CONFIG_BT_CONN_TX_QUOTA)
+	atomic_val_t pkts = atomic_dec(&conn->tx_pkts);
+
+	if (conn->tx_quota && pkts >= conn->tx_quota) {
+		/* Let the TX thread poll the connection again */
+		k_poll_signal_raise(&conn_change, 0);
+	}
+#endif /* CONFIG_BT_CONN_TX_QUOTA */
+
+	k_sem_give(bt_conn_get_pkts(conn));
+}
+
 static inline const char *state2str(bt_conn_state_t state)
 {
 	switch (state) {
@@ -461,6 +497,11 @@ struct bt_conn *bt_conn_new(struct bt_conn *conns, size_t size)
 	k_work_init_delayable(&conn->deferred_work, deferred_work);
 	k_work_init(&conn->tx_complete_work, tx_complete_work);
 
+#if defined(CONFIG_BT_CONN_TX_QUOTA)
+	conn->tx_quota = CONFIG_BT_CONN_TX_QUOTA_DEFAULT;
+	conn->tx_weight = CONFIG_BT_CONN_TX_WEIGHT_DEFAULT;
+#endif /* CONFIG_BT_CONN_TX_QUOTA */
+
 	return conn;
 }
 
@@ -1159,8 +1200,7 @@ static bool send_frag(struct bt_conn *conn, struct net_buf *buf, uint8_t flags,
 	BT_DBG("conn %p buf %p len %u flags 0x%02x", conn, buf, buf->len,
 	       flags);
 
-	/* Wait until the controller can accept ACL packets */
-	k_sem_take(bt_conn_get_pkts(conn), K_FOREVER);
+	conn_pkt_take(conn);
 
 	/* Check for disconnection while waiting for pkts_sem */
 	if (conn->state != BT_CONN_CONNECTED) {
@@ -1208,7 +1248,7 @@ static bool send_frag(struct bt_conn *conn, struct net_buf *buf, uint8_t flags,
 	return true;
 
 fail:
-	k_sem_give(bt_conn_get_pkts(conn));
+	bt_conn_pkt_done(conn);
 	if (tx) {
 		tx_free(tx);
 	}
@@ -1259,18 +1299,68 @@ static struct net_buf *create_frag(struct bt_conn *conn, struct net_buf *buf)
 
 	frag_len = MIN(conn_mtu(conn), net_buf_tailroom(frag));
 
-	net_buf_add_mem(frag, buf->data, frag_len);
-	net_buf_pull(buf, frag_len);
+	/* The data may span the fragments of a buffer chain */
+	while (frag_len && buf) {
+		uint16_t len = MIN(frag_len, buf->len);
+
+		net_buf_add_mem(frag, buf->data, len);
+		net_buf_pull(buf, len);
+		frag_len -= len;
+		buf = buf->frags;
+	}
 
 	return frag;
 }
 
+/* The data of a buffer chain is copied into the fragments, the last
+ * fragment takes over the TX callback of the chain.
+ */
+static bool send_buf_chain(struct bt_conn *conn, struct net_buf *buf)
+{
+	uint8_t flags = FRAG_START;
+	struct net_buf *frag;
+
+	while (net_buf_frags_len(buf) > conn_mtu(conn)) {
+		frag = create_frag(conn, buf);
+		if (!frag) {
+			return false;
+		}
+
+		if (!send_frag(conn, frag, flags, true)) {
+			return false;
+		}
+
+		flags = FRAG_CONT;
+	}
+
+	frag = create_frag(conn, buf);
+	if (!frag) {
+		return false;
+	}
+
+	tx_data(frag)->tx = tx_data(buf)->tx;
+	tx_data(buf)->tx = NULL;
+
+	if (!send_frag(conn, frag, flags == FRAG_START ? FRAG_SINGLE : FRAG_END,
+		       true)) {
+		return false;
+	}
+
+	net_buf_unref(buf);
+
+	return true;
+}
+
 static bool send_buf(struct bt_conn *conn, struct net_buf *buf)
 {
 	struct net_buf *frag;
 
 	BT_DBG("conn %p buf %p len %u", conn, buf, buf->len);
 
+	if (buf->frags) {
+		return send_buf_chain(conn, buf);
+	}
+
 	/* Send directly if the packet fits the ACL MTU */
 	if (buf->len <= conn_mtu(conn)) {
 		return send_frag(conn, buf, FRAG_SINGLE, false);
@@ -1304,9 +1394,6 @@ static bool send_buf(struct bt_conn *conn, struct net_buf *buf)
 	return send_frag(conn, buf, FRAG_END, false);
 }
 
-static struct k_poll_signal conn_change =
-		K_POLL_SIGNAL_INITIALIZER(conn_change);
-
 static void conn_cleanup(struct bt_conn *conn)
 {
 	struct net_buf *buf;
@@ -1345,6 +1432,11 @@ static int conn_prepare_events(struct bt_conn *conn,
 		return -ENOTCONN;
 	}
 
+	if (conn_tx_quota_reached(conn)) {
+		BT_DBG("conn %p used its TX quota", conn);
+		return -ENOBUFS;
+	}
+
 	BT_DBG("Adding conn %p to poll list", conn);
 
 	k_poll_event_init(&events[0],
@@ -1407,6 +1499,25 @@ void bt_conn_process_tx(struct bt_conn *conn)
 	if (!send_buf(conn, buf)) {
 		net_buf_unref(buf);
 	}
+
+#if defined(CONFIG_BT_CONN_TX_QUOTA)
+	/* The other packets of the turn of the connection */
+	for (int i = 1; i < conn->tx_weight; i++) {
+		if (conn->state != BT_CONN_CONNECTED ||
+		    conn_tx_quota_reached(conn)) {
+			break;
+		}
+
+		buf = net_buf_get(&conn->tx_queue, K_NO_WAIT);
+		if (!buf) {
+			break;
+		}
+
+		if (!send_buf(conn, buf)) {
+			net_buf_unref(buf);
+		}
+	}
+#endif /* CONFIG_BT_CONN_TX_QUOTA */
 }
 
 bool bt_conn_exists_le(uint8_t id, const bt_addr_le_t *peer)
@@ -1464,7 +1575,7 @@ static void process_unack_tx(struct bt_conn *conn)
 		if (conn->pending_no_cb) {
 			conn->pending_no_cb--;
 			irq_unlock(key);
-			k_sem_give(bt_conn_get_pkts(conn));
+			bt_conn_pkt_done(conn);
 			continue;
 		}
 
@@ -1484,7 +1595,7 @@ static void process_unack_tx(struct bt_conn *conn)
 
 		tx_free(tx);
 
-		k_sem_give(bt_conn_get_pkts(conn));
+		bt_conn_pkt_done(conn);
 	}
 }
 
@@ -1904,6 +2015,23 @@ const bt_addr_le_t *bt_conn_get_dst(const struct bt_conn *conn)
 	return &conn->le.dst;
 }
 
+#if defined(CONFIG_BT_CONN_TX_QUOTA)
+int bt_conn_set_tx_sched(struct bt_conn *conn, uint8_t quota, uint8_t weight)
+{
+	if (!weight) {
+		return -EINVAL;
+	}
+
+	conn->tx_quota = quota;
+	conn->tx_weight = weight;
+
+	/* The connection may be below its new quota */
+	k_poll_signal_raise(&conn_change, 0);
+
+	return 0;
+}
+#endif /* CONFIG_BT_CONN_TX_QUOTA */
+
 int bt_conn_get_info(const struct bt_conn *conn, struct bt_conn_info *info)
 {
 	info->type = conn->type;
@@ -179,6 +179,13 @@ struct bt_conn {
 	/* Queue for outgoing ACL data */
 	struct k_fifo		tx_queue;
 
+#if defined(CONFIG_BT_CONN_TX_QUOTA)
+	/* Controller buffers used by the connection */
+	atomic_t		tx_pkts;
+	uint8_t			tx_quota;
+	uint8_t			tx_weight;
+#endif /* CONFIG_BT_CONN_TX_QUOTA */
+
 	/* Active L2CAP/ISO channels */
 	sys_slist_t		channels;
 
@@ -399,6 +406,9 @@ int bt_conn_init(void);
 /* Selects based on connecton type right semaphore for ACL packets */
 struct k_sem *bt_conn_get_pkts(struct bt_conn *conn);
 
+/* Give back the controller buffer of a packet of the connection */
+void bt_conn_pkt_done(struct bt_conn *conn);
+
 /* k_poll related helpers for the TX thread */
 int bt_conn_prepare_events(struct k_poll_event events[]);
 void bt_conn_process_tx(struct bt_conn *conn);
@@ -856,6 +856,175 @@ BT_GATT_SERVICE_DEFINE(_1_gatt_svc,
 #endif /* CONFIG_BT_GATT_SERVICE_CHANGED */
 );
 
+#if defined(CONFIG_BT_GATT_DB_INDEX)
+/* Attribute arrays of the services in ascending handle order, the static
+ * services first. Once a service does not fit, the database is walked
+ * instead.
+ */
+struct db_index_entry {
+	const struct bt_gatt_attr *attrs;
+	uint16_t start;
+	uint16_t count;
+	/* The handle of attrs[i] is start + i */
+	bool contiguous;
+	/* attrs[0] is the only service declaration */
+	bool single_svc;
+};
+
+static struct db_index_entry db_index[CONFIG_BT_GATT_DB_INDEX_SIZE];
+static uint16_t db_index_len;
+static bool db_index_valid;
+/* Positions of the static services in db_index, by attribute address */
+static uint8_t db_index_by_addr[CONFIG_BT_GATT_DB_INDEX_SIZE];
+static uint16_t db_index_static_len;
+
+static bool is_svc_decl(const struct bt_uuid *uuid)
+{
+	return !bt_uuid_cmp(uuid, BT_UUID_GATT_PRIMARY) ||
+	       !bt_uuid_cmp(uuid, BT_UUID_GATT_SECONDARY);
+}
+
+static void db_index_entry_init(struct db_index_entry *entry,
+				const struct bt_gatt_attr *attrs,
+				uint16_t count, uint16_t start)
+{
+	entry->attrs = attrs;
+	entry->start = start;
+	entry->count = count;
+	entry->contiguous = true;
+	entry->single_svc = true;
+
+	for (uint16_t i = 0; i < count; i++) {
+		if (attrs[i].handle && attrs[i].handle != start + i) {
+			entry->contiguous = false;
+		}
+
+		if (i > 0 && is_svc_decl(attrs[i].uuid)) {
+			entry->single_svc = false;
+		}
+	}
+}
+
+static void db_index_init(void)
+{
+	uint16_t handle = 1;
+	int j;
+
+	Z_STRUCT_SECTION_FOREACH(bt_gatt_service_static, svc) {
+		if (db_index_len == ARRAY_SIZE(db_index)) {
+			BT_WARN("Too many services for the database index");
+			return;
+		}
+
+		db_index_entry_init(&db_index[db_index_len], svc->attrs,
+				    svc->attr_count, handle);
+		handle += svc->attr_count;
+
+		/* Insertion sort by address */
+		for (j = db_index_len; j > 0; j--) {
+			if (db_index[db_index_by_addr[j - 1]].attrs <
+			    svc->attrs) {
+				break;
+			}
+
+			db_index_by_addr[j] = db_index_by_addr[j - 1];
+		}
+
+		db_index_by_addr[j] = db_index_len++;
+	}
+
+	db_index_static_len = db_index_len;
+	db_index_valid = true;
+}
+
+/* Position of the last service starting at or before handle */
+static uint16_t db_index_find(uint16_t handle)
+{
+	uint16_t lo = 0, hi = db_index_len;
+
+	while (hi - lo > 1) {
+		uint16_t mid = (lo + hi) / 2;
+
+		if (db_index[mid].start <= handle) {
+			lo = mid;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+static uint16_t db_index_static_handle(const struct bt_gatt_attr *attr)
+{
+	uint16_t lo = 0, hi = db_index_static_len;
+	const struct db_index_entry *entry;
+
+	if (!db_index_static_len) {
+		return 0;
+	}
+
+	/* Last service whose attributes start at or before attr */
+	while (hi - lo > 1) {
+		uint16_t mid = (lo + hi) / 2;
+
+		if (db_index[db_index_by_addr[mid]].attrs <= attr) {
+			lo = mid;
+		} else {
+			hi = mid;
+		}
+	}
+
+	entry = &db_index[db_index_by_addr[lo]];
+	if (attr < entry->attrs || attr >= &entry->attrs[entry->count]) {
+		return 0;
+	}
+
+	return entry->start + (attr - entry->attrs);
+}
+
+#if defined(CONFIG_BT_GATT_DYNAMIC_DB)
+static void db_index_insert(const struct bt_gatt_service *svc)
+{
+	uint16_t pos;
+
+	if (!db_index_valid) {
+		return;
+	}
+
+	if (db_index_len == ARRAY_SIZE(db_index)) {
+		BT_WARN("Too many services for the database index");
+		db_index_valid = false;
+		return;
+	}
+
+	for (pos = db_index_len; pos > db_index_static_len; pos--) {
+		if (db_index[pos - 1].start < svc->attrs[0].handle) {
+			break;
+		}
+	}
+
+	memmove(&db_index[pos + 1], &db_index[pos],
+		(db_index_len - pos) * sizeof(db_index[0]));
+	db_index_entry_init(&db_index[pos], svc->attrs, svc->attr_count,
+			    svc->attrs[0].handle);
+	db_index_len++;
+}
+
+static void db_index_remove(const struct bt_gatt_service *svc)
+{
+	for (uint16_t pos = db_index_static_len; pos < db_index_len; pos++) {
+		if (db_index[pos].attrs == svc->attrs) {
+			db_index_len--;
+			memmove(&db_index[pos], &db_index[pos + 1],
+				(db_index_len - pos) * sizeof(db_index[0]));
+			return;
+		}
+	}
+}
+#endif /* CONFIG_BT_GATT_DYNAMIC_DB */
+#endif /* CONFIG_BT_GATT_DB_INDEX */
+
 #if defined(CONFIG_BT_GATT_DYNAMIC_DB)
 static uint8_t found_attr(const struct bt_gatt_attr *attr, uint16_t handle,
 			  void *user_data)
@@ -940,6 +1109,10 @@ populate:
 
 	gatt_insert(svc, last_handle);
 
+#if defined(CONFIG_BT_GATT_DB_INDEX)
+	db_index_insert(svc);
+#endif
+
 	return 0;
 }
 #endif /* CONFIG_BT_GATT_DYNAMIC_DB */
@@ -1097,6 +1270,10 @@ static void bt_gatt_service_init(void)
 	Z_STRUCT_SECTION_FOREACH(bt_gatt_service_static, svc) {
 		last_static_handle += svc->attr_count;
 	}
+
+#if defined(CONFIG_BT_GATT_DB_INDEX)
+	db_index_init();
+#endif
 }
 
 void bt_gatt_init(void)
@@ -1237,6 +1414,10 @@ static int gatt_unregister(struct bt_gatt_service *svc)
 		return -ENOENT;
 	}
 
+#if defined(CONFIG_BT_GATT_DB_INDEX)
+	db_index_remove(svc);
+#endif
+
 	for (uint16_t i = 0; i < svc->attr_count; i++) {
 		struct bt_gatt_attr *attr = &svc->attrs[i];
 
@@ -1391,6 +1572,12 @@ uint16_t bt_gatt_attr_get_handle(const struct bt_gatt_attr *attr)
 		return attr->handle;
 	}
 
+#if defined(CONFIG_BT_GATT_DB_INDEX)
+	if (db_index_valid) {
+		return db_index_static_handle(attr);
+	}
+#endif
+
 	Z_STRUCT_SECTION_FOREACH(bt_gatt_service_static, static_svc) {
 		/* Skip ahead if start is not within service attributes array */
 		if ((attr < &static_svc->attrs[0]) ||
@@ -1573,6 +1760,49 @@ static void foreach_attr_type_dyndb(uint16_t start_handle, uint16_t end_handle,
 #endif /* CONFIG_BT_GATT_DYNAMIC_DB */
 }
 
+#if defined(CONFIG_BT_GATT_DB_INDEX)
+static void foreach_attr_type_index(uint16_t start_handle, uint16_t end_handle,
+				    const struct bt_uuid *uuid,
+				    const void *attr_data, uint16_t num_matches,
+				    bt_gatt_attr_func_t func, void *user_data)
+{
+	/* Only the first attribute of a service can match its declaration */
+	bool svc_uuid = uuid && is_svc_decl(uuid);
+
+	for (uint16_t pos = db_index_find(start_handle); pos < db_index_len;
+	     pos++) {
+		const struct db_index_entry *entry = &db_index[pos];
+		uint16_t count = entry->count;
+		uint16_t i = 0;
+
+		if (entry->start > end_handle) {
+			return;
+		}
+
+		if (entry->contiguous && start_handle > entry->start) {
+			i = start_handle - entry->start;
+		}
+
+		if (svc_uuid && entry->single_svc) {
+			count = MIN(count, 1);
+		}
+
+		for (; i < count; i++) {
+			const struct bt_gatt_attr *attr = &entry->attrs[i];
+			uint16_t handle = entry->contiguous ?
+					  entry->start + i : attr->handle;
+
+			if (gatt_foreach_iter(attr, handle, start_handle,
+					      end_handle, uuid, attr_data,
+					      &num_matches, func, user_data) ==
+			    BT_GATT_ITER_STOP) {
+				return;
+			}
+		}
+	}
+}
+#endif /* CONFIG_BT_GATT_DB_INDEX */
+
 void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 			       const struct bt_uuid *uuid,
 			       const void *attr_data, uint16_t num_matches,
@@ -1584,6 +1814,15 @@ void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 		num_matches = UINT16_MAX;
 	}
 
+#if defined(CONFIG_BT_GATT_DB_INDEX)
+	if (db_index_valid) {
+		foreach_attr_type_index(start_handle, end_handle, uuid,
+					attr_data, num_matches, func,
+					user_data);
+		return;
+	}
+#endif
+
 	if (start_handle <= last_static_handle) {
 		uint16_t handle = 1;
 
@@ -2407,6 +2646,15 @@ uint16_t bt_gatt_get_mtu(struct bt_conn *conn)
 	return bt_att_get_mtu(conn);
 }
 
+#if defined(CONFIG_BT_EATT_STATS)
+void bt_gatt_bearer_stats_foreach(struct bt_conn *conn,
+				  bt_gatt_bearer_stats_func_t func,
+				  void *user_data)
+{
+	bt_att_stats_foreach(conn, func, user_data);
+}
+#endif /* CONFIG_BT_EATT_STATS */
+
 uint8_t bt_gatt_check_perm(struct bt_conn *conn, const struct bt_gatt_attr *attr,
 			uint8_t mask)
 {
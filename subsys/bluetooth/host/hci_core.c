@@ -442,7 +442,7 @@ static void hci_num_completed_packets(struct net_buf *buf)
 			if (conn->pending_no_cb) {
 				conn->pending_no_cb--;
 				irq_unlock(key);
-				k_sem_give(bt_conn_get_pkts(conn));
+				bt_conn_pkt_done(conn);
 				continue;
 			}
 
@@ -463,7 +463,7 @@ static void hci_num_completed_packets(struct net_buf *buf)
 			irq_unlock(key);
 
 			k_work_submit(&conn->tx_complete_work);
-			k_sem_give(bt_conn_get_pkts(conn));
+			bt_conn_pkt_done(conn);
 		}
 
 		bt_conn_unref(conn);
@@ -67,10 +67,35 @@ NET_BUF_POOL_FIXED_DEFINE(disc_pool, 1,
 
 struct data_sent {
 	uint16_t len;
+	/* Segments refer to data of the buffer which was pulled */
+	bool sliced;
 };
 
 #define data_sent(buf) ((struct data_sent *)net_buf_user_data(buf))
 
+#if defined(CONFIG_BT_L2CAP_SEG_ZERO_COPY)
+static void seg_slice_destroy(struct net_buf *buf);
+
+/* Headers of the segments referring to SDU data */
+NET_BUF_POOL_FIXED_DEFINE(seg_hdr_pool, CONFIG_BT_L2CAP_SEG_SLICE_COUNT,
+			  BT_L2CAP_CHAN_SEND_RESERVE + BT_L2CAP_SDU_HDR_SIZE,
+			  NULL);
+
+/* Buffers referring to SDU data, which keep a reference to the SDU buffer */
+NET_BUF_POOL_FIXED_DEFINE(seg_slice_pool, CONFIG_BT_L2CAP_SEG_SLICE_COUNT, 0,
+			  seg_slice_destroy);
+
+#define slice_parent(buf) (*(struct net_buf **)net_buf_user_data(buf))
+
+static void seg_slice_destroy(struct net_buf *buf)
+{
+	struct net_buf *parent = slice_parent(buf);
+
+	net_buf_destroy(buf);
+	net_buf_unref(parent);
+}
+#endif /* CONFIG_BT_L2CAP_SEG_ZERO_COPY */
+
 static sys_slist_t servers;
 
 #endif /* CONFIG_BT_L2CAP_DYNAMIC_CHANNEL */
@@ -607,7 +632,7 @@ int bt_l2cap_send_cb(struct bt_conn *conn, uint16_t cid, struct net_buf *buf,
 	BT_DBG("conn %p cid %u len %zu", conn, cid, net_buf_frags_len(buf));
 
 	hdr = net_buf_push(buf, sizeof(*hdr));
-	hdr->len = sys_cpu_to_le16(buf->len - sizeof(*hdr));
+	hdr->len = sys_cpu_to_le16(net_buf_frags_len(buf) - sizeof(*hdr));
 	hdr->cid = sys_cpu_to_le16(cid);
 
 	return bt_conn_send_cb(conn, buf, cb, user_data);
@@ -1630,6 +1655,62 @@ static inline struct net_buf *l2cap_alloc_seg(struct net_buf *buf)
 	return bt_l2cap_create_pdu_timeout(NULL, 0, K_NO_WAIT);
 }
 
+#if defined(CONFIG_BT_L2CAP_SEG_ZERO_COPY)
+static uint16_t l2cap_acl_mtu(void)
+{
+#if defined(CONFIG_BT_BREDR)
+	if (!bt_dev.le.acl_mtu) {
+		return bt_dev.br.mtu;
+	}
+#endif /* CONFIG_BT_BREDR */
+	return bt_dev.le.acl_mtu;
+}
+
+/* A segment which does not fit in an ACL packet is copied into the ACL
+ * packets by the connection anyway, so it refers to the data of the SDU
+ * instead of getting a copy of its own.
+ */
+static struct net_buf *l2cap_slice_seg(struct bt_l2cap_le_chan *ch,
+				       struct net_buf *buf,
+				       size_t sdu_hdr_len)
+{
+	struct net_buf *seg, *slice;
+	uint16_t len;
+
+	len = MIN(buf->len, ch->tx.mps - sdu_hdr_len);
+	if (BT_L2CAP_HDR_SIZE + sdu_hdr_len + len <= l2cap_acl_mtu()) {
+		return NULL;
+	}
+
+	seg = net_buf_alloc(&seg_hdr_pool, K_NO_WAIT);
+	if (!seg) {
+		return NULL;
+	}
+
+	slice = net_buf_alloc_with_data(&seg_slice_pool, buf->data, len,
+					K_NO_WAIT);
+	if (!slice) {
+		net_buf_unref(seg);
+		return NULL;
+	}
+
+	slice_parent(slice) = net_buf_ref(buf);
+
+	net_buf_reserve(seg, BT_L2CAP_CHAN_SEND_RESERVE);
+	if (sdu_hdr_len) {
+		net_buf_add_le16(seg, net_buf_frags_len(buf));
+	}
+
+	net_buf_frag_add(seg, slice);
+	net_buf_pull(buf, len);
+	data_sent(buf)->sliced = true;
+
+	BT_DBG("ch %p seg %p slice %p len %u", ch, seg, slice, len);
+
+	return seg;
+}
+#endif /* CONFIG_BT_L2CAP_SEG_ZERO_COPY */
+
 static struct net_buf *l2cap_chan_create_seg(struct bt_l2cap_le_chan *ch,
 					     struct net_buf *buf,
 					     size_t sdu_hdr_len)
@@ -1646,9 +1727,11 @@ static struct net_buf *l2cap_chan_create_seg(struct bt_l2cap_le_chan *ch,
 	headroom = BT_L2CAP_CHAN_SEND_RESERVE + sdu_hdr_len;
 
 	/* Check if original buffer has enough headroom and don't have any
-	 * fragments.
+	 * fragments. The headroom of a buffer that segments refer to is still
+	 * in use by them.
 	 */
-	if (net_buf_headroom(buf) >= headroom && !buf->frags) {
+	if (net_buf_headroom(buf) >= headroom && !buf->frags &&
+	    !data_sent(buf)->sliced) {
 		if (sdu_hdr_len) {
 			/* Push SDU length if set */
 			net_buf_push_le16(buf, net_buf_frags_len(buf));
@@ -1657,6 +1740,13 @@ static struct net_buf *l2cap_chan_create_seg(struct bt_l2cap_le_chan *ch,
 	}
 
 segment:
+#if defined(CONFIG_BT_L2CAP_SEG_ZERO_COPY)
+	seg = l2cap_slice_seg(ch, buf, sdu_hdr_len);
+	if (seg) {
+		return seg;
+	}
+#endif /* CONFIG_BT_L2CAP_SEG_ZERO_COPY */
+
 	seg = l2cap_alloc_seg(buf);
 	if (!seg) {
 		return NULL;
@@ -1771,10 +1861,10 @@ static int l2cap_chan_le_send(struct bt_l2cap_le_chan *ch,
 		return -EAGAIN;
 	}
 
-	BT_DBG("ch %p cid 0x%04x len %u credits %u", ch, ch->tx.cid,
-	       seg->len, atomic_get(&ch->tx.credits));
+	len = net_buf_frags_len(seg) - sdu_hdr_len;
 
-	len = seg->len - sdu_hdr_len;
+	BT_DBG("ch %p cid 0x%04x len %u credits %u", ch, ch->tx.cid,
+	       len, atomic_get(&ch->tx.credits));
 
 	/* Set a callback if there is no data left in the buffer and sent
 	 * callback has been set.
@@ -1840,6 +1930,8 @@ static int l2cap_chan_le_send_sdu(struct bt_l2cap_le_chan *ch,
 	}
 
 	if (!sent) {
+		data_sent(frag)->sliced = false;
+
 		/* Add SDU length for the first segment */
 		ret = l2cap_chan_le_send(ch, frag, BT_L2CAP_SDU_HDR_SIZE);
 		if (ret < 0) {
@@ -1858,6 +1950,7 @@ static int l2cap_chan_le_send_sdu(struct bt_l2cap_le_chan *ch,
 		/* Proceed to next fragment */
 		if (!frag->len) {
 			frag = net_buf_frag_del(NULL, frag);
+			data_sent(frag)->sliced = false;
 		}
 
 		ret = l2cap_chan_le_send(ch, frag, 0);
@@ -2196,13 +2289,18 @@ static void l2cap_chan_le_recv_seg(struct bt_l2cap_le_chan *chan,
 
 	BT_DBG("chan %p seg %d len %zu", chan, seg, net_buf_frags_len(buf));
 
-	/* Append received segment to SDU */
-	len = net_buf_append_bytes(chan->_sdu, buf->len, buf->data, K_NO_WAIT,
-				   l2cap_alloc_frag, chan);
-	if (len != buf->len) {
-		BT_ERR("Unable to store SDU");
-		bt_l2cap_chan_disconnect(&chan->chan);
-		return;
+	if (IS_ENABLED(CONFIG_BT_L2CAP_SEG_ZERO_COPY)) {
+		/* Chain the received buffer to the SDU */
+		net_buf_frag_add(chan->_sdu, net_buf_ref(buf));
+	} else {
+		/* Append received segment to SDU */
+		len = net_buf_append_bytes(chan->_sdu, buf->len, buf->data,
+					   K_NO_WAIT, l2cap_alloc_frag, chan);
+		if (len != buf->len) {
+			BT_ERR("Unable to store SDU");
+			bt_l2cap_chan_disconnect(&chan->chan);
+			return;
+		}
 	}
 
 	if (net_buf_frags_len(chan->_sdu) < chan->_sdu_len) {
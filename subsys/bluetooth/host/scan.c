@@ -8,6 +8,7 @@
 
 #include <sys/byteorder.h>
 #include <sys/check.h>
+#include <sys/fnv1a.h>
 
 #include <bluetooth/bluetooth.h>
 #include <bluetooth/iso.h>
@@ -391,12 +392,136 @@ static uint8_t get_adv_props(uint8_t evt_type)
 	}
 }
 
+#if defined(CONFIG_BT_SCAN_DEDUP)
+/* Duplicate filter, with each report hashed to one entry */
+static struct {
+	uint32_t hash;
+	uint32_t timestamp;
+} scan_dedup[CONFIG_BT_SCAN_DEDUP_SIZE];
+
+static bool scan_dedup_check(const bt_addr_le_t *addr,
+			     const struct bt_le_scan_recv_info *info,
+			     const uint8_t *data, uint8_t len)
+{
+	uint32_t now = k_uptime_get_32();
+	uint32_t hash;
+	int i;
+
+	hash = fnv1a_32_update(FNV1A_32_INIT, addr, sizeof(*addr));
+	hash = fnv1a_32_update(hash, &info->adv_props,
+			       sizeof(info->adv_props));
+	hash = fnv1a_32_update(hash, data, len);
+
+	i = hash % ARRAY_SIZE(scan_dedup);
+
+	if (scan_dedup[i].hash == hash &&
+	    (now - scan_dedup[i].timestamp) < CONFIG_BT_SCAN_DEDUP_TIMEOUT) {
+		return true;
+	}
+
+	scan_dedup[i].hash = hash;
+	scan_dedup[i].timestamp = now;
+
+	return false;
+}
+
+static void scan_dedup_reset(void)
+{
+	(void)memset(scan_dedup, 0, sizeof(scan_dedup));
+}
+#endif /* CONFIG_BT_SCAN_DEDUP */
+
+#if defined(CONFIG_BT_SCAN_FILTER)
+/* What a report contains, for matching against listener filters */
+struct scan_report_info {
+	uint32_t ad_types[8];
+	const uint8_t *uuid16;
+	uint8_t uuid16_len;
+	uint16_t company_id;
+	bool has_company_id;
+};
+
+static void scan_report_parse(const uint8_t *data, uint8_t len,
+			      struct scan_report_info *report)
+{
+	(void)memset(report, 0, sizeof(*report));
+
+	while (len > 1) {
+		uint8_t field_len = data[0];
+		uint8_t type = data[1];
+
+		/* Check for early termination or malformed data */
+		if (field_len == 0U || field_len >= len) {
+			return;
+		}
+
+		report->ad_types[type / 32] |= BIT(type % 32);
+
+		switch (type) {
+		case BT_DATA_UUID16_SOME:
+		case BT_DATA_UUID16_ALL:
+			report->uuid16 = &data[2];
+			report->uuid16_len = field_len - 1;
+			break;
+		case BT_DATA_MANUFACTURER_DATA:
+			if (field_len >= 3) {
+				report->company_id = sys_get_le16(&data[2]);
+				report->has_company_id = true;
+			}
+			break;
+		default:
+			break;
+		}
+
+		data += field_len + 1;
+		len -= field_len + 1;
+	}
+}
+
+static bool scan_filter_match(const struct bt_le_scan_filter *filter,
+			      const struct scan_report_info *report)
+{
+	if ((filter->options & BT_LE_SCAN_FILTER_AD_TYPE) &&
+	    !(report->ad_types[filter->ad_type / 32] &
+	      BIT(filter->ad_type % 32))) {
+		return false;
+	}
+
+	if (filter->options & BT_LE_SCAN_FILTER_UUID16) {
+		uint8_t i;
+
+		for (i = 0U; i + 1 < report->uuid16_len; i += 2) {
+			if (sys_get_le16(&report->uuid16[i]) ==
+			    filter->uuid16) {
+				break;
+			}
+		}
+
+		if (i + 1 >= report->uuid16_len) {
+			return false;
+		}
+	}
+
+	if ((filter->options & BT_LE_SCAN_FILTER_COMPANY_ID) &&
+	    (!report->has_company_id ||
+	     report->company_id != filter->company_id)) {
+		return false;
+	}
+
+	return true;
+}
+#endif /* CONFIG_BT_SCAN_FILTER */
+
 static void le_adv_recv(bt_addr_le_t *addr, struct bt_le_scan_recv_info *info,
 			struct net_buf *buf, uint8_t len)
 {
 	struct bt_le_scan_cb *listener, *next;
 	struct net_buf_simple_state state;
 	bt_addr_le_t id_addr;
+#if defined(CONFIG_BT_SCAN_FILTER)
+	struct scan_report_info report;
+	bool parsed = false;
+#endif /* CONFIG_BT_SCAN_FILTER */
 
 	BT_DBG("%s event %u, len %u, rssi %d dBm", bt_addr_le_str(addr),
 	       info->adv_type, len, info->rssi);
@@ -422,6 +547,17 @@ static void le_adv_recv(bt_addr_le_t *addr, struct bt_le_scan_recv_info *info,
 
 	info->addr = &id_addr;
 
+#if defined(CONFIG_BT_SCAN_DEDUP)
+	if (atomic_test_bit(bt_dev.flags, BT_DEV_SCAN_FILTER_DUP) &&
+	    scan_dedup_check(addr, info, buf->data, len)) {
+		BT_DBG("Dropped duplicate adv report");
+#if defined(CONFIG_BT_CENTRAL)
+		check_pending_conn(&id_addr, addr, info->adv_props);
+#endif /* CONFIG_BT_CENTRAL */
+		return;
+	}
+#endif /* CONFIG_BT_SCAN_DEDUP */
+
 	if (scan_dev_found_cb) {
 		net_buf_simple_save(&buf->b, &state);
 
@@ -433,6 +569,19 @@ static void le_adv_recv(bt_addr_le_t *addr, struct bt_le_scan_recv_info *info,
 	}
 
 	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&scan_cbs, listener, next, node) {
+#if defined(CONFIG_BT_SCAN_FILTER)
+		if (listener->recv && listener->filter) {
+			if (!parsed) {
+				scan_report_parse(buf->data, len, &report);
+				parsed = true;
+			}
+
+			if (!scan_filter_match(listener->filter, &report)) {
+				continue;
+			}
+		}
+#endif /* CONFIG_BT_SCAN_FILTER */
+
 		if (listener->recv) {
 			net_buf_simple_save(&buf->b, &state);
 
@@ -989,6 +1138,10 @@ int bt_le_scan_start(const struct bt_le_scan_param *param, bt_le_scan_cb_t cb)
 	atomic_set_bit_to(bt_dev.flags, BT_DEV_SCAN_FILTER_DUP,
 			  param->options & BT_LE_SCAN_OPT_FILTER_DUPLICATE);
 
+#if defined(CONFIG_BT_SCAN_DEDUP)
+	scan_dedup_reset();
+#endif /* CONFIG_BT_SCAN_DEDUP */
+
 #if defined(CONFIG_BT_WHITELIST)
 	atomic_set_bit_to(bt_dev.flags, BT_DEV_SCAN_WL,
 			  param->options & BT_LE_SCAN_OPT_FILTER_WHITELIST);
@@ -40,6 +40,9 @@ const uint8_t bt_mesh_adv_type[BT_MESH_ADV_TYPES] = {
 };
 
 K_FIFO_DEFINE(bt_mesh_adv_queue);
+#if defined(CONFIG_BT_MESH_ADV_EXT)
+K_FIFO_DEFINE(bt_mesh_relay_queue);
+#endif
 
 static void adv_buf_destroy(struct net_buf *buf)
 {
@@ -96,6 +99,18 @@ struct net_buf *bt_mesh_adv_create(enum bt_mesh_adv_type type, uint8_t xmit,
 					    xmit, timeout);
 }
 
+struct net_buf *bt_mesh_adv_relay_create(uint8_t xmit, k_timeout_t timeout)
+{
+	struct net_buf *buf;
+
+	buf = bt_mesh_adv_create(BT_MESH_ADV_DATA, xmit, timeout);
+	if (buf) {
+		BT_MESH_ADV(buf)->relay = 1U;
+	}
+
+	return buf;
+}
+
 void bt_mesh_adv_send(struct net_buf *buf, const struct bt_mesh_send_cb *cb,
 		      void *cb_data)
 {
@@ -106,6 +121,14 @@ void bt_mesh_adv_send(struct net_buf *buf, const struct bt_mesh_send_cb *cb,
 	BT_MESH_ADV(buf)->cb_data = cb_data;
 	BT_MESH_ADV(buf)->busy = 1U;
 
+#if defined(CONFIG_BT_MESH_ADV_EXT)
+	if (BT_MESH_ADV(buf)->relay) {
+		net_buf_put(&bt_mesh_relay_queue, net_buf_ref(buf));
+		bt_mesh_adv_buf_ready();
+		return;
+	}
+#endif
+
 	net_buf_put(&bt_mesh_adv_queue, net_buf_ref(buf));
 	bt_mesh_adv_buf_ready();
 }
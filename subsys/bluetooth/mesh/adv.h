@@ -36,7 +36,8 @@ struct bt_mesh_adv {
 
 	uint8_t      type:2,
 		  started:1,
-		  busy:1;
+		  busy:1,
+		  relay:1;
 
 	uint8_t      xmit;
 };
@@ -44,6 +45,7 @@ struct bt_mesh_adv {
 typedef struct bt_mesh_adv *(*bt_mesh_adv_alloc_t)(int id);
 
 extern struct k_fifo bt_mesh_adv_queue;
+extern struct k_fifo bt_mesh_relay_queue;
 
 /* Lookup table for Advertising data types for bt_mesh_adv_type: */
 extern const uint8_t bt_mesh_adv_type[BT_MESH_ADV_TYPES];
@@ -52,6 +54,11 @@ extern const uint8_t bt_mesh_adv_type[BT_MESH_ADV_TYPES];
 struct net_buf *bt_mesh_adv_create(enum bt_mesh_adv_type type, uint8_t xmit,
 				   k_timeout_t timeout);
 
+/* Create a buffer for a relayed message, which may be sent on a separate
+ * advertising set from locally originated messages.
+ */
+struct net_buf *bt_mesh_adv_relay_create(uint8_t xmit, k_timeout_t timeout);
+
 struct net_buf *bt_mesh_adv_create_from_pool(struct net_buf_pool *pool,
 					     bt_mesh_adv_alloc_t get_id,
 					     enum bt_mesh_adv_type type,
@@ -27,14 +27,23 @@
 /* Convert from ms to 0.625ms units */
 #define ADV_INT_FAST_MS    20
 
-static struct bt_le_adv_param adv_param = {
-	.id = BT_ID_DEFAULT,
-	.interval_min = BT_MESH_ADV_SCAN_UNIT(ADV_INT_FAST_MS),
-	.interval_max = BT_MESH_ADV_SCAN_UNIT(ADV_INT_FAST_MS),
+#if defined(CONFIG_BT_MESH_RELAY_ADV_SETS)
+#define RELAY_ADV_SETS CONFIG_BT_MESH_RELAY_ADV_SETS
+#else
+#define RELAY_ADV_SETS 0
+#endif
+
+/* One set for locally originated messages, optionally followed by sets
+ * dedicated to relayed messages and one for GATT server advertising.
+ */
+#define ADV_SET_COUNT (1 + RELAY_ADV_SETS + \
+		       IS_ENABLED(CONFIG_BT_MESH_ADV_EXT_GATT_SEPARATE))
+
 #if defined(CONFIG_BT_MESH_DEBUG_USE_ID_ADDR)
-	.options = BT_LE_ADV_OPT_USE_IDENTITY,
+#define ADV_OPTIONS BT_LE_ADV_OPT_USE_IDENTITY
+#else
+#define ADV_OPTIONS 0
 #endif
-};
 
 enum {
 	/** Controller is currently advertising */
@@ -52,62 +61,108 @@ enum {
 	ADV_FLAGS_NUM
 };
 
-static struct {
+/* What an advertising set is used for */
+enum {
+	/** Locally originated messages */
+	ADV_TAG_LOCAL = BIT(0),
+	/** Relayed messages */
+	ADV_TAG_RELAY = BIT(1),
+	/** GATT server advertising */
+	ADV_TAG_PROXY = BIT(2),
+};
+
+struct ext_adv {
+	uint8_t tags;
 	ATOMIC_DEFINE(flags, ADV_FLAGS_NUM);
 	struct bt_le_ext_adv *instance;
 	struct net_buf *buf;
 	uint64_t timestamp;
 	struct k_work_delayable work;
-} adv;
+	struct bt_le_adv_param adv_param;
+};
+
+static struct ext_adv adv_sets[ADV_SET_COUNT] = {
+	[0 ... (ADV_SET_COUNT - 1)] = {
+		.adv_param = {
+			.id = BT_ID_DEFAULT,
+			.interval_min = BT_MESH_ADV_SCAN_UNIT(ADV_INT_FAST_MS),
+			.interval_max = BT_MESH_ADV_SCAN_UNIT(ADV_INT_FAST_MS),
+			.options = ADV_OPTIONS,
+		},
+	},
+};
 
-static int adv_start(const struct bt_le_adv_param *param,
+static struct ext_adv *gatt_adv_get(void)
+{
+	if (IS_ENABLED(CONFIG_BT_MESH_ADV_EXT_GATT_SEPARATE)) {
+		return &adv_sets[ADV_SET_COUNT - 1];
+	}
+
+	return &adv_sets[0];
+}
+
+static struct ext_adv *adv_set_find(struct bt_le_ext_adv *instance)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(adv_sets); i++) {
+		if (adv_sets[i].instance == instance) {
+			return &adv_sets[i];
+		}
+	}
+
+	return NULL;
+}
+
+static int adv_start(struct ext_adv *adv,
+		     const struct bt_le_adv_param *param,
 		     struct bt_le_ext_adv_start_param *start,
 		     const struct bt_data *ad, size_t ad_len,
 		     const struct bt_data *sd, size_t sd_len)
 {
 	int err;
 
-	if (!adv.instance) {
+	if (!adv->instance) {
 		BT_ERR("Mesh advertiser not enabled");
 		return -ENODEV;
 	}
 
-	if (atomic_test_and_set_bit(adv.flags, ADV_FLAG_ACTIVE)) {
+	if (atomic_test_and_set_bit(adv->flags, ADV_FLAG_ACTIVE)) {
 		BT_ERR("Advertiser is busy");
 		return -EBUSY;
 	}
 
-	if (atomic_test_bit(adv.flags, ADV_FLAG_UPDATE_PARAMS)) {
-		err = bt_le_ext_adv_update_param(adv.instance, param);
+	if (atomic_test_bit(adv->flags, ADV_FLAG_UPDATE_PARAMS)) {
+		err = bt_le_ext_adv_update_param(adv->instance, param);
 		if (err) {
 			BT_ERR("Failed updating adv params: %d", err);
-			atomic_clear_bit(adv.flags, ADV_FLAG_ACTIVE);
+			atomic_clear_bit(adv->flags, ADV_FLAG_ACTIVE);
 			return err;
 		}
 
-		atomic_set_bit_to(adv.flags, ADV_FLAG_UPDATE_PARAMS,
-				  param != &adv_param);
+		atomic_set_bit_to(adv->flags, ADV_FLAG_UPDATE_PARAMS,
+				  param != &adv->adv_param);
 	}
 
-	err = bt_le_ext_adv_set_data(adv.instance, ad, ad_len, sd, sd_len);
+	err = bt_le_ext_adv_set_data(adv->instance, ad, ad_len, sd, sd_len);
 	if (err) {
 		BT_ERR("Failed setting adv data: %d", err);
-		atomic_clear_bit(adv.flags, ADV_FLAG_ACTIVE);
+		atomic_clear_bit(adv->flags, ADV_FLAG_ACTIVE);
 		return err;
 	}
 
-	adv.timestamp = k_uptime_get();
+	adv->timestamp = k_uptime_get();
 
-	err = bt_le_ext_adv_start(adv.instance, start);
+	err = bt_le_ext_adv_start(adv->instance, start);
 	if (err) {
 		BT_ERR("Advertising failed: err %d", err);
-		atomic_clear_bit(adv.flags, ADV_FLAG_ACTIVE);
+		atomic_clear_bit(adv->flags, ADV_FLAG_ACTIVE);
 	}
 
 	return err;
 }
 
-static int buf_send(struct net_buf *buf)
+static int buf_send(struct ext_adv *adv, struct net_buf *buf)
 {
 	struct bt_le_ext_adv_start_param start = {
 		.num_events =
@@ -133,15 +188,15 @@ static int buf_send(struct net_buf *buf)
 	ad.data = buf->data;
 
 	/* Only update advertising parameters if they're different */
-	if (adv_param.interval_min != BT_MESH_ADV_SCAN_UNIT(adv_int)) {
-		adv_param.interval_min = BT_MESH_ADV_SCAN_UNIT(adv_int);
-		adv_param.interval_max = adv_param.interval_min;
-		atomic_set_bit(adv.flags, ADV_FLAG_UPDATE_PARAMS);
+	if (adv->adv_param.interval_min != BT_MESH_ADV_SCAN_UNIT(adv_int)) {
+		adv->adv_param.interval_min = BT_MESH_ADV_SCAN_UNIT(adv_int);
+		adv->adv_param.interval_max = adv->adv_param.interval_min;
+		atomic_set_bit(adv->flags, ADV_FLAG_UPDATE_PARAMS);
 	}
 
-	err = adv_start(&adv_param, &start, &ad, 1, NULL, 0);
+	err = adv_start(adv, &adv->adv_param, &start, &ad, 1, NULL, 0);
 	if (!err) {
-		adv.buf = net_buf_ref(buf);
+		adv->buf = net_buf_ref(buf);
 	}
 
 	bt_mesh_adv_send_start(duration, err, BT_MESH_ADV(buf));
@@ -149,14 +204,34 @@ static int buf_send(struct net_buf *buf)
 	return err;
 }
 
+/* Locally originated messages take priority over relayed ones on sets
+ * which send both.
+ */
+static struct net_buf *adv_buf_get(struct ext_adv *adv)
+{
+	struct net_buf *buf = NULL;
+
+	if (adv->tags & ADV_TAG_LOCAL) {
+		buf = net_buf_get(&bt_mesh_adv_queue, K_NO_WAIT);
+	}
+
+	if (!buf && (adv->tags & ADV_TAG_RELAY)) {
+		buf = net_buf_get(&bt_mesh_relay_queue, K_NO_WAIT);
+	}
+
+	return buf;
+}
+
 static void send_pending_adv(struct k_work *work)
 {
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct ext_adv *adv = CONTAINER_OF(dwork, struct ext_adv, work);
 	struct net_buf *buf;
 	int err;
 
-	atomic_clear_bit(adv.flags, ADV_FLAG_SCHEDULED);
+	atomic_clear_bit(adv->flags, ADV_FLAG_SCHEDULED);
 
-	while ((buf = net_buf_get(&bt_mesh_adv_queue, K_NO_WAIT))) {
+	while ((buf = adv_buf_get(adv))) {
 		/* busy == 0 means this was canceled */
 		if (!BT_MESH_ADV(buf)->busy) {
 			net_buf_unref(buf);
@@ -164,7 +239,7 @@ static void send_pending_adv(struct k_work *work)
 		}
 
 		BT_MESH_ADV(buf)->busy = 0U;
-		err = buf_send(buf);
+		err = buf_send(adv, buf);
 
 		net_buf_unref(buf);
 
@@ -174,27 +249,28 @@ static void send_pending_adv(struct k_work *work)
 	}
 
 	/* No more pending buffers */
-	if (IS_ENABLED(CONFIG_BT_MESH_GATT_SERVER)) {
+	if (IS_ENABLED(CONFIG_BT_MESH_GATT_SERVER) &&
+	    (adv->tags & ADV_TAG_PROXY)) {
 		BT_DBG("Proxy Advertising");
 		err = bt_mesh_proxy_adv_start();
 		if (!err) {
-			atomic_set_bit(adv.flags, ADV_FLAG_PROXY);
+			atomic_set_bit(adv->flags, ADV_FLAG_PROXY);
 		}
 	}
 }
 
-static void schedule_send(void)
+static void schedule_send(struct ext_adv *adv)
 {
-	uint64_t timestamp = adv.timestamp;
+	uint64_t timestamp = adv->timestamp;
 	int64_t delta;
 
-	if (atomic_test_and_clear_bit(adv.flags, ADV_FLAG_PROXY)) {
-		bt_le_ext_adv_stop(adv.instance);
-		atomic_clear_bit(adv.flags, ADV_FLAG_ACTIVE);
+	if (atomic_test_and_clear_bit(adv->flags, ADV_FLAG_PROXY)) {
+		bt_le_ext_adv_stop(adv->instance);
+		atomic_clear_bit(adv->flags, ADV_FLAG_ACTIVE);
 	}
 
-	if (atomic_test_bit(adv.flags, ADV_FLAG_ACTIVE) ||
-	    atomic_test_and_set_bit(adv.flags, ADV_FLAG_SCHEDULED)) {
+	if (atomic_test_bit(adv->flags, ADV_FLAG_ACTIVE) ||
+	    atomic_test_and_set_bit(adv->flags, ADV_FLAG_SCHEDULED)) {
 		return;
 	}
 
@@ -203,52 +279,92 @@ static void schedule_send(void)
 	 * to the previous packet than what's permitted by the specification.
 	 */
 	delta = k_uptime_delta(&timestamp);
-	k_work_reschedule(&adv.work, K_MSEC(ADV_INT_FAST_MS - delta));
+	k_work_reschedule(&adv->work, K_MSEC(ADV_INT_FAST_MS - delta));
 }
 
 void bt_mesh_adv_update(void)
 {
 	BT_DBG("");
 
-	schedule_send();
+	schedule_send(gatt_adv_get());
 }
 
 void bt_mesh_adv_buf_ready(void)
 {
-	schedule_send();
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(adv_sets); i++) {
+		struct ext_adv *adv = &adv_sets[i];
+
+		if (!(adv->tags & (ADV_TAG_LOCAL | ADV_TAG_RELAY))) {
+			continue;
+		}
+
+		/* Don't interrupt proxy advertising for a relayed message if
+		 * there are sets dedicated to relaying.
+		 */
+		if (RELAY_ADV_SETS && (adv->tags & ADV_TAG_PROXY) &&
+		    atomic_test_bit(adv->flags, ADV_FLAG_PROXY) &&
+		    k_fifo_is_empty(&bt_mesh_adv_queue)) {
+			continue;
+		}
+
+		schedule_send(adv);
+	}
 }
 
 void bt_mesh_adv_init(void)
 {
-	k_work_init_delayable(&adv.work, send_pending_adv);
+	int i;
+
+	adv_sets[0].tags = ADV_TAG_LOCAL | ADV_TAG_RELAY;
+
+	for (i = 1; i <= RELAY_ADV_SETS; i++) {
+		adv_sets[i].tags = ADV_TAG_RELAY;
+	}
+
+	gatt_adv_get()->tags |= ADV_TAG_PROXY;
+
+	for (i = 0; i < ARRAY_SIZE(adv_sets); i++) {
+		k_work_init_delayable(&adv_sets[i].work, send_pending_adv);
+	}
 }
 
 static void adv_sent(struct bt_le_ext_adv *instance,
 		     struct bt_le_ext_adv_sent_info *info)
 {
+	struct ext_adv *adv = adv_set_find(instance);
+	int64_t duration;
+
+	if (!adv) {
+		return;
+	}
+
 	/* Calling k_uptime_delta on a timestamp moves it to the current time.
 	 * This is essential here, as schedule_send() uses the end of the event
 	 * as a reference to avoid sending the next advertisement too soon.
 	 */
-	int64_t duration = k_uptime_delta(&adv.timestamp);
+	duration = k_uptime_delta(&adv->timestamp);
 
 	BT_DBG("Advertising stopped after %u ms", (uint32_t)duration);
 
-	atomic_clear_bit(adv.flags, ADV_FLAG_ACTIVE);
+	atomic_clear_bit(adv->flags, ADV_FLAG_ACTIVE);
 
-	if (!atomic_test_and_clear_bit(adv.flags, ADV_FLAG_PROXY)) {
-		net_buf_unref(adv.buf);
+	if (!atomic_test_and_clear_bit(adv->flags, ADV_FLAG_PROXY)) {
+		net_buf_unref(adv->buf);
 	}
 
-	schedule_send();
+	schedule_send(adv);
 }
 
 static void connected(struct bt_le_ext_adv *instance,
 		      struct bt_le_ext_adv_connected_info *info)
 {
-	if (atomic_test_and_clear_bit(adv.flags, ADV_FLAG_PROXY)) {
-		atomic_clear_bit(adv.flags, ADV_FLAG_ACTIVE);
-		schedule_send();
+	struct ext_adv *adv = adv_set_find(instance);
+
+	if (adv && atomic_test_and_clear_bit(adv->flags, ADV_FLAG_PROXY)) {
+		atomic_clear_bit(adv->flags, ADV_FLAG_ACTIVE);
+		schedule_send(adv);
 	}
 }
 
@@ -258,19 +374,31 @@ int bt_mesh_adv_enable(void)
 		.sent = adv_sent,
 		.connected = connected,
 	};
+	int err;
+	int i;
 
-	if (adv.instance) {
+	if (adv_sets[0].instance) {
 		/* Already initialized */
 		return 0;
 	}
 
-	return bt_le_ext_adv_create(&adv_param, &adv_cb, &adv.instance);
+	for (i = 0; i < ARRAY_SIZE(adv_sets); i++) {
+		err = bt_le_ext_adv_create(&adv_sets[i].adv_param, &adv_cb,
+					   &adv_sets[i].instance);
+		if (err) {
+			BT_ERR("Failed creating adv set %d: %d", i, err);
+			return err;
+		}
+	}
+
+	return 0;
 }
 
 int bt_mesh_adv_start(const struct bt_le_adv_param *param, int32_t duration,
 		      const struct bt_data *ad, size_t ad_len,
 		      const struct bt_data *sd, size_t sd_len)
 {
+	struct ext_adv *adv = gatt_adv_get();
 	struct bt_le_ext_adv_start_param start = {
 		/* Timeout is set in 10 ms steps, with 0 indicating "forever" */
 		.timeout = (duration == SYS_FOREVER_MS) ? 0 : (duration / 10),
@@ -278,7 +406,7 @@ int bt_mesh_adv_start(const struct bt_le_adv_param *param, int32_t duration,
 
 	BT_DBG("Start advertising %d ms", duration);
 
-	atomic_set_bit(adv.flags, ADV_FLAG_UPDATE_PARAMS);
+	atomic_set_bit(adv->flags, ADV_FLAG_UPDATE_PARAMS);
 
-	return adv_start(param, &start, ad, ad_len, sd, sd_len);
+	return adv_start(adv, param, &start, ad, ad_len, sd, sd_len);
 }
@@ -116,13 +116,110 @@ static bool check_dup(struct net_buf_simple *data)
 	return false;
 }
 
-static bool msg_cache_match(struct net_buf_simple *pdu)
+#if defined(CONFIG_BT_MESH_MSG_CACHE_BLOOM)
+/* Counting bloom filter over the entries of the message cache. Evicted
+ * entries are removed from the filter, so a miss in the filter means the
+ * message is not in the cache. A counter which has saturated can't be
+ * decremented any more, so the filter is rebuilt the next time the cache
+ * wraps around.
+ */
+static uint8_t msg_cache_bloom[CONFIG_BT_MESH_MSG_CACHE_BLOOM_SIZE];
+static bool msg_cache_bloom_stale;
+
+static inline uint32_t msg_cache_key(uint16_t src, uint32_t seq)
+{
+	return ((uint32_t)src << 17) | (seq & BIT_MASK(17));
+}
+
+static inline uint16_t msg_cache_bloom_idx(uint32_t key, int i)
+{
+	static const uint32_t mul[] = { 0x9e3779b1, 0x85ebca6b };
+
+	return ((key * mul[i]) >> 16) % ARRAY_SIZE(msg_cache_bloom);
+}
+
+static bool msg_cache_bloom_test(uint32_t key)
+{
+	int i;
+
+	for (i = 0; i < 2; i++) {
+		if (!msg_cache_bloom[msg_cache_bloom_idx(key, i)]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void msg_cache_bloom_add(uint32_t key)
+{
+	uint8_t *cnt;
+	int i;
+
+	for (i = 0; i < 2; i++) {
+		cnt = &msg_cache_bloom[msg_cache_bloom_idx(key, i)];
+		if (*cnt == UINT8_MAX) {
+			msg_cache_bloom_stale = true;
+		} else {
+			(*cnt)++;
+		}
+	}
+}
+
+static void msg_cache_bloom_del(uint32_t key)
+{
+	uint8_t *cnt;
+	int i;
+
+	for (i = 0; i < 2; i++) {
+		cnt = &msg_cache_bloom[msg_cache_bloom_idx(key, i)];
+		if (*cnt && *cnt != UINT8_MAX) {
+			(*cnt)--;
+		}
+	}
+}
+
+static void msg_cache_bloom_rebuild(void)
 {
 	uint16_t i;
 
+	(void)memset(msg_cache_bloom, 0, sizeof(msg_cache_bloom));
+	msg_cache_bloom_stale = false;
+
 	for (i = 0U; i < ARRAY_SIZE(msg_cache); i++) {
-		if (msg_cache[i].src == SRC(pdu->data) &&
-		    msg_cache[i].seq == (SEQ(pdu->data) & BIT_MASK(17))) {
+		if (msg_cache[i].src) {
+			msg_cache_bloom_add(msg_cache_key(msg_cache[i].src,
+							  msg_cache[i].seq));
+		}
+	}
+}
+#endif /* CONFIG_BT_MESH_MSG_CACHE_BLOOM */
+
+static struct bt_mesh_msg_cache_stats msg_cache_stats;
+
+static bool msg_cache_match(struct net_buf_simple *pdu)
+{
+	uint16_t src = SRC(pdu->data);
+	uint32_t seq = SEQ(pdu->data) & BIT_MASK(17);
+	uint16_t i, n;
+
+	msg_cache_stats.lookups++;
+
+#if defined(CONFIG_BT_MESH_MSG_CACHE_BLOOM)
+	if (!msg_cache_bloom_test(msg_cache_key(src, seq))) {
+		msg_cache_stats.filtered++;
+		return false;
+	}
+#endif
+
+	/* Duplicates are usually relays of a message we've just seen, so
+	 * start with the most recently added entry.
+	 */
+	for (n = 0U, i = msg_cache_next; n < ARRAY_SIZE(msg_cache); n++) {
+		i = (i ? i : ARRAY_SIZE(msg_cache)) - 1;
+
+		if (msg_cache[i].src == src && msg_cache[i].seq == seq) {
+			msg_cache_stats.hits++;
 			return true;
 		}
 	}
@@ -130,12 +227,57 @@ static bool msg_cache_match(struct net_buf_simple *pdu)
 	return false;
 }
 
+static void msg_cache_del(uint16_t idx)
+{
+#if defined(CONFIG_BT_MESH_MSG_CACHE_BLOOM)
+	if (msg_cache[idx].src) {
+		msg_cache_bloom_del(msg_cache_key(msg_cache[idx].src,
+						  msg_cache[idx].seq));
+	}
+#endif
+
+	msg_cache[idx].src = BT_MESH_ADDR_UNASSIGNED;
+}
+
 static void msg_cache_add(struct bt_mesh_net_rx *rx)
 {
 	rx->msg_cache_idx = msg_cache_next++;
+
+	/* Evict the oldest entry */
+	msg_cache_del(rx->msg_cache_idx);
+
 	msg_cache[rx->msg_cache_idx].src = rx->ctx.addr;
 	msg_cache[rx->msg_cache_idx].seq = rx->seq;
 	msg_cache_next %= ARRAY_SIZE(msg_cache);
+
+#if defined(CONFIG_BT_MESH_MSG_CACHE_BLOOM)
+	msg_cache_bloom_add(msg_cache_key(rx->ctx.addr, rx->seq));
+
+	if (!msg_cache_next && msg_cache_bloom_stale) {
+		msg_cache_bloom_rebuild();
+	}
+#endif
+}
+
+static void msg_cache_reset(void)
+{
+	(void)memset(msg_cache, 0, sizeof(msg_cache));
+	msg_cache_next = 0U;
+
+#if defined(CONFIG_BT_MESH_MSG_CACHE_BLOOM)
+	(void)memset(msg_cache_bloom, 0, sizeof(msg_cache_bloom));
+	msg_cache_bloom_stale = false;
+#endif
+}
+
+void bt_mesh_net_msg_cache_stats(struct bt_mesh_msg_cache_stats *stats,
+				 bool reset)
+{
+	*stats = msg_cache_stats;
+
+	if (reset) {
+		(void)memset(&msg_cache_stats, 0, sizeof(msg_cache_stats));
+	}
 }
 
 static void store_iv(bool only_duration)
@@ -178,8 +320,7 @@ int bt_mesh_net_create(uint16_t idx, uint8_t flags, const uint8_t key[16],
 		return err;
 	}
 
-	(void)memset(msg_cache, 0, sizeof(msg_cache));
-	msg_cache_next = 0U;
+	msg_cache_reset();
 
 	bt_mesh.iv_index = iv_index;
 	atomic_set_bit_to(bt_mesh.flags, BT_MESH_IVU_IN_PROGRESS,
@@ -665,7 +806,7 @@ static void bt_mesh_net_relay(struct net_buf_simple *sbuf,
 		transmit = bt_mesh_net_transmit_get();
 	}
 
-	buf = bt_mesh_adv_create(BT_MESH_ADV_DATA, transmit, K_NO_WAIT);
+	buf = bt_mesh_adv_relay_create(transmit, K_NO_WAIT);
 	if (!buf) {
 		BT_ERR("Out of relay buffers");
 		return;
@@ -828,7 +969,7 @@ void bt_mesh_net_recv(struct net_buf_simple *data, int8_t rssi,
 	 */
 	if (bt_mesh_trans_recv(&buf, &rx) == -EAGAIN) {
 		BT_WARN("Removing rejected message from Network Message Cache");
-		msg_cache[rx.msg_cache_idx].src = BT_MESH_ADDR_UNASSIGNED;
+		msg_cache_del(rx.msg_cache_idx);
 		/* Rewind the next index now that we're not using this entry */
 		msg_cache_next = rx.msg_cache_idx;
 	}
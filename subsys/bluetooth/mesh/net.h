@@ -282,6 +282,16 @@ void bt_mesh_net_loopback_clear(uint16_t net_idx);
 
 uint32_t bt_mesh_next_seq(void);
 
+/* Network message cache statistics */
+struct bt_mesh_msg_cache_stats {
+	uint32_t lookups;  /* Messages checked against the cache */
+	uint32_t filtered; /* Lookups rejected by the bloom filter */
+	uint32_t hits;     /* Duplicates found in the cache */
+};
+
+void bt_mesh_net_msg_cache_stats(struct bt_mesh_msg_cache_stats *stats,
+				 bool reset);
+
 void bt_mesh_net_init(void);
 void bt_mesh_net_header_parse(struct net_buf_simple *buf,
 			      struct bt_mesh_net_rx *rx);
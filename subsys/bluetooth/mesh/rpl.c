@@ -40,11 +40,102 @@ struct rpl_val {
 static struct bt_mesh_rpl replay_list[CONFIG_BT_MESH_CRPL];
 static ATOMIC_DEFINE(store, CONFIG_BT_MESH_CRPL);
 
+/* Hash index of the entries by source address. Each bucket holds the index
+ * of its first entry, and the entries of a bucket are linked with next.
+ */
+#define RPL_NONE UINT16_MAX
+
+static uint16_t rpl_bucket[CONFIG_BT_MESH_CRPL] = {
+	[0 ... (CONFIG_BT_MESH_CRPL - 1)] = RPL_NONE,
+};
+static uint16_t rpl_next[CONFIG_BT_MESH_CRPL];
+
 static inline int rpl_idx(const struct bt_mesh_rpl *rpl)
 {
 	return rpl - &replay_list[0];
 }
 
+static inline uint16_t *rpl_head(uint16_t src)
+{
+	return &rpl_bucket[src % ARRAY_SIZE(rpl_bucket)];
+}
+
+static void rpl_index_add(struct bt_mesh_rpl *rpl)
+{
+	uint16_t *head = rpl_head(rpl->src);
+
+	rpl_next[rpl_idx(rpl)] = *head;
+	*head = rpl_idx(rpl);
+}
+
+static void rpl_index_del(struct bt_mesh_rpl *rpl)
+{
+	uint16_t *link = rpl_head(rpl->src);
+
+	while (*link != RPL_NONE) {
+		if (*link == rpl_idx(rpl)) {
+			*link = rpl_next[*link];
+			return;
+		}
+
+		link = &rpl_next[*link];
+	}
+}
+
+static void rpl_index_reset(void)
+{
+	(void)memset(rpl_bucket, 0xff, sizeof(rpl_bucket));
+}
+
+static void rpl_set_src(struct bt_mesh_rpl *rpl, uint16_t src)
+{
+	if (rpl->src == src) {
+		return;
+	}
+
+	if (rpl->src) {
+		rpl_index_del(rpl);
+	}
+
+	rpl->src = src;
+	rpl_index_add(rpl);
+}
+
+static void rpl_entry_reset(struct bt_mesh_rpl *rpl)
+{
+	if (rpl->src) {
+		rpl_index_del(rpl);
+	}
+
+	(void)memset(rpl, 0, sizeof(*rpl));
+}
+
+static struct bt_mesh_rpl *bt_mesh_rpl_find(uint16_t src)
+{
+	uint16_t i;
+
+	for (i = *rpl_head(src); i != RPL_NONE; i = rpl_next[i]) {
+		if (replay_list[i].src == src) {
+			return &replay_list[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct bt_mesh_rpl *rpl_find_free(void)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
+		if (!replay_list[i].src) {
+			return &replay_list[i];
+		}
+	}
+
+	return NULL;
+}
+
 static void clear_rpl(struct bt_mesh_rpl *rpl)
 {
 	int err;
@@ -62,7 +153,7 @@ static void clear_rpl(struct bt_mesh_rpl *rpl)
 		BT_DBG("Cleared RPL");
 	}
 
-	(void)memset(rpl, 0, sizeof(*rpl));
+	rpl_entry_reset(rpl);
 	atomic_clear_bit(store, rpl_idx(rpl));
 }
 
@@ -94,7 +185,7 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 		rpl->seg = 0;
 	}
 
-	rpl->src = rx->ctx.addr;
+	rpl_set_src(rpl, rx->ctx.addr);
 	rpl->seq = rx->seq;
 	rpl->old_iv = rx->old_iv;
 
@@ -111,7 +202,7 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 		struct bt_mesh_rpl **match)
 {
-	int i;
+	struct bt_mesh_rpl *rpl;
 
 	/* Don't bother checking messages from ourselves */
 	if (rx->net_if == BT_MESH_NET_IF_LOCAL) {
@@ -123,42 +214,39 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 		return false;
 	}
 
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		struct bt_mesh_rpl *rpl = &replay_list[i];
-
+	rpl = bt_mesh_rpl_find(rx->ctx.addr);
+	if (!rpl) {
 		/* Empty slot */
-		if (!rpl->src) {
-			if (match) {
-				*match = rpl;
-			} else {
-				bt_mesh_rpl_update(rpl, rx);
-			}
+		rpl = rpl_find_free();
+		if (!rpl) {
+			BT_ERR("RPL is full!");
+			return true;
+		}
 
-			return false;
+		if (match) {
+			*match = rpl;
+		} else {
+			bt_mesh_rpl_update(rpl, rx);
 		}
 
-		/* Existing slot for given address */
-		if (rpl->src == rx->ctx.addr) {
-			if (rx->old_iv && !rpl->old_iv) {
-				return true;
-			}
+		return false;
+	}
 
-			if ((!rx->old_iv && rpl->old_iv) ||
-			    rpl->seq < rx->seq) {
-				if (match) {
-					*match = rpl;
-				} else {
-					bt_mesh_rpl_update(rpl, rx);
-				}
+	/* Existing slot for given address */
+	if (rx->old_iv && !rpl->old_iv) {
+		return true;
+	}
 
-				return false;
-			} else {
-				return true;
-			}
+	if ((!rx->old_iv && rpl->old_iv) || rpl->seq < rx->seq) {
+		if (match) {
+			*match = rpl;
+		} else {
+			bt_mesh_rpl_update(rpl, rx);
 		}
+
+		return false;
 	}
 
-	BT_ERR("RPL is full!");
 	return true;
 }
 
@@ -170,34 +258,20 @@ void bt_mesh_rpl_clear(void)
 		schedule_rpl_clear();
 	} else {
 		(void)memset(replay_list, 0, sizeof(replay_list));
+		rpl_index_reset();
 	}
 }
 
-static struct bt_mesh_rpl *bt_mesh_rpl_find(uint16_t src)
-{
-	int i;
-
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		if (replay_list[i].src == src) {
-			return &replay_list[i];
-		}
-	}
-
-	return NULL;
-}
-
 static struct bt_mesh_rpl *bt_mesh_rpl_alloc(uint16_t src)
 {
-	int i;
+	struct bt_mesh_rpl *rpl;
 
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		if (!replay_list[i].src) {
-			replay_list[i].src = src;
-			return &replay_list[i];
-		}
+	rpl = rpl_find_free();
+	if (rpl) {
+		rpl_set_src(rpl, src);
 	}
 
-	return NULL;
+	return rpl;
 }
 
 void bt_mesh_rpl_reset(void)
@@ -215,7 +289,7 @@ void bt_mesh_rpl_reset(void)
 				if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
 					clear_rpl(rpl);
 				} else {
-					(void)memset(rpl, 0, sizeof(*rpl));
+					rpl_entry_reset(rpl);
 				}
 			} else {
 				rpl->old_iv = true;
@@ -247,7 +321,7 @@ static int rpl_set(const char *name, size_t len_rd,
 	if (len_rd == 0) {
 		BT_DBG("val (null)");
 		if (entry) {
-			(void)memset(entry, 0, sizeof(*entry));
+			rpl_entry_reset(entry);
 		} else {
 			BT_WARN("Unable to find RPL entry for 0x%04x", src);
 		}
@@ -315,8 +389,25 @@ static void store_pending_rpl(struct bt_mesh_rpl *rpl)
 	}
 }
 
+/* Only the entries marked in the store bitmap are visited */
+static void store_all_pending_rpl(void)
+{
+	atomic_val_t pending;
+	int i, bit;
+
+	for (i = 0; i < ARRAY_SIZE(store); i++) {
+		pending = atomic_clear(&store[i]);
+
+		while ((bit = find_lsb_set(pending))) {
+			pending &= ~BIT(bit - 1);
+			store_rpl(&replay_list[i * ATOMIC_BITS + bit - 1]);
+		}
+	}
+}
+
 void bt_mesh_rpl_pending_store(uint16_t addr)
 {
+	struct bt_mesh_rpl *rpl;
 	int i;
 
 	if (!IS_ENABLED(CONFIG_BT_SETTINGS) ||
@@ -325,24 +416,29 @@ void bt_mesh_rpl_pending_store(uint16_t addr)
 		return;
 	}
 
-	if (addr == BT_MESH_ADDR_ALL_NODES) {
-		bt_mesh_settings_store_cancel(BT_MESH_SETTINGS_RPL_PENDING);
-	}
-
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		if (addr != BT_MESH_ADDR_ALL_NODES &&
-		    addr != replay_list[i].src) {
-			continue;
+	if (addr != BT_MESH_ADDR_ALL_NODES) {
+		rpl = bt_mesh_rpl_find(addr);
+		if (!rpl) {
+			return;
 		}
 
 		if (atomic_test_bit(bt_mesh.flags, BT_MESH_VALID)) {
-			store_pending_rpl(&replay_list[i]);
+			store_pending_rpl(rpl);
 		} else {
-			clear_rpl(&replay_list[i]);
+			clear_rpl(rpl);
 		}
 
-		if (addr != BT_MESH_ADDR_ALL_NODES) {
-			break;
-		}
+		return;
+	}
+
+	bt_mesh_settings_store_cancel(BT_MESH_SETTINGS_RPL_PENDING);
+
+	if (atomic_test_bit(bt_mesh.flags, BT_MESH_VALID)) {
+		store_all_pending_rpl();
+		return;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
+		clear_rpl(&replay_list[i]);
 	}
 }
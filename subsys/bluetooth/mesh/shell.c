@@ -769,6 +769,20 @@ static int cmd_rpl_clear(const struct shell *shell, size_t argc, char *argv[])
 	return 0;
 }
 
+static int cmd_msg_cache_stats(const struct shell *shell, size_t argc,
+			       char *argv[])
+{
+	struct bt_mesh_msg_cache_stats stats;
+	bool reset = (argc > 1 && !strcmp(argv[1], "reset"));
+
+	bt_mesh_net_msg_cache_stats(&stats, reset);
+
+	shell_print(shell, "Lookups %u filtered %u duplicates %u",
+		    stats.lookups, stats.filtered, stats.hits);
+
+	return 0;
+}
+
 static int cmd_beacon(const struct shell *shell, size_t argc, char *argv[])
 {
 	uint8_t status;
@@ -2673,6 +2687,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(mesh_cmds,
 		      cmd_iv_update_test, 2, 0),
 #endif
 	SHELL_CMD_ARG(rpl-clear, NULL, NULL, cmd_rpl_clear, 1, 0),
+	SHELL_CMD_ARG(msg-cache-stats, NULL, "[reset]", cmd_msg_cache_stats,
+		      1, 1),
 
 	/* Provisioning operations */
 #if defined(CONFIG_BT_MESH_PB_GATT)
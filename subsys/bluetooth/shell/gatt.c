@@ -1112,6 +1112,32 @@ int cmd_att_mtu(const struct shell *shell, size_t argc, char *argv[])
 	return 0;
 }
 
+#if defined(CONFIG_BT_EATT_STATS)
+static void print_bearer(struct bt_conn *conn,
+			 const struct bt_gatt_bearer_stats *stats,
+			 void *user_data)
+{
+	const struct shell *shell = user_data;
+
+	shell_print(shell, "CID 0x%04x %s MTU %u: %u requests, %u PDUs, "
+		    "busy %u ms", stats->cid, stats->enhanced ? "EATT" : "ATT",
+		    stats->mtu, stats->reqs, stats->pdus, stats->busy_ms);
+}
+
+static int cmd_bearers(const struct shell *shell, size_t argc, char *argv[])
+{
+	if (!default_conn) {
+		shell_print(shell, "No default connection");
+		return -ENOEXEC;
+	}
+
+	bt_gatt_bearer_stats_foreach(default_conn, print_bearer,
+				     (void *)shell);
+
+	return 0;
+}
+#endif /* CONFIG_BT_EATT_STATS */
+
 #define HELP_NONE "[none]"
 #define HELP_ADDR_LE "<address: XX:XX:XX:XX:XX:XX> <type: (public|random)>"
 
@@ -1154,6 +1180,10 @@ SHELL_STATIC_SUBCMD_SET_CREATE(gatt_cmds,
 	SHELL_CMD_ARG(set, NULL, "<handle> [data...]", cmd_set, 2, 255),
 	SHELL_CMD_ARG(show-db, NULL, "[uuid] [num_matches]", cmd_show_db, 1, 2),
 	SHELL_CMD_ARG(att_mtu, NULL, "Output ATT MTU size", cmd_att_mtu, 1, 0),
+#if defined(CONFIG_BT_EATT_STATS)
+	SHELL_CMD_ARG(bearers, NULL, "Output ATT bearer statistics",
+		      cmd_bearers, 1, 0),
+#endif /* CONFIG_BT_EATT_STATS */
 #if defined(CONFIG_BT_GATT_DYNAMIC_DB)
 	SHELL_CMD_ARG(metrics, NULL, "[value: on, off]", cmd_metrics, 1, 1),
 	SHELL_CMD_ARG(register, NULL,
@@ -217,6 +217,38 @@ static void receive_timeout_handler(struct _timeout *to)
 	k_work_submit(&ctx->work);
 }
 
+/*
+ * Receive the message into the user buffer if it fits, starting with the data
+ * of the SF or FF
+ */
+static bool receive_user_buf_start(struct isotp_recv_ctx *ctx, uint32_t len)
+{
+	unsigned int key = irq_lock();
+	bool fits = ctx->user_buf && len <= ctx->user_buf_size;
+
+	ctx->user_buf_rx = fits;
+	irq_unlock(key);
+
+	if (!fits) {
+		return false;
+	}
+
+	memcpy(ctx->user_buf, ctx->buf->data, ctx->buf->len);
+	ctx->user_buf_len = ctx->buf->len;
+	net_buf_unref(ctx->buf);
+	ctx->buf = NULL;
+
+	return true;
+}
+
+static void receive_user_buf_done(struct isotp_recv_ctx *ctx, int err)
+{
+	ctx->user_buf = NULL;
+	ctx->user_buf_rx = 0;
+	ctx->user_buf_err = err;
+	k_sem_give(&ctx->user_buf_sem);
+}
+
 static int receive_alloc_buffer(struct isotp_recv_ctx *ctx)
 {
 	struct net_buf *buf = NULL;
@@ -272,6 +304,15 @@ static void receive_state_machine(struct isotp_recv_ctx *ctx)
 	switch (ctx->state) {
 	case ISOTP_RX_STATE_PROCESS_SF:
 		ctx->length = receive_get_sf_length(ctx->buf);
+		if (receive_user_buf_start(ctx, ctx->length)) {
+			LOG_DBG("SM SF of length %d in user buffer",
+				ctx->length);
+			receive_user_buf_done(ctx, 0);
+			ctx->state = ISOTP_RX_STATE_RECYCLE;
+			receive_state_machine(ctx);
+			break;
+		}
+
 		ud_rem_len = net_buf_user_data(ctx->buf);
 		*ud_rem_len = 0;
 		LOG_DBG("SM process SF of length %d", ctx->length);
@@ -283,6 +324,15 @@ static void receive_state_machine(struct isotp_recv_ctx *ctx)
 	case ISOTP_RX_STATE_PROCESS_FF:
 		ctx->length = receive_get_ff_length(ctx->buf);
 		LOG_DBG("SM process FF. Length: %d", ctx->length);
+		if (receive_user_buf_start(ctx, ctx->length)) {
+			/* Nothing to allocate */
+			ctx->length -= ctx->user_buf_len;
+			ctx->bs = ctx->opts.bs;
+			ctx->state = ISOTP_RX_STATE_SEND_FC;
+			receive_state_machine(ctx);
+			break;
+		}
+
 		ctx->length -= ctx->buf->len;
 		if (ctx->opts.bs == 0 &&
 		    ctx->length > CONFIG_ISOTP_RX_BUF_COUNT *
@@ -349,9 +399,18 @@ static void receive_state_machine(struct isotp_recv_ctx *ctx)
 			receive_send_fc(ctx, ISOTP_PCI_FS_OVFLW);
 		}
 
-		k_fifo_cancel_wait(&ctx->fifo);
-		net_buf_unref(ctx->buf);
-		ctx->buf = NULL;
+		if (ctx->user_buf_rx) {
+			receive_user_buf_done(ctx, ctx->error_nr);
+			ctx->error_nr = 0;
+		} else {
+			k_fifo_cancel_wait(&ctx->fifo);
+		}
+
+		if (ctx->buf) {
+			net_buf_unref(ctx->buf);
+			ctx->buf = NULL;
+		}
+
 		ctx->state = ISOTP_RX_STATE_RECYCLE;
 		__fallthrough;
 	case ISOTP_RX_STATE_RECYCLE:
@@ -475,7 +534,7 @@ static inline void receive_add_mem(struct isotp_recv_ctx *ctx, uint8_t *data,
 
 static void process_cf(struct isotp_recv_ctx *ctx, struct zcan_frame *frame)
 {
-	uint32_t *ud_rem_len = (uint32_t *)net_buf_user_data(ctx->buf);
+	uint32_t *ud_rem_len;
 	int index = 0;
 	uint32_t data_len;
 
@@ -516,20 +575,40 @@ static void process_cf(struct isotp_recv_ctx *ctx, struct zcan_frame *frame)
 	LOG_DBG("Got CF irq. Appending data");
 	data_len = (ctx->length > frame->dlc - index) ? frame->dlc - index :
 		ctx->length;
-	receive_add_mem(ctx, &frame->data[index], data_len);
+	if (ctx->user_buf_rx) {
+		memcpy(&ctx->user_buf[ctx->user_buf_len], &frame->data[index],
+		       data_len);
+		ctx->user_buf_len += data_len;
+	} else {
+		receive_add_mem(ctx, &frame->data[index], data_len);
+	}
+
 	ctx->length -= data_len;
 	LOG_DBG("%d bytes remaining", ctx->length);
 
 	if (ctx->length == 0) {
 		ctx->state = ISOTP_RX_STATE_RECYCLE;
+		if (ctx->user_buf_rx) {
+			receive_user_buf_done(ctx, 0);
+			return;
+		}
+
+		ud_rem_len = net_buf_user_data(ctx->buf);
 		*ud_rem_len = 0;
 		net_buf_put(&ctx->fifo, ctx->buf);
 		return;
 	}
 
 	if (ctx->opts.bs && !--ctx->bs) {
-		LOG_DBG("Block is complete. Allocate new buffer");
 		ctx->bs = ctx->opts.bs;
+		if (ctx->user_buf_rx) {
+			LOG_DBG("Block is complete. Send FC");
+			ctx->state = ISOTP_RX_STATE_SEND_FC;
+			return;
+		}
+
+		LOG_DBG("Block is complete. Allocate new buffer");
+		ud_rem_len = net_buf_user_data(ctx->buf);
 		*ud_rem_len = ctx->length;
 		net_buf_put(&ctx->fifo, ctx->buf);
 		ctx->state = ISOTP_RX_STATE_TRY_ALLOC;
@@ -612,6 +691,9 @@ int isotp_bind(struct isotp_recv_ctx *ctx, const struct device *can_dev,
 	ctx->rx_addr = *rx_addr;
 	ctx->tx_addr = *tx_addr;
 	k_fifo_init(&ctx->fifo);
+	ctx->user_buf = NULL;
+	ctx->user_buf_rx = 0;
+	k_sem_init(&ctx->user_buf_sem, 0, 1);
 
 	__ASSERT(opts->stmin < ISOTP_STMIN_MAX, "STmin limit");
 	__ASSERT(opts->stmin <= ISOTP_STMIN_MS_MAX ||
@@ -660,6 +742,10 @@ void isotp_unbind(struct isotp_recv_ctx *ctx)
 
 	ctx->state = ISOTP_RX_STATE_UNBOUND;
 
+	if (ctx->user_buf_rx) {
+		receive_user_buf_done(ctx, ISOTP_N_ERROR);
+	}
+
 	while ((buf = net_buf_get(&ctx->fifo, K_NO_WAIT))) {
 		net_buf_unref(buf);
 	}
@@ -750,6 +836,30 @@ int isotp_recv(struct isotp_recv_ctx *ctx, uint8_t *data, size_t len,
 	return num_copied;
 }
 
+void isotp_recv_buf_set(struct isotp_recv_ctx *ctx, uint8_t *data,
+			size_t len)
+{
+	unsigned int key;
+
+	__ASSERT(!ctx->user_buf_rx, "Reception into the buffer ongoing");
+
+	key = irq_lock();
+	k_sem_reset(&ctx->user_buf_sem);
+	ctx->user_buf_size = len;
+	ctx->user_buf_len = 0;
+	ctx->user_buf = data;
+	irq_unlock(key);
+}
+
+int isotp_recv_buf_wait(struct isotp_recv_ctx *ctx, k_timeout_t timeout)
+{
+	if (k_sem_take(&ctx->user_buf_sem, timeout)) {
+		return ISOTP_RECV_TIMEOUT;
+	}
+
+	return ctx->user_buf_err ? ctx->user_buf_err : ctx->user_buf_len;
+}
+
 static inline void send_report_error(struct isotp_send_ctx *ctx, uint32_t err)
 {
 	ctx->state = ISOTP_TX_ERR;
@@ -1106,6 +1216,20 @@ static void send_state_machine(struct isotp_send_ctx *ctx)
 		break;
 
 	case ISOTP_TX_WAIT_ST:
+		/* Separation times shorter than a tick are rounded up to a
+		 * whole tick by a timeout
+		 */
+		if (IS_ENABLED(CONFIG_ISOTP_TX_STMIN_BUSY_WAIT) &&
+		    ctx->opts.stmin >= ISOTP_STMIN_US_BEGIN &&
+		    ctx->opts.stmin <= ISOTP_STMIN_US_END) {
+			k_busy_wait((ctx->opts.stmin + 1 -
+				     ISOTP_STMIN_US_BEGIN) * 100U);
+			ctx->state = ISOTP_TX_SEND_CF;
+			k_work_submit(&ctx->work);
+			LOG_DBG("SM busy wait ST");
+			break;
+		}
+
 		z_add_timeout(&ctx->timeout, send_timeout_handler,
 			      stmin_to_ticks(ctx->opts.stmin));
 		ctx->state = ISOTP_TX_SEND_CF;
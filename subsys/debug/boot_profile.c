@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ *  @brief Boot profiling implementation
+ */
+
+#include <kernel.h>
+#include <kernel_internal.h>
+#include <init.h>
+#include <spinlock.h>
+#include <sys/printk.h>
+#include <linker/section_tags.h>
+#include <debug/boot_profile.h>
+
+#define EARLY_MAGIC 0x424f4f54U
+
+/* Size of the printed lines, one per record. */
+#define LINE_SIZE 96
+
+/* The early phases run before the BSS is zeroed and, for XIP images,
+ * before the data are copied: they are recorded to memory neither touches,
+ * and added to the records once the kernel starts. Each phase has its own
+ * slot, valid once its magic is set, so that left-overs of a previous boot
+ * are not mistaken for records.
+ */
+static __noinit struct {
+	uint32_t magic;
+	timing_t start;
+	timing_t end;
+} early[Z_BOOT_PROFILE_EARLY_PHASES];
+
+static const char *const early_names[] = {
+	[Z_BOOT_PROFILE_BSS_ZERO] = "bss_zero",
+	[Z_BOOT_PROFILE_DATA_COPY] = "data_copy",
+};
+
+static const char *const level_names[] = {
+	[BOOT_PROFILE_EARLY] = "EARLY",
+	[BOOT_PROFILE_PRE_KERNEL_1] = "PRE_KERNEL_1",
+	[BOOT_PROFILE_PRE_KERNEL_2] = "PRE_KERNEL_2",
+	[BOOT_PROFILE_POST_KERNEL] = "POST_KERNEL",
+	[BOOT_PROFILE_APPLICATION] = "APPLICATION",
+	[BOOT_PROFILE_SMP] = "SMP",
+	[BOOT_PROFILE_MAIN] = "MAIN",
+};
+
+static struct boot_profile_record records[CONFIG_BOOT_PROFILING_RECORDS];
+static uint32_t count;
+static uint32_t dropped;
+static struct k_spinlock lock;
+
+/* Counter value the record starts are relative to. */
+static timing_t base;
+static bool started;
+static uint8_t cur_level = BOOT_PROFILE_EARLY;
+
+static uint32_t cycles_get(timing_t start, timing_t end)
+{
+	uint64_t cycles = timing_cycles_get(&start, &end);
+
+	return (uint32_t)MIN(cycles, UINT32_MAX);
+}
+
+static void record_add(const char *name, const void *func, uint8_t level,
+		       int32_t start, uint32_t cycles)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (count < ARRAY_SIZE(records)) {
+		records[count].name = name;
+		records[count].func = func;
+		records[count].start = start;
+		records[count].cycles = cycles;
+		records[count].level = level;
+		count++;
+	} else {
+		dropped++;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+static void record_end(const char *name, const void *func, timing_t start)
+{
+	timing_t end = timing_counter_get();
+
+	if (!started) {
+		return;
+	}
+
+	record_add(name, func, cur_level,
+		   (int32_t)MIN(cycles_get(base, start), INT32_MAX),
+		   cycles_get(start, end));
+}
+
+__boot_func
+timing_t z_boot_profile_early_begin(void)
+{
+#if defined(CONFIG_CORTEX_M_DWT) && \
+	!defined(CONFIG_SOC_HAS_TIMING_FUNCTIONS) && \
+	!defined(CONFIG_BOARD_HAS_TIMING_FUNCTIONS)
+	/* The DWT cycle counter only counts once enabled, which is done
+	 * with register accesses only, safe before the C runtime is set up.
+	 * Other counters are expected to run from reset.
+	 */
+	arch_timing_init();
+#endif
+
+	return timing_counter_get();
+}
+
+__boot_func
+void z_boot_profile_early_end(int phase, timing_t start)
+{
+	early[phase].start = start;
+	early[phase].end = timing_counter_get();
+	early[phase].magic = EARLY_MAGIC;
+}
+
+/* Lay the early phases out in the order they ran, ending at 0: the counter
+ * is set up again for the kernel, they cannot be related to its values.
+ */
+static void early_import(void)
+{
+	timing_t last = 0;
+	int order[Z_BOOT_PROFILE_EARLY_PHASES];
+	int n = 0;
+
+	for (int i = 0; i < Z_BOOT_PROFILE_EARLY_PHASES; i++) {
+		if (early[i].magic != EARLY_MAGIC) {
+			continue;
+		}
+
+		if (n == 0 || early[i].end > last) {
+			last = early[i].end;
+		}
+
+		/* Insertion sort on the start, there are very few phases. */
+		int j = n++;
+
+		while (j > 0 && early[order[j - 1]].start > early[i].start) {
+			order[j] = order[j - 1];
+			j--;
+		}
+		order[j] = i;
+	}
+
+	for (int i = 0; i < n; i++) {
+		int phase = order[i];
+
+		record_add(early_names[phase], NULL, BOOT_PROFILE_EARLY,
+			   -(int32_t)MIN(cycles_get(early[phase].start, last),
+					 INT32_MAX),
+			   cycles_get(early[phase].start, early[phase].end));
+		early[phase].magic = 0U;
+	}
+}
+
+/* The counter must count from here on. On x86, setting the timing
+ * functions up calibrates the TSC against the system timer, which only
+ * runs after PRE_KERNEL_2: it is done then, the TSC counts from reset.
+ */
+static void timing_setup(void)
+{
+	timing_init();
+	timing_start();
+}
+
+void z_boot_profile_init(void)
+{
+	if (!IS_ENABLED(CONFIG_X86)) {
+		timing_setup();
+	}
+
+	base = timing_counter_get();
+	started = true;
+
+	early_import();
+}
+
+timing_t z_boot_profile_level_begin(int32_t level)
+{
+	cur_level = BOOT_PROFILE_PRE_KERNEL_1 + level;
+
+	return timing_counter_get();
+}
+
+void z_boot_profile_level_end(int32_t level, timing_t start)
+{
+	record_end(level_names[BOOT_PROFILE_PRE_KERNEL_1 + level], NULL,
+		   start);
+
+	if (IS_ENABLED(CONFIG_X86) && level == _SYS_INIT_LEVEL_PRE_KERNEL_2) {
+		timing_setup();
+	}
+}
+
+void z_boot_profile_entry_end(const struct init_entry *entry, timing_t start)
+{
+	record_end(entry->dev != NULL ? entry->dev->name : NULL,
+		   (const void *)entry->init, start);
+}
+
+void z_boot_profile_done(void)
+{
+	cur_level = BOOT_PROFILE_MAIN;
+
+#ifdef CONFIG_BOOT_PROFILING_PRINT
+	boot_profile_print();
+#endif
+}
+
+void boot_profile_end(const char *name, timing_t start)
+{
+	record_end(name, NULL, start);
+}
+
+uint32_t boot_profile_records_get(const struct boot_profile_record **out)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t n = count;
+
+	k_spin_unlock(&lock, key);
+
+	*out = records;
+
+	return n;
+}
+
+uint32_t boot_profile_dropped_get(void)
+{
+	return dropped;
+}
+
+static void header_format(char *buf, size_t len)
+{
+	snprintk(buf, len, "boot_profile freq %u dropped %u",
+		 (uint32_t)timing_freq_get(), dropped);
+}
+
+static void record_format(const struct boot_profile_record *record,
+			  char *buf, size_t len)
+{
+	snprintk(buf, len, "boot_profile %s %d %u %p %s",
+		 level_names[record->level], record->start, record->cycles,
+		 record->func, record->name != NULL ? record->name : "-");
+}
+
+void boot_profile_print(void)
+{
+	const struct boot_profile_record *table;
+	uint32_t n = boot_profile_records_get(&table);
+	char line[LINE_SIZE];
+
+	header_format(line, sizeof(line));
+	printk("%s\n", line);
+
+	for (uint32_t i = 0; i < n; i++) {
+		record_format(&table[i], line, sizeof(line));
+		printk("%s\n", line);
+	}
+}
+
+#ifdef CONFIG_BOOT_PROFILING_SHELL
+#include <shell/shell.h>
+
+/* One line per record, to be rendered as a timeline by
+ * scripts/tracing/boot_profile_timeline.py.
+ */
+static int cmd_boot_profile(const struct shell *shell, size_t argc,
+			    char **argv)
+{
+	const struct boot_profile_record *table;
+	uint32_t n = boot_profile_records_get(&table);
+	char line[LINE_SIZE];
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	header_format(line, sizeof(line));
+	shell_print(shell, "%s", line);
+
+	for (uint32_t i = 0; i < n; i++) {
+		record_format(&table[i], line, sizeof(line));
+		shell_print(shell, "%s", line);
+	}
+
+	return 0;
+}
+
+SHELL_CMD_REGISTER(boot_profile, NULL, "Print the boot profile",
+		   cmd_boot_profile);
+
+#endif /* CONFIG_BOOT_PROFILING_SHELL */
@@ -30,6 +30,11 @@ LOG_MODULE_REGISTER(coredump, CONFIG_KERNEL_LOG_LEVEL);
  * coredump data follows. The padding is to simplify the data read
  * function so that the first read of a data stream is always
  * aligned to flash write size.
+ *
+ * The data are written in chunks of CONFIG_DEBUG_COREDUMP_FLASH_BUF_SIZE
+ * bytes. With CONFIG_DEBUG_COREDUMP_FLASH_ERASE_PROGRESSIVELY, the pages
+ * are erased as the data reach them, the first page at the start of the
+ * dump, for the header to be written at the end.
  */
 
 #if !FLASH_AREA_LABEL_EXISTS(coredump_partition)
@@ -41,7 +46,11 @@ LOG_MODULE_REGISTER(coredump, CONFIG_KERNEL_LOG_LEVEL);
 	DT_PARENT(DT_PARENT(DT_NODELABEL(coredump_partition)))
 
 #define FLASH_WRITE_SIZE	DT_PROP(FLASH_CONTROLLER, write_block_size)
-#define FLASH_BUF_SIZE		FLASH_WRITE_SIZE
+#define FLASH_BUF_SIZE		\
+	ROUND_UP(CONFIG_DEBUG_COREDUMP_FLASH_BUF_SIZE, FLASH_WRITE_SIZE)
+
+/* Size of the chunks copied, then checksummed and written */
+#define COPY_BUF_SIZE		FLASH_WRITE_SIZE
 
 #define FLASH_PARTITION		FLASH_AREA_ID(coredump_partition)
 
@@ -93,6 +102,9 @@ struct flash_hdr_t {
 	int		error;
 } __packed;
 
+/* Header, padded to the write size */
+static uint8_t hdr_buf[ROUND_UP(sizeof(struct flash_hdr_t), FLASH_WRITE_SIZE)];
+
 
 /**
  * @brief Open the flash partition.
@@ -170,8 +182,10 @@ static int data_read(off_t off, uint8_t *dst, size_t len,
 			copy_sz = remaining;
 		}
 
+		/* Data are written in whole write blocks */
 		ret = flash_area_read(backend_ctx.flash_area, offset,
-				      data_read_buf, FLASH_BUF_SIZE);
+				      data_read_buf,
+				      ROUND_UP(copy_sz, FLASH_WRITE_SIZE));
 		if (ret != 0) {
 			break;
 		}
@@ -309,7 +323,8 @@ static void coredump_flash_backend_start(void)
 
 	ret = partition_open();
 
-	if (ret == 0) {
+	if ((ret == 0) &&
+	    !IS_ENABLED(CONFIG_DEBUG_COREDUMP_FLASH_ERASE_PROGRESSIVELY)) {
 		/* Erase whole flash partition */
 		ret = flash_area_erase(backend_ctx.flash_area, 0,
 				       backend_ctx.flash_area->fa_size);
@@ -337,6 +352,14 @@ static void coredump_flash_backend_start(void)
 					NULL);
 	}
 
+#ifdef CONFIG_DEBUG_COREDUMP_FLASH_ERASE_PROGRESSIVELY
+	if (ret == 0) {
+		/* The page of the header, the others are erased on the go */
+		ret = stream_flash_erase_page(&backend_ctx.stream_ctx,
+					      backend_ctx.flash_area->fa_off);
+	}
+#endif
+
 	if (ret != 0) {
 		LOG_ERR("Cannot start coredump!");
 		backend_ctx.error = ret;
@@ -354,7 +377,6 @@ static void coredump_flash_backend_start(void)
 static void coredump_flash_backend_end(void)
 {
 	int ret;
-	const struct device *flash_dev;
 
 	struct flash_hdr_t hdr = {
 		.id = {'C', 'D'},
@@ -376,22 +398,18 @@ static void coredump_flash_backend_end(void)
 	hdr.error = backend_ctx.error;
 	hdr.flags = 0;
 
-	flash_dev = flash_area_get_device(backend_ctx.flash_area);
+	/*
+	 * Write at the beginning of the partition directly, the page is
+	 * already erased.
+	 */
+	(void)memset(hdr_buf, 0, sizeof(hdr_buf));
+	(void)memcpy(hdr_buf, &hdr, sizeof(hdr));
 
-	/* Need to re-init context to write at beginning of flash */
-	ret = stream_flash_init(&backend_ctx.stream_ctx, flash_dev,
-				stream_flash_buf,
-				sizeof(stream_flash_buf),
-				backend_ctx.flash_area->fa_off,
-				backend_ctx.flash_area->fa_size, NULL);
-	if (ret == 0) {
-		ret = stream_flash_buffered_write(&backend_ctx.stream_ctx,
-						  (void *)&hdr, sizeof(hdr),
-						  true);
-		if (ret != 0) {
-			LOG_ERR("Cannot write coredump header!");
-			backend_ctx.error = ret;
-		}
+	ret = flash_area_write(backend_ctx.flash_area, 0, hdr_buf,
+			       sizeof(hdr_buf));
+	if (ret != 0) {
+		LOG_ERR("Cannot write coredump header!");
+		backend_ctx.error = ret;
 	}
 
 	if (backend_ctx.error != 0) {
@@ -418,7 +436,7 @@ static void coredump_flash_backend_buffer_output(uint8_t *buf, size_t buflen)
 	size_t remaining = buflen;
 	size_t copy_sz;
 	uint8_t *ptr = buf;
-	uint8_t tmp_buf[FLASH_BUF_SIZE];
+	uint8_t tmp_buf[COPY_BUF_SIZE];
 
 	if ((backend_ctx.error != 0) || (backend_ctx.flash_area == NULL)) {
 		return;
@@ -430,9 +448,9 @@ static void coredump_flash_backend_buffer_output(uint8_t *buf, size_t buflen)
 	 * part of the buffer, so that the checksum corresponds to what is
 	 * being written.
 	 */
-	copy_sz = FLASH_BUF_SIZE;
+	copy_sz = COPY_BUF_SIZE;
 	while (remaining > 0) {
-		if (remaining < FLASH_BUF_SIZE) {
+		if (remaining < COPY_BUF_SIZE) {
 			copy_sz = remaining;
 		}
 
@@ -5,6 +5,7 @@
  */
 
 #include <errno.h>
+#include <string.h>
 #include <kernel_internal.h>
 #include <toolchain.h>
 #include <debug/coredump.h>
@@ -13,6 +14,10 @@
 
 #include "coredump_internal.h"
 
+#ifdef CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_THREADS
+#include <heap.h>
+#endif
+
 #if defined(CONFIG_DEBUG_COREDUMP_BACKEND_LOGGING)
 extern struct z_coredump_backend_api z_coredump_backend_logging;
 static struct z_coredump_backend_api
@@ -25,6 +30,163 @@ static struct z_coredump_backend_api
 #error "Need to select a coredump backend"
 #endif
 
+#ifdef CONFIG_DEBUG_COREDUMP_COMPRESS
+/*
+ * LZ77 compression of the coredump past its header, in a fixed amount of
+ * memory. The compressed data are a sequence of blocks, each starting
+ * with a control byte:
+ * - 0x00 to 0x7f: control + 1 literal bytes follow.
+ * - 0x80 to 0xff: (control & 0x7f) + LZ_MATCH_MIN bytes are repeated
+ *   from the output, a distance back given by the next two bytes, in
+ *   little endian. The distance may be shorter than the match.
+ *
+ * The input goes through a ring buffer holding the window and the bytes
+ * to be compressed, so that the matches refer to the data as they were
+ * output, even if the memory changes in the meantime.
+ */
+#define LZ_WINDOW_SIZE	BIT(CONFIG_DEBUG_COREDUMP_COMPRESS_WINDOW_BITS)
+#define LZ_RING_SIZE	(2 * LZ_WINDOW_SIZE)
+#define LZ_LITERAL_MAX	128
+#define LZ_MATCH_MIN	3
+#define LZ_MATCH_MAX	(0x7f + LZ_MATCH_MIN)
+#define LZ_HASH_BITS	8
+#define LZ_OUT_SIZE	64
+
+#define LZ_RING(pos)	(lz.ring[(pos) & (LZ_RING_SIZE - 1)])
+
+static struct {
+	uint8_t ring[LZ_RING_SIZE];
+
+	/* Last position of each hash of 3 bytes, modulo 2^16 */
+	uint16_t hash[BIT(LZ_HASH_BITS)];
+
+	uint8_t out[LZ_OUT_SIZE];
+	size_t out_len;
+
+	/* Stream positions of the end of the input, of the next byte to
+	 * compress and of the first pending literal
+	 */
+	uint32_t in_pos;
+	uint32_t pos;
+	uint32_t lit_pos;
+
+	bool active;
+} lz;
+
+static void lz_out(uint8_t byte)
+{
+	lz.out[lz.out_len++] = byte;
+
+	if (lz.out_len == sizeof(lz.out)) {
+		backend_api->buffer_output(lz.out, lz.out_len);
+		lz.out_len = 0;
+	}
+}
+
+static void lz_literals_flush(void)
+{
+	uint32_t len = lz.pos - lz.lit_pos;
+
+	if (len == 0) {
+		return;
+	}
+
+	lz_out(len - 1);
+	for (uint32_t i = 0; i < len; i++) {
+		lz_out(LZ_RING(lz.lit_pos + i));
+	}
+
+	lz.lit_pos = lz.pos;
+}
+
+static inline uint32_t lz_hash(uint32_t pos)
+{
+	uint32_t v = (LZ_RING(pos) << 16) | (LZ_RING(pos + 1) << 8) |
+		     LZ_RING(pos + 2);
+
+	return (v * 2654435761U) >> (32 - LZ_HASH_BITS);
+}
+
+/* Compress the byte at the current position, or a match starting there */
+static void lz_step(void)
+{
+	uint32_t avail = MIN(lz.in_pos - lz.pos, LZ_MATCH_MAX);
+	uint32_t len = 0;
+	uint32_t dist = 0;
+
+	if (avail >= LZ_MATCH_MIN) {
+		uint16_t *last = &lz.hash[lz_hash(lz.pos)];
+
+		dist = (uint16_t)(lz.pos - *last);
+		*last = (uint16_t)lz.pos;
+
+		/* The hash may collide, only the data tell a match */
+		if (dist != 0 && dist <= LZ_WINDOW_SIZE && dist <= lz.pos) {
+			while (len < avail && LZ_RING(lz.pos - dist + len) ==
+			       LZ_RING(lz.pos + len)) {
+				len++;
+			}
+		}
+	}
+
+	if (len < LZ_MATCH_MIN) {
+		lz.pos++;
+		if (lz.pos - lz.lit_pos == LZ_LITERAL_MAX) {
+			lz_literals_flush();
+		}
+		return;
+	}
+
+	lz_literals_flush();
+	lz_out(0x80 | (len - LZ_MATCH_MIN));
+	lz_out(dist & 0xff);
+	lz_out(dist >> 8);
+
+	lz.pos += len;
+	lz.lit_pos = lz.pos;
+}
+
+static void lz_start(void)
+{
+	(void)memset(&lz, 0, sizeof(lz));
+	lz.active = true;
+}
+
+static void lz_input(const uint8_t *buf, size_t buflen)
+{
+	while (buflen > 0) {
+		/* Keep the window behind the position */
+		while (buflen > 0 && lz.in_pos - lz.pos < LZ_WINDOW_SIZE) {
+			LZ_RING(lz.in_pos++) = *buf++;
+			buflen--;
+		}
+
+		while (lz.in_pos - lz.pos >= LZ_MATCH_MAX) {
+			lz_step();
+		}
+	}
+}
+
+static void lz_end(void)
+{
+	if (!lz.active) {
+		return;
+	}
+
+	while (lz.pos != lz.in_pos) {
+		lz_step();
+	}
+
+	lz_literals_flush();
+
+	if (lz.out_len != 0) {
+		backend_api->buffer_output(lz.out, lz.out_len);
+	}
+
+	lz.active = false;
+}
+#endif /* CONFIG_DEBUG_COREDUMP_COMPRESS */
+
 static void dump_header(unsigned int reason)
 {
 	struct coredump_hdr_t hdr = {
@@ -43,14 +205,32 @@ static void dump_header(unsigned int reason)
 
 	hdr.tgt_code = sys_cpu_to_le16(arch_coredump_tgt_code_get());
 
+	if (IS_ENABLED(CONFIG_DEBUG_COREDUMP_COMPRESS)) {
+		hdr.flag |= COREDUMP_FLAG_COMPRESSED;
+	}
+
 	backend_api->buffer_output((uint8_t *)&hdr, sizeof(hdr));
 }
 
-static void dump_thread(struct k_thread *thread)
+#if defined(CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_MIN) || \
+	defined(CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_THREADS)
+static void dump_thread_memory(struct k_thread *thread)
 {
-#ifdef CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_MIN
 	uintptr_t end_addr;
 
+	end_addr = POINTER_TO_UINT(thread) + sizeof(*thread);
+
+	coredump_memory_dump(POINTER_TO_UINT(thread), end_addr);
+
+	end_addr = thread->stack_info.start + thread->stack_info.size;
+
+	coredump_memory_dump(thread->stack_info.start, end_addr);
+}
+#endif
+
+static void dump_thread(struct k_thread *thread)
+{
+#ifdef CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_MIN
 	/*
 	 * When dumping minimum information,
 	 * the current thread struct and stack need to
@@ -61,18 +241,56 @@ static void dump_thread(struct k_thread *thread)
 		return;
 	}
 
-	end_addr = POINTER_TO_UINT(thread) + sizeof(*thread);
+	dump_thread_memory(thread);
+#endif
+}
 
-	coredump_memory_dump(POINTER_TO_UINT(thread), end_addr);
+#ifdef CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_THREADS
+/* The statically defined kernel objects are linked next to each other,
+ * from the timers to the condition variables.
+ */
+extern char _k_timer_list_start[];
+extern char _k_condvar_list_end[];
 
-	end_addr = thread->stack_info.start + thread->stack_info.size;
+static void dump_threads_and_objects(void)
+{
+	struct k_thread *thread;
 
-	coredump_memory_dump(thread->stack_info.start, end_addr);
-#endif
+	/* All the threads, the faulting one included */
+	for (thread = _kernel.threads; thread != NULL;
+	     thread = thread->next_thread) {
+		dump_thread_memory(thread);
+	}
+
+	coredump_memory_dump(POINTER_TO_UINT(z_interrupt_stacks),
+			     POINTER_TO_UINT(z_interrupt_stacks) +
+			     sizeof(z_interrupt_stacks));
+
+	coredump_memory_dump(POINTER_TO_UINT(&_kernel),
+			     POINTER_TO_UINT(&_kernel) + sizeof(_kernel));
+
+	coredump_memory_dump(POINTER_TO_UINT(_k_timer_list_start),
+			     POINTER_TO_UINT(_k_condvar_list_end));
+
+	/* The heap struct and free lists, in the first chunk of each heap */
+	Z_STRUCT_SECTION_FOREACH(k_heap, h) {
+		struct z_heap *zh = h->heap.heap;
+
+		if (zh != NULL) {
+			coredump_memory_dump(POINTER_TO_UINT(zh),
+					     POINTER_TO_UINT(zh) +
+					     chunk_size(zh, 0) * CHUNK_UNIT);
+		}
+	}
 }
+#endif /* CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_THREADS */
 
 void process_memory_region_list(void)
 {
+#ifdef CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_THREADS
+	dump_threads_and_objects();
+#endif
+
 #ifdef CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_LINKER_RAM
 	unsigned int idx = 0;
 
@@ -98,6 +316,10 @@ void coredump(unsigned int reason, const z_arch_esf_t *esf,
 
 	dump_header(reason);
 
+#ifdef CONFIG_DEBUG_COREDUMP_COMPRESS
+	lz_start();
+#endif
+
 	if (esf != NULL) {
 		arch_coredump_info_dump(esf);
 	}
@@ -118,6 +340,10 @@ void z_coredump_start(void)
 
 void z_coredump_end(void)
 {
+#ifdef CONFIG_DEBUG_COREDUMP_COMPRESS
+	lz_end();
+#endif
+
 	backend_api->end();
 }
 
@@ -128,6 +354,13 @@ void coredump_buffer_output(uint8_t *buf, size_t buflen)
 		return;
 	}
 
+#ifdef CONFIG_DEBUG_COREDUMP_COMPRESS
+	if (lz.active) {
+		lz_input(buf, buflen);
+		return;
+	}
+#endif
+
 	backend_api->buffer_output(buf, buflen);
 }
 
@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ *  @brief Sampling profiler implementation
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <init.h>
+#include <sys/atomic.h>
+#include <debug/profiler.h>
+#include <tracing/tracing.h>
+#include <arch/arm/aarch32/cortex_m/cmsis.h>
+
+/* Samples are taken by a kernel timer, i.e. from the system clock
+ * interrupt, which Cortex-M drivers run at the highest priority given to
+ * Zephyr interrupts. A sample therefore interrupts threads and ISRs alike,
+ * except for the code running with interrupts locked, whose time is
+ * accounted to the instruction unlocking them.
+ *
+ * Each CPU records its samples into its own ring. The sampling interrupt
+ * is the only writer of the ring of its CPU, readers only move the tail:
+ * the rings need no locking against the interrupt, only between readers.
+ */
+
+struct profiler_ring {
+	/* One slot is kept empty to tell a full ring from an empty one. */
+	struct profiler_sample samples[CONFIG_PROFILER_BUFFER_SIZE + 1];
+	atomic_t head;
+	atomic_t tail;
+};
+
+static struct profiler_ring rings[CONFIG_MP_NUM_CPUS];
+static atomic_t dropped;
+static K_MUTEX_DEFINE(read_lock);
+
+static inline uint32_t ring_next(uint32_t idx)
+{
+	return (idx == CONFIG_PROFILER_BUFFER_SIZE) ? 0 : idx + 1;
+}
+
+/* Find the IRQ the sampling interrupt preempted: out of the active IRQs,
+ * the one with the highest priority, i.e. the lowest priority value.
+ */
+static int16_t active_irq_get(void)
+{
+	int16_t irq = PROFILER_IRQ_UNKNOWN;
+	uint32_t prio = UINT32_MAX;
+
+	for (int i = 0; i < DIV_ROUND_UP(CONFIG_NUM_IRQS, 32); i++) {
+		uint32_t active = NVIC->IABR[i];
+
+		while (active) {
+			int n = i * 32 + find_lsb_set(active) - 1;
+
+			active &= active - 1U;
+
+			if (NVIC_GetPriority((IRQn_Type)n) < prio) {
+				prio = NVIC_GetPriority((IRQn_Type)n);
+				irq = n;
+			}
+		}
+	}
+
+	return irq;
+}
+
+static void sample_fill(struct profiler_sample *sample)
+{
+	/* RETTOBASE set: the system clock interrupt is the only active
+	 * exception, it preempted a thread, whose exception stack frame is
+	 * at the top of the process stack.
+	 */
+	if (SCB->ICSR & SCB_ICSR_RETTOBASE_Msk) {
+		const uint32_t *frame = (const uint32_t *)__get_PSP();
+
+		sample->pc = frame[6];
+		sample->lr = frame[5];
+		sample->thread = _current;
+		sample->irq = PROFILER_IRQ_NONE;
+	} else {
+		sample->pc = 0;
+		sample->lr = 0;
+		sample->thread = NULL;
+		sample->irq = active_irq_get();
+	}
+}
+
+static void profiler_sample_take(struct k_timer *timer)
+{
+	struct profiler_ring *ring = &rings[_current_cpu->id];
+	uint32_t head = atomic_get(&ring->head);
+	uint32_t next = ring_next(head);
+	struct profiler_sample *sample;
+
+	ARG_UNUSED(timer);
+
+	if (next == atomic_get(&ring->tail)) {
+		atomic_inc(&dropped);
+		return;
+	}
+
+	sample = &ring->samples[head];
+	sample_fill(sample);
+
+#ifdef CONFIG_PROFILER_TRACING
+	sys_port_trace_profiler_sample(sample->thread, sample->pc, sample->lr,
+				       sample->irq);
+#endif /* CONFIG_PROFILER_TRACING */
+
+	atomic_set(&ring->head, next);
+}
+
+static K_TIMER_DEFINE(profiler_timer, profiler_sample_take, NULL);
+
+int profiler_start(uint32_t rate)
+{
+	k_timeout_t period;
+
+	if (rate == 0 || rate > CONFIG_SYS_CLOCK_TICKS_PER_SEC) {
+		return -EINVAL;
+	}
+
+	period = K_TICKS(CONFIG_SYS_CLOCK_TICKS_PER_SEC / rate);
+	k_timer_start(&profiler_timer, period, period);
+
+	return 0;
+}
+
+void profiler_stop(void)
+{
+	k_timer_stop(&profiler_timer);
+}
+
+uint32_t profiler_samples_get(profiler_sample_cb cb, void *user_data)
+{
+	uint32_t count = 0;
+
+	k_mutex_lock(&read_lock, K_FOREVER);
+
+	for (int cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+		struct profiler_ring *ring = &rings[cpu];
+		uint32_t tail = atomic_get(&ring->tail);
+
+		while (tail != atomic_get(&ring->head)) {
+			cb(cpu, &ring->samples[tail], user_data);
+			tail = ring_next(tail);
+			atomic_set(&ring->tail, tail);
+			count++;
+		}
+	}
+
+	k_mutex_unlock(&read_lock);
+
+	return count;
+}
+
+uint32_t profiler_dropped_get(bool reset)
+{
+	return reset ? atomic_set(&dropped, 0) : atomic_get(&dropped);
+}
+
+#ifdef CONFIG_PROFILER_AUTO_START
+static int profiler_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return profiler_start(CONFIG_PROFILER_RATE);
+}
+
+SYS_INIT(profiler_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+#endif /* CONFIG_PROFILER_AUTO_START */
+
+#ifdef CONFIG_PROFILER_SHELL
+#include <shell/shell.h>
+#include <stdlib.h>
+
+static int cmd_profiler_start(const struct shell *shell,
+			      size_t argc, char **argv)
+{
+	uint32_t rate = CONFIG_PROFILER_RATE;
+	int err;
+
+	if (argc > 1) {
+		rate = strtoul(argv[1], NULL, 10);
+	}
+
+	err = profiler_start(rate);
+	if (err) {
+		shell_error(shell, "Invalid rate %u Hz (max %u Hz)", rate,
+			    CONFIG_SYS_CLOCK_TICKS_PER_SEC);
+		return err;
+	}
+
+	shell_print(shell, "Sampling at %u Hz.", rate);
+
+	return 0;
+}
+
+static int cmd_profiler_stop(const struct shell *shell,
+			     size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	profiler_stop();
+
+	shell_print(shell, "Sampling stopped.");
+
+	return 0;
+}
+
+static void sample_print(uint8_t cpu, const struct profiler_sample *sample,
+			 void *user_data)
+{
+	const struct shell *shell = user_data;
+
+	shell_print(shell, "sample %u %p %d 0x%lx 0x%lx", cpu, sample->thread,
+		    sample->irq, (unsigned long)sample->pc,
+		    (unsigned long)sample->lr);
+}
+
+#ifdef CONFIG_THREAD_MONITOR
+static void thread_print(const struct k_thread *thread, void *user_data)
+{
+	const struct shell *shell = user_data;
+	const char *name = k_thread_name_get((k_tid_t)thread);
+
+	shell_print(shell, "thread %p %s", thread,
+		    (name && name[0]) ? name : "unknown");
+}
+#endif /* CONFIG_THREAD_MONITOR */
+
+/* One line per sample and per thread, to be folded into a flame graph by
+ * scripts/tracing/profiler_fold.py.
+ */
+static int cmd_profiler_dump(const struct shell *shell,
+			     size_t argc, char **argv)
+{
+	uint32_t count;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+#ifdef CONFIG_THREAD_MONITOR
+	k_thread_foreach_unlocked(thread_print, (void *)shell);
+#endif /* CONFIG_THREAD_MONITOR */
+
+	count = profiler_samples_get(sample_print, (void *)shell);
+
+	shell_print(shell, "samples %u dropped %u", count,
+		    profiler_dropped_get(true));
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_profiler,
+	SHELL_CMD_ARG(start, NULL, "Start sampling [rate in Hz]",
+		      cmd_profiler_start, 1, 1),
+	SHELL_CMD(stop, NULL, "Stop sampling", cmd_profiler_stop),
+	SHELL_CMD(dump, NULL, "Print and remove the recorded samples",
+		  cmd_profiler_dump),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+
+SHELL_CMD_REGISTER(profiler, &sub_profiler, "Sampling profiler commands",
+		   NULL);
+
+#endif /* CONFIG_PROFILER_SHELL */
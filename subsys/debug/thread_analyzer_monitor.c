@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ *  @brief Thread analyzer continuous monitoring
+ *
+ *  Every monitoring window, the CPU utilization of each thread is computed
+ *  from the execution cycles the kernel accounted to it at context switch,
+ *  and its stack is scanned from its previous high-water mark only.
+ */
+
+#include <kernel.h>
+#include <init.h>
+#include <debug/thread_analyzer.h>
+#include <logging/log.h>
+#include <stats/stats.h>
+#include <string.h>
+
+LOG_MODULE_DECLARE(thread_analyzer, CONFIG_THREAD_ANALYZER_LOG_LEVEL);
+
+#define STACK_FILL 0xaaU
+
+/* Also fits a thread address printed with %p. */
+#ifdef CONFIG_THREAD_NAME
+#define NAME_LEN MAX(CONFIG_THREAD_MAX_NAME_LEN, sizeof(void *) * 2 + 3)
+#else
+#define NAME_LEN (sizeof(void *) * 2 + 3)
+#endif
+
+#ifdef CONFIG_THREAD_ANALYZER_MONITOR_STATS
+STATS_SECT_START(thread_monitor)
+STATS_SECT_ENTRY32(cpu)
+STATS_SECT_ENTRY32(cpu_max)
+STATS_SECT_ENTRY32(stack_used)
+STATS_SECT_ENTRY32(stack_size)
+STATS_SECT_END;
+
+STATS_NAME_START(thread_monitor)
+STATS_NAME(thread_monitor, cpu)
+STATS_NAME(thread_monitor, cpu_max)
+STATS_NAME(thread_monitor, stack_used)
+STATS_NAME(thread_monitor, stack_size)
+STATS_NAME_END(thread_monitor);
+#endif
+
+struct monitor_slot {
+	/* NULL if the slot is free. */
+	const struct k_thread *thread;
+	/* Execution cycles of the thread at the end of the last window. */
+	uint64_t cycles;
+	/* Stack bytes below the high-water mark. */
+	size_t unused;
+	size_t stack_size;
+	uint8_t utilization;
+	uint8_t utilization_max;
+	bool seen;
+	char name[NAME_LEN];
+#ifdef CONFIG_THREAD_ANALYZER_MONITOR_STATS
+	STATS_SECT_DECL(thread_monitor) stats;
+	bool registered;
+#endif
+};
+
+static struct monitor_slot slots[CONFIG_THREAD_ANALYZER_MONITOR_THREADS];
+static uint64_t all_cycles;
+static uint64_t window_cycles;
+static uint32_t window;
+static struct k_work_delayable monitor_work;
+static K_MUTEX_DEFINE(monitor_lock);
+
+static const uint8_t *stack_start(const struct k_thread *thread, size_t *size)
+{
+	const uint8_t *start = (const uint8_t *)thread->stack_info.start;
+
+	*size = thread->stack_info.size;
+
+	/* First 4 bytes of the stack buffer reserved for the sentinel. */
+	if (IS_ENABLED(CONFIG_STACK_SENTINEL)) {
+		start += 4;
+		*size -= 4;
+	}
+
+	return start;
+}
+
+static size_t stack_unused_full(const uint8_t *start, size_t size)
+{
+	size_t unused = 0;
+
+	while (unused < size && start[unused] == STACK_FILL) {
+		unused++;
+	}
+
+	return unused;
+}
+
+/* Stacks grow down: the area used since the last window lies right below
+ * the previous high-water mark. It ends where the stack is still untouched
+ * over the configured gap.
+ */
+static size_t stack_unused_delta(const uint8_t *start, size_t unused)
+{
+	size_t clean = 0;
+	size_t i = unused;
+
+	while (i > 0 && clean < CONFIG_THREAD_ANALYZER_MONITOR_STACK_GAP) {
+		i--;
+		if (start[i] == STACK_FILL) {
+			clean++;
+		} else {
+			clean = 0;
+			unused = i;
+		}
+	}
+
+	return unused;
+}
+
+static void stack_update(struct monitor_slot *slot,
+			 const struct k_thread *thread, bool full)
+{
+	const uint8_t *start;
+	size_t size;
+
+	/* Same restriction as k_thread_stack_space_get(). */
+	if (IS_ENABLED(CONFIG_NO_UNUSED_STACK_INSPECTION) &&
+	    thread == k_current_get()) {
+		return;
+	}
+
+	start = stack_start(thread, &size);
+	slot->unused = MIN(slot->unused, size);
+
+	if (full) {
+		slot->unused = stack_unused_full(start, size);
+	} else {
+		slot->unused = stack_unused_delta(start, slot->unused);
+	}
+}
+
+/* Not known until the stack of the thread could be scanned once. */
+static size_t slot_stack_used(const struct monitor_slot *slot)
+{
+	return slot->unused == SIZE_MAX ? 0 : slot->stack_size - slot->unused;
+}
+
+#ifdef CONFIG_THREAD_ANALYZER_MONITOR_STATS
+static void stats_update(struct monitor_slot *slot,
+			 const struct k_thread *thread)
+{
+	struct stats_hdr *hdr;
+	int err;
+
+	/* The group name must be unique, the thread names need not be. */
+	hdr = stats_group_find(slot->name);
+	if (hdr != NULL && hdr != &slot->stats.s_hdr) {
+		snprintk(slot->name, sizeof(slot->name), "%p", (void *)thread);
+	}
+
+	if (!slot->registered) {
+		err = STATS_INIT_AND_REG(slot->stats, STATS_SIZE_32,
+					 slot->name);
+		if (err) {
+			LOG_WRN("Cannot register stats of %s (%d)",
+				log_strdup(slot->name), err);
+			return;
+		}
+
+		slot->registered = true;
+	}
+
+	STATS_CLEAR(slot->stats, cpu);
+	STATS_INCN(slot->stats, cpu, slot->utilization);
+	STATS_CLEAR(slot->stats, cpu_max);
+	STATS_INCN(slot->stats, cpu_max, slot->utilization_max);
+	STATS_CLEAR(slot->stats, stack_used);
+	STATS_INCN(slot->stats, stack_used, slot_stack_used(slot));
+	STATS_CLEAR(slot->stats, stack_size);
+	STATS_INCN(slot->stats, stack_size, slot->stack_size);
+}
+#endif /* CONFIG_THREAD_ANALYZER_MONITOR_STATS */
+
+static struct monitor_slot *slot_get(const struct k_thread *thread,
+				     uint64_t cycles)
+{
+	struct monitor_slot *free_slot = NULL;
+	const char *name;
+
+	for (int i = 0; i < ARRAY_SIZE(slots); i++) {
+		if (slots[i].thread == thread) {
+			return &slots[i];
+		}
+
+		if (slots[i].thread == NULL && free_slot == NULL) {
+			free_slot = &slots[i];
+		}
+	}
+
+	if (free_slot == NULL) {
+		return NULL;
+	}
+
+	free_slot->thread = thread;
+	free_slot->cycles = cycles;
+	free_slot->unused = SIZE_MAX;
+	free_slot->stack_size = thread->stack_info.size;
+	free_slot->utilization = 0;
+	free_slot->utilization_max = 0;
+
+	name = k_thread_name_get((k_tid_t)thread);
+	if (name != NULL && name[0] != '\0') {
+		strncpy(free_slot->name, name, sizeof(free_slot->name) - 1);
+		free_slot->name[sizeof(free_slot->name) - 1] = '\0';
+	} else {
+		snprintk(free_slot->name, sizeof(free_slot->name), "%p",
+			 (void *)thread);
+	}
+
+	return free_slot;
+}
+
+static void thread_monitor_cb(const struct k_thread *thread, void *user_data)
+{
+	k_thread_runtime_stats_t rt_stats;
+	struct monitor_slot *slot;
+	uint64_t delta;
+	bool full;
+
+	ARG_UNUSED(user_data);
+
+	if (k_thread_runtime_stats_get((k_tid_t)thread, &rt_stats) != 0) {
+		return;
+	}
+
+	slot = slot_get(thread, rt_stats.execution_cycles);
+	if (slot == NULL) {
+		return;
+	}
+
+	slot->seen = true;
+
+	delta = rt_stats.execution_cycles - slot->cycles;
+	slot->cycles = rt_stats.execution_cycles;
+	if (window_cycles != 0) {
+		slot->utilization = MIN(delta * 100U / window_cycles, 100);
+		slot->utilization_max = MAX(slot->utilization_max,
+					    slot->utilization);
+	}
+
+	/* Spread the full scans of the threads over the windows. A new
+	 * thread is first scanned from the top of its stack, which costs
+	 * its used area only.
+	 */
+	full = false;
+	if (CONFIG_THREAD_ANALYZER_MONITOR_FULL_SCAN > 0) {
+		full = ((window + (slot - slots)) %
+			CONFIG_THREAD_ANALYZER_MONITOR_FULL_SCAN) == 0;
+	}
+
+	stack_update(slot, thread, full);
+
+#ifdef CONFIG_THREAD_ANALYZER_MONITOR_STATS
+	stats_update(slot, thread);
+#endif
+}
+
+static void monitor_work_handler(struct k_work *work)
+{
+	k_thread_runtime_stats_t rt_stats;
+
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&monitor_lock, K_FOREVER);
+
+	if (k_thread_runtime_stats_all_get(&rt_stats) == 0) {
+		window_cycles = rt_stats.execution_cycles - all_cycles;
+		all_cycles = rt_stats.execution_cycles;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(slots); i++) {
+		slots[i].seen = false;
+	}
+
+	if (IS_ENABLED(CONFIG_THREAD_ANALYZER_RUN_UNLOCKED)) {
+		k_thread_foreach_unlocked(thread_monitor_cb, NULL);
+	} else {
+		k_thread_foreach(thread_monitor_cb, NULL);
+	}
+
+	/* Release the slots of the threads which exited. */
+	for (int i = 0; i < ARRAY_SIZE(slots); i++) {
+		if (slots[i].thread != NULL && !slots[i].seen) {
+			slots[i].thread = NULL;
+#ifdef CONFIG_THREAD_ANALYZER_MONITOR_STATS
+			if (slots[i].registered) {
+				stats_reset(&slots[i].stats.s_hdr);
+			}
+#endif
+		}
+	}
+
+	window++;
+
+	k_mutex_unlock(&monitor_lock);
+
+	k_work_reschedule(&monitor_work,
+			  K_MSEC(CONFIG_THREAD_ANALYZER_MONITOR_INTERVAL));
+}
+
+void thread_analyzer_monitor_get(thread_analyzer_cb cb)
+{
+	struct thread_analyzer_info info;
+	struct monitor_slot *slot;
+
+	k_mutex_lock(&monitor_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(slots); i++) {
+		slot = &slots[i];
+		if (slot->thread == NULL) {
+			continue;
+		}
+
+		info.name = slot->name;
+		info.stack_size = slot->stack_size;
+		info.stack_used = slot_stack_used(slot);
+		info.utilization = slot->utilization;
+		cb(&info);
+	}
+
+	k_mutex_unlock(&monitor_lock);
+}
+
+static int thread_analyzer_monitor_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_work_init_delayable(&monitor_work, monitor_work_handler);
+	k_work_schedule(&monitor_work,
+			K_MSEC(CONFIG_THREAD_ANALYZER_MONITOR_INTERVAL));
+
+	return 0;
+}
+
+SYS_INIT(thread_analyzer_monitor_init, APPLICATION,
+	 CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * LZ4-compressed RAM backing store implementation
+ */
+#include <mmu.h>
+#include <string.h>
+#include <kernel_arch_interface.h>
+#include <lz4.h>
+
+/*
+ * Data pages are compressed with LZ4 into a pool of RAM, divided into
+ * fixed-size blocks. A compressed data page takes as many blocks as needed,
+ * chained together, so the pool never fragments. Data pages which do not
+ * compress by at least one block are stored as-is.
+ *
+ * Location tokens are indexes into a table of slots, each holding the
+ * first block and the length of one data page. As the compressed size is
+ * only known at page-out time, obtaining a location reserves enough blocks
+ * for an uncompressed page, and the page-out returns what was not used.
+ * Like the RAM test backing store, locations are freed as soon as data
+ * pages are paged in, so Z_PAGE_FRAME_BACKED is never set.
+ *
+ * Anonymous memory tends to compress well, which lets this hold several
+ * times as many data pages as the same amount of uncompressed RAM.
+ */
+
+#define BLOCK_SIZE	CONFIG_BACKING_STORE_COMPRESSED_BLOCK_SIZE
+#define NUM_BLOCKS	(CONFIG_BACKING_STORE_COMPRESSED_SIZE / BLOCK_SIZE)
+#define PAGE_BLOCKS	(CONFIG_MMU_PAGE_SIZE / BLOCK_SIZE)
+#define NUM_SLOTS	CONFIG_BACKING_STORE_COMPRESSED_PAGES
+#define INDEX_NONE	UINT16_MAX
+
+BUILD_ASSERT(CONFIG_MMU_PAGE_SIZE % BLOCK_SIZE == 0,
+	     "block size must divide the page size");
+BUILD_ASSERT(NUM_BLOCKS >= 2 * PAGE_BLOCKS,
+	     "pool must hold at least two uncompressed pages");
+BUILD_ASSERT(NUM_BLOCKS < INDEX_NONE && NUM_SLOTS < INDEX_NONE);
+
+struct slot {
+	/* First block of the data page, or next free slot */
+	uint16_t first;
+
+	/* Stored length, 0 if not paged out yet, or CONFIG_MMU_PAGE_SIZE
+	 * if stored uncompressed
+	 */
+	uint16_t len;
+};
+
+static char pool[NUM_BLOCKS][BLOCK_SIZE];
+static uint16_t block_next[NUM_BLOCKS];
+static uint16_t free_block_head;
+static unsigned int free_blocks;
+static unsigned int reserved_blocks;
+
+static struct slot slots[NUM_SLOTS];
+static uint16_t free_slot_head;
+static unsigned int free_slots;
+
+static LZ4_stream_t lz4_state;
+static char compress_buf[CONFIG_MMU_PAGE_SIZE];
+
+static struct slot *location_to_slot(uintptr_t location)
+{
+	__ASSERT(location < NUM_SLOTS, "bad location 0x%lx", location);
+
+	return &slots[location];
+}
+
+static void blocks_free(uint16_t block)
+{
+	while (block != INDEX_NONE) {
+		uint16_t next = block_next[block];
+
+		block_next[block] = free_block_head;
+		free_block_head = block;
+		free_blocks++;
+		block = next;
+	}
+}
+
+/* Copy len bytes to a chain of newly allocated blocks, returning the
+ * first one
+ */
+static uint16_t blocks_store(const char *src, size_t len)
+{
+	uint16_t first = INDEX_NONE, *link = &first;
+
+	for (size_t off = 0; off < len; off += BLOCK_SIZE) {
+		uint16_t block = free_block_head;
+
+		__ASSERT(block != INDEX_NONE, "block count mismatch");
+		free_block_head = block_next[block];
+		free_blocks--;
+
+		(void)memcpy(pool[block], src + off,
+			     MIN(BLOCK_SIZE, len - off));
+		*link = block;
+		link = &block_next[block];
+	}
+	*link = INDEX_NONE;
+
+	return first;
+}
+
+static void blocks_load(char *dst, uint16_t block, size_t len)
+{
+	for (size_t off = 0; off < len; off += BLOCK_SIZE) {
+		__ASSERT(block != INDEX_NONE, "truncated block chain");
+		(void)memcpy(dst + off, pool[block],
+			     MIN(BLOCK_SIZE, len - off));
+		block = block_next[block];
+	}
+}
+
+int k_mem_paging_backing_store_location_get(struct z_page_frame *pf,
+					    uintptr_t *location,
+					    bool page_fault)
+{
+	unsigned int needed = page_fault ? PAGE_BLOCKS : 2 * PAGE_BLOCKS;
+	uint16_t index;
+
+	/* Keep a slot and room for an uncompressed page for page faults */
+	if ((!page_fault && free_slots == 1) || free_slots == 0 ||
+	    free_blocks - reserved_blocks < needed) {
+		return -ENOMEM;
+	}
+
+	index = free_slot_head;
+	free_slot_head = slots[index].first;
+	free_slots--;
+
+	slots[index].first = INDEX_NONE;
+	slots[index].len = 0U;
+	reserved_blocks += PAGE_BLOCKS;
+	*location = index;
+
+	return 0;
+}
+
+void k_mem_paging_backing_store_location_free(uintptr_t location)
+{
+	struct slot *slot = location_to_slot(location);
+
+	if (slot->len == 0U) {
+		/* Never paged out, still holding its reservation */
+		reserved_blocks -= PAGE_BLOCKS;
+	} else {
+		blocks_free(slot->first);
+	}
+
+	slot->first = free_slot_head;
+	free_slot_head = location;
+	free_slots++;
+}
+
+void k_mem_paging_backing_store_page_out(uintptr_t location)
+{
+	struct slot *slot = location_to_slot(location);
+	const char *src = compress_buf;
+	int len;
+
+	__ASSERT(slot->len == 0U, "location 0x%lx already in use", location);
+
+	len = LZ4_compress_fast_extState(&lz4_state, Z_SCRATCH_PAGE,
+					 compress_buf, CONFIG_MMU_PAGE_SIZE,
+					 CONFIG_MMU_PAGE_SIZE - BLOCK_SIZE, 1);
+	if (len <= 0) {
+		/* Would not save anything */
+		src = Z_SCRATCH_PAGE;
+		len = CONFIG_MMU_PAGE_SIZE;
+	}
+
+	reserved_blocks -= PAGE_BLOCKS;
+	slot->first = blocks_store(src, len);
+	slot->len = len;
+}
+
+void k_mem_paging_backing_store_page_in(uintptr_t location)
+{
+	struct slot *slot = location_to_slot(location);
+	int ret;
+
+	__ASSERT(slot->len != 0U, "location 0x%lx never paged out", location);
+
+	if (slot->len == CONFIG_MMU_PAGE_SIZE) {
+		blocks_load(Z_SCRATCH_PAGE, slot->first, slot->len);
+		return;
+	}
+
+	blocks_load(compress_buf, slot->first, slot->len);
+	ret = LZ4_decompress_safe(compress_buf, Z_SCRATCH_PAGE, slot->len,
+				  CONFIG_MMU_PAGE_SIZE);
+	__ASSERT(ret == CONFIG_MMU_PAGE_SIZE,
+		 "corrupted data page at location 0x%lx", location);
+	(void)ret;
+}
+
+void k_mem_paging_backing_store_page_finalize(struct z_page_frame *pf,
+					      uintptr_t location)
+{
+	k_mem_paging_backing_store_location_free(location);
+}
+
+void k_mem_paging_backing_store_init(void)
+{
+	for (uint16_t i = 0U; i < NUM_BLOCKS; i++) {
+		block_next[i] = i + 1U;
+	}
+	block_next[NUM_BLOCKS - 1] = INDEX_NONE;
+	free_block_head = 0U;
+	free_blocks = NUM_BLOCKS;
+	reserved_blocks = 0U;
+
+	for (uint16_t i = 0U; i < NUM_SLOTS; i++) {
+		slots[i].first = i + 1U;
+		slots[i].len = 0U;
+	}
+	slots[NUM_SLOTS - 1].first = INDEX_NONE;
+	free_slot_head = 0U;
+	free_slots = NUM_SLOTS;
+}
@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Flash partition backing store implementation
+ */
+#include <mmu.h>
+#include <string.h>
+#include <kernel_arch_interface.h>
+#include <drivers/flash.h>
+#include <storage/flash_map.h>
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
+
+/*
+ * This is a large, sparse backing store: the partition labeled
+ * "backing-store-partition" in devicetree mirrors the virtual address
+ * space, and the location token of a data page is simply its offset from
+ * Z_VIRT_RAM_START. No space management is necessary, and the flash copy
+ * of a data page stays valid after it is paged in, so Z_PAGE_FRAME_BACKED
+ * is set and clean pages are never written back. This saves both time and
+ * flash wear.
+ *
+ * As neighbouring data pages have neighbouring locations, a page-in also
+ * queues reading the next CONFIG_BACKING_STORE_FLASH_READ_AHEAD pages
+ * into RAM buffers, if they are paged out. This is done from the system
+ * work queue, one page at a time with interrupts locked, which keeps
+ * flash accesses serialized with those made on behalf of page faults.
+ * A page-in finding its data in one of these buffers is a copy instead of
+ * a flash read.
+ *
+ * The flash driver and everything it uses must be pinned in memory.
+ */
+
+#if !FLASH_AREA_LABEL_EXISTS(backing_store_partition)
+#error "Need a fixed partition named 'backing-store-partition'!"
+#endif
+
+#define FLASH_PARTITION		FLASH_AREA_ID(backing_store_partition)
+
+static const struct flash_area *flash_area;
+
+#if CONFIG_BACKING_STORE_FLASH_READ_AHEAD > 0
+enum ra_state {
+	RA_FREE,
+	RA_PENDING,
+	RA_VALID,
+};
+
+struct ra_entry {
+	uintptr_t location;
+	enum ra_state state;
+};
+
+static char
+	ra_bufs[CONFIG_BACKING_STORE_FLASH_READ_AHEAD][CONFIG_MMU_PAGE_SIZE];
+static struct ra_entry ra_entries[CONFIG_BACKING_STORE_FLASH_READ_AHEAD];
+
+/* Next entry to recycle when all are in use */
+static unsigned int ra_next;
+
+static struct ra_entry *ra_find(uintptr_t location)
+{
+	for (int i = 0; i < ARRAY_SIZE(ra_entries); i++) {
+		if (ra_entries[i].state != RA_FREE &&
+		    ra_entries[i].location == location) {
+			return &ra_entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void ra_work_handler(struct k_work *work)
+{
+	for (int i = 0; i < ARRAY_SIZE(ra_entries); i++) {
+		struct ra_entry *entry = &ra_entries[i];
+		int key = irq_lock();
+
+		/* Page faults may have consumed, invalidated or recycled
+		 * the entry since it was queued
+		 */
+		if (entry->state == RA_PENDING) {
+			if (flash_area_read(flash_area, entry->location,
+					    ra_bufs[i],
+					    CONFIG_MMU_PAGE_SIZE) == 0) {
+				entry->state = RA_VALID;
+			} else {
+				entry->state = RA_FREE;
+			}
+		}
+
+		irq_unlock(key);
+	}
+}
+
+static K_WORK_DEFINE(ra_work, ra_work_handler);
+
+/* Queue reading the data pages following the one at location, if they
+ * would otherwise fault
+ */
+static void ra_schedule(uintptr_t location)
+{
+	bool queued = false;
+
+	for (int i = 1; i <= CONFIG_BACKING_STORE_FLASH_READ_AHEAD; i++) {
+		uintptr_t next = location + (i * CONFIG_MMU_PAGE_SIZE);
+		uint8_t *addr = Z_VIRT_RAM_START + next;
+		struct ra_entry *entry;
+		uintptr_t cur;
+
+		if (addr >= Z_VIRT_RAM_END ||
+		    next + CONFIG_MMU_PAGE_SIZE > flash_area->fa_size) {
+			break;
+		}
+
+		if (arch_page_location_get(addr, &cur) !=
+		    ARCH_PAGE_LOCATION_PAGED_OUT) {
+			/* Resident or unmapped, a gap ends the sequence */
+			break;
+		}
+
+		if (ra_find(next) != NULL) {
+			continue;
+		}
+
+		entry = &ra_entries[ra_next];
+		ra_next = (ra_next + 1) % ARRAY_SIZE(ra_entries);
+		entry->location = next;
+		entry->state = RA_PENDING;
+		queued = true;
+	}
+
+	if (queued) {
+		k_work_submit(&ra_work);
+	}
+}
+
+/* Copy the data page at location to Z_SCRATCH_PAGE if it was read
+ * ahead, returning whether it was
+ */
+static bool ra_page_in(uintptr_t location)
+{
+	struct ra_entry *entry = ra_find(location);
+
+	if (entry == NULL) {
+		return false;
+	}
+
+	if (entry->state != RA_VALID) {
+		/* Not read yet, the caller reads it right away instead */
+		entry->state = RA_FREE;
+		return false;
+	}
+
+	(void)memcpy(Z_SCRATCH_PAGE, ra_bufs[entry - ra_entries],
+		     CONFIG_MMU_PAGE_SIZE);
+	entry->state = RA_FREE;
+
+	return true;
+}
+
+static void ra_invalidate(uintptr_t location)
+{
+	struct ra_entry *entry = ra_find(location);
+
+	if (entry != NULL) {
+		entry->state = RA_FREE;
+	}
+}
+#else
+static inline void ra_schedule(uintptr_t location)
+{
+}
+
+static inline bool ra_page_in(uintptr_t location)
+{
+	return false;
+}
+
+static inline void ra_invalidate(uintptr_t location)
+{
+}
+#endif /* CONFIG_BACKING_STORE_FLASH_READ_AHEAD > 0 */
+
+int k_mem_paging_backing_store_location_get(struct z_page_frame *pf,
+					    uintptr_t *location,
+					    bool page_fault)
+{
+	uintptr_t offset = (uint8_t *)pf->addr - Z_VIRT_RAM_START;
+
+	/* Every data page has its own location, whether this is for a
+	 * page fault or not makes no difference
+	 */
+	if (offset + CONFIG_MMU_PAGE_SIZE > flash_area->fa_size) {
+		return -ENOMEM;
+	}
+
+	*location = offset;
+
+	return 0;
+}
+
+void k_mem_paging_backing_store_location_free(uintptr_t location)
+{
+	/* Locations are never shared, nothing to manage */
+}
+
+void k_mem_paging_backing_store_page_out(uintptr_t location)
+{
+	int ret;
+
+	ra_invalidate(location);
+
+	ret = flash_area_erase(flash_area, location, CONFIG_MMU_PAGE_SIZE);
+	if (ret == 0) {
+		ret = flash_area_write(flash_area, location, Z_SCRATCH_PAGE,
+				       CONFIG_MMU_PAGE_SIZE);
+	}
+	__ASSERT(ret == 0, "page out to 0x%lx failed: %d", location, ret);
+	(void)ret;
+}
+
+void k_mem_paging_backing_store_page_in(uintptr_t location)
+{
+	int ret;
+
+	if (!ra_page_in(location)) {
+		ret = flash_area_read(flash_area, location, Z_SCRATCH_PAGE,
+				      CONFIG_MMU_PAGE_SIZE);
+		__ASSERT(ret == 0, "page in from 0x%lx failed: %d", location,
+			 ret);
+		(void)ret;
+	}
+
+	ra_schedule(location);
+}
+
+void k_mem_paging_backing_store_page_finalize(struct z_page_frame *pf,
+					      uintptr_t location)
+{
+	/* The flash copy is kept, no need to write it again unless the
+	 * data page is modified
+	 */
+	pf->flags |= Z_PAGE_FRAME_BACKED;
+}
+
+void k_mem_paging_backing_store_init(void)
+{
+	struct flash_pages_info info;
+	int ret;
+
+	ret = flash_area_open(FLASH_PARTITION, &flash_area);
+	__ASSERT(ret == 0, "cannot open backing store partition: %d", ret);
+
+	ret = flash_get_page_info_by_offs(flash_area_get_device(flash_area),
+					  flash_area->fa_off, &info);
+	__ASSERT(ret == 0 && (CONFIG_MMU_PAGE_SIZE % info.size) == 0 &&
+		 (flash_area->fa_off % info.size) == 0,
+		 "flash pages must tile data pages");
+	(void)ret;
+
+	if (flash_area->fa_size < Z_VIRT_RAM_SIZE) {
+		LOG_WRN("backing store partition only covers %zu of %zu bytes of virtual memory",
+			flash_area->fa_size, Z_VIRT_RAM_SIZE);
+	}
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Approximate Least Recently Used (LRU) eviction algorithm for demand paging
+ */
+#include <kernel.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+
+/* LRU is approximated by "aging": each page frame has an 8-bit age
+ * which a periodic timer shifts right, shifting in the accessed state
+ * of its data page at the top before clearing it.  The age then holds
+ * whether the page was used during each of the last eight periods,
+ * the most recent one being the most significant bit, and the page
+ * frame with the lowest age is the least recently used one.
+ *
+ * A page accessed since the last period is considered more recently
+ * used than any other, as such pages may have been paged in after
+ * that period and carry a stale age.  Ties are broken in favor of
+ * evicting clean pages.
+ */
+static uint8_t lru_ages[Z_NUM_PAGE_FRAMES];
+
+static void lru_periodic_update(struct k_timer *timer)
+{
+	uintptr_t flags, phys;
+	struct z_page_frame *pf;
+	int key = irq_lock();
+
+	Z_PAGE_FRAME_FOREACH(phys, pf) {
+		uint8_t *age = &lru_ages[pf - z_page_frames];
+
+		if (!z_page_frame_is_evictable(pf)) {
+			/* Any data page mapped here later starts afresh */
+			*age = 0U;
+			continue;
+		}
+
+		/* Clear accessed bit in page tables */
+		flags = arch_page_info_get(pf->addr, NULL, true);
+
+		*age >>= 1;
+		if ((flags & ARCH_DATA_PAGE_ACCESSED) != 0UL) {
+			*age |= BIT(7);
+		}
+	}
+
+	irq_unlock(key);
+}
+
+struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	unsigned int last_rank = UINT_MAX;
+	struct z_page_frame *last_pf = NULL, *pf;
+	bool accessed;
+	bool dirty = false;
+	uintptr_t flags, phys;
+
+	Z_PAGE_FRAME_FOREACH(phys, pf) {
+		unsigned int rank;
+
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		flags = arch_page_info_get(pf->addr, NULL, false);
+		accessed = (flags & ARCH_DATA_PAGE_ACCESSED) != 0UL;
+
+		/* Implies a mismatch with page frame ontology and page
+		 * tables
+		 */
+		__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0U,
+			 "non-present page, %s",
+			 ((flags & ARCH_DATA_PAGE_NOT_MAPPED) != 0U) ?
+			 "un-mapped" : "paged out");
+
+		rank = ((accessed ? BIT(8) : 0U) | lru_ages[pf - z_page_frames])
+		       << 1;
+		rank |= ((flags & ARCH_DATA_PAGE_DIRTY) != 0UL) ? 1U : 0U;
+
+		if (rank < last_rank) {
+			last_rank = rank;
+			last_pf = pf;
+			dirty = (rank & 1U) != 0U;
+
+			if (rank == 0U) {
+				/* Unused for eight periods and clean */
+				break;
+			}
+		}
+	}
+	/* Shouldn't ever happen unless every page is pinned */
+	__ASSERT(last_pf != NULL, "no page to evict");
+
+	*dirty_ptr = dirty;
+
+	return last_pf;
+}
+
+static K_TIMER_DEFINE(lru_timer, lru_periodic_update, NULL);
+
+void k_mem_paging_eviction_init(void)
+{
+	k_timer_start(&lru_timer, K_NO_WAIT,
+		      K_MSEC(CONFIG_EVICTION_LRU_PERIOD));
+}
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <dfu/flash_img_delta.h>
+#include <storage/flash_map.h>
+#include <sys/byteorder.h>
+
+#ifdef CONFIG_TRUSTED_EXECUTION_NONSECURE
+#define SOURCE_FLASH_AREA_ID FLASH_AREA_ID(image_0_nonsecure)
+#else
+#define SOURCE_FLASH_AREA_ID FLASH_AREA_ID(image_0)
+#endif
+
+#define HASH_SIZE 32
+#define COPY_CMD_SIZE 9
+#define INSERT_CMD_SIZE 5
+
+enum delta_state {
+	/* Receiving the magic number, or the beginning of a full image. */
+	DELTA_MAGIC,
+	/* Receiving a full image. */
+	DELTA_RAW,
+	DELTA_HEADER,
+	DELTA_CMD,
+	/* Receiving the data of an insert command. */
+	DELTA_INSERT,
+	DELTA_DONE,
+};
+
+/* Bytes the header or the current command takes. */
+static size_t hdr_size(const struct flash_img_delta *delta)
+{
+	switch (delta->state) {
+	case DELTA_MAGIC:
+		return sizeof(uint32_t);
+	case DELTA_HEADER:
+		return FLASH_IMG_DELTA_HDR_SIZE;
+	default:
+		break;
+	}
+
+	if (delta->hdr_len == 0) {
+		return 1;
+	}
+
+	switch (delta->hdr[0]) {
+	case FLASH_IMG_DELTA_OP_COPY:
+		return COPY_CMD_SIZE;
+	case FLASH_IMG_DELTA_OP_INSERT:
+		return INSERT_CMD_SIZE;
+	default:
+		return 1;
+	}
+}
+
+static int source_open(struct flash_img_delta *delta)
+{
+	struct flash_area_check fac;
+	int rc;
+
+	rc = flash_area_open(SOURCE_FLASH_AREA_ID, &delta->source);
+	if (rc) {
+		return rc;
+	}
+
+	if (delta->source->fa_id == delta->target_id) {
+		return -ENOTSUP;
+	}
+
+	if (delta->source_size > delta->source->fa_size ||
+	    delta->target_size > delta->img->flash_area->fa_size) {
+		return -EBADMSG;
+	}
+
+	/* The patch must have been made against the image in the slot. */
+	fac.match = &delta->hdr[16];
+	fac.clen = delta->source_size;
+	fac.off = 0;
+	fac.rbuf = delta->buf;
+	fac.rblen = sizeof(delta->buf);
+
+	if (flash_area_check_int_sha256(delta->source, &fac)) {
+		return -EBADMSG;
+	}
+
+	return 0;
+}
+
+static int copy(struct flash_img_delta *delta, uint32_t off, uint32_t len)
+{
+	size_t chunk;
+	int rc;
+
+	if (len > delta->source_size || off > delta->source_size - len) {
+		return -EBADMSG;
+	}
+
+	while (len > 0) {
+		chunk = MIN(len, sizeof(delta->buf));
+
+		rc = flash_area_read(delta->source, off, delta->buf, chunk);
+		if (rc) {
+			return rc;
+		}
+
+		rc = flash_img_buffered_write(delta->img, delta->buf, chunk,
+					      false);
+		if (rc) {
+			return rc;
+		}
+
+		off += chunk;
+		len -= chunk;
+	}
+
+	return 0;
+}
+
+/* Act on the complete header, or command. */
+static int hdr_process(struct flash_img_delta *delta)
+{
+	uint8_t *hdr = delta->hdr;
+	int rc = 0;
+
+	switch (delta->state) {
+	case DELTA_MAGIC:
+		if (sys_get_le32(hdr) == FLASH_IMG_DELTA_MAGIC) {
+			delta->patch = true;
+			delta->state = DELTA_HEADER;
+			return 0;
+		}
+
+		delta->state = DELTA_RAW;
+		rc = flash_img_buffered_write(delta->img, hdr, delta->hdr_len,
+					      false);
+		break;
+	case DELTA_HEADER:
+		delta->source_size = sys_get_le32(&hdr[4]);
+		delta->target_size = sys_get_le32(&hdr[8]);
+		memcpy(delta->target_hash, &hdr[16 + HASH_SIZE], HASH_SIZE);
+
+		if (sys_get_le32(&hdr[12]) != 0) {
+			return -EBADMSG;
+		}
+
+		rc = source_open(delta);
+		delta->state = DELTA_CMD;
+		break;
+	case DELTA_CMD:
+		if (hdr[0] == FLASH_IMG_DELTA_OP_COPY) {
+			rc = copy(delta, sys_get_le32(&hdr[1]),
+				  sys_get_le32(&hdr[5]));
+		} else if (hdr[0] == FLASH_IMG_DELTA_OP_INSERT) {
+			delta->insert_len = sys_get_le32(&hdr[1]);
+			if (delta->insert_len > 0) {
+				delta->state = DELTA_INSERT;
+			}
+		} else {
+			rc = -EBADMSG;
+		}
+		break;
+	default:
+		break;
+	}
+
+	delta->hdr_len = 0;
+
+	return rc;
+}
+
+static int finish(struct flash_img_delta *delta)
+{
+	struct flash_img_check fic;
+	int rc;
+
+	switch (delta->state) {
+	case DELTA_MAGIC:
+		/* Shorter than the magic number. */
+		return flash_img_buffered_write(delta->img, delta->hdr,
+						delta->hdr_len, true);
+	case DELTA_RAW:
+		return flash_img_buffered_write(delta->img, NULL, 0, true);
+	case DELTA_CMD:
+		if (delta->hdr_len == 0) {
+			break;
+		}
+		__fallthrough;
+	default:
+		/* Truncated patch. */
+		return -EBADMSG;
+	}
+
+	rc = flash_img_buffered_write(delta->img, NULL, 0, true);
+	if (rc) {
+		return rc;
+	}
+
+	if (flash_img_bytes_written(delta->img) != delta->target_size) {
+		return -EBADMSG;
+	}
+
+	fic.match = delta->target_hash;
+	fic.clen = delta->target_size;
+
+	if (flash_img_check(delta->img, &fic, delta->target_id)) {
+		return -EIO;
+	}
+
+	return 0;
+}
+
+int flash_img_delta_init(struct flash_img_delta *delta,
+			 struct flash_img_context *img)
+{
+	if (img->flash_area == NULL) {
+		return -EINVAL;
+	}
+
+	delta->img = img;
+	delta->source = NULL;
+	delta->target_id = img->flash_area->fa_id;
+	delta->state = DELTA_MAGIC;
+	delta->patch = false;
+	delta->hdr_len = 0;
+	delta->received = 0;
+
+	return 0;
+}
+
+int flash_img_delta_write(struct flash_img_delta *delta, const uint8_t *data,
+			  size_t len, bool flush)
+{
+	size_t n;
+	int rc = 0;
+
+	delta->received += len;
+
+	while (len > 0 && rc == 0) {
+		switch (delta->state) {
+		case DELTA_RAW:
+			n = len;
+			rc = flash_img_buffered_write(delta->img, data, n,
+						      false);
+			break;
+		case DELTA_INSERT:
+			n = MIN(len, delta->insert_len);
+			rc = flash_img_buffered_write(delta->img, data, n,
+						      false);
+			delta->insert_len -= n;
+			if (delta->insert_len == 0) {
+				delta->state = DELTA_CMD;
+			}
+			break;
+		case DELTA_DONE:
+			n = len;
+			rc = -EBADMSG;
+			break;
+		default:
+			n = MIN(len, hdr_size(delta) - delta->hdr_len);
+			memcpy(&delta->hdr[delta->hdr_len], data, n);
+			delta->hdr_len += n;
+			if (delta->hdr_len == hdr_size(delta)) {
+				rc = hdr_process(delta);
+			}
+			break;
+		}
+
+		data += n;
+		len -= n;
+	}
+
+	if (rc == 0 && flush) {
+		rc = finish(delta);
+	}
+
+	if (rc || flush) {
+		delta->state = DELTA_DONE;
+		if (delta->source != NULL) {
+			flash_area_close(delta->source);
+			delta->source = NULL;
+		}
+	}
+
+	return rc;
+}
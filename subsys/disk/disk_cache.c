@@ -0,0 +1,377 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <kernel.h>
+#include <sys/util.h>
+#include <storage/disk_access.h>
+
+#include "disk_cache.h"
+
+#define LOG_LEVEL CONFIG_DISK_LOG_LEVEL
+#include <logging/log.h>
+LOG_MODULE_DECLARE(disk);
+
+#define SECTOR_SIZE CONFIG_DISK_CACHE_SECTOR_SIZE
+#define BURST_SECTORS CONFIG_DISK_CACHE_BURST_SECTORS
+
+/* Transfers of this many sectors go straight to the disk, so that large
+ * sequential transfers do not evict the whole cache.
+ */
+#define STREAM_SECTORS MAX(CONFIG_DISK_CACHE_SECTORS / 2, 1)
+
+struct cache_slot {
+	/* Disk of the cached sector, NULL for a free slot */
+	struct disk_info *disk;
+	uint32_t sector;
+	/* Value of use_count at the last access, for the LRU eviction */
+	uint32_t used;
+	/* Set if the sector differs from the disk */
+	bool dirty;
+};
+
+static struct cache_slot slots[CONFIG_DISK_CACHE_SECTORS];
+static uint8_t slot_data[CONFIG_DISK_CACHE_SECTORS][SECTOR_SIZE];
+
+/* Consecutive sectors for the read-ahead and the coalesced writes */
+static uint8_t burst_buf[BURST_SECTORS][SECTOR_SIZE];
+
+static uint32_t use_count;
+
+static K_MUTEX_DEFINE(cache_lock);
+
+static inline uint8_t *slot_buf(const struct cache_slot *slot)
+{
+	return slot_data[slot - slots];
+}
+
+static inline void slot_touch(struct cache_slot *slot)
+{
+	slot->used = ++use_count;
+}
+
+static struct cache_slot *slot_find(const struct disk_info *disk,
+				    uint32_t sector)
+{
+	for (int i = 0; i < ARRAY_SIZE(slots); i++) {
+		if (slots[i].disk == disk && slots[i].sector == sector) {
+			return &slots[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct cache_slot *dirty_first(const struct disk_info *disk)
+{
+	struct cache_slot *first = NULL;
+
+	for (int i = 0; i < ARRAY_SIZE(slots); i++) {
+		if (slots[i].disk == disk && slots[i].dirty &&
+		    (!first || slots[i].sector < first->sector)) {
+			first = &slots[i];
+		}
+	}
+
+	return first;
+}
+
+/* The dirty sectors are written in order, each run of consecutive ones with
+ * a single multi-sector write.
+ */
+static int cache_flush(struct disk_info *disk)
+{
+	struct cache_slot *slot;
+	uint32_t sector;
+	uint32_t count;
+	int rc;
+
+	while ((slot = dirty_first(disk)) != NULL) {
+		sector = slot->sector;
+		count = 0U;
+
+		do {
+			memcpy(burst_buf[count], slot_buf(slot), SECTOR_SIZE);
+			count++;
+			slot = slot_find(disk, sector + count);
+		} while (count < BURST_SECTORS && slot && slot->dirty);
+
+		rc = disk->ops->write(disk, burst_buf[0], sector, count);
+		if (rc != 0) {
+			LOG_ERR("Failed to write %u sectors at %u (%d)",
+				count, sector, rc);
+			return rc;
+		}
+
+		for (uint32_t i = 0U; i < count; i++) {
+			slot_find(disk, sector + i)->dirty = false;
+		}
+	}
+
+	return 0;
+}
+
+static void cache_drop(const struct disk_info *disk, uint32_t start,
+		       uint32_t count)
+{
+	for (int i = 0; i < ARRAY_SIZE(slots); i++) {
+		if (slots[i].disk == disk && slots[i].sector >= start &&
+		    slots[i].sector - start < count) {
+			slots[i].disk = NULL;
+			slots[i].dirty = false;
+		}
+	}
+}
+
+/* Take a free slot, or the least recently used one. Evicting a dirty sector
+ * writes all the dirty sectors of its disk, to coalesce them.
+ */
+static struct cache_slot *slot_alloc(struct disk_info *disk, uint32_t sector,
+				     int *rc)
+{
+	struct cache_slot *slot = &slots[0];
+
+	for (int i = 0; i < ARRAY_SIZE(slots); i++) {
+		if (!slots[i].disk) {
+			slot = &slots[i];
+			break;
+		}
+
+		if ((int32_t)(slots[i].used - slot->used) < 0) {
+			slot = &slots[i];
+		}
+	}
+
+	if (slot->dirty) {
+		*rc = cache_flush(slot->disk);
+		if (*rc != 0) {
+			return NULL;
+		}
+	}
+
+	slot->disk = disk;
+	slot->sector = sector;
+	slot->dirty = false;
+	slot_touch(slot);
+
+	return slot;
+}
+
+/* Keep clean copies of sectors read from the disk. Sectors already cached
+ * are left alone, they may be dirty.
+ */
+static void cache_fill(struct disk_info *disk, const uint8_t *data_buf,
+		       uint32_t start, uint32_t count)
+{
+	struct cache_slot *slot;
+	int rc;
+
+	for (uint32_t i = 0U; i < count; i++) {
+		if (slot_find(disk, start + i)) {
+			continue;
+		}
+
+		slot = slot_alloc(disk, start + i, &rc);
+		if (!slot) {
+			return;
+		}
+
+		memcpy(slot_buf(slot), data_buf + i * SECTOR_SIZE, SECTOR_SIZE);
+	}
+}
+
+static int read_missing(struct disk_info *disk, uint8_t *data_buf,
+			uint32_t start, uint32_t count, bool sequential)
+{
+	uint32_t ahead;
+	int rc;
+
+	if (start >= disk->cache_sector_count ||
+	    count > disk->cache_sector_count - start) {
+		return disk->ops->read(disk, data_buf, start, count);
+	}
+
+	/* A small read following the previous one also reads the next
+	 * sectors, expecting to be asked for them next.
+	 */
+	if (IS_ENABLED(CONFIG_DISK_CACHE_READ_AHEAD) && sequential &&
+	    count < BURST_SECTORS) {
+		ahead = MIN(BURST_SECTORS, disk->cache_sector_count - start);
+
+		rc = disk->ops->read(disk, burst_buf[0], start, ahead);
+		if (rc == 0) {
+			memcpy(data_buf, burst_buf[0], count * SECTOR_SIZE);
+			cache_fill(disk, burst_buf[0], start, ahead);
+		}
+
+		return rc;
+	}
+
+	rc = disk->ops->read(disk, data_buf, start, count);
+	if (rc == 0 && count < STREAM_SECTORS) {
+		cache_fill(disk, data_buf, start, count);
+	}
+
+	return rc;
+}
+
+int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+		    uint32_t start_sector, uint32_t num_sector)
+{
+	bool sequential = (start_sector == disk->cache_next);
+	struct cache_slot *slot;
+	uint32_t count;
+	int rc = 0;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	for (uint32_t i = 0U; i < num_sector; i += count) {
+		slot = slot_find(disk, start_sector + i);
+		if (slot) {
+			memcpy(data_buf + i * SECTOR_SIZE, slot_buf(slot),
+			       SECTOR_SIZE);
+			slot_touch(slot);
+			count = 1U;
+			continue;
+		}
+
+		/* The run of sectors missing from the cache is read at once */
+		for (count = 1U; i + count < num_sector; count++) {
+			if (slot_find(disk, start_sector + i + count)) {
+				break;
+			}
+		}
+
+		rc = read_missing(disk, data_buf + i * SECTOR_SIZE,
+				  start_sector + i, count, sequential);
+		if (rc != 0) {
+			break;
+		}
+	}
+
+	disk->cache_next = start_sector + num_sector;
+
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
+
+static int write_through(struct disk_info *disk, const uint8_t *data_buf,
+			 uint32_t start_sector, uint32_t num_sector)
+{
+	int rc;
+
+	rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+	if (rc != 0) {
+		cache_drop(disk, start_sector, num_sector);
+		return rc;
+	}
+
+	/* The cached copies become clean copies of the new data. */
+	for (int i = 0; i < ARRAY_SIZE(slots); i++) {
+		if (slots[i].disk == disk && slots[i].sector >= start_sector &&
+		    slots[i].sector - start_sector < num_sector) {
+			memcpy(slot_buf(&slots[i]),
+			       data_buf + (slots[i].sector - start_sector) *
+					  SECTOR_SIZE,
+			       SECTOR_SIZE);
+			slots[i].dirty = false;
+		}
+	}
+
+	if (num_sector < STREAM_SECTORS) {
+		cache_fill(disk, data_buf, start_sector, num_sector);
+	}
+
+	return 0;
+}
+
+int disk_cache_write(struct disk_info *disk, const uint8_t *data_buf,
+		     uint32_t start_sector, uint32_t num_sector)
+{
+	struct cache_slot *slot;
+	int rc = 0;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	if (!IS_ENABLED(CONFIG_DISK_CACHE_WRITE_BACK) ||
+	    num_sector >= STREAM_SECTORS) {
+		rc = write_through(disk, data_buf, start_sector, num_sector);
+		goto out;
+	}
+
+	for (uint32_t i = 0U; i < num_sector; i++) {
+		slot = slot_find(disk, start_sector + i);
+		if (!slot) {
+			slot = slot_alloc(disk, start_sector + i, &rc);
+			if (!slot) {
+				break;
+			}
+		}
+
+		memcpy(slot_buf(slot), data_buf + i * SECTOR_SIZE, SECTOR_SIZE);
+		slot->dirty = true;
+		slot_touch(slot);
+	}
+
+out:
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
+
+int disk_cache_sync(struct disk_info *disk)
+{
+	int rc;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+	rc = cache_flush(disk);
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
+
+void disk_cache_remove(struct disk_info *disk)
+{
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	if (disk_cache_enabled(disk)) {
+		(void)cache_flush(disk);
+		cache_drop(disk, 0U, UINT32_MAX);
+		disk->cache_sector_count = 0U;
+	}
+
+	k_mutex_unlock(&cache_lock);
+}
+
+void disk_cache_init(struct disk_info *disk)
+{
+	uint32_t sector_size = 0U;
+	uint32_t sector_count = 0U;
+
+	/* The media may have changed, forget what was cached from it. */
+	disk_cache_remove(disk);
+
+	if (disk->ops->ioctl == NULL ||
+	    disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_SIZE,
+			     &sector_size) != 0 ||
+	    disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_COUNT,
+			     &sector_count) != 0) {
+		return;
+	}
+
+	if (sector_size != SECTOR_SIZE) {
+		LOG_DBG("%s not cached, %u bytes sectors", disk->name,
+			sector_size);
+		return;
+	}
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+	disk->cache_sector_count = sector_count;
+	disk->cache_next = UINT32_MAX;
+	k_mutex_unlock(&cache_lock);
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Sector cache between disk_access and the disk drivers.
+ *
+ * Only the disks with sectors of CONFIG_DISK_CACHE_SECTOR_SIZE bytes are
+ * cached, the others are accessed directly.
+ */
+
+#ifndef ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_
+#define ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_
+
+#include <errno.h>
+#include <drivers/disk.h>
+
+#if defined(CONFIG_DISK_CACHE)
+/* Set up the cache of an initialized disk, dropping its cached sectors. */
+void disk_cache_init(struct disk_info *disk);
+
+/* Write the dirty sectors of a disk and forget about it. */
+void disk_cache_remove(struct disk_info *disk);
+
+static inline bool disk_cache_enabled(const struct disk_info *disk)
+{
+	return disk->cache_sector_count != 0U;
+}
+
+int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+		    uint32_t start_sector, uint32_t num_sector);
+
+int disk_cache_write(struct disk_info *disk, const uint8_t *data_buf,
+		     uint32_t start_sector, uint32_t num_sector);
+
+/* Write the dirty sectors of a disk. */
+int disk_cache_sync(struct disk_info *disk);
+#else
+static inline void disk_cache_init(struct disk_info *disk)
+{
+}
+
+static inline void disk_cache_remove(struct disk_info *disk)
+{
+}
+
+static inline bool disk_cache_enabled(const struct disk_info *disk)
+{
+	return false;
+}
+
+static inline int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+				  uint32_t start_sector, uint32_t num_sector)
+{
+	return -ENOTSUP;
+}
+
+static inline int disk_cache_write(struct disk_info *disk,
+				   const uint8_t *data_buf,
+				   uint32_t start_sector, uint32_t num_sector)
+{
+	return -ENOTSUP;
+}
+
+static inline int disk_cache_sync(struct disk_info *disk)
+{
+	return 0;
+}
+#endif /* CONFIG_DISK_CACHE */
+
+#endif /* ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_ */
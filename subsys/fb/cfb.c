@@ -12,6 +12,8 @@
 #include <logging/log.h>
 LOG_MODULE_REGISTER(cfb);
 
+#define GLYPH_CACHE_SIZE CONFIG_CHARACTER_FRAMEBUFFER_GLYPH_CACHE_SIZE
+
 extern const struct cfb_font __font_entry_start[];
 extern const struct cfb_font __font_entry_end[];
 
@@ -23,6 +25,20 @@ static inline uint8_t byte_reverse(uint8_t b)
 	return b;
 }
 
+/* Rectangle of pixel columns and pages, empty if x0 > x1 */
+struct cfb_area {
+	uint16_t x0;
+	uint16_t x1;
+	uint16_t p0;
+	uint16_t p1;
+};
+
+struct glyph_tag {
+	char c;
+	uint8_t font_idx;
+	bool valid;
+};
+
 struct char_framebuffer {
 	/** Pointer to a buffer in RAM */
 	uint8_t *buf;
@@ -59,10 +75,88 @@ struct char_framebuffer {
 
 	/** Invertedj*/
 	bool inverted;
+
+	/** Area to write to the display at the next finalize */
+	struct cfb_area dirty;
+
+	/** Area drawn since the last clear */
+	struct cfb_area inked;
+
+#if GLYPH_CACHE_SIZE > 0
+	/** Rotated glyphs, of glyph_size bytes each, or NULL */
+	uint8_t *glyph_cache;
+
+	/** Size of the largest glyph of the fonts */
+	uint16_t glyph_size;
+
+	/** Characters of the cached glyphs */
+	struct glyph_tag glyph_tags[GLYPH_CACHE_SIZE];
+#endif
 };
 
 static struct char_framebuffer char_fb;
 
+static inline void area_reset(struct cfb_area *area)
+{
+	area->x0 = UINT16_MAX;
+	area->x1 = 0U;
+	area->p0 = UINT16_MAX;
+	area->p1 = 0U;
+}
+
+static inline bool area_is_empty(const struct cfb_area *area)
+{
+	return area->x0 > area->x1;
+}
+
+static void area_add(struct cfb_area *area, const struct cfb_area *add)
+{
+	if (area_is_empty(add)) {
+		return;
+	}
+
+	area->x0 = MIN(area->x0, add->x0);
+	area->x1 = MAX(area->x1, add->x1);
+	area->p0 = MIN(area->p0, add->p0);
+	area->p1 = MAX(area->p1, add->p1);
+}
+
+static void mark_all_dirty(struct char_framebuffer *fb)
+{
+	fb->dirty = (struct cfb_area) {
+		.x0 = 0U,
+		.x1 = fb->x_res - 1U,
+		.p0 = 0U,
+		.p1 = fb->y_res / fb->ppt - 1U,
+	};
+}
+
+/* Mark the columns and pages drawn, clipped to the framebuffer */
+static void mark_drawn(struct char_framebuffer *fb, uint16_t x, uint16_t page,
+		       uint16_t width, uint16_t pages)
+{
+	struct cfb_area area = {
+		.x0 = x,
+		.x1 = MIN(x + width, fb->x_res) - 1U,
+		.p0 = page,
+		.p1 = MIN(page + pages, fb->y_res / fb->ppt) - 1U,
+	};
+
+	if (x >= fb->x_res || page >= fb->y_res / fb->ppt) {
+		return;
+	}
+
+	/* The glyph wraps to the next pages */
+	if (x + width > fb->x_res) {
+		area.x0 = 0U;
+		area.x1 = fb->x_res - 1U;
+		area.p1 = MIN(area.p1 + 1U, fb->y_res / fb->ppt - 1U);
+	}
+
+	area_add(&fb->dirty, &area);
+	area_add(&fb->inked, &area);
+}
+
 static inline uint8_t *get_glyph_ptr(const struct cfb_font *fptr, char c)
 {
 	if (fptr->caps & CFB_FONT_MONO_VPACKED) {
@@ -74,11 +168,115 @@ static inline uint8_t *get_glyph_ptr(const struct cfb_font *fptr, char c)
 	return NULL;
 }
 
+#if GLYPH_CACHE_SIZE > 0
+/*
+ * Glyph of a character, rotated to the layout of the framebuffer: the bytes
+ * of the first page of all the columns, then those of the next page, in the
+ * bit order of the display. The glyphs are kept in a direct mapped cache.
+ */
+static const uint8_t *get_glyph_rotated(struct char_framebuffer *fb,
+					const struct cfb_font *fptr, char c,
+					bool need_reverse)
+{
+	size_t idx = ((uint8_t)c + fb->font_idx * 31U) %
+		     GLYPH_CACHE_SIZE;
+	struct glyph_tag *tag = &fb->glyph_tags[idx];
+	uint8_t *glyph = &fb->glyph_cache[idx * fb->glyph_size];
+	uint16_t pages = fptr->height / 8U;
+	uint8_t *glyph_ptr;
+
+	if (tag->valid && tag->c == c && tag->font_idx == fb->font_idx) {
+		return glyph;
+	}
+
+	glyph_ptr = get_glyph_ptr(fptr, c);
+	if (!glyph_ptr) {
+		return NULL;
+	}
+
+	for (size_t g_y = 0; g_y < pages; g_y++) {
+		for (size_t g_x = 0; g_x < fptr->width; g_x++) {
+			uint8_t byte = glyph_ptr[g_x * pages + g_y];
+
+			if (need_reverse) {
+				byte = byte_reverse(byte);
+			}
+
+			glyph[g_y * fptr->width + g_x] = byte;
+		}
+	}
+
+	*tag = (struct glyph_tag) {
+		.c = c,
+		.font_idx = fb->font_idx,
+		.valid = true,
+	};
+
+	return glyph;
+}
+
+/* Copy a cached glyph to the framebuffer, a page at a time */
+static bool draw_char_cached(struct char_framebuffer *fb,
+			     const struct cfb_font *fptr, char c,
+			     uint16_t x, uint16_t page, bool need_reverse)
+{
+	uint16_t pages = fptr->height / 8U;
+	const uint8_t *glyph;
+
+	if (fb->glyph_cache == NULL || x + fptr->width > fb->x_res ||
+	    page + pages > fb->y_res / fb->ppt) {
+		return false;
+	}
+
+	glyph = get_glyph_rotated(fb, fptr, c, need_reverse);
+	if (glyph == NULL) {
+		return false;
+	}
+
+	for (size_t g_y = 0; g_y < pages; g_y++) {
+		memcpy(&fb->buf[(page + g_y) * fb->x_res + x],
+		       &glyph[g_y * fptr->width], fptr->width);
+	}
+
+	return true;
+}
+
+static void glyph_cache_init(struct char_framebuffer *fb)
+{
+	fb->glyph_size = 0U;
+
+	for (size_t i = 0; i < fb->numof_fonts; i++) {
+		fb->glyph_size = MAX(fb->glyph_size,
+				     fb->fonts[i].width *
+				     fb->fonts[i].height / 8U);
+	}
+
+	memset(fb->glyph_tags, 0, sizeof(fb->glyph_tags));
+	fb->glyph_cache = k_malloc(fb->glyph_size *
+				   GLYPH_CACHE_SIZE);
+	if (!fb->glyph_cache) {
+		LOG_WRN("No memory for the glyph cache");
+	}
+}
+#else
+static inline bool draw_char_cached(struct char_framebuffer *fb,
+				    const struct cfb_font *fptr, char c,
+				    uint16_t x, uint16_t page,
+				    bool need_reverse)
+{
+	return false;
+}
+
+static inline void glyph_cache_init(struct char_framebuffer *fb)
+{
+}
+#endif /* GLYPH_CACHE_SIZE > 0 */
+
 /*
  * Draw the monochrome character in the monochrome tiled framebuffer,
  * a byte is interpreted as 8 pixels ordered vertically among each other.
  */
-static uint8_t draw_char_vtmono(const struct char_framebuffer *fb,
+static uint8_t draw_char_vtmono(struct char_framebuffer *fb,
 			     char c, uint16_t x, uint16_t y)
 {
 	const struct cfb_font *fptr = &(fb->fonts[fb->font_idx]);
@@ -90,6 +288,12 @@ static uint8_t draw_char_vtmono(const struct char_framebuffer *fb,
 		c = ' ';
 	}
 
+	mark_drawn(fb, x, y / 8U, fptr->width, fptr->height / 8U);
+
+	if (draw_char_cached(fb, fptr, c, x, y / 8U, need_reverse)) {
+		return fptr->width;
+	}
+
 	glyph_ptr = get_glyph_ptr(fptr, c);
 	if (!glyph_ptr) {
 		return 0;
@@ -121,7 +325,7 @@ static uint8_t draw_char_vtmono(const struct char_framebuffer *fb,
 
 int cfb_print(const struct device *dev, char *str, uint16_t x, uint16_t y)
 {
-	const struct char_framebuffer *fb = &char_fb;
+	struct char_framebuffer *fb = &char_fb;
 	const struct cfb_font *fptr;
 
 	if (!fb->fonts || !fb->buf) {
@@ -150,18 +354,16 @@ int cfb_print(const struct device *dev, char *str, uint16_t x, uint16_t y)
 	return -1;
 }
 
-static int cfb_invert(const struct char_framebuffer *fb)
+static void cfb_invert(uint8_t *buf, size_t len)
 {
-	for (size_t i = 0; i < fb->x_res * fb->y_res / 8U; i++) {
-		fb->buf[i] = ~fb->buf[i];
+	for (size_t i = 0; i < len; i++) {
+		buf[i] = ~buf[i];
 	}
-
-	return 0;
 }
 
 int cfb_framebuffer_clear(const struct device *dev, bool clear_display)
 {
-	const struct char_framebuffer *fb = &char_fb;
+	struct char_framebuffer *fb = &char_fb;
 	struct display_buffer_descriptor desc;
 
 	if (!fb || !fb->buf) {
@@ -174,6 +376,15 @@ int cfb_framebuffer_clear(const struct device *dev, bool clear_display)
 	desc.pitch = fb->x_res;
 	memset(fb->buf, 0, fb->size);
 
+	/* Only the area drawn since the last clear changes on the display */
+	if (clear_display) {
+		mark_all_dirty(fb);
+	} else {
+		area_add(&fb->dirty, &fb->inked);
+	}
+
+	area_reset(&fb->inked);
+
 	return 0;
 }
 
@@ -187,6 +398,7 @@ int cfb_framebuffer_invert(const struct device *dev)
 	}
 
 	fb->inverted = !fb->inverted;
+	mark_all_dirty(fb);
 
 	return 0;
 }
@@ -194,23 +406,57 @@ int cfb_framebuffer_invert(const struct device *dev)
 int cfb_framebuffer_finalize(const struct device *dev)
 {
 	const struct display_driver_api *api = dev->api;
-	const struct char_framebuffer *fb = &char_fb;
+	struct char_framebuffer *fb = &char_fb;
 	struct display_buffer_descriptor desc;
+	bool invert;
+	uint16_t x;
+	uint8_t *buf;
+	int err;
 
 	if (!fb || !fb->buf) {
 		return -1;
 	}
 
-	desc.buf_size = fb->size;
-	desc.width = fb->x_res;
-	desc.height = fb->y_res;
-	desc.pitch = fb->x_res;
+	if (area_is_empty(&fb->dirty)) {
+		return 0;
+	}
+
+	/*
+	 * Write the band of the dirty pages at once, as each write may
+	 * refresh the display, e.g. an e-paper one. It is narrowed to the
+	 * dirty columns on a single page only: the columns of several pages
+	 * are not contiguous in the framebuffer.
+	 */
+	if (fb->dirty.p0 == fb->dirty.p1) {
+		x = fb->dirty.x0;
+		desc.width = fb->dirty.x1 - fb->dirty.x0 + 1U;
+	} else {
+		x = 0U;
+		desc.width = fb->x_res;
+	}
+
+	desc.height = (fb->dirty.p1 - fb->dirty.p0 + 1U) * fb->ppt;
+	desc.pitch = desc.width;
+	desc.buf_size = desc.width * desc.height / fb->ppt;
+	buf = &fb->buf[fb->dirty.p0 * fb->x_res + x];
 
-	if (!(fb->pixel_format & PIXEL_FORMAT_MONO10) != !(fb->inverted)) {
-		cfb_invert(fb);
+	/* The framebuffer is inverted for the write only */
+	invert = !(fb->pixel_format & PIXEL_FORMAT_MONO10) != !(fb->inverted);
+	if (invert) {
+		cfb_invert(buf, desc.buf_size);
 	}
 
-	return api->write(dev, 0, 0, &desc, fb->buf);
+	err = api->write(dev, x, fb->dirty.p0 * fb->ppt, &desc, buf);
+
+	if (invert) {
+		cfb_invert(buf, desc.buf_size);
+	}
+
+	if (err == 0) {
+		area_reset(&fb->dirty);
+	}
+
+	return err;
 }
 
 int cfb_get_display_parameter(const struct device *dev,
@@ -314,5 +560,9 @@ int cfb_framebuffer_init(const struct device *dev)
 
 	memset(fb->buf, 0, fb->size);
 
+	area_reset(&fb->inked);
+	mark_all_dirty(fb);
+	glyph_cache_init(fb);
+
 	return 0;
 }
@@ -21,8 +21,26 @@
 K_MEM_SLAB_DEFINE(fatfs_dirp_pool, sizeof(DIR),
 			CONFIG_FS_FATFS_NUM_DIRS, 4);
 
+#if defined(CONFIG_FS_FATFS_FAST_SEEK) && !_USE_FASTSEEK
+#error "The FatFs configuration does not enable _USE_FASTSEEK"
+#endif
+
+#if defined(CONFIG_FS_FATFS_EXPAND) && !_USE_EXPAND
+#error "The FatFs configuration does not enable _USE_EXPAND"
+#endif
+
+/* FatFs file object, with the cluster map used for fast seek. The FIL comes
+ * first: the file pointer of the fs_file_t points to both.
+ */
+struct fatfs_file {
+	FIL fil;
+#if defined(CONFIG_FS_FATFS_FAST_SEEK)
+	DWORD clmt[CONFIG_FS_FATFS_FAST_SEEK_MAP_SIZE];
+#endif
+};
+
 /* Memory pool for FatFs file objects */
-K_MEM_SLAB_DEFINE(fatfs_filep_pool, sizeof(FIL),
+K_MEM_SLAB_DEFINE(fatfs_filep_pool, sizeof(struct fatfs_file),
 			CONFIG_FS_FATFS_NUM_FILES, 4);
 
 static int translate_error(int error)
@@ -89,7 +107,7 @@ static int fatfs_open(struct fs_file_t *zfp, const char *file_name,
 	void *ptr;
 
 	if (k_mem_slab_alloc(&fatfs_filep_pool, &ptr, K_NO_WAIT) == 0) {
-		(void)memset(ptr, 0, sizeof(FIL));
+		(void)memset(ptr, 0, sizeof(struct fatfs_file));
 		zfp->filep = ptr;
 	} else {
 		return -ENOMEM;
@@ -102,8 +120,29 @@ static int fatfs_open(struct fs_file_t *zfp, const char *file_name,
 	if (res != FR_OK) {
 		k_mem_slab_free(&fatfs_filep_pool, &ptr);
 		zfp->filep = NULL;
+		return translate_error(res);
 	}
 
+#if defined(CONFIG_FS_FATFS_FAST_SEEK)
+	/* The size of a file in fast seek mode can not change, so only the
+	 * files opened for reading use it. Seeking then finds the cluster in
+	 * the map instead of following the chain from the start of the file.
+	 */
+	if ((mode & FS_O_WRITE) == 0) {
+		struct fatfs_file *file = ptr;
+
+		file->clmt[0] = ARRAY_SIZE(file->clmt);
+		file->fil.cltbl = file->clmt;
+
+		res = f_lseek(&file->fil, CREATE_LINKMAP);
+		if (res != FR_OK) {
+			/* Too fragmented for the map, seek the slow way */
+			file->fil.cltbl = NULL;
+			res = FR_OK;
+		}
+	}
+#endif
+
 	return translate_error(res);
 }
 
@@ -285,6 +324,27 @@ static int fatfs_truncate(struct fs_file_t *zfp, off_t length)
 	return res;
 }
 
+static int fatfs_allocate(struct fs_file_t *zfp, off_t length)
+{
+	int res = -ENOTSUP;
+
+#if !defined(CONFIG_FS_FATFS_READ_ONLY) && defined(CONFIG_FS_FATFS_EXPAND)
+	if (f_size((FIL *)zfp->filep) != 0 || length < 0) {
+		return -EINVAL;
+	}
+
+	res = f_expand(zfp->filep, length, 1);
+	if (res == FR_DENIED) {
+		/* No contiguous free space of that length */
+		return -ENOSPC;
+	}
+
+	res = translate_error(res);
+#endif
+
+	return res;
+}
+
 static int fatfs_sync(struct fs_file_t *zfp)
 {
 	int res = -ENOTSUP;
@@ -449,6 +509,7 @@ static const struct fs_file_system_t fatfs_fs = {
 	.lseek = fatfs_seek,
 	.tell = fatfs_tell,
 	.truncate = fatfs_truncate,
+	.allocate = fatfs_allocate,
 	.sync = fatfs_sync,
 	.opendir = fatfs_opendir,
 	.readdir = fatfs_readdir,
@@ -157,6 +157,9 @@ fcb_init(int f_area_id, struct fcb *fcb)
 		newest = oldest = 0;
 	}
 	fcb->f_align = align;
+	for (i = 0; i < fcb->f_sector_cnt; i++) {
+		fcb_index_reset(fcb, &fcb->f_sectors[i]);
+	}
 	fcb->f_oldest = oldest_sector;
 	fcb->f_active.fe_sector = newest_sector;
 	fcb->f_active.fe_elem_off = sizeof(struct fcb_disk_area);
@@ -273,6 +276,7 @@ fcb_sector_hdr_init(struct fcb *fcb, struct flash_sector *sector, uint16_t id)
 	if (rc != 0) {
 		return -EIO;
 	}
+	fcb_index_reset(fcb, sector);
 	return 0;
 }
 
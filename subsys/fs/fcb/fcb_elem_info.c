@@ -11,19 +11,14 @@
 #include "fcb_priv.h"
 
 /*
- * Given offset in flash sector, fill in rest of the fcb_entry, and crc8 over
- * the data.
+ * Given offset in flash sector, read the length of the element and fill in
+ * rest of the fcb_entry. The length as found in flash is left in tmp_str.
  */
-int
-fcb_elem_crc8(struct fcb *fcb, struct fcb_entry *loc, uint8_t *c8p)
+static int
+fcb_elem_len(struct fcb *fcb, struct fcb_entry *loc, uint8_t *tmp_str)
 {
-	uint8_t tmp_str[FCB_TMP_BUF_SZ];
-	int cnt;
-	int blk_sz;
-	uint8_t crc8;
 	uint16_t len;
-	uint32_t off;
-	uint32_t end;
+	int cnt;
 	int rc;
 
 	if (loc->fe_elem_off + 2 > loc->fe_sector->fs_size) {
@@ -41,6 +36,31 @@ fcb_elem_crc8(struct fcb *fcb, struct fcb_entry *loc, uint8_t *c8p)
 	loc->fe_data_off = loc->fe_elem_off + fcb_len_in_flash(fcb, cnt);
 	loc->fe_data_len = len;
 
+	return cnt;
+}
+
+/*
+ * Given offset in flash sector, fill in rest of the fcb_entry, and crc8 over
+ * the data.
+ */
+int
+fcb_elem_crc8(struct fcb *fcb, struct fcb_entry *loc, uint8_t *c8p)
+{
+	uint8_t tmp_str[FCB_TMP_BUF_SZ];
+	int cnt;
+	int blk_sz;
+	uint8_t crc8;
+	uint16_t len;
+	uint32_t off;
+	uint32_t end;
+	int rc;
+
+	cnt = fcb_elem_len(fcb, loc, tmp_str);
+	if (cnt < 0) {
+		return cnt;
+	}
+	len = loc->fe_data_len;
+
 	crc8 = CRC8_CCITT_INITIAL_VALUE;
 	crc8 = crc8_ccitt(crc8, tmp_str, cnt);
 
@@ -65,11 +85,20 @@ fcb_elem_crc8(struct fcb *fcb, struct fcb_entry *loc, uint8_t *c8p)
 
 int fcb_elem_info(struct fcb *fcb, struct fcb_entry *loc)
 {
+	uint8_t tmp_str[2];
+	uint32_t *checked;
 	int rc;
 	uint8_t crc8;
 	uint8_t fl_crc8;
 	off_t off;
 
+	/* The elements already checked are not read again. */
+	checked = fcb_index_get(fcb, loc->fe_sector);
+	if (checked && (loc->fe_elem_off < *checked)) {
+		rc = fcb_elem_len(fcb, loc, tmp_str);
+		return (rc < 0) ? rc : 0;
+	}
+
 	rc = fcb_elem_crc8(fcb, loc, &crc8);
 	if (rc) {
 		return rc;
@@ -84,5 +113,7 @@ int fcb_elem_info(struct fcb *fcb, struct fcb_entry *loc)
 	if (fl_crc8 != crc8) {
 		return -EBADMSG;
 	}
+
+	fcb_index_add(fcb, loc);
 	return 0;
 }
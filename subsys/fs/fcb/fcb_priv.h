@@ -69,6 +69,49 @@ struct flash_sector *fcb_getnext_sector(struct fcb *fcb,
 					struct flash_sector *sector);
 int fcb_getnext_nolock(struct fcb *fcb, struct fcb_entry *loc);
 
+/* Offset of the element following the one of loc */
+static inline uint32_t fcb_elem_end(struct fcb *fcb,
+				    const struct fcb_entry *loc)
+{
+	return loc->fe_data_off + fcb_len_in_flash(fcb, loc->fe_data_len) +
+	       fcb_len_in_flash(fcb, FCB_CRC_SZ);
+}
+
+/* Offset up to which the elements of a sector have been checked, NULL when
+ * the sector is not indexed.
+ */
+static inline uint32_t *fcb_index_get(struct fcb *fcb,
+				      const struct flash_sector *sector)
+{
+#ifdef CONFIG_FCB_INDEX
+	if (sector - fcb->f_sectors < CONFIG_FCB_INDEX_MAX_SECTORS) {
+		return &fcb->f_index[sector - fcb->f_sectors];
+	}
+#endif
+	return NULL;
+}
+
+/* Forget the checked elements of a sector, when it is taken into use */
+static inline void fcb_index_reset(struct fcb *fcb,
+				   const struct flash_sector *sector)
+{
+	uint32_t *checked = fcb_index_get(fcb, sector);
+
+	if (checked) {
+		*checked = sizeof(struct fcb_disk_area);
+	}
+}
+
+/* Extend the checked elements of a sector with the valid element of loc */
+static inline void fcb_index_add(struct fcb *fcb, const struct fcb_entry *loc)
+{
+	uint32_t *checked = fcb_index_get(fcb, loc->fe_sector);
+
+	if (checked && (*checked == loc->fe_elem_off)) {
+		*checked = fcb_elem_end(fcb, loc);
+	}
+}
+
 int fcb_elem_info(struct fcb *fcb, struct fcb_entry *loc);
 int fcb_elem_crc8(struct fcb *fcb, struct fcb_entry *loc, uint8_t *crc8p);
 
@@ -5,6 +5,9 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <sys/crc.h>
+#include <sys/util.h>
+
 #include <fs/fcb.h>
 #include "fcb_priv.h"
 
@@ -47,3 +50,149 @@ fcb_walk(struct fcb *fcb, struct flash_sector *sector, fcb_walk_cb cb,
 	k_mutex_unlock(&fcb->f_mtx);
 	return 0;
 }
+
+/*
+ * Call 'cb' for every element of a sector, reading them buf_len bytes at a
+ * time. An element larger than the buffer is given without its data.
+ */
+static int
+fcb_walk_bulk_sector(struct fcb *fcb, struct flash_sector *sector,
+		     uint8_t *buf, size_t buf_len, fcb_bulk_walk_cb cb,
+		     void *cb_arg)
+{
+	struct fcb_entry_ctx entry_ctx;
+	uint32_t off = sizeof(struct fcb_disk_area);
+	uint32_t end;
+	uint32_t size = 0U;
+	uint32_t pos;
+	uint32_t data_pos;
+	uint16_t data_len;
+	size_t len;
+	uint8_t crc8;
+	int cnt;
+	int rc;
+
+	entry_ctx.loc.fe_sector = sector;
+	entry_ctx.fap = fcb->fap;
+
+	while (1) {
+		rc = k_mutex_lock(&fcb->f_mtx, K_FOREVER);
+		if (rc < 0) {
+			return -EINVAL;
+		}
+		if (sector == fcb->f_active.fe_sector) {
+			end = fcb->f_active.fe_elem_off;
+		} else {
+			end = sector->fs_size;
+		}
+		len = (off + 2 <= end) ? MIN(buf_len, end - off) : 0;
+		if (len) {
+			rc = fcb_flash_read(fcb, sector, off, buf, len);
+		}
+		k_mutex_unlock(&fcb->f_mtx);
+
+		if (rc) {
+			return -EIO;
+		}
+		if (len == 0) {
+			return 0;
+		}
+
+		for (pos = 0U; pos + 2 <= len; pos += size) {
+			cnt = fcb_get_len(fcb, &buf[pos], &data_len);
+			if (cnt < 0) {
+				/* Nothing written after this offset */
+				return 0;
+			}
+			data_pos = pos + fcb_len_in_flash(fcb, cnt);
+			size = fcb_len_in_flash(fcb, cnt) +
+			       fcb_len_in_flash(fcb, data_len) +
+			       fcb_len_in_flash(fcb, FCB_CRC_SZ);
+			if (off + pos + size > end) {
+				return 0;
+			}
+			if (pos + size > len) {
+				break;
+			}
+
+			crc8 = crc8_ccitt(CRC8_CCITT_INITIAL_VALUE, &buf[pos],
+					  cnt);
+			crc8 = crc8_ccitt(crc8, &buf[data_pos], data_len);
+			if (crc8 != buf[data_pos +
+					fcb_len_in_flash(fcb, data_len)]) {
+				continue;
+			}
+
+			entry_ctx.loc.fe_elem_off = off + pos;
+			entry_ctx.loc.fe_data_off = off + data_pos;
+			entry_ctx.loc.fe_data_len = data_len;
+			rc = cb(&entry_ctx, &buf[data_pos], cb_arg);
+			if (rc) {
+				return rc;
+			}
+		}
+
+		if (pos > 0U) {
+			off += pos;
+			continue;
+		}
+
+		/* The first element does not fit in the buffer. */
+		entry_ctx.loc.fe_elem_off = off;
+		rc = k_mutex_lock(&fcb->f_mtx, K_FOREVER);
+		if (rc < 0) {
+			return -EINVAL;
+		}
+		rc = fcb_elem_info(fcb, &entry_ctx.loc);
+		k_mutex_unlock(&fcb->f_mtx);
+
+		if (rc == 0) {
+			rc = cb(&entry_ctx, NULL, cb_arg);
+			if (rc) {
+				return rc;
+			}
+		} else if (rc != -EBADMSG) {
+			return (rc == -ENOTSUP) ? 0 : rc;
+		}
+		off += size;
+	}
+}
+
+int
+fcb_walk_bulk(struct fcb *fcb, struct flash_sector *sector, uint8_t *buf,
+	      size_t buf_len, fcb_bulk_walk_cb cb, void *cb_arg)
+{
+	struct flash_sector *cur;
+	bool last;
+	int rc;
+
+	if (buf_len < 2) {
+		return -EINVAL;
+	}
+
+	rc = k_mutex_lock(&fcb->f_mtx, K_FOREVER);
+	if (rc < 0) {
+		return -EINVAL;
+	}
+	cur = sector ? sector : fcb->f_oldest;
+	k_mutex_unlock(&fcb->f_mtx);
+
+	while (1) {
+		rc = fcb_walk_bulk_sector(fcb, cur, buf, buf_len, cb, cb_arg);
+		if (rc || sector) {
+			return rc;
+		}
+
+		rc = k_mutex_lock(&fcb->f_mtx, K_FOREVER);
+		if (rc < 0) {
+			return -EINVAL;
+		}
+		last = (cur == fcb->f_active.fe_sector);
+		cur = fcb_getnext_sector(fcb, cur);
+		k_mutex_unlock(&fcb->f_mtx);
+
+		if (last) {
+			return 0;
+		}
+	}
+}
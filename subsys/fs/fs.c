@@ -27,6 +27,11 @@ static sys_dlist_t fs_mnt_list;
 /* lock to protect mount list operations */
 static struct k_mutex mutex;
 
+/* lock to protect the mount list during lookups, which do not wait for the
+ * mount operations serialized by mutex.
+ */
+static struct k_spinlock mnt_list_lock;
+
 /* Maps an identifier used in mount points to the file system
  * implementation.
  */
@@ -86,8 +91,9 @@ static int fs_get_mnt_point(struct fs_mount_t **mnt_pntp,
 	size_t longest_match = 0;
 	size_t len, name_len = strlen(name);
 	sys_dnode_t *node;
+	k_spinlock_key_t key;
 
-	k_mutex_lock(&mutex, K_FOREVER);
+	key = k_spin_lock(&mnt_list_lock);
 	SYS_DLIST_FOR_EACH_NODE(&fs_mnt_list, node) {
 		itr = CONTAINER_OF(node, struct fs_mount_t, node);
 		len = itr->mountp_len;
@@ -115,7 +121,7 @@ static int fs_get_mnt_point(struct fs_mount_t **mnt_pntp,
 			longest_match = len;
 		}
 	}
-	k_mutex_unlock(&mutex);
+	k_spin_unlock(&mnt_list_lock, key);
 
 	if (mnt_p == NULL) {
 		return -ENOENT;
@@ -236,6 +242,51 @@ ssize_t fs_write(struct fs_file_t *zfp, const void *ptr, size_t size)
 	return rc;
 }
 
+static ssize_t fs_transfer_v(struct fs_file_t *zfp, const struct fs_iovec *iov,
+			     int iovcnt, bool write)
+{
+	ssize_t total = 0;
+	ssize_t rc;
+
+	if (iovcnt < 0) {
+		return -EINVAL;
+	}
+
+	for (int i = 0; i < iovcnt; i++) {
+		if (write) {
+			rc = fs_write(zfp, iov[i].base, iov[i].len);
+		} else {
+			rc = fs_read(zfp, iov[i].base, iov[i].len);
+		}
+
+		if (rc < 0) {
+			/* The data already transferred is reported as a
+			 * short read or write.
+			 */
+			return (total > 0) ? total : rc;
+		}
+
+		total += rc;
+		if (rc < iov[i].len) {
+			break;
+		}
+	}
+
+	return total;
+}
+
+ssize_t fs_readv(struct fs_file_t *zfp, const struct fs_iovec *iov,
+		 int iovcnt)
+{
+	return fs_transfer_v(zfp, iov, iovcnt, false);
+}
+
+ssize_t fs_writev(struct fs_file_t *zfp, const struct fs_iovec *iov,
+		  int iovcnt)
+{
+	return fs_transfer_v(zfp, iov, iovcnt, true);
+}
+
 int fs_seek(struct fs_file_t *zfp, off_t offset, int whence)
 {
 	int rc = -ENOTSUP;
@@ -296,6 +347,26 @@ int fs_truncate(struct fs_file_t *zfp, off_t length)
 	return rc;
 }
 
+int fs_allocate(struct fs_file_t *zfp, off_t length)
+{
+	int rc = -EINVAL;
+
+	if (zfp->mp == NULL) {
+		return -EBADF;
+	}
+
+	if (zfp->mp->fs->allocate == NULL) {
+		return -ENOTSUP;
+	}
+
+	rc = zfp->mp->fs->allocate(zfp, length);
+	if (rc < 0) {
+		LOG_ERR("file allocate error (%d)", rc);
+	}
+
+	return rc;
+}
+
 int fs_sync(struct fs_file_t *zfp)
 {
 	int rc = -EINVAL;
@@ -639,6 +710,7 @@ int fs_mount(struct fs_mount_t *mp)
 	struct fs_mount_t *itr;
 	const struct fs_file_system_t *fs;
 	sys_dnode_t *node;
+	k_spinlock_key_t key;
 	int rc = -EINVAL;
 	size_t len = 0;
 
@@ -703,7 +775,9 @@ int fs_mount(struct fs_mount_t *mp)
 	mp->mountp_len = len;
 	mp->fs = fs;
 
+	key = k_spin_lock(&mnt_list_lock);
 	sys_dlist_append(&fs_mnt_list, &mp->node);
+	k_spin_unlock(&mnt_list_lock, key);
 	LOG_DBG("fs mounted at %s", log_strdup(mp->mnt_point));
 
 mount_err:
@@ -714,6 +788,7 @@ mount_err:
 
 int fs_unmount(struct fs_mount_t *mp)
 {
+	k_spinlock_key_t key;
 	int rc = -EINVAL;
 
 	if (mp == NULL) {
@@ -739,11 +814,13 @@ int fs_unmount(struct fs_mount_t *mp)
 		goto unmount_err;
 	}
 
-	/* clear file system interface */
-	mp->fs = NULL;
-
 	/* remove mount node from the list */
+	key = k_spin_lock(&mnt_list_lock);
 	sys_dlist_remove(&mp->node);
+	k_spin_unlock(&mnt_list_lock, key);
+
+	/* clear file system interface, once lookups can no longer find it */
+	mp->fs = NULL;
 	LOG_DBG("fs unmounted from %s", log_strdup(mp->mnt_point));
 
 unmount_err:
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <kernel.h>
+#include <init.h>
+#include <fs/fs.h>
+
+/* Each thread has its own queue, and the requests of a file always go to the
+ * same queue: they run in order, while the requests of different files may
+ * run in parallel.
+ */
+static K_KERNEL_STACK_ARRAY_DEFINE(aio_stacks, CONFIG_FILE_SYSTEM_AIO_THREADS,
+				   CONFIG_FILE_SYSTEM_AIO_STACK_SIZE);
+static struct k_thread aio_threads[CONFIG_FILE_SYSTEM_AIO_THREADS];
+static struct k_fifo aio_queues[CONFIG_FILE_SYSTEM_AIO_THREADS];
+
+static struct k_fifo *aio_queue(const struct fs_file_t *zfp)
+{
+	uintptr_t idx = (uintptr_t)zfp / sizeof(*zfp);
+
+	return &aio_queues[idx % CONFIG_FILE_SYSTEM_AIO_THREADS];
+}
+
+static ssize_t aio_run(struct fs_aio *aio)
+{
+	switch (aio->type) {
+	case FS_AIO_READ:
+		return fs_readv(aio->zfp, aio->iov, aio->iovcnt);
+	case FS_AIO_WRITE:
+		return fs_writev(aio->zfp, aio->iov, aio->iovcnt);
+	case FS_AIO_SYNC:
+		return fs_sync(aio->zfp);
+	default:
+		return -EINVAL;
+	}
+}
+
+static void aio_thread(void *p1, void *p2, void *p3)
+{
+	struct k_fifo *queue = p1;
+	struct k_poll_signal *signal;
+	struct fs_aio *aio;
+	ssize_t result;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		aio = k_fifo_get(queue, K_FOREVER);
+
+		result = aio_run(aio);
+		aio->result = result;
+
+		/* The callback may submit the request again. */
+		signal = aio->signal;
+		if (aio->cb) {
+			aio->cb(aio, result);
+		}
+
+		if (signal) {
+			k_poll_signal_raise(signal, (int)result);
+		}
+	}
+}
+
+int fs_aio_submit(struct fs_aio *aio)
+{
+	if (aio->zfp == NULL || aio->zfp->mp == NULL) {
+		return -EBADF;
+	}
+
+	if (aio->type > FS_AIO_SYNC ||
+	    (aio->type != FS_AIO_SYNC && aio->iovcnt < 0)) {
+		return -EINVAL;
+	}
+
+	aio->result = -EINPROGRESS;
+	k_fifo_put(aio_queue(aio->zfp), aio);
+
+	return 0;
+}
+
+static int fs_aio_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	for (int i = 0; i < CONFIG_FILE_SYSTEM_AIO_THREADS; i++) {
+		k_fifo_init(&aio_queues[i]);
+		k_thread_create(&aio_threads[i], aio_stacks[i],
+				K_KERNEL_STACK_SIZEOF(aio_stacks[i]),
+				aio_thread, &aio_queues[i], NULL, NULL,
+				K_PRIO_PREEMPT(CONFIG_FILE_SYSTEM_AIO_THREAD_PRIO),
+				0, K_NO_WAIT);
+		k_thread_name_set(&aio_threads[i], "fs_aio");
+	}
+
+	return 0;
+}
+
+SYS_INIT(fs_aio_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -27,6 +27,10 @@ struct lfs_file_data {
 	struct lfs_file file;
 	struct lfs_file_config config;
 	void *cache_block;
+#if CONFIG_FS_LITTLEFS_SYNC_DELAY_MS > 0
+	struct k_work_delayable sync_work;
+	struct fs_littlefs *fs;
+#endif
 };
 
 #define LFS_FILEP(fp) (&((struct lfs_file_data *)(fp->filep))->file)
@@ -68,6 +72,180 @@ static inline void fc_release(void *buf)
 	k_heap_free(&file_cache_heap, buf);
 }
 
+#ifdef CONFIG_FS_LITTLEFS_BLOCK_CACHE
+/* Portion of a block, at a multiple of the cache size, cached for all the
+ * files of a mount.
+ */
+struct block_cache_line {
+	lfs_block_t block;
+	lfs_off_t off;
+	uint32_t used;
+	uint8_t *data;
+};
+
+struct fs_littlefs_block_cache {
+	uint32_t tick;
+	uint16_t count;
+	struct block_cache_line lines[];
+};
+
+#define BLOCK_CACHE_INVALID ((lfs_block_t)-1)
+
+static K_HEAP_DEFINE(block_cache_heap,
+		     CONFIG_FS_LITTLEFS_BLOCK_CACHE_HEAP_SIZE);
+
+/* Take as many lines as the heap has room for, up to the configured count */
+static void block_cache_alloc(struct fs_littlefs *fs)
+{
+	struct fs_littlefs_block_cache *cache = NULL;
+	lfs_size_t line_size = fs->cfg.cache_size;
+	uint16_t count = CONFIG_FS_LITTLEFS_BLOCK_CACHE_LINES;
+	uint8_t *data;
+
+	while (count > 0) {
+		cache = k_heap_alloc(&block_cache_heap,
+				     sizeof(*cache) +
+				     count * (sizeof(cache->lines[0]) +
+					      line_size),
+				     K_NO_WAIT);
+		if (cache) {
+			break;
+		}
+
+		count /= 2;
+	}
+
+	if (!cache) {
+		LOG_WRN("no room for a block cache");
+		fs->block_cache = NULL;
+		return;
+	}
+
+	cache->tick = 0U;
+	cache->count = count;
+	data = (uint8_t *)&cache->lines[count];
+	for (int i = 0; i < count; i++) {
+		cache->lines[i].block = BLOCK_CACHE_INVALID;
+		cache->lines[i].used = 0U;
+		cache->lines[i].data = data + i * line_size;
+	}
+
+	fs->block_cache = cache;
+	LOG_DBG("block cache of %u lines", count);
+}
+
+static void block_cache_free(struct fs_littlefs *fs)
+{
+	if (fs->block_cache) {
+		k_heap_free(&block_cache_heap, fs->block_cache);
+		fs->block_cache = NULL;
+	}
+}
+
+static struct block_cache_line *block_cache_get(
+	struct fs_littlefs_block_cache *cache, lfs_block_t block,
+	lfs_off_t off, bool *hit)
+{
+	struct block_cache_line *victim = &cache->lines[0];
+	struct block_cache_line *line;
+
+	for (int i = 0; i < cache->count; i++) {
+		line = &cache->lines[i];
+
+		if (line->block == block && line->off == off) {
+			line->used = ++cache->tick;
+			*hit = true;
+			return line;
+		}
+
+		if (line->block == BLOCK_CACHE_INVALID) {
+			victim = line;
+		} else if (victim->block != BLOCK_CACHE_INVALID &&
+			   (int32_t)(line->used - victim->used) < 0) {
+			victim = line;
+		}
+	}
+
+	victim->block = block;
+	victim->off = off;
+	victim->used = ++cache->tick;
+	*hit = false;
+
+	return victim;
+}
+
+/* Drop the lines overlapping size bytes at off in block, all the block for
+ * a size of 0.
+ */
+static void block_cache_invalidate(struct fs_littlefs *fs, lfs_block_t block,
+				   lfs_off_t off, lfs_size_t size)
+{
+	struct fs_littlefs_block_cache *cache = fs->block_cache;
+	lfs_size_t line_size = fs->cfg.cache_size;
+
+	if (!cache) {
+		return;
+	}
+
+	for (int i = 0; i < cache->count; i++) {
+		struct block_cache_line *line = &cache->lines[i];
+
+		if (line->block != block) {
+			continue;
+		}
+
+		if (size == 0 ||
+		    (line->off < off + size && off < line->off + line_size)) {
+			line->block = BLOCK_CACHE_INVALID;
+		}
+	}
+}
+
+static int block_cache_read(struct fs_littlefs *fs, lfs_block_t block,
+			    lfs_off_t off, uint8_t *buffer, lfs_size_t size)
+{
+	struct fs_littlefs_block_cache *cache = fs->block_cache;
+	lfs_size_t line_size = fs->cfg.cache_size;
+	size_t block_off = block * fs->cfg.block_size;
+	struct block_cache_line *line;
+	lfs_off_t line_off;
+	lfs_size_t len;
+	bool hit;
+	int rc;
+
+	while (size > 0) {
+		line_off = off - (off % line_size);
+		len = MIN(size, line_off + line_size - off);
+
+		line = block_cache_get(cache, block, line_off, &hit);
+		if (hit) {
+			fs->cache_stats.hits++;
+		} else {
+			fs->cache_stats.misses++;
+			rc = flash_area_read(fs->area, block_off + line_off,
+					     line->data, line_size);
+			if (rc < 0) {
+				line->block = BLOCK_CACHE_INVALID;
+				return rc;
+			}
+		}
+
+		memcpy(buffer, line->data + (off - line_off), len);
+		buffer += len;
+		off += len;
+		size -= len;
+	}
+
+	return 0;
+}
+#else
+static inline void block_cache_invalidate(struct fs_littlefs *fs,
+					  lfs_block_t block, lfs_off_t off,
+					  lfs_size_t size)
+{
+}
+#endif /* CONFIG_FS_LITTLEFS_BLOCK_CACHE */
+
 static inline void fs_lock(struct fs_littlefs *fs)
 {
 	k_mutex_lock(&fs->mutex, K_FOREVER);
@@ -155,6 +333,17 @@ static int lfs_api_read(const struct lfs_config *c, lfs_block_t block,
 	const struct flash_area *fa = c->context;
 	size_t offset = block * c->block_size + off;
 
+#ifdef CONFIG_FS_LITTLEFS_BLOCK_CACHE
+	struct fs_littlefs *fs = CONTAINER_OF(c, struct fs_littlefs, cfg);
+
+	/* Large reads of file data would only evict the shared lines. */
+	if (fs->block_cache &&
+	    size <= fs->block_cache->count / 2 * c->cache_size) {
+		return errno_to_lfs(block_cache_read(fs, block, off, buffer,
+						     size));
+	}
+#endif
+
 	int rc = flash_area_read(fa, offset, buffer, size);
 
 	return errno_to_lfs(rc);
@@ -166,6 +355,9 @@ static int lfs_api_prog(const struct lfs_config *c, lfs_block_t block,
 	const struct flash_area *fa = c->context;
 	size_t offset = block * c->block_size + off;
 
+	block_cache_invalidate(CONTAINER_OF(c, struct fs_littlefs, cfg),
+			       block, off, size);
+
 	int rc = flash_area_write(fa, offset, buffer, size);
 
 	return errno_to_lfs(rc);
@@ -176,6 +368,9 @@ static int lfs_api_erase(const struct lfs_config *c, lfs_block_t block)
 	const struct flash_area *fa = c->context;
 	size_t offset = block * c->block_size;
 
+	block_cache_invalidate(CONTAINER_OF(c, struct fs_littlefs, cfg),
+			       block, 0, 0);
+
 	int rc = flash_area_erase(fa, offset, c->block_size);
 
 	return errno_to_lfs(rc);
@@ -186,6 +381,24 @@ static int lfs_api_sync(const struct lfs_config *c)
 	return LFS_ERR_OK;
 }
 
+#if CONFIG_FS_LITTLEFS_SYNC_DELAY_MS > 0
+static void deferred_sync(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct lfs_file_data *fdp = CONTAINER_OF(dwork, struct lfs_file_data,
+						 sync_work);
+	int ret;
+
+	fs_lock(fdp->fs);
+	ret = lfs_file_sync(&fdp->fs->lfs, &fdp->file);
+	fs_unlock(fdp->fs);
+
+	if (ret < 0) {
+		LOG_ERR("deferred sync failed (LFS %d)", ret);
+	}
+}
+#endif
+
 static void release_file_data(struct fs_file_t *fp)
 {
 	struct lfs_file_data *fdp = fp->filep;
@@ -238,6 +451,11 @@ static int littlefs_open(struct fs_file_t *fp, const char *path,
 	fdp->config.buffer = fdp->cache_block;
 	path = fs_impl_strip_prefix(path, fp->mp);
 
+#if CONFIG_FS_LITTLEFS_SYNC_DELAY_MS > 0
+	fdp->fs = fs;
+	k_work_init_delayable(&fdp->sync_work, deferred_sync);
+#endif
+
 	fs_lock(fs);
 
 	ret = lfs_file_opencfg(&fs->lfs, &fdp->file,
@@ -256,6 +474,16 @@ static int littlefs_close(struct fs_file_t *fp)
 {
 	struct fs_littlefs *fs = fp->mp->fs_data;
 
+#if CONFIG_FS_LITTLEFS_SYNC_DELAY_MS > 0
+	struct k_work_sync sync;
+
+	/* Closing syncs the file anyway. The deferred sync takes the lock,
+	 * so it is cancelled before taking it.
+	 */
+	k_work_cancel_delayable_sync(
+		&((struct lfs_file_data *)fp->filep)->sync_work, &sync);
+#endif
+
 	fs_lock(fs);
 
 	int ret = lfs_file_close(&fs->lfs, LFS_FILEP(fp));
@@ -370,12 +598,25 @@ static int littlefs_sync(struct fs_file_t *fp)
 {
 	struct fs_littlefs *fs = fp->mp->fs_data;
 
+#if CONFIG_FS_LITTLEFS_SYNC_DELAY_MS > 0
+	struct lfs_file_data *fdp = fp->filep;
+
+	/* The syncs requested until the delay expires are coalesced in one
+	 * commit of the file.
+	 */
+	ARG_UNUSED(fs);
+	k_work_schedule(&fdp->sync_work,
+			K_MSEC(CONFIG_FS_LITTLEFS_SYNC_DELAY_MS));
+
+	return 0;
+#else
 	fs_lock(fs);
 
 	int ret = lfs_file_sync(&fs->lfs, LFS_FILEP(fp));
 
 	fs_unlock(fs);
 	return lfs_to_errno(ret);
+#endif
 }
 
 static int littlefs_mkdir(struct fs_mount_t *mountp, const char *path)
@@ -690,6 +931,12 @@ static int littlefs_mount(struct fs_mount_t *mountp)
 	lcp->cache_size = cache_size;
 	lcp->lookahead_size = lookahead_size;
 
+#ifdef CONFIG_FS_LITTLEFS_BLOCK_CACHE
+	block_cache_alloc(fs);
+	fs->cache_stats.hits = 0U;
+	fs->cache_stats.misses = 0U;
+#endif
+
 	/* Mount it, formatting if needed. */
 	ret = lfs_mount(&fs->lfs, &fs->cfg);
 	if (ret < 0 &&
@@ -720,6 +967,9 @@ static int littlefs_mount(struct fs_mount_t *mountp)
 
 out:
 	if (ret < 0) {
+#ifdef CONFIG_FS_LITTLEFS_BLOCK_CACHE
+		block_cache_free(fs);
+#endif
 		fs->area = NULL;
 	}
 
@@ -737,6 +987,11 @@ static int littlefs_unmount(struct fs_mount_t *mountp)
 	lfs_unmount(&fs->lfs);
 	flash_area_close(fs->area);
 	fs->area = NULL;
+#ifdef CONFIG_FS_LITTLEFS_BLOCK_CACHE
+	LOG_DBG("block cache hits %u misses %u", fs->cache_stats.hits,
+		fs->cache_stats.misses);
+	block_cache_free(fs);
+#endif
 
 	fs_unlock(fs);
 
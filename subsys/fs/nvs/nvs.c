@@ -16,6 +16,19 @@
 #include <logging/log.h>
 LOG_MODULE_REGISTER(fs_nvs, CONFIG_NVS_LOG_LEVEL);
 
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+
+/* IDs are usually allocated from 0 up, so the cache entry of an ID is
+ * simply the ID modulo the cache size. The cache entry holds the address of
+ * the most recent ATE of all the IDs sharing it: the most recent ATE of an
+ * ID is found by walking through the ATEs from this address.
+ */
+static inline size_t nvs_lookup_cache_pos(uint16_t id)
+{
+	return id % CONFIG_NVS_LOOKUP_CACHE_SIZE;
+}
+#endif /* CONFIG_NVS_LOOKUP_CACHE */
+
 /* basic routines */
 /* nvs_al_size returns size aligned to fs->write_block_size */
 static inline size_t nvs_al_size(struct nvs_fs *fs, size_t len)
@@ -96,6 +109,13 @@ static int nvs_flash_ate_wrt(struct nvs_fs *fs, const struct nvs_ate *entry)
 
 	rc = nvs_flash_al_wrt(fs, fs->ate_wra, entry,
 			       sizeof(struct nvs_ate));
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	/* 0xFFFF is the ID of the sector close and gc done ATEs */
+	if (entry->id != 0xFFFF) {
+		fs->lookup_cache[nvs_lookup_cache_pos(entry->id)] =
+			fs->ate_wra;
+	}
+#endif
 	fs->ate_wra -= nvs_al_size(fs, sizeof(struct nvs_ate));
 
 	return rc;
@@ -239,6 +259,82 @@ static int nvs_flash_erase_sector(struct nvs_fs *fs, uint32_t addr)
 	return rc;
 }
 
+#ifdef CONFIG_NVS_BACKGROUND_GC
+/* erase the next page of the sector released by gc.
+ * return 1 if pages are left, 0 once the sector is erased, errorcode on error.
+ */
+static int nvs_gc_erase_step(struct nvs_fs *fs)
+{
+	int rc;
+	off_t offset;
+	struct flash_pages_info info;
+
+	if (fs->gc_erase_addr == NVS_GC_ERASE_NONE) {
+		return 0;
+	}
+
+	offset = fs->offset;
+	offset += fs->sector_size * (fs->gc_erase_addr >> ADDR_SECT_SHIFT);
+	offset += fs->gc_erase_addr & ADDR_OFFS_MASK;
+
+	rc = flash_get_page_info_by_offs(fs->flash_device, offset, &info);
+	if (rc) {
+		return rc;
+	}
+
+	LOG_DBG("Erasing flash at %lx, len %zu", (long int) offset, info.size);
+	rc = flash_erase(fs->flash_device, offset, info.size);
+	if (rc) {
+		return rc;
+	}
+
+	if (nvs_flash_cmp_const(fs, fs->gc_erase_addr,
+				fs->flash_parameters->erase_value, info.size)) {
+		return -ENXIO;
+	}
+
+	fs->gc_erase_addr += info.size;
+	if ((fs->gc_erase_addr & ADDR_OFFS_MASK) >= fs->sector_size) {
+		fs->gc_erase_addr = NVS_GC_ERASE_NONE;
+		return 0;
+	}
+
+	return 1;
+}
+
+/* complete the erase of the sector released by gc, before writing to it */
+static int nvs_gc_erase_finish(struct nvs_fs *fs)
+{
+	int rc;
+
+	do {
+		rc = nvs_gc_erase_step(fs);
+	} while (rc > 0);
+
+	return rc;
+}
+
+static void nvs_gc_work_handler(struct k_work *work)
+{
+	struct nvs_fs *fs = CONTAINER_OF(work, struct nvs_fs, gc_work);
+	int rc;
+
+	/* One page at a time, so that a write waits for one page erase at
+	 * most.
+	 */
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	rc = nvs_gc_erase_step(fs);
+	k_mutex_unlock(&fs->nvs_lock);
+
+	if (rc > 0) {
+		k_work_submit(&fs->gc_work);
+	} else if (rc < 0) {
+		/* retried by the write needing the sector */
+		LOG_ERR("Erase of released sector failed: %d", rc);
+	}
+}
+#endif /* CONFIG_NVS_BACKGROUND_GC */
+
 /* crc update on allocation entry */
 static void nvs_ate_crc8_update(struct nvs_ate *entry)
 {
@@ -322,9 +418,53 @@ static int nvs_close_ate_valid(struct nvs_fs *fs, const struct nvs_ate *entry)
 	return 1;
 }
 
+/* nvs_ate_usable validates an ate and checks that it is not part of an
+ * interrupted batch. The ates of a batch are written in a row in one sector
+ * and all but the last have part set to NVS_PART_BATCH, so a batch is
+ * complete if such an ate is followed by a valid ate with another part.
+ * return 1 if usable, 0 otherwise, errcode if error
+ */
+static int nvs_ate_usable(struct nvs_fs *fs, uint32_t addr,
+			  const struct nvs_ate *entry)
+{
+	int rc;
+	struct nvs_ate next_ate;
+	size_t ate_size;
+
+	if (!nvs_ate_valid(fs, entry)) {
+		return 0;
+	}
+
+	if (entry->part != NVS_PART_BATCH) {
+		return 1;
+	}
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	while ((addr & ADDR_OFFS_MASK) >= ate_size) {
+		addr -= ate_size;
+		rc = nvs_flash_ate_rd(fs, addr, &next_ate);
+		if (rc) {
+			return rc;
+		}
+
+		if ((!nvs_ate_valid(fs, &next_ate)) ||
+		    (next_ate.id == 0xFFFF)) {
+			/* the batch was interrupted */
+			return 0;
+		}
+
+		if (next_ate.part != NVS_PART_BATCH) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
 /* store an entry in flash */
 static int nvs_flash_wrt_entry(struct nvs_fs *fs, uint16_t id, const void *data,
-				size_t len)
+				size_t len, uint8_t part)
 {
 	int rc;
 	struct nvs_ate entry;
@@ -335,7 +475,7 @@ static int nvs_flash_wrt_entry(struct nvs_fs *fs, uint16_t id, const void *data,
 	entry.id = id;
 	entry.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
 	entry.len = (uint16_t)len;
-	entry.part = 0xff;
+	entry.part = part;
 
 	nvs_ate_crc8_update(&entry);
 
@@ -419,6 +559,18 @@ static int nvs_prev_ate(struct nvs_fs *fs, uint32_t *addr, struct nvs_ate *ate)
 		*addr -= (1 << ADDR_SECT_SHIFT);
 	}
 
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	/* the sector released by gc is the end of the filesystem, even if it
+	 * still holds old entries.
+	 */
+	if ((fs->gc_erase_addr != NVS_GC_ERASE_NONE) &&
+	    (((*addr) >> ADDR_SECT_SHIFT) ==
+	     (fs->gc_erase_addr >> ADDR_SECT_SHIFT))) {
+		*addr = fs->ate_wra;
+		return 0;
+	}
+#endif
+
 	rc = nvs_flash_ate_rd(fs, *addr, &close_ate);
 	if (rc) {
 		return rc;
@@ -449,6 +601,63 @@ static int nvs_prev_ate(struct nvs_fs *fs, uint32_t *addr, struct nvs_ate *ate)
 	return nvs_recover_last_ate(fs, addr);
 }
 
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
+{
+	int rc;
+	uint32_t addr, ate_addr;
+	uint32_t *cache_entry;
+	struct nvs_ate ate;
+
+	memset(fs->lookup_cache, 0xff, sizeof(fs->lookup_cache));
+	addr = fs->ate_wra;
+
+	while (true) {
+		/* nvs_prev_ate() moves addr to the previous ATE */
+		ate_addr = addr;
+		rc = nvs_prev_ate(fs, &addr, &ate);
+		if (rc) {
+			return rc;
+		}
+
+		cache_entry = &fs->lookup_cache[nvs_lookup_cache_pos(ate.id)];
+
+		if (ate.id != 0xFFFF &&
+		    *cache_entry == NVS_LOOKUP_CACHE_NO_ADDR) {
+			rc = nvs_ate_usable(fs, ate_addr, &ate);
+			if (rc < 0) {
+				return rc;
+			}
+			if (rc) {
+				*cache_entry = ate_addr;
+			}
+		}
+
+		if (addr == fs->ate_wra) {
+			break;
+		}
+	}
+
+	return 0;
+}
+
+/* Forget the ATEs of a sector which is about to be erased. The IDs of these
+ * entries have no more recent ATE: it would be cached instead.
+ */
+static void nvs_lookup_cache_invalidate(struct nvs_fs *fs, uint32_t sector)
+{
+	uint32_t *cache_entry = fs->lookup_cache;
+	uint32_t *const cache_end =
+		&fs->lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
+
+	for (; cache_entry < cache_end; ++cache_entry) {
+		if ((*cache_entry >> ADDR_SECT_SHIFT) == sector) {
+			*cache_entry = NVS_LOOKUP_CACHE_NO_ADDR;
+		}
+	}
+}
+#endif /* CONFIG_NVS_LOOKUP_CACHE */
+
 static void nvs_sector_advance(struct nvs_fs *fs, uint32_t *addr)
 {
 	*addr += (1 << ADDR_SECT_SHIFT);
@@ -498,6 +707,39 @@ static int nvs_add_gc_done_ate(struct nvs_fs *fs)
 
 	return nvs_flash_ate_wrt(fs, &gc_done_ate);
 }
+/* A batch interrupted by a reset or a flash error leaves ates with part set
+ * to NVS_PART_BATCH at the head of the ate list. End it with a gc done ate,
+ * so that the next ate written does not complete it.
+ */
+static int nvs_abort_batch(struct nvs_fs *fs)
+{
+	int rc;
+	struct nvs_ate last_ate;
+	uint32_t addr;
+	size_t ate_size;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+	addr = fs->ate_wra + ate_size;
+
+	if ((addr & ADDR_OFFS_MASK) >= (fs->sector_size - ate_size)) {
+		/* no ate in the sector yet */
+		return 0;
+	}
+
+	rc = nvs_flash_ate_rd(fs, addr, &last_ate);
+	if (rc) {
+		return rc;
+	}
+
+	if ((!nvs_ate_valid(fs, &last_ate)) || (last_ate.id == 0xFFFF) ||
+	    (last_ate.part != NVS_PART_BATCH)) {
+		return 0;
+	}
+
+	LOG_INF("Interrupted batch found");
+	return nvs_add_gc_done_ate(fs);
+}
+
 /* garbage collection: the address ate_wra has been updated to the new sector
  * that has just been started. The data to gc is in the sector after this new
  * sector.
@@ -547,7 +789,11 @@ static int nvs_gc(struct nvs_fs *fs)
 			return rc;
 		}
 
-		if (!nvs_ate_valid(fs, &gc_ate)) {
+		rc = nvs_ate_usable(fs, gc_prev_addr, &gc_ate);
+		if (rc < 0) {
+			return rc;
+		}
+		if (!rc) {
 			continue;
 		}
 
@@ -563,9 +809,15 @@ static int nvs_gc(struct nvs_fs *fs)
 			 * have been written that has the same ate but is
 			 * invalid, don't consider these as a match.
 			 */
-			if ((wlk_ate.id == gc_ate.id) &&
-			    (nvs_ate_valid(fs, &wlk_ate))) {
-				break;
+			if (wlk_ate.id == gc_ate.id) {
+				rc = nvs_ate_usable(fs, wlk_prev_addr,
+						    &wlk_ate);
+				if (rc < 0) {
+					return rc;
+				}
+				if (rc) {
+					break;
+				}
 			}
 		} while (wlk_addr != fs->ate_wra);
 
@@ -580,6 +832,8 @@ static int nvs_gc(struct nvs_fs *fs)
 			data_addr += gc_ate.offset;
 
 			gc_ate.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
+			/* the moved entry is no longer next to its batch */
+			gc_ate.part = 0xff;
 			nvs_ate_crc8_update(&gc_ate);
 
 			rc = nvs_flash_block_move(fs, data_addr, gc_ate.len);
@@ -596,6 +850,10 @@ static int nvs_gc(struct nvs_fs *fs)
 
 gc_done:
 
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	nvs_lookup_cache_invalidate(fs, sec_addr >> ADDR_SECT_SHIFT);
+#endif
+
 	/* Make it possible to detect that gc has finished by writing a
 	 * gc done ate to the sector. In the field we might have nvs systems
 	 * that do not have sufficient space to add this ate, so for these
@@ -607,6 +865,15 @@ gc_done:
 		if (rc) {
 			return rc;
 		}
+
+#ifdef CONFIG_NVS_BACKGROUND_GC
+		/* With the gc done ate, an interrupted erase is completed at
+		 * startup, so the sector can be erased later.
+		 */
+		fs->gc_erase_addr = sec_addr;
+		k_work_submit(&fs->gc_work);
+		return 0;
+#endif
 	}
 
 	/* Erase the gc'ed sector */
@@ -819,6 +1086,16 @@ end:
 
 		rc = nvs_add_gc_done_ate(fs);
 	}
+
+	if (!rc) {
+		rc = nvs_abort_batch(fs);
+	}
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	if (!rc) {
+		rc = nvs_lookup_cache_rebuild(fs);
+	}
+#endif
 	k_mutex_unlock(&fs->nvs_lock);
 	return rc;
 }
@@ -833,6 +1110,12 @@ int nvs_clear(struct nvs_fs *fs)
 		return -EACCES;
 	}
 
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	fs->gc_erase_addr = NVS_GC_ERASE_NONE;
+	k_mutex_unlock(&fs->nvs_lock);
+#endif
+
 	for (uint16_t i = 0; i < fs->sector_count; i++) {
 		addr = i << ADDR_SECT_SHIFT;
 		rc = nvs_flash_erase_sector(fs, addr);
@@ -840,6 +1123,10 @@ int nvs_clear(struct nvs_fs *fs)
 			return rc;
 		}
 	}
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	memset(fs->lookup_cache, 0xff, sizeof(fs->lookup_cache));
+#endif
 	return 0;
 }
 
@@ -850,6 +1137,18 @@ int nvs_init(struct nvs_fs *fs, const char *dev_name)
 	struct flash_pages_info info;
 	size_t write_block_size;
 
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	if (fs->ready) {
+		struct k_work_sync sync;
+
+		/* an erase left by the previous mount is done at startup */
+		k_work_cancel_sync(&fs->gc_work, &sync);
+	}
+
+	k_work_init(&fs->gc_work, nvs_gc_work_handler);
+	fs->gc_erase_addr = NVS_GC_ERASE_NONE;
+#endif
+
 	k_mutex_init(&fs->nvs_lock);
 
 	fs->flash_device = device_get_binding(dev_name);
@@ -935,7 +1234,15 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 	}
 
 	/* find latest entry with same id */
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
+
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		goto no_cached_entry;
+	}
+#else
 	wlk_addr = fs->ate_wra;
+#endif
 	rd_addr = wlk_addr;
 
 	while (1) {
@@ -944,15 +1251,24 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 		if (rc) {
 			return rc;
 		}
-		if ((wlk_ate.id == id) && (nvs_ate_valid(fs, &wlk_ate))) {
-			prev_found = true;
-			break;
+		if (wlk_ate.id == id) {
+			rc = nvs_ate_usable(fs, rd_addr, &wlk_ate);
+			if (rc < 0) {
+				return rc;
+			}
+			if (rc) {
+				prev_found = true;
+				break;
+			}
 		}
 		if (wlk_addr == fs->ate_wra) {
 			break;
 		}
 	}
 
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+no_cached_entry:
+#endif
 	if (prev_found) {
 		/* previous entry found */
 		rd_addr &= ADDR_SECT_MASK;
@@ -1001,7 +1317,7 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 
 		if (fs->ate_wra >= (fs->data_wra + required_space)) {
 
-			rc = nvs_flash_wrt_entry(fs, id, data, len);
+			rc = nvs_flash_wrt_entry(fs, id, data, len, 0xff);
 			if (rc) {
 				goto end;
 			}
@@ -1009,6 +1325,14 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 		}
 
 
+#ifdef CONFIG_NVS_BACKGROUND_GC
+		/* the next sector is written once the current one is closed */
+		rc = nvs_gc_erase_finish(fs);
+		if (rc) {
+			goto end;
+		}
+#endif
+
 		rc = nvs_sector_close(fs);
 		if (rc) {
 			goto end;
@@ -1031,6 +1355,104 @@ int nvs_delete(struct nvs_fs *fs, uint16_t id)
 	return nvs_write(fs, id, NULL, 0);
 }
 
+int nvs_write_batch(struct nvs_fs *fs, const struct nvs_batch_entry *entries,
+		    size_t count)
+{
+	int rc, gc_count;
+	size_t ate_size, data_size, required_space;
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	if (count == 0) {
+		return 0;
+	}
+
+	if (count == 1) {
+		rc = nvs_write(fs, entries[0].id, entries[0].data,
+			       entries[0].len);
+		return (rc < 0) ? rc : 0;
+	}
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	if (count > (fs->sector_size / ate_size)) {
+		return -EINVAL;
+	}
+
+	data_size = 0;
+	for (size_t i = 0; i < count; i++) {
+		if ((entries[i].len > (fs->sector_size - 4 * ate_size)) ||
+		    ((entries[i].len > 0) && (entries[i].data == NULL))) {
+			return -EINVAL;
+		}
+		data_size += nvs_al_size(fs, entries[i].len);
+	}
+
+	/* The whole batch is written in one sector, which also holds a
+	 * sector close ate, a gc done ate, an ate to end the batch if it is
+	 * interrupted and an ate to always allow a delete.
+	 */
+	if (data_size + (count + 4) * ate_size > fs->sector_size) {
+		return -EINVAL;
+	}
+
+	/* the ate of the first entry is written at ate_wra */
+	required_space = data_size + (count + 1) * ate_size;
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	gc_count = 0;
+	while (1) {
+		if (gc_count == fs->sector_count) {
+			rc = -ENOSPC;
+			goto end;
+		}
+
+		if (fs->ate_wra >= (fs->data_wra + required_space)) {
+			break;
+		}
+
+#ifdef CONFIG_NVS_BACKGROUND_GC
+		rc = nvs_gc_erase_finish(fs);
+		if (rc) {
+			goto end;
+		}
+#endif
+
+		rc = nvs_sector_close(fs);
+		if (rc) {
+			goto end;
+		}
+
+		rc = nvs_gc(fs);
+		if (rc) {
+			goto end;
+		}
+		gc_count++;
+	}
+
+	/* The last entry commits the batch */
+	for (size_t i = 0; i < count; i++) {
+		rc = nvs_flash_wrt_entry(fs, entries[i].id, entries[i].data,
+					 entries[i].len,
+					 (i < count - 1) ? NVS_PART_BATCH : 0xff);
+		if (rc) {
+			if (i > 0) {
+				(void)nvs_abort_batch(fs);
+			}
+			goto end;
+		}
+	}
+
+	rc = 0;
+end:
+	k_mutex_unlock(&fs->nvs_lock);
+	return rc;
+}
+
 ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 		      uint16_t cnt)
 {
@@ -1053,7 +1475,16 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 
 	cnt_his = 0U;
 
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
+
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		rc = -ENOENT;
+		goto err;
+	}
+#else
 	wlk_addr = fs->ate_wra;
+#endif
 	rd_addr = wlk_addr;
 
 	while (cnt_his <= cnt) {
@@ -1062,16 +1493,22 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 		if (rc) {
 			goto err;
 		}
-		if ((wlk_ate.id == id) &&  (nvs_ate_valid(fs, &wlk_ate))) {
-			cnt_his++;
+		if (wlk_ate.id == id) {
+			rc = nvs_ate_usable(fs, rd_addr, &wlk_ate);
+			if (rc < 0) {
+				goto err;
+			}
+			if (rc) {
+				cnt_his++;
+			}
 		}
 		if (wlk_addr == fs->ate_wra) {
 			break;
 		}
 	}
 
-	if (((wlk_addr == fs->ate_wra) && (wlk_ate.id != id)) ||
-	    (wlk_ate.len == 0U) || (cnt_his < cnt)) {
+	/* the walk stops past the requested entry, unless it is not found */
+	if ((cnt_his <= cnt) || (wlk_ate.len == 0U)) {
 		return -ENOENT;
 	}
 
@@ -28,12 +28,19 @@ extern "C" {
 
 #define NVS_BLOCK_SIZE 32
 
+/* Part of the ates of a batch but the last */
+#define NVS_PART_BATCH 0xfe
+
+#define NVS_LOOKUP_CACHE_NO_ADDR 0xFFFFFFFF
+
+#define NVS_GC_ERASE_NONE 0xFFFFFFFF
+
 /* Allocation Table Entry */
 struct nvs_ate {
 	uint16_t id;	/* data id */
 	uint16_t offset;	/* data offset within sector */
 	uint16_t len;	/* data len within sector */
-	uint8_t part;	/* part of a multipart data - future extension */
+	uint8_t part;	/* part of a multipart data, or NVS_PART_BATCH */
 	uint8_t crc8;	/* crc8 check of the entry */
 } __packed;
 
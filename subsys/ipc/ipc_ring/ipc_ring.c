@@ -0,0 +1,550 @@
+/*
+ * Copyright (c) 2021, Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ipc/ipc_ring.h>
+
+#include <zephyr.h>
+#include <device.h>
+#include <cache.h>
+#include <drivers/ipm.h>
+#include <logging/log.h>
+#include <string.h>
+
+#define LOG_MODULE_NAME ipc_ring
+LOG_MODULE_REGISTER(LOG_MODULE_NAME, CONFIG_IPC_RING_LOG_LEVEL);
+
+#if !DT_HAS_CHOSEN(zephyr_ipc_shm)
+#error "Module requires definition of shared memory for the rings"
+#endif
+
+#define MASTER IS_ENABLED(CONFIG_IPC_RING_MODE_MASTER)
+
+#define LINE_SIZE CONFIG_IPC_RING_CACHE_LINE_SIZE
+
+BUILD_ASSERT((CONFIG_IPC_RING_SHM_BASE_ADDRESS % LINE_SIZE) == 0,
+	     "Shared memory must be aligned on cache lines");
+
+/* Written by the producer, once the ring was reset. "IRNG" */
+#define RING_MAGIC 0x474e5249U
+
+/* The indexes each have their own cache line, so that the writes of one core
+ * never write back a stale copy of the index of the other.
+ */
+struct ring_hdr {
+	/* Written by the producer. */
+	uint32_t magic __aligned(LINE_SIZE);
+	uint32_t wr_idx;
+	/* Written by the consumer. */
+	uint32_t rd_idx __aligned(LINE_SIZE);
+};
+
+/* Each core writes to one half of the shared memory. */
+#define RING_AREA_SIZE	ROUND_DOWN(CONFIG_IPC_RING_SHM_SIZE / 2, LINE_SIZE)
+#define RING_DATA_SIZE	ROUND_DOWN(RING_AREA_SIZE - sizeof(struct ring_hdr), 4)
+
+#if MASTER
+#define TX_AREA_ADDR	CONFIG_IPC_RING_SHM_BASE_ADDRESS
+#define RX_AREA_ADDR	(CONFIG_IPC_RING_SHM_BASE_ADDRESS + RING_AREA_SIZE)
+#else
+#define TX_AREA_ADDR	(CONFIG_IPC_RING_SHM_BASE_ADDRESS + RING_AREA_SIZE)
+#define RX_AREA_ADDR	CONFIG_IPC_RING_SHM_BASE_ADDRESS
+#endif
+
+struct ring {
+	volatile struct ring_hdr *hdr;
+	uint8_t *data;
+};
+
+static const struct ring tx = {
+	.hdr = (volatile struct ring_hdr *)TX_AREA_ADDR,
+	.data = (uint8_t *)(TX_AREA_ADDR + sizeof(struct ring_hdr)),
+};
+
+static const struct ring rx = {
+	.hdr = (volatile struct ring_hdr *)RX_AREA_ADDR,
+	.data = (uint8_t *)(RX_AREA_ADDR + sizeof(struct ring_hdr)),
+};
+
+/* Messages start on 4 bytes boundaries, and never wrap around the end of the
+ * ring: the end is skipped with a padding message instead.
+ */
+struct msg_hdr {
+	uint16_t len;
+	/* Id of the endpoint on the receiving core. */
+	uint8_t ept;
+	uint8_t type;
+};
+
+enum msg_type {
+	MSG_DATA,
+	/* Payload: id of the endpoint on the sending core, reply flag and
+	 * name.
+	 */
+	MSG_BIND,
+	MSG_PAD,
+};
+
+#define MSG_SIZE(len) (sizeof(struct msg_hdr) + ROUND_UP(len, 4))
+
+#if IS_ENABLED(CONFIG_COOP_ENABLED)
+#define WORK_QUEUE_PRIORITY -1
+#else
+#define WORK_QUEUE_PRIORITY 0
+#endif
+
+K_THREAD_STACK_DEFINE(ipc_ring_stack_area,
+		      CONFIG_IPC_RING_WORK_QUEUE_STACK_SIZE);
+
+static struct k_work_q ipc_ring_work_q;
+static struct k_work rx_work;
+static struct k_work_delayable notify_work;
+
+#if defined(CONFIG_IPC_RING_DUAL_IPM_SUPPORT)
+static const struct device *ipm_tx_handle;
+static const struct device *ipm_rx_handle;
+#elif defined(CONFIG_IPC_RING_SINGLE_IPM_SUPPORT)
+static const struct device *ipm_handle;
+#endif
+
+static struct {
+	const char *name;
+	ipc_ring_ept_cb cb;
+	void *priv;
+	/* Id of the endpoint on the remote core. */
+	uint8_t remote_id;
+	volatile bool bound;
+} endpoints[CONFIG_IPC_RING_NUM_ENDPOINTS];
+
+/* Protects the endpoints table and the producer side of the TX ring. */
+static struct k_spinlock lock;
+static int num_endpoints;
+static bool initialized;
+/* Bytes written since the remote core was last notified. */
+static uint32_t unnotified;
+
+static inline void cache_wb(volatile void *addr, size_t size)
+{
+#if defined(CONFIG_CACHE_MANAGEMENT)
+	sys_cache_data_range((void *)addr, size, K_CACHE_WB);
+#endif
+}
+
+static inline void cache_inv(volatile void *addr, size_t size)
+{
+#if defined(CONFIG_CACHE_MANAGEMENT)
+	sys_cache_data_range((void *)addr, size, K_CACHE_INVD);
+#endif
+}
+
+static void notify(void)
+{
+	int status;
+
+#if defined(CONFIG_IPC_RING_DUAL_IPM_SUPPORT)
+	status = ipm_send(ipm_tx_handle, 0, 0, NULL, 0);
+#elif defined(CONFIG_IPC_RING_SINGLE_IPM_SUPPORT)
+	uint32_t dummy_data = 0x55005500; /* Some data must be provided */
+
+	status = ipm_send(ipm_handle, 0, 0, &dummy_data, sizeof(dummy_data));
+#endif
+
+	if (status != 0) {
+		LOG_ERR("ipm_send failed to notify: %d", status);
+	}
+}
+
+static void notify_work_handler(struct k_work *work)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	unnotified = 0;
+	k_spin_unlock(&lock, key);
+
+	notify();
+}
+
+/* Write a message made of two parts, called with the lock held. */
+static int msg_put(uint8_t type, uint8_t ept, const void *data1, size_t len1,
+		   const void *data2, size_t len2)
+{
+	size_t len = len1 + len2;
+	uint32_t total = MSG_SIZE(len);
+	uint32_t wr = tx.hdr->wr_idx;
+	uint32_t pad = 0;
+	uint32_t used;
+	uint32_t rd;
+	struct msg_hdr *hdr;
+
+	/* One word stays free, so that a full ring is told from an empty
+	 * one.
+	 */
+	if (len > UINT16_MAX || total > RING_DATA_SIZE - 4) {
+		return -EMSGSIZE;
+	}
+
+	cache_inv(&tx.hdr->rd_idx, sizeof(uint32_t));
+	rd = tx.hdr->rd_idx;
+
+	if (wr + total > RING_DATA_SIZE) {
+		pad = RING_DATA_SIZE - wr;
+	}
+
+	used = (wr >= rd) ? (wr - rd) : (RING_DATA_SIZE - rd + wr);
+	if (RING_DATA_SIZE - used - 4 < pad + total) {
+		return -ENOMEM;
+	}
+
+	if (pad > 0) {
+		hdr = (struct msg_hdr *)&tx.data[wr];
+		hdr->len = pad - sizeof(*hdr);
+		hdr->ept = 0;
+		hdr->type = MSG_PAD;
+		cache_wb(hdr, sizeof(*hdr));
+		wr = 0;
+	}
+
+	hdr = (struct msg_hdr *)&tx.data[wr];
+	hdr->len = len;
+	hdr->ept = ept;
+	hdr->type = type;
+	memcpy(hdr + 1, data1, len1);
+	if (len2 > 0) {
+		memcpy((uint8_t *)(hdr + 1) + len1, data2, len2);
+	}
+	cache_wb(hdr, total);
+
+	wr += total;
+	if (wr == RING_DATA_SIZE) {
+		wr = 0;
+	}
+
+	/* The message must be in the shared memory before the index. */
+	__sync_synchronize();
+	tx.hdr->wr_idx = wr;
+	cache_wb(&tx.hdr->wr_idx, sizeof(uint32_t));
+
+	unnotified += pad + total;
+
+	return len;
+}
+
+static void bind_send(int id, bool reply)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	const char *name = endpoints[id].name;
+	uint8_t info[2] = { id, reply };
+	int err;
+
+	err = msg_put(MSG_BIND, 0, info, sizeof(info), name, strlen(name));
+	if (err >= 0) {
+		unnotified = 0;
+	}
+	k_spin_unlock(&lock, key);
+
+	if (err < 0) {
+		LOG_ERR("Announcing endpoint %s failed: %d", log_strdup(name),
+			err);
+		return;
+	}
+
+	notify();
+}
+
+static void bind_handle(const uint8_t *payload, size_t len)
+{
+	const char *name = (const char *)&payload[2];
+	size_t name_len;
+
+	if (len < 2) {
+		return;
+	}
+
+	name_len = len - 2;
+
+	for (int i = 0; i < num_endpoints; i++) {
+		if (strlen(endpoints[i].name) != name_len ||
+		    memcmp(endpoints[i].name, name, name_len) != 0) {
+			continue;
+		}
+
+		endpoints[i].remote_id = payload[0];
+		endpoints[i].bound = true;
+
+		/* The remote endpoint may have been registered after this
+		 * one was announced.
+		 */
+		if (!payload[1]) {
+			bind_send(i, true);
+		}
+
+		return;
+	}
+
+	LOG_DBG("Remote endpoint not registered locally");
+}
+
+static void msg_handle(const struct msg_hdr *hdr)
+{
+	const uint8_t *payload = (const uint8_t *)(hdr + 1);
+
+	switch (hdr->type) {
+	case MSG_DATA:
+		if (hdr->ept < num_endpoints && endpoints[hdr->ept].cb) {
+			endpoints[hdr->ept].cb(payload, hdr->len,
+					       endpoints[hdr->ept].priv);
+		}
+		break;
+	case MSG_BIND:
+		bind_handle(payload, hdr->len);
+		break;
+	default:
+		break;
+	}
+}
+
+static void rx_process(struct k_work *work)
+{
+	const struct msg_hdr *hdr;
+	uint32_t total;
+	uint32_t rd;
+	uint32_t wr;
+
+	cache_inv(&rx.hdr->magic, LINE_SIZE);
+	if (rx.hdr->magic != RING_MAGIC) {
+		/* The remote core has not started yet. */
+		return;
+	}
+
+	rd = rx.hdr->rd_idx;
+	wr = rx.hdr->wr_idx;
+
+	while (rd != wr) {
+		if (rd >= RING_DATA_SIZE || wr >= RING_DATA_SIZE) {
+			LOG_ERR("Ring indexes out of range");
+			return;
+		}
+
+		/* Read the message after the index. */
+		__sync_synchronize();
+
+		hdr = (const struct msg_hdr *)&rx.data[rd];
+		cache_inv((void *)hdr, sizeof(*hdr));
+		total = MSG_SIZE(hdr->len);
+		if (rd + total > RING_DATA_SIZE) {
+			LOG_ERR("Message out of the ring");
+			return;
+		}
+
+		cache_inv((void *)(hdr + 1), hdr->len);
+		msg_handle(hdr);
+
+		rd += total;
+		if (rd == RING_DATA_SIZE) {
+			rd = 0;
+		}
+
+		/* Done with the message before it is given back. */
+		__sync_synchronize();
+		rx.hdr->rd_idx = rd;
+		cache_wb(&rx.hdr->rd_idx, sizeof(uint32_t));
+
+		if (rd == wr) {
+			cache_inv(&rx.hdr->magic, LINE_SIZE);
+			wr = rx.hdr->wr_idx;
+		}
+	}
+}
+
+static void ipm_callback(const struct device *dev, void *context,
+			 uint32_t id, volatile void *data)
+{
+	k_work_submit_to_queue(&ipc_ring_work_q, &rx_work);
+}
+
+int ipc_ring_register_endpoint(const char *name, ipc_ring_ept_cb cb,
+			       void *priv)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	bool announce = initialized;
+	int id;
+
+	if (num_endpoints == CONFIG_IPC_RING_NUM_ENDPOINTS) {
+		k_spin_unlock(&lock, key);
+		return -ENOMEM;
+	}
+
+	id = num_endpoints;
+	endpoints[id].name = name;
+	endpoints[id].cb = cb;
+	endpoints[id].priv = priv;
+	endpoints[id].bound = false;
+	num_endpoints++;
+
+	k_spin_unlock(&lock, key);
+
+	/* Otherwise announced by the initialization. */
+	if (announce) {
+		bind_send(id, false);
+	}
+
+	return id;
+}
+
+int ipc_ring_send(int endpoint_id, const void *data, size_t len)
+{
+	k_spinlock_key_t key;
+	bool now;
+	int ret;
+
+	if (endpoint_id < 0 || endpoint_id >= num_endpoints) {
+		return -EINVAL;
+	}
+
+	if (!endpoints[endpoint_id].bound) {
+		return -ENOTCONN;
+	}
+
+	key = k_spin_lock(&lock);
+	ret = msg_put(MSG_DATA, endpoints[endpoint_id].remote_id, data, len,
+		      NULL, 0);
+	/* A full ring must not wait for the delayed notification. */
+	now = (unnotified >= CONFIG_IPC_RING_NOTIFY_THRESHOLD) ||
+	      (ret == -ENOMEM && unnotified > 0);
+	if (now) {
+		unnotified = 0;
+	}
+	k_spin_unlock(&lock, key);
+
+	if (now) {
+		notify();
+	} else if (ret >= 0) {
+		/* Does nothing if already scheduled, which bounds the
+		 * latency of the coalesced messages.
+		 */
+		(void)k_work_schedule_for_queue(&ipc_ring_work_q, &notify_work,
+				K_USEC(CONFIG_IPC_RING_NOTIFY_DELAY_US));
+	}
+
+	return ret;
+}
+
+bool ipc_ring_endpoint_is_bound(int endpoint_id)
+{
+	if (endpoint_id < 0 || endpoint_id >= num_endpoints) {
+		return false;
+	}
+
+	return endpoints[endpoint_id].bound;
+}
+
+static int ipm_setup(void)
+{
+#if defined(CONFIG_IPC_RING_DUAL_IPM_SUPPORT)
+	ipm_tx_handle = device_get_binding(CONFIG_IPC_RING_IPM_TX_NAME);
+	ipm_rx_handle = device_get_binding(CONFIG_IPC_RING_IPM_RX_NAME);
+
+	if (!ipm_tx_handle) {
+		LOG_ERR("Could not get TX IPM device handle");
+		return -ENODEV;
+	}
+
+	if (!ipm_rx_handle) {
+		LOG_ERR("Could not get RX IPM device handle");
+		return -ENODEV;
+	}
+
+	ipm_register_callback(ipm_rx_handle, ipm_callback, NULL);
+#elif defined(CONFIG_IPC_RING_SINGLE_IPM_SUPPORT)
+	int err;
+
+	ipm_handle = device_get_binding(CONFIG_IPC_RING_IPM_NAME);
+
+	if (ipm_handle == NULL) {
+		LOG_ERR("Could not get IPM device handle");
+		return -ENODEV;
+	}
+
+	ipm_register_callback(ipm_handle, ipm_callback, NULL);
+
+	err = ipm_set_enabled(ipm_handle, 1);
+	if (err != 0) {
+		LOG_ERR("Could not enable IPM interrupts and callbacks");
+		return err;
+	}
+#endif
+
+	return 0;
+}
+
+static int ipc_ring_init(const struct device *dev)
+{
+	k_spinlock_key_t key;
+	int count;
+	int err;
+
+	ARG_UNUSED(dev);
+
+	k_work_queue_start(&ipc_ring_work_q, ipc_ring_stack_area,
+			   K_THREAD_STACK_SIZEOF(ipc_ring_stack_area),
+			   WORK_QUEUE_PRIORITY, NULL);
+	k_thread_name_set(&ipc_ring_work_q.thread, "ipc_ring_work_q");
+
+	k_work_init(&rx_work, rx_process);
+	k_work_init_delayable(&notify_work, notify_work_handler);
+
+	/* Reset the ring this core writes, then tell the remote core it may
+	 * read it.
+	 */
+	tx.hdr->magic = 0;
+	tx.hdr->wr_idx = 0;
+	tx.hdr->rd_idx = 0;
+	cache_wb(tx.hdr, sizeof(struct ring_hdr));
+	__sync_synchronize();
+	tx.hdr->magic = RING_MAGIC;
+	cache_wb(&tx.hdr->magic, sizeof(uint32_t));
+
+	err = ipm_setup();
+	if (err) {
+		return err;
+	}
+
+	key = k_spin_lock(&lock);
+	initialized = true;
+	count = num_endpoints;
+	k_spin_unlock(&lock, key);
+
+	for (int i = 0; i < count; i++) {
+		bind_send(i, false);
+	}
+
+	/* The remote core may have started first, its notification is
+	 * lost.
+	 */
+	k_work_submit_to_queue(&ipc_ring_work_q, &rx_work);
+
+	return 0;
+}
+
+SYS_INIT(ipc_ring_init, POST_KERNEL, CONFIG_IPC_RING_INIT_PRIORITY);
+
+#if MASTER
+/* Invalidate both rings very early, before the secondary core is brought up,
+ * so that it does not read what the rings held before a reset.
+ */
+static int ipc_ring_clear(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	tx.hdr->magic = 0;
+	rx.hdr->magic = 0;
+	cache_wb(&tx.hdr->magic, sizeof(uint32_t));
+	cache_wb(&rx.hdr->magic, sizeof(uint32_t));
+
+	return 0;
+}
+
+SYS_INIT(ipc_ring_clear, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif /* MASTER */
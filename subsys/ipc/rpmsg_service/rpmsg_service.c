@@ -161,4 +161,25 @@ int rpmsg_service_send(int endpoint_id, const void *data, size_t len)
 	return rpmsg_send(&endpoints[endpoint_id].ep, data, len);
 }
 
+void *rpmsg_service_get_tx_buffer(int endpoint_id, uint32_t *len, bool wait)
+{
+	return rpmsg_get_tx_payload_buffer(&endpoints[endpoint_id].ep, len,
+					   wait);
+}
+
+int rpmsg_service_send_nocopy(int endpoint_id, const void *data, size_t len)
+{
+	return rpmsg_send_nocopy(&endpoints[endpoint_id].ep, data, len);
+}
+
+void rpmsg_service_hold_rx_buffer(int endpoint_id, void *data)
+{
+	rpmsg_hold_rx_buffer(&endpoints[endpoint_id].ep, data);
+}
+
+void rpmsg_service_release_rx_buffer(int endpoint_id, void *data)
+{
+	rpmsg_release_rx_buffer(&endpoints[endpoint_id].ep, data);
+}
+
 SYS_INIT(rpmsg_service_init, POST_KERNEL, CONFIG_RPMSG_SERVICE_INIT_PRIORITY);
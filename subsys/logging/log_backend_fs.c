@@ -6,6 +6,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <kernel.h>
 #include <logging/log_backend.h>
 #include <logging/log_output_dict.h>
 #include <logging/log_backend_std.h>
@@ -424,8 +425,130 @@ BUILD_ASSERT(!IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE),
 
 #ifndef CONFIG_LOG_BACKEND_FS_TESTSUITE
 
+#if CONFIG_LOG_BACKEND_FS_BLOCK_SIZE > 0
+#define BLOCK_SIZE CONFIG_LOG_BACKEND_FS_BLOCK_SIZE
+#define BLOCK_COUNT CONFIG_LOG_BACKEND_FS_BLOCK_COUNT
+
+struct log_block {
+	uint8_t __aligned(4) data[BLOCK_SIZE];
+	size_t len;
+};
+
+static struct log_block blocks[BLOCK_COUNT];
+/* Block being filled, NULL while waiting for a free one */
+static struct log_block *fill_block;
+static K_MUTEX_DEFINE(fill_lock);
+K_MSGQ_DEFINE(log_fs_full_blocks, sizeof(struct log_block *), BLOCK_COUNT, 4);
+K_MSGQ_DEFINE(log_fs_free_blocks, sizeof(struct log_block *), BLOCK_COUNT, 4);
+
+static K_KERNEL_STACK_DEFINE(writer_stack,
+			     CONFIG_LOG_BACKEND_FS_THREAD_STACK_SIZE);
+static struct k_thread writer_thread;
+
+/* Called with fill_lock held */
+static void hand_over_block(void)
+{
+	(void)k_msgq_put(&log_fs_full_blocks, &fill_block, K_NO_WAIT);
+	fill_block = NULL;
+}
+
+static int write_log_to_block(uint8_t *data, size_t length, void *ctx)
+{
+	struct log_block *block;
+	size_t len;
+
+	k_mutex_lock(&fill_lock, K_FOREVER);
+
+	for (size_t done = 0; done < length; done += len) {
+		if (!fill_block) {
+			/* The writer only ever takes the block being filled,
+			 * so it stays NULL until a free block is got here.
+			 */
+			k_mutex_unlock(&fill_lock);
+			(void)k_msgq_get(&log_fs_free_blocks, &block,
+					 K_FOREVER);
+			k_mutex_lock(&fill_lock, K_FOREVER);
+
+			block->len = 0;
+			fill_block = block;
+		}
+
+		len = MIN(length - done, BLOCK_SIZE - fill_block->len);
+		memcpy(&fill_block->data[fill_block->len], data + done, len);
+		fill_block->len += len;
+
+		if (fill_block->len == BLOCK_SIZE) {
+			hand_over_block();
+		}
+	}
+
+	k_mutex_unlock(&fill_lock);
+
+	return length;
+}
+
+static void block_writer(void *p1, void *p2, void *p3)
+{
+	k_timeout_t timeout = CONFIG_LOG_BACKEND_FS_FLUSH_MS > 0 ?
+			      K_MSEC(CONFIG_LOG_BACKEND_FS_FLUSH_MS) :
+			      K_FOREVER;
+	struct log_block *block;
+	size_t done;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		if (k_msgq_get(&log_fs_full_blocks, &block, timeout) != 0) {
+			k_mutex_lock(&fill_lock, K_FOREVER);
+			if (fill_block && fill_block->len > 0) {
+				hand_over_block();
+			}
+			k_mutex_unlock(&fill_lock);
+
+			continue;
+		}
+
+		/* As for the log output, 0 is returned once the oldest log
+		 * file is deleted to make room, and the write is retried.
+		 */
+		for (done = 0; done < block->len;) {
+			done += write_log_to_file(&block->data[done],
+						  block->len - done, NULL);
+		}
+
+		(void)k_msgq_put(&log_fs_free_blocks, &block, K_NO_WAIT);
+	}
+}
+
+static void block_writer_start(void)
+{
+	struct log_block *block;
+
+	fill_block = &blocks[0];
+	fill_block->len = 0;
+
+	for (int i = 1; i < BLOCK_COUNT; i++) {
+		block = &blocks[i];
+		(void)k_msgq_put(&log_fs_free_blocks, &block, K_NO_WAIT);
+	}
+
+	k_thread_create(&writer_thread, writer_stack,
+			K_KERNEL_STACK_SIZEOF(writer_stack), block_writer,
+			NULL, NULL, NULL,
+			K_PRIO_PREEMPT(CONFIG_LOG_BACKEND_FS_THREAD_PRIO), 0,
+			K_NO_WAIT);
+	k_thread_name_set(&writer_thread, "log_fs");
+}
+
+#define LOG_FS_OUTPUT_FUNC write_log_to_block
+#else
+#define LOG_FS_OUTPUT_FUNC write_log_to_file
+#endif /* CONFIG_LOG_BACKEND_FS_BLOCK_SIZE > 0 */
+
 static uint8_t __aligned(4) buf[MAX_FLASH_WRITE_SIZE];
-LOG_OUTPUT_DEFINE(log_output, write_log_to_file, buf, MAX_FLASH_WRITE_SIZE);
+LOG_OUTPUT_DEFINE(log_output, LOG_FS_OUTPUT_FUNC, buf, MAX_FLASH_WRITE_SIZE);
 
 static void put(const struct log_backend *const backend,
 		struct log_msg *msg)
@@ -435,6 +558,9 @@ static void put(const struct log_backend *const backend,
 
 static void log_backend_fs_init(const struct log_backend *const backend)
 {
+#if CONFIG_LOG_BACKEND_FS_BLOCK_SIZE > 0
+	block_writer_start();
+#endif
 }
 
 static void panic(struct log_backend const *const backend)
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Backend of a remote domain, passing its log messages over RPMsg to the
+ * domain running the RPMsg link (CONFIG_LOG_LINK_RPMSG), which outputs them
+ * along with its own. Only the message strings are formatted here: the
+ * prefixes, timestamps and output formats are left to the backends of the
+ * other domain.
+ */
+
+#include <errno.h>
+#include <logging/log_backend.h>
+#include <logging/log_core.h>
+#include <logging/log_ctrl.h>
+#include <logging/log_msg2.h>
+#include <ipc/rpmsg_service.h>
+#include <sys/cbprintf.h>
+#include <init.h>
+#include <string.h>
+#include "log_link_rpmsg.h"
+
+struct text_ctx {
+	char *pos;
+	char *end;
+};
+
+static int ep_id = -1;
+static bool names_sent;
+static bool panic_mode;
+static uint32_t dropped_cnt;
+
+static int ep_cb(struct rpmsg_endpoint *ept, void *data, size_t len,
+		 uint32_t src, void *priv)
+{
+	/* Nothing is expected from the other domain. */
+	return RPMSG_SUCCESS;
+}
+
+/* The messages are built in the shared memory buffers of RPMsg, and sent
+ * without being copied.
+ */
+static uint8_t *tx_buf_get(size_t *size)
+{
+	uint8_t *buf;
+	uint32_t len;
+
+	buf = rpmsg_service_get_tx_buffer(ep_id, &len, true);
+	*size = MIN(len, CONFIG_LOG_BACKEND_RPMSG_BUFFER_SIZE);
+
+	return buf;
+}
+
+static int name_send(uint8_t type, uint16_t source, const char *name)
+{
+	struct log_link_rpmsg_hdr *hdr;
+	uint8_t *buf;
+	size_t size;
+	size_t len;
+
+	buf = tx_buf_get(&size);
+	if (buf == NULL) {
+		return -ENOMEM;
+	}
+
+	hdr = (struct log_link_rpmsg_hdr *)buf;
+	len = MIN(strlen(name), size - sizeof(*hdr));
+
+	*hdr = (struct log_link_rpmsg_hdr) {
+		.type = type,
+		.domain = CONFIG_LOG_DOMAIN_ID,
+		.source = source,
+	};
+	memcpy(&buf[sizeof(*hdr)], name, len);
+
+	return rpmsg_service_send_nocopy(ep_id, buf, sizeof(*hdr) + len);
+}
+
+static bool names_send(void)
+{
+	uint32_t cnt = log_src_cnt_get(CONFIG_LOG_DOMAIN_ID);
+
+	if (name_send(LOG_LINK_RPMSG_DOMAIN, LOG_LINK_RPMSG_NO_SOURCE,
+		      CONFIG_LOG_DOMAIN_NAME) < 0) {
+		return false;
+	}
+
+	for (uint32_t i = 0; i < cnt; i++) {
+		if (name_send(LOG_LINK_RPMSG_SOURCE, i,
+			      log_source_name_get(CONFIG_LOG_DOMAIN_ID, i)) < 0) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void dropped_send(void)
+{
+	struct log_link_rpmsg_hdr hdr = {
+		.type = LOG_LINK_RPMSG_DROPPED,
+		.domain = CONFIG_LOG_DOMAIN_ID,
+		.source = LOG_LINK_RPMSG_NO_SOURCE,
+		.dlen = MIN(dropped_cnt, UINT16_MAX),
+	};
+
+	if (rpmsg_service_send(ep_id, &hdr, sizeof(hdr)) >= 0) {
+		dropped_cnt -= hdr.dlen;
+	}
+}
+
+static int text_out(int c, void *ctx)
+{
+	struct text_ctx *text = ctx;
+
+	if (text->pos < text->end) {
+		*text->pos++ = (char)c;
+	}
+
+	return 0;
+}
+
+static int msg_send(struct log_msg2 *msg)
+{
+	void *source = (void *)log_msg2_get_source(msg);
+	struct log_link_rpmsg_hdr *hdr;
+	struct text_ctx text;
+	uint8_t *payload;
+	uint8_t *data;
+	uint8_t *package;
+	uint8_t *buf;
+	size_t size;
+	size_t dlen;
+	size_t plen;
+
+	buf = tx_buf_get(&size);
+	if (buf == NULL) {
+		return -ENOMEM;
+	}
+
+	hdr = (struct log_link_rpmsg_hdr *)buf;
+	payload = &buf[sizeof(*hdr)];
+
+	*hdr = (struct log_link_rpmsg_hdr) {
+		.type = LOG_LINK_RPMSG_LOG,
+		.domain = log_msg2_get_domain(msg),
+		.level = log_msg2_get_level(msg),
+		.source = source == NULL ? LOG_LINK_RPMSG_NO_SOURCE :
+			(IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ?
+				log_dynamic_source_id(source) :
+				log_const_source_id(source)),
+	};
+
+	/* Hexdump data and strings which do not fit are truncated, one byte
+	 * is kept for the string terminator.
+	 */
+	data = log_msg2_get_data(msg, &dlen);
+	dlen = MIN(dlen, size - sizeof(*hdr) - 1);
+	memcpy(payload, data, dlen);
+	hdr->dlen = dlen;
+
+	text.pos = (char *)&payload[dlen];
+	text.end = (char *)&buf[size - 1];
+
+	package = log_msg2_get_package(msg, &plen);
+	if (plen) {
+		(void)cbpprintf(text_out, &text, package);
+	}
+	*text.pos++ = '\0';
+
+	return rpmsg_service_send_nocopy(ep_id, buf, (uint8_t *)text.pos - buf);
+}
+
+static void process(const struct log_backend *const backend,
+		    union log_msg2_generic *msg)
+{
+	/* The other domain cannot be waited for after a panic. */
+	if (panic_mode) {
+		return;
+	}
+
+	/* Messages logged before the other domain bound the endpoint are
+	 * reported as dropped once it did.
+	 */
+	if (ep_id < 0 || !rpmsg_service_endpoint_is_bound(ep_id)) {
+		dropped_cnt++;
+		return;
+	}
+
+	if (!names_sent) {
+		names_sent = names_send();
+		if (!names_sent) {
+			dropped_cnt++;
+			return;
+		}
+	}
+
+	if (dropped_cnt) {
+		dropped_send();
+	}
+
+	if (msg_send(&msg->log) < 0) {
+		dropped_cnt++;
+	}
+}
+
+static void dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	ARG_UNUSED(backend);
+
+	dropped_cnt += cnt;
+}
+
+static void panic(struct log_backend const *const backend)
+{
+	ARG_UNUSED(backend);
+
+	panic_mode = true;
+}
+
+const struct log_backend_api log_backend_rpmsg_api = {
+	.process = process,
+	.dropped = dropped,
+	.panic = panic,
+};
+
+LOG_BACKEND_DEFINE(log_backend_rpmsg, log_backend_rpmsg_api, true);
+
+static int log_backend_rpmsg_register(const struct device *arg)
+{
+	ARG_UNUSED(arg);
+
+	ep_id = rpmsg_service_register_endpoint(LOG_LINK_RPMSG_EPT_NAME, ep_cb);
+
+	return ep_id < 0 ? ep_id : 0;
+}
+
+SYS_INIT(log_backend_rpmsg_register, POST_KERNEL,
+	 CONFIG_RPMSG_SERVICE_EP_REG_PRIORITY);
@@ -8,6 +8,7 @@
 #include <logging/log_core.h>
 #include <logging/log_msg.h>
 #include <logging/log_output.h>
+#include <logging/log_output_dict.h>
 #include <logging/log_backend_std.h>
 #include <SEGGER_RTT.h>
 
@@ -41,8 +42,11 @@
 
 #define MESSAGE_SIZE CONFIG_LOG_BACKEND_RTT_MESSAGE_SIZE
 
+/* In dictionary mode, a message is written to the up-buffer at once. */
 #define CHAR_BUF_SIZE \
-	((IS_ENABLED(CONFIG_LOG_BACKEND_RTT_MODE_BLOCK) && \
+	(IS_ENABLED(CONFIG_LOG_BACKEND_RTT_OUTPUT_DICTIONARY) ? \
+		MESSAGE_SIZE : \
+	 (IS_ENABLED(CONFIG_LOG_BACKEND_RTT_MODE_BLOCK) && \
 	 !IS_ENABLED(CONFIG_LOG_IMMEDIATE)) ? \
 		CONFIG_LOG_BACKEND_RTT_OUTPUT_BUFFER_SIZE : 1)
 
@@ -231,7 +235,33 @@ static int data_out_block_mode(uint8_t *data, size_t length, void *ctx)
 	return ((ret == 0) && host_present) ? 0 : length;
 }
 
+/* Binary data cannot be split in lines: in drop mode, the data of a
+ * message (or its part which did not fit the buffer) is written at once
+ * or dropped altogether.
+ */
+static int data_out_dict(uint8_t *data, size_t length, void *ctx)
+{
+	int ret;
+
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_RTT_MODE_BLOCK) || is_sync_mode()) {
+		return data_out_block_mode(data, length, ctx);
+	}
+
+	RTT_LOCK();
+	ret = SEGGER_RTT_WriteSkipNoLock(CONFIG_LOG_BACKEND_RTT_BUFFER,
+					 data, length);
+	RTT_UNLOCK();
+
+	if (ret == 0) {
+		drop_cnt++;
+	}
+
+	return length;
+}
+
 LOG_OUTPUT_DEFINE(log_output_rtt,
+		  IS_ENABLED(CONFIG_LOG_BACKEND_RTT_OUTPUT_DICTIONARY) ?
+			  data_out_dict :
 		  IS_ENABLED(CONFIG_LOG_BACKEND_RTT_MODE_BLOCK) ?
 			  data_out_block_mode : data_out_drop_mode,
 		  char_buf, sizeof(char_buf));
@@ -272,7 +302,11 @@ static void dropped(const struct log_backend *const backend, uint32_t cnt)
 {
 	ARG_UNUSED(backend);
 
-	log_backend_std_dropped(&log_output_rtt, cnt);
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_RTT_OUTPUT_DICTIONARY)) {
+		log_dict_output_dropped_process(&log_output_rtt, cnt);
+	} else {
+		log_backend_std_dropped(&log_output_rtt, cnt);
+	}
 }
 
 static void sync_string(const struct log_backend *const backend,
@@ -302,6 +336,20 @@ static void process(const struct log_backend *const backend,
 {
 	uint32_t flags = log_backend_std_get_flags();
 
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_RTT_OUTPUT_DICTIONARY)) {
+		/* Report the messages dropped by the up-buffer. */
+		if (drop_cnt > 0) {
+			int cnt = drop_cnt;
+
+			drop_cnt = 0;
+			log_dict_output_dropped_process(&log_output_rtt, cnt);
+		}
+
+		log_dict_output_msg2_process(&log_output_rtt, &msg->log,
+					     flags);
+		return;
+	}
+
 	log_output_msg2_process(&log_output_rtt, &msg->log, flags);
 }
 
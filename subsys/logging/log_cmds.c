@@ -8,6 +8,7 @@
 #include <logging/log_ctrl.h>
 #include <logging/log.h>
 #include <string.h>
+#include <stdlib.h>
 
 typedef int (*log_backend_cmd_t)(const struct shell *shell,
 				 const struct log_backend *backend,
@@ -399,6 +400,36 @@ static int cmd_log_strdup_utilization(const struct shell *shell,
 	return 0;
 }
 
+#ifdef CONFIG_LOG_RATELIMIT
+static int cmd_log_ratelimit(const struct shell *shell,
+			     size_t argc, char **argv)
+{
+	uint32_t rate, burst;
+
+	log_ratelimit_get(&rate, &burst);
+
+	if (argc > 1) {
+		rate = strtoul(argv[1], NULL, 10);
+		if (argc > 2) {
+			burst = strtoul(argv[2], NULL, 10);
+		}
+
+		if (log_ratelimit_set(rate, burst)) {
+			shell_error(shell, "Invalid rate or burst.");
+			return -EINVAL;
+		}
+	}
+
+	if (rate == 0U) {
+		shell_print(shell, "Rate limiting disabled.");
+	} else {
+		shell_print(shell, "Rate limit: %u messages/s, burst %u.",
+			    rate, burst);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_LOG_RATELIMIT */
 
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_log_backend,
 	SHELL_CMD_ARG(disable, &dsub_module_name,
@@ -452,6 +483,10 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_log_stat,
 	SHELL_COND_CMD_ARG(CONFIG_LOG_STRDUP_POOL_PROFILING, strdup_utilization,
 			NULL, "Get utilization of string duplicates pool",
 			cmd_log_strdup_utilization, 1, 0),
+	SHELL_COND_CMD_ARG(CONFIG_LOG_RATELIMIT, ratelimit, NULL,
+			"'log ratelimit [<rate> [<burst>]]' gets or sets the "
+			"rate limit of each call site, 0 disables it.",
+			cmd_log_ratelimit, 1, 2),
 	SHELL_SUBCMD_SET_END
 );
 
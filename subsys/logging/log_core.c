@@ -5,6 +5,7 @@
  */
 #include <logging/log_msg.h>
 #include "log_list.h"
+#include "log_link_rpmsg.h"
 #include <logging/log.h>
 #include <logging/log_backend.h>
 #include <logging/log_ctrl.h>
@@ -55,6 +56,10 @@ LOG_MODULE_REGISTER(log);
 #define CONFIG_LOG_BLOCK_IN_THREAD_TIMEOUT_MS 0
 #endif
 
+#ifndef CONFIG_LOG_RATELIMIT_REPORT_INTERVAL_MS
+#define CONFIG_LOG_RATELIMIT_REPORT_INTERVAL_MS 0
+#endif
+
 #ifndef CONFIG_LOG_BUFFER_SIZE
 #define CONFIG_LOG_BUFFER_SIZE 4
 #endif
@@ -729,30 +734,34 @@ static bool msg_filter_check(struct log_backend const *backend,
 	}
 }
 
-static void msg_process(union log_msgs msg, bool bypass)
+static void msg_backends_process(union log_msgs msg)
 {
 	struct log_backend const *backend;
 
-	if (!bypass) {
-		if (!IS_ENABLED(CONFIG_LOG2) &&
-		    IS_ENABLED(CONFIG_LOG_DETECT_MISSED_STRDUP) &&
-		    !panic_mode) {
-			detect_missed_strdup(msg.msg);
-		}
+	if (!IS_ENABLED(CONFIG_LOG2) &&
+	    IS_ENABLED(CONFIG_LOG_DETECT_MISSED_STRDUP) &&
+	    !panic_mode) {
+		detect_missed_strdup(msg.msg);
+	}
 
-		for (int i = 0; i < log_backend_count_get(); i++) {
-			backend = log_backend_get(i);
-			if (log_backend_is_active(backend) &&
-			    msg_filter_check(backend, msg)) {
-				if (IS_ENABLED(CONFIG_LOG2)) {
-					log_backend_msg2_process(backend,
-								 msg.msg2);
-				} else {
-					log_backend_put(backend, msg.msg);
-				}
+	for (int i = 0; i < log_backend_count_get(); i++) {
+		backend = log_backend_get(i);
+		if (log_backend_is_active(backend) &&
+		    msg_filter_check(backend, msg)) {
+			if (IS_ENABLED(CONFIG_LOG2)) {
+				log_backend_msg2_process(backend, msg.msg2);
+			} else {
+				log_backend_put(backend, msg.msg);
 			}
 		}
 	}
+}
+
+static void msg_process(union log_msgs msg, bool bypass)
+{
+	if (!bypass) {
+		msg_backends_process(msg);
+	}
 
 	if (!IS_ENABLED(CONFIG_LOG2_MODE_IMMEDIATE)) {
 		if (IS_ENABLED(CONFIG_LOG2)) {
@@ -803,24 +812,176 @@ static bool next_pending(void)
 	return (log_list_head_peek(&list) != NULL);
 }
 
-bool z_impl_log_process(bool bypass)
+#ifdef CONFIG_LOG_RATELIMIT
+static struct k_spinlock ratelimit_lock;
+static uint32_t ratelimit_rate = CONFIG_LOG_RATELIMIT_RATE;
+static uint32_t ratelimit_burst = CONFIG_LOG_RATELIMIT_BURST;
+static uint32_t ratelimit_report_stamp;
+
+static void ratelimit_report(uint32_t suppressed, const char *fmt)
 {
-	union log_msgs msg;
+	/* The format string can only be printed if it outlives the message. */
+	if (is_rodata(fmt)) {
+		LOG_WRN("%u messages suppressed: \"%s\"", suppressed, fmt);
+	} else {
+		LOG_WRN("%u messages suppressed", suppressed);
+	}
+}
+
+/* Virtual scheduling form of the leaky bucket: a call site keeps the time
+ * at which its next message is due. Each message pushes it one interval
+ * further, and messages are suppressed once it is more than the burst
+ * ahead of the current time.
+ */
+bool z_log_ratelimit_check(struct log_ratelimit *rl, const char *fmt)
+{
+	uint32_t interval, ahead, suppressed = 0U;
+	k_spinlock_key_t key;
+	uint32_t now;
+	bool pass;
+
+	if (ratelimit_rate == 0U) {
+		return true;
+	}
+
+	now = k_uptime_get_32();
+	key = k_spin_lock(&ratelimit_lock);
+
+	interval = MSEC_PER_SEC / ratelimit_rate;
+	ahead = rl->tat - now;
+	/* The due time is never more than the burst ahead, it is in the past
+	 * otherwise: the bucket is empty.
+	 */
+	if (ahead > ratelimit_burst * interval) {
+		rl->tat = now;
+		ahead = 0U;
+	}
+
+	pass = (ahead <= (ratelimit_burst - 1U) * interval);
+	if (pass) {
+		rl->tat += interval;
+		suppressed = rl->suppressed;
+		rl->suppressed = 0U;
+	} else {
+		rl->fmt = fmt;
+		rl->suppressed++;
+	}
+
+	k_spin_unlock(&ratelimit_lock, key);
+
+	if (suppressed) {
+		ratelimit_report(suppressed, fmt);
+	}
+
+	return pass;
+}
+
+/* Report the call sites which did not log since their messages were
+ * suppressed.
+ */
+static void ratelimit_report_all(void)
+{
+	uint32_t now = k_uptime_get_32();
+
+	if ((now - ratelimit_report_stamp) <
+	    CONFIG_LOG_RATELIMIT_REPORT_INTERVAL_MS) {
+		return;
+	}
+
+	ratelimit_report_stamp = now;
+
+	Z_STRUCT_SECTION_FOREACH(log_ratelimit, rl) {
+		k_spinlock_key_t key = k_spin_lock(&ratelimit_lock);
+		uint32_t suppressed = rl->suppressed;
+		const char *fmt = rl->fmt;
+
+		rl->suppressed = 0U;
+		k_spin_unlock(&ratelimit_lock, key);
 
+		if (suppressed) {
+			ratelimit_report(suppressed, fmt);
+		}
+	}
+}
+
+int log_ratelimit_set(uint32_t rate, uint32_t burst)
+{
+	k_spinlock_key_t key;
+
+	if (rate > MSEC_PER_SEC || burst == 0U || burst > UINT16_MAX) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&ratelimit_lock);
+	ratelimit_rate = rate;
+	ratelimit_burst = burst;
+	k_spin_unlock(&ratelimit_lock, key);
+
+	return 0;
+}
+
+void log_ratelimit_get(uint32_t *rate, uint32_t *burst)
+{
+	*rate = ratelimit_rate;
+	*burst = ratelimit_burst;
+}
+#endif /* CONFIG_LOG_RATELIMIT */
+
+#ifdef CONFIG_LOG2_MODE_DEFERRED
+/* Messages are claimed and freed in batches, the buffer lock is taken once
+ * per batch rather than twice per message.
+ */
+static void msg2_batch_process(bool bypass)
+{
+	union mpsc_pbuf_generic *batch[CONFIG_LOG_PROCESS_BATCH];
+	uint32_t n;
+
+	n = mpsc_pbuf_claim_batch(&log_buffer, batch, ARRAY_SIZE(batch));
+	if (n == 0) {
+		return;
+	}
+
+	atomic_sub(&buffered_cnt, n);
+
+	for (uint32_t i = 0; !bypass && i < n; i++) {
+		union log_msgs msg = {
+			.msg2 = (union log_msg2_generic *)batch[i]
+		};
+
+		msg_backends_process(msg);
+	}
+
+	mpsc_pbuf_free_batch(&log_buffer, batch, n);
+}
+#endif /* CONFIG_LOG2_MODE_DEFERRED */
+
+bool z_impl_log_process(bool bypass)
+{
 	if (!backend_attached && !bypass) {
 		return false;
 	}
 
-	msg = get_msg();
+#ifdef CONFIG_LOG2_MODE_DEFERRED
+	msg2_batch_process(bypass);
+#else
+	union log_msgs msg = get_msg();
+
 	if (msg.msg) {
 		atomic_dec(&buffered_cnt);
 		msg_process(msg, bypass);
 	}
+#endif
 
 	if (!bypass && z_log_dropped_pending()) {
 		dropped_notify();
 	}
 
+#ifdef CONFIG_LOG_RATELIMIT
+	if (!bypass) {
+		ratelimit_report_all();
+	}
+#endif /* CONFIG_LOG_RATELIMIT */
+
 	return next_pending();
 }
 
@@ -866,16 +1027,39 @@ static void notify_drop(struct mpsc_pbuf_buffer *buffer,
 	z_log_dropped();
 }
 
+static inline bool is_remote_domain(uint32_t domain_id)
+{
+	return IS_ENABLED(CONFIG_LOG_LINK_RPMSG) &&
+	       (domain_id != CONFIG_LOG_DOMAIN_ID);
+}
+
 uint32_t log_src_cnt_get(uint32_t domain_id)
 {
+	if (is_remote_domain(domain_id)) {
+		return z_log_link_rpmsg_src_cnt_get(domain_id);
+	}
+
 	return log_sources_count();
 }
 
 const char *log_source_name_get(uint32_t domain_id, uint32_t src_id)
 {
+	if (is_remote_domain(domain_id)) {
+		return z_log_link_rpmsg_source_name_get(domain_id, src_id);
+	}
+
 	return src_id < log_sources_count() ? log_name_get(src_id) : NULL;
 }
 
+const char *log_domain_name_get(uint32_t domain_id)
+{
+	if (is_remote_domain(domain_id)) {
+		return z_log_link_rpmsg_domain_name_get(domain_id);
+	}
+
+	return CONFIG_LOG_DOMAIN_NAME;
+}
+
 static uint32_t max_filter_get(uint32_t filters)
 {
 	uint32_t max_filter = LOG_LEVEL_NONE;
@@ -1005,6 +1189,11 @@ void log_backend_disable(struct log_backend const *const backend)
 uint32_t log_filter_get(struct log_backend const *const backend,
 			uint32_t domain_id, int16_t source_id, bool runtime)
 {
+	/* Messages of the remote domains were filtered there. */
+	if (is_remote_domain(domain_id)) {
+		return LOG_LEVEL_DBG;
+	}
+
 	__ASSERT_NO_MSG(source_id < log_sources_count());
 
 	if (IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) && runtime) {
@@ -1400,7 +1589,11 @@ static void log_process_thread_func(void *dummy1, void *dummy2, void *dummy3)
 
 	while (true) {
 		if (log_process(false) == false) {
-			k_sem_take(&log_process_thread_sem, K_FOREVER);
+			/* Wake up for the reports of suppressed messages. */
+			k_sem_take(&log_process_thread_sem,
+				   IS_ENABLED(CONFIG_LOG_RATELIMIT) ?
+				   K_MSEC(CONFIG_LOG_RATELIMIT_REPORT_INTERVAL_MS) :
+				   K_FOREVER);
 		}
 	}
 }
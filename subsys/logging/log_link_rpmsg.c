@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Link receiving the log messages of a remote domain over RPMsg, sent by its
+ * RPMsg backend (CONFIG_LOG_BACKEND_RPMSG). The messages are put into the
+ * local log with the ID of the remote domain, and output by the local
+ * backends, which get the names of the remote domain and sources from here.
+ */
+
+#include <logging/log_core.h>
+#include <logging/log_ctrl.h>
+#include <logging/log_msg2.h>
+#include <ipc/rpmsg_service.h>
+#include <init.h>
+#include <string.h>
+#include "log_link_rpmsg.h"
+
+#define NO_NAME UINT16_MAX
+
+struct link_names {
+	/* Offsets of the domain and source names in the pool. */
+	uint16_t domain;
+	uint16_t sources[CONFIG_LOG_LINK_RPMSG_MAX_SOURCES];
+	uint16_t src_cnt;
+	uint16_t used;
+	char pool[CONFIG_LOG_LINK_RPMSG_NAMES_SIZE];
+};
+
+BUILD_ASSERT(CONFIG_LOG_LINK_RPMSG_NAMES_SIZE < NO_NAME);
+
+static struct link_names names;
+static int domain_id = -1;
+
+static uint16_t name_add(const uint8_t *name, size_t len)
+{
+	uint16_t offset = names.used;
+
+	if (len + 1 > sizeof(names.pool) - names.used) {
+		return NO_NAME;
+	}
+
+	memcpy(&names.pool[offset], name, len);
+	names.pool[offset + len] = '\0';
+	names.used += len + 1;
+
+	return offset;
+}
+
+/* Messages carry a pointer to the data of their source, from which the
+ * backends compute the source ID. A remote source is given the address its
+ * data would have if it was a local source, it is never dereferenced.
+ */
+static const void *source_get(uint16_t source_id)
+{
+	if (source_id >= names.src_cnt) {
+		return NULL;
+	}
+
+	return IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ?
+		(const void *)&__log_dynamic_start[source_id] :
+		(const void *)&__log_const_start[source_id];
+}
+
+static void domain_set(const struct log_link_rpmsg_hdr *hdr,
+		       const uint8_t *payload, size_t len)
+{
+	if (hdr->domain == CONFIG_LOG_DOMAIN_ID) {
+		/* Messages would be mistaken for local ones. */
+		domain_id = -1;
+		return;
+	}
+
+	/* Remote domain (re)started. */
+	domain_id = hdr->domain;
+	names.used = 0;
+	names.src_cnt = 0;
+	names.domain = name_add(payload, len);
+}
+
+static void source_add(const struct log_link_rpmsg_hdr *hdr,
+		       const uint8_t *payload, size_t len)
+{
+	if (hdr->source != names.src_cnt ||
+	    hdr->source >= ARRAY_SIZE(names.sources)) {
+		return;
+	}
+
+	names.sources[names.src_cnt++] = name_add(payload, len);
+}
+
+static void msg_create(const struct log_link_rpmsg_hdr *hdr,
+		       const uint8_t *payload, size_t len)
+{
+	if (hdr->domain != domain_id || len <= hdr->dlen ||
+	    payload[len - 1] != '\0') {
+		z_log_dropped();
+		return;
+	}
+
+	z_log_msg2_runtime_create(hdr->domain, source_get(hdr->source),
+				  hdr->level, payload, hdr->dlen,
+				  "%s", (const char *)&payload[hdr->dlen]);
+}
+
+static int ep_cb(struct rpmsg_endpoint *ept, void *data, size_t len,
+		 uint32_t src, void *priv)
+{
+	const struct log_link_rpmsg_hdr *hdr = data;
+	const uint8_t *payload = (const uint8_t *)data + sizeof(*hdr);
+
+	if (len < sizeof(*hdr)) {
+		return RPMSG_SUCCESS;
+	}
+
+	len -= sizeof(*hdr);
+
+	switch (hdr->type) {
+	case LOG_LINK_RPMSG_DOMAIN:
+		domain_set(hdr, payload, len);
+		break;
+	case LOG_LINK_RPMSG_SOURCE:
+		source_add(hdr, payload, len);
+		break;
+	case LOG_LINK_RPMSG_LOG:
+		msg_create(hdr, payload, len);
+		break;
+	case LOG_LINK_RPMSG_DROPPED:
+		for (int i = 0; i < hdr->dlen; i++) {
+			z_log_dropped();
+		}
+		break;
+	default:
+		break;
+	}
+
+	return RPMSG_SUCCESS;
+}
+
+uint32_t z_log_link_rpmsg_src_cnt_get(uint32_t domain)
+{
+	return ((int)domain == domain_id) ? names.src_cnt : 0;
+}
+
+const char *z_log_link_rpmsg_source_name_get(uint32_t domain,
+					     uint32_t source_id)
+{
+	if ((int)domain != domain_id || source_id >= names.src_cnt ||
+	    names.sources[source_id] == NO_NAME) {
+		return NULL;
+	}
+
+	return &names.pool[names.sources[source_id]];
+}
+
+const char *z_log_link_rpmsg_domain_name_get(uint32_t domain)
+{
+	if ((int)domain != domain_id || names.domain == NO_NAME) {
+		return NULL;
+	}
+
+	return &names.pool[names.domain];
+}
+
+static int log_link_rpmsg_register(const struct device *arg)
+{
+	int ep_id;
+
+	ARG_UNUSED(arg);
+
+	ep_id = rpmsg_service_register_endpoint(LOG_LINK_RPMSG_EPT_NAME, ep_cb);
+
+	return ep_id < 0 ? ep_id : 0;
+}
+
+SYS_INIT(log_link_rpmsg_register, POST_KERNEL,
+	 CONFIG_RPMSG_SERVICE_EP_REG_PRIORITY);
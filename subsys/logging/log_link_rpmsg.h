@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_LOGGING_LOG_LINK_RPMSG_H_
+#define ZEPHYR_SUBSYS_LOGGING_LOG_LINK_RPMSG_H_
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Protocol between the RPMsg backend of a remote domain and the RPMsg link
+ * of the domain outputting its messages. Both domains run on the same SoC,
+ * the fields are in native byte order.
+ *
+ * A remote domain first sends its name, then the names of its sources,
+ * indexed by source ID. Log messages then only carry the source ID.
+ */
+
+#define LOG_LINK_RPMSG_EPT_NAME "log"
+
+/* Source ID of the messages without source. */
+#define LOG_LINK_RPMSG_NO_SOURCE 0xFFFF
+
+enum log_link_rpmsg_type {
+	/* Payload: domain name. Resets the names of the domain sources. */
+	LOG_LINK_RPMSG_DOMAIN,
+	/* Payload: name of the source. */
+	LOG_LINK_RPMSG_SOURCE,
+	/* Payload: dlen bytes of hexdump data, then the formatted string,
+	 * null terminated.
+	 */
+	LOG_LINK_RPMSG_LOG,
+	/* No payload, dlen holds the number of dropped messages. */
+	LOG_LINK_RPMSG_DROPPED,
+};
+
+struct log_link_rpmsg_hdr {
+	uint8_t type;
+	uint8_t domain;
+	uint8_t level;
+	uint8_t reserved;
+	uint16_t source;
+	uint16_t dlen;
+};
+
+/* Name lookups of the remote domains, used by the logging core. */
+uint32_t z_log_link_rpmsg_src_cnt_get(uint32_t domain_id);
+
+const char *z_log_link_rpmsg_source_name_get(uint32_t domain_id,
+					     uint32_t source_id);
+
+const char *z_log_link_rpmsg_domain_name_get(uint32_t domain_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_SUBSYS_LOGGING_LOG_LINK_RPMSG_H_ */
@@ -53,6 +53,45 @@ static inline void z_vrfy_z_log_msg2_static_create(const void *source,
 #include <syscalls/z_log_msg2_static_create_mrsh.c>
 #endif
 
+void z_impl_z_log_msg2_static_create_strs(const void *source,
+					  const struct log_msg2_desc desc,
+					  uint8_t *package,
+					  const uint8_t *str_pos,
+					  uint32_t str_cnt,
+					  const void *data)
+{
+	struct log_msg2_desc out_desc = desc;
+	struct log_msg2 *msg;
+	int plen;
+
+	plen = cbprintf_package_copy(NULL, 0, package, str_pos, str_cnt);
+	__ASSERT_NO_MSG(plen >= 0);
+	out_desc.package_len = plen;
+
+	msg = z_log_msg2_alloc(log_msg2_get_total_wlen(out_desc));
+	if (msg) {
+		plen = cbprintf_package_copy(msg->data, plen, package,
+					     str_pos, str_cnt);
+		__ASSERT_NO_MSG(plen >= 0);
+	}
+
+	z_log_msg2_finalize(msg, source, out_desc, data);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline void z_vrfy_z_log_msg2_static_create_strs(const void *source,
+					  const struct log_msg2_desc desc,
+					  uint8_t *package,
+					  const uint8_t *str_pos,
+					  uint32_t str_cnt,
+					  const void *data)
+{
+	return z_impl_z_log_msg2_static_create_strs(source, desc, package,
+						    str_pos, str_cnt, data);
+}
+#include <syscalls/z_log_msg2_static_create_strs_mrsh.c>
+#endif
+
 void z_impl_z_log_msg2_runtime_vcreate(uint8_t domain_id, const void *source,
 				uint8_t level, const void *data, size_t dlen,
 				const char *fmt, va_list ap)
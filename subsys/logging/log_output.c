@@ -258,6 +258,15 @@ static int ids_print(const struct log_output *output, bool level_on,
 		total += print_formatted(output, "<%s> ", severity[level]);
 	}
 
+	/* Messages of the other domains are prefixed with the domain. */
+	if (domain_id != CONFIG_LOG_DOMAIN_ID) {
+		const char *name = log_domain_name_get(domain_id);
+
+		total += (name != NULL && name[0] != '\0') ?
+			print_formatted(output, "%s/", name) :
+			print_formatted(output, "%u/", domain_id);
+	}
+
 	if (source_id >= 0) {
 		total += print_formatted(output,
 				(func_on &&
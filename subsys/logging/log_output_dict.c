@@ -11,17 +11,39 @@
 #include <logging/log_output_dict.h>
 #include <sys/__assert.h>
 #include <sys/util.h>
+#include <string.h>
 
-static void buffer_write(log_output_func_t outf, uint8_t *buf, size_t len,
-			 void *ctx)
+/* Data goes through the output buffer, so that the backends which send a
+ * packet per flush (e.g. network) get a message in one piece when it fits
+ * the buffer. As for the text output, the buffer is bypassed in immediate
+ * mode, where it could be used by several contexts at once.
+ */
+static void buffer_write(const struct log_output *output, uint8_t *buf,
+			 size_t len)
 {
-	int processed;
+	struct log_output_control_block *cb = output->control_block;
+
+	while (len != 0) {
+		size_t chunk;
+		int processed;
+
+		if (IS_ENABLED(CONFIG_LOG_IMMEDIATE)) {
+			processed = output->func(buf, len, cb->ctx);
+			len -= processed;
+			buf += processed;
+			continue;
+		}
+
+		if (cb->offset == output->size) {
+			log_output_flush(output);
+		}
 
-	do {
-		processed = outf(buf, len, ctx);
-		len -= processed;
-		buf += processed;
-	} while (len != 0);
+		chunk = MIN(len, output->size - cb->offset);
+		memcpy(&output->buf[cb->offset], buf, chunk);
+		cb->offset += chunk;
+		len -= chunk;
+		buf += chunk;
+	}
 }
 
 void log_dict_output_msg2_process(const struct log_output *output,
@@ -44,19 +66,18 @@ void log_dict_output_msg2_process(const struct log_output *output,
 					log_const_source_id(source)) :
 				0U;
 
-	buffer_write(output->func, (uint8_t *)&output_hdr, sizeof(output_hdr),
-		     (void *)output);
+	buffer_write(output, (uint8_t *)&output_hdr, sizeof(output_hdr));
 
 	size_t len;
 	uint8_t *data = log_msg2_get_package(msg, &len);
 
 	if (len > 0U) {
-		buffer_write(output->func, data, len, (void *)output);
+		buffer_write(output, data, len);
 	}
 
 	data = log_msg2_get_data(msg, &len);
 	if (len > 0U) {
-		buffer_write(output->func, data, len, (void *)output);
+		buffer_write(output, data, len);
 	}
 
 	log_output_flush(output);
@@ -69,6 +90,7 @@ void log_dict_output_dropped_process(const struct log_output *output, uint32_t c
 	msg.type = MSG_DROPPED_MSG;
 	msg.num_dropped_messages = MIN(cnt, 9999);
 
-	buffer_write(output->func, (uint8_t *)&msg, sizeof(msg),
-		     (void *)output);
+	buffer_write(output, (uint8_t *)&msg, sizeof(msg));
+
+	log_output_flush(output);
 }
@@ -26,6 +26,7 @@ LOG_MODULE_REGISTER(hawkbit);
 #include <net/dns_resolve.h>
 #include <logging/log_ctrl.h>
 #include <storage/flash_map.h>
+#include <dfu/flash_img_delta.h>
 
 #include "hawkbit_priv.h"
 #include "hawkbit_device.h"
@@ -66,6 +67,13 @@ struct hawkbit_download {
 	int download_progress;
 	size_t downloaded_size;
 	size_t http_content_size;
+	/* The response to the current request was checked. */
+	bool started;
+	bool complete;
+#ifdef CONFIG_HAWKBIT_DOWNLOAD_RESUME
+	/* Bytes written when the progress was last saved. */
+	size_t saved_size;
+#endif
 };
 
 static struct hawkbit_context {
@@ -79,6 +87,9 @@ static struct hawkbit_context {
 	struct hawkbit_download dl;
 	struct http_request http_req;
 	struct flash_img_context flash_ctx;
+#ifdef CONFIG_IMG_DELTA
+	struct flash_img_delta delta;
+#endif
 	uint8_t url_buffer[URL_BUFFER_SIZE];
 	uint8_t status_buffer[STATUS_BUFFER_SIZE];
 	uint8_t recv_buf_tcp[RECV_BUFFER_SIZE];
@@ -662,6 +673,121 @@ static int enum_for_http_req_string(char *userdata)
 	return 0;
 }
 
+static int download_init(void)
+{
+	int ret;
+
+	ret = flash_img_init(&hb_context.flash_ctx);
+#ifdef CONFIG_IMG_DELTA
+	if (ret == 0) {
+		ret = flash_img_delta_init(&hb_context.delta,
+					   &hb_context.flash_ctx);
+	}
+#endif
+
+	hb_context.dl.downloaded_size = 0;
+	hb_context.dl.download_progress = 0;
+
+	return ret;
+}
+
+static int download_write(const uint8_t *data, size_t len, bool flush)
+{
+#ifdef CONFIG_IMG_DELTA
+	return flash_img_delta_write(&hb_context.delta, data, len, flush);
+#else
+	return flash_img_buffered_write(&hb_context.flash_ctx, data, len,
+					flush);
+#endif
+}
+
+#ifdef CONFIG_HAWKBIT_DOWNLOAD_RESUME
+/* The progress is stored per action, so that another artifact is never
+ * resumed.
+ */
+static void download_progress_key(char *key, size_t size)
+{
+	snprintk(key, size, "hawkbit/dl/%d", hb_context.json_action_id);
+}
+
+static void download_progress_load(void)
+{
+	char key[24];
+
+	download_progress_key(key, sizeof(key));
+	if (stream_flash_progress_load(&hb_context.flash_ctx.stream, key)) {
+		return;
+	}
+
+	hb_context.dl.downloaded_size =
+		flash_img_bytes_written(&hb_context.flash_ctx);
+	hb_context.dl.saved_size = hb_context.dl.downloaded_size;
+
+	if (hb_context.dl.downloaded_size > 0) {
+		LOG_INF("Resuming download at %zu bytes",
+			hb_context.dl.downloaded_size);
+	}
+}
+
+/* Only the bytes written to flash are saved, not the buffered ones. */
+static void download_progress_save(bool force)
+{
+	size_t written = flash_img_bytes_written(&hb_context.flash_ctx);
+	char key[24];
+
+	if (!force && written - hb_context.dl.saved_size <
+	    CONFIG_HAWKBIT_DOWNLOAD_RESUME_INTERVAL) {
+		return;
+	}
+
+	download_progress_key(key, sizeof(key));
+	if (stream_flash_progress_save(&hb_context.flash_ctx.stream, key)) {
+		LOG_WRN("Unable to save the download progress");
+		return;
+	}
+
+	hb_context.dl.saved_size = written;
+}
+
+static void download_progress_clear(void)
+{
+	char key[24];
+
+	download_progress_key(key, sizeof(key));
+	(void)stream_flash_progress_clear(&hb_context.flash_ctx.stream, key);
+}
+#endif /* CONFIG_HAWKBIT_DOWNLOAD_RESUME */
+
+/* A request resuming the download must get the rest of the artifact. If the
+ * server ignored the range, the download starts over.
+ */
+static int download_response_check(struct http_response *rsp)
+{
+	size_t offset = hb_context.dl.downloaded_size;
+
+	if (rsp->http_status_code == 206 && offset > 0) {
+		hb_context.dl.http_content_size = offset + rsp->content_length;
+		return 0;
+	}
+
+	if (rsp->http_status_code != 200) {
+		LOG_ERR("Download failed, HTTP status %u",
+			rsp->http_status_code);
+		return -EIO;
+	}
+
+	if (offset > 0) {
+		LOG_WRN("Range not supported, restarting the download");
+		if (download_init() < 0) {
+			return -EIO;
+		}
+	}
+
+	hb_context.dl.http_content_size = rsp->content_length;
+
+	return 0;
+}
+
 static void response_cb(struct http_response *rsp,
 			enum http_final_call final_data,
 			void *userdata)
@@ -792,41 +918,59 @@ static void response_cb(struct http_response *rsp,
 		break;
 
 	case HAWKBIT_DOWNLOAD:
-		if (hb_context.dl.http_content_size == 0) {
-			body_data = rsp->body_start;
-			body_len = rsp->data_len;
-			body_len -= (rsp->body_start - rsp->recv_buf);
-			hb_context.dl.http_content_size = rsp->content_length;
+		if (!hb_context.dl.started) {
+			hb_context.dl.started = true;
+			if (download_response_check(rsp) < 0) {
+				hb_context.code_status = HAWKBIT_DOWNLOAD_ERROR;
+			}
 		}
 
-		if ((rsp->body_found == 1) && (body_data == NULL)) {
-			body_data = rsp->recv_buf;
-			body_len = rsp->data_len;
+		if (hb_context.code_status == HAWKBIT_DOWNLOAD_ERROR) {
+			break;
 		}
 
-		if (body_data != NULL) {
-			ret = flash_img_buffered_write(&hb_context.flash_ctx,
-				body_data, body_len,
-				final_data == HTTP_DATA_FINAL);
+		/* The body fragments are written from the receive buffer,
+		 * the chunk headers of a chunked response are not part of
+		 * them.
+		 */
+		if (rsp->body_frag_len > 0) {
+			ret = download_write(rsp->body_frag_start,
+					     rsp->body_frag_len, false);
 			if (ret < 0) {
 				LOG_ERR("flash write error");
 				hb_context.code_status = HAWKBIT_DOWNLOAD_ERROR;
+				break;
 			}
-		}
 
-		hb_context.dl.downloaded_size =
-			flash_img_bytes_written(&hb_context.flash_ctx);
+			hb_context.dl.downloaded_size += rsp->body_frag_len;
+#ifdef CONFIG_HAWKBIT_DOWNLOAD_RESUME
+			download_progress_save(false);
+#endif
+		}
 
-		downloaded = hb_context.dl.downloaded_size * 100 /
-			     hb_context.dl.http_content_size;
+		if (hb_context.dl.http_content_size > 0) {
+			downloaded = hb_context.dl.downloaded_size * 100 /
+				     hb_context.dl.http_content_size;
 
-		if (downloaded > hb_context.dl.download_progress) {
-			hb_context.dl.download_progress = downloaded;
-			LOG_DBG("Download percentage: %d%% ",
-				hb_context.dl.download_progress);
+			if (downloaded > hb_context.dl.download_progress) {
+				hb_context.dl.download_progress = downloaded;
+				LOG_DBG("Download percentage: %d%% ",
+					hb_context.dl.download_progress);
+			}
 		}
 
-		if (final_data == HTTP_DATA_FINAL) {
+		if (rsp->message_complete) {
+			if (rsp->cl_present &&
+			    hb_context.dl.downloaded_size !=
+			    hb_context.dl.http_content_size) {
+				LOG_ERR("HTTP response len mismatch");
+				hb_context.code_status = HAWKBIT_DOWNLOAD_ERROR;
+			} else if (download_write(NULL, 0, true) < 0) {
+				LOG_ERR("flash write error");
+				hb_context.code_status = HAWKBIT_DOWNLOAD_ERROR;
+			}
+
+			hb_context.dl.complete = true;
 			k_sem_give(&hb_context.semaphore);
 		}
 
@@ -845,6 +989,8 @@ static bool send_request(enum http_method method,
 	struct hawkbit_close close;
 	struct hawkbit_dep_fbk feedback;
 	char acid[11];
+	char range[32];
+	const char *range_headers[] = { range, NULL };
 	const char *fini = hawkbit_status_finished(finished);
 	const char *exec = hawkbit_status_execution(execution);
 	char device_id[DEVICE_ID_HEX_MAX_SIZE] = { 0 };
@@ -995,6 +1141,15 @@ static bool send_request(enum http_method method,
 		break;
 
 	case HAWKBIT_DOWNLOAD:
+		if (hb_context.dl.downloaded_size > 0) {
+			snprintk(range, sizeof(range), "Range: bytes=%zu-\r\n",
+				 hb_context.dl.downloaded_size);
+			hb_context.http_req.optional_headers = range_headers;
+		}
+
+		hb_context.dl.started = false;
+		hb_context.dl.complete = false;
+
 		ret = http_client_req(hb_context.sock, &hb_context.http_req,
 				      HAWKBIT_RECV_TIMEOUT, "HAWKBIT_DOWNLOAD");
 		if (ret < 0) {
@@ -1013,6 +1168,10 @@ enum hawkbit_response hawkbit_probe(void)
 	int ret;
 	int32_t action_id;
 	int32_t file_size = 0;
+	size_t start_size;
+	int64_t start_time;
+	int64_t elapsed;
+	int attempt;
 	char device_id[DEVICE_ID_HEX_MAX_SIZE] = { 0 },
 	     cancel_base[CANCEL_BASE_SIZE] = { 0 },
 	     download_http[DOWNLOAD_HTTP_SIZE] = { 0 },
@@ -1194,20 +1353,68 @@ enum hawkbit_response hawkbit_probe(void)
 	snprintk(hb_context.url_buffer, hb_context.url_buffer_size, "%s",
 		 download_http);
 
-	flash_img_init(&hb_context.flash_ctx);
-
-	if (!send_request(HTTP_GET, HAWKBIT_DOWNLOAD,
-			  HAWKBIT_STATUS_FINISHED_NONE,
-			  HAWKBIT_STATUS_EXEC_NONE)) {
-		LOG_ERR("Send request failed");
-		hb_context.code_status = HAWKBIT_NETWORKING_ERROR;
+	if (download_init() < 0) {
+		LOG_ERR("Unable to init flash");
+		hb_context.code_status = HAWKBIT_DOWNLOAD_ERROR;
 		goto cleanup;
 	}
 
+#ifdef CONFIG_HAWKBIT_DOWNLOAD_RESUME
+	download_progress_load();
+#endif
+
+	start_size = hb_context.dl.downloaded_size;
+	start_time = k_uptime_get();
+
+	/* An interrupted download resumes where it stopped. */
+	for (attempt = 0; ; attempt++) {
+		if (attempt > 0) {
+			LOG_WRN("Download interrupted at %zu bytes, resuming",
+				hb_context.dl.downloaded_size);
+			cleanup_connection();
+			if (!start_http_client()) {
+				hb_context.code_status =
+					HAWKBIT_NETWORKING_ERROR;
+#ifdef CONFIG_HAWKBIT_DOWNLOAD_RESUME
+				download_progress_save(true);
+#endif
+				goto error;
+			}
+		}
+
+		(void)send_request(HTTP_GET, HAWKBIT_DOWNLOAD,
+				   HAWKBIT_STATUS_FINISHED_NONE,
+				   HAWKBIT_STATUS_EXEC_NONE);
+
+		if (hb_context.dl.complete ||
+		    hb_context.code_status == HAWKBIT_DOWNLOAD_ERROR) {
+			break;
+		}
+
+		if (attempt == CONFIG_HAWKBIT_DOWNLOAD_RETRIES) {
+			LOG_ERR("Send request failed");
+			hb_context.code_status = HAWKBIT_NETWORKING_ERROR;
+#ifdef CONFIG_HAWKBIT_DOWNLOAD_RESUME
+			download_progress_save(true);
+#endif
+			goto cleanup;
+		}
+	}
+
+#ifdef CONFIG_HAWKBIT_DOWNLOAD_RESUME
+	download_progress_clear();
+#endif
+
 	if (hb_context.code_status == HAWKBIT_DOWNLOAD_ERROR) {
 		goto cleanup;
 	}
 
+	elapsed = MAX(k_uptime_get() - start_time, 1);
+	LOG_INF("Downloaded %zu bytes in %u ms (%u B/s), %d resumption(s)",
+		hb_context.dl.downloaded_size - start_size, (uint32_t)elapsed,
+		(uint32_t)((hb_context.dl.downloaded_size - start_size) *
+			   MSEC_PER_SEC / elapsed), attempt);
+
 	if (boot_request_upgrade(BOOT_UPGRADE_TEST)) {
 		LOG_ERR("Download failed");
 		hb_context.code_status = HAWKBIT_DOWNLOAD_ERROR;
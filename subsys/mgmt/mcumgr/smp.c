@@ -5,6 +5,7 @@
  */
 
 #include <zephyr.h>
+#include <init.h>
 #include "net/buf.h"
 #include "mgmt/mgmt.h"
 #include "mgmt/mcumgr/buf.h"
@@ -20,6 +21,13 @@ static mgmt_init_writer_fn zephyr_smp_init_writer;
 static mgmt_free_buf_fn zephyr_smp_free_buf;
 static smp_tx_rsp_fn zephyr_smp_tx_rsp;
 
+#ifdef CONFIG_MCUMGR_SMP_WORKQUEUE
+K_THREAD_STACK_DEFINE(smp_work_queue_stack,
+		      CONFIG_MCUMGR_SMP_WORKQUEUE_STACK_SIZE);
+
+static struct k_work_q smp_work_queue;
+#endif
+
 static const struct mgmt_streamer_cfg zephyr_smp_cbor_cfg = {
 	.alloc_rsp = zephyr_smp_alloc_rsp,
 	.trim_front = zephyr_smp_trim_front,
@@ -300,5 +308,29 @@ void
 zephyr_smp_rx_req(struct zephyr_smp_transport *zst, struct net_buf *nb)
 {
 	net_buf_put(&zst->zst_fifo, nb);
+#ifdef CONFIG_MCUMGR_SMP_WORKQUEUE
+	k_work_submit_to_queue(&smp_work_queue, &zst->zst_work);
+#else
 	k_work_submit(&zst->zst_work);
+#endif
+}
+
+#ifdef CONFIG_MCUMGR_SMP_WORKQUEUE
+static int
+zephyr_smp_init(const struct device *dev)
+{
+	static const struct k_work_queue_config cfg = {
+		.name = "mcumgr smp",
+	};
+
+	ARG_UNUSED(dev);
+
+	k_work_queue_start(&smp_work_queue, smp_work_queue_stack,
+			   K_THREAD_STACK_SIZEOF(smp_work_queue_stack),
+			   CONFIG_MCUMGR_SMP_WORKQUEUE_THREAD_PRIO, &cfg);
+
+	return 0;
 }
+
+SYS_INIT(zephyr_smp_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif
@@ -53,6 +53,11 @@ static ssize_t smp_bt_chr_write(struct bt_conn *conn,
 	struct net_buf *nb;
 
 	nb = mcumgr_buf_alloc();
+	if (nb == NULL) {
+		/* Too many requests in flight. */
+		return BT_GATT_ERR(BT_ATT_ERR_INSUFFICIENT_RESOURCES);
+	}
+
 	net_buf_add_mem(nb, buf, len);
 
 	ud = net_buf_user_data(nb);
@@ -178,6 +183,39 @@ static int smp_bt_tx_pkt(struct zephyr_smp_transport *zst, struct net_buf *nb)
 	return rc;
 }
 
+#ifdef CONFIG_MCUMGR_SMP_BT_LARGE_MTU
+static struct bt_gatt_exchange_params
+	smp_bt_exchange_params[CONFIG_BT_MAX_CONN];
+
+static void smp_bt_mtu_exchanged(struct bt_conn *conn, uint8_t err,
+				 struct bt_gatt_exchange_params *params)
+{
+}
+
+static void smp_bt_connected(struct bt_conn *conn, uint8_t err)
+{
+	struct bt_gatt_exchange_params *params;
+
+	if (err) {
+		return;
+	}
+
+	/* The peer may already have started the procedures, or it may not
+	 * support them: the failures are not relevant, the MTU and the data
+	 * length are only larger when they succeed.
+	 */
+	(void)bt_conn_le_data_len_update(conn, BT_LE_DATA_LEN_PARAM_MAX);
+
+	params = &smp_bt_exchange_params[bt_conn_index(conn)];
+	params->func = smp_bt_mtu_exchanged;
+	(void)bt_gatt_exchange_mtu(conn, params);
+}
+
+static struct bt_conn_cb smp_bt_conn_callbacks = {
+	.connected = smp_bt_connected,
+};
+#endif /* CONFIG_MCUMGR_SMP_BT_LARGE_MTU */
+
 int smp_bt_register(void)
 {
 	return bt_gatt_service_register(&smp_bt_svc);
@@ -195,6 +233,11 @@ static int smp_bt_init(const struct device *dev)
 	zephyr_smp_transport_init(&smp_bt_transport, smp_bt_tx_pkt,
 				  smp_bt_get_mtu, smp_bt_ud_copy,
 				  smp_bt_ud_free);
+
+#ifdef CONFIG_MCUMGR_SMP_BT_LARGE_MTU
+	bt_conn_cb_register(&smp_bt_conn_callbacks);
+#endif
+
 	return 0;
 }
 
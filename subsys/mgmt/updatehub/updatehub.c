@@ -21,6 +21,7 @@ LOG_MODULE_REGISTER(updatehub, CONFIG_UPDATEHUB_LOG_LEVEL);
 #include <tinycrypt/sha256.h>
 #include <data/json.h>
 #include <storage/flash_map.h>
+#include <dfu/flash_img_delta.h>
 
 #include "include/updatehub.h"
 #include "updatehub_priv.h"
@@ -66,6 +67,9 @@ static struct updatehub_context {
 	struct coap_block_context block;
 	struct k_sem semaphore;
 	struct flash_img_context flash_ctx;
+#ifdef CONFIG_IMG_DELTA
+	struct flash_img_delta delta;
+#endif
 	struct tc_sha256_state_struct sha256sum;
 	enum updatehub_response code_status;
 	uint8_t hash[TC_SHA256_DIGEST_SIZE];
@@ -471,10 +475,17 @@ static void install_update_cb(void)
 		(ctx.downloaded_size == ctx.block.total_size ?
 			"True" : "False"));
 
+#ifdef CONFIG_IMG_DELTA
+	if (flash_img_delta_write(&ctx.delta,
+				  response_packet.data + response_packet.offset,
+				  response_packet.max_len - response_packet.offset,
+				  ctx.downloaded_size == ctx.block.total_size) < 0) {
+#else
 	if (flash_img_buffered_write(&ctx.flash_ctx,
 				     response_packet.data + response_packet.offset,
 				     response_packet.max_len - response_packet.offset,
 				     ctx.downloaded_size == ctx.block.total_size) < 0) {
+#endif
 		LOG_ERR("Error to write on the flash");
 		ctx.code_status = UPDATEHUB_INSTALL_ERROR;
 		goto cleanup;
@@ -514,8 +525,17 @@ static void install_update_cb(void)
 		fic.match = ctx.hash;
 		fic.clen = ctx.downloaded_size;
 
+		/* The hash of the object is the one of the patch, the image
+		 * written from it was checked against the patch header.
+		 */
+#ifdef CONFIG_IMG_DELTA
+		if (!flash_img_delta_is_patch(&ctx.delta) &&
+		    flash_img_check(&ctx.flash_ctx, &fic,
+				    FLASH_AREA_ID(image_1))) {
+#else
 		if (flash_img_check(&ctx.flash_ctx, &fic,
 				    FLASH_AREA_ID(image_1))) {
+#endif
 			LOG_ERR("Firmware - flash validation has failed");
 			ctx.code_status = UPDATEHUB_INSTALL_ERROR;
 			goto cleanup;
@@ -564,6 +584,14 @@ static enum updatehub_response install_update(void)
 		goto cleanup;
 	}
 
+#ifdef CONFIG_IMG_DELTA
+	if (flash_img_delta_init(&ctx.delta, &ctx.flash_ctx)) {
+		LOG_ERR("Unable init delta update");
+		ctx.code_status = UPDATEHUB_FLASH_INIT_ERROR;
+		goto cleanup;
+	}
+#endif
+
 	ctx.downloaded_size = 0;
 	updatehub_blk_set(UPDATEHUB_BLK_ATTEMPT, 0);
 	updatehub_blk_set(UPDATEHUB_BLK_INDEX, 0);
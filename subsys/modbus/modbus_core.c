@@ -215,6 +215,34 @@ static struct modbus_context *modbus_init_iface(const uint8_t iface)
 	return ctx;
 }
 
+/* Blocks sorted by type and address, not overlapping */
+static bool reg_map_is_valid(const struct modbus_reg_block *map, size_t size)
+{
+	const struct modbus_reg_block *prev = NULL;
+
+	if (map == NULL) {
+		return size == 0;
+	}
+
+	for (const struct modbus_reg_block *block = map;
+	     block < &map[size]; prev = block++) {
+		if (block->count == 0 ||
+		    (uint32_t)block->addr + block->count > UINT16_MAX + 1U ||
+		    (block->regs == NULL && block->read == NULL)) {
+			return false;
+		}
+
+		if (prev != NULL &&
+		    (prev->type > block->type ||
+		     (prev->type == block->type &&
+		      prev->addr + prev->count > block->addr))) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 int modbus_init_server(const int iface, struct modbus_iface_param param)
 {
 	struct modbus_context *ctx = NULL;
@@ -232,6 +260,13 @@ int modbus_init_server(const int iface, struct modbus_iface_param param)
 		goto init_server_error;
 	}
 
+	if (!reg_map_is_valid(param.server.reg_map,
+			      param.server.reg_map_size)) {
+		LOG_ERR("Invalid register map");
+		rc = -EINVAL;
+		goto init_server_error;
+	}
+
 	ctx = modbus_init_iface(iface);
 	if (ctx == NULL) {
 		rc = -EINVAL;
@@ -265,6 +300,8 @@ int modbus_init_server(const int iface, struct modbus_iface_param param)
 	ctx->client = false;
 	ctx->unit_id = param.server.unit_id;
 	ctx->mbs_user_cb = param.server.user_cb;
+	ctx->mbs_reg_map = param.server.reg_map;
+	ctx->mbs_reg_map_size = param.server.reg_map_size;
 	if (IS_ENABLED(CONFIG_MODBUS_FC08_DIAGNOSTIC)) {
 		modbus_reset_stats(ctx);
 	}
@@ -325,6 +362,8 @@ int modbus_init_client(const int iface, struct modbus_iface_param param)
 	ctx->client = true;
 	ctx->unit_id = 0;
 	ctx->mbs_user_cb = NULL;
+	ctx->mbs_reg_map = NULL;
+	ctx->mbs_reg_map_size = 0;
 	ctx->rxwait_to = param.rx_timeout;
 
 	return 0;
@@ -364,6 +403,8 @@ int modbus_disable(const uint8_t iface)
 	ctx->unit_id = 0;
 	ctx->mode = MODBUS_MODE_RTU;
 	ctx->mbs_user_cb = NULL;
+	ctx->mbs_reg_map = NULL;
+	ctx->mbs_reg_map_size = 0;
 	atomic_clear_bit(&ctx->state, MODBUS_STATE_CONFIGURED);
 
 	LOG_INF("Modbus interface %u disabled", iface);
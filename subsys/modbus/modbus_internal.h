@@ -95,6 +95,14 @@ struct modbus_serial_config {
 	struct gpio_dt_spec *re;
 	/* RTU timer to detect frame end point */
 	struct k_timer rtu_timer;
+#ifdef CONFIG_MODBUS_SERIAL_ASYNC
+	/* Buffers of the asynchronous UART reception */
+	uint8_t async_buf[2][CONFIG_MODBUS_SERIAL_ASYNC_BUF_SIZE];
+	/* Index of the last buffer given to the UART */
+	uint8_t async_buf_idx;
+	/* Whether reception is to be enabled */
+	bool async_rx_on;
+#endif
 	/* Number of bytes received or to send */
 	uint16_t uart_buf_ctr;
 	/* Storage of received characters or characters to send */
@@ -120,6 +128,10 @@ struct modbus_context {
 	uint32_t rxwait_to;
 	/* Pointer to user server callbacks */
 	struct modbus_user_callbacks *mbs_user_cb;
+	/* Server register map, sorted by type and address */
+	const struct modbus_reg_block *mbs_reg_map;
+	/* Number of blocks of the server register map */
+	size_t mbs_reg_map_size;
 	/* Interface state */
 	atomic_t state;
 
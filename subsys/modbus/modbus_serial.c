@@ -28,6 +28,59 @@ LOG_MODULE_REGISTER(modbus_serial, CONFIG_MODBUS_LOG_LEVEL);
 #include <sys/byteorder.h>
 #include <modbus_internal.h>
 
+#ifdef CONFIG_MODBUS_SERIAL_ASYNC
+/* RTU frames go through the asynchronous UART API, ASCII ones do not. */
+static inline bool modbus_serial_async(struct modbus_context *ctx)
+{
+	return ctx->mode == MODBUS_MODE_RTU;
+}
+
+static void modbus_serial_async_rx_enable(struct modbus_context *ctx)
+{
+	struct modbus_serial_config *cfg = ctx->cfg;
+	/* Inactivity timeout of the UART, the end of a frame */
+	int32_t timeout = DIV_ROUND_UP(cfg->rtu_timeout, USEC_PER_MSEC);
+	int err;
+
+	cfg->async_rx_on = true;
+	cfg->async_buf_idx = 0;
+
+	err = uart_rx_enable(cfg->dev, cfg->async_buf[0],
+			     sizeof(cfg->async_buf[0]), timeout);
+	/*
+	 * The UART may still be disabling the reception, in which case it
+	 * is enabled again on UART_RX_DISABLED.
+	 */
+	if (err != 0 && err != -EBUSY) {
+		LOG_ERR("Failed to enable UART reception (%d)", err);
+	}
+}
+
+static void modbus_serial_async_rx_disable(struct modbus_context *ctx)
+{
+	struct modbus_serial_config *cfg = ctx->cfg;
+
+	cfg->async_rx_on = false;
+	(void)uart_rx_disable(cfg->dev);
+}
+#else
+static inline bool modbus_serial_async(struct modbus_context *ctx)
+{
+	return false;
+}
+
+static void modbus_serial_async_rx_enable(struct modbus_context *ctx)
+{
+}
+
+static void modbus_serial_async_rx_disable(struct modbus_context *ctx)
+{
+}
+#endif
+
+static void modbus_serial_tx_off(struct modbus_context *ctx);
+static void modbus_serial_rx_on(struct modbus_context *ctx);
+
 static void modbus_serial_tx_on(struct modbus_context *ctx)
 {
 	struct modbus_serial_config *cfg = ctx->cfg;
@@ -36,14 +89,28 @@ static void modbus_serial_tx_on(struct modbus_context *ctx)
 		gpio_pin_set(cfg->de->port, cfg->de->pin, 1);
 	}
 
-	uart_irq_tx_enable(cfg->dev);
+	if (modbus_serial_async(ctx)) {
+		int err = uart_tx(cfg->dev, cfg->uart_buf_ptr,
+				  cfg->uart_buf_ctr, SYS_FOREVER_MS);
+
+		if (err != 0) {
+			LOG_ERR("Failed to start UART transmission (%d)", err);
+			modbus_serial_tx_off(ctx);
+			modbus_serial_rx_on(ctx);
+		}
+	} else {
+		uart_irq_tx_enable(cfg->dev);
+	}
 }
 
 static void modbus_serial_tx_off(struct modbus_context *ctx)
 {
 	struct modbus_serial_config *cfg = ctx->cfg;
 
-	uart_irq_tx_disable(cfg->dev);
+	if (!modbus_serial_async(ctx)) {
+		uart_irq_tx_disable(cfg->dev);
+	}
+
 	if (cfg->de != NULL) {
 		gpio_pin_set(cfg->de->port, cfg->de->pin, 0);
 	}
@@ -57,14 +124,23 @@ static void modbus_serial_rx_on(struct modbus_context *ctx)
 		gpio_pin_set(cfg->re->port, cfg->re->pin, 1);
 	}
 
-	uart_irq_rx_enable(cfg->dev);
+	if (modbus_serial_async(ctx)) {
+		modbus_serial_async_rx_enable(ctx);
+	} else {
+		uart_irq_rx_enable(cfg->dev);
+	}
 }
 
 static void modbus_serial_rx_off(struct modbus_context *ctx)
 {
 	struct modbus_serial_config *cfg = ctx->cfg;
 
-	uart_irq_rx_disable(cfg->dev);
+	if (modbus_serial_async(ctx)) {
+		modbus_serial_async_rx_disable(ctx);
+	} else {
+		uart_irq_rx_disable(cfg->dev);
+	}
+
 	if (cfg->re != NULL) {
 		gpio_pin_set(cfg->re->port, cfg->re->pin, 0);
 	}
@@ -238,32 +314,50 @@ static void modbus_ascii_tx_adu(struct modbus_context *ctx)
 }
 #endif
 
+/* CRC of the bytes 0 to 255 (MODBUS_CRC16_POLY), to process a byte at once */
+static const uint16_t modbus_rtu_crc16_table[256] = {
+	0x0000, 0xC0C1, 0xC181, 0x0140, 0xC301, 0x03C0, 0x0280, 0xC241,
+	0xC601, 0x06C0, 0x0780, 0xC741, 0x0500, 0xC5C1, 0xC481, 0x0440,
+	0xCC01, 0x0CC0, 0x0D80, 0xCD41, 0x0F00, 0xCFC1, 0xCE81, 0x0E40,
+	0x0A00, 0xCAC1, 0xCB81, 0x0B40, 0xC901, 0x09C0, 0x0880, 0xC841,
+	0xD801, 0x18C0, 0x1980, 0xD941, 0x1B00, 0xDBC1, 0xDA81, 0x1A40,
+	0x1E00, 0xDEC1, 0xDF81, 0x1F40, 0xDD01, 0x1DC0, 0x1C80, 0xDC41,
+	0x1400, 0xD4C1, 0xD581, 0x1540, 0xD701, 0x17C0, 0x1680, 0xD641,
+	0xD201, 0x12C0, 0x1380, 0xD341, 0x1100, 0xD1C1, 0xD081, 0x1040,
+	0xF001, 0x30C0, 0x3180, 0xF141, 0x3300, 0xF3C1, 0xF281, 0x3240,
+	0x3600, 0xF6C1, 0xF781, 0x3740, 0xF501, 0x35C0, 0x3480, 0xF441,
+	0x3C00, 0xFCC1, 0xFD81, 0x3D40, 0xFF01, 0x3FC0, 0x3E80, 0xFE41,
+	0xFA01, 0x3AC0, 0x3B80, 0xFB41, 0x3900, 0xF9C1, 0xF881, 0x3840,
+	0x2800, 0xE8C1, 0xE981, 0x2940, 0xEB01, 0x2BC0, 0x2A80, 0xEA41,
+	0xEE01, 0x2EC0, 0x2F80, 0xEF41, 0x2D00, 0xEDC1, 0xEC81, 0x2C40,
+	0xE401, 0x24C0, 0x2580, 0xE541, 0x2700, 0xE7C1, 0xE681, 0x2640,
+	0x2200, 0xE2C1, 0xE381, 0x2340, 0xE101, 0x21C0, 0x2080, 0xE041,
+	0xA001, 0x60C0, 0x6180, 0xA141, 0x6300, 0xA3C1, 0xA281, 0x6240,
+	0x6600, 0xA6C1, 0xA781, 0x6740, 0xA501, 0x65C0, 0x6480, 0xA441,
+	0x6C00, 0xACC1, 0xAD81, 0x6D40, 0xAF01, 0x6FC0, 0x6E80, 0xAE41,
+	0xAA01, 0x6AC0, 0x6B80, 0xAB41, 0x6900, 0xA9C1, 0xA881, 0x6840,
+	0x7800, 0xB8C1, 0xB981, 0x7940, 0xBB01, 0x7BC0, 0x7A80, 0xBA41,
+	0xBE01, 0x7EC0, 0x7F80, 0xBF41, 0x7D00, 0xBDC1, 0xBC81, 0x7C40,
+	0xB401, 0x74C0, 0x7580, 0xB541, 0x7700, 0xB7C1, 0xB681, 0x7640,
+	0x7200, 0xB2C1, 0xB381, 0x7340, 0xB101, 0x71C0, 0x7080, 0xB041,
+	0x5000, 0x90C1, 0x9181, 0x5140, 0x9301, 0x53C0, 0x5280, 0x9241,
+	0x9601, 0x56C0, 0x5780, 0x9741, 0x5500, 0x95C1, 0x9481, 0x5440,
+	0x9C01, 0x5CC0, 0x5D80, 0x9D41, 0x5F00, 0x9FC1, 0x9E81, 0x5E40,
+	0x5A00, 0x9AC1, 0x9B81, 0x5B40, 0x9901, 0x59C0, 0x5880, 0x9841,
+	0x8801, 0x48C0, 0x4980, 0x8941, 0x4B00, 0x8BC1, 0x8A81, 0x4A40,
+	0x4E00, 0x8EC1, 0x8F81, 0x4F40, 0x8D01, 0x4DC0, 0x4C80, 0x8C41,
+	0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641,
+	0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040,
+};
+
 static uint16_t modbus_rtu_crc16(uint8_t *src, size_t length)
 {
 	uint16_t crc = 0xFFFF;
-	uint8_t shiftctr;
-	bool flag;
-	uint8_t *pblock = src;
 
 	while (length > 0) {
 		length--;
-		crc ^= (uint16_t)*pblock++;
-		shiftctr = 8;
-		do {
-			/* Determine if the shift out of rightmost bit is 1 */
-			flag = (crc & 0x0001) ? true : false;
-			/* Shift CRC to the right one bit. */
-			crc >>= 1;
-			/*
-			 * If bit shifted out of rightmost bit was a 1
-			 * exclusive OR the CRC with the generating polynomial.
-			 */
-			if (flag == true) {
-				crc ^= MODBUS_CRC16_POLY;
-			}
-
-			shiftctr--;
-		} while (shiftctr > 0);
+		crc = (crc >> 8) ^
+		      modbus_rtu_crc16_table[(crc ^ *src++) & 0xFF];
 	}
 
 	return crc;
@@ -440,6 +534,90 @@ static void rtu_tmr_handler(struct k_timer *t_id)
 	k_work_submit(&ctx->server_work);
 }
 
+#ifdef CONFIG_MODBUS_SERIAL_ASYNC
+/*
+ * Received data are reported on the inactivity timeout of the UART, which
+ * ends the frame, or as a reception buffer is full. In the latter case the
+ * frame may go on in the next buffer, or end with no more data to time out
+ * on, so that the RTU timer is started as a fallback.
+ */
+static void async_rx_rdy(struct modbus_context *ctx,
+			 struct uart_event_rx *rx)
+{
+	struct modbus_serial_config *cfg = ctx->cfg;
+	size_t len = MIN(rx->len, CONFIG_MODBUS_BUFFER_SIZE -
+			 cfg->uart_buf_ctr);
+
+	memcpy(cfg->uart_buf_ptr, &rx->buf[rx->offset], len);
+	cfg->uart_buf_ptr += len;
+	cfg->uart_buf_ctr += len;
+
+	if (rx->offset + rx->len < CONFIG_MODBUS_SERIAL_ASYNC_BUF_SIZE) {
+		k_timer_stop(&cfg->rtu_timer);
+		k_work_submit(&ctx->server_work);
+	} else {
+		k_timer_start(&cfg->rtu_timer,
+			      K_USEC(cfg->rtu_timeout), K_NO_WAIT);
+	}
+}
+
+static void uart_async_cb_handler(const struct device *dev,
+				  struct uart_event *evt, void *user_data)
+{
+	struct modbus_context *ctx = (struct modbus_context *)user_data;
+	struct modbus_serial_config *cfg = ctx->cfg;
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		cfg->uart_buf_ctr = 0;
+		cfg->uart_buf_ptr = &cfg->uart_buf[0];
+		modbus_serial_tx_off(ctx);
+		if (atomic_test_bit(&ctx->state, MODBUS_STATE_CONFIGURED)) {
+			modbus_serial_rx_on(ctx);
+		}
+		break;
+	case UART_RX_RDY:
+		async_rx_rdy(ctx, &evt->data.rx);
+		break;
+	case UART_RX_BUF_REQUEST:
+		cfg->async_buf_idx ^= 1;
+		(void)uart_rx_buf_rsp(dev, cfg->async_buf[cfg->async_buf_idx],
+				      sizeof(cfg->async_buf[0]));
+		break;
+	case UART_RX_STOPPED:
+		LOG_WRN("UART reception stopped (%d), frame dropped",
+			evt->data.rx_stop.reason);
+		k_timer_stop(&cfg->rtu_timer);
+		cfg->uart_buf_ctr = 0;
+		cfg->uart_buf_ptr = &cfg->uart_buf[0];
+		break;
+	case UART_RX_DISABLED:
+		/* Stopped on an error, or disabled before being enabled */
+		if (cfg->async_rx_on) {
+			modbus_serial_async_rx_enable(ctx);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+static int modbus_serial_async_init(struct modbus_context *ctx)
+{
+	struct modbus_serial_config *cfg = ctx->cfg;
+
+	cfg->async_rx_on = false;
+
+	return uart_callback_set(cfg->dev, uart_async_cb_handler, ctx);
+}
+#else
+static int modbus_serial_async_init(struct modbus_context *ctx)
+{
+	return -ENOTSUP;
+}
+#endif
+
 static int configure_gpio(struct modbus_context *ctx)
 {
 	struct modbus_serial_config *cfg = ctx->cfg;
@@ -590,7 +768,15 @@ int modbus_serial_init(struct modbus_context *ctx,
 	cfg->uart_buf_ctr = 0;
 	cfg->uart_buf_ptr = &cfg->uart_buf[0];
 
-	uart_irq_callback_user_data_set(cfg->dev, uart_cb_handler, ctx);
+	if (modbus_serial_async(ctx)) {
+		if (modbus_serial_async_init(ctx) != 0) {
+			LOG_ERR("UART has no asynchronous API support");
+			return -ENOTSUP;
+		}
+	} else {
+		uart_irq_callback_user_data_set(cfg->dev, uart_cb_handler, ctx);
+	}
+
 	k_timer_init(&cfg->rtu_timer, rtu_tmr_handler, NULL);
 	k_timer_user_data_set(&cfg->rtu_timer, ctx);
 
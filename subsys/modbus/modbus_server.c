@@ -91,6 +91,197 @@ static void mbs_exception_rsp(struct modbus_context *ctx, uint8_t excep_code)
 	ctx->tx_adu.length = 1;
 }
 
+/* Number of registers passed at once to the bulk handlers */
+#define REG_MAP_CHUNK_SIZE	16
+
+/* Block of the register map holding a register, or NULL */
+static const struct modbus_reg_block *reg_map_find(struct modbus_context *ctx,
+						   enum modbus_reg_type type,
+						   uint16_t addr)
+{
+	size_t lo = 0;
+	size_t hi = ctx->mbs_reg_map_size;
+
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		const struct modbus_reg_block *block = &ctx->mbs_reg_map[mid];
+
+		if (block->type < type ||
+		    (block->type == type &&
+		     block->addr + block->count <= addr)) {
+			lo = mid + 1;
+		} else if (block->type > type || block->addr > addr) {
+			hi = mid;
+		} else {
+			return block;
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Read registers of the register map into a response, block by block,
+ * with a call of the bulk handler per block or chunk of a block.
+ */
+static int reg_map_read(struct modbus_context *ctx, enum modbus_reg_type type,
+			uint16_t addr, uint16_t qty, uint8_t *presp)
+{
+	uint16_t buf[REG_MAP_CHUNK_SIZE];
+
+	if ((uint32_t)addr + qty > UINT16_MAX + 1U) {
+		return -EINVAL;
+	}
+
+	while (qty > 0) {
+		const struct modbus_reg_block *block;
+		const uint16_t *src;
+		uint16_t n;
+
+		block = reg_map_find(ctx, type, addr);
+		if (block == NULL) {
+			return -ENOENT;
+		}
+
+		n = MIN(qty, block->addr + block->count - addr);
+
+		if (block->read != NULL) {
+			int err;
+
+			n = MIN(n, ARRAY_SIZE(buf));
+			err = block->read(block, addr, buf, n);
+			if (err != 0) {
+				return err;
+			}
+
+			src = buf;
+		} else {
+			src = &block->regs[addr - block->addr];
+		}
+
+		for (uint16_t i = 0; i < n; i++) {
+			sys_put_be16(src[i], presp);
+			presp += sizeof(uint16_t);
+		}
+
+		addr += n;
+		qty -= n;
+	}
+
+	return 0;
+}
+
+/* Write holding registers of the register map from a request */
+static int reg_map_write(struct modbus_context *ctx, uint16_t addr,
+			 uint16_t qty, const uint8_t *preq)
+{
+	uint16_t buf[REG_MAP_CHUNK_SIZE];
+
+	if ((uint32_t)addr + qty > UINT16_MAX + 1U) {
+		return -EINVAL;
+	}
+
+	while (qty > 0) {
+		const struct modbus_reg_block *block;
+		uint16_t *dst;
+		uint16_t n;
+
+		block = reg_map_find(ctx, MODBUS_REG_HOLDING, addr);
+		if (block == NULL) {
+			return -ENOENT;
+		}
+
+		n = MIN(qty, block->addr + block->count - addr);
+
+		if (block->write != NULL) {
+			n = MIN(n, ARRAY_SIZE(buf));
+			dst = buf;
+		} else if (block->regs != NULL) {
+			dst = &block->regs[addr - block->addr];
+		} else {
+			return -EACCES;
+		}
+
+		for (uint16_t i = 0; i < n; i++) {
+			dst[i] = sys_get_be16(preq);
+			preq += sizeof(uint16_t);
+		}
+
+		if (block->write != NULL) {
+			int err = block->write(block, addr, buf, n);
+
+			if (err != 0) {
+				return err;
+			}
+		}
+
+		addr += n;
+		qty -= n;
+	}
+
+	return 0;
+}
+
+/* FC03 and FC04 requests starting in the register map */
+static bool mbs_reg_map_read(struct modbus_context *ctx,
+			     enum modbus_reg_type type,
+			     uint16_t reg_addr, uint16_t reg_qty)
+{
+	const uint16_t regs_limit = 125;
+	uint16_t num_bytes = reg_qty * sizeof(uint16_t);
+
+	if (reg_qty == 0 || reg_qty > regs_limit) {
+		LOG_ERR("Number of registers limit exceeded");
+		mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_DATA_VAL);
+		return true;
+	}
+
+	if (reg_map_read(ctx, type, reg_addr, reg_qty,
+			 &ctx->tx_adu.data[1]) != 0) {
+		LOG_INF("Register address not supported");
+		mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_DATA_ADDR);
+		return true;
+	}
+
+	ctx->tx_adu.length = num_bytes + 1;
+	ctx->tx_adu.data[0] = (uint8_t)num_bytes;
+
+	return true;
+}
+
+/* FC16 requests starting in the register map */
+static bool mbs_reg_map_write(struct modbus_context *ctx, uint16_t reg_addr,
+			      uint16_t reg_qty, uint16_t num_bytes)
+{
+	const uint16_t regs_limit = 125;
+	const uint8_t response_len = 4;
+
+	if (reg_qty == 0 || reg_qty > regs_limit) {
+		LOG_ERR("Number of registers limit exceeded");
+		mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_DATA_VAL);
+		return true;
+	}
+
+	if ((ctx->rx_adu.length - 5) != num_bytes ||
+	    num_bytes != reg_qty * sizeof(uint16_t)) {
+		LOG_ERR("Mismatch in the number of bytes");
+		mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_DATA_VAL);
+		return true;
+	}
+
+	if (reg_map_write(ctx, reg_addr, reg_qty, &ctx->rx_adu.data[5]) != 0) {
+		LOG_INF("Register address not supported");
+		mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_DATA_ADDR);
+		return true;
+	}
+
+	ctx->tx_adu.length = response_len;
+	sys_put_be16(reg_addr, &ctx->tx_adu.data[0]);
+	sys_put_be16(reg_qty, &ctx->tx_adu.data[2]);
+
+	return true;
+}
+
 /*
  * FC 01 (0x01) Read Coils
  *
@@ -325,6 +516,11 @@ static bool mbs_fc03_hreg_read(struct modbus_context *ctx)
 	if ((reg_addr < MODBUS_FP_EXTENSIONS_ADDR) ||
 	    !IS_ENABLED(CONFIG_MODBUS_FP_EXTENSIONS)) {
 		/* Read integer register */
+		if (reg_map_find(ctx, MODBUS_REG_HOLDING, reg_addr) != NULL) {
+			return mbs_reg_map_read(ctx, MODBUS_REG_HOLDING,
+						reg_addr, reg_qty);
+		}
+
 		if (ctx->mbs_user_cb->holding_reg_rd == NULL) {
 			mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_FC);
 			return true;
@@ -435,6 +631,11 @@ static bool mbs_fc04_inreg_read(struct modbus_context *ctx)
 	if ((reg_addr < MODBUS_FP_EXTENSIONS_ADDR) ||
 	    !IS_ENABLED(CONFIG_MODBUS_FP_EXTENSIONS)) {
 		/* Read integer register */
+		if (reg_map_find(ctx, MODBUS_REG_INPUT, reg_addr) != NULL) {
+			return mbs_reg_map_read(ctx, MODBUS_REG_INPUT,
+						reg_addr, reg_qty);
+		}
+
 		if (ctx->mbs_user_cb->input_reg_rd == NULL) {
 			mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_FC);
 			return true;
@@ -596,15 +797,17 @@ static bool mbs_fc06_hreg_write(struct modbus_context *ctx)
 		return false;
 	}
 
-	if (ctx->mbs_user_cb->holding_reg_wr == NULL) {
-		mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_FC);
-		return true;
-	}
-
 	reg_addr = sys_get_be16(&ctx->rx_adu.data[0]);
 	reg_val = sys_get_be16(&ctx->rx_adu.data[2]);
 
-	err = ctx->mbs_user_cb->holding_reg_wr(reg_addr, reg_val);
+	if (reg_map_find(ctx, MODBUS_REG_HOLDING, reg_addr) != NULL) {
+		err = reg_map_write(ctx, reg_addr, 1, &ctx->rx_adu.data[2]);
+	} else if (ctx->mbs_user_cb->holding_reg_wr == NULL) {
+		mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_FC);
+		return true;
+	} else {
+		err = ctx->mbs_user_cb->holding_reg_wr(reg_addr, reg_val);
+	}
 
 	if (err != 0) {
 		LOG_INF("Register address not supported");
@@ -848,6 +1051,11 @@ static bool mbs_fc16_hregs_write(struct modbus_context *ctx)
 	if ((reg_addr < MODBUS_FP_EXTENSIONS_ADDR) ||
 	    !IS_ENABLED(CONFIG_MODBUS_FP_EXTENSIONS)) {
 		/* Write integer register */
+		if (reg_map_find(ctx, MODBUS_REG_HOLDING, reg_addr) != NULL) {
+			return mbs_reg_map_write(ctx, reg_addr, reg_qty,
+						 num_bytes);
+		}
+
 		if (ctx->mbs_user_cb->holding_reg_wr == NULL) {
 			mbs_exception_rsp(ctx, MODBUS_EXC_ILLEGAL_FC);
 			return true;
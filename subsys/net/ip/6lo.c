@@ -46,6 +46,33 @@ static inline uint8_t get_6co_cid(struct net_icmpv6_nd_opt_6co *opt)
 static struct net_6lo_context ctx_6co[CONFIG_NET_MAX_6LO_CONTEXTS];
 #endif
 
+#if defined(CONFIG_NET_6LO_FLOW_CACHE)
+#define NET_6LO_FLOW_LLADDR_LEN 8
+
+/* Address compression chosen for a source and destination pair. The
+ * choice only depends on the addresses, the link layer addresses and the
+ * contexts, so it stays valid until the contexts change.
+ */
+struct net_6lo_flow {
+	struct net_if *iface;
+	struct in6_addr src;
+	struct in6_addr dst;
+	uint8_t ll_src[NET_6LO_FLOW_LLADDR_LEN];
+	uint8_t ll_dst[NET_6LO_FLOW_LLADDR_LEN];
+	uint8_t ll_src_len;
+	uint8_t ll_dst_len;
+	/* CID, SAC, SAM, M, DAC and DAM bits of the IPHC header */
+	uint16_t iphc;
+	/* Context identifier extension, if CID is set */
+	uint8_t cid;
+	bool is_used;
+};
+
+static struct net_6lo_flow flow_cache[CONFIG_NET_6LO_FLOW_CACHE_SIZE];
+static uint8_t flow_cache_next;
+static struct k_spinlock flow_cache_lock;
+#endif
+
 static const uint8_t udp_nhc_inline_size_table[] = {4, 3, 3, 1};
 
 static const uint8_t tf_inline_size_table[] = {4, 3, 1, 0};
@@ -155,6 +182,99 @@ static inline bool net_6lo_maddr_48_bit_compressible(struct in6_addr *addr)
 		 (addr->s6_addr[10] == 0x00));
 }
 
+#if defined(CONFIG_NET_6LO_FLOW_CACHE)
+static void flow_cache_flush(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&flow_cache_lock);
+	uint8_t i;
+
+	for (i = 0U; i < ARRAY_SIZE(flow_cache); i++) {
+		flow_cache[i].is_used = false;
+	}
+
+	k_spin_unlock(&flow_cache_lock, key);
+}
+
+static void flow_set_key(struct net_6lo_flow *flow, struct net_pkt *pkt,
+			 struct net_ipv6_hdr *ipv6)
+{
+	struct net_linkaddr *ll_src = net_pkt_lladdr_src(pkt);
+	struct net_linkaddr *ll_dst = net_pkt_lladdr_dst(pkt);
+
+	flow->iface = net_pkt_iface(pkt);
+	net_ipaddr_copy(&flow->src, &ipv6->src);
+	net_ipaddr_copy(&flow->dst, &ipv6->dst);
+
+	flow->ll_src_len = ll_src->addr ? ll_src->len : 0U;
+	flow->ll_dst_len = ll_dst->addr ? ll_dst->len : 0U;
+	memcpy(flow->ll_src, ll_src->addr, flow->ll_src_len);
+	memcpy(flow->ll_dst, ll_dst->addr, flow->ll_dst_len);
+}
+
+static bool flow_can_cache(struct net_pkt *pkt)
+{
+	return net_pkt_lladdr_src(pkt)->len <= NET_6LO_FLOW_LLADDR_LEN &&
+	       net_pkt_lladdr_dst(pkt)->len <= NET_6LO_FLOW_LLADDR_LEN;
+}
+
+static bool flow_matches(struct net_6lo_flow *flow, struct net_pkt *pkt,
+			 struct net_ipv6_hdr *ipv6)
+{
+	struct net_linkaddr *ll_src = net_pkt_lladdr_src(pkt);
+	struct net_linkaddr *ll_dst = net_pkt_lladdr_dst(pkt);
+	uint8_t ll_src_len = ll_src->addr ? ll_src->len : 0U;
+	uint8_t ll_dst_len = ll_dst->addr ? ll_dst->len : 0U;
+
+	return flow->is_used && flow->iface == net_pkt_iface(pkt) &&
+	       net_ipv6_addr_cmp(&flow->dst, &ipv6->dst) &&
+	       net_ipv6_addr_cmp(&flow->src, &ipv6->src) &&
+	       flow->ll_src_len == ll_src_len &&
+	       flow->ll_dst_len == ll_dst_len &&
+	       !memcmp(flow->ll_src, ll_src->addr, ll_src_len) &&
+	       !memcmp(flow->ll_dst, ll_dst->addr, ll_dst_len);
+}
+
+static bool flow_cache_lookup(struct net_pkt *pkt, struct net_ipv6_hdr *ipv6,
+			      uint16_t *iphc, uint8_t *cid)
+{
+	k_spinlock_key_t key;
+	bool found = false;
+	uint8_t i;
+
+	if (!flow_can_cache(pkt)) {
+		return false;
+	}
+
+	key = k_spin_lock(&flow_cache_lock);
+
+	for (i = 0U; i < ARRAY_SIZE(flow_cache); i++) {
+		if (flow_matches(&flow_cache[i], pkt, ipv6)) {
+			*iphc |= flow_cache[i].iphc;
+			*cid = flow_cache[i].cid;
+			found = true;
+			break;
+		}
+	}
+
+	k_spin_unlock(&flow_cache_lock, key);
+
+	return found;
+}
+
+static void flow_cache_add(struct net_6lo_flow *flow)
+{
+	k_spinlock_key_t key = k_spin_lock(&flow_cache_lock);
+
+	flow->is_used = true;
+	flow_cache[flow_cache_next] = *flow;
+	flow_cache_next = (flow_cache_next + 1U) % ARRAY_SIZE(flow_cache);
+
+	k_spin_unlock(&flow_cache_lock, key);
+}
+#else
+#define flow_cache_flush(...)
+#endif /* CONFIG_NET_6LO_FLOW_CACHE */
+
 #if defined(CONFIG_NET_6LO_CONTEXT)
 /* RFC 6775, 4.2, 5.4.2, 5.4.3 and 7.2*/
 static inline void set_6lo_context(struct net_if *iface, uint8_t index,
@@ -189,6 +309,8 @@ void net_6lo_set_context(struct net_if *iface,
 
 		if (ctx_6co[i].iface == iface &&
 		    ctx_6co[i].cid == get_6co_cid(context)) {
+			flow_cache_flush();
+
 			/* Remove if lifetime is zero */
 			if (!context->lifetime) {
 				ctx_6co[i].is_used = false;
@@ -203,6 +325,7 @@ void net_6lo_set_context(struct net_if *iface,
 
 	/* Cache the context information. */
 	if (unused != -1) {
+		flow_cache_flush();
 		set_6lo_context(iface, unused, context);
 		return;
 	}
@@ -584,6 +707,70 @@ static uint8_t *compress_da_ctx(struct net_ipv6_hdr *ipv6, uint8_t *inline_ptr,
 }
 #endif
 
+#if defined(CONFIG_NET_6LO_FLOW_CACHE)
+static uint8_t *inline_addr_part(struct in6_addr *addr, uint8_t *inline_ptr,
+				 uint8_t offset, uint8_t len)
+{
+	inline_ptr -= len;
+	memmove(inline_ptr, &addr->s6_addr[offset], len);
+
+	return inline_ptr;
+}
+
+/* Inline the addresses as given by the SAC, SAM, M, DAC and DAM bits of
+ * the IPHC header, in the same order as the compress_da*() and
+ * compress_sa*() helpers do.
+ */
+static uint8_t *inline_addrs(struct net_ipv6_hdr *ipv6, uint8_t *inline_ptr,
+			     uint16_t iphc)
+{
+	switch (iphc & (NET_6LO_IPHC_M_MASK | NET_6LO_IPHC_DAM_MASK)) {
+	case NET_6LO_IPHC_M_1 | NET_6LO_IPHC_DAM_11:
+		inline_ptr = inline_addr_part(&ipv6->dst, inline_ptr, 15U, 1U);
+		break;
+	case NET_6LO_IPHC_M_1 | NET_6LO_IPHC_DAM_10:
+		inline_ptr = inline_addr_part(&ipv6->dst, inline_ptr, 13U, 3U);
+		inline_ptr = inline_addr_part(&ipv6->dst, inline_ptr, 1U, 1U);
+		break;
+	case NET_6LO_IPHC_M_1 | NET_6LO_IPHC_DAM_01:
+		inline_ptr = inline_addr_part(&ipv6->dst, inline_ptr, 11U, 5U);
+		inline_ptr = inline_addr_part(&ipv6->dst, inline_ptr, 1U, 1U);
+		break;
+	case NET_6LO_IPHC_M_1 | NET_6LO_IPHC_DAM_00:
+	case NET_6LO_IPHC_M_0 | NET_6LO_IPHC_DAM_00:
+		inline_ptr = inline_addr_part(&ipv6->dst, inline_ptr, 0U, 16U);
+		break;
+	case NET_6LO_IPHC_M_0 | NET_6LO_IPHC_DAM_01:
+		inline_ptr = inline_addr_part(&ipv6->dst, inline_ptr, 8U, 8U);
+		break;
+	case NET_6LO_IPHC_M_0 | NET_6LO_IPHC_DAM_10:
+		inline_ptr = inline_addr_part(&ipv6->dst, inline_ptr, 14U, 2U);
+		break;
+	default:
+		break;
+	}
+
+	switch (iphc & NET_6LO_IPHC_SA_MASK) {
+	case NET_6LO_IPHC_SAC_0 | NET_6LO_IPHC_SAM_00:
+		inline_ptr = inline_addr_part(&ipv6->src, inline_ptr, 0U, 16U);
+		break;
+	case NET_6LO_IPHC_SAC_0 | NET_6LO_IPHC_SAM_01:
+	case NET_6LO_IPHC_SAC_1 | NET_6LO_IPHC_SAM_01:
+		inline_ptr = inline_addr_part(&ipv6->src, inline_ptr, 8U, 8U);
+		break;
+	case NET_6LO_IPHC_SAC_0 | NET_6LO_IPHC_SAM_10:
+	case NET_6LO_IPHC_SAC_1 | NET_6LO_IPHC_SAM_10:
+		inline_ptr = inline_addr_part(&ipv6->src, inline_ptr, 14U, 2U);
+		break;
+	default:
+		/* Elided, or unspecified address */
+		break;
+	}
+
+	return inline_ptr;
+}
+#endif /* CONFIG_NET_6LO_FLOW_CACHE */
+
 /* Helper to compress Next header UDP */
 static inline uint8_t *compress_nh_udp(struct net_udp_hdr *udp, uint8_t *inline_ptr,
 				    bool compress_checksum)
@@ -723,9 +910,14 @@ static inline int compress_IPHC_header(struct net_pkt *pkt)
 #if defined(CONFIG_NET_6LO_CONTEXT)
 	struct net_6lo_context *src_ctx = NULL;
 	struct net_6lo_context *dst_ctx = NULL;
+#endif
+#if defined(CONFIG_NET_6LO_FLOW_CACHE)
+	struct net_6lo_flow flow;
+	bool cache_miss;
 #endif
 	uint8_t compressed = 0;
 	uint16_t iphc = (NET_6LO_DISPATCH_IPHC << 8);
+	uint8_t cid = 0U;
 	struct net_ipv6_hdr *ipv6 = NET_IPV6_HDR(pkt);
 	struct net_udp_hdr *udp;
 	uint8_t *inline_pos;
@@ -752,6 +944,20 @@ static inline int compress_IPHC_header(struct net_pkt *pkt)
 		inline_pos = compress_nh_udp(udp, inline_pos, false);
 	}
 
+#if defined(CONFIG_NET_6LO_FLOW_CACHE)
+	if (flow_cache_lookup(pkt, ipv6, &iphc, &cid)) {
+		cache_miss = false;
+		inline_pos = inline_addrs(ipv6, inline_pos, iphc);
+		goto sa_end;
+	}
+
+	/* The addresses are overwritten by the compressed header */
+	cache_miss = flow_can_cache(pkt);
+	if (cache_miss) {
+		flow_set_key(&flow, pkt, ipv6);
+	}
+#endif
+
 	if (net_6lo_ll_prefix_padded_with_zeros(&ipv6->dst)) {
 		inline_pos = compress_da(ipv6, pkt, inline_pos, &iphc);
 		goto da_end;
@@ -800,24 +1006,33 @@ da_end:
 	inline_pos = set_sa_inline(ipv6, inline_pos, &iphc);
 sa_end:
 
+#if defined(CONFIG_NET_6LO_CONTEXT)
+	if (src_ctx) {
+		cid = src_ctx->cid << 4;
+	}
+
+	if (dst_ctx) {
+		cid |= dst_ctx->cid & 0x0F;
+	}
+#endif
+
+#if defined(CONFIG_NET_6LO_FLOW_CACHE)
+	if (cache_miss) {
+		flow.iphc = iphc & (NET_6LO_IPHC_CID_MASK | NET_6LO_IPHC_SA_MASK |
+				    NET_6LO_IPHC_DA_MASK);
+		flow.cid = cid;
+		flow_cache_add(&flow);
+	}
+#endif
+
 	inline_pos = compress_hoplimit(ipv6, inline_pos, &iphc);
 	inline_pos = compress_nh(ipv6, inline_pos, &iphc);
 	inline_pos = compress_tfl(ipv6, inline_pos, &iphc);
 
-#if defined(CONFIG_NET_6LO_CONTEXT)
 	if (iphc & NET_6LO_IPHC_CID_1) {
 		inline_pos -= sizeof(uint8_t);
-		*inline_pos = 0;
-
-		if (src_ctx) {
-			*inline_pos = src_ctx->cid << 4;
-		}
-
-		if (dst_ctx) {
-			*inline_pos |= dst_ctx->cid & 0x0F;
-		}
+		*inline_pos = cid;
 	}
-#endif
 
 	inline_pos -= sizeof(iphc);
 	iphc = htons(iphc);
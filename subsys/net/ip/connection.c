@@ -59,6 +59,26 @@ static struct net_conn conns[CONFIG_NET_MAX_CONN];
 static sys_slist_t conn_unused;
 static sys_slist_t conn_used;
 
+/* Used connections are also indexed by protocol and local port, as a
+ * UDP or TCP handler with a local port only matches packets sent to
+ * that port. Handlers without a local port are in conn_wildcard. Each
+ * list has the newest handler first, like conn_used, so that walking a
+ * bucket and conn_wildcard together visits handlers in the same order.
+ */
+static sys_slist_t conn_hash[CONFIG_NET_CONN_HASH_BUCKETS];
+static sys_slist_t conn_wildcard;
+static uint32_t conn_seq;
+
+/* Walks either all the used connections, or a bucket merged with the
+ * wildcard handlers
+ */
+struct conn_iter {
+	sys_snode_t *all;
+	sys_snode_t *bucket;
+	sys_snode_t *wildcard;
+	bool hashed;
+};
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -127,11 +147,84 @@ static struct net_conn *conn_get_unused(void)
 	return CONTAINER_OF(node, struct net_conn, node);
 }
 
+/* The port is in network byte order */
+static sys_slist_t *conn_hash_list(uint16_t proto, uint16_t port)
+{
+	if (port == 0U) {
+		return &conn_wildcard;
+	}
+
+	return &conn_hash[(proto * 31U + ntohs(port)) %
+			  CONFIG_NET_CONN_HASH_BUCKETS];
+}
+
+static sys_slist_t *conn_get_hash_list(struct net_conn *conn)
+{
+	return conn_hash_list(conn->proto,
+			      net_sin(&conn->local_addr)->sin_port);
+}
+
+static void conn_iter_init(struct conn_iter *iter, struct net_pkt *pkt,
+			   uint16_t proto, uint16_t dst_port)
+{
+	/* Only an IP packet is known to skip handlers bound to other
+	 * ports, everything else takes the slow path
+	 */
+	iter->hashed = (IS_ENABLED(CONFIG_NET_IPV4) &&
+			net_pkt_family(pkt) == AF_INET) ||
+		       (IS_ENABLED(CONFIG_NET_IPV6) &&
+			net_pkt_family(pkt) == AF_INET6);
+
+	if (iter->hashed) {
+		iter->all = NULL;
+		iter->bucket = sys_slist_peek_head(conn_hash_list(proto,
+								  dst_port));
+		iter->wildcard = sys_slist_peek_head(&conn_wildcard);
+	} else {
+		iter->all = sys_slist_peek_head(&conn_used);
+		iter->bucket = NULL;
+		iter->wildcard = NULL;
+	}
+}
+
+static struct net_conn *conn_iter_next(struct conn_iter *iter)
+{
+	struct net_conn *bucket, *wildcard;
+
+	if (!iter->hashed) {
+		struct net_conn *conn = SYS_SLIST_CONTAINER(iter->all, conn,
+							    node);
+
+		if (conn) {
+			iter->all = sys_slist_peek_next(iter->all);
+		}
+
+		return conn;
+	}
+
+	bucket = SYS_SLIST_CONTAINER(iter->bucket, bucket, hash_node);
+	wildcard = SYS_SLIST_CONTAINER(iter->wildcard, wildcard, hash_node);
+
+	if (bucket &&
+	    (!wildcard || (int32_t)(bucket->seq - wildcard->seq) > 0)) {
+		iter->bucket = sys_slist_peek_next(iter->bucket);
+		return bucket;
+	}
+
+	if (wildcard) {
+		iter->wildcard = sys_slist_peek_next(iter->wildcard);
+	}
+
+	return wildcard;
+}
+
 static void conn_set_used(struct net_conn *conn)
 {
 	conn->flags |= NET_CONN_IN_USE;
+	conn->seq = conn_seq++;
 
 	sys_slist_prepend(&conn_used, &conn->node);
+	sys_slist_prepend(conn_get_hash_list(conn), &conn->hash_node);
 }
 
 static void conn_set_unused(struct net_conn *conn)
@@ -151,7 +244,10 @@ static struct net_conn *conn_find_handler(uint16_t proto, uint8_t family,
 	struct net_conn *conn;
 	struct net_conn *tmp;
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&conn_used, conn, tmp, node) {
+	/* Handlers in other lists have another protocol or local port */
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(conn_hash_list(proto,
+							 htons(local_port)),
+					  conn, tmp, hash_node) {
 		if (conn->proto != proto) {
 			continue;
 		}
@@ -380,6 +476,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 	NET_DBG("Connection handler %p removed", conn);
 
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	sys_slist_find_and_remove(conn_get_hash_list(conn), &conn->hash_node);
 
 	conn_set_unused(conn);
 
@@ -558,6 +655,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	bool raw_pkt_delivered = false;
 	bool raw_pkt_continue = false;
 	int16_t best_rank = -1;
+	struct conn_iter iter;
 	struct net_conn *conn;
 	enum net_verdict ret;
 	uint16_t src_port;
@@ -566,6 +664,8 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	if (IS_ENABLED(CONFIG_NET_UDP) && proto == IPPROTO_UDP) {
 		src_port = proto_hdr->udp->src_port;
 		dst_port = proto_hdr->udp->dst_port;
+
+		net_pkt_rx_stage_mark(pkt, NET_STATS_RX_STAGE_IP);
 	} else if (IS_ENABLED(CONFIG_NET_TCP) && proto == IPPROTO_TCP) {
 		if (proto_hdr->tcp == NULL) {
 			return NET_DROP;
@@ -573,6 +673,8 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 
 		src_port = proto_hdr->tcp->src_port;
 		dst_port = proto_hdr->tcp->dst_port;
+
+		net_pkt_rx_stage_mark(pkt, NET_STATS_RX_STAGE_IP);
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET)) {
 		if (net_pkt_family(pkt) != AF_PACKET ||
 		    (!IS_ENABLED(CONFIG_NET_SOCKETS_PACKET_DGRAM) &&
@@ -623,7 +725,9 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+	conn_iter_init(&iter, pkt, proto, dst_port);
+
+	while ((conn = conn_iter_next(&iter)) != NULL) {
 		if (conn->context != NULL &&
 		    net_context_is_bound_to_iface(conn->context) &&
 		    net_pkt_iface(pkt) != net_context_get_iface(conn->context)) {
@@ -855,6 +959,11 @@ void net_conn_init(void)
 
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
+	sys_slist_init(&conn_wildcard);
+
+	for (i = 0; i < ARRAY_SIZE(conn_hash); i++) {
+		sys_slist_init(&conn_hash[i]);
+	}
 
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
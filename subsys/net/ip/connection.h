@@ -51,6 +51,9 @@ struct net_conn {
 	/** Internal slist node */
 	sys_snode_t node;
 
+	/** Internal slist node of the lookup table */
+	sys_snode_t hash_node;
+
 	/** Remote IP address */
 	struct sockaddr remote_addr;
 
@@ -76,6 +79,11 @@ struct net_conn {
 
 	/** Flags for the connection */
 	uint8_t flags;
+
+	/** Registration order, to walk the lookup table like the list of
+	 *  used connections
+	 */
+	uint32_t seq;
 };
 
 /**
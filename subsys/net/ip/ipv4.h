@@ -19,6 +19,7 @@
 #include <net/net_pkt.h>
 #include <net/net_if.h>
 #include <net/net_context.h>
+#include <net/net_timeout.h>
 
 #define NET_IPV4_IHL_MASK 0x0F
 
@@ -204,4 +205,108 @@ static inline int net_ipv4_parse_hdr_options(struct net_pkt *pkt,
 }
 #endif
 
+#if defined(CONFIG_NET_IPV4_FRAGMENT_MAX_PKT)
+#define NET_IPV4_FRAGMENTS_MAX_PKT CONFIG_NET_IPV4_FRAGMENT_MAX_PKT
+#else
+#define NET_IPV4_FRAGMENTS_MAX_PKT 1
+#endif
+
+/** Store pending IPv4 fragment information that is needed for reassembly. */
+struct net_ipv4_reassembly {
+	/** Node in the hash bucket or in the list of free slots */
+	sys_snode_t node;
+
+	/** Timeout for cancelling the reassembly */
+	struct net_timeout timeout;
+
+	/** IPv4 source address of the fragment */
+	struct in_addr src;
+
+	/** IPv4 destination address of the fragment */
+	struct in_addr dst;
+
+	/** Pending fragments, sorted by their offset */
+	struct net_pkt *pkt[NET_IPV4_FRAGMENTS_MAX_PKT];
+
+	/** IPv4 fragment identification */
+	uint16_t id;
+
+	/** Protocol of the fragmented packet */
+	uint8_t proto;
+};
+
+/**
+ * @typedef net_ipv4_frag_cb_t
+ * @brief Callback used while iterating over pending IPv4 fragments.
+ *
+ * @param reass IPv4 fragment reassembly struct
+ * @param user_data A valid pointer on some user data or NULL
+ */
+typedef void (*net_ipv4_frag_cb_t)(struct net_ipv4_reassembly *reass,
+				   void *user_data);
+
+/**
+ * @brief Go through all the currently pending IPv4 fragments.
+ *
+ * @param cb Callback to call for each pending IPv4 fragment.
+ * @param user_data User specified data or NULL.
+ */
+void net_ipv4_frag_foreach(net_ipv4_frag_cb_t cb, void *user_data);
+
+/**
+ * @brief Handles IPv4 fragmented packets.
+ *
+ * @param pkt Network head packet, the cursor being after the IPv4 header
+ * and its options.
+ * @param hdr IPv4 header of the packet
+ *
+ * @return Return verdict about the packet
+ */
+#if defined(CONFIG_NET_IPV4_FRAGMENT) && defined(CONFIG_NET_NATIVE_IPV4)
+enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt,
+					      struct net_ipv4_hdr *hdr);
+#else
+static inline
+enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt,
+					      struct net_ipv4_hdr *hdr)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(hdr);
+
+	return NET_DROP;
+}
+#endif
+
+/**
+ * @brief Fragment an IPv4 packet and send the fragments.
+ *
+ * @param iface Network interface
+ * @param pkt Network packet to split, it is not released
+ * @param mtu MTU of the interface
+ *
+ * @return 0 on success, negative errno otherwise.
+ */
+int net_ipv4_send_fragmented_pkt(struct net_if *iface, struct net_pkt *pkt,
+				 uint16_t mtu);
+
+/**
+ * @brief Prepare IPv4 packet for sending. The packet is fragmented if it
+ * does not fit into the MTU of the interface.
+ *
+ * @param pkt Network packet
+ *
+ * @return NET_OK if the packet can be sent as is, NET_CONTINUE if it was
+ * sent in fragments, NET_DROP otherwise.
+ */
+#if defined(CONFIG_NET_IPV4_FRAGMENT) && defined(CONFIG_NET_NATIVE_IPV4)
+enum net_verdict net_ipv4_prepare_for_send(struct net_pkt *pkt);
+#else
+static inline enum net_verdict net_ipv4_prepare_for_send(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return NET_OK;
+}
+#endif
+
 #endif /* __IPV4_H */
@@ -0,0 +1,579 @@
+/** @file
+ * @brief IPv4 Fragment related functions
+ */
+
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_ipv4, CONFIG_NET_IPV4_LOG_LEVEL);
+
+#include <errno.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/net_stats.h>
+#include <net/net_context.h>
+#include <random/rand32.h>
+#include "net_private.h"
+#include "ipv4.h"
+#include "net_stats.h"
+
+#define REASSEMBLY_HASH_SIZE MAX(1, CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT / 2)
+
+/* Fragment offset field of the header, flags excluded */
+#define FRAG_OFFSET_MASK 0x1fff
+
+#define BUF_ALLOC_TIMEOUT K_MSEC(100)
+
+static void reassembly_timeout(struct k_work *work);
+
+static struct net_ipv4_reassembly
+reassembly[CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT];
+
+/* The reassemblies in use are kept in hash buckets so that the matching
+ * one is found without going through all of them, and in a list of
+ * active timeouts that a single timer works through. Unused ones are in
+ * the free list.
+ */
+static sys_slist_t reassembly_hash[REASSEMBLY_HASH_SIZE];
+static sys_slist_t reassembly_free;
+static sys_slist_t active_reassembly_timeouts;
+static bool reassembly_init_done;
+
+static K_MUTEX_DEFINE(reassembly_lock);
+static K_WORK_DELAYABLE_DEFINE(reassembly_timer, reassembly_timeout);
+
+static void reassembly_init(void)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
+		sys_slist_append(&reassembly_free, &reassembly[i].node);
+	}
+
+	reassembly_init_done = true;
+}
+
+static sys_slist_t *reassembly_bucket(uint16_t id, uint8_t proto,
+				      const struct in_addr *src,
+				      const struct in_addr *dst)
+{
+	uint32_t key = UNALIGNED_GET(&src->s_addr) ^
+		       UNALIGNED_GET(&dst->s_addr) ^
+		       ((uint32_t)proto << 16) ^ id;
+
+	key ^= key >> 16;
+
+	return &reassembly_hash[key % REASSEMBLY_HASH_SIZE];
+}
+
+static bool reassembly_match(struct net_ipv4_reassembly *reass,
+			     struct net_ipv4_hdr *hdr)
+{
+	return reass->id == ((hdr->id[0] << 8) | hdr->id[1]) &&
+	       reass->proto == hdr->proto &&
+	       net_ipv4_addr_cmp(&reass->src, &hdr->src) &&
+	       net_ipv4_addr_cmp(&reass->dst, &hdr->dst);
+}
+
+static struct net_ipv4_reassembly *reassembly_get(struct net_ipv4_hdr *hdr)
+{
+	uint16_t id = (hdr->id[0] << 8) | hdr->id[1];
+	struct net_ipv4_reassembly *reass;
+	sys_slist_t *bucket;
+	sys_snode_t *node;
+
+	bucket = reassembly_bucket(id, hdr->proto, &hdr->src, &hdr->dst);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(bucket, reass, node) {
+		if (reassembly_match(reass, hdr)) {
+			return reass;
+		}
+	}
+
+	node = sys_slist_get(&reassembly_free);
+	if (!node) {
+		return NULL;
+	}
+
+	reass = CONTAINER_OF(node, struct net_ipv4_reassembly, node);
+
+	net_ipaddr_copy(&reass->src, &hdr->src);
+	net_ipaddr_copy(&reass->dst, &hdr->dst);
+	reass->id = id;
+	reass->proto = hdr->proto;
+
+	sys_slist_prepend(bucket, &reass->node);
+
+	sys_slist_append(&active_reassembly_timeouts, &reass->timeout.node);
+	net_timeout_set(&reass->timeout, CONFIG_NET_IPV4_FRAGMENT_TIMEOUT,
+			k_uptime_get_32());
+	k_work_reschedule(&reassembly_timer, K_NO_WAIT);
+
+	return reass;
+}
+
+/* Take the reassembly out of use, the caller is responsible of the
+ * fragments that are still stored in it.
+ */
+static void reassembly_release(struct net_ipv4_reassembly *reass)
+{
+	sys_slist_find_and_remove(reassembly_bucket(reass->id, reass->proto,
+						    &reass->src, &reass->dst),
+				  &reass->node);
+	sys_slist_find_and_remove(&active_reassembly_timeouts,
+				  &reass->timeout.node);
+
+	sys_slist_append(&reassembly_free, &reass->node);
+}
+
+static void reassembly_cancel(struct net_ipv4_reassembly *reass)
+{
+	int i;
+
+	NET_DBG("Cancel 0x%x", reass->id);
+
+	for (i = 0; i < NET_IPV4_FRAGMENTS_MAX_PKT; i++) {
+		if (!reass->pkt[i]) {
+			continue;
+		}
+
+		NET_DBG("[%d] IPv4 reassembly pkt %p %zd bytes data",
+			i, reass->pkt[i], net_pkt_get_len(reass->pkt[i]));
+
+		net_pkt_unref(reass->pkt[i]);
+		reass->pkt[i] = NULL;
+	}
+
+	reassembly_release(reass);
+}
+
+static void reassembly_info(char *str, struct net_ipv4_reassembly *reass)
+{
+	NET_DBG("%s id 0x%x src %s dst %s remain %u s", str, reass->id,
+		log_strdup(net_sprint_ipv4_addr(&reass->src)),
+		log_strdup(net_sprint_ipv4_addr(&reass->dst)),
+		net_timeout_remaining(&reass->timeout, k_uptime_get_32()));
+}
+
+static void reassembly_timeout(struct k_work *work)
+{
+	uint32_t next_update = UINT32_MAX;
+	uint32_t current_time = k_uptime_get_32();
+	struct net_ipv4_reassembly *current, *next;
+
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&reassembly_lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&active_reassembly_timeouts,
+					  current, next, timeout.node) {
+		uint32_t this_update = net_timeout_evaluate(&current->timeout,
+							     current_time);
+
+		if (this_update == 0U) {
+			reassembly_info("Reassembly cancelled", current);
+			reassembly_cancel(current);
+			continue;
+		}
+
+		if (this_update < next_update) {
+			next_update = this_update;
+		}
+	}
+
+	if (next_update != UINT32_MAX) {
+		k_work_reschedule(&reassembly_timer, K_MSEC(next_update));
+	}
+
+	k_mutex_unlock(&reassembly_lock);
+}
+
+static uint16_t fragment_len(struct net_pkt *pkt)
+{
+	return net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+		net_pkt_ipv4_opts_len(pkt);
+}
+
+/* The fragments are stored in offset order, so all of them have been
+ * received when the last one closes the packet and they follow each
+ * other without holes.
+ */
+static bool fragment_complete(struct net_ipv4_reassembly *reass)
+{
+	uint16_t offset = 0U;
+	int i;
+
+	for (i = 0; i < NET_IPV4_FRAGMENTS_MAX_PKT && reass->pkt[i]; i++) {
+		if (net_pkt_ipv4_fragment_offset(reass->pkt[i]) != offset) {
+			return false;
+		}
+
+		offset += fragment_len(reass->pkt[i]);
+	}
+
+	return !(net_pkt_ipv4_fragment_flags(reass->pkt[i - 1]) & NET_IPV4_MF);
+}
+
+/* Place the fragment in offset order. Overlapping fragments are not
+ * accepted, and a fragment received twice is dropped as is.
+ */
+static int fragment_insert(struct net_ipv4_reassembly *reass,
+			   struct net_pkt *pkt)
+{
+	uint16_t offset = net_pkt_ipv4_fragment_offset(pkt);
+	uint16_t end = offset + fragment_len(pkt);
+	int i;
+
+	for (i = 0; i < NET_IPV4_FRAGMENTS_MAX_PKT && reass->pkt[i]; i++) {
+		if (net_pkt_ipv4_fragment_offset(reass->pkt[i]) >= offset) {
+			break;
+		}
+	}
+
+	if (i < NET_IPV4_FRAGMENTS_MAX_PKT && reass->pkt[i] &&
+	    net_pkt_ipv4_fragment_offset(reass->pkt[i]) == offset &&
+	    fragment_len(reass->pkt[i]) == fragment_len(pkt)) {
+		return -EALREADY;
+	}
+
+	if ((i > 0 && net_pkt_ipv4_fragment_offset(reass->pkt[i - 1]) +
+		      fragment_len(reass->pkt[i - 1]) > offset) ||
+	    (i < NET_IPV4_FRAGMENTS_MAX_PKT && reass->pkt[i] &&
+	     net_pkt_ipv4_fragment_offset(reass->pkt[i]) < end)) {
+		return -EINVAL;
+	}
+
+	if (reass->pkt[NET_IPV4_FRAGMENTS_MAX_PKT - 1]) {
+		return -ENOMEM;
+	}
+
+	memmove(&reass->pkt[i + 1], &reass->pkt[i],
+		sizeof(void *) * (NET_IPV4_FRAGMENTS_MAX_PKT - i - 1));
+	reass->pkt[i] = pkt;
+
+	return 0;
+}
+
+/* The data of the other fragments is chained to the first one without
+ * copying, only their headers are pulled away.
+ */
+static struct net_pkt *reassemble_packet(struct net_ipv4_reassembly *reass)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+	struct net_ipv4_hdr *hdr;
+	struct net_pkt *pkt;
+	struct net_buf *last;
+	int i;
+
+	last = net_buf_frag_last(reass->pkt[0]->buffer);
+
+	for (i = 1; i < NET_IPV4_FRAGMENTS_MAX_PKT && reass->pkt[i]; i++) {
+		pkt = reass->pkt[i];
+
+		net_pkt_cursor_init(pkt);
+
+		if (net_pkt_pull(pkt, net_pkt_ip_hdr_len(pkt) +
+				 net_pkt_ipv4_opts_len(pkt))) {
+			NET_ERR("Failed to pull headers");
+			return NULL;
+		}
+
+		last->frags = pkt->buffer;
+		last = net_buf_frag_last(pkt->buffer);
+
+		pkt->buffer = NULL;
+		reass->pkt[i] = NULL;
+
+		net_pkt_unref(pkt);
+	}
+
+	pkt = reass->pkt[0];
+	reass->pkt[0] = NULL;
+
+	net_pkt_cursor_init(pkt);
+
+	hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt, &ipv4_access);
+	if (!hdr) {
+		net_pkt_unref(pkt);
+		return NULL;
+	}
+
+	hdr->len = htons(net_pkt_get_len(pkt));
+	hdr->offset[0] = 0U;
+	hdr->offset[1] = 0U;
+	hdr->chksum = 0U;
+	hdr->chksum = net_calc_chksum_ipv4(pkt);
+
+	net_pkt_set_data(pkt, &ipv4_access);
+
+	NET_DBG("New pkt %p IPv4 len is %zd bytes", pkt, net_pkt_get_len(pkt));
+
+	return pkt;
+}
+
+void net_ipv4_frag_foreach(net_ipv4_frag_cb_t cb, void *user_data)
+{
+	struct net_ipv4_reassembly *reass;
+	int i;
+
+	k_mutex_lock(&reassembly_lock, K_FOREVER);
+
+	for (i = 0; reassembly_init_done && i < REASSEMBLY_HASH_SIZE; i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&reassembly_hash[i], reass,
+					     node) {
+			cb(reass, user_data);
+		}
+	}
+
+	k_mutex_unlock(&reassembly_lock);
+}
+
+enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt,
+					      struct net_ipv4_hdr *hdr)
+{
+	struct net_ipv4_reassembly *reass;
+	struct net_pkt *reassembled = NULL;
+	uint16_t flag = (hdr->offset[0] << 8) | hdr->offset[1];
+	uint16_t offset = (flag & FRAG_OFFSET_MASK) * 8U;
+	uint16_t len = fragment_len(pkt);
+	bool more = flag & (NET_IPV4_MF << 13);
+	int ret;
+
+	if (len == 0U || (more && (len % 8U)) ||
+	    offset + len + net_pkt_ip_hdr_len(pkt) +
+	    net_pkt_ipv4_opts_len(pkt) > UINT16_MAX) {
+		NET_DBG("DROP: invalid fragment offset %u len %u", offset,
+			len);
+		return NET_DROP;
+	}
+
+	net_pkt_set_ipv4_fragment_offset(pkt, offset);
+	net_pkt_set_ipv4_fragment_flags(pkt, more ? NET_IPV4_MF : 0U);
+
+	k_mutex_lock(&reassembly_lock, K_FOREVER);
+
+	if (!reassembly_init_done) {
+		reassembly_init();
+	}
+
+	reass = reassembly_get(hdr);
+	if (!reass) {
+		NET_DBG("Cannot get reassembly slot, dropping pkt %p", pkt);
+		k_mutex_unlock(&reassembly_lock);
+		return NET_DROP;
+	}
+
+	ret = fragment_insert(reass, pkt);
+	if (ret == -EALREADY) {
+		NET_DBG("Duplicate fragment offset %u for 0x%x", offset,
+			reass->id);
+		k_mutex_unlock(&reassembly_lock);
+		return NET_DROP;
+	} else if (ret < 0) {
+		/* Overlapping fragments or too many of them, the whole
+		 * packet is discarded.
+		 */
+		NET_DBG("Cannot store fragment for 0x%x (%d)", reass->id,
+			ret);
+		reassembly_cancel(reass);
+		k_mutex_unlock(&reassembly_lock);
+		return NET_DROP;
+	}
+
+	NET_DBG("Storing pkt %p offset %u", pkt, offset);
+
+	if (fragment_complete(reass)) {
+		reassembly_info("Reassembly last pkt", reass);
+
+		reassembled = reassemble_packet(reass);
+
+		/* In case of failure, release what is left */
+		reassembly_cancel(reass);
+	} else {
+		reassembly_info("Reassembly nth pkt", reass);
+	}
+
+	k_mutex_unlock(&reassembly_lock);
+
+	/* We need to use the queue when feeding the packet back into the
+	 * IP stack as we might run out of stack if we call processing_data()
+	 * directly. As the packet does not contain link layer header, we
+	 * MUST NOT pass it to L2 so there will be a special check for that
+	 * in process_data() when handling the packet.
+	 */
+	if (reassembled && net_recv_data(net_pkt_iface(reassembled),
+					 reassembled) < 0) {
+		net_pkt_unref(reassembled);
+	}
+
+	return NET_OK;
+}
+
+static int send_ipv4_fragment(struct net_pkt *pkt, uint16_t hdr_len,
+			      uint16_t frag_hdr_len, uint16_t id,
+			      uint16_t frag_offset, uint16_t fit_len,
+			      bool final)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+	struct net_ipv4_hdr *hdr;
+	struct net_pkt *frag_pkt;
+	int ret = -ENOBUFS;
+
+	frag_pkt = net_pkt_alloc_with_buffer(net_pkt_iface(pkt),
+					     frag_hdr_len - NET_IPV4H_LEN +
+					     fit_len, AF_INET, 0,
+					     BUF_ALLOC_TIMEOUT);
+	if (!frag_pkt) {
+		return -ENOMEM;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	/* The options are only carried by the first fragment, the others
+	 * get the bare IPv4 header followed by their part of the payload.
+	 */
+	if (net_pkt_copy(frag_pkt, pkt, frag_hdr_len) ||
+	    net_pkt_skip(pkt, hdr_len - frag_hdr_len + frag_offset) ||
+	    net_pkt_copy(frag_pkt, pkt, fit_len)) {
+		goto fail;
+	}
+
+	net_pkt_set_ip_hdr_len(frag_pkt, NET_IPV4H_LEN);
+	net_pkt_set_ipv4_opts_len(frag_pkt, frag_hdr_len - NET_IPV4H_LEN);
+	net_pkt_set_priority(frag_pkt, net_pkt_priority(pkt));
+
+	net_pkt_cursor_init(frag_pkt);
+	net_pkt_set_overwrite(frag_pkt, true);
+
+	hdr = (struct net_ipv4_hdr *)net_pkt_get_data(frag_pkt, &ipv4_access);
+	if (!hdr) {
+		goto fail;
+	}
+
+	hdr->vhl = 0x40 | (frag_hdr_len / 4U);
+	hdr->len = htons(frag_hdr_len + fit_len);
+	hdr->id[0] = id >> 8;
+	hdr->id[1] = id;
+	hdr->offset[0] = ((frag_offset / 8U) >> 8) |
+			 (final ? 0U : NET_IPV4_MF << 5);
+	hdr->offset[1] = frag_offset / 8U;
+	hdr->chksum = 0U;
+
+	if (net_if_need_calc_tx_checksum(net_pkt_iface(frag_pkt))) {
+		hdr->chksum = net_calc_chksum_ipv4(frag_pkt);
+	}
+
+	if (net_pkt_set_data(frag_pkt, &ipv4_access)) {
+		goto fail;
+	}
+
+	ret = net_send_data(frag_pkt);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	/* Let this packet to be sent and hopefully it will release
+	 * the memory that can be utilized for next sent IPv4 fragment.
+	 */
+	k_yield();
+
+	return 0;
+
+fail:
+	NET_DBG("Cannot send fragment (%d)", ret);
+	net_pkt_unref(frag_pkt);
+
+	return ret;
+}
+
+int net_ipv4_send_fragmented_pkt(struct net_if *iface, struct net_pkt *pkt,
+				 uint16_t mtu)
+{
+	uint16_t hdr_len = (NET_IPV4_HDR(pkt)->vhl & NET_IPV4_IHL_MASK) * 4U;
+	uint16_t id = sys_rand32_get();
+	uint16_t frag_offset;
+	size_t length;
+	int fit_len;
+	int ret;
+
+	ARG_UNUSED(iface);
+
+	/* All the fragments but the last one carry a multiple of 8 bytes */
+	fit_len = (mtu - hdr_len) & ~7;
+	if (fit_len <= 0) {
+		NET_DBG("No room for IPv4 payload MTU %d hdr_len %d",
+			mtu, hdr_len);
+		return -EINVAL;
+	}
+
+	frag_offset = 0U;
+
+	length = net_pkt_get_len(pkt) - hdr_len;
+	while (length) {
+		bool final = false;
+
+		if (fit_len >= length) {
+			final = true;
+			fit_len = length;
+		}
+
+		ret = send_ipv4_fragment(pkt, hdr_len,
+					 frag_offset ? NET_IPV4H_LEN : hdr_len,
+					 id, frag_offset, fit_len, final);
+		if (ret < 0) {
+			return ret;
+		}
+
+		length -= fit_len;
+		frag_offset += fit_len;
+	}
+
+	return 0;
+}
+
+enum net_verdict net_ipv4_prepare_for_send(struct net_pkt *pkt)
+{
+	uint16_t mtu = net_if_get_mtu(net_pkt_iface(pkt));
+	int ret;
+
+	/* A TCP segment to be split by the device is not fragmented */
+	if (mtu == 0U || net_pkt_get_len(pkt) <= mtu ||
+	    net_pkt_tso_mss(pkt)) {
+		return NET_OK;
+	}
+
+	if (NET_IPV4_HDR(pkt)->offset[0] & (NET_IPV4_DF << 5)) {
+		NET_DBG("DROP: pkt %p too long and cannot be fragmented", pkt);
+		return NET_DROP;
+	}
+
+	ret = net_ipv4_send_fragmented_pkt(net_pkt_iface(pkt), pkt, mtu);
+	if (ret < 0) {
+		NET_DBG("Cannot fragment IPv4 pkt (%d)", ret);
+
+		if (ret == -ENOMEM) {
+			/* Try to send the packet if we could not allocate
+			 * enough network packets and hope the original large
+			 * packet can be sent ok.
+			 */
+			return NET_OK;
+		}
+	}
+
+	/* We "fake" the sending of the packet here so that
+	 * tcp.c:tcp_retry_expired() will increase the ref count when
+	 * re-sending the packet.
+	 */
+	if (IS_ENABLED(CONFIG_NET_TCP)) {
+		net_pkt_set_sent(pkt, true);
+	}
+
+	/* We need to unref here because we simulate the packet sending. */
+	net_pkt_unref(pkt);
+
+	return NET_CONTINUE;
+}
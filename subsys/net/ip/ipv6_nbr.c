@@ -255,14 +255,71 @@ void nbr_print(void)
 #define nbr_print(...)
 #endif
 
+/* The neighbors are indexed by a hash of their address, so that the
+ * lookups done for every sent packet do not walk the whole table. Each
+ * bucket is a chain of neighbor indexes plus one, 0 ending the chain.
+ * The interface is not hashed, so lookups without one can use the index.
+ *
+ * Neighbors stay in their chain when released, as they are validated
+ * on lookup, and are moved when reused for another address.
+ */
+#define NBR_HASH_SIZE MAX(1, CONFIG_NET_IPV6_MAX_NEIGHBORS / 2)
+
+static uint8_t nbr_hash[NBR_HASH_SIZE];
+static uint8_t nbr_hash_next[CONFIG_NET_IPV6_MAX_NEIGHBORS];
+
+static inline int nbr_index(struct net_nbr *nbr)
+{
+	return ((uint8_t *)nbr - (uint8_t *)net_neighbor_pool) /
+		sizeof(net_neighbor_pool[0]);
+}
+
+static uint8_t *nbr_hash_bucket(const struct in6_addr *addr)
+{
+	uint32_t hash = UNALIGNED_GET(&addr->s6_addr32[0]) ^
+			UNALIGNED_GET(&addr->s6_addr32[1]) ^
+			UNALIGNED_GET(&addr->s6_addr32[2]) ^
+			UNALIGNED_GET(&addr->s6_addr32[3]);
+
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
+
+	return &nbr_hash[hash % NBR_HASH_SIZE];
+}
+
+static void nbr_hash_del(struct net_nbr *nbr)
+{
+	uint8_t *link = nbr_hash_bucket(&net_ipv6_nbr_data(nbr)->addr);
+	int idx = nbr_index(nbr);
+
+	while (*link) {
+		if (*link == idx + 1) {
+			*link = nbr_hash_next[idx];
+			nbr_hash_next[idx] = 0U;
+			return;
+		}
+
+		link = &nbr_hash_next[*link - 1];
+	}
+}
+
+static void nbr_hash_add(struct net_nbr *nbr)
+{
+	uint8_t *bucket = nbr_hash_bucket(&net_ipv6_nbr_data(nbr)->addr);
+	int idx = nbr_index(nbr);
+
+	nbr_hash_next[idx] = *bucket;
+	*bucket = idx + 1;
+}
+
 static struct net_nbr *nbr_lookup(struct net_nbr_table *table,
 				  struct net_if *iface,
 				  const struct in6_addr *addr)
 {
-	int i;
+	uint8_t i = *nbr_hash_bucket(addr);
 
-	for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
-		struct net_nbr *nbr = get_nbr(i);
+	for (; i; i = nbr_hash_next[i - 1]) {
+		struct net_nbr *nbr = get_nbr(i - 1);
 
 		if (!nbr->ref) {
 			continue;
@@ -407,7 +464,9 @@ static void nbr_init(struct net_nbr *nbr, struct net_if *iface,
 	nbr->idx = NET_NBR_LLADDR_UNKNOWN;
 	nbr->iface = iface;
 
+	nbr_hash_del(nbr);
 	net_ipaddr_copy(&net_ipv6_nbr_data(nbr)->addr, addr);
+	nbr_hash_add(nbr);
 	ipv6_nbr_set_state(nbr, state);
 	net_ipv6_nbr_data(nbr)->is_router = is_router;
 	net_ipv6_nbr_data(nbr)->pending = NULL;
@@ -787,9 +846,10 @@ enum net_verdict net_ipv6_prepare_for_send(struct net_pkt *pkt)
 
 #if defined(CONFIG_NET_IPV6_FRAGMENT)
 	/* If we have already fragmented the packet, the fragment id will
-	 * contain a proper value and we can skip other checks.
+	 * contain a proper value and we can skip other checks. A TCP
+	 * segment to be split by the device is not fragmented either.
 	 */
-	if (net_pkt_ipv6_fragment_id(pkt) == 0U) {
+	if (net_pkt_ipv6_fragment_id(pkt) == 0U && !net_pkt_tso_mss(pkt)) {
 		uint16_t mtu = net_if_get_mtu(net_pkt_iface(pkt));
 		size_t pkt_len = net_pkt_get_len(pkt);
 
@@ -1245,6 +1245,16 @@ static int get_context_sndtimeo(struct net_context *context,
 #endif
 }
 
+static int get_context_tcp_congestion(struct net_context *context,
+				      void *value, size_t *len)
+{
+	if (net_context_get_ip_proto(context) != IPPROTO_TCP || !len) {
+		return -EINVAL;
+	}
+
+	return net_tcp_get_congestion(context, value, len);
+}
+
 /* If buf is not NULL, then use it. Otherwise read the data to be written
  * to net_pkt from msghdr.
  */
@@ -1396,9 +1406,28 @@ static void set_pkt_txtime(struct net_pkt *pkt, const struct msghdr *msghdr)
 	}
 }
 
+/* Unlink the caller's buffers from a packet that could not be sent */
+static void context_detach_frags(struct net_pkt *pkt, struct net_buf *frags)
+{
+	struct net_buf *buf;
+
+	if (pkt->buffer == frags) {
+		pkt->buffer = NULL;
+		return;
+	}
+
+	for (buf = pkt->buffer; buf; buf = buf->frags) {
+		if (buf->frags == frags) {
+			buf->frags = NULL;
+			break;
+		}
+	}
+}
+
 static int context_sendto(struct net_context *context,
 			  const void *buf,
 			  size_t len,
+			  struct net_buf *frags,
 			  const struct sockaddr *dst_addr,
 			  socklen_t addrlen,
 			  net_context_send_cb_t cb,
@@ -1614,14 +1643,33 @@ static int context_sendto(struct net_context *context,
 		return -ENETDOWN;
 	}
 
-	pkt = context_alloc_pkt(context, len, PKT_WAIT_TIME);
+	if (frags) {
+		/* The caller's buffers are linked to the packet as they
+		 * are, which only UDP and TCP know how to handle.
+		 */
+		if ((IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+		     net_if_is_ip_offloaded(iface)) ||
+		    (net_context_get_ip_proto(context) != IPPROTO_UDP &&
+		     net_context_get_ip_proto(context) != IPPROTO_TCP)) {
+			return -EOPNOTSUPP;
+		}
+
+		len = net_buf_frags_len(frags);
+
+		if (net_context_get_ip_proto(context) == IPPROTO_UDP &&
+		    len > UINT16_MAX - NET_UDPH_LEN) {
+			return -EMSGSIZE;
+		}
+	}
+
+	pkt = context_alloc_pkt(context, frags ? 0 : len, PKT_WAIT_TIME);
 	if (!pkt) {
 		return -ENOBUFS;
 	}
 
 	tmp_len = net_pkt_available_payload_buffer(
 				pkt, net_context_get_ip_proto(context));
-	if (tmp_len < len) {
+	if (!frags && tmp_len < len) {
 		len = tmp_len;
 	}
 
@@ -1668,21 +1716,35 @@ static int context_sendto(struct net_context *context,
 		}
 	} else if (IS_ENABLED(CONFIG_NET_UDP) &&
 	    net_context_get_ip_proto(context) == IPPROTO_UDP) {
-		ret = context_setup_udp_packet(context, pkt, buf, len, msghdr,
+		ret = context_setup_udp_packet(context, pkt, buf,
+					       frags ? 0 : len, msghdr,
 					       dst_addr, addrlen);
 		if (ret < 0) {
 			goto fail;
 		}
 
+		if (frags) {
+			net_pkt_append_buffer(pkt, frags);
+		}
+
 		context_finalize_packet(context, pkt);
 
 		ret = net_send_data(pkt);
 	} else if (IS_ENABLED(CONFIG_NET_TCP) &&
 		   net_context_get_ip_proto(context) == IPPROTO_TCP) {
 
-		ret = context_write_data(pkt, buf, len, msghdr);
-		if (ret < 0) {
-			goto fail;
+		if (frags) {
+			/* Segments are built from the send queue, so the
+			 * buffers are queued instead of the allocated one.
+			 */
+			net_buf_unref(pkt->buffer);
+			pkt->buffer = NULL;
+			net_pkt_append_buffer(pkt, frags);
+		} else {
+			ret = context_write_data(pkt, buf, len, msghdr);
+			if (ret < 0) {
+				goto fail;
+			}
 		}
 
 		net_pkt_cursor_init(pkt);
@@ -1730,6 +1792,10 @@ static int context_sendto(struct net_context *context,
 
 	return len;
 fail:
+	if (frags) {
+		context_detach_frags(pkt, frags);
+	}
+
 	net_pkt_unref(pkt);
 
 	return ret;
@@ -1770,7 +1836,7 @@ int net_context_send(struct net_context *context,
 		addrlen = 0;
 	}
 
-	ret = context_sendto(context, buf, len, &context->remote,
+	ret = context_sendto(context, buf, len, NULL, &context->remote,
 			     addrlen, cb, timeout, user_data, false);
 unlock:
 	k_mutex_unlock(&context->lock);
@@ -1789,7 +1855,7 @@ int net_context_sendmsg(struct net_context *context,
 
 	k_mutex_lock(&context->lock, K_FOREVER);
 
-	ret = context_sendto(context, msghdr, 0, NULL, 0,
+	ret = context_sendto(context, msghdr, 0, NULL, NULL, 0,
 			     cb, timeout, user_data, true);
 
 	k_mutex_unlock(&context->lock);
@@ -1810,7 +1876,7 @@ int net_context_sendto(struct net_context *context,
 
 	k_mutex_lock(&context->lock, K_FOREVER);
 
-	ret = context_sendto(context, buf, len, dst_addr, addrlen,
+	ret = context_sendto(context, buf, len, NULL, dst_addr, addrlen,
 			     cb, timeout, user_data, true);
 
 	k_mutex_unlock(&context->lock);
@@ -1818,6 +1884,40 @@ int net_context_sendto(struct net_context *context,
 	return ret;
 }
 
+int net_context_sendto_buf(struct net_context *context,
+			   struct net_buf *frags,
+			   const struct sockaddr *dst_addr,
+			   socklen_t addrlen,
+			   net_context_send_cb_t cb,
+			   k_timeout_t timeout,
+			   void *user_data)
+{
+	int ret;
+
+	if (!frags) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	if (!dst_addr) {
+		if (!(context->flags & NET_CONTEXT_REMOTE_ADDR_SET)) {
+			ret = -EDESTADDRREQ;
+			goto unlock;
+		}
+
+		dst_addr = &context->remote;
+		addrlen = sizeof(context->remote);
+	}
+
+	ret = context_sendto(context, NULL, 0, frags, dst_addr, addrlen,
+			     cb, timeout, user_data, true);
+unlock:
+	k_mutex_unlock(&context->lock);
+
+	return ret;
+}
+
 enum net_verdict net_context_packet_received(struct net_conn *conn,
 					     struct net_pkt *pkt,
 					     union net_ip_header *ip_hdr,
@@ -2206,6 +2306,16 @@ static int set_context_sndtimeo(struct net_context *context,
 #endif
 }
 
+static int set_context_tcp_congestion(struct net_context *context,
+				      const void *value, size_t len)
+{
+	if (net_context_get_ip_proto(context) != IPPROTO_TCP) {
+		return -EINVAL;
+	}
+
+	return net_tcp_set_congestion(context, value, len);
+}
+
 int net_context_set_option(struct net_context *context,
 			   enum net_context_option option,
 			   const void *value, size_t len)
@@ -2236,6 +2346,9 @@ int net_context_set_option(struct net_context *context,
 	case NET_OPT_SNDTIMEO:
 		ret = set_context_sndtimeo(context, value, len);
 		break;
+	case NET_OPT_TCP_CONGESTION:
+		ret = set_context_tcp_congestion(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
@@ -2273,6 +2386,9 @@ int net_context_get_option(struct net_context *context,
 	case NET_OPT_SNDTIMEO:
 		ret = get_context_sndtimeo(context, value, len);
 		break;
+	case NET_OPT_TCP_CONGESTION:
+		ret = get_context_tcp_congestion(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
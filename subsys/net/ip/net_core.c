@@ -42,6 +42,7 @@ LOG_MODULE_REGISTER(net_core, CONFIG_NET_CORE_LOG_LEVEL);
 #include "ipv6.h"
 
 #include "icmpv4.h"
+#include "ipv4.h"
 
 #include "dhcpv4.h"
 
@@ -78,6 +79,15 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 	}
 #endif
 
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+	/* A reassembled IPv4 packet is carried by its first fragment, and
+	 * does not have link layer headers either.
+	 */
+	if (net_pkt_ipv4_fragment_flags(pkt) & NET_IPV4_MF) {
+		locally_routed = true;
+	}
+#endif
+
 	/* If there is no data, then drop the packet. */
 	if (!pkt->frags) {
 		NET_DBG("Corrupted packet (frags %p)", pkt->frags);
@@ -99,6 +109,8 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 		}
 	}
 
+	net_pkt_rx_stage_mark(pkt, NET_STATS_RX_STAGE_L2);
+
 	/* L2 processed, now we can pass IPPROTO_RAW to packet socket: */
 	ret = net_packet_socket_input(pkt, IPPROTO_RAW);
 	if (ret != NET_CONTINUE) {
@@ -367,13 +379,14 @@ static void net_rx(struct net_if *iface, struct net_pkt *pkt)
 void net_process_rx_packet(struct net_pkt *pkt)
 {
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
+	net_pkt_rx_stage_mark(pkt, NET_STATS_RX_STAGE_TC);
 
 	net_capture_pkt(net_pkt_iface(pkt), pkt);
 
 	net_rx(net_pkt_iface(pkt), pkt);
 }
 
-static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
+static uint8_t net_queue_rx_tc(struct net_if *iface, struct net_pkt *pkt)
 {
 	uint8_t prio = net_pkt_priority(pkt);
 	uint8_t tc = net_rx_priority2tc(prio);
@@ -388,6 +401,13 @@ static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 	NET_DBG("TC %d with prio %d pkt %p", tc, prio, pkt);
 #endif
 
+	return tc;
+}
+
+static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
+{
+	uint8_t tc = net_queue_rx_tc(iface, pkt);
+
 	if (NET_TC_RX_COUNT == 0) {
 		net_process_rx_packet(pkt);
 	} else {
@@ -395,6 +415,23 @@ static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 	}
 }
 
+static void net_recv_prepare(struct net_if *iface, struct net_pkt *pkt)
+{
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_cursor_init(pkt);
+
+	NET_DBG("prio %d iface %p pkt %p len %zu", net_pkt_priority(pkt),
+		iface, pkt, net_pkt_get_len(pkt));
+
+	if (IS_ENABLED(CONFIG_NET_ROUTING)) {
+		net_pkt_set_orig_iface(pkt, iface);
+	}
+
+	net_pkt_set_iface(pkt, iface);
+
+	net_pkt_rx_stage_mark(pkt, NET_STATS_RX_STAGE_DRIVER);
+}
+
 /* Called by driver when an IP packet has been received */
 int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
 {
@@ -410,21 +447,51 @@ int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
 		return -ENETDOWN;
 	}
 
-	net_pkt_set_overwrite(pkt, true);
-	net_pkt_cursor_init(pkt);
+	net_recv_prepare(iface, pkt);
+	net_queue_rx(iface, pkt);
 
-	NET_DBG("prio %d iface %p pkt %p len %zu", net_pkt_priority(pkt),
-		iface, pkt, net_pkt_get_len(pkt));
+	return 0;
+}
 
-	if (IS_ENABLED(CONFIG_NET_ROUTING)) {
-		net_pkt_set_orig_iface(pkt, iface);
+int net_recv_data_batch(struct net_if *iface, struct net_pkt **pkts,
+			size_t count)
+{
+	size_t queued = 0;
+
+	if (!pkts || !iface) {
+		return -EINVAL;
 	}
 
-	net_pkt_set_iface(pkt, iface);
+	if (!net_if_flag_is_set(iface, NET_IF_UP)) {
+		return -ENETDOWN;
+	}
 
-	net_queue_rx(iface, pkt);
+	for (size_t i = 0; i < count; i++) {
+		struct net_pkt *pkt = pkts[i];
 
-	return 0;
+		if (net_pkt_is_empty(pkt)) {
+			net_stats_update_processing_error(iface);
+			net_pkt_unref(pkt);
+			continue;
+		}
+
+		net_recv_prepare(iface, pkt);
+		(void)net_queue_rx_tc(iface, pkt);
+
+		if (NET_TC_RX_COUNT == 0) {
+			net_process_rx_packet(pkt);
+		} else {
+			pkts[queued] = pkt;
+		}
+
+		queued++;
+	}
+
+	if (NET_TC_RX_COUNT > 0) {
+		net_tc_submit_batch_to_rx_queue(pkts, queued);
+	}
+
+	return queued;
 }
 
 static inline void l3_init(void)
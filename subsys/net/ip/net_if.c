@@ -23,6 +23,7 @@ LOG_MODULE_REGISTER(net_if, CONFIG_NET_IF_LOG_LEVEL);
 
 #include "net_private.h"
 #include "ipv6.h"
+#include "ipv4.h"
 #include "ipv4_autoconf_internal.h"
 
 #include "net_stats.h"
@@ -331,10 +332,11 @@ void net_process_tx_packet(struct net_pkt *pkt)
 #endif
 }
 
-void net_if_queue_tx(struct net_if *iface, struct net_pkt *pkt)
+/* Returns true if the packet was sent right away instead of being queued */
+static bool net_if_queue_tx_bypass(struct net_if *iface, struct net_pkt *pkt)
 {
 	uint8_t prio = net_pkt_priority(pkt);
-	uint8_t tc = net_tx_priority2tc(prio);
+	uint8_t tc __unused = net_tx_priority2tc(prio);
 
 	net_stats_update_tc_sent_pkt(iface, tc);
 	net_stats_update_tc_sent_bytes(iface, tc, net_pkt_get_len(pkt));
@@ -349,7 +351,7 @@ void net_if_queue_tx(struct net_if *iface, struct net_pkt *pkt)
 		net_pkt_set_tx_stats_tick(pkt, k_cycle_get_32());
 
 		net_if_tx(net_pkt_iface(pkt), pkt);
-		return;
+		return true;
 	}
 
 #if NET_TC_TX_COUNT > 1
@@ -360,6 +362,17 @@ void net_if_queue_tx(struct net_if *iface, struct net_pkt *pkt)
 	iface->tx_pending++;
 #endif
 
+	return false;
+}
+
+void net_if_queue_tx(struct net_if *iface, struct net_pkt *pkt)
+{
+	uint8_t tc = net_tx_priority2tc(net_pkt_priority(pkt));
+
+	if (net_if_queue_tx_bypass(iface, pkt)) {
+		return;
+	}
+
 	if (!net_tc_submit_to_tx_queue(tc, pkt)) {
 #if defined(CONFIG_NET_POWER_MANAGEMENT)
 		iface->tx_pending--
@@ -368,12 +381,31 @@ void net_if_queue_tx(struct net_if *iface, struct net_pkt *pkt)
 	}
 }
 
+void net_if_queue_tx_batch(struct net_if *iface, struct net_pkt **pkts,
+			   size_t count)
+{
+	size_t queued = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		if (!net_if_queue_tx_bypass(iface, pkts[i])) {
+			pkts[queued++] = pkts[i];
+		}
+	}
+
+	if (queued > 0) {
+		net_tc_submit_batch_to_tx_queue(pkts, queued);
+	}
+}
+
 void net_if_stats_reset(struct net_if *iface)
 {
 #if defined(CONFIG_NET_STATISTICS_PER_INTERFACE)
 	Z_STRUCT_SECTION_FOREACH(net_if, tmp) {
 		if (iface == tmp) {
 			memset(&iface->stats, 0, sizeof(iface->stats));
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+			memset(iface->stats_cpu, 0, sizeof(iface->stats_cpu));
+#endif
 			return;
 		}
 	}
@@ -389,6 +421,9 @@ void net_if_stats_reset_all(void)
 
 	Z_STRUCT_SECTION_FOREACH(net_if, iface) {
 		memset(&iface->stats, 0, sizeof(iface->stats));
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+		memset(iface->stats_cpu, 0, sizeof(iface->stats_cpu));
+#endif
 	}
 
 	k_mutex_unlock(&lock);
@@ -475,6 +510,11 @@ enum net_verdict net_if_send_data(struct net_if *iface, struct net_pkt *pkt)
 		verdict = net_ipv6_prepare_for_send(pkt);
 	}
 
+	/* A packet that does not fit into the MTU is sent in fragments */
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		verdict = net_ipv4_prepare_for_send(pkt);
+	}
+
 done:
 	/*   NET_OK in which case packet has checked successfully. In this case
 	 *   the net_context callback is called after successful delivery in
@@ -3938,6 +3978,24 @@ bool net_if_need_calc_rx_checksum(struct net_if *iface)
 	return need_calc_checksum(iface, ETHERNET_HW_RX_CHKSUM_OFFLOAD);
 }
 
+bool net_if_supports_tx_tso(struct net_if *iface)
+{
+#if defined(CONFIG_NET_TCP_TSO) && defined(CONFIG_NET_L2_ETHERNET)
+	const enum ethernet_hw_caps caps = ETHERNET_HW_TX_TCP_SEGMENTATION |
+					   ETHERNET_HW_TX_CHKSUM_OFFLOAD;
+
+	if (net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET)) {
+		return false;
+	}
+
+	return (net_eth_get_hw_capabilities(iface) & caps) == caps;
+#else
+	ARG_UNUSED(iface);
+
+	return false;
+#endif
+}
+
 int net_if_get_by_iface(struct net_if *iface)
 {
 	if (!(iface >= _net_if_list_start && iface < _net_if_list_end)) {
@@ -38,7 +38,10 @@ LOG_MODULE_REGISTER(net_pkt, CONFIG_NET_PKT_LOG_LEVEL);
 #include <net/ethernet.h>
 #include <net/udp.h>
 
+#include <tracing/tracing.h>
+
 #include "net_private.h"
+#include "net_stats.h"
 #include "tcp_internal.h"
 
 /* Find max header size of IP protocol (IPv4 or IPv6) */
@@ -78,8 +81,15 @@ LOG_MODULE_REGISTER(net_pkt, CONFIG_NET_PKT_LOG_LEVEL);
 
 /* Make sure that IP + TCP/UDP/ICMP headers fit into one fragment. This
  * makes possible to cast a fragment pointer to protocol header struct.
+ * Variable size fragments are never split smaller than the minimum size.
  */
-#if CONFIG_NET_BUF_DATA_SIZE < (MAX_IP_PROTO_LEN + MAX_NEXT_PROTO_LEN)
+#if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
+#define PKT_FRAG_MIN_SIZE CONFIG_NET_BUF_DATA_SIZE
+#else
+#define PKT_FRAG_MIN_SIZE CONFIG_NET_BUF_DATA_MIN_FRAG_SIZE
+#endif
+
+#if PKT_FRAG_MIN_SIZE < (MAX_IP_PROTO_LEN + MAX_NEXT_PROTO_LEN)
 #if defined(STRING2)
 #undef STRING2
 #endif
@@ -88,7 +98,7 @@ LOG_MODULE_REGISTER(net_pkt, CONFIG_NET_PKT_LOG_LEVEL);
 #endif
 #define STRING2(x) #x
 #define STRING(x) STRING2(x)
-#pragma message "Data len " STRING(CONFIG_NET_BUF_DATA_SIZE)
+#pragma message "Data len " STRING(PKT_FRAG_MIN_SIZE)
 #pragma message "Minimum len " STRING(MAX_IP_PROTO_LEN + MAX_NEXT_PROTO_LEN)
 #error "Too small net_buf fragment size"
 #endif
@@ -924,25 +934,118 @@ static struct net_buf *pkt_alloc_buffer(struct net_buf_pool *pool,
 					size_t size, k_timeout_t timeout)
 #endif
 {
-	struct net_buf *buf;
+	struct net_buf *first = NULL;
+	struct net_buf *current = NULL;
+	size_t total = size;
+	size_t len = size;
+
+	/* Try to fit the data in a single buffer. If the pool has enough
+	 * free memory but not in one block, split the data in smaller
+	 * buffers instead of waiting for a large enough block.
+	 */
+	while (size) {
+		struct net_buf *new;
+
+		new = net_buf_alloc_len(pool, MIN(len, size), K_NO_WAIT);
+		if (!new) {
+			if (len <= CONFIG_NET_BUF_DATA_MIN_FRAG_SIZE) {
+				break;
+			}
+
+			len = MAX(len / 2, CONFIG_NET_BUF_DATA_MIN_FRAG_SIZE);
+			continue;
+		}
+
+		if (!first) {
+			first = new;
+		} else {
+			current->frags = new;
+		}
+
+		current = new;
+		size -= current->size;
+	}
+
+	if (size) {
+		if (first) {
+			net_buf_unref(first);
+		}
+
+		first = NULL;
 
-	buf = net_buf_alloc_len(pool, size, timeout);
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			first = net_buf_alloc_len(pool, total, timeout);
+		}
+	}
 
 #if CONFIG_NET_PKT_LOG_LEVEL >= LOG_LEVEL_DBG
-	NET_FRAG_CHECK_IF_NOT_IN_USE(buf, buf->ref + 1);
+	for (current = first; current; current = current->frags) {
+		NET_FRAG_CHECK_IF_NOT_IN_USE(current, current->ref + 1);
 
-	net_pkt_alloc_add(buf, false, caller, line);
+		net_pkt_alloc_add(current, false, caller, line);
 
-	NET_DBG("%s (%s) [%d] frag %p ref %d (%s():%d)",
-		pool2str(pool), get_name(pool), get_frees(pool),
-		buf, buf->ref, caller, line);
+		NET_DBG("%s (%s) [%d] frag %p ref %d (%s():%d)",
+			pool2str(pool), get_name(pool), get_frees(pool),
+			current, current->ref, caller, line);
+	}
 #endif
 
-	return buf;
+	return first;
 }
 
 #endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
 
+#if defined(CONFIG_NET_PKT_BUF_STATS)
+static struct net_pkt_buf_stats rx_buf_stats;
+static struct net_pkt_buf_stats tx_buf_stats;
+
+static void pkt_buf_stats_update(struct net_pkt *pkt, size_t len,
+				 struct net_buf *buf)
+{
+	struct net_pkt_buf_stats *stats;
+
+	stats = pkt->slab == &rx_pkts ? &rx_buf_stats : &tx_buf_stats;
+
+	if (!buf) {
+		stats->failed++;
+		return;
+	}
+
+	stats->allocs++;
+	stats->requested += len;
+
+	if (buf->frags) {
+		stats->split++;
+	}
+
+	for (; buf; buf = buf->frags) {
+		stats->bufs++;
+#if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
+		stats->allocated += CONFIG_NET_BUF_DATA_SIZE;
+#else
+		stats->allocated += buf->size;
+#endif
+	}
+}
+
+void net_pkt_get_buf_stats(struct net_pkt_buf_stats *rx,
+			   struct net_pkt_buf_stats *tx)
+{
+	if (rx) {
+		*rx = rx_buf_stats;
+	}
+
+	if (tx) {
+		*tx = tx_buf_stats;
+	}
+}
+#else
+static inline void pkt_buf_stats_update(struct net_pkt *pkt, size_t len,
+					struct net_buf *buf)
+{
+}
+#endif /* CONFIG_NET_PKT_BUF_STATS */
+
 static size_t pkt_buffer_length(struct net_pkt *pkt,
 				size_t size,
 				enum net_ip_protocol proto,
@@ -968,6 +1071,13 @@ static size_t pkt_buffer_length(struct net_pkt *pkt,
 
 		max_len = MAX(max_len, NET_IPV6_MTU);
 	} else if (IS_ENABLED(CONFIG_NET_IPV4) && family == AF_INET) {
+		if (IS_ENABLED(CONFIG_NET_IPV4_FRAGMENT) && (size > max_len)) {
+			/* We support larger packets if IPv4 fragmentation is
+			 * enabled.
+			 */
+			max_len = size;
+		}
+
 		max_len = MAX(max_len, NET_IPV4_MTU);
 	} else { /* family == AF_UNSPEC */
 #if defined (CONFIG_NET_L2_ETHERNET)
@@ -1159,6 +1269,8 @@ int net_pkt_alloc_buffer(struct net_pkt *pkt,
 	buf = pkt_alloc_buffer(pool, alloc_len, timeout);
 #endif
 
+	pkt_buf_stats_update(pkt, alloc_len, buf);
+
 	if (!buf) {
 #if NET_LOG_LEVEL >= LOG_LEVEL_DBG
 		NET_ERR("Data buffer (%zd) allocation failed (%s:%d)",
@@ -1174,6 +1286,32 @@ int net_pkt_alloc_buffer(struct net_pkt *pkt,
 	return 0;
 }
 
+#if defined(CONFIG_NET_PKT_RX_LATENCY)
+void net_pkt_rx_stage_mark(struct net_pkt *pkt,
+			   enum net_stats_rx_stage stage)
+{
+	uint32_t now;
+	uint32_t usec;
+
+	if (pkt->rx_latency.stage == 0U ||
+	    stage + 1 < pkt->rx_latency.stage) {
+		return;
+	}
+
+	now = k_cycle_get_32();
+	usec = k_cyc_to_us_floor32(now - pkt->rx_latency.time);
+
+	pkt->rx_latency.time = now;
+	pkt->rx_latency.stage = stage + 2;
+
+	if (net_pkt_iface(pkt)) {
+		net_stats_update_rx_latency(net_pkt_iface(pkt), stage, usec);
+	}
+
+	sys_port_trace_net_pkt_rx_stage(pkt, stage, usec);
+}
+#endif /* CONFIG_NET_PKT_RX_LATENCY */
+
 #if NET_LOG_LEVEL >= LOG_LEVEL_DBG
 static struct net_pkt *pkt_alloc(struct k_mem_slab *slab, k_timeout_t timeout,
 				 const char *caller, int line)
@@ -1226,6 +1364,12 @@ static struct net_pkt *pkt_alloc(struct k_mem_slab *slab, k_timeout_t timeout)
 		net_pkt_set_priority(pkt, TX_DEFAULT_PRIORITY);
 	} else if (&rx_pkts == slab) {
 		net_pkt_set_priority(pkt, RX_DEFAULT_PRIORITY);
+
+#if defined(CONFIG_NET_PKT_RX_LATENCY)
+		/* The driver stage starts when the packet is allocated */
+		pkt->rx_latency.time = k_cycle_get_32();
+		pkt->rx_latency.stage = 1U;
+#endif
 	}
 
 	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) ||
@@ -1739,6 +1883,13 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_priority(clone_pkt, net_pkt_priority(pkt));
 	net_pkt_set_orig_iface(clone_pkt, net_pkt_orig_iface(pkt));
 	net_pkt_set_captured(clone_pkt, net_pkt_is_captured(pkt));
+	net_pkt_set_tso_mss(clone_pkt, net_pkt_tso_mss(pkt));
+	net_pkt_set_rx_hash(clone_pkt, net_pkt_rx_hash(pkt));
+
+#if defined(CONFIG_NET_PKT_RX_LATENCY)
+	/* The clone carries on in the RX path, such as TCP data */
+	clone_pkt->rx_latency = pkt->rx_latency;
+#endif
 
 	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
 		net_pkt_set_ipv4_ttl(clone_pkt, net_pkt_ipv4_ttl(pkt));
@@ -1913,13 +2064,21 @@ int net_pkt_pull(struct net_pkt *pkt, size_t length)
 			rem = length;
 		}
 
-		c_op->buf->len -= rem;
 		left -= rem;
-		if (left) {
+		if (left && c_op->pos == c_op->buf->data) {
+			/* Nothing to keep in front, so moving the start of
+			 * the data is enough. This also avoids writing to
+			 * buffers holding external data.
+			 */
+			c_op->pos = net_buf_pull(c_op->buf, rem);
+		} else if (left) {
+			c_op->buf->len -= rem;
 			memmove(c_op->pos, c_op->pos+rem, left);
 		} else {
 			struct net_buf *buf = pkt->buffer;
 
+			c_op->buf->len -= rem;
+
 			if (buf) {
 				pkt->buffer = buf->frags;
 				buf->frags = NULL;
@@ -90,6 +90,13 @@ static inline enum net_verdict net_ipv6_input(struct net_pkt *pkt,
 #endif
 extern bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt);
 extern void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt);
+extern void net_tc_submit_batch_to_tx_queue(struct net_pkt **pkts,
+					    size_t count);
+extern void net_tc_submit_batch_to_rx_queue(struct net_pkt **pkts,
+					    size_t count);
+#if defined(CONFIG_NET_RX_FLOW_STEERING)
+extern uint32_t net_tc_rx_flow_hash(struct net_pkt *pkt);
+#endif
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
 char *net_sprint_addr(sa_family_t af, const void *addr);
@@ -38,6 +38,7 @@ LOG_MODULE_REGISTER(net_shell, LOG_LEVEL_DBG);
 #endif
 
 #include "ipv6.h"
+#include "ipv4.h"
 
 #if defined(CONFIG_NET_ARP)
 #include "ethernet/arp.h"
@@ -259,6 +260,7 @@ static struct ethernet_capabilities eth_hw_caps[] = {
 	EC(ETHERNET_HW_RX_CHKSUM_OFFLOAD, "RX checksum offload"),
 	EC(ETHERNET_HW_VLAN,              "Virtual LAN"),
 	EC(ETHERNET_HW_VLAN_TAG_STRIP,    "VLAN Tag stripping"),
+	EC(ETHERNET_HW_VLAN_TAG_INSERT,   "VLAN Tag insertion"),
 	EC(ETHERNET_AUTO_NEGOTIATION_SET, "Auto negotiation"),
 	EC(ETHERNET_LINK_10BASE_T,        "10 Mbits"),
 	EC(ETHERNET_LINK_100BASE_T,       "100 Mbits"),
@@ -1177,11 +1179,54 @@ static void print_net_pm_stats(const struct shell *shell, struct net_if *iface)
 #endif
 }
 
+static void print_rx_latency_stats(const struct shell *shell,
+				   struct net_if *iface)
+{
+#if defined(CONFIG_NET_PKT_RX_LATENCY)
+	static const char * const stage2str[] = {
+		[NET_STATS_RX_STAGE_DRIVER] = "driver",
+		[NET_STATS_RX_STAGE_TC] = "tc queue",
+		[NET_STATS_RX_STAGE_L2] = "L2",
+		[NET_STATS_RX_STAGE_IP] = "IP",
+		[NET_STATS_RX_STAGE_TRANSPORT] = "transport",
+		[NET_STATS_RX_STAGE_SOCKET] = "socket",
+	};
+	net_stats_t count;
+	int i, j;
+
+	PR("RX latency (packets per time range):\n");
+
+	for (i = 0; i < NET_STATS_RX_STAGE_COUNT; i++) {
+		PR("\t%-9s:", stage2str[i]);
+
+		for (j = 0; j < NET_STATS_RX_LATENCY_BUCKETS; j++) {
+			count = GET_STAT(iface, rx_latency[i].hist[j]);
+			if (!count) {
+				continue;
+			}
+
+			if (j == NET_STATS_RX_LATENCY_BUCKETS - 1) {
+				PR(" >=%u us %u", BIT(j - 1), count);
+			} else {
+				PR(" <%u us %u", BIT(j), count);
+			}
+		}
+
+		PR("\n");
+	}
+#else
+	ARG_UNUSED(shell);
+	ARG_UNUSED(iface);
+#endif
+}
+
 static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 {
 	struct net_shell_user_data *data = user_data;
 	const struct shell *shell = data->shell;
 
+	net_stats_collect(iface);
+
 	if (iface) {
 		const char *extra;
 
@@ -1312,6 +1357,7 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 #endif /* CONFIG_NET_STATISTICS_PPP && CONFIG_NET_STATISTICS_USER_API */
 
 	print_net_pm_stats(shell, iface);
+	print_rx_latency_stats(shell, iface);
 }
 #endif /* CONFIG_NET_STATISTICS */
 
@@ -1600,6 +1646,50 @@ static void ipv6_frag_cb(struct net_ipv6_reassembly *reass,
 }
 #endif /* CONFIG_NET_IPV6_FRAGMENT */
 
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+static void ipv4_frag_cb(struct net_ipv4_reassembly *reass,
+			 void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *shell = data->shell;
+	int *count = data->user_data;
+	char src[ADDR_LEN];
+	int i;
+
+	if (!*count) {
+		PR("\nIPv4 reassembly Id     Remain "
+		   "Src             \tDst\n");
+	}
+
+	snprintk(src, ADDR_LEN, "%s", net_sprint_ipv4_addr(&reass->src));
+
+	PR("%p      0x%04x  %5u %16s\t%16s\n", reass, reass->id,
+	   net_timeout_remaining(&reass->timeout, k_uptime_get_32()),
+	   src, net_sprint_ipv4_addr(&reass->dst));
+
+	for (i = 0; i < NET_IPV4_FRAGMENTS_MAX_PKT; i++) {
+		if (reass->pkt[i]) {
+			struct net_buf *frag = reass->pkt[i]->frags;
+
+			PR("[%d] pkt %p->", i, reass->pkt[i]);
+
+			while (frag) {
+				PR("%p", frag);
+
+				frag = frag->frags;
+				if (frag) {
+					PR("->");
+				}
+			}
+
+			PR("\n");
+		}
+	}
+
+	(*count)++;
+}
+#endif /* CONFIG_NET_IPV4_FRAGMENT */
+
 #if defined(CONFIG_NET_DEBUG_NET_PKT_ALLOC)
 static void allocs_cb(struct net_pkt *pkt,
 		      struct net_buf *buf,
@@ -1810,6 +1900,8 @@ static void capture_cb(struct net_capture_info *info, void *user_data)
 	   (net_if_get_by_iface(info->capture_iface) + '0') : '-',
 	   net_if_get_by_iface(info->tunnel_iface),
 	   addr_local, addr_peer);
+	PR("\t\t%s mode, captured %u, dropped %u\n",
+	   info->is_ring ? "Ring" : "Clone", info->captured, info->dropped);
 
 	(*count)++;
 }
@@ -1995,6 +2087,46 @@ static int cmd_net_capture_disable(const struct shell *shell, size_t argc,
 	return 0;
 }
 
+static int cmd_net_capture_ring(const struct shell *shell, size_t argc,
+				char *argv[])
+{
+#if defined(CONFIG_NET_CAPTURE)
+	int ret, arg = 1, snaplen = 0;
+	bool enable = true;
+
+	if (capture_dev == NULL) {
+		return 0;
+	}
+
+	if (argv[arg] != NULL) {
+		if (strcmp(argv[arg], "off") == 0) {
+			enable = false;
+		} else {
+			snaplen = atoi(argv[arg]);
+			if (snaplen < 0 || snaplen > UINT16_MAX) {
+				PR_WARNING("Snap length %d is invalid.\n",
+					   snaplen);
+				return -ENOEXEC;
+			}
+		}
+	}
+
+	ret = net_capture_set_ring(capture_dev, enable, snaplen);
+	if (ret < 0) {
+		PR_WARNING("Capture %s failed (%d)\n", "ring", ret);
+		return -ENOEXEC;
+	}
+#else
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	PR_INFO("Set %s to enable %s support.\n",
+		"CONFIG_NET_CAPTURE", "network packet capture");
+#endif
+
+	return 0;
+}
+
 static int cmd_net_conn(const struct shell *shell, size_t argc, char *argv[])
 {
 	ARG_UNUSED(argc);
@@ -2074,6 +2206,13 @@ static int cmd_net_conn(const struct shell *shell, size_t argc, char *argv[])
 	/* Do not print anything if no fragments are pending atm */
 #endif
 
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+	count = 0;
+	user_data.user_data = &count;
+
+	net_ipv4_frag_foreach(ipv4_frag_cb, &user_data);
+#endif
+
 #else
 	PR_INFO("Set %s to enable %s support.\n",
 		"CONFIG_NET_OFFLOAD or CONFIG_NET_NATIVE",
@@ -2181,6 +2320,24 @@ static void print_dns_info(const struct shell *shell,
 			   remaining);
 		}
 	}
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	PR("Cached answers (hits %u misses %u):\n", ctx->cache_hits,
+	   ctx->cache_misses);
+
+	for (i = 0; i < CONFIG_DNS_RESOLVER_CACHE_SIZE; i++) {
+		int64_t remaining = ctx->cache[i].expires - k_uptime_get();
+
+		if (remaining <= 0) {
+			continue;
+		}
+
+		PR("\t%s: %s %d addresses remaining %u s\n",
+		   ctx->cache[i].query_type == DNS_QUERY_TYPE_A ?
+		   "IPv4" : "IPv6", ctx->cache[i].name, ctx->cache[i].count,
+		   (uint32_t)(remaining / MSEC_PER_SEC));
+	}
+#endif
 }
 #endif
 
@@ -2225,6 +2382,27 @@ static int cmd_net_dns_cancel(const struct shell *shell, size_t argc,
 	return 0;
 }
 
+static int cmd_net_dns_flush(const struct shell *shell, size_t argc,
+			     char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	if (net_mgmt(NET_REQUEST_DNS_CACHE_FLUSH, NULL, NULL, 0)) {
+		PR_WARNING("Cannot flush the DNS cache.\n");
+		return -ENOEXEC;
+	}
+
+	PR("DNS cache flushed.\n");
+#else
+	PR_INFO("Set %s to enable %s support.\n", "CONFIG_DNS_RESOLVER_CACHE",
+		"DNS cache");
+#endif
+
+	return 0;
+}
+
 static int cmd_net_dns_query(const struct shell *shell, size_t argc,
 			     char *argv[])
 {
@@ -3292,6 +3470,24 @@ static int cmd_net_gptp(const struct shell *shell, size_t argc, char *argv[])
 		PR("\tThe local clock has expired    : %s\n",
 		   domain->state.clk_slave_sync.rcvd_local_clk_tick ?
 							   "yes" : "no");
+#if defined(CONFIG_NET_GPTP_USE_DEFAULT_CLOCK_UPDATE)
+		PR("\tLast offset (ns)               : %d\n",
+		   domain->state.clk_slave_sync.servo.offset);
+		PR("\tMin / max offset (ns)          : %d / %d\n",
+		   domain->state.clk_slave_sync.servo.offset_min,
+		   domain->state.clk_slave_sync.servo.offset_max);
+		PR("\tAverage |offset| (ns)          : %d\n",
+		   (int)domain->state.clk_slave_sync.servo.offset_avg);
+		PR("\tOffset jitter (ns)             : %d\n",
+		   (int)domain->state.clk_slave_sync.servo.jitter);
+		PR("\tOffsets used / outliers        : %u / %u\n",
+		   domain->state.clk_slave_sync.servo.samples,
+		   domain->state.clk_slave_sync.servo.outliers);
+#if defined(CONFIG_NET_GPTP_PI_SERVO)
+		PR("\tFrequency correction (ppb)     : %d\n",
+		   (int)domain->state.clk_slave_sync.servo.applied);
+#endif
+#endif
 
 		PR("PortRoleSelection state machine variables:\n");
 		PR("\tCurrent state                  : %s\n",
@@ -3658,7 +3854,12 @@ static int cmd_net_mem(const struct shell *shell, size_t argc, char *argv[])
 
 	net_pkt_get_info(&rx, &tx, &rx_data, &tx_data);
 
+#if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
 	PR("Fragment length %d bytes\n", CONFIG_NET_BUF_DATA_SIZE);
+#else
+	PR("Data pool size %d bytes, smallest fragment %d bytes\n",
+	   CONFIG_NET_BUF_DATA_POOL_SIZE, CONFIG_NET_BUF_DATA_MIN_FRAG_SIZE);
+#endif
 
 	PR("Network buffer pools:\n");
 
@@ -3689,6 +3890,29 @@ static int cmd_net_mem(const struct shell *shell, size_t argc, char *argv[])
 		"CONFIG_NET_BUF_POOL_USAGE", "net_buf allocation");
 #endif /* CONFIG_NET_BUF_POOL_USAGE */
 
+#if defined(CONFIG_NET_PKT_BUF_STATS)
+	struct net_pkt_buf_stats stats[2];
+
+	net_pkt_get_buf_stats(&stats[0], &stats[1]);
+
+	/* The usage is the requested share of the memory taken by the
+	 * buffer data and the net_buf headers.
+	 */
+	PR("\nData allocations:\n");
+	PR("Allocs\tBufs\tSplit\tFailed\tUsage\n");
+
+	for (int i = 0; i < ARRAY_SIZE(stats); i++) {
+		uint64_t used = stats[i].allocated +
+			(uint64_t)stats[i].bufs * sizeof(struct net_buf);
+
+		PR("%u\t%u\t%u\t%u\t%u%%\t%s\n",
+		   stats[i].allocs, stats[i].bufs, stats[i].split,
+		   stats[i].failed,
+		   used ? (uint32_t)(stats[i].requested * 100U / used) : 0U,
+		   i == 0 ? "RX" : "TX");
+	}
+#endif /* CONFIG_NET_PKT_BUF_STATS */
+
 	if (IS_ENABLED(CONFIG_NET_CONTEXT_NET_PKT_POOL)) {
 		struct net_shell_user_data user_data;
 		struct ctx_info info;
@@ -5683,12 +5907,19 @@ SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_capture,
 		  cmd_net_capture_enable),
 	SHELL_CMD(disable, NULL, "Disable network packet capture.",
 		  cmd_net_capture_disable),
+	SHELL_CMD(ring, NULL, "Store the captured packets in a ring buffer "
+		  "and send them in batches.\n"
+		  "'net capture ring [<snap length>]' to use the ring buffer,\n"
+		  "'net capture ring off' to clone each packet again",
+		  cmd_net_capture_ring),
 	SHELL_SUBCMD_SET_END
 );
 
 SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_dns,
 	SHELL_CMD(cancel, NULL, "Cancel all pending requests.",
 		  cmd_net_dns_cancel),
+	SHELL_CMD(flush, NULL, "Forget all the cached answers.",
+		  cmd_net_dns_flush),
 	SHELL_CMD(query, NULL,
 		  "'net dns <hostname> [A or AAAA]' queries IPv4 address "
 		  "(default) or IPv6 address for a host name.",
@@ -29,6 +29,80 @@ LOG_MODULE_REGISTER(net_stats, NET_LOG_LEVEL);
  */
 struct net_stats net_stats = { 0 };
 
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+struct net_stats_cpu net_stats_cpu[CONFIG_MP_NUM_CPUS];
+
+/* Serializes the readers summing to the same statistics */
+static K_MUTEX_DEFINE(collect_lock);
+
+BUILD_ASSERT(sizeof(struct net_stats) % sizeof(net_stats_t) == 0,
+	     "The statistics are summed as an array of net_stats_t");
+
+/* Everything but the priorities of the traffic classes is a counter of
+ * type net_stats_t, or a time sum that is never updated when the
+ * statistics are kept per CPU. So the copies are summed word by word,
+ * and the priorities are fixed afterwards.
+ */
+static void stats_sum(struct net_stats *dst, const struct net_stats *src,
+		      size_t stride)
+{
+	net_stats_t *sum = (net_stats_t *)dst;
+	const struct net_stats *cpu_stats;
+	const net_stats_t *val;
+	int cpu, i;
+
+	memset(dst, 0, sizeof(*dst));
+
+	for (cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+		cpu_stats = (const struct net_stats *)((const uint8_t *)src +
+						       cpu * stride);
+		val = (const net_stats_t *)cpu_stats;
+
+		for (i = 0; i < sizeof(*dst) / sizeof(net_stats_t); i++) {
+			sum[i] += val[i];
+		}
+
+#if NET_TC_COUNT > 1
+		/* A CPU that has not sent or received anything in the
+		 * traffic class did not set the priority.
+		 */
+		for (i = 0; i < NET_TC_TX_STATS_COUNT; i++) {
+			dst->tc.sent[i].priority =
+				MAX(dst->tc.sent[i].priority,
+				    cpu_stats->tc.sent[i].priority);
+		}
+
+		for (i = 0; i < NET_TC_RX_STATS_COUNT; i++) {
+			dst->tc.recv[i].priority =
+				MAX(dst->tc.recv[i].priority,
+				    cpu_stats->tc.recv[i].priority);
+		}
+#endif
+	}
+}
+
+void net_stats_collect(struct net_if *iface)
+{
+	k_mutex_lock(&collect_lock, K_FOREVER);
+
+#if defined(CONFIG_NET_STATISTICS_PER_INTERFACE)
+	if (iface) {
+		stats_sum(&iface->stats, &iface->stats_cpu[0].stats,
+			  sizeof(iface->stats_cpu[0]));
+		goto out;
+	}
+#endif
+
+	stats_sum(&net_stats, &net_stats_cpu[0].stats,
+		  sizeof(net_stats_cpu[0]));
+
+#if defined(CONFIG_NET_STATISTICS_PER_INTERFACE)
+out:
+#endif
+	k_mutex_unlock(&collect_lock);
+}
+#endif /* CONFIG_NET_STATISTICS_PER_CPU */
+
 #if defined(CONFIG_NET_STATISTICS_PERIODIC_OUTPUT)
 
 #define PRINT_STATISTICS_INTERVAL (30 * MSEC_PER_SEC)
@@ -72,6 +146,8 @@ static inline void stats(struct net_if *iface)
 	int i;
 
 	if (!next_print || (abs(cmp) > PRINT_STATISTICS_INTERVAL)) {
+		net_stats_collect(iface);
+
 		if (iface) {
 			NET_INFO("Interface %p [%d]", iface,
 				 net_if_get_by_iface(iface));
@@ -240,6 +316,8 @@ static int net_stats_get(uint32_t mgmt_request, struct net_if *iface,
 	size_t len_chk = 0;
 	void *src = NULL;
 
+	net_stats_collect(iface);
+
 	switch (NET_MGMT_GET_COMMAND(mgmt_request)) {
 	case NET_REQUEST_STATS_CMD_GET_ALL:
 		len_chk = sizeof(struct net_stats);
@@ -302,6 +380,13 @@ static int net_stats_get(uint32_t mgmt_request, struct net_if *iface,
 		len_chk = sizeof(struct net_stats_pm);
 		src = GET_STAT_ADDR(iface, pm);
 		break;
+#endif
+#if defined(CONFIG_NET_PKT_RX_LATENCY)
+	case NET_REQUEST_STATS_CMD_GET_RX_LATENCY:
+		len_chk = sizeof(struct net_stats_rx_latency) *
+			NET_STATS_RX_STAGE_COUNT;
+		src = GET_STAT_ADDR(iface, rx_latency);
+		break;
 #endif
 	}
 
@@ -361,6 +446,11 @@ NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_STATS_GET_PM,
 				  net_stats_get);
 #endif
 
+#if defined(CONFIG_NET_PKT_RX_LATENCY)
+NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_STATS_GET_RX_LATENCY,
+				  net_stats_get);
+#endif
+
 #endif /* CONFIG_NET_STATISTICS_USER_API */
 
 void net_stats_reset(struct net_if *iface)
@@ -372,4 +462,8 @@ void net_stats_reset(struct net_if *iface)
 
 	net_if_stats_reset_all();
 	memset(&net_stats, 0, sizeof(net_stats));
+
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+	memset(net_stats_cpu, 0, sizeof(net_stats_cpu));
+#endif
 }
@@ -27,10 +27,42 @@ extern struct net_stats net_stats;
 #define GET_STAT_ADDR(iface, s) (&GET_STAT(iface, s))
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+extern struct net_stats_cpu net_stats_cpu[CONFIG_MP_NUM_CPUS];
+
+#if defined(CONFIG_NET_STATISTICS_PER_INTERFACE)
+#define SET_STAT_CPU(_iface, _cpu, _cmd) ((_iface)->stats_cpu[_cpu]._cmd)
+#else
+#define SET_STAT_CPU(_iface, _cpu, _cmd)
+#endif
+
+/* The counters of the current CPU are updated. Locking the interrupts of
+ * this CPU is enough to keep the thread from being preempted or migrated
+ * in the middle of the update, the other CPUs never write these counters.
+ */
+#define UPDATE_STAT(_iface, _cmd)					\
+	{								\
+		unsigned int _key = arch_irq_lock();			\
+		int _cpu = NET_STATS_CPU_ID();				\
+									\
+		NET_ASSERT(_iface);					\
+		(net_stats_cpu[_cpu]._cmd);				\
+		SET_STAT_CPU(_iface, _cpu, _cmd);			\
+		arch_irq_unlock(_key);					\
+	}
+
+/* Sum the counters of all the CPUs to the statistics of the interface,
+ * or to the global statistics if iface is NULL.
+ */
+void net_stats_collect(struct net_if *iface);
+#else
 #define UPDATE_STAT_GLOBAL(cmd) (net_##cmd)
 #define UPDATE_STAT(_iface, _cmd) \
 	{ NET_ASSERT(_iface); (UPDATE_STAT_GLOBAL(_cmd)); \
 	  SET_STAT(_iface->_cmd); }
+
+#define net_stats_collect(iface)
+#endif /* CONFIG_NET_STATISTICS_PER_CPU */
 /* Core stats */
 
 static inline void net_stats_update_processing_error(struct net_if *iface)
@@ -65,6 +97,7 @@ static inline void net_stats_update_bytes_sent(struct net_if *iface,
 #define net_stats_update_ip_errors_vhlerr(iface)
 #define net_stats_update_bytes_recv(iface, bytes)
 #define net_stats_update_bytes_sent(iface, bytes)
+#define net_stats_collect(iface)
 #endif /* CONFIG_NET_STATISTICS */
 
 #if defined(CONFIG_NET_STATISTICS_IPV6) && defined(CONFIG_NET_NATIVE_IPV6)
@@ -595,6 +628,17 @@ static inline void net_stats_update_tc_rx_time_detail(struct net_if *iface,
 #endif /* CONFIG_NET_PKT_RXTIME_STATS_DETAIL */
 #endif /* NET_TC_COUNT > 1 */
 
+#if defined(CONFIG_NET_PKT_RX_LATENCY)
+static inline void net_stats_update_rx_latency(struct net_if *iface,
+					       enum net_stats_rx_stage stage,
+					       uint32_t usec)
+{
+	int bucket = MIN(find_msb_set(usec), NET_STATS_RX_LATENCY_BUCKETS - 1);
+
+	UPDATE_STAT(iface, stats.rx_latency[stage].hist[bucket]++);
+}
+#endif /* CONFIG_NET_PKT_RX_LATENCY */
+
 #if defined(CONFIG_NET_STATISTICS_POWER_MANAGEMENT)	\
 	&& defined(CONFIG_NET_STATISTICS) && defined(CONFIG_NET_NATIVE)
 static inline void net_stats_add_suspend_start_time(struct net_if *iface,
@@ -9,27 +9,39 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 
 #include <zephyr.h>
 #include <string.h>
+#include <sys/fnv1a.h>
 
 #include <net/net_core.h>
 #include <net/net_pkt.h>
 #include <net/net_stats.h>
+#include <net/ethernet.h>
 
 #include "net_private.h"
 #include "net_stats.h"
 #include "net_tc_mapping.h"
+#include "ipv4.h"
 
 /* Template for thread name. The "xx" is either "TX" denoting transmit thread,
  * or "RX" denoting receive thread. The "q[y]" denotes the traffic class queue
  * where y indicates the traffic class id. The value of y can be from 0 to 7.
+ * With RX flow steering, the RX queue of flow z of the class is "q[y.z]".
  */
-#define MAX_NAME_LEN sizeof("xx_q[y]")
+#define MAX_NAME_LEN sizeof("xx_q[y.zz]")
+
+#if defined(CONFIG_NET_RX_FLOW_STEERING)
+#define NET_RX_FLOW_QUEUES CONFIG_NET_RX_FLOW_QUEUES
+#else
+#define NET_RX_FLOW_QUEUES 1
+#endif
+
+#define NET_RX_QUEUE_COUNT (NET_TC_RX_COUNT * NET_RX_FLOW_QUEUES)
 
 /* Stacks for TX work queue */
 K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, NET_TC_TX_COUNT,
 			    CONFIG_NET_TX_STACK_SIZE);
 
 /* Stacks for RX work queue */
-K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
+K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_RX_QUEUE_COUNT,
 			    CONFIG_NET_RX_STACK_SIZE);
 
 #if NET_TC_TX_COUNT > 0
@@ -37,7 +49,8 @@ static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 #endif
 
 #if NET_TC_RX_COUNT > 0
-static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+/* The flow queues of each class are next to each other */
+static struct net_traffic_class rx_classes[NET_RX_QUEUE_COUNT];
 #endif
 
 #if NET_TC_RX_COUNT > 0 || NET_TC_TX_COUNT > 0
@@ -45,6 +58,24 @@ static void submit_to_queue(struct k_fifo *queue, struct net_pkt *pkt)
 {
 	k_fifo_put(queue, pkt);
 }
+
+/* The packets are linked through their fifo word, which is what k_fifo
+ * expects of its items.
+ */
+static void batch_add(sys_slist_t *batch, struct net_pkt *pkt)
+{
+	sys_slist_append(batch, (sys_snode_t *)pkt);
+}
+
+static void submit_batch_to_queue(struct k_fifo *queue, sys_slist_t *batch)
+{
+	if (sys_slist_is_empty(batch)) {
+		return;
+	}
+
+	k_fifo_put_slist(queue, batch);
+	sys_slist_init(batch);
+}
 #endif
 
 bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt)
@@ -60,18 +91,193 @@ bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt)
 	return true;
 }
 
+void net_tc_submit_batch_to_tx_queue(struct net_pkt **pkts, size_t count)
+{
+#if NET_TC_TX_COUNT > 0
+	sys_slist_t batch;
+	int tc = -1;
+
+	sys_slist_init(&batch);
+
+	/* Consecutive packets of the same class are queued together */
+	for (size_t i = 0; i < count; i++) {
+		int pkt_tc = net_tx_priority2tc(net_pkt_priority(pkts[i]));
+
+		if (pkt_tc != tc && tc >= 0) {
+			submit_batch_to_queue(&tx_classes[tc].fifo, &batch);
+		}
+
+		tc = pkt_tc;
+		net_pkt_set_tx_stats_tick(pkts[i], k_cycle_get_32());
+		batch_add(&batch, pkts[i]);
+	}
+
+	if (tc >= 0) {
+		submit_batch_to_queue(&tx_classes[tc].fifo, &batch);
+	}
+#else
+	ARG_UNUSED(pkts);
+	ARG_UNUSED(count);
+#endif
+}
+
+#if defined(CONFIG_NET_RX_FLOW_STEERING)
+/* Hash the addresses, protocol and ports of the packet, as long as it is
+ * not an IP fragment, which only the first one would have ports for.
+ * Packets that are not IP are all hashed to 0.
+ */
+uint32_t net_tc_rx_flow_hash(struct net_pkt *pkt)
+{
+	union {
+		struct net_ipv4_hdr ipv4;
+		struct net_ipv6_hdr ipv6;
+	} ip;
+	struct net_pkt_cursor backup;
+	struct net_eth_hdr eth;
+	uint32_t hash = FNV1A_32_INIT;
+	uint16_t ports[2];
+	uint16_t type;
+	uint8_t proto;
+	bool overwrite;
+
+	if (net_pkt_rx_hash(pkt)) {
+		return net_pkt_rx_hash(pkt);
+	}
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(net_pkt_iface(pkt)) != &NET_L2_GET_NAME(ETHERNET)) {
+		return 0U;
+	}
+#else
+	return 0U;
+#endif
+
+	net_pkt_cursor_backup(pkt, &backup);
+	overwrite = net_pkt_is_being_overwritten(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_read(pkt, &eth, sizeof(eth))) {
+		hash = 0U;
+		goto out;
+	}
+
+	type = ntohs(eth.type);
+
+	if (type == NET_ETH_PTYPE_VLAN &&
+	    (net_pkt_skip(pkt, sizeof(uint16_t)) ||
+	     net_pkt_read_be16(pkt, &type))) {
+		hash = 0U;
+		goto out;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && type == NET_ETH_PTYPE_IP) {
+		if (net_pkt_read(pkt, &ip.ipv4, sizeof(ip.ipv4))) {
+			hash = 0U;
+			goto out;
+		}
+
+		proto = ip.ipv4.proto;
+		hash = fnv1a_32_update(hash, &ip.ipv4.src,
+				      2 * sizeof(struct in_addr));
+		hash = fnv1a_32_update(hash, &proto, sizeof(proto));
+
+		/* More fragments flag or fragment offset */
+		if ((sys_get_be16(ip.ipv4.offset) & 0x3fff) ||
+		    net_pkt_skip(pkt, (ip.ipv4.vhl & NET_IPV4_IHL_MASK) * 4U -
+				 sizeof(ip.ipv4))) {
+			goto out;
+		}
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   type == NET_ETH_PTYPE_IPV6) {
+		if (net_pkt_read(pkt, &ip.ipv6, sizeof(ip.ipv6))) {
+			hash = 0U;
+			goto out;
+		}
+
+		/* Behind extension headers, only the addresses are used */
+		proto = ip.ipv6.nexthdr;
+		hash = fnv1a_32_update(hash, &ip.ipv6.src,
+				      2 * sizeof(struct in6_addr));
+		hash = fnv1a_32_update(hash, &proto, sizeof(proto));
+	} else {
+		hash = 0U;
+		goto out;
+	}
+
+	if ((proto == IPPROTO_TCP || proto == IPPROTO_UDP) &&
+	    !net_pkt_read(pkt, ports, sizeof(ports))) {
+		hash = fnv1a_32_update(hash, ports, sizeof(ports));
+	}
+
+out:
+	net_pkt_cursor_restore(pkt, &backup);
+	net_pkt_set_overwrite(pkt, overwrite);
+
+	return hash;
+}
+#endif /* CONFIG_NET_RX_FLOW_STEERING */
+
+#if NET_TC_RX_COUNT > 0
+static int rx_queue_get(uint8_t tc, struct net_pkt *pkt)
+{
+	int queue = tc * NET_RX_FLOW_QUEUES;
+
+#if defined(CONFIG_NET_RX_FLOW_STEERING)
+	uint32_t hash = net_tc_rx_flow_hash(pkt);
+
+	queue += (hash ^ (hash >> 16)) % NET_RX_FLOW_QUEUES;
+#endif
+
+	return queue;
+}
+#endif
+
 void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 {
 #if NET_TC_RX_COUNT > 0
+	int queue = rx_queue_get(tc, pkt);
+
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
-	submit_to_queue(&rx_classes[tc].fifo, pkt);
+	submit_to_queue(&rx_classes[queue].fifo, pkt);
 #else
 	ARG_UNUSED(tc);
 	ARG_UNUSED(pkt);
 #endif
 }
 
+void net_tc_submit_batch_to_rx_queue(struct net_pkt **pkts, size_t count)
+{
+#if NET_TC_RX_COUNT > 0
+	sys_slist_t batch;
+	int queue = -1;
+
+	sys_slist_init(&batch);
+
+	/* Consecutive packets of the same queue are queued together */
+	for (size_t i = 0; i < count; i++) {
+		uint8_t tc = net_rx_priority2tc(net_pkt_priority(pkts[i]));
+		int pkt_queue = rx_queue_get(tc, pkts[i]);
+
+		if (pkt_queue != queue && queue >= 0) {
+			submit_batch_to_queue(&rx_classes[queue].fifo, &batch);
+		}
+
+		queue = pkt_queue;
+		net_pkt_set_rx_stats_tick(pkts[i], k_cycle_get_32());
+		batch_add(&batch, pkts[i]);
+	}
+
+	if (queue >= 0) {
+		submit_batch_to_queue(&rx_classes[queue].fifo, &batch);
+	}
+#else
+	ARG_UNUSED(pkts);
+	ARG_UNUSED(count);
+#endif
+}
+
 int net_tx_priority2tc(enum net_priority prio)
 {
 #if NET_TC_TX_COUNT > 0
@@ -343,12 +549,12 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+	for (i = 0; i < NET_RX_QUEUE_COUNT; i++) {
 		uint8_t thread_priority;
 		int priority;
 		k_tid_t tid;
 
-		thread_priority = rx_tc2thread(i);
+		thread_priority = rx_tc2thread(i / NET_RX_FLOW_QUEUES);
 
 		priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
 			K_PRIO_COOP(thread_priority) :
@@ -378,10 +584,24 @@ void net_tc_rx_init(void)
 		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
 			char name[MAX_NAME_LEN];
 
-			snprintk(name, sizeof(name), "rx_q[%d]", i);
+			if (NET_RX_FLOW_QUEUES > 1) {
+				snprintk(name, sizeof(name), "rx_q[%d.%d]",
+					 i / NET_RX_FLOW_QUEUES,
+					 i % NET_RX_FLOW_QUEUES);
+			} else {
+				snprintk(name, sizeof(name), "rx_q[%d]", i);
+			}
+
 			k_thread_name_set(tid, name);
 		}
 
+#if defined(CONFIG_NET_RX_FLOW_STEERING) && defined(CONFIG_SCHED_CPU_MASK)
+		/* Bind the flow queues of each class to the CPUs in turn */
+		k_thread_cpu_mask_clear(tid);
+		k_thread_cpu_mask_enable(tid, (i % NET_RX_FLOW_QUEUES) %
+					 CONFIG_MP_NUM_CPUS);
+#endif
+
 		k_thread_start(tid);
 	}
 #endif
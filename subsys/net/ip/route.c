@@ -257,6 +257,230 @@ static inline void update_route_access(struct net_route_entry *route)
 	sys_slist_prepend(&routes, &route->node);
 }
 
+#if defined(CONFIG_NET_ROUTE_TRIE)
+/* Path-compressed binary trie of the route prefixes. A node stands for
+ * the first len bits of prefix. It holds the routes of exactly that
+ * prefix, if any, and its children continue with bit len being 0 or 1.
+ * Nodes without routes only exist to branch, so there are at most two
+ * nodes per route.
+ */
+struct route_trie_node {
+	struct route_trie_node *child[2];
+	sys_slist_t routes;
+	struct in6_addr prefix;
+	uint8_t len;
+};
+
+static struct route_trie_node trie_nodes[2 * CONFIG_NET_MAX_ROUTES];
+static struct route_trie_node *trie_free;
+static struct route_trie_node *trie_root;
+
+static inline int trie_bit(const struct in6_addr *addr, uint8_t pos)
+{
+	return (addr->s6_addr[pos / 8U] >> (7U - (pos % 8U))) & 1U;
+}
+
+/* Length of the common prefix of a and b, up to max bits */
+static uint8_t trie_common_len(const struct in6_addr *a,
+			       const struct in6_addr *b, uint8_t max)
+{
+	uint8_t len = 0U;
+
+	for (int i = 0; i < sizeof(a->s6_addr) && len < max; i++) {
+		uint8_t diff = a->s6_addr[i] ^ b->s6_addr[i];
+
+		if (diff) {
+			while (!(diff & 0x80)) {
+				diff <<= 1;
+				len++;
+			}
+
+			break;
+		}
+
+		len += 8U;
+	}
+
+	return MIN(len, max);
+}
+
+static struct route_trie_node *trie_node_new(const struct in6_addr *prefix,
+					     uint8_t len)
+{
+	struct route_trie_node *node = trie_free;
+
+	NET_ASSERT(node, "route trie nodes exhausted");
+
+	trie_free = node->child[0];
+
+	node->child[0] = node->child[1] = NULL;
+	sys_slist_init(&node->routes);
+	net_ipaddr_copy(&node->prefix, prefix);
+	node->len = len;
+
+	return node;
+}
+
+static void trie_node_free(struct route_trie_node *node)
+{
+	node->child[0] = trie_free;
+	trie_free = node;
+}
+
+static void trie_insert(struct net_route_entry *route)
+{
+	struct route_trie_node **link = &trie_root;
+	struct route_trie_node *node, *parent;
+	uint8_t len = route->prefix_len;
+	uint8_t common = 0U;
+
+	while (*link) {
+		node = *link;
+		common = trie_common_len(&node->prefix, &route->addr,
+					 MIN(node->len, len));
+		if (common < node->len) {
+			break;
+		}
+
+		if (node->len == len) {
+			sys_slist_prepend(&node->routes, &route->trie_node);
+			return;
+		}
+
+		link = &node->child[trie_bit(&route->addr, node->len)];
+	}
+
+	node = *link;
+
+	if (!node) {
+		parent = trie_node_new(&route->addr, len);
+	} else if (common == len) {
+		/* The route is a prefix of the node, which moves below */
+		parent = trie_node_new(&route->addr, len);
+		parent->child[trie_bit(&node->prefix, len)] = node;
+	} else {
+		/* They differ at bit common, branch there */
+		struct route_trie_node *leaf;
+
+		leaf = trie_node_new(&route->addr, len);
+		sys_slist_prepend(&leaf->routes, &route->trie_node);
+
+		parent = trie_node_new(&route->addr, common);
+		parent->child[trie_bit(&route->addr, common)] = leaf;
+		parent->child[trie_bit(&node->prefix, common)] = node;
+		*link = parent;
+
+		return;
+	}
+
+	sys_slist_prepend(&parent->routes, &route->trie_node);
+	*link = parent;
+}
+
+static void trie_remove(struct net_route_entry *route)
+{
+	struct route_trie_node **link = &trie_root, **parent_link = NULL;
+	struct route_trie_node *node, *child;
+	uint8_t len = route->prefix_len;
+
+	while ((node = *link) != NULL && node->len < len) {
+		parent_link = link;
+		link = &node->child[trie_bit(&route->addr, node->len)];
+	}
+
+	if (!node || node->len != len ||
+	    !sys_slist_find_and_remove(&node->routes, &route->trie_node) ||
+	    !sys_slist_is_empty(&node->routes)) {
+		return;
+	}
+
+	/* Nodes without routes must branch, drop this one and then
+	 * possibly its parent if either is left with a single child
+	 */
+	if (node->child[0] && node->child[1]) {
+		return;
+	}
+
+	*link = node->child[0] ? node->child[0] : node->child[1];
+	trie_node_free(node);
+
+	if (*link || !parent_link) {
+		return;
+	}
+
+	node = *parent_link;
+	if (!sys_slist_is_empty(&node->routes)) {
+		return;
+	}
+
+	child = node->child[0] ? node->child[0] : node->child[1];
+	*parent_link = child;
+	trie_node_free(node);
+}
+
+static struct net_route_entry *trie_lookup(struct net_if *iface,
+					   struct in6_addr *dst)
+{
+	struct route_trie_node *node = trie_root;
+	struct net_route_entry *found = NULL;
+
+	while (node && net_ipv6_is_prefix(dst->s6_addr, node->prefix.s6_addr,
+					  node->len)) {
+		struct net_route_entry *route;
+
+		SYS_SLIST_FOR_EACH_CONTAINER(&node->routes, route, trie_node) {
+			if (!iface || route->iface == iface) {
+				found = route;
+				break;
+			}
+		}
+
+		if (node->len == 128U) {
+			break;
+		}
+
+		node = node->child[trie_bit(dst, node->len)];
+	}
+
+	return found;
+}
+
+static void trie_init(void)
+{
+	trie_root = NULL;
+	trie_free = NULL;
+
+	for (int i = 0; i < ARRAY_SIZE(trie_nodes); i++) {
+		trie_node_free(&trie_nodes[i]);
+	}
+}
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found = trie_lookup(iface, dst);
+
+	if (found) {
+		net_route_info("Found", found, dst);
+
+		update_route_access(found);
+	}
+
+	return found;
+}
+#else
+static inline void trie_insert(struct net_route_entry *route)
+{
+}
+
+static inline void trie_remove(struct net_route_entry *route)
+{
+}
+
+static inline void trie_init(void)
+{
+}
+
 struct net_route_entry *net_route_lookup(struct net_if *iface,
 					 struct in6_addr *dst)
 {
@@ -294,6 +518,7 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 
 	return found;
 }
+#endif /* CONFIG_NET_ROUTE_TRIE */
 
 struct net_route_entry *net_route_add(struct net_if *iface,
 				      struct in6_addr *addr,
@@ -412,6 +637,8 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	sys_slist_init(&route->nexthop);
 	sys_slist_prepend(&route->nexthop, &nexthop_route->node);
 
+	trie_insert(route);
+
 	net_route_info("Added", route, addr);
 
 #if defined(CONFIG_NET_MGMT_EVENT_INFO)
@@ -461,6 +688,8 @@ int net_route_del(struct net_route_entry *route)
 		return -ENOENT;
 	}
 
+	trie_remove(route);
+
 	net_route_info("Deleted", route, &route->addr);
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&route->nexthop, nexthop_route, node) {
@@ -915,4 +1144,6 @@ void net_route_init(void)
 
 	NET_DBG("Allocated %d nexthop entries (%zu bytes)",
 		CONFIG_NET_MAX_NEXTHOPS, sizeof(net_route_nexthop_pool));
+
+	trie_init();
 }
@@ -57,6 +57,11 @@ struct net_route_entry {
 	/** IPv6 address/prefix of the route. */
 	struct in6_addr addr;
 
+#if defined(CONFIG_NET_ROUTE_TRIE)
+	/** Node in the list of routes of the same prefix in the trie */
+	sys_snode_t trie_node;
+#endif
+
 	/** IPv6 address/prefix length. */
 	uint8_t prefix_len;
 };
@@ -33,7 +33,8 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 
 static int tcp_rto = CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
 static int tcp_retries = CONFIG_NET_TCP_RETRY_COUNT;
-static int tcp_window = NET_IPV6_MTU;
+static int tcp_window = CONFIG_NET_TCP_MAX_RECV_WINDOW_SIZE ?
+			 CONFIG_NET_TCP_MAX_RECV_WINDOW_SIZE : NET_IPV6_MTU;
 
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
@@ -613,9 +614,9 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
-
+	/* MSS, window scale and SACK-permitted are only valid in SYN
+	 * segments, what was found there stays for the connection
+	 */
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
 
@@ -658,9 +659,37 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
+			recv_options->window = options[2];
 			recv_options->wnd_found = true;
 			break;
+		case TCPOPT_SACK_PERM:
+			if (opt_len != 2) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = true;
+			break;
+#if defined(CONFIG_NET_TCP_SACK)
+		case TCPOPT_SACK:
+			if ((opt_len - 2) % 8 != 0) {
+				result = false;
+				goto end;
+			}
+
+			for (int i = 2; i < opt_len &&
+			     recv_options->sack_count < TCP_SACK_MAX_BLOCKS;
+			     i += 8) {
+				struct tcp_sack_block *block = &recv_options->sack[
+					recv_options->sack_count++];
+
+				block->start = ntohl(UNALIGNED_GET(
+					(uint32_t *)(options + i)));
+				block->end = ntohl(UNALIGNED_GET(
+					(uint32_t *)(options + i + 4)));
+			}
+			break;
+#endif
 		default:
 			continue;
 		}
@@ -682,18 +711,49 @@ static size_t tcp_check_pending_data(struct tcp *conn, struct net_pkt *pkt,
 	    !net_pkt_is_empty(conn->queue_recv_data)) {
 		struct tcphdr *th = th_get(pkt);
 		uint32_t expected_seq = th_seq(th) + len;
+		struct net_buf *head, *last;
 		uint32_t pending_seq;
 
-		pending_seq = tcp_get_seq(conn->queue_recv_data->buffer);
-		if (pending_seq == expected_seq) {
-			pending_len = net_pkt_get_len(conn->queue_recv_data);
+		/* Drop what this segment already covers, as the peer may
+		 * have resent several segments as one
+		 */
+		head = conn->queue_recv_data->buffer;
+		while (head && net_tcp_seq_cmp(tcp_get_seq(head) + head->len,
+					       expected_seq) <= 0) {
+			conn->queue_recv_data->buffer = head->frags;
+			head->frags = NULL;
+			net_buf_unref(head);
+			head = conn->queue_recv_data->buffer;
+		}
+
+		if (head && net_tcp_seq_cmp(tcp_get_seq(head),
+					    expected_seq) < 0) {
+			net_buf_pull(head, expected_seq - tcp_get_seq(head));
+			tcp_set_seq(head, expected_seq);
+		}
+
+		pending_seq = head ? tcp_get_seq(head) : 0;
+		if (head && pending_seq == expected_seq) {
+			/* Take the data up to the first hole */
+			last = head;
+			pending_len = last->len;
+
+			while (last->frags &&
+			       tcp_get_seq(last->frags) ==
+			       tcp_get_seq(last) + last->len) {
+				last = last->frags;
+				pending_len += last->len;
+			}
+
+			conn->queue_recv_data->buffer = last->frags;
+			last->frags = NULL;
 
 			NET_DBG("Found pending data seq %u len %zd",
 				pending_seq, pending_len);
-			net_buf_frag_add(pkt->buffer,
-					 conn->queue_recv_data->buffer);
-			conn->queue_recv_data->buffer = NULL;
+			net_buf_frag_add(pkt->buffer, head);
+		}
 
+		if (net_pkt_is_empty(conn->queue_recv_data)) {
 			k_work_cancel_delayable(&conn->recv_queue_timer);
 		}
 	}
@@ -755,11 +815,137 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+/* Find the run of contiguous data starting at buf in the receive queue,
+ * returning the buffer following it
+ */
+static struct net_buf *tcp_queue_run(struct net_buf *buf,
+				     struct tcp_sack_block *run)
+{
+	run->start = tcp_get_seq(buf);
+	run->end = run->start;
+
+	while (buf && tcp_get_seq(buf) == run->end) {
+		run->end += buf->len;
+		buf = buf->frags;
+	}
+
+	return buf;
+}
+
+/* Describe the data held in the receive queue, the block with the most
+ * recently received segment first as required by RFC 2018
+ */
+static int tcp_sack_blocks_get(struct tcp *conn,
+			       struct tcp_sack_block *blocks)
+{
+	struct tcp_sack_block run;
+	struct net_buf *buf;
+	bool recent_found = false;
+	int count = 1;
+
+	if (!CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT ||
+	    net_pkt_is_empty(conn->queue_recv_data)) {
+		return 0;
+	}
+
+	buf = conn->queue_recv_data->buffer;
+	while (buf) {
+		buf = tcp_queue_run(buf, &run);
+
+		if (!recent_found &&
+		    net_tcp_seq_cmp(conn->sack_recent, run.start) >= 0 &&
+		    net_tcp_seq_cmp(conn->sack_recent, run.end) < 0) {
+			blocks[0] = run;
+			recent_found = true;
+		} else if (count < TCP_SACK_MAX_BLOCKS) {
+			blocks[count++] = run;
+		}
+	}
+
+	if (!recent_found) {
+		count--;
+		memmove(&blocks[0], &blocks[1], count * sizeof(blocks[0]));
+	}
+
+	return count;
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+/* Build the options of a segment with the given flags in buf, which must
+ * hold the 40 bytes allowed, and return their length
+ */
+static size_t tcp_options_build(struct tcp *conn, uint8_t flags, uint8_t *buf)
+{
+	size_t len = 0;
+
+	if (flags & SYN) {
+		/* A SYN offers everything, a SYN-ACK only what was agreed */
+		bool offer = !(flags & ACK);
+
+		if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) &&
+		    (offer || conn->wscale_ok)) {
+			buf[len++] = TCPOPT_NOP;
+			buf[len++] = TCPOPT_WINDOW;
+			buf[len++] = 3;
+			buf[len++] = conn->rcv_wscale;
+		}
+
+		if (IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+		    (offer || conn->sack_ok)) {
+			buf[len++] = TCPOPT_NOP;
+			buf[len++] = TCPOPT_NOP;
+			buf[len++] = TCPOPT_SACK_PERM;
+			buf[len++] = 2;
+		}
+
+		return len;
+	}
+
+#if defined(CONFIG_NET_TCP_SACK)
+	if ((flags & ACK) && conn->sack_ok) {
+		struct tcp_sack_block blocks[TCP_SACK_MAX_BLOCKS];
+		int count = tcp_sack_blocks_get(conn, blocks);
+
+		if (count > 0) {
+			buf[len++] = TCPOPT_NOP;
+			buf[len++] = TCPOPT_NOP;
+			buf[len++] = TCPOPT_SACK;
+			buf[len++] = 2 + count * 8;
+
+			for (int i = 0; i < count; i++) {
+				UNALIGNED_PUT(htonl(blocks[i].start),
+					      (uint32_t *)(buf + len));
+				UNALIGNED_PUT(htonl(blocks[i].end),
+					      (uint32_t *)(buf + len + 4));
+				len += 8;
+			}
+		}
+	}
+#endif
+
+	return len;
+}
+
+/* Window to advertise, which is never scaled in SYN segments */
+static uint16_t tcp_win_get(struct tcp *conn, uint8_t flags)
+{
+	uint32_t win = conn->recv_win;
+
+	if (conn->wscale_ok && !(flags & SYN)) {
+		win >>= conn->rcv_wscale;
+	}
+
+	return MIN(win, UINT16_MAX);
+}
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, const uint8_t *options,
+			  size_t options_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
+	int ret;
 
 	th = (struct tcphdr *)net_pkt_get_data(pkt, &tcp_access);
 	if (!th) {
@@ -770,16 +956,21 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, &th->th_sport);
 	UNALIGNED_PUT(conn->dst.sin.sin_port, &th->th_dport);
-	th->th_off = 5;
+	th->th_off = 5 + options_len / 4;
 	UNALIGNED_PUT(flags, &th->th_flags);
-	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
+	UNALIGNED_PUT(htons(tcp_win_get(conn, flags)), &th->th_win);
 	UNALIGNED_PUT(htonl(seq), &th->th_seq);
 
 	if (ACK & flags) {
 		UNALIGNED_PUT(htonl(conn->ack), &th->th_ack);
 	}
 
-	return net_pkt_set_data(pkt, &tcp_access);
+	ret = net_pkt_set_data(pkt, &tcp_access);
+	if (ret == 0 && options_len) {
+		ret = net_pkt_write(pkt, options, options_len);
+	}
+
+	return ret;
 }
 
 static int ip_header_add(struct tcp *conn, struct net_pkt *pkt)
@@ -802,16 +993,23 @@ static int ip_header_add(struct tcp *conn, struct net_pkt *pkt)
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
+	uint8_t options[40]; /* TCP header max options size is 40 */
+	size_t options_len = tcp_options_build(conn, flags, options);
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	pkt = tcp_pkt_alloc(conn, sizeof(struct tcphdr));
+	pkt = tcp_pkt_alloc(conn, sizeof(struct tcphdr) + options_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
 		goto out;
 	}
 
 	if (data) {
+		/* Data beyond the MSS is for the device to segment */
+		if (net_pkt_get_len(data) > conn_mss(conn)) {
+			net_pkt_set_tso_mss(pkt, conn_mss(conn));
+		}
+
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
@@ -823,7 +1021,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, options, options_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
@@ -888,9 +1086,133 @@ static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
 	return net_pkt_copy(to, from, len);
 }
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+/* Start with the initial window of RFC 5681 */
+static void tcp_cc_init(struct tcp *conn)
+{
+	uint32_t mss = conn_mss(conn);
+
+	conn->cwnd = MIN(4U * mss, MAX(2U * mss, 4380U));
+	conn->ssthresh = UINT32_MAX;
+	conn->cc_bytes_acked = 0U;
+
+	if (conn->cc->init) {
+		conn->cc->init(conn);
+	}
+}
+
+static uint32_t tcp_cc_window(struct tcp *conn)
+{
+	return MIN(conn->send_win, conn->cwnd);
+}
+
+static void tcp_cc_ack(struct tcp *conn, uint32_t acked)
+{
+	/* Do not grow a window which is not used */
+	if (conn->cwnd >= conn->send_win) {
+		return;
+	}
+
+	if (conn->cwnd < conn->ssthresh) {
+		/* Slow start, at most one segment per ACK */
+		conn->cwnd += MIN(acked, conn_mss(conn));
+		return;
+	}
+
+	conn->cc->cong_avoid(conn, acked);
+}
+
+static void tcp_cc_loss(struct tcp *conn)
+{
+	conn->ssthresh = conn->cc->ssthresh(conn);
+	conn->cwnd = conn->ssthresh;
+	conn->cc_bytes_acked = 0U;
+
+	/* NewReno accounts for the three segments which left the network */
+	if (!conn->sack_ok) {
+		conn->cwnd += 3U * conn_mss(conn);
+	}
+}
+
+/* Inflate the window for each segment which left the network during
+ * NewReno fast recovery
+ */
+static void tcp_cc_dup_ack(struct tcp *conn)
+{
+	conn->cwnd += conn_mss(conn);
+}
+
+/* Deflate the window by what a partial ACK acknowledged (RFC 6582) */
+static void tcp_cc_partial_ack(struct tcp *conn, uint32_t acked)
+{
+	uint32_t mss = conn_mss(conn);
+
+	if (conn->sack_ok) {
+		return;
+	}
+
+	conn->cwnd = (conn->cwnd > acked) ? conn->cwnd - acked : 0U;
+	if (acked >= mss) {
+		conn->cwnd += mss;
+	}
+	conn->cwnd = MAX(conn->cwnd, mss);
+}
+
+static void tcp_cc_recovered(struct tcp *conn)
+{
+	conn->cwnd = MAX(MIN(conn->ssthresh, conn->cwnd), conn_mss(conn));
+}
+
+/* Back to slow start from one segment. Repeated timeouts of the same
+ * data keep the slow start threshold of the first one.
+ */
+static void tcp_cc_timeout(struct tcp *conn)
+{
+	if (conn->send_data_retries == 0U) {
+		conn->ssthresh = conn->cc->ssthresh(conn);
+	}
+
+	conn->cwnd = conn_mss(conn);
+	conn->cc_bytes_acked = 0U;
+}
+#else
+static inline void tcp_cc_init(struct tcp *conn)
+{
+}
+
+static inline uint32_t tcp_cc_window(struct tcp *conn)
+{
+	return conn->send_win;
+}
+
+static inline void tcp_cc_ack(struct tcp *conn, uint32_t acked)
+{
+}
+
+static inline void tcp_cc_loss(struct tcp *conn)
+{
+}
+
+static inline void tcp_cc_dup_ack(struct tcp *conn)
+{
+}
+
+static inline void tcp_cc_partial_ack(struct tcp *conn, uint32_t acked)
+{
+}
+
+static inline void tcp_cc_recovered(struct tcp *conn)
+{
+}
+
+static inline void tcp_cc_timeout(struct tcp *conn)
+{
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
+
 static bool tcp_window_full(struct tcp *conn)
 {
-	bool window_full = !(conn->unacked_len < conn->send_win);
+	bool window_full = !(conn->unacked_len < tcp_cc_window(conn));
 
 	NET_DBG("conn: %p window_full=%hu", conn, window_full);
 
@@ -915,42 +1237,98 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
-static int tcp_send_data(struct tcp *conn)
+/* Most data to put in a new segment: more than the MSS if the network
+ * device splits segments itself
+ */
+static int tcp_seg_max(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_TSO)
+	if (conn->iface && net_if_supports_tx_tso(conn->iface)) {
+		return MAX(CONFIG_NET_TCP_TSO_MAX_SIZE, conn_mss(conn));
+	}
+#endif
+
+	return conn_mss(conn);
+}
+
+#if defined(CONFIG_NET_TCP_TSO)
+/* Add up to len more bytes of send_data from pos to pkt, an MSS at a
+ * time as packet allocation is limited to the MTU, returning how many
+ * buffers could be found for
+ */
+static int tcp_tso_data_add(struct tcp *conn, struct net_pkt *pkt, int pos,
+			    int len)
+{
+	int added = 0;
+
+	while (added < len) {
+		int chunk = MIN(len - added, conn_mss(conn));
+		struct net_pkt *more = tcp_pkt_alloc(conn, chunk);
+
+		if (!more) {
+			break;
+		}
+
+		if (tcp_pkt_peek(more, conn->send_data, pos + added,
+				 chunk) < 0) {
+			tcp_pkt_unref(more);
+			break;
+		}
+
+		net_pkt_append_buffer(pkt, more->buffer);
+		more->buffer = NULL;
+		tcp_pkt_unref(more);
+		added += chunk;
+	}
+
+	return added;
+}
+#endif /* CONFIG_NET_TCP_TSO */
+
+/* Send len bytes of send_data starting at pos, i.e. at conn->seq + pos,
+ * returning how many were sent. This is less than len only if a segment
+ * for the device to split runs out of buffers.
+ */
+static int tcp_send_segment(struct tcp *conn, int pos, int len, bool resend)
 {
 	int ret = 0;
-	int pos, len;
 	struct net_pkt *pkt;
+	int first = MIN(len, conn_mss(conn));
 
-	pos = conn->unacked_len;
-	len = MIN3(conn->send_data_total - conn->unacked_len,
-		   conn->send_win - conn->unacked_len,
-		   conn_mss(conn));
-
-	pkt = tcp_pkt_alloc(conn, len);
+	pkt = tcp_pkt_alloc(conn, first);
 	if (!pkt) {
 		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
 		ret = -ENOBUFS;
 		goto out;
 	}
 
-	ret = tcp_pkt_peek(pkt, conn->send_data, pos, len);
+	ret = tcp_pkt_peek(pkt, conn->send_data, pos, first);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		ret = -ENOBUFS;
 		goto out;
 	}
 
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
-	if (ret == 0) {
-		conn->unacked_len += len;
+#if defined(CONFIG_NET_TCP_TSO)
+	if (len > first) {
+		len = first + tcp_tso_data_add(conn, pkt, pos + first,
+					       len - first);
+	}
+#else
+	len = first;
+#endif
 
-		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + pos);
+	if (ret == 0) {
+		if (resend) {
 			net_stats_update_tcp_resent(conn->iface, len);
 			net_stats_update_tcp_seg_rexmit(conn->iface);
 		} else {
 			net_stats_update_tcp_sent(conn->iface, len);
 			net_stats_update_tcp_seg_sent(conn->iface);
 		}
+
+		ret = len;
 	}
 
 	/* The data we want to send, has been moved to the send queue so we
@@ -959,9 +1337,31 @@ static int tcp_send_data(struct tcp *conn)
 	 */
 	tcp_pkt_unref(pkt);
 
+ out:
+	return ret;
+}
+
+static int tcp_send_data(struct tcp *conn)
+{
+	bool resend = conn->data_mode == TCP_DATA_MODE_RESEND;
+	int ret;
+	int len;
+
+	/* Retransmissions stay one MSS long, a lost segment for the device
+	 * to split should not be resent in one piece again
+	 */
+	len = MIN3(conn->send_data_total - conn->unacked_len,
+		   tcp_cc_window(conn) - conn->unacked_len,
+		   resend ? conn_mss(conn) : tcp_seg_max(conn));
+
+	ret = tcp_send_segment(conn, conn->unacked_len, len, resend);
+	if (ret >= 0) {
+		conn->unacked_len += ret;
+		ret = 0;
+	}
+
 	conn_send_data_dump(conn);
 
- out:
 	return ret;
 }
 
@@ -1014,6 +1414,245 @@ static int tcp_send_queued_data(struct tcp *conn)
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+static void tcp_sack_remove(struct tcp *conn, int i)
+{
+	conn->sacked_count--;
+	memmove(&conn->sacked[i], &conn->sacked[i + 1],
+		(conn->sacked_count - i) * sizeof(conn->sacked[0]));
+}
+
+/* Add a block reported by the peer to the scoreboard, which is kept
+ * sorted and merged. Only data sent but not acknowledged yet counts.
+ */
+static void tcp_sack_mark(struct tcp *conn, uint32_t ack,
+			  const struct tcp_sack_block *block)
+{
+	struct tcp_sack_block *sb = conn->sacked;
+	uint32_t high = conn->seq + conn->unacked_len;
+	uint32_t start = block->start;
+	uint32_t end = block->end;
+	int i;
+
+	if (net_tcp_seq_cmp(start, ack) < 0) {
+		start = ack;
+	}
+
+	if (net_tcp_seq_cmp(end, high) > 0) {
+		end = high;
+	}
+
+	if (net_tcp_seq_cmp(start, end) >= 0) {
+		return;
+	}
+
+	/* Absorb the blocks this one overlaps or touches */
+	for (i = 0; i < conn->sacked_count; ) {
+		if (net_tcp_seq_cmp(sb[i].end, start) < 0 ||
+		    net_tcp_seq_cmp(sb[i].start, end) > 0) {
+			i++;
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(sb[i].start, start) < 0) {
+			start = sb[i].start;
+		}
+
+		if (net_tcp_seq_cmp(sb[i].end, end) > 0) {
+			end = sb[i].end;
+		}
+
+		tcp_sack_remove(conn, i);
+	}
+
+	i = 0;
+	while (i < conn->sacked_count &&
+	       net_tcp_seq_cmp(sb[i].start, start) < 0) {
+		i++;
+	}
+
+	/* When full, forgetting the highest block only means that recovery
+	 * may resend data the peer already has
+	 */
+	if (conn->sacked_count == TCP_SACK_MAX_BLOCKS) {
+		if (i == TCP_SACK_MAX_BLOCKS) {
+			return;
+		}
+
+		conn->sacked_count--;
+	}
+
+	memmove(&sb[i + 1], &sb[i], (conn->sacked_count - i) * sizeof(sb[0]));
+	sb[i].start = start;
+	sb[i].end = end;
+	conn->sacked_count++;
+}
+
+static void tcp_sack_prune(struct tcp *conn, uint32_t ack)
+{
+	while (conn->sacked_count > 0 &&
+	       net_tcp_seq_cmp(conn->sacked[0].end, ack) <= 0) {
+		tcp_sack_remove(conn, 0);
+	}
+
+	if (conn->sacked_count > 0 &&
+	    net_tcp_seq_cmp(conn->sacked[0].start, ack) < 0) {
+		conn->sacked[0].start = ack;
+	}
+}
+
+/* Resend one segment from the next hole below the highest data the peer
+ * has reported holding
+ */
+static void tcp_sack_retransmit(struct tcp *conn, uint32_t ack)
+{
+	struct tcp_sack_block *sb = conn->sacked;
+	uint32_t next = conn->rexmit_next;
+	int i, len;
+
+	if (net_tcp_seq_cmp(next, ack) < 0) {
+		next = ack;
+	}
+
+	for (i = 0; i < conn->sacked_count; i++) {
+		if (net_tcp_seq_cmp(next, sb[i].start) < 0) {
+			break;
+		}
+
+		if (net_tcp_seq_cmp(next, sb[i].end) < 0) {
+			next = sb[i].end;
+		}
+	}
+
+	if (i == conn->sacked_count) {
+		return;
+	}
+
+	len = MIN(sb[i].start - next, conn_mss(conn));
+
+	NET_DBG("conn: %p resending hole seq %u len %d", conn, next, len);
+
+	/* send_data still starts at conn->seq, even if ack is past it */
+	len = tcp_send_segment(conn, next - conn->seq, len, true);
+	if (len >= 0) {
+		conn->rexmit_next = next + len;
+	}
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+/* Resend the next hole reported with SACK or, without it, the first
+ * segment not acknowledged by ack
+ */
+static void tcp_recovery_retransmit(struct tcp *conn, uint32_t ack)
+{
+	uint32_t end = conn->seq + conn->unacked_len;
+	int len;
+
+#if defined(CONFIG_NET_TCP_SACK)
+	if (conn->sack_ok) {
+		tcp_sack_retransmit(conn, ack);
+		return;
+	}
+#endif
+
+	if (net_tcp_seq_cmp(ack, end) >= 0) {
+		return;
+	}
+
+	len = MIN(end - ack, conn_mss(conn));
+
+	NET_DBG("conn: %p resending seq %u len %d", conn, ack, len);
+
+	/* send_data still starts at conn->seq, even if ack is past it */
+	(void)tcp_send_segment(conn, ack - conn->seq, len, true);
+}
+
+/* Update the congestion state from an incoming ACK, and start or continue
+ * loss recovery on duplicate and partial ACKs: NewReno (RFC 6582), or
+ * RFC 6675 if SACK is used. This is called before conn->seq is moved to
+ * the acknowledged data.
+ */
+static void tcp_ack_received(struct tcp *conn, struct tcphdr *th, size_t len)
+{
+	uint32_t ack = th_ack(th);
+
+	/* After a retransmission timeout everything is resent anyway */
+	if (conn->data_mode == TCP_DATA_MODE_RESEND) {
+		return;
+	}
+
+#if defined(CONFIG_NET_TCP_SACK)
+	if (conn->sack_ok) {
+		for (int i = 0; i < conn->recv_options.sack_count; i++) {
+			tcp_sack_mark(conn, ack, &conn->recv_options.sack[i]);
+		}
+
+		tcp_sack_prune(conn, ack);
+	}
+#endif
+
+	if (net_tcp_seq_cmp(ack, conn->seq) > 0) {
+		conn->dup_acks = 0U;
+
+		if (!conn->in_recovery) {
+			tcp_cc_ack(conn, ack - conn->seq);
+			return;
+		}
+
+		if (net_tcp_seq_cmp(ack, conn->recovery_point) >= 0) {
+			conn->in_recovery = false;
+			tcp_cc_recovered(conn);
+			return;
+		}
+
+		/* Partial ACK: the next hole was lost too */
+		tcp_cc_partial_ack(conn, ack - conn->seq);
+		tcp_recovery_retransmit(conn, ack);
+		return;
+	}
+
+	if (ack != conn->seq || len > 0 || conn->unacked_len == 0) {
+		return;
+	}
+
+#if defined(CONFIG_NET_TCP_SACK)
+	/* With SACK, only count what reports more data arriving */
+	if (conn->sack_ok && conn->recv_options.sack_count == 0U) {
+		return;
+	}
+#endif
+
+	if (conn->in_recovery) {
+		if (conn->sack_ok) {
+			tcp_recovery_retransmit(conn, ack);
+		} else {
+			tcp_cc_dup_ack(conn);
+			(void)tcp_send_queued_data(conn);
+		}
+
+		return;
+	}
+
+	/* Without SACK, the window reduction is what makes it safe to
+	 * retransmit early
+	 */
+	if (++conn->dup_acks < TCP_DUPACK_THRESHOLD ||
+	    (!conn->sack_ok &&
+	     !IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CONTROL))) {
+		return;
+	}
+
+	NET_DBG("conn: %p entering fast recovery", conn);
+
+	conn->in_recovery = true;
+	conn->recovery_point = conn->seq + conn->unacked_len;
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->rexmit_next = conn->seq;
+#endif
+	tcp_cc_loss(conn);
+	tcp_recovery_retransmit(conn, ack);
+}
+
 static void tcp_cleanup_recv_queue(struct k_work *work)
 {
 	struct tcp *conn = CONTAINER_OF(work, struct tcp, recv_queue_timer);
@@ -1046,8 +1685,15 @@ static void tcp_resend_data(struct k_work *work)
 		goto out;
 	}
 
+	tcp_cc_timeout(conn);
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
+	conn->dup_acks = 0U;
+	conn->in_recovery = false;
+#if defined(CONFIG_NET_TCP_SACK)
+	/* The peer may have dropped data it reported holding */
+	conn->sacked_count = 0U;
+#endif
 
 	ret = tcp_send_data(conn);
 	if (ret == 0) {
@@ -1159,6 +1805,19 @@ static struct tcp *tcp_conn_alloc(void)
 	conn->in_connect = false;
 	conn->state = TCP_LISTEN;
 	conn->recv_win = tcp_window;
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	conn->cc = tcp_cc_default();
+#endif
+
+	/* Smallest shift that lets the window be advertised, should the
+	 * peer agree to window scaling
+	 */
+	if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE)) {
+		while (conn->rcv_wscale < TCP_WSCALE_MAX &&
+		       (conn->recv_win >> conn->rcv_wscale) > UINT16_MAX) {
+			conn->rcv_wscale++;
+		}
+	}
 
 	/* The ISN value will be set when we get the connection attempt or
 	 * when trying to create a connection.
@@ -1281,6 +1940,9 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 		net_ipaddr_copy(&conn_old->context->remote, &conn->dst.sa);
 
 		conn->accepted_conn = conn_old;
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+		conn->cc = conn_old->cc;
+#endif
 	}
  in:
 	if (conn) {
@@ -1514,6 +2176,7 @@ static void tcp_queue_recv_data(struct tcp *conn, struct net_pkt *pkt,
 				size_t len, uint32_t seq)
 {
 	uint32_t seq_start = seq;
+	struct net_buf *prev = NULL, *next;
 	bool inserted = false;
 	struct net_buf *tmp;
 
@@ -1536,49 +2199,44 @@ static void tcp_queue_recv_data(struct tcp *conn, struct net_pkt *pkt,
 		print_seq_list(pkt->buffer);
 	}
 
-	if (!net_pkt_is_empty(conn->queue_recv_data)) {
-		/* Place the data to correct place in the list. If the data
-		 * would not be sequential, then drop this packet.
-		 */
-		uint32_t pending_seq;
-
-		pending_seq = tcp_get_seq(conn->queue_recv_data->buffer);
-		if (pending_seq == seq) {
-			/* Put new data before the pending data */
-			net_buf_frag_add(pkt->buffer,
-					 conn->queue_recv_data->buffer);
-			conn->queue_recv_data->buffer = pkt->buffer;
-			inserted = true;
-		} else {
-			struct net_buf *last;
+	/* Find the place of the data in the queue, which is kept in
+	 * sequence order. Data overlapping what is queued already is dropped.
+	 */
+	next = conn->queue_recv_data->buffer;
+	while (next && net_tcp_seq_cmp(tcp_get_seq(next), seq_start) < 0) {
+		prev = next;
+		next = next->frags;
+	}
 
-			last = net_buf_frag_last(conn->queue_recv_data->buffer);
-			pending_seq = tcp_get_seq(last);
+	if ((prev && net_tcp_seq_cmp(tcp_get_seq(prev) + prev->len,
+				     seq_start) > 0) ||
+	    (next && net_tcp_seq_cmp(seq, tcp_get_seq(next)) > 0)) {
+		NET_DBG("Cannot add new data to queue");
+	} else {
+		net_buf_frag_last(pkt->buffer)->frags = next;
 
-			if ((pending_seq + last->len) == seq_start) {
-				/* Put new data after pending data */
-				last->frags = pkt->buffer;
-				inserted = true;
-			}
+		if (prev) {
+			prev->frags = pkt->buffer;
+		} else {
+			conn->queue_recv_data->buffer = pkt->buffer;
 		}
 
+		inserted = true;
+
 		if (IS_ENABLED(CONFIG_NET_TCP_LOG_LEVEL_DBG)) {
-			if (inserted) {
-				NET_DBG("All pending data: conn %p", conn);
-				print_seq_list(conn->queue_recv_data->buffer);
-			} else {
-				NET_DBG("Cannot add new data to queue");
-			}
+			NET_DBG("All pending data: conn %p", conn);
+			print_seq_list(conn->queue_recv_data->buffer);
 		}
-	} else {
-		net_pkt_append_buffer(conn->queue_recv_data, pkt->buffer);
-		inserted = true;
 	}
 
 	if (inserted) {
 		/* We need to keep the received data but free the pkt */
 		pkt->buffer = NULL;
 
+#if defined(CONFIG_NET_TCP_SACK)
+		conn->sack_recent = seq_start;
+#endif
+
 		if (!k_work_delayable_is_pending(&conn->recv_queue_timer)) {
 			k_work_reschedule_for_queue(
 				&tcp_work_q, &conn->recv_queue_timer,
@@ -1616,6 +2274,31 @@ static void tcp_out_of_order_data(struct tcp *conn, struct net_pkt *pkt,
 	/* We received out-of-order data. Try to queue it.
 	 */
 	tcp_queue_recv_data(conn, pkt, data_len, seq);
+
+	/* With SACK, a duplicate ACK tells the peer right away what is
+	 * missing
+	 */
+	if (conn->sack_ok) {
+		tcp_out(conn, ACK);
+	}
+}
+
+/* Settle the options of the connection from the SYN or SYN-ACK of the
+ * peer, as our own SYN offers everything enabled
+ */
+static void tcp_options_negotiate(struct tcp *conn)
+{
+	if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) &&
+	    conn->recv_options.wnd_found) {
+		conn->wscale_ok = true;
+		conn->snd_wscale = MIN(conn->recv_options.window,
+				       TCP_WSCALE_MAX);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+	    conn->recv_options.sack_perm_found) {
+		conn->sack_ok = true;
+	}
 }
 
 /* TCP state machine, everything happens here */
@@ -1661,6 +2344,11 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto next_state;
 	}
 
+#if defined(CONFIG_NET_TCP_SACK)
+	/* SACK blocks only describe the segment carrying them */
+	conn->recv_options.sack_count = 0U;
+#endif
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
 						  tcp_options_len)) {
 		NET_DBG("DROP: Invalid TCP option list");
@@ -1674,6 +2362,11 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 
 		conn->send_win = ntohs(th_win(th));
 
+		/* The window of SYN segments is never scaled */
+		if (conn->wscale_ok && !(th_flags(th) & SYN)) {
+			conn->send_win <<= conn->snd_wscale;
+		}
+
 #if defined(CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE)
 		if (CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE) {
 			max_win = CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE;
@@ -1683,8 +2376,12 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 			/* Adjust the window so that we do not run out of bufs
 			 * while waiting acks.
 			 */
+#if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
 			max_win = (CONFIG_NET_BUF_TX_COUNT *
 				   CONFIG_NET_BUF_DATA_SIZE) / 3;
+#else
+			max_win = CONFIG_NET_BUF_DATA_POOL_SIZE / 3;
+#endif
 		}
 
 		max_win = MAX(max_win, NET_IPV6_MTU);
@@ -1702,6 +2399,7 @@ next_state:
 	switch (conn->state) {
 	case TCP_LISTEN:
 		if (FL(&fl, ==, SYN)) {
+			tcp_options_negotiate(conn);
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
 			tcp_out(conn, SYN | ACK);
 			conn_seq(conn, + 1);
@@ -1723,6 +2421,7 @@ next_state:
 				th_seq(th) == conn->ack)) {
 			k_work_cancel_delayable(&conn->establish_timer);
 			tcp_send_timer_cancel(conn);
+			tcp_cc_init(conn);
 			next = TCP_ESTABLISHED;
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
@@ -1755,6 +2454,7 @@ next_state:
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
+			tcp_options_negotiate(conn);
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
 				if (tcp_data_get(conn, pkt, &len) < 0) {
@@ -1763,6 +2463,7 @@ next_state:
 				conn_ack(conn, + len);
 			}
 
+			tcp_cc_init(conn);
 			next = TCP_ESTABLISHED;
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
@@ -1809,6 +2510,10 @@ next_state:
 			break;
 		}
 
+		if (th && (th_flags(th) & ACK)) {
+			tcp_ack_received(conn, th, len);
+		}
+
 		if (th && net_tcp_seq_cmp(th_ack(th), conn->seq) > 0) {
 			uint32_t len_acked = th_ack(th) - conn->seq;
 
@@ -2065,6 +2770,60 @@ int net_tcp_update_recv_wnd(struct net_context *context, int32_t delta)
 	return -EPROTONOSUPPORT;
 }
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+int net_tcp_set_congestion(struct net_context *context, const char *name,
+			   size_t len)
+{
+	struct tcp *conn = context->tcp;
+	const struct tcp_cc *cc;
+
+	if (!conn) {
+		return -EPROTOTYPE;
+	}
+
+	/* Like on other systems, the terminating NUL may be counted */
+	cc = tcp_cc_find(name, strnlen(name, len));
+	if (!cc) {
+		return -ENOENT;
+	}
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (conn->cc != cc) {
+		conn->cc = cc;
+
+		/* Window and threshold carry over, the algorithm starts
+		 * from scratch
+		 */
+		if (conn->state != TCP_LISTEN && conn->state != TCP_SYN_SENT &&
+		    conn->state != TCP_SYN_RECEIVED && cc->init) {
+			cc->init(conn);
+		}
+	}
+
+	k_mutex_unlock(&conn->lock);
+
+	return 0;
+}
+
+int net_tcp_get_congestion(struct net_context *context, char *name,
+			   size_t *len)
+{
+	struct tcp *conn = context->tcp;
+	size_t name_len;
+
+	if (!conn) {
+		return -EPROTOTYPE;
+	}
+
+	name_len = MIN(strlen(conn->cc->name) + 1, *len);
+	memcpy(name, conn->cc->name, name_len);
+	*len = name_len;
+
+	return 0;
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
+
 /* net_context queues the outgoing data for the TCP connection */
 int net_tcp_queue_data(struct net_context *context, struct net_pkt *pkt)
 {
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* TCP congestion control algorithms */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <string.h>
+#include <zephyr.h>
+#include <net/net_pkt.h>
+#include <net/net_context.h>
+#include "tcp2_priv.h"
+
+/* NewReno (RFC 5681): one segment more per window of acked data, the
+ * window is halved on loss.
+ */
+static void newreno_cong_avoid(struct tcp *conn, uint32_t acked)
+{
+	conn->cc_bytes_acked += acked;
+
+	if (conn->cc_bytes_acked >= conn->cwnd) {
+		conn->cc_bytes_acked -= conn->cwnd;
+		conn->cwnd += conn_mss(conn);
+	}
+}
+
+static uint32_t newreno_ssthresh(struct tcp *conn)
+{
+	return MAX((uint32_t)conn->unacked_len / 2U, 2U * conn_mss(conn));
+}
+
+static const struct tcp_cc newreno = {
+	.name = "newreno",
+	.cong_avoid = newreno_cong_avoid,
+	.ssthresh = newreno_ssthresh,
+};
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+/* CUBIC (RFC 8312), with C = 0.4 and beta = 0.7. The window follows
+ * W(t) = C * (t - K)^3 + W_max, in segments and seconds, from the start
+ * of congestion avoidance. As there is no RTT estimate here, the target
+ * is taken at t rather than t + RTT, which only makes the growth a
+ * little more cautious.
+ */
+#define CUBIC_BETA_NUM 7U
+#define CUBIC_BETA_DEN 10U
+
+/* Longest time (t - K) the cubic function is evaluated for, in ms. This
+ * keeps C * (t - K)^3 * MSS within 64 bits, and W(t) is beyond any
+ * window by then.
+ */
+#define CUBIC_MAX_DELTA 30000U
+
+static uint32_t cubic_cbrt(uint64_t x)
+{
+	uint64_t root = 0U;
+
+	for (int shift = 63; shift >= 0; shift -= 3) {
+		uint64_t b;
+
+		root <<= 1;
+		b = 3U * root * (root + 1U) + 1U;
+
+		if ((x >> shift) >= b) {
+			x -= b << shift;
+			root++;
+		}
+	}
+
+	return (uint32_t)root;
+}
+
+static void cubic_init(struct tcp *conn)
+{
+	(void)memset(&conn->cubic, 0, sizeof(conn->cubic));
+}
+
+static void cubic_epoch_start(struct tcp *conn)
+{
+	struct tcp_cubic *cubic = &conn->cubic;
+	uint32_t mss = conn_mss(conn);
+
+	cubic->epoch_start = k_uptime_get_32() | 1U;
+	cubic->w_est = conn->cwnd;
+
+	if (conn->cwnd < cubic->w_max) {
+		/* K = cbrt((W_max - cwnd) / C), in ms */
+		cubic->k = cubic_cbrt((uint64_t)(cubic->w_max - conn->cwnd) *
+				      2500000000ULL / mss);
+		cubic->origin = cubic->w_max;
+	} else {
+		cubic->k = 0U;
+		cubic->origin = conn->cwnd;
+	}
+}
+
+static void cubic_cong_avoid(struct tcp *conn, uint32_t acked)
+{
+	struct tcp_cubic *cubic = &conn->cubic;
+	uint32_t mss = conn_mss(conn);
+	uint32_t t, delta, target;
+	uint64_t offset;
+
+	if (cubic->epoch_start == 0U) {
+		cubic_epoch_start(conn);
+	}
+
+	t = k_uptime_get_32() - cubic->epoch_start;
+	delta = MIN(t > cubic->k ? t - cubic->k : cubic->k - t,
+		    CUBIC_MAX_DELTA);
+
+	/* C * delta^3 segments, delta in ms */
+	offset = (uint64_t)delta * delta * delta * 4U * mss / 10000000000ULL;
+
+	if (t > cubic->k) {
+		target = MIN((uint64_t)cubic->origin + offset, UINT32_MAX);
+	} else {
+		target = (offset < cubic->origin) ? cubic->origin - offset : 0U;
+	}
+
+	/* TCP friendly region: grow at least as fast as Reno would, which
+	 * with beta = 0.7 is 3 * (1 - beta) / (1 + beta), about 9/17, of a
+	 * segment per window
+	 */
+	cubic->w_est += (uint64_t)acked * mss * 9U / (17U * conn->cwnd);
+	target = MAX(target, cubic->w_est);
+
+	if (target > conn->cwnd) {
+		conn->cwnd += MAX((uint64_t)(target - conn->cwnd) * acked /
+				  conn->cwnd, 1U);
+	} else {
+		/* At the plateau, probe very slowly */
+		newreno_cong_avoid(conn, acked / 100U);
+	}
+}
+
+static uint32_t cubic_ssthresh(struct tcp *conn)
+{
+	struct tcp_cubic *cubic = &conn->cubic;
+
+	/* Fast convergence: release bandwidth to newer flows if the
+	 * window did not even get back to where it was
+	 */
+	if (conn->cwnd < cubic->w_max) {
+		cubic->w_max = conn->cwnd * (CUBIC_BETA_DEN + CUBIC_BETA_NUM) /
+			       (2U * CUBIC_BETA_DEN);
+	} else {
+		cubic->w_max = conn->cwnd;
+	}
+
+	cubic->epoch_start = 0U;
+
+	return MAX(conn->cwnd / CUBIC_BETA_DEN * CUBIC_BETA_NUM,
+		   2U * conn_mss(conn));
+}
+
+static const struct tcp_cc cubic = {
+	.name = "cubic",
+	.init = cubic_init,
+	.cong_avoid = cubic_cong_avoid,
+	.ssthresh = cubic_ssthresh,
+};
+#endif /* CONFIG_NET_TCP_CONGESTION_CUBIC */
+
+static const struct tcp_cc *const algorithms[] = {
+	&newreno,
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+	&cubic,
+#endif
+};
+
+const struct tcp_cc *tcp_cc_default(void)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_CUBIC)
+	return &cubic;
+#else
+	return &newreno;
+#endif
+}
+
+const struct tcp_cc *tcp_cc_find(const char *name, size_t len)
+{
+	for (int i = 0; i < ARRAY_SIZE(algorithms); i++) {
+		if (strlen(algorithms[i]->name) == len &&
+		    strncmp(algorithms[i]->name, name, len) == 0) {
+			return algorithms[i];
+		}
+	}
+
+	return NULL;
+}
@@ -125,7 +125,7 @@
 #define conn_send_data_dump(_conn)                                             \
 	({                                                                     \
 		NET_DBG("conn: %p total=%zd, unacked_len=%d, "                 \
-			"send_win=%hu, mss=%hu",                               \
+			"send_win=%u, mss=%hu",                                \
 			(_conn), net_pkt_get_len((_conn)->send_data),          \
 			conn->unacked_len, conn->send_win,                     \
 			(uint16_t)conn_mss((_conn)));                          \
@@ -141,6 +141,17 @@
 #define TCPOPT_NOP	1
 #define TCPOPT_MAXSEG	2
 #define TCPOPT_WINDOW	3
+#define TCPOPT_SACK_PERM	4
+#define TCPOPT_SACK	5
+
+/* Largest shift allowed by RFC 7323 */
+#define TCP_WSCALE_MAX	14
+
+/* Without timestamps, four SACK blocks fit in the TCP options */
+#define TCP_SACK_MAX_BLOCKS	4
+
+/* Duplicate ACKs starting loss recovery, as in RFC 6675 */
+#define TCP_DUPACK_THRESHOLD	3
 
 enum pkt_addr {
 	TCP_EP_SRC = 1,
@@ -202,12 +213,32 @@ union tcp_endpoint {
 	struct sockaddr_in6 sin6;
 };
 
+struct tcp_sack_block {
+	uint32_t start;
+	uint32_t end;
+};
+
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+#if defined(CONFIG_NET_TCP_SACK)
+	uint8_t sack_count;
+	struct tcp_sack_block sack[TCP_SACK_MAX_BLOCKS];
+#endif
+};
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+struct tcp_cubic {
+	uint32_t epoch_start; /* uptime in ms, 0 outside congestion avoidance */
+	uint32_t k;           /* ms from epoch_start to get back to origin */
+	uint32_t origin;      /* window at the plateau of the cubic curve */
+	uint32_t w_max;       /* window before the last reduction */
+	uint32_t w_est;       /* what a Reno sender would reach by now */
 };
+#endif
 
 struct tcp { /* TCP connection */
 	sys_snode_t next;
@@ -245,14 +276,37 @@ struct tcp { /* TCP connection */
 	atomic_t ref_count;
 	enum tcp_state state;
 	enum tcp_data_mode data_mode;
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Sender scoreboard: data the peer has reported holding, above seq */
+	struct tcp_sack_block sacked[TCP_SACK_MAX_BLOCKS];
+	uint32_t rexmit_next;    /* where to look for the next hole to resend */
+	uint32_t sack_recent;    /* latest out-of-order data received */
+	uint8_t sacked_count;
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	const struct tcp_cc *cc;
+	uint32_t cwnd;           /* congestion window, in bytes */
+	uint32_t ssthresh;       /* slow start threshold, in bytes */
+	uint32_t cc_bytes_acked; /* acked in congestion avoidance, not counted */
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+	struct tcp_cubic cubic;
+#endif
+#endif
+	uint32_t recovery_point; /* seq that ends the loss recovery */
+	uint8_t dup_acks;
 	uint32_t seq;
 	uint32_t ack;
-	uint16_t recv_win;
-	uint16_t send_win;
+	uint32_t recv_win;
+	uint32_t send_win;
+	uint8_t snd_wscale; /* shift of the windows the peer advertises */
+	uint8_t rcv_wscale; /* shift of the windows we advertise */
 	uint8_t send_data_retries;
 	bool in_retransmission : 1;
 	bool in_connect : 1;
 	bool in_close : 1;
+	bool wscale_ok : 1;
+	bool sack_ok : 1;
+	bool in_recovery : 1;
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
@@ -271,4 +325,23 @@ struct tcp { /* TCP connection */
 #define FL(_fl, _op, _mask, _args...)					\
 	_flags(_fl, _op, _mask, strlen("" #_args) ? _args : true)
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+/* Congestion control algorithm. Slow start and loss recovery are common
+ * to all, the algorithm decides how the window grows in congestion
+ * avoidance and how it is reduced on loss.
+ */
+struct tcp_cc {
+	const char *name;
+	/* Called when the connection is established, may be NULL */
+	void (*init)(struct tcp *conn);
+	/* New data was acked while cwnd >= ssthresh */
+	void (*cong_avoid)(struct tcp *conn, uint32_t acked);
+	/* Loss was detected, return the new ssthresh */
+	uint32_t (*ssthresh)(struct tcp *conn);
+};
+
+const struct tcp_cc *tcp_cc_default(void);
+const struct tcp_cc *tcp_cc_find(const char *name, size_t len);
+#endif
+
 typedef void (*net_tcp_cb_t)(struct tcp *conn, void *user_data);
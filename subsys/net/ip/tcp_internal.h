@@ -338,6 +338,59 @@ static inline int net_tcp_update_recv_wnd(struct net_context *context,
 }
 #endif
 
+/**
+ * @brief Select the congestion control algorithm of a TCP connection
+ *
+ * @param context Network context
+ * @param name Name of the algorithm, need not be NUL terminated
+ * @param len Length of @a name
+ *
+ * @return 0 on success, -EPROTOTYPE if there is no TCP context, -ENOENT
+ *         if there is no such algorithm, -ENOTSUP if congestion control
+ *         is not enabled
+ */
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+int net_tcp_set_congestion(struct net_context *context, const char *name,
+			   size_t len);
+#else
+static inline int net_tcp_set_congestion(struct net_context *context,
+					 const char *name, size_t len)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(name);
+	ARG_UNUSED(len);
+
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Get the name of the congestion control algorithm of a TCP
+ *        connection
+ *
+ * @param context Network context
+ * @param name Where to store the NUL terminated name, truncated to
+ *        @a len bytes
+ * @param len Size of @a name, set to the length stored
+ *
+ * @return 0 on success, -EPROTOTYPE if there is no TCP context, -ENOTSUP
+ *         if congestion control is not enabled
+ */
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+int net_tcp_get_congestion(struct net_context *context, char *name,
+			   size_t *len);
+#else
+static inline int net_tcp_get_congestion(struct net_context *context,
+					 char *name, size_t *len)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(name);
+	ARG_UNUSED(len);
+
+	return -ENOTSUP;
+}
+#endif
+
 /**
  * @brief Queue a TCP FIN packet if needed to close the socket
  *
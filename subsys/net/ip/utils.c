@@ -487,32 +487,47 @@ int z_vrfy_net_addr_pton(sa_family_t family, const char *src,
 #include <syscalls/net_addr_pton_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+/* The one's complement sum does not depend on the byte order, so the
+ * data is added up a 32-bit word at a time as laid out in memory, with
+ * the carries collected in the upper half of a 64-bit sum. Only the
+ * folded result is converted to host order.
+ */
 static uint16_t calc_chksum(uint16_t sum, const uint8_t *data, size_t len)
 {
-	const uint8_t *end;
-	uint16_t tmp;
+	uint64_t acc = htons(sum);
 
-	end = data + len - 1;
+	while (len >= 16U) {
+		acc += UNALIGNED_GET((const uint32_t *)data);
+		acc += UNALIGNED_GET((const uint32_t *)(data + 4));
+		acc += UNALIGNED_GET((const uint32_t *)(data + 8));
+		acc += UNALIGNED_GET((const uint32_t *)(data + 12));
+		data += 16;
+		len -= 16U;
+	}
 
-	while (data < end) {
-		tmp = (data[0] << 8) + data[1];
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+	while (len >= 4U) {
+		acc += UNALIGNED_GET((const uint32_t *)data);
+		data += 4;
+		len -= 4U;
+	}
 
+	if (len >= 2U) {
+		acc += UNALIGNED_GET((const uint16_t *)data);
 		data += 2;
+		len -= 2U;
 	}
 
-	if (data == end) {
-		tmp = data[0] << 8;
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+	if (len) {
+		const uint8_t last[2] = { data[0], 0 };
+
+		acc += UNALIGNED_GET((const uint16_t *)last);
 	}
 
-	return sum;
+	while (acc >> 16) {
+		acc = (acc & 0xffff) + (acc >> 16);
+	}
+
+	return ntohs((uint16_t)acc);
 }
 
 static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
@@ -30,6 +30,15 @@ static sys_slist_t arp_free_entries;
 static sys_slist_t arp_pending_entries;
 static sys_slist_t arp_table;
 
+/* The entries of the table are also in buckets indexed by a hash of
+ * their address, so that resolving the destination of every sent
+ * packet does not walk the whole table. The table itself is kept
+ * ordered from the newest to the oldest entry, for replacement.
+ */
+#define ARP_HASH_SIZE MAX(1, CONFIG_NET_ARP_TABLE_SIZE / 2)
+
+static sys_slist_t arp_hash[ARP_HASH_SIZE];
+
 struct k_work_delayable arp_request_timer;
 
 static void arp_entry_cleanup(struct arp_entry *entry, bool pending)
@@ -50,6 +59,44 @@ static void arp_entry_cleanup(struct arp_entry *entry, bool pending)
 	(void)memset(&entry->eth, 0, sizeof(struct net_eth_addr));
 }
 
+static sys_slist_t *arp_hash_bucket(struct in_addr *addr)
+{
+	uint32_t hash = UNALIGNED_GET(&addr->s_addr);
+
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
+
+	return &arp_hash[hash % ARP_HASH_SIZE];
+}
+
+static void arp_table_add(struct arp_entry *entry)
+{
+	sys_slist_prepend(&arp_table, &entry->node);
+	sys_slist_prepend(arp_hash_bucket(&entry->ip), &entry->hash_node);
+}
+
+static void arp_table_remove(struct arp_entry *entry, sys_snode_t *prev)
+{
+	sys_slist_remove(&arp_table, prev, &entry->node);
+	sys_slist_find_and_remove(arp_hash_bucket(&entry->ip),
+				  &entry->hash_node);
+}
+
+static struct arp_entry *arp_table_find(struct net_if *iface,
+					struct in_addr *dst)
+{
+	struct arp_entry *entry;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(arp_hash_bucket(dst), entry, hash_node) {
+		if (entry->iface == iface &&
+		    net_ipv4_addr_cmp(&entry->ip, dst)) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
 static struct arp_entry *arp_entry_find(sys_slist_t *list,
 					struct net_if *iface,
 					struct in_addr *dst,
@@ -74,30 +121,6 @@ static struct arp_entry *arp_entry_find(sys_slist_t *list,
 	return NULL;
 }
 
-static inline struct arp_entry *arp_entry_find_move_first(struct net_if *iface,
-							  struct in_addr *dst)
-{
-	sys_snode_t *prev = NULL;
-	struct arp_entry *entry;
-
-	NET_DBG("dst %s", log_strdup(net_sprint_ipv4_addr(dst)));
-
-	entry = arp_entry_find(&arp_table, iface, dst, &prev);
-	if (entry) {
-		/* Let's assume the target is going to be accessed
-		 * more than once here in a short time frame. So we
-		 * place the entry first in position into the table
-		 * in order to reduce subsequent find.
-		 */
-		if (&entry->node != sys_slist_peek_head(&arp_table)) {
-			sys_slist_remove(&arp_table, prev, &entry->node);
-			sys_slist_prepend(&arp_table, &entry->node);
-		}
-	}
-
-	return entry;
-}
-
 static inline
 struct arp_entry *arp_entry_find_pending(struct net_if *iface,
 					 struct in_addr *dst)
@@ -145,6 +168,7 @@ static struct arp_entry *arp_entry_get_free(void)
 
 static struct arp_entry *arp_entry_get_last_from_table(void)
 {
+	struct arp_entry *entry;
 	sys_snode_t *node;
 
 	/* We assume last entry is the oldest one,
@@ -156,9 +180,13 @@ static struct arp_entry *arp_entry_get_last_from_table(void)
 		return NULL;
 	}
 
+	entry = CONTAINER_OF(node, struct arp_entry, node);
+
 	sys_slist_find_and_remove(&arp_table, node);
+	sys_slist_find_and_remove(arp_hash_bucket(&entry->ip),
+				  &entry->hash_node);
 
-	return CONTAINER_OF(node, struct arp_entry, node);
+	return entry;
 }
 
 
@@ -354,7 +382,7 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 	/* If the destination address is already known, we do not need
 	 * to send any ARP packet.
 	 */
-	entry = arp_entry_find_move_first(net_pkt_iface(pkt), addr);
+	entry = arp_table_find(net_pkt_iface(pkt), addr);
 	if (!entry) {
 		struct net_pkt *req;
 
@@ -404,10 +432,9 @@ static void arp_gratuitous(struct net_if *iface,
 			   struct in_addr *src,
 			   struct net_eth_addr *hwaddr)
 {
-	sys_snode_t *prev = NULL;
 	struct arp_entry *entry;
 
-	entry = arp_entry_find(&arp_table, iface, src, &prev);
+	entry = arp_table_find(iface, src);
 	if (entry) {
 		NET_DBG("Gratuitous ARP hwaddr %s -> %s",
 			log_strdup(net_sprint_ll_addr(
@@ -439,10 +466,9 @@ static void arp_update(struct net_if *iface,
 		}
 
 		if (force) {
-			sys_snode_t *prev = NULL;
 			struct arp_entry *entry;
 
-			entry = arp_entry_find(&arp_table, iface, src, &prev);
+			entry = arp_table_find(iface, src);
 			if (entry) {
 				memcpy(&entry->eth, hwaddr,
 				       sizeof(struct net_eth_addr));
@@ -461,7 +487,7 @@ static void arp_update(struct net_if *iface,
 					entry->iface = iface;
 					net_ipaddr_copy(&entry->ip, src);
 					memcpy(&entry->eth, hwaddr, sizeof(entry->eth));
-					sys_slist_prepend(&arp_table, &entry->node);
+					arp_table_add(entry);
 				}
 			}
 		}
@@ -484,7 +510,7 @@ static void arp_update(struct net_if *iface,
 	memcpy(&entry->eth, hwaddr, sizeof(struct net_eth_addr));
 
 	/* Inserting entry into the table */
-	sys_slist_prepend(&arp_table, &entry->node);
+	arp_table_add(entry);
 
 	net_if_queue_tx(iface, pkt);
 }
@@ -685,9 +711,9 @@ void net_arp_clear_cache(struct net_if *iface)
 			continue;
 		}
 
+		arp_table_remove(entry, prev);
 		arp_entry_cleanup(entry, false);
 
-		sys_slist_remove(&arp_table, prev, &entry->node);
 		sys_slist_prepend(&arp_free_entries, &entry->node);
 	}
 
@@ -738,6 +764,10 @@ void net_arp_init(void)
 	sys_slist_init(&arp_pending_entries);
 	sys_slist_init(&arp_table);
 
+	for (i = 0; i < ARP_HASH_SIZE; i++) {
+		sys_slist_init(&arp_hash[i]);
+	}
+
 	for (i = 0; i < CONFIG_NET_ARP_TABLE_SIZE; i++) {
 		/* Inserting entry as free */
 		sys_slist_prepend(&arp_free_entries, &arp_entries[i].node);
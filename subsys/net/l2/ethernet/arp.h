@@ -51,6 +51,7 @@ enum net_verdict net_arp_input(struct net_pkt *pkt,
 
 struct arp_entry {
 	sys_snode_t node;
+	sys_snode_t hash_node;
 	uint32_t req_start;
 	struct net_if *iface;
 	struct in_addr ip;
@@ -172,8 +172,11 @@ int dsa_tx(const struct device *dev, struct net_pkt *pkt)
 		 */
 		ctx = net_if_l2_data(iface);
 		context = ctx->dsa_ctx;
-		return ctx->dsa_send(dev,
-				     context->dapi->dsa_xmit_pkt(iface, pkt));
+		if (context->dapi->dsa_xmit_pkt(iface, pkt) == NULL) {
+			return -ENOMEM;
+		}
+
+		return ctx->dsa_send(dev, pkt);
 	}
 
 	context = dev->data;
@@ -195,6 +198,9 @@ int dsa_tx(const struct device *dev, struct net_pkt *pkt)
 
 	/* Adjust packet for DSA routing and send it via master interface */
 	ctx = net_if_l2_data(iface_master);
-	return ctx->dsa_send(net_if_get_device(iface_master),
-			     context->dapi->dsa_xmit_pkt(iface, pkt));
+	if (context->dapi->dsa_xmit_pkt(iface, pkt) == NULL) {
+		return -ENOMEM;
+	}
+
+	return ctx->dsa_send(net_if_get_device(iface_master), pkt);
 }
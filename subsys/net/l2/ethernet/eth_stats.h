@@ -13,193 +13,97 @@
 #include <net/net_stats.h>
 #include <net/net_if.h>
 
-static inline void eth_stats_update_bytes_rx(struct net_if *iface,
-					     uint32_t bytes)
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+/* The counters are updated in the copy of the current CPU kept in the
+ * Ethernet context, and added to the statistics of the driver when these are
+ * read.
+ */
+#define UPDATE_ETH_STAT(_iface, _cmd)					\
+	{								\
+		struct ethernet_context *_ctx = net_if_l2_data(_iface);	\
+		unsigned int _key = arch_irq_lock();			\
+									\
+		(_ctx->stats_cpu[NET_STATS_CPU_ID()]._cmd);		\
+		arch_irq_unlock(_key);					\
+	}
+#else
+static inline struct net_stats_eth *eth_stats_get_driver(struct net_if *iface)
 {
 	const struct ethernet_api *api = (const struct ethernet_api *)
 		net_if_get_device(iface)->api;
-	struct net_stats_eth *stats;
 
 	if (!api->get_stats) {
-		return;
+		return NULL;
 	}
 
-	stats = api->get_stats(net_if_get_device(iface));
-	if (!stats) {
-		return;
+	return api->get_stats(net_if_get_device(iface));
+}
+
+#define UPDATE_ETH_STAT(_iface, _cmd)					\
+	{								\
+		struct net_stats_eth *_stats =				\
+			eth_stats_get_driver(_iface);			\
+									\
+		if (_stats) {						\
+			(_stats->_cmd);					\
+		}							\
 	}
+#endif /* CONFIG_NET_STATISTICS_PER_CPU */
 
-	stats->bytes.received += bytes;
+static inline void eth_stats_update_bytes_rx(struct net_if *iface,
+					     uint32_t bytes)
+{
+	UPDATE_ETH_STAT(iface, bytes.received += bytes);
 }
 
 static inline void eth_stats_update_bytes_tx(struct net_if *iface,
 					     uint32_t bytes)
 {
-	const struct ethernet_api *api = (const struct ethernet_api *)
-		net_if_get_device(iface)->api;
-	struct net_stats_eth *stats;
-
-	if (!api->get_stats) {
-		return;
-	}
-
-	stats = api->get_stats(net_if_get_device(iface));
-	if (!stats) {
-		return;
-	}
-
-	stats->bytes.sent += bytes;
+	UPDATE_ETH_STAT(iface, bytes.sent += bytes);
 }
 
 static inline void eth_stats_update_pkts_rx(struct net_if *iface)
 {
-	const struct ethernet_api *api = (const struct ethernet_api *)
-		net_if_get_device(iface)->api;
-	struct net_stats_eth *stats;
-
-	if (!api->get_stats) {
-		return;
-	}
-
-	stats = api->get_stats(net_if_get_device(iface));
-	if (!stats) {
-		return;
-	}
-
-	stats->pkts.rx++;
+	UPDATE_ETH_STAT(iface, pkts.rx++);
 }
 
 static inline void eth_stats_update_pkts_tx(struct net_if *iface)
 {
-	const struct ethernet_api *api = (const struct ethernet_api *)
-		net_if_get_device(iface)->api;
-	struct net_stats_eth *stats;
-
-	if (!api->get_stats) {
-		return;
-	}
-
-	stats = api->get_stats(net_if_get_device(iface));
-	if (!stats) {
-		return;
-	}
-
-	stats->pkts.tx++;
+	UPDATE_ETH_STAT(iface, pkts.tx++);
 }
 
 static inline void eth_stats_update_broadcast_rx(struct net_if *iface)
 {
-	const struct ethernet_api *api = (const struct ethernet_api *)
-		net_if_get_device(iface)->api;
-	struct net_stats_eth *stats;
-
-	if (!api->get_stats) {
-		return;
-	}
-
-	stats = api->get_stats(net_if_get_device(iface));
-	if (!stats) {
-		return;
-	}
-
-	stats->broadcast.rx++;
+	UPDATE_ETH_STAT(iface, broadcast.rx++);
 }
 
 static inline void eth_stats_update_broadcast_tx(struct net_if *iface)
 {
-	const struct ethernet_api *api = (const struct ethernet_api *)
-		net_if_get_device(iface)->api;
-	struct net_stats_eth *stats;
-
-	if (!api->get_stats) {
-		return;
-	}
-
-	stats = api->get_stats(net_if_get_device(iface));
-	if (!stats) {
-		return;
-	}
-
-	stats->broadcast.tx++;
+	UPDATE_ETH_STAT(iface, broadcast.tx++);
 }
 
 static inline void eth_stats_update_multicast_rx(struct net_if *iface)
 {
-	const struct ethernet_api *api = (const struct ethernet_api *)
-		net_if_get_device(iface)->api;
-	struct net_stats_eth *stats;
-
-	if (!api->get_stats) {
-		return;
-	}
-
-	stats = api->get_stats(net_if_get_device(iface));
-	if (!stats) {
-		return;
-	}
-
-	stats->multicast.rx++;
+	UPDATE_ETH_STAT(iface, multicast.rx++);
 }
 
 static inline void eth_stats_update_multicast_tx(struct net_if *iface)
 {
-	const struct ethernet_api *api = (const struct ethernet_api *)
-		net_if_get_device(iface)->api;
-	struct net_stats_eth *stats;
-
-	if (!api->get_stats) {
-		return;
-	}
-
-	stats = api->get_stats(net_if_get_device(iface));
-	if (!stats) {
-		return;
-	}
-
-	stats->multicast.tx++;
+	UPDATE_ETH_STAT(iface, multicast.tx++);
 }
 
-
 static inline void eth_stats_update_errors_rx(struct net_if *iface)
 {
-	struct net_stats_eth *stats;
-	const struct ethernet_api *api;
-
 	if (!iface) {
 		return;
 	}
 
-	api = ((const struct ethernet_api *)
-	       net_if_get_device(iface)->api);
-
-	if (!api->get_stats) {
-		return;
-	}
-
-	stats = api->get_stats(net_if_get_device(iface));
-	if (!stats) {
-		return;
-	}
-
-	stats->errors.rx++;
+	UPDATE_ETH_STAT(iface, errors.rx++);
 }
 
 static inline void eth_stats_update_errors_tx(struct net_if *iface)
 {
-	struct net_stats_eth *stats;
-	const struct ethernet_api *api = ((const struct ethernet_api *)
-		net_if_get_device(iface)->api);
-
-	if (!api->get_stats) {
-		return;
-	}
-
-	stats = api->get_stats(net_if_get_device(iface));
-	if (!stats) {
-		return;
-	}
-
-	stats->errors.tx++;
+	UPDATE_ETH_STAT(iface, errors.tx++);
 }
 
 #else /* CONFIG_NET_STATISTICS_ETHERNET */
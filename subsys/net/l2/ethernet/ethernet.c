@@ -151,6 +151,14 @@ static inline bool eth_is_vlan_tag_stripped(struct net_if *iface)
 	return (api->get_capabilities(dev) & ETHERNET_HW_VLAN_TAG_STRIP);
 }
 
+static inline bool eth_is_vlan_tag_inserted(struct net_if *iface)
+{
+	const struct device *dev = net_if_get_device(iface);
+	const struct ethernet_api *api = dev->api;
+
+	return (api->get_capabilities(dev) & ETHERNET_HW_VLAN_TAG_INSERT);
+}
+
 /* Drop packet if it has broadcast destination MAC address but the IP
  * address is not multicast or broadcast address. See RFC 1122 ch 3.3.6
  */
@@ -489,7 +497,8 @@ static struct net_buf *ethernet_fill_header(struct ethernet_context *ctx,
 	}
 
 	if (IS_ENABLED(CONFIG_NET_VLAN) &&
-	    net_eth_is_vlan_enabled(ctx, net_pkt_iface(pkt))) {
+	    net_eth_is_vlan_enabled(ctx, net_pkt_iface(pkt)) &&
+	    !eth_is_vlan_tag_inserted(net_pkt_iface(pkt))) {
 		struct net_eth_vlan_hdr *hdr_vlan;
 
 		hdr_vlan = (struct net_eth_vlan_hdr *)(hdr_frag->data);
@@ -725,6 +734,12 @@ struct net_if *net_eth_get_vlan_iface(struct net_if *iface, uint16_t tag)
 	struct net_if *first_non_vlan_iface = NULL;
 	int i;
 
+#if defined(CONFIG_NET_VLAN_TAG_MAP)
+	if (tag < ARRAY_SIZE(ctx->vlan_map) && ctx->vlan_map[tag]) {
+		return ctx->vlan[ctx->vlan_map[tag] - 1].iface;
+	}
+#endif
+
 	for (i = 0; i < CONFIG_NET_VLAN_COUNT; i++) {
 		if (ctx->vlan[i].tag == NET_VLAN_TAG_UNSPEC) {
 			if (!first_non_vlan_iface) {
@@ -901,7 +916,7 @@ int net_eth_vlan_enable(struct net_if *iface, uint16_t tag)
 		return -EPERM;
 	}
 
-	if (tag == NET_VLAN_TAG_UNSPEC) {
+	if (tag >= NET_VLAN_TAG_UNSPEC) {
 		return -EBADF;
 	}
 
@@ -923,6 +938,10 @@ int net_eth_vlan_enable(struct net_if *iface, uint16_t tag)
 
 		ctx->vlan[i].tag = tag;
 
+#if defined(CONFIG_NET_VLAN_TAG_MAP)
+		ctx->vlan_map[tag] = i + 1;
+#endif
+
 		/* Add a link local IPv6 address to VLAN interface here.
 		 * Each network interface needs LL address, but as there is
 		 * only one link (MAC) address defined for all the master and
@@ -969,7 +988,7 @@ int net_eth_vlan_disable(struct net_if *iface, uint16_t tag)
 		return -EINVAL;
 	}
 
-	if (tag == NET_VLAN_TAG_UNSPEC) {
+	if (tag >= NET_VLAN_TAG_UNSPEC) {
 		return -EBADF;
 	}
 
@@ -982,6 +1001,10 @@ int net_eth_vlan_disable(struct net_if *iface, uint16_t tag)
 
 	vlan->tag = NET_VLAN_TAG_UNSPEC;
 
+#if defined(CONFIG_NET_VLAN_TAG_MAP)
+	ctx->vlan_map[tag] = 0U;
+#endif
+
 	disable_vlan_iface(ctx, iface);
 
 	if (eth->vlan_setup) {
@@ -17,6 +17,31 @@ LOG_MODULE_REGISTER(net_ethernet_stats, CONFIG_NET_L2_ETHERNET_LOG_LEVEL);
 
 #if defined(CONFIG_NET_STATISTICS_USER_API)
 
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+/* Add the per CPU counters of the L2 to the statistics of the driver */
+static void eth_stats_add_cpu(struct net_if *iface,
+			      struct net_stats_eth *stats)
+{
+	const struct ethernet_context *ctx = net_if_l2_data(iface);
+	int i;
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		const struct net_stats_eth_cpu *cpu = &ctx->stats_cpu[i];
+
+		stats->bytes.sent += cpu->bytes.sent;
+		stats->bytes.received += cpu->bytes.received;
+		stats->pkts.tx += cpu->pkts.tx;
+		stats->pkts.rx += cpu->pkts.rx;
+		stats->broadcast.tx += cpu->broadcast.tx;
+		stats->broadcast.rx += cpu->broadcast.rx;
+		stats->multicast.tx += cpu->multicast.tx;
+		stats->multicast.rx += cpu->multicast.rx;
+		stats->errors.tx += cpu->errors.tx;
+		stats->errors.rx += cpu->errors.rx;
+	}
+}
+#endif
+
 static int eth_stats_get(uint32_t mgmt_request, struct net_if *iface,
 			 void *data, size_t len)
 {
@@ -46,6 +71,10 @@ static int eth_stats_get(uint32_t mgmt_request, struct net_if *iface,
 
 	memcpy(data, src, len);
 
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+	eth_stats_add_cpu(iface, data);
+#endif
+
 	return 0;
 }
 
@@ -569,6 +569,11 @@ static void gptp_thread(void)
 }
 
 
+void gptp_wakeup(void)
+{
+	k_fifo_cancel_wait(&gptp_rx_queue);
+}
+
 static void gptp_add_port(struct net_if *iface, void *user_data)
 {
 	int *num_ports = user_data;
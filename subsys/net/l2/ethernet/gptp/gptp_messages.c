@@ -103,6 +103,9 @@ static void gptp_sync_timestamp_callback(struct net_pkt *pkt)
 
 		/* The pkt was ref'ed in gptp_send_sync() */
 		net_pkt_unref(pkt);
+
+		/* The Follow_Up carries this timestamp, send it right away */
+		gptp_wakeup();
 	}
 }
 
@@ -734,6 +734,102 @@ static void gptp_mi_clk_slave_sync_compute(void)
 }
 
 #if defined(CONFIG_NET_GPTP_USE_DEFAULT_CLOCK_UPDATE)
+/* Weight of a new offset in the averages, as a power of two */
+#define GPTP_OFFSET_AVG_SHIFT 4
+
+/* Offsets below this are at the level of the timestamp noise, and never
+ * taken as outliers.
+ */
+#define GPTP_OFFSET_OUTLIER_MIN_NS 100
+
+/* Number of outliers in a row after which the offset is used anyway */
+#define GPTP_OFFSET_OUTLIER_MAX_IN_ROW 4
+
+/* Record an offset to the grandmaster. Returns false for an outlier, which
+ * should not be used to correct the clock.
+ */
+static bool gptp_servo_sample(struct gptp_clk_servo *servo, int64_t offset)
+{
+	int32_t ns = CLAMP(offset, INT32_MIN, INT32_MAX);
+	double abs_ns = ns < 0 ? -(double)ns : (double)ns;
+	double delta;
+
+	if (CONFIG_NET_GPTP_OFFSET_OUTLIER_FACTOR > 0 &&
+	    servo->samples >= BIT(GPTP_OFFSET_AVG_SHIFT) &&
+	    abs_ns > GPTP_OFFSET_OUTLIER_MIN_NS &&
+	    abs_ns > CONFIG_NET_GPTP_OFFSET_OUTLIER_FACTOR *
+		     servo->offset_avg &&
+	    servo->outliers_in_row < GPTP_OFFSET_OUTLIER_MAX_IN_ROW) {
+		servo->outliers++;
+		servo->outliers_in_row++;
+		return false;
+	}
+
+	servo->outliers_in_row = 0U;
+
+	if (servo->samples == 0U) {
+		servo->offset_min = ns;
+		servo->offset_max = ns;
+		servo->offset_avg = abs_ns;
+		servo->jitter = 0;
+	} else {
+		servo->offset_min = MIN(servo->offset_min, ns);
+		servo->offset_max = MAX(servo->offset_max, ns);
+		servo->offset_avg += (abs_ns - servo->offset_avg) /
+				     BIT(GPTP_OFFSET_AVG_SHIFT);
+
+		delta = (double)ns - servo->offset;
+		if (delta < 0) {
+			delta = -delta;
+		}
+
+		servo->jitter += (delta - servo->jitter) /
+				 BIT(GPTP_OFFSET_AVG_SHIFT);
+	}
+
+	servo->offset = ns;
+	servo->samples++;
+
+	return true;
+}
+
+#if defined(CONFIG_NET_GPTP_PI_SERVO)
+/* The clock drivers get the rate ratio as a float, which only represents
+ * changes of about 120 ppb and more around 1.
+ */
+#define GPTP_SERVO_RATE_MIN_PPB 120
+
+static void gptp_servo_pi(struct gptp_clk_servo *servo,
+			  const struct device *clk, int64_t offset)
+{
+	double kp = CONFIG_NET_GPTP_PI_SERVO_KP / 1000.0;
+	double ki = CONFIG_NET_GPTP_PI_SERVO_KI / 1000.0;
+	double change;
+
+	/* The proportional term moves the clock right away */
+	ptp_clock_adjust(clk, (int)(kp * offset));
+
+	/* The integral term follows the frequency error, in ppb */
+	servo->drift = CLAMP(servo->drift + ki * offset,
+			     -CONFIG_NET_GPTP_PI_SERVO_MAX_PPB,
+			     CONFIG_NET_GPTP_PI_SERVO_MAX_PPB);
+
+	/* Smaller frequency errors are left to the proportional term until
+	 * they add up. The drivers apply the ratio on top of the previous
+	 * ones, so only the change is given.
+	 */
+	change = servo->drift - servo->applied;
+	if (change > -GPTP_SERVO_RATE_MIN_PPB &&
+	    change < GPTP_SERVO_RATE_MIN_PPB) {
+		return;
+	}
+
+	ptp_clock_rate_adjust(clk, (1.0 + servo->drift / NSEC_PER_SEC) /
+				   (1.0 + servo->applied / NSEC_PER_SEC));
+	servo->applied = servo->drift;
+}
+#endif /* CONFIG_NET_GPTP_PI_SERVO */
+
 static void gptp_update_local_port_clock(void)
 {
 	struct gptp_clk_slave_sync_state *state;
@@ -753,12 +849,17 @@ static void gptp_update_local_port_clock(void)
 
 	port_ds = GPTP_PORT_DS(port);
 
-	/* Check if the last neighbor rate ratio can still be used */
-	if (!port_ds->neighbor_rate_ratio_valid) {
-		return;
-	}
+	/* The PI servo follows the offset of each Sync, the neighbor rate
+	 * ratio is only used to compute it.
+	 */
+	if (!IS_ENABLED(CONFIG_NET_GPTP_PI_SERVO)) {
+		/* Check if the last neighbor rate ratio can still be used */
+		if (!port_ds->neighbor_rate_ratio_valid) {
+			return;
+		}
 
-	port_ds->neighbor_rate_ratio_valid = false;
+		port_ds->neighbor_rate_ratio_valid = false;
+	}
 
 	second_diff = global_ds->sync_receipt_time.second -
 		(global_ds->sync_receipt_local_time / NSEC_PER_SEC);
@@ -781,7 +882,9 @@ static void gptp_update_local_port_clock(void)
 		nanosecond_diff = -NSEC_PER_SEC + nanosecond_diff;
 	}
 
-	ptp_clock_rate_adjust(clk, port_ds->neighbor_rate_ratio);
+	if (!IS_ENABLED(CONFIG_NET_GPTP_PI_SERVO)) {
+		ptp_clock_rate_adjust(clk, port_ds->neighbor_rate_ratio);
+	}
 
 	/* If time difference is too high, set the clock value.
 	 * Otherwise, adjust it.
@@ -791,6 +894,12 @@ static void gptp_update_local_port_clock(void)
 			     nanosecond_diff > 5000))) {
 		bool underflow = false;
 
+		/* The offsets before the step say nothing of the ones after */
+		state->servo.offset = CLAMP(second_diff * NSEC_PER_SEC +
+					    nanosecond_diff,
+					    INT32_MIN, INT32_MAX);
+		state->servo.samples = 0U;
+
 		key = irq_lock();
 		ptp_clock_get(clk, &tm);
 
@@ -832,6 +941,15 @@ static void gptp_update_local_port_clock(void)
 	skip_clock_set:
 		irq_unlock(key);
 	} else {
+		if (!gptp_servo_sample(&state->servo, nanosecond_diff)) {
+			NET_DBG("Offset %d ns discarded as outlier",
+				(int)nanosecond_diff);
+			return;
+		}
+
+#if defined(CONFIG_NET_GPTP_PI_SERVO)
+		gptp_servo_pi(&state->servo, clk, nanosecond_diff);
+#else
 		if (nanosecond_diff < -200) {
 			nanosecond_diff = -200;
 		} else if (nanosecond_diff > 200) {
@@ -839,6 +957,7 @@ static void gptp_update_local_port_clock(void)
 		}
 
 		ptp_clock_adjust(clk, nanosecond_diff);
+#endif
 	}
 }
 #endif /* CONFIG_NET_GPTP_USE_DEFAULT_CLOCK_UPDATE */
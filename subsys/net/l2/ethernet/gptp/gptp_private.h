@@ -101,6 +101,14 @@ void gptp_update_sync_interval(int port, int8_t log_val);
 
 void gptp_update_announce_interval(int port, int8_t log_val);
 
+/**
+ * @brief Run the state machines without waiting for their next period.
+ *
+ * Used when an event the state machines wait for, like the TX timestamp
+ * of a Sync, is available.
+ */
+void gptp_wakeup(void);
+
 /**
  * @brief Convert a ptp timestamp to nanoseconds.
  *
@@ -368,6 +368,37 @@ struct gptp_site_sync_sync_state {
 	bool rcvd_pss;
 };
 
+/* Offset of the local clock to the grandmaster, and its servo. */
+struct gptp_clk_servo {
+	/** Frequency correction of the integral term, in ppb. */
+	double drift;
+
+	/** Frequency correction given to the local clock, in ppb. */
+	double applied;
+
+	/** Average of the absolute offsets, in ns. */
+	double offset_avg;
+
+	/** Average of the offset change between two samples, in ns. */
+	double jitter;
+
+	/** Last offset to the grandmaster, in ns. */
+	int32_t offset;
+
+	/** Smallest and largest offsets since the last clock step, in ns. */
+	int32_t offset_min;
+	int32_t offset_max;
+
+	/** Number of offsets used since the last clock step. */
+	uint32_t samples;
+
+	/** Number of offsets discarded as outliers. */
+	uint32_t outliers;
+
+	/** Number of outliers in a row. */
+	uint8_t outliers_in_row;
+};
+
 /* ClockSlaveSync state machine variables. */
 struct gptp_clk_slave_sync_state {
 	/** Pointer to the PortSyncSync structure received. */
@@ -381,6 +412,11 @@ struct gptp_clk_slave_sync_state {
 
 	/** The local clock has expired. */
 	bool rcvd_local_clk_tick;
+
+#if defined(CONFIG_NET_GPTP_USE_DEFAULT_CLOCK_UPDATE)
+	/** Servo of the local clock. */
+	struct gptp_clk_servo servo;
+#endif
 };
 
 /* ClockMasterSyncOffset state machine variables. */
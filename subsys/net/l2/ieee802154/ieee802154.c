@@ -29,6 +29,7 @@ LOG_MODULE_REGISTER(net_ieee802154, CONFIG_NET_L2_IEEE802154_LOG_LEVEL);
 
 #define BUF_TIMEOUT K_MSEC(50)
 
+#if !defined(CONFIG_NET_L2_IEEE802154_TX_QUEUE)
 /* No need to hold space for the FCS */
 static uint8_t frame_buffer_data[IEEE802154_MTU - 2];
 
@@ -38,6 +39,22 @@ static struct net_buf frame_buf = {
 	.frags = NULL,
 	.__buf = frame_buffer_data,
 };
+#else
+struct ieee802154_tx_frame {
+	struct net_pkt *pkt;
+	bool first;
+};
+
+/* No need to hold space for the FCS */
+NET_BUF_POOL_DEFINE(tx_frame_pool, CONFIG_NET_L2_IEEE802154_TX_QUEUE_SIZE,
+		    IEEE802154_MTU - 2, 0, NULL);
+
+/* Indexed by the id of the frame buffer */
+static struct ieee802154_tx_frame tx_frames[
+	CONFIG_NET_L2_IEEE802154_TX_QUEUE_SIZE];
+
+static K_FIFO_DEFINE(tx_queue);
+#endif
 
 #define PKT_TITLE      "IEEE 802.15.4 packet content:"
 #define TX_PKT_TITLE   "> " PKT_TITLE
@@ -214,12 +231,80 @@ static enum net_verdict ieee802154_recv(struct net_if *iface,
 
 }
 
+static int ieee802154_send_frame(struct net_if *iface, struct net_pkt *pkt,
+				 struct net_buf *frame, bool burst)
+{
+	struct ieee802154_context *ctx = net_if_l2_data(iface);
+	int ret;
+
+	ctx->tx_burst = burst;
+
+	if (IS_ENABLED(CONFIG_NET_L2_IEEE802154_RADIO_CSMA_CA) &&
+	    ieee802154_get_hw_capabilities(iface) & IEEE802154_HW_CSMA) {
+		ret = ieee802154_tx(iface, IEEE802154_TX_MODE_CSMA_CA,
+				    pkt, frame);
+	} else {
+		ret = ieee802154_radio_send(iface, pkt, frame);
+	}
+
+	ctx->tx_burst = false;
+
+	return ret;
+}
+
+#if defined(CONFIG_NET_L2_IEEE802154_TX_QUEUE)
+static void tx_queue_thread(void *p1, void *p2, void *p3)
+{
+	struct net_pkt *failed = NULL;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (1) {
+		struct ieee802154_tx_frame *meta;
+		struct net_buf *frame;
+		int ret;
+
+		frame = net_buf_get(&tx_queue, K_FOREVER);
+		meta = &tx_frames[net_buf_id(frame)];
+
+		if (meta->first && meta->pkt == failed) {
+			failed = NULL;
+		}
+
+		/* Once a fragment is lost, the datagram cannot be
+		 * reassembled, so its next fragments are dropped.
+		 */
+		if (meta->pkt != failed) {
+			ret = ieee802154_send_frame(net_pkt_iface(meta->pkt),
+						    meta->pkt, frame,
+						    !meta->first);
+			if (ret) {
+				NET_DBG("Cannot send frame of pkt %p (%d)",
+					meta->pkt, ret);
+				failed = meta->pkt;
+			}
+		}
+
+		net_pkt_unref(meta->pkt);
+		net_buf_unref(frame);
+	}
+}
+
+K_THREAD_DEFINE(ieee802154_tx_tid, CONFIG_NET_L2_IEEE802154_TX_QUEUE_STACK_SIZE,
+		tx_queue_thread, NULL, NULL, NULL,
+		K_PRIO_COOP(CONFIG_NET_L2_IEEE802154_TX_QUEUE_PRIORITY), 0, 0);
+#endif /* CONFIG_NET_L2_IEEE802154_TX_QUEUE */
+
 static int ieee802154_send(struct net_if *iface, struct net_pkt *pkt)
 {
 	struct ieee802154_context *ctx = net_if_l2_data(iface);
 	struct ieee802154_fragment_ctx f_ctx;
+	struct net_buf *frame;
 	struct net_buf *buf;
 	uint8_t ll_hdr_size;
+	bool first = true;
 	bool fragment;
 	int len;
 
@@ -242,46 +327,56 @@ static int ieee802154_send(struct net_if *iface, struct net_pkt *pkt)
 	ieee802154_fragment_ctx_init(&f_ctx, pkt, len, true);
 
 	len = 0;
-	frame_buf.len = 0U;
 	buf = pkt->buffer;
 
 	while (buf) {
+#if defined(CONFIG_NET_L2_IEEE802154_TX_QUEUE)
+		struct ieee802154_tx_frame *meta;
+
+		/* Waits for the radio when the queue is full */
+		frame = net_buf_alloc(&tx_frame_pool, K_FOREVER);
+#else
 		int ret;
 
-		net_buf_add(&frame_buf, ll_hdr_size);
+		frame = &frame_buf;
+		frame->len = 0U;
+#endif
+
+		net_buf_add(frame, ll_hdr_size);
 
 		if (fragment) {
-			ieee802154_fragment(&f_ctx, &frame_buf, true);
+			ieee802154_fragment(&f_ctx, frame, true);
 			buf = f_ctx.buf;
 		} else {
-			memcpy(frame_buf.data + frame_buf.len,
+			memcpy(frame->data + frame->len,
 			       buf->data, buf->len);
-			net_buf_add(&frame_buf, buf->len);
+			net_buf_add(frame, buf->len);
 			buf = buf->frags;
 		}
 
 		if (!ieee802154_create_data_frame(ctx, net_pkt_lladdr_dst(pkt),
-						  &frame_buf, ll_hdr_size)) {
+						  frame, ll_hdr_size)) {
+#if defined(CONFIG_NET_L2_IEEE802154_TX_QUEUE)
+			net_buf_unref(frame);
+#endif
 			return -EINVAL;
 		}
 
-		if (IS_ENABLED(CONFIG_NET_L2_IEEE802154_RADIO_CSMA_CA) &&
-		    ieee802154_get_hw_capabilities(iface) &
-		    IEEE802154_HW_CSMA) {
-			ret = ieee802154_tx(iface, IEEE802154_TX_MODE_CSMA_CA,
-					    pkt, &frame_buf);
-		} else {
-			ret = ieee802154_radio_send(iface, pkt, &frame_buf);
-		}
+		len += frame->len;
 
+#if defined(CONFIG_NET_L2_IEEE802154_TX_QUEUE)
+		meta = &tx_frames[net_buf_id(frame)];
+		meta->pkt = net_pkt_ref(pkt);
+		meta->first = first;
+
+		net_buf_put(&tx_queue, frame);
+#else
+		ret = ieee802154_send_frame(iface, pkt, frame, !first);
 		if (ret) {
 			return ret;
 		}
-
-		len += frame_buf.len;
-
-		/* Reinitializing frame_buf */
-		frame_buf.len = 0U;
+#endif
+		first = false;
 	}
 
 	net_pkt_unref(pkt);
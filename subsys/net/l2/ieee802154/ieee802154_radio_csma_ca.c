@@ -35,6 +35,12 @@ static inline int csma_ca_radio_send(struct net_if *iface,
 
 	NET_DBG("frag %p", frag);
 
+	/* The next fragments of a datagram start with a CCA */
+	if (IS_ENABLED(CONFIG_NET_L2_IEEE802154_RADIO_CSMA_CA_BURST) &&
+	    ctx->tx_burst) {
+		be = 0U;
+	}
+
 loop:
 	while (retries) {
 		retries--;
@@ -240,22 +240,15 @@ static void ot_receive_handler(otMessage *aMessage, void *context)
 		net_pkt_hexdump(pkt, "Received IPv6 packet");
 	}
 
-	if (!pkt_list_is_full(ot_context)) {
-		if (pkt_list_add(ot_context, pkt) != 0) {
-			NET_ERR("pkt_list_add failed");
-			goto out;
-		}
-
-		if (net_recv_data(ot_context->iface, pkt) < 0) {
-			NET_ERR("net_recv_data failed");
-			pkt_list_remove_first(ot_context);
-			goto out;
-		}
+	/* Let openthread_recv() pass the packet on to the upper layers */
+	net_pkt_set_l2_processed(pkt, true);
 
-		pkt = NULL;
-	} else {
-		NET_INFO("Packet list is full");
+	if (net_recv_data(ot_context->iface, pkt) < 0) {
+		NET_ERR("net_recv_data failed");
+		goto out;
 	}
+
+	pkt = NULL;
 out:
 	if (pkt) {
 		net_pkt_unref(pkt);
@@ -298,10 +291,7 @@ static void openthread_process(struct k_work *work)
 static enum net_verdict openthread_recv(struct net_if *iface,
 					struct net_pkt *pkt)
 {
-	struct openthread_context *ot_context = net_if_l2_data(iface);
-
-	if (pkt_list_peek(ot_context) == pkt) {
-		pkt_list_remove_last(ot_context);
+	if (net_pkt_is_l2_processed(pkt)) {
 		NET_DBG("Got injected Ip6 packet, sending to upper layers");
 
 		if (IS_ENABLED(CONFIG_OPENTHREAD_L2_DEBUG_DUMP_IPV6)) {
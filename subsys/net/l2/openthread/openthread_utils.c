@@ -35,71 +35,6 @@ static bool is_mesh_local(struct openthread_context *context,
 	return (memcmp(address, ml_prefix->m8, sizeof(ml_prefix)) == 0);
 }
 
-int pkt_list_add(struct openthread_context *context, struct net_pkt *pkt)
-{
-	uint16_t i_idx = context->pkt_list_in_idx;
-
-	if (context->pkt_list_full) {
-		return -ENOMEM;
-	}
-
-	i_idx++;
-	if (i_idx == CONFIG_OPENTHREAD_PKT_LIST_SIZE) {
-		i_idx = 0U;
-	}
-
-	if (i_idx == context->pkt_list_out_idx) {
-		context->pkt_list_full = 1U;
-	}
-
-	context->pkt_list[context->pkt_list_in_idx].pkt = pkt;
-	context->pkt_list_in_idx = i_idx;
-
-	return 0;
-}
-
-void pkt_list_remove_first(struct openthread_context *context)
-{
-	uint16_t idx = context->pkt_list_in_idx;
-
-	if (idx == 0U) {
-		idx = CONFIG_OPENTHREAD_PKT_LIST_SIZE - 1;
-	} else {
-		idx--;
-	}
-	context->pkt_list_in_idx = idx;
-
-	if (context->pkt_list_full) {
-		context->pkt_list_full = 0U;
-	}
-}
-
-struct net_pkt *pkt_list_peek(struct openthread_context *context)
-{
-	if ((context->pkt_list_in_idx == context->pkt_list_out_idx) &&
-	    (!context->pkt_list_full)) {
-
-		return NULL;
-	}
-	return context->pkt_list[context->pkt_list_out_idx].pkt;
-}
-
-void pkt_list_remove_last(struct openthread_context *context)
-{
-	if ((context->pkt_list_in_idx == context->pkt_list_out_idx) &&
-	    (!context->pkt_list_full)) {
-
-		return;
-	}
-
-	context->pkt_list_out_idx++;
-	if (context->pkt_list_out_idx == CONFIG_OPENTHREAD_PKT_LIST_SIZE) {
-		context->pkt_list_out_idx = 0U;
-	}
-
-	context->pkt_list_full = 0U;
-}
-
 void add_ipv6_addr_to_zephyr(struct openthread_context *context)
 {
 	const otNetifAddress *address;
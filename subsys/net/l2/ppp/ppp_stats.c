@@ -17,6 +17,27 @@ LOG_MODULE_REGISTER(net_ppp_stats, CONFIG_NET_L2_PPP_LOG_LEVEL);
 
 #if defined(CONFIG_NET_STATISTICS_USER_API)
 
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+/* Add the per CPU counters of the L2 to the statistics of the driver */
+static void ppp_stats_add_cpu(struct net_if *iface,
+			      struct net_stats_ppp *stats)
+{
+	const struct ppp_context *ctx = net_if_l2_data(iface);
+	int i;
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		const struct net_stats_ppp *cpu = &ctx->stats_cpu[i].stats;
+
+		stats->bytes.sent += cpu->bytes.sent;
+		stats->bytes.received += cpu->bytes.received;
+		stats->pkts.tx += cpu->pkts.tx;
+		stats->pkts.rx += cpu->pkts.rx;
+		stats->drop += cpu->drop;
+		stats->chkerr += cpu->chkerr;
+	}
+}
+#endif
+
 static int ppp_stats_get(uint32_t mgmt_request, struct net_if *iface,
 			 void *data, size_t len)
 {
@@ -45,6 +66,10 @@ static int ppp_stats_get(uint32_t mgmt_request, struct net_if *iface,
 
 	memcpy(data, src, len);
 
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+	ppp_stats_add_cpu(iface, data);
+#endif
+
 	return 0;
 }
 
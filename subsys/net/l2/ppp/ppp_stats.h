@@ -13,114 +13,73 @@
 #include <net/net_stats.h>
 #include <net/net_if.h>
 
-static inline void ppp_stats_update_bytes_rx(struct net_if *iface,
-					     uint32_t bytes)
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+/* The counters are updated in the copy of the current CPU kept in the
+ * PPP context, and added to the statistics of the driver when these are
+ * read.
+ */
+#define UPDATE_PPP_STAT(_iface, _cmd)					\
+	{								\
+		struct ppp_context *_ctx = net_if_l2_data(_iface);	\
+		unsigned int _key = arch_irq_lock();			\
+									\
+		(_ctx->stats_cpu[NET_STATS_CPU_ID()].stats._cmd);	\
+		arch_irq_unlock(_key);					\
+	}
+#else
+static inline struct net_stats_ppp *ppp_stats_get_driver(struct net_if *iface)
 {
 	const struct ppp_api *api = (const struct ppp_api *)
 		net_if_get_device(iface)->api;
-	struct net_stats_ppp *stats;
 
 	if (!api->get_stats) {
-		return;
+		return NULL;
 	}
 
-	stats = api->get_stats(net_if_get_device(iface));
-	if (!stats) {
-		return;
+	return api->get_stats(net_if_get_device(iface));
+}
+
+#define UPDATE_PPP_STAT(_iface, _cmd)					\
+	{								\
+		struct net_stats_ppp *_stats =				\
+			ppp_stats_get_driver(_iface);			\
+									\
+		if (_stats) {						\
+			(_stats->_cmd);					\
+		}							\
 	}
+#endif /* CONFIG_NET_STATISTICS_PER_CPU */
 
-	stats->bytes.received += bytes;
+static inline void ppp_stats_update_bytes_rx(struct net_if *iface,
+					     uint32_t bytes)
+{
+	UPDATE_PPP_STAT(iface, bytes.received += bytes);
 }
 
 static inline void ppp_stats_update_bytes_tx(struct net_if *iface,
 					     uint32_t bytes)
 {
-	const struct ppp_api *api = (const struct ppp_api *)
-		net_if_get_device(iface)->api;
-	struct net_stats_ppp *stats;
-
-	if (!api->get_stats) {
-		return;
-	}
-
-	stats = api->get_stats(net_if_get_device(iface));
-	if (!stats) {
-		return;
-	}
-
-	stats->bytes.sent += bytes;
+	UPDATE_PPP_STAT(iface, bytes.sent += bytes);
 }
 
 static inline void ppp_stats_update_pkts_rx(struct net_if *iface)
 {
-	const struct ppp_api *api = (const struct ppp_api *)
-		net_if_get_device(iface)->api;
-	struct net_stats_ppp *stats;
-
-	if (!api->get_stats) {
-		return;
-	}
-
-	stats = api->get_stats(net_if_get_device(iface));
-	if (!stats) {
-		return;
-	}
-
-	stats->pkts.rx++;
+	UPDATE_PPP_STAT(iface, pkts.rx++);
 }
 
 static inline void ppp_stats_update_pkts_tx(struct net_if *iface)
 {
-	const struct ppp_api *api = (const struct ppp_api *)
-		net_if_get_device(iface)->api;
-	struct net_stats_ppp *stats;
-
-	if (!api->get_stats) {
-		return;
-	}
-
-	stats = api->get_stats(net_if_get_device(iface));
-	if (!stats) {
-		return;
-	}
-
-	stats->pkts.tx++;
+	UPDATE_PPP_STAT(iface, pkts.tx++);
 }
 
 static inline void ppp_stats_update_drop_rx(struct net_if *iface)
 {
-	const struct ppp_api *api = ((const struct ppp_api *)
-		net_if_get_device(iface)->api);
-	struct net_stats_ppp *stats;
-
-	if (!api->get_stats) {
-		return;
-	}
-
-	stats = api->get_stats(net_if_get_device(iface));
-	if (!stats) {
-		return;
-	}
-
-	stats->drop++;
+	UPDATE_PPP_STAT(iface, drop++);
 }
 
 static inline void ppp_stats_update_fcs_error_rx(struct net_if *iface)
 {
-	const struct ppp_api *api = ((const struct ppp_api *)
-		net_if_get_device(iface)->api);
-	struct net_stats_ppp *stats;
-
-	if (!api->get_stats) {
-		return;
-	}
-
-	stats = api->get_stats(net_if_get_device(iface));
-	if (!stats) {
-		return;
-	}
-
-	stats->chkerr++;
+	UPDATE_PPP_STAT(iface, chkerr++);
 }
 
 #else /* CONFIG_NET_STATISTICS_PPP */
@@ -10,6 +10,7 @@ LOG_MODULE_REGISTER(net_capture, CONFIG_NET_CAPTURE_LOG_LEVEL);
 #include <zephyr.h>
 #include <stdlib.h>
 #include <sys/slist.h>
+#include <sys/ring_buffer.h>
 #include <net/net_core.h>
 #include <net/net_ip.h>
 #include <net/net_if.h>
@@ -50,6 +51,14 @@ NET_BUF_POOL_VAR_DEFINE(capture_bufs, CONFIG_NET_CAPTURE_BUF_COUNT,
 
 static sys_slist_t net_capture_devlist;
 
+/* pcap packet record header, in network byte order */
+struct pcap_rec_hdr {
+	uint32_t ts_sec;
+	uint32_t ts_usec;
+	uint32_t incl_len;
+	uint32_t orig_len;
+};
+
 struct net_capture {
 	sys_snode_t node;
 
@@ -83,6 +92,54 @@ struct net_capture {
 	 */
 	struct sockaddr local;
 
+	/**
+	 * Rules a packet must match to be captured.
+	 */
+	struct net_capture_filter filter[CONFIG_NET_CAPTURE_FILTER_COUNT];
+	int filter_count;
+
+	/**
+	 * Number of packets captured, and dropped because there was no
+	 * room for them.
+	 */
+	uint32_t captured;
+	uint32_t dropped;
+
+#if defined(CONFIG_NET_CAPTURE_RING)
+	/**
+	 * Ring buffer of pcap records, waiting to be sent.
+	 */
+	struct ring_buf ring;
+	uint8_t ring_data[CONFIG_NET_CAPTURE_RING_SIZE];
+
+	/**
+	 * Header of the next record, taken from the ring buffer but not
+	 * sent yet as it did not fit in the previous datagram.
+	 */
+	struct pcap_rec_hdr next_rec;
+	bool has_next_rec;
+
+	/**
+	 * Sends the records in the ring buffer.
+	 */
+	struct k_work_delayable flush;
+
+	/**
+	 * Max length captured of each packet, 0 if no limit.
+	 */
+	uint16_t snaplen;
+
+	/**
+	 * Max length of the records sent in one datagram.
+	 */
+	uint16_t batch_len;
+#endif
+
+	/**
+	 * Are the packets stored in the ring buffer?
+	 */
+	bool is_ring : 1;
+
 	/**
 	 * Is this context setup already
 	 */
@@ -129,7 +186,10 @@ void net_capture_foreach(net_capture_cb_t cb, void *user_data)
 		info.tunnel_iface = ctx->tunnel_iface;
 		info.peer = &ctx->peer;
 		info.local = &ctx->local;
+		info.captured = ctx->captured;
+		info.dropped = ctx->dropped;
 		info.is_enabled = ctx->is_enabled;
+		info.is_ring = ctx->is_ring;
 
 		k_mutex_unlock(&lock);
 		cb(&info, user_data);
@@ -462,6 +522,8 @@ static int capture_cleanup(const struct device *dev)
 	(void)cleanup_iface(ctx->tunnel_iface, &ctx->local);
 
 	ctx->tunnel_iface = NULL;
+	ctx->filter_count = 0;
+	ctx->is_ring = false;
 	ctx->in_use = false;
 
 	return 0;
@@ -504,11 +566,236 @@ static int capture_disable(const struct device *dev)
 	ctx->capture_iface = NULL;
 	ctx->is_enabled = false;
 
+#if defined(CONFIG_NET_CAPTURE_RING)
+	/* The records left cannot be sent once the tunnel is down */
+	k_mutex_lock(&lock, K_FOREVER);
+
+	(void)k_work_cancel_delayable(&ctx->flush);
+	ring_buf_reset(&ctx->ring);
+	ctx->has_next_rec = false;
+
+	k_mutex_unlock(&lock);
+#endif
+
 	net_if_down(ctx->tunnel_iface);
 
 	return 0;
 }
 
+static int capture_set_filter(const struct device *dev,
+			      const struct net_capture_filter *filter,
+			      int count)
+{
+	struct net_capture *ctx = DEV_DATA(dev);
+	int i;
+
+	if (count < 0 || count > CONFIG_NET_CAPTURE_FILTER_COUNT ||
+	    (count > 0 && filter == NULL)) {
+		return -EINVAL;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (filter[i].len != 1 && filter[i].len != 2 &&
+		    filter[i].len != 4) {
+			return -EINVAL;
+		}
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	memcpy(ctx->filter, filter, count * sizeof(*filter));
+	ctx->filter_count = count;
+
+	k_mutex_unlock(&lock);
+
+	return 0;
+}
+
+static int capture_set_ring(const struct device *dev, bool enable,
+			    uint16_t snaplen)
+{
+#if defined(CONFIG_NET_CAPTURE_RING)
+	struct net_capture *ctx = DEV_DATA(dev);
+	int hdr_len;
+	int ret = 0;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (!ctx->in_use) {
+		ret = -ENOENT;
+		goto out;
+	}
+
+	if (ctx->is_enabled) {
+		ret = -EBUSY;
+		goto out;
+	}
+
+	if (ctx->local.sa_family == AF_INET) {
+		hdr_len = sizeof(struct net_ipv4_hdr);
+	} else {
+		hdr_len = sizeof(struct net_ipv6_hdr);
+	}
+
+	/* The datagram and its outer IP header must fit in the MTU */
+	ctx->batch_len = net_if_get_mtu(ctx->tunnel_iface) - 2 * hdr_len -
+			 sizeof(struct net_udp_hdr);
+	ctx->snaplen = snaplen;
+	ctx->is_ring = enable;
+
+	ring_buf_reset(&ctx->ring);
+	ctx->has_next_rec = false;
+
+out:
+	k_mutex_unlock(&lock);
+
+	return ret;
+#else
+	ARG_UNUSED(dev);
+	ARG_UNUSED(enable);
+	ARG_UNUSED(snaplen);
+
+	return -ENOTSUP;
+#endif
+}
+
+static bool filter_match(struct net_capture *ctx, struct net_pkt *pkt)
+{
+	bool overwrite = net_pkt_is_being_overwritten(pkt);
+	struct net_pkt_cursor backup;
+	bool match = true;
+	int i;
+
+	if (ctx->filter_count == 0) {
+		return true;
+	}
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_set_overwrite(pkt, true);
+
+	for (i = 0; i < ctx->filter_count && match; i++) {
+		struct net_capture_filter *rule = &ctx->filter[i];
+		uint8_t field[4];
+		uint32_t value = 0U;
+		int j;
+
+		net_pkt_cursor_init(pkt);
+
+		/* A packet too short for the field does not match */
+		if (net_pkt_skip(pkt, rule->offset) ||
+		    net_pkt_read(pkt, field, rule->len)) {
+			match = false;
+			break;
+		}
+
+		for (j = 0; j < rule->len; j++) {
+			value = (value << 8) | field[j];
+		}
+
+		match = ((value & rule->mask) ==
+			 (rule->value & rule->mask)) != rule->negate;
+	}
+
+	net_pkt_cursor_restore(pkt, &backup);
+	net_pkt_set_overwrite(pkt, overwrite);
+
+	return match;
+}
+
+#if defined(CONFIG_NET_CAPTURE_RING)
+/* Copy the packet to the ring buffer as a pcap record */
+static int ring_put(struct net_capture *ctx, struct net_pkt *pkt)
+{
+	uint64_t usec = k_ticks_to_us_floor64(k_uptime_ticks());
+	size_t len = net_pkt_get_len(pkt);
+	struct net_pkt_cursor backup;
+	struct pcap_rec_hdr hdr;
+	uint32_t claimed;
+	uint8_t *data;
+	size_t incl;
+
+	incl = MIN(len, ctx->batch_len - sizeof(hdr));
+	if (ctx->snaplen > 0) {
+		incl = MIN(incl, ctx->snaplen);
+	}
+
+	if (ring_buf_space_get(&ctx->ring) < sizeof(hdr) + incl) {
+		return -ENOBUFS;
+	}
+
+	hdr.ts_sec = htonl(usec / USEC_PER_SEC);
+	hdr.ts_usec = htonl(usec % USEC_PER_SEC);
+	hdr.incl_len = htonl(incl);
+	hdr.orig_len = htonl(len);
+
+	(void)ring_buf_put(&ctx->ring, (uint8_t *)&hdr, sizeof(hdr));
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+
+	while (incl > 0) {
+		claimed = ring_buf_put_claim(&ctx->ring, &data, incl);
+		(void)net_pkt_read(pkt, data, claimed);
+		(void)ring_buf_put_finish(&ctx->ring, claimed);
+
+		incl -= claimed;
+	}
+
+	net_pkt_cursor_restore(pkt, &backup);
+
+	/* Send at once if a datagram can be filled, otherwise give some
+	 * time for more packets to come.
+	 */
+	if (ring_buf_capacity_get(&ctx->ring) -
+	    ring_buf_space_get(&ctx->ring) >= ctx->batch_len) {
+		(void)k_work_reschedule(&ctx->flush, K_NO_WAIT);
+	} else {
+		(void)k_work_schedule(&ctx->flush,
+				      K_MSEC(CONFIG_NET_CAPTURE_RING_FLUSH_TIME));
+	}
+
+	return 0;
+}
+
+/* Move as many records as fit from the ring buffer to the datagram */
+static void ring_get_batch(struct net_capture *ctx, struct net_pkt *pkt)
+{
+	size_t len = 0;
+	uint32_t claimed;
+	uint8_t *data;
+	size_t incl;
+
+	while (true) {
+		if (!ctx->has_next_rec) {
+			if (ring_buf_get(&ctx->ring, (uint8_t *)&ctx->next_rec,
+					 sizeof(ctx->next_rec)) == 0) {
+				break;
+			}
+
+			ctx->has_next_rec = true;
+		}
+
+		incl = ntohl(ctx->next_rec.incl_len);
+		if (len + sizeof(ctx->next_rec) + incl > ctx->batch_len) {
+			break;
+		}
+
+		(void)net_pkt_write(pkt, &ctx->next_rec, sizeof(ctx->next_rec));
+		ctx->has_next_rec = false;
+
+		len += sizeof(ctx->next_rec) + incl;
+
+		while (incl > 0) {
+			claimed = ring_buf_get_claim(&ctx->ring, &data, incl);
+			(void)net_pkt_write(pkt, data, claimed);
+			(void)ring_buf_get_finish(&ctx->ring, claimed);
+
+			incl -= claimed;
+		}
+	}
+}
+#endif /* CONFIG_NET_CAPTURE_RING */
+
 void net_capture_pkt(struct net_if *iface, struct net_pkt *pkt)
 {
 	struct k_mem_slab *orig_slab;
@@ -534,6 +821,25 @@ void net_capture_pkt(struct net_if *iface, struct net_pkt *pkt)
 			continue;
 		}
 
+		if (!filter_match(ctx, pkt)) {
+			goto out;
+		}
+
+#if defined(CONFIG_NET_CAPTURE_RING)
+		if (ctx->is_ring) {
+			if (ring_put(ctx, pkt) < 0) {
+				NET_DBG("Captured pkt %s", "dropped");
+				ctx->dropped++;
+				goto out;
+			}
+
+			net_pkt_set_captured(pkt, true);
+			ctx->captured++;
+
+			goto out;
+		}
+#endif
+
 		orig_slab = pkt->slab;
 		pkt->slab = get_net_pkt();
 
@@ -543,7 +849,7 @@ void net_capture_pkt(struct net_if *iface, struct net_pkt *pkt)
 
 		if (captured == NULL) {
 			NET_DBG("Captured pkt %s", "dropped");
-			/* TODO: update capture data statistics */
+			ctx->dropped++;
 			goto out;
 		}
 
@@ -554,6 +860,9 @@ void net_capture_pkt(struct net_if *iface, struct net_pkt *pkt)
 		ret = net_capture_send(ctx->dev, ctx->tunnel_iface, captured);
 		if (ret < 0) {
 			net_pkt_unref(captured);
+			ctx->dropped++;
+		} else {
+			ctx->captured++;
 		}
 
 		goto out;
@@ -563,40 +872,19 @@ out:
 	k_mutex_unlock(&lock);
 }
 
-static int capture_dev_init(const struct device *dev)
-{
-	struct net_capture *ctx = DEV_DATA(dev);
-
-	k_mutex_lock(&lock, K_FOREVER);
-
-	sys_slist_find_and_remove(&net_capture_devlist, &ctx->node);
-	sys_slist_prepend(&net_capture_devlist, &ctx->node);
-
-	ctx->dev = dev;
-	ctx->init_done = true;
-
-	k_mutex_unlock(&lock);
-
-	return 0;
-}
-
-static int capture_send(const struct device *dev, struct net_if *iface,
-			struct net_pkt *pkt)
+/* Allocate a datagram to the tunnel peer, with room for len bytes of data
+ * after the IP and UDP headers.
+ */
+static int tunnel_pkt_alloc(struct net_capture *ctx, size_t len,
+			    struct net_pkt **ret_pkt)
 {
-	struct net_capture *ctx = DEV_DATA(dev);
-	enum net_verdict verdict;
 	struct net_pkt *ip;
 	int ret;
-	int len;
-
-	if (!ctx->in_use) {
-		return -ENOENT;
-	}
 
 	if (ctx->local.sa_family == AF_INET) {
-		len = sizeof(struct net_ipv4_hdr);
+		len += sizeof(struct net_ipv4_hdr);
 	} else if (ctx->local.sa_family == AF_INET6) {
-		len = sizeof(struct net_ipv6_hdr);
+		len += sizeof(struct net_ipv6_hdr);
 	} else {
 		return -EINVAL;
 	}
@@ -638,10 +926,16 @@ static int capture_send(const struct device *dev, struct net_if *iface,
 	(void)net_udp_create(ip, net_sin(&ctx->local)->sin_port,
 			     net_sin(&ctx->peer)->sin_port);
 
-	net_buf_frag_add(ip->buffer, pkt->buffer);
-	pkt->buffer = ip->buffer;
-	ip->buffer = NULL;
-	net_pkt_unref(ip);
+	*ret_pkt = ip;
+
+	return 0;
+}
+
+/* Finalize the datagram and send it through the tunnel */
+static int tunnel_pkt_send(struct net_capture *ctx, struct net_pkt *pkt)
+{
+	enum net_verdict verdict;
+	int ret = 0;
 
 	/* Clear the context if it was set as the pkt was cloned and we
 	 * do not want to affect the original pkt.
@@ -685,12 +979,96 @@ static int capture_send(const struct device *dev, struct net_if *iface,
 	return ret;
 }
 
+#if defined(CONFIG_NET_CAPTURE_RING)
+static void ring_flush(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct net_capture *ctx = CONTAINER_OF(dwork, struct net_capture,
+					       flush);
+	struct net_pkt *pkt;
+	bool pending;
+
+	while (true) {
+		k_mutex_lock(&lock, K_FOREVER);
+		pending = ctx->is_enabled && (ctx->has_next_rec ||
+					      !ring_buf_is_empty(&ctx->ring));
+		k_mutex_unlock(&lock);
+
+		if (!pending) {
+			return;
+		}
+
+		if (tunnel_pkt_alloc(ctx, ctx->batch_len, &pkt) < 0) {
+			(void)k_work_schedule(dwork,
+				K_MSEC(CONFIG_NET_CAPTURE_RING_FLUSH_TIME));
+			return;
+		}
+
+		k_mutex_lock(&lock, K_FOREVER);
+		ring_get_batch(ctx, pkt);
+		k_mutex_unlock(&lock);
+
+		if (tunnel_pkt_send(ctx, pkt) < 0) {
+			net_pkt_unref(pkt);
+		}
+	}
+}
+#endif /* CONFIG_NET_CAPTURE_RING */
+
+static int capture_send(const struct device *dev, struct net_if *iface,
+			struct net_pkt *pkt)
+{
+	struct net_capture *ctx = DEV_DATA(dev);
+	struct net_pkt *ip;
+	int ret;
+
+	if (!ctx->in_use) {
+		return -ENOENT;
+	}
+
+	ret = tunnel_pkt_alloc(ctx, 0, &ip);
+	if (ret < 0) {
+		return ret;
+	}
+
+	net_buf_frag_add(ip->buffer, pkt->buffer);
+	pkt->buffer = ip->buffer;
+	ip->buffer = NULL;
+	net_pkt_unref(ip);
+
+	return tunnel_pkt_send(ctx, pkt);
+}
+
+static int capture_dev_init(const struct device *dev)
+{
+	struct net_capture *ctx = DEV_DATA(dev);
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	sys_slist_find_and_remove(&net_capture_devlist, &ctx->node);
+	sys_slist_prepend(&net_capture_devlist, &ctx->node);
+
+	ctx->dev = dev;
+	ctx->init_done = true;
+
+#if defined(CONFIG_NET_CAPTURE_RING)
+	ring_buf_init(&ctx->ring, sizeof(ctx->ring_data), ctx->ring_data);
+	k_work_init_delayable(&ctx->flush, ring_flush);
+#endif
+
+	k_mutex_unlock(&lock);
+
+	return 0;
+}
+
 static const struct net_capture_interface_api capture_interface_api = {
 	.cleanup = capture_cleanup,
 	.enable = capture_enable,
 	.disable = capture_disable,
 	.is_enabled = capture_is_enabled,
 	.send = capture_send,
+	.set_filter = capture_set_filter,
+	.set_ring = capture_set_ring,
 };
 
 #define DEFINE_NET_CAPTURE_DEV_DATA(x, _)				\
@@ -7,6 +7,7 @@
 #include <logging/log.h>
 LOG_MODULE_REGISTER(net_coap, CONFIG_COAP_LOG_LEVEL);
 
+#include <limits.h>
 #include <stdlib.h>
 #include <stddef.h>
 #include <string.h>
@@ -708,6 +709,9 @@ uint8_t coap_header_get_code(const struct coap_packet *cpkt)
 	case COAP_METHOD_POST:
 	case COAP_METHOD_PUT:
 	case COAP_METHOD_DELETE:
+	case COAP_METHOD_FETCH:
+	case COAP_METHOD_PATCH:
+	case COAP_METHOD_IPATCH:
 
 	/* All the defined response codes */
 	case COAP_RESPONSE_CODE_OK:
@@ -841,6 +845,22 @@ static bool is_request(const struct coap_packet *cpkt)
 	return !(code & ~COAP_REQUEST_MASK);
 }
 
+static int call_method(struct coap_resource *resource,
+		       struct coap_packet *cpkt,
+		       struct sockaddr *addr, socklen_t addr_len)
+{
+	coap_method_t method;
+	uint8_t code;
+
+	code = coap_header_get_code(cpkt);
+	method = method_from_code(resource, code);
+	if (!method) {
+		return -EPERM;
+	}
+
+	return method(resource, cpkt, addr, addr_len);
+}
+
 int coap_handle_request(struct coap_packet *cpkt,
 			struct coap_resource *resources,
 			struct coap_option *options,
@@ -855,26 +875,284 @@ int coap_handle_request(struct coap_packet *cpkt,
 
 	/* FIXME: deal with hierarchical resources */
 	for (resource = resources; resource && resource->path; resource++) {
-		coap_method_t method;
-		uint8_t code;
-
 		if (!uri_path_eq(cpkt, resource->path, options, opt_num)) {
 			continue;
 		}
 
-		code = coap_header_get_code(cpkt);
-		method = method_from_code(resource, code);
-		if (!method) {
-			return -EPERM;
-		}
-
-		return method(resource, cpkt, addr, addr_len);
+		return call_method(resource, cpkt, addr, addr_len);
 	}
 
 	NET_DBG("%d", __LINE__);
 	return -ENOENT;
 }
 
+static int segment_cmp(const char *a, uint16_t a_len,
+		       const char *b, uint16_t b_len)
+{
+	if (a_len != b_len) {
+		return a_len < b_len ? -1 : 1;
+	}
+
+	return memcmp(a, b, a_len);
+}
+
+static bool is_multi_level_wildcard(const char *segment)
+{
+	return IS_ENABLED(CONFIG_COAP_URI_WILDCARD) &&
+		segment[0] == '#' && segment[1] == '\0';
+}
+
+/* Only the completed levels of the trie can be searched. */
+static int index_child(const struct coap_resource_index *index,
+		       int parent, const char *segment, uint16_t len)
+{
+	const struct coap_resource_index_node *node = &index->nodes[parent];
+	int lo = node->first_child;
+	int hi = node->first_child + node->num_children;
+
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+		int cmp = segment_cmp(segment, len, index->nodes[mid].segment,
+				      index->nodes[mid].len);
+
+		if (cmp == 0) {
+			return mid;
+		}
+
+		if (cmp < 0) {
+			hi = mid;
+		} else {
+			lo = mid + 1;
+		}
+	}
+
+	return -1;
+}
+
+/* Node of the first depth segments of a resource path. A multi-level
+ * wildcard matches like a path ending with it.
+ */
+static int index_path_node(const struct coap_resource_index *index,
+			   const char * const *path, int depth)
+{
+	int node = 0;
+
+	for (int i = 0; i < depth && node >= 0 && path[i]; i++) {
+		node = index_child(index, node, path[i], strlen(path[i]));
+		if (is_multi_level_wildcard(path[i])) {
+			break;
+		}
+	}
+
+	return node;
+}
+
+static int index_add_child(struct coap_resource_index *index,
+			   size_t max_nodes, int parent, int level_end,
+			   const char *segment)
+{
+	struct coap_resource_index_node *nodes = index->nodes;
+	struct coap_resource_index_node *node = &nodes[parent];
+	uint16_t len = strlen(segment);
+	int pos;
+
+	for (pos = node->first_child;
+	     pos < node->first_child + node->num_children; pos++) {
+		int cmp = segment_cmp(segment, len, nodes[pos].segment,
+				      nodes[pos].len);
+
+		if (cmp == 0) {
+			return 0;
+		}
+
+		if (cmp < 0) {
+			break;
+		}
+	}
+
+	if (index->num_nodes >= max_nodes) {
+		return -ENOMEM;
+	}
+
+	/* The children of the next parents of the level move along. */
+	memmove(&nodes[pos + 1], &nodes[pos],
+		(index->num_nodes - pos) * sizeof(nodes[0]));
+	for (int i = parent + 1; i < level_end; i++) {
+		nodes[i].first_child++;
+	}
+
+	if (IS_ENABLED(CONFIG_COAP_URI_WILDCARD) && len == 1 &&
+	    (*segment == '+' || *segment == '#')) {
+		index->wildcards = true;
+	}
+
+	nodes[pos].segment = segment;
+	nodes[pos].len = len;
+	nodes[pos].first_child = 0U;
+	nodes[pos].num_children = 0U;
+	nodes[pos].resource = 0U;
+
+	node->num_children++;
+	index->num_nodes++;
+
+	return 0;
+}
+
+int coap_resource_index_init(struct coap_resource_index *index,
+			     struct coap_resource *resources,
+			     struct coap_resource_index_node *nodes,
+			     size_t max_nodes)
+{
+	struct coap_resource *resource;
+	int level_start = 0;
+	int level_end = 1;
+	int ret;
+
+	if (!index || !nodes || max_nodes == 0 || max_nodes > UINT16_MAX) {
+		return -EINVAL;
+	}
+
+	index->resources = resources;
+	index->nodes = nodes;
+	index->num_nodes = 1U;
+	index->wildcards = false;
+
+	(void)memset(&nodes[0], 0, sizeof(nodes[0]));
+
+	/* Built one level at a time, so that the children of a node are
+	 * next to each other and can be searched by bisection.
+	 */
+	for (int depth = 0; level_start < level_end; depth++) {
+		for (int i = level_start; i < level_end; i++) {
+			nodes[i].first_child = index->num_nodes;
+		}
+
+		for (resource = resources; resource && resource->path;
+		     resource++) {
+			int parent;
+
+			parent = index_path_node(index, resource->path, depth);
+			if (parent < level_start || !resource->path[depth] ||
+			    (depth > 0 &&
+			     is_multi_level_wildcard(resource->path[depth - 1]))) {
+				continue;
+			}
+
+			ret = index_add_child(index, max_nodes, parent,
+					      level_end, resource->path[depth]);
+			if (ret < 0) {
+				return ret;
+			}
+		}
+
+		level_start = level_end;
+		level_end = index->num_nodes;
+	}
+
+	/* The first resource of a path wins, as with a scan of the array. */
+	for (resource = resources; resource && resource->path; resource++) {
+		int node = index_path_node(index, resource->path, INT_MAX);
+
+		if (nodes[node].resource == 0U) {
+			nodes[node].resource = resource - resources + 1;
+		}
+	}
+
+	return 0;
+}
+
+static int next_uri_path(struct coap_option *options, uint8_t opt_num,
+			 int i)
+{
+	for (; i < opt_num; i++) {
+		if (options[i].delta == COAP_OPTION_URI_PATH) {
+			break;
+		}
+	}
+
+	return i;
+}
+
+/* Position of the matching resource plus one, the smallest one when
+ * several wildcards match.
+ */
+static uint16_t index_lookup(const struct coap_resource_index *index,
+			     int node, struct coap_option *options,
+			     uint8_t opt_num, int i)
+{
+	uint16_t best = 0U;
+	uint16_t found;
+	int child;
+
+	i = next_uri_path(options, opt_num, i);
+	if (i == opt_num) {
+		return index->nodes[node].resource;
+	}
+
+	child = index_child(index, node, (const char *)options[i].value,
+			    options[i].len);
+	if (child > 0) {
+		best = index_lookup(index, child, options, opt_num, i + 1);
+	}
+
+	if (!index->wildcards) {
+		return best;
+	}
+
+	child = index_child(index, node, "+", 1);
+	if (child > 0) {
+		found = index_lookup(index, child, options, opt_num, i + 1);
+		if (found && (!best || found < best)) {
+			best = found;
+		}
+	}
+
+	child = index_child(index, node, "#", 1);
+	if (child > 0) {
+		found = index->nodes[child].resource;
+		if (found && (!best || found < best)) {
+			best = found;
+		}
+	}
+
+	return best;
+}
+
+struct coap_resource *coap_resource_index_find(
+	const struct coap_resource_index *index,
+	struct coap_option *options, uint8_t opt_num)
+{
+	uint16_t found;
+
+	found = index_lookup(index, 0, options, opt_num, 0);
+	if (!found) {
+		return NULL;
+	}
+
+	return &index->resources[found - 1];
+}
+
+int coap_handle_request_index(struct coap_packet *cpkt,
+			      const struct coap_resource_index *index,
+			      struct coap_option *options,
+			      uint8_t opt_num,
+			      struct sockaddr *addr, socklen_t addr_len)
+{
+	struct coap_resource *resource;
+
+	if (!is_request(cpkt)) {
+		return 0;
+	}
+
+	resource = coap_resource_index_find(index, options, opt_num);
+	if (!resource) {
+		NET_DBG("%d", __LINE__);
+		return -ENOENT;
+	}
+
+	return call_method(resource, cpkt, addr, addr_len);
+}
+
 int coap_block_transfer_init(struct coap_block_context *ctx,
 			      enum coap_block_size block_size,
 			      size_t total_size)
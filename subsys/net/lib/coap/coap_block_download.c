@@ -0,0 +1,374 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_coap, CONFIG_COAP_LOG_LEVEL);
+
+#include <string.h>
+#include <errno.h>
+
+#include <sys/util.h>
+
+#include <net/net_core.h>
+#include <net/coap.h>
+#include <net/coap_block_download.h>
+
+#define SLOT_FREE     0
+#define SLOT_PENDING  1
+#define SLOT_RECEIVED 2
+
+#define NUM_UNKNOWN UINT32_MAX
+
+#define BLOCK_SZX(v)  ((v) & 0x07)
+#define BLOCK_MORE(v) (!!((v) & 0x08))
+#define BLOCK_NUM(v)  ((uint32_t)(v) >> 4)
+
+static inline uint16_t block_bytes(const struct coap_block_download *download)
+{
+	return coap_block_size_to_bytes(download->block_size);
+}
+
+static inline bool last_known(const struct coap_block_download *download)
+{
+	return download->last_num != NUM_UNKNOWN;
+}
+
+static struct coap_block_download_slot *find_slot(
+	struct coap_block_download *download, uint8_t state,
+	const uint8_t *token, uint8_t tkl)
+{
+	for (int i = 0; i < download->window; i++) {
+		struct coap_block_download_slot *slot = &download->slots[i];
+
+		if (slot->state != state) {
+			continue;
+		}
+
+		if (!token || (tkl == sizeof(slot->token) &&
+			       !memcmp(slot->token, token, tkl))) {
+			return slot;
+		}
+	}
+
+	return NULL;
+}
+
+static struct coap_block_download_slot *find_received(
+	struct coap_block_download *download, uint32_t num)
+{
+	for (int i = 0; i < download->window; i++) {
+		struct coap_block_download_slot *slot = &download->slots[i];
+
+		if (slot->state == SLOT_RECEIVED && slot->num == num) {
+			return slot;
+		}
+	}
+
+	return NULL;
+}
+
+static int send_request(struct coap_block_download *download,
+			struct coap_block_download_slot *slot, uint32_t num)
+{
+	struct coap_block_context block;
+	int r;
+
+	coap_block_transfer_init(&block, download->block_size,
+				 download->total_size);
+	block.current = (size_t)num * block_bytes(download);
+
+	memcpy(slot->token, coap_next_token(), sizeof(slot->token));
+	slot->num = num;
+	slot->len = 0U;
+	slot->state = SLOT_PENDING;
+
+	r = download->request(download, &block, slot->token,
+			      sizeof(slot->token), download->user_data);
+	if (r < 0) {
+		slot->state = SLOT_FREE;
+	}
+
+	return r;
+}
+
+/* Until the size of the resource is known, the end of the resource is only
+ * found with the last block, so the blocks are requested one at a time not
+ * to request past it.
+ */
+static int fill_window(struct coap_block_download *download)
+{
+	struct coap_block_download_slot *slot;
+	int r;
+
+	while (download->next_num < download->deliver_num + download->window) {
+		if (last_known(download) ?
+		    download->next_num > download->last_num :
+		    find_slot(download, SLOT_PENDING, NULL, 0) != NULL) {
+			break;
+		}
+
+		slot = find_slot(download, SLOT_FREE, NULL, 0);
+		if (!slot) {
+			break;
+		}
+
+		r = send_request(download, slot, download->next_num);
+		if (r < 0) {
+			return r;
+		}
+
+		download->next_num++;
+	}
+
+	return 0;
+}
+
+/* The server may choose a smaller block size in any response. Before it
+ * becomes smaller, the blocks in flight could have been received with
+ * different sizes, so the window restarts from the first missing byte.
+ */
+static void restart_window(struct coap_block_download *download,
+			   enum coap_block_size block_size)
+{
+	size_t offset = (size_t)download->deliver_num * block_bytes(download);
+
+	download->block_size = block_size;
+	download->deliver_num = offset / block_bytes(download);
+	download->next_num = download->deliver_num;
+
+	if (download->total_size) {
+		download->last_num = (download->total_size - 1) /
+				     block_bytes(download);
+	} else {
+		download->last_num = NUM_UNKNOWN;
+	}
+
+	for (int i = 0; i < download->window; i++) {
+		download->slots[i].state = SLOT_FREE;
+	}
+}
+
+static bool is_last(const struct coap_block_download *download,
+		    uint32_t num)
+{
+	int received = 0;
+
+	if (!last_known(download)) {
+		return false;
+	}
+
+	if (download->buf) {
+		return num == download->last_num;
+	}
+
+	/* Out of order, the last data is the one completing the download. */
+	for (int i = 0; i < download->window; i++) {
+		if (download->slots[i].state == SLOT_RECEIVED) {
+			received++;
+		}
+	}
+
+	return download->deliver_num + received + 1 > download->last_num;
+}
+
+static int deliver(struct coap_block_download *download,
+		   struct coap_block_download_slot *slot,
+		   const uint8_t *data, uint16_t len)
+{
+	size_t offset = (size_t)slot->num * block_bytes(download);
+	uint8_t *stored;
+	int r;
+
+	if (download->buf && slot->num != download->deliver_num) {
+		stored = download->buf + (slot->num % download->window) *
+					 block_bytes(download);
+		memcpy(stored, data, len);
+		slot->len = len;
+		slot->state = SLOT_RECEIVED;
+
+		return 0;
+	}
+
+	r = download->sink(download, offset, data, len,
+			   is_last(download, slot->num), download->user_data);
+	if (r < 0) {
+		return r;
+	}
+
+	if (slot->num != download->deliver_num) {
+		slot->state = SLOT_RECEIVED;
+		return 0;
+	}
+
+	slot->state = SLOT_FREE;
+	download->deliver_num++;
+
+	/* Hand over the blocks which were waiting for this one. */
+	while ((slot = find_received(download, download->deliver_num))) {
+		if (download->buf) {
+			stored = download->buf +
+				 (slot->num % download->window) *
+				 block_bytes(download);
+			r = download->sink(download,
+					   (size_t)slot->num *
+					   block_bytes(download),
+					   stored, slot->len,
+					   slot->num == download->last_num,
+					   download->user_data);
+			if (r < 0) {
+				return r;
+			}
+		}
+
+		slot->state = SLOT_FREE;
+		download->deliver_num++;
+	}
+
+	return 0;
+}
+
+int coap_block_download_init(struct coap_block_download *download,
+			     enum coap_block_size block_size, uint8_t window,
+			     uint8_t *buf, size_t buf_len,
+			     coap_block_request_t request,
+			     coap_block_sink_t sink, void *user_data)
+{
+	if (!download || !request || !sink || window == 0U ||
+	    window > CONFIG_COAP_BLOCK_DOWNLOAD_MAX_WINDOW) {
+		return -EINVAL;
+	}
+
+	if (buf && buf_len < (size_t)window *
+				 coap_block_size_to_bytes(block_size)) {
+		return -ENOMEM;
+	}
+
+	(void)memset(download, 0, sizeof(*download));
+
+	download->request = request;
+	download->sink = sink;
+	download->user_data = user_data;
+	download->buf = buf;
+	download->buf_len = buf_len;
+	download->block_size = block_size;
+	download->window = window;
+	download->last_num = NUM_UNKNOWN;
+
+	return 0;
+}
+
+int coap_block_download_start(struct coap_block_download *download)
+{
+	return fill_window(download);
+}
+
+int coap_block_download_response(struct coap_block_download *download,
+				 const struct coap_packet *response)
+{
+	struct coap_block_download_slot *slot;
+	const uint8_t *payload;
+	uint8_t token[8];
+	uint16_t len;
+	uint8_t tkl;
+	int block2, size2;
+	int r;
+
+	tkl = coap_header_get_token(response, token);
+	slot = find_slot(download, SLOT_PENDING, token, tkl);
+	if (!slot) {
+		return -ENOENT;
+	}
+
+	if (coap_header_get_code(response) != COAP_RESPONSE_CODE_CONTENT) {
+		NET_DBG("Block %u failed with code 0x%02x", slot->num,
+			coap_header_get_code(response));
+		slot->state = SLOT_FREE;
+		return -ENOMSG;
+	}
+
+	block2 = coap_get_option_int(response, COAP_OPTION_BLOCK2);
+	if (block2 < 0) {
+		/* The whole resource fits in the response. */
+		if (slot->num != 0U) {
+			slot->state = SLOT_FREE;
+			return -EBADMSG;
+		}
+
+		block2 = 0;
+	} else if (BLOCK_SZX(block2) > download->block_size ||
+		   BLOCK_SZX(block2) == 7) {
+		slot->state = SLOT_FREE;
+		return -EBADMSG;
+	}
+
+	if (BLOCK_SZX(block2) < download->block_size && block2 != 0) {
+		if (download->negotiated) {
+			NET_DBG("Block size reduced to %u",
+				coap_block_size_to_bytes(BLOCK_SZX(block2)));
+			restart_window(download, BLOCK_SZX(block2));
+			return fill_window(download);
+		}
+
+		download->block_size = BLOCK_SZX(block2);
+	}
+
+	if (BLOCK_NUM(block2) != slot->num) {
+		slot->state = SLOT_FREE;
+		return -EBADMSG;
+	}
+
+	payload = coap_packet_get_payload(response, &len);
+	if (BLOCK_MORE(block2) && len != block_bytes(download)) {
+		slot->state = SLOT_FREE;
+		return -EBADMSG;
+	}
+
+	if (!download->negotiated) {
+		download->negotiated = true;
+
+		size2 = coap_get_option_int(response, COAP_OPTION_SIZE2);
+		if (size2 > 0) {
+			download->total_size = size2;
+			download->last_num = (size2 - 1) /
+					     block_bytes(download);
+		}
+	}
+
+	if (!BLOCK_MORE(block2)) {
+		download->last_num = slot->num;
+		download->total_size = (size_t)slot->num *
+				       block_bytes(download) + len;
+	} else if (last_known(download) && slot->num >= download->last_num) {
+		slot->state = SLOT_FREE;
+		return -EBADMSG;
+	}
+
+	r = deliver(download, slot, payload, len);
+	if (r < 0) {
+		return r;
+	}
+
+	return fill_window(download);
+}
+
+int coap_block_download_retry(struct coap_block_download *download,
+			      const uint8_t *token, uint8_t tkl)
+{
+	struct coap_block_download_slot *slot;
+
+	slot = find_slot(download, SLOT_PENDING, token, tkl);
+	if (!slot) {
+		return -ENOENT;
+	}
+
+	return send_request(download, slot, slot->num);
+}
+
+bool coap_block_download_is_done(const struct coap_block_download *download)
+{
+	return last_known(download) &&
+		download->deliver_num > download->last_num;
+}
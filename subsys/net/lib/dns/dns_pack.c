@@ -336,9 +336,11 @@ int dns_unpack_response_query(struct dns_msg_t *dns_msg)
 	/* header already parsed + qname size */
 	offset = dns_msg->query_offset + qname_size;
 
-	/* 4 bytes more due to qtype and qclass */
+	/* 4 bytes more due to qtype and qclass. There might be no answers
+	 * after the query, like in a name error response.
+	 */
 	offset += DNS_QTYPE_LEN + DNS_QCLASS_LEN;
-	if (offset >= dns_msg->msg_size) {
+	if (offset > dns_msg->msg_size) {
 		return -ENOMEM;
 	}
 
@@ -16,6 +16,7 @@ LOG_MODULE_REGISTER(net_dns_resolve, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 #include <zephyr/types.h>
 #include <random/rand32.h>
 #include <string.h>
+#include <strings.h>
 #include <errno.h>
 #include <stdlib.h>
 
@@ -460,6 +461,109 @@ static inline int get_slot_by_id(struct dns_resolve_context *ctx,
 	return -ENOENT;
 }
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+/* Must be invoked with context lock held */
+static struct dns_cache_entry *dns_cache_find(struct dns_resolve_context *ctx,
+					      const char *name,
+					      enum dns_query_type type)
+{
+	int64_t now = k_uptime_get();
+	int i;
+
+	for (i = 0; i < CONFIG_DNS_RESOLVER_CACHE_SIZE; i++) {
+		struct dns_cache_entry *entry = &ctx->cache[i];
+
+		/* The terminating \0 of the entry name is compared too, so
+		 * longer names never match.
+		 */
+		if (entry->expires > now && entry->query_type == type &&
+		    !strncasecmp(entry->name, name, sizeof(entry->name))) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/* Must be invoked with context lock held */
+static void dns_cache_add(struct dns_resolve_context *ctx,
+			  const char *name,
+			  enum dns_query_type type,
+			  int status,
+			  const struct sockaddr *addr,
+			  int count,
+			  uint32_t ttl)
+{
+	struct dns_cache_entry *entry;
+	int i;
+
+	ttl = MIN(ttl, CONFIG_DNS_RESOLVER_CACHE_MAX_TTL);
+
+	if (ttl == 0U || !name ||
+	    strlen(name) > CONFIG_DNS_RESOLVER_CACHE_NAME_LEN) {
+		return;
+	}
+
+	/* Refresh the entry of the name if there is one. Otherwise replace
+	 * the entry expiring first, which is any unused one.
+	 */
+	entry = dns_cache_find(ctx, name, type);
+	if (!entry) {
+		entry = &ctx->cache[0];
+
+		for (i = 1; i < CONFIG_DNS_RESOLVER_CACHE_SIZE; i++) {
+			if (ctx->cache[i].expires < entry->expires) {
+				entry = &ctx->cache[i];
+			}
+		}
+	}
+
+	strcpy(entry->name, name);
+	entry->query_type = type;
+	entry->status = status;
+	entry->count = count;
+	memcpy(entry->addr, addr, count * sizeof(*addr));
+	entry->expires = k_uptime_get() + (int64_t)ttl * MSEC_PER_SEC;
+
+	NET_DBG("Caching %d addresses for %s type %d for %u s", count,
+		log_strdup(name), type, ttl);
+}
+
+/* Must be invoked with context lock held */
+static void dns_cache_answer(struct dns_cache_entry *entry,
+			     dns_resolve_cb_t cb,
+			     void *user_data)
+{
+	struct dns_addrinfo info = { 0 };
+	int i;
+
+	for (i = 0; i < entry->count; i++) {
+		memcpy(&info.ai_addr, &entry->addr[i], sizeof(info.ai_addr));
+		info.ai_family = entry->addr[i].sa_family;
+
+		if (info.ai_family == AF_INET) {
+			info.ai_addrlen = sizeof(struct sockaddr_in);
+		} else {
+			info.ai_addrlen = sizeof(struct sockaddr_in6);
+		}
+
+		cb(DNS_EAI_INPROGRESS, &info, user_data);
+	}
+
+	cb(entry->status, NULL, user_data);
+}
+
+/* Must be invoked with context lock held */
+static void dns_cache_flush(struct dns_resolve_context *ctx)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_DNS_RESOLVER_CACHE_SIZE; i++) {
+		ctx->cache[i].expires = 0;
+	}
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 /* Unit test needs to be able to call this function */
 #if !defined(CONFIG_NET_TEST)
 static
@@ -473,6 +577,10 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 {
 	struct dns_addrinfo info = { 0 };
 	uint32_t ttl; /* RR ttl, so far it is not passed to caller */
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	struct sockaddr cache_addr[CONFIG_DNS_RESOLVER_AI_MAX_ENTRIES];
+	uint32_t cache_ttl = UINT32_MAX;
+#endif
 	uint8_t *src, *addr;
 	const char *query_name;
 	int address_size;
@@ -509,8 +617,11 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 		goto quit;
 	}
 
+	/* A name error is reported as no data, the other errors of the
+	 * server as failures.
+	 */
 	ret = dns_unpack_response_header(dns_msg, *dns_id);
-	if (ret < 0) {
+	if (ret < 0 || (ret > 0 && ret != DNS_HEADER_NAMEERROR)) {
 		ret = DNS_EAI_FAIL;
 		goto quit;
 	}
@@ -633,6 +744,15 @@ query_known:
 			src = dns_msg->msg + dns_msg->response_position;
 			memcpy(addr, src, address_size);
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+			if (items < ARRAY_SIZE(cache_addr)) {
+				memcpy(&cache_addr[items], &info.ai_addr,
+				       sizeof(cache_addr[items]));
+			}
+
+			cache_ttl = MIN(cache_ttl, ttl);
+#endif
+
 			invoke_query_callback(DNS_EAI_INPROGRESS, &info,
 					      &ctx->queries[*query_idx]);
 			items++;
@@ -706,6 +826,23 @@ query_known:
 		ret = DNS_EAI_ALLDONE;
 	}
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	/* Only a name error means that the name does not exist, the other
+	 * failures of the server are not cached.
+	 */
+	if (items > 0) {
+		dns_cache_add(ctx, ctx->queries[*query_idx].query,
+			      ctx->queries[*query_idx].query_type, ret,
+			      cache_addr, MIN(items, ARRAY_SIZE(cache_addr)),
+			      cache_ttl);
+	} else if (dns_header_rcode(dns_msg->msg) == DNS_HEADER_NAMEERROR) {
+		dns_cache_add(ctx, ctx->queries[*query_idx].query,
+			      ctx->queries[*query_idx].query_type, ret,
+			      cache_addr, 0,
+			      CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL);
+	}
+#endif
+
 quit:
 	return ret;
 }
@@ -719,7 +856,7 @@ static int dns_read(struct dns_resolve_context *ctx,
 		    uint16_t *query_hash)
 {
 	/* Helper struct to track the dns msg received from the server */
-	struct dns_msg_t dns_msg;
+	struct dns_msg_t dns_msg = { 0 };
 	int data_len;
 	int ret;
 	int query_idx = -1;
@@ -1114,6 +1251,9 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 	k_timeout_t tout;
 	struct net_buf *dns_data = NULL;
 	struct net_buf *dns_qname = NULL;
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	struct dns_cache_entry *entry;
+#endif
 	struct sockaddr addr;
 	int ret, i = -1, j = 0;
 	int failure = 0;
@@ -1187,6 +1327,25 @@ try_resolve:
 		goto fail;
 	}
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	entry = dns_cache_find(ctx, query, type);
+	if (entry) {
+		ctx->cache_hits++;
+
+		/* There is nothing to cancel */
+		if (dns_id) {
+			*dns_id = 0U;
+		}
+
+		dns_cache_answer(entry, cb, user_data);
+
+		ret = 0;
+		goto fail;
+	}
+
+	ctx->cache_misses++;
+#endif
+
 	i = get_cb_slot(ctx);
 	if (i < 0) {
 		ret = -EAGAIN;
@@ -1368,6 +1527,11 @@ static int dns_resolve_close_locked(struct dns_resolve_context *ctx)
 
 	k_mutex_lock(&ctx->lock, K_FOREVER);
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	/* The answers came from the servers that were just removed */
+	dns_cache_flush(ctx);
+#endif
+
 	ctx->state = DNS_RESOLVE_CONTEXT_INACTIVE;
 
 	return 0;
@@ -1418,6 +1582,44 @@ unlock:
 	return err;
 }
 
+int dns_resolve_cache_flush(struct dns_resolve_context *ctx)
+{
+	if (!ctx) {
+		return -ENOENT;
+	}
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	k_mutex_lock(&ctx->lock, K_FOREVER);
+	dns_cache_flush(ctx);
+	k_mutex_unlock(&ctx->lock);
+#endif
+
+	return 0;
+}
+
+static int dns_cache_flush_request(uint32_t mgmt_request,
+				   struct net_if *iface,
+				   void *data, size_t len)
+{
+	struct dns_resolve_context *ctx = dns_resolve_get_default();
+
+	ARG_UNUSED(mgmt_request);
+	ARG_UNUSED(iface);
+
+	if (data) {
+		if (len != sizeof(struct dns_resolve_context)) {
+			return -EINVAL;
+		}
+
+		ctx = data;
+	}
+
+	return dns_resolve_cache_flush(ctx);
+}
+
+NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_DNS_CACHE_FLUSH,
+				  dns_cache_flush_request);
+
 struct dns_resolve_context *dns_resolve_get_default(void)
 {
 	return &dns_default_ctx;
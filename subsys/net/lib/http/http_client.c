@@ -269,6 +269,9 @@ static int on_body(struct http_parser *parser, const char *at, size_t length)
 		req->internal.response.body_start = (uint8_t *)at;
 	}
 
+	req->internal.response.body_frag_start = (uint8_t *)at;
+	req->internal.response.body_frag_len = length;
+
 	if (req->internal.response.cb) {
 		if (http_should_keep_alive(parser)) {
 			NET_DBG("Calling callback for partitioned %zd len data",
@@ -291,6 +294,9 @@ static int on_body(struct http_parser *parser, const char *at, size_t length)
 		req->internal.response.body_start = NULL;
 	}
 
+	req->internal.response.body_frag_start = NULL;
+	req->internal.response.body_frag_len = 0;
+
 	return 0;
 }
 
@@ -354,6 +360,11 @@ static int on_message_complete(struct http_parser *parser)
 
 	req->internal.response.message_complete = 1;
 
+	/* Stop at the end of the message, the data after it belongs to the
+	 * next response on the connection.
+	 */
+	http_parser_pause(parser, 1);
+
 	if (req->internal.response.cb) {
 		req->internal.response.cb(&req->internal.response,
 					  HTTP_DATA_FINAL,
@@ -408,16 +419,46 @@ static void http_client_init_parser(struct http_parser *parser,
 	settings->on_url = on_url;
 }
 
-static int http_wait_data(int sock, struct http_request *req)
+/* Data received after the end of a response, which is the start of the
+ * next one when requests are pipelined.
+ */
+struct http_carry {
+	uint8_t *data;
+	size_t len;
+};
+
+static int http_wait_data(int sock, struct http_request *req,
+			  struct http_carry *carry)
 {
 	int total_received = 0;
 	size_t offset = 0;
+	size_t pending = 0;
+	size_t parsed = 0;
 	int received, ret;
 
+	if (carry && carry->len) {
+		if (carry->len > req->internal.response.recv_buf_len) {
+			return -ENOBUFS;
+		}
+
+		memmove(req->internal.response.recv_buf, carry->data,
+			carry->len);
+		pending = carry->len;
+		carry->len = 0;
+	}
+
 	do {
-		received = recv(sock, req->internal.response.recv_buf + offset,
-				req->internal.response.recv_buf_len - offset,
-				0);
+		if (pending) {
+			received = pending;
+			pending = 0;
+		} else {
+			received = recv(sock,
+					req->internal.response.recv_buf +
+					offset,
+					req->internal.response.recv_buf_len -
+					offset, 0);
+		}
+
 		if (received == 0) {
 			/* Connection closed */
 			LOG_DBG("Connection closed");
@@ -431,7 +472,7 @@ static int http_wait_data(int sock, struct http_request *req)
 		} else {
 			req->internal.response.data_len += received;
 
-			(void)http_parser_execute(
+			parsed = http_parser_execute(
 				&req->internal.parser,
 				&req->internal.parser_settings,
 				req->internal.response.recv_buf + offset,
@@ -439,17 +480,24 @@ static int http_wait_data(int sock, struct http_request *req)
 		}
 
 		total_received += received;
-		offset += received;
-
-		if (offset >= req->internal.response.recv_buf_len) {
-			offset = 0;
-		}
 
 		if (req->internal.response.message_complete) {
+			if (carry) {
+				carry->data = req->internal.response.recv_buf +
+					      offset + parsed;
+				carry->len = received - parsed;
+			}
+
 			ret = total_received;
 			break;
 		}
 
+		offset += received;
+
+		if (offset >= req->internal.response.recv_buf_len) {
+			offset = 0;
+		}
+
 	} while (true);
 
 	return ret;
@@ -461,17 +509,18 @@ static void http_timeout(struct k_work *work)
 		CONTAINER_OF(work, struct http_client_internal_data, work);
 
 	(void)close(data->sock);
+	data->sock = -1;
 }
 
-int http_client_req(int sock, struct http_request *req,
-		    int32_t timeout, void *user_data)
+static int http_send_request(int sock, struct http_request *req,
+			     int32_t timeout, void *user_data)
 {
 	/* Utilize the network usage by sending data in bigger blocks */
 	char send_buf[MAX_SEND_BUF_LEN];
 	const size_t send_buf_max_len = sizeof(send_buf);
 	size_t send_buf_pos = 0;
 	int total_sent = 0;
-	int ret, total_recv, i;
+	int ret, i;
 	const char *method;
 
 	if (sock < 0 || req == NULL || req->response == NULL ||
@@ -652,6 +701,17 @@ int http_client_req(int sock, struct http_request *req,
 	http_client_init_parser(&req->internal.parser,
 				&req->internal.parser_settings);
 
+	return total_sent;
+
+out:
+	return ret;
+}
+
+static int http_recv_response(int sock, struct http_request *req,
+			      struct http_carry *carry)
+{
+	int total_recv;
+
 	if (!K_TIMEOUT_EQ(req->internal.timeout, K_FOREVER) &&
 	    !K_TIMEOUT_EQ(req->internal.timeout, K_NO_WAIT)) {
 		k_work_init_delayable(&req->internal.work, http_timeout);
@@ -660,7 +720,7 @@ int http_client_req(int sock, struct http_request *req,
 	}
 
 	/* Request is sent, now wait data to be received */
-	total_recv = http_wait_data(sock, req);
+	total_recv = http_wait_data(sock, req, carry);
 	if (total_recv < 0) {
 		NET_DBG("Wait data failure (%d)", total_recv);
 	} else {
@@ -672,8 +732,328 @@ int http_client_req(int sock, struct http_request *req,
 		(void)k_work_cancel_delayable(&req->internal.work);
 	}
 
+	return total_recv;
+}
+
+int http_client_req(int sock, struct http_request *req,
+		    int32_t timeout, void *user_data)
+{
+	int total_sent;
+
+	total_sent = http_send_request(sock, req, timeout, user_data);
+	if (total_sent < 0) {
+		return total_sent;
+	}
+
+	(void)http_recv_response(sock, req, NULL);
+
 	return total_sent;
+}
+
+#if defined(CONFIG_HTTP_CLIENT_POOL)
+void http_client_pool_init(struct http_client_pool *pool,
+			   http_client_connect_cb_t connect, void *user_data)
+{
+	(void)memset(pool, 0, sizeof(*pool));
+
+	pool->connect = connect;
+	pool->user_data = user_data;
+	k_mutex_init(&pool->lock);
+
+	for (int i = 0; i < ARRAY_SIZE(pool->conns); i++) {
+		pool->conns[i].sock = -1;
+	}
+}
+
+static void pool_conn_close(struct http_client_conn *conn)
+{
+	if (conn->sock >= 0) {
+		(void)close(conn->sock);
+		conn->sock = -1;
+	}
+}
+
+static bool pool_conn_matches(const struct http_client_conn *conn,
+			      const char *host, const char *port)
+{
+	return strcmp(conn->host, host) == 0 &&
+	       strcmp(conn->port, port ? port : "") == 0;
+}
+
+/* Takes an idle connection to the host, or a free entry to connect from,
+ * closing the connection idle for the longest time if there is none.
+ */
+static struct http_client_conn *pool_conn_get(struct http_client_pool *pool,
+					      const char *host,
+					      const char *port)
+{
+	struct http_client_conn *conn = NULL;
+	struct http_client_conn *oldest = NULL;
+	int64_t now = k_uptime_get();
+
+	k_mutex_lock(&pool->lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(pool->conns); i++) {
+		struct http_client_conn *iter = &pool->conns[i];
+
+		if (iter->busy) {
+			continue;
+		}
+
+		if (iter->sock >= 0 &&
+		    now - iter->idle_since >=
+		    CONFIG_HTTP_CLIENT_POOL_IDLE_TIMEOUT) {
+			NET_DBG("Closing idle connection to %s",
+				log_strdup(iter->host));
+			pool_conn_close(iter);
+		}
+
+		if (iter->sock < 0) {
+			if (!conn) {
+				conn = iter;
+			}
+
+			continue;
+		}
+
+		if (pool_conn_matches(iter, host, port)) {
+			conn = iter;
+			break;
+		}
+
+		if (!oldest || iter->idle_since < oldest->idle_since) {
+			oldest = iter;
+		}
+	}
+
+	if (!conn && oldest) {
+		pool_conn_close(oldest);
+		conn = oldest;
+	}
+
+	if (conn) {
+		conn->busy = true;
+
+		if (conn->sock < 0) {
+			strcpy(conn->host, host);
+			strcpy(conn->port, port ? port : "");
+		}
+	}
+
+	k_mutex_unlock(&pool->lock);
+
+	return conn;
+}
+
+static void pool_conn_put(struct http_client_pool *pool,
+			  struct http_client_conn *conn, bool keep_alive)
+{
+	k_mutex_lock(&pool->lock, K_FOREVER);
+
+	if (keep_alive) {
+		conn->idle_since = k_uptime_get();
+	} else {
+		pool_conn_close(conn);
+	}
+
+	conn->busy = false;
+
+	k_mutex_unlock(&pool->lock);
+}
+
+static int pool_conn_connect(struct http_client_pool *pool,
+			     struct http_client_conn *conn)
+{
+	int sock;
+
+	sock = pool->connect(conn->host, conn->port[0] ? conn->port : NULL,
+			     pool->user_data);
+	if (sock < 0) {
+		NET_DBG("Cannot connect to %s (%d)", log_strdup(conn->host),
+			sock);
+		return sock;
+	}
+
+	conn->sock = sock;
+
+	return 0;
+}
+
+static bool response_complete(struct http_request *req)
+{
+	return req->internal.sock >= 0 &&
+	       req->internal.response.message_complete;
+}
+
+/* A server may close an idle connection at any time, and the request is
+ * then lost without any response. It can be sent again on a new
+ * connection, unless its payload is produced by a callback.
+ */
+static bool response_lost(struct http_request *req)
+{
+	return req->internal.sock >= 0 && req->payload_cb == NULL &&
+	       req->internal.response.http_status_code == 0U &&
+	       !req->internal.response.message_complete;
+}
+
+static int pool_send(struct http_client_conn *conn,
+		     struct http_request *reqs, size_t count,
+		     int32_t timeout, void *user_data)
+{
+	int total_sent = 0;
+	int ret;
+
+	for (size_t i = 0; i < count; i++) {
+		ret = http_send_request(conn->sock, &reqs[i], timeout,
+					user_data);
+		if (ret < 0) {
+			return ret;
+		}
+
+		total_sent += ret;
+	}
+
+	return total_sent;
+}
+
+static int pool_recv(struct http_client_conn *conn,
+		     struct http_request *reqs, size_t count)
+{
+	struct http_carry carry = { 0 };
+	size_t i;
+	int ret;
+
+	for (i = 0; i < count; i++) {
+		ret = http_recv_response(conn->sock, &reqs[i], &carry);
+		if (ret < 0 && i == 0) {
+			return ret;
+		}
+
+		if (!response_complete(&reqs[i])) {
+			break;
+		}
+	}
+
+	return i;
+}
+
+static int pool_transfer(struct http_client_pool *pool,
+			 struct http_request *reqs, size_t count,
+			 int32_t timeout, void *user_data, int *total_sent)
+{
+	struct http_client_conn *conn;
+	bool keep_alive;
+	bool reused;
+	int ret;
+
+	if (strlen(reqs[0].host) >= sizeof(conn->host) ||
+	    (reqs[0].port && strlen(reqs[0].port) >= sizeof(conn->port))) {
+		return -ENAMETOOLONG;
+	}
+
+	conn = pool_conn_get(pool, reqs[0].host, reqs[0].port);
+	if (!conn) {
+		return -EAGAIN;
+	}
+
+	reused = conn->sock >= 0;
+
+	do {
+		if (conn->sock < 0) {
+			ret = pool_conn_connect(pool, conn);
+			if (ret < 0) {
+				pool_conn_put(pool, conn, false);
+				return ret;
+			}
+		}
+
+		ret = pool_send(conn, reqs, count, timeout, user_data);
+		if (ret >= 0) {
+			*total_sent = ret;
+			ret = pool_recv(conn, reqs, count);
+		}
+
+		for (size_t i = 0; i < count; i++) {
+			/* Closed on timeout */
+			if (reqs[i].internal.sock < 0) {
+				conn->sock = -1;
+			}
+		}
+
+		if (!reused || ret > 0 || !response_lost(&reqs[0])) {
+			break;
+		}
+
+		NET_DBG("Connection to %s closed by peer, reconnecting",
+			log_strdup(conn->host));
+		pool_conn_close(conn);
+		reused = false;
+	} while (true);
+
+	keep_alive = ret == (int)count &&
+		     http_should_keep_alive(&reqs[count - 1].internal.parser);
+
+	pool_conn_put(pool, conn, keep_alive);
 
-out:
 	return ret;
 }
+
+int http_client_pool_req(struct http_client_pool *pool,
+			 struct http_request *req, int32_t timeout,
+			 void *user_data)
+{
+	int total_sent = 0;
+	int ret;
+
+	if (pool == NULL || req == NULL || req->host == NULL) {
+		return -EINVAL;
+	}
+
+	ret = pool_transfer(pool, req, 1, timeout, user_data, &total_sent);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (ret == 0) {
+		return -ECONNRESET;
+	}
+
+	return total_sent;
+}
+
+int http_client_pool_pipeline(struct http_client_pool *pool,
+			      struct http_request *reqs, size_t count,
+			      int32_t timeout, void *user_data)
+{
+	int total_sent = 0;
+
+	if (pool == NULL || reqs == NULL || count == 0 ||
+	    reqs[0].host == NULL) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 1; i < count; i++) {
+		if (!reqs[i].host || strcmp(reqs[i].host, reqs[0].host) ||
+		    (reqs[i].port == NULL) != (reqs[0].port == NULL) ||
+		    (reqs[i].port && strcmp(reqs[i].port, reqs[0].port))) {
+			return -EINVAL;
+		}
+	}
+
+	return pool_transfer(pool, reqs, count, timeout, user_data,
+			     &total_sent);
+}
+
+void http_client_pool_close(struct http_client_pool *pool)
+{
+	k_mutex_lock(&pool->lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(pool->conns); i++) {
+		if (!pool->conns[i].busy) {
+			pool_conn_close(&pool->conns[i]);
+		}
+	}
+
+	k_mutex_unlock(&pool->lock);
+}
+#endif /* CONFIG_HTTP_CLIENT_POOL */
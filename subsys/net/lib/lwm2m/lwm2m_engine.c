@@ -46,6 +46,12 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #ifdef CONFIG_LWM2M_RW_JSON_SUPPORT
 #include "lwm2m_rw_json.h"
 #endif
+#ifdef CONFIG_LWM2M_RW_SENML_JSON_SUPPORT
+#include "lwm2m_rw_senml_json.h"
+#endif
+#ifdef CONFIG_LWM2M_RW_SENML_CBOR_SUPPORT
+#include "lwm2m_rw_senml_cbor.h"
+#endif
 #ifdef CONFIG_LWM2M_RD_CLIENT_SUPPORT
 #include "lwm2m_rd_client.h"
 #endif
@@ -72,15 +78,24 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 
 struct observe_node {
 	sys_snode_t node;
+	/* observer index bucket, by path */
+	sys_snode_t index_node;
 	struct lwm2m_obj_path path;
 	uint8_t  token[MAX_TOKEN_LEN];
 	int64_t event_timestamp;
+	/* first change since the last notification */
+	int64_t first_event_timestamp;
 	int64_t last_timestamp;
 	uint32_t min_period_sec;
 	uint32_t max_period_sec;
 	uint32_t counter;
 	uint16_t format;
 	uint8_t  tkl;
+#if defined(CONFIG_LWM2M_RW_SENML)
+	/* paths of a composite observation, which has none of its own */
+	struct lwm2m_obj_path composite[CONFIG_LWM2M_COMPOSITE_PATH_MAX];
+	uint8_t composite_count;
+#endif
 };
 
 struct notification_attrs {
@@ -107,9 +122,20 @@ struct service_node {
 static struct service_node service_node_data[MAX_PERIODIC_SERVICE];
 
 static sys_slist_t engine_obj_list;
-static sys_slist_t engine_obj_inst_list;
 static sys_slist_t engine_service_list;
 
+/* Objects, instances and observers hashed by their IDs, so that looking
+ * them up doesn't walk every one of them.
+ */
+#define INDEX_SIZE	CONFIG_LWM2M_ENGINE_INDEX_SIZE
+
+static sys_slist_t engine_obj_index[INDEX_SIZE];
+static sys_slist_t engine_obj_inst_index[INDEX_SIZE];
+static sys_slist_t engine_observer_index[INDEX_SIZE];
+#if defined(CONFIG_LWM2M_RW_SENML)
+static sys_slist_t engine_composite_observers;
+#endif
+
 static K_KERNEL_STACK_DEFINE(engine_thread_stack,
 			      CONFIG_LWM2M_ENGINE_STACK_SIZE);
 static struct k_thread engine_thread_data;
@@ -138,6 +164,45 @@ static struct lwm2m_engine_obj *get_engine_obj(int obj_id);
 static struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id,
 							 int obj_inst_id);
 
+static inline sys_slist_t *obj_index_bucket(uint16_t obj_id)
+{
+	return &engine_obj_index[obj_id % INDEX_SIZE];
+}
+
+static inline uint32_t index_hash(uint16_t obj_id, uint16_t obj_inst_id)
+{
+	return ((uint32_t)obj_id * 31U + obj_inst_id) % INDEX_SIZE;
+}
+
+static inline sys_slist_t *obj_inst_index_bucket(uint16_t obj_id,
+						 uint16_t obj_inst_id)
+{
+	return &engine_obj_inst_index[index_hash(obj_id, obj_inst_id)];
+}
+
+static sys_slist_t *observer_index_bucket(struct observe_node *obs)
+{
+#if defined(CONFIG_LWM2M_RW_SENML)
+	if (obs->composite_count > 0U) {
+		return &engine_composite_observers;
+	}
+#endif
+
+	return &engine_observer_index[index_hash(obs->path.obj_id,
+						 obs->path.obj_inst_id)];
+}
+
+static void observer_index_add(struct observe_node *obs)
+{
+	sys_slist_append(observer_index_bucket(obs), &obs->index_node);
+}
+
+static void observer_index_remove(struct observe_node *obs)
+{
+	sys_slist_find_and_remove(observer_index_bucket(obs),
+				  &obs->index_node);
+}
+
 /* Shared set of in-flight LwM2M messages */
 static struct lwm2m_message messages[CONFIG_LWM2M_ENGINE_MAX_MESSAGES];
 
@@ -342,29 +407,73 @@ static void clear_attrs(void *ref)
 	}
 }
 
+#if defined(CONFIG_LWM2M_RW_SENML)
+static bool composite_observer_match(struct observe_node *obs,
+				     uint16_t obj_id, uint16_t obj_inst_id,
+				     uint16_t res_id)
+{
+	struct lwm2m_obj_path *path;
+	int i;
+
+	for (i = 0; i < obs->composite_count; i++) {
+		path = &obs->composite[i];
+
+		if (path->obj_id == obj_id &&
+		    (path->level < 2U || path->obj_inst_id == obj_inst_id) &&
+		    (path->level < 3U || path->res_id == res_id)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif
+
+static void observer_event(struct observe_node *obs)
+{
+	int64_t timestamp = k_uptime_get();
+
+	/* the first change not notified yet opens the coalescing window */
+	if (obs->event_timestamp <= obs->last_timestamp) {
+		obs->first_event_timestamp = timestamp;
+	}
+
+	obs->event_timestamp = timestamp;
+}
+
 int lwm2m_notify_observer(uint16_t obj_id, uint16_t obj_inst_id, uint16_t res_id)
 {
 	struct observe_node *obs;
 	int ret = 0;
-	int i;
 
 	/* look for observers which match our resource */
-	for (i = 0; i < sock_nfds; ++i) {
-		SYS_SLIST_FOR_EACH_CONTAINER(&sock_ctx[i]->observer, obs, node) {
-			if (obs->path.obj_id == obj_id &&
-			    obs->path.obj_inst_id == obj_inst_id &&
-			    (obs->path.level < 3 ||
-			     obs->path.res_id == res_id)) {
-				/* update the event time for this observer */
-				obs->event_timestamp = k_uptime_get();
-
-				LOG_DBG("NOTIFY EVENT %u/%u/%u",
-					obj_id, obj_inst_id, res_id);
-
-				ret++;
-			}
+	SYS_SLIST_FOR_EACH_CONTAINER(
+		&engine_observer_index[index_hash(obj_id, obj_inst_id)],
+		obs, index_node) {
+		if (obs->path.obj_id == obj_id &&
+		    obs->path.obj_inst_id == obj_inst_id &&
+		    (obs->path.level < 3 ||
+		     obs->path.res_id == res_id)) {
+			/* update the event time for this observer */
+			observer_event(obs);
+
+			LOG_DBG("NOTIFY EVENT %u/%u/%u",
+				obj_id, obj_inst_id, res_id);
+
+			ret++;
+		}
+	}
+
+#if defined(CONFIG_LWM2M_RW_SENML)
+	SYS_SLIST_FOR_EACH_CONTAINER(&engine_composite_observers, obs,
+				     index_node) {
+		if (composite_observer_match(obs, obj_id, obj_inst_id,
+					     res_id)) {
+			observer_event(obs);
+			ret++;
 		}
 	}
+#endif
 
 	return ret;
 }
@@ -506,6 +615,8 @@ static int engine_add_observer(struct lwm2m_message *msg,
 	observe_node_data[i].last_timestamp = k_uptime_get();
 	observe_node_data[i].event_timestamp =
 			observe_node_data[i].last_timestamp;
+	observe_node_data[i].first_event_timestamp =
+			observe_node_data[i].last_timestamp;
 	observe_node_data[i].min_period_sec = attrs.pmin;
 	observe_node_data[i].max_period_sec = (attrs.pmax > 0) ? MAX(attrs.pmax, attrs.pmin)
 							       : attrs.pmax;
@@ -513,6 +624,7 @@ static int engine_add_observer(struct lwm2m_message *msg,
 	observe_node_data[i].counter = OBSERVE_COUNTER_START;
 	sys_slist_append(&msg->ctx->observer,
 			 &observe_node_data[i].node);
+	observer_index_add(&observe_node_data[i]);
 
 	LOG_DBG("OBSERVER ADDED %u/%u/%u(%u) token:'%s' addr:%s",
 		msg->path.obj_id, msg->path.obj_inst_id,
@@ -523,6 +635,74 @@ static int engine_add_observer(struct lwm2m_message *msg,
 	return 0;
 }
 
+#if defined(CONFIG_LWM2M_RW_SENML)
+static int engine_add_composite_observer(struct lwm2m_message *msg,
+					 const uint8_t *token, uint8_t tkl,
+					 uint16_t format,
+					 struct lwm2m_obj_path *paths,
+					 uint8_t path_count)
+{
+	struct observe_node *obs = NULL;
+	int i;
+
+	if (!token || (tkl == 0U || tkl > MAX_TOKEN_LEN)) {
+		LOG_ERR("token(%p) and token length(%u) must be valid.",
+			token, tkl);
+		return -EINVAL;
+	}
+
+	/* a composite observation is identified by its token only */
+	SYS_SLIST_FOR_EACH_CONTAINER(&msg->ctx->observer, obs, node) {
+		if (obs->composite_count > 0U && obs->tkl == tkl &&
+		    memcmp(obs->token, token, tkl) == 0) {
+			break;
+		}
+	}
+
+	if (!obs) {
+		for (i = 0; i < CONFIG_LWM2M_ENGINE_MAX_OBSERVER; i++) {
+			if (!observe_node_data[i].tkl) {
+				break;
+			}
+		}
+
+		if (i == CONFIG_LWM2M_ENGINE_MAX_OBSERVER) {
+			return -ENOMEM;
+		}
+
+		obs = &observe_node_data[i];
+		(void)memset(obs, 0, sizeof(*obs));
+		memcpy(obs->token, token, tkl);
+		obs->tkl = tkl;
+		obs->composite_count = path_count;
+		sys_slist_append(&msg->ctx->observer, &obs->node);
+		observer_index_add(obs);
+	}
+
+	/* there are no attributes for composites, use the server ones */
+	obs->last_timestamp = k_uptime_get();
+	obs->event_timestamp = obs->last_timestamp;
+	obs->first_event_timestamp = obs->last_timestamp;
+	obs->min_period_sec = lwm2m_server_get_pmin(msg->ctx->srv_obj_inst);
+	obs->max_period_sec = lwm2m_server_get_pmax(msg->ctx->srv_obj_inst);
+	if (obs->max_period_sec > 0) {
+		obs->max_period_sec = MAX(obs->max_period_sec,
+					  obs->min_period_sec);
+	}
+
+	obs->format = format;
+	obs->counter = OBSERVE_COUNTER_START;
+	memcpy(obs->composite, paths, path_count * sizeof(*paths));
+	obs->composite_count = path_count;
+
+	LOG_DBG("COMPOSITE OBSERVER ADDED %u paths token:'%s' addr:%s",
+		path_count, log_strdup(sprint_token(token, tkl)),
+		log_strdup(lwm2m_sprint_ip_addr(&msg->ctx->remote_addr)));
+
+	return 0;
+}
+#endif /* CONFIG_LWM2M_RW_SENML */
+
 static int engine_remove_observer(struct lwm2m_ctx *ctx, const uint8_t *token, uint8_t tkl)
 {
 	struct observe_node *obs, *found_obj = NULL;
@@ -549,6 +729,7 @@ static int engine_remove_observer(struct lwm2m_ctx *ctx, const uint8_t *token, u
 	}
 
 	sys_slist_remove(&ctx->observer, prev_node, &found_obj->node);
+	observer_index_remove(found_obj);
 	(void)memset(found_obj, 0, sizeof(*found_obj));
 
 	LOG_DBG("observer '%s' removed", log_strdup(sprint_token(token, tkl)));
@@ -580,16 +761,17 @@ static int engine_remove_observer_by_path(struct lwm2m_obj_path *path)
 {
 	char buf[LWM2M_MAX_PATH_STR_LEN];
 	struct observe_node *obs, *found_obj = NULL;
-	sys_snode_t *prev_node = NULL;
+	int i;
 
 	/* find the node index */
-	SYS_SLIST_FOR_EACH_CONTAINER(&engine_observer_list, obs, node) {
+	SYS_SLIST_FOR_EACH_CONTAINER(
+		&engine_observer_index[index_hash(path->obj_id,
+						  path->obj_inst_id)],
+		obs, index_node) {
 		if (memcmp(path, &obs->path, sizeof(*path)) == 0) {
 			found_obj = obs;
 			break;
 		}
-
-		prev_node = &obs->node;
 	}
 
 	if (!found_obj) {
@@ -598,7 +780,14 @@ static int engine_remove_observer_by_path(struct lwm2m_obj_path *path)
 
 	LOG_INF("Removing observer for path %s",
 		lwm2m_path_log_strdup(buf, path));
-	sys_slist_remove(&engine_observer_list, prev_node, &found_obj->node);
+	for (i = 0; i < sock_nfds; ++i) {
+		if (sys_slist_find_and_remove(&sock_ctx[i]->observer,
+					      &found_obj->node)) {
+			break;
+		}
+	}
+
+	observer_index_remove(found_obj);
 	(void)memset(found_obj, 0, sizeof(*found_obj));
 
 	return 0;
@@ -615,13 +804,16 @@ static void engine_remove_observer_by_id(uint16_t obj_id, int32_t obj_inst_id)
 	for (i = 0; i < sock_nfds; ++i) {
 		SYS_SLIST_FOR_EACH_CONTAINER_SAFE(
 			&sock_ctx[i]->observer, obs, tmp, node) {
-			if (!(obj_id == obs->path.obj_id &&
+			/* composite observers have no path of their own */
+			if (obs->path.level == LWM2M_PATH_LEVEL_NONE ||
+			    !(obj_id == obs->path.obj_id &&
 			      obj_inst_id == obs->path.obj_inst_id)) {
 				prev_node = &obs->node;
 				continue;
 			}
 
 			sys_slist_remove(&sock_ctx[i]->observer, prev_node, &obs->node);
+			observer_index_remove(obs);
 			(void)memset(obs, 0, sizeof(*obs));
 		}
 	}
@@ -632,19 +824,23 @@ static void engine_remove_observer_by_id(uint16_t obj_id, int32_t obj_inst_id)
 void lwm2m_register_obj(struct lwm2m_engine_obj *obj)
 {
 	sys_slist_append(&engine_obj_list, &obj->node);
+	sys_slist_append(obj_index_bucket(obj->obj_id), &obj->index_node);
 }
 
 void lwm2m_unregister_obj(struct lwm2m_engine_obj *obj)
 {
 	engine_remove_observer_by_id(obj->obj_id, -1);
 	sys_slist_find_and_remove(&engine_obj_list, &obj->node);
+	sys_slist_find_and_remove(obj_index_bucket(obj->obj_id),
+				  &obj->index_node);
 }
 
 static struct lwm2m_engine_obj *get_engine_obj(int obj_id)
 {
 	struct lwm2m_engine_obj *obj;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_list, obj, node) {
+	SYS_SLIST_FOR_EACH_CONTAINER(obj_index_bucket(obj_id), obj,
+				     index_node) {
 		if (obj->obj_id == obj_id) {
 			return obj;
 		}
@@ -673,14 +869,38 @@ lwm2m_get_engine_obj_field(struct lwm2m_engine_obj *obj, int res_id)
 
 static void engine_register_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 {
-	sys_slist_append(&engine_obj_inst_list, &obj_inst->node);
+	struct lwm2m_engine_obj_inst *iter, *prev = NULL;
+	sys_slist_t *instances = &obj_inst->obj->instances;
+
+	/* keep the instances of the object sorted by ID */
+	SYS_SLIST_FOR_EACH_CONTAINER(instances, iter, node) {
+		if (iter->obj_inst_id > obj_inst->obj_inst_id) {
+			break;
+		}
+
+		prev = iter;
+	}
+
+	if (prev) {
+		sys_slist_insert(instances, &prev->node, &obj_inst->node);
+	} else {
+		sys_slist_prepend(instances, &obj_inst->node);
+	}
+
+	sys_slist_append(obj_inst_index_bucket(obj_inst->obj->obj_id,
+					       obj_inst->obj_inst_id),
+			 &obj_inst->index_node);
 }
 
 static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 {
 	engine_remove_observer_by_id(
 			obj_inst->obj->obj_id, obj_inst->obj_inst_id);
-	sys_slist_find_and_remove(&engine_obj_inst_list, &obj_inst->node);
+	sys_slist_find_and_remove(&obj_inst->obj->instances, &obj_inst->node);
+	sys_slist_find_and_remove(
+		obj_inst_index_bucket(obj_inst->obj->obj_id,
+				      obj_inst->obj_inst_id),
+		&obj_inst->index_node);
 }
 
 static struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id,
@@ -688,8 +908,9 @@ static struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id,
 {
 	struct lwm2m_engine_obj_inst *obj_inst;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, obj_inst,
-				     node) {
+	SYS_SLIST_FOR_EACH_CONTAINER(obj_inst_index_bucket(obj_id,
+							   obj_inst_id),
+				     obj_inst, index_node) {
 		if (obj_inst->obj->obj_id == obj_id &&
 		    obj_inst->obj_inst_id == obj_inst_id) {
 			return obj_inst;
@@ -702,18 +923,29 @@ static struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id,
 static struct lwm2m_engine_obj_inst *
 next_engine_obj_inst(int obj_id, int obj_inst_id)
 {
-	struct lwm2m_engine_obj_inst *obj_inst, *next = NULL;
+	struct lwm2m_engine_obj *obj;
+	struct lwm2m_engine_obj_inst *obj_inst;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, obj_inst,
-				     node) {
-		if (obj_inst->obj->obj_id == obj_id &&
-		    obj_inst->obj_inst_id > obj_inst_id &&
-		    (!next || next->obj_inst_id > obj_inst->obj_inst_id)) {
-			next = obj_inst;
+	/* the instance following an existing one is next in the list */
+	if (obj_inst_id >= 0) {
+		obj_inst = get_engine_obj_inst(obj_id, obj_inst_id);
+		if (obj_inst) {
+			return SYS_SLIST_PEEK_NEXT_CONTAINER(obj_inst, node);
 		}
 	}
 
-	return next;
+	obj = get_engine_obj(obj_id);
+	if (!obj) {
+		return NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&obj->instances, obj_inst, node) {
+		if (obj_inst->obj_inst_id > obj_inst_id) {
+			return obj_inst;
+		}
+	}
+
+	return NULL;
 }
 
 int lwm2m_create_obj_inst(uint16_t obj_id, uint16_t obj_inst_id,
@@ -1152,19 +1384,16 @@ int lwm2m_register_payload_handler(struct lwm2m_message *msg)
 			}
 		}
 
-		SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list,
-					     obj_inst, node) {
-			if (obj_inst->obj->obj_id == obj->obj_id) {
-				struct lwm2m_obj_path path = {
-					.obj_id = obj_inst->obj->obj_id,
-					.obj_inst_id = obj_inst->obj_inst_id,
-					.level = LWM2M_PATH_LEVEL_OBJECT_INST,
-				};
+		SYS_SLIST_FOR_EACH_CONTAINER(&obj->instances, obj_inst, node) {
+			struct lwm2m_obj_path path = {
+				.obj_id = obj_inst->obj->obj_id,
+				.obj_inst_id = obj_inst->obj_inst_id,
+				.level = LWM2M_PATH_LEVEL_OBJECT_INST,
+			};
 
-				ret = engine_put_corelink(&msg->out, &path);
-				if (ret < 0) {
-					return ret;
-				}
+			ret = engine_put_corelink(&msg->out, &path);
+			if (ret < 0) {
+				return ret;
 			}
 		}
 	}
@@ -1199,6 +1428,18 @@ static int select_writer(struct lwm2m_output_context *out, uint16_t accept)
 		break;
 #endif
 
+#ifdef CONFIG_LWM2M_RW_SENML_JSON_SUPPORT
+	case LWM2M_FORMAT_APP_SENML_JSON:
+		out->writer = &senml_json_writer;
+		break;
+#endif
+
+#ifdef CONFIG_LWM2M_RW_SENML_CBOR_SUPPORT
+	case LWM2M_FORMAT_APP_SENML_CBOR:
+		out->writer = &senml_cbor_writer;
+		break;
+#endif
+
 	default:
 		LOG_WRN("Unknown content type %u", accept);
 		return -ENOMSG;
@@ -1230,6 +1471,18 @@ static int select_reader(struct lwm2m_input_context *in, uint16_t format)
 		break;
 #endif
 
+#ifdef CONFIG_LWM2M_RW_SENML_JSON_SUPPORT
+	case LWM2M_FORMAT_APP_SENML_JSON:
+		in->reader = &senml_json_reader;
+		break;
+#endif
+
+#ifdef CONFIG_LWM2M_RW_SENML_CBOR_SUPPORT
+	case LWM2M_FORMAT_APP_SENML_CBOR:
+		in->reader = &senml_cbor_reader;
+		break;
+#endif
+
 	default:
 		LOG_WRN("Unknown content type %u", format);
 		return -ENOMSG;
@@ -1305,6 +1558,36 @@ static int string_to_path(char *pathstr, struct lwm2m_obj_path *path,
 	return 0;
 }
 
+/* Stricter than string_to_path(), for paths received from the server:
+ * anything but IDs separated by slashes is rejected.
+ */
+int lwm2m_string_to_path(char *pathstr, struct lwm2m_obj_path *path)
+{
+	uint32_t id = 0U;
+	int i, ret;
+
+	/* string_to_path() skips what is not a number */
+	for (i = 0; pathstr[i] != '\0'; i++) {
+		if (pathstr[i] == '/') {
+			id = 0U;
+		} else if (isdigit((unsigned char)pathstr[i])) {
+			id = id * 10U + (pathstr[i] - '0');
+			if (id > UINT16_MAX) {
+				return -EINVAL;
+			}
+		} else {
+			return -EINVAL;
+		}
+	}
+
+	ret = string_to_path(pathstr, path, '/');
+	if (ret == 0 && path->level == 0U) {
+		return -EINVAL;
+	}
+
+	return ret;
+}
+
 static int path_to_objs(const struct lwm2m_obj_path *path,
 			struct lwm2m_engine_obj_inst **obj_inst,
 			struct lwm2m_engine_obj_field **obj_field,
@@ -3164,6 +3447,16 @@ static int do_read_op(struct lwm2m_message *msg, uint16_t content_format)
 		return do_read_op_json(msg, content_format);
 #endif
 
+#if defined(CONFIG_LWM2M_RW_SENML_JSON_SUPPORT)
+	case LWM2M_FORMAT_APP_SENML_JSON:
+		return do_read_op_senml_json(msg, content_format);
+#endif
+
+#if defined(CONFIG_LWM2M_RW_SENML_CBOR_SUPPORT)
+	case LWM2M_FORMAT_APP_SENML_CBOR:
+		return do_read_op_senml_cbor(msg, content_format);
+#endif
+
 	default:
 		LOG_ERR("Unsupported content-format: %u", content_format);
 		return -ENOMSG;
@@ -3171,45 +3464,29 @@ static int do_read_op(struct lwm2m_message *msg, uint16_t content_format)
 	}
 }
 
-int lwm2m_perform_read_op(struct lwm2m_message *msg, uint16_t content_format)
+static struct lwm2m_engine_obj_inst *
+read_path_obj_inst(const struct lwm2m_obj_path *path)
 {
-	struct lwm2m_engine_obj_inst *obj_inst = NULL;
-	struct lwm2m_engine_res *res = NULL;
-	struct lwm2m_engine_obj_field *obj_field;
-	struct lwm2m_obj_path temp_path;
-	int ret = 0, index;
-	uint8_t num_read = 0U;
-
-	if (msg->path.level >= 2U) {
-		obj_inst = get_engine_obj_inst(msg->path.obj_id,
-					       msg->path.obj_inst_id);
-	} else if (msg->path.level == 1U) {
+	if (path->level >= 2U) {
+		return get_engine_obj_inst(path->obj_id, path->obj_inst_id);
+	} else if (path->level == 1U) {
 		/* find first obj_inst with path's obj_id */
-		obj_inst = next_engine_obj_inst(msg->path.obj_id, -1);
+		return next_engine_obj_inst(path->obj_id, -1);
 	}
 
-	if (!obj_inst) {
-		return -ENOENT;
-	}
-
-	/* set output content-format */
-	ret = coap_append_option_int(msg->out.out_cpkt,
-				     COAP_OPTION_CONTENT_FORMAT,
-				     content_format);
-	if (ret < 0) {
-		LOG_ERR("Error setting response content-format: %d", ret);
-		return ret;
-	}
-
-	ret = coap_packet_append_payload_marker(msg->out.out_cpkt);
-	if (ret < 0) {
-		LOG_ERR("Error appending payload marker: %d", ret);
-		return ret;
-	}
+	return NULL;
+}
 
-	/* store original path values so we can change them during processing */
-	memcpy(&temp_path, &msg->path, sizeof(temp_path));
-	engine_put_begin(&msg->out, &msg->path);
+/* Format the resources of msg->path, starting from obj_inst, into the
+ * payload. msg->path is changed while moving through them.
+ */
+static int perform_read_path(struct lwm2m_message *msg,
+			     struct lwm2m_engine_obj_inst *obj_inst,
+			     uint8_t *num_read)
+{
+	struct lwm2m_engine_res *res = NULL;
+	struct lwm2m_engine_obj_field *obj_field;
+	int ret = 0, index;
 
 	while (obj_inst) {
 		if (!obj_inst->resources || obj_inst->resource_count == 0U) {
@@ -3260,7 +3537,7 @@ int lwm2m_perform_read_op(struct lwm2m_message *msg, uint16_t content_format)
 						LOG_ERR("READ OP: %d", ret);
 					}
 				} else {
-					num_read += 1U;
+					*num_read += 1U;
 				}
 
 				/* end resource formatting */
@@ -3291,6 +3568,55 @@ move_forward:
 		}
 	}
 
+	return ret;
+}
+
+static int start_read_payload(struct lwm2m_message *msg,
+			      uint16_t content_format)
+{
+	int ret;
+
+	/* set output content-format */
+	ret = coap_append_option_int(msg->out.out_cpkt,
+				     COAP_OPTION_CONTENT_FORMAT,
+				     content_format);
+	if (ret < 0) {
+		LOG_ERR("Error setting response content-format: %d", ret);
+		return ret;
+	}
+
+	ret = coap_packet_append_payload_marker(msg->out.out_cpkt);
+	if (ret < 0) {
+		LOG_ERR("Error appending payload marker: %d", ret);
+		return ret;
+	}
+
+	return 0;
+}
+
+int lwm2m_perform_read_op(struct lwm2m_message *msg, uint16_t content_format)
+{
+	struct lwm2m_engine_obj_inst *obj_inst;
+	struct lwm2m_obj_path temp_path;
+	uint8_t num_read = 0U;
+	int ret;
+
+	obj_inst = read_path_obj_inst(&msg->path);
+	if (!obj_inst) {
+		return -ENOENT;
+	}
+
+	ret = start_read_payload(msg, content_format);
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* store original path values so we can change them during processing */
+	memcpy(&temp_path, &msg->path, sizeof(temp_path));
+	engine_put_begin(&msg->out, &msg->path);
+
+	ret = perform_read_path(msg, obj_inst, &num_read);
+
 	engine_put_end(&msg->out, &msg->path);
 
 	/* restore original path values */
@@ -3304,6 +3630,49 @@ move_forward:
 	return ret;
 }
 
+/* Read all the paths of a composite into a single payload. The paths
+ * which are not found are skipped, as long as one of them is.
+ */
+int lwm2m_perform_composite_read_op(struct lwm2m_message *msg,
+				    uint16_t content_format,
+				    struct lwm2m_obj_path *paths,
+				    uint8_t path_count)
+{
+	struct lwm2m_engine_obj_inst *obj_inst;
+	struct lwm2m_obj_path temp_path;
+	uint8_t num_read = 0U;
+	int ret, i;
+
+	ret = start_read_payload(msg, content_format);
+	if (ret < 0) {
+		return ret;
+	}
+
+	memcpy(&temp_path, &msg->path, sizeof(temp_path));
+	engine_put_begin(&msg->out, &msg->path);
+
+	for (i = 0; i < path_count; i++) {
+		memcpy(&msg->path, &paths[i], sizeof(msg->path));
+
+		obj_inst = read_path_obj_inst(&msg->path);
+		if (!obj_inst) {
+			continue;
+		}
+
+		ret = perform_read_path(msg, obj_inst, &num_read);
+		if (ret < 0) {
+			LOG_DBG("Composite read of %u/%u/%u(%u): %d",
+				paths[i].obj_id, paths[i].obj_inst_id,
+				paths[i].res_id, paths[i].level, ret);
+		}
+	}
+
+	memcpy(&msg->path, &temp_path, sizeof(temp_path));
+	engine_put_end(&msg->out, &msg->path);
+
+	return num_read > 0U ? 0 : -ENOENT;
+}
+
 int lwm2m_discover_handler(struct lwm2m_message *msg, bool is_bootstrap)
 {
 	struct lwm2m_engine_obj *obj;
@@ -3375,12 +3744,7 @@ int lwm2m_discover_handler(struct lwm2m_message *msg, bool is_bootstrap)
 			}
 		}
 
-		SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list,
-					     obj_inst, node) {
-			if (obj_inst->obj->obj_id != obj->obj_id) {
-				continue;
-			}
-
+		SYS_SLIST_FOR_EACH_CONTAINER(&obj->instances, obj_inst, node) {
 			/* Skip unrelated object instance. */
 			if (msg->path.level > LWM2M_PATH_LEVEL_OBJECT &&
 			    msg->path.obj_inst_id != obj_inst->obj_inst_id) {
@@ -3533,6 +3897,164 @@ bool lwm2m_engine_shall_report_obj_version(const struct lwm2m_engine_obj *obj)
 	return obj->version_major != 1 || obj->version_minor != 0;
 }
 
+/* Write the value the reader is at to the resource of msg->path, as
+ * named by a record of a SenML pack.
+ */
+int lwm2m_write_path_handler(struct lwm2m_message *msg)
+{
+	struct lwm2m_engine_obj_field *obj_field;
+	struct lwm2m_engine_obj_inst *obj_inst;
+	struct lwm2m_engine_res *res = NULL;
+	struct lwm2m_engine_res_inst *res_inst = NULL;
+	int ret, i;
+
+	if (msg->path.level < 3U) {
+		return -EINVAL;
+	}
+
+	ret = lwm2m_get_or_create_engine_obj(msg, &obj_inst, NULL);
+	if (ret < 0) {
+		return ret;
+	}
+
+	obj_field = lwm2m_get_engine_obj_field(obj_inst->obj, msg->path.res_id);
+	if (!obj_field) {
+		return -ENOENT;
+	}
+
+	if (!LWM2M_HAS_PERM(obj_field, LWM2M_PERM_W)) {
+		return -EPERM;
+	}
+
+	for (i = 0; i < obj_inst->resource_count; i++) {
+		if (obj_inst->resources[i].res_id == msg->path.res_id) {
+			res = &obj_inst->resources[i];
+			break;
+		}
+	}
+
+	if (!res) {
+		return -ENOENT;
+	}
+
+	for (i = 0; i < res->res_inst_count; i++) {
+		if (res->res_instances[i].res_inst_id ==
+		    msg->path.res_inst_id) {
+			res_inst = &res->res_instances[i];
+			break;
+		}
+	}
+
+	if (!res_inst) {
+		return -ENOENT;
+	}
+
+	return lwm2m_write_handler(obj_inst, res, res_inst, obj_field, msg);
+}
+
+#if defined(CONFIG_LWM2M_RW_SENML)
+static int do_composite_paths(struct lwm2m_message *msg, uint16_t format,
+			      struct lwm2m_obj_path *paths)
+{
+	switch (format) {
+
+#if defined(CONFIG_LWM2M_RW_SENML_JSON_SUPPORT)
+	case LWM2M_FORMAT_APP_SENML_JSON:
+		return senml_json_parse_paths(msg, paths,
+					      CONFIG_LWM2M_COMPOSITE_PATH_MAX);
+#endif
+
+#if defined(CONFIG_LWM2M_RW_SENML_CBOR_SUPPORT)
+	case LWM2M_FORMAT_APP_SENML_CBOR:
+		return senml_cbor_parse_paths(msg, paths,
+					      CONFIG_LWM2M_COMPOSITE_PATH_MAX);
+#endif
+
+	default:
+		LOG_ERR("Unsupported composite format: %u", format);
+		return -ENOMSG;
+
+	}
+}
+
+static int do_composite_read_op(struct lwm2m_message *msg,
+				uint16_t content_format,
+				struct lwm2m_obj_path *paths,
+				uint8_t path_count)
+{
+	switch (content_format) {
+
+#if defined(CONFIG_LWM2M_RW_SENML_JSON_SUPPORT)
+	case LWM2M_FORMAT_APP_SENML_JSON:
+		return do_composite_read_op_senml_json(msg, content_format,
+						       paths, path_count);
+#endif
+
+#if defined(CONFIG_LWM2M_RW_SENML_CBOR_SUPPORT)
+	case LWM2M_FORMAT_APP_SENML_CBOR:
+		return do_composite_read_op_senml_cbor(msg, content_format,
+						       paths, path_count);
+#endif
+
+	default:
+		LOG_ERR("Unsupported composite content-format: %u",
+			content_format);
+		return -ENOMSG;
+
+	}
+}
+
+/*
+ * LwM2M V1_1_1-20190617-A, 6.3.8/6.4.3, Read-Composite and
+ * Observe-Composite: CoAP FETCH with the list of paths in the payload.
+ */
+static int handle_composite_read(struct lwm2m_message *msg, uint16_t format,
+				 uint16_t accept, int observe,
+				 const uint8_t *token, uint8_t tkl)
+{
+	struct lwm2m_obj_path paths[CONFIG_LWM2M_COMPOSITE_PATH_MAX];
+	int count, r;
+
+	count = do_composite_paths(msg, format, paths);
+	if (count < 0) {
+		return count;
+	}
+
+	if (count == 0) {
+		return -EINVAL;
+	}
+
+	if (observe == 0) {
+		if (!msg->token) {
+			LOG_ERR("OBSERVE request missing token");
+			return -EINVAL;
+		}
+
+		r = coap_append_option_int(msg->out.out_cpkt,
+					   COAP_OPTION_OBSERVE,
+					   OBSERVE_COUNTER_START);
+		if (r < 0) {
+			LOG_ERR("OBSERVE option error: %d", r);
+			return r;
+		}
+
+		r = engine_add_composite_observer(msg, token, tkl, accept,
+						  paths, count);
+		if (r < 0) {
+			LOG_ERR("add OBSERVE error: %d", r);
+			return r;
+		}
+	} else if (observe == 1) {
+		r = engine_remove_observer(msg->ctx, token, tkl);
+		if (r < 0) {
+			LOG_ERR("remove observe error: %d", r);
+		}
+	}
+
+	return do_composite_read_op(msg, accept, paths, count);
+}
+#endif /* CONFIG_LWM2M_RW_SENML */
+
 static int do_write_op(struct lwm2m_message *msg,
 		       uint16_t format)
 {
@@ -3553,6 +4075,16 @@ static int do_write_op(struct lwm2m_message *msg,
 		return do_write_op_json(msg);
 #endif
 
+#ifdef CONFIG_LWM2M_RW_SENML_JSON_SUPPORT
+	case LWM2M_FORMAT_APP_SENML_JSON:
+		return do_write_op_senml_json(msg);
+#endif
+
+#ifdef CONFIG_LWM2M_RW_SENML_CBOR_SUPPORT
+	case LWM2M_FORMAT_APP_SENML_CBOR:
+		return do_write_op_senml_cbor(msg);
+#endif
+
 	default:
 		LOG_ERR("Unsupported format: %u", format);
 		return -ENOMSG;
@@ -3590,6 +4122,7 @@ static bool bootstrap_delete_allowed(int obj_id, int obj_inst_id)
 
 static int bootstrap_delete(struct lwm2m_message *msg)
 {
+	struct lwm2m_engine_obj *obj;
 	struct lwm2m_engine_obj_inst *obj_inst, *tmp;
 	int ret = 0;
 
@@ -3613,22 +4146,23 @@ static int bootstrap_delete(struct lwm2m_message *msg)
 	 * - LwM2M Bootstrap-Server Account (Bootstrap Security object, ID 0)
 	 * - Device object (ID 3)
 	 */
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&engine_obj_inst_list,
-					  obj_inst, tmp, node) {
-		if (msg->path.level == 1 &&
-		    obj_inst->obj->obj_id != msg->path.obj_id) {
+	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_list, obj, node) {
+		if (msg->path.level == 1 && obj->obj_id != msg->path.obj_id) {
 			continue;
 		}
 
-		if (!bootstrap_delete_allowed(obj_inst->obj->obj_id,
-					      obj_inst->obj_inst_id)) {
-			continue;
-		}
+		SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&obj->instances,
+						  obj_inst, tmp, node) {
+			if (!bootstrap_delete_allowed(obj->obj_id,
+						      obj_inst->obj_inst_id)) {
+				continue;
+			}
 
-		ret = lwm2m_delete_obj_inst(obj_inst->obj->obj_id,
-					    obj_inst->obj_inst_id);
-		if (ret < 0) {
-			return ret;
+			ret = lwm2m_delete_obj_inst(obj->obj_id,
+						    obj_inst->obj_inst_id);
+			if (ret < 0) {
+				return ret;
+			}
 		}
 	}
 
@@ -3700,6 +4234,10 @@ static int handle_request(struct coap_packet *request,
 
 			r = -EPERM;
 			goto error;
+#endif
+#if defined(CONFIG_LWM2M_RW_SENML)
+		case COAP_METHOD_FETCH:
+			break;
 #endif
 		default:
 			r = -EPERM;
@@ -3746,6 +4284,9 @@ static int handle_request(struct coap_packet *request,
 	r = coap_find_options(msg->in.in_cpkt, COAP_OPTION_ACCEPT, options, 1);
 	if (r > 0) {
 		accept = coap_option_value_to_int(&options[0]);
+	} else if ((code & COAP_REQUEST_MASK) == COAP_METHOD_FETCH) {
+		/* answer a composite in the format of its paths */
+		accept = format;
 	} else {
 		LOG_DBG("No accept option given. Assume OMA TLV.");
 		accept = LWM2M_FORMAT_OMA_TLV;
@@ -3756,7 +4297,8 @@ static int handle_request(struct coap_packet *request,
 		goto error;
 	}
 
-	if (!(msg->ctx->bootstrap_mode && msg->path.level == 0)) {
+	if (!(msg->ctx->bootstrap_mode && msg->path.level == 0) &&
+	    (code & COAP_REQUEST_MASK) != COAP_METHOD_FETCH) {
 		/* find registered obj */
 		obj = get_engine_obj(msg->path.obj_id);
 		if (!obj) {
@@ -3819,6 +4361,17 @@ static int handle_request(struct coap_packet *request,
 		msg->code = COAP_RESPONSE_CODE_DELETED;
 		break;
 
+#if defined(CONFIG_LWM2M_RW_SENML)
+	case COAP_METHOD_FETCH:
+		msg->operation = LWM2M_OP_READ_COMPOSITE;
+
+		/* check for observe-composite */
+		observe = coap_get_option_int(msg->in.in_cpkt,
+					      COAP_OPTION_OBSERVE);
+		msg->code = COAP_RESPONSE_CODE_CONTENT;
+		break;
+#endif
+
 	default:
 		break;
 	}
@@ -3947,6 +4500,13 @@ static int handle_request(struct coap_packet *request,
 			r = do_read_op(msg, accept);
 			break;
 
+#if defined(CONFIG_LWM2M_RW_SENML)
+		case LWM2M_OP_READ_COMPOSITE:
+			r = handle_composite_read(msg, format, accept, observe,
+						  token, tkl);
+			break;
+#endif
+
 		case LWM2M_OP_DISCOVER:
 			r = do_discover_op(msg, accept);
 			break;
@@ -4326,14 +4886,20 @@ static int generate_notify_message(struct lwm2m_ctx *ctx,
 		log_strdup(lwm2m_sprint_ip_addr(&ctx->remote_addr)),
 		k_uptime_get());
 
-	obj_inst = get_engine_obj_inst(obs->path.obj_id,
-				       obs->path.obj_inst_id);
-	if (!obj_inst) {
-		LOG_ERR("unable to get engine obj for %u/%u",
-			obs->path.obj_id,
-			obs->path.obj_inst_id);
-		ret = -EINVAL;
-		goto cleanup;
+#if defined(CONFIG_LWM2M_RW_SENML)
+	/* the paths of a composite which are gone are left out */
+	if (obs->composite_count == 0U)
+#endif
+	{
+		obj_inst = get_engine_obj_inst(obs->path.obj_id,
+					       obs->path.obj_inst_id);
+		if (!obj_inst) {
+			LOG_ERR("unable to get engine obj for %u/%u",
+				obs->path.obj_id,
+				obs->path.obj_inst_id);
+			ret = -EINVAL;
+			goto cleanup;
+		}
 	}
 
 	msg->type = COAP_TYPE_CON;
@@ -4363,7 +4929,15 @@ static int generate_notify_message(struct lwm2m_ctx *ctx,
 	/* set the output writer */
 	select_writer(&msg->out, obs->format);
 
-	ret = do_read_op(msg, obs->format);
+#if defined(CONFIG_LWM2M_RW_SENML)
+	if (obs->composite_count > 0U) {
+		ret = do_composite_read_op(msg, obs->format, obs->composite,
+					   obs->composite_count);
+	} else
+#endif
+	{
+		ret = do_read_op(msg, obs->format);
+	}
 	if (ret < 0) {
 		LOG_ERR("error in multi-format read (err:%d)", ret);
 		goto cleanup;
@@ -4475,6 +5049,7 @@ int lwm2m_engine_context_close(struct lwm2m_ctx *client_ctx)
 	while (!sys_slist_is_empty(&client_ctx->observer)) {
 		obs_node = sys_slist_get_not_empty(&client_ctx->observer);
 		obs = SYS_SLIST_CONTAINER(obs_node, obs, node);
+		observer_index_remove(obs);
 		(void)memset(obs, 0, sizeof(*obs));
 	}
 
@@ -4550,7 +5125,9 @@ static bool manual_notify_is_due(const struct observe_node *obs,
 
 	return obs->event_timestamp > obs->last_timestamp &&
 		(!has_min_period || timestamp > obs->last_timestamp +
-		 MSEC_PER_SEC * obs->min_period_sec);
+		 MSEC_PER_SEC * obs->min_period_sec) &&
+		timestamp >= obs->first_event_timestamp +
+			     CONFIG_LWM2M_ENGINE_NOTIFY_COALESCE_MS;
 }
 
 static bool automatic_notify_is_due(const struct observe_node *obs,
@@ -4562,29 +5139,61 @@ static bool automatic_notify_is_due(const struct observe_node *obs,
 				  MSEC_PER_SEC * obs->max_period_sec);
 }
 
+/* Once notifications are due, the other observations which pmin allows
+ * to notify, because they changed or reach their pmax within the
+ * coalescing window, go out with them.
+ */
+static bool notify_may_join(const struct observe_node *obs,
+			    const int64_t timestamp)
+{
+	if (obs->min_period_sec != 0 &&
+	    timestamp <= obs->last_timestamp +
+			 MSEC_PER_SEC * obs->min_period_sec) {
+		return false;
+	}
+
+	if (obs->event_timestamp > obs->last_timestamp) {
+		return true;
+	}
+
+	return obs->max_period_sec != 0 &&
+		(timestamp + CONFIG_LWM2M_ENGINE_NOTIFY_COALESCE_MS >
+		 obs->last_timestamp + MSEC_PER_SEC * obs->max_period_sec);
+}
+
 static void check_notifications(struct lwm2m_ctx *ctx,
 				const int64_t timestamp)
 {
 	struct observe_node *obs;
+	bool due = false;
 	int rc;
-	bool manual_notify, automatic_notify;
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->observer, obs, node) {
-		manual_notify = manual_notify_is_due(obs, timestamp);
-		automatic_notify = automatic_notify_is_due(obs, timestamp);
-		if (!manual_notify && !automatic_notify) {
+		if (manual_notify_is_due(obs, timestamp) ||
+		    automatic_notify_is_due(obs, timestamp)) {
+			due = true;
+			break;
+		}
+	}
+
+	if (!due) {
+		return;
+	}
+
+	/* send them back to back, so the radio wakes up once */
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->observer, obs, node) {
+		if (!notify_may_join(obs, timestamp)) {
 			continue;
 		}
-		rc = generate_notify_message(ctx, obs, manual_notify);
+
+		rc = generate_notify_message(
+			ctx, obs, obs->event_timestamp > obs->last_timestamp);
 		if (rc == -ENOMEM) {
 			/* no memory/messages available, retry later */
 			return;
 		}
+
 		obs->last_timestamp = timestamp;
-		if (!rc) {
-			/* create at most one notification */
-			return;
-		}
 	}
 }
 
@@ -0,0 +1,1073 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * SenML-CBOR content format (RFC 8428, LwM2M 1.1 section 7.4.6).
+ *
+ * A pack is a CBOR array of records, each of them a map using the
+ * integer labels of SenML. The records are written with a base name
+ * of "/obj/inst/" only when the object instance changes, and a name
+ * of "res" or "res/res_inst" relative to it. The few CBOR items SenML
+ * needs are encoded and decoded here, without a generic CBOR library.
+ */
+
+#define LOG_MODULE_NAME net_lwm2m_senml_cbor
+#define LOG_LEVEL CONFIG_LWM2M_LOG_LEVEL
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <sys/byteorder.h>
+
+#include "lwm2m_object.h"
+#include "lwm2m_rw_senml_cbor.h"
+#include "lwm2m_engine.h"
+#include "lwm2m_util.h"
+
+/* CBOR major types */
+#define CBOR_UINT		0
+#define CBOR_NINT		1
+#define CBOR_BYTES		2
+#define CBOR_TEXT		3
+#define CBOR_ARRAY		4
+#define CBOR_MAP		5
+#define CBOR_SIMPLE		7
+
+/* CBOR additional information */
+#define CBOR_FALSE		20
+#define CBOR_TRUE		21
+#define CBOR_FLOAT16		25
+#define CBOR_FLOAT32		26
+#define CBOR_FLOAT64		27
+#define CBOR_INDEFINITE		31
+
+#define CBOR_BREAK		0xff
+
+/* SenML labels */
+#define SENML_LABEL_BN		-2
+#define SENML_LABEL_N		0
+#define SENML_LABEL_V		2
+#define SENML_LABEL_VS		3
+#define SENML_LABEL_VB		4
+#define SENML_LABEL_VD		8
+/* "vlo" is a text label, mapped to a value no integer label uses */
+#define SENML_LABEL_VLO		INT32_MAX
+#define SENML_LABEL_UNKNOWN	INT32_MIN
+
+/* longest name: "/65535/65535/65535/65535" */
+#define SENML_NAME_LEN		25
+
+struct cbor_out_formatter_data {
+	/* base name of the previous records */
+	uint16_t bn_obj_id;
+	uint16_t bn_obj_inst_id;
+
+	/* flags */
+	uint8_t writer_flags;
+};
+
+struct cbor_in_formatter_data {
+	/* base name, applying to the records which do not set another */
+	char base_name[SENML_NAME_LEN];
+
+	/* name of the current record */
+	char name[SENML_NAME_LEN];
+
+	/* offset of the value of the current record, 0 if it has none */
+	uint16_t value_offset;
+
+	/* offset of the next record */
+	uint16_t offset;
+
+	/* records left in the pack, -1 up to a break */
+	int32_t records;
+};
+
+static size_t cbor_put(struct lwm2m_output_context *out,
+		       const uint8_t *buf, size_t len)
+{
+	if (buf_append(CPKT_BUF_WRITE(out->out_cpkt), (uint8_t *)buf,
+		       len) < 0) {
+		return 0;
+	}
+
+	return len;
+}
+
+static size_t cbor_put_head(struct lwm2m_output_context *out,
+			    uint8_t major, uint64_t value)
+{
+	uint8_t buf[9];
+	size_t len;
+
+	buf[0] = major << 5;
+
+	if (value < 24) {
+		buf[0] |= value;
+		len = 1;
+	} else if (value <= UINT8_MAX) {
+		buf[0] |= 24;
+		buf[1] = value;
+		len = 2;
+	} else if (value <= UINT16_MAX) {
+		buf[0] |= 25;
+		sys_put_be16(value, &buf[1]);
+		len = 3;
+	} else if (value <= UINT32_MAX) {
+		buf[0] |= 26;
+		sys_put_be32(value, &buf[1]);
+		len = 5;
+	} else {
+		buf[0] |= 27;
+		sys_put_be64(value, &buf[1]);
+		len = 9;
+	}
+
+	return cbor_put(out, buf, len);
+}
+
+static size_t cbor_put_int(struct lwm2m_output_context *out, int64_t value)
+{
+	if (value < 0) {
+		return cbor_put_head(out, CBOR_NINT, (uint64_t)(-(value + 1)));
+	}
+
+	return cbor_put_head(out, CBOR_UINT, value);
+}
+
+static size_t cbor_put_string(struct lwm2m_output_context *out,
+			      uint8_t major, const char *buf, size_t buflen)
+{
+	size_t len;
+
+	len = cbor_put_head(out, major, buflen);
+	if (len == 0 || (buflen > 0 && cbor_put(out, buf, buflen) == 0)) {
+		return 0;
+	}
+
+	return len + buflen;
+}
+
+static size_t cbor_put_text_item(struct lwm2m_output_context *out,
+				 int label, const char *buf, size_t buflen)
+{
+	size_t len, ret;
+
+	len = cbor_put_int(out, label);
+	if (len == 0) {
+		return 0;
+	}
+
+	ret = cbor_put_string(out, CBOR_TEXT, buf, buflen);
+	return ret ? len + ret : 0;
+}
+
+/* Start a record, up to the label of its value */
+static size_t put_record(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path)
+{
+	struct cbor_out_formatter_data *fd;
+	char name[SENML_NAME_LEN];
+	bool base_name;
+	size_t len, ret;
+	int name_len;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	base_name = !(fd->writer_flags & WRITER_OUTPUT_VALUE) ||
+		    fd->bn_obj_id != path->obj_id ||
+		    fd->bn_obj_inst_id != path->obj_inst_id;
+
+	len = cbor_put_head(out, CBOR_MAP, base_name ? 3 : 2);
+	if (len == 0) {
+		return 0;
+	}
+
+	if (base_name) {
+		name_len = snprintk(name, sizeof(name), "/%u/%u/",
+				    path->obj_id, path->obj_inst_id);
+		ret = cbor_put_text_item(out, SENML_LABEL_BN, name, name_len);
+		if (ret == 0) {
+			return 0;
+		}
+
+		len += ret;
+		fd->bn_obj_id = path->obj_id;
+		fd->bn_obj_inst_id = path->obj_inst_id;
+		fd->writer_flags |= WRITER_OUTPUT_VALUE;
+	}
+
+	if (fd->writer_flags & WRITER_RESOURCE_INSTANCE) {
+		name_len = snprintk(name, sizeof(name), "%u/%u",
+				    path->res_id, path->res_inst_id);
+	} else {
+		name_len = snprintk(name, sizeof(name), "%u", path->res_id);
+	}
+
+	ret = cbor_put_text_item(out, SENML_LABEL_N, name, name_len);
+	return ret ? len + ret : 0;
+}
+
+static size_t put_value_label(struct lwm2m_output_context *out,
+			      struct lwm2m_obj_path *path, int label)
+{
+	size_t len, ret;
+
+	len = put_record(out, path);
+	if (len == 0) {
+		return 0;
+	}
+
+	if (label == SENML_LABEL_VLO) {
+		ret = cbor_put_string(out, CBOR_TEXT, "vlo", 3);
+	} else {
+		ret = cbor_put_int(out, label);
+	}
+
+	return ret ? len + ret : 0;
+}
+
+static size_t put_begin(struct lwm2m_output_context *out,
+			struct lwm2m_obj_path *path)
+{
+	uint8_t c = (CBOR_ARRAY << 5) | CBOR_INDEFINITE;
+
+	return cbor_put(out, &c, 1);
+}
+
+static size_t put_end(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path)
+{
+	uint8_t c = CBOR_BREAK;
+
+	return cbor_put(out, &c, 1);
+}
+
+static size_t put_begin_ri(struct lwm2m_output_context *out,
+			   struct lwm2m_obj_path *path)
+{
+	struct cbor_out_formatter_data *fd;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	fd->writer_flags |= WRITER_RESOURCE_INSTANCE;
+	return 0;
+}
+
+static size_t put_end_ri(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path)
+{
+	struct cbor_out_formatter_data *fd;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	fd->writer_flags &= ~WRITER_RESOURCE_INSTANCE;
+	return 0;
+}
+
+static size_t put_s64(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path, int64_t value)
+{
+	size_t len, ret;
+
+	len = put_value_label(out, path, SENML_LABEL_V);
+	if (len == 0) {
+		return 0;
+	}
+
+	ret = cbor_put_int(out, value);
+	return ret ? len + ret : 0;
+}
+
+static size_t put_s32(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path, int32_t value)
+{
+	return put_s64(out, path, (int64_t)value);
+}
+
+static size_t put_s16(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path, int16_t value)
+{
+	return put_s64(out, path, (int64_t)value);
+}
+
+static size_t put_s8(struct lwm2m_output_context *out,
+		     struct lwm2m_obj_path *path, int8_t value)
+{
+	return put_s64(out, path, (int64_t)value);
+}
+
+static size_t put_string(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path,
+			 char *buf, size_t buflen)
+{
+	size_t len, ret;
+
+	len = put_value_label(out, path, SENML_LABEL_VS);
+	if (len == 0) {
+		return 0;
+	}
+
+	ret = cbor_put_string(out, CBOR_TEXT, buf, buflen);
+	return ret ? len + ret : 0;
+}
+
+static size_t put_opaque(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path,
+			 char *buf, size_t buflen)
+{
+	size_t len, ret;
+
+	len = put_value_label(out, path, SENML_LABEL_VD);
+	if (len == 0) {
+		return 0;
+	}
+
+	ret = cbor_put_string(out, CBOR_BYTES, buf, buflen);
+	return ret ? len + ret : 0;
+}
+
+static size_t put_float32fix(struct lwm2m_output_context *out,
+			     struct lwm2m_obj_path *path,
+			     float32_value_t *value)
+{
+	uint8_t buf[5] = { (CBOR_SIMPLE << 5) | CBOR_FLOAT32 };
+	size_t len;
+
+	/* whole values are shorter as integers */
+	if (value->val2 == 0) {
+		return put_s64(out, path, value->val1);
+	}
+
+	if (lwm2m_f32_to_b32(value, &buf[1], 4) < 0) {
+		return 0;
+	}
+
+	len = put_value_label(out, path, SENML_LABEL_V);
+	if (len == 0 || cbor_put(out, buf, sizeof(buf)) == 0) {
+		return 0;
+	}
+
+	return len + sizeof(buf);
+}
+
+static size_t put_float64fix(struct lwm2m_output_context *out,
+			     struct lwm2m_obj_path *path,
+			     float64_value_t *value)
+{
+	uint8_t buf[9] = { (CBOR_SIMPLE << 5) | CBOR_FLOAT64 };
+	size_t len;
+
+	if (value->val2 == 0) {
+		return put_s64(out, path, value->val1);
+	}
+
+	if (lwm2m_f64_to_b64(value, &buf[1], 8) < 0) {
+		return 0;
+	}
+
+	len = put_value_label(out, path, SENML_LABEL_V);
+	if (len == 0 || cbor_put(out, buf, sizeof(buf)) == 0) {
+		return 0;
+	}
+
+	return len + sizeof(buf);
+}
+
+static size_t put_bool(struct lwm2m_output_context *out,
+		       struct lwm2m_obj_path *path,
+		       bool value)
+{
+	uint8_t c = (CBOR_SIMPLE << 5) | (value ? CBOR_TRUE : CBOR_FALSE);
+	size_t len;
+
+	len = put_value_label(out, path, SENML_LABEL_VB);
+	if (len == 0 || cbor_put(out, &c, 1) == 0) {
+		return 0;
+	}
+
+	return len + 1;
+}
+
+static size_t put_objlnk(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path,
+			 struct lwm2m_objlnk *value)
+{
+	char buf[sizeof("65535:65535")];
+	size_t len, ret;
+	int buflen;
+
+	buflen = snprintk(buf, sizeof(buf), "%u:%u", value->obj_id,
+			  value->obj_inst);
+
+	len = put_value_label(out, path, SENML_LABEL_VLO);
+	if (len == 0) {
+		return 0;
+	}
+
+	ret = cbor_put_string(out, CBOR_TEXT, buf, buflen);
+	return ret ? len + ret : 0;
+}
+
+static int cbor_get_byte(struct lwm2m_input_context *in, uint16_t *offset,
+			 uint8_t *c)
+{
+	if (*offset >= in->in_cpkt->offset) {
+		return -ENODATA;
+	}
+
+	*c = in->in_cpkt->data[(*offset)++];
+	return 0;
+}
+
+/* Read the initial byte of an item and the argument following it */
+static int cbor_get_head(struct lwm2m_input_context *in, uint16_t *offset,
+			 uint8_t *major, uint8_t *info, uint64_t *arg)
+{
+	uint8_t c;
+	int i, ret;
+
+	ret = cbor_get_byte(in, offset, &c);
+	if (ret < 0) {
+		return ret;
+	}
+
+	*major = c >> 5;
+	*info = c & 0x1f;
+	*arg = 0U;
+
+	if (*info < 24) {
+		*arg = *info;
+		return 0;
+	}
+
+	if (*info == CBOR_INDEFINITE) {
+		return 0;
+	}
+
+	if (*info > CBOR_FLOAT64) {
+		return -EINVAL;
+	}
+
+	for (i = 0; i < (1 << (*info - 24)); i++) {
+		ret = cbor_get_byte(in, offset, &c);
+		if (ret < 0) {
+			return ret;
+		}
+
+		*arg = (*arg << 8) | c;
+	}
+
+	return 0;
+}
+
+static bool cbor_get_break(struct lwm2m_input_context *in, uint16_t *offset)
+{
+	if (*offset < in->in_cpkt->offset &&
+	    in->in_cpkt->data[*offset] == CBOR_BREAK) {
+		(*offset)++;
+		return true;
+	}
+
+	return false;
+}
+
+/* Skip a value item. SenML values are never arrays or maps. */
+static int cbor_skip(struct lwm2m_input_context *in, uint16_t *offset)
+{
+	uint8_t major, info;
+	uint64_t arg;
+	int ret;
+
+	ret = cbor_get_head(in, offset, &major, &info, &arg);
+	if (ret < 0) {
+		return ret;
+	}
+
+	switch (major) {
+
+	case CBOR_UINT:
+	case CBOR_NINT:
+		return 0;
+
+	case CBOR_BYTES:
+	case CBOR_TEXT:
+		if (info == CBOR_INDEFINITE) {
+			return -ENOTSUP;
+		}
+
+		if (arg > in->in_cpkt->offset - *offset) {
+			return -ENODATA;
+		}
+
+		*offset += arg;
+		return 0;
+
+	case CBOR_SIMPLE:
+		return info == CBOR_INDEFINITE ? -EINVAL : 0;
+
+	default:
+		return -ENOTSUP;
+
+	}
+}
+
+static int cbor_get_text(struct lwm2m_input_context *in, uint16_t *offset,
+			 char *buf, size_t buflen)
+{
+	uint8_t major, info;
+	uint64_t arg;
+	int ret;
+
+	ret = cbor_get_head(in, offset, &major, &info, &arg);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (major != CBOR_TEXT || info == CBOR_INDEFINITE || arg >= buflen ||
+	    arg > in->in_cpkt->offset - *offset) {
+		return -EINVAL;
+	}
+
+	memcpy(buf, in->in_cpkt->data + *offset, arg);
+	buf[arg] = '\0';
+	*offset += arg;
+
+	return 0;
+}
+
+static int cbor_get_label(struct lwm2m_input_context *in, uint16_t *offset,
+			  int32_t *label)
+{
+	char key[sizeof("vlo")];
+	uint8_t major, info;
+	uint64_t arg;
+	uint16_t start = *offset;
+	int ret;
+
+	ret = cbor_get_head(in, offset, &major, &info, &arg);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (major == CBOR_UINT || major == CBOR_NINT) {
+		if (arg > INT16_MAX) {
+			*label = SENML_LABEL_UNKNOWN;
+		} else if (major == CBOR_NINT) {
+			*label = -1 - (int32_t)arg;
+		} else {
+			*label = arg;
+		}
+
+		return 0;
+	}
+
+	if (major != CBOR_TEXT) {
+		return -EINVAL;
+	}
+
+	*label = SENML_LABEL_UNKNOWN;
+
+	/* keys longer than "vlo" are skipped */
+	*offset = start;
+	if (arg >= sizeof(key)) {
+		return cbor_skip(in, offset);
+	}
+
+	ret = cbor_get_text(in, offset, key, sizeof(key));
+	if (ret == 0 && strcmp(key, "vlo") == 0) {
+		*label = SENML_LABEL_VLO;
+	}
+
+	return ret;
+}
+
+static int cbor_begin_pack(struct lwm2m_input_context *in,
+			   struct cbor_in_formatter_data *fd)
+{
+	uint8_t major, info;
+	uint64_t arg;
+	int ret;
+
+	(void)memset(fd, 0, sizeof(*fd));
+	fd->offset = in->offset;
+
+	ret = cbor_get_head(in, &fd->offset, &major, &info, &arg);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (major != CBOR_ARRAY) {
+		LOG_ERR("SenML pack is not an array");
+		return -EINVAL;
+	}
+
+	/* every record takes a byte at least */
+	if (info != CBOR_INDEFINITE && arg > in->in_cpkt->offset - fd->offset) {
+		LOG_ERR("SenML pack is truncated");
+		return -EINVAL;
+	}
+
+	fd->records = info == CBOR_INDEFINITE ? -1 : (int32_t)arg;
+	return 0;
+}
+
+/* Parse the next record of the pack. Returns 1 if there was one, 0 at the
+ * end of the pack.
+ */
+static int cbor_next_record(struct lwm2m_input_context *in,
+			    struct cbor_in_formatter_data *fd)
+{
+	uint8_t major, info;
+	uint64_t arg;
+	int32_t label;
+	int ret;
+
+	if (fd->records == 0 ||
+	    (fd->records < 0 && cbor_get_break(in, &fd->offset))) {
+		return 0;
+	}
+
+	if (fd->records > 0) {
+		fd->records--;
+	}
+
+	ret = cbor_get_head(in, &fd->offset, &major, &info, &arg);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (major != CBOR_MAP) {
+		LOG_ERR("SenML record is not a map");
+		return -EINVAL;
+	}
+
+	fd->name[0] = '\0';
+	fd->value_offset = 0U;
+
+	while (info == CBOR_INDEFINITE ? !cbor_get_break(in, &fd->offset) :
+					 arg-- > 0) {
+		ret = cbor_get_label(in, &fd->offset, &label);
+		if (ret < 0) {
+			return ret;
+		}
+
+		switch (label) {
+
+		case SENML_LABEL_BN:
+			ret = cbor_get_text(in, &fd->offset, fd->base_name,
+					    sizeof(fd->base_name));
+			break;
+
+		case SENML_LABEL_N:
+			ret = cbor_get_text(in, &fd->offset, fd->name,
+					    sizeof(fd->name));
+			break;
+
+		case SENML_LABEL_V:
+		case SENML_LABEL_VS:
+		case SENML_LABEL_VB:
+		case SENML_LABEL_VD:
+		case SENML_LABEL_VLO:
+			fd->value_offset = fd->offset;
+			ret = cbor_skip(in, &fd->offset);
+			break;
+
+		default:
+			ret = cbor_skip(in, &fd->offset);
+			break;
+
+		}
+
+		if (ret < 0) {
+			LOG_ERR("Invalid SenML label %d", label);
+			return ret;
+		}
+	}
+
+	return 1;
+}
+
+static int record_path(struct cbor_in_formatter_data *fd,
+		       struct lwm2m_obj_path *path)
+{
+	char full_name[2 * SENML_NAME_LEN];
+
+	snprintk(full_name, sizeof(full_name), "%s%s", fd->base_name,
+		 fd->name);
+
+	return lwm2m_string_to_path(full_name, path);
+}
+
+/* Read the head of the value of the current record */
+static int get_value(struct lwm2m_input_context *in, uint8_t *major,
+		     uint8_t *info, uint64_t *arg)
+{
+	struct cbor_in_formatter_data *fd;
+	uint16_t offset;
+	int ret;
+
+	fd = engine_get_in_user_data(in);
+	if (!fd || fd->value_offset == 0U) {
+		return -EINVAL;
+	}
+
+	offset = fd->value_offset;
+	ret = cbor_get_head(in, &offset, major, info, arg);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return offset - fd->value_offset;
+}
+
+static int float16_to_b32(uint16_t half, uint8_t *b32)
+{
+	uint32_t exp = (half >> 10) & 0x1f;
+	uint32_t bin = (uint32_t)(half & 0x8000) << 16;
+
+	if (exp == 0x1f || (exp == 0U && (half & 0x3ff))) {
+		/* no infinity, NaN or subnormal in fixed point */
+		return -EINVAL;
+	}
+
+	if (exp != 0U) {
+		bin |= (exp - 15 + 127) << 23 | (uint32_t)(half & 0x3ff) << 13;
+	}
+
+	sys_put_be32(bin, b32);
+	return 0;
+}
+
+static size_t get_float(struct lwm2m_input_context *in,
+			float32_value_t *f32, float64_value_t *f64)
+{
+	uint8_t major, info, bin[8];
+	uint64_t arg;
+	int len, ret;
+
+	len = get_value(in, &major, &info, &arg);
+	if (len < 0) {
+		return 0;
+	}
+
+	if (major == CBOR_UINT || major == CBOR_NINT) {
+		f64->val1 = major == CBOR_NINT ? -1 - (int64_t)arg : arg;
+		f64->val2 = 0;
+		f32->val1 = f64->val1;
+		f32->val2 = 0;
+		return len;
+	}
+
+	if (major != CBOR_SIMPLE) {
+		return 0;
+	}
+
+	switch (info) {
+
+	case CBOR_FLOAT16:
+		ret = float16_to_b32(arg, bin);
+		ret = ret ? ret : lwm2m_b32_to_f32(bin, 4, f32);
+		f64->val1 = f32->val1;
+		f64->val2 = (int64_t)f32->val2 * 1000;
+		break;
+
+	case CBOR_FLOAT32:
+		sys_put_be32(arg, bin);
+		ret = lwm2m_b32_to_f32(bin, 4, f32);
+		f64->val1 = f32->val1;
+		f64->val2 = (int64_t)f32->val2 * 1000;
+		break;
+
+	case CBOR_FLOAT64:
+		sys_put_be64(arg, bin);
+		ret = lwm2m_b64_to_f64(bin, 8, f64);
+		f32->val1 = f64->val1;
+		f32->val2 = f64->val2 / 1000;
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+
+	}
+
+	return ret < 0 ? 0 : len;
+}
+
+static size_t get_s64(struct lwm2m_input_context *in, int64_t *value)
+{
+	float32_value_t f32;
+	float64_value_t f64;
+	size_t len;
+
+	len = get_float(in, &f32, &f64);
+	if (len > 0) {
+		*value = f64.val1;
+	}
+
+	return len;
+}
+
+static size_t get_s32(struct lwm2m_input_context *in, int32_t *value)
+{
+	int64_t tmp;
+	size_t len;
+
+	len = get_s64(in, &tmp);
+	if (len > 0) {
+		*value = (int32_t)tmp;
+	}
+
+	return len;
+}
+
+static size_t get_string(struct lwm2m_input_context *in,
+			 uint8_t *buf, size_t buflen)
+{
+	struct cbor_in_formatter_data *fd;
+	uint8_t major, info;
+	uint64_t arg;
+	int len;
+
+	len = get_value(in, &major, &info, &arg);
+	if (len < 0 || (major != CBOR_TEXT && major != CBOR_BYTES) ||
+	    buflen == 0) {
+		return 0;
+	}
+
+	fd = engine_get_in_user_data(in);
+
+	if (arg >= buflen) {
+		arg = buflen - 1;
+	}
+
+	memcpy(buf, in->in_cpkt->data + fd->value_offset + len, arg);
+	buf[arg] = '\0';
+
+	return len + arg;
+}
+
+static size_t get_float32fix(struct lwm2m_input_context *in,
+			     float32_value_t *value)
+{
+	float64_value_t f64;
+
+	return get_float(in, value, &f64);
+}
+
+static size_t get_float64fix(struct lwm2m_input_context *in,
+			     float64_value_t *value)
+{
+	float32_value_t f32;
+
+	return get_float(in, &f32, value);
+}
+
+static size_t get_bool(struct lwm2m_input_context *in, bool *value)
+{
+	uint8_t major, info;
+	uint64_t arg;
+	int len;
+
+	len = get_value(in, &major, &info, &arg);
+	if (len < 0 || major != CBOR_SIMPLE ||
+	    (info != CBOR_TRUE && info != CBOR_FALSE)) {
+		return 0;
+	}
+
+	*value = info == CBOR_TRUE;
+	return len;
+}
+
+static size_t get_opaque(struct lwm2m_input_context *in,
+			 uint8_t *value, size_t buflen,
+			 struct lwm2m_opaque_context *opaque,
+			 bool *last_block)
+{
+	struct cbor_in_formatter_data *fd;
+	uint8_t major, info;
+	uint64_t arg;
+	int len;
+
+	/* Get the item head only on first read. */
+	if (opaque->remaining == 0) {
+		len = get_value(in, &major, &info, &arg);
+		if (len < 0 || (major != CBOR_BYTES && major != CBOR_TEXT) ||
+		    info == CBOR_INDEFINITE) {
+			*last_block = true;
+			return 0;
+		}
+
+		fd = engine_get_in_user_data(in);
+		in->offset = fd->value_offset + len;
+		opaque->len = arg;
+		opaque->remaining = arg;
+	}
+
+	return lwm2m_engine_get_opaque_more(in, value, buflen,
+					    opaque, last_block);
+}
+
+static size_t get_objlnk(struct lwm2m_input_context *in,
+			 struct lwm2m_objlnk *value)
+{
+	char buf[sizeof("65535:65535")];
+	char *end;
+	size_t len;
+
+	len = get_string(in, buf, sizeof(buf));
+	if (len == 0) {
+		return 0;
+	}
+
+	value->obj_id = strtoul(buf, &end, 10);
+	if (*end != ':') {
+		return 0;
+	}
+
+	value->obj_inst = strtoul(end + 1, NULL, 10);
+
+	return len;
+}
+
+const struct lwm2m_writer senml_cbor_writer = {
+	.put_begin = put_begin,
+	.put_end = put_end,
+	.put_begin_ri = put_begin_ri,
+	.put_end_ri = put_end_ri,
+	.put_s8 = put_s8,
+	.put_s16 = put_s16,
+	.put_s32 = put_s32,
+	.put_s64 = put_s64,
+	.put_string = put_string,
+	.put_float32fix = put_float32fix,
+	.put_float64fix = put_float64fix,
+	.put_bool = put_bool,
+	.put_opaque = put_opaque,
+	.put_objlnk = put_objlnk,
+};
+
+const struct lwm2m_reader senml_cbor_reader = {
+	.get_s32 = get_s32,
+	.get_s64 = get_s64,
+	.get_string = get_string,
+	.get_float32fix = get_float32fix,
+	.get_float64fix = get_float64fix,
+	.get_bool = get_bool,
+	.get_opaque = get_opaque,
+	.get_objlnk = get_objlnk,
+};
+
+int do_read_op_senml_cbor(struct lwm2m_message *msg, int content_format)
+{
+	struct cbor_out_formatter_data fd;
+	int ret;
+
+	(void)memset(&fd, 0, sizeof(fd));
+	engine_set_out_user_data(&msg->out, &fd);
+	ret = lwm2m_perform_read_op(msg, content_format);
+	engine_clear_out_user_data(&msg->out);
+
+	return ret;
+}
+
+int do_composite_read_op_senml_cbor(struct lwm2m_message *msg,
+				    int content_format,
+				    struct lwm2m_obj_path *paths,
+				    uint8_t path_count)
+{
+	struct cbor_out_formatter_data fd;
+	int ret;
+
+	(void)memset(&fd, 0, sizeof(fd));
+	engine_set_out_user_data(&msg->out, &fd);
+	ret = lwm2m_perform_composite_read_op(msg, content_format, paths,
+					      path_count);
+	engine_clear_out_user_data(&msg->out);
+
+	return ret;
+}
+
+int do_write_op_senml_cbor(struct lwm2m_message *msg)
+{
+	struct cbor_in_formatter_data fd;
+	struct lwm2m_obj_path orig_path;
+	int ret;
+
+	ret = cbor_begin_pack(&msg->in, &fd);
+	if (ret < 0) {
+		return ret;
+	}
+
+	engine_set_in_user_data(&msg->in, &fd);
+
+	/* store a copy of the original path */
+	memcpy(&orig_path, &msg->path, sizeof(msg->path));
+
+	while ((ret = cbor_next_record(&msg->in, &fd)) > 0) {
+		if (fd.value_offset == 0U) {
+			continue;
+		}
+
+		ret = record_path(&fd, &msg->path);
+		if (ret < 0) {
+			break;
+		}
+
+		ret = lwm2m_write_path_handler(msg);
+		if (ret < 0) {
+			break;
+		}
+	}
+
+	memcpy(&msg->path, &orig_path, sizeof(msg->path));
+	engine_clear_in_user_data(&msg->in);
+
+	return ret;
+}
+
+int senml_cbor_parse_paths(struct lwm2m_message *msg,
+			   struct lwm2m_obj_path *paths, uint8_t max_paths)
+{
+	struct cbor_in_formatter_data fd;
+	int ret, count = 0;
+
+	ret = cbor_begin_pack(&msg->in, &fd);
+	if (ret < 0) {
+		return ret;
+	}
+
+	while ((ret = cbor_next_record(&msg->in, &fd)) > 0) {
+		if (count == max_paths) {
+			LOG_ERR("Too many paths in composite");
+			return -EFBIG;
+		}
+
+		ret = record_path(&fd, &paths[count]);
+		if (ret < 0) {
+			return ret;
+		}
+
+		count++;
+	}
+
+	return ret < 0 ? ret : count;
+}
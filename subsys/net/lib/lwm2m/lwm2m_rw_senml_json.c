@@ -0,0 +1,1043 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * SenML-JSON content format (RFC 8428, LwM2M 1.1 section 7.4.5).
+ *
+ * The records are named the same way as the SenML-CBOR ones, a base
+ * name of "/obj/inst/" set when the object instance changes and a name
+ * of "res" or "res/res_inst". Opaque values are base64url encoded, with
+ * no padding.
+ */
+
+#define LOG_MODULE_NAME net_lwm2m_senml_json
+#define LOG_LEVEL CONFIG_LWM2M_LOG_LEVEL
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <ctype.h>
+
+#include "lwm2m_object.h"
+#include "lwm2m_rw_senml_json.h"
+#include "lwm2m_rw_plain_text.h"
+#include "lwm2m_engine.h"
+
+#define TOKEN_BUF_LEN	64
+
+/* longest name: "/65535/65535/65535/65535" */
+#define SENML_NAME_LEN	25
+
+/* value types */
+#define VALUE_NONE	0
+#define VALUE_STRING	1
+#define VALUE_LITERAL	2
+
+#define MAX_DIGITS	18
+
+struct senml_json_out_formatter_data {
+	/* base name of the previous records */
+	uint16_t bn_obj_id;
+	uint16_t bn_obj_inst_id;
+
+	/* flags */
+	uint8_t writer_flags;
+};
+
+struct senml_json_in_formatter_data {
+	/* base name, applying to the records which do not set another */
+	char base_name[SENML_NAME_LEN];
+
+	/* name of the current record */
+	char name[SENML_NAME_LEN];
+
+	/* value of the current record, without the quotes of a string */
+	uint16_t value_offset;
+	uint16_t value_len;
+	uint8_t value_type;
+
+	/* offset of the next record */
+	uint16_t offset;
+
+	/* base64 decoding state of an opaque value */
+	uint16_t b64_offset;
+	uint16_t b64_acc;
+	uint8_t b64_bits;
+
+	bool first_record;
+};
+
+static const char b64url_alphabet[] =
+	"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+static size_t json_put(struct lwm2m_output_context *out,
+		       const char *buf, size_t len)
+{
+	if (buf_append(CPKT_BUF_WRITE(out->out_cpkt), (uint8_t *)buf,
+		       len) < 0) {
+		return 0;
+	}
+
+	return len;
+}
+
+/* Start a record, up to the label of its value */
+static size_t put_record(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path, const char *label)
+{
+	struct senml_json_out_formatter_data *fd;
+	char buf[TOKEN_BUF_LEN];
+	char base_name[sizeof("\"bn\":\"/65535/65535/\",")];
+	int len;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	if (!(fd->writer_flags & WRITER_OUTPUT_VALUE) ||
+	    fd->bn_obj_id != path->obj_id ||
+	    fd->bn_obj_inst_id != path->obj_inst_id) {
+		snprintk(base_name, sizeof(base_name), "\"bn\":\"/%u/%u/\",",
+			 path->obj_id, path->obj_inst_id);
+	} else {
+		base_name[0] = '\0';
+	}
+
+	if (fd->writer_flags & WRITER_RESOURCE_INSTANCE) {
+		len = snprintk(buf, sizeof(buf), "%s{%s\"n\":\"%u/%u\",\"%s\":",
+			       (fd->writer_flags & WRITER_OUTPUT_VALUE) ?
+			       "," : "", base_name, path->res_id,
+			       path->res_inst_id, label);
+	} else {
+		len = snprintk(buf, sizeof(buf), "%s{%s\"n\":\"%u\",\"%s\":",
+			       (fd->writer_flags & WRITER_OUTPUT_VALUE) ?
+			       "," : "", base_name, path->res_id, label);
+	}
+
+	if (len < 0 || len >= sizeof(buf) || json_put(out, buf, len) == 0) {
+		return 0;
+	}
+
+	fd->bn_obj_id = path->obj_id;
+	fd->bn_obj_inst_id = path->obj_inst_id;
+	fd->writer_flags |= WRITER_OUTPUT_VALUE;
+
+	return len;
+}
+
+static size_t put_record_end(struct lwm2m_output_context *out,
+			     size_t len, size_t value_len)
+{
+	if (len == 0 || value_len == 0 || json_put(out, "}", 1) == 0) {
+		return 0;
+	}
+
+	return len + value_len + 1;
+}
+
+static size_t put_begin(struct lwm2m_output_context *out,
+			struct lwm2m_obj_path *path)
+{
+	return json_put(out, "[", 1);
+}
+
+static size_t put_end(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path)
+{
+	return json_put(out, "]", 1);
+}
+
+static size_t put_begin_ri(struct lwm2m_output_context *out,
+			   struct lwm2m_obj_path *path)
+{
+	struct senml_json_out_formatter_data *fd;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	fd->writer_flags |= WRITER_RESOURCE_INSTANCE;
+	return 0;
+}
+
+static size_t put_end_ri(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path)
+{
+	struct senml_json_out_formatter_data *fd;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	fd->writer_flags &= ~WRITER_RESOURCE_INSTANCE;
+	return 0;
+}
+
+static size_t put_s64(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path, int64_t value)
+{
+	size_t len;
+
+	len = put_record(out, path, "v");
+	if (len == 0) {
+		return 0;
+	}
+
+	return put_record_end(out, len,
+			      plain_text_put_format(out, "%lld", value));
+}
+
+static size_t put_s32(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path, int32_t value)
+{
+	return put_s64(out, path, (int64_t)value);
+}
+
+static size_t put_s16(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path, int16_t value)
+{
+	return put_s64(out, path, (int64_t)value);
+}
+
+static size_t put_s8(struct lwm2m_output_context *out,
+		     struct lwm2m_obj_path *path, int8_t value)
+{
+	return put_s64(out, path, (int64_t)value);
+}
+
+static size_t put_string(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path,
+			 char *buf, size_t buflen)
+{
+	char escape[sizeof("\\u0000")];
+	size_t len, value_len, i;
+	int ret;
+
+	len = put_record(out, path, "vs");
+	if (len == 0 || json_put(out, "\"", 1) == 0) {
+		return 0;
+	}
+
+	value_len = 2;
+
+	for (i = 0; i < buflen; i++) {
+		if ((uint8_t)buf[i] < 0x20) {
+			ret = snprintk(escape, sizeof(escape), "\\u%04x",
+				       buf[i]);
+		} else if (buf[i] == '"' || buf[i] == '\\') {
+			escape[0] = '\\';
+			escape[1] = buf[i];
+			ret = 2;
+		} else {
+			escape[0] = buf[i];
+			ret = 1;
+		}
+
+		if (json_put(out, escape, ret) == 0) {
+			return 0;
+		}
+
+		value_len += ret;
+	}
+
+	if (json_put(out, "\"", 1) == 0) {
+		return 0;
+	}
+
+	return put_record_end(out, len, value_len);
+}
+
+static size_t put_opaque(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path,
+			 char *buf, size_t buflen)
+{
+	const uint8_t *data = (const uint8_t *)buf;
+	size_t len, value_len = 2, i;
+	char enc[4];
+	uint32_t group;
+	int n;
+
+	len = put_record(out, path, "vd");
+	if (len == 0 || json_put(out, "\"", 1) == 0) {
+		return 0;
+	}
+
+	for (i = 0; i < buflen; i += 3) {
+		n = MIN(buflen - i, 3);
+		group = data[i] << 16;
+		if (n > 1) {
+			group |= data[i + 1] << 8;
+		}
+
+		if (n > 2) {
+			group |= data[i + 2];
+		}
+
+		enc[0] = b64url_alphabet[(group >> 18) & 0x3f];
+		enc[1] = b64url_alphabet[(group >> 12) & 0x3f];
+		enc[2] = b64url_alphabet[(group >> 6) & 0x3f];
+		enc[3] = b64url_alphabet[group & 0x3f];
+
+		/* no padding in base64url */
+		if (json_put(out, enc, n + 1) == 0) {
+			return 0;
+		}
+
+		value_len += n + 1;
+	}
+
+	if (json_put(out, "\"", 1) == 0) {
+		return 0;
+	}
+
+	return put_record_end(out, len, value_len);
+}
+
+static size_t put_float32fix(struct lwm2m_output_context *out,
+			     struct lwm2m_obj_path *path,
+			     float32_value_t *value)
+{
+	size_t len;
+
+	len = put_record(out, path, "v");
+	if (len == 0) {
+		return 0;
+	}
+
+	return put_record_end(out, len,
+			      plain_text_put_float32fix(out, path, value));
+}
+
+static size_t put_float64fix(struct lwm2m_output_context *out,
+			     struct lwm2m_obj_path *path,
+			     float64_value_t *value)
+{
+	size_t len;
+
+	len = put_record(out, path, "v");
+	if (len == 0) {
+		return 0;
+	}
+
+	return put_record_end(out, len,
+			      plain_text_put_float64fix(out, path, value));
+}
+
+static size_t put_bool(struct lwm2m_output_context *out,
+		       struct lwm2m_obj_path *path,
+		       bool value)
+{
+	size_t len;
+
+	len = put_record(out, path, "vb");
+	if (len == 0) {
+		return 0;
+	}
+
+	return put_record_end(out, len,
+			      json_put(out, value ? "true" : "false",
+				       value ? 4 : 5));
+}
+
+static size_t put_objlnk(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path,
+			 struct lwm2m_objlnk *value)
+{
+	size_t len;
+
+	len = put_record(out, path, "vlo");
+	if (len == 0) {
+		return 0;
+	}
+
+	return put_record_end(out, len,
+			      plain_text_put_format(out, "\"%u:%u\"",
+						    value->obj_id,
+						    value->obj_inst));
+}
+
+/* Skip white space and return the next character, 0 at the end */
+static uint8_t json_peek(struct lwm2m_input_context *in,
+			 struct senml_json_in_formatter_data *fd)
+{
+	uint8_t c;
+
+	while (fd->offset < in->in_cpkt->offset) {
+		c = in->in_cpkt->data[fd->offset];
+		if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+			return c;
+		}
+
+		fd->offset++;
+	}
+
+	return 0;
+}
+
+static int json_expect(struct lwm2m_input_context *in,
+		       struct senml_json_in_formatter_data *fd, uint8_t c)
+{
+	if (json_peek(in, fd) != c) {
+		return -EINVAL;
+	}
+
+	fd->offset++;
+	return 0;
+}
+
+/* Find the bounds of a string, or of a number or literal name */
+static int json_get_value(struct lwm2m_input_context *in,
+			  struct senml_json_in_formatter_data *fd,
+			  uint16_t *start, uint16_t *len, uint8_t *type)
+{
+	uint8_t c = json_peek(in, fd);
+	bool escape = false;
+
+	if (c == '"') {
+		*start = ++fd->offset;
+		*type = VALUE_STRING;
+
+		while (fd->offset < in->in_cpkt->offset) {
+			c = in->in_cpkt->data[fd->offset++];
+			if (escape) {
+				escape = false;
+			} else if (c == '\\') {
+				escape = true;
+			} else if (c == '"') {
+				*len = fd->offset - *start - 1;
+				return 0;
+			}
+		}
+
+		return -EINVAL;
+	}
+
+	if (c == 0 || c == '{' || c == '[') {
+		return -EINVAL;
+	}
+
+	*start = fd->offset;
+	*type = VALUE_LITERAL;
+
+	while (fd->offset < in->in_cpkt->offset) {
+		c = in->in_cpkt->data[fd->offset];
+		if (c == ',' || c == '}' || c == ']' || c == ' ' ||
+		    c == '\t' || c == '\n' || c == '\r') {
+			break;
+		}
+
+		fd->offset++;
+	}
+
+	*len = fd->offset - *start;
+	return 0;
+}
+
+static bool json_key_is(struct lwm2m_input_context *in, uint16_t start,
+			uint16_t len, const char *key)
+{
+	return len == strlen(key) &&
+	       memcmp(in->in_cpkt->data + start, key, len) == 0;
+}
+
+static int json_get_name(struct lwm2m_input_context *in,
+			 struct senml_json_in_formatter_data *fd,
+			 char *buf, size_t buflen)
+{
+	uint16_t start, len;
+	uint8_t type;
+	int ret;
+
+	ret = json_get_value(in, fd, &start, &len, &type);
+	if (ret < 0 || type != VALUE_STRING || len >= buflen) {
+		return -EINVAL;
+	}
+
+	memcpy(buf, in->in_cpkt->data + start, len);
+	buf[len] = '\0';
+
+	return 0;
+}
+
+static int json_begin_pack(struct lwm2m_input_context *in,
+			   struct senml_json_in_formatter_data *fd)
+{
+	(void)memset(fd, 0, sizeof(*fd));
+	fd->offset = in->offset;
+	fd->first_record = true;
+
+	if (json_expect(in, fd, '[') < 0) {
+		LOG_ERR("SenML pack is not an array");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* Parse the next record of the pack. Returns 1 if there was one, 0 at the
+ * end of the pack.
+ */
+static int json_next_record(struct lwm2m_input_context *in,
+			    struct senml_json_in_formatter_data *fd)
+{
+	uint16_t key_start, key_len;
+	uint8_t type;
+	int ret;
+
+	if (json_peek(in, fd) == ']') {
+		fd->offset++;
+		return 0;
+	}
+
+	if (!fd->first_record && json_expect(in, fd, ',') < 0) {
+		return -EINVAL;
+	}
+
+	fd->first_record = false;
+
+	if (json_expect(in, fd, '{') < 0) {
+		LOG_ERR("SenML record is not an object");
+		return -EINVAL;
+	}
+
+	fd->name[0] = '\0';
+	fd->value_type = VALUE_NONE;
+
+	if (json_peek(in, fd) == '}') {
+		fd->offset++;
+		return 1;
+	}
+
+	do {
+		ret = json_get_value(in, fd, &key_start, &key_len, &type);
+		if (ret < 0 || type != VALUE_STRING ||
+		    json_expect(in, fd, ':') < 0) {
+			return -EINVAL;
+		}
+
+		if (json_key_is(in, key_start, key_len, "bn")) {
+			ret = json_get_name(in, fd, fd->base_name,
+					    sizeof(fd->base_name));
+		} else if (json_key_is(in, key_start, key_len, "n")) {
+			ret = json_get_name(in, fd, fd->name,
+					    sizeof(fd->name));
+		} else if (json_key_is(in, key_start, key_len, "v") ||
+			   json_key_is(in, key_start, key_len, "vs") ||
+			   json_key_is(in, key_start, key_len, "vb") ||
+			   json_key_is(in, key_start, key_len, "vd") ||
+			   json_key_is(in, key_start, key_len, "vlo")) {
+			ret = json_get_value(in, fd, &fd->value_offset,
+					     &fd->value_len, &fd->value_type);
+		} else {
+			ret = json_get_value(in, fd, &key_start, &key_len,
+					     &type);
+		}
+
+		if (ret < 0) {
+			return ret;
+		}
+	} while (json_expect(in, fd, ',') == 0);
+
+	if (json_expect(in, fd, '}') < 0) {
+		return -EINVAL;
+	}
+
+	return 1;
+}
+
+static int record_path(struct senml_json_in_formatter_data *fd,
+		       struct lwm2m_obj_path *path)
+{
+	char full_name[2 * SENML_NAME_LEN];
+
+	snprintk(full_name, sizeof(full_name), "%s%s", fd->base_name,
+		 fd->name);
+
+	return lwm2m_string_to_path(full_name, path);
+}
+
+/* Convert a JSON number to a fixed point value with frac_digits digits
+ * in val2.
+ */
+static size_t read_number(struct lwm2m_input_context *in,
+			  int64_t *val1, int64_t *val2, int frac_digits)
+{
+	struct senml_json_in_formatter_data *fd;
+	const uint8_t *buf;
+	int64_t mantissa = 0, div = 1, rem;
+	int digits = 0, scale = 0, exp = 0, exp_sign = 1, j;
+	bool neg = false, frac = false, mantissa_digit = false;
+	uint16_t i = 0;
+
+	fd = engine_get_in_user_data(in);
+	if (!fd || fd->value_type != VALUE_LITERAL) {
+		return 0;
+	}
+
+	buf = in->in_cpkt->data + fd->value_offset;
+
+	if (i < fd->value_len && buf[i] == '-') {
+		neg = true;
+		i++;
+	}
+
+	for (; i < fd->value_len; i++) {
+		if (isdigit(buf[i])) {
+			mantissa_digit = true;
+			if (digits < MAX_DIGITS) {
+				mantissa = mantissa * 10 + (buf[i] - '0');
+				digits += mantissa > 0 ? 1 : 0;
+				scale += frac ? 1 : 0;
+			} else if (!frac) {
+				/* drop the digits which do not fit */
+				exp++;
+			}
+		} else if (buf[i] == '.' && !frac) {
+			frac = true;
+		} else {
+			break;
+		}
+	}
+
+	if (i < fd->value_len && (buf[i] == 'e' || buf[i] == 'E')) {
+		int e = 0;
+
+		i++;
+		if (i < fd->value_len && (buf[i] == '-' || buf[i] == '+')) {
+			exp_sign = buf[i] == '-' ? -1 : 1;
+			i++;
+		}
+
+		/* the exponent needs a digit as well */
+		if (i == fd->value_len || !isdigit(buf[i])) {
+			return 0;
+		}
+
+		for (; i < fd->value_len && isdigit(buf[i]); i++) {
+			e = MIN(e * 10 + (buf[i] - '0'), 2 * MAX_DIGITS);
+		}
+
+		exp += exp_sign * e;
+	}
+
+	/* "-", "." or "e1" alone are not numbers */
+	if (!mantissa_digit || i != fd->value_len) {
+		return 0;
+	}
+
+	exp -= scale;
+	*val2 = 0;
+
+	if (exp >= 0) {
+		while (exp-- > 0 && mantissa < INT64_MAX / 10) {
+			mantissa *= 10;
+		}
+
+		*val1 = mantissa;
+	} else {
+		while (exp < 0 && div < INT64_MAX / 10) {
+			div *= 10;
+			exp++;
+		}
+
+		*val1 = mantissa / div;
+		rem = mantissa % div;
+
+		/* scale the remainder to frac_digits decimals */
+		for (j = 0; j < frac_digits; j++) {
+			if (rem < INT64_MAX / 10) {
+				rem *= 10;
+			} else if (div > 1) {
+				div /= 10;
+			}
+		}
+
+		*val2 = rem / div;
+	}
+
+	if (neg) {
+		*val1 = -*val1;
+		*val2 = -*val2;
+	}
+
+	return fd->value_len;
+}
+
+static size_t get_s64(struct lwm2m_input_context *in, int64_t *value)
+{
+	int64_t frac;
+
+	return read_number(in, value, &frac, 0);
+}
+
+static size_t get_s32(struct lwm2m_input_context *in, int32_t *value)
+{
+	int64_t tmp1, tmp2;
+	size_t len;
+
+	len = read_number(in, &tmp1, &tmp2, 0);
+	if (len > 0) {
+		*value = (int32_t)tmp1;
+	}
+
+	return len;
+}
+
+static int hex_value(uint8_t c)
+{
+	if (isdigit(c)) {
+		return c - '0';
+	}
+
+	c = tolower(c);
+	if (c >= 'a' && c <= 'f') {
+		return c - 'a' + 10;
+	}
+
+	return -EINVAL;
+}
+
+static size_t get_string(struct lwm2m_input_context *in,
+			 uint8_t *buf, size_t buflen)
+{
+	struct senml_json_in_formatter_data *fd;
+	const uint8_t *src;
+	size_t len = 0;
+	uint16_t i;
+	uint32_t cp;
+	int j, h;
+
+	fd = engine_get_in_user_data(in);
+	if (!fd || fd->value_type != VALUE_STRING || buflen == 0) {
+		return 0;
+	}
+
+	src = in->in_cpkt->data + fd->value_offset;
+
+	for (i = 0; i < fd->value_len && len < buflen - 1; i++) {
+		if (src[i] != '\\' || i + 1 == fd->value_len) {
+			buf[len++] = src[i];
+			continue;
+		}
+
+		switch (src[++i]) {
+		case 'b':
+			buf[len++] = '\b';
+			break;
+		case 'f':
+			buf[len++] = '\f';
+			break;
+		case 'n':
+			buf[len++] = '\n';
+			break;
+		case 'r':
+			buf[len++] = '\r';
+			break;
+		case 't':
+			buf[len++] = '\t';
+			break;
+		case 'u':
+			cp = 0U;
+			for (j = 0; j < 4 && i + 1 < fd->value_len; j++) {
+				h = hex_value(src[++i]);
+				if (h < 0) {
+					return 0;
+				}
+
+				cp = (cp << 4) | h;
+			}
+
+			/* encode the code point as UTF-8 */
+			if (cp < 0x80) {
+				buf[len++] = cp;
+			} else if (cp < 0x800 && len + 2 < buflen) {
+				buf[len++] = 0xc0 | (cp >> 6);
+				buf[len++] = 0x80 | (cp & 0x3f);
+			} else if (len + 3 < buflen) {
+				buf[len++] = 0xe0 | (cp >> 12);
+				buf[len++] = 0x80 | ((cp >> 6) & 0x3f);
+				buf[len++] = 0x80 | (cp & 0x3f);
+			}
+			break;
+		default:
+			buf[len++] = src[i];
+			break;
+		}
+	}
+
+	buf[len] = '\0';
+
+	return fd->value_len;
+}
+
+static size_t get_float32fix(struct lwm2m_input_context *in,
+			     float32_value_t *value)
+{
+	int64_t tmp1, tmp2;
+	size_t len;
+
+	len = read_number(in, &tmp1, &tmp2, 6);
+	if (len > 0) {
+		value->val1 = (int32_t)tmp1;
+		value->val2 = (int32_t)tmp2;
+	}
+
+	return len;
+}
+
+static size_t get_float64fix(struct lwm2m_input_context *in,
+			     float64_value_t *value)
+{
+	return read_number(in, &value->val1, &value->val2, 9);
+}
+
+static size_t get_bool(struct lwm2m_input_context *in, bool *value)
+{
+	struct senml_json_in_formatter_data *fd;
+
+	fd = engine_get_in_user_data(in);
+	if (!fd || fd->value_type != VALUE_LITERAL) {
+		return 0;
+	}
+
+	if (json_key_is(in, fd->value_offset, fd->value_len, "true")) {
+		*value = true;
+	} else if (json_key_is(in, fd->value_offset, fd->value_len,
+			       "false")) {
+		*value = false;
+	} else {
+		return 0;
+	}
+
+	return fd->value_len;
+}
+
+static int b64url_value(uint8_t c)
+{
+	const char *p;
+
+	/* accept the base64 alphabet as well */
+	if (c == '+') {
+		c = '-';
+	} else if (c == '/') {
+		c = '_';
+	}
+
+	p = strchr(b64url_alphabet, c);
+	if (!p || c == '\0') {
+		return -EINVAL;
+	}
+
+	return p - b64url_alphabet;
+}
+
+static size_t get_opaque(struct lwm2m_input_context *in,
+			 uint8_t *value, size_t buflen,
+			 struct lwm2m_opaque_context *opaque,
+			 bool *last_block)
+{
+	struct senml_json_in_formatter_data *fd;
+	uint16_t end;
+	size_t len = 0;
+	int v;
+
+	fd = engine_get_in_user_data(in);
+	if (!fd || fd->value_type != VALUE_STRING) {
+		*last_block = true;
+		return 0;
+	}
+
+	end = fd->value_offset + fd->value_len;
+
+	/* Start decoding only on first read. */
+	if (opaque->remaining == 0) {
+		while (end > fd->value_offset &&
+		       in->in_cpkt->data[end - 1] == '=') {
+			end--;
+		}
+
+		fd->b64_offset = fd->value_offset;
+		fd->b64_acc = 0U;
+		fd->b64_bits = 0U;
+		opaque->len = (end - fd->value_offset) * 3 / 4;
+		opaque->remaining = opaque->len;
+	}
+
+	while (len < buflen && opaque->remaining > 0) {
+		while (fd->b64_bits < 8) {
+			v = b64url_value(in->in_cpkt->data[fd->b64_offset++]);
+			if (v < 0) {
+				*last_block = true;
+				return 0;
+			}
+
+			fd->b64_acc = (fd->b64_acc << 6) | v;
+			fd->b64_bits += 6;
+		}
+
+		fd->b64_bits -= 8;
+		value[len++] = fd->b64_acc >> fd->b64_bits;
+		opaque->remaining--;
+	}
+
+	*last_block = opaque->remaining == 0;
+
+	return len;
+}
+
+static size_t get_objlnk(struct lwm2m_input_context *in,
+			 struct lwm2m_objlnk *value)
+{
+	char buf[sizeof("65535:65535")];
+	char *end;
+	size_t len;
+
+	len = get_string(in, buf, sizeof(buf));
+	if (len == 0) {
+		return 0;
+	}
+
+	value->obj_id = strtoul(buf, &end, 10);
+	if (*end != ':') {
+		return 0;
+	}
+
+	value->obj_inst = strtoul(end + 1, NULL, 10);
+
+	return len;
+}
+
+const struct lwm2m_writer senml_json_writer = {
+	.put_begin = put_begin,
+	.put_end = put_end,
+	.put_begin_ri = put_begin_ri,
+	.put_end_ri = put_end_ri,
+	.put_s8 = put_s8,
+	.put_s16 = put_s16,
+	.put_s32 = put_s32,
+	.put_s64 = put_s64,
+	.put_string = put_string,
+	.put_float32fix = put_float32fix,
+	.put_float64fix = put_float64fix,
+	.put_bool = put_bool,
+	.put_opaque = put_opaque,
+	.put_objlnk = put_objlnk,
+};
+
+const struct lwm2m_reader senml_json_reader = {
+	.get_s32 = get_s32,
+	.get_s64 = get_s64,
+	.get_string = get_string,
+	.get_float32fix = get_float32fix,
+	.get_float64fix = get_float64fix,
+	.get_bool = get_bool,
+	.get_opaque = get_opaque,
+	.get_objlnk = get_objlnk,
+};
+
+int do_read_op_senml_json(struct lwm2m_message *msg, int content_format)
+{
+	struct senml_json_out_formatter_data fd;
+	int ret;
+
+	(void)memset(&fd, 0, sizeof(fd));
+	engine_set_out_user_data(&msg->out, &fd);
+	ret = lwm2m_perform_read_op(msg, content_format);
+	engine_clear_out_user_data(&msg->out);
+
+	return ret;
+}
+
+int do_composite_read_op_senml_json(struct lwm2m_message *msg,
+				    int content_format,
+				    struct lwm2m_obj_path *paths,
+				    uint8_t path_count)
+{
+	struct senml_json_out_formatter_data fd;
+	int ret;
+
+	(void)memset(&fd, 0, sizeof(fd));
+	engine_set_out_user_data(&msg->out, &fd);
+	ret = lwm2m_perform_composite_read_op(msg, content_format, paths,
+					      path_count);
+	engine_clear_out_user_data(&msg->out);
+
+	return ret;
+}
+
+int do_write_op_senml_json(struct lwm2m_message *msg)
+{
+	struct senml_json_in_formatter_data fd;
+	struct lwm2m_obj_path orig_path;
+	int ret;
+
+	ret = json_begin_pack(&msg->in, &fd);
+	if (ret < 0) {
+		return ret;
+	}
+
+	engine_set_in_user_data(&msg->in, &fd);
+
+	/* store a copy of the original path */
+	memcpy(&orig_path, &msg->path, sizeof(msg->path));
+
+	while ((ret = json_next_record(&msg->in, &fd)) > 0) {
+		if (fd.value_type == VALUE_NONE) {
+			continue;
+		}
+
+		ret = record_path(&fd, &msg->path);
+		if (ret < 0) {
+			break;
+		}
+
+		ret = lwm2m_write_path_handler(msg);
+		if (ret < 0) {
+			break;
+		}
+	}
+
+	memcpy(&msg->path, &orig_path, sizeof(msg->path));
+	engine_clear_in_user_data(&msg->in);
+
+	return ret;
+}
+
+int senml_json_parse_paths(struct lwm2m_message *msg,
+			   struct lwm2m_obj_path *paths, uint8_t max_paths)
+{
+	struct senml_json_in_formatter_data fd;
+	int ret, count = 0;
+
+	ret = json_begin_pack(&msg->in, &fd);
+	if (ret < 0) {
+		return ret;
+	}
+
+	while ((ret = json_next_record(&msg->in, &fd)) > 0) {
+		if (count == max_paths) {
+			LOG_ERR("Too many paths in composite");
+			return -EFBIG;
+		}
+
+		ret = record_path(&fd, &paths[count]);
+		if (ret < 0) {
+			return ret;
+		}
+
+		count++;
+	}
+
+	return ret < 0 ? ret : count;
+}
@@ -236,16 +236,296 @@ static int verify_tx_state(const struct mqtt_client *client)
 	return 0;
 }
 
-int mqtt_publish(struct mqtt_client *client,
-		 const struct mqtt_publish_param *param)
+static int publish_msg_encode(struct mqtt_client *client,
+			      const struct mqtt_publish_param *param,
+			      struct iovec io_vector[2], struct msghdr *msg)
+{
+	int err_code;
+	struct buf_ctx packet;
+
+	tx_buf_init(client, &packet);
+
+	err_code = publish_encode(param, &packet);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	io_vector[0].iov_base = packet.cur;
+	io_vector[0].iov_len = packet.end - packet.cur;
+	io_vector[1].iov_base = param->message.payload.data;
+	io_vector[1].iov_len = param->message.payload.len;
+
+	memset(msg, 0, sizeof(*msg));
+
+	msg->msg_iov = io_vector;
+	msg->msg_iovlen = 2;
+
+	return 0;
+}
+
+/* Sends the header encoded in the packet with the first chunk of the
+ * payload, to fill the transmit buffer. On failure the message is
+ * incomplete, the caller has to disconnect.
+ */
+static int publish_stream_write(struct mqtt_client *client,
+				struct buf_ctx *packet,
+				const struct mqtt_publish_param *param,
+				mqtt_payload_cb_t payload_cb, void *user_data)
+{
+	const uint32_t payload_len = param->message.payload.len;
+	uint8_t *tx_end = client->tx_buf + client->tx_buf_size;
+	uint32_t offset = 0U;
+	uint32_t chunk_len;
+	int err_code;
+
+	do {
+		chunk_len = MIN(payload_len - offset, tx_end - packet->end);
+		if (chunk_len > 0) {
+			err_code = payload_cb(client, user_data, offset,
+					      packet->end, chunk_len);
+			if (err_code < 0) {
+				return err_code;
+			}
+
+			if (err_code == 0 || (uint32_t)err_code > chunk_len) {
+				return -EIO;
+			}
+
+			packet->end += err_code;
+			offset += err_code;
+		}
+
+		err_code = mqtt_transport_write(client, packet->cur,
+						packet->end - packet->cur);
+		if (err_code < 0) {
+			return err_code;
+		}
+
+		packet->cur = client->tx_buf;
+		packet->end = client->tx_buf;
+	} while (offset < payload_len);
+
+	client->internal.last_activity = mqtt_sys_tick_in_ms_get();
+
+	return 0;
+}
+
+#if defined(CONFIG_MQTT_LIB_INFLIGHT)
+static struct mqtt_inflight_msg *inflight_find(struct mqtt_client *client,
+					       uint16_t message_id)
+{
+	struct mqtt_inflight_msg *inflight = client->internal.inflight;
+
+	for (int i = 0; i < CONFIG_MQTT_LIB_INFLIGHT_MAX; i++) {
+		if (inflight[i].ack_type != 0U &&
+		    inflight[i].param.message_id == message_id) {
+			return &inflight[i];
+		}
+	}
+
+	return NULL;
+}
+
+static uint16_t inflight_next_message_id(struct mqtt_client *client)
+{
+	uint16_t message_id = client->internal.last_message_id;
+
+	/* Message id 0 is not allowed, and the number of ids in use is small
+	 * compared to the id space, so this terminates quickly.
+	 */
+	do {
+		message_id++;
+	} while (message_id == 0U || inflight_find(client, message_id));
+
+	client->internal.last_message_id = message_id;
+
+	return message_id;
+}
+
+static int inflight_add(struct mqtt_client *client,
+			const struct mqtt_publish_param *param,
+			mqtt_payload_cb_t payload_cb, void *user_data,
+			struct mqtt_inflight_msg **entry)
+{
+	struct mqtt_inflight_msg *inflight = client->internal.inflight;
+	struct mqtt_inflight_msg *free_entry = NULL;
+
+	for (int i = 0; i < CONFIG_MQTT_LIB_INFLIGHT_MAX; i++) {
+		if (inflight[i].ack_type == 0U) {
+			free_entry = &inflight[i];
+			break;
+		}
+	}
+
+	if (free_entry == NULL) {
+		return -EAGAIN;
+	}
+
+	if (param->message_id != 0U &&
+	    inflight_find(client, param->message_id)) {
+		MQTT_ERR("Message id 0x%04x already in use", param->message_id);
+		return -EBUSY;
+	}
+
+	free_entry->param = *param;
+	free_entry->payload_cb = payload_cb;
+	free_entry->user_data = user_data;
+	if (free_entry->param.message_id == 0U) {
+		free_entry->param.message_id = inflight_next_message_id(client);
+	}
+
+	free_entry->ack_type =
+		(param->message.topic.qos == MQTT_QOS_1_AT_LEAST_ONCE) ?
+		MQTT_PKT_TYPE_PUBACK : MQTT_PKT_TYPE_PUBREC;
+
+	*entry = free_entry;
+
+	return 0;
+}
+
+/* Writes from the RX path, the caller disconnects on failure. */
+static int inflight_write(struct mqtt_client *client,
+			  struct mqtt_inflight_msg *entry)
 {
 	int err_code;
 	struct buf_ctx packet;
 	struct iovec io_vector[2];
 	struct msghdr msg;
 
-	NULL_PARAM_CHECK(client);
-	NULL_PARAM_CHECK(param);
+	if (entry->ack_type == MQTT_PKT_TYPE_PUBCOMP) {
+		const struct mqtt_pubrel_param param = {
+			.message_id = entry->param.message_id,
+		};
+
+		tx_buf_init(client, &packet);
+
+		err_code = publish_release_encode(&param, &packet);
+		if (err_code < 0) {
+			return err_code;
+		}
+
+		err_code = mqtt_transport_write(client, packet.cur,
+						packet.end - packet.cur);
+	} else if (entry->payload_cb != NULL) {
+		tx_buf_init(client, &packet);
+
+		err_code = publish_encode(&entry->param, &packet);
+		if (err_code < 0) {
+			return err_code;
+		}
+
+		return publish_stream_write(client, &packet, &entry->param,
+					    entry->payload_cb,
+					    entry->user_data);
+	} else {
+		err_code = publish_msg_encode(client, &entry->param,
+					      io_vector, &msg);
+		if (err_code < 0) {
+			return err_code;
+		}
+
+		err_code = mqtt_transport_write_msg(client, &msg);
+	}
+
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	client->internal.last_activity = mqtt_sys_tick_in_ms_get();
+
+	return 0;
+}
+
+int mqtt_inflight_ack(struct mqtt_client *client, uint8_t type,
+		      uint16_t message_id)
+{
+	struct mqtt_inflight_msg *entry;
+
+	entry = inflight_find(client, message_id);
+	if (entry == NULL) {
+		MQTT_TRC("[CID %p]: No in-flight message 0x%04x", client,
+			 message_id);
+		return 0;
+	}
+
+	switch (type) {
+	case MQTT_PKT_TYPE_PUBACK:
+		if (entry->ack_type == MQTT_PKT_TYPE_PUBACK) {
+			entry->ack_type = 0U;
+		}
+
+		return 0;
+
+	case MQTT_PKT_TYPE_PUBREC:
+		/* A repeated PUBREC is answered with PUBREL again. */
+		if (entry->ack_type == MQTT_PKT_TYPE_PUBACK) {
+			return 0;
+		}
+
+		entry->ack_type = MQTT_PKT_TYPE_PUBCOMP;
+
+		return inflight_write(client, entry);
+
+	case MQTT_PKT_TYPE_PUBCOMP:
+		if (entry->ack_type == MQTT_PKT_TYPE_PUBCOMP) {
+			entry->ack_type = 0U;
+		}
+
+		return 0;
+
+	default:
+		return 0;
+	}
+}
+
+int mqtt_inflight_resend(struct mqtt_client *client, bool session_present)
+{
+	struct mqtt_inflight_msg *inflight = client->internal.inflight;
+	int err_code;
+
+	for (int i = 0; i < CONFIG_MQTT_LIB_INFLIGHT_MAX; i++) {
+		if (inflight[i].ack_type == 0U) {
+			continue;
+		}
+
+		if (!session_present) {
+			/* A new session only needs the messages which did not
+			 * reach the broker yet, as new messages.
+			 */
+			if (inflight[i].ack_type == MQTT_PKT_TYPE_PUBCOMP) {
+				inflight[i].ack_type = 0U;
+				continue;
+			}
+
+			inflight[i].param.dup_flag = 0U;
+		} else if (inflight[i].ack_type != MQTT_PKT_TYPE_PUBCOMP) {
+			inflight[i].param.dup_flag = 1U;
+		}
+
+		MQTT_TRC("[CID %p]: Resending message 0x%04x", client,
+			 inflight[i].param.message_id);
+
+		err_code = inflight_write(client, &inflight[i]);
+		if (err_code < 0) {
+			return err_code;
+		}
+	}
+
+	return 0;
+}
+#endif /* CONFIG_MQTT_LIB_INFLIGHT */
+
+static int client_publish(struct mqtt_client *client,
+			  const struct mqtt_publish_param *param,
+			  mqtt_payload_cb_t payload_cb, void *user_data)
+{
+	int err_code;
+	struct buf_ctx packet;
+	struct iovec io_vector[2];
+	struct msghdr msg;
+#if defined(CONFIG_MQTT_LIB_INFLIGHT)
+	struct mqtt_inflight_msg *inflight = NULL;
+#endif
 
 	MQTT_TRC("[CID %p]:[State 0x%02x]: >> Topic size 0x%08x, "
 		 "Data size 0x%08x", client, client->internal.state,
@@ -254,31 +534,55 @@ int mqtt_publish(struct mqtt_client *client,
 
 	mqtt_mutex_lock(client);
 
-	tx_buf_init(client, &packet);
-
 	err_code = verify_tx_state(client);
 	if (err_code < 0) {
 		goto error;
 	}
 
-	err_code = publish_encode(param, &packet);
-	if (err_code < 0) {
-		goto error;
+#if defined(CONFIG_MQTT_LIB_INFLIGHT)
+	if (param->message.topic.qos > MQTT_QOS_0_AT_MOST_ONCE) {
+		err_code = inflight_add(client, param, payload_cb, user_data,
+					&inflight);
+		if (err_code < 0) {
+			goto error;
+		}
+
+		param = &inflight->param;
 	}
+#endif
 
-	io_vector[0].iov_base = packet.cur;
-	io_vector[0].iov_len = packet.end - packet.cur;
-	io_vector[1].iov_base = param->message.payload.data;
-	io_vector[1].iov_len = param->message.payload.len;
+	if (payload_cb != NULL) {
+		tx_buf_init(client, &packet);
+
+		err_code = publish_encode(param, &packet);
+		if (err_code < 0) {
+			goto error;
+		}
 
-	memset(&msg, 0, sizeof(msg));
+		err_code = publish_stream_write(client, &packet, param,
+						payload_cb, user_data);
+		if (err_code < 0) {
+			client_disconnect(client, err_code, true);
+		}
 
-	msg.msg_iov = io_vector;
-	msg.msg_iovlen = ARRAY_SIZE(io_vector);
+		goto error;
+	}
+
+	err_code = publish_msg_encode(client, param, io_vector, &msg);
+	if (err_code < 0) {
+		goto error;
+	}
 
 	err_code = client_write_msg(client, &msg);
 
 error:
+#if defined(CONFIG_MQTT_LIB_INFLIGHT)
+	/* The application gets the error, it is not retransmitted. */
+	if (err_code < 0 && inflight != NULL) {
+		inflight->ack_type = 0U;
+	}
+#endif
+
 	MQTT_TRC("[CID %p]:[State 0x%02x]: << result 0x%08x",
 			 client, client->internal.state, err_code);
 
@@ -287,6 +591,26 @@ error:
 	return err_code;
 }
 
+int mqtt_publish(struct mqtt_client *client,
+		 const struct mqtt_publish_param *param)
+{
+	NULL_PARAM_CHECK(client);
+	NULL_PARAM_CHECK(param);
+
+	return client_publish(client, param, NULL, NULL);
+}
+
+int mqtt_publish_stream(struct mqtt_client *client,
+			const struct mqtt_publish_param *param,
+			mqtt_payload_cb_t payload_cb, void *user_data)
+{
+	NULL_PARAM_CHECK(client);
+	NULL_PARAM_CHECK(param);
+	NULL_PARAM_CHECK(payload_cb);
+
+	return client_publish(client, param, payload_cb, user_data);
+}
+
 int mqtt_publish_qos1_ack(struct mqtt_client *client,
 			  const struct mqtt_puback_param *param)
 {
@@ -366,6 +690,9 @@ int mqtt_publish_qos2_release(struct mqtt_client *client,
 {
 	int err_code;
 	struct buf_ctx packet;
+#if defined(CONFIG_MQTT_LIB_INFLIGHT)
+	struct mqtt_inflight_msg *inflight;
+#endif
 
 	NULL_PARAM_CHECK(client);
 	NULL_PARAM_CHECK(param);
@@ -382,6 +709,16 @@ int mqtt_publish_qos2_release(struct mqtt_client *client,
 		goto error;
 	}
 
+#if defined(CONFIG_MQTT_LIB_INFLIGHT)
+	/* The PUBREL was sent when the PUBREC was received. */
+	inflight = inflight_find(client, param->message_id);
+	if (inflight != NULL && inflight->ack_type == MQTT_PKT_TYPE_PUBCOMP) {
+		MQTT_TRC("[CID %p]: Message 0x%04x already released", client,
+			 param->message_id);
+		goto error;
+	}
+#endif
+
 	err_code = publish_release_encode(param, &packet);
 	if (err_code < 0) {
 		goto error;
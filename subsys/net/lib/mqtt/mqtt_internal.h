@@ -162,6 +162,28 @@ void event_notify(struct mqtt_client *client, const struct mqtt_evt *evt);
  */
 int mqtt_handle_rx(struct mqtt_client *client);
 
+#if defined(CONFIG_MQTT_LIB_INFLIGHT)
+/**@brief Matches an acknowledgment with the in-flight publish messages.
+ *
+ * @param[in] client Identifies the client for which the data was received.
+ * @param[in] type Packet type of the acknowledgment.
+ * @param[in] message_id Message id of the acknowledgment.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int mqtt_inflight_ack(struct mqtt_client *client, uint8_t type,
+		      uint16_t message_id);
+
+/**@brief Sends the in-flight publish messages again after a reconnect.
+ *
+ * @param[in] client Identifies the client which connected.
+ * @param[in] session_present Whether the broker kept the session.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int mqtt_inflight_resend(struct mqtt_client *client, bool session_present);
+#endif /* CONFIG_MQTT_LIB_INFLIGHT */
+
 /**@brief Constructs/encodes Connect packet.
  *
  * @param[in] client Identifies the client for which the procedure is requested.
@@ -25,7 +25,10 @@ typedef int (*transport_connect_handler_t)(struct mqtt_client *client);
 typedef int (*transport_write_handler_t)(struct mqtt_client *client,
 					 const uint8_t *data, uint32_t datalen);
 
-/**@brief Transport write message handler, similar to POSIX sendmsg function. */
+/**@brief Transport write message handler, similar to POSIX sendmsg function.
+ *        The whole message is written, the I/O vectors may be modified to
+ *        do so.
+ */
 typedef int (*transport_write_msg_handler_t)(struct mqtt_client *client,
 					     const struct msghdr *message);
 
@@ -87,7 +90,8 @@ int mqtt_transport_write(struct mqtt_client *client, const uint8_t *data,
  *
  * @param[in] client Identifies the client on which the procedure is requested.
  * @param[in] message Pointer to the `struct msghdr` structure, containing data
- *            to be written on the transport.
+ *            to be written on the transport. The I/O vectors may be
+ *            modified.
  *
  * @retval 0 or an error code indicating reason for failure.
  */
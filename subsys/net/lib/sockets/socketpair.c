@@ -15,6 +15,7 @@ LOG_MODULE_REGISTER(net_spair, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <syscall_handler.h>
 #include <sys/__assert.h>
 #include <sys/fdtable.h>
+#include <sys/ring_buffer.h>
 
 #include "sockets_internal.h"
 
@@ -47,12 +48,22 @@ enum {
  * - read operations may block if the local @a recv_q is empty
  * - write operations may block if the remote @a recv_q is full
  * - each endpoint may be blocking or non-blocking
+ * - data is copied straight to and from the ring buffer of @a recv_q, or
+ *   accessed in place with the zsock_socketpair_*_claim() functions
+ * - a blocked reader waits on its own @a data_sem, given by the writer, and
+ *   a blocked writer waits on its own @a space_sem, given by the reader
  */
 __net_socket struct spair {
 	int remote; /**< the remote endpoint file descriptor */
 	uint32_t flags; /**< status and option bits */
 	struct k_sem sem; /**< semaphore for exclusive structure access */
-	struct k_pipe recv_q; /**< receive queue of local endpoint */
+	struct ring_buf recv_q; /**< receive queue of local endpoint */
+	/** given when data is written to the local @a recv_q */
+	struct k_sem data_sem;
+	/** given when data is read from the remote @a recv_q */
+	struct k_sem space_sem;
+	/** size of the pending zero-copy claim */
+	uint32_t claim_len;
 	/** indicates local @a recv_q isn't empty */
 	struct k_poll_signal readable;
 	/** indicates local @a recv_q isn't full */
@@ -106,7 +117,7 @@ static inline size_t spair_write_avail(struct spair *spair)
 		return 0;
 	}
 
-	return k_pipe_write_avail(&remote->recv_q);
+	return ring_buf_space_get(&remote->recv_q);
 }
 
 /**
@@ -117,7 +128,8 @@ static inline size_t spair_write_avail(struct spair *spair)
  */
 static inline size_t spair_read_avail(struct spair *spair)
 {
-	return k_pipe_read_avail(&spair->recv_q);
+	return ring_buf_capacity_get(&spair->recv_q) -
+	       ring_buf_space_get(&spair->recv_q);
 }
 
 /** Swap two 32-bit integers */
@@ -152,7 +164,8 @@ static inline void swap32(uint32_t *a, uint32_t *b)
  *
  * If the remote endpoint is already closed, the former operation does not
  * take place. Otherwise, the @ref spair.remote of the local endpoint is
- * set to -1.
+ * set to -1, and the threads blocked on the remote @ref spair.data_sem and
+ * @ref spair.space_sem are woken up, to return end-of-file and @ref EPIPE.
  *
  * If no threads are blocking on A, then the signals have no effect.
  *
@@ -182,6 +195,14 @@ static void spair_delete(struct spair *spair)
 				__ASSERT(res == 0,
 					"k_poll_signal_raise() failed: %d",
 					res);
+
+				/* Wake the blocked threads up, and leave a
+				 * token for those about to block.
+				 */
+				k_sem_reset(&remote->data_sem);
+				k_sem_give(&remote->data_sem);
+				k_sem_reset(&remote->space_sem);
+				k_sem_give(&remote->space_sem);
 			}
 		}
 	}
@@ -241,7 +262,9 @@ static struct spair *spair_new(void)
 	spair->flags = SPAIR_FLAGS_DEFAULT;
 
 	k_sem_init(&spair->sem, 1, 1);
-	k_pipe_init(&spair->recv_q, spair->buf, sizeof(spair->buf));
+	ring_buf_init(&spair->recv_q, sizeof(spair->buf), spair->buf);
+	k_sem_init(&spair->data_sem, 0, 1);
+	k_sem_init(&spair->space_sem, 0, 1);
 	k_poll_signal_init(&spair->readable);
 	k_poll_signal_init(&spair->writeable);
 
@@ -351,49 +374,126 @@ out:
 #include <syscalls/zsock_socketpair_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+/**
+ * Complete a write to the @em remote @ref spair.recv_q
+ *
+ * Called with both semaphores held, once data was added to the remote
+ * @ref spair.recv_q: wakes the reader blocked on the remote end up and
+ * updates the poll signals.
+ */
+static void spair_write_done(struct spair *spair, struct spair *remote)
+{
+	int res;
+
+	if (ring_buf_space_get(&remote->recv_q) == 0) {
+		k_poll_signal_reset(&remote->writeable);
+	} else {
+		/* Let the next blocked writer in */
+		k_sem_give(&spair->space_sem);
+	}
+
+	res = k_poll_signal_raise(&remote->readable, SPAIR_SIG_DATA);
+	__ASSERT(res == 0, "k_poll_signal_raise() failed: %d", res);
+
+	k_sem_give(&remote->data_sem);
+}
+
+/**
+ * Complete a read from the @em local @ref spair.recv_q
+ *
+ * Called with the local semaphore held, once data was removed from the
+ * local @ref spair.recv_q: wakes the writer blocked on the remote end up
+ * and updates the poll signals.
+ */
+static void spair_read_done(struct spair *spair)
+{
+	int res;
+	struct spair *remote;
+
+	if (ring_buf_is_empty(&spair->recv_q)) {
+		if (!sock_is_eof(spair)) {
+			k_poll_signal_reset(&spair->readable);
+		}
+	} else {
+		/* Let the next blocked reader in */
+		k_sem_give(&spair->data_sem);
+	}
+
+	/* The remote end cannot be deleted while the local semaphore is
+	 * held, as deleting it takes the local semaphore.
+	 */
+	remote = z_get_fd_obj(spair->remote,
+		(const struct fd_op_vtable *)&spair_fd_op_vtable, 0);
+
+	if (remote != NULL) {
+		res = k_poll_signal_raise(&spair->writeable, SPAIR_SIG_DATA);
+		__ASSERT(res == 0, "k_poll_signal_raise() failed: %d", res);
+
+		k_sem_give(&remote->space_sem);
+	}
+}
+
+/**
+ * Take the semaphore of a @ref spair
+ *
+ * @return 0 on success
+ * @return -1 on error, with @ref errno set appropriately.
+ */
+static int spair_lock(struct spair *spair, bool is_nonblock)
+{
+	int res;
+
+	res = k_sem_take(&spair->sem, is_nonblock ? K_NO_WAIT : K_FOREVER);
+	if (res < 0) {
+		errno = is_nonblock ? EAGAIN : -res;
+		return -1;
+	}
+
+	return 0;
+}
+
 /**
  * Write data to one end of a @ref spair
  *
  * Data written on one file descriptor of a socketpair can be read at the
  * other end using common POSIX calls such as read(2) or recv(2).
  *
- * If the underlying file descriptor has the @ref O_NONBLOCK flag set then
- * this function will return immediately. If no data was written on a
- * non-blocking file descriptor, then -1 will be returned and @ref errno will
- * be set to @ref EAGAIN.
+ * If the underlying file descriptor has the @ref O_NONBLOCK flag set, or
+ * @p flags has @ref ZSOCK_MSG_DONTWAIT set, then this function will return
+ * immediately. If no data was written on a non-blocking file descriptor,
+ * then -1 will be returned and @ref errno will be set to @ref EAGAIN.
  *
  * Blocking write operations occur when the @ref O_NONBLOCK flag is @em not
- * set and there is insufficient space in the @em remote @ref spair.pipe.
+ * set and there is no space in the @em remote @ref spair.recv_q.
  *
- * Such a blocking write will suspend execution of the current thread until
- * one of two possible results is received on the @em remote
- * @ref spair.writeable:
+ * Such a blocking write releases both semaphores and waits on the @em local
+ * @ref spair.space_sem, until either:
  *
- * 1) @ref SPAIR_SIG_DATA - data has been read from the @em remote
- *    @ref spair.pipe. Thus, allowing more data to be written.
+ * 1) data has been read from the @em remote @ref spair.recv_q. Thus,
+ *    allowing more data to be written.
  *
- * 2) @ref SPAIR_SIG_CANCEL - the @em remote socketpair endpoint was closed
- *    Receipt of this result is analagous to SIGPIPE from POSIX
- *    ("Write on a pipe with no one to read it."). In this case, the function
- *    will return -1 and set @ref errno to @ref EPIPE.
+ * 2) the @em remote socketpair endpoint was closed.
+ *    This is analagous to SIGPIPE from POSIX ("Write on a pipe with no one
+ *    to read it."). In this case, the function will return -1 and set
+ *    @ref errno to @ref EPIPE.
  *
  * @param obj the address of an @ref spair object cast to `void *`
  * @param buffer the buffer to write
  * @param count the number of bytes to write from @p buffer
+ * @param flags ZSOCK_MSG_DONTWAIT or 0
  *
  * @return on success, a number > 0 representing the number of bytes written
  * @return -1 on error, with @ref errno set appropriately.
  */
-static ssize_t spair_write(void *obj, const void *buffer, size_t count)
+static ssize_t spair_send(void *obj, const void *buffer, size_t count,
+			  int flags)
 {
 	int res;
 	int key;
-	size_t avail;
 	bool is_nonblock;
 	size_t bytes_written;
 	bool have_local_sem = false;
 	bool have_remote_sem = false;
-	bool will_block = false;
 	struct spair *const spair = (struct spair *)obj;
 	struct spair *remote = NULL;
 
@@ -404,145 +504,69 @@ static ssize_t spair_write(void *obj, const void *buffer, size_t count)
 	}
 
 	key = irq_lock();
-	is_nonblock = sock_is_nonblock(spair);
+	is_nonblock = sock_is_nonblock(spair) ||
+		      (flags & ZSOCK_MSG_DONTWAIT) != 0;
 	res = k_sem_take(&spair->sem, K_NO_WAIT);
 	irq_unlock(key);
 	if (res < 0) {
-		if (is_nonblock) {
-			errno = EAGAIN;
-			res = -1;
-			goto out;
-		}
-
-		res = k_sem_take(&spair->sem, K_FOREVER);
+		res = spair_lock(spair, is_nonblock);
 		if (res < 0) {
-			errno = -res;
-			res = -1;
 			goto out;
 		}
-		is_nonblock = sock_is_nonblock(spair);
+		is_nonblock = sock_is_nonblock(spair) ||
+			      (flags & ZSOCK_MSG_DONTWAIT) != 0;
 	}
 
 	have_local_sem = true;
 
-	remote = z_get_fd_obj(spair->remote,
-		(const struct fd_op_vtable *)&spair_fd_op_vtable, 0);
-
-	if (remote == NULL) {
-		errno = EPIPE;
-		res = -1;
-		goto out;
-	}
+	while (true) {
+		remote = z_get_fd_obj(spair->remote,
+			(const struct fd_op_vtable *)&spair_fd_op_vtable, 0);
 
-	res = k_sem_take(&remote->sem, K_NO_WAIT);
-	if (res < 0) {
-		if (is_nonblock) {
-			errno = EAGAIN;
+		if (remote == NULL) {
+			/* Pass the wake-up on to the other blocked writers */
+			k_sem_give(&spair->space_sem);
+			errno = EPIPE;
 			res = -1;
 			goto out;
 		}
-		res = k_sem_take(&remote->sem, K_FOREVER);
+
+		res = spair_lock(remote, is_nonblock);
 		if (res < 0) {
-			errno = -res;
-			res = -1;
 			goto out;
 		}
-	}
 
-	have_remote_sem = true;
+		have_remote_sem = true;
 
-	avail = spair_write_avail(spair);
+		if (ring_buf_space_get(&remote->recv_q) > 0) {
+			break;
+		}
 
-	if (avail == 0) {
 		if (is_nonblock) {
 			errno = EAGAIN;
 			res = -1;
 			goto out;
 		}
-		will_block = true;
-	}
 
-	if (will_block) {
-
-		for (int signaled = false, result = -1; !signaled;
-			result = -1) {
-
-			struct k_poll_event events[] = {
-				K_POLL_EVENT_INITIALIZER(
-					K_POLL_TYPE_SIGNAL,
-					K_POLL_MODE_NOTIFY_ONLY,
-					&remote->writeable),
-			};
-
-			k_sem_give(&remote->sem);
-			have_remote_sem = false;
-
-			res = k_poll(events, ARRAY_SIZE(events), K_FOREVER);
-			if (res < 0) {
-				errno = -res;
-				res = -1;
-				goto out;
-			}
-
-			remote = z_get_fd_obj(spair->remote,
-				(const struct fd_op_vtable *)
-				&spair_fd_op_vtable, 0);
-
-			if (remote == NULL) {
-				errno = EPIPE;
-				res = -1;
-				goto out;
-			}
-
-			res = k_sem_take(&remote->sem, K_FOREVER);
-			if (res < 0) {
-				errno = -res;
-				res = -1;
-				goto out;
-			}
-
-			have_remote_sem = true;
+		/* Wait for the reader to make room */
+		k_sem_give(&remote->sem);
+		have_remote_sem = false;
+		k_sem_give(&spair->sem);
+		have_local_sem = false;
 
-			k_poll_signal_check(&remote->writeable, &signaled,
-					    &result);
-			if (!signaled) {
-				continue;
-			}
+		/* -EAGAIN when the remote end is being closed */
+		(void)k_sem_take(&spair->space_sem, K_FOREVER);
 
-			switch (result) {
-				case SPAIR_SIG_DATA: {
-					break;
-				}
-
-				case SPAIR_SIG_CANCEL: {
-					errno = EPIPE;
-					res = -1;
-					goto out;
-				}
-
-				default: {
-					__ASSERT(false,
-						"unrecognized result: %d",
-						result);
-					continue;
-				}
-			}
+		res = k_sem_take(&spair->sem, K_FOREVER);
+		__ASSERT(res == 0, "failed to take local sem: %d", res);
 
-			/* SPAIR_SIG_DATA was received */
-			break;
-		}
+		have_local_sem = true;
 	}
 
-	res = k_pipe_put(&remote->recv_q, (void *)buffer, count,
-			 &bytes_written, 1, K_NO_WAIT);
-	__ASSERT(res == 0, "k_pipe_put() failed: %d", res);
-
-	if (spair_write_avail(spair) == 0) {
-		k_poll_signal_reset(&remote->writeable);
-	}
+	bytes_written = ring_buf_put(&remote->recv_q, buffer,
+				     MIN(count, UINT32_MAX));
 
-	res = k_poll_signal_raise(&remote->readable, SPAIR_SIG_DATA);
-	__ASSERT(res == 0, "k_poll_signal_raise() failed: %d", res);
+	spair_write_done(spair, remote);
 
 	res = bytes_written;
 
@@ -558,6 +582,39 @@ out:
 	return res;
 }
 
+static ssize_t spair_write(void *obj, const void *buffer, size_t count)
+{
+	return spair_send(obj, buffer, count, 0);
+}
+
+/**
+ * Copy data from the @em local @ref spair.recv_q, leaving it there
+ *
+ * The data may wrap around the end of the ring buffer, it is then claimed
+ * in two parts. The claim is dropped afterwards.
+ */
+static size_t spair_peek(struct spair *spair, uint8_t *buffer, size_t count)
+{
+	uint8_t *data;
+	uint32_t len;
+	size_t bytes_read = 0;
+
+	for (int i = 0; i < 2 && bytes_read < count; i++) {
+		len = ring_buf_get_claim(&spair->recv_q, &data,
+					 MIN(count - bytes_read, UINT32_MAX));
+		if (len == 0) {
+			break;
+		}
+
+		memcpy(&buffer[bytes_read], data, len);
+		bytes_read += len;
+	}
+
+	(void)ring_buf_get_finish(&spair->recv_q, 0);
+
+	return bytes_read;
+}
+
 /**
  * Read data from one end of a @ref spair
  *
@@ -565,43 +622,42 @@ out:
  * send(2)) can be read at the other end using common POSIX calls such as
  * read(2) or recv(2).
  *
- * If the underlying file descriptor has the @ref O_NONBLOCK flag set then
- * this function will return immediately. If no data was read from a
- * non-blocking file descriptor, then -1 will be returned and @ref errno will
- * be set to @ref EAGAIN.
+ * If the underlying file descriptor has the @ref O_NONBLOCK flag set, or
+ * @p flags has @ref ZSOCK_MSG_DONTWAIT set, then this function will return
+ * immediately. If no data was read from a non-blocking file descriptor,
+ * then -1 will be returned and @ref errno will be set to @ref EAGAIN.
  *
  * Blocking read operations occur when the @ref O_NONBLOCK flag is @em not set
- * and there are no bytes to read in the @em local @ref spair.pipe.
+ * and there are no bytes to read in the @em local @ref spair.recv_q.
  *
- * Such a blocking read will suspend execution of the current thread until
- * one of two possible results is received on the @em local
- * @ref spair.readable:
+ * Such a blocking read releases the local semaphore and waits on the
+ * @em local @ref spair.data_sem, until either:
  *
- * -# @ref SPAIR_SIG_DATA - data has been written to the @em local
- *    @ref spair.pipe. Thus, allowing more data to be read.
+ * -# data has been written to the @em local @ref spair.recv_q. Thus,
+ *    allowing more data to be read.
  *
- * -# @ref SPAIR_SIG_CANCEL - read of the the @em local @spair.pipe
- *    must be cancelled for some reason (e.g. the file descriptor will be
- *    closed imminently). In this case, the function will return -1 and set
- *    @ref errno to @ref EINTR.
+ * -# the @em remote socketpair endpoint was closed. In this case, the
+ *    function will return 0 (end-of-file).
+ *
+ * With @ref ZSOCK_MSG_PEEK set in @p flags, the data is left in the
+ * @em local @ref spair.recv_q.
  *
  * @param obj the address of an @ref spair object cast to `void *`
  * @param buffer the buffer in which to read
  * @param count the number of bytes to read
+ * @param flags ZSOCK_MSG_DONTWAIT, ZSOCK_MSG_PEEK or 0
  *
- * @return on success, a number > 0 representing the number of bytes written
+ * @return on success, a number > 0 representing the number of bytes read
+ * @return 0 at end-of-file
  * @return -1 on error, with @ref errno set appropriately.
  */
-static ssize_t spair_read(void *obj, void *buffer, size_t count)
+static ssize_t spair_recv(void *obj, void *buffer, size_t count, int flags)
 {
 	int res;
 	int key;
-	bool is_connected;
-	size_t avail;
 	bool is_nonblock;
 	size_t bytes_read;
 	bool have_local_sem = false;
-	bool will_block = false;
 	struct spair *const spair = (struct spair *)obj;
 
 	if (obj == NULL || buffer == NULL || count == 0) {
@@ -611,32 +667,26 @@ static ssize_t spair_read(void *obj, void *buffer, size_t count)
 	}
 
 	key = irq_lock();
-	is_nonblock = sock_is_nonblock(spair);
+	is_nonblock = sock_is_nonblock(spair) ||
+		      (flags & ZSOCK_MSG_DONTWAIT) != 0;
 	res = k_sem_take(&spair->sem, K_NO_WAIT);
 	irq_unlock(key);
 	if (res < 0) {
-		if (is_nonblock) {
-			errno = EAGAIN;
-			res = -1;
-			goto out;
-		}
-
-		res = k_sem_take(&spair->sem, K_FOREVER);
+		res = spair_lock(spair, is_nonblock);
 		if (res < 0) {
-			errno = -res;
-			res = -1;
 			goto out;
 		}
-		is_nonblock = sock_is_nonblock(spair);
+		is_nonblock = sock_is_nonblock(spair) ||
+			      (flags & ZSOCK_MSG_DONTWAIT) != 0;
 	}
 
 	have_local_sem = true;
 
-	is_connected = sock_is_connected(spair);
-	avail = spair_read_avail(spair);
+	while (ring_buf_is_empty(&spair->recv_q)) {
+		if (!sock_is_connected(spair)) {
+			/* Pass the wake-up on to the other blocked readers */
+			k_sem_give(&spair->data_sem);
 
-	if (avail == 0) {
-		if (!is_connected) {
 			/* signal EOF */
 			res = 0;
 			goto out;
@@ -648,75 +698,27 @@ static ssize_t spair_read(void *obj, void *buffer, size_t count)
 			goto out;
 		}
 
-		will_block = true;
-	}
-
-	if (will_block) {
-
-		for (int signaled = false, result = -1; !signaled;
-			result = -1) {
-
-			struct k_poll_event events[] = {
-				K_POLL_EVENT_INITIALIZER(
-					K_POLL_TYPE_SIGNAL,
-					K_POLL_MODE_NOTIFY_ONLY,
-					&spair->readable
-				),
-			};
-
-			k_sem_give(&spair->sem);
-			have_local_sem = false;
-
-			res = k_poll(events, ARRAY_SIZE(events), K_FOREVER);
-			__ASSERT(res == 0, "k_poll() failed: %d", res);
-
-			res = k_sem_take(&spair->sem, K_FOREVER);
-			__ASSERT(res == 0, "failed to take local sem: %d", res);
-
-			have_local_sem = true;
+		k_sem_give(&spair->sem);
+		have_local_sem = false;
 
-			k_poll_signal_check(&spair->readable, &signaled,
-					    &result);
-			if (!signaled) {
-				continue;
-			}
+		/* -EAGAIN when the remote end is being closed */
+		(void)k_sem_take(&spair->data_sem, K_FOREVER);
 
-			switch (result) {
-				case SPAIR_SIG_DATA: {
-					break;
-				}
-
-				case SPAIR_SIG_CANCEL: {
-					errno = EPIPE;
-					res = -1;
-					goto out;
-				}
-
-				default: {
-					__ASSERT(false,
-						"unrecognized result: %d",
-						result);
-					continue;
-				}
-			}
+		res = k_sem_take(&spair->sem, K_FOREVER);
+		__ASSERT(res == 0, "failed to take local sem: %d", res);
 
-			/* SPAIR_SIG_DATA was received */
-			break;
-		}
+		have_local_sem = true;
 	}
 
-	res = k_pipe_get(&spair->recv_q, (void *)buffer, count, &bytes_read,
-			 1, K_NO_WAIT);
-	__ASSERT(res == 0, "k_pipe_get() failed: %d", res);
-
-	if (spair_read_avail(spair) == 0 && !sock_is_eof(spair)) {
-		k_poll_signal_reset(&spair->readable);
+	if (flags & ZSOCK_MSG_PEEK) {
+		res = spair_peek(spair, buffer, count);
+		goto out;
 	}
 
-	if (is_connected) {
-		res = k_poll_signal_raise(&spair->writeable, SPAIR_SIG_DATA);
-		__ASSERT(res == 0, "k_poll_signal_raise() failed: %d", res);
-	}
+	bytes_read = ring_buf_get(&spair->recv_q, buffer,
+				  MIN(count, UINT32_MAX));
+
+	spair_read_done(spair);
 
 	res = bytes_read;
 
@@ -729,6 +731,11 @@ out:
 	return res;
 }
 
+static ssize_t spair_read(void *obj, void *buffer, size_t count)
+{
+	return spair_recv(obj, buffer, count, 0);
+}
+
 static int zsock_poll_prepare_ctx(struct spair *const spair,
 				  struct zsock_pollfd *const pfd,
 				  struct k_poll_event **pev,
@@ -1016,11 +1023,10 @@ static ssize_t spair_sendto(void *obj, const void *buf, size_t len,
 			    int flags, const struct sockaddr *dest_addr,
 				 socklen_t addrlen)
 {
-	ARG_UNUSED(flags);
 	ARG_UNUSED(dest_addr);
 	ARG_UNUSED(addrlen);
 
-	return spair_write(obj, buf, len);
+	return spair_send(obj, buf, len, flags);
 }
 
 static ssize_t spair_sendmsg(void *obj, const struct msghdr *msg,
@@ -1086,7 +1092,6 @@ static ssize_t spair_recvfrom(void *obj, void *buf, size_t max_len,
 			      int flags, struct sockaddr *src_addr,
 				   socklen_t *addrlen)
 {
-	(void)flags;
 	(void)src_addr;
 	(void)addrlen;
 
@@ -1103,7 +1108,7 @@ static ssize_t spair_recvfrom(void *obj, void *buf, size_t max_len,
 		*addrlen = 0;
 	}
 
-	return spair_read(obj, buf, max_len);
+	return spair_recv(obj, buf, max_len, flags);
 }
 
 static int spair_getsockopt(void *obj, int level, int optname,
@@ -1148,6 +1153,166 @@ static int spair_close(void *obj)
 	return 0;
 }
 
+ssize_t zsock_socketpair_recv_claim(int sock, void **data, size_t max_len)
+{
+	int res;
+	uint32_t len;
+	struct spair *spair;
+
+	spair = z_get_fd_obj(sock,
+		(const struct fd_op_vtable *)&spair_fd_op_vtable, ENOTSOCK);
+	if (spair == NULL) {
+		return -1;
+	}
+
+	if (data == NULL || max_len == 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	res = spair_lock(spair, sock_is_nonblock(spair));
+	if (res < 0) {
+		return -1;
+	}
+
+	len = ring_buf_get_claim(&spair->recv_q, (uint8_t **)data,
+				 MIN(max_len, UINT32_MAX));
+	if (len == 0) {
+		if (sock_is_connected(spair)) {
+			errno = EAGAIN;
+			res = -1;
+		}
+
+		(void)ring_buf_get_finish(&spair->recv_q, 0);
+		k_sem_give(&spair->sem);
+		return res;
+	}
+
+	/* The local semaphore is held until the claim is finished */
+	spair->claim_len = len;
+
+	return len;
+}
+
+int zsock_socketpair_recv_finish(int sock, size_t len)
+{
+	int res = 0;
+	struct spair *spair;
+
+	spair = z_get_fd_obj(sock,
+		(const struct fd_op_vtable *)&spair_fd_op_vtable, ENOTSOCK);
+	if (spair == NULL) {
+		return -1;
+	}
+
+	if (len > spair->claim_len) {
+		errno = EINVAL;
+		res = -1;
+		len = 0;
+	}
+
+	(void)ring_buf_get_finish(&spair->recv_q, len);
+	spair->claim_len = 0;
+
+	if (len > 0) {
+		spair_read_done(spair);
+	}
+
+	k_sem_give(&spair->sem);
+
+	return res;
+}
+
+ssize_t zsock_socketpair_send_claim(int sock, void **data, size_t max_len)
+{
+	int res;
+	uint32_t len;
+	bool is_nonblock;
+	struct spair *spair;
+	struct spair *remote;
+
+	spair = z_get_fd_obj(sock,
+		(const struct fd_op_vtable *)&spair_fd_op_vtable, ENOTSOCK);
+	if (spair == NULL) {
+		return -1;
+	}
+
+	if (data == NULL || max_len == 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	is_nonblock = sock_is_nonblock(spair);
+	res = spair_lock(spair, is_nonblock);
+	if (res < 0) {
+		return -1;
+	}
+
+	remote = z_get_fd_obj(spair->remote,
+		(const struct fd_op_vtable *)&spair_fd_op_vtable, 0);
+	if (remote == NULL) {
+		k_sem_give(&spair->sem);
+		errno = EPIPE;
+		return -1;
+	}
+
+	res = spair_lock(remote, is_nonblock);
+	if (res < 0) {
+		k_sem_give(&spair->sem);
+		return -1;
+	}
+
+	len = ring_buf_put_claim(&remote->recv_q, (uint8_t **)data,
+				 MIN(max_len, UINT32_MAX));
+	if (len == 0) {
+		k_sem_give(&remote->sem);
+		k_sem_give(&spair->sem);
+		errno = EAGAIN;
+		return -1;
+	}
+
+	/* Both semaphores are held until the claim is committed */
+	spair->claim_len = len;
+
+	return len;
+}
+
+int zsock_socketpair_send_commit(int sock, size_t len)
+{
+	int res = 0;
+	struct spair *spair;
+	struct spair *remote;
+
+	spair = z_get_fd_obj(sock,
+		(const struct fd_op_vtable *)&spair_fd_op_vtable, ENOTSOCK);
+	if (spair == NULL) {
+		return -1;
+	}
+
+	/* Held since the claim, which holds its semaphore */
+	remote = z_get_fd_obj(spair->remote,
+		(const struct fd_op_vtable *)&spair_fd_op_vtable, 0);
+	__ASSERT(remote != NULL, "remote is NULL");
+
+	if (len > spair->claim_len) {
+		errno = EINVAL;
+		res = -1;
+		len = 0;
+	}
+
+	(void)ring_buf_put_finish(&remote->recv_q, len);
+	spair->claim_len = 0;
+
+	if (len > 0) {
+		spair_write_done(spair, remote);
+	}
+
+	k_sem_give(&remote->sem);
+	k_sem_give(&spair->sem);
+
+	return res;
+}
+
 static const struct socket_op_vtable spair_fd_op_vtable = {
 	.fd_vtable = {
 		.read = spair_read,
@@ -378,6 +378,7 @@ static void zsock_received_cb(struct net_context *ctx,
 	}
 
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
+	net_pkt_rx_stage_mark(pkt, NET_STATS_RX_STAGE_TRANSPORT);
 
 	k_fifo_put(&ctx->recv_q, pkt);
 
@@ -617,9 +618,10 @@ static inline int z_vrfy_zsock_accept(int sock, struct sockaddr *addr,
 #define WAIT_BUFS K_MSEC(100)
 #define MAX_WAIT_BUFS K_SECONDS(10)
 
-ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
-			 int flags,
-			 const struct sockaddr *dest_addr, socklen_t addrlen)
+/* Send either len bytes of buf or the frags chain */
+static ssize_t sock_sendto(struct net_context *ctx, const void *buf,
+			   size_t len, struct net_buf *frags, int flags,
+			   const struct sockaddr *dest_addr, socklen_t addrlen)
 {
 	k_timeout_t timeout = K_FOREVER;
 	uint64_t buf_timeout = 0;
@@ -643,7 +645,11 @@ ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 	}
 
 	while (1) {
-		if (dest_addr) {
+		if (frags) {
+			status = net_context_sendto_buf(ctx, frags, dest_addr,
+							addrlen, NULL, timeout,
+							ctx->user_data);
+		} else if (dest_addr) {
 			status = net_context_sendto(ctx, buf, len, dest_addr,
 						    addrlen, NULL, timeout,
 						    ctx->user_data);
@@ -688,6 +694,31 @@ ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 	return status;
 }
 
+ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
+			 int flags,
+			 const struct sockaddr *dest_addr, socklen_t addrlen)
+{
+	return sock_sendto(ctx, buf, len, NULL, flags, dest_addr, addrlen);
+}
+
+ssize_t zsock_sendto_buf_ctx(struct net_context *ctx, struct net_buf *frags,
+			     int flags, const struct sockaddr *dest_addr,
+			     socklen_t addrlen)
+{
+	if (frags == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	return sock_sendto(ctx, NULL, 0, frags, flags, dest_addr, addrlen);
+}
+
+ssize_t zsock_sendto_buf(int sock, struct net_buf *frags, int flags,
+			 const struct sockaddr *dest_addr, socklen_t addrlen)
+{
+	VTABLE_CALL(sendto_buf, sock, frags, flags, dest_addr, addrlen);
+}
+
 ssize_t z_impl_zsock_sendto(int sock, const void *buf, size_t len, int flags,
 			   const struct sockaddr *dest_addr, socklen_t addrlen)
 {
@@ -741,90 +772,102 @@ ssize_t z_impl_zsock_sendmsg(int sock, const struct msghdr *msg, int flags)
 }
 
 #ifdef CONFIG_USERSPACE
-static inline ssize_t z_vrfy_zsock_sendmsg(int sock,
-					   const struct msghdr *msg,
-					   int flags)
+static void sendmsg_user_free(struct msghdr *msg_copy)
+{
+	if (msg_copy->msg_name) {
+		k_free(msg_copy->msg_name);
+	}
+
+	if (msg_copy->msg_control) {
+		k_free(msg_copy->msg_control);
+	}
+
+	if (msg_copy->msg_iov) {
+		for (size_t i = 0; i < msg_copy->msg_iovlen; i++) {
+			if (msg_copy->msg_iov[i].iov_base) {
+				k_free(msg_copy->msg_iov[i].iov_base);
+			}
+		}
+
+		k_free(msg_copy->msg_iov);
+	}
+}
+
+/* Copy a user message header and everything it points to, to be freed
+ * with sendmsg_user_free()
+ */
+static int sendmsg_from_user(struct msghdr *msg_copy, const struct msghdr *msg)
 {
-	struct msghdr msg_copy;
 	size_t i;
-	int ret;
 
-	Z_OOPS(z_user_from_copy(&msg_copy, (void *)msg, sizeof(msg_copy)));
+	Z_OOPS(z_user_from_copy(msg_copy, (void *)msg, sizeof(*msg_copy)));
 
-	msg_copy.msg_name = NULL;
-	msg_copy.msg_control = NULL;
+	msg_copy->msg_name = NULL;
+	msg_copy->msg_control = NULL;
 
-	msg_copy.msg_iov = z_user_alloc_from_copy(msg->msg_iov,
+	msg_copy->msg_iov = z_user_alloc_from_copy(msg->msg_iov,
 				       msg->msg_iovlen * sizeof(struct iovec));
-	if (!msg_copy.msg_iov) {
+	if (!msg_copy->msg_iov) {
 		errno = ENOMEM;
 		goto fail;
 	}
 
 	for (i = 0; i < msg->msg_iovlen; i++) {
-		msg_copy.msg_iov[i].iov_base =
+		msg_copy->msg_iov[i].iov_base =
 			z_user_alloc_from_copy(msg->msg_iov[i].iov_base,
 					       msg->msg_iov[i].iov_len);
-		if (!msg_copy.msg_iov[i].iov_base) {
+		if (!msg_copy->msg_iov[i].iov_base) {
 			errno = ENOMEM;
 			goto fail;
 		}
 
-		msg_copy.msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
+		msg_copy->msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
 	}
 
 	if (msg->msg_namelen > 0) {
-		msg_copy.msg_name = z_user_alloc_from_copy(msg->msg_name,
-							   msg->msg_namelen);
-		if (!msg_copy.msg_name) {
+		msg_copy->msg_name = z_user_alloc_from_copy(msg->msg_name,
+							    msg->msg_namelen);
+		if (!msg_copy->msg_name) {
 			errno = ENOMEM;
 			goto fail;
 		}
 	}
 
 	if (msg->msg_controllen > 0) {
-		msg_copy.msg_control = z_user_alloc_from_copy(msg->msg_control,
-							  msg->msg_controllen);
-		if (!msg_copy.msg_control) {
+		msg_copy->msg_control =
+			z_user_alloc_from_copy(msg->msg_control,
+					       msg->msg_controllen);
+		if (!msg_copy->msg_control) {
 			errno = ENOMEM;
 			goto fail;
 		}
 	}
 
-	ret = z_impl_zsock_sendmsg(sock, (const struct msghdr *)&msg_copy,
-				   flags);
-
-	k_free(msg_copy.msg_name);
-	k_free(msg_copy.msg_control);
-
-	for (i = 0; i < msg_copy.msg_iovlen; i++) {
-		k_free(msg_copy.msg_iov[i].iov_base);
-	}
+	return 0;
 
-	k_free(msg_copy.msg_iov);
+fail:
+	sendmsg_user_free(msg_copy);
 
-	return ret;
+	return -1;
+}
 
-fail:
-	if (msg_copy.msg_name) {
-		k_free(msg_copy.msg_name);
-	}
+static inline ssize_t z_vrfy_zsock_sendmsg(int sock,
+					   const struct msghdr *msg,
+					   int flags)
+{
+	struct msghdr msg_copy;
+	int ret;
 
-	if (msg_copy.msg_control) {
-		k_free(msg_copy.msg_control);
+	if (sendmsg_from_user(&msg_copy, msg) < 0) {
+		return -1;
 	}
 
-	if (msg_copy.msg_iov) {
-		for (i = 0; i < msg_copy.msg_iovlen; i++) {
-			if (msg_copy.msg_iov[i].iov_base) {
-				k_free(msg_copy.msg_iov[i].iov_base);
-			}
-		}
+	ret = z_impl_zsock_sendmsg(sock, (const struct msghdr *)&msg_copy,
+				   flags);
 
-		k_free(msg_copy.msg_iov);
-	}
+	sendmsg_user_free(&msg_copy);
 
-	return -1;
+	return ret;
 }
 #include <syscalls/zsock_sendmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
@@ -983,18 +1026,173 @@ static int wait_data(struct net_context *ctx, k_timeout_t *timeout)
 	return 0;
 }
 
+/* Fill in the source address of a received datagram, addrlen is a
+ * value-result argument set to its actual size
+ */
+static int sock_recv_src_addr(struct net_context *ctx, struct net_pkt *pkt,
+			      struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	int rv;
+
+	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+	    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+		/*
+		 * Packets from offloaded IP stack do not have IP
+		 * headers, so src address cannot be figured out at this
+		 * point. The best we can do is returning remote address
+		 * if that was set using connect() call.
+		 */
+		if (ctx->flags & NET_CONTEXT_REMOTE_ADDR_SET) {
+			memcpy(src_addr, &ctx->remote,
+			       MIN(*addrlen, sizeof(ctx->remote)));
+		} else {
+			errno = ENOTSUP;
+			return -1;
+		}
+	} else {
+		rv = sock_get_pkt_src_addr(pkt, net_context_get_ip_proto(ctx),
+					   src_addr, *addrlen);
+		if (rv < 0) {
+			errno = -rv;
+			LOG_ERR("sock_get_pkt_src_addr %d", rv);
+			return -1;
+		}
+	}
+
+	if (src_addr->sa_family == AF_INET) {
+		*addrlen = sizeof(struct sockaddr_in);
+	} else if (src_addr->sa_family == AF_INET6) {
+		*addrlen = sizeof(struct sockaddr_in6);
+	} else {
+		errno = ENOTSUP;
+		return -1;
+	}
+
+	return 0;
+}
+
+/* Append one control message to msg, at offset *used of its buffer */
+static void sock_cmsg_put(struct msghdr *msg, size_t *used, int level,
+			  int type, const void *data, size_t len)
+{
+	struct cmsghdr *cmsg;
+
+	if (*used + CMSG_SPACE(len) > msg->msg_controllen) {
+		msg->msg_flags |= ZSOCK_MSG_CTRUNC;
+		return;
+	}
+
+	cmsg = (struct cmsghdr *)((uint8_t *)msg->msg_control + *used);
+	cmsg->cmsg_len = CMSG_LEN(len);
+	cmsg->cmsg_level = level;
+	cmsg->cmsg_type = type;
+	memcpy(CMSG_DATA(cmsg), data, len);
+
+	*used += CMSG_SPACE(len);
+}
+
+static int sock_put_pktinfo(struct net_context *ctx, struct net_pkt *pkt,
+			    struct msghdr *msg, size_t *used)
+{
+	int ifindex = net_if_get_by_iface(net_pkt_iface(pkt));
+	struct net_pkt_cursor backup;
+	int ret = 0;
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) &&
+	    net_pkt_family(pkt) == AF_INET) {
+		NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access,
+						      struct net_ipv4_hdr);
+		struct net_ipv4_hdr *ipv4_hdr;
+		struct in_pktinfo info = { .ipi_ifindex = ifindex };
+
+		ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(
+							pkt, &ipv4_access);
+		if (!ipv4_hdr) {
+			ret = -ENOBUFS;
+			goto out;
+		}
+
+		net_ipaddr_copy(&info.ipi_addr, &ipv4_hdr->dst);
+		net_ipaddr_copy(&info.ipi_spec_dst, &ipv4_hdr->dst);
+		sock_cmsg_put(msg, used, IPPROTO_IP, IP_PKTINFO,
+			      &info, sizeof(info));
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(pkt) == AF_INET6) {
+		NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv6_access,
+						      struct net_ipv6_hdr);
+		struct net_ipv6_hdr *ipv6_hdr;
+		struct in6_pktinfo info = { .ipi6_ifindex = ifindex };
+
+		ipv6_hdr = (struct net_ipv6_hdr *)net_pkt_get_data(
+							pkt, &ipv6_access);
+		if (!ipv6_hdr) {
+			ret = -ENOBUFS;
+			goto out;
+		}
+
+		net_ipaddr_copy(&info.ipi6_addr, &ipv6_hdr->dst);
+		sock_cmsg_put(msg, used, IPPROTO_IPV6, IPV6_PKTINFO,
+			      &info, sizeof(info));
+	}
+
+out:
+	net_pkt_cursor_restore(pkt, &backup);
+
+	return ret;
+}
+
+/* Fill in the ancillary data the socket asked for, msg_controllen is set
+ * to the length actually used
+ */
+static int sock_put_cmsgs(struct net_context *ctx, struct net_pkt *pkt,
+			  struct msghdr *msg)
+{
+	size_t used = 0;
+	int ret;
+
+	if (msg->msg_control == NULL) {
+		msg->msg_controllen = 0;
+		return 0;
+	}
+
+	/* Packets from an offloaded IP stack have no IP headers */
+	if (sock_get_flag(ctx, SOCK_RECV_PKTINFO) &&
+	    !(IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+	      net_if_is_ip_offloaded(net_context_get_iface(ctx)))) {
+		ret = sock_put_pktinfo(ctx, pkt, msg, &used);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_NET_PKT_TIMESTAMP) &&
+	    sock_get_flag(ctx, SOCK_RECV_TIMESTAMP)) {
+		sock_cmsg_put(msg, &used, SOL_SOCKET, SCM_TIMESTAMPNS,
+			      net_pkt_timestamp(pkt),
+			      sizeof(struct net_ptp_time));
+	}
+
+	msg->msg_controllen = used;
+
+	return 0;
+}
+
 static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
-				       void *buf,
-				       size_t max_len,
-				       int flags,
-				       struct sockaddr *src_addr,
-				       socklen_t *addrlen)
+				       struct msghdr *msg,
+				       int flags)
 {
 	k_timeout_t timeout = K_FOREVER;
+	struct sockaddr *src_addr = msg->msg_name;
 	size_t recv_len = 0;
-	size_t read_len;
+	size_t read_len = 0;
 	struct net_pkt_cursor backup;
 	struct net_pkt *pkt;
+	int rv;
+
+	msg->msg_flags = 0;
 
 	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
 		timeout = K_NO_WAIT;
@@ -1032,95 +1230,676 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 
 	net_pkt_cursor_backup(pkt, &backup);
 
-	if (src_addr && addrlen) {
-		if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
-		    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
-			/*
-			 * Packets from offloaded IP stack do not have IP
-			 * headers, so src address cannot be figured out at this
-			 * point. The best we can do is returning remote address
-			 * if that was set using connect() call.
+	if (src_addr && sock_recv_src_addr(ctx, pkt, src_addr,
+					   &msg->msg_namelen) < 0) {
+		goto fail;
+	}
+
+	rv = sock_put_cmsgs(ctx, pkt, msg);
+	if (rv < 0) {
+		errno = -rv;
+		goto fail;
+	}
+
+	recv_len = net_pkt_remaining_data(pkt);
+
+	for (size_t i = 0; i < msg->msg_iovlen && read_len < recv_len; i++) {
+		size_t len = MIN(msg->msg_iov[i].iov_len, recv_len - read_len);
+
+		if (net_pkt_read(pkt, msg->msg_iov[i].iov_base, len)) {
+			errno = ENOBUFS;
+			goto fail;
+		}
+
+		read_len += len;
+	}
+
+	if (read_len < recv_len) {
+		msg->msg_flags |= ZSOCK_MSG_TRUNC;
+	}
+
+	if (!(flags & ZSOCK_MSG_PEEK)) {
+		net_pkt_rx_stage_mark(pkt, NET_STATS_RX_STAGE_SOCKET);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) &&
+	    !(flags & ZSOCK_MSG_PEEK)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	if (!(flags & ZSOCK_MSG_PEEK)) {
+		net_pkt_unref(pkt);
+	} else {
+		net_pkt_cursor_restore(pkt, &backup);
+	}
+
+	return (flags & ZSOCK_MSG_TRUNC) ? recv_len : read_len;
+
+fail:
+	if (!(flags & ZSOCK_MSG_PEEK)) {
+		net_pkt_unref(pkt);
+	}
+
+	return -1;
+}
+
+static inline ssize_t zsock_recv_stream(struct net_context *ctx,
+					void *buf,
+					size_t max_len,
+					int flags)
+{
+	k_timeout_t timeout = K_FOREVER;
+	size_t recv_len = 0;
+	struct net_pkt_cursor backup;
+	int res;
+	uint64_t end;
+	const bool waitall = flags & ZSOCK_MSG_WAITALL;
+
+	if (!net_context_is_used(ctx)) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+		errno = ENOTCONN;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else if (!sock_is_eof(ctx)) {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+	}
+
+	end = sys_clock_timeout_end_calc(timeout);
+
+	do {
+		struct net_pkt *pkt;
+		size_t data_len, read_len;
+		bool release_pkt = true;
+
+		if (sock_is_eof(ctx)) {
+			return 0;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			res = wait_data(ctx, &timeout);
+			if (res < 0) {
+				errno = -res;
+				return -1;
+			}
+		}
+
+		pkt = k_fifo_peek_head(&ctx->recv_q);
+		if (!pkt) {
+			/* Either timeout expired, or wait was cancelled
+			 * due to connection closure by peer.
 			 */
-			if (ctx->flags & NET_CONTEXT_REMOTE_ADDR_SET) {
-				memcpy(src_addr, &ctx->remote,
-				       MIN(*addrlen, sizeof(ctx->remote)));
+			NET_DBG("NULL return from fifo");
+
+			if (waitall && (recv_len > 0)) {
+				return recv_len;
+			} else if (sock_is_eof(ctx)) {
+				return 0;
 			} else {
-				errno = ENOTSUP;
-				goto fail;
-			}
-		} else {
-			int rv;
-
-			rv = sock_get_pkt_src_addr(pkt, net_context_get_ip_proto(ctx),
-						   src_addr, *addrlen);
-			if (rv < 0) {
-				errno = -rv;
-				LOG_ERR("sock_get_pkt_src_addr %d", rv);
-				goto fail;
+				errno = EAGAIN;
+				return -1;
 			}
 		}
 
-		/* addrlen is a value-result argument, set to actual
-		 * size of source address
-		 */
-		if (src_addr->sa_family == AF_INET) {
-			*addrlen = sizeof(struct sockaddr_in);
-		} else if (src_addr->sa_family == AF_INET6) {
-			*addrlen = sizeof(struct sockaddr_in6);
-		} else {
-			errno = ENOTSUP;
-			goto fail;
+		net_pkt_cursor_backup(pkt, &backup);
+
+		data_len = net_pkt_remaining_data(pkt);
+		read_len = data_len;
+		if (recv_len + read_len > max_len) {
+			read_len = max_len - recv_len;
+			release_pkt = false;
+		}
+
+		/* Actually copy data to application buffer */
+		if (net_pkt_read(pkt, (uint8_t *)buf + recv_len, read_len)) {
+			errno = ENOBUFS;
+			return -1;
+		}
+
+		recv_len += read_len;
+
+		if (!(flags & ZSOCK_MSG_PEEK)) {
+			/* Only the first read of the packet is collected */
+			net_pkt_rx_stage_mark(pkt, NET_STATS_RX_STAGE_SOCKET);
+
+			if (release_pkt) {
+				/* Finished processing head pkt in
+				 * the fifo. Drop it from there.
+				 */
+				k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+				if (net_pkt_eof(pkt)) {
+					sock_set_eof(ctx);
+				}
+
+				if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+					net_socket_update_tc_rx_time(
+						pkt, k_cycle_get_32());
+				}
+
+				net_pkt_unref(pkt);
+			}
+		} else {
+			net_pkt_cursor_restore(pkt, &backup);
+		}
+
+		/* Update the timeout value in case loop is repeated. */
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT) &&
+		    !K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			int64_t remaining = end - sys_clock_tick_get();
+
+			if (remaining <= 0) {
+				timeout = K_NO_WAIT;
+			} else {
+				timeout = Z_TIMEOUT_TICKS(remaining);
+			}
+		}
+	} while ((recv_len == 0) || (waitall && (recv_len < max_len)));
+
+	if (!(flags & ZSOCK_MSG_PEEK)) {
+		net_context_update_recv_wnd(ctx, recv_len);
+	}
+
+	return recv_len;
+}
+
+ssize_t zsock_recvfrom_ctx(struct net_context *ctx, void *buf, size_t max_len,
+			   int flags,
+			   struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+
+	if (max_len == 0) {
+		return 0;
+	}
+
+	if (sock_type == SOCK_DGRAM) {
+		struct iovec iov = { .iov_base = buf, .iov_len = max_len };
+		struct msghdr msg = {
+			.msg_name = addrlen ? src_addr : NULL,
+			.msg_namelen = addrlen ? *addrlen : 0,
+			.msg_iov = &iov,
+			.msg_iovlen = 1,
+		};
+		ssize_t ret;
+
+		ret = zsock_recv_dgram(ctx, &msg, flags);
+		if (ret >= 0 && msg.msg_name) {
+			*addrlen = msg.msg_namelen;
+		}
+
+		return ret;
+	} else if (sock_type == SOCK_STREAM) {
+		return zsock_recv_stream(ctx, buf, max_len, flags);
+	} else {
+		__ASSERT(0, "Unknown socket type");
+	}
+
+	return 0;
+}
+
+ssize_t z_impl_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
+			     struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	VTABLE_CALL(recvfrom, sock, buf, max_len, flags, src_addr, addrlen);
+}
+
+#ifdef CONFIG_USERSPACE
+ssize_t z_vrfy_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
+			      struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	socklen_t addrlen_copy;
+	ssize_t ret;
+
+	if (Z_SYSCALL_MEMORY_WRITE(buf, max_len)) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	if (addrlen) {
+		Z_OOPS(z_user_from_copy(&addrlen_copy, addrlen,
+					sizeof(socklen_t)));
+	}
+	Z_OOPS(src_addr && Z_SYSCALL_MEMORY_WRITE(src_addr, addrlen_copy));
+
+	ret = z_impl_zsock_recvfrom(sock, (void *)buf, max_len, flags,
+				   (struct sockaddr *)src_addr,
+				   addrlen ? &addrlen_copy : NULL);
+
+	if (addrlen) {
+		Z_OOPS(z_user_to_copy(addrlen, &addrlen_copy,
+				      sizeof(socklen_t)));
+	}
+
+	return ret;
+}
+#include <syscalls/zsock_recvfrom_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+static ssize_t zsock_recvmsg_stream(struct net_context *ctx,
+				    struct msghdr *msg, int flags)
+{
+	ssize_t recv_len = 0;
+
+	msg->msg_namelen = 0;
+	msg->msg_controllen = 0;
+	msg->msg_flags = 0;
+
+	for (size_t i = 0; i < msg->msg_iovlen; i++) {
+		ssize_t ret;
+
+		if (msg->msg_iov[i].iov_len == 0) {
+			continue;
+		}
+
+		ret = zsock_recv_stream(ctx, msg->msg_iov[i].iov_base,
+					msg->msg_iov[i].iov_len, flags);
+		if (ret < 0) {
+			return (recv_len > 0) ? recv_len : ret;
+		}
+
+		recv_len += ret;
+
+		if (ret < msg->msg_iov[i].iov_len) {
+			break;
+		}
+
+		/* Only wait for whatever fills the first buffer */
+		if (!(flags & ZSOCK_MSG_WAITALL)) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
+	}
+
+	return recv_len;
+}
+
+ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
+			  int flags)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+
+	if (sock_type == SOCK_DGRAM) {
+		return zsock_recv_dgram(ctx, msg, flags);
+	} else if (sock_type == SOCK_STREAM) {
+		return zsock_recvmsg_stream(ctx, msg, flags);
+	}
+
+	__ASSERT(0, "Unknown socket type");
+
+	return 0;
+}
+
+/* Receive one message with the socket lock held, socket types without a
+ * recvmsg method get it through recvfrom
+ */
+static ssize_t sock_recvmsg_locked(const struct socket_op_vtable *vtable,
+				   void *obj, struct msghdr *msg, int flags)
+{
+	socklen_t addrlen = msg->msg_namelen;
+	ssize_t ret;
+
+	if (vtable->recvmsg != NULL) {
+		return vtable->recvmsg(obj, msg, flags);
+	}
+
+	if (vtable->recvfrom == NULL || msg->msg_iovlen > 1) {
+		errno = ENOTSUP;
+		return -1;
+	}
+
+	ret = vtable->recvfrom(obj,
+			       msg->msg_iovlen ? msg->msg_iov[0].iov_base : NULL,
+			       msg->msg_iovlen ? msg->msg_iov[0].iov_len : 0,
+			       flags, msg->msg_name,
+			       msg->msg_name ? &addrlen : NULL);
+	if (ret >= 0) {
+		msg->msg_namelen = msg->msg_name ? addrlen : 0;
+		msg->msg_controllen = 0;
+		msg->msg_flags = 0;
+	}
+
+	return ret;
+}
+
+ssize_t z_impl_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	ssize_t ret;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+	ret = sock_recvmsg_locked(vtable, obj, msg, flags);
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+/* Copy a user message header for receiving into it. The buffers stay in
+ * user memory and are only checked for being writable, the iovec array
+ * is copied and must be freed with k_free().
+ */
+static int recvmsg_from_user(struct msghdr *msg_copy, struct msghdr *msg)
+{
+	size_t iov_size;
+
+	Z_OOPS(z_user_from_copy(msg_copy, msg, sizeof(*msg_copy)));
+	Z_OOPS(size_mul_overflow(msg_copy->msg_iovlen, sizeof(struct iovec),
+				 &iov_size));
+
+	Z_OOPS(msg_copy->msg_name &&
+	       Z_SYSCALL_MEMORY_WRITE(msg_copy->msg_name,
+				      msg_copy->msg_namelen));
+	Z_OOPS(msg_copy->msg_control &&
+	       Z_SYSCALL_MEMORY_WRITE(msg_copy->msg_control,
+				      msg_copy->msg_controllen));
+
+	msg_copy->msg_iov = z_user_alloc_from_copy(msg_copy->msg_iov, iov_size);
+	if (msg_copy->msg_iov == NULL && iov_size > 0) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	for (size_t i = 0; i < msg_copy->msg_iovlen; i++) {
+		if (Z_SYSCALL_MEMORY_WRITE(msg_copy->msg_iov[i].iov_base,
+					   msg_copy->msg_iov[i].iov_len)) {
+			k_free(msg_copy->msg_iov);
+			Z_OOPS(true);
+		}
+	}
+
+	return 0;
+}
+
+/* Return the output fields of a received message header to the user */
+static void recvmsg_to_user(struct msghdr *msg, struct msghdr *msg_copy)
+{
+	k_free(msg_copy->msg_iov);
+
+	Z_OOPS(z_user_to_copy(&msg->msg_namelen, &msg_copy->msg_namelen,
+			      sizeof(msg->msg_namelen)));
+	Z_OOPS(z_user_to_copy(&msg->msg_controllen, &msg_copy->msg_controllen,
+			      sizeof(msg->msg_controllen)));
+	Z_OOPS(z_user_to_copy(&msg->msg_flags, &msg_copy->msg_flags,
+			      sizeof(msg->msg_flags)));
+}
+
+static inline ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg,
+					   int flags)
+{
+	struct msghdr msg_copy;
+	ssize_t ret;
+
+	if (recvmsg_from_user(&msg_copy, msg) < 0) {
+		return -1;
+	}
+
+	ret = z_impl_zsock_recvmsg(sock, &msg_copy, flags);
+
+	recvmsg_to_user(msg, &msg_copy);
+
+	return ret;
+}
+#include <syscalls/zsock_recvmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int i;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL || vtable->sendmsg == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (i = 0; i < vlen; i++) {
+		ssize_t ret = vtable->sendmsg(obj, &msgvec[i].msg_hdr, flags);
+
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+	}
+
+	k_mutex_unlock(lock);
+
+	/* errno is kept from the failed message */
+	return (i == 0 && vlen > 0) ? -1 : i;
+}
+
+int z_impl_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int i;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (i = 0; i < vlen; i++) {
+		ssize_t ret = sock_recvmsg_locked(vtable, obj,
+						  &msgvec[i].msg_hdr,
+						  flags & ~ZSOCK_MSG_WAITFORONE);
+
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+
+		if (flags & ZSOCK_MSG_WAITFORONE) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
+	}
+
+	k_mutex_unlock(lock);
+
+	return (i == 0 && vlen > 0) ? -1 : i;
+}
+
+#ifdef CONFIG_USERSPACE
+/* Kernel copy of a user message vector, only the headers, the data stays
+ * in or is copied from user memory as for single messages
+ */
+static struct mmsghdr *mmsg_alloc(unsigned int vlen)
+{
+	struct mmsghdr *msgvec;
+	size_t size;
+
+	Z_OOPS(size_mul_overflow(vlen, sizeof(struct mmsghdr), &size));
+
+	msgvec = z_thread_malloc(size);
+	if (msgvec == NULL && vlen > 0) {
+		errno = ENOMEM;
+	}
+
+	return msgvec;
+}
+
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct mmsghdr *msgvec_copy = mmsg_alloc(vlen);
+	unsigned int i, n = 0;
+	int ret = -1;
+
+	if (msgvec_copy == NULL) {
+		return -1;
+	}
+
+	for (n = 0; n < vlen; n++) {
+		if (sendmsg_from_user(&msgvec_copy[n].msg_hdr,
+				      &msgvec[n].msg_hdr) < 0) {
+			goto out;
+		}
+	}
+
+	ret = z_impl_zsock_sendmmsg(sock, msgvec_copy, vlen, flags);
+
+	for (i = 0; ret > 0 && i < (unsigned int)ret; i++) {
+		Z_OOPS(z_user_to_copy(&msgvec[i].msg_len,
+				      &msgvec_copy[i].msg_len,
+				      sizeof(msgvec[i].msg_len)));
+	}
+
+out:
+	for (i = 0; i < n; i++) {
+		sendmsg_user_free(&msgvec_copy[i].msg_hdr);
+	}
+
+	k_free(msgvec_copy);
+
+	return ret;
+}
+#include <syscalls/zsock_sendmmsg_mrsh.c>
+
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct mmsghdr *msgvec_copy = mmsg_alloc(vlen);
+	unsigned int i, n = 0;
+	int ret = -1;
+
+	if (msgvec_copy == NULL) {
+		return -1;
+	}
+
+	for (n = 0; n < vlen; n++) {
+		if (recvmsg_from_user(&msgvec_copy[n].msg_hdr,
+				      &msgvec[n].msg_hdr) < 0) {
+			goto out;
+		}
+	}
+
+	ret = z_impl_zsock_recvmmsg(sock, msgvec_copy, vlen, flags);
+
+out:
+	for (i = 0; i < n; i++) {
+		recvmsg_to_user(&msgvec[i].msg_hdr, &msgvec_copy[i].msg_hdr);
+
+		if (ret > 0 && i < (unsigned int)ret) {
+			Z_OOPS(z_user_to_copy(&msgvec[i].msg_len,
+					      &msgvec_copy[i].msg_len,
+					      sizeof(msgvec[i].msg_len)));
+		}
+	}
+
+	k_free(msgvec_copy);
+
+	return ret;
+}
+#include <syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+/* Detach the fragments holding the data of pkt from its cursor on, the
+ * rest of pkt is released. Returns NULL if there is no data, or on
+ * allocation failure when set to ENOBUFS.
+ */
+static struct net_buf *sock_pkt_take_data(struct net_pkt *pkt, int *err)
+{
+	struct net_buf *buf = pkt->cursor.buf;
+	struct net_buf *prev;
+	size_t offset;
+
+	*err = 0;
+
+	if (buf == NULL || net_pkt_remaining_data(pkt) == 0) {
+		net_pkt_unref(pkt);
+		return NULL;
+	}
+
+	offset = pkt->cursor.pos - buf->data;
+
+	if (buf == pkt->buffer) {
+		pkt->buffer = NULL;
+	} else {
+		for (prev = pkt->buffer; prev->frags != buf;
+		     prev = prev->frags) {
 		}
+
+		prev->frags = NULL;
 	}
 
-	recv_len = net_pkt_remaining_data(pkt);
-	read_len = MIN(recv_len, max_len);
+	net_pkt_unref(pkt);
 
-	if (net_pkt_read(pkt, buf, read_len)) {
-		errno = ENOBUFS;
-		goto fail;
-	}
+	if (buf->ref > 1) {
+		/* Shared with another packet, headers cannot be pulled off
+		 * in place
+		 */
+		struct net_buf *copy = net_buf_clone(buf, K_NO_WAIT);
 
-	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) &&
-	    !(flags & ZSOCK_MSG_PEEK)) {
-		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
-	}
+		if (copy == NULL) {
+			net_buf_unref(buf);
+			*err = -ENOBUFS;
+			return NULL;
+		}
 
-	if (!(flags & ZSOCK_MSG_PEEK)) {
-		net_pkt_unref(pkt);
-	} else {
-		net_pkt_cursor_restore(pkt, &backup);
+		copy->frags = buf->frags ? net_buf_ref(buf->frags) : NULL;
+		net_buf_unref(buf);
+		buf = copy;
 	}
 
-	return (flags & ZSOCK_MSG_TRUNC) ? recv_len : read_len;
+	net_buf_pull(buf, offset);
 
-fail:
-	if (!(flags & ZSOCK_MSG_PEEK)) {
-		net_pkt_unref(pkt);
+	while (buf->len == 0 && buf->frags) {
+		buf = net_buf_frag_del(NULL, buf);
 	}
 
-	return -1;
+	return buf;
 }
 
-static inline ssize_t zsock_recv_stream(struct net_context *ctx,
-					void *buf,
-					size_t max_len,
-					int flags)
+ssize_t zsock_recvfrom_buf_ctx(struct net_context *ctx, struct net_buf **frags,
+			       int flags, struct sockaddr *src_addr,
+			       socklen_t *addrlen)
 {
+	enum net_sock_type sock_type = net_context_get_type(ctx);
 	k_timeout_t timeout = K_FOREVER;
-	size_t recv_len = 0;
-	struct net_pkt_cursor backup;
-	int res;
-	uint64_t end;
-	const bool waitall = flags & ZSOCK_MSG_WAITALL;
+	struct net_pkt *pkt;
+	size_t len;
+	int ret;
 
-	if (!net_context_is_used(ctx)) {
-		errno = EBADF;
+	*frags = NULL;
+
+	if (flags & ZSOCK_MSG_PEEK) {
+		/* The packet would have to stay in the queue */
+		errno = EINVAL;
 		return -1;
 	}
 
-	if (net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
-		errno = ENOTCONN;
+	if (sock_type == SOCK_STREAM) {
+		if (net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+			errno = ENOTCONN;
+			return -1;
+		}
+	} else if (sock_type != SOCK_DGRAM) {
+		errno = EOPNOTSUPP;
 		return -1;
 	}
 
@@ -1130,158 +1909,68 @@ static inline ssize_t zsock_recv_stream(struct net_context *ctx,
 		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
 	}
 
-	end = sys_clock_timeout_end_calc(timeout);
-
 	do {
-		struct net_pkt *pkt;
-		size_t data_len, read_len;
-		bool release_pkt = true;
-
-		if (sock_is_eof(ctx)) {
+		if (sock_type == SOCK_STREAM && sock_is_eof(ctx)) {
 			return 0;
 		}
 
 		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
-			res = wait_data(ctx, &timeout);
-			if (res < 0) {
-				errno = -res;
+			ret = wait_data(ctx, &timeout);
+			if (ret < 0) {
+				errno = -ret;
 				return -1;
 			}
 		}
 
-		pkt = k_fifo_peek_head(&ctx->recv_q);
-		if (!pkt) {
-			/* Either timeout expired, or wait was cancelled
-			 * due to connection closure by peer.
-			 */
-			NET_DBG("NULL return from fifo");
-
-			if (waitall && (recv_len > 0)) {
-				return recv_len;
-			} else if (sock_is_eof(ctx)) {
+		pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+		if (pkt == NULL) {
+			if (sock_type == SOCK_STREAM && sock_is_eof(ctx)) {
 				return 0;
-			} else {
-				errno = EAGAIN;
-				return -1;
 			}
-		}
 
-		net_pkt_cursor_backup(pkt, &backup);
-
-		data_len = net_pkt_remaining_data(pkt);
-		read_len = data_len;
-		if (recv_len + read_len > max_len) {
-			read_len = max_len - recv_len;
-			release_pkt = false;
+			errno = EAGAIN;
+			return -1;
 		}
 
-		/* Actually copy data to application buffer */
-		if (net_pkt_read(pkt, (uint8_t *)buf + recv_len, read_len)) {
-			errno = ENOBUFS;
+		if (sock_type == SOCK_DGRAM && src_addr && addrlen &&
+		    sock_recv_src_addr(ctx, pkt, src_addr, addrlen) < 0) {
+			net_pkt_unref(pkt);
 			return -1;
 		}
 
-		recv_len += read_len;
-
-		if (!(flags & ZSOCK_MSG_PEEK)) {
-			if (release_pkt) {
-				/* Finished processing head pkt in
-				 * the fifo. Drop it from there.
-				 */
-				k_fifo_get(&ctx->recv_q, K_NO_WAIT);
-				if (net_pkt_eof(pkt)) {
-					sock_set_eof(ctx);
-				}
-
-				if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
-					net_socket_update_tc_rx_time(
-						pkt, k_cycle_get_32());
-				}
-
-				net_pkt_unref(pkt);
-			}
-		} else {
-			net_pkt_cursor_restore(pkt, &backup);
+		if (sock_type == SOCK_STREAM && net_pkt_eof(pkt)) {
+			sock_set_eof(ctx);
 		}
 
-		/* Update the timeout value in case loop is repeated. */
-		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT) &&
-		    !K_TIMEOUT_EQ(timeout, K_FOREVER)) {
-			int64_t remaining = end - sys_clock_tick_get();
+		net_pkt_rx_stage_mark(pkt, NET_STATS_RX_STAGE_SOCKET);
 
-			if (remaining <= 0) {
-				timeout = K_NO_WAIT;
-			} else {
-				timeout = Z_TIMEOUT_TICKS(remaining);
-			}
+		if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+			net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
 		}
-	} while ((recv_len == 0) || (waitall && (recv_len < max_len)));
 
-	if (!(flags & ZSOCK_MSG_PEEK)) {
-		net_context_update_recv_wnd(ctx, recv_len);
-	}
-
-	return recv_len;
-}
+		len = net_pkt_remaining_data(pkt);
 
-ssize_t zsock_recvfrom_ctx(struct net_context *ctx, void *buf, size_t max_len,
-			   int flags,
-			   struct sockaddr *src_addr, socklen_t *addrlen)
-{
-	enum net_sock_type sock_type = net_context_get_type(ctx);
+		*frags = sock_pkt_take_data(pkt, &ret);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
 
-	if (max_len == 0) {
-		return 0;
-	}
+		/* Only empty datagrams are returned without data */
+	} while (len == 0 && sock_type == SOCK_STREAM);
 
-	if (sock_type == SOCK_DGRAM) {
-		return zsock_recv_dgram(ctx, buf, max_len, flags, src_addr, addrlen);
-	} else if (sock_type == SOCK_STREAM) {
-		return zsock_recv_stream(ctx, buf, max_len, flags);
-	} else {
-		__ASSERT(0, "Unknown socket type");
+	if (sock_type == SOCK_STREAM) {
+		net_context_update_recv_wnd(ctx, len);
 	}
 
-	return 0;
-}
-
-ssize_t z_impl_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
-			     struct sockaddr *src_addr, socklen_t *addrlen)
-{
-	VTABLE_CALL(recvfrom, sock, buf, max_len, flags, src_addr, addrlen);
+	return len;
 }
 
-#ifdef CONFIG_USERSPACE
-ssize_t z_vrfy_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
-			      struct sockaddr *src_addr, socklen_t *addrlen)
+ssize_t zsock_recvfrom_buf(int sock, struct net_buf **frags, int flags,
+			   struct sockaddr *src_addr, socklen_t *addrlen)
 {
-	socklen_t addrlen_copy;
-	ssize_t ret;
-
-	if (Z_SYSCALL_MEMORY_WRITE(buf, max_len)) {
-		errno = EFAULT;
-		return -1;
-	}
-
-	if (addrlen) {
-		Z_OOPS(z_user_from_copy(&addrlen_copy, addrlen,
-					sizeof(socklen_t)));
-	}
-	Z_OOPS(src_addr && Z_SYSCALL_MEMORY_WRITE(src_addr, addrlen_copy));
-
-	ret = z_impl_zsock_recvfrom(sock, (void *)buf, max_len, flags,
-				   (struct sockaddr *)src_addr,
-				   addrlen ? &addrlen_copy : NULL);
-
-	if (addrlen) {
-		Z_OOPS(z_user_to_copy(addrlen, &addrlen_copy,
-				      sizeof(socklen_t)));
-	}
-
-	return ret;
+	VTABLE_CALL(recvfrom_buf, sock, frags, flags, src_addr, addrlen);
 }
-#include <syscalls/zsock_recvfrom_mrsh.c>
-#endif /* CONFIG_USERSPACE */
 
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
@@ -1636,6 +2325,33 @@ static inline int z_vrfy_zsock_inet_pton(sa_family_t family,
 #include <syscalls/zsock_inet_pton_mrsh.c>
 #endif
 
+/* Boolean options kept in the socket flags */
+static int sock_flag_opt_set(struct net_context *ctx, uintptr_t flag,
+			     const void *optval, socklen_t optlen)
+{
+	if (optval == NULL || optlen != sizeof(int)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	sock_set_flag(ctx, flag, *(const int *)optval ? flag : 0);
+
+	return 0;
+}
+
+static int sock_flag_opt_get(struct net_context *ctx, uintptr_t flag,
+			     void *optval, socklen_t *optlen)
+{
+	if (*optlen != sizeof(int)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	*(int *)optval = sock_get_flag(ctx, flag) ? 1 : 0;
+
+	return 0;
+}
+
 int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 			 void *optval, socklen_t *optlen)
 {
@@ -1683,6 +2399,51 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 
 			return 0;
 		}
+
+		case SO_TIMESTAMPNS:
+			if (IS_ENABLED(CONFIG_NET_PKT_TIMESTAMP)) {
+				return sock_flag_opt_get(ctx,
+							 SOCK_RECV_TIMESTAMP,
+							 optval, optlen);
+			}
+			break;
+		}
+
+		break;
+
+	case IPPROTO_IP:
+		switch (optname) {
+		case IP_PKTINFO:
+			return sock_flag_opt_get(ctx, SOCK_RECV_PKTINFO,
+						 optval, optlen);
+		}
+
+		break;
+
+	case IPPROTO_IPV6:
+		switch (optname) {
+		case IPV6_RECVPKTINFO:
+			return sock_flag_opt_get(ctx, SOCK_RECV_PKTINFO,
+						 optval, optlen);
+		}
+
+		break;
+
+	case IPPROTO_TCP:
+		switch (optname) {
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CONTROL)) {
+				ret = net_context_get_option(ctx,
+						NET_OPT_TCP_CONGESTION,
+						optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+			break;
 		}
 
 		break;
@@ -1896,6 +2657,23 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			return 0;
 		}
 
+		case SO_TIMESTAMPNS:
+			if (IS_ENABLED(CONFIG_NET_PKT_TIMESTAMP)) {
+				return sock_flag_opt_set(ctx,
+							 SOCK_RECV_TIMESTAMP,
+							 optval, optlen);
+			}
+
+			break;
+		}
+
+		break;
+
+	case IPPROTO_IP:
+		switch (optname) {
+		case IP_PKTINFO:
+			return sock_flag_opt_set(ctx, SOCK_RECV_PKTINFO,
+						 optval, optlen);
 		}
 
 		break;
@@ -1907,6 +2685,20 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			 * existing apps.
 			 */
 			return 0;
+
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CONTROL)) {
+				ret = net_context_set_option(ctx,
+						NET_OPT_TCP_CONGESTION,
+						optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+			break;
 		}
 		break;
 
@@ -1917,6 +2709,10 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			 * existing apps.
 			 */
 			return 0;
+
+		case IPV6_RECVPKTINFO:
+			return sock_flag_opt_set(ctx, SOCK_RECV_PKTINFO,
+						 optval, optlen);
 		}
 		break;
 	}
@@ -2154,12 +2950,32 @@ static ssize_t sock_sendto_vmeth(void *obj, const void *buf, size_t len,
 	return zsock_sendto_ctx(obj, buf, len, flags, dest_addr, addrlen);
 }
 
+static ssize_t sock_sendto_buf_vmeth(void *obj, struct net_buf *frags,
+				     int flags,
+				     const struct sockaddr *dest_addr,
+				     socklen_t addrlen)
+{
+	return zsock_sendto_buf_ctx(obj, frags, flags, dest_addr, addrlen);
+}
+
 static ssize_t sock_sendmsg_vmeth(void *obj, const struct msghdr *msg,
 				  int flags)
 {
 	return zsock_sendmsg_ctx(obj, msg, flags);
 }
 
+static ssize_t sock_recvmsg_vmeth(void *obj, struct msghdr *msg, int flags)
+{
+	return zsock_recvmsg_ctx(obj, msg, flags);
+}
+
+static ssize_t sock_recvfrom_buf_vmeth(void *obj, struct net_buf **frags,
+				       int flags, struct sockaddr *src_addr,
+				       socklen_t *addrlen)
+{
+	return zsock_recvfrom_buf_ctx(obj, frags, flags, src_addr, addrlen);
+}
+
 static ssize_t sock_recvfrom_vmeth(void *obj, void *buf, size_t max_len,
 				   int flags, struct sockaddr *src_addr,
 				   socklen_t *addrlen)
@@ -2204,6 +3020,9 @@ const struct socket_op_vtable sock_fd_op_vtable = {
 	.accept = sock_accept_vmeth,
 	.sendto = sock_sendto_vmeth,
 	.sendmsg = sock_sendmsg_vmeth,
+	.recvmsg = sock_recvmsg_vmeth,
+	.recvfrom_buf = sock_recvfrom_buf_vmeth,
+	.sendto_buf = sock_sendto_buf_vmeth,
 	.recvfrom = sock_recvfrom_vmeth,
 	.getsockopt = sock_getsockopt_vmeth,
 	.setsockopt = sock_setsockopt_vmeth,
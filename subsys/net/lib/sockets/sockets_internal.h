@@ -11,6 +11,8 @@
 
 #define SOCK_EOF 1
 #define SOCK_NONBLOCK 2
+#define SOCK_RECV_PKTINFO 4
+#define SOCK_RECV_TIMESTAMP 8
 
 int zsock_close_ctx(struct net_context *ctx);
 int zsock_poll_internal(struct zsock_pollfd *fds, int nfds, k_timeout_t timeout);
@@ -63,6 +65,12 @@ struct socket_op_vtable {
 	int (*setsockopt)(void *obj, int level, int optname,
 			  const void *optval, socklen_t optlen);
 	ssize_t (*sendmsg)(void *obj, const struct msghdr *msg, int flags);
+	ssize_t (*recvmsg)(void *obj, struct msghdr *msg, int flags);
+	ssize_t (*recvfrom_buf)(void *obj, struct net_buf **frags, int flags,
+				struct sockaddr *src_addr, socklen_t *addrlen);
+	ssize_t (*sendto_buf)(void *obj, struct net_buf *frags, int flags,
+			      const struct sockaddr *dest_addr,
+			      socklen_t addrlen);
 	int (*getsockname)(void *obj, struct sockaddr *addr,
 			   socklen_t *addrlen);
 };
@@ -40,6 +40,386 @@ static inline int k_fifo_wait_non_empty(struct k_fifo *fifo,
 	return k_poll(events, ARRAY_SIZE(events), timeout);
 }
 
+#if defined(CONFIG_NET_SOCKETS_PACKET_RING)
+/* Offsets of the packet in the RX and TX frames */
+#define RX_DATA_OFF TPACKET_ALIGN(TPACKET_HDRLEN)
+#define TX_DATA_OFF (TPACKET_HDRLEN - sizeof(struct sockaddr_ll))
+
+struct packet_ring {
+	struct net_context *ctx;
+	uint8_t *buf;
+	size_t frame_size;
+	unsigned int frame_nr;
+	/* Next frame used by the stack */
+	unsigned int head;
+	bool tx;
+	/* Packets were dropped since the last frame written */
+	bool losing;
+	struct tpacket_stats stats;
+	/* Raised when a frame is written, for poll() */
+	struct k_poll_signal signal;
+};
+
+static struct packet_ring rings[CONFIG_NET_SOCKETS_PACKET_RINGS];
+
+/* Protects the rings from the RX path while sockets set them up */
+static K_MUTEX_DEFINE(rings_lock);
+
+static struct packet_ring *ring_find(struct net_context *ctx, bool tx)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(rings); i++) {
+		if (rings[i].ctx == ctx && rings[i].tx == tx) {
+			return &rings[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct packet_ring *ring_get(struct net_context *ctx, bool tx)
+{
+	struct packet_ring *ring;
+
+	(void)k_mutex_lock(&rings_lock, K_FOREVER);
+	ring = ring_find(ctx, tx);
+	k_mutex_unlock(&rings_lock);
+
+	return ring;
+}
+
+static inline struct tpacket_hdr *ring_frame(struct packet_ring *ring,
+					     unsigned int i)
+{
+	return (struct tpacket_hdr *)(ring->buf + i * ring->frame_size);
+}
+
+static inline uint32_t frame_status(struct tpacket_hdr *hdr)
+{
+	return __atomic_load_n(&hdr->tp_status, __ATOMIC_ACQUIRE);
+}
+
+static inline void frame_set_status(struct tpacket_hdr *hdr, uint32_t status)
+{
+	__atomic_store_n(&hdr->tp_status, status, __ATOMIC_RELEASE);
+}
+
+static inline void ring_next(struct packet_ring *ring)
+{
+	ring->head = (ring->head + 1) % ring->frame_nr;
+}
+
+static int ring_setup(struct net_context *ctx, bool tx,
+		      const void *optval, socklen_t optlen)
+{
+	const struct tpacket_req *req = optval;
+	struct packet_ring *ring;
+	int ret = 0;
+	int i;
+
+	if (!optval || optlen != sizeof(*req)) {
+		return -EINVAL;
+	}
+
+	(void)k_mutex_lock(&rings_lock, K_FOREVER);
+
+	ring = ring_find(ctx, tx);
+
+	if (req->tp_frame_nr == 0) {
+		if (ring) {
+			ring->ctx = NULL;
+		}
+
+		goto out;
+	}
+
+	if (ring) {
+		ret = -EBUSY;
+		goto out;
+	}
+
+	if (!req->tp_ring ||
+	    POINTER_TO_UINT(req->tp_ring) % TPACKET_ALIGNMENT ||
+	    req->tp_frame_size % TPACKET_ALIGNMENT ||
+	    req->tp_frame_size <= RX_DATA_OFF ||
+	    req->tp_frame_nr > SIZE_MAX / req->tp_frame_size) {
+		ret = -EINVAL;
+		goto out;
+	}
+
+	ring = ring_find(NULL, false);
+	if (!ring) {
+		ring = ring_find(NULL, true);
+		if (!ring) {
+			ret = -ENOMEM;
+			goto out;
+		}
+	}
+
+	*ring = (struct packet_ring) {
+		.ctx = ctx,
+		.buf = req->tp_ring,
+		.frame_size = req->tp_frame_size,
+		.frame_nr = req->tp_frame_nr,
+		.tx = tx,
+	};
+
+	k_poll_signal_init(&ring->signal);
+
+	/* All the RX frames belong to the stack, and the TX ones to the
+	 * application.
+	 */
+	for (i = 0; i < ring->frame_nr; i++) {
+		frame_set_status(ring_frame(ring, i), 0);
+	}
+
+out:
+	k_mutex_unlock(&rings_lock);
+
+	return ret;
+}
+
+static void ring_release(struct net_context *ctx)
+{
+	int i;
+
+	(void)k_mutex_lock(&rings_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(rings); i++) {
+		if (rings[i].ctx == ctx) {
+			rings[i].ctx = NULL;
+		}
+	}
+
+	k_mutex_unlock(&rings_lock);
+}
+
+static void ring_write(struct packet_ring *ring, struct net_pkt *pkt)
+{
+	struct tpacket_hdr *hdr = ring_frame(ring, ring->head);
+	struct sockaddr_ll *ll = (struct sockaddr_ll *)
+		((uint8_t *)hdr + TPACKET_ALIGN(sizeof(*hdr)));
+	struct net_linkaddr *lladdr = net_pkt_lladdr_src(pkt);
+	uint64_t usec = k_ticks_to_us_floor64(k_uptime_ticks());
+	uint32_t status = TP_STATUS_USER;
+	size_t len = net_pkt_get_len(pkt);
+	size_t snaplen;
+
+	ring->stats.tp_packets++;
+
+	if (frame_status(hdr) != TP_STATUS_KERNEL) {
+		ring->stats.tp_drops++;
+		ring->losing = true;
+		return;
+	}
+
+	snaplen = MIN(len, ring->frame_size - RX_DATA_OFF);
+
+	if (net_pkt_read(pkt, (uint8_t *)hdr + RX_DATA_OFF, snaplen)) {
+		ring->stats.tp_drops++;
+		ring->losing = true;
+		return;
+	}
+
+	memset(ll, 0, sizeof(*ll));
+	ll->sll_family = AF_PACKET;
+	ll->sll_ifindex = net_if_get_by_iface(net_pkt_iface(pkt));
+
+	if (lladdr->addr && lladdr->len <= sizeof(ll->sll_addr)) {
+		ll->sll_halen = lladdr->len;
+		memcpy(ll->sll_addr, lladdr->addr, lladdr->len);
+	}
+
+	hdr->tp_len = len;
+	hdr->tp_snaplen = snaplen;
+	hdr->tp_mac = RX_DATA_OFF;
+	hdr->tp_sec = usec / USEC_PER_SEC;
+	hdr->tp_usec = usec % USEC_PER_SEC;
+
+	if (ring->losing) {
+		status |= TP_STATUS_LOSING;
+		ring->losing = false;
+	}
+
+	frame_set_status(hdr, status);
+	ring_next(ring);
+
+	k_poll_signal_raise(&ring->signal, 0);
+}
+
+/* Write the packet to the RX ring of the socket, if there is one */
+static bool ring_input(struct net_context *ctx, struct net_pkt *pkt)
+{
+	struct packet_ring *ring;
+
+	(void)k_mutex_lock(&rings_lock, K_FOREVER);
+
+	ring = ring_find(ctx, false);
+	if (ring) {
+		ring_write(ring, pkt);
+	}
+
+	k_mutex_unlock(&rings_lock);
+
+	if (!ring) {
+		return false;
+	}
+
+	net_pkt_unref(pkt);
+
+	return true;
+}
+
+/* Send all the frames queued in the TX ring, in order */
+static ssize_t ring_send(struct net_context *ctx, struct packet_ring *ring,
+			 const struct sockaddr *dest_addr, socklen_t addrlen,
+			 k_timeout_t timeout)
+{
+	struct tpacket_hdr *hdr;
+	ssize_t sent = 0;
+	int ret;
+
+	while (true) {
+		hdr = ring_frame(ring, ring->head);
+
+		if (frame_status(hdr) != TP_STATUS_SEND_REQUEST) {
+			break;
+		}
+
+		if (hdr->tp_len > ring->frame_size - TX_DATA_OFF) {
+			frame_set_status(hdr, TP_STATUS_WRONG_FORMAT);
+			ring_next(ring);
+			continue;
+		}
+
+		frame_set_status(hdr, TP_STATUS_SENDING);
+
+		ret = net_context_sendto(ctx, (uint8_t *)hdr + TX_DATA_OFF,
+					 hdr->tp_len, dest_addr, addrlen,
+					 NULL, timeout, ctx->user_data);
+		if (ret < 0) {
+			/* Left for the next send() call */
+			frame_set_status(hdr, TP_STATUS_SEND_REQUEST);
+
+			if (sent == 0) {
+				errno = -ret;
+				return -1;
+			}
+
+			break;
+		}
+
+		frame_set_status(hdr, TP_STATUS_AVAILABLE);
+		ring_next(ring);
+
+		sent += ret;
+	}
+
+	return sent;
+}
+
+/* Readable when the last frame written has not been released yet */
+static bool ring_readable(struct packet_ring *ring)
+{
+	unsigned int prev;
+	bool readable;
+
+	(void)k_mutex_lock(&rings_lock, K_FOREVER);
+
+	prev = (ring->head + ring->frame_nr - 1) % ring->frame_nr;
+	readable = frame_status(ring_frame(ring, prev)) != TP_STATUS_KERNEL;
+
+	k_mutex_unlock(&rings_lock);
+
+	return readable;
+}
+
+static int ring_poll_prepare(struct packet_ring *ring,
+			     struct zsock_pollfd *pfd,
+			     struct k_poll_event **pev,
+			     struct k_poll_event *pev_end)
+{
+	if (pfd->events & ZSOCK_POLLIN) {
+		if (*pev == pev_end) {
+			return -ENOMEM;
+		}
+
+		k_poll_signal_reset(&ring->signal);
+
+		(*pev)->obj = &ring->signal;
+		(*pev)->type = K_POLL_TYPE_SIGNAL;
+		(*pev)->mode = K_POLL_MODE_NOTIFY_ONLY;
+		(*pev)->state = K_POLL_STATE_NOT_READY;
+		(*pev)++;
+
+		if (ring_readable(ring)) {
+			return -EALREADY;
+		}
+	}
+
+	if (pfd->events & ZSOCK_POLLOUT) {
+		return -EALREADY;
+	}
+
+	return 0;
+}
+
+static int ring_poll_update(struct packet_ring *ring,
+			    struct zsock_pollfd *pfd,
+			    struct k_poll_event **pev)
+{
+	if (pfd->events & ZSOCK_POLLOUT) {
+		pfd->revents |= ZSOCK_POLLOUT;
+	}
+
+	if (pfd->events & ZSOCK_POLLIN) {
+		if (ring_readable(ring)) {
+			pfd->revents |= ZSOCK_POLLIN;
+		}
+
+		(*pev)++;
+	}
+
+	return 0;
+}
+
+static int ring_get_stats(struct net_context *ctx, void *optval,
+			  socklen_t *optlen)
+{
+	struct tpacket_stats stats = { 0 };
+	struct packet_ring *ring;
+
+	if (*optlen < sizeof(stats)) {
+		return -EINVAL;
+	}
+
+	(void)k_mutex_lock(&rings_lock, K_FOREVER);
+
+	ring = ring_find(ctx, false);
+	if (ring) {
+		stats = ring->stats;
+		memset(&ring->stats, 0, sizeof(ring->stats));
+	}
+
+	k_mutex_unlock(&rings_lock);
+
+	memcpy(optval, &stats, sizeof(stats));
+	*optlen = sizeof(stats);
+
+	return 0;
+}
+#else
+static inline bool ring_input(struct net_context *ctx, struct net_pkt *pkt)
+{
+	return false;
+}
+
+static inline void ring_release(struct net_context *ctx)
+{
+}
+#endif /* CONFIG_NET_SOCKETS_PACKET_RING */
+
 static int zpacket_socket(int family, int type, int proto)
 {
 	struct net_context *ctx;
@@ -105,6 +485,10 @@ static void zpacket_received_cb(struct net_context *ctx,
 		return;
 	}
 
+	if (ring_input(ctx, pkt)) {
+		return;
+	}
+
 	/* Normal packet */
 	net_pkt_set_eof(pkt, false);
 
@@ -142,6 +526,24 @@ ssize_t zpacket_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 {
 	k_timeout_t timeout = K_FOREVER;
 	int status;
+#if defined(CONFIG_NET_SOCKETS_PACKET_RING)
+	struct packet_ring *ring = ring_get(ctx, true);
+	struct sockaddr_ll bound_addr = { 0 };
+
+	/* With a TX ring, the frames are sent to the bound address unless
+	 * another one is given.
+	 */
+	if (ring && !dest_addr &&
+	    net_sll_ptr(&ctx->local)->sll_family == AF_PACKET) {
+		bound_addr.sll_family = AF_PACKET;
+		bound_addr.sll_ifindex = net_sll_ptr(&ctx->local)->sll_ifindex;
+		bound_addr.sll_protocol =
+			net_sll_ptr(&ctx->local)->sll_protocol;
+
+		dest_addr = (struct sockaddr *)&bound_addr;
+		addrlen = sizeof(bound_addr);
+	}
+#endif
 
 	if (!dest_addr) {
 		errno = EDESTADDRREQ;
@@ -165,6 +567,13 @@ ssize_t zpacket_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 		return -1;
 	}
 
+#if defined(CONFIG_NET_SOCKETS_PACKET_RING)
+	if (ring) {
+		/* The data given to the call is ignored, as with Linux */
+		return ring_send(ctx, ring, dest_addr, addrlen, timeout);
+	}
+#endif
+
 	status = net_context_sendto(ctx, buf, len, dest_addr, addrlen,
 				    NULL, timeout, ctx->user_data);
 	if (status < 0) {
@@ -266,6 +675,20 @@ int zpacket_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 		return -1;
 	}
 
+#if defined(CONFIG_NET_SOCKETS_PACKET_RING)
+	if (level == SOL_PACKET && optname == PACKET_STATISTICS) {
+		int ret;
+
+		ret = ring_get_stats(ctx, optval, optlen);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+
+		return 0;
+	}
+#endif
+
 	return sock_fd_op_vtable.getsockopt(ctx, level, optname,
 					    optval, optlen);
 }
@@ -273,6 +696,22 @@ int zpacket_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 int zpacket_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			const void *optval, socklen_t optlen)
 {
+#if defined(CONFIG_NET_SOCKETS_PACKET_RING)
+	if (level == SOL_PACKET &&
+	    (optname == PACKET_RX_RING || optname == PACKET_TX_RING)) {
+		int ret;
+
+		ret = ring_setup(ctx, optname == PACKET_TX_RING,
+				 optval, optlen);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+
+		return 0;
+	}
+#endif
+
 	return sock_fd_op_vtable.setsockopt(ctx, level, optname,
 					    optval, optlen);
 }
@@ -291,6 +730,40 @@ static ssize_t packet_sock_write_vmeth(void *obj, const void *buffer,
 static int packet_sock_ioctl_vmeth(void *obj, unsigned int request,
 				   va_list args)
 {
+#if defined(CONFIG_NET_SOCKETS_PACKET_RING)
+	struct packet_ring *ring;
+
+	/* Packets received go to the RX ring instead of the queue */
+	if (request == ZFD_IOCTL_POLL_PREPARE ||
+	    request == ZFD_IOCTL_POLL_UPDATE) {
+		ring = ring_get(obj, false);
+	} else {
+		ring = NULL;
+	}
+
+	if (ring && request == ZFD_IOCTL_POLL_PREPARE) {
+		struct zsock_pollfd *pfd;
+		struct k_poll_event **pev;
+		struct k_poll_event *pev_end;
+
+		pfd = va_arg(args, struct zsock_pollfd *);
+		pev = va_arg(args, struct k_poll_event **);
+		pev_end = va_arg(args, struct k_poll_event *);
+
+		return ring_poll_prepare(ring, pfd, pev, pev_end);
+	}
+
+	if (ring && request == ZFD_IOCTL_POLL_UPDATE) {
+		struct zsock_pollfd *pfd;
+		struct k_poll_event **pev;
+
+		pfd = va_arg(args, struct zsock_pollfd *);
+		pev = va_arg(args, struct k_poll_event **);
+
+		return ring_poll_update(ring, pfd, pev);
+	}
+#endif
+
 	return sock_fd_op_vtable.fd_vtable.ioctl(obj, request, args);
 }
 
@@ -362,6 +835,8 @@ static int packet_sock_setsockopt_vmeth(void *obj, int level, int optname,
 
 static int packet_sock_close_vmeth(void *obj)
 {
+	ring_release(obj);
+
 	return zsock_close_ctx(obj);
 }
 
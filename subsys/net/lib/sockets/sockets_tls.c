@@ -12,6 +12,7 @@
 LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 #include <init.h>
+#include <sys/crc.h>
 #include <sys/util.h>
 #include <net/socket.h>
 #include <random/rand32.h>
@@ -32,6 +33,13 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <mbedtls/ssl_cookie.h>
 #include <mbedtls/error.h>
 #include <mbedtls/debug.h>
+#include <mbedtls/platform.h>
+#if defined(MBEDTLS_SSL_CACHE_C)
+#include <mbedtls/ssl_cache.h>
+#endif
+#if defined(MBEDTLS_SSL_TICKET_C)
+#include <mbedtls/ssl_ticket.h>
+#endif
 #endif /* CONFIG_MBEDTLS */
 
 #include "sockets_internal.h"
@@ -114,6 +122,9 @@ __net_socket struct tls_context {
 		/** DTLS role, client by default. */
 		int8_t role;
 
+		/** Information if session caching is enabled. */
+		bool cache_enabled;
+
 		/** NULL-terminated list of allowed application layer
 		 * protocols.
 		 */
@@ -167,6 +178,48 @@ static struct tls_context tls_contexts[CONFIG_NET_SOCKETS_TLS_MAX_CONTEXTS];
 /* A mutex for protecting TLS context allocation. */
 static struct k_mutex context_lock;
 
+/* A mutex for protecting the session caches. */
+static struct k_mutex session_lock;
+
+#if CONFIG_NET_SOCKETS_TLS_SENDMSG_BUF_SIZE > 0
+/* A buffer to send the vectors of a sendmsg() in a single record. */
+static uint8_t sendmsg_buf[CONFIG_NET_SOCKETS_TLS_SENDMSG_BUF_SIZE];
+
+/* A mutex for protecting the sendmsg() buffer. */
+static struct k_mutex sendmsg_lock;
+#endif
+
+#if CONFIG_NET_SOCKETS_TLS_MAX_CLIENT_SESSION_COUNT > 0
+/** A client session stored for resumption. */
+struct tls_session_cache {
+	/** Key of the server the session was established with. */
+	uint32_t key;
+
+	/** Time the session was stored, to replace the oldest one. */
+	int64_t timestamp;
+
+	/** Serialized session, NULL if the entry is unused. */
+	uint8_t *session;
+
+	/** Length of the serialized session. */
+	size_t session_len;
+};
+
+static struct tls_session_cache
+	client_cache[CONFIG_NET_SOCKETS_TLS_MAX_CLIENT_SESSION_COUNT];
+#endif /* CONFIG_NET_SOCKETS_TLS_MAX_CLIENT_SESSION_COUNT > 0 */
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+/* Sessions of the clients of all TLS/DTLS servers. */
+static mbedtls_ssl_cache_context server_cache;
+#endif
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+/* Keys protecting the session tickets issued by all TLS/DTLS servers. */
+static mbedtls_ssl_ticket_context ticket_ctx;
+static bool ticket_ctx_ready;
+#endif
+
 bool net_socket_is_tls(void *obj)
 {
 	return PART_OF_ARRAY(tls_contexts, (struct tls_context *)obj);
@@ -268,11 +321,37 @@ static int tls_init(const struct device *unused)
 	(void)memset(tls_contexts, 0, sizeof(tls_contexts));
 
 	k_mutex_init(&context_lock);
+	k_mutex_init(&session_lock);
+#if CONFIG_NET_SOCKETS_TLS_SENDMSG_BUF_SIZE > 0
+	k_mutex_init(&sendmsg_lock);
+#endif
 
 #if defined(MBEDTLS_DEBUG_C) && (CONFIG_NET_SOCKETS_LOG_LEVEL >= LOG_LEVEL_DBG)
 	mbedtls_debug_set_threshold(CONFIG_MBEDTLS_DEBUG_LEVEL);
 #endif
 
+#if defined(MBEDTLS_SSL_CACHE_C)
+	mbedtls_ssl_cache_init(&server_cache);
+	mbedtls_ssl_cache_set_max_entries(
+		&server_cache, CONFIG_NET_SOCKETS_TLS_MAX_SERVER_SESSION_COUNT);
+#if defined(MBEDTLS_HAVE_TIME)
+	mbedtls_ssl_cache_set_timeout(&server_cache,
+				      CONFIG_NET_SOCKETS_TLS_SESSION_LIFETIME);
+#endif
+#endif /* MBEDTLS_SSL_CACHE_C */
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+	mbedtls_ssl_ticket_init(&ticket_ctx);
+	if (mbedtls_ssl_ticket_setup(&ticket_ctx, tls_ctr_drbg_random, NULL,
+				     MBEDTLS_CIPHER_AES_256_GCM,
+				     CONFIG_NET_SOCKETS_TLS_SESSION_LIFETIME)
+	    == 0) {
+		ticket_ctx_ready = true;
+	} else {
+		NET_WARN("Failed to set up session tickets");
+	}
+#endif /* MBEDTLS_SSL_TICKET_C */
+
 	return 0;
 }
 
@@ -296,16 +375,32 @@ static inline bool is_handshake_complete(struct tls_context *ctx)
 	: (MBEDTLS_SSL_IN_CONTENT_LEN)				     \
 	)
 
+/* Maximum Fragment Length to request, unless configured explicitly,
+ * the length our record buffers can handle.
+ */
+#if defined(CONFIG_NET_SOCKETS_TLS_SET_MAX_FRAGMENT_LENGTH) && \
+	(CONFIG_NET_SOCKETS_TLS_MAX_FRAGMENT_LENGTH > 0)
+BUILD_ASSERT(CONFIG_NET_SOCKETS_TLS_MAX_FRAGMENT_LENGTH == 512 ||
+	     CONFIG_NET_SOCKETS_TLS_MAX_FRAGMENT_LENGTH == 1024 ||
+	     CONFIG_NET_SOCKETS_TLS_MAX_FRAGMENT_LENGTH == 2048 ||
+	     CONFIG_NET_SOCKETS_TLS_MAX_FRAGMENT_LENGTH == 4096,
+	     "Maximum Fragment Length shall be 512, 1024, 2048 or 4096");
+
+#define TLS_MFL_LEN MIN(CONFIG_NET_SOCKETS_TLS_MAX_FRAGMENT_LENGTH, \
+			MBEDTLS_TLS_EXT_ADV_CONTENT_LEN)
+#else
+#define TLS_MFL_LEN MBEDTLS_TLS_EXT_ADV_CONTENT_LEN
+#endif
+
 #if defined(CONFIG_NET_SOCKETS_TLS_SET_MAX_FRAGMENT_LENGTH) &&	\
 	defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH) &&		\
-	(MBEDTLS_TLS_EXT_ADV_CONTENT_LEN < 16384)
+	(TLS_MFL_LEN < 16384)
 
-BUILD_ASSERT(MBEDTLS_TLS_EXT_ADV_CONTENT_LEN >= 512,
-	     "Too small content length!");
+BUILD_ASSERT(TLS_MFL_LEN >= 512, "Too small content length!");
 
 static inline unsigned char tls_mfl_code_from_content_len(void)
 {
-	size_t len = MBEDTLS_TLS_EXT_ADV_CONTENT_LEN;
+	size_t len = TLS_MFL_LEN;
 
 	if (len >= 4096) {
 		return MBEDTLS_SSL_MAX_FRAG_LEN_4096;
@@ -797,6 +892,298 @@ exit:
 	return err;
 }
 
+#if CONFIG_NET_SOCKETS_TLS_MAX_CLIENT_SESSION_COUNT > 0
+/* Sessions are resumed with a server of the same hostname, or of the same
+ * address if no hostname was set, on the same port and transport.
+ */
+static uint32_t tls_session_key(struct tls_context *context,
+				const struct sockaddr *addr)
+{
+	uint16_t port = net_sin(addr)->sin_port;
+	uint32_t key;
+
+	key = crc32_ieee_update(0, (uint8_t *)&context->type,
+				sizeof(context->type));
+	key = crc32_ieee_update(key, (uint8_t *)&port, sizeof(port));
+
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+	if (context->options.is_hostname_set && context->ssl.hostname) {
+		return crc32_ieee_update(key,
+					 (const uint8_t *)context->ssl.hostname,
+					 strlen(context->ssl.hostname));
+	}
+#endif
+
+	if (addr->sa_family == AF_INET6) {
+		return crc32_ieee_update(key,
+					 (uint8_t *)&net_sin6(addr)->sin6_addr,
+					 sizeof(struct in6_addr));
+	}
+
+	return crc32_ieee_update(key, (uint8_t *)&net_sin(addr)->sin_addr,
+				 sizeof(struct in_addr));
+}
+
+/* Must be invoked with session lock held */
+static struct tls_session_cache *tls_session_find(uint32_t key)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(client_cache); i++) {
+		if (client_cache[i].session && client_cache[i].key == key) {
+			return &client_cache[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Must be invoked with session lock held */
+static void tls_session_free(struct tls_session_cache *entry)
+{
+	mbedtls_free(entry->session);
+	entry->session = NULL;
+	entry->session_len = 0;
+}
+
+static void tls_session_store(struct tls_context *context,
+			      const struct sockaddr *addr)
+{
+	struct tls_session_cache *entry;
+	mbedtls_ssl_session session;
+	uint32_t key;
+	uint8_t *buf;
+	size_t len;
+	int ret, i;
+
+	if (!context->options.cache_enabled) {
+		return;
+	}
+
+	key = tls_session_key(context, addr);
+
+	mbedtls_ssl_session_init(&session);
+
+	ret = mbedtls_ssl_get_session(&context->ssl, &session);
+	if (ret != 0) {
+		goto out;
+	}
+
+	/* Get the length first */
+	ret = mbedtls_ssl_session_save(&session, NULL, 0, &len);
+	if (ret != MBEDTLS_ERR_SSL_BUFFER_TOO_SMALL) {
+		goto out;
+	}
+
+	buf = mbedtls_calloc(1, len);
+	if (!buf) {
+		NET_WARN("Not enough memory to store the TLS session");
+		goto out;
+	}
+
+	ret = mbedtls_ssl_session_save(&session, buf, len, &len);
+	if (ret != 0) {
+		mbedtls_free(buf);
+		goto out;
+	}
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	/* Replace the session of the server, the first unused entry or
+	 * the oldest session, in that order.
+	 */
+	entry = tls_session_find(key);
+	if (!entry) {
+		entry = &client_cache[0];
+
+		for (i = 0; i < ARRAY_SIZE(client_cache); i++) {
+			if (!client_cache[i].session) {
+				entry = &client_cache[i];
+				break;
+			}
+
+			if (client_cache[i].timestamp < entry->timestamp) {
+				entry = &client_cache[i];
+			}
+		}
+	}
+
+	tls_session_free(entry);
+
+	entry->key = key;
+	entry->timestamp = k_uptime_get();
+	entry->session = buf;
+	entry->session_len = len;
+
+	k_mutex_unlock(&session_lock);
+
+	NET_DBG("Stored TLS session of %zu bytes", len);
+
+out:
+	mbedtls_ssl_session_free(&session);
+}
+
+static void tls_session_restore(struct tls_context *context,
+				const struct sockaddr *addr)
+{
+	struct tls_session_cache *entry;
+	mbedtls_ssl_session session;
+	int ret;
+
+	if (!context->options.cache_enabled) {
+		return;
+	}
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	entry = tls_session_find(tls_session_key(context, addr));
+	if (!entry) {
+		goto unlock;
+	}
+
+	mbedtls_ssl_session_init(&session);
+
+	ret = mbedtls_ssl_session_load(&session, entry->session,
+				       entry->session_len);
+	if (ret == 0) {
+		ret = mbedtls_ssl_set_session(&context->ssl, &session);
+	}
+
+	if (ret != 0) {
+		/* The session cannot be used, so do not try it again. */
+		NET_DBG("Cannot restore TLS session: -%x", -ret);
+		tls_session_free(entry);
+	}
+
+	mbedtls_ssl_session_free(&session);
+
+unlock:
+	k_mutex_unlock(&session_lock);
+}
+
+static void tls_session_purge(void)
+{
+	int i;
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(client_cache); i++) {
+		tls_session_free(&client_cache[i]);
+	}
+
+	k_mutex_unlock(&session_lock);
+}
+#else
+static void tls_session_store(struct tls_context *context,
+			      const struct sockaddr *addr)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(addr);
+}
+
+static void tls_session_restore(struct tls_context *context,
+				const struct sockaddr *addr)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(addr);
+}
+
+static void tls_session_purge(void)
+{
+}
+#endif /* CONFIG_NET_SOCKETS_TLS_MAX_CLIENT_SESSION_COUNT > 0 */
+
+/* The mbedTLS server cache and ticket keys are shared by all the servers,
+ * and are only thread safe with MBEDTLS_THREADING_C, so lock them here.
+ */
+#if defined(MBEDTLS_SSL_CACHE_C)
+static int tls_server_cache_get(void *data, mbedtls_ssl_session *session)
+{
+	int ret;
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+	ret = mbedtls_ssl_cache_get(data, session);
+	k_mutex_unlock(&session_lock);
+
+	return ret;
+}
+
+static int tls_server_cache_set(void *data,
+				const mbedtls_ssl_session *session)
+{
+	int ret;
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+	ret = mbedtls_ssl_cache_set(data, session);
+	k_mutex_unlock(&session_lock);
+
+	return ret;
+}
+#endif /* MBEDTLS_SSL_CACHE_C */
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+static int tls_ticket_write(void *data, const mbedtls_ssl_session *session,
+			    unsigned char *start, const unsigned char *end,
+			    size_t *tlen, uint32_t *lifetime)
+{
+	int ret;
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+	ret = mbedtls_ssl_ticket_write(data, session, start, end, tlen,
+				       lifetime);
+	k_mutex_unlock(&session_lock);
+
+	return ret;
+}
+
+static int tls_ticket_parse(void *data, mbedtls_ssl_session *session,
+			    unsigned char *buf, size_t len)
+{
+	int ret;
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+	ret = mbedtls_ssl_ticket_parse(data, session, buf, len);
+	k_mutex_unlock(&session_lock);
+
+	return ret;
+}
+#endif /* MBEDTLS_SSL_TICKET_C */
+
+static void tls_session_cache_conf(struct tls_context *context,
+				   bool is_server)
+{
+	if (!is_server) {
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+		/* Do not ask for tickets that would not be stored. */
+		if (!context->options.cache_enabled) {
+			mbedtls_ssl_conf_session_tickets(
+				&context->config,
+				MBEDTLS_SSL_SESSION_TICKETS_DISABLED);
+		}
+#endif
+		return;
+	}
+
+	if (!context->options.cache_enabled) {
+		return;
+	}
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+	mbedtls_ssl_conf_session_cache(&context->config, &server_cache,
+				       tls_server_cache_get,
+				       tls_server_cache_set);
+#endif
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+	if (ticket_ctx_ready) {
+		mbedtls_ssl_conf_session_tickets_cb(&context->config,
+						    tls_ticket_write,
+						    tls_ticket_parse,
+						    &ticket_ctx);
+	}
+#endif
+}
+
 static int tls_mbedtls_reset(struct tls_context *context)
 {
 	int ret;
@@ -947,6 +1334,8 @@ static int tls_mbedtls_init(struct tls_context *context, bool is_server)
 			     tls_ctr_drbg_random,
 			     NULL);
 
+	tls_session_cache_conf(context, is_server);
+
 	ret = tls_mbedtls_set_credentials(context);
 	if (ret != 0) {
 		return ret;
@@ -1290,6 +1679,58 @@ static int tls_opt_dtls_role_set(struct tls_context *context,
 	return 0;
 }
 
+static int tls_opt_session_cache_set(struct tls_context *context,
+				     const void *optval, socklen_t optlen)
+{
+	int *cache;
+
+	if (!optval) {
+		return -EINVAL;
+	}
+
+	if (optlen != sizeof(int)) {
+		return -EINVAL;
+	}
+
+	cache = (int *)optval;
+	if (*cache != TLS_SESSION_CACHE_DISABLED &&
+	    *cache != TLS_SESSION_CACHE_ENABLED) {
+		return -EINVAL;
+	}
+
+	context->options.cache_enabled = (*cache == TLS_SESSION_CACHE_ENABLED);
+
+	return 0;
+}
+
+static int tls_opt_session_cache_get(struct tls_context *context,
+				     void *optval, socklen_t *optlen)
+{
+	int cache = context->options.cache_enabled ?
+		TLS_SESSION_CACHE_ENABLED : TLS_SESSION_CACHE_DISABLED;
+
+	if (*optlen != sizeof(cache)) {
+		return -EINVAL;
+	}
+
+	*(int *)optval = cache;
+
+	return 0;
+}
+
+static int tls_opt_session_cache_purge_set(struct tls_context *context,
+					   const void *optval,
+					   socklen_t optlen)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(optval);
+	ARG_UNUSED(optlen);
+
+	tls_session_purge();
+
+	return 0;
+}
+
 static int protocol_check(int family, int type, int *proto)
 {
 	if (family != AF_INET && family != AF_INET6) {
@@ -1407,6 +1848,8 @@ int ztls_connect_ctx(struct tls_context *ctx, const struct sockaddr *addr,
 			goto error;
 		}
 
+		tls_session_restore(ctx, addr);
+
 		/* Do not use any socket flags during the handshake. */
 		ctx->flags = 0;
 
@@ -1417,6 +1860,8 @@ int ztls_connect_ctx(struct tls_context *ctx, const struct sockaddr *addr,
 		if (ret < 0) {
 			goto error;
 		}
+
+		tls_session_store(ctx, addr);
 	} else {
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 		/* Just store the address. */
@@ -1547,6 +1992,8 @@ static ssize_t sendto_dtls_client(struct tls_context *ctx, const void *buf,
 		if (ret < 0) {
 			goto error;
 		}
+
+		tls_session_restore(ctx, &ctx->dtls_peer_addr);
 	}
 
 	if (!is_handshake_complete(ctx)) {
@@ -1557,6 +2004,8 @@ static ssize_t sendto_dtls_client(struct tls_context *ctx, const void *buf,
 		if (ret < 0) {
 			goto error;
 		}
+
+		tls_session_store(ctx, &ctx->dtls_peer_addr);
 	}
 
 	return send_tls(ctx, buf, len, flags);
@@ -1615,6 +2064,32 @@ ssize_t ztls_sendto_ctx(struct tls_context *ctx, const void *buf, size_t len,
 #endif /* CONFIG_NET_SOCKETS_ENABLE_DTLS */
 }
 
+#if CONFIG_NET_SOCKETS_TLS_SENDMSG_BUF_SIZE > 0
+static ssize_t sendmsg_single_record(struct tls_context *ctx,
+				     const struct msghdr *msg, int flags,
+				     size_t total_len)
+{
+	size_t offset = 0;
+	ssize_t ret;
+	int i;
+
+	k_mutex_lock(&sendmsg_lock, K_FOREVER);
+
+	for (i = 0; i < msg->msg_iovlen; i++) {
+		memcpy(sendmsg_buf + offset, msg->msg_iov[i].iov_base,
+		       msg->msg_iov[i].iov_len);
+		offset += msg->msg_iov[i].iov_len;
+	}
+
+	ret = ztls_sendto_ctx(ctx, sendmsg_buf, total_len, flags,
+			      msg->msg_name, msg->msg_namelen);
+
+	k_mutex_unlock(&sendmsg_lock);
+
+	return ret;
+}
+#endif
+
 ssize_t ztls_sendmsg_ctx(struct tls_context *ctx, const struct msghdr *msg,
 			 int flags)
 {
@@ -1622,6 +2097,21 @@ ssize_t ztls_sendmsg_ctx(struct tls_context *ctx, const struct msghdr *msg,
 	ssize_t ret;
 	int i;
 
+#if CONFIG_NET_SOCKETS_TLS_SENDMSG_BUF_SIZE > 0
+	if (msg && msg->msg_iovlen > 1) {
+		size_t total_len = 0;
+
+		for (i = 0; i < msg->msg_iovlen; i++) {
+			total_len += msg->msg_iov[i].iov_len;
+		}
+
+		if (total_len <= sizeof(sendmsg_buf)) {
+			return sendmsg_single_record(ctx, msg, flags,
+						     total_len);
+		}
+	}
+#endif
+
 	len = 0;
 	if (msg) {
 		for (i = 0; i < msg->msg_iovlen; i++) {
@@ -2241,6 +2731,10 @@ int ztls_getsockopt_ctx(struct tls_context *ctx, int level, int optname,
 		err = tls_opt_alpn_list_get(ctx, optval, optlen);
 		break;
 
+	case TLS_SESSION_CACHE:
+		err = tls_opt_session_cache_get(ctx, optval, optlen);
+		break;
+
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 	case TLS_DTLS_HANDSHAKE_TIMEOUT_MIN:
 		err = tls_opt_dtls_handshake_timeout_get(ctx, optval,
@@ -2302,6 +2796,14 @@ int ztls_setsockopt_ctx(struct tls_context *ctx, int level, int optname,
 		err = tls_opt_alpn_list_set(ctx, optval, optlen);
 		break;
 
+	case TLS_SESSION_CACHE:
+		err = tls_opt_session_cache_set(ctx, optval, optlen);
+		break;
+
+	case TLS_SESSION_CACHE_PURGE:
+		err = tls_opt_session_cache_purge_set(ctx, optval, optlen);
+		break;
+
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 	case TLS_DTLS_HANDSHAKE_TIMEOUT_MIN:
 		err = tls_opt_dtls_handshake_timeout_set(ctx, optval,
@@ -440,27 +440,66 @@ static int websocket_ioctl_vmeth(void *obj, unsigned int request, va_list args)
 	return sock_fd_op_vtable.fd_vtable.ioctl(obj, request, args);
 }
 
+/* Masks len bytes of src into dst, which may be the same buffer, a word at a
+ * time. The offset is the position of the first byte in the message, which
+ * selects the byte of the masking value it is masked with.
+ */
+static void websocket_mask(uint8_t *dst, const uint8_t *src, size_t len,
+			   uint32_t masking_value, size_t offset)
+{
+	uint8_t key[sizeof(uint32_t)];
+	uint32_t key_word;
+	uint32_t word;
+	size_t i;
+
+	/* The masking value is applied from its most significant byte */
+	sys_put_be32(masking_value, key);
+
+	for (i = 0; i < len && (offset + i) % sizeof(key); i++) {
+		dst[i] = src[i] ^ key[(offset + i) % sizeof(key)];
+	}
+
+	memcpy(&key_word, key, sizeof(key_word));
+
+	for (; i + sizeof(word) <= len; i += sizeof(word)) {
+		memcpy(&word, &src[i], sizeof(word));
+		word ^= key_word;
+		memcpy(&dst[i], &word, sizeof(word));
+	}
+
+	for (; i < len; i++) {
+		dst[i] = src[i] ^ key[(offset + i) % sizeof(key)];
+	}
+}
+
 static int websocket_prepare_and_send(struct websocket_context *ctx,
 				      uint8_t *header, size_t header_len,
-				      uint8_t *payload, size_t payload_len,
+				      const struct iovec *iov, size_t iovcnt,
 				      int32_t timeout)
 {
-	struct iovec io_vector[2];
+	struct iovec io_vector[1 + WEBSOCKET_MAX_IOV];
 	struct msghdr msg;
+	size_t i;
 
 	io_vector[0].iov_base = header;
 	io_vector[0].iov_len = header_len;
-	io_vector[1].iov_base = payload;
-	io_vector[1].iov_len = payload_len;
+
+	for (i = 0; i < iovcnt; i++) {
+		io_vector[1 + i] = iov[i];
+	}
 
 	memset(&msg, 0, sizeof(msg));
 
 	msg.msg_iov = io_vector;
-	msg.msg_iovlen = ARRAY_SIZE(io_vector);
+	msg.msg_iovlen = 1 + iovcnt;
 
 	if (HEXDUMP_SENT_PACKETS) {
 		LOG_HEXDUMP_DBG(header, header_len, "Header");
-		LOG_HEXDUMP_DBG(payload, payload_len, "Payload");
+
+		for (i = 0; i < iovcnt; i++) {
+			LOG_HEXDUMP_DBG(iov[i].iov_base, iov[i].iov_len,
+					"Payload");
+		}
 	}
 
 #if defined(CONFIG_NET_TEST)
@@ -480,13 +519,16 @@ static int websocket_prepare_and_send(struct websocket_context *ctx,
 #endif /* CONFIG_NET_TEST */
 }
 
-int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
-		       enum websocket_opcode opcode, bool mask, bool final,
-		       int32_t timeout)
+int websocket_send_msg_iov(int ws_sock, const struct iovec *iov,
+			   size_t iovcnt, enum websocket_opcode opcode,
+			   bool mask, bool final, int32_t timeout)
 {
 	struct websocket_context *ctx;
 	uint8_t header[MAX_HEADER_LEN], hdr_len = 2;
-	uint8_t *data_to_send = (uint8_t *)payload;
+	struct iovec masked_iov;
+	uint8_t *masked = NULL;
+	size_t payload_len = 0;
+	size_t i;
 	int ret;
 
 	if (opcode != WEBSOCKET_OPCODE_DATA_TEXT &&
@@ -498,6 +540,10 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 		return -EINVAL;
 	}
 
+	if (iovcnt > WEBSOCKET_MAX_IOV || (iovcnt > 0 && iov == NULL)) {
+		return -EINVAL;
+	}
+
 #if defined(CONFIG_NET_TEST)
 	/* Websocket unit test does not use socket layer but feeds
 	 * the data directly here when testing this function.
@@ -514,6 +560,10 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 	}
 #endif /* CONFIG_NET_TEST */
 
+	for (i = 0; i < iovcnt; i++) {
+		payload_len += iov[i].iov_len;
+	}
+
 	NET_DBG("[%p] Len %zd %s/%d/%s", ctx, payload_len, opcode2str(opcode),
 		mask, final ? "final" : "more");
 
@@ -550,7 +600,7 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 
 	/* Add masking value if needed */
 	if (mask) {
-		int i;
+		size_t offset = 0;
 
 		ctx->masking_value = sys_rand32_get();
 
@@ -559,34 +609,53 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 		header[hdr_len++] |= ctx->masking_value >> 8;
 		header[hdr_len++] |= ctx->masking_value;
 
-		data_to_send = k_malloc(payload_len);
-		if (!data_to_send) {
+		/* The payload of the caller is not modified, it is masked
+		 * while gathered in a single buffer.
+		 */
+		masked = k_malloc(MAX(payload_len, 1));
+		if (!masked) {
 			return -ENOMEM;
 		}
 
-		memcpy(data_to_send, payload, payload_len);
-
-		for (i = 0; i < payload_len; i++) {
-			data_to_send[i] ^=
-				ctx->masking_value >> (8 * (3 - i % 4));
+		for (i = 0; i < iovcnt; i++) {
+			websocket_mask(&masked[offset], iov[i].iov_base,
+				       iov[i].iov_len, ctx->masking_value,
+				       offset);
+			offset += iov[i].iov_len;
 		}
+
+		masked_iov.iov_base = masked;
+		masked_iov.iov_len = payload_len;
+		iov = &masked_iov;
+		iovcnt = 1;
 	}
 
-	ret = websocket_prepare_and_send(ctx, header, hdr_len,
-					 data_to_send, payload_len, timeout);
+	ret = websocket_prepare_and_send(ctx, header, hdr_len, iov, iovcnt,
+					 timeout);
 	if (ret < 0) {
 		NET_DBG("Cannot send ws msg (%d)", -errno);
 		goto quit;
 	}
 
 quit:
-	if (data_to_send != payload) {
-		k_free(data_to_send);
-	}
+	k_free(masked);
 
 	return ret - hdr_len;
 }
 
+int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
+		       enum websocket_opcode opcode, bool mask, bool final,
+		       int32_t timeout)
+{
+	struct iovec iov = {
+		.iov_base = (void *)payload,
+		.iov_len = payload_len,
+	};
+
+	return websocket_send_msg_iov(ws_sock, &iov, 1, opcode, mask, final,
+				      timeout);
+}
+
 static bool websocket_parse_header(uint8_t *buf, size_t buf_len, bool *masked,
 				   uint32_t *mask_value, uint64_t *message_length,
 				   uint32_t *message_type_flag,
@@ -837,12 +906,9 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 		 * tell that.
 		 */
 		int mask_shift = (ctx->total_read - recv_len) % sizeof(uint32_t);
-		int i;
 
-		for (i = 0; i < recv_len; i++) {
-			buf[i] ^= ctx->masking_value >>
-				(8 * (3 - (i + mask_shift) % 4));
-		}
+		websocket_mask(buf, buf, recv_len, ctx->masking_value,
+			       mask_shift);
 	}
 
 #if HEXDUMP_RECV_PACKETS
@@ -133,6 +133,22 @@ int pm_device_state_set(const struct device *dev,
 			enum pm_device_state device_power_state,
 			pm_device_cb cb, void *arg)
 {
+	int rc;
+
+	if (z_device_deferred(dev)) {
+		/* The device is powered off until initialized, which brings
+		 * it up.
+		 */
+		if (device_power_state != PM_DEVICE_STATE_ACTIVE) {
+			return 0;
+		}
+
+		rc = device_init(dev);
+		if (rc != 0) {
+			return rc;
+		}
+	}
+
 	if (dev->pm_control == NULL) {
 		return -ENOSYS;
 	}
@@ -144,6 +160,11 @@ int pm_device_state_set(const struct device *dev,
 int pm_device_state_get(const struct device *dev,
 			enum pm_device_state *device_power_state)
 {
+	if (z_device_deferred(dev)) {
+		*device_power_state = PM_DEVICE_STATE_OFF;
+		return 0;
+	}
+
 	if (dev->pm_control == NULL) {
 		return -ENOSYS;
 	}
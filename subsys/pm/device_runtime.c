@@ -19,6 +19,56 @@ LOG_MODULE_DECLARE(power);
 #define PM_DEVICE_SYNC          BIT(0)
 #define PM_DEVICE_ASYNC         BIT(1)
 
+#ifdef CONFIG_PM_DEVICE_RUNTIME_PARALLEL
+
+#define PARALLEL_THREADS CONFIG_PM_DEVICE_RUNTIME_PARALLEL_THREADS
+
+static K_THREAD_STACK_ARRAY_DEFINE(pm_work_q_stacks, PARALLEL_THREADS,
+				   CONFIG_PM_DEVICE_RUNTIME_PARALLEL_STACK_SIZE);
+static struct k_work_q pm_work_qs[PARALLEL_THREADS];
+static bool pm_work_qs_started;
+
+/* The work of a device always goes to the same queue, so that it can be
+ * rescheduled.
+ */
+static struct k_work_q *pm_work_q_get(const struct device *dev)
+{
+	if (!pm_work_qs_started) {
+		return &k_sys_work_q;
+	}
+
+	return &pm_work_qs[device_handle_get(dev) % PARALLEL_THREADS];
+}
+
+static int pm_work_qs_init(const struct device *unused)
+{
+	ARG_UNUSED(unused);
+
+	for (int i = 0; i < PARALLEL_THREADS; i++) {
+		k_work_queue_start(&pm_work_qs[i], pm_work_q_stacks[i],
+				   K_THREAD_STACK_SIZEOF(pm_work_q_stacks[i]),
+				   CONFIG_SYSTEM_WORKQUEUE_PRIORITY, NULL);
+		k_thread_name_set(&pm_work_qs[i].thread, "pm_device");
+	}
+
+	pm_work_qs_started = true;
+
+	return 0;
+}
+
+SYS_INIT(pm_work_qs_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#else
+
+static struct k_work_q *pm_work_q_get(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return &k_sys_work_q;
+}
+
+#endif /* CONFIG_PM_DEVICE_RUNTIME_PARALLEL */
+
 static void device_pm_callback(const struct device *dev,
 			       int retval, enum pm_device_state *state, void *arg)
 {
@@ -97,6 +147,16 @@ static int pm_device_request(const struct device *dev,
 			(target_state == PM_DEVICE_STATE_SUSPEND),
 			"Invalid device PM state requested");
 
+	/* A deferred device is initialized on first use, its driver then
+	 * enables the runtime PM.
+	 */
+	if ((target_state == PM_DEVICE_STATE_ACTIVE) && z_device_deferred(dev)) {
+		ret = device_init(dev);
+		if (ret != 0) {
+			goto out;
+		}
+	}
+
 	if (k_is_pre_kernel()) {
 		if (target_state == PM_DEVICE_STATE_ACTIVE) {
 			dev->pm->usage++;
@@ -141,12 +201,24 @@ static int pm_device_request(const struct device *dev,
 	}
 
 
-	/* Return in case of Async request */
+	/* Return in case of Async request. The last release only suspends
+	 * the device after the autosuspend delay, a new usage in between
+	 * brings the request forward.
+	 */
 	if (pm_flags & PM_DEVICE_ASYNC) {
-		(void)k_work_schedule(&dev->pm->work, K_NO_WAIT);
+		(void)k_work_reschedule_for_queue(pm_work_q_get(dev),
+			&dev->pm->work,
+			((target_state == PM_DEVICE_STATE_SUSPEND) &&
+			 (dev->pm->usage == 0)) ?
+			dev->pm->autosuspend_delay : K_NO_WAIT);
 		goto out_unlock;
 	}
 
+	/* The state is set below, a pending request is not needed anymore,
+	 * in particular a suspend waiting for the autosuspend delay.
+	 */
+	(void)k_work_cancel_delayable(&dev->pm->work);
+
 	while ((k_work_delayable_is_pending(&dev->pm->work)) ||
 		(dev->pm->state == PM_DEVICE_STATE_SUSPENDING) ||
 		(dev->pm->state == PM_DEVICE_STATE_RESUMING)) {
@@ -223,7 +295,8 @@ void pm_device_enable(const struct device *dev)
 		dev->pm->state = PM_DEVICE_STATE_SUSPEND;
 		k_work_init_delayable(&dev->pm->work, pm_work_handler);
 	} else {
-		k_work_schedule(&dev->pm->work, K_NO_WAIT);
+		k_work_schedule_for_queue(pm_work_q_get(dev), &dev->pm->work,
+					  K_NO_WAIT);
 	}
 
 out_unlock:
@@ -242,7 +315,8 @@ void pm_device_disable(const struct device *dev)
 	if (dev->pm->enable) {
 		dev->pm->enable = false;
 		/* Bring up the device before disabling the Idle PM */
-		k_work_schedule(&dev->pm->work, K_NO_WAIT);
+		k_work_reschedule_for_queue(pm_work_q_get(dev),
+					    &dev->pm->work, K_NO_WAIT);
 	}
 	(void)k_mutex_unlock(&dev->pm->lock);
 	SYS_PORT_TRACING_FUNC_EXIT(pm, device_disable, dev);
@@ -266,3 +340,219 @@ int pm_device_wait(const struct device *dev, k_timeout_t timeout)
 
 	return ret;
 }
+
+void pm_device_autosuspend_delay_set(const struct device *dev,
+				     k_timeout_t delay)
+{
+	k_mutex_lock(&dev->pm->lock, K_FOREVER);
+	dev->pm->autosuspend_delay = delay;
+	k_mutex_unlock(&dev->pm->lock);
+}
+
+enum batch_status {
+	BATCH_PENDING,
+	BATCH_STARTED,
+	BATCH_DONE,
+};
+
+struct batch_item {
+	struct k_work work;
+	const struct device *dev;
+	uint32_t target_state;
+	enum batch_status status;
+	int ret;
+};
+
+/* Protects the status of the batch items, signalled when one is done. */
+static K_MUTEX_DEFINE(batch_lock);
+static K_CONDVAR_DEFINE(batch_done);
+
+static void batch_work_handler(struct k_work *work)
+{
+	struct batch_item *item = CONTAINER_OF(work, struct batch_item, work);
+	int ret;
+
+	ret = pm_device_request(item->dev, item->target_state, 0);
+
+	k_mutex_lock(&batch_lock, K_FOREVER);
+	item->ret = ret;
+	item->status = BATCH_DONE;
+	k_condvar_broadcast(&batch_done);
+	k_mutex_unlock(&batch_lock);
+}
+
+static void batch_submit(struct batch_item *item)
+{
+#ifdef CONFIG_PM_DEVICE_RUNTIME_PARALLEL
+	static atomic_t next_q;
+
+	if (pm_work_qs_started) {
+		(void)k_work_submit_to_queue(
+			&pm_work_qs[(uint32_t)atomic_inc(&next_q) %
+				    PARALLEL_THREADS],
+			&item->work);
+		return;
+	}
+#endif
+
+	batch_work_handler(&item->work);
+}
+
+static bool requires(const struct device *dev, const struct device *dep)
+{
+	const device_handle_t *handles;
+	device_handle_t handle = device_handle_get(dep);
+	size_t count = 0;
+
+	handles = device_required_handles_get(dev, &count);
+	for (size_t i = 0; i < count; i++) {
+		if (handles[i] == handle) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Whether an item waits for another one: a device is resumed after the
+ * devices it requires, and suspended before them.
+ */
+static bool batch_depends(const struct batch_item *item,
+			  const struct batch_item *other)
+{
+	if (item->target_state == PM_DEVICE_STATE_ACTIVE) {
+		return requires(item->dev, other->dev);
+	}
+
+	return requires(other->dev, item->dev);
+}
+
+/* Called with batch_lock held. Returns 0 if the item can be started, 1 if
+ * it must wait, a negative errno if an item it depends on failed.
+ */
+static int batch_item_ready(const struct batch_item *items, size_t count,
+			    size_t i)
+{
+	for (size_t j = 0; j < count; j++) {
+		if ((j == i) || !batch_depends(&items[i], &items[j])) {
+			continue;
+		}
+
+		if (items[j].status != BATCH_DONE) {
+			return 1;
+		}
+
+		if (items[j].ret != 0) {
+			return -EIO;
+		}
+	}
+
+	return 0;
+}
+
+static int batch_run(const struct device *const *devs, size_t count,
+		     uint32_t target_state)
+{
+	struct batch_item items[CONFIG_PM_DEVICE_RUNTIME_BATCH_MAX];
+#ifdef CONFIG_PM_DEVICE_RUNTIME_PARALLEL
+	struct k_work_sync sync;
+#endif
+	size_t finished;
+	int ret = 0;
+
+	if (count > ARRAY_SIZE(items)) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		k_work_init(&items[i].work, batch_work_handler);
+		items[i].dev = devs[i];
+		items[i].target_state = target_state;
+		items[i].status = BATCH_PENDING;
+		items[i].ret = 0;
+	}
+
+	k_mutex_lock(&batch_lock, K_FOREVER);
+	do {
+		bool progress = false;
+
+		finished = 0;
+		for (size_t i = 0; i < count; i++) {
+			int ready;
+
+			if (items[i].status == BATCH_DONE) {
+				finished++;
+				continue;
+			}
+
+			if (items[i].status != BATCH_PENDING) {
+				continue;
+			}
+
+			ready = batch_item_ready(items, count, i);
+			if (ready > 0) {
+				continue;
+			}
+
+			progress = true;
+			if (ready < 0) {
+				items[i].ret = -ECANCELED;
+				items[i].status = BATCH_DONE;
+				finished++;
+				continue;
+			}
+
+			items[i].status = BATCH_STARTED;
+			k_mutex_unlock(&batch_lock);
+			batch_submit(&items[i]);
+			k_mutex_lock(&batch_lock, K_FOREVER);
+		}
+
+		if (!progress && (finished < count)) {
+			k_condvar_wait(&batch_done, &batch_lock, K_FOREVER);
+		}
+	} while (finished < count);
+	k_mutex_unlock(&batch_lock);
+
+#ifdef CONFIG_PM_DEVICE_RUNTIME_PARALLEL
+	/* The work queues still hold the items until their handler
+	 * returned, which may be after they are marked done.
+	 */
+	for (size_t i = 0; i < count; i++) {
+		(void)k_work_flush(&items[i].work, &sync);
+	}
+#endif
+
+	for (size_t i = 0; i < count; i++) {
+		if ((items[i].ret != 0) && (items[i].ret != -ECANCELED)) {
+			ret = items[i].ret;
+			break;
+		}
+	}
+
+	/* Suspend back the devices resumed. */
+	if ((ret != 0) && (target_state == PM_DEVICE_STATE_ACTIVE)) {
+		const struct device *resumed[ARRAY_SIZE(items)];
+		size_t n = 0;
+
+		for (size_t i = 0; i < count; i++) {
+			if (items[i].ret == 0) {
+				resumed[n++] = items[i].dev;
+			}
+		}
+
+		(void)batch_run(resumed, n, PM_DEVICE_STATE_SUSPEND);
+	}
+
+	return ret;
+}
+
+int pm_device_get_many(const struct device *const *devs, size_t count)
+{
+	return batch_run(devs, count, PM_DEVICE_STATE_ACTIVE);
+}
+
+int pm_device_put_many(const struct device *const *devs, size_t count)
+{
+	return batch_run(devs, count, PM_DEVICE_STATE_SUSPEND);
+}
@@ -7,6 +7,7 @@
 #ifndef ZEPHYR_SUBSYS_PM_PRIV_H_
 #define ZEPHYR_SUBSYS_PM_PRIV_H_
 
+#include <sys/util.h>
 #include <pm/pm.h>
 
 #ifdef __cplusplus
@@ -33,6 +34,34 @@ int pm_force_suspend_devices(void);
  */
 void pm_resume_devices(void);
 
+#ifdef CONFIG_PM_POLICY_ADAPTIVE
+/**
+ * @brief Start measuring the residency in the state selected by the policy
+ *
+ * @return Start of the measure, to be given to pm_policy_residency_end().
+ */
+uint32_t pm_policy_residency_begin(void);
+
+/**
+ * @brief Account the residency in the state selected by the policy
+ *
+ * To be called on wake up, before the interrupts are unlocked.
+ *
+ * @param start Value returned by pm_policy_residency_begin().
+ */
+void pm_policy_residency_end(uint32_t start);
+#else
+static inline uint32_t pm_policy_residency_begin(void)
+{
+	return 0;
+}
+
+static inline void pm_policy_residency_end(uint32_t start)
+{
+	ARG_UNUSED(start);
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
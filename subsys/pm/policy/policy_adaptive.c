@@ -0,0 +1,402 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Adaptive PM policy.
+ *
+ * The duration of the idle period is predicted from the time to the next
+ * timeout, scaled by how long the periods of similar length actually
+ * lasted, and from the recent periods when they are regular. Interrupts
+ * other than the system timer end the periods early: the prediction lets
+ * the policy stay out of the states they would make unprofitable.
+ *
+ * The residency and the exit latency are measured in every state entered,
+ * with the system timer which keeps running in the low power states. The
+ * exit latency is how late the wake up is, past the timer expiry: it is
+ * only measured on the wake ups by the system timer, to the resolution of
+ * a tick.
+ */
+
+#include <zephyr.h>
+#include <kernel.h>
+#include <string.h>
+#include <spinlock.h>
+#include <sys/util.h>
+#include <pm/pm.h>
+#include <pm/policy.h>
+
+#include "../pm_priv.h"
+
+#define LOG_LEVEL CONFIG_PM_LOG_LEVEL /* From power module Kconfig */
+#include <logging/log.h>
+LOG_MODULE_DECLARE(power);
+
+/* Number of recent idle periods the regular pattern is looked for in. */
+#define INTERVALS 8
+
+/* Longest idle period accounted for, in microseconds, which keeps the
+ * variance of the recent periods within 64 bits.
+ */
+#define INTERVAL_MAX_US BIT(24)
+
+/* Correction factors, per decade of the time to the next timeout. */
+#define BUCKETS 6
+#define RESOLUTION 1024U
+#define DECAY 8U
+
+/* Histogram buckets: bucket 0 counts 0 us, bucket i [2^(i-1), 2^i) us,
+ * the last one everything above.
+ */
+#define HIST_BUCKETS 20
+
+struct state_stats {
+	/* Times the state was entered */
+	uint32_t entries;
+	/* Wake ups before the system timer expiry */
+	uint32_t early;
+	/* Total residency, in microseconds */
+	uint64_t residency_us;
+	/* Exit latency: running average and maximum, in microseconds */
+	uint32_t latency_avg_us;
+	uint32_t latency_max_us;
+	uint32_t residency_hist[HIST_BUCKETS];
+	uint32_t latency_hist[HIST_BUCKETS];
+};
+
+static const struct pm_state_info pm_states[] =
+	PM_STATE_INFO_DT_ITEMS_LIST(DT_NODELABEL(cpu0));
+
+static struct state_stats stats[ARRAY_SIZE(pm_states)];
+static struct k_spinlock stats_lock;
+
+static uint32_t intervals[INTERVALS];
+static uint32_t interval_idx;
+static uint32_t interval_count;
+
+static uint32_t correction[BUCKETS] = {
+	[0 ... BUCKETS - 1] = RESOLUTION * DECAY,
+};
+
+/* Selection being measured */
+static int cur_state = -1;
+static int cur_bucket;
+static uint32_t cur_next_us;
+
+static int bucket_get(uint32_t next_us)
+{
+	int bucket = 0;
+
+	for (uint32_t limit = 10U; bucket < BUCKETS - 1 && next_us >= limit;
+	     limit *= 10U) {
+		bucket++;
+	}
+
+	return bucket;
+}
+
+static int hist_bucket_get(uint32_t us)
+{
+	int bucket = (us == 0U) ? 0 : (32 - __builtin_clz(us));
+
+	return MIN(bucket, HIST_BUCKETS - 1);
+}
+
+/* Average of the recent idle periods, if they are regular enough: the
+ * longest are dropped as outliers while at least 3/4 of them are left.
+ */
+static uint32_t typical_interval_get(void)
+{
+	uint32_t thresh = UINT32_MAX;
+
+	if (interval_count < INTERVALS) {
+		return UINT32_MAX;
+	}
+
+	for (;;) {
+		uint64_t sum = 0U;
+		uint64_t variance = 0U;
+		uint64_t avg;
+		uint32_t max = 0U;
+		uint32_t n = 0U;
+
+		for (int i = 0; i < INTERVALS; i++) {
+			if (intervals[i] <= thresh) {
+				sum += intervals[i];
+				max = MAX(max, intervals[i]);
+				n++;
+			}
+		}
+
+		avg = sum / n;
+
+		for (int i = 0; i < INTERVALS; i++) {
+			if (intervals[i] <= thresh) {
+				int64_t diff = (int64_t)intervals[i] - avg;
+
+				variance += diff * diff;
+			}
+		}
+
+		variance /= n;
+
+		/* Regular when the standard deviation is within a sixth of
+		 * the average.
+		 */
+		if (36U * variance <= avg * avg) {
+			return (uint32_t)avg;
+		}
+
+		if ((n - 1U) * 4U < INTERVALS * 3U) {
+			return UINT32_MAX;
+		}
+
+		thresh = max - 1U;
+	}
+}
+
+struct pm_state_info pm_policy_next_state(int32_t ticks)
+{
+	uint32_t max_latency_us = pm_policy_latency_max_get();
+	uint32_t next_us, predicted_us;
+	int bucket;
+	int i;
+
+	if (ticks == K_TICKS_FOREVER) {
+		next_us = UINT32_MAX;
+		predicted_us = UINT32_MAX;
+		bucket = BUCKETS - 1;
+	} else {
+		next_us = k_ticks_to_us_floor32(ticks);
+		bucket = bucket_get(next_us);
+		predicted_us = ((uint64_t)next_us * correction[bucket]) /
+			       (RESOLUTION * DECAY);
+	}
+
+	predicted_us = MIN(predicted_us, typical_interval_get());
+
+	for (i = ARRAY_SIZE(pm_states) - 1; i >= 0; i--) {
+		uint32_t latency_us;
+
+		if (!pm_constraint_get(pm_states[i].state)) {
+			continue;
+		}
+
+		/* The latency requirements are met with the worst latency
+		 * seen, the residency with the usual one.
+		 */
+		latency_us = MAX(pm_states[i].exit_latency_us,
+				 stats[i].latency_max_us);
+		if (latency_us > max_latency_us) {
+			continue;
+		}
+
+		/* As the residency policy, with the time to the next timeout */
+		if ((ticks != K_TICKS_FOREVER) &&
+		    (ticks < (k_us_to_ticks_ceil32(
+				      pm_states[i].min_residency_us) +
+			      k_us_to_ticks_ceil32(
+				      pm_states[i].exit_latency_us)))) {
+			continue;
+		}
+
+		latency_us = MAX(pm_states[i].exit_latency_us,
+				 stats[i].latency_avg_us);
+
+		if ((uint64_t)predicted_us <
+		    (uint64_t)pm_states[i].min_residency_us + latency_us) {
+			continue;
+		}
+
+		LOG_DBG("Selected power state %d "
+			"(ticks: %d, predicted: %u us)",
+			pm_states[i].state, ticks, predicted_us);
+
+		cur_state = i;
+		cur_bucket = bucket;
+		cur_next_us = next_us;
+
+		return pm_states[i];
+	}
+
+	LOG_DBG("No suitable power state found!");
+	cur_state = -1;
+
+	return (struct pm_state_info){PM_STATE_ACTIVE, 0, 0};
+}
+
+uint32_t pm_policy_residency_begin(void)
+{
+	return k_cycle_get_32();
+}
+
+void pm_policy_residency_end(uint32_t start)
+{
+	const struct pm_state_info *info;
+	struct state_stats *st;
+	k_spinlock_key_t key;
+	uint32_t residency_us;
+	uint32_t expiry_us;
+
+	residency_us = (uint32_t)k_cyc_to_us_floor64(k_cycle_get_32() - start);
+
+	if (cur_state < 0) {
+		return;
+	}
+
+	info = &pm_states[cur_state];
+	st = &stats[cur_state];
+
+	key = k_spin_lock(&stats_lock);
+
+	st->entries++;
+	st->residency_us += residency_us;
+	st->residency_hist[hist_bucket_get(residency_us)]++;
+
+	if (cur_next_us == UINT32_MAX) {
+		st->early++;
+	} else {
+		/* The timer was set to expire early by the exit latency. */
+		expiry_us = cur_next_us - MIN(cur_next_us,
+			k_ticks_to_us_floor32(
+				k_us_to_ticks_ceil32(info->exit_latency_us)));
+
+		if (residency_us + k_ticks_to_us_ceil32(1) < expiry_us) {
+			st->early++;
+		} else {
+			uint32_t latency_us = (residency_us > expiry_us) ?
+					      (residency_us - expiry_us) : 0U;
+
+			st->latency_hist[hist_bucket_get(latency_us)]++;
+			st->latency_max_us = MAX(st->latency_max_us,
+						 latency_us);
+			st->latency_avg_us = (st->latency_avg_us * 7U +
+					      latency_us) / 8U;
+		}
+
+		/* Scale the next predictions by how long the period lasted,
+		 * compared to the time to the next timeout.
+		 */
+		correction[cur_bucket] -= correction[cur_bucket] / DECAY;
+		if (residency_us >= cur_next_us) {
+			correction[cur_bucket] += RESOLUTION;
+		} else {
+			correction[cur_bucket] += ((uint64_t)residency_us *
+						   RESOLUTION) / cur_next_us;
+		}
+	}
+
+	intervals[interval_idx] = MIN(residency_us, INTERVAL_MAX_US);
+	interval_idx = (interval_idx + 1U) % INTERVALS;
+	interval_count = MIN(interval_count + 1U, INTERVALS);
+
+	k_spin_unlock(&stats_lock, key);
+
+	cur_state = -1;
+}
+
+#ifdef CONFIG_PM_POLICY_ADAPTIVE_SHELL
+#include <shell/shell.h>
+
+static const char *const state_names[] = {
+	[PM_STATE_ACTIVE] = "active",
+	[PM_STATE_RUNTIME_IDLE] = "runtime-idle",
+	[PM_STATE_SUSPEND_TO_IDLE] = "suspend-to-idle",
+	[PM_STATE_STANDBY] = "standby",
+	[PM_STATE_SUSPEND_TO_RAM] = "suspend-to-ram",
+	[PM_STATE_SUSPEND_TO_DISK] = "suspend-to-disk",
+	[PM_STATE_SOFT_OFF] = "soft-off",
+};
+
+static void hist_print(const struct shell *shell, const char *name,
+		       const uint32_t *hist)
+{
+	shell_fprintf(shell, SHELL_NORMAL, "  %s:", name);
+
+	for (int i = 0; i < HIST_BUCKETS; i++) {
+		if (hist[i] == 0U) {
+			continue;
+		}
+
+		if (i == 0) {
+			shell_fprintf(shell, SHELL_NORMAL, " 0:%u", hist[i]);
+		} else if (i == HIST_BUCKETS - 1) {
+			shell_fprintf(shell, SHELL_NORMAL, " >=%lu:%u",
+				      BIT(i - 1), hist[i]);
+		} else {
+			shell_fprintf(shell, SHELL_NORMAL, " <%lu:%u",
+				      BIT(i), hist[i]);
+		}
+	}
+
+	shell_fprintf(shell, SHELL_NORMAL, "\n");
+}
+
+static int cmd_pm_policy_stats(const struct shell *shell, size_t argc,
+			       char **argv)
+{
+	struct state_stats st;
+	uint32_t max_latency_us = pm_policy_latency_max_get();
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	if (max_latency_us == UINT32_MAX) {
+		shell_print(shell, "latency requirement: none");
+	} else {
+		shell_print(shell, "latency requirement: %u us",
+			    max_latency_us);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(pm_states); i++) {
+		k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+		st = stats[i];
+		k_spin_unlock(&stats_lock, key);
+
+		shell_print(shell, "%s/%u: entries %u early %u "
+			    "residency avg %u us latency avg %u max %u "
+			    "(declared %u) us",
+			    state_names[pm_states[i].state],
+			    pm_states[i].substate_id, st.entries, st.early,
+			    (st.entries != 0U) ?
+			    (uint32_t)(st.residency_us / st.entries) : 0U,
+			    st.latency_avg_us, st.latency_max_us,
+			    pm_states[i].exit_latency_us);
+		hist_print(shell, "residency us", st.residency_hist);
+		hist_print(shell, "latency us", st.latency_hist);
+	}
+
+	return 0;
+}
+
+static int cmd_pm_policy_reset(const struct shell *shell, size_t argc,
+			       char **argv)
+{
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	memset(stats, 0, sizeof(stats));
+	k_spin_unlock(&stats_lock, key);
+
+	shell_print(shell, "Statistics reset");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_pm_policy,
+	SHELL_CMD(stats, NULL,
+		  "Print the residency and exit latency of every state",
+		  cmd_pm_policy_stats),
+	SHELL_CMD(reset, NULL, "Reset the statistics", cmd_pm_policy_reset),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+
+SHELL_CMD_REGISTER(pm_policy, &sub_pm_policy, "Adaptive PM policy commands",
+		   NULL);
+
+#endif /* CONFIG_PM_POLICY_ADAPTIVE_SHELL */
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <kernel.h>
+#include <spinlock.h>
+#include <sys/slist.h>
+#include <pm/policy.h>
+
+#define LOG_LEVEL CONFIG_PM_LOG_LEVEL /* From power module Kconfig */
+#include <logging/log.h>
+LOG_MODULE_DECLARE(power);
+
+static sys_slist_t latency_reqs = SYS_SLIST_STATIC_INIT(&latency_reqs);
+static struct k_spinlock latency_lock;
+
+/* Strictest requirement, updated when the requests change so that the
+ * policies read it from the idle thread at no cost.
+ */
+static uint32_t max_latency_us = UINT32_MAX;
+
+static void max_latency_update(void)
+{
+	struct pm_policy_latency_request *req;
+	uint32_t value_us = UINT32_MAX;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&latency_reqs, req, node) {
+		value_us = MIN(value_us, req->value_us);
+	}
+
+	max_latency_us = value_us;
+}
+
+void pm_policy_latency_request_add(struct pm_policy_latency_request *req,
+				   uint32_t value_us)
+{
+	k_spinlock_key_t key = k_spin_lock(&latency_lock);
+
+	req->value_us = value_us;
+	sys_slist_append(&latency_reqs, &req->node);
+	max_latency_update();
+
+	k_spin_unlock(&latency_lock, key);
+}
+
+void pm_policy_latency_request_update(struct pm_policy_latency_request *req,
+				      uint32_t value_us)
+{
+	k_spinlock_key_t key = k_spin_lock(&latency_lock);
+
+	req->value_us = value_us;
+	max_latency_update();
+
+	k_spin_unlock(&latency_lock, key);
+}
+
+void pm_policy_latency_request_remove(struct pm_policy_latency_request *req)
+{
+	k_spinlock_key_t key = k_spin_lock(&latency_lock);
+
+	if (!sys_slist_find_and_remove(&latency_reqs, &req->node)) {
+		LOG_WRN("Latency request %p was not added", req);
+	}
+	max_latency_update();
+
+	k_spin_unlock(&latency_lock, key);
+}
+
+uint32_t pm_policy_latency_max_get(void)
+{
+	return max_latency_us;
+}
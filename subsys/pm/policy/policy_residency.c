@@ -18,6 +18,7 @@ static const struct pm_state_info pm_min_residency[] =
 
 struct pm_state_info pm_policy_next_state(int32_t ticks)
 {
+	uint32_t max_latency_us = pm_policy_latency_max_get();
 	int i;
 
 	for (i = ARRAY_SIZE(pm_min_residency) - 1; i >= 0; i--) {
@@ -27,6 +28,10 @@ struct pm_state_info pm_policy_next_state(int32_t ticks)
 			continue;
 		}
 
+		if (pm_min_residency[i].exit_latency_us > max_latency_us) {
+			continue;
+		}
+
 		min_residency = k_us_to_ticks_ceil32(
 			    pm_min_residency[i].min_residency_us);
 		exit_latency = k_us_to_ticks_ceil32(
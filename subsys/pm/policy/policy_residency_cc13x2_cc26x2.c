@@ -59,6 +59,11 @@ struct pm_state_info pm_policy_next_state(int32_t ticks)
 			continue;
 		}
 
+		if (residency_info[i].exit_latency_us >
+		    pm_policy_latency_max_get()) {
+			continue;
+		}
+
 		if ((ticks <
 		     k_us_to_ticks_ceil32(residency_info[i].min_residency_us))
 		    && (ticks != K_TICKS_FOREVER)) {
@@ -177,6 +177,8 @@ static enum pm_state _handle_device_abort(struct pm_state_info info)
 
 enum pm_state pm_system_suspend(int32_t ticks)
 {
+	uint32_t residency_start;
+
 	SYS_PORT_TRACING_FUNC_ENTER(pm, system_suspend, ticks);
 	z_power_state = pm_policy_next_state(ticks);
 	if (z_power_state.state == PM_STATE_ACTIVE) {
@@ -247,7 +249,9 @@ enum pm_state pm_system_suspend(int32_t ticks)
 	pm_debug_start_timer();
 	/* Enter power state */
 	pm_state_notify(true);
+	residency_start = pm_policy_residency_begin();
 	pm_power_state_set(z_power_state);
+	pm_policy_residency_end(residency_start);
 	pm_debug_stop_timer();
 
 	/* Wake up sequence starts here */
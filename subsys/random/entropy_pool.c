@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <device.h>
+#include <drivers/entropy.h>
+#include <random/entropy_pool.h>
+#include <sys/ring_buffer.h>
+#include <string.h>
+
+#define REFILL_CHUNK 32
+
+RING_BUF_DECLARE(entropy_pool_buf, CONFIG_ENTROPY_POOL_SIZE);
+
+/* Protects the pool, which is read from any context. */
+static struct k_spinlock lock;
+
+/* Given when the pool falls below the threshold, and at startup. */
+static K_SEM_DEFINE(refill_sem, 1, 1);
+
+static uint32_t level_get(void)
+{
+	return ring_buf_capacity_get(&entropy_pool_buf) - ring_buf_space_get(&entropy_pool_buf);
+}
+
+int entropy_pool_get(uint8_t *dst, size_t len)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t level = level_get();
+	int ret = -EAGAIN;
+
+	if (len <= level) {
+		(void)ring_buf_get(&entropy_pool_buf, dst, len);
+		level -= len;
+		ret = 0;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (level < CONFIG_ENTROPY_POOL_REFILL_THRESHOLD) {
+		k_sem_give(&refill_sem);
+	}
+
+	return ret;
+}
+
+static void refill_thread(void *p1, void *p2, void *p3)
+{
+	const struct device *dev;
+	uint8_t buf[REFILL_CHUNK];
+	k_spinlock_key_t key;
+	uint32_t space;
+	int err;
+
+	dev = device_get_binding(DT_CHOSEN_ZEPHYR_ENTROPY_LABEL);
+	__ASSERT((dev != NULL),
+		"Device driver for %s (DT_CHOSEN_ZEPHYR_ENTROPY_LABEL) not found. "
+		"Check your build configuration!",
+		DT_CHOSEN_ZEPHYR_ENTROPY_LABEL);
+	if (dev == NULL) {
+		return;
+	}
+
+	while (true) {
+		k_sem_take(&refill_sem, K_FOREVER);
+
+		/* Fill the pool up, whatever its level: the driver is
+		 * called less often, with larger requests.
+		 */
+		do {
+			key = k_spin_lock(&lock);
+			space = ring_buf_space_get(&entropy_pool_buf);
+			k_spin_unlock(&lock, key);
+
+			if (space == 0) {
+				break;
+			}
+
+			space = MIN(space, sizeof(buf));
+			err = entropy_get_entropy(dev, buf, space);
+			if (err) {
+				break;
+			}
+
+			key = k_spin_lock(&lock);
+			(void)ring_buf_put(&entropy_pool_buf, buf, space);
+			k_spin_unlock(&lock, key);
+		} while (true);
+
+		(void)memset(buf, 0, sizeof(buf));
+	}
+}
+
+K_THREAD_DEFINE(entropy_pool_thread, CONFIG_ENTROPY_POOL_THREAD_STACK_SIZE,
+		refill_thread, NULL, NULL, NULL,
+		CONFIG_ENTROPY_POOL_THREAD_PRIORITY, 0, 0);
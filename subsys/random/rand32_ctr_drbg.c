@@ -8,6 +8,7 @@
 #include <device.h>
 #include <drivers/entropy.h>
 #include <kernel.h>
+#include <random/entropy_pool.h>
 #include <string.h>
 
 #if defined(CONFIG_MBEDTLS)
@@ -26,31 +27,59 @@
 
 #endif /* CONFIG_MBEDTLS */
 
-static K_SEM_DEFINE(state_sem, 1, 1);
-
 static const struct device *entropy_driver;
 static const unsigned char drbg_seed[] = CONFIG_CS_CTR_DRBG_PERSONALIZATION;
 
+/* One instance per CPU, so that the CPUs do not contend for a single lock.
+ * Both implementations update their key with fresh output at the end of
+ * every request, so a compromised state does not reveal the previous
+ * outputs.
+ */
+struct drbg {
+	struct k_spinlock lock;
+	bool seeded;
+	/* Requests served since the last (re)seed. */
+	uint32_t requests;
 #if defined(CONFIG_MBEDTLS)
+	mbedtls_ctr_drbg_context ctx;
+	/* Seed material, fetched before the lock is taken. */
+	const uint8_t *seed;
+	size_t seed_len;
+#elif defined(CONFIG_TINYCRYPT)
+	TCCtrPrng_t ctx;
+#endif
+};
+
+static struct drbg drbgs[CONFIG_MP_NUM_CPUS];
 
-static mbedtls_ctr_drbg_context ctr_ctx;
+#if defined(CONFIG_MBEDTLS)
+
+/* Entropy and nonce. */
+#define SEED_LEN (MBEDTLS_CTR_DRBG_ENTROPY_LEN + MBEDTLS_CTR_DRBG_ENTROPY_LEN / 2)
 
 static int ctr_drbg_entropy_func(void *ctx, unsigned char *buf, size_t len)
 {
-	return entropy_get_entropy(entropy_driver, (void *)buf, len);
+	struct drbg *drbg = ctx;
+
+	if (len > drbg->seed_len) {
+		return MBEDTLS_ERR_CTR_DRBG_ENTROPY_SOURCE_FAILED;
+	}
+
+	memcpy(buf, drbg->seed, len);
+	drbg->seed += len;
+	drbg->seed_len -= len;
+
+	return 0;
 }
 
 #elif defined(CONFIG_TINYCRYPT)
 
-static TCCtrPrng_t ctr_ctx;
+#define SEED_LEN (TC_AES_KEY_SIZE + TC_AES_BLOCK_SIZE)
 
 #endif /* CONFIG_MBEDTLS */
 
-
-static int ctr_drbg_initialize(void)
+static int entropy_driver_init(void)
 {
-	int ret;
-
 	/* Only one entropy device exists, so this is safe even
 	 * if the whole operation isn't atomic.
 	 */
@@ -63,36 +92,76 @@ static int ctr_drbg_initialize(void)
 		return -EINVAL;
 	}
 
-#if defined(CONFIG_MBEDTLS)
+	return 0;
+}
 
-	mbedtls_ctr_drbg_init(&ctr_ctx);
+/* Called without any lock held, the entropy device may block. */
+static int seed_get(uint8_t *buf, size_t len)
+{
+	int ret;
 
-	ret = mbedtls_ctr_drbg_seed(&ctr_ctx,
-				    ctr_drbg_entropy_func,
-				    NULL,
-				    drbg_seed,
-				    sizeof(drbg_seed));
+#if defined(CONFIG_ENTROPY_POOL)
+	if (entropy_pool_get(buf, len) == 0) {
+		return 0;
+	}
+#endif
 
-	if (ret != 0) {
-		mbedtls_ctr_drbg_free(&ctr_ctx);
-		return -EIO;
+	if (k_is_in_isr()) {
+		ret = entropy_get_entropy_isr(entropy_driver, buf, len,
+					      ENTROPY_BUSYWAIT);
+		return (ret == (int)len) ? 0 : -EIO;
 	}
 
-#elif defined(CONFIG_TINYCRYPT)
+	return entropy_get_entropy(entropy_driver, buf, len);
+}
+
+/* Called with the lock of the instance held. */
+static int ctr_drbg_seed(struct drbg *drbg, const uint8_t *seed, size_t len)
+{
+	int ret;
+
+#if defined(CONFIG_MBEDTLS)
+
+	drbg->seed = seed;
+	drbg->seed_len = len;
 
-	uint8_t entropy[TC_AES_KEY_SIZE + TC_AES_BLOCK_SIZE];
+	if (!drbg->seeded) {
+		mbedtls_ctr_drbg_init(&drbg->ctx);
+
+		ret = mbedtls_ctr_drbg_seed(&drbg->ctx,
+					    ctr_drbg_entropy_func,
+					    drbg,
+					    drbg_seed,
+					    sizeof(drbg_seed));
+		if (ret != 0) {
+			mbedtls_ctr_drbg_free(&drbg->ctx);
+		} else {
+			/* Reseeded here first, with seed material fetched
+			 * beforehand.
+			 */
+			mbedtls_ctr_drbg_set_reseed_interval(&drbg->ctx,
+				CONFIG_CS_CTR_DRBG_RESEED_INTERVAL);
+		}
+	} else {
+		ret = mbedtls_ctr_drbg_reseed(&drbg->ctx, NULL, 0);
+	}
+
+	drbg->seed = NULL;
+	drbg->seed_len = 0;
 
-	ret = entropy_get_entropy(entropy_driver, (void *)&entropy,
-				  sizeof(entropy));
 	if (ret != 0) {
 		return -EIO;
 	}
 
-	ret = tc_ctr_prng_init(&ctr_ctx,
-			       (uint8_t *)&entropy,
-			       sizeof(entropy),
-			       (uint8_t *)drbg_seed,
-			       sizeof(drbg_seed));
+#elif defined(CONFIG_TINYCRYPT)
+
+	if (!drbg->seeded) {
+		ret = tc_ctr_prng_init(&drbg->ctx, seed, len, drbg_seed,
+				       sizeof(drbg_seed));
+	} else {
+		ret = tc_ctr_prng_reseed(&drbg->ctx, seed, len, drbg_seed,
+					 sizeof(drbg_seed));
+	}
 
 	if (ret == TC_CRYPTO_FAIL) {
 		return -EIO;
@@ -100,60 +169,103 @@ static int ctr_drbg_initialize(void)
 
 #endif
 
+	drbg->seeded = true;
+	drbg->requests = 0;
+
 	return 0;
 }
 
-
-int z_impl_sys_csrand_get(void *dst, uint32_t outlen)
+/* Called with the lock of the instance held. */
+static int ctr_drbg_generate(struct drbg *drbg, void *dst, uint32_t outlen)
 {
 	int ret;
-	unsigned int key = irq_lock();
 
-	if (unlikely(!entropy_driver)) {
-		ret = ctr_drbg_initialize();
-		if (ret != 0) {
-			ret = -EIO;
-			goto end;
-		}
-	}
+	drbg->requests++;
 
 #if defined(CONFIG_MBEDTLS)
 
-	ret = mbedtls_ctr_drbg_random(&ctr_ctx, (unsigned char *)dst, outlen);
+	ret = mbedtls_ctr_drbg_random(&drbg->ctx, (unsigned char *)dst,
+				      outlen);
 
 #elif defined(CONFIG_TINYCRYPT)
 
-	uint8_t entropy[TC_AES_KEY_SIZE + TC_AES_BLOCK_SIZE];
-
-	ret = tc_ctr_prng_generate(&ctr_ctx, 0, 0, (uint8_t *)dst, outlen);
+	ret = tc_ctr_prng_generate(&drbg->ctx, 0, 0, (uint8_t *)dst, outlen);
 
 	if (ret == TC_CRYPTO_SUCCESS) {
 		ret = 0;
 	} else if (ret == TC_CTR_PRNG_RESEED_REQ) {
+		/* Reseed on the next request. */
+		drbg->requests = CONFIG_CS_CTR_DRBG_RESEED_INTERVAL;
+		ret = -EIO;
+	} else {
+		ret = -EIO;
+	}
+
+#endif
+
+	return ret;
+}
 
-		ret = entropy_get_entropy(entropy_driver,
-				    (void *)&entropy, sizeof(entropy));
+int z_impl_sys_csrand_get(void *dst, uint32_t outlen)
+{
+	uint8_t seed[SEED_LEN];
+	k_spinlock_key_t key;
+	struct drbg *drbg;
+	bool reseed;
+	int ret;
+
+	if (unlikely(!entropy_driver)) {
+		ret = entropy_driver_init();
 		if (ret != 0) {
-			ret = -EIO;
-			goto end;
+			return -EIO;
 		}
+	}
+
+	/* The thread may move to another CPU meanwhile, the instance is
+	 * still protected by its lock.
+	 */
+	drbg = &drbgs[arch_curr_cpu()->id];
 
-		ret = tc_ctr_prng_reseed(&ctr_ctx,
-					entropy,
-					sizeof(entropy),
-					drbg_seed,
-					sizeof(drbg_seed));
+	/* The seed is fetched without the lock, so whether a reseed is due
+	 * is checked again with the lock held. Another request may have
+	 * used up the reseed interval meanwhile: mbedtls would then reseed
+	 * on its own, without seed material.
+	 */
+	while (true) {
+		reseed = !drbg->seeded ||
+			 drbg->requests >= CONFIG_CS_CTR_DRBG_RESEED_INTERVAL;
+		if (reseed) {
+			ret = seed_get(seed, sizeof(seed));
+			if (ret != 0) {
+				return -EIO;
+			}
+		}
 
-		ret = tc_ctr_prng_generate(&ctr_ctx, 0, 0,
-					   (uint8_t *)dst, outlen);
+		key = k_spin_lock(&drbg->lock);
 
-		ret = (ret == TC_CRYPTO_SUCCESS) ? 0 : -EIO;
-	} else {
-		ret = -EIO;
+		if (reseed || (drbg->seeded && drbg->requests <
+			       CONFIG_CS_CTR_DRBG_RESEED_INTERVAL)) {
+			break;
+		}
+
+		k_spin_unlock(&drbg->lock, key);
 	}
-#endif
+
+	if (reseed) {
+		/* Reseeding again, if another request did it meanwhile, does
+		 * no harm.
+		 */
+		ret = ctr_drbg_seed(drbg, seed, sizeof(seed));
+		(void)memset(seed, 0, sizeof(seed));
+		if (ret != 0) {
+			goto end;
+		}
+	}
+
+	ret = ctr_drbg_generate(drbg, dst, outlen);
+
 end:
-	irq_unlock(key);
+	k_spin_unlock(&drbg->lock, key);
 
 	return ret;
 }
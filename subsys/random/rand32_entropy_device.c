@@ -7,6 +7,7 @@
 #include <sys/atomic.h>
 #include <kernel.h>
 #include <drivers/entropy.h>
+#include <random/entropy_pool.h>
 #include <string.h>
 
 static const struct device *entropy_driver;
@@ -30,6 +31,12 @@ uint32_t z_impl_sys_rand32_get(void)
 		entropy_driver = dev;
 	}
 
+#if defined(CONFIG_ENTROPY_POOL)
+	if (entropy_pool_get((uint8_t *)&random_num, sizeof(random_num)) == 0) {
+		return random_num;
+	}
+#endif
+
 	ret = entropy_get_entropy(dev, (uint8_t *)&random_num,
 				  sizeof(random_num));
 	if (unlikely(ret < 0)) {
@@ -64,6 +71,12 @@ static int rand_get(uint8_t *dst, size_t outlen, bool csrand)
 		entropy_driver = dev;
 	}
 
+#if defined(CONFIG_ENTROPY_POOL)
+	if (entropy_pool_get(dst, outlen) == 0) {
+		return 0;
+	}
+#endif
+
 	ret = entropy_get_entropy(dev, dst, outlen);
 
 	if (unlikely(ret < 0)) {
@@ -38,6 +38,13 @@ struct settings_nvs {
 	struct nvs_fs cf_nvs;
 	uint16_t last_name_id;
 	const char *flash_dev_name;
+#ifdef CONFIG_SETTINGS_NVS_NAME_INDEX
+	/* Hash of the first name segment of each name ID, 0 when the ID
+	 * is free. Only used once built by a load of all the name IDs.
+	 */
+	uint8_t name_index[CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE];
+	bool name_index_valid;
+#endif
 };
 
 /* register nvs to be a source of settings */
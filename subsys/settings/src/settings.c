@@ -189,6 +189,17 @@ struct settings_handler_static *settings_parse_and_lookup(const char *name,
 	return bestmatch;
 }
 
+/* Whether the handler is part of the values loaded with load_arg */
+static bool handler_is_loaded(const struct settings_handler_static *ch,
+			      const struct settings_load_arg *load_arg)
+{
+	if (!load_arg || load_arg->subtree) {
+		return true;
+	}
+
+	return load_arg->deferred == !!(ch->flags & SETTINGS_HANDLER_DEFERRED);
+}
+
 int settings_call_set_handler(const char *name,
 			      size_t len,
 			      settings_read_cb read_cb,
@@ -210,7 +221,7 @@ int settings_call_set_handler(const char *name,
 		struct settings_handler_static *ch;
 
 		ch = settings_parse_and_lookup(name, &name_key);
-		if (!ch) {
+		if (!ch || !handler_is_loaded(ch, load_arg)) {
 			return 0;
 		}
 
@@ -231,10 +242,17 @@ int settings_call_set_handler(const char *name,
 
 int settings_commit(void)
 {
-	return settings_commit_subtree(NULL);
+	int rc;
+	int rc2;
+
+	rc = settings_flush();
+	rc2 = settings_commit_subtree(NULL);
+
+	return rc ? rc : rc2;
 }
 
-int settings_commit_subtree(const char *subtree)
+static int commit_handlers(const char *subtree,
+			   const struct settings_load_arg *load_arg)
 {
 	int rc;
 	int rc2;
@@ -245,6 +263,9 @@ int settings_commit_subtree(const char *subtree)
 		if (subtree && !settings_name_steq(ch->name, subtree, NULL)) {
 			continue;
 		}
+		if (!handler_is_loaded(ch, load_arg)) {
+			continue;
+		}
 		if (ch->h_commit) {
 			rc2 = ch->h_commit();
 			if (!rc) {
@@ -259,6 +280,10 @@ int settings_commit_subtree(const char *subtree)
 		if (subtree && !settings_name_steq(ch->name, subtree, NULL)) {
 			continue;
 		}
+		if (!handler_is_loaded((struct settings_handler_static *)ch,
+				       load_arg)) {
+			continue;
+		}
 		if (ch->h_commit) {
 			rc2 = ch->h_commit();
 			if (!rc) {
@@ -270,3 +295,13 @@ int settings_commit_subtree(const char *subtree)
 
 	return rc;
 }
+
+int settings_commit_subtree(const char *subtree)
+{
+	return commit_handlers(subtree, NULL);
+}
+
+int settings_commit_loaded(const struct settings_load_arg *load_arg)
+{
+	return commit_handlers(load_arg->subtree, load_arg);
+}
@@ -7,6 +7,7 @@
 
 #include <errno.h>
 #include <string.h>
+#include <sys/fnv1a.h>
 
 #include "settings/settings.h"
 #include "settings/settings_nvs.h"
@@ -25,12 +26,23 @@ static int settings_nvs_load(struct settings_store *cs,
 			     const struct settings_load_arg *arg);
 static int settings_nvs_save(struct settings_store *cs, const char *name,
 			     const char *value, size_t val_len);
+static int settings_nvs_save_batch(struct settings_store *cs,
+				   const struct settings_batch_item *items,
+				   size_t count);
 
 static struct settings_store_itf settings_nvs_itf = {
 	.csi_load = settings_nvs_load,
 	.csi_save = settings_nvs_save,
+	.csi_save_batch = settings_nvs_save_batch,
 };
 
+/* NVS entries of a batch save, used with the settings lock held. Each item
+ * takes up to two entries, and the largest name ID one more.
+ */
+static struct nvs_batch_entry
+	settings_nvs_batch[2 * CONFIG_SETTINGS_NVS_BATCH_SIZE + 1];
+static uint16_t settings_nvs_batch_ids[CONFIG_SETTINGS_NVS_BATCH_SIZE];
+
 static ssize_t settings_nvs_read_fn(void *back_end, void *data, size_t len)
 {
 	struct settings_nvs_read_fn_arg *rd_fn_arg;
@@ -48,6 +60,81 @@ static ssize_t settings_nvs_read_fn(void *back_end, void *data, size_t len)
 	return rc;
 }
 
+#ifdef CONFIG_SETTINGS_NVS_NAME_INDEX
+/* FNV-1a hash of the first segment of a name, never 0 */
+static uint8_t settings_nvs_name_hash(const char *name)
+{
+	uint32_t hash = FNV1A_32_INIT;
+
+	for (; *name && (*name != SETTINGS_NAME_SEPARATOR) &&
+	       (*name != SETTINGS_NAME_END); name++) {
+		hash = fnv1a_32_byte(hash, (uint8_t)*name);
+	}
+
+	return (hash % 255U) + 1U;
+}
+
+/* Index entry of a name ID: 0 when the ID is free, the hash of the first
+ * name segment otherwise, or -1 when the index does not cover the ID.
+ */
+static int settings_nvs_index_get(struct settings_nvs *cf, uint16_t name_id)
+{
+	uint16_t pos = name_id - NVS_NAMECNT_ID - 1;
+
+	if (!cf->name_index_valid ||
+	    (pos >= CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE)) {
+		return -1;
+	}
+
+	return cf->name_index[pos];
+}
+
+/* Record the name of a name ID, NULL when it is freed */
+static void settings_nvs_index_set(struct settings_nvs *cf, uint16_t name_id,
+				   const char *name)
+{
+	uint16_t pos = name_id - NVS_NAMECNT_ID - 1;
+
+	if (pos < CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE) {
+		cf->name_index[pos] = name ? settings_nvs_name_hash(name) : 0U;
+	}
+}
+
+static void settings_nvs_index_validate(struct settings_nvs *cf)
+{
+	cf->name_index_valid = true;
+}
+
+static void settings_nvs_index_reset(struct settings_nvs *cf)
+{
+	cf->name_index_valid = false;
+}
+#else
+static inline uint8_t settings_nvs_name_hash(const char *name)
+{
+	return 0U;
+}
+
+static inline int settings_nvs_index_get(struct settings_nvs *cf,
+					 uint16_t name_id)
+{
+	return -1;
+}
+
+static inline void settings_nvs_index_set(struct settings_nvs *cf,
+					  uint16_t name_id, const char *name)
+{
+}
+
+static inline void settings_nvs_index_validate(struct settings_nvs *cf)
+{
+}
+
+static inline void settings_nvs_index_reset(struct settings_nvs *cf)
+{
+}
+#endif /* CONFIG_SETTINGS_NVS_NAME_INDEX */
+
 int settings_nvs_src(struct settings_nvs *cf)
 {
 	cf->cf_store.cs_itf = &settings_nvs_itf;
@@ -74,6 +161,13 @@ static int settings_nvs_load(struct settings_store *cs,
 	char buf;
 	ssize_t rc1, rc2;
 	uint16_t name_id = NVS_NAMECNT_ID;
+	bool all_read = true;
+	uint8_t hash = 0U;
+	int index;
+
+	if (arg && arg->subtree && arg->subtree[0]) {
+		hash = settings_nvs_name_hash(arg->subtree);
+	}
 
 	name_id = cf->last_name_id + 1;
 
@@ -84,6 +178,14 @@ static int settings_nvs_load(struct settings_store *cs,
 			break;
 		}
 
+		/* With the name index, only the name IDs which may hold an
+		 * item of the subtree are read.
+		 */
+		index = settings_nvs_index_get(cf, name_id);
+		if ((index == 0) || ((index > 0) && hash && (index != hash))) {
+			continue;
+		}
+
 		/* In the NVS backend, each setting item is stored in two NVS
 		 * entries one for the setting's name and one with the
 		 * setting's value.
@@ -93,6 +195,10 @@ static int settings_nvs_load(struct settings_store *cs,
 			       &buf, sizeof(buf));
 
 		if ((rc1 <= 0) && (rc2 <= 0)) {
+			if (rc1 != -ENOENT) {
+				all_read = false;
+			}
+			settings_nvs_index_set(cf, name_id, NULL);
 			continue;
 		}
 
@@ -109,11 +215,13 @@ static int settings_nvs_load(struct settings_store *cs,
 			}
 			nvs_delete(&cf->cf_nvs, name_id);
 			nvs_delete(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET);
+			settings_nvs_index_set(cf, name_id, NULL);
 			continue;
 		}
 
 		/* Found a name, this might not include a trailing \0 */
 		name[rc1] = '\0';
+		settings_nvs_index_set(cf, name_id, name);
 		read_fn_arg.fs = &cf->cf_nvs;
 		read_fn_arg.id = name_id + NVS_NAME_ID_OFFSET;
 
@@ -122,9 +230,16 @@ static int settings_nvs_load(struct settings_store *cs,
 			settings_nvs_read_fn, &read_fn_arg,
 			(void *)arg);
 		if (ret) {
+			all_read = false;
 			break;
 		}
 	}
+
+	/* The index is complete once all the name IDs have been read. */
+	if (all_read) {
+		settings_nvs_index_validate(cf);
+	}
+
 	return ret;
 }
 
@@ -135,12 +250,16 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 	char rdname[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
 	uint16_t name_id, write_name_id;
 	bool delete, write_name;
+	uint8_t hash;
+	int index;
 	int rc = 0;
 
 	if (!name) {
 		return -EINVAL;
 	}
 
+	hash = settings_nvs_name_hash(name);
+
 	/* Find out if we are doing a delete */
 	delete = ((value == NULL) || (val_len == 0));
 
@@ -154,6 +273,14 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 			break;
 		}
 
+		index = settings_nvs_index_get(cf, name_id);
+		if (index == 0) {
+			write_name_id = name_id;
+			continue;
+		} else if ((index > 0) && (index != hash)) {
+			continue;
+		}
+
 		rc = nvs_read(&cf->cf_nvs, name_id, &rdname, sizeof(rdname));
 
 		if (rc < 0) {
@@ -194,6 +321,7 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 				return rc;
 			}
 
+			settings_nvs_index_set(cf, name_id, NULL);
 			return 0;
 		}
 		write_name_id = name_id;
@@ -223,6 +351,8 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 		if (rc < 0) {
 			return rc;
 		}
+
+		settings_nvs_index_set(cf, write_name_id, name);
 	}
 
 	/* update the last_name_id and write to flash if required*/
@@ -239,6 +369,181 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 	return 0;
 }
 
+static bool settings_nvs_batch_has_id(const struct nvs_batch_entry *entries,
+				      size_t n, uint16_t id)
+{
+	for (size_t i = 0; i < n; i++) {
+		if (entries[i].id == id) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Find the name ID of a settings item in the NVS. When it is not found,
+ * name_id is set to the lowest free name ID, not taken by the entries of
+ * the batch either.
+ */
+static bool settings_nvs_batch_find(struct settings_nvs *cf, const char *name,
+				    const struct nvs_batch_entry *entries,
+				    size_t n, uint16_t last_name_id,
+				    uint16_t *name_id)
+{
+	char rdname[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	uint8_t hash = settings_nvs_name_hash(name);
+	uint16_t id;
+	ssize_t rc;
+	int index;
+
+	*name_id = last_name_id + 1;
+
+	for (id = last_name_id; id > NVS_NAMECNT_ID; id--) {
+		if (settings_nvs_batch_has_id(entries, n, id)) {
+			continue;
+		}
+
+		index = settings_nvs_index_get(cf, id);
+		if (index == 0) {
+			*name_id = id;
+			continue;
+		} else if ((index > 0) && (index != hash)) {
+			continue;
+		}
+
+		rc = nvs_read(&cf->cf_nvs, id, &rdname, sizeof(rdname));
+		if (rc < 0) {
+			/* Error or entry not found */
+			if (rc == -ENOENT) {
+				*name_id = id;
+			}
+			continue;
+		}
+
+		rdname[rc] = '\0';
+
+		if (!strcmp(name, rdname)) {
+			*name_id = id;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static int settings_nvs_save_batch(struct settings_store *cs,
+				   const struct settings_batch_item *items,
+				   size_t count)
+{
+	struct settings_nvs *cf = (struct settings_nvs *)cs;
+	struct nvs_batch_entry *entries = settings_nvs_batch;
+	uint16_t *ids = settings_nvs_batch_ids;
+	uint16_t last_name_id = cf->last_name_id;
+	uint16_t name_id;
+	bool delete, found;
+	size_t n = 0;
+	size_t i, j;
+	int rc;
+
+	if (count > CONFIG_SETTINGS_NVS_BATCH_SIZE) {
+		return -ENOMEM;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (!items[i].name) {
+			return -EINVAL;
+		}
+
+		delete = ((items[i].value == NULL) || (items[i].val_len == 0));
+
+		/* An item given twice keeps the name ID of its first save */
+		for (j = 0; j < i; j++) {
+			if (!strcmp(items[i].name, items[j].name)) {
+				break;
+			}
+		}
+
+		if ((j < i) && (ids[j] != NVS_NAMECNT_ID)) {
+			name_id = ids[j];
+			found = true;
+		} else {
+			found = settings_nvs_batch_find(cf, items[i].name,
+							entries, n,
+							last_name_id,
+							&name_id);
+		}
+
+		if (delete) {
+			ids[i] = NVS_NAMECNT_ID;
+
+			if (!found) {
+				continue;
+			}
+
+			if (name_id == last_name_id) {
+				last_name_id--;
+			}
+
+			entries[n++] = (struct nvs_batch_entry) {
+				.id = name_id,
+			};
+			entries[n++] = (struct nvs_batch_entry) {
+				.id = name_id + NVS_NAME_ID_OFFSET,
+			};
+			continue;
+		}
+
+		if (!found) {
+			/* No free IDs left. */
+			if (name_id == NVS_NAMECNT_ID + NVS_NAME_ID_OFFSET) {
+				return -ENOMEM;
+			}
+
+			entries[n++] = (struct nvs_batch_entry) {
+				.id = name_id,
+				.data = items[i].name,
+				.len = strlen(items[i].name),
+			};
+		}
+
+		ids[i] = name_id;
+		entries[n++] = (struct nvs_batch_entry) {
+			.id = name_id + NVS_NAME_ID_OFFSET,
+			.data = items[i].value,
+			.len = items[i].val_len,
+		};
+
+		if (name_id > last_name_id) {
+			last_name_id = name_id;
+		}
+	}
+
+	if (last_name_id != cf->last_name_id) {
+		entries[n++] = (struct nvs_batch_entry) {
+			.id = NVS_NAMECNT_ID,
+			.data = &last_name_id,
+			.len = sizeof(last_name_id),
+		};
+	}
+
+	rc = nvs_write_batch(&cf->cf_nvs, entries, n);
+	if (rc < 0) {
+		return rc;
+	}
+
+	for (i = 0; i < n; i++) {
+		if ((entries[i].id > NVS_NAMECNT_ID) &&
+		    (entries[i].id < NVS_NAMECNT_ID + NVS_NAME_ID_OFFSET)) {
+			settings_nvs_index_set(cf, entries[i].id,
+					       entries[i].data);
+		}
+	}
+
+	cf->last_name_id = last_name_id;
+
+	return 0;
+}
+
 /* Initialize the nvs backend. */
 int settings_nvs_backend_init(struct settings_nvs *cf)
 {
@@ -250,6 +555,8 @@ int settings_nvs_backend_init(struct settings_nvs *cf)
 		return rc;
 	}
 
+	settings_nvs_index_reset(cf);
+
 	rc = nvs_read(&cf->cf_nvs, NVS_NAMECNT_ID, &last_name_id,
 		      sizeof(last_name_id));
 	if (rc < 0) {
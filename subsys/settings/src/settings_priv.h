@@ -20,6 +20,22 @@ extern "C" {
 int settings_cli_register(void);
 int settings_nmgr_register(void);
 
+/* Write a batch to the destination store, with the settings lock held. */
+int settings_dst_save_batch(const struct settings_batch_item *items,
+			    size_t count);
+
+/* Commit the handlers whose values were loaded with load_arg. */
+int settings_commit_loaded(const struct settings_load_arg *load_arg);
+
+#ifdef CONFIG_SETTINGS_WRITEBACK
+/* Forget the deferred value of an item, with the settings lock held. */
+void settings_wb_drop(const char *name);
+#else
+static inline void settings_wb_drop(const char *name)
+{
+}
+#endif
+
 struct mgmt_cbuf;
 int settings_cbor_line(struct mgmt_cbuf *cb, char *name, int nlen, char *value,
 		       int vlen);
@@ -13,6 +13,7 @@
 #include <sys/types.h>
 #include <errno.h>
 #include <kernel.h>
+#include <debug/boot_profile.h>
 
 #include "settings/settings.h"
 #include "settings_priv.h"
@@ -34,18 +35,10 @@ void settings_dst_register(struct settings_store *cs)
 	settings_save_dst = cs;
 }
 
-int settings_load(void)
-{
-	return settings_load_subtree(NULL);
-}
-
-int settings_load_subtree(const char *subtree)
+static int load(const struct settings_load_arg *arg)
 {
 	struct settings_store *cs;
 	int rc;
-	const struct settings_load_arg arg = {
-		.subtree = subtree
-	};
 
 	/*
 	 * for every config store
@@ -54,14 +47,63 @@ int settings_load_subtree(const char *subtree)
 	 *    commit all
 	 */
 	k_mutex_lock(&settings_lock, K_FOREVER);
+	/* Deferred values are newer than the stored ones */
+	(void)settings_flush();
 	SYS_SLIST_FOR_EACH_CONTAINER(&settings_load_srcs, cs, cs_next) {
-		cs->cs_itf->csi_load(cs, &arg);
+		cs->cs_itf->csi_load(cs, arg);
 	}
-	rc = settings_commit_subtree(subtree);
+	rc = settings_commit_loaded(arg);
 	k_mutex_unlock(&settings_lock);
 	return rc;
 }
 
+#if defined(CONFIG_SETTINGS_DEFERRED_LOAD_BACKGROUND)
+static void deferred_load_handler(struct k_work *work)
+{
+	int rc;
+
+	rc = settings_load_deferred();
+	if (rc) {
+		LOG_ERR("deferred load failure (%d)", rc);
+	}
+}
+
+static K_WORK_DEFINE(deferred_load_work, deferred_load_handler);
+#endif
+
+int settings_load(void)
+{
+	timing_t start = boot_profile_begin();
+	int rc;
+
+	rc = settings_load_subtree(NULL);
+	boot_profile_end("settings_load", start);
+
+#if defined(CONFIG_SETTINGS_DEFERRED_LOAD_BACKGROUND)
+	k_work_submit(&deferred_load_work);
+#endif
+
+	return rc;
+}
+
+int settings_load_deferred(void)
+{
+	const struct settings_load_arg arg = {
+		.deferred = true
+	};
+
+	return load(&arg);
+}
+
+int settings_load_subtree(const char *subtree)
+{
+	const struct settings_load_arg arg = {
+		.subtree = subtree
+	};
+
+	return load(&arg);
+}
+
 int settings_load_subtree_direct(
 	const char             *subtree,
 	settings_load_direct_cb cb,
@@ -81,6 +123,7 @@ int settings_load_subtree_direct(
 	 *    commit all
 	 */
 	k_mutex_lock(&settings_lock, K_FOREVER);
+	(void)settings_flush();
 	SYS_SLIST_FOR_EACH_CONTAINER(&settings_load_srcs, cs, cs_next) {
 		cs->cs_itf->csi_load(cs, &arg);
 	}
@@ -103,6 +146,10 @@ int settings_save_one(const char *name, const void *value, size_t val_len)
 
 	k_mutex_lock(&settings_lock, K_FOREVER);
 
+	if (name) {
+		settings_wb_drop(name);
+	}
+
 	rc = cs->cs_itf->csi_save(cs, name, (char *)value, val_len);
 
 	k_mutex_unlock(&settings_lock);
@@ -110,6 +157,69 @@ int settings_save_one(const char *name, const void *value, size_t val_len)
 	return rc;
 }
 
+int settings_dst_save_batch(const struct settings_batch_item *items,
+			    size_t count)
+{
+	int rc = 0;
+	struct settings_store *cs;
+
+	cs = settings_save_dst;
+	if (!cs) {
+		return -ENOENT;
+	}
+
+	if (cs->cs_itf->csi_save_batch) {
+		rc = cs->cs_itf->csi_save_batch(cs, items, count);
+	} else {
+		for (size_t i = 0; i < count; i++) {
+			rc = cs->cs_itf->csi_save(cs, items[i].name,
+						  (char *)items[i].value,
+						  items[i].val_len);
+			if (rc) {
+				break;
+			}
+		}
+	}
+
+	return rc;
+}
+
+int settings_save_batch(const struct settings_batch_item *items, size_t count)
+{
+	int rc;
+
+	if (!settings_save_dst) {
+		return -ENOENT;
+	}
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	for (size_t i = 0; i < count; i++) {
+		if (items[i].name) {
+			settings_wb_drop(items[i].name);
+		}
+	}
+
+	rc = settings_dst_save_batch(items, count);
+
+	k_mutex_unlock(&settings_lock);
+
+	return rc;
+}
+
+#if !defined(CONFIG_SETTINGS_WRITEBACK)
+int settings_save_one_deferred(const char *name, const void *value,
+			       size_t val_len)
+{
+	return settings_save_one(name, value, val_len);
+}
+
+int settings_flush(void)
+{
+	return 0;
+}
+#endif /* !CONFIG_SETTINGS_WRITEBACK */
+
 int settings_delete(const char *name)
 {
 	return settings_save_one(name, NULL, 0);
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <kernel.h>
+
+#include "settings/settings.h"
+#include "settings_priv.h"
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(settings, CONFIG_SETTINGS_LOG_LEVEL);
+
+extern struct k_mutex settings_lock;
+
+/* Latest deferred value of a settings item, not written yet */
+struct settings_wb_entry {
+	char name[CONFIG_SETTINGS_WRITEBACK_NAME_LEN + 1];
+	uint8_t value[CONFIG_SETTINGS_WRITEBACK_VALUE_LEN];
+	size_t val_len;
+	bool pending;
+};
+
+static struct settings_wb_entry settings_wb[CONFIG_SETTINGS_WRITEBACK_ENTRIES];
+static struct settings_batch_item
+	settings_wb_items[CONFIG_SETTINGS_WRITEBACK_ENTRIES];
+
+static void settings_wb_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(settings_wb_work, settings_wb_handler);
+
+static struct settings_wb_entry *settings_wb_find(const char *name)
+{
+	for (int i = 0; i < ARRAY_SIZE(settings_wb); i++) {
+		if (settings_wb[i].pending && !strcmp(name, settings_wb[i].name)) {
+			return &settings_wb[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct settings_wb_entry *settings_wb_alloc(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(settings_wb); i++) {
+		if (!settings_wb[i].pending) {
+			return &settings_wb[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Write all the pending values in one batch, with the settings lock held.
+ * On failure the values are kept, to be written by the next flush.
+ */
+static int settings_wb_flush(void)
+{
+	size_t count = 0;
+	int rc;
+
+	for (int i = 0; i < ARRAY_SIZE(settings_wb); i++) {
+		if (!settings_wb[i].pending) {
+			continue;
+		}
+
+		settings_wb_items[count++] = (struct settings_batch_item) {
+			.name = settings_wb[i].name,
+			.value = settings_wb[i].val_len ?
+				 settings_wb[i].value : NULL,
+			.val_len = settings_wb[i].val_len,
+		};
+	}
+
+	if (count == 0) {
+		return 0;
+	}
+
+	rc = settings_dst_save_batch(settings_wb_items, count);
+	if (rc) {
+		LOG_ERR("Deferred save of %zu items failed (err %d)", count,
+			rc);
+		return rc;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(settings_wb); i++) {
+		settings_wb[i].pending = false;
+	}
+
+	return 0;
+}
+
+static void settings_wb_handler(struct k_work *work)
+{
+	int rc;
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+	rc = settings_wb_flush();
+	k_mutex_unlock(&settings_lock);
+
+	if (rc) {
+		k_work_schedule(&settings_wb_work,
+				K_MSEC(CONFIG_SETTINGS_WRITEBACK_DELAY));
+	}
+}
+
+int settings_save_one_deferred(const char *name, const void *value,
+			       size_t val_len)
+{
+	struct settings_wb_entry *entry;
+	int rc;
+
+	if (!name) {
+		return -EINVAL;
+	}
+
+	if (!value) {
+		val_len = 0;
+	}
+
+	if ((strlen(name) > CONFIG_SETTINGS_WRITEBACK_NAME_LEN) ||
+	    (val_len > CONFIG_SETTINGS_WRITEBACK_VALUE_LEN)) {
+		return settings_save_one(name, value, val_len);
+	}
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	entry = settings_wb_find(name);
+	if (!entry) {
+		entry = settings_wb_alloc();
+		if (!entry) {
+			/* All the entries are taken, make room for this one */
+			rc = settings_wb_flush();
+			if (rc) {
+				k_mutex_unlock(&settings_lock);
+				return rc;
+			}
+
+			entry = &settings_wb[0];
+		}
+
+		strcpy(entry->name, name);
+		entry->pending = true;
+	}
+
+	memcpy(entry->value, value, val_len);
+	entry->val_len = val_len;
+
+	/* The delay runs from the oldest pending value. */
+	k_work_schedule(&settings_wb_work,
+			K_MSEC(CONFIG_SETTINGS_WRITEBACK_DELAY));
+
+	k_mutex_unlock(&settings_lock);
+
+	return 0;
+}
+
+int settings_flush(void)
+{
+	int rc;
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+	rc = settings_wb_flush();
+	k_mutex_unlock(&settings_lock);
+
+	return rc;
+}
+
+void settings_wb_drop(const char *name)
+{
+	struct settings_wb_entry *entry;
+
+	entry = settings_wb_find(name);
+	if (entry) {
+		entry->pending = false;
+	}
+}
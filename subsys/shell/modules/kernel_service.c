@@ -114,6 +114,16 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 	} else {
 		shell_print(shell, "\tTotal execution cycles: ? (? %%)");
 	}
+
+#ifdef CONFIG_SCHED_LATENCY_STATS
+	if (ret == 0) {
+		shell_print(shell,
+			    "\tswitches: %u, preemptions: %u, max latency: %u",
+			    rt_stats_thread.switches,
+			    rt_stats_thread.preemptions,
+			    rt_stats_thread.latency.max);
+	}
+#endif
 #endif
 
 	ret = k_thread_stack_space_get(thread, &unused);
@@ -214,6 +224,114 @@ static int cmd_kernel_stacks(const struct shell *shell,
 }
 #endif
 
+#if defined(CONFIG_SYS_HEAP_RUNTIME_STATS)
+static int cmd_kernel_heaps(const struct shell *shell,
+			    size_t argc, char **argv)
+{
+	struct sys_heap_runtime_stats stats;
+	uint32_t buckets[32];
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	Z_STRUCT_SECTION_FOREACH(k_heap, h) {
+		k_spinlock_key_t key = k_spin_lock(&h->lock);
+		int nb = sys_heap_bucket_stats_get(&h->heap, buckets,
+						   ARRAY_SIZE(buckets));
+
+		(void)sys_heap_runtime_stats_get(&h->heap, &stats);
+		k_spin_unlock(&h->lock, key);
+
+		shell_print(shell,
+			    "%p free %zu allocated %zu max allocated %zu "
+			    "largest free %zu",
+			    h, stats.free_bytes, stats.allocated_bytes,
+			    stats.max_allocated_bytes, stats.largest_free_bytes);
+
+		shell_fprintf(shell, SHELL_NORMAL, "\tfree chunks per bucket:");
+		for (int i = 0; i < MIN(nb, ARRAY_SIZE(buckets)); i++) {
+			shell_fprintf(shell, SHELL_NORMAL, " %u", buckets[i]);
+		}
+		shell_fprintf(shell, SHELL_NORMAL, "\n");
+	}
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_SPIN_LOCK_STATS)
+static void shell_spinlock_cb(struct k_spinlock *l, void *user_data)
+{
+	const struct shell *shell = (const struct shell *)user_data;
+
+	/* Only read once, the lock may be in use as we print */
+	uint32_t contended = l->contended;
+	uint32_t spins = l->spins;
+
+	shell_print(shell, "%p contended %u spins %u (avg %u, max %u)",
+		    l, contended, spins, contended ? spins / contended : 0U,
+		    l->max_spins);
+}
+
+static int cmd_kernel_spinlocks(const struct shell *shell,
+				size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(shell, "Contended spinlocks:");
+	z_spin_stats_foreach(shell_spinlock_cb, (void *)shell);
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_SCHED_LATENCY_STATS)
+static void shell_latency_print(const struct shell *shell, const char *name,
+				const struct k_sched_latency_stats *stats)
+{
+	shell_fprintf(shell, SHELL_NORMAL, "%-8s max %10u:", name, stats->max);
+	for (int i = 0; i < CONFIG_SCHED_LATENCY_STATS_NUM_BINS; i++) {
+		shell_fprintf(shell, SHELL_NORMAL, " %u", stats->counts[i]);
+	}
+	shell_fprintf(shell, SHELL_NORMAL, "\n");
+}
+
+static int cmd_kernel_latency(const struct shell *shell,
+			      size_t argc, char **argv)
+{
+	struct k_sched_latency_stats stats;
+	k_thread_runtime_stats_t rt_stats_all;
+	char name[8];
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(shell, "Scheduling latency in cycles, bin n counts "
+		    "[2^n, 2^(n+1)):");
+
+	for (int prio = K_HIGHEST_THREAD_PRIO; prio <= K_LOWEST_THREAD_PRIO;
+	     prio++) {
+		/* Skip levels no thread was ever switched in at */
+		if (k_sched_latency_stats_get(prio, &stats) != 0 ||
+		    (stats.max == 0U && stats.counts[0] == 0U)) {
+			continue;
+		}
+
+		snprintk(name, sizeof(name), "%d", prio);
+		shell_latency_print(shell, name, &stats);
+	}
+
+	if (k_thread_runtime_stats_all_get(&rt_stats_all) == 0) {
+		shell_latency_print(shell, "all", &rt_stats_all.latency);
+		shell_print(shell, "switches: %u, preemptions: %u",
+			    rt_stats_all.switches, rt_stats_all.preemptions);
+	}
+
+	return 0;
+}
+#endif
+
 #if defined(CONFIG_REBOOT)
 static int cmd_kernel_reboot_warm(const struct shell *shell,
 				  size_t argc, char **argv)
@@ -248,9 +366,20 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_reboot,
 
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
 	SHELL_CMD(cycles, NULL, "Kernel cycles.", cmd_kernel_cycles),
+#if defined(CONFIG_SYS_HEAP_RUNTIME_STATS)
+	SHELL_CMD(heaps, NULL, "List k_heap usage.", cmd_kernel_heaps),
+#endif
+#if defined(CONFIG_SCHED_LATENCY_STATS)
+	SHELL_CMD(latency, NULL, "Scheduling latency histograms.",
+		  cmd_kernel_latency),
+#endif
 #if defined(CONFIG_REBOOT)
 	SHELL_CMD(reboot, &sub_kernel_reboot, "Reboot.", NULL),
 #endif
+#if defined(CONFIG_SPIN_LOCK_STATS)
+	SHELL_CMD(spinlocks, NULL, "List contended spinlocks.",
+		  cmd_kernel_spinlocks),
+#endif
 #if defined(CONFIG_INIT_STACKS) && defined(CONFIG_THREAD_STACK_INFO) && \
 		defined(CONFIG_THREAD_MONITOR)
 	SHELL_CMD(stacks, NULL, "List threads stack usage.", cmd_kernel_stacks),
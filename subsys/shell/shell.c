@@ -1325,6 +1325,8 @@ void shell_thread(void *shell_handle, void *arg_log_backend,
 					    shell_log_process);
 		}
 
+		z_shell_output_flush(shell);
+
 		k_mutex_unlock(&shell->ctx->wr_mtx);
 	}
 }
@@ -1398,6 +1400,7 @@ int shell_start(const struct shell *shell)
 
 	z_shell_raw_fprintf(shell->fprintf_ctx, "\n\n");
 	state_set(shell, SHELL_STATE_ACTIVE);
+	z_shell_output_flush(shell);
 
 	k_mutex_unlock(&shell->ctx->wr_mtx);
 
@@ -1442,6 +1445,8 @@ void shell_process(const struct shell *shell)
 		break;
 	}
 
+	z_shell_output_flush(shell);
+
 	/* atomically clear the processing flag */
 	z_flag_processing_set(shell, false);
 }
@@ -1474,7 +1479,15 @@ void shell_vfprintf(const struct shell *shell, enum shell_vt100_color color,
 	if (!z_flag_cmd_ctx_get(shell) && !shell->ctx->bypass) {
 		z_shell_print_prompt_and_cmd(shell);
 	}
-	z_transport_buffer_flush(shell);
+
+	/* The output of a command is flushed once it returns, unless
+	 * every print is flushed.
+	 */
+	if (!z_flag_cmd_ctx_get(shell)) {
+		z_shell_output_flush(shell);
+	} else if (IS_ENABLED(CONFIG_SHELL_PRINTF_AUTOFLUSH)) {
+		z_transport_buffer_flush(shell);
+	}
 	k_mutex_unlock(&shell->ctx->wr_mtx);
 }
 
@@ -1597,6 +1610,7 @@ int shell_execute_cmd(const struct shell *shell, const char *cmd)
 
 	k_mutex_lock(&shell->ctx->wr_mtx, K_FOREVER);
 	ret_val = execute(shell);
+	z_shell_output_flush(shell);
 	k_mutex_unlock(&shell->ctx->wr_mtx);
 
 	return ret_val;
@@ -23,6 +23,10 @@ static int out_func(int c, void *ctx)
 	sh_fprintf->buffer[sh_fprintf->ctrl_blk->buffer_cnt] = (uint8_t)c;
 	sh_fprintf->ctrl_blk->buffer_cnt++;
 
+	if (c == '\n') {
+		sh_fprintf->ctrl_blk->line_cnt++;
+	}
+
 	if (sh_fprintf->ctrl_blk->buffer_cnt == sh_fprintf->buffer_size) {
 		z_shell_fprintf_buffer_flush(sh_fprintf);
 	}
@@ -35,7 +39,10 @@ void z_shell_fprintf_fmt(const struct shell_fprintf *sh_fprintf,
 {
 	(void)cbvprintf(out_func, (void *)sh_fprintf, fmt, args);
 
-	if (sh_fprintf->ctrl_blk->autoflush) {
+	if (sh_fprintf->ctrl_blk->autoflush ||
+	    (CONFIG_SHELL_PRINTF_FLUSH_LINES > 0 &&
+	     sh_fprintf->ctrl_blk->line_cnt >=
+	     CONFIG_SHELL_PRINTF_FLUSH_LINES)) {
 		z_shell_fprintf_buffer_flush(sh_fprintf);
 	}
 }
@@ -46,4 +53,5 @@ void z_shell_fprintf_buffer_flush(const struct shell_fprintf *sh_fprintf)
 	sh_fprintf->fwrite(sh_fprintf->user_ctx, sh_fprintf->buffer,
 			   sh_fprintf->ctrl_blk->buffer_cnt);
 	sh_fprintf->ctrl_blk->buffer_cnt = 0;
+	sh_fprintf->ctrl_blk->line_cnt = 0;
 }
@@ -13,6 +13,13 @@ static bool process_msg2_from_buffer(const struct shell *shell);
 
 int z_shell_log_backend_output_func(uint8_t *data, size_t length, void *ctx)
 {
+	/* Prints still held in the print buffer, e.g. the erased command
+	 * line, go first.
+	 */
+	if (!IS_ENABLED(CONFIG_SHELL_PRINTF_AUTOFLUSH)) {
+		z_transport_buffer_flush((const struct shell *)ctx);
+	}
+
 	z_shell_print_stream(ctx, data, length);
 	return length;
 }
@@ -406,9 +406,11 @@ static int write(const struct shell_transport *transport,
 		lb->len += copy_len;
 
 		/* Send the data immediately if the buffer is full or line feed
-		 * is recognized.
+		 * is recognized, unless lines are coalesced until the shell
+		 * is idle.
 		 */
-		if (lb->buf[lb->len - 1] == '\n' ||
+		if ((lb->buf[lb->len - 1] == '\n' &&
+		     !IS_ENABLED(CONFIG_SHELL_TELNET_COALESCE)) ||
 		    lb->len == TELNET_LINE_SIZE) {
 			err = telnet_send();
 			if (err != 0) {
@@ -434,6 +436,17 @@ static int write(const struct shell_transport *transport,
 	return 0;
 }
 
+static void flush(const struct shell_transport *transport)
+{
+	if (sh_telnet == NULL || sh_telnet->line_out.len == 0) {
+		return;
+	}
+
+	k_work_cancel_delayable_sync(&sh_telnet->send_work,
+				     &sh_telnet->work_sync);
+	(void)telnet_send();
+}
+
 static int read(const struct shell_transport *transport,
 		void *data, size_t length, size_t *cnt)
 {
@@ -485,7 +498,8 @@ const struct shell_transport_api shell_telnet_transport_api = {
 	.uninit = uninit,
 	.enable = enable,
 	.write = write,
-	.read = read
+	.read = read,
+	.flush = IS_ENABLED(CONFIG_SHELL_TELNET_COALESCE) ? flush : NULL,
 };
 
 static int enable_shell_telnet(const struct device *arg)
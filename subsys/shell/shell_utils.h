@@ -88,6 +88,16 @@ static inline void z_transport_buffer_flush(const struct shell *shell)
 	z_shell_fprintf_buffer_flush(shell->fprintf_ctx);
 }
 
+/* End of a burst of output: the transport may send what it buffered. */
+static inline void z_shell_output_flush(const struct shell *shell)
+{
+	z_transport_buffer_flush(shell);
+
+	if (shell->iface->api->flush) {
+		shell->iface->api->flush(shell->iface);
+	}
+}
+
 static inline bool z_shell_in_select_mode(const struct shell *shell)
 {
 	return shell->ctx->selected_cmd == NULL ? false : true;
@@ -8,13 +8,19 @@
 #include <stdio.h>
 #include <errno.h>
 #include <zephyr/types.h>
+#include <sys/math_extras.h>
 #include <stats/stats.h>
 
 #define STATS_GEN_NAME_MAX_LEN  (sizeof("s255"))
 
+#define STATS_HIST_SUB_BITS CONFIG_STATS_HISTOGRAM_SUB_BUCKET_BITS
+
 /* The global list of registered statistic groups. */
 static struct stats_hdr *stats_list;
 
+static void stats_histogram_reset(struct stats_histogram *hist);
+static void stats_histogram_update(struct stats_histogram *hist);
+
 static const char *
 stats_get_name(const struct stats_hdr *hdr, int idx)
 {
@@ -100,6 +106,11 @@ stats_walk(struct stats_hdr *hdr, stats_walk_fn *walk_func, void *arg)
 	int rc;
 	int i;
 
+	/* The entries of a histogram are computed when they are read. */
+	if (hdr->s_flags & STATS_HDR_F_HISTOGRAM) {
+		stats_histogram_update((struct stats_histogram *)hdr);
+	}
+
 	for (i = 0; i < hdr->s_cnt; i++) {
 		name = stats_get_name(hdr, i);
 		if (name == NULL) {
@@ -281,4 +292,206 @@ void
 stats_reset(struct stats_hdr *hdr)
 {
 	(void)memset((uint8_t *)hdr + sizeof(*hdr), 0, hdr->s_size * hdr->s_cnt);
+
+	if (hdr->s_flags & STATS_HDR_F_HISTOGRAM) {
+		stats_histogram_reset((struct stats_histogram *)hdr);
+	}
+}
+
+#ifdef CONFIG_STATS_NAMES
+#define STATS_HIST_NAME(entry__, name__) \
+	{ offsetof(struct stats_histogram, summary.entry__), name__ }
+
+static const struct stats_name_map stats_histogram_map[] = {
+	STATS_HIST_NAME(count, "count"),
+	STATS_HIST_NAME(min, "min"),
+	STATS_HIST_NAME(max, "max"),
+	STATS_HIST_NAME(mean, "mean"),
+	STATS_HIST_NAME(p50, "p50"),
+	STATS_HIST_NAME(p90, "p90"),
+	STATS_HIST_NAME(p99, "p99"),
+	STATS_HIST_NAME(p999, "p99.9"),
+};
+#define STATS_HIST_MAP stats_histogram_map
+#define STATS_HIST_MAP_CNT ARRAY_SIZE(stats_histogram_map)
+#else
+#define STATS_HIST_MAP NULL
+#define STATS_HIST_MAP_CNT 0
+#endif
+
+/**
+ * Buckets are indexed by the most significant bit of the value, and by the
+ * STATS_HIST_SUB_BITS bits following it.  Values below 2^STATS_HIST_SUB_BITS
+ * have their own bucket.
+ */
+static uint32_t
+stats_histogram_index(uint32_t value)
+{
+	int shift;
+
+	if (value < STATS_HISTOGRAM_SUB_CNT) {
+		return value;
+	}
+
+	shift = 31 - u32_count_leading_zeros(value) - STATS_HIST_SUB_BITS;
+
+	return ((shift + 1) << STATS_HIST_SUB_BITS) +
+	       ((value >> shift) & (STATS_HISTOGRAM_SUB_CNT - 1));
+}
+
+static uint32_t
+stats_histogram_low(uint32_t idx)
+{
+	int shift;
+
+	if (idx < STATS_HISTOGRAM_SUB_CNT) {
+		return idx;
+	}
+
+	shift = (idx >> STATS_HIST_SUB_BITS) - 1;
+
+	return (STATS_HISTOGRAM_SUB_CNT + (idx & (STATS_HISTOGRAM_SUB_CNT - 1)))
+	       << shift;
+}
+
+static uint32_t
+stats_histogram_high(uint32_t idx)
+{
+	int shift;
+
+	if (idx < STATS_HISTOGRAM_SUB_CNT) {
+		return idx;
+	}
+
+	shift = (idx >> STATS_HIST_SUB_BITS) - 1;
+
+	return stats_histogram_low(idx) + ((1U << shift) - 1);
+}
+
+static void
+stats_histogram_reset(struct stats_histogram *hist)
+{
+	(void)memset(hist->buckets, 0,
+		     hist->bucket_cnt * sizeof(hist->buckets[0]));
+	hist->sum = 0;
+	hist->count = 0;
+	hist->min = UINT32_MAX;
+	hist->max = 0;
+}
+
+static void
+stats_histogram_update(struct stats_histogram *hist)
+{
+	stats_histogram_summary_get(hist, &hist->summary);
+}
+
+/**
+ * Initializes a histogram and registers it as a statistics group, whose
+ * 32-bit entries are the fields of its summary.
+ */
+int
+stats_histogram_init_and_reg(struct stats_histogram *hist, const char *name)
+{
+	hist->s_hdr.s_flags = STATS_HDR_F_HISTOGRAM;
+
+	return stats_init_and_reg(&hist->s_hdr, STATS_SIZE_32,
+				  sizeof(hist->summary) / STATS_SIZE_32,
+				  STATS_HIST_MAP, STATS_HIST_MAP_CNT, name);
+}
+
+void
+stats_histogram_record(struct stats_histogram *hist, uint32_t value)
+{
+	uint32_t idx = MIN(stats_histogram_index(value),
+			   hist->bucket_cnt - 1U);
+
+	hist->buckets[idx]++;
+	hist->count++;
+	hist->sum += value;
+
+	if (value < hist->min) {
+		hist->min = value;
+	}
+
+	if (value > hist->max) {
+		hist->max = value;
+	}
+}
+
+/**
+ * Finds the bucket holding the requested rank, and returns its highest value
+ * bounded by the extreme recorded values.  The last bucket also holds the
+ * values above the range of the histogram, its values are reported as the
+ * maximum.
+ */
+uint32_t
+stats_histogram_percentile(const struct stats_histogram *hist,
+			   uint16_t permille)
+{
+	uint64_t rank;
+	uint64_t cnt;
+	uint32_t i;
+
+	if (hist->count == 0) {
+		return 0;
+	}
+
+	rank = MAX(((uint64_t)hist->count * MIN(permille, 1000) + 999) / 1000, 1);
+	cnt = 0;
+	for (i = 0; i < hist->bucket_cnt - 1U; i++) {
+		cnt += hist->buckets[i];
+		if (cnt >= rank) {
+			return CLAMP(stats_histogram_high(i), hist->min, hist->max);
+		}
+	}
+
+	return hist->max;
+}
+
+void
+stats_histogram_summary_get(const struct stats_histogram *hist,
+			    struct stats_histogram_summary *summary)
+{
+	if (hist->count == 0) {
+		(void)memset(summary, 0, sizeof(*summary));
+		return;
+	}
+
+	summary->count = hist->count;
+	summary->min = hist->min;
+	summary->max = hist->max;
+	summary->mean = hist->sum / hist->count;
+	summary->p50 = stats_histogram_percentile(hist, 500);
+	summary->p90 = stats_histogram_percentile(hist, 900);
+	summary->p99 = stats_histogram_percentile(hist, 990);
+	summary->p999 = stats_histogram_percentile(hist, 999);
+}
+
+int
+stats_histogram_bucket_walk(struct stats_histogram *hist,
+			    stats_histogram_bucket_fn *walk_func, void *arg)
+{
+	uint32_t high;
+	uint32_t i;
+	int rc;
+
+	for (i = 0; i < hist->bucket_cnt; i++) {
+		if (hist->buckets[i] == 0) {
+			continue;
+		}
+
+		/* The last bucket extends up to the maximum. */
+		high = stats_histogram_high(i);
+		if (i == hist->bucket_cnt - 1U) {
+			high = MAX(high, hist->max);
+		}
+
+		rc = walk_func(hist, arg, stats_histogram_low(i), high,
+			       hist->buckets[i]);
+		if (rc != 0) {
+			return rc;
+		}
+	}
+
+	return 0;
 }
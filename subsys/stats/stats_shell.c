@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stats/stats.h>
+#include <shell/shell.h>
+
+static int group_print_name(struct stats_hdr *hdr, void *arg)
+{
+	const struct shell *shell = arg;
+
+	shell_print(shell, "%s%s", hdr->s_name,
+		    (hdr->s_flags & STATS_HDR_F_HISTOGRAM) ? " (histogram)" :
+							     "");
+
+	return 0;
+}
+
+static int entry_print(struct stats_hdr *hdr, void *arg, const char *name,
+		       uint16_t off)
+{
+	const struct shell *shell = arg;
+	const uint8_t *entry = (const uint8_t *)hdr + off;
+	uint64_t value;
+
+	switch (hdr->s_size) {
+	case STATS_SIZE_16:
+		value = *(const uint16_t *)entry;
+		break;
+	case STATS_SIZE_32:
+		value = *(const uint32_t *)entry;
+		break;
+	default:
+		value = *(const uint64_t *)entry;
+		break;
+	}
+
+	shell_print(shell, "  %s: %llu", name, (unsigned long long)value);
+
+	return 0;
+}
+
+static int group_print(struct stats_hdr *hdr, void *arg)
+{
+	const struct shell *shell = arg;
+
+	shell_print(shell, "%s:", hdr->s_name);
+
+	return stats_walk(hdr, entry_print, (void *)shell);
+}
+
+static struct stats_hdr *group_get(const struct shell *shell, const char *name)
+{
+	struct stats_hdr *hdr = stats_group_find(name);
+
+	if (hdr == NULL) {
+		shell_error(shell, "Unknown group %s", name);
+	}
+
+	return hdr;
+}
+
+static int cmd_stats_list(const struct shell *shell, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	return stats_group_walk(group_print_name, (void *)shell);
+}
+
+static int cmd_stats_show(const struct shell *shell, size_t argc, char **argv)
+{
+	struct stats_hdr *hdr;
+
+	if (argc < 2) {
+		return stats_group_walk(group_print, (void *)shell);
+	}
+
+	hdr = group_get(shell, argv[1]);
+	if (hdr == NULL) {
+		return -ENOENT;
+	}
+
+	return group_print(hdr, (void *)shell);
+}
+
+static int cmd_stats_reset(const struct shell *shell, size_t argc, char **argv)
+{
+	struct stats_hdr *hdr = group_get(shell, argv[1]);
+
+	if (hdr == NULL) {
+		return -ENOENT;
+	}
+
+	stats_reset(hdr);
+
+	return 0;
+}
+
+static int bucket_print(struct stats_histogram *hist, void *arg,
+			uint32_t low, uint32_t high, uint32_t cnt)
+{
+	const struct shell *shell = arg;
+
+	shell_print(shell, "  %u-%u: %u", low, high, cnt);
+
+	return 0;
+}
+
+static int cmd_stats_buckets(const struct shell *shell, size_t argc,
+			     char **argv)
+{
+	struct stats_hdr *hdr = group_get(shell, argv[1]);
+
+	if (hdr == NULL) {
+		return -ENOENT;
+	}
+
+	if (!(hdr->s_flags & STATS_HDR_F_HISTOGRAM)) {
+		shell_error(shell, "%s is not a histogram", argv[1]);
+		return -EINVAL;
+	}
+
+	shell_print(shell, "%s:", hdr->s_name);
+
+	return stats_histogram_bucket_walk((struct stats_histogram *)hdr,
+					   bucket_print, (void *)shell);
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_stats,
+	SHELL_CMD(list, NULL, "List the statistics groups", cmd_stats_list),
+	SHELL_CMD_ARG(show, NULL, "Show the statistics [group]",
+		      cmd_stats_show, 1, 1),
+	SHELL_CMD_ARG(reset, NULL, "Reset a statistics group <group>",
+		      cmd_stats_reset, 2, 0),
+	SHELL_CMD_ARG(buckets, NULL,
+		      "Show the non-empty buckets of a histogram <group>",
+		      cmd_stats_buckets, 2, 0),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+
+SHELL_CMD_REGISTER(stats, &sub_stats, "Statistics commands", NULL);
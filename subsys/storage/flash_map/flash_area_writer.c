@@ -0,0 +1,349 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <kernel.h>
+#include <init.h>
+#include <drivers/flash.h>
+#include <storage/flash_map.h>
+#include <storage/flash_area_writer.h>
+
+#define NO_PAGE UINT32_MAX
+
+static K_KERNEL_STACK_DEFINE(writer_stack, CONFIG_FLASH_AREA_WRITER_STACK_SIZE);
+static struct k_work_q writer_queue;
+
+static int page_info(struct flash_area_writer *w, uint32_t idx,
+		     struct flash_pages_info *info)
+{
+	int rc;
+
+	rc = flash_get_page_info_by_idx(w->fdev, w->first_page + idx, info);
+	if (rc == 0) {
+		/* Make the offset relative to the area */
+		info->start_offset -= w->fa->fa_off;
+	}
+
+	return rc;
+}
+
+static int erase_page(struct flash_area_writer *w, uint32_t idx)
+{
+	struct flash_pages_info info;
+	int rc;
+
+	rc = page_info(w, idx, &info);
+	if (rc == 0) {
+		rc = flash_area_erase(w->fa, info.start_offset, info.size);
+	}
+
+	return rc;
+}
+
+/* Keeps the pages following the one being filled erased, one page at a time
+ * so that the writes are not held back for long.
+ */
+static void erase_ahead(struct k_work *work)
+{
+	struct flash_area_writer *w =
+		CONTAINER_OF(work, struct flash_area_writer, work);
+	uint32_t idx;
+	int rc;
+
+	for (uint8_t i = 1U; i <= w->ahead; i++) {
+		k_mutex_lock(&w->lock, K_FOREVER);
+
+		if (w->cur_page == NO_PAGE ||
+		    w->cur_page + i >= w->page_count) {
+			k_mutex_unlock(&w->lock);
+			break;
+		}
+
+		idx = w->cur_page + i;
+		if (!atomic_test_bit(w->erased, idx)) {
+			rc = erase_page(w, idx);
+			if (rc < 0) {
+				w->erase_err = rc;
+				k_mutex_unlock(&w->lock);
+				break;
+			}
+
+			atomic_set_bit(w->erased, idx);
+		}
+
+		k_mutex_unlock(&w->lock);
+	}
+}
+
+int flash_area_writer_init(struct flash_area_writer *w,
+			   const struct flash_area *fa, atomic_t *erased,
+			   size_t max_pages, uint8_t ahead)
+{
+	struct flash_pages_info first, last;
+	const struct device *fdev;
+	int rc;
+
+	if (fa->fa_size == 0) {
+		return -EINVAL;
+	}
+
+	fdev = flash_area_get_device(fa);
+	if (!fdev) {
+		return -ENODEV;
+	}
+
+	rc = flash_get_page_info_by_offs(fdev, fa->fa_off, &first);
+	if (rc < 0) {
+		return rc;
+	}
+
+	rc = flash_get_page_info_by_offs(fdev, fa->fa_off + fa->fa_size - 1,
+					 &last);
+	if (rc < 0) {
+		return rc;
+	}
+
+	if (first.start_offset != fa->fa_off ||
+	    last.start_offset + last.size != fa->fa_off + fa->fa_size) {
+		return -EINVAL;
+	}
+
+	if (last.index - first.index + 1 > max_pages) {
+		return -ENOMEM;
+	}
+
+	w->fa = fa;
+	w->fdev = fdev;
+	w->erased = erased;
+	w->page_count = last.index - first.index + 1;
+	w->first_page = first.index;
+	w->cur_page = NO_PAGE;
+	w->offset = 0;
+	w->ahead = ahead;
+	w->erase_err = 0;
+
+	for (size_t i = 0; i < w->page_count; i++) {
+		atomic_clear_bit(erased, i);
+	}
+
+	k_mutex_init(&w->lock);
+	k_work_init(&w->work, erase_ahead);
+
+	return 0;
+}
+
+int flash_area_writer_scan(struct flash_area_writer *w)
+{
+	struct flash_pages_info info;
+	int rc = 0;
+
+	k_mutex_lock(&w->lock, K_FOREVER);
+
+	for (uint32_t i = 0; i < w->page_count; i++) {
+		if (i == w->cur_page || atomic_test_bit(w->erased, i)) {
+			continue;
+		}
+
+		rc = page_info(w, i, &info);
+		if (rc < 0) {
+			break;
+		}
+
+		rc = flash_area_is_erased(w->fa, info.start_offset, info.size);
+		if (rc < 0) {
+			break;
+		}
+
+		if (rc) {
+			atomic_set_bit(w->erased, i);
+		}
+
+		rc = 0;
+	}
+
+	k_mutex_unlock(&w->lock);
+
+	return rc;
+}
+
+int flash_area_writer_write(struct flash_area_writer *w, const void *data,
+			    size_t len)
+{
+	const uint8_t *src = data;
+	struct flash_pages_info info;
+	size_t chunk;
+	int rc = 0;
+
+	k_mutex_lock(&w->lock, K_FOREVER);
+
+	if (w->erase_err) {
+		rc = w->erase_err;
+		w->erase_err = 0;
+		goto out;
+	}
+
+	if (len > w->fa->fa_size - w->offset) {
+		rc = -ENOSPC;
+		goto out;
+	}
+
+	while (len > 0) {
+		rc = flash_get_page_info_by_offs(w->fdev,
+						 w->fa->fa_off + w->offset,
+						 &info);
+		if (rc < 0) {
+			break;
+		}
+
+		info.index -= w->first_page;
+		info.start_offset -= w->fa->fa_off;
+
+		if (info.index != w->cur_page) {
+			if (!atomic_test_and_clear_bit(w->erased, info.index)) {
+				rc = flash_area_erase(w->fa, info.start_offset,
+						      info.size);
+				if (rc < 0) {
+					break;
+				}
+			}
+
+			w->cur_page = info.index;
+
+			if (w->ahead) {
+				k_work_submit_to_queue(&writer_queue,
+						       &w->work);
+			}
+		}
+
+		chunk = MIN(len, info.start_offset + info.size - w->offset);
+
+		rc = flash_area_write(w->fa, w->offset, src, chunk);
+		if (rc < 0) {
+			break;
+		}
+
+		w->offset += chunk;
+		src += chunk;
+		len -= chunk;
+	}
+
+out:
+	k_mutex_unlock(&w->lock);
+
+	return rc;
+}
+
+int flash_area_writer_seek(struct flash_area_writer *w, off_t off)
+{
+	struct flash_pages_info info;
+	int rc;
+
+	if (off < 0 || off > w->fa->fa_size) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&w->lock, K_FOREVER);
+
+	w->offset = off;
+	w->cur_page = NO_PAGE;
+
+	if (off < w->fa->fa_size) {
+		rc = flash_get_page_info_by_offs(w->fdev, w->fa->fa_off + off,
+						 &info);
+		if (rc == 0 && info.start_offset != w->fa->fa_off + off) {
+			/* Writing in the middle of the page, keep its data */
+			w->cur_page = info.index - w->first_page;
+			atomic_clear_bit(w->erased, w->cur_page);
+		}
+	}
+
+	k_mutex_unlock(&w->lock);
+
+	return 0;
+}
+
+int flash_area_writer_erase(struct flash_area_writer *w, off_t off,
+			    size_t len)
+{
+	struct flash_pages_info info;
+	int rc = 0;
+
+	if (off < 0 || len > w->fa->fa_size - off) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&w->lock, K_FOREVER);
+
+	while (len > 0) {
+		rc = flash_get_page_info_by_offs(w->fdev, w->fa->fa_off + off,
+						 &info);
+		if (rc < 0) {
+			break;
+		}
+
+		info.index -= w->first_page;
+		info.start_offset -= w->fa->fa_off;
+
+		if (info.start_offset != off || info.size > len) {
+			rc = -EINVAL;
+			break;
+		}
+
+		if (!atomic_test_bit(w->erased, info.index)) {
+			rc = flash_area_erase(w->fa, off, info.size);
+			if (rc < 0) {
+				break;
+			}
+
+			atomic_set_bit(w->erased, info.index);
+		}
+
+		if (info.index == w->cur_page) {
+			w->cur_page = NO_PAGE;
+		}
+
+		off += info.size;
+		len -= info.size;
+	}
+
+	k_mutex_unlock(&w->lock);
+
+	return rc;
+}
+
+int flash_area_writer_sync(struct flash_area_writer *w)
+{
+	struct k_work_sync sync;
+	int rc;
+
+	(void)k_work_flush(&w->work, &sync);
+
+	k_mutex_lock(&w->lock, K_FOREVER);
+	rc = w->erase_err;
+	w->erase_err = 0;
+	k_mutex_unlock(&w->lock);
+
+	return rc;
+}
+
+static int flash_area_writer_queue_init(const struct device *dev)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "flash_area_writer",
+	};
+
+	ARG_UNUSED(dev);
+
+	k_work_queue_start(&writer_queue, writer_stack,
+			   K_KERNEL_STACK_SIZEOF(writer_stack),
+			   K_PRIO_PREEMPT(CONFIG_FLASH_AREA_WRITER_THREAD_PRIO),
+			   &cfg);
+
+	return 0;
+}
+
+SYS_INIT(flash_area_writer_queue_init, POST_KERNEL,
+	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -198,6 +198,20 @@ int flash_area_read(const struct flash_area *fa, off_t off, void *dst,
 	return flash_read(dev, fa->fa_off + off, dst, len);
 }
 
+int flash_area_mmap(const struct flash_area *fa, off_t off, size_t len,
+		    const void **addr)
+{
+	const struct device *dev;
+
+	if (!is_in_flash_area_bounds(fa, off, len)) {
+		return -EINVAL;
+	}
+
+	dev = device_get_binding(fa->fa_dev_name);
+
+	return flash_mmap(dev, fa->fa_off + off, len, addr);
+}
+
 int flash_area_write(const struct flash_area *fa, off_t off, const void *src,
 		     size_t len)
 {
@@ -263,6 +277,34 @@ uint8_t flash_area_erased_val(const struct flash_area *fa)
 	return param->erase_value;
 }
 
+int flash_area_is_erased(const struct flash_area *fa, off_t off, size_t len)
+{
+	uint8_t erased_val = flash_area_erased_val(fa);
+	uint8_t buf[32];
+	size_t chunk;
+	int rc;
+
+	while (len > 0) {
+		chunk = MIN(len, sizeof(buf));
+
+		rc = flash_area_read(fa, off, buf, chunk);
+		if (rc < 0) {
+			return rc;
+		}
+
+		for (size_t i = 0; i < chunk; i++) {
+			if (buf[i] != erased_val) {
+				return 0;
+			}
+		}
+
+		off += chunk;
+		len -= chunk;
+	}
+
+	return 1;
+}
+
 #if defined(CONFIG_FLASH_AREA_CHECK_INTEGRITY)
 int flash_area_check_int_sha256(const struct flash_area *fa,
 				const struct flash_area_check *fac)
@@ -12,6 +12,7 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME, CONFIG_STREAM_FLASH_LOG_LEVEL);
 
 #include <zephyr/types.h>
 #include <string.h>
+#include <init.h>
 #include <drivers/flash.h>
 
 #include <storage/stream_flash.h>
@@ -104,7 +105,9 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 
 #endif /* CONFIG_STREAM_FLASH_ERASE */
 
-static int flash_sync(struct stream_flash_ctx *ctx)
+/* Program buf_bytes of buf, right after the bytes already written */
+static int flash_program(struct stream_flash_ctx *ctx, uint8_t *buf,
+			 size_t buf_bytes)
 {
 	int rc = 0;
 	size_t write_addr = ctx->offset + ctx->bytes_written;
@@ -113,14 +116,14 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 	uint8_t filler;
 
 
-	if (ctx->buf_bytes == 0) {
+	if (buf_bytes == 0) {
 		return 0;
 	}
 
 	if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE)) {
 
 		rc = stream_flash_erase_page(ctx,
-					     write_addr + ctx->buf_bytes - 1);
+					     write_addr + buf_bytes - 1);
 		if (rc < 0) {
 			LOG_ERR("stream_flash_erase_page err %d offset=0x%08zx",
 				rc, write_addr);
@@ -129,17 +132,17 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 	}
 
 	fill_length = flash_get_write_block_size(ctx->fdev);
-	if (ctx->buf_bytes % fill_length) {
-		fill_length -= ctx->buf_bytes % fill_length;
+	if (buf_bytes % fill_length) {
+		fill_length -= buf_bytes % fill_length;
 		filler = flash_get_parameters(ctx->fdev)->erase_value;
 
-		memset(ctx->buf + ctx->buf_bytes, filler, fill_length);
+		memset(buf + buf_bytes, filler, fill_length);
 	} else {
 		fill_length = 0;
 	}
 
-	buf_bytes_aligned = ctx->buf_bytes + fill_length;
-	rc = flash_write(ctx->fdev, write_addr, ctx->buf, buf_bytes_aligned);
+	buf_bytes_aligned = buf_bytes + fill_length;
+	rc = flash_write(ctx->fdev, write_addr, buf, buf_bytes_aligned);
 
 	if (rc != 0) {
 		LOG_ERR("flash_write error %d offset=0x%08zx", rc,
@@ -151,30 +154,171 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 		/* Invert to ensure that caller is able to discover a faulty
 		 * flash_read() even if no error code is returned.
 		 */
-		for (int i = 0; i < ctx->buf_bytes; i++) {
-			ctx->buf[i] = ~ctx->buf[i];
+		for (int i = 0; i < buf_bytes; i++) {
+			buf[i] = ~buf[i];
 		}
 
-		rc = flash_read(ctx->fdev, write_addr, ctx->buf,
-				ctx->buf_bytes);
+		rc = flash_read(ctx->fdev, write_addr, buf, buf_bytes);
 		if (rc != 0) {
 			LOG_ERR("flash read failed: %d", rc);
 			return rc;
 		}
 
-		rc = ctx->callback(ctx->buf, ctx->buf_bytes, write_addr);
+		rc = ctx->callback(buf, buf_bytes, write_addr);
 		if (rc != 0) {
 			LOG_ERR("callback failed: %d", rc);
 			return rc;
 		}
 	}
 
-	ctx->bytes_written += ctx->buf_bytes;
+	ctx->bytes_written += buf_bytes;
+
+	return rc;
+}
+
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+
+static K_KERNEL_STACK_DEFINE(stream_flash_stack,
+			     CONFIG_STREAM_FLASH_ASYNC_STACK_SIZE);
+static struct k_work_q stream_flash_queue;
+
+static void stream_flash_work_handler(struct k_work *work)
+{
+	struct stream_flash_ctx *ctx =
+		CONTAINER_OF(work, struct stream_flash_ctx, work);
+	int rc;
+
+	rc = flash_program(ctx, ctx->wr_buf, ctx->wr_bytes);
+
+#ifdef CONFIG_STREAM_FLASH_ERASE
+	size_t next_end = ctx->bytes_written + ctx->buf_len;
+
+	/* Erase the page the next buffer ends in while it is filled. */
+	if (rc == 0 && next_end <= ctx->available) {
+		rc = stream_flash_erase_page(ctx, ctx->offset + next_end - 1);
+	}
+#endif
+
+	ctx->wr_err = rc;
+	k_sem_give(&ctx->idle);
+}
+
+/* Hand the filled buffer over to the work queue, once the previous one has
+ * been programmed, and go on with the other buffer.
+ */
+static int flash_sync_async(struct stream_flash_ctx *ctx)
+{
+	uint8_t *buf = ctx->buf;
+	int rc;
+
+	k_sem_take(&ctx->idle, K_FOREVER);
+
+	rc = ctx->wr_err;
+	if (rc != 0) {
+		k_sem_give(&ctx->idle);
+		return rc;
+	}
+
+	ctx->wr_buf = buf;
+	ctx->wr_bytes = ctx->buf_bytes;
+	ctx->bytes_queued += ctx->buf_bytes;
+
+	ctx->buf = ctx->alt_buf;
+	ctx->alt_buf = buf;
 	ctx->buf_bytes = 0U;
 
+	k_work_submit_to_queue(&stream_flash_queue, &ctx->work);
+
+	return 0;
+}
+
+static int flash_async_wait(struct stream_flash_ctx *ctx)
+{
+	int rc;
+
+	k_sem_take(&ctx->idle, K_FOREVER);
+	rc = ctx->wr_err;
+	k_sem_give(&ctx->idle);
+
 	return rc;
 }
 
+int stream_flash_async_enable(struct stream_flash_ctx *ctx)
+{
+	size_t half;
+
+	if (!ctx) {
+		return -EFAULT;
+	}
+
+	half = ctx->buf_len / 2;
+	if (half == 0 || half % flash_get_write_block_size(ctx->fdev)) {
+		LOG_ERR("Half buffer not aligned to minimal write-block-size");
+		return -EFAULT;
+	}
+
+	ctx->buf_len = half;
+	ctx->alt_buf = ctx->buf + half;
+	ctx->bytes_queued = ctx->bytes_written;
+	ctx->wr_err = 0;
+	k_work_init(&ctx->work, stream_flash_work_handler);
+	k_sem_init(&ctx->idle, 1, 1);
+	ctx->async = true;
+
+	return 0;
+}
+
+static int stream_flash_queue_init(const struct device *dev)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "stream_flash",
+	};
+
+	ARG_UNUSED(dev);
+
+	k_work_queue_start(&stream_flash_queue, stream_flash_stack,
+			   K_KERNEL_STACK_SIZEOF(stream_flash_stack),
+			   K_PRIO_PREEMPT(CONFIG_STREAM_FLASH_ASYNC_THREAD_PRIO),
+			   &cfg);
+
+	return 0;
+}
+
+SYS_INIT(stream_flash_queue_init, POST_KERNEL,
+	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#endif /* CONFIG_STREAM_FLASH_ASYNC */
+
+static int flash_sync(struct stream_flash_ctx *ctx)
+{
+	int rc;
+
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	if (ctx->async) {
+		return flash_sync_async(ctx);
+	}
+#endif
+
+	rc = flash_program(ctx, ctx->buf, ctx->buf_bytes);
+	if (rc == 0) {
+		ctx->buf_bytes = 0U;
+	}
+
+	return rc;
+}
+
+/* Bytes written or on their way to the flash */
+static size_t bytes_queued(struct stream_flash_ctx *ctx)
+{
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	if (ctx->async) {
+		return ctx->bytes_queued;
+	}
+#endif
+
+	return ctx->bytes_written;
+}
+
 int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *data,
 				size_t len, bool flush)
 {
@@ -186,7 +330,7 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		return -EFAULT;
 	}
 
-	if (ctx->bytes_written + ctx->buf_bytes + len > ctx->available) {
+	if (bytes_queued(ctx) + ctx->buf_bytes + len > ctx->available) {
 		return -ENOMEM;
 	}
 
@@ -216,6 +360,12 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		rc = flash_sync(ctx);
 	}
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	if (flush && rc == 0 && ctx->async) {
+		rc = flash_async_wait(ctx);
+	}
+#endif
+
 	return rc;
 }
 
@@ -299,6 +449,9 @@ int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 #ifdef CONFIG_STREAM_FLASH_ERASE
 	ctx->last_erased_page_start_offset = -1;
 #endif
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	ctx->async = false;
+#endif
 
 	return 0;
 }
@@ -321,6 +474,12 @@ int stream_flash_progress_load(struct stream_flash_ctx *ctx,
 			rc, settings_key);
 	}
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	if (ctx->async) {
+		ctx->bytes_queued = ctx->bytes_written;
+	}
+#endif
+
 	return rc;
 }
 
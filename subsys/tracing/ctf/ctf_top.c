@@ -8,6 +8,8 @@
 #include <kernel_structs.h>
 #include <kernel_internal.h>
 #include <ctf_top.h>
+#include <tracing_core.h>
+#include <sys/byteorder.h>
 
 
 static void _get_thread_name(struct k_thread *thread,
@@ -22,13 +24,104 @@ static void _get_thread_name(struct k_thread *thread,
 	}
 }
 
+#ifdef CONFIG_TRACING_CTF_COMPACT
+/* Largest time since the previous event a compact header can hold */
+#define CTF_COMPACT_TSTAMP_MAX (BIT(24) - 1)
+#define CTF_COMPACT_EXTENDED 0xFF
+
+static struct k_thread *ctf_threads[CONFIG_TRACING_CTF_COMPACT_THREADS];
+static uint32_t ctf_last_tstamp;
+static uint32_t ctf_drop_num;
+static bool ctf_synced;
+
+/* Returns true if the thread name has already been output */
+static bool _thread_interned(struct k_thread *thread)
+{
+	uint32_t idx = ((uintptr_t)thread >> 3) %
+		       CONFIG_TRACING_CTF_COMPACT_THREADS;
+
+	if (ctf_threads[idx] == thread) {
+		return true;
+	}
+
+	/* Only remember threads whose name can be output */
+	if (is_tracing_enabled()) {
+		ctf_threads[idx] = thread;
+	}
+
+	return false;
+}
+
+static void _get_event_thread_name(struct k_thread *thread,
+				   ctf_bounded_string_t *name)
+{
+	if (!_thread_interned(thread)) {
+		_get_thread_name(thread, name);
+		ctf_top_thread_name_set((uint32_t)(uintptr_t)thread, *name);
+	}
+}
+
+void ctf_top_compact_emit(uint8_t *epacket, uint32_t length)
+{
+	uint8_t header[2 + sizeof(uint32_t)];
+	struct tracing_data tracing_data[2];
+	uint32_t tstamp, drop_num;
+	uint8_t *cursor = header;
+	int key;
+
+	key = irq_lock();
+
+	/* The decoder deduces the upper timestamp bits from the previous
+	 * event it got, which must then be the previous one emitted here.
+	 */
+	if (!is_tracing_enabled()
+#ifdef CONFIG_TRACING_ASYNC
+	    || is_tracing_thread()
+#endif
+	    ) {
+		ctf_synced = false;
+		irq_unlock(key);
+		return;
+	}
+
+	tstamp = k_cyc_to_ns_floor64(k_cycle_get_32());
+	drop_num = tracing_packet_drop_num_get();
+
+	if (!ctf_synced || drop_num != ctf_drop_num ||
+	    tstamp - ctf_last_tstamp > CTF_COMPACT_TSTAMP_MAX) {
+		*cursor++ = CTF_COMPACT_EXTENDED;
+		*cursor++ = epacket[0];
+		sys_put_le32(tstamp, cursor);
+		cursor += sizeof(uint32_t);
+	} else {
+		*cursor++ = epacket[0];
+		sys_put_le24(tstamp, cursor);
+		cursor += 3;
+	}
+
+	ctf_last_tstamp = tstamp;
+	ctf_drop_num = drop_num;
+	ctf_synced = true;
+
+	tracing_data[0].data = header;
+	tracing_data[0].length = cursor - header;
+	tracing_data[1].data = &epacket[1];
+	tracing_data[1].length = length - 1;
+	tracing_format_data(tracing_data, ARRAY_SIZE(tracing_data));
+
+	irq_unlock(key);
+}
+#else
+#define _get_event_thread_name _get_thread_name
+#endif /* CONFIG_TRACING_CTF_COMPACT */
+
 void sys_trace_k_thread_switched_out(void)
 {
 	ctf_bounded_string_t name = { "unknown" };
 	struct k_thread *thread;
 
 	thread = k_current_get();
-	_get_thread_name(thread, &name);
+	_get_event_thread_name(thread, &name);
 
 	ctf_top_thread_switched_out((uint32_t)(uintptr_t)thread, name);
 }
@@ -39,7 +132,7 @@ void sys_trace_k_thread_switched_in(void)
 	ctf_bounded_string_t name = { "unknown" };
 
 	thread = k_current_get();
-	_get_thread_name(thread, &name);
+	_get_event_thread_name(thread, &name);
 
 	ctf_top_thread_switched_in((uint32_t)(uintptr_t)thread, name);
 }
@@ -48,7 +141,7 @@ void sys_trace_k_thread_priority_set(struct k_thread *thread)
 {
 	ctf_bounded_string_t name = { "unknown" };
 
-	_get_thread_name(thread, &name);
+	_get_event_thread_name(thread, &name);
 	ctf_top_thread_priority_set((uint32_t)(uintptr_t)thread,
 				    thread->base.prio, name);
 }
@@ -57,7 +150,7 @@ void sys_trace_k_thread_create(struct k_thread *thread, size_t stack_size, int p
 {
 	ctf_bounded_string_t name = { "unknown" };
 
-	_get_thread_name(thread, &name);
+	_get_event_thread_name(thread, &name);
 	ctf_top_thread_create(
 		(uint32_t)(uintptr_t)thread,
 		thread->base.prio,
@@ -65,6 +158,7 @@ void sys_trace_k_thread_create(struct k_thread *thread, size_t stack_size, int p
 		);
 
 #if defined(CONFIG_THREAD_STACK_INFO)
+	_get_thread_name(thread, &name);
 	ctf_top_thread_info(
 		(uint32_t)(uintptr_t)thread,
 		name,
@@ -78,7 +172,7 @@ void sys_trace_k_thread_abort(struct k_thread *thread)
 {
 	ctf_bounded_string_t name = { "unknown" };
 
-	_get_thread_name(thread, &name);
+	_get_event_thread_name(thread, &name);
 	ctf_top_thread_abort((uint32_t)(uintptr_t)thread, name);
 }
 
@@ -86,7 +180,7 @@ void sys_trace_k_thread_suspend(struct k_thread *thread)
 {
 	ctf_bounded_string_t name = { "unknown" };
 
-	_get_thread_name(thread, &name);
+	_get_event_thread_name(thread, &name);
 	ctf_top_thread_suspend((uint32_t)(uintptr_t)thread, name);
 }
 
@@ -94,7 +188,7 @@ void sys_trace_k_thread_resume(struct k_thread *thread)
 {
 	ctf_bounded_string_t name = { "unknown" };
 
-	_get_thread_name(thread, &name);
+	_get_event_thread_name(thread, &name);
 
 	ctf_top_thread_resume((uint32_t)(uintptr_t)thread, name);
 }
@@ -103,7 +197,7 @@ void sys_trace_k_thread_ready(struct k_thread *thread)
 {
 	ctf_bounded_string_t name = { "unknown" };
 
-	_get_thread_name(thread, &name);
+	_get_event_thread_name(thread, &name);
 
 	ctf_top_thread_ready((uint32_t)(uintptr_t)thread, name);
 }
@@ -117,7 +211,7 @@ void sys_trace_k_thread_pend(struct k_thread *thread)
 {
 	ctf_bounded_string_t name = { "unknown" };
 
-	_get_thread_name(thread, &name);
+	_get_event_thread_name(thread, &name);
 	ctf_top_thread_pend((uint32_t)(uintptr_t)thread, name);
 }
 
@@ -140,6 +234,9 @@ void sys_trace_k_thread_name_set(struct k_thread *thread, int ret)
 {
 	ctf_bounded_string_t name = { "unknown" };
 
+#ifdef CONFIG_TRACING_CTF_COMPACT
+	(void)_thread_interned(thread);
+#endif
 	_get_thread_name(thread, &name);
 	ctf_top_thread_name_set(
 		(uint32_t)(uintptr_t)thread,
@@ -295,3 +392,48 @@ void sys_trace_k_timer_status_sync_blocking(struct k_timer *timer)
 void sys_trace_k_timer_status_sync_exit(struct k_timer *timer, uint32_t result)
 {
 }
+
+/* Network */
+void sys_trace_net_pkt_rx_stage(struct net_pkt *pkt, int stage, uint32_t usec)
+{
+	ctf_top_net_pkt_rx_stage(
+		(uint32_t)(uintptr_t)pkt,
+		(uint8_t)stage,
+		usec
+		);
+}
+
+/* Profiler */
+void sys_trace_profiler_sample(void *thread, uintptr_t pc, uintptr_t lr,
+			       int irq)
+{
+	ctf_top_profiler_sample(
+		(uint32_t)(uintptr_t)thread,
+		(uint32_t)pc,
+		(uint32_t)lr,
+		(int16_t)irq
+		);
+}
+
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+/* Written straight to the backend by the tracing thread, ahead of the
+ * merged events recorded on another CPU than the previous ones.
+ */
+void tracing_cpu_id_handle(uint8_t cpu_id, uint32_t timestamp)
+{
+#ifdef CONFIG_TRACING_CTF_TIMESTAMP
+	const uint32_t tstamp = k_cyc_to_ns_floor64(timestamp);
+#endif
+	const uint8_t id = CTF_EVENT_CPU_ID;
+	uint8_t epacket[sizeof(uint32_t) + sizeof(id) + sizeof(cpu_id)];
+	uint8_t *epacket_cursor = &epacket[0];
+
+#ifdef CONFIG_TRACING_CTF_TIMESTAMP
+	CTF_INTERNAL_FIELD_APPEND(tstamp);
+#endif
+	CTF_INTERNAL_FIELD_APPEND(id);
+	CTF_INTERNAL_FIELD_APPEND(cpu_id);
+
+	tracing_buffer_handle(epacket, epacket_cursor - epacket);
+}
+#endif /* CONFIG_TRACING_BUFFER_PER_CPU */
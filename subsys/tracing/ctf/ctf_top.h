@@ -41,7 +41,20 @@
 		tracing_format_raw_data(epacket, sizeof(epacket));              \
 	}
 
-#ifdef CONFIG_TRACING_CTF_TIMESTAMP
+#if defined(CONFIG_TRACING_CTF_COMPACT)
+/*
+ * Gather the ID and fields to a contiguous event-packet, the header is added
+ * when emitting it.
+ */
+#define CTF_EVENT(...)                                                         \
+	{                                                                      \
+		uint8_t epacket[0 MAP(CTF_INTERNAL_FIELD_SIZE, __VA_ARGS__)];  \
+		uint8_t *epacket_cursor = &epacket[0];                         \
+									       \
+		MAP(CTF_INTERNAL_FIELD_APPEND, __VA_ARGS__)                    \
+		ctf_top_compact_emit(epacket, sizeof(epacket));                \
+	}
+#elif defined(CONFIG_TRACING_CTF_TIMESTAMP)
 #define CTF_EVENT(...)                                                         \
 	{                                                                      \
 		const uint32_t tstamp = k_cyc_to_ns_floor64(k_cycle_get_32()); \
@@ -55,6 +68,18 @@
 	}
 #endif
 
+/*
+ * Emit an event of the thread given by its ID. The thread name is left out
+ * with the compact encoding, where it is output once per thread instead.
+ */
+#ifdef CONFIG_TRACING_CTF_COMPACT
+#define CTF_THREAD_EVENT(id, thread_id, name, ...)                             \
+	CTF_EVENT(CTF_LITERAL(uint8_t, id), thread_id, ##__VA_ARGS__)
+#else
+#define CTF_THREAD_EVENT(id, thread_id, name, ...)                             \
+	CTF_EVENT(CTF_LITERAL(uint8_t, id), thread_id, name, ##__VA_ARGS__)
+#endif
+
 /* Anonymous compound literal with 1 member. Legal since C99.
  * This permits us to take the address of literals, like so:
  *  &CTF_LITERAL(int, 1234)
@@ -97,73 +122,75 @@ typedef enum {
 	CTF_EVENT_MUTEX_LOCK_EXIT = 0x2B,
 	CTF_EVENT_MUTEX_UNLOCK_ENTER = 0x2C,
 	CTF_EVENT_MUTEX_UNLOCK_EXIT = 0x2D,
+	CTF_EVENT_NET_PKT_RX_STAGE = 0x2E,
+	CTF_EVENT_CPU_ID = 0x2F,
+	CTF_EVENT_PROFILER_SAMPLE = 0x30,
 } ctf_event_t;
 
 typedef struct {
 	char buf[CTF_MAX_STRING_LEN];
 } ctf_bounded_string_t;
 
+#ifdef CONFIG_TRACING_CTF_COMPACT
+/*
+ * Emit an event-packet made of the event ID and fields, prefixed with a
+ * compact header.
+ */
+void ctf_top_compact_emit(uint8_t *epacket, uint32_t length);
+#endif
+
 static inline void ctf_top_thread_switched_out(uint32_t thread_id,
 					       ctf_bounded_string_t name)
 {
-	CTF_EVENT(CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_SWITCHED_OUT),
-		  thread_id, name);
+	CTF_THREAD_EVENT(CTF_EVENT_THREAD_SWITCHED_OUT, thread_id, name);
 }
 
 static inline void ctf_top_thread_switched_in(uint32_t thread_id,
 					      ctf_bounded_string_t name)
 {
-	CTF_EVENT(CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_SWITCHED_IN), thread_id,
-		  name);
+	CTF_THREAD_EVENT(CTF_EVENT_THREAD_SWITCHED_IN, thread_id, name);
 }
 
 static inline void ctf_top_thread_priority_set(uint32_t thread_id, int8_t prio,
 					       ctf_bounded_string_t name)
 {
-	CTF_EVENT(CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_PRIORITY_SET),
-		  thread_id, name, prio);
+	CTF_THREAD_EVENT(CTF_EVENT_THREAD_PRIORITY_SET, thread_id, name, prio);
 }
 
 static inline void ctf_top_thread_create(uint32_t thread_id, int8_t prio,
 					 ctf_bounded_string_t name)
 {
-	CTF_EVENT(CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_CREATE), thread_id,
-		  name);
+	CTF_THREAD_EVENT(CTF_EVENT_THREAD_CREATE, thread_id, name);
 }
 
 static inline void ctf_top_thread_abort(uint32_t thread_id,
 					ctf_bounded_string_t name)
 {
-	CTF_EVENT(CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_ABORT), thread_id,
-		  name);
+	CTF_THREAD_EVENT(CTF_EVENT_THREAD_ABORT, thread_id, name);
 }
 
 static inline void ctf_top_thread_suspend(uint32_t thread_id,
 					  ctf_bounded_string_t name)
 {
-	CTF_EVENT(CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_SUSPEND), thread_id,
-		  name);
+	CTF_THREAD_EVENT(CTF_EVENT_THREAD_SUSPEND, thread_id, name);
 }
 
 static inline void ctf_top_thread_resume(uint32_t thread_id,
 					 ctf_bounded_string_t name)
 {
-	CTF_EVENT(CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_RESUME), thread_id,
-		  name);
+	CTF_THREAD_EVENT(CTF_EVENT_THREAD_RESUME, thread_id, name);
 }
 
 static inline void ctf_top_thread_ready(uint32_t thread_id,
 					ctf_bounded_string_t name)
 {
-	CTF_EVENT(CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_READY), thread_id,
-		  name);
+	CTF_THREAD_EVENT(CTF_EVENT_THREAD_READY, thread_id, name);
 }
 
 static inline void ctf_top_thread_pend(uint32_t thread_id,
 				       ctf_bounded_string_t name)
 {
-	CTF_EVENT(CTF_LITERAL(uint8_t, CTF_EVENT_THREAD_PENDING), thread_id,
-		  name);
+	CTF_THREAD_EVENT(CTF_EVENT_THREAD_PENDING, thread_id, name);
 }
 
 static inline void ctf_top_thread_info(uint32_t thread_id,
@@ -290,4 +317,20 @@ static inline void ctf_top_mutex_unlock_exit(uint32_t mutex_id, int32_t ret)
 	CTF_EVENT(CTF_LITERAL(uint8_t, CTF_EVENT_MUTEX_UNLOCK_EXIT), mutex_id);
 }
 
+/* Network */
+static inline void ctf_top_net_pkt_rx_stage(uint32_t pkt_id, uint8_t stage,
+					    uint32_t usec)
+{
+	CTF_EVENT(CTF_LITERAL(uint8_t, CTF_EVENT_NET_PKT_RX_STAGE), pkt_id,
+		  stage, usec);
+}
+
+/* Profiler */
+static inline void ctf_top_profiler_sample(uint32_t thread_id, uint32_t pc,
+					   uint32_t lr, int16_t irq)
+{
+	CTF_EVENT(CTF_LITERAL(uint8_t, CTF_EVENT_PROFILER_SAMPLE), thread_id,
+		  pc, lr, irq);
+}
+
 #endif /* SUBSYS_DEBUG_TRACING_CTF_TOP_H */
@@ -66,6 +66,7 @@ extern "C" {
 #define sys_port_trace_k_thread_sched_abort(thread)
 #define sys_port_trace_k_thread_sched_priority_set(thread, prio)
 #define sys_port_trace_k_thread_sched_ready(thread)
+#define sys_port_trace_k_thread_sched_latency(thread, cycles)
 
 #define sys_port_trace_k_thread_sched_pend(thread)
 
@@ -191,6 +192,9 @@ extern "C" {
 #define sys_port_trace_k_queue_get_enter(queue, timeout)
 #define sys_port_trace_k_queue_get_blocking(queue, timeout)
 #define sys_port_trace_k_queue_get_exit(queue, timeout, ret)
+#define sys_port_trace_k_queue_get_batch_enter(queue, max, timeout)
+#define sys_port_trace_k_queue_get_batch_blocking(queue, max, timeout)
+#define sys_port_trace_k_queue_get_batch_exit(queue, max, timeout, ret)
 #define sys_port_trace_k_queue_remove_enter(queue)
 #define sys_port_trace_k_queue_remove_exit(queue, ret)
 #define sys_port_trace_k_queue_unique_append_enter(queue)
@@ -212,6 +216,8 @@ extern "C" {
 #define sys_port_trace_k_fifo_put_slist_exit(fifo, list)
 #define sys_port_trace_k_fifo_get_enter(fifo, timeout)
 #define sys_port_trace_k_fifo_get_exit(fifo, timeout, ret)
+#define sys_port_trace_k_fifo_get_batch_enter(fifo, list, max, timeout)
+#define sys_port_trace_k_fifo_get_batch_exit(fifo, list, max, timeout, ret)
 #define sys_port_trace_k_fifo_peek_head_enter(fifo)
 #define sys_port_trace_k_fifo_peek_head_exit(fifo, ret)
 #define sys_port_trace_k_fifo_peek_tail_enter(fifo)
@@ -225,6 +231,8 @@ extern "C" {
 #define sys_port_trace_k_lifo_alloc_put_exit(lifo, data, ret)
 #define sys_port_trace_k_lifo_get_enter(lifo, timeout)
 #define sys_port_trace_k_lifo_get_exit(lifo, timeout, ret)
+#define sys_port_trace_k_lifo_get_batch_enter(lifo, list, max, timeout)
+#define sys_port_trace_k_lifo_get_batch_exit(lifo, list, max, timeout, ret)
 
 #define sys_port_trace_k_stack_init(stack)
 #define sys_port_trace_k_stack_alloc_init_enter(stack)
@@ -325,6 +333,12 @@ extern "C" {
 #define sys_port_trace_pm_device_disable_enter(dev)
 #define sys_port_trace_pm_device_disable_exit(dev)
 
+#define sys_port_trace_net_pkt_rx_stage(pkt, stage, usec)                      \
+	sys_trace_net_pkt_rx_stage(pkt, stage, usec)
+
+#define sys_port_trace_profiler_sample(thread, pc, lr, irq)                    \
+	sys_trace_profiler_sample(thread, pc, lr, irq)
+
 void sys_trace_syscall_enter(void);
 void sys_trace_syscall_exit(void);
 void sys_trace_idle(void);
@@ -412,6 +426,11 @@ void sys_trace_k_timer_stop(struct k_timer *timer);
 void sys_trace_k_timer_status_sync_blocking(struct k_timer *timer);
 void sys_trace_k_timer_status_sync_exit(struct k_timer *timer, uint32_t result);
 
+struct net_pkt;
+void sys_trace_net_pkt_rx_stage(struct net_pkt *pkt, int stage, uint32_t usec);
+
+void sys_trace_profiler_sample(void *thread, uintptr_t pc, uintptr_t lr,
+			       int irq);
 
 #ifdef __cplusplus
 }
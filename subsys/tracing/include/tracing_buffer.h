@@ -9,6 +9,7 @@
 
 #include <stdbool.h>
 #include <zephyr/types.h>
+#include <tracing/tracing_format.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -113,6 +114,58 @@ uint32_t tracing_buffer_get(uint8_t *data, uint32_t size);
  */
 uint32_t tracing_cmd_buffer_alloc(uint8_t **data);
 
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+/**
+ * @brief Record a packet in the tracing buffer of the current CPU.
+ *
+ * The packet is gathered from the given data array and recorded along
+ * with a timestamp, without taking any lock shared with other CPUs.
+ *
+ * @param tracing_data_array Data array making up the packet.
+ * @param count Data array count.
+ * @param before_put_is_empty Set to true if the buffer of the current CPU
+ *                            was empty before this put.
+ *
+ * @return true if the packet has been recorded.
+ */
+bool tracing_buffer_cpu_put(tracing_data_t *tracing_data_array,
+			    uint32_t count, bool *before_put_is_empty);
+
+/**
+ * @brief Get the oldest packet recorded by any CPU.
+ *
+ * @param data Pointer to the address. It's set to the packet start.
+ * @param cpu_id Set to the ID of the CPU the packet was recorded on.
+ * @param timestamp Set to the cycle count the packet was recorded at.
+ *
+ * @return Packet length, 0 if all the tracing buffers are empty.
+ */
+uint32_t tracing_buffer_merge_claim(uint8_t **data, uint8_t *cpu_id,
+				    uint32_t *timestamp);
+
+/**
+ * @brief Release the packet returned by tracing_buffer_merge_claim().
+ */
+void tracing_buffer_merge_finish(void);
+
+/**
+ * @brief Check if the tracing buffers of all CPUs are empty.
+ *
+ * @return true if all the tracing buffers are empty.
+ */
+bool tracing_buffer_merge_is_empty(void);
+
+/**
+ * @brief Freeze or unfreeze recording in the tracing buffers.
+ *
+ * Once frozen, nothing more is recorded and the packets being recorded
+ * have been completed.
+ *
+ * @param freeze true to freeze recording, false to resume it.
+ */
+void tracing_buffer_freeze(bool freeze);
+#endif /* CONFIG_TRACING_BUFFER_PER_CPU */
+
 #ifdef __cplusplus
 }
 #endif
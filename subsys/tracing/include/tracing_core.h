@@ -38,6 +38,13 @@ void tracing_buffer_handle(uint8_t *data, uint32_t length);
  */
 void tracing_packet_drop_handle(void);
 
+/**
+ * @brief Get the number of tracing packets dropped so far.
+ *
+ * @return Number of dropped tracing packets.
+ */
+uint32_t tracing_packet_drop_num_get(void);
+
 /**
  * @brief Handle tracing command.
  *
@@ -60,6 +67,17 @@ void tracing_trigger_output(bool before_put_is_empty);
  */
 bool is_tracing_thread(void);
 
+/**
+ * @brief Handle a change of the CPU the merged tracing packets come from.
+ *
+ * Provided by the tracing format when per-CPU tracing buffers are enabled,
+ * to output the CPU ID ahead of the packets recorded on that CPU.
+ *
+ * @param cpu_id ID of the CPU the following packets were recorded on.
+ * @param timestamp Cycle count the next packet was recorded at.
+ */
+void tracing_cpu_id_handle(uint8_t cpu_id, uint32_t timestamp);
+
 #ifdef __cplusplus
 }
 #endif
@@ -33,6 +33,19 @@ typedef struct {
  */
 bool tracing_format_string_put(const char *str, va_list args);
 
+/**
+ * @brief Format a string tracing message into a buffer.
+ *
+ * @param buf   Output buffer.
+ * @param size  Output buffer size, the message is truncated to it.
+ * @param str   String to format.
+ * @param args  Variable parameters.
+ *
+ * @return Length of the formatted message.
+ */
+uint32_t tracing_format_string_copy(uint8_t *buf, uint32_t size,
+				    const char *str, va_list args);
+
 /**
  * @brief Put raw data format tracing message to tracing buffer.
  *
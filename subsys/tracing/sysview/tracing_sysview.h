@@ -154,7 +154,10 @@ extern "C" {
 #define TID_PM_DEVICE_REQUEST (125u + TID_OFFSET)
 #define TID_PM_DEVICE_ENABLE (126u + TID_OFFSET)
 #define TID_PM_DEVICE_DISABLE (127u + TID_OFFSET)
-/* latest ID is 127 */
+
+#define TID_NET_PKT_RX_STAGE (128u + TID_OFFSET)
+#define TID_PROFILER_SAMPLE (129u + TID_OFFSET)
+/* latest ID is 129 */
 
 void sys_trace_thread_info(struct k_thread *thread);
 
@@ -257,6 +260,8 @@ void sys_trace_thread_info(struct k_thread *thread);
 #define sys_port_trace_k_thread_sched_ready(thread)                                                \
 	SEGGER_SYSVIEW_OnTaskStartReady((uint32_t)(uintptr_t)thread)
 
+#define sys_port_trace_k_thread_sched_latency(thread, cycles)
+
 #define sys_port_trace_k_thread_sched_pend(thread)                                                 \
 	SEGGER_SYSVIEW_OnTaskStopReady((uint32_t)(uintptr_t)thread, 3 << 3)
 
@@ -525,6 +530,10 @@ void sys_trace_thread_info(struct k_thread *thread);
 #define sys_port_trace_k_queue_get_exit(queue, timeout, data)                                      \
 	SEGGER_SYSVIEW_RecordEndCall(TID_QUEUE_GET)
 
+#define sys_port_trace_k_queue_get_batch_enter(queue, max, timeout)
+#define sys_port_trace_k_queue_get_batch_blocking(queue, max, timeout)
+#define sys_port_trace_k_queue_get_batch_exit(queue, max, timeout, ret)
+
 #define sys_port_trace_k_queue_remove_enter(queue)                                                 \
 	SEGGER_SYSVIEW_RecordU32(TID_QUEUE_REMOVE, (uint32_t)(uintptr_t)queue)
 
@@ -580,6 +589,9 @@ void sys_trace_thread_info(struct k_thread *thread);
 #define sys_port_trace_k_fifo_get_exit(fifo, timeout, ret)                                         \
 	SEGGER_SYSVIEW_RecordEndCall(TID_FIFO_GET)
 
+#define sys_port_trace_k_fifo_get_batch_enter(fifo, list, max, timeout)
+#define sys_port_trace_k_fifo_get_batch_exit(fifo, list, max, timeout, ret)
+
 #define sys_port_trace_k_fifo_peek_head_enter(fifo)                                                \
 	SEGGER_SYSVIEW_RecordU32(TID_FIFO_PEAK_HEAD, (uint32_t)(uintptr_t)fifo)
 
@@ -612,6 +624,8 @@ void sys_trace_thread_info(struct k_thread *thread);
 	SEGGER_SYSVIEW_RecordU32x2(TID_LIFO_GET, (uint32_t)(uintptr_t)lifo, (uint32_t)timeout.ticks)
 #define sys_port_trace_k_lifo_get_exit(lifo, timeout, ret)                                         \
 	SEGGER_SYSVIEW_RecordEndCall(TID_LIFO_GET)
+#define sys_port_trace_k_lifo_get_batch_enter(lifo, list, max, timeout)
+#define sys_port_trace_k_lifo_get_batch_exit(lifo, list, max, timeout, ret)
 
 #define sys_port_trace_k_stack_init(stack)
 #define sys_port_trace_k_stack_alloc_init_enter(stack)
@@ -768,6 +782,14 @@ void sys_trace_k_thread_info(struct k_thread *thread);
 #define sys_port_trace_pm_device_disable_exit(dev) \
 	SEGGER_SYSVIEW_RecordEndCall(TID_PM_DEVICE_DISABLE)
 
+#define sys_port_trace_net_pkt_rx_stage(pkt, stage, usec)                                          \
+	SEGGER_SYSVIEW_RecordU32x3(TID_NET_PKT_RX_STAGE, (uint32_t)(uintptr_t)pkt,                 \
+				   (uint32_t)stage, (uint32_t)usec)
+
+#define sys_port_trace_profiler_sample(thread, pc, lr, irq)                                        \
+	SEGGER_SYSVIEW_RecordU32x4(TID_PROFILER_SAMPLE, (uint32_t)(uintptr_t)thread,               \
+				   (uint32_t)pc, (uint32_t)lr, (uint32_t)irq)
+
 
 #ifdef __cplusplus
 }
@@ -60,6 +60,8 @@
 #define sys_port_trace_k_thread_sched_priority_set(thread, prio)                                   \
 	sys_trace_k_thread_sched_set_priority(thread, prio)
 #define sys_port_trace_k_thread_sched_ready(thread) sys_trace_k_thread_sched_ready(thread)
+#define sys_port_trace_k_thread_sched_latency(thread, cycles)                                      \
+	sys_trace_k_thread_sched_latency(thread, cycles)
 #define sys_port_trace_k_thread_sched_pend(thread) sys_trace_k_thread_sched_pend(thread)
 #define sys_port_trace_k_thread_sched_resume(thread) sys_trace_k_thread_sched_resume(thread)
 #define sys_port_trace_k_thread_sched_suspend(thread) sys_trace_k_thread_sched_suspend(thread)
@@ -189,6 +191,9 @@
 	sys_trace_k_queue_get_blocking(queue, timeout)
 #define sys_port_trace_k_queue_get_exit(queue, timeout, ret)                                       \
 	sys_trace_k_queue_get_exit(queue, timeout, ret)
+#define sys_port_trace_k_queue_get_batch_enter(queue, max, timeout)
+#define sys_port_trace_k_queue_get_batch_blocking(queue, max, timeout)
+#define sys_port_trace_k_queue_get_batch_exit(queue, max, timeout, ret)
 #define sys_port_trace_k_queue_remove_enter(queue) sys_trace_k_queue_remove_enter(queue, data)
 #define sys_port_trace_k_queue_remove_exit(queue, ret)                                             \
 	sys_trace_k_queue_remove_exit(queue, data, ret)
@@ -235,6 +240,10 @@
 #define sys_port_trace_k_fifo_get_exit(fifo, timeout, ret)                                         \
 	sys_trace_k_fifo_get_exit(fifo, timeout, ret)
 
+#define sys_port_trace_k_fifo_get_batch_enter(fifo, list, max, timeout)
+
+#define sys_port_trace_k_fifo_get_batch_exit(fifo, list, max, timeout, ret)
+
 #define sys_port_trace_k_fifo_peek_head_enter(fifo) sys_trace_k_fifo_peek_head_enter(fifo)
 
 #define sys_port_trace_k_fifo_peek_head_exit(fifo, ret) sys_trace_k_fifo_peek_head_exit(fifo, ret)
@@ -263,6 +272,10 @@
 #define sys_port_trace_k_lifo_get_exit(lifo, timeout, ret)                                         \
 	sys_trace_k_lifo_get_exit(lifo, timeout, ret)
 
+#define sys_port_trace_k_lifo_get_batch_enter(lifo, list, max, timeout)
+
+#define sys_port_trace_k_lifo_get_batch_exit(lifo, list, max, timeout, ret)
+
 /* Stack */
 #define sys_port_trace_k_stack_init(stack) sys_trace_k_stack_init(stack, buffer, num_entries)
 
@@ -427,6 +440,10 @@
 #define sys_port_trace_pm_device_disable_enter(dev)
 #define sys_port_trace_pm_device_disable_exit(dev)
 
+#define sys_port_trace_net_pkt_rx_stage(pkt, stage, usec)
+
+#define sys_port_trace_profiler_sample(thread, pc, lr, irq)
+
 void sys_trace_syscall_enter(void);
 void sys_trace_syscall_exit(void);
 void sys_trace_idle(void);
@@ -440,6 +457,7 @@ void sys_trace_k_thread_sched_wakeup(struct k_thread *thread);
 void sys_trace_k_thread_sched_abort(struct k_thread *thread);
 void sys_trace_k_thread_sched_set_priority(struct k_thread *thread, int prio);
 void sys_trace_k_thread_sched_ready(struct k_thread *thread);
+void sys_trace_k_thread_sched_latency(struct k_thread *thread, uint32_t cycles);
 void sys_trace_k_thread_sched_pend(struct k_thread *thread);
 void sys_trace_k_thread_sched_resume(struct k_thread *thread);
 void sys_trace_k_thread_sched_suspend(struct k_thread *thread);
@@ -4,7 +4,12 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <string.h>
+#include <sys/atomic.h>
 #include <sys/ring_buffer.h>
+#include <tracing_buffer.h>
 
 static struct ring_buf tracing_ring_buf;
 static uint8_t tracing_buffer[CONFIG_TRACING_BUFFER_SIZE + 1];
@@ -67,3 +72,259 @@ uint32_t tracing_buffer_space_get(void)
 {
 	return ring_buf_space_get(&tracing_ring_buf);
 }
+
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+/* Each CPU records into its own buffer, which it is the only writer of, and
+ * the tracing thread is the only reader of. Recording thus only needs to
+ * lock interrupts on the local CPU, and never contends with other CPUs.
+ *
+ * A buffer holds records made of a header followed by a packet, aligned to
+ * 4 bytes. Records never wrap: when the space left at the end of the buffer
+ * is too small, a wrap record is written there if it fits, and the record
+ * is written at the start of the buffer.
+ */
+#define TRACING_RECORD_WRAP 0xFFFF
+#define TRACING_CPU_BUFFER_SIZE ROUND_DOWN(CONFIG_TRACING_BUFFER_SIZE, 4)
+
+struct tracing_record {
+	uint16_t length;
+	uint16_t reserved;
+	uint32_t timestamp;
+	uint8_t data[];
+};
+
+struct tracing_cpu_buffer {
+	atomic_t head;
+	atomic_t tail;
+	atomic_t busy;
+	uint8_t data[TRACING_CPU_BUFFER_SIZE] __aligned(4);
+};
+
+static struct tracing_cpu_buffer tracing_cpu_buffers[CONFIG_MP_NUM_CPUS];
+static uint8_t tracing_merge_cpu;
+
+#ifdef CONFIG_TRACING_FLIGHT_RECORDER
+static atomic_t tracing_frozen;
+#endif
+
+static inline uint32_t record_size(uint32_t length)
+{
+	return ROUND_UP(sizeof(struct tracing_record) + length, 4);
+}
+
+static struct tracing_record *cpu_buffer_peek(struct tracing_cpu_buffer *cb)
+{
+	uint32_t head = atomic_get(&cb->head);
+	uint32_t tail = atomic_get(&cb->tail);
+	struct tracing_record *record;
+
+	while (tail != head) {
+		if (TRACING_CPU_BUFFER_SIZE - tail < sizeof(*record)) {
+			tail = 0U;
+			atomic_set(&cb->tail, tail);
+			continue;
+		}
+
+		record = (struct tracing_record *)&cb->data[tail];
+		if (record->length != TRACING_RECORD_WRAP) {
+			return record;
+		}
+
+		tail = 0U;
+		atomic_set(&cb->tail, tail);
+	}
+
+	return NULL;
+}
+
+static void cpu_buffer_free(struct tracing_cpu_buffer *cb,
+			    struct tracing_record *record)
+{
+	uint32_t tail = (uint8_t *)record - cb->data + record_size(record->length);
+
+	atomic_set(&cb->tail, tail % TRACING_CPU_BUFFER_SIZE);
+}
+
+/* Returns the offset at which size bytes can be written, or -1 */
+static int cpu_buffer_reserve(struct tracing_cpu_buffer *cb, uint32_t size,
+			      uint32_t *new_head)
+{
+	uint32_t head = atomic_get(&cb->head);
+	uint32_t tail = atomic_get(&cb->tail);
+	struct tracing_record *wrap;
+
+	/* The head never catches up with the tail, as that would make the
+	 * buffer look empty.
+	 */
+	if (head < tail) {
+		if (head + size < tail) {
+			*new_head = head + size;
+			return head;
+		}
+
+		return -1;
+	}
+
+	if (head + size < TRACING_CPU_BUFFER_SIZE ||
+	    (head + size == TRACING_CPU_BUFFER_SIZE && tail != 0U)) {
+		*new_head = (head + size) % TRACING_CPU_BUFFER_SIZE;
+		return head;
+	}
+
+	if (size >= tail) {
+		return -1;
+	}
+
+	if (TRACING_CPU_BUFFER_SIZE - head >= sizeof(*wrap)) {
+		wrap = (struct tracing_record *)&cb->data[head];
+		wrap->length = TRACING_RECORD_WRAP;
+	}
+
+	*new_head = size;
+	return 0;
+}
+
+bool tracing_buffer_cpu_put(tracing_data_t *tracing_data_array,
+			    uint32_t count, bool *before_put_is_empty)
+{
+	struct tracing_cpu_buffer *cb;
+	struct tracing_record *record;
+	uint32_t length = 0U, new_head;
+	unsigned int key;
+	uint8_t *data;
+	int offset;
+
+	for (uint32_t i = 0; i < count; i++) {
+		length += tracing_data_array[i].length;
+	}
+
+	if (!length || record_size(length) >= TRACING_CPU_BUFFER_SIZE) {
+		return false;
+	}
+
+	/* Only the local CPU has to be kept out, irq_lock() would take the
+	 * global lock on SMP.
+	 */
+	key = arch_irq_lock();
+	cb = &tracing_cpu_buffers[_current_cpu->id];
+
+#ifdef CONFIG_TRACING_FLIGHT_RECORDER
+	/* The reader waits for busy buffers after freezing them */
+	atomic_set(&cb->busy, 1);
+	if (atomic_get(&tracing_frozen)) {
+		atomic_set(&cb->busy, 0);
+		arch_irq_unlock(key);
+		return false;
+	}
+#endif
+
+	*before_put_is_empty = atomic_get(&cb->head) == atomic_get(&cb->tail);
+
+	offset = cpu_buffer_reserve(cb, record_size(length), &new_head);
+
+#ifdef CONFIG_TRACING_FLIGHT_RECORDER
+	/* Nobody reads the buffers until they are frozen, so the oldest
+	 * records can be overwritten.
+	 */
+	while (offset < 0) {
+		record = cpu_buffer_peek(cb);
+		if (!record) {
+			break;
+		}
+
+		cpu_buffer_free(cb, record);
+		offset = cpu_buffer_reserve(cb, record_size(length),
+					    &new_head);
+	}
+#endif
+
+	if (offset >= 0) {
+		record = (struct tracing_record *)&cb->data[offset];
+		record->length = length;
+		record->timestamp = k_cycle_get_32();
+
+		data = record->data;
+		for (uint32_t i = 0; i < count; i++) {
+			memcpy(data, tracing_data_array[i].data,
+			       tracing_data_array[i].length);
+			data += tracing_data_array[i].length;
+		}
+
+		atomic_set(&cb->head, new_head);
+	}
+
+#ifdef CONFIG_TRACING_FLIGHT_RECORDER
+	atomic_set(&cb->busy, 0);
+#endif
+	arch_irq_unlock(key);
+
+	return offset >= 0;
+}
+
+uint32_t tracing_buffer_merge_claim(uint8_t **data, uint8_t *cpu_id,
+				    uint32_t *timestamp)
+{
+	struct tracing_record *oldest = NULL, *record;
+
+	for (uint8_t cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+		record = cpu_buffer_peek(&tracing_cpu_buffers[cpu]);
+		if (record && (!oldest ||
+			       (int32_t)(record->timestamp -
+					 oldest->timestamp) < 0)) {
+			oldest = record;
+			tracing_merge_cpu = cpu;
+		}
+	}
+
+	if (!oldest) {
+		return 0;
+	}
+
+	*data = oldest->data;
+	*cpu_id = tracing_merge_cpu;
+	*timestamp = oldest->timestamp;
+
+	return oldest->length;
+}
+
+void tracing_buffer_merge_finish(void)
+{
+	struct tracing_cpu_buffer *cb = &tracing_cpu_buffers[tracing_merge_cpu];
+	struct tracing_record *record = cpu_buffer_peek(cb);
+
+	if (record) {
+		cpu_buffer_free(cb, record);
+	}
+}
+
+bool tracing_buffer_merge_is_empty(void)
+{
+	for (uint8_t cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+		struct tracing_cpu_buffer *cb = &tracing_cpu_buffers[cpu];
+
+		if (atomic_get(&cb->head) != atomic_get(&cb->tail)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+#ifdef CONFIG_TRACING_FLIGHT_RECORDER
+void tracing_buffer_freeze(bool freeze)
+{
+	atomic_set(&tracing_frozen, freeze);
+
+	if (!freeze) {
+		return;
+	}
+
+	/* Let the records being written complete */
+	for (uint8_t cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+		while (atomic_get(&tracing_cpu_buffers[cpu].busy)) {
+			arch_nop();
+		}
+	}
+}
+#endif /* CONFIG_TRACING_FLIGHT_RECORDER */
+#endif /* CONFIG_TRACING_BUFFER_PER_CPU */
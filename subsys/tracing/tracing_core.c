@@ -15,6 +15,7 @@
 
 #define TRACING_CMD_ENABLE  "enable"
 #define TRACING_CMD_DISABLE "disable"
+#define TRACING_CMD_TRIGGER "trigger"
 
 #ifdef CONFIG_TRACING_BACKEND_UART
 #define TRACING_BACKEND_NAME "tracing_backend_uart"
@@ -47,6 +48,68 @@ static K_SEM_DEFINE(tracing_thread_sem, 0, 1);
 static K_THREAD_STACK_DEFINE(tracing_thread_stack,
 			CONFIG_TRACING_THREAD_STACK_SIZE);
 
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+#define TRACING_CPU_ID_NONE 0xFF
+
+#ifdef CONFIG_TRACING_FLIGHT_RECORDER
+static K_SEM_DEFINE(tracing_trigger_sem, 0, 1);
+static uint32_t tracing_trigger_timestamp;
+#endif
+
+/* Output the packets of all CPUs by timestamp order, skipping the ones
+ * recorded before since when discard_old is set.
+ */
+static void tracing_merge_output(bool discard_old, uint32_t since)
+{
+	static uint8_t last_cpu_id = TRACING_CPU_ID_NONE;
+	uint32_t length, timestamp;
+	uint8_t *data, cpu_id;
+
+	while (true) {
+		length = tracing_buffer_merge_claim(&data, &cpu_id, &timestamp);
+		if (!length) {
+			break;
+		}
+
+		if (discard_old && (int32_t)(timestamp - since) < 0) {
+			tracing_buffer_merge_finish();
+			continue;
+		}
+
+		if (cpu_id != last_cpu_id) {
+			tracing_cpu_id_handle(cpu_id, timestamp);
+			last_cpu_id = cpu_id;
+		}
+
+		tracing_buffer_handle(data, length);
+		tracing_buffer_merge_finish();
+	}
+}
+
+static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
+{
+	tracing_thread_tid = k_current_get();
+
+	while (true) {
+#ifdef CONFIG_TRACING_FLIGHT_RECORDER
+		uint32_t window =
+			k_ms_to_cyc_ceil32(CONFIG_TRACING_FLIGHT_RECORDER_WINDOW);
+
+		k_sem_take(&tracing_trigger_sem, K_FOREVER);
+
+		tracing_buffer_freeze(true);
+		tracing_merge_output(true, tracing_trigger_timestamp - window);
+		tracing_buffer_freeze(false);
+#else
+		if (tracing_buffer_merge_is_empty()) {
+			k_sem_take(&tracing_thread_sem, K_FOREVER);
+		} else {
+			tracing_merge_output(false, 0);
+		}
+#endif
+	}
+}
+#else
 static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 {
 	uint8_t *transferring_buf;
@@ -70,6 +133,7 @@ static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 		}
 	}
 }
+#endif /* CONFIG_TRACING_BUFFER_PER_CPU */
 
 static void tracing_thread_timer_expiry_fn(struct k_timer *timer)
 {
@@ -118,6 +182,11 @@ SYS_INIT(tracing_init, APPLICATION, 0);
 #ifdef CONFIG_TRACING_ASYNC
 void tracing_trigger_output(bool before_put_is_empty)
 {
+	/* The flight recorder is only output when triggered */
+	if (IS_ENABLED(CONFIG_TRACING_FLIGHT_RECORDER)) {
+		return;
+	}
+
 	if (before_put_is_empty) {
 		k_timer_start(&tracing_thread_timer,
 			      K_MSEC(CONFIG_TRACING_THREAD_WAIT_THRESHOLD),
@@ -131,6 +200,14 @@ bool is_tracing_thread(void)
 }
 #endif
 
+#ifdef CONFIG_TRACING_FLIGHT_RECORDER
+void tracing_flight_recorder_trigger(void)
+{
+	tracing_trigger_timestamp = k_cycle_get_32();
+	k_sem_give(&tracing_trigger_sem);
+}
+#endif
+
 bool is_tracing_enabled(void)
 {
 	return atomic_get(&tracing_state) == TRACING_ENABLE;
@@ -142,6 +219,10 @@ void tracing_cmd_handle(uint8_t *buf, uint32_t length)
 		tracing_set_state(TRACING_ENABLE);
 	} else if (strncmp(buf, TRACING_CMD_DISABLE, length) == 0) {
 		tracing_set_state(TRACING_DISABLE);
+#ifdef CONFIG_TRACING_FLIGHT_RECORDER
+	} else if (strncmp(buf, TRACING_CMD_TRIGGER, length) == 0) {
+		tracing_flight_recorder_trigger();
+#endif
 	}
 }
 
@@ -154,3 +235,8 @@ void tracing_packet_drop_handle(void)
 {
 	atomic_inc(&tracing_packet_drop_num);
 }
+
+uint32_t tracing_packet_drop_num_get(void)
+{
+	return atomic_get(&tracing_packet_drop_num);
+}
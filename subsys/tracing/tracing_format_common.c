@@ -29,6 +29,33 @@ static int str_put(int c, void *ctx)
 	return 0;
 }
 
+struct str_copy_ctx {
+	uint8_t *buf;
+	uint32_t size;
+	uint32_t length;
+};
+
+static int str_copy(int c, void *ctx)
+{
+	struct str_copy_ctx *copy_ctx = ctx;
+
+	if (copy_ctx->length < copy_ctx->size) {
+		copy_ctx->buf[copy_ctx->length++] = (uint8_t)c;
+	}
+
+	return 0;
+}
+
+uint32_t tracing_format_string_copy(uint8_t *buf, uint32_t size,
+				    const char *str, va_list args)
+{
+	struct str_copy_ctx copy_ctx = { .buf = buf, .size = size };
+
+	(void)cbvprintf(str_copy, (void *)&copy_ctx, str, args);
+
+	return copy_ctx.length;
+}
+
 bool tracing_format_string_put(const char *str, va_list args)
 {
 	tracing_ctx_t str_ctx = {0};
@@ -22,6 +22,7 @@
 #include <sys/byteorder.h>
 #include <sys/util.h>
 #include <net/buf.h>
+#include <string.h>
 
 #include <logging/log.h>
 LOG_MODULE_REGISTER(usb_audio, CONFIG_USB_AUDIO_LOG_LEVEL);
@@ -45,6 +46,13 @@ struct usb_audio_dev_data {
 
 	bool rx_enable;
 	bool tx_enable;
+
+#ifdef CONFIG_USB_AUDIO_MEM_SLAB
+	struct k_mem_slab *rx_slab;
+	/* Slab of the block being sent */
+	struct k_mem_slab *tx_slab;
+	struct usb_audio_block_stats stats;
+#endif
 };
 
 static sys_slist_t usb_audio_data_devlist;
@@ -828,6 +836,140 @@ int usb_audio_send(const struct device *dev, struct net_buf *buffer,
 	return 0;
 }
 
+#ifdef CONFIG_USB_AUDIO_MEM_SLAB
+static void audio_write_block_cb(uint8_t ep, int size, void *priv)
+{
+	struct usb_dev_data *dev_data;
+	struct usb_audio_dev_data *audio_dev_data;
+	void *block = priv;
+
+	dev_data = usb_get_dev_data_by_ep(&usb_audio_data_devlist, ep);
+	audio_dev_data = dev_data->dev->data;
+
+	LOG_DBG("Written block %p, %d bytes on ep 0x%02x", block, size, ep);
+
+	audio_dev_data->stats.tx_blocks++;
+
+	if (audio_dev_data->ops && audio_dev_data->ops->block_written_cb) {
+		audio_dev_data->ops->block_written_cb(dev_data->dev,
+						      block, size);
+	} else {
+		k_mem_slab_free(audio_dev_data->tx_slab, &block);
+	}
+}
+
+int usb_audio_send_block(const struct device *dev, void *block, size_t len,
+			 struct k_mem_slab *slab)
+{
+	struct usb_audio_dev_data *audio_dev_data = dev->data;
+	struct usb_cfg_data *cfg = (void *)dev->config;
+	/* EP ISO IN is always placed first in the endpoint table */
+	uint8_t ep = cfg->endpoint[0].ep_addr;
+	uint32_t depth;
+	int ret;
+
+	if (!(ep & USB_EP_DIR_MASK)) {
+		LOG_ERR("Wrong device");
+		return -EINVAL;
+	}
+
+	if (!audio_dev_data->tx_enable) {
+		LOG_DBG("sending dropped -> Host chose passive interface");
+		return -EAGAIN;
+	}
+
+	if (len > slab->block_size) {
+		LOG_ERR("Cannot send %zu bytes, to much data", len);
+		return -EINVAL;
+	}
+
+	/* Only one transfer per endpoint, the previous block was released
+	 * before this one can be sent.
+	 */
+	audio_dev_data->tx_slab = slab;
+
+	depth = k_mem_slab_num_used_get(slab);
+	audio_dev_data->stats.tx_depth_max =
+		MAX(audio_dev_data->stats.tx_depth_max, depth);
+
+	ret = usb_transfer(ep, block, len, USB_TRANS_WRITE | USB_TRANS_NO_ZLP,
+			   audio_write_block_cb, block);
+	if (ret) {
+		audio_dev_data->stats.tx_errors++;
+	}
+
+	return ret;
+}
+
+int usb_audio_rx_slab_set(const struct device *dev, struct k_mem_slab *slab)
+{
+	struct usb_audio_dev_data *audio_dev_data = dev->data;
+
+	if (audio_dev_data->pool == NULL) {
+		LOG_ERR("Wrong device");
+		return -EINVAL;
+	}
+
+	audio_dev_data->rx_slab = slab;
+
+	return 0;
+}
+
+void usb_audio_block_stats_get(const struct device *dev,
+			       struct usb_audio_block_stats *stats,
+			       bool reset)
+{
+	struct usb_audio_dev_data *audio_dev_data = dev->data;
+	unsigned int key = irq_lock();
+
+	*stats = audio_dev_data->stats;
+	if (reset) {
+		memset(&audio_dev_data->stats, 0,
+		       sizeof(audio_dev_data->stats));
+	}
+
+	irq_unlock(key);
+}
+
+static void audio_receive_block(struct usb_audio_dev_data *audio_dev_data,
+				uint8_t ep)
+{
+	struct k_mem_slab *slab = audio_dev_data->rx_slab;
+	uint32_t depth;
+	void *block;
+	int ret_bytes;
+	int ret;
+
+	if (!audio_dev_data->ops || !audio_dev_data->ops->block_received_cb) {
+		return;
+	}
+
+	if (k_mem_slab_alloc(slab, &block, K_NO_WAIT)) {
+		audio_dev_data->stats.rx_dropped++;
+		LOG_DBG("No free block");
+		return;
+	}
+
+	ret = usb_read(ep, block, slab->block_size, &ret_bytes);
+	if (ret || !ret_bytes) {
+		if (ret) {
+			LOG_ERR("ret=%d ", ret);
+		}
+
+		k_mem_slab_free(slab, &block);
+		return;
+	}
+
+	depth = k_mem_slab_num_used_get(slab);
+	audio_dev_data->stats.rx_depth_max =
+		MAX(audio_dev_data->stats.rx_depth_max, depth);
+	audio_dev_data->stats.rx_blocks++;
+
+	audio_dev_data->ops->block_received_cb(audio_dev_data->common.dev,
+					       block, ret_bytes);
+}
+#endif /* CONFIG_USB_AUDIO_MEM_SLAB */
+
 size_t usb_audio_get_in_frame_size(const struct device *dev)
 {
 	struct usb_audio_dev_data *audio_dev_data = dev->data;
@@ -860,6 +1002,14 @@ static void audio_receive_cb(uint8_t ep, enum usb_dc_ep_cb_status_code status)
 		return;
 	}
 
+#ifdef CONFIG_USB_AUDIO_MEM_SLAB
+	/* Read straight into a block the application passes on */
+	if (audio_dev_data->rx_slab) {
+		audio_receive_block(audio_dev_data, ep);
+		return;
+	}
+#endif
+
 	/* Check if application installed callback and process the data.
 	 * In case no callback is installed do not alloc the buffer at all.
 	 */
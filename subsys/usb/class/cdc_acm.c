@@ -199,6 +199,20 @@ struct cdc_acm_dev_data_t {
 	bool configured;
 	/* CDC ACM suspended flag */
 	bool suspended;
+#ifdef CONFIG_UART_ASYNC_API
+	/* Asynchronous API callback, the reception is only done in the
+	 * buffers of the application when set.
+	 */
+	uart_callback_t async_cb;
+	void *async_cb_data;
+	const uint8_t *tx_async_buf;
+	uint8_t *rx_async_buf;
+	size_t rx_async_len;
+	size_t rx_async_offset;
+	uint8_t *rx_async_next;
+	size_t rx_async_next_len;
+	bool rx_async_ena;
+#endif
 
 	struct usb_dev_data common;
 };
@@ -206,6 +220,11 @@ struct cdc_acm_dev_data_t {
 static sys_slist_t cdc_acm_data_devlist;
 static const struct uart_driver_api cdc_acm_driver_api;
 
+#ifdef CONFIG_UART_ASYNC_API
+static void cdc_acm_rx_async_start(struct cdc_acm_dev_data_t *dev_data);
+static void cdc_acm_tx_async_abort(struct cdc_acm_dev_data_t *dev_data);
+#endif
+
 /**
  * @brief Handler called for Class requests not handled by the USB stack.
  *
@@ -365,6 +384,16 @@ done:
 		k_work_submit_to_queue(&USB_WORK_Q, &dev_data->cb_work);
 	}
 
+#ifdef CONFIG_UART_ASYNC_API
+	if (dev_data->async_cb != NULL) {
+		if (dev_data->rx_async_ena) {
+			cdc_acm_rx_async_start(dev_data);
+		}
+
+		return;
+	}
+#endif
+
 	usb_transfer(ep, dev_data->rx_buf, sizeof(dev_data->rx_buf),
 		     USB_TRANS_READ, cdc_acm_read_cb, dev_data);
 
@@ -400,6 +429,12 @@ static void cdc_acm_int_in(uint8_t ep, enum usb_dc_ep_cb_status_code ep_status)
 static void cdc_acm_reset_port(struct cdc_acm_dev_data_t *dev_data)
 {
 	k_sem_give(&dev_data->poll_wait_sem);
+#ifdef CONFIG_UART_ASYNC_API
+	/* The transfers are cancelled, the reception resumes once the device
+	 * is configured again.
+	 */
+	cdc_acm_tx_async_abort(dev_data);
+#endif
 	dev_data->configured = false;
 	dev_data->suspended = false;
 	dev_data->rx_ready = false;
@@ -433,10 +468,10 @@ static void cdc_acm_do_cb(struct cdc_acm_dev_data_t *dev_data,
 	case USB_DC_CONFIGURED:
 		LOG_INF("Device configured");
 		if (!dev_data->configured) {
+			dev_data->configured = true;
 			cdc_acm_read_cb(cfg->endpoint[ACM_OUT_EP_IDX].ep_addr, 0,
 					dev_data);
 		}
-		dev_data->configured = true;
 		dev_data->tx_ready = true;
 		break;
 	case USB_DC_DISCONNECTED:
@@ -993,9 +1028,302 @@ static void cdc_acm_poll_out(const struct device *dev,
 	k_sem_take(&dev_data->poll_wait_sem, K_MSEC(100));
 }
 
+#ifdef CONFIG_UART_ASYNC_API
+static void cdc_acm_async_evt(struct cdc_acm_dev_data_t *dev_data,
+			      struct uart_event *evt)
+{
+	if (dev_data->async_cb) {
+		dev_data->async_cb(dev_data->common.dev, evt,
+				   dev_data->async_cb_data);
+	}
+}
+
+static int cdc_acm_callback_set(const struct device *dev,
+				uart_callback_t callback, void *user_data)
+{
+	struct cdc_acm_dev_data_t * const dev_data = DEV_DATA(dev);
+	struct usb_cfg_data *cfg = (void *)dev->config;
+
+	dev_data->async_cb = callback;
+	dev_data->async_cb_data = user_data;
+
+	/* Stop receiving in the internal buffer */
+	if (callback != NULL && !dev_data->rx_async_ena) {
+		usb_cancel_transfer(cfg->endpoint[ACM_OUT_EP_IDX].ep_addr);
+	}
+
+	return 0;
+}
+
+static void cdc_acm_tx_async_cb(uint8_t ep, int size, void *priv)
+{
+	struct cdc_acm_dev_data_t *dev_data = priv;
+	struct uart_event evt = {
+		.type = UART_TX_DONE,
+		.data.tx.len = size,
+	};
+	unsigned int key;
+
+	key = irq_lock();
+	evt.data.tx.buf = dev_data->tx_async_buf;
+	dev_data->tx_async_buf = NULL;
+	irq_unlock(key);
+
+	/* Aborted meanwhile */
+	if (evt.data.tx.buf == NULL) {
+		return;
+	}
+
+	LOG_DBG("ep %x: written %d bytes dev_data %p", ep, size, dev_data);
+
+	cdc_acm_async_evt(dev_data, &evt);
+}
+
+/*
+ * The data is sent as a single transfer, followed by a zero-length packet if
+ * its length is a multiple of the max packet size so that the host does not
+ * wait for more.
+ */
+static int cdc_acm_tx(const struct device *dev, const uint8_t *buf,
+		      size_t len, int32_t timeout)
+{
+	struct cdc_acm_dev_data_t * const dev_data = DEV_DATA(dev);
+	struct usb_cfg_data *cfg = (void *)dev->config;
+	unsigned int key;
+	int ret;
+
+	ARG_UNUSED(timeout);
+
+	if (!dev_data->configured || dev_data->suspended) {
+		return -EIO;
+	}
+
+	key = irq_lock();
+
+	if (dev_data->tx_async_buf != NULL) {
+		irq_unlock(key);
+		return -EBUSY;
+	}
+
+	dev_data->tx_async_buf = buf;
+
+	irq_unlock(key);
+
+	ret = usb_transfer(cfg->endpoint[ACM_IN_EP_IDX].ep_addr,
+			   (uint8_t *)buf, len, USB_TRANS_WRITE,
+			   cdc_acm_tx_async_cb, dev_data);
+	if (ret) {
+		dev_data->tx_async_buf = NULL;
+	}
+
+	return ret;
+}
+
+static void cdc_acm_tx_async_abort(struct cdc_acm_dev_data_t *dev_data)
+{
+	struct uart_event evt = {
+		.type = UART_TX_ABORTED,
+	};
+	unsigned int key;
+
+	key = irq_lock();
+	evt.data.tx.buf = dev_data->tx_async_buf;
+	dev_data->tx_async_buf = NULL;
+	irq_unlock(key);
+
+	if (evt.data.tx.buf != NULL) {
+		cdc_acm_async_evt(dev_data, &evt);
+	}
+}
+
+/* The length of the data sent before the abort is not known. */
+static int cdc_acm_tx_abort(const struct device *dev)
+{
+	struct cdc_acm_dev_data_t * const dev_data = DEV_DATA(dev);
+	struct usb_cfg_data *cfg = (void *)dev->config;
+
+	if (dev_data->tx_async_buf == NULL) {
+		return -EFAULT;
+	}
+
+	usb_cancel_transfer(cfg->endpoint[ACM_IN_EP_IDX].ep_addr);
+	cdc_acm_tx_async_abort(dev_data);
+
+	return 0;
+}
+
+static void cdc_acm_rx_async_cb(uint8_t ep, int size, void *priv)
+{
+	struct cdc_acm_dev_data_t *dev_data = priv;
+	struct uart_event evt;
+
+	if (!dev_data->rx_async_ena) {
+		return;
+	}
+
+	/* A transfer ends with a short packet, or when the buffer is full */
+	if (size > 0) {
+		evt.type = UART_RX_RDY;
+		evt.data.rx.buf = dev_data->rx_async_buf;
+		evt.data.rx.offset = dev_data->rx_async_offset;
+		evt.data.rx.len = size;
+		dev_data->rx_async_offset += size;
+		cdc_acm_async_evt(dev_data, &evt);
+	}
+
+	/* A packet must fit in the rest of the buffer */
+	if (dev_data->rx_async_len - dev_data->rx_async_offset >=
+	    CONFIG_CDC_ACM_BULK_EP_MPS) {
+		cdc_acm_rx_async_start(dev_data);
+		return;
+	}
+
+	evt.type = UART_RX_BUF_RELEASED;
+	evt.data.rx_buf.buf = dev_data->rx_async_buf;
+	cdc_acm_async_evt(dev_data, &evt);
+
+	if (dev_data->rx_async_next == NULL) {
+		dev_data->rx_async_ena = false;
+		evt.type = UART_RX_DISABLED;
+		cdc_acm_async_evt(dev_data, &evt);
+		return;
+	}
+
+	dev_data->rx_async_buf = dev_data->rx_async_next;
+	dev_data->rx_async_len = dev_data->rx_async_next_len;
+	dev_data->rx_async_offset = 0;
+	dev_data->rx_async_next = NULL;
+
+	evt.type = UART_RX_BUF_REQUEST;
+	cdc_acm_async_evt(dev_data, &evt);
+
+	cdc_acm_rx_async_start(dev_data);
+}
+
+/*
+ * Receive straight in the buffer of the application, up to its end. A
+ * short packet completes the transfer before, it is then continued in the
+ * rest of the buffer.
+ */
+static void cdc_acm_rx_async_start(struct cdc_acm_dev_data_t *dev_data)
+{
+	const struct device *dev = dev_data->common.dev;
+	struct usb_cfg_data *cfg = (void *)dev->config;
+	size_t len = dev_data->rx_async_len - dev_data->rx_async_offset;
+	int ret;
+
+	if (!dev_data->configured || dev_data->suspended) {
+		/* Started once configured */
+		return;
+	}
+
+	/* Whole packets only, what does not fit is dropped by the driver */
+	len -= len % CONFIG_CDC_ACM_BULK_EP_MPS;
+
+	ret = usb_transfer(cfg->endpoint[ACM_OUT_EP_IDX].ep_addr,
+			   dev_data->rx_async_buf + dev_data->rx_async_offset,
+			   len, USB_TRANS_READ, cdc_acm_rx_async_cb, dev_data);
+	if (ret) {
+		LOG_DBG("Reception not started (%d)", ret);
+	}
+}
+
+static int cdc_acm_rx_enable(const struct device *dev, uint8_t *buf,
+			     size_t len, int32_t timeout)
+{
+	struct cdc_acm_dev_data_t * const dev_data = DEV_DATA(dev);
+	struct uart_event evt = {
+		.type = UART_RX_BUF_REQUEST,
+	};
+
+	ARG_UNUSED(timeout);
+
+	if (dev_data->rx_async_ena) {
+		return -EBUSY;
+	}
+
+	if (len < CONFIG_CDC_ACM_BULK_EP_MPS) {
+		return -EINVAL;
+	}
+
+	dev_data->rx_async_buf = buf;
+	dev_data->rx_async_len = len;
+	dev_data->rx_async_offset = 0;
+	dev_data->rx_async_next = NULL;
+	dev_data->rx_async_ena = true;
+
+	cdc_acm_async_evt(dev_data, &evt);
+	cdc_acm_rx_async_start(dev_data);
+
+	return 0;
+}
+
+static int cdc_acm_rx_buf_rsp(const struct device *dev, uint8_t *buf,
+			      size_t len)
+{
+	struct cdc_acm_dev_data_t * const dev_data = DEV_DATA(dev);
+
+	if (!dev_data->rx_async_ena) {
+		return -EACCES;
+	}
+
+	if (dev_data->rx_async_next != NULL) {
+		return -EBUSY;
+	}
+
+	if (len < CONFIG_CDC_ACM_BULK_EP_MPS) {
+		return -EINVAL;
+	}
+
+	dev_data->rx_async_next = buf;
+	dev_data->rx_async_next_len = len;
+
+	return 0;
+}
+
+/* The data of the transfer in progress, not completed yet, is dropped. */
+static int cdc_acm_rx_disable(const struct device *dev)
+{
+	struct cdc_acm_dev_data_t * const dev_data = DEV_DATA(dev);
+	struct usb_cfg_data *cfg = (void *)dev->config;
+	struct uart_event evt = {
+		.type = UART_RX_BUF_RELEASED,
+	};
+
+	if (!dev_data->rx_async_ena) {
+		return -EFAULT;
+	}
+
+	dev_data->rx_async_ena = false;
+	usb_cancel_transfer(cfg->endpoint[ACM_OUT_EP_IDX].ep_addr);
+
+	evt.data.rx_buf.buf = dev_data->rx_async_buf;
+	cdc_acm_async_evt(dev_data, &evt);
+
+	if (dev_data->rx_async_next != NULL) {
+		evt.data.rx_buf.buf = dev_data->rx_async_next;
+		dev_data->rx_async_next = NULL;
+		cdc_acm_async_evt(dev_data, &evt);
+	}
+
+	evt.type = UART_RX_DISABLED;
+	cdc_acm_async_evt(dev_data, &evt);
+
+	return 0;
+}
+#endif /* CONFIG_UART_ASYNC_API */
+
 static const struct uart_driver_api cdc_acm_driver_api = {
 	.poll_in = cdc_acm_poll_in,
 	.poll_out = cdc_acm_poll_out,
+#ifdef CONFIG_UART_ASYNC_API
+	.callback_set = cdc_acm_callback_set,
+	.tx = cdc_acm_tx,
+	.tx_abort = cdc_acm_tx_abort,
+	.rx_enable = cdc_acm_rx_enable,
+	.rx_buf_rsp = cdc_acm_rx_buf_rsp,
+	.rx_disable = cdc_acm_rx_disable,
+#endif
 	.fifo_fill = cdc_acm_fifo_fill,
 	.fifo_read = cdc_acm_fifo_read,
 	.irq_tx_enable = cdc_acm_irq_tx_enable,
@@ -56,7 +56,8 @@ LOG_MODULE_REGISTER(usb_msc);
 
 #define THREAD_OP_READ_QUEUED		1
 #define THREAD_OP_WRITE_QUEUED		3
-#define THREAD_OP_WRITE_DONE		4
+
+#define BUF_SIZE	(CONFIG_MASS_STORAGE_BUF_BLOCKS * BLOCK_SIZE)
 
 #define MASS_STORAGE_IN_EP_ADDR		0x82
 #define MASS_STORAGE_OUT_EP_ADDR	0x01
@@ -106,17 +107,40 @@ static volatile int thread_op;
 static K_KERNEL_STACK_DEFINE(mass_thread_stack, CONFIG_MASS_STORAGE_STACK_SIZE);
 static struct k_thread mass_thread_data;
 static struct k_sem disk_wait_sem;
-static volatile uint32_t defered_wr_sz;
 
 /*
- * Keep block buffer larger than BLOCK_SIZE for the case
- * the dCBWDataTransferLength is multiple of the BLOCK_SIZE and
- * the length of the transferred data is not aligned to the BLOCK_SIZE.
+ * The data of READ and WRITE commands goes through two buffers, so that
+ * one is transferred over USB while the other is read from or written to
+ * the disk, with one disk access for all its blocks.
+ *
+ * Keep the buffers larger than BUF_SIZE for the case the packet size is
+ * not a divisor of BLOCK_SIZE, and the last packet received in a buffer
+ * overflows it.
  *
  * Align for cases where the underlying disk access requires word-aligned
  * addresses.
  */
-static uint8_t __aligned(4) page[BLOCK_SIZE + CONFIG_MASS_STORAGE_BULK_EP_MPS];
+static uint8_t __aligned(4) bufs[2][BUF_SIZE + CONFIG_MASS_STORAGE_BULK_EP_MPS];
+
+/* Bytes of the buffers to send or to write to the disk, 0 if free */
+static volatile uint32_t buf_len[2];
+/* Buffer transferred over USB, and offset of the transfer in it */
+static uint8_t usb_idx;
+static uint32_t usb_off;
+/* Bytes of the last write on the IN endpoint */
+static uint32_t usb_sent;
+/* Bytes received past the end of the previous buffer */
+static uint32_t usb_overflow;
+/* USB waits for the disk thread to fill or to free a buffer */
+static volatile bool usb_wait;
+/* Reception stopped on the OUT endpoint until a buffer is free */
+static bool rx_stopped;
+/* Buffer read from or written to the disk, next block and blocks left */
+static uint8_t disk_idx;
+static uint32_t disk_lba;
+static volatile uint32_t disk_blocks;
+/* A disk access of the current command failed */
+static volatile bool disk_failed;
 
 /* Initialized during mass_storage_init() */
 static uint32_t memory_size;
@@ -130,6 +154,7 @@ static void mass_storage_bulk_out(uint8_t ep,
 				  enum usb_dc_ep_cb_status_code ep_status);
 static void mass_storage_bulk_in(uint8_t ep,
 				 enum usb_dc_ep_cb_status_code ep_status);
+static void fail(void);
 
 /* Describe EndPoints configuration */
 static struct usb_ep_cfg_data mass_ep_data[] = {
@@ -215,9 +240,29 @@ static void msd_init(void)
 {
 	(void)memset((void *)&cbw, 0, sizeof(struct CBW));
 	(void)memset((void *)&csw, 0, sizeof(struct CSW));
-	(void)memset(page, 0, sizeof(page));
+	(void)memset(bufs, 0, sizeof(bufs));
 	addr = 0U;
 	length = 0U;
+	buf_len[0] = 0U;
+	buf_len[1] = 0U;
+	disk_blocks = 0U;
+	usb_wait = false;
+	rx_stopped = false;
+}
+
+static void pipeline_start(void)
+{
+	buf_len[0] = 0U;
+	buf_len[1] = 0U;
+	usb_idx = 0U;
+	usb_off = 0U;
+	usb_sent = 0U;
+	usb_overflow = 0U;
+	rx_stopped = false;
+	disk_idx = 0U;
+	disk_lba = addr / BLOCK_SIZE;
+	disk_blocks = length / BLOCK_SIZE;
+	disk_failed = false;
 }
 
 static void sendCSW(void)
@@ -384,63 +429,108 @@ static bool readCapacity(void)
 	return write(capacity, sizeof(capacity));
 }
 
-static void thread_memory_read_done(void)
+static void memory_read_send(void)
 {
-	uint32_t n;
-
-	n = (length > MAX_PACKET) ? MAX_PACKET : length;
-	if ((addr + n) > memory_size) {
-		n = memory_size - addr;
-		stage = MSC_ERROR;
-	}
-
 	if (usb_write(mass_ep_data[MSD_IN_EP_IDX].ep_addr,
-		&page[addr % BLOCK_SIZE], n, NULL) != 0) {
+		      &bufs[usb_idx][usb_off], buf_len[usb_idx] - usb_off,
+		      &usb_sent) != 0) {
 		LOG_ERR("Failed to write EP 0x%x",
 			mass_ep_data[MSD_IN_EP_IDX].ep_addr);
+		usb_sent = 0U;
 	}
-	addr += n;
-	length -= n;
+}
 
-	csw.DataResidue -= n;
+static void thread_memory_read(void)
+{
+	unsigned int key;
+	uint32_t n;
 
-	if (!length || (stage != MSC_PROCESS_CBW)) {
-		csw.Status = (stage == MSC_PROCESS_CBW) ?
-			CSW_PASSED : CSW_FAILED;
-		stage = (stage == MSC_PROCESS_CBW) ? MSC_SEND_CSW : stage;
+	while (disk_blocks && !buf_len[disk_idx]) {
+		n = MIN(disk_blocks, CONFIG_MASS_STORAGE_BUF_BLOCKS);
+		if (disk_access_read(disk_pdrv, bufs[disk_idx], disk_lba, n)) {
+			LOG_ERR("!! Disk Read Error %d !", disk_lba);
+			disk_failed = true;
+		}
+
+		disk_lba += n;
+
+		key = irq_lock();
+
+		/* The device was reset meanwhile */
+		if (disk_blocks < n) {
+			irq_unlock(key);
+			break;
+		}
+
+		disk_blocks -= n;
+		buf_len[disk_idx] = n * BLOCK_SIZE;
+		disk_idx ^= 1U;
+
+		if (usb_wait) {
+			usb_wait = false;
+			memory_read_send();
+		}
+
+		irq_unlock(key);
 	}
 }
 
-
 static void memoryRead(void)
 {
-	uint32_t n;
+	if ((addr + length) > memory_size) {
+		LOG_WRN("Read past the end of the disk");
+		fail();
+		return;
+	}
 
-	n = (length > MAX_PACKET) ? MAX_PACKET : length;
-	if ((addr + n) > memory_size) {
-		n = memory_size - addr;
-		stage = MSC_ERROR;
+	pipeline_start();
+	usb_wait = true;
+
+	thread_op = THREAD_OP_READ_QUEUED;
+	LOG_DBG("Signal thread for %d", (addr/BLOCK_SIZE));
+	k_sem_give(&disk_wait_sem);
+}
+
+/* Called when the last write on the IN endpoint completed */
+static void memoryReadDone(void)
+{
+	unsigned int key;
+
+	key = irq_lock();
+
+	usb_off += usb_sent;
+	addr += usb_sent;
+	length -= usb_sent;
+	csw.DataResidue -= usb_sent;
+	usb_sent = 0U;
+
+	if (usb_off == buf_len[usb_idx]) {
+		/* Let the thread fill the buffer again */
+		buf_len[usb_idx] = 0U;
+		usb_idx ^= 1U;
+		usb_off = 0U;
+		if (disk_blocks) {
+			k_sem_give(&disk_wait_sem);
+		}
 	}
 
-	/* we read an entire block */
-	if (!(addr % BLOCK_SIZE)) {
-		thread_op = THREAD_OP_READ_QUEUED;
-		LOG_DBG("Signal thread for %d", (addr/BLOCK_SIZE));
-		k_sem_give(&disk_wait_sem);
-		return;
+	if (!length) {
+		csw.Status = disk_failed ? CSW_FAILED : CSW_PASSED;
+		sendCSW();
+	} else if (buf_len[usb_idx]) {
+		memory_read_send();
+	} else {
+		usb_wait = true;
 	}
-	usb_write(mass_ep_data[MSD_IN_EP_IDX].ep_addr,
-		  &page[addr % BLOCK_SIZE], n, NULL);
-	addr += n;
-	length -= n;
 
-	csw.DataResidue -= n;
+	irq_unlock(key);
+}
 
-	if (!length || (stage != MSC_PROCESS_CBW)) {
-		csw.Status = (stage == MSC_PROCESS_CBW) ?
-			CSW_PASSED : CSW_FAILED;
-		stage = (stage == MSC_PROCESS_CBW) ? MSC_SEND_CSW : stage;
-	}
+static void memoryWriteStart(void)
+{
+	pipeline_start();
+	usb_wait = false;
+	thread_op = THREAD_OP_WRITE_QUEUED;
 }
 
 static bool check_cbw_data_length(void)
@@ -598,6 +688,7 @@ static void CBWDecode(uint8_t *buf, uint16_t size)
 			if (infoTransfer()) {
 				if (!(cbw.Flags & 0x80)) {
 					stage = MSC_PROCESS_CBW;
+					memoryWriteStart();
 				} else {
 					usb_ep_set_stall(
 					  mass_ep_data[MSD_IN_EP_IDX].ep_addr);
@@ -655,14 +746,14 @@ static void memoryVerify(uint8_t *buf, uint16_t size)
 	/* beginning of a new block -> load a whole block in RAM */
 	if (!(addr % BLOCK_SIZE)) {
 		LOG_DBG("Disk READ sector %d", addr/BLOCK_SIZE);
-		if (disk_access_read(disk_pdrv, page, addr/BLOCK_SIZE, 1)) {
+		if (disk_access_read(disk_pdrv, bufs[0], addr/BLOCK_SIZE, 1)) {
 			LOG_ERR("---- Disk Read Error %d", addr/BLOCK_SIZE);
 		}
 	}
 
 	/* info are in RAM -> no need to re-read memory */
 	for (n = 0U; n < size; n++) {
-		if (page[addr%BLOCK_SIZE + n] != buf[n]) {
+		if (bufs[0][addr%BLOCK_SIZE + n] != buf[n]) {
 			LOG_DBG("Mismatch sector %d offset %d",
 				addr/BLOCK_SIZE, n);
 			memOK = false;
@@ -681,8 +772,19 @@ static void memoryVerify(uint8_t *buf, uint16_t size)
 	}
 }
 
+/* Continue the reception in the buffer the USB waits for */
+static void memory_write_next(void)
+{
+	memcpy(bufs[usb_idx], &bufs[usb_idx ^ 1U][BUF_SIZE], usb_overflow);
+	usb_off = usb_overflow;
+	usb_overflow = 0U;
+	usb_wait = false;
+}
+
 static void memoryWrite(uint8_t *buf, uint16_t size)
 {
+	unsigned int key;
+
 	if ((addr + size) > memory_size) {
 		size = memory_size - addr;
 		stage = MSC_ERROR;
@@ -690,30 +792,88 @@ static void memoryWrite(uint8_t *buf, uint16_t size)
 		LOG_WRN("Stall OUT endpoint");
 	}
 
-	/* we fill an array in RAM of 1 block before writing it in memory */
-	for (int i = 0; i < size; i++) {
-		page[addr % BLOCK_SIZE + i] = buf[i];
+	/* we fill a buffer in RAM before writing it in memory */
+	memcpy(&bufs[usb_idx][usb_off], buf, size);
+	usb_off += size;
+	addr += size;
+	length -= size;
+	csw.DataResidue -= size;
+
+	if (stage != MSC_PROCESS_CBW) {
+		csw.Status = CSW_FAILED;
+		sendCSW();
+		return;
+	}
+
+	if ((usb_off < BUF_SIZE) && length) {
+		return;
+	}
+
+	key = irq_lock();
+
+	/* if the buffer is filled, hand it to the thread */
+	buf_len[usb_idx] = MIN(usb_off, BUF_SIZE);
+	usb_overflow = usb_off - buf_len[usb_idx];
+	usb_idx ^= 1U;
+	usb_off = 0U;
+	LOG_DBG("Disk WRITE Qd %d", disk_lba);
+	k_sem_give(&disk_wait_sem);
+
+	/* The CSW is sent by the thread once the data is written */
+	if (length) {
+		if (buf_len[usb_idx]) {
+			usb_wait = true;
+		} else {
+			memory_write_next();
+		}
 	}
 
-	/* if the array is filled, write it in memory */
-	if ((addr % BLOCK_SIZE) + size >= BLOCK_SIZE) {
+	irq_unlock(key);
+}
+
+static void thread_memory_write(void)
+{
+	unsigned int key;
+	uint32_t n;
+	bool done;
+
+	while (buf_len[disk_idx]) {
+		n = buf_len[disk_idx] / BLOCK_SIZE;
 		if (!(disk_access_status(disk_pdrv) &
 					DISK_STATUS_WR_PROTECT)) {
-			LOG_DBG("Disk WRITE Qd %d", (addr/BLOCK_SIZE));
-			thread_op = THREAD_OP_WRITE_QUEUED;  /* write_queued */
-			defered_wr_sz = size;
-			k_sem_give(&disk_wait_sem);
-			return;
+			if (disk_access_write(disk_pdrv, bufs[disk_idx],
+					      disk_lba, n)) {
+				LOG_ERR("!!!!! Disk Write Error %d !!!!!",
+					disk_lba);
+				disk_failed = true;
+			}
 		}
-	}
 
-	addr += size;
-	length -= size;
-	csw.DataResidue -= size;
+		disk_lba += n;
 
-	if ((!length) || (stage != MSC_PROCESS_CBW)) {
-		csw.Status = (stage == MSC_ERROR) ? CSW_FAILED : CSW_PASSED;
-		sendCSW();
+		key = irq_lock();
+
+		buf_len[disk_idx] = 0U;
+		disk_idx ^= 1U;
+
+		if (usb_wait) {
+			memory_write_next();
+			if (rx_stopped) {
+				rx_stopped = false;
+				usb_ep_read_continue(
+					mass_ep_data[MSD_OUT_EP_IDX].ep_addr);
+			}
+		}
+
+		done = (stage == MSC_PROCESS_CBW) && !length &&
+		       !buf_len[disk_idx];
+
+		irq_unlock(key);
+
+		if (done) {
+			csw.Status = disk_failed ? CSW_FAILED : CSW_PASSED;
+			sendCSW();
+		}
 	}
 }
 
@@ -723,6 +883,7 @@ static void mass_storage_bulk_out(uint8_t ep,
 {
 	uint32_t bytes_read = 0U;
 	uint8_t bo_buf[CONFIG_MASS_STORAGE_BULK_EP_MPS];
+	unsigned int key;
 
 	ARG_UNUSED(ep_status);
 
@@ -763,36 +924,16 @@ static void mass_storage_bulk_out(uint8_t ep,
 		break;
 	}
 
-	if (thread_op != THREAD_OP_WRITE_QUEUED) {
+	key = irq_lock();
+
+	if (!usb_wait) {
 		usb_ep_read_continue(ep);
 	} else {
 		LOG_DBG("> BO not clearing NAKs yet");
+		rx_stopped = true;
 	}
 
-}
-
-static void thread_memory_write_done(void)
-{
-	uint32_t size = defered_wr_sz;
-	size_t overflowed_len = (addr + size) % CONFIG_MASS_STORAGE_BULK_EP_MPS;
-
-	if (overflowed_len) {
-		memmove(page, &page[BLOCK_SIZE], overflowed_len);
-	}
-
-	addr += size;
-	length -= size;
-	csw.DataResidue -= size;
-
-
-	if ((!length) || (stage != MSC_PROCESS_CBW)) {
-		csw.Status = (stage == MSC_ERROR) ? CSW_FAILED : CSW_PASSED;
-		sendCSW();
-	}
-
-	thread_op = THREAD_OP_WRITE_DONE;
-
-	usb_ep_read_continue(mass_ep_data[MSD_OUT_EP_IDX].ep_addr);
+	irq_unlock(key);
 }
 
 /**
@@ -816,7 +957,7 @@ static void mass_storage_bulk_in(uint8_t ep,
 		case READ10:
 		case READ12:
 			/* LOG_DBG("< BI - PROC_CBW  READ"); */
-			memoryRead();
+			memoryReadDone();
 			break;
 		default:
 			LOG_ERR("< BI-PROC_CBW default <<ERROR!!>>");
@@ -931,21 +1072,10 @@ static void mass_thread_main(int arg1, int unused)
 
 		switch (thread_op) {
 		case THREAD_OP_READ_QUEUED:
-			if (disk_access_read(disk_pdrv,
-						page, (addr/BLOCK_SIZE), 1)) {
-				LOG_ERR("!! Disk Read Error %d !",
-					addr/BLOCK_SIZE);
-			}
-
-			thread_memory_read_done();
+			thread_memory_read();
 			break;
 		case THREAD_OP_WRITE_QUEUED:
-			if (disk_access_write(disk_pdrv,
-						page, (addr/BLOCK_SIZE), 1)) {
-				LOG_ERR("!!!!! Disk Write Error %d !!!!!",
-					addr/BLOCK_SIZE);
-			}
-			thread_memory_write_done();
+			thread_memory_write();
 			break;
 		default:
 			LOG_ERR("XXXXXX thread_op  %d ! XXXXX", thread_op);
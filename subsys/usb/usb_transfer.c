@@ -42,21 +42,89 @@ struct usb_transfer_data {
 	struct k_work work;
 	/** Transfer flags */
 	unsigned int flags;
+	/** Queuing order, while the transfer is queued */
+	uint32_t seq;
 };
 
+/* Status of the transfers queued behind an ongoing one */
+#define USB_TRANSFER_QUEUED -EINPROGRESS
+
 /** Max number of parallel transfers */
 static struct usb_transfer_data ut_data[CONFIG_USB_MAX_NUM_TRANSFERS];
 
+static uint32_t ut_seq;
+
 /* Transfer management */
 static struct usb_transfer_data *usb_ep_get_transfer(uint8_t ep)
 {
+	struct usb_transfer_data *trans = NULL;
+
 	for (int i = 0; i < ARRAY_SIZE(ut_data); i++) {
-		if (ut_data[i].ep == ep && ut_data[i].status != 0) {
+		if (ut_data[i].ep != ep || ut_data[i].status == 0 ||
+		    ut_data[i].status == USB_TRANSFER_QUEUED) {
+			continue;
+		}
+
+		/* The ongoing transfer first */
+		if (ut_data[i].status == -EBUSY) {
 			return &ut_data[i];
 		}
+
+		if (trans == NULL) {
+			trans = &ut_data[i];
+		}
+	}
+
+	return trans;
+}
+
+/* Oldest transfer queued on the endpoint */
+static struct usb_transfer_data *usb_ep_get_queued(uint8_t ep)
+{
+	struct usb_transfer_data *trans = NULL;
+
+	for (int i = 0; i < ARRAY_SIZE(ut_data); i++) {
+		if (ut_data[i].ep != ep ||
+		    ut_data[i].status != USB_TRANSFER_QUEUED) {
+			continue;
+		}
+
+		if (trans == NULL || (int32_t)(ut_data[i].seq - trans->seq) < 0) {
+			trans = &ut_data[i];
+		}
 	}
 
-	return NULL;
+	return trans;
+}
+
+static int usb_transfer_start(struct usb_transfer_data *trans)
+{
+	trans->status = -EBUSY;
+
+	if (trans->flags & USB_TRANS_WRITE) {
+		/* start writing first chunk */
+		k_work_submit_to_queue(&USB_WORK_Q, &trans->work);
+		return 0;
+	}
+
+	/* ready to read, clear NAK */
+	return usb_dc_ep_read_continue(trans->ep);
+}
+
+static void usb_transfer_start_queued(uint8_t ep)
+{
+	struct usb_transfer_data *trans;
+	unsigned int key;
+
+	key = irq_lock();
+
+	trans = usb_ep_get_queued(ep);
+	if (trans != NULL) {
+		LOG_DBG("Queued transfer start, ep 0x%02x", ep);
+		(void)usb_transfer_start(trans);
+	}
+
+	irq_unlock(key);
 }
 
 bool usb_transfer_is_busy(uint8_t ep)
@@ -150,6 +218,9 @@ done:
 		trans->cb = NULL;
 		k_sem_give(&trans->sem);
 
+		/* Keep the endpoint busy while the callback runs */
+		usb_transfer_start_queued(ep);
+
 		/* Transfer completion callback */
 		if (trans->status != -ECANCELED) {
 			cb(ep, tsize, priv);
@@ -200,8 +271,8 @@ int usb_transfer(uint8_t ep, uint8_t *data, size_t dlen, unsigned int flags,
 	struct usb_transfer_data *trans = NULL;
 	int i, key, ret = 0;
 
-	/* Parallel transfer to same endpoint is not supported. */
-	if (usb_transfer_is_busy(ep)) {
+	/* Parallel transfer to same endpoint is not supported, unless queued. */
+	if (!(flags & USB_TRANS_QUEUE) && usb_transfer_is_busy(ep)) {
 		return -EBUSY;
 	}
 
@@ -239,21 +310,26 @@ int usb_transfer(uint8_t ep, uint8_t *data, size_t dlen, unsigned int flags,
 	trans->cb = cb;
 	trans->flags = flags;
 	trans->priv = cb_data;
-	trans->status = -EBUSY;
 
 	if (usb_dc_ep_mps(ep) && (dlen % usb_dc_ep_mps(ep))) {
 		/* no need to send ZLP since last packet will be a short one */
 		trans->flags |= USB_TRANS_NO_ZLP;
 	}
 
-	if (flags & USB_TRANS_WRITE) {
-		/* start writing first chunk */
-		k_work_submit_to_queue(&USB_WORK_Q, &trans->work);
-	} else {
-		/* ready to read, clear NAK */
-		ret = usb_dc_ep_read_continue(ep);
+	/* Behind the ongoing transfer and the ones queued before, the
+	 * latter may be waiting for the completion of the former to be
+	 * processed.
+	 */
+	if ((flags & USB_TRANS_QUEUE) &&
+	    (usb_transfer_is_busy(ep) || usb_ep_get_queued(ep) != NULL)) {
+		LOG_DBG("Transfer queued, ep 0x%02x", ep);
+		trans->seq = ut_seq++;
+		trans->status = USB_TRANSFER_QUEUED;
+		goto done;
 	}
 
+	ret = usb_transfer_start(trans);
+
 done:
 	irq_unlock(key);
 	return ret;
@@ -266,6 +342,12 @@ void usb_cancel_transfer(uint8_t ep)
 
 	key = irq_lock();
 
+	/* Cancel the queued transfers first, so that none is started */
+	while ((trans = usb_ep_get_queued(ep)) != NULL) {
+		trans->status = -ECANCELED;
+		k_work_submit_to_queue(&USB_WORK_Q, &trans->work);
+	}
+
 	trans = usb_ep_get_transfer(ep);
 	if (!trans) {
 		goto done;
@@ -290,7 +372,8 @@ void usb_cancel_transfers(void)
 
 		key = irq_lock();
 
-		if (trans->status == -EBUSY) {
+		if (trans->status == -EBUSY ||
+		    trans->status == USB_TRANSFER_QUEUED) {
 			trans->status = -ECANCELED;
 			k_work_submit_to_queue(&USB_WORK_Q, &trans->work);
 			LOG_DBG("Cancel transfer for ep: 0x%02x", trans->ep);
@@ -331,6 +414,10 @@ int usb_transfer_sync(uint8_t ep, uint8_t *data, size_t dlen, unsigned int flags
 			break;
 		}
 
+		if (usb_ep_get_queued(ep) != NULL) {
+			continue;
+		}
+
 		trans = usb_ep_get_transfer(ep);
 		if (!trans || trans->status != -EBUSY) {
 			LOG_WRN("Sync transfer cancelled, ep 0x%02x", ep);
@@ -10,6 +10,66 @@
 
 #ifdef FIFO_BENCH
 
+#define FIFO_BATCH_LEN 16
+
+static K_FIFO_DEFINE(bench_fifo);
+static sys_snode_t bench_items[NR_OF_FIFO_RUNS];
+
+static void fifo_fill(void)
+{
+	for (int i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		k_fifo_put(&bench_fifo, &bench_items[i]);
+	}
+}
+
+/**
+ *
+ * @brief k_fifo dequeue speed test, item by item and in batches
+ *
+ * @return N/A
+ */
+static void fifo_batch_test(void)
+{
+	uint32_t et; /* elapsed time */
+	sys_slist_t list;
+	int i;
+
+	fifo_fill();
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		k_fifo_get(&bench_fifo, K_FOREVER);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT, "dequeue 1 item from k_fifo",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	fifo_fill();
+	sys_slist_init(&list);
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i += FIFO_BATCH_LEN) {
+		k_fifo_get_batch(&bench_fifo, &list, FIFO_BATCH_LEN, K_FOREVER);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT,
+			"dequeue items from k_fifo in batches of 16 (per item)",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	fifo_fill();
+	sys_slist_init(&list);
+	et = BENCH_START();
+	k_fifo_get_all(&bench_fifo, &list, K_FOREVER);
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT,
+			"dequeue all items from k_fifo at once (per item)",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+}
+
 /**
  *
  * @brief Queue transfer speed test
@@ -61,6 +121,8 @@ void queue_test(void)
 	PRINT_F(output_file, FORMAT, "dequeue 4 bytes msg in FIFO",
 			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
 
+	fifo_batch_test();
+
 	k_sem_give(&STARTRCV);
 
 	et = BENCH_START();
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+#define CONFIG_BT_LOG_LEVEL 1
+#if defined(CONFIG_BENCHMARK_TICKER_ENQUEUE_INDEX)
+#define CONFIG_BT_TICKER_ENQUEUE_INDEX 1
+#endif
+
+#include "ticker/ticker.c"
+
+/* Ticker benchmark.  The BLE controller ticker is built on its own, with
+ * a counter which only moves when told to.  For each number of nodes,
+ * periodic ticker nodes with a spread of connection-like intervals are
+ * started, then the ticker is run from one expiry to the next, and the
+ * time ticker_job takes to insert the started and the expired nodes back
+ * into the list is printed.
+ */
+
+#define NODE_COUNTS { 16, 64, 128, 250 }
+#define NODES_MAX 250
+#define OPS_MAX (NODES_MAX + 1)
+#define EXPIRIES 1000
+
+static struct ticker_node nodes[NODES_MAX];
+static struct ticker_user users[1];
+static struct ticker_user_op user_ops[OPS_MAX];
+static uint32_t cntr;
+
+uint32_t cntr_cnt_get(void)
+{
+	return cntr;
+}
+
+uint32_t cntr_start(void)
+{
+	return 0;
+}
+
+uint32_t cntr_stop(void)
+{
+	return 0;
+}
+
+static uint8_t caller_id_get(uint8_t user_id)
+{
+	return TICKER_CALL_ID_PROGRAM;
+}
+
+static void sched(uint8_t caller_id, uint8_t callee_id, uint8_t chain,
+		  void *instance)
+{
+	/* The worker and the job are run by the benchmark */
+}
+
+static void trigger_set(uint32_t value)
+{
+}
+
+static void timeout(uint32_t ticks_at_expire, uint32_t remainder,
+		    uint16_t lazy, uint8_t force, void *context)
+{
+}
+
+static uint32_t elapsed_us(uint32_t start)
+{
+	return k_cyc_to_us_floor32(k_cycle_get_32() - start);
+}
+
+static void bench_ticker(uint8_t count)
+{
+	struct ticker_instance *instance = &_instance[0];
+	uint32_t start, us, start_us, total = 0U, max = 0U;
+	uint32_t err;
+
+	cntr = 0U;
+	users[0].count_user_op = count + 1;
+	err = ticker_init(0, count, nodes, 1, users, count + 1, user_ops,
+			  caller_id_get, sched, trigger_set);
+	__ASSERT_NO_MSG(err == TICKER_STATUS_SUCCESS);
+
+	/* Intervals from 7.5 to 26.25 ms, with the first expiries spread
+	 * over the shortest one.
+	 */
+	for (uint8_t i = 0; i < count; i++) {
+		err = ticker_start(0, 0, i, 0,
+				   HAL_TICKER_US_TO_TICKS(1000 + i * 25),
+				   HAL_TICKER_US_TO_TICKS(7500 + (i % 16) * 1250),
+				   TICKER_NULL_REMAINDER, TICKER_NULL_LAZY,
+				   TICKER_NULL_SLOT, timeout, NULL, NULL,
+				   NULL);
+		__ASSERT_NO_MSG(err == TICKER_STATUS_SUCCESS);
+	}
+
+	start = k_cycle_get_32();
+	ticker_job(instance);
+	start_us = elapsed_us(start);
+
+	for (int i = 0; i < EXPIRIES; i++) {
+		uint8_t head = instance->ticker_id_head;
+
+		cntr = (instance->ticks_current +
+			nodes[head].ticks_to_expire) & HAL_TICKER_CNTR_MASK;
+		ticker_worker(instance);
+
+		start = k_cycle_get_32();
+		ticker_job(instance);
+		us = elapsed_us(start);
+
+		total += us;
+		max = MAX(max, us);
+	}
+
+	printk("nodes %u start us %u job avg us %u max us %u\n", count,
+	       start_us, total / EXPIRIES, max);
+}
+
+void main(void)
+{
+	static const uint8_t counts[] = NODE_COUNTS;
+
+	printk("ticker enqueue index %s\n",
+	       IS_ENABLED(CONFIG_BENCHMARK_TICKER_ENQUEUE_INDEX) ?
+	       "on" : "off");
+
+	for (int i = 0; i < ARRAY_SIZE(counts); i++) {
+		bench_ticker(counts[i]);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zephyr.h>
+#include <sys/vecmath.h>
+#include "../../common/benchmark_common.h"
+
+#define PATTERN_LENGTH	(256)
+#define FIR_TAPS	(32)
+
+static int16_t input1[PATTERN_LENGTH];
+static int16_t input2[PATTERN_LENGTH];
+static int16_t output[PATTERN_LENGTH];
+static int32_t output_q31[PATTERN_LENGTH];
+
+static int16_t fir_coeffs[VECMATH_FIR_Q15_COEFFS_LEN(FIR_TAPS)];
+static int16_t fir_state[VECMATH_FIR_Q15_STATE_LEN(FIR_TAPS, PATTERN_LENGTH)];
+
+static void pattern_fill(int16_t *buf, size_t len, uint32_t seed)
+{
+	for (size_t i = 0; i < len; i++) {
+		seed = seed * 1103515245U + 12345U;
+		buf[i] = (int16_t)(seed >> 16);
+	}
+}
+
+static void result_check(uint32_t timespan, uint32_t budget)
+{
+	/* Print result */
+	TC_PRINT(BENCHMARK_TYPE " = %u\n", timespan);
+
+	if (budget != 0U) {
+		zassert_true(timespan <= budget, "over the budget of %u",
+			     budget);
+	}
+}
+
+void test_benchmark_vecmath_dot_q15(void)
+{
+	uint32_t irq_key, timestamp, timespan;
+	volatile int64_t result;
+
+	/* Begin benchmark */
+	benchmark_begin(&irq_key, &timestamp);
+
+	/* Execute function */
+	result = vecmath_dot_q15(input1, input2, PATTERN_LENGTH);
+
+	/* End benchmark */
+	timespan = benchmark_end(irq_key, timestamp);
+
+	ARG_UNUSED(result);
+
+	result_check(timespan, CONFIG_BENCHMARK_VECMATH_DOT_MAX_CYCLES);
+}
+
+void test_benchmark_vecmath_copy_scale_q15(void)
+{
+	uint32_t irq_key, timestamp, timespan;
+
+	/* Begin benchmark */
+	benchmark_begin(&irq_key, &timestamp);
+
+	/* Execute function */
+	vecmath_copy_scale_q15(output, input1, 0x5a82, 1, PATTERN_LENGTH);
+
+	/* End benchmark */
+	timespan = benchmark_end(irq_key, timestamp);
+
+	result_check(timespan, CONFIG_BENCHMARK_VECMATH_SCALE_MAX_CYCLES);
+}
+
+void test_benchmark_vecmath_q15_to_q31(void)
+{
+	uint32_t irq_key, timestamp, timespan;
+
+	/* Begin benchmark */
+	benchmark_begin(&irq_key, &timestamp);
+
+	/* Execute function */
+	vecmath_q15_to_q31(output_q31, input1, PATTERN_LENGTH);
+
+	/* End benchmark */
+	timespan = benchmark_end(irq_key, timestamp);
+
+	result_check(timespan, CONFIG_BENCHMARK_VECMATH_CONVERT_MAX_CYCLES);
+}
+
+void test_benchmark_vecmath_fir_q15(void)
+{
+	uint32_t irq_key, timestamp, timespan;
+	struct vecmath_fir_q15 fir;
+	int ret;
+
+	ret = vecmath_fir_q15_init(&fir, fir_coeffs, FIR_TAPS, fir_state,
+				   PATTERN_LENGTH);
+	zassert_equal(ret, 0, "FIR filter initialization failed");
+
+	/* Begin benchmark */
+	benchmark_begin(&irq_key, &timestamp);
+
+	/* Execute function */
+	vecmath_fir_q15(&fir, output, input1, PATTERN_LENGTH);
+
+	/* End benchmark */
+	timespan = benchmark_end(irq_key, timestamp);
+
+	result_check(timespan, CONFIG_BENCHMARK_VECMATH_FIR_MAX_CYCLES);
+}
+
+void test_main(void)
+{
+	pattern_fill(input1, PATTERN_LENGTH, 1);
+	pattern_fill(input2, PATTERN_LENGTH, 2);
+	pattern_fill(fir_coeffs, FIR_TAPS, 3);
+
+	ztest_test_suite(benchmark_vecmath,
+			 ztest_unit_test(test_benchmark_vecmath_dot_q15),
+			 ztest_unit_test(test_benchmark_vecmath_copy_scale_q15),
+			 ztest_unit_test(test_benchmark_vecmath_q15_to_q31),
+			 ztest_unit_test(test_benchmark_vecmath_fir_q15));
+	ztest_run_test_suite(benchmark_vecmath);
+}
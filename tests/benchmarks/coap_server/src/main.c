@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/coap.h>
+
+/* CoAP server request dispatch benchmark.  GET requests are parsed and
+ * handed to the library, which finds the resource of their path, with
+ * a table of resources growing from one to MAX_RESOURCES, once with a
+ * scan of the table and once with a resource index.
+ */
+
+#define MAX_RESOURCES 512
+#define REQUESTS 20000
+#define SEGMENT_LEN 4
+
+static char segments[MAX_RESOURCES][SEGMENT_LEN];
+static const char *paths[MAX_RESOURCES][4];
+static struct coap_resource resources[MAX_RESOURCES + 1];
+/* The root, "sensors", each number and its "value" */
+static struct coap_resource_index_node nodes[2 + 2 * MAX_RESOURCES];
+static uint8_t requests[MAX_RESOURCES + 1][32];
+static uint16_t request_lens[MAX_RESOURCES + 1];
+static volatile uint32_t handled;
+
+static int bench_get(struct coap_resource *resource,
+		     struct coap_packet *request,
+		     struct sockaddr *addr, socklen_t addr_len)
+{
+	handled++;
+
+	return 0;
+}
+
+static int build_request(int i, const char *number)
+{
+	struct coap_packet req;
+	int r;
+
+	r = coap_packet_init(&req, requests[i], sizeof(requests[i]),
+			     COAP_VERSION_1, COAP_TYPE_NON_CON, 0, NULL,
+			     COAP_METHOD_GET, coap_next_id());
+	if (r < 0) {
+		return r;
+	}
+
+	r = coap_packet_append_option(&req, COAP_OPTION_URI_PATH,
+				      "sensors", strlen("sensors"));
+	if (r < 0) {
+		return r;
+	}
+
+	r = coap_packet_append_option(&req, COAP_OPTION_URI_PATH, number,
+				      strlen(number));
+	if (r < 0) {
+		return r;
+	}
+
+	r = coap_packet_append_option(&req, COAP_OPTION_URI_PATH, "value",
+				      strlen("value"));
+	if (r < 0) {
+		return r;
+	}
+
+	request_lens[i] = req.offset;
+
+	return 0;
+}
+
+static void add_resource(int i)
+{
+	snprintk(segments[i], SEGMENT_LEN, "%d", i);
+
+	paths[i][0] = "sensors";
+	paths[i][1] = segments[i];
+	paths[i][2] = "value";
+	paths[i][3] = NULL;
+
+	resources[i].path = paths[i];
+	resources[i].get = bench_get;
+}
+
+static uint32_t run_requests(int n, const struct coap_resource_index *index)
+{
+	struct sockaddr_in6 addr = { .sin6_family = AF_INET6 };
+	struct coap_option options[4];
+	struct coap_packet req;
+	uint32_t start, cycles;
+	uint8_t buf[32];
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < REQUESTS; i++) {
+		/* One request in eight is for a missing resource */
+		int r = (i & 7) == 7 ? MAX_RESOURCES : i % n;
+
+		/* The request is parsed in place, as a server would do */
+		memcpy(buf, requests[r], request_lens[r]);
+		if (coap_packet_parse(&req, buf, request_lens[r], options,
+				      ARRAY_SIZE(options)) < 0) {
+			continue;
+		}
+
+		if (index) {
+			(void)coap_handle_request_index(
+				&req, index, options, ARRAY_SIZE(options),
+				(struct sockaddr *)&addr, sizeof(addr));
+		} else {
+			(void)coap_handle_request(
+				&req, resources, options, ARRAY_SIZE(options),
+				(struct sockaddr *)&addr, sizeof(addr));
+		}
+	}
+
+	cycles = MAX(k_cycle_get_32() - start, 1U);
+
+	return (uint32_t)(((uint64_t)REQUESTS * sys_clock_hw_cycles_per_sec()) /
+			  cycles);
+}
+
+void main(void)
+{
+	struct coap_resource_index index;
+	uint32_t scan_rate, index_rate;
+	int n = 0;
+
+	for (int i = 0; i < MAX_RESOURCES; i++) {
+		char number[SEGMENT_LEN];
+
+		snprintk(number, sizeof(number), "%d", i);
+		if (build_request(i, number) < 0) {
+			printk("cannot build request %d\n", i);
+			return;
+		}
+	}
+
+	if (build_request(MAX_RESOURCES, "x") < 0) {
+		printk("cannot build the missing request\n");
+		return;
+	}
+
+	for (int size = 1; size <= MAX_RESOURCES; size *= 2) {
+		for (; n < size; n++) {
+			add_resource(n);
+		}
+
+		if (coap_resource_index_init(&index, resources, nodes,
+					     ARRAY_SIZE(nodes)) < 0) {
+			printk("cannot index %d resources\n", n);
+			return;
+		}
+
+		scan_rate = run_requests(n, NULL);
+		index_rate = run_requests(n, &index);
+
+		printk("resources %d scan req/s %u index req/s %u\n", n,
+		       scan_rate, index_rate);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <list>
+#include <memory>
+#include <cpp/memory_resource.hpp>
+
+using namespace zephyr::pmr;
+
+#define ROUNDS 64
+#define BLOCKS 32
+#define BLOCK_SIZE 32
+
+K_HEAP_DEFINE(bench_heap, 4096);
+K_MEM_SLAB_DEFINE(bench_slab, BLOCK_SIZE, BLOCKS, 8);
+
+static void *blocks[BLOCKS];
+
+/* Resource allocating with the global operator new, for the reference */
+static memory_resource *const new_res = new_delete_resource();
+
+/* Cycles per allocation and free */
+static uint32_t run_alloc(memory_resource *res, monotonic_resource *arena)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int r = 0; r < ROUNDS; r++) {
+		for (int i = 0; i < BLOCKS; i++) {
+			blocks[i] = res->allocate(BLOCK_SIZE, 8);
+		}
+
+		for (int i = 0; i < BLOCKS; i++) {
+			res->deallocate(blocks[i], BLOCK_SIZE, 8);
+		}
+
+		if (arena != nullptr) {
+			arena->release();
+		}
+	}
+
+	return (k_cycle_get_32() - start) / (ROUNDS * BLOCKS);
+}
+
+/* Cycles per element insertion and removal */
+static uint32_t run_list(memory_resource *res, monotonic_resource *arena)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int r = 0; r < ROUNDS; r++) {
+		std::list<int, polymorphic_allocator<int>> list(res);
+
+		for (int i = 0; i < BLOCKS; i++) {
+			list.push_back(i);
+		}
+
+		while (!list.empty()) {
+			list.pop_front();
+		}
+
+		if (arena != nullptr) {
+			arena->release();
+		}
+	}
+
+	return (k_cycle_get_32() - start) / (ROUNDS * BLOCKS);
+}
+
+static uint32_t run_list_default(void)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int r = 0; r < ROUNDS; r++) {
+		std::list<int> list;
+
+		for (int i = 0; i < BLOCKS; i++) {
+			list.push_back(i);
+		}
+
+		while (!list.empty()) {
+			list.pop_front();
+		}
+	}
+
+	return (k_cycle_get_32() - start) / (ROUNDS * BLOCKS);
+}
+
+void main(void)
+{
+	static monotonic_arena<BLOCKS * BLOCK_SIZE> arena;
+	heap_resource heap(&bench_heap);
+	slab_resource slab(&bench_slab);
+	struct {
+		const char *name;
+		memory_resource *res;
+		monotonic_resource *arena;
+	} resources[] = {
+		{ "new", new_res, nullptr },
+		{ "heap", &heap, nullptr },
+		{ "slab", &slab, nullptr },
+		{ "monotonic", &arena, &arena },
+	};
+
+	/* Warm the allocators up, e.g. for the C library to get its heap */
+	for (auto &r : resources) {
+		run_alloc(r.res, r.arena);
+	}
+
+	for (auto &r : resources) {
+		printk("%-12s alloc %u cycles/op\n", r.name,
+		       run_alloc(r.res, r.arena));
+	}
+
+	printk("%-12s list  %u cycles/op\n", "std", run_list_default());
+
+	for (auto &r : resources) {
+		printk("%-12s list  %u cycles/op\n", r.name,
+		       run_list(r.res, r.arena));
+	}
+
+	printk("fin\n");
+}
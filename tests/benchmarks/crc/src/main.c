@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <sys/crc.h>
+#include <random/rand32.h>
+
+#define ROUNDS 200
+
+static const size_t lens[] = { 8, 64, 256, 1024, 4096 };
+static uint8_t data[4096];
+
+static uint32_t bench_crc32_ieee(const uint8_t *buf, size_t len)
+{
+	return crc32_ieee(buf, len);
+}
+
+static uint32_t bench_crc32_c(const uint8_t *buf, size_t len)
+{
+	return crc32_c(0, buf, len, true, true);
+}
+
+static uint32_t bench_crc16_ccitt(const uint8_t *buf, size_t len)
+{
+	return crc16_ccitt(0, buf, len);
+}
+
+static uint32_t bench_crc8_ccitt(const uint8_t *buf, size_t len)
+{
+	return crc8_ccitt(CRC8_CCITT_INITIAL_VALUE, buf, len);
+}
+
+static const struct {
+	const char *name;
+	uint32_t (*crc)(const uint8_t *buf, size_t len);
+	/* CRC of "123456789" */
+	uint32_t check;
+} algos[] = {
+	{ "crc32_ieee", bench_crc32_ieee, 0xcbf43926 },
+	{ "crc32_c", bench_crc32_c, 0xe3069283 },
+	{ "crc16_ccitt", bench_crc16_ccitt, 0x2189 },
+	{ "crc8_ccitt", bench_crc8_ccitt, 0xfb },
+};
+
+/* Cycles per byte, times 100 */
+static uint32_t run(uint32_t (*crc)(const uint8_t *buf, size_t len),
+		    size_t len)
+{
+	volatile uint32_t sink;
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ROUNDS; i++) {
+		sink = crc(data, len);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	return (uint32_t)((uint64_t)cycles * 100U / ((uint64_t)ROUNDS * len));
+}
+
+void main(void)
+{
+	static const uint8_t check[] = "123456789";
+
+	for (int i = 0; i < ARRAY_SIZE(algos); i++) {
+		uint32_t crc = algos[i].crc(check, sizeof(check) - 1);
+
+		if (crc != algos[i].check) {
+			printk("%s check 0x%x, expected 0x%x\n", algos[i].name,
+			       crc, algos[i].check);
+			return;
+		}
+	}
+
+	sys_rand_get(data, sizeof(data));
+
+	for (int i = 0; i < ARRAY_SIZE(algos); i++) {
+		for (int j = 0; j < ARRAY_SIZE(lens); j++) {
+			uint32_t cpb = run(algos[i].crc, lens[j]);
+
+			printk("%-11s len %4zu %2u.%02u cycles/byte\n",
+			       algos[i].name, lens[j], cpb / 100U, cpb % 100U);
+		}
+	}
+
+	printk("fin\n");
+}
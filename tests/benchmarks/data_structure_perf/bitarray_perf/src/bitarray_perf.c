@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief bit array allocation benchmark
+ *
+ * @defgroup lib_bitarray_perf_tests Bitarray
+ */
+
+#include <ztest.h>
+#include <sys/bitarray.h>
+#include <random/rand32.h>
+
+#define NUM_BITS 4096
+#define ROUNDS 2000
+
+SYS_BITARRAY_DEFINE(ba, NUM_BITS);
+
+/* First fit, one bit at a time */
+static int ref_alloc(size_t num_bits, size_t *offset)
+{
+	for (size_t start = 0; start + num_bits <= NUM_BITS; start++) {
+		if (sys_bitarray_is_region_cleared(&ba, num_bits, start)) {
+			*offset = start;
+			return 0;
+		}
+	}
+
+	return -ENOSPC;
+}
+
+static void ba_reset(void)
+{
+	(void)sys_bitarray_clear_region(&ba, NUM_BITS, 0);
+}
+
+/**
+ * @brief Test that the allocations are first fit
+ *
+ * @details Allocate and free random regions, checking each allocation
+ * against a bit at a time first fit search.
+ *
+ * @ingroup lib_bitarray_perf_tests
+ *
+ * @see sys_bitarray_alloc(), sys_bitarray_free()
+ */
+void test_bitarray_first_fit(void)
+{
+	static struct {
+		size_t offset;
+		size_t num_bits;
+	} regions[64];
+	size_t expected, offset;
+	int ret, ref;
+
+	ba_reset();
+
+	for (int i = 0; i < ROUNDS; i++) {
+		int r = sys_rand32_get() % ARRAY_SIZE(regions);
+
+		if (regions[r].num_bits != 0) {
+			zassert_equal(sys_bitarray_free(&ba, regions[r].num_bits,
+							regions[r].offset),
+				      0, "free failed");
+			regions[r].num_bits = 0;
+			continue;
+		}
+
+		regions[r].num_bits = 1 + sys_rand32_get() % 128;
+		ref = ref_alloc(regions[r].num_bits, &expected);
+		ret = sys_bitarray_alloc(&ba, regions[r].num_bits, &offset);
+		zassert_equal(ret, ref, "alloc returned %d, expected %d",
+			      ret, ref);
+		if (ret != 0) {
+			regions[r].num_bits = 0;
+			continue;
+		}
+
+		zassert_equal(offset, expected, "alloc at %zu, expected %zu",
+			      offset, expected);
+		regions[r].offset = offset;
+	}
+}
+
+/**
+ * @brief Measure allocations in a fragmented bit array
+ *
+ * @details Every other bit is allocated in the first half of the bit
+ * array: regions of 2 bits and more only fit in the second half. Print
+ * the average cycles of sys_bitarray_alloc() and of a bit at a time
+ * search.
+ *
+ * @ingroup lib_bitarray_perf_tests
+ *
+ * @see sys_bitarray_alloc()
+ */
+void test_bitarray_alloc_perf(void)
+{
+	static const size_t sizes[] = { 2, 8, 32, 128 };
+	uint32_t start, cycles, ref_cycles;
+	size_t offset;
+
+	for (int i = 0; i < ARRAY_SIZE(sizes); i++) {
+		ba_reset();
+		for (size_t bit = 0; bit < NUM_BITS / 2; bit += 2) {
+			(void)sys_bitarray_set_bit(&ba, bit);
+		}
+
+		start = k_cycle_get_32();
+		zassert_equal(sys_bitarray_alloc(&ba, sizes[i], &offset), 0,
+			      NULL);
+		cycles = k_cycle_get_32() - start;
+		zassert_equal(offset, NUM_BITS / 2, NULL);
+		(void)sys_bitarray_free(&ba, sizes[i], offset);
+
+		start = k_cycle_get_32();
+		zassert_equal(ref_alloc(sizes[i], &offset), 0, NULL);
+		ref_cycles = k_cycle_get_32() - start;
+
+		TC_PRINT("alloc %3zu bits of %u: %u cycles, bit at a time %u\n",
+			 sizes[i], NUM_BITS, cycles, ref_cycles);
+	}
+}
+
+void test_main(void)
+{
+	ztest_test_suite(bitarray_perf,
+			 ztest_unit_test(test_bitarray_first_fit),
+			 ztest_unit_test(test_bitarray_alloc_perf));
+	ztest_run_test_suite(bitarray_perf);
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * This file contains the benchmark that measures the average time it takes
+ * to do context switches, using k_yield(), between threads using the FPU,
+ * and between a thread using the FPU and a thread that does not.
+ */
+
+#include <zephyr.h>
+#include <timing/timing.h>
+#include "utils.h"
+
+#if defined(CONFIG_FPU) && defined(CONFIG_FPU_SHARING)
+
+#define NB_OF_YIELD 1000
+
+#define FP_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+/* Above the test thread, which only gets back to run once both are done */
+#define FP_PRIORITY K_PRIO_PREEMPT(9)
+
+K_THREAD_STACK_DEFINE(fp_stack_area, FP_STACK_SIZE);
+K_THREAD_STACK_DEFINE(other_stack_area, FP_STACK_SIZE);
+static struct k_thread fp_thread;
+static struct k_thread other_thread;
+
+static volatile float fp_value[2];
+static timing_t timestamp_start;
+static timing_t timestamp_end;
+
+/* Yield, keeping an FP context or not. */
+static void yield_thread(void *arg1, void *arg2, void *arg3)
+{
+	uint32_t id = POINTER_TO_UINT(arg1);
+	bool use_fp = POINTER_TO_UINT(arg2) != 0U;
+
+	ARG_UNUSED(arg3);
+
+	if (id == 0U) {
+		timestamp_start = timing_counter_get();
+	}
+
+	for (uint32_t i = 0U; i < NB_OF_YIELD; i++) {
+		if (use_fp) {
+			fp_value[id] = fp_value[id] * 1.5f + 1.0f;
+		}
+
+		k_yield();
+	}
+
+	if (id == 0U) {
+		timestamp_end = timing_counter_get();
+	}
+}
+
+static void fp_yield_measure(const char *tag, bool other_fp)
+{
+	uint32_t ts_diff;
+
+	bench_test_start();
+
+	fp_value[0] = 0.0f;
+	fp_value[1] = 0.0f;
+
+	k_thread_create(&fp_thread, fp_stack_area, FP_STACK_SIZE,
+			yield_thread, UINT_TO_POINTER(0U), UINT_TO_POINTER(1U),
+			NULL, FP_PRIORITY, K_FP_REGS, K_FOREVER);
+	k_thread_create(&other_thread, other_stack_area, FP_STACK_SIZE,
+			yield_thread, UINT_TO_POINTER(1U),
+			UINT_TO_POINTER(other_fp ? 1U : 0U), NULL, FP_PRIORITY,
+			other_fp ? K_FP_REGS : 0, K_FOREVER);
+
+	k_thread_start(&fp_thread);
+	k_thread_start(&other_thread);
+
+	k_thread_join(&fp_thread, K_FOREVER);
+	k_thread_join(&other_thread, K_FOREVER);
+
+	if (bench_test_end() < 0) {
+		error_count++;
+		PRINT_OVERFLOW_ERROR();
+		return;
+	}
+
+	ts_diff = timing_cycles_get(&timestamp_start, &timestamp_end);
+	PRINT_STATS_AVG(tag, ts_diff, 2 * NB_OF_YIELD);
+}
+
+/**
+ * @brief Entry point for FP thread context switch using yield test
+ *
+ * @return N/A
+ */
+void fp_ctx_switch(void)
+{
+	timing_start();
+
+	fp_yield_measure("Average context switch between FP threads", true);
+	fp_yield_measure("Average context switch, FP and non-FP threads",
+			 false);
+
+	timing_stop();
+}
+
+#else
+
+void fp_ctx_switch(void)
+{
+}
+
+#endif /* CONFIG_FPU && CONFIG_FPU_SHARING */
@@ -19,6 +19,7 @@ uint32_t tm_off; /* time necessary to read the time */
 int error_count; /* track number of errors */
 
 extern void thread_switch_yield(void);
+extern void fp_ctx_switch(void);
 extern void int_to_thread(void);
 extern void int_to_thread_evt(void);
 extern void sema_test_signal(void);
@@ -43,6 +44,8 @@ void test_thread(void *arg1, void *arg2, void *arg3)
 
 	thread_switch_yield();
 
+	fp_ctx_switch();
+
 	coop_ctx_switch();
 
 	int_to_thread();
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <random/rand32.h>
+#include <string.h>
+
+#define ROUNDS 200
+#define MAX_LEN 1024
+
+typedef void *(*copy_fn)(void *d, const void *s, size_t n);
+typedef void *(*set_fn)(void *buf, int c, size_t n);
+
+static const size_t lens[] = { 8, 16, 64, 256, 1024 };
+static const uint8_t aligns[][2] = { { 0, 0 }, { 1, 1 }, { 0, 1 }, { 3, 2 } };
+
+static uint8_t src[MAX_LEN + 8] __aligned(8);
+static uint8_t dst[MAX_LEN + 8] __aligned(8);
+static uint8_t chk[MAX_LEN + 8] __aligned(8);
+
+/* The copy the minimal libc used to have: words only when both buffers
+ * have the same alignment, bytes otherwise.
+ */
+static void *ref_memcpy(void *d, const void *s, size_t n)
+{
+	unsigned char *d_byte = (unsigned char *)d;
+	const unsigned char *s_byte = (const unsigned char *)s;
+	const uintptr_t mask = sizeof(mem_word_t) - 1;
+
+	if ((((uintptr_t)d ^ (uintptr_t)s_byte) & mask) == 0) {
+		while (((uintptr_t)d_byte) & mask) {
+			if (n == 0) {
+				return d;
+			}
+			*(d_byte++) = *(s_byte++);
+			n--;
+		}
+
+		mem_word_t *d_word = (mem_word_t *)d_byte;
+		const mem_word_t *s_word = (const mem_word_t *)s_byte;
+
+		while (n >= sizeof(mem_word_t)) {
+			*(d_word++) = *(s_word++);
+			n -= sizeof(mem_word_t);
+		}
+
+		d_byte = (unsigned char *)d_word;
+		s_byte = (unsigned char *)s_word;
+	}
+
+	while (n > 0) {
+		*(d_byte++) = *(s_byte++);
+		n--;
+	}
+
+	return d;
+}
+
+/* The memmove() the minimal libc used to have, a byte at a time. */
+static void *ref_memmove(void *d, const void *s, size_t n)
+{
+	char *dest = d;
+	const char *source = s;
+
+	if ((size_t)(dest - source) < n) {
+		while (n > 0) {
+			n--;
+			dest[n] = source[n];
+		}
+	} else {
+		while (n > 0) {
+			*(dest++) = *(source++);
+			n--;
+		}
+	}
+
+	return d;
+}
+
+static void *ref_memset(void *buf, int c, size_t n)
+{
+	unsigned char *d_byte = (unsigned char *)buf;
+	unsigned char c_byte = (unsigned char)c;
+
+	while (((uintptr_t)d_byte) & (sizeof(mem_word_t) - 1)) {
+		if (n == 0) {
+			return buf;
+		}
+		*(d_byte++) = c_byte;
+		n--;
+	}
+
+	mem_word_t *d_word = (mem_word_t *)d_byte;
+	mem_word_t c_word = (mem_word_t)c_byte;
+
+	c_word |= c_word << 8;
+	c_word |= c_word << 16;
+#if Z_MEM_WORD_T_WIDTH > 32
+	c_word |= c_word << 32;
+#endif
+
+	while (n >= sizeof(mem_word_t)) {
+		*(d_word++) = c_word;
+		n -= sizeof(mem_word_t);
+	}
+
+	d_byte = (unsigned char *)d_word;
+
+	while (n > 0) {
+		*(d_byte++) = c_byte;
+		n--;
+	}
+
+	return buf;
+}
+
+static const struct {
+	const char *name;
+	copy_fn ref;
+	copy_fn new;
+	/* Copy within the destination buffer, to a higher address. */
+	bool overlap;
+} copies[] = {
+	{ "memcpy", ref_memcpy, memcpy, false },
+	{ "memmove", ref_memmove, memmove, true },
+};
+
+static bool copy_check(copy_fn fn, bool overlap, size_t len, int d_off,
+		       int s_off)
+{
+	const uint8_t *s = overlap ? dst + s_off : src + s_off;
+
+	sys_rand_get(dst, sizeof(dst));
+	memcpy(chk, dst, sizeof(chk));
+
+	fn(dst + d_off, s, len);
+	ref_memmove(chk + d_off, overlap ? chk + s_off : s, len);
+
+	return memcmp(dst, chk, sizeof(dst)) == 0;
+}
+
+static bool set_check(size_t len, int off)
+{
+	sys_rand_get(dst, sizeof(dst));
+	memcpy(chk, dst, sizeof(chk));
+
+	memset(dst + off, 0xa5, len);
+	ref_memset(chk + off, 0xa5, len);
+
+	return memcmp(dst, chk, sizeof(dst)) == 0;
+}
+
+/* Cycles per byte, times 100 */
+static uint32_t copy_run(copy_fn fn, bool overlap, size_t len, int d_off,
+			 int s_off)
+{
+	const uint8_t *s = overlap ? dst + s_off : src + s_off;
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ROUNDS; i++) {
+		fn(dst + d_off, s, len);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	return (uint32_t)((uint64_t)cycles * 100U / ((uint64_t)ROUNDS * len));
+}
+
+static uint32_t set_run(set_fn fn, size_t len, int off)
+{
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ROUNDS; i++) {
+		fn(dst + off, i, len);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	return (uint32_t)((uint64_t)cycles * 100U / ((uint64_t)ROUNDS * len));
+}
+
+static void print(const char *name, size_t len, int d_off, int s_off,
+		  uint32_t ref, uint32_t new)
+{
+	printk("%-7s len %4zu align %d/%d ref %2u.%02u new %2u.%02u "
+	       "cycles/byte\n", name, len, d_off, s_off,
+	       ref / 100U, ref % 100U, new / 100U, new % 100U);
+}
+
+void main(void)
+{
+	sys_rand_get(src, sizeof(src));
+
+	for (size_t len = 0; len <= 300; len++) {
+		for (int d_off = 0; d_off < 8; d_off++) {
+			for (int s_off = 0; s_off < 8; s_off++) {
+				if (!copy_check(memcpy, false, len, d_off,
+						s_off) ||
+				    !copy_check(memmove, true, len,
+						MAX(d_off, s_off),
+						MIN(d_off, s_off)) ||
+				    !copy_check(memmove, true, len,
+						MIN(d_off, s_off),
+						MAX(d_off, s_off))) {
+					printk("copy mismatch, len %zu "
+					       "align %d/%d\n",
+					       len, d_off, s_off);
+					return;
+				}
+			}
+
+			if (!set_check(len, d_off)) {
+				printk("memset mismatch, len %zu align %d\n",
+				       len, d_off);
+				return;
+			}
+		}
+	}
+
+	for (int c = 0; c < ARRAY_SIZE(copies); c++) {
+		for (int i = 0; i < ARRAY_SIZE(lens); i++) {
+			for (int a = 0; a < ARRAY_SIZE(aligns); a++) {
+				int d_off = aligns[a][0];
+				int s_off = aligns[a][1];
+				uint32_t ref, new;
+
+				if (copies[c].overlap) {
+					/* Destination after the source. */
+					d_off += 4;
+				}
+
+				ref = copy_run(copies[c].ref, copies[c].overlap,
+					       lens[i], d_off, s_off);
+				new = copy_run(copies[c].new, copies[c].overlap,
+					       lens[i], d_off, s_off);
+
+				print(copies[c].name, lens[i], d_off, s_off,
+				      ref, new);
+			}
+		}
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(lens); i++) {
+		for (int off = 0; off < 2; off++) {
+			uint32_t ref, new;
+
+			ref = set_run(ref_memset, lens[i], off);
+			new = set_run(memset, lens[i], off);
+
+			print("memset", lens[i], off, off, ref, new);
+		}
+	}
+
+	printk("fin\n");
+}
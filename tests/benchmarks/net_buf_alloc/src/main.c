@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/net_if.h>
+#include <net/net_pkt.h>
+#include <net/dummy.h>
+
+#include "ipv4.h"
+#include "udp_internal.h"
+
+/* Packet data allocation benchmark.  For UDP datagrams of typical
+ * lengths, it shows how many RX packets the data pool can hold at once,
+ * in how many buffers each one is allocated and which share of the
+ * memory they take is actually requested, then how many datagrams per
+ * second are allocated, received and delivered to a context.
+ */
+
+#define PORT 4242
+#define MAX_HELD CONFIG_NET_PKT_RX_COUNT
+#define RECEIVES 2000
+
+static const uint16_t lens[] = { 18, 64, 128, 256, 512, 1024, 1472 };
+
+static uint8_t mac_addr[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+static uint8_t payload[1472];
+static struct net_pkt *held[MAX_HELD];
+static struct net_if *iface;
+
+static K_SEM_DEFINE(delivered, 0, 1);
+
+static int bench_dev_init(const struct device *dev)
+{
+	return 0;
+}
+
+static void bench_iface_init(struct net_if *iface)
+{
+	net_if_set_link_addr(iface, mac_addr, sizeof(mac_addr),
+			     NET_LINK_ETHERNET);
+}
+
+static int bench_send(const struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static struct dummy_api bench_if_api = {
+	.iface_api.init = bench_iface_init,
+	.send = bench_send,
+};
+
+NET_DEVICE_INIT(net_buf_alloc_bench, "net_buf_alloc_bench", bench_dev_init,
+		NULL, NULL, NULL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&bench_if_api, DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 1500);
+
+static void recv_cb(struct net_context *context, struct net_pkt *pkt,
+		    union net_ip_header *ip_hdr,
+		    union net_proto_header *proto_hdr,
+		    int status, void *user_data)
+{
+	net_pkt_unref(pkt);
+	k_sem_give(&delivered);
+}
+
+static struct net_pkt *alloc_datagram(size_t len)
+{
+	return net_pkt_rx_alloc_with_buffer(iface, NET_UDPH_LEN + len,
+					    AF_INET, IPPROTO_UDP, K_NO_WAIT);
+}
+
+/* Fill in a datagram from the peer, as a driver would receive it */
+static int build_datagram(struct net_pkt *pkt, size_t len)
+{
+	if (net_ipv4_create(pkt, &peer_addr, &my_addr) ||
+	    net_udp_create(pkt, htons(PORT + 1), htons(PORT)) ||
+	    net_pkt_write(pkt, payload, len)) {
+		return -ENOBUFS;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	return net_ipv4_finalize(pkt, IPPROTO_UDP);
+}
+
+static int hold_datagrams(size_t len, struct net_pkt_buf_stats *stats)
+{
+	struct net_pkt_buf_stats before;
+	int count;
+
+	net_pkt_get_buf_stats(&before, NULL);
+
+	for (count = 0; count < MAX_HELD; count++) {
+		held[count] = alloc_datagram(len);
+		if (!held[count]) {
+			break;
+		}
+	}
+
+	net_pkt_get_buf_stats(stats, NULL);
+
+	stats->allocs -= before.allocs;
+	stats->bufs -= before.bufs;
+	stats->requested -= before.requested;
+	stats->allocated -= before.allocated;
+
+	for (int i = 0; i < count; i++) {
+		net_pkt_unref(held[i]);
+	}
+
+	return count;
+}
+
+static uint32_t run_receives(size_t len)
+{
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < RECEIVES; i++) {
+		struct net_pkt *pkt = alloc_datagram(len);
+
+		if (!pkt) {
+			return 0;
+		}
+
+		if (build_datagram(pkt, len) || net_recv_data(iface, pkt)) {
+			net_pkt_unref(pkt);
+			return 0;
+		}
+
+		k_sem_take(&delivered, K_FOREVER);
+	}
+
+	cycles = MAX(k_cycle_get_32() - start, 1U);
+
+	return (uint32_t)(((uint64_t)RECEIVES * sys_clock_hw_cycles_per_sec()) /
+			  cycles);
+}
+
+void main(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(PORT),
+	};
+	struct net_context *ctx;
+
+	for (int i = 0; i < sizeof(payload); i++) {
+		payload[i] = i;
+	}
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0);
+	net_ipaddr_copy(&addr.sin_addr, &my_addr);
+
+	if (net_context_get(AF_INET, SOCK_DGRAM, IPPROTO_UDP, &ctx) ||
+	    net_context_bind(ctx, (struct sockaddr *)&addr, sizeof(addr)) ||
+	    net_context_recv(ctx, recv_cb, K_NO_WAIT, NULL)) {
+		printk("cannot set up the UDP context\n");
+		return;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(lens); i++) {
+		struct net_pkt_buf_stats stats;
+		uint32_t rate, bufs, usage;
+		int count;
+
+		count = hold_datagrams(lens[i], &stats);
+		if (!count) {
+			printk("cannot allocate a %u byte datagram\n", lens[i]);
+			return;
+		}
+
+		/* The net_buf headers are part of the memory taken */
+		bufs = stats.bufs * 10U / stats.allocs;
+		usage = stats.requested * 100U /
+			(stats.allocated + stats.bufs * sizeof(struct net_buf));
+
+		rate = run_receives(lens[i]);
+		if (!rate) {
+			printk("cannot receive a %u byte datagram\n", lens[i]);
+			return;
+		}
+
+		printk("len %4u held %2d bufs/pkt %2u.%u usage %3u%% "
+		       "pkts/s %u\n", lens[i], count, bufs / 10U, bufs % 10U,
+		       usage, rate);
+	}
+	printk("fin\n");
+}
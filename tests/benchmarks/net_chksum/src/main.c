@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_chksum_bench, LOG_LEVEL_NONE);
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <random/rand32.h>
+#include <net/net_ip.h>
+
+#include "net_private.h"
+
+#define ROUNDS 2000
+
+static const size_t lens[] = { 20, 64, 75, 256, 576, 1280, 1500 };
+static uint8_t data[1500 + 1];
+
+/* The word at a time loop the stack used to have, finalized the same way
+ * as net_calc_chksum_igmp()
+ */
+static uint16_t ref_chksum(uint8_t *buf, size_t len)
+{
+	const uint8_t *end = buf + len - 1;
+	uint16_t sum = 0U;
+	uint16_t tmp;
+
+	while (buf < end) {
+		tmp = (buf[0] << 8) + buf[1];
+		sum += tmp;
+		if (sum < tmp) {
+			sum++;
+		}
+
+		buf += 2;
+	}
+
+	if (buf == end) {
+		tmp = buf[0] << 8;
+		sum += tmp;
+		if (sum < tmp) {
+			sum++;
+		}
+	}
+
+	sum = (sum == 0U) ? 0xffff : htons(sum);
+
+	return ~sum;
+}
+
+/* Cycles per byte, times 100 */
+static uint32_t run(uint16_t (*chksum)(uint8_t *buf, size_t len),
+		    uint8_t *buf, size_t len)
+{
+	volatile uint16_t sink;
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ROUNDS; i++) {
+		sink = chksum(buf, len);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	return (uint32_t)((uint64_t)cycles * 100U / ((uint64_t)ROUNDS * len));
+}
+
+void main(void)
+{
+	sys_rand_get(data, sizeof(data));
+
+	for (size_t len = 0; len < sizeof(data); len++) {
+		for (int align = 0; align < 2 && align + len < sizeof(data);
+		     align++) {
+			if (ref_chksum(data + align, len) !=
+			    net_calc_chksum_igmp(data + align, len)) {
+				printk("checksum mismatch, len %zu align %d\n",
+				       len, align);
+				return;
+			}
+		}
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(lens); i++) {
+		for (int align = 0; align < 2; align++) {
+			uint8_t *buf = data + align;
+			uint32_t ref, new;
+
+			ref = run(ref_chksum, buf, lens[i]);
+			new = run(net_calc_chksum_igmp, buf, lens[i]);
+
+			printk("len %4zu align %d ref %2u.%02u new %2u.%02u "
+			       "cycles/byte\n", lens[i], align,
+			       ref / 100U, ref % 100U, new / 100U, new % 100U);
+		}
+	}
+
+	printk("fin\n");
+}
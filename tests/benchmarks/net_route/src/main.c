@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/net_if.h>
+#include <net/dummy.h>
+
+#include "ipv6.h"
+#include "route.h"
+
+/* IPv6 route lookup benchmark.  The routing table is filled with
+ * routes of various prefix lengths, all via the same neighbor, and
+ * looked up for destinations inside and outside of them while the
+ * table grows, which shows how the lookup cost scales with its size.
+ */
+
+#define MAX_ROUTES CONFIG_NET_MAX_ROUTES
+#define LOOKUPS 20000
+
+static uint8_t mac_addr[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+static uint8_t gw_mac_addr[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x02 };
+static struct in6_addr gw_addr = { { { 0xfe, 0x80, 0, 0, 0, 0, 0, 0,
+				       0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+static struct in6_addr dsts[2 * MAX_ROUTES];
+
+static int bench_dev_init(const struct device *dev)
+{
+	return 0;
+}
+
+static void bench_iface_init(struct net_if *iface)
+{
+	net_if_set_link_addr(iface, mac_addr, sizeof(mac_addr),
+			     NET_LINK_ETHERNET);
+}
+
+static int bench_send(const struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static struct dummy_api bench_if_api = {
+	.iface_api.init = bench_iface_init,
+	.send = bench_send,
+};
+
+NET_DEVICE_INIT(net_route_bench, "net_route_bench", bench_dev_init, NULL,
+		NULL, NULL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&bench_if_api, DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 1280);
+
+/* The routes are disjoint, as adding one inside of a route with the
+ * same nexthop would just return that route.  Each one gets a covered
+ * destination, and the same destination in 2001:db9::/32 misses.
+ */
+static bool add_route(struct net_if *iface, int i)
+{
+	struct in6_addr addr;
+	uint8_t len = 48U + (i % 5) * 16U;
+
+	net_ipv6_addr_create(&addr, 0x2001, 0xdb8, i, i, i, i, i, 0);
+	net_ipv6_addr_create(&dsts[2 * i], 0x2001, 0xdb8, i, i, i, i, i, 1);
+	net_ipv6_addr_create(&dsts[2 * i + 1], 0x2001, 0xdb9, i, i, i, i, i,
+			     1);
+
+	return net_route_add(iface, &addr, len, &gw_addr) != NULL;
+}
+
+static uint32_t run_lookups(int n)
+{
+	volatile uint32_t found = 0U;
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < LOOKUPS; i++) {
+		/* Three hits for each miss */
+		int route = i % n;
+		int miss = (i & 3) == 3;
+
+		if (net_route_lookup(NULL, &dsts[2 * route + miss]) != NULL) {
+			found++;
+		}
+	}
+
+	cycles = MAX(k_cycle_get_32() - start, 1U);
+
+	return (uint32_t)(((uint64_t)LOOKUPS * sys_clock_hw_cycles_per_sec()) /
+			  cycles);
+}
+
+void main(void)
+{
+	struct net_if *iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	struct net_linkaddr lladdr = {
+		.addr = gw_mac_addr,
+		.len = sizeof(gw_mac_addr),
+		.type = NET_LINK_ETHERNET,
+	};
+	int n = 0;
+
+	if (net_ipv6_nbr_add(iface, &gw_addr, &lladdr, true,
+			     NET_IPV6_NBR_STATE_REACHABLE) == NULL) {
+		printk("cannot add the nexthop neighbor\n");
+		return;
+	}
+
+	for (int size = 1; size <= MAX_ROUTES; size *= 2) {
+		for (; n < size; n++) {
+			if (!add_route(iface, n)) {
+				printk("cannot add route %d\n", n);
+				return;
+			}
+		}
+
+		printk("routes %d lookups/s %u\n", n, run_lookups(n));
+	}
+	printk("fin\n");
+}
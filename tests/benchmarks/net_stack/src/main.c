@@ -0,0 +1,592 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <string.h>
+#include <net/net_if.h>
+#include <net/net_pkt.h>
+#include <net/net_mgmt.h>
+#include <net/net_stats.h>
+#include <net/dummy.h>
+#include <net/socket.h>
+
+/* Network stack benchmark.  The stack is run against itself, with no
+ * external peer, so that only its own per packet cost is measured:
+ *
+ * - udp_tx: UDP datagrams sent from a socket to a dummy interface whose
+ *   driver drops them, i.e. an infinitely fast link.
+ * - udp_rx: the datagrams sent in udp_tx, with the addresses swapped,
+ *   injected by the dummy driver and read from the socket.
+ * - udp_lo: UDP datagrams sent to a socket through the loopback interface.
+ * - tcp_lo: messages sent over a TCP connection through the loopback
+ *   interface.
+ *
+ * The packets are sent in bursts, all the packets of a burst being sent
+ * before they are received.  The latency of each packet, from the socket
+ * to the driver for udp_tx, from the driver to the socket for udp_rx and
+ * from socket to socket otherwise, is counted in a histogram.
+ */
+
+#define PKTS 2000
+#define MAX_BURST 16
+#define MAX_SIZE 480
+#define PORT 4242
+#define TIMEOUT_MS 1000
+
+/* Latency histogram: exact below 8 cycles, then four buckets per power of
+ * two, i.e. within 25%.
+ */
+#define HIST_BUCKETS 128
+
+static const int sizes[] = { 64, MAX_SIZE };
+static const int bursts[] = { 1, MAX_BURST };
+
+static uint8_t mac_addr[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+static struct in_addr bench_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+static struct in_addr bench_netmask = { { { 255, 255, 255, 0 } } };
+static struct in_addr lo_addr = { { { 127, 0, 0, 1 } } };
+static struct in_addr lo_netmask = { { { 255, 0, 0, 0 } } };
+
+static struct net_if *bench_iface;
+static struct net_if *lo_iface;
+
+static int udp_sock = -1;
+static int lo_sock = -1;
+static int tcp_client = -1;
+static int tcp_server = -1;
+
+static uint8_t buf[MAX_SIZE];
+
+/* Start times of the packets in flight, in order */
+static uint32_t stamps[MAX_BURST];
+static unsigned int stamp_in, stamp_out;
+static uint32_t hist[HIST_BUCKETS];
+
+/* Whether the driver ends the latency of the packets it gets */
+static bool tx_timing;
+
+/* Copy of the next packet the driver gets, when capture is set */
+static uint8_t frame[NET_IPV4UDPH_LEN + MAX_SIZE];
+static size_t frame_len;
+static bool capture;
+
+static inline int hist_bucket(uint32_t cycles)
+{
+	int msb;
+
+	if (cycles < 8U) {
+		return cycles;
+	}
+
+	msb = 31 - __builtin_clz(cycles);
+
+	return (msb - 1) * 4 + ((cycles >> (msb - 2)) & 3U);
+}
+
+/* Lower bound of the durations counted in a bucket */
+static uint32_t hist_value(int bucket)
+{
+	if (bucket < 8) {
+		return bucket;
+	}
+
+	return (4U + (bucket % 4)) << (bucket / 4 - 1);
+}
+
+static inline void lat_start(void)
+{
+	stamps[stamp_in++ % MAX_BURST] = k_cycle_get_32();
+}
+
+static inline void lat_end(void)
+{
+	uint32_t start = stamps[stamp_out++ % MAX_BURST];
+
+	hist[hist_bucket(k_cycle_get_32() - start)]++;
+}
+
+static int bench_dev_init(const struct device *dev)
+{
+	return 0;
+}
+
+static void bench_iface_init(struct net_if *iface)
+{
+	bench_iface = iface;
+	net_if_set_link_addr(iface, mac_addr, sizeof(mac_addr),
+			     NET_LINK_DUMMY);
+}
+
+static int bench_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+
+	if (tx_timing && stamp_out != stamp_in) {
+		lat_end();
+	}
+
+	if (capture) {
+		frame_len = MIN(net_pkt_get_len(pkt), sizeof(frame));
+		net_pkt_cursor_init(pkt);
+		if (net_pkt_read(pkt, frame, frame_len) < 0) {
+			frame_len = 0;
+		}
+		capture = false;
+	}
+
+	return 0;
+}
+
+static struct dummy_api bench_if_api = {
+	.iface_api.init = bench_iface_init,
+	.send = bench_send,
+};
+
+NET_DEVICE_INIT(net_stack_bench, "net_stack_bench", bench_dev_init, NULL,
+		NULL, NULL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&bench_if_api, DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 1500);
+
+static void lo_iface_find(struct net_if *iface, void *user_data)
+{
+	if (iface != bench_iface &&
+	    net_if_l2(iface) == &NET_L2_GET_NAME(DUMMY)) {
+		lo_iface = iface;
+	}
+}
+
+/* Wait for the driver to get the packets sent. The network threads all
+ * have a higher priority than the benchmark.
+ */
+static int wait_sent(void)
+{
+	int64_t end = k_uptime_get() + TIMEOUT_MS;
+
+	while (stamp_out != stamp_in) {
+		if (k_uptime_get() > end) {
+			return -ETIMEDOUT;
+		}
+		k_yield();
+	}
+
+	return 0;
+}
+
+static int recv_msg(int sock, int size)
+{
+	int len = 0;
+	int ret;
+
+	/* The TCP messages may come in pieces */
+	while (len < size) {
+		ret = recv(sock, buf + len, size - len, 0);
+		if (ret <= 0) {
+			return -EIO;
+		}
+		len += ret;
+	}
+
+	lat_end();
+
+	return 0;
+}
+
+static int udp_tx(int size, int burst)
+{
+	struct sockaddr_in peer = {
+		.sin_family = AF_INET,
+		.sin_port = htons(PORT),
+		.sin_addr = peer_addr,
+	};
+
+	for (int i = 0; i < burst; i++) {
+		lat_start();
+		if (sendto(udp_sock, buf, size, 0, (struct sockaddr *)&peer,
+			   sizeof(peer)) != size) {
+			return -EIO;
+		}
+	}
+
+	return wait_sent();
+}
+
+static int udp_rx(int size, int burst)
+{
+	struct net_pkt *pkt;
+
+	for (int i = 0; i < burst; i++) {
+		/* The copy to a new packet stands for the driver's */
+		lat_start();
+		pkt = net_pkt_rx_alloc_with_buffer(bench_iface, frame_len,
+						   AF_UNSPEC, 0,
+						   K_MSEC(TIMEOUT_MS));
+		if (pkt == NULL) {
+			return -ENOMEM;
+		}
+
+		if (net_pkt_write(pkt, frame, frame_len) < 0 ||
+		    net_recv_data(bench_iface, pkt) < 0) {
+			net_pkt_unref(pkt);
+			return -EIO;
+		}
+	}
+
+	for (int i = 0; i < burst; i++) {
+		if (recv_msg(udp_sock, size) < 0) {
+			return -EIO;
+		}
+	}
+
+	return 0;
+}
+
+static int udp_lo(int size, int burst)
+{
+	struct sockaddr_in self = {
+		.sin_family = AF_INET,
+		.sin_port = htons(PORT + 1),
+		.sin_addr = lo_addr,
+	};
+
+	for (int i = 0; i < burst; i++) {
+		lat_start();
+		if (sendto(lo_sock, buf, size, 0, (struct sockaddr *)&self,
+			   sizeof(self)) != size) {
+			return -EIO;
+		}
+	}
+
+	for (int i = 0; i < burst; i++) {
+		if (recv_msg(lo_sock, size) < 0) {
+			return -EIO;
+		}
+	}
+
+	return 0;
+}
+
+static int tcp_lo(int size, int burst)
+{
+	for (int i = 0; i < burst; i++) {
+		lat_start();
+		if (send(tcp_client, buf, size, 0) != size) {
+			return -EIO;
+		}
+	}
+
+	for (int i = 0; i < burst; i++) {
+		if (recv_msg(tcp_server, size) < 0) {
+			return -EIO;
+		}
+	}
+
+	return 0;
+}
+
+static const struct {
+	const char *name;
+	int (*run)(int size, int burst);
+	/* Interface whose RX stage latencies are reported, if any */
+	struct net_if **rx_iface;
+	/* Larger bursts could fill the TCP window, with nobody to read it */
+	int max_burst;
+} cases[] = {
+	{ "udp_tx", udp_tx, NULL, MAX_BURST },
+	{ "udp_rx", udp_rx, &bench_iface, MAX_BURST },
+	{ "udp_lo", udp_lo, &lo_iface, MAX_BURST },
+	{ "tcp_lo", tcp_lo, &lo_iface, 1 },
+};
+
+/* Values at the 50th and 99th percentiles of a histogram */
+static void percentiles(const uint32_t *h, int buckets,
+			uint32_t (*value)(int bucket), uint32_t lat[2])
+{
+	static const uint32_t pcts[] = { 500, 990 };
+	uint64_t total = 0U;
+	uint64_t rank = 0U;
+	int p = 0;
+
+	for (int b = 0; b < buckets; b++) {
+		total += h[b];
+	}
+
+	for (int b = 0; b < buckets && p < ARRAY_SIZE(pcts); b++) {
+		rank += h[b];
+		while (p < ARRAY_SIZE(pcts) && total > 0U &&
+		       rank * 1000U >= total * pcts[p]) {
+			lat[p++] = value(b);
+		}
+	}
+
+	while (p < ARRAY_SIZE(pcts)) {
+		lat[p++] = 0U;
+	}
+}
+
+#if defined(CONFIG_NET_PKT_RX_LATENCY)
+static struct net_stats_rx_latency rx_lat[NET_STATS_RX_STAGE_COUNT];
+
+static const char *const stage_names[] = {
+	[NET_STATS_RX_STAGE_DRIVER] = "driver",
+	[NET_STATS_RX_STAGE_TC] = "tc",
+	[NET_STATS_RX_STAGE_L2] = "l2",
+	[NET_STATS_RX_STAGE_IP] = "ip",
+	[NET_STATS_RX_STAGE_TRANSPORT] = "transport",
+	[NET_STATS_RX_STAGE_SOCKET] = "socket",
+};
+
+/* Upper bound of the times counted in a bucket, in microseconds */
+static uint32_t rx_lat_value(int bucket)
+{
+	return BIT(bucket);
+}
+
+static void rx_lat_begin(struct net_if *iface)
+{
+	(void)net_mgmt(NET_REQUEST_STATS_GET_RX_LATENCY, iface, rx_lat,
+		       sizeof(rx_lat));
+}
+
+static void rx_lat_report(int c, int size, int burst, struct net_if *iface)
+{
+	struct net_stats_rx_latency end[NET_STATS_RX_STAGE_COUNT];
+	uint32_t lat[2];
+
+	if (net_mgmt(NET_REQUEST_STATS_GET_RX_LATENCY, iface, end,
+		     sizeof(end)) < 0) {
+		return;
+	}
+
+	for (int s = 0; s < NET_STATS_RX_STAGE_COUNT; s++) {
+		for (int b = 0; b < NET_STATS_RX_LATENCY_BUCKETS; b++) {
+			end[s].hist[b] -= rx_lat[s].hist[b];
+		}
+
+		percentiles(end[s].hist, NET_STATS_RX_LATENCY_BUCKETS,
+			    rx_lat_value, lat);
+		printk("net_rx,%s,%d,%d,%s,%u,%u\n", cases[c].name, size,
+		       burst, stage_names[s], lat[0], lat[1]);
+	}
+}
+#else
+static inline void rx_lat_begin(struct net_if *iface)
+{
+	ARG_UNUSED(iface);
+}
+
+static inline void rx_lat_report(int c, int size, int burst,
+				 struct net_if *iface)
+{
+	ARG_UNUSED(c);
+	ARG_UNUSED(size);
+	ARG_UNUSED(burst);
+	ARG_UNUSED(iface);
+}
+#endif /* CONFIG_NET_PKT_RX_LATENCY */
+
+/* Data buffer allocations and buffers per packet, in hundredths */
+static void buf_stats(uint32_t *allocs, uint32_t *bufs)
+{
+#if defined(CONFIG_NET_PKT_BUF_STATS)
+	struct net_pkt_buf_stats rx, tx;
+
+	net_pkt_get_buf_stats(&rx, &tx);
+	*allocs = rx.allocs + tx.allocs;
+	*bufs = rx.bufs + tx.bufs;
+#else
+	*allocs = 0U;
+	*bufs = 0U;
+#endif
+}
+
+static void run(int c, int size, int burst)
+{
+	struct net_if *rx_iface = cases[c].rx_iface != NULL ?
+				  *cases[c].rx_iface : NULL;
+	uint32_t allocs, bufs, allocs_end, bufs_end;
+	uint64_t cycles = 0U;
+	uint32_t lat[2];
+	uint32_t start;
+	int ret = 0;
+
+	memset(hist, 0, sizeof(hist));
+	stamp_in = stamp_out = 0U;
+
+	if (rx_iface != NULL) {
+		rx_lat_begin(rx_iface);
+	}
+	buf_stats(&allocs, &bufs);
+
+	for (int i = 0; i < PKTS / burst && ret == 0; i++) {
+		start = k_cycle_get_32();
+		ret = cases[c].run(size, burst);
+		cycles += k_cycle_get_32() - start;
+	}
+
+	if (ret < 0) {
+		printk("%s size %d burst %d failed (%d)\n", cases[c].name,
+		       size, burst, ret);
+		return;
+	}
+
+	buf_stats(&allocs_end, &bufs_end);
+	allocs = (allocs_end - allocs) * 100U / PKTS;
+	bufs = (bufs_end - bufs) * 100U / PKTS;
+
+	percentiles(hist, HIST_BUCKETS, hist_value, lat);
+	cycles = MAX(cycles, 1U);
+
+	printk("net,%s,%d,%d,%u,%u,%u,%u,%u.%02u,%u.%02u\n", cases[c].name,
+	       size, burst,
+	       (uint32_t)(PKTS * (uint64_t)sys_clock_hw_cycles_per_sec() /
+			  cycles),
+	       (uint32_t)(cycles / PKTS), lat[0], lat[1],
+	       allocs / 100U, allocs % 100U, bufs / 100U, bufs % 100U);
+
+	if (rx_iface != NULL) {
+		rx_lat_report(c, size, burst, rx_iface);
+	}
+}
+
+static int sock_open(int type, const struct in_addr *addr, uint16_t port)
+{
+	struct sockaddr_in sin = {
+		.sin_family = AF_INET,
+		.sin_port = htons(port),
+		.sin_addr = *addr,
+	};
+	struct timeval tv = {
+		.tv_sec = TIMEOUT_MS / MSEC_PER_SEC,
+	};
+	int sock;
+
+	sock = socket(AF_INET, type,
+		      type == SOCK_DGRAM ? IPPROTO_UDP : IPPROTO_TCP);
+	if (sock < 0) {
+		return sock;
+	}
+
+	if (setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) < 0 ||
+	    bind(sock, (struct sockaddr *)&sin, sizeof(sin)) < 0) {
+		close(sock);
+		return -1;
+	}
+
+	return sock;
+}
+
+static int setup(void)
+{
+	struct sockaddr_in server = {
+		.sin_family = AF_INET,
+		.sin_port = htons(PORT + 2),
+		.sin_addr = lo_addr,
+	};
+	int listener;
+
+	net_if_foreach(lo_iface_find, NULL);
+	if (lo_iface == NULL) {
+		return -ENODEV;
+	}
+
+	if (net_if_ipv4_addr_add(bench_iface, &bench_addr, NET_ADDR_MANUAL,
+				 0) == NULL ||
+	    net_if_ipv4_addr_add(lo_iface, &lo_addr, NET_ADDR_MANUAL,
+				 0) == NULL) {
+		return -EADDRNOTAVAIL;
+	}
+	net_if_ipv4_set_netmask(bench_iface, &bench_netmask);
+	net_if_ipv4_set_netmask(lo_iface, &lo_netmask);
+
+	/* The swapped udp_tx packets come back to the sending socket */
+	udp_sock = sock_open(SOCK_DGRAM, &bench_addr, PORT);
+	lo_sock = sock_open(SOCK_DGRAM, &lo_addr, PORT + 1);
+	listener = sock_open(SOCK_STREAM, &lo_addr, PORT + 2);
+	tcp_client = sock_open(SOCK_STREAM, &lo_addr, 0);
+	if (udp_sock < 0 || lo_sock < 0 || listener < 0 || tcp_client < 0) {
+		return -ENOMEM;
+	}
+
+	if (listen(listener, 1) < 0 ||
+	    connect(tcp_client, (struct sockaddr *)&server,
+		    sizeof(server)) < 0) {
+		return -ECONNREFUSED;
+	}
+
+	tcp_server = accept(listener, NULL, NULL);
+	close(listener);
+
+	return tcp_server < 0 ? -ECONNREFUSED : 0;
+}
+
+/* Send a datagram to the dummy interface and keep a copy of it, with the
+ * addresses swapped, to be injected in udp_rx.  The checksums are sums
+ * over both addresses, which are still valid after the swap.
+ */
+static int frame_capture(int size)
+{
+	struct net_ipv4_hdr *hdr = (struct net_ipv4_hdr *)frame;
+	struct in_addr addr;
+	int ret;
+
+	frame_len = 0;
+	capture = true;
+	tx_timing = true;
+	ret = udp_tx(size, 1);
+	capture = false;
+
+	if (ret < 0 || frame_len != NET_IPV4UDPH_LEN + size) {
+		return -EIO;
+	}
+
+	addr = hdr->src;
+	hdr->src = hdr->dst;
+	hdr->dst = addr;
+
+	return 0;
+}
+
+void main(void)
+{
+	int ret;
+
+	/* Keep the main thread below the network threads */
+	k_thread_priority_set(k_current_get(),
+			      K_LOWEST_APPLICATION_THREAD_PRIO);
+
+	ret = setup();
+	if (ret < 0) {
+		printk("setup failed (%d)\n", ret);
+		return;
+	}
+
+	printk("# cycles/s %u\n", sys_clock_hw_cycles_per_sec());
+	printk("# net,case,size,burst,pkts/s,cycles/pkt,p50,p99 (cycles),"
+	       "allocs/pkt,bufs/pkt\n");
+	printk("# net_rx,case,size,burst,stage,p50,p99 (us)\n");
+
+	for (int s = 0; s < ARRAY_SIZE(sizes); s++) {
+		for (int c = 0; c < ARRAY_SIZE(cases); c++) {
+			if (cases[c].run == udp_rx &&
+			    frame_capture(sizes[s]) < 0) {
+				printk("cannot capture a %d byte frame\n",
+				       sizes[s]);
+				continue;
+			}
+
+			tx_timing = cases[c].run == udp_tx;
+
+			for (int b = 0; b < ARRAY_SIZE(bursts); b++) {
+				if (bursts[b] <= cases[c].max_burst) {
+					run(c, sizes[s], bursts[b]);
+				}
+			}
+		}
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <string.h>
+
+/* SMP scaling benchmark of the kernel primitives.  For each workload,
+ * and each count N from 1 to CONFIG_MP_NUM_CPUS, N worker threads, each
+ * pinned to its own CPU, run the same operation in a loop for a fixed
+ * interval.  In the "private" mode each worker has its own object, so
+ * that only the kernel state shared behind the objects is contended.  In
+ * the "shared" mode all the workers use the same object.  The duration of
+ * each operation is recorded in a histogram of the worker, from which the
+ * latency percentiles are derived.
+ */
+
+#define MAX_WORKERS CONFIG_MP_NUM_CPUS
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define RUN_MS 500
+#define PRIO K_PRIO_PREEMPT(1)
+
+#define MSG_SIZE 4
+#define BLOCK_SIZE 32
+#define HEAP_SIZE 512
+
+/* Latency histogram: exact below 8 cycles, then four buckets per power of
+ * two, i.e. within 25%.
+ */
+#define HIST_BUCKETS 128
+
+enum mode {
+	MODE_PRIVATE,
+	MODE_SHARED,
+};
+
+struct worker {
+	struct k_sem sem;
+	struct k_mutex mutex;
+	struct k_msgq msgq;
+	char msgq_buf[MAX_WORKERS * MSG_SIZE] __aligned(8);
+	struct k_mem_slab slab;
+	char slab_buf[MAX_WORKERS * BLOCK_SIZE] __aligned(8);
+	struct k_heap heap;
+	char heap_buf[HEAP_SIZE] __aligned(8);
+	struct k_spinlock lock;
+	struct k_work work;
+	uint32_t ops;
+	uint32_t hist[HIST_BUCKETS];
+};
+
+static struct worker workers[MAX_WORKERS + 1];
+/* Objects of the shared mode */
+static struct worker *const shared = &workers[MAX_WORKERS];
+
+static struct k_thread threads[MAX_WORKERS];
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_WORKERS, STACK_SIZE);
+
+static struct k_work_q work_q;
+static K_THREAD_STACK_DEFINE(work_q_stack, STACK_SIZE);
+
+static volatile bool stop;
+
+static void work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+}
+
+static void op_sem(struct worker *w)
+{
+	k_sem_take(&w->sem, K_FOREVER);
+	k_sem_give(&w->sem);
+}
+
+static void op_mutex(struct worker *w)
+{
+	k_mutex_lock(&w->mutex, K_FOREVER);
+	k_mutex_unlock(&w->mutex);
+}
+
+static void op_msgq(struct worker *w)
+{
+	uint32_t msg = 0U;
+
+	k_msgq_put(&w->msgq, &msg, K_FOREVER);
+	k_msgq_get(&w->msgq, &msg, K_FOREVER);
+}
+
+static void op_mem_slab(struct worker *w)
+{
+	void *block;
+
+	k_mem_slab_alloc(&w->slab, &block, K_FOREVER);
+	k_mem_slab_free(&w->slab, &block);
+}
+
+static void op_heap(struct worker *w)
+{
+	k_heap_free(&w->heap, k_heap_alloc(&w->heap, BLOCK_SIZE, K_FOREVER));
+}
+
+static void op_spinlock(struct worker *w)
+{
+	k_spinlock_key_t key = k_spin_lock(&w->lock);
+
+	k_spin_unlock(&w->lock, key);
+}
+
+/* Submit the worker's own item to the common queue, and wait for it */
+static void op_work(struct worker *w)
+{
+	struct k_work_sync sync;
+
+	k_work_submit_to_queue(&work_q, &w->work);
+	k_work_flush(&w->work, &sync);
+}
+
+static const struct {
+	const char *name;
+	void (*op)(struct worker *w);
+	/* Whether there is a private mode, with an object per worker */
+	bool private;
+} workloads[] = {
+	{ "sem", op_sem, true },
+	{ "mutex", op_mutex, true },
+	{ "msgq", op_msgq, true },
+	{ "mem_slab", op_mem_slab, true },
+	{ "heap", op_heap, true },
+	{ "spinlock", op_spinlock, true },
+	{ "work", op_work, false },
+};
+
+static void objects_init(struct worker *w)
+{
+	k_sem_init(&w->sem, 1, 1);
+	k_mutex_init(&w->mutex);
+	k_msgq_init(&w->msgq, w->msgq_buf, MSG_SIZE, MAX_WORKERS);
+	k_mem_slab_init(&w->slab, w->slab_buf, BLOCK_SIZE, MAX_WORKERS);
+	k_heap_init(&w->heap, w->heap_buf, HEAP_SIZE);
+	w->lock = (struct k_spinlock) {};
+	k_work_init(&w->work, work_handler);
+}
+
+static inline int hist_bucket(uint32_t cycles)
+{
+	int msb;
+
+	if (cycles < 8U) {
+		return cycles;
+	}
+
+	msb = 31 - __builtin_clz(cycles);
+
+	return (msb - 1) * 4 + ((cycles >> (msb - 2)) & 3U);
+}
+
+/* Lower bound of the durations counted in a bucket */
+static inline uint32_t hist_value(int bucket)
+{
+	if (bucket < 8) {
+		return bucket;
+	}
+
+	return (4U + (bucket % 4)) << (bucket / 4 - 1);
+}
+
+static void worker_entry(void *p1, void *p2, void *p3)
+{
+	struct worker *w = p1;
+	struct worker *obj = p2;
+	void (*op)(struct worker *w) = p3;
+	uint32_t start, end;
+
+	while (!stop) {
+		start = k_cycle_get_32();
+		op(obj);
+		end = k_cycle_get_32();
+
+		w->hist[hist_bucket(end - start)]++;
+		w->ops++;
+	}
+}
+
+static void run(int wl, enum mode mode, int n)
+{
+	static uint32_t hist[HIST_BUCKETS];
+	static const uint32_t pcts[] = { 500, 990, 999 };
+	uint32_t lat[ARRAY_SIZE(pcts)];
+	uint64_t ops = 0U;
+	uint64_t rank = 0U;
+	int64_t start, elapsed;
+	int p = 0;
+
+	for (int i = 0; i <= MAX_WORKERS; i++) {
+		objects_init(&workers[i]);
+		workers[i].ops = 0U;
+		memset(workers[i].hist, 0, sizeof(workers[i].hist));
+	}
+
+	stop = false;
+
+	for (int i = 0; i < n; i++) {
+		struct worker *obj = mode == MODE_SHARED ? shared : &workers[i];
+
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE,
+				worker_entry, &workers[i], obj,
+				workloads[wl].op, PRIO, 0, K_FOREVER);
+		k_thread_cpu_mask_clear(&threads[i]);
+		k_thread_cpu_mask_enable(&threads[i], i);
+	}
+
+	start = k_uptime_get();
+
+	for (int i = 0; i < n; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	k_sleep(K_MSEC(RUN_MS));
+	stop = true;
+
+	for (int i = 0; i < n; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	elapsed = k_uptime_get() - start;
+
+	memset(hist, 0, sizeof(hist));
+	for (int i = 0; i < n; i++) {
+		ops += workers[i].ops;
+		for (int b = 0; b < HIST_BUCKETS; b++) {
+			hist[b] += workers[i].hist[b];
+		}
+	}
+
+	for (int b = 0; b < HIST_BUCKETS && p < ARRAY_SIZE(pcts); b++) {
+		rank += hist[b];
+		while (p < ARRAY_SIZE(pcts) && rank * 1000U >= ops * pcts[p]) {
+			lat[p++] = hist_value(b);
+		}
+	}
+
+	while (p < ARRAY_SIZE(pcts)) {
+		lat[p++] = 0U;
+	}
+
+	printk("smp,%s,%s,%d,%u,%u,%u,%u\n", workloads[wl].name,
+	       mode == MODE_SHARED ? "shared" : "private", n,
+	       (uint32_t)(ops * MSEC_PER_SEC / MAX(elapsed, 1)),
+	       lat[0], lat[1], lat[2]);
+}
+
+void main(void)
+{
+	/* Keep the main thread out of the way of the measured ones */
+	k_thread_priority_set(k_current_get(), K_PRIO_COOP(0));
+
+	k_work_queue_start(&work_q, work_q_stack,
+			   K_THREAD_STACK_SIZEOF(work_q_stack),
+			   K_PRIO_PREEMPT(0), NULL);
+
+	printk("# cycles/s %u\n", sys_clock_hw_cycles_per_sec());
+	printk("# smp,workload,mode,cpus,ops/s,p50,p99,p99.9 (cycles)\n");
+
+	for (int wl = 0; wl < ARRAY_SIZE(workloads); wl++) {
+		for (int n = 1; n <= MAX_WORKERS; n++) {
+			if (workloads[wl].private) {
+				run(wl, MODE_PRIVATE, n);
+			}
+			run(wl, MODE_SHARED, n);
+		}
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/socket.h>
+
+/* Socketpair throughput benchmark. A producer thread sends TOTAL bytes in
+ * chunks of a given size and the main thread receives them, through a
+ * k_pipe as the baseline, then through a socketpair with the copying and
+ * with the zero-copy calls.
+ */
+
+#define TOTAL (64 * 1024)
+#define BUF_SIZE CONFIG_NET_SOCKETPAIR_BUFFER_SIZE
+#define STACK_SIZE 1024
+
+enum mode {
+	MODE_PIPE,
+	MODE_SOCKET,
+	MODE_ZCOPY,
+};
+
+static const char *const mode_names[] = {
+	[MODE_PIPE] = "pipe",
+	[MODE_SOCKET] = "socket",
+	[MODE_ZCOPY] = "zcopy",
+};
+
+static const size_t chunks[] = { 1, 16, 64, 256 };
+
+static K_THREAD_STACK_DEFINE(producer_stack, STACK_SIZE);
+static struct k_thread producer_thread;
+
+static uint8_t pipe_buf[BUF_SIZE];
+static struct k_pipe pipe;
+static int sv[2];
+
+static uint8_t tx_buf[256];
+static uint8_t rx_buf[256];
+
+/* Send TOTAL bytes, the value of each one being its offset. Poll for
+ * space before zero-copy claims, as they do not wait.
+ */
+static void producer(void *p1, void *p2, void *p3)
+{
+	enum mode mode = POINTER_TO_UINT(p1);
+	size_t chunk = POINTER_TO_UINT(p2);
+	struct zsock_pollfd pfd = { .fd = sv[0], .events = ZSOCK_POLLOUT };
+	size_t sent = 0;
+	size_t len;
+	void *data;
+	int res;
+
+	ARG_UNUSED(p3);
+
+	while (sent < TOTAL) {
+		len = MIN(chunk, TOTAL - sent);
+
+		switch (mode) {
+		case MODE_PIPE:
+			for (size_t i = 0; i < len; i++) {
+				tx_buf[i] = (uint8_t)(sent + i);
+			}
+			res = k_pipe_put(&pipe, tx_buf, len, &len, 1,
+					 K_FOREVER);
+			break;
+		case MODE_SOCKET:
+			for (size_t i = 0; i < len; i++) {
+				tx_buf[i] = (uint8_t)(sent + i);
+			}
+			res = zsock_send(sv[0], tx_buf, len, 0);
+			len = res;
+			break;
+		default:
+			res = zsock_socketpair_send_claim(sv[0], &data, len);
+			if (res < 0 && errno == EAGAIN) {
+				(void)zsock_poll(&pfd, 1, -1);
+				continue;
+			}
+			len = res;
+			for (size_t i = 0; i < len; i++) {
+				((uint8_t *)data)[i] = (uint8_t)(sent + i);
+			}
+			res = zsock_socketpair_send_commit(sv[0], len);
+			break;
+		}
+
+		if (res < 0) {
+			printk("%s: send failed: %d\n", mode_names[mode], errno);
+			return;
+		}
+
+		sent += len;
+	}
+}
+
+static bool check(const uint8_t *data, size_t len, size_t offset)
+{
+	for (size_t i = 0; i < len; i++) {
+		if (data[i] != (uint8_t)(offset + i)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static uint32_t run(enum mode mode, size_t chunk)
+{
+	struct zsock_pollfd pfd = { .fd = sv[1], .events = ZSOCK_POLLIN };
+	uint32_t start, cycles;
+	size_t received = 0;
+	size_t len;
+	void *data;
+	int res;
+
+	k_pipe_init(&pipe, pipe_buf, sizeof(pipe_buf));
+	if (zsock_socketpair(AF_UNIX, SOCK_STREAM, 0, sv) < 0) {
+		printk("cannot create the socketpair: %d\n", errno);
+		return 0;
+	}
+
+	start = k_cycle_get_32();
+
+	/* Lower priority than the consumer, as a network stack would be */
+	k_thread_create(&producer_thread, producer_stack,
+			K_THREAD_STACK_SIZEOF(producer_stack), producer,
+			UINT_TO_POINTER(mode), UINT_TO_POINTER(chunk), NULL,
+			K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	while (received < TOTAL) {
+		switch (mode) {
+		case MODE_PIPE:
+			res = k_pipe_get(&pipe, rx_buf, chunk, &len, 1,
+					 K_FOREVER);
+			if (res == 0) {
+				res = len;
+			}
+			if (res > 0 && !check(rx_buf, len, received)) {
+				res = -EIO;
+			}
+			break;
+		case MODE_SOCKET:
+			res = zsock_recv(sv[1], rx_buf, chunk, 0);
+			len = res;
+			if (res > 0 && !check(rx_buf, len, received)) {
+				res = -EIO;
+			}
+			break;
+		default:
+			res = zsock_socketpair_recv_claim(sv[1], &data, chunk);
+			if (res < 0 && errno == EAGAIN) {
+				(void)zsock_poll(&pfd, 1, -1);
+				continue;
+			}
+			len = res;
+			if (res > 0 && !check(data, len, received)) {
+				res = -EIO;
+			}
+			(void)zsock_socketpair_recv_finish(sv[1], len);
+			break;
+		}
+
+		if (res <= 0) {
+			printk("%s: receive failed at %zu\n", mode_names[mode],
+			       received);
+			break;
+		}
+
+		received += len;
+	}
+
+	cycles = MAX(k_cycle_get_32() - start, 1U);
+
+	k_thread_join(&producer_thread, K_FOREVER);
+	(void)zsock_close(sv[0]);
+	(void)zsock_close(sv[1]);
+
+	if (received < TOTAL) {
+		return 0;
+	}
+
+	return (uint32_t)(((uint64_t)TOTAL * sys_clock_hw_cycles_per_sec()) /
+			  ((uint64_t)cycles * 1024U));
+}
+
+void main(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(chunks); i++) {
+		for (enum mode mode = MODE_PIPE; mode <= MODE_ZCOPY; mode++) {
+			uint32_t rate = run(mode, chunks[i]);
+
+			if (!rate) {
+				return;
+			}
+
+			printk("%-6s chunk %4zu kB/s %u\n", mode_names[mode],
+			       chunks[i], rate);
+		}
+	}
+	printk("fin\n");
+}
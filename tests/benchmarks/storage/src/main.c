@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <drivers/flash.h>
+#include <storage/flash_map.h>
+#include <fs/nvs.h>
+#include <settings/settings.h>
+
+#if defined(CONFIG_FILE_SYSTEM_LITTLEFS)
+#include <fs/fs.h>
+#include <fs/littlefs.h>
+#endif
+
+/* Storage benchmark.  The storage partition is used in turn by NVS, the
+ * settings and littlefs, and the time each operation takes is printed.
+ * With the timing simulation of the flash simulator, the time of
+ * native_posix only advances while the flash is busy, so the results are
+ * the flash time the storage layers need, which only changes with the
+ * way they access the flash.
+ */
+
+#define NVS_IDS 16
+#define NVS_WRITES 512
+#define NVS_DATA_LEN 32
+#define SETTINGS_ITEMS 32
+#define LFS_FILE_SIZE 4096
+#define LFS_ROUNDS 4
+
+static uint8_t data[256];
+static const struct flash_area *fa;
+
+static uint32_t elapsed_us(uint32_t start)
+{
+	return k_cyc_to_us_floor32(k_cycle_get_32() - start);
+}
+
+static int erase_storage(void)
+{
+	return flash_area_erase(fa, 0, fa->fa_size);
+}
+
+static int bench_nvs(void)
+{
+	const struct device *dev = flash_area_get_device(fa);
+	struct flash_pages_info info;
+	struct nvs_fs fs;
+	uint32_t start, us, total = 0U, max = 0U;
+	int rc;
+
+	rc = erase_storage();
+	if (rc) {
+		return rc;
+	}
+
+	fs.offset = fa->fa_off;
+	rc = flash_get_page_info_by_offs(dev, fs.offset, &info);
+	if (rc) {
+		return rc;
+	}
+
+	fs.sector_size = info.size;
+	fs.sector_count = fa->fa_size / info.size;
+
+	rc = nvs_init(&fs, dev->name);
+	if (rc) {
+		return rc;
+	}
+
+	/* Enough writes to fill the partition a few times, so that the
+	 * garbage collection is part of the average.
+	 */
+	for (int i = 0; i < NVS_WRITES; i++) {
+		data[0] = i;
+
+		start = k_cycle_get_32();
+		rc = nvs_write(&fs, i % NVS_IDS, data, NVS_DATA_LEN);
+		us = elapsed_us(start);
+		if (rc < 0) {
+			return rc;
+		}
+
+		total += us;
+		max = MAX(max, us);
+	}
+
+	printk("nvs write avg us %u max us %u\n", total / NVS_WRITES, max);
+
+	total = 0U;
+	for (int i = 0; i < NVS_WRITES; i++) {
+		start = k_cycle_get_32();
+		rc = nvs_read(&fs, i % NVS_IDS, data, NVS_DATA_LEN);
+		total += elapsed_us(start);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	printk("nvs read avg us %u\n", total / NVS_WRITES);
+
+	return 0;
+}
+
+#if defined(CONFIG_SETTINGS)
+static int loaded;
+
+static int bench_set(const char *name, size_t len, settings_read_cb read_cb,
+		     void *cb_arg)
+{
+	loaded++;
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(bench, "bench", NULL, bench_set, NULL, NULL);
+
+static int bench_settings(void)
+{
+	char name[16];
+	uint32_t start, us;
+	int rc;
+
+	rc = erase_storage();
+	if (rc) {
+		return rc;
+	}
+
+	rc = settings_subsys_init();
+	if (rc) {
+		return rc;
+	}
+
+	for (int i = 0; i < SETTINGS_ITEMS; i++) {
+		snprintk(name, sizeof(name), "bench/item%d", i);
+		rc = settings_save_one(name, data, 16);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	loaded = 0;
+	start = k_cycle_get_32();
+	rc = settings_load();
+	us = elapsed_us(start);
+	if (rc) {
+		return rc;
+	}
+
+	printk("settings load us %u items %d\n", us, loaded);
+
+	return 0;
+}
+#endif /* CONFIG_SETTINGS */
+
+#if defined(CONFIG_FILE_SYSTEM_LITTLEFS)
+FS_LITTLEFS_DECLARE_DEFAULT_CONFIG(lfs_data);
+static struct fs_mount_t lfs_mnt = {
+	.type = FS_LITTLEFS,
+	.fs_data = &lfs_data,
+	.storage_dev = (void *)FLASH_AREA_ID(storage),
+	.mnt_point = "/lfs",
+};
+
+static int lfs_transfer(const char *path, bool write, uint32_t *us)
+{
+	struct fs_file_t file;
+	uint32_t start;
+	ssize_t len;
+	int rc;
+
+	fs_file_t_init(&file);
+
+	start = k_cycle_get_32();
+
+	rc = fs_open(&file, path, write ? FS_O_CREATE | FS_O_WRITE : FS_O_READ);
+	if (rc) {
+		return rc;
+	}
+
+	for (size_t done = 0; done < LFS_FILE_SIZE; done += sizeof(data)) {
+		len = write ? fs_write(&file, data, sizeof(data)) :
+			      fs_read(&file, data, sizeof(data));
+		if (len != sizeof(data)) {
+			(void)fs_close(&file);
+			return len < 0 ? len : -EIO;
+		}
+	}
+
+	rc = fs_close(&file);
+	*us += elapsed_us(start);
+
+	return rc;
+}
+
+static int bench_littlefs(void)
+{
+	uint32_t write_us = 0U, read_us = 0U;
+	int rc;
+
+	rc = erase_storage();
+	if (rc) {
+		return rc;
+	}
+
+	rc = fs_mount(&lfs_mnt);
+	if (rc) {
+		return rc;
+	}
+
+	for (int i = 0; i < LFS_ROUNDS && !rc; i++) {
+		rc = lfs_transfer("/lfs/bench", true, &write_us);
+		if (!rc) {
+			rc = lfs_transfer("/lfs/bench", false, &read_us);
+		}
+		if (!rc) {
+			rc = fs_unlink("/lfs/bench");
+		}
+	}
+
+	(void)fs_unmount(&lfs_mnt);
+	if (rc) {
+		return rc;
+	}
+
+	/* bytes per us are the same as kB/s */
+	printk("littlefs write kB/s %u read kB/s %u\n",
+	       (uint32_t)((uint64_t)LFS_ROUNDS * LFS_FILE_SIZE * 1000U /
+			  MAX(write_us, 1U) / 1024U),
+	       (uint32_t)((uint64_t)LFS_ROUNDS * LFS_FILE_SIZE * 1000U /
+			  MAX(read_us, 1U) / 1024U));
+
+	return 0;
+}
+#endif /* CONFIG_FILE_SYSTEM_LITTLEFS */
+
+void main(void)
+{
+	int rc;
+
+	for (int i = 0; i < sizeof(data); i++) {
+		data[i] = i;
+	}
+
+	rc = flash_area_open(FLASH_AREA_ID(storage), &fa);
+	if (rc) {
+		printk("cannot open the storage partition: %d\n", rc);
+		return;
+	}
+
+	rc = bench_nvs();
+	if (rc) {
+		printk("nvs failed: %d\n", rc);
+		return;
+	}
+
+#if defined(CONFIG_SETTINGS)
+	rc = bench_settings();
+	if (rc) {
+		printk("settings failed: %d\n", rc);
+		return;
+	}
+#endif
+
+#if defined(CONFIG_FILE_SYSTEM_LITTLEFS)
+	rc = bench_littlefs();
+	if (rc) {
+		printk("littlefs failed: %d\n", rc);
+		return;
+	}
+#endif
+
+	printk("fin\n");
+}
@@ -224,6 +224,50 @@ void test_gatt_foreach(void)
 	}
 }
 
+static uint8_t find_handle(const struct bt_gatt_attr *attr, uint16_t handle,
+			   void *user_data)
+{
+	uint16_t *tmp = user_data;
+
+	*tmp = handle;
+
+	return BT_GATT_ITER_STOP;
+}
+
+void test_gatt_foreach_range(void)
+{
+	const struct bt_gatt_attr *attr;
+	uint16_t handle;
+	uint16_t num;
+
+	/* Find the services from the first test service */
+	num = 0;
+	bt_gatt_foreach_attr_type(test_attrs[0].handle, 0xffff,
+				  BT_UUID_GATT_PRIMARY, NULL, 0, count_attr,
+				  &num);
+	zassert_equal(num, 2, "Number of services don't match");
+
+	/* Iterate the attributes of a range within a service */
+	num = 0;
+	bt_gatt_foreach_attr(test1_attrs[1].handle, test1_attrs[2].handle,
+			     count_attr, &num);
+	zassert_equal(num, 2, "Number of attributes don't match");
+
+	/* Find an attribute by handle */
+	handle = 0;
+	bt_gatt_foreach_attr(test1_attrs[2].handle, 0xffff, find_handle,
+			     &handle);
+	zassert_equal(handle, test1_attrs[2].handle, "Handle don't match");
+
+	/* Static attributes get their handle from their position */
+	attr = NULL;
+	bt_gatt_foreach_attr_type(0x0001, 0x0001, NULL, NULL, 1, find_attr,
+				  &attr);
+	zassert_not_null(attr, "Attribute don't match");
+	zassert_equal(bt_gatt_attr_get_handle(attr), 0x0001,
+		      "Handle don't match");
+}
+
 void test_gatt_read(void)
 {
 	const struct bt_gatt_attr *attr;
@@ -272,6 +316,7 @@ void test_main(void)
 			 ztest_unit_test(test_gatt_register),
 			 ztest_unit_test(test_gatt_unregister),
 			 ztest_unit_test(test_gatt_foreach),
+			 ztest_unit_test(test_gatt_foreach_range),
 			 ztest_unit_test(test_gatt_read),
 			 ztest_unit_test(test_gatt_write));
 	ztest_run_test_suite(test_gatt);
@@ -279,6 +279,81 @@ static void test_get_erase_value(void)
 		      FLASH_SIMULATOR_ERASE_VALUE);
 }
 
+#if defined(CONFIG_FLASH_ASYNC)
+static int async_cb_result;
+static int async_cb_count;
+
+static void async_cb(const struct device *dev, struct flash_async_op *op,
+		     int result)
+{
+	zassert_equal(dev, flash_dev, "Unexpected device");
+	async_cb_result = result;
+	async_cb_count++;
+}
+
+static int async_wait(struct k_poll_signal *signal)
+{
+	struct k_poll_event event = K_POLL_EVENT_INITIALIZER(
+		K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, signal);
+	unsigned int signaled;
+	int result;
+
+	zassert_equal(0, k_poll(&event, 1, K_SECONDS(1)),
+		      "Operation not completed");
+	k_poll_signal_check(signal, &signaled, &result);
+	zassert_true(signaled, "Signal not raised");
+	k_poll_signal_reset(signal);
+
+	return result;
+}
+#endif
+
+static void test_async(void)
+{
+#if defined(CONFIG_FLASH_ASYNC)
+	struct flash_async_op erase_op = { 0 };
+	struct flash_async_op write_op = { 0 };
+	struct flash_async_op read_op = { 0 };
+	struct k_poll_signal signal;
+	uint32_t data[4] = { 0x01234567, 0x89abcdef, 0x76543210, 0xfedcba98 };
+	uint32_t r_data[ARRAY_SIZE(data)];
+	int rc;
+
+	k_poll_signal_init(&signal);
+	async_cb_count = 0;
+
+	/* Queued together, the operations complete in order. */
+	erase_op.cb = async_cb;
+	write_op.cb = async_cb;
+	read_op.signal = &signal;
+
+	rc = flash_erase_async(flash_dev, FLASH_SIMULATOR_BASE_OFFSET,
+			       FLASH_SIMULATOR_ERASE_UNIT, &erase_op);
+	zassert_equal(0, rc, "flash_erase_async should succeed");
+	rc = flash_write_async(flash_dev, FLASH_SIMULATOR_BASE_OFFSET, data,
+			       sizeof(data), &write_op);
+	zassert_equal(0, rc, "flash_write_async should succeed");
+	rc = flash_read_async(flash_dev, FLASH_SIMULATOR_BASE_OFFSET, r_data,
+			      sizeof(r_data), &read_op);
+	zassert_equal(0, rc, "flash_read_async should succeed");
+
+	zassert_equal(0, async_wait(&signal), "Read should succeed");
+	zassert_equal(2, async_cb_count, "Erase and write not completed");
+	zassert_equal(0, async_cb_result, "Write should succeed");
+	zassert_mem_equal(data, r_data, sizeof(data), "Unexpected data");
+
+	/* Errors are reported with the completion. */
+	write_op.cb = NULL;
+	write_op.signal = &signal;
+	rc = flash_write_async(flash_dev, FLASH_SIMULATOR_BASE_OFFSET, data,
+			       sizeof(data), &write_op);
+	zassert_equal(0, rc, "flash_write_async should succeed");
+	zassert_equal(-EIO, async_wait(&signal), "Double write should fail");
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(flash_sim_api,
@@ -289,7 +364,8 @@ void test_main(void)
 			 ztest_unit_test(test_out_of_bounds),
 			 ztest_unit_test(test_align),
 			 ztest_unit_test(test_get_erase_value),
-			 ztest_unit_test(test_double_write));
+			 ztest_unit_test(test_double_write),
+			 ztest_unit_test(test_async));
 
 	ztest_run_test_suite(flash_sim_api);
 }
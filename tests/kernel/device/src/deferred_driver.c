@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <device.h>
+
+#define DT_DRV_COMPAT vnd_deferred_device
+
+/* Number of times each instance was initialized. */
+int deferred_init_count[DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT)];
+
+static int deferred_driver_init(const struct device *dev)
+{
+	int *count = (int *)dev->config;
+
+	(*count)++;
+
+	return 0;
+}
+
+#define DEFERRED_DEVICE_DEFINE(n)					\
+	DEVICE_DT_INST_DEFINE(n, deferred_driver_init, NULL, NULL,	\
+			      &deferred_init_count[n], POST_KERNEL,	\
+			      CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, NULL);
+
+DT_INST_FOREACH_STATUS_OKAY(DEFERRED_DEVICE_DEFINE)
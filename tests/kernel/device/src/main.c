@@ -465,6 +465,43 @@ void test_abstraction_driver_common(void)
 	zassert_true(baz == 2, "common API do_that fail");
 }
 
+#ifdef CONFIG_DEVICE_DEFERRED_INIT
+extern int deferred_init_count[];
+
+/**
+ * @brief Test devices initialized on first use
+ *
+ * @details The devices with the zephyr,deferred-init property are not
+ * initialized at boot, but once, by the first of device_is_ready(),
+ * device_get_binding() or device_init().
+ *
+ * @ingroup kernel_device_tests
+ */
+void test_deferred_init(void)
+{
+	const struct device *dev0 = DEVICE_DT_GET(DT_NODELABEL(fakedeferred0));
+	const struct device *dev1 = DEVICE_DT_GET(DT_NODELABEL(fakedeferred1));
+
+	zassert_equal(deferred_init_count[0], 0, "initialized at boot");
+	zassert_equal(deferred_init_count[1], 0, "initialized at boot");
+
+	zassert_true(device_is_ready(dev0), "not initialized on first use");
+	zassert_equal(deferred_init_count[0], 1, "not initialized once");
+	zassert_equal(device_init(dev0), 0, "initialization failed");
+	zassert_equal(deferred_init_count[0], 1, "initialized again");
+
+	zassert_equal(device_get_binding("FAKE_DEFERRED_1"), dev1,
+		      "not found by name");
+	zassert_equal(deferred_init_count[1], 1, "not initialized once");
+	zassert_true(device_is_ready(dev1), "not ready");
+	zassert_equal(deferred_init_count[1], 1, "initialized again");
+}
+#else
+void test_deferred_init(void)
+{
+	ztest_test_skip();
+}
+#endif
 
 /**
  * @}
@@ -483,6 +520,7 @@ void test_main(void)
 			 ztest_user_unit_test(test_dynamic_name),
 			 ztest_unit_test(test_device_init_level),
 			 ztest_unit_test(test_device_init_priority),
+			 ztest_unit_test(test_deferred_init),
 			 ztest_unit_test(test_abstraction_driver_common),
 			 ztest_unit_test(test_mmio_single),
 			 ztest_unit_test(test_mmio_multiple),
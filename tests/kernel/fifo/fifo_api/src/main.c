@@ -13,6 +13,7 @@
  *   -# k_fifo_init K_FIFO_DEFINE
  *   -# k_fifo_put k_fifo_put_list k_fifo_put_slist
  *   -# k_fifo_get *
+ *   -# k_fifo_get_batch k_fifo_get_all k_lifo_get_batch
  *
  * @defgroup kernel_fifo_tests FIFOs
  * @ingroup all_tests
@@ -29,6 +30,9 @@ extern void test_fifo_loop(void);
 extern void test_fifo_cancel_wait(void);
 extern void test_fifo_is_empty_thread(void);
 extern void test_fifo_is_empty_isr(void);
+extern void test_fifo_get_batch(void);
+extern void test_fifo_get_batch_wait(void);
+extern void test_lifo_get_batch(void);
 
 /*test case main entry*/
 void test_main(void)
@@ -41,6 +45,9 @@ void test_main(void)
 			 ztest_1cpu_unit_test(test_fifo_loop),
 			 ztest_1cpu_unit_test(test_fifo_cancel_wait),
 			 ztest_unit_test(test_fifo_is_empty_thread),
-			 ztest_unit_test(test_fifo_is_empty_isr));
+			 ztest_unit_test(test_fifo_is_empty_isr),
+			 ztest_unit_test(test_fifo_get_batch),
+			 ztest_1cpu_unit_test(test_fifo_get_batch_wait),
+			 ztest_unit_test(test_lifo_get_batch));
 	ztest_run_test_suite(fifo_api);
 }
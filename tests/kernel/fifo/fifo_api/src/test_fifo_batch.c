@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_fifo.h"
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define LIST_LEN 6
+#define BATCH_LEN 4
+
+static struct k_fifo fifo_b;
+static struct k_lifo lifo_b;
+static fdata_t data[LIST_LEN];
+
+static K_THREAD_STACK_DEFINE(tstack, STACK_SIZE);
+static struct k_thread tdata;
+
+static void tfifo_batch_put_entry(void *p1, void *p2, void *p3)
+{
+	struct k_fifo *pfifo = p1;
+
+	k_sleep(K_MSEC(10));
+
+	for (int i = 0; i < LIST_LEN; i++) {
+		k_fifo_put(pfifo, &data[i]);
+	}
+}
+
+static void tlist_check(sys_slist_t *list, int first, int count, int step)
+{
+	sys_snode_t *node;
+	int i = 0;
+
+	SYS_SLIST_FOR_EACH_NODE(list, node) {
+		zassert_equal(node, &data[first + i * step].snode,
+			      "item %d out of order", i);
+		i++;
+	}
+
+	zassert_equal(i, count, NULL);
+}
+
+/**
+ * @addtogroup kernel_fifo_tests
+ * @{
+ */
+
+/**
+ * @brief Test getting the items of a FIFO queue at once
+ * @see k_fifo_get_batch(), k_fifo_get_all()
+ */
+void test_fifo_get_batch(void)
+{
+	sys_slist_t list;
+	int ret;
+
+	k_fifo_init(&fifo_b);
+	sys_slist_init(&list);
+
+	/**TESTPOINT: nothing to get*/
+	ret = k_fifo_get_batch(&fifo_b, &list, BATCH_LEN, K_NO_WAIT);
+	zassert_equal(ret, 0, NULL);
+	zassert_true(sys_slist_is_empty(&list), NULL);
+
+	for (int i = 0; i < LIST_LEN; i++) {
+		k_fifo_put(&fifo_b, &data[i]);
+	}
+
+	/**TESTPOINT: get up to a number of items*/
+	ret = k_fifo_get_batch(&fifo_b, &list, BATCH_LEN, K_NO_WAIT);
+	zassert_equal(ret, BATCH_LEN, NULL);
+	tlist_check(&list, 0, BATCH_LEN, 1);
+
+	/**TESTPOINT: get the remaining items, appended to the list*/
+	ret = k_fifo_get_all(&fifo_b, &list, K_NO_WAIT);
+	zassert_equal(ret, LIST_LEN - BATCH_LEN, NULL);
+	tlist_check(&list, 0, LIST_LEN, 1);
+	zassert_true(k_fifo_is_empty(&fifo_b), NULL);
+
+	/**TESTPOINT: the items can be put back at once*/
+	k_fifo_put_slist(&fifo_b, &list);
+	sys_slist_init(&list);
+	ret = k_fifo_get_all(&fifo_b, &list, K_NO_WAIT);
+	zassert_equal(ret, LIST_LEN, NULL);
+	tlist_check(&list, 0, LIST_LEN, 1);
+}
+
+/**
+ * @brief Test waiting for the items of a FIFO queue
+ * @see k_fifo_get_batch()
+ */
+void test_fifo_get_batch_wait(void)
+{
+	sys_slist_t list;
+	k_tid_t tid;
+	int ret;
+
+	k_fifo_init(&fifo_b);
+	sys_slist_init(&list);
+
+	/**TESTPOINT: timeout*/
+	ret = k_fifo_get_batch(&fifo_b, &list, BATCH_LEN, K_MSEC(10));
+	zassert_equal(ret, 0, NULL);
+	zassert_true(sys_slist_is_empty(&list), NULL);
+
+	/**TESTPOINT: woken up by the first item*/
+	tid = k_thread_create(&tdata, tstack, STACK_SIZE,
+			      tfifo_batch_put_entry, &fifo_b, NULL, NULL,
+			      K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	ret = k_fifo_get_batch(&fifo_b, &list, BATCH_LEN, K_FOREVER);
+	zassert_true(ret >= 1 && ret <= BATCH_LEN, NULL);
+	tlist_check(&list, 0, ret, 1);
+
+	k_thread_join(tid, K_FOREVER);
+}
+
+/**
+ * @brief Test getting the items of a LIFO queue at once
+ * @see k_lifo_get_batch()
+ */
+void test_lifo_get_batch(void)
+{
+	sys_slist_t list;
+	int ret;
+
+	k_lifo_init(&lifo_b);
+	sys_slist_init(&list);
+
+	for (int i = 0; i < LIST_LEN; i++) {
+		k_lifo_put(&lifo_b, &data[i]);
+	}
+
+	/**TESTPOINT: the last items put are got first*/
+	ret = k_lifo_get_batch(&lifo_b, &list, SIZE_MAX, K_NO_WAIT);
+	zassert_equal(ret, LIST_LEN, NULL);
+	tlist_check(&list, LIST_LEN - 1, LIST_LEN, -1);
+}
+
+/**
+ * @}
+ */
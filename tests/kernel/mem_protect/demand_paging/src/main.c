@@ -9,12 +9,17 @@
 #include <timing/timing.h>
 #include <mmu.h>
 
-#ifdef CONFIG_BACKING_STORE_RAM_PAGES
-#define EXTRA_PAGES	(CONFIG_BACKING_STORE_RAM_PAGES - 1)
+#if defined(CONFIG_BACKING_STORE_RAM_PAGES)
+#define BACKING_STORE_PAGES	CONFIG_BACKING_STORE_RAM_PAGES
+#elif defined(CONFIG_BACKING_STORE_COMPRESSED_PAGES)
+/* The pool is configured to hold as many uncompressed pages as slots */
+#define BACKING_STORE_PAGES	CONFIG_BACKING_STORE_COMPRESSED_PAGES
 #else
 #error "Unsupported configuration"
 #endif
 
+#define EXTRA_PAGES	(BACKING_STORE_PAGES - 1)
+
 #ifdef CONFIG_DEMAND_PAGING_TIMING_HISTOGRAM
 #ifdef CONFIG_DEMAND_PAGING_STATS_USING_TIMING_FUNCTIONS
 
@@ -108,6 +113,12 @@ void print_paging_stats(struct k_mem_paging_stats_t *stats, const char *scope)
 	       stats->eviction.clean);
 	printk("    - Dirty pages evicted: %lu\n",
 	       stats->eviction.dirty);
+
+#ifdef CONFIG_DEMAND_PAGING_PREFETCH
+	printk("* Prefetch (%s):\n", scope);
+	printk("    - Fault-around pages: %lu\n", stats->prefetch.around);
+	printk("    - Sequential pages: %lu\n", stats->prefetch.sequential);
+#endif
 }
 
 void test_touch_anon_pages(void)
@@ -283,6 +294,50 @@ void test_k_mem_unpin(void)
 	test_k_mem_page_out();
 }
 
+void test_prefetch(void)
+{
+#ifdef CONFIG_DEMAND_PAGING_PREFETCH
+	struct k_mem_paging_stats_t before, after;
+	unsigned long faults;
+	size_t around, sequential_max;
+	int key, ret;
+
+	zassert_equal(k_mem_paging_prefetch_set(Z_NUM_PAGE_FRAMES, 0),
+		      -EINVAL, NULL);
+
+	ret = k_mem_paging_prefetch_set(4, 8);
+	zassert_equal(ret, 0, "k_mem_paging_prefetch_set failed with %d", ret);
+	k_mem_paging_prefetch_get(&around, &sequential_max);
+	zassert_equal(around, 4, NULL);
+	zassert_equal(sequential_max, 8, NULL);
+
+	key = irq_lock();
+	ret = k_mem_page_out(arena, HALF_BYTES);
+	zassert_equal(ret, 0, "k_mem_page_out failed with %d", ret);
+
+	k_mem_paging_stats_get(&before);
+	faults = z_num_pagefaults_get();
+	for (size_t i = 0; i < HALF_BYTES; i++) {
+		zassert_equal(arena[i], nums[i % 10], "arena corrupted");
+	}
+	faults = z_num_pagefaults_get() - faults;
+	k_mem_paging_stats_get(&after);
+	irq_unlock(key);
+
+	/* Restore the policy the other tests count faults with */
+	zassert_equal(k_mem_paging_prefetch_set(0, 0), 0, NULL);
+
+	/**TESTPOINT: fewer faults than pages, the rest was prefetched */
+	zassert_true(faults < HALF_PAGES, "%lu page faults for %lu pages",
+		     faults, HALF_PAGES);
+	zassert_true(faults + (after.prefetch.around - before.prefetch.around) +
+		     (after.prefetch.sequential - before.prefetch.sequential) >=
+		     HALF_PAGES, NULL);
+#else
+	ztest_test_skip();
+#endif
+}
+
 /* Show that even if we map enough anonymous memory to fill the backing
  * store, we can still handle pagefaults.
  * This eats up memory so should be last in the suite.
@@ -292,7 +347,7 @@ void test_backing_store_capacity(void)
 	char *mem, *ret;
 	int key;
 	unsigned long faults;
-	size_t size = (((CONFIG_BACKING_STORE_RAM_PAGES - 1) - HALF_PAGES) *
+	size_t size = (((BACKING_STORE_PAGES - 1) - HALF_PAGES) *
 		       CONFIG_MMU_PAGE_SIZE);
 
 	/* Consume the rest of memory */
@@ -348,6 +403,22 @@ void test_user_get_stats(void)
 
 }
 
+/* Test if we can get a working set snapshot under usermode */
+void test_user_get_working_set(void)
+{
+	struct k_mem_paging_working_set_t ws;
+
+	k_mem_paging_working_set_get(&ws);
+	printk("Working set: %lu resident, %lu accessed, %lu dirty, "
+	       "%lu pinned\n", ws.resident, ws.accessed, ws.dirty, ws.pinned);
+
+	/* At the very least the kernel image is pinned */
+	zassert_not_equal(ws.pinned, 0UL, "no pinned page frames?");
+	zassert_not_equal(ws.resident, 0UL, "no evictable page frames?");
+	zassert_true(ws.accessed <= ws.resident, NULL);
+	zassert_true(ws.dirty <= ws.resident, NULL);
+}
+
 /* Print the histogram and return true if histogram has non-zero values
  * in one of its bins.
  */
@@ -403,6 +474,11 @@ void test_user_get_hist(void)
 /* ztest main entry*/
 void test_main(void)
 {
+#ifdef CONFIG_DEMAND_PAGING_PREFETCH
+	/* Tests count one fault per page unless said otherwise */
+	(void)k_mem_paging_prefetch_set(0, 0);
+#endif
+
 	ztest_test_suite(test_demand_paging,
 			ztest_unit_test(test_map_anon_pages),
 			ztest_unit_test(test_touch_anon_pages),
@@ -410,8 +486,10 @@ void test_main(void)
 			ztest_unit_test(test_k_mem_page_in),
 			ztest_unit_test(test_k_mem_pin),
 			ztest_unit_test(test_k_mem_unpin),
+			ztest_unit_test(test_prefetch),
 			ztest_unit_test(test_backing_store_capacity),
 			ztest_user_unit_test(test_user_get_stats),
+			ztest_user_unit_test(test_user_get_working_set),
 			ztest_user_unit_test(test_user_get_hist));
 
 	ztest_run_test_suite(test_demand_paging);
@@ -192,6 +192,52 @@ void test_z_phys_unmap(void)
 	ztest_test_fail();
 }
 
+/**
+ * Show that z_phys_map() places regions spanning large pages so that
+ * they can be mapped with them, and that such mappings access the right
+ * memory
+ *
+ * @ingroup kernel_memprotect_tests
+ */
+void test_z_phys_map_large(void)
+{
+#if CONFIG_MMU_LARGE_PAGE_SIZE > CONFIG_MMU_PAGE_SIZE
+	const size_t large = CONFIG_MMU_LARGE_PAGE_SIZE;
+	uintptr_t test_phys = z_mem_phys_addr(test_page);
+	uintptr_t phys;
+	uint8_t *mapped;
+
+	/* Two large pages of RAM around test_page, offset by a page so
+	 * that only one can be mapped as such
+	 */
+	phys = ROUND_DOWN(test_phys, large) + CONFIG_MMU_PAGE_SIZE;
+	if (phys > test_phys) {
+		phys -= large;
+	}
+	if (phys < Z_PHYS_RAM_START || phys + 2 * large > Z_PHYS_RAM_END) {
+		ztest_test_skip();
+	}
+
+	expect_fault = false;
+	test_page[0] = 42;
+	test_page[sizeof(test_page) - 1] = 24;
+
+	z_phys_map(&mapped, phys, 2 * large, BASE_FLAGS);
+
+	/**TESTPOINT: virtual and physical offsets into large pages agree */
+	zassert_equal(((uintptr_t)mapped - phys) % large, 0,
+		      "%p not congruent with 0x%lx", mapped, phys);
+
+	zassert_equal(mapped[test_phys - phys], 42, NULL);
+	zassert_equal(mapped[test_phys - phys + sizeof(test_page) - 1], 24,
+		      NULL);
+
+	z_phys_unmap(mapped, 2 * large);
+#else
+	ztest_test_skip();
+#endif
+}
+
 /**
  * Basic k_mem_map() and k_mem_unmap() functionality
  *
@@ -420,6 +466,7 @@ void test_main(void)
 			ztest_unit_test(test_z_phys_map_exec),
 			ztest_unit_test(test_z_phys_map_side_effect),
 			ztest_unit_test(test_z_phys_unmap),
+			ztest_unit_test(test_z_phys_map_large),
 			ztest_unit_test(test_k_mem_map_unmap),
 			ztest_unit_test(test_k_mem_map_guard_before),
 			ztest_unit_test(test_k_mem_map_guard_after),
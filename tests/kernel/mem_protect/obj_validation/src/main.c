@@ -10,6 +10,7 @@
 #include <kernel_internal.h>
 
 #define SEM_ARRAY_SIZE	16
+#define DYN_OBJ_COUNT	64
 
 /* Show that extern declarations don't interfere with detecting kernel
  * objects, this was at one point a problem.
@@ -20,6 +21,7 @@ static struct k_sem semarray[SEM_ARRAY_SIZE];
 static struct k_sem *dyn_sem[SEM_ARRAY_SIZE];
 
 static struct k_mutex *test_dyn_mutex;
+static struct k_sem *dyn_objs[DYN_OBJ_COUNT];
 
 K_SEM_DEFINE(sem1, 0, 1);
 static struct k_sem sem2;
@@ -183,6 +185,58 @@ void test_no_ref_dyn_kobj_release_mem(void)
 	zassert_true(ret == -EBADF, "Dynamic kernel object not released");
 }
 
+static void check_dyn_objs(int first, int step)
+{
+	for (int i = 0; i < DYN_OBJ_COUNT; i++) {
+		struct z_object *ko = z_object_find(dyn_objs[i]);
+		bool live = i >= first && ((i - first) % step) == 0;
+
+		zassert_equal(ko != NULL, live, "object %d wrongly %s", i,
+			      live ? "missing" : "found");
+		if (live) {
+			zassert_equal_ptr(ko->name, dyn_objs[i], NULL);
+		}
+	}
+}
+
+/**
+ * @brief Test lookup of many dynamic kernel objects
+ *
+ * @details Allocate enough objects for the dynamic object index to grow
+ * several times, then free them out of order so that it shrinks again, and
+ * check that exactly the live objects are found all along.
+ *
+ * @ingroup kernel_memprotect_tests
+ *
+ * @see k_object_alloc(), k_object_free()
+ */
+void test_dyn_obj_lookup(void)
+{
+	for (int i = 0; i < DYN_OBJ_COUNT; i++) {
+		dyn_objs[i] = k_object_alloc(K_OBJ_SEM);
+		zassert_not_null(dyn_objs[i], "couldn't allocate semaphore");
+	}
+	check_dyn_objs(0, 1);
+
+	for (int i = 1; i < DYN_OBJ_COUNT; i += 2) {
+		k_object_free(dyn_objs[i]);
+	}
+	check_dyn_objs(0, 2);
+
+	for (int i = 2; i < DYN_OBJ_COUNT; i += 4) {
+		k_object_free(dyn_objs[i]);
+	}
+	check_dyn_objs(0, 4);
+
+	for (int i = 0; i < DYN_OBJ_COUNT - 4; i += 4) {
+		k_object_free(dyn_objs[i]);
+	}
+	check_dyn_objs(DYN_OBJ_COUNT - 4, 4);
+
+	k_object_free(dyn_objs[DYN_OBJ_COUNT - 4]);
+	zassert_is_null(z_object_find(dyn_objs[DYN_OBJ_COUNT - 4]), NULL);
+}
+
 void test_main(void)
 {
 	k_thread_system_pool_assign(k_current_get());
@@ -190,7 +244,8 @@ void test_main(void)
 	ztest_test_suite(object_validation,
 			 ztest_unit_test(test_generic_object),
 			 ztest_unit_test(test_kobj_assign_perms_on_alloc_obj),
-			 ztest_unit_test(test_no_ref_dyn_kobj_release_mem)
+			 ztest_unit_test(test_no_ref_dyn_kobj_release_mem),
+			 ztest_unit_test(test_dyn_obj_lookup)
 			 );
 	ztest_run_test_suite(object_validation);
 }
@@ -10,6 +10,7 @@
 #include <linker/linker-defs.h>
 #include "test_syscalls.h"
 #include <mmu.h>
+#include <sys/syscall_batch.h>
 
 #define BUF_SIZE	32
 #define SLEEP_MS_LONG	15000
@@ -316,6 +317,44 @@ void test_more_args(void)
 		      "syscall didn't match impl");
 }
 
+#ifdef CONFIG_SYSCALL_BATCH
+ZTEST_BMEM struct k_syscall_desc batch[4];
+K_SEM_DEFINE(batch_sem, 0, 4);
+#endif
+
+void test_syscall_batch(void)
+{
+#ifdef CONFIG_SYSCALL_BATCH
+	struct k_syscall_desc descs[] = {
+		K_SYSCALL_DESC_INITIALIZER(K_SYSCALL_K_SEM_GIVE,
+					   (uintptr_t)&batch_sem),
+		K_SYSCALL_DESC_INITIALIZER(K_SYSCALL_K_SEM_GIVE,
+					   (uintptr_t)&batch_sem),
+		K_SYSCALL_DESC_INITIALIZER(K_SYSCALL_SYSCALL_CONTEXT),
+		K_SYSCALL_DESC_INITIALIZER(K_SYSCALL_K_SEM_COUNT_GET,
+					   (uintptr_t)&batch_sem),
+	};
+
+	memcpy(batch, descs, sizeof(batch));
+	zassert_equal(k_syscall_batch(batch, ARRAY_SIZE(batch)),
+		      ARRAY_SIZE(batch), "batch not fully executed");
+	zassert_true(batch[2].ret, "not reported in user syscall");
+	zassert_equal(batch[3].ret, 2, "semaphore not given twice");
+	zassert_equal(k_sem_count_get(&batch_sem), 2, NULL);
+
+	/**TESTPOINT: a batch stops at invalid and nested calls */
+	batch[1].id = K_SYSCALL_K_SYSCALL_BATCH;
+	batch[1].args[0] = (uintptr_t)batch;
+	batch[1].args[1] = 1;
+	zassert_equal(k_syscall_batch(batch, ARRAY_SIZE(batch)), 1, NULL);
+	batch[0].id = K_SYSCALL_LIMIT;
+	zassert_equal(k_syscall_batch(batch, ARRAY_SIZE(batch)), 0, NULL);
+	zassert_equal(k_sem_count_get(&batch_sem), 3, NULL);
+#else
+	ztest_test_skip();
+#endif
+}
+
 #define NR_THREADS	(CONFIG_MP_NUM_CPUS * 4)
 #define STACK_SZ	(1024 + CONFIG_TEST_EXTRA_STACKSIZE)
 
@@ -432,6 +471,9 @@ void test_main(void)
 	sprintf(kernel_string, "this is a kernel string");
 	sprintf(user_string, "this is a user string");
 	k_thread_heap_assign(k_current_get(), &test_heap);
+#ifdef CONFIG_SYSCALL_BATCH
+	k_thread_access_grant(k_current_get(), &batch_sem);
+#endif
 
 	ztest_test_suite(syscalls,
 			 ztest_unit_test(test_string_nlen),
@@ -441,6 +483,7 @@ void test_main(void)
 			 ztest_user_unit_test(test_user_string_alloc_copy),
 			 ztest_user_unit_test(test_arg64),
 			 ztest_user_unit_test(test_more_args),
+			 ztest_user_unit_test(test_syscall_batch),
 			 ztest_unit_test(test_syscall_torture),
 			 ztest_unit_test(test_syscall_context)
 			 );
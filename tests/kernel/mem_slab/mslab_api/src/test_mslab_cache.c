@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include "test_mslab.h"
+
+#define CACHE_BLK_NUM (8 * CONFIG_MP_NUM_CPUS * 4)
+
+K_MEM_SLAB_DEFINE(cslab, BLK_SIZE, CACHE_BLK_NUM, BLK_ALIGN);
+
+/**
+ * @brief Verify memory slab accounting with per-CPU caches
+ *
+ * @details Allocate every block of a slab large enough to be cached,
+ * free them all, and repeat, checking that no block gets stranded and
+ * that the used/free counts only reflect blocks held by the caller.
+ * With CONFIG_MEM_SLAB_CPU_CACHE, also check that the second round
+ * is served from the per-CPU cache.
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+void test_mslab_cache(void)
+{
+	static void *block[CACHE_BLK_NUM];
+	void *extra;
+
+	for (int round = 0; round < 2; round++) {
+		for (int i = 0; i < CACHE_BLK_NUM; i++) {
+			zassert_equal(k_mem_slab_alloc(&cslab, &block[i],
+						       K_NO_WAIT), 0, NULL);
+			zassert_equal(k_mem_slab_num_used_get(&cslab), i + 1,
+				      NULL);
+		}
+		zassert_equal(k_mem_slab_num_free_get(&cslab), 0, NULL);
+		zassert_equal(k_mem_slab_alloc(&cslab, &extra, K_NO_WAIT),
+			      -ENOMEM, NULL);
+
+		for (int i = 0; i < CACHE_BLK_NUM; i++) {
+			k_mem_slab_free(&cslab, &block[i]);
+		}
+		zassert_equal(k_mem_slab_num_used_get(&cslab), 0, NULL);
+		zassert_equal(k_mem_slab_num_free_get(&cslab), CACHE_BLK_NUM,
+			      NULL);
+	}
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	struct k_mem_slab_cache_stats stats;
+
+	zassert_equal(k_mem_slab_cache_stats_get(&cslab, &stats), 0, NULL);
+	zassert_true(stats.hits > stats.misses, NULL);
+	zassert_true(stats.cached > 0, NULL);
+	zassert_equal(k_mem_slab_cache_stats_get(&cslab, NULL), -EINVAL, NULL);
+#endif
+}
@@ -23,6 +23,10 @@ extern void test_msgq_alloc(void);
 extern void test_msgq_pend_thread(void);
 extern void test_msgq_empty(void);
 extern void test_msgq_full(void);
+extern void test_msgq_spsc(void);
+extern void test_msgq_spsc_pend(void);
+extern void test_msgq_spsc_stream(void);
+extern void test_msgq_spsc_poll(void);
 #ifdef CONFIG_USERSPACE
 extern void test_msgq_user_thread(void);
 extern void test_msgq_user_thread_overflow(void);
@@ -84,6 +88,10 @@ void test_main(void)
 			 ztest_1cpu_unit_test(test_msgq_pend_thread),
 			 ztest_1cpu_unit_test(test_msgq_empty),
 			 ztest_1cpu_unit_test(test_msgq_full),
+			 ztest_1cpu_unit_test(test_msgq_spsc),
+			 ztest_1cpu_unit_test(test_msgq_spsc_pend),
+			 ztest_1cpu_unit_test(test_msgq_spsc_stream),
+			 ztest_1cpu_unit_test(test_msgq_spsc_poll),
 			 ztest_unit_test(test_msgq_alloc));
 	ztest_run_test_suite(msgq_api);
 }
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#ifdef CONFIG_MSGQ_SPSC
+
+#define SPSC_MSGS 64
+
+static struct k_msgq spsc_msgq;
+static char __aligned(4) spsc_buffer[MSG_SIZE * MSGQ_LEN];
+static K_THREAD_STACK_DEFINE(spsc_stack, STACK_SIZE);
+static struct k_thread spsc_thread;
+
+static void spsc_consumer(void *p1, void *p2, void *p3)
+{
+	uint32_t *rx = p1;
+	int count = POINTER_TO_INT(p2);
+
+	for (int i = 0; i < count; i++) {
+		zassert_equal(k_msgq_get(&spsc_msgq, &rx[i], K_FOREVER), 0,
+			      NULL);
+	}
+}
+
+static void spsc_producer(void *p1, void *p2, void *p3)
+{
+	uint32_t first = POINTER_TO_INT(p1);
+	int count = POINTER_TO_INT(p2);
+
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t msg = first + i;
+
+		zassert_equal(k_msgq_put(&spsc_msgq, &msg, K_FOREVER), 0, NULL);
+	}
+}
+
+static void spsc_isr_put(const void *param)
+{
+	uint32_t msg = POINTER_TO_INT(param);
+
+	zassert_equal(k_msgq_put(&spsc_msgq, &msg, K_NO_WAIT), 0, NULL);
+}
+
+/**
+ * @brief Test the non-blocking operations of an SPSC message queue
+ *
+ * @ingroup kernel_message_queue_tests
+ *
+ * @see k_msgq_spsc_init()
+ */
+void test_msgq_spsc(void)
+{
+	struct k_msgq_attrs attrs;
+	uint32_t msg, rx;
+
+	k_msgq_spsc_init(&spsc_msgq, spsc_buffer, MSG_SIZE, MSGQ_LEN);
+
+	/* wrap around the ring a few times */
+	for (msg = 0; msg < 3 * MSGQ_LEN; msg++) {
+		zassert_equal(k_msgq_put(&spsc_msgq, &msg, K_NO_WAIT), 0, NULL);
+		zassert_equal(k_msgq_num_used_get(&spsc_msgq), 1, NULL);
+		zassert_equal(k_msgq_peek(&spsc_msgq, &rx), 0, NULL);
+		zassert_equal(rx, msg, NULL);
+		zassert_equal(k_msgq_get(&spsc_msgq, &rx, K_NO_WAIT), 0, NULL);
+		zassert_equal(rx, msg, NULL);
+	}
+
+	zassert_equal(k_msgq_get(&spsc_msgq, &rx, K_NO_WAIT), -ENOMSG, NULL);
+	zassert_equal(k_msgq_peek(&spsc_msgq, &rx), -ENOMSG, NULL);
+
+	for (msg = 0; msg < MSGQ_LEN; msg++) {
+		zassert_equal(k_msgq_put(&spsc_msgq, &msg, K_NO_WAIT), 0, NULL);
+	}
+	zassert_equal(k_msgq_put(&spsc_msgq, &msg, K_NO_WAIT), -ENOMSG, NULL);
+	zassert_equal(k_msgq_num_free_get(&spsc_msgq), 0, NULL);
+
+	k_msgq_get_attrs(&spsc_msgq, &attrs);
+	zassert_equal(attrs.used_msgs, MSGQ_LEN, NULL);
+
+	/**TESTPOINT: a purge drops everything and keeps the ring usable */
+	k_msgq_purge(&spsc_msgq);
+	zassert_equal(k_msgq_num_used_get(&spsc_msgq), 0, NULL);
+	zassert_equal(k_msgq_peek(&spsc_msgq, &rx), -ENOMSG, NULL);
+
+	irq_offload(spsc_isr_put, INT_TO_POINTER(MSG0));
+	zassert_equal(k_msgq_get(&spsc_msgq, &rx, K_NO_WAIT), 0, NULL);
+	zassert_equal(rx, MSG0, NULL);
+}
+
+/**
+ * @brief Test pending on an empty or full SPSC message queue
+ *
+ * @details A blocked reader must be handed the next message and a
+ * blocked writer must get its message queued by the read that makes
+ * room, without either losing FIFO order.
+ *
+ * @ingroup kernel_message_queue_tests
+ *
+ * @see k_msgq_spsc_init()
+ */
+void test_msgq_spsc_pend(void)
+{
+	uint32_t rx[MSGQ_LEN + 1];
+	uint32_t msg;
+
+	k_msgq_spsc_init(&spsc_msgq, spsc_buffer, MSG_SIZE, MSGQ_LEN);
+
+	/**TESTPOINT: the reader blocks on the empty queue */
+	k_thread_create(&spsc_thread, spsc_stack, STACK_SIZE, spsc_consumer,
+			rx, INT_TO_POINTER(1), NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS);
+
+	msg = MSG1;
+	zassert_equal(k_msgq_put(&spsc_msgq, &msg, K_NO_WAIT), 0, NULL);
+	k_thread_join(&spsc_thread, K_FOREVER);
+	zassert_equal(rx[0], MSG1, NULL);
+	zassert_equal(k_msgq_num_used_get(&spsc_msgq), 0, NULL);
+
+	/**TESTPOINT: the writer blocks on the full queue */
+	k_thread_create(&spsc_thread, spsc_stack, STACK_SIZE, spsc_producer,
+			INT_TO_POINTER(0), INT_TO_POINTER(MSGQ_LEN + 1), NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS);
+	zassert_equal(k_msgq_num_used_get(&spsc_msgq), MSGQ_LEN, NULL);
+
+	for (int i = 0; i < MSGQ_LEN + 1; i++) {
+		zassert_equal(k_msgq_get(&spsc_msgq, &rx[i], K_NO_WAIT), 0,
+			      NULL);
+		zassert_equal(rx[i], i, NULL);
+	}
+	k_thread_join(&spsc_thread, K_FOREVER);
+
+	zassert_equal(k_msgq_get(&spsc_msgq, &msg, TIMEOUT), -EAGAIN, NULL);
+}
+
+/**
+ * @brief Stream messages between two threads through an SPSC queue
+ *
+ * @ingroup kernel_message_queue_tests
+ *
+ * @see k_msgq_spsc_init()
+ */
+void test_msgq_spsc_stream(void)
+{
+	static uint32_t rx[SPSC_MSGS];
+
+	k_msgq_spsc_init(&spsc_msgq, spsc_buffer, MSG_SIZE, MSGQ_LEN);
+
+	k_thread_create(&spsc_thread, spsc_stack, STACK_SIZE, spsc_consumer,
+			rx, INT_TO_POINTER(SPSC_MSGS), NULL,
+			K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	spsc_producer(INT_TO_POINTER(MSG0), INT_TO_POINTER(SPSC_MSGS), NULL);
+	k_thread_join(&spsc_thread, K_FOREVER);
+
+	for (int i = 0; i < SPSC_MSGS; i++) {
+		zassert_equal(rx[i], MSG0 + i, NULL);
+	}
+	zassert_equal(k_msgq_num_used_get(&spsc_msgq), 0, NULL);
+}
+
+#ifdef CONFIG_POLL
+static void spsc_delayed_put(void *p1, void *p2, void *p3)
+{
+	uint32_t msg = MSG0;
+
+	k_msleep(TIMEOUT_MS);
+	zassert_equal(k_msgq_put(&spsc_msgq, &msg, K_NO_WAIT), 0, NULL);
+}
+#endif
+
+/**
+ * @brief Test k_poll() on an SPSC message queue
+ *
+ * @ingroup kernel_message_queue_tests
+ *
+ * @see k_msgq_spsc_init(), k_poll()
+ */
+void test_msgq_spsc_poll(void)
+{
+#ifdef CONFIG_POLL
+	struct k_poll_event event;
+	uint32_t rx;
+
+	k_msgq_spsc_init(&spsc_msgq, spsc_buffer, MSG_SIZE, MSGQ_LEN);
+	k_poll_event_init(&event, K_POLL_TYPE_MSGQ_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &spsc_msgq);
+
+	zassert_equal(k_poll(&event, 1, K_NO_WAIT), -EAGAIN, NULL);
+
+	k_thread_create(&spsc_thread, spsc_stack, STACK_SIZE, spsc_delayed_put,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	event.state = K_POLL_STATE_NOT_READY;
+	zassert_equal(k_poll(&event, 1, K_FOREVER), 0, NULL);
+	zassert_equal(event.state, K_POLL_STATE_MSGQ_DATA_AVAILABLE, NULL);
+	k_thread_join(&spsc_thread, K_FOREVER);
+
+	zassert_equal(k_msgq_get(&spsc_msgq, &rx, K_NO_WAIT), 0, NULL);
+	zassert_equal(rx, MSG0, NULL);
+#else
+	ztest_test_skip();
+#endif
+}
+
+#else
+
+void test_msgq_spsc(void)
+{
+	ztest_test_skip();
+}
+
+void test_msgq_spsc_pend(void)
+{
+	ztest_test_skip();
+}
+
+void test_msgq_spsc_stream(void)
+{
+	ztest_test_skip();
+}
+
+void test_msgq_spsc_poll(void)
+{
+	ztest_test_skip();
+}
+
+#endif /* CONFIG_MSGQ_SPSC */
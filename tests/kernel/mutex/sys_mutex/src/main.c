@@ -62,11 +62,16 @@ ZTEST_BMEM SYS_MUTEX_DEFINE(mutex_2);
 ZTEST_BMEM SYS_MUTEX_DEFINE(mutex_3);
 ZTEST_BMEM SYS_MUTEX_DEFINE(mutex_4);
 
-#ifdef CONFIG_USERSPACE
+#if defined(CONFIG_USERSPACE) && !defined(CONFIG_SYS_MUTEX_FAST)
 static SYS_MUTEX_DEFINE(no_access_mutex);
 #endif
 static ZTEST_BMEM SYS_MUTEX_DEFINE(not_my_mutex);
 static ZTEST_BMEM SYS_MUTEX_DEFINE(bad_count_mutex);
+#ifdef CONFIG_SYS_MUTEX_FAST
+static ZTEST_BMEM SYS_MUTEX_DEFINE(fast_mutex);
+static K_THREAD_STACK_DEFINE(fast_stack, STACKSIZE);
+static struct k_thread fast_thread;
+#endif
 extern void test_mutex_multithread_competition(void);
 
 /**
@@ -366,8 +371,10 @@ void test_supervisor_access(void)
 {
 	int rv;
 
-#ifdef CONFIG_USERSPACE
-	/* coverage for get_k_mutex checks */
+#if defined(CONFIG_USERSPACE) && !defined(CONFIG_SYS_MUTEX_FAST)
+	/* coverage for get_k_mutex checks, which fast mutexes skip when
+	 * there is no contention
+	 */
 	rv = sys_mutex_lock((struct sys_mutex *)NULL, K_NO_WAIT);
 	zassert_true(rv == -EINVAL, "accepted bad mutex pointer");
 	rv = sys_mutex_lock((struct sys_mutex *)k_current_get(), K_NO_WAIT);
@@ -386,7 +393,7 @@ void test_supervisor_access(void)
 
 void test_user_access(void)
 {
-#ifdef CONFIG_USERSPACE
+#if defined(CONFIG_USERSPACE) && !defined(CONFIG_SYS_MUTEX_FAST)
 	int rv;
 
 	rv = sys_mutex_lock(&no_access_mutex, K_NO_WAIT);
@@ -398,6 +405,53 @@ void test_user_access(void)
 #endif /* CONFIG_USERSPACE */
 }
 
+#ifdef CONFIG_SYS_MUTEX_FAST
+static void fast_contender(void *p1, void *p2, void *p3)
+{
+	zassert_equal(sys_mutex_lock(&fast_mutex, K_FOREVER), 0, NULL);
+	zassert_equal(sys_mutex_unlock(&fast_mutex), 0, NULL);
+}
+#endif
+
+/**
+ * @brief Test that only contended fast mutexes involve the kernel
+ *
+ * @see sys_mutex_lock(), sys_mutex_unlock()
+ */
+void test_mutex_fast(void)
+{
+#ifdef CONFIG_SYS_MUTEX_FAST
+	k_tid_t self = k_current_get();
+	int prio = k_thread_priority_get(self);
+
+	zassert_equal(sys_mutex_lock(&fast_mutex, K_NO_WAIT), 0, NULL);
+	zassert_equal_ptr(atomic_ptr_get(&fast_mutex.val), self,
+			  "uncontended mutex not in user memory");
+	zassert_equal(sys_mutex_lock(&fast_mutex, K_NO_WAIT), 0, NULL);
+	zassert_equal(sys_mutex_unlock(&fast_mutex), 0, NULL);
+	zassert_equal_ptr(atomic_ptr_get(&fast_mutex.val), self, NULL);
+	zassert_equal(sys_mutex_unlock(&fast_mutex), 0, NULL);
+	zassert_is_null(atomic_ptr_get(&fast_mutex.val), NULL);
+
+	/**TESTPOINT: a waiter moves the mutex to the kernel and is
+	 * handed ownership along with priority inheritance
+	 */
+	zassert_equal(sys_mutex_lock(&fast_mutex, K_NO_WAIT), 0, NULL);
+	k_thread_create(&fast_thread, fast_stack, STACKSIZE, fast_contender,
+			NULL, NULL, NULL, prio - 1, 0, K_NO_WAIT);
+	zassert_equal_ptr(atomic_ptr_get(&fast_mutex.val), (void *)1, NULL);
+	zassert_equal(k_thread_priority_get(self), prio - 1,
+		      "priority not inherited");
+
+	zassert_equal(sys_mutex_unlock(&fast_mutex), 0, NULL);
+	zassert_equal(k_thread_priority_get(self), prio, NULL);
+	k_thread_join(&fast_thread, K_FOREVER);
+	zassert_is_null(atomic_ptr_get(&fast_mutex.val), NULL);
+#else
+	ztest_test_skip();
+#endif
+}
+
 K_THREAD_DEFINE(THREAD_05, STACKSIZE, thread_05, NULL, NULL, NULL,
 		5, K_USER, 0);
 
@@ -440,7 +494,8 @@ void test_main(void)
 	ztest_test_suite(mutex_complex,
 			 ztest_user_unit_test(test_mutex),
 			 ztest_user_unit_test(test_user_access),
-			 ztest_unit_test(test_supervisor_access));
+			 ztest_unit_test(test_supervisor_access),
+			 ztest_unit_test(test_mutex_fast));
 
 	ztest_run_test_suite(mutex_complex);
 #else
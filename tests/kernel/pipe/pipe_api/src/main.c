@@ -48,6 +48,9 @@ extern void test_pipe_avail_w_lt_r(void);
 extern void test_pipe_avail_r_eq_w_full(void);
 extern void test_pipe_avail_r_eq_w_empty(void);
 extern void test_pipe_avail_no_buffer(void);
+extern void test_pipe_claim(void);
+extern void test_pipe_claim_reader_wait(void);
+extern void test_pipe_claim_writer_wait(void);
 
 /* k objects */
 extern struct k_pipe pipe, kpipe, khalfpipe, put_get_pipe;
@@ -114,6 +117,9 @@ void test_main(void)
 			 ztest_unit_test(test_pipe_avail_w_lt_r),
 			 ztest_unit_test(test_pipe_avail_r_eq_w_full),
 			 ztest_unit_test(test_pipe_avail_r_eq_w_empty),
-			 ztest_unit_test(test_pipe_avail_no_buffer));
+			 ztest_unit_test(test_pipe_avail_no_buffer),
+			 ztest_unit_test(test_pipe_claim),
+			 ztest_1cpu_unit_test(test_pipe_claim_reader_wait),
+			 ztest_1cpu_unit_test(test_pipe_claim_writer_wait));
 	ztest_run_test_suite(pipe_api);
 }
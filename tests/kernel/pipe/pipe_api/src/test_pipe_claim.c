@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Tests for the zero-copy pipe claim API
+ * @ingroup kernel_pipe_tests
+ * @{
+ */
+
+#include <ztest.h>
+
+#define CLAIM_PIPE_SIZE 16
+#define CLAIM_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+static unsigned char __aligned(4) claim_buf[CLAIM_PIPE_SIZE];
+static struct k_pipe claim_pipe;
+
+static K_THREAD_STACK_DEFINE(claim_stack, CLAIM_STACK_SIZE);
+static struct k_thread claim_thread;
+
+static unsigned char rx_data[CLAIM_PIPE_SIZE];
+static size_t rx_bytes;
+
+static void fill(uint8_t *dst, size_t size, uint8_t first)
+{
+	for (size_t i = 0; i < size; i++) {
+		dst[i] = first + i;
+	}
+}
+
+static void check(const uint8_t *src, size_t size, uint8_t first)
+{
+	for (size_t i = 0; i < size; i++) {
+		zassert_equal(src[i], (uint8_t)(first + i),
+			      "byte %u is %u", i, src[i]);
+	}
+}
+
+static void claim_put(size_t size, size_t expected, uint8_t first)
+{
+	uint8_t *data;
+
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &data, size), expected,
+		      NULL);
+	fill(data, expected, first);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, expected), 0, NULL);
+}
+
+static void reader_entry(void *p1, void *p2, void *p3)
+{
+	size_t bytes = POINTER_TO_INT(p1);
+
+	zassert_equal(k_pipe_get(&claim_pipe, rx_data, bytes, &rx_bytes,
+				 bytes, K_FOREVER), 0, NULL);
+}
+
+static void writer_entry(void *p1, void *p2, void *p3)
+{
+	uint8_t tx_data[CLAIM_PIPE_SIZE / 2];
+	size_t written;
+
+	fill(tx_data, sizeof(tx_data), POINTER_TO_INT(p1));
+	zassert_equal(k_pipe_put(&claim_pipe, tx_data, sizeof(tx_data),
+				 &written, sizeof(tx_data), K_FOREVER), 0, NULL);
+	zassert_equal(written, sizeof(tx_data), NULL);
+}
+
+/**
+ * @brief Test claiming space and data directly in the pipe's buffer
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_finish(),
+ *	k_pipe_get_claim(), k_pipe_get_finish()
+ */
+void test_pipe_claim(void)
+{
+	uint8_t *data, *other;
+	size_t bytes;
+
+	k_pipe_init(&claim_pipe, claim_buf, sizeof(claim_buf));
+
+	zassert_equal(k_pipe_put_finish(&claim_pipe, 0), -EINVAL, NULL);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 0), -EINVAL, NULL);
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, 1), 0, NULL);
+
+	/**TESTPOINT: only one put claim at a time, and no k_pipe_put() */
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &data, 10), 10, NULL);
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &other, 1), 0, NULL);
+	zassert_equal(k_pipe_put(&claim_pipe, rx_data, 1, &bytes, 0,
+				 K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0, NULL);
+	fill(data, 10, 0);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, 10), 0, NULL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 10, NULL);
+
+	/**TESTPOINT: only one get claim at a time, and no k_pipe_get() */
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, 4), 4, NULL);
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &other, 1), 0, NULL);
+	zassert_equal(k_pipe_get(&claim_pipe, rx_data, 1, &bytes, 0,
+				 K_NO_WAIT), -EBUSY, NULL);
+	check(data, 4, 0);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 11), -EINVAL, NULL);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 4), 0, NULL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 6, NULL);
+
+	/**TESTPOINT: claims stop at the end of the buffer */
+	claim_put(CLAIM_PIPE_SIZE, CLAIM_PIPE_SIZE - 10, 10);
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &data, CLAIM_PIPE_SIZE),
+		      4, NULL);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, 5), -EINVAL, NULL);
+	fill(data, 2, CLAIM_PIPE_SIZE);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, 2), 0, NULL);
+
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, CLAIM_PIPE_SIZE),
+		      CLAIM_PIPE_SIZE - 4, NULL);
+	check(data, CLAIM_PIPE_SIZE - 4, 4);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, CLAIM_PIPE_SIZE - 4), 0,
+		      NULL);
+
+	/**TESTPOINT: claims and copies interoperate */
+	zassert_equal(k_pipe_get(&claim_pipe, rx_data, sizeof(rx_data),
+				 &bytes, 0, K_NO_WAIT), 0, NULL);
+	zassert_equal(bytes, 2, NULL);
+	check(rx_data, 2, CLAIM_PIPE_SIZE);
+}
+
+/**
+ * @brief Test that committing a put claim serves a waiting reader
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_finish()
+ */
+void test_pipe_claim_reader_wait(void)
+{
+	k_pipe_init(&claim_pipe, claim_buf, sizeof(claim_buf));
+
+	k_thread_create(&claim_thread, claim_stack, CLAIM_STACK_SIZE,
+			reader_entry, INT_TO_POINTER(6), NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(10);
+
+	/* The data is handed over in two parts */
+	claim_put(4, 4, 0);
+	k_msleep(10);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0, NULL);
+	claim_put(4, 4, 4);
+
+	k_thread_join(&claim_thread, K_FOREVER);
+	zassert_equal(rx_bytes, 6, NULL);
+	check(rx_data, 6, 0);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 2, NULL);
+}
+
+/**
+ * @brief Test that releasing a get claim refills from a waiting writer
+ *
+ * @see k_pipe_get_claim(), k_pipe_get_finish()
+ */
+void test_pipe_claim_writer_wait(void)
+{
+	uint8_t *data;
+
+	k_pipe_init(&claim_pipe, claim_buf, sizeof(claim_buf));
+	claim_put(CLAIM_PIPE_SIZE, CLAIM_PIPE_SIZE, 0);
+
+	k_thread_create(&claim_thread, claim_stack, CLAIM_STACK_SIZE,
+			writer_entry, INT_TO_POINTER(CLAIM_PIPE_SIZE), NULL,
+			NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(10);
+
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, CLAIM_PIPE_SIZE),
+		      CLAIM_PIPE_SIZE, NULL);
+	check(data, CLAIM_PIPE_SIZE, 0);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, CLAIM_PIPE_SIZE), 0,
+		      NULL);
+
+	k_thread_join(&claim_thread, K_FOREVER);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), CLAIM_PIPE_SIZE / 2,
+		      NULL);
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, CLAIM_PIPE_SIZE),
+		      CLAIM_PIPE_SIZE / 2, NULL);
+	check(data, CLAIM_PIPE_SIZE / 2, CLAIM_PIPE_SIZE);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, CLAIM_PIPE_SIZE / 2), 0,
+		      NULL);
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+
+#define SET_SEMS 4
+#define SET_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+static struct k_poll_set set;
+static struct k_sem set_sems[SET_SEMS];
+static struct k_poll_signal set_signal;
+static struct k_poll_event set_events[SET_SEMS + 1];
+
+static K_THREAD_STACK_DEFINE(set_stack, SET_STACK_SIZE);
+static struct k_thread set_thread;
+
+static void set_setup(void)
+{
+	k_poll_set_init(&set);
+	k_poll_signal_init(&set_signal);
+
+	for (int i = 0; i < SET_SEMS; i++) {
+		k_sem_init(&set_sems[i], 0, 1);
+		k_poll_event_init(&set_events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &set_sems[i]);
+		zassert_equal(k_poll_set_add(&set, &set_events[i]), 0, NULL);
+	}
+
+	k_poll_event_init(&set_events[SET_SEMS], K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_signal);
+	zassert_equal(k_poll_set_add(&set, &set_events[SET_SEMS]), 0, NULL);
+}
+
+static void set_teardown(void)
+{
+	for (int i = 0; i <= SET_SEMS; i++) {
+		zassert_equal(k_poll_set_remove(&set, &set_events[i]), 0, NULL);
+	}
+}
+
+/**
+ * @brief Test readiness reporting of a poll set
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_add(), k_poll_set_wait(), k_poll_set_remove()
+ */
+void test_poll_set(void)
+{
+	struct k_poll_event *ready[SET_SEMS + 1];
+	struct k_poll_event other;
+
+	set_setup();
+
+	/**TESTPOINT: events belong to one set at a time */
+	zassert_equal(k_poll_set_add(&set, &set_events[0]), -EBUSY, NULL);
+	k_poll_event_init(&other, K_POLL_TYPE_SEM_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_sems[0]);
+	zassert_equal(k_poll_set_remove(&set, &other), -EINVAL, NULL);
+	other.type = K_POLL_TYPE_IGNORE;
+	zassert_equal(k_poll_set_add(&set, &other), -EINVAL, NULL);
+
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, NULL);
+
+	/**TESTPOINT: only the ready events are returned, in order */
+	k_sem_give(&set_sems[2]);
+	k_sem_give(&set_sems[0]);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 2, NULL);
+	zassert_equal_ptr(ready[0], &set_events[2], NULL);
+	zassert_equal_ptr(ready[1], &set_events[0], NULL);
+	zassert_equal(ready[0]->state, K_POLL_STATE_SEM_AVAILABLE, NULL);
+
+	/**TESTPOINT: events stay ready until their condition is gone */
+	zassert_equal(k_sem_take(&set_sems[2], K_NO_WAIT), 0, NULL);
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), 1, NULL);
+	zassert_equal_ptr(ready[0], &set_events[0], NULL);
+	zassert_equal(k_sem_take(&set_sems[0], K_NO_WAIT), 0, NULL);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, NULL);
+
+	/**TESTPOINT: events are re-armed after being handed out */
+	k_sem_give(&set_sems[2]);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 1, NULL);
+	zassert_equal_ptr(ready[0], &set_events[2], NULL);
+	zassert_equal(k_sem_take(&set_sems[2], K_NO_WAIT), 0, NULL);
+
+	k_poll_signal_raise(&set_signal, 0x1337);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 1, NULL);
+	zassert_equal_ptr(ready[0], &set_events[SET_SEMS], NULL);
+	zassert_equal(ready[0]->state, K_POLL_STATE_SIGNALED, NULL);
+	k_poll_signal_reset(&set_signal);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, NULL);
+
+	/**TESTPOINT: removed events are not reported any more */
+	k_sem_give(&set_sems[1]);
+	zassert_equal(k_poll_set_remove(&set, &set_events[1]), 0, NULL);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, NULL);
+	zassert_equal(k_poll_set_add(&set, &set_events[1]), 0, NULL);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 1, NULL);
+	zassert_equal(k_sem_take(&set_sems[1], K_NO_WAIT), 0, NULL);
+
+	set_teardown();
+}
+
+static void set_give(void *p1, void *p2, void *p3)
+{
+	k_msleep(50);
+	k_sem_give(&set_sems[3]);
+}
+
+/**
+ * @brief Test waiting on a poll set
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_wait()
+ */
+void test_poll_set_wait(void)
+{
+	struct k_poll_event *ready[SET_SEMS + 1];
+
+	set_setup();
+
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_MSEC(50)), -EAGAIN, NULL);
+
+	k_thread_create(&set_thread, set_stack, SET_STACK_SIZE, set_give,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_FOREVER), 1, NULL);
+	zassert_equal_ptr(ready[0], &set_events[3], NULL);
+	zassert_equal(k_sem_take(&set_sems[3], K_NO_WAIT), 0, NULL);
+	k_thread_join(&set_thread, K_FOREVER);
+
+	/**TESTPOINT: a k_poll() on the same object takes precedence */
+	struct k_poll_event event = K_POLL_EVENT_INITIALIZER(
+		K_POLL_TYPE_SEM_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY,
+		&set_sems[3]);
+
+	k_thread_create(&set_thread, set_stack, SET_STACK_SIZE, set_give,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	zassert_equal(k_poll(&event, 1, K_FOREVER), 0, NULL);
+	zassert_equal(event.state, K_POLL_STATE_SEM_AVAILABLE, NULL);
+	k_thread_join(&set_thread, K_FOREVER);
+
+	/* The set's event was not signaled, but is still registered */
+	zassert_equal(k_sem_take(&set_sems[3], K_NO_WAIT), 0, NULL);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, NULL);
+	k_sem_give(&set_sems[3]);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 1, NULL);
+	zassert_equal(k_sem_take(&set_sems[3], K_NO_WAIT), 0, NULL);
+
+	set_teardown();
+}
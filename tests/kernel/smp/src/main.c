@@ -554,9 +554,13 @@ void test_get_cpu(void)
 /* global variable for testing send IPI */
 static volatile int sched_ipi_has_called;
 
+/* IPIs received by each CPU, for testing directed IPIs */
+static atomic_t sched_ipi_cpu_called[CONFIG_MP_NUM_CPUS];
+
 void z_trace_sched_ipi(void)
 {
 	sched_ipi_has_called++;
+	atomic_inc(&sched_ipi_cpu_called[arch_curr_cpu()->id]);
 }
 #endif
 
@@ -630,6 +634,47 @@ void test_smp_ipi(void)
 	}
 }
 
+/**
+ * @brief Test interprocessor interrupt to given CPUs
+ *
+ * @ingroup kernel_smp_integration_tests
+ *
+ * @details Send a scheduler IPI to each other CPU in turn and check
+ * that it is received there.
+ *
+ * @see arch_sched_directed_ipi()
+ */
+void test_smp_directed_ipi(void)
+{
+#if defined(CONFIG_TRACE_SCHED_IPI) && defined(CONFIG_ARCH_HAS_DIRECTED_IPIS)
+	unsigned int key;
+	int self;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		/* Stay on one CPU while deciding where to send it */
+		key = arch_irq_lock();
+		self = arch_curr_cpu()->id;
+		if (i != self) {
+			atomic_clear(&sched_ipi_cpu_called[i]);
+			arch_sched_directed_ipi(BIT(i));
+		}
+		arch_irq_unlock(key);
+
+		if (i == self) {
+			continue;
+		}
+
+		k_msleep(100);
+
+		/**TESTPOINT: the target CPU entered our IPI handler */
+		zassert_true(atomic_get(&sched_ipi_cpu_called[i]) != 0,
+			     "CPU %d did not receive IPI", i);
+	}
+#else
+	ztest_test_skip();
+#endif
+}
+
 void k_sys_fatal_error_handler(unsigned int reason, const z_arch_esf_t *pEsf)
 {
 	static int trigger;
@@ -965,6 +1010,7 @@ void test_main(void)
 			 ztest_unit_test(test_sleep_threads),
 			 ztest_unit_test(test_wakeup_threads),
 			 ztest_unit_test(test_smp_ipi),
+			 ztest_unit_test(test_smp_directed_ipi),
 			 ztest_unit_test(test_get_cpu),
 			 ztest_unit_test(test_fatal_on_smp),
 			 ztest_unit_test(test_workq_on_smp),
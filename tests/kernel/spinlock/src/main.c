@@ -20,6 +20,12 @@ static struct k_spinlock bounce_lock;
 
 volatile int bounce_owner, bounce_done;
 
+#ifdef CONFIG_SPIN_LOCK_TICKET
+#define IS_LOCKED(l) ((l)->next != (l)->owner)
+#else
+#define IS_LOCKED(l) ((l)->locked)
+#endif
+
 /**
  * @brief Tests for spinlock
  *
@@ -43,15 +49,15 @@ void test_spinlock_basic(void)
 	k_spinlock_key_t key;
 	static struct k_spinlock l;
 
-	zassert_true(!l.locked, "Spinlock initialized to locked");
+	zassert_true(!IS_LOCKED(&l), "Spinlock initialized to locked");
 
 	key = k_spin_lock(&l);
 
-	zassert_true(l.locked, "Spinlock failed to lock");
+	zassert_true(IS_LOCKED(&l), "Spinlock failed to lock");
 
 	k_spin_unlock(&l, key);
 
-	zassert_true(!l.locked, "Spinlock failed to unlock");
+	zassert_true(!IS_LOCKED(&l), "Spinlock failed to unlock");
 }
 
 void bounce_once(int id)
@@ -151,7 +157,7 @@ void test_spinlock_mutual_exclusion(void)
 
 	key = k_spin_lock(&lock_runtime);
 
-	zassert_true(lock_runtime.locked, "Spinlock failed to lock");
+	zassert_true(IS_LOCKED(&lock_runtime), "Spinlock failed to lock");
 
 	/* check irq has not locked */
 	zassert_true(arch_irq_unlocked(key.key),
@@ -171,9 +177,39 @@ void test_spinlock_mutual_exclusion(void)
 
 	k_spin_unlock(&lock_runtime, key);
 
-	zassert_true(!lock_runtime.locked, "Spinlock failed to unlock");
+	zassert_true(!IS_LOCKED(&lock_runtime), "Spinlock failed to unlock");
+}
+
+#ifdef CONFIG_SPIN_LOCK_STATS
+static void find_lock_cb(struct k_spinlock *l, void *user_data)
+{
+	if (l == &bounce_lock) {
+		*(bool *)user_data = true;
+	}
 }
+#endif
 
+/**
+ * @brief Test contention statistics of the lock bounced between CPUs
+ *
+ * @ingroup kernel_spinlock_tests
+ *
+ * @see k_spin_lock()
+ */
+void test_spinlock_stats(void)
+{
+#ifdef CONFIG_SPIN_LOCK_STATS
+	bool found = false;
+
+	z_spin_stats_foreach(find_lock_cb, &found);
+	zassert_true(found, "Contended lock not listed");
+	zassert_true(bounce_lock.contended > 0, NULL);
+	zassert_true(bounce_lock.spins >= bounce_lock.contended, NULL);
+	zassert_true(bounce_lock.max_spins > 0, NULL);
+#else
+	ztest_test_skip();
+#endif
+}
 
 extern void test_spinlock_no_recursive(void);
 extern void test_spinlock_unlock_error(void);
@@ -185,6 +221,7 @@ void test_main(void)
 	ztest_test_suite(spinlock,
 			 ztest_unit_test(test_spinlock_basic),
 			 ztest_unit_test(test_spinlock_bounce),
+			 ztest_unit_test(test_spinlock_stats),
 			 ztest_unit_test(test_spinlock_mutual_exclusion),
 			 ztest_unit_test(test_spinlock_no_recursive),
 			 ztest_unit_test(test_spinlock_unlock_error),
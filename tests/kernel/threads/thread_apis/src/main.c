@@ -45,6 +45,7 @@ extern void test_threads_suspend(void);
 extern void test_abort_from_isr(void);
 extern void test_abort_from_isr_not_self(void);
 extern void test_essential_thread_abort(void);
+extern void test_threads_sched_latency(void);
 
 struct k_thread tdata;
 #define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
@@ -696,7 +697,8 @@ void test_main(void)
 			 ztest_unit_test(test_abort_from_isr_not_self),
 			 ztest_user_unit_test(test_thread_timeout_remaining_expires),
 			 ztest_unit_test(test_k_busy_wait),
-			 ztest_1cpu_user_unit_test(test_k_busy_wait_user)
+			 ztest_1cpu_user_unit_test(test_k_busy_wait_user),
+			 ztest_1cpu_unit_test(test_threads_sched_latency)
 			 );
 
 	ztest_run_test_suite(threads_lifecycle);
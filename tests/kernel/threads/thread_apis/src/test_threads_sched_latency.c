@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+
+#include "tests_thread_apis.h"
+
+#define WAKEUPS 8
+
+K_SEM_DEFINE(sem_latency, 0, 1);
+
+#ifdef CONFIG_SCHED_LATENCY_STATS
+static uint32_t latency_count(const struct k_sched_latency_stats *stats)
+{
+	uint32_t count = 0;
+
+	for (int i = 0; i < CONFIG_SCHED_LATENCY_STATS_NUM_BINS; i++) {
+		count += stats->counts[i];
+	}
+
+	return count;
+}
+
+static void latency_entry(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < WAKEUPS; i++) {
+		k_sem_take(&sem_latency, K_FOREVER);
+	}
+}
+#endif
+
+/**
+ * @brief Test the scheduling latency statistics
+ *
+ * @details A higher priority thread is woken up repeatedly, each
+ * wakeup must be accounted for in its own histogram and in that of
+ * its priority, and the thread waking it up must be seen preempted.
+ *
+ * @ingroup kernel_thread_tests
+ *
+ * @see k_thread_runtime_stats_get(), k_sched_latency_stats_get()
+ */
+void test_threads_sched_latency(void)
+{
+#ifdef CONFIG_SCHED_LATENCY_STATS
+	int prio = k_thread_priority_get(k_current_get()) - 1;
+	struct k_sched_latency_stats prio_before, prio_after;
+	k_thread_runtime_stats_t self_before, self_after, stats;
+	k_tid_t tid;
+
+	zassert_equal(k_sched_latency_stats_get(K_HIGHEST_THREAD_PRIO - 1,
+						&prio_before), -EINVAL, NULL);
+	zassert_equal(k_sched_latency_stats_get(K_LOWEST_THREAD_PRIO + 1,
+						&prio_before), -EINVAL, NULL);
+	zassert_equal(k_sched_latency_stats_get(prio, NULL), -EINVAL, NULL);
+
+	zassert_equal(k_sched_latency_stats_get(prio, &prio_before), 0, NULL);
+	k_thread_runtime_stats_get(k_current_get(), &self_before);
+
+	tid = k_thread_create(&tdata, tstack, STACK_SIZE, latency_entry,
+			      NULL, NULL, NULL, prio, 0, K_NO_WAIT);
+
+	/* Yields are for the benefit of a cooperative test thread, the
+	 * new thread must be blocked on the semaphore for each give
+	 */
+	k_yield();
+	for (int i = 0; i < WAKEUPS; i++) {
+		k_sem_give(&sem_latency);
+		k_yield();
+	}
+
+	k_thread_runtime_stats_get(tid, &stats);
+	k_thread_join(tid, K_FOREVER);
+
+	/**TESTPOINT: the start and each wakeup are one switch each */
+	zassert_true(stats.switches >= WAKEUPS + 1, "%u switches",
+		     stats.switches);
+	zassert_true(latency_count(&stats.latency) >= WAKEUPS + 1, NULL);
+
+	/**TESTPOINT: the waker was switched out while runnable */
+	k_thread_runtime_stats_get(k_current_get(), &self_after);
+	zassert_true(self_after.preemptions - self_before.preemptions >=
+		     WAKEUPS, NULL);
+
+	/**TESTPOINT: the priority level accounts for the same wakeups */
+	zassert_equal(k_sched_latency_stats_get(prio, &prio_after), 0, NULL);
+	zassert_true(latency_count(&prio_after) - latency_count(&prio_before)
+		     >= WAKEUPS + 1, NULL);
+	zassert_true(prio_after.max >= stats.latency.max, NULL);
+#else
+	ztest_test_skip();
+#endif
+}
@@ -5,6 +5,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include <ztest.h>
 #include <zephyr/types.h>
 
@@ -811,6 +812,70 @@ void test_sleep_abs(void)
 		     start + sleep_ticks, end, late);
 }
 
+/**
+ * @brief Test that timeouts within the slack of a timer share its expiry
+ *
+ * @details A timer with a slack is due before a timer without. The first
+ * one is deferred to the expiry of the second: both expire with a single
+ * timer interrupt, seen by a thread waiting on the first.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_slack_set()
+ */
+void test_timer_slack(void)
+{
+#ifdef CONFIG_TIMEOUT_SLACK
+	static struct k_timer loose_timer, strict_timer;
+
+	if (!IS_ENABLED(CONFIG_TICKLESS_KERNEL)) {
+		/* Every tick is announced, nothing is deferred */
+		ztest_test_skip();
+		return;
+	}
+
+	k_timer_init(&loose_timer, NULL, NULL);
+	k_timer_init(&strict_timer, NULL, NULL);
+	k_timer_slack_set(&loose_timer, K_MSEC(DURATION));
+
+	k_usleep(1); /* tick align */
+
+	k_timer_start(&loose_timer, K_MSEC(PERIOD), K_NO_WAIT);
+	k_timer_start(&strict_timer, K_MSEC(DURATION), K_NO_WAIT);
+
+	zassert_equal(k_timer_status_sync(&loose_timer), 1U, NULL);
+	zassert_equal(k_timer_status_get(&strict_timer), 1U,
+		      "the timers expired separately");
+
+	k_timer_slack_set(&loose_timer, K_NO_WAIT);
+#else
+	ztest_test_skip();
+#endif
+}
+
+/**
+ * @brief Test stopping and querying a timer that was never started
+ *
+ * @details The timer is on the stack, over memory filled with garbage, as
+ * left by a previous use of the stack.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_init(), k_timer_stop(), k_timer_remaining_get()
+ */
+void test_timer_unstarted(void)
+{
+	struct k_timer timer;
+
+	memset(&timer, 0xa5, sizeof(timer));
+	k_timer_init(&timer, NULL, NULL);
+
+	k_timer_stop(&timer);
+	zassert_equal(k_timer_remaining_get(&timer), 0, NULL);
+	zassert_equal(k_timer_remaining_ticks(&timer), 0, NULL);
+	zassert_equal(k_timer_status_get(&timer), 0, NULL);
+}
+
 static void timer_init(struct k_timer *timer, k_timer_expiry_t expiry_fn,
 		       k_timer_stop_t stop_fn)
 {
@@ -853,6 +918,8 @@ void test_main(void)
 			 ztest_user_unit_test(test_timer_user_data),
 			 ztest_user_unit_test(test_timer_remaining),
 			 ztest_user_unit_test(test_timeout_abs),
-			 ztest_user_unit_test(test_sleep_abs));
+			 ztest_user_unit_test(test_sleep_abs),
+			 ztest_unit_test(test_timer_slack),
+			 ztest_unit_test(test_timer_unstarted));
 	ztest_run_test_suite(timer_api);
 }
@@ -1511,6 +1511,239 @@ static void test_1cpu_legacy_delayed_cancel(void)
 	zassert_false(k_delayed_work_pending(&lwork), NULL);
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+#define POOL_THREADS 3
+
+/* A cooperative work queue served by POOL_THREADS threads. */
+static K_THREAD_STACK_DEFINE(pool_stack, STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(pool_stacks, POOL_THREADS - 1, STACK_SIZE);
+static struct k_thread pool_threads[POOL_THREADS - 1];
+static struct k_work_q pool_queue;
+static struct k_work_q unstarted_queue;
+static struct k_work pool_work[POOL_THREADS];
+
+static K_SEM_DEFINE(pool_rel_sem, 0, POOL_THREADS);
+static K_SEM_DEFINE(pool_done_sem, 0, POOL_THREADS);
+static atomic_t pool_running;
+static atomic_t pool_max_running;
+
+static void pool_enter(void)
+{
+	atomic_val_t n = atomic_inc(&pool_running) + 1;
+
+	if (n > atomic_get(&pool_max_running)) {
+		atomic_set(&pool_max_running, n);
+	}
+}
+
+static void pool_leave(void)
+{
+	atomic_dec(&pool_running);
+	k_sem_give(&pool_done_sem);
+}
+
+/* Blocks until released through pool_rel_sem. */
+static void pool_rel_handler(struct k_work *work)
+{
+	pool_enter();
+	k_sem_take(&pool_rel_sem, K_FOREVER);
+	pool_leave();
+}
+
+/* Takes DELAY_MS to complete. */
+static void pool_delay_handler(struct k_work *work)
+{
+	pool_enter();
+	k_sleep(DELAY_TIMEOUT);
+	pool_leave();
+}
+
+static void reset_pool(void)
+{
+	zassert_equal(atomic_get(&pool_running), 0, NULL);
+	zassert_equal(k_sem_take(&pool_done_sem, K_NO_WAIT), -EBUSY, NULL);
+	atomic_set(&pool_max_running, 0);
+}
+
+static void test_pool_start(void)
+{
+	struct k_work_queue_config cfg = {
+		.name = "wq.pool",
+	};
+	int rc;
+
+	k_work_queue_start(&pool_queue, pool_stack, STACK_SIZE,
+			   COOPHI_PRIORITY, &cfg);
+
+	for (int i = 0; i < POOL_THREADS - 1; i++) {
+		rc = k_work_queue_thread_add(&pool_queue, &pool_threads[i],
+					     pool_stacks[i], STACK_SIZE,
+					     COOPHI_PRIORITY, -1);
+		zassert_equal(rc, 0, NULL);
+	}
+	zassert_equal(pool_queue.pool_size, POOL_THREADS - 1, NULL);
+
+	/* Only started queues can take threads */
+	rc = k_work_queue_thread_add(&unstarted_queue, &pool_threads[0],
+				     pool_stacks[0], STACK_SIZE,
+				     COOPHI_PRIORITY, -1);
+	zassert_equal(rc, -ENODEV, NULL);
+}
+
+/* Blocked items on a pool queue don't hold up the others. */
+static void test_pool_parallel(void)
+{
+	int rc;
+
+	reset_pool();
+
+	for (int i = 0; i < POOL_THREADS; i++) {
+		k_work_init(&pool_work[i], pool_rel_handler);
+		rc = k_work_submit_to_queue(&pool_queue, &pool_work[i]);
+		zassert_equal(rc, 1, NULL);
+	}
+
+	/* All of them should get going */
+	k_sleep(K_TICKS(1));
+	zassert_equal(atomic_get(&pool_running), POOL_THREADS, NULL);
+
+	for (int i = 0; i < POOL_THREADS; i++) {
+		k_sem_give(&pool_rel_sem);
+	}
+	for (int i = 0; i < POOL_THREADS; i++) {
+		zassert_equal(k_sem_take(&pool_done_sem, K_FOREVER), 0, NULL);
+	}
+	zassert_equal(atomic_get(&pool_max_running), POOL_THREADS, NULL);
+}
+
+/* An item resubmitted while running is not picked up by another
+ * thread of the pool until the running invocation completes.
+ */
+static void test_pool_reentrant(void)
+{
+	int rc;
+
+	reset_pool();
+	k_work_init(&work, pool_rel_handler);
+
+	rc = k_work_submit_to_queue(&pool_queue, &work);
+	zassert_equal(rc, 1, NULL);
+	k_sleep(K_TICKS(1));
+	zassert_equal(k_work_busy_get(&work), K_WORK_RUNNING, NULL);
+
+	rc = k_work_submit_to_queue(&pool_queue, &work);
+	zassert_equal(rc, 2, NULL);
+	k_sleep(K_TICKS(1));
+	zassert_equal(k_work_busy_get(&work), K_WORK_RUNNING | K_WORK_QUEUED,
+		      NULL);
+	zassert_equal(atomic_get(&pool_running), 1, NULL);
+
+	/* Release the first invocation, the second one starts */
+	k_sem_give(&pool_rel_sem);
+	zassert_equal(k_sem_take(&pool_done_sem, K_FOREVER), 0, NULL);
+	k_sleep(K_TICKS(1));
+	zassert_equal(k_work_busy_get(&work), K_WORK_RUNNING, NULL);
+
+	k_sem_give(&pool_rel_sem);
+	zassert_equal(k_sem_take(&pool_done_sem, K_FOREVER), 0, NULL);
+	zassert_equal(atomic_get(&pool_max_running), 1, NULL);
+}
+
+/* Flushing a running item waits for it even though other threads of
+ * the pool are idle.
+ */
+static void test_pool_running_flush(void)
+{
+	int rc;
+
+	reset_pool();
+	k_work_init(&work, pool_delay_handler);
+
+	rc = k_work_submit_to_queue(&pool_queue, &work);
+	zassert_equal(rc, 1, NULL);
+	k_sleep(K_TICKS(1));
+	zassert_equal(k_work_busy_get(&work), K_WORK_RUNNING, NULL);
+
+	zassert_true(k_work_flush(&work, &work_sync), NULL);
+	zassert_equal(k_work_busy_get(&work), 0, NULL);
+	zassert_equal(k_sem_take(&pool_done_sem, K_NO_WAIT), 0, NULL);
+}
+
+/* Cancelling a running item waits for it. */
+static void test_pool_running_cancel_sync(void)
+{
+	int rc;
+
+	reset_pool();
+	k_work_init(&work, pool_delay_handler);
+
+	rc = k_work_submit_to_queue(&pool_queue, &work);
+	zassert_equal(rc, 1, NULL);
+	k_sleep(K_TICKS(1));
+
+	/* Resubmission is dropped by the cancel */
+	rc = k_work_submit_to_queue(&pool_queue, &work);
+	zassert_equal(rc, 2, NULL);
+
+	zassert_true(k_work_cancel_sync(&work, &work_sync), NULL);
+	zassert_equal(k_work_busy_get(&work), 0, NULL);
+	zassert_equal(k_sem_take(&pool_done_sem, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_sem_take(&pool_done_sem, K_MSEC(2 * DELAY_MS)),
+		      -EAGAIN, NULL);
+}
+
+/* Draining waits for all threads of the pool to finish. */
+static void test_pool_drain(void)
+{
+	int rc;
+
+	reset_pool();
+
+	for (int i = 0; i < POOL_THREADS; i++) {
+		k_work_init(&pool_work[i], pool_delay_handler);
+		rc = k_work_submit_to_queue(&pool_queue, &pool_work[i]);
+		zassert_equal(rc, 1, NULL);
+	}
+
+	rc = k_work_queue_drain(&pool_queue, false);
+	zassert_equal(rc, 1, NULL);
+	zassert_equal(atomic_get(&pool_running), 0, NULL);
+
+	for (int i = 0; i < POOL_THREADS; i++) {
+		zassert_equal(k_sem_take(&pool_done_sem, K_NO_WAIT), 0, NULL);
+	}
+}
+#else
+static void test_pool_start(void)
+{
+	ztest_test_skip();
+}
+
+static void test_pool_parallel(void)
+{
+	ztest_test_skip();
+}
+
+static void test_pool_reentrant(void)
+{
+	ztest_test_skip();
+}
+
+static void test_pool_running_flush(void)
+{
+	ztest_test_skip();
+}
+
+static void test_pool_running_cancel_sync(void)
+{
+	ztest_test_skip();
+}
+
+static void test_pool_drain(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
 
 static void test_nop(void)
 {
@@ -1561,6 +1794,12 @@ void test_main(void)
 			 ztest_1cpu_unit_test(
 				 test_1cpu_legacy_delayed_resubmit),
 			 ztest_1cpu_unit_test(test_1cpu_legacy_delayed_cancel),
+			 ztest_unit_test(test_pool_start),
+			 ztest_unit_test(test_pool_parallel),
+			 ztest_unit_test(test_pool_reentrant),
+			 ztest_unit_test(test_pool_running_flush),
+			 ztest_unit_test(test_pool_running_cancel_sync),
+			 ztest_unit_test(test_pool_drain),
 			 ztest_unit_test(test_nop));
 	ztest_run_test_suite(work);
 }
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <cache.h>
+#include <net/buf.h>
+#include <sys/dma_mem.h>
+
+#define BLOCK_SIZE 50
+#define BLOCKS 4
+
+DMA_MEM_SLAB_DEFINE(slab, BLOCK_SIZE, BLOCKS);
+NET_BUF_POOL_DMA_DEFINE(pool, BLOCKS, BLOCK_SIZE, NULL);
+static DMA_MEM_BUF_DEFINE(buf, 4 * DMA_MEM_ALIGN);
+
+static bool is_aligned(const void *ptr)
+{
+	return POINTER_TO_UINT(ptr) % DMA_MEM_ALIGN == 0U;
+}
+
+static void test_slab(void)
+{
+	void *blocks[BLOCKS];
+
+	zassert_equal(slab.block_size, DMA_MEM_ROUND_UP(BLOCK_SIZE), NULL);
+
+	for (int i = 0; i < BLOCKS; i++) {
+		zassert_equal(k_mem_slab_alloc(&slab, &blocks[i], K_NO_WAIT),
+			      0, "Block %d not allocated", i);
+		zassert_true(is_aligned(blocks[i]), "Block %p misaligned",
+			     blocks[i]);
+	}
+
+	for (int i = 0; i < BLOCKS; i++) {
+		k_mem_slab_free(&slab, &blocks[i]);
+	}
+}
+
+static void test_net_buf_pool(void)
+{
+	struct net_buf *bufs[BLOCKS];
+
+	for (int i = 0; i < BLOCKS; i++) {
+		bufs[i] = net_buf_alloc(&pool, K_NO_WAIT);
+		zassert_not_null(bufs[i], "Buffer %d not allocated", i);
+		zassert_true(is_aligned(bufs[i]->data), "Data %p misaligned",
+			     bufs[i]->data);
+		zassert_equal(bufs[i]->size, DMA_MEM_ROUND_UP(BLOCK_SIZE),
+			      NULL);
+	}
+
+	for (int i = 0; i < BLOCKS; i++) {
+		net_buf_unref(bufs[i]);
+	}
+}
+
+static void test_buf(void)
+{
+	zassert_true(is_aligned(buf), NULL);
+	zassert_equal(sizeof(buf) % DMA_MEM_ALIGN, 0, NULL);
+}
+
+static void test_sync(void)
+{
+	/* Adjacent, overlapping and disjoint ranges, and an empty one */
+	const struct dma_mem_range ranges[] = {
+		{ &buf[0], DMA_MEM_ALIGN },
+		{ &buf[DMA_MEM_ALIGN], DMA_MEM_ALIGN },
+		{ &buf[DMA_MEM_ALIGN], 2 * DMA_MEM_ALIGN },
+		{ &buf[0], 0 },
+		{ &buf[3 * DMA_MEM_ALIGN], DMA_MEM_ALIGN },
+	};
+
+	zassert_equal(dma_mem_sync(ranges, ARRAY_SIZE(ranges), K_CACHE_WB),
+		      0, NULL);
+	zassert_equal(dma_mem_sync(ranges, ARRAY_SIZE(ranges), K_CACHE_INVD),
+		      0, NULL);
+	zassert_equal(dma_mem_sync(ranges, 0, K_CACHE_WB_INVD), 0, NULL);
+
+	/* Partial lines may be written back */
+	zassert_equal(dma_mem_sync_buf(&buf[1], 3, K_CACHE_WB), 0, NULL);
+}
+
+static void test_coherent(void)
+{
+	zassert_equal(dma_mem_is_coherent(buf, sizeof(buf)),
+		      !IS_ENABLED(CONFIG_CACHE_MANAGEMENT) ||
+		      IS_ENABLED(CONFIG_DMA_MEM_NOCACHE), NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(dma_mem,
+			 ztest_unit_test(test_slab),
+			 ztest_unit_test(test_net_buf_pool),
+			 ztest_unit_test(test_buf),
+			 ztest_unit_test(test_sync),
+			 ztest_unit_test(test_coherent));
+	ztest_run_test_suite(dma_mem);
+}
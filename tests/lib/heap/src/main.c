@@ -235,6 +235,163 @@ static void test_solo_free_header(void)
 	}
 }
 
+static void *rawalloc(void *arg, size_t bytes)
+{
+	return sys_heap_alloc(arg, bytes);
+}
+
+static void rawfree(void *arg, void *p)
+{
+	sys_heap_free(arg, p);
+}
+
+/* Same workload as test_small_heap, but without the per-operation
+ * validation, so that the cost per operation and the resulting fill
+ * level can be compared between heap configurations (e.g. with and
+ * without CONFIG_SYS_HEAP_FAST_BINS).
+ */
+static void test_small_heap_perf(void)
+{
+	struct sys_heap heap;
+	struct z_heap_stress_result result;
+	uint32_t ops, cyc;
+
+	TC_PRINT("Timing small (%d byte) heap\n", (int) SMALL_HEAP_SZ);
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+
+	cyc = k_cycle_get_32();
+	sys_heap_stress(rawalloc, rawfree, &heap,
+			SMALL_HEAP_SZ, ITERATION_COUNT,
+			scratchmem, sizeof(scratchmem),
+			50, &result);
+	cyc = k_cycle_get_32() - cyc;
+
+	ops = result.total_allocs + result.total_frees;
+	TC_PRINT("%u operations, %u cycles/op\n", ops, cyc / ops);
+	log_result(SMALL_HEAP_SZ, &result);
+
+	zassert_true(sys_heap_validate(&heap), "");
+}
+
+/* Fast bins: a freed small block is handed back to the next request
+ * of the same size, and binned blocks are released when the heap
+ * runs out of memory.
+ */
+static void test_fast_bins(void)
+{
+	struct sys_heap heap;
+	void *p1, *p2;
+	int n = 0;
+
+	if (!IS_ENABLED(CONFIG_SYS_HEAP_FAST_BINS)) {
+		ztest_test_skip();
+		return;
+	}
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+
+	p1 = sys_heap_alloc(&heap, 24);
+	p2 = sys_heap_alloc(&heap, 24);
+	zassert_not_null(p1, "");
+	zassert_not_null(p2, "");
+	sys_heap_free(&heap, p1);
+	sys_heap_free(&heap, p2);
+
+	/* Inspecting the heap must leave the bins alone */
+	zassert_true(sys_heap_validate(&heap), "");
+	sys_heap_print_info(&heap, false);
+	zassert_equal(sys_heap_alloc(&heap, 22), p2, "bins are not LIFO");
+	zassert_equal(sys_heap_alloc(&heap, 22), p1, "bins are not LIFO");
+	sys_heap_free(&heap, p1);
+	sys_heap_free(&heap, p2);
+
+	/* Fill the heap with small blocks, then bin them all */
+	while ((scratchmem[n] = sys_heap_alloc(&heap, 16)) != NULL) {
+		n++;
+		zassert_true(n < ARRAY_SIZE(scratchmem), "");
+	}
+	zassert_true(n > 1, "");
+	while (n > 0) {
+		sys_heap_free(&heap, scratchmem[--n]);
+	}
+
+	/* Only fits once the bins have been merged back */
+	p1 = sys_heap_alloc(&heap, SMALL_HEAP_SZ / 2);
+	zassert_not_null(p1, "binned blocks not flushed");
+	sys_heap_free(&heap, p1);
+
+	zassert_true(sys_heap_validate(&heap), "");
+}
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+static void test_runtime_stats(void)
+{
+	struct sys_heap heap;
+	struct sys_heap_runtime_stats st0, st;
+	uint32_t buckets[32];
+	void *p1, *p2;
+	int nb;
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+
+	zassert_equal(sys_heap_runtime_stats_get(&heap, &st0), 0, "");
+	zassert_equal(st0.allocated_bytes, 0, "");
+	zassert_equal(st0.max_allocated_bytes, 0, "");
+	zassert_true(st0.free_bytes > 0 && st0.free_bytes < SMALL_HEAP_SZ, "");
+	zassert_equal(st0.largest_free_bytes, st0.free_bytes,
+		      "empty heap has a single free chunk");
+
+	p1 = sys_heap_alloc(&heap, 100);
+	p2 = sys_heap_alloc(&heap, 200);
+	sys_heap_runtime_stats_get(&heap, &st);
+	zassert_true(st.allocated_bytes >= 300, "");
+	zassert_equal(st.max_allocated_bytes, st.allocated_bytes, "");
+	zassert_true(st.free_bytes + st.allocated_bytes <= st0.free_bytes, "");
+
+	/* Freeing the first block leaves a hole below the second one */
+	sys_heap_free(&heap, p1);
+	sys_heap_runtime_stats_get(&heap, &st);
+	zassert_true(st.allocated_bytes >= 200 && st.allocated_bytes < 300, "");
+	zassert_true(st.max_allocated_bytes >= 300, "");
+	zassert_true(st.largest_free_bytes < st.free_bytes, "");
+
+	nb = sys_heap_bucket_stats_get(&heap, buckets, ARRAY_SIZE(buckets));
+	zassert_true(nb > 0 && nb <= ARRAY_SIZE(buckets), "");
+
+	uint32_t nfree = 0;
+
+	for (int i = 0; i < nb; i++) {
+		nfree += buckets[i];
+	}
+	zassert_equal(nfree, 2, "expected two free chunks");
+
+	p2 = sys_heap_realloc(&heap, p2, 50);
+	sys_heap_runtime_stats_get(&heap, &st);
+	zassert_true(st.allocated_bytes >= 50 && st.allocated_bytes < 100, "");
+
+	sys_heap_runtime_stats_reset_max(&heap);
+	sys_heap_runtime_stats_get(&heap, &st);
+	zassert_equal(st.max_allocated_bytes, st.allocated_bytes, "");
+
+	/* Validation leaves fast bins alone, all free space is reported
+	 * anyway because binned chunks count as free.
+	 */
+	sys_heap_free(&heap, p2);
+	zassert_true(sys_heap_validate(&heap), "");
+	sys_heap_runtime_stats_get(&heap, &st);
+	zassert_equal(st.allocated_bytes, 0, "");
+	zassert_equal(st.free_bytes, st0.free_bytes, "");
+
+	zassert_equal(sys_heap_runtime_stats_get(NULL, &st), -EINVAL, "");
+}
+#else
+static void test_runtime_stats(void)
+{
+	ztest_test_skip();
+}
+#endif
+
 /* Simple clobber detection */
 void realloc_fill_block(uint8_t *p, size_t sz)
 {
@@ -361,7 +518,10 @@ void test_main(void)
 			 ztest_unit_test(test_small_heap),
 			 ztest_unit_test(test_fragmentation),
 			 ztest_unit_test(test_big_heap),
-			 ztest_unit_test(test_solo_free_header)
+			 ztest_unit_test(test_solo_free_header),
+			 ztest_unit_test(test_small_heap_perf),
+			 ztest_unit_test(test_fast_bins),
+			 ztest_unit_test(test_runtime_stats)
 			 );
 
 	ztest_run_test_suite(lib_heap_test);
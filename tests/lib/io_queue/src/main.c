@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <sys/io_queue.h>
+
+#define QUEUE_SIZE 4
+
+IO_EXECUTOR_DEFINE(executor, 1024, K_PRIO_PREEMPT(1));
+IO_QUEUE_DEFINE(queue, executor, QUEUE_SIZE);
+IO_QUEUE_DEFINE(queue2, executor, QUEUE_SIZE);
+
+static uint32_t order[2 * QUEUE_SIZE];
+static uint32_t order_cnt;
+static uint32_t cb_cnt;
+
+static int op_record(const struct io_sqe *sqe)
+{
+	order[order_cnt++] = POINTER_TO_UINT(sqe->user_data);
+
+	return POINTER_TO_INT(sqe->callback.arg);
+}
+
+static struct io_sqe *sqe_add(struct io_queue *q, uint32_t id, int result,
+			      uint8_t flags)
+{
+	struct io_sqe *sqe = io_queue_sqe_acquire(q);
+
+	zassert_not_null(sqe, "no submission entry");
+
+	sqe->op = IO_OP_CALLBACK;
+	sqe->flags = flags;
+	sqe->user_data = UINT_TO_POINTER(id);
+	sqe->callback.func = op_record;
+	sqe->callback.arg = INT_TO_POINTER(result);
+
+	return sqe;
+}
+
+static void reset(void)
+{
+	struct io_cqe cqes[QUEUE_SIZE];
+
+	(void)io_queue_reap(&queue, cqes, ARRAY_SIZE(cqes));
+	(void)io_queue_reap(&queue2, cqes, ARRAY_SIZE(cqes));
+	io_queue_callback_set(&queue, NULL);
+	order_cnt = 0;
+	cb_cnt = 0;
+}
+
+static void test_submit_reap(void)
+{
+	struct io_cqe cqes[QUEUE_SIZE];
+	struct io_sqe *sqe;
+
+	reset();
+
+	sqe = io_queue_sqe_acquire(&queue);
+	zassert_not_null(sqe, "no submission entry");
+	sqe->op = IO_OP_NOP;
+	sqe->user_data = UINT_TO_POINTER(1);
+	sqe_add(&queue, 2, 0, 0);
+
+	zassert_equal(io_queue_wait(&queue, 1, K_MSEC(10)), -EAGAIN,
+		      "completion before submission");
+	zassert_equal(io_queue_submit(&queue), 2, "wrong submission count");
+	zassert_equal(io_queue_submit(&queue), 0, "entries submitted twice");
+	zassert_equal(io_queue_wait(&queue, 2, K_MSEC(100)), 0,
+		      "no completions");
+
+	zassert_equal(io_queue_reap(&queue, cqes, ARRAY_SIZE(cqes)), 2,
+		      "wrong completion count");
+	zassert_equal(cqes[0].result, 0, "wrong result");
+	zassert_equal(POINTER_TO_UINT(cqes[0].user_data), 1, "wrong order");
+	zassert_equal(POINTER_TO_UINT(cqes[1].user_data), 2, "wrong order");
+	zassert_equal(io_queue_reap(&queue, cqes, ARRAY_SIZE(cqes)), 0,
+		      "completions reaped twice");
+}
+
+static void test_full(void)
+{
+	struct io_cqe cqes[QUEUE_SIZE];
+
+	reset();
+
+	for (int i = 0; i < QUEUE_SIZE; i++) {
+		sqe_add(&queue, i, 0, 0);
+	}
+
+	zassert_is_null(io_queue_sqe_acquire(&queue), "queue overflow");
+
+	io_queue_submit(&queue);
+	zassert_equal(io_queue_wait(&queue, QUEUE_SIZE, K_MSEC(100)), 0,
+		      "no completions");
+	zassert_is_null(io_queue_sqe_acquire(&queue),
+			"entry reused before its completion was reaped");
+
+	zassert_equal(io_queue_reap(&queue, cqes, 1), 1, "no completion");
+	zassert_not_null(io_queue_sqe_acquire(&queue), "entry not reused");
+	io_queue_submit(&queue);
+	zassert_equal(io_queue_wait(&queue, QUEUE_SIZE, K_MSEC(100)), 0,
+		      "no completions");
+}
+
+static void test_chain(void)
+{
+	struct io_cqe cqes[QUEUE_SIZE];
+
+	reset();
+
+	sqe_add(&queue, 0, 0, IO_SQE_CHAINED);
+	sqe_add(&queue, 1, -EIO, IO_SQE_CHAINED);
+	sqe_add(&queue, 2, 0, 0);
+	sqe_add(&queue, 3, 0, 0);
+
+	io_queue_submit(&queue);
+	zassert_equal(io_queue_wait(&queue, 4, K_MSEC(100)), 0,
+		      "no completions");
+	zassert_equal(io_queue_reap(&queue, cqes, ARRAY_SIZE(cqes)), 4,
+		      "wrong completion count");
+
+	zassert_equal(cqes[0].result, 0, "wrong result");
+	zassert_equal(cqes[1].result, -EIO, "wrong result");
+	zassert_equal(cqes[2].result, -ECANCELED, "chain not canceled");
+	zassert_equal(cqes[3].result, 0, "next chain canceled");
+
+	zassert_equal(order_cnt, 3, "canceled entry performed");
+	zassert_equal(order[2], 3, "wrong order");
+}
+
+static void test_fairness(void)
+{
+	reset();
+
+	/* The chains of both queues are interleaved. */
+	sqe_add(&queue, 0, 0, IO_SQE_CHAINED);
+	sqe_add(&queue, 1, 0, 0);
+	sqe_add(&queue, 2, 0, 0);
+	sqe_add(&queue2, 10, 0, 0);
+	sqe_add(&queue2, 11, 0, 0);
+
+	k_sched_lock();
+	io_queue_submit(&queue);
+	io_queue_submit(&queue2);
+	k_sched_unlock();
+
+	zassert_equal(io_queue_wait(&queue, 3, K_MSEC(100)), 0,
+		      "no completions");
+	zassert_equal(io_queue_wait(&queue2, 2, K_MSEC(100)), 0,
+		      "no completions");
+
+	zassert_equal(order[0], 0, "wrong order");
+	zassert_equal(order[1], 1, "chain interrupted");
+	zassert_equal(order[2], 10, "queue starved");
+	zassert_equal(order[3], 2, "queue starved");
+	zassert_equal(order[4], 11, "queue starved");
+}
+
+static void completion_cb(struct io_queue *q, const struct io_cqe *cqe)
+{
+	zassert_equal_ptr(q, &queue, "wrong queue");
+	zassert_equal(POINTER_TO_UINT(cqe->user_data), cb_cnt,
+		      "wrong order");
+	cb_cnt++;
+}
+
+static void test_callback(void)
+{
+	reset();
+
+	io_queue_callback_set(&queue, completion_cb);
+	sqe_add(&queue, 0, 0, 0);
+	sqe_add(&queue, 1, 0, 0);
+	io_queue_submit(&queue);
+
+	zassert_equal(io_queue_wait(&queue, 2, K_MSEC(100)), 0,
+		      "no completions");
+	zassert_equal(cb_cnt, 2, "callback not called");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(io_queue_api,
+			 ztest_unit_test(test_submit_reap),
+			 ztest_unit_test(test_full),
+			 ztest_unit_test(test_chain),
+			 ztest_unit_test(test_fairness),
+			 ztest_unit_test(test_callback));
+	ztest_run_test_suite(io_queue_api);
+}
@@ -539,6 +539,194 @@ static void test_json_encode_bounds_check(void)
 	zassert_equal(ret, -ENOMEM, "Bounds check rejected");
 }
 
+struct flush_output {
+	char data[512];
+	size_t len;
+	int calls;
+};
+
+static int flush_to_output(const char *bytes, size_t len, void *data)
+{
+	struct flush_output *output = data;
+
+	zassert_true(output->len + len < sizeof(output->data),
+		     "Output overflow");
+	memcpy(output->data + output->len, bytes, len);
+	output->len += len;
+	output->calls++;
+
+	return 0;
+}
+
+static void test_json_buffered_encoding(void)
+{
+	struct test_struct ts = {
+		.some_string = "a string long enough to skip the buffer",
+		.some_int = 42,
+		.some_nested_struct = {
+			.nested_string = "escaped\t",
+		},
+		.some_array_len = 2,
+		.xnother_nexx = {
+			.nested_string = "",
+		},
+	};
+	static struct flush_output output;
+	struct json_buffered_writer writer;
+	char expected[512];
+	char buf[16];
+	int ret;
+
+	ret = json_obj_encode_buf(test_descr, ARRAY_SIZE(test_descr), &ts,
+				  expected, sizeof(expected));
+	zassert_equal(ret, 0, "Encoding in a buffer failed");
+
+	json_buffered_writer_init(&writer, buf, sizeof(buf),
+				  flush_to_output, &output);
+
+	ret = json_obj_encode(test_descr, ARRAY_SIZE(test_descr), &ts,
+			      json_buffered_append, &writer);
+	zassert_equal(ret, 0, "Buffered encoding failed");
+
+	ret = json_buffered_flush(&writer);
+	zassert_equal(ret, 0, "Flush failed");
+
+	zassert_equal(output.len, strlen(expected), "Length mismatch");
+	zassert_equal(memcmp(output.data, expected, output.len), 0,
+		      "Encoded contents mismatch");
+	zassert_true(output.calls <= output.len / sizeof(buf) + 1,
+		     "Output written in small blocks");
+}
+
+struct stream_events {
+	char log[256];
+	size_t len;
+};
+
+static void stream_log(struct json_stream_parser *parser, const char *str)
+{
+	struct stream_events *events = parser->user_data;
+	size_t len = strlen(str);
+
+	zassert_true(events->len + len < sizeof(events->log), "Log overflow");
+	memcpy(events->log + events->len, str, len + 1);
+	events->len += len;
+}
+
+static int stream_on_start(struct json_stream_parser *parser,
+			   enum json_tokens type)
+{
+	stream_log(parser, type == JSON_TOK_OBJECT_START ? "{" : "[");
+
+	return 0;
+}
+
+static int stream_on_end(struct json_stream_parser *parser,
+			 enum json_tokens type)
+{
+	stream_log(parser, type == JSON_TOK_OBJECT_END ? "}" : "]");
+
+	return 0;
+}
+
+static int stream_on_key(struct json_stream_parser *parser, const char *key,
+			 size_t len)
+{
+	zassert_equal(strlen(key), len, "Key not terminated");
+	stream_log(parser, key);
+	stream_log(parser, "=");
+
+	return 0;
+}
+
+static int stream_on_value(struct json_stream_parser *parser,
+			   enum json_tokens type, const char *value,
+			   size_t len)
+{
+	char type_str[] = { (char)type, '\0' };
+
+	zassert_equal(strlen(value), len, "Value not terminated");
+	stream_log(parser, type_str);
+	stream_log(parser, value);
+	stream_log(parser, ";");
+
+	return 0;
+}
+
+static const struct json_stream_callbacks stream_callbacks = {
+	.on_start = stream_on_start,
+	.on_end = stream_on_end,
+	.on_key = stream_on_key,
+	.on_value = stream_on_value,
+};
+
+static int stream_parse(const char *json, size_t chunk_len,
+			struct stream_events *events)
+{
+	struct json_stream_parser parser;
+	size_t len = strlen(json);
+	char buf[16];
+	int ret;
+
+	memset(events, 0, sizeof(*events));
+	json_stream_init(&parser, &stream_callbacks, buf, sizeof(buf),
+			 events);
+
+	for (size_t pos = 0; pos < len; pos += chunk_len) {
+		ret = json_stream_feed(&parser, json + pos,
+				       MIN(chunk_len, len - pos));
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return json_stream_finish(&parser);
+}
+
+static void test_json_stream_parsing(void)
+{
+	const char json[] = "{\"str\":\"a\\\"b\\u00e9\", \"num\" : -12.5e3,"
+		"\"list\":[true,false,null,[],{}],\n"
+		"\"obj\":{\"n\":7}}";
+	const char expected[] = "{str=\"a\\\"b\\u00e9;num=0-12.5e3;"
+		"list=[ttrue;ffalse;nnull;[]{}]obj={n=07;}}";
+	static struct stream_events events;
+	int ret;
+
+	/* The result does not depend on how the payload is split */
+	for (size_t chunk_len = 1; chunk_len <= sizeof(json); chunk_len++) {
+		ret = stream_parse(json, chunk_len, &events);
+		zassert_equal(ret, 0, "Parsing failed with chunks of %zu",
+			      chunk_len);
+		zassert_true(!strcmp(events.log, expected),
+			     "Unexpected events %s", events.log);
+	}
+
+	ret = stream_parse("42", 1, &events);
+	zassert_equal(ret, 0, "Parsing a number failed");
+	zassert_true(!strcmp(events.log, "042;"), "Unexpected events");
+}
+
+static void test_json_stream_invalid(void)
+{
+	static struct stream_events events;
+	const char *invalid[] = {
+		"{\"a\":1", "{\"a\" 1}", "{\"a\":1,}", "[1 2]", "[1,]",
+		"{\"a\":tru}", "[\"\\x\"]", "{1:2}", "[1}", "{}}", "-",
+		"[1.]", "{} {}",
+	};
+	int ret;
+
+	for (int i = 0; i < ARRAY_SIZE(invalid); i++) {
+		ret = stream_parse(invalid[i], 2, &events);
+		zassert_equal(ret, -EINVAL, "Accepted %s", invalid[i]);
+	}
+
+	ret = stream_parse("[\"a string too long for the buffer\"]", 4,
+			   &events);
+	zassert_equal(ret, -ENOMEM, "Token larger than the buffer accepted");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(lib_json_test,
@@ -560,7 +748,10 @@ void test_main(void)
 			 ztest_unit_test(test_json_escape_empty),
 			 ztest_unit_test(test_json_escape_no_op),
 			 ztest_unit_test(test_json_escape_bounds_check),
-			 ztest_unit_test(test_json_encode_bounds_check)
+			 ztest_unit_test(test_json_encode_bounds_check),
+			 ztest_unit_test(test_json_buffered_encoding),
+			 ztest_unit_test(test_json_stream_parsing),
+			 ztest_unit_test(test_json_stream_invalid)
 			 );
 
 	ztest_run_test_suite(lib_json_test);
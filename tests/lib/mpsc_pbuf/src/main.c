@@ -848,6 +848,174 @@ void test_overwrite_while_claimed2(void)
 		overwrite_while_claimed2(false);
 }
 
+void claim_batch(bool pow2)
+{
+	union mpsc_pbuf_generic *packets[4];
+	struct test_data_var *packet;
+	struct mpsc_pbuf_buffer buffer;
+	uint32_t len = 5;
+	uint32_t data = 0;
+	uint32_t n;
+
+	init(&buffer, false, pow2);
+
+	uint32_t packet_cnt = saturate_buffer_uneven(&buffer, len);
+
+	n = mpsc_pbuf_claim_batch(&buffer, packets, ARRAY_SIZE(packets));
+	zassert_equal(n, ARRAY_SIZE(packets), NULL);
+
+	/* Space is not released until packets are freed. */
+	packet = (struct test_data_var *)mpsc_pbuf_alloc(&buffer, len,
+							 K_NO_WAIT);
+	zassert_equal(packet, NULL, NULL);
+
+	for (int i = 0; i < n; i++) {
+		packet = (struct test_data_var *)packets[i];
+		zassert_equal(packet->hdr.data, data++, NULL);
+	}
+
+	mpsc_pbuf_free_batch(&buffer, packets, n);
+
+	packet = (struct test_data_var *)mpsc_pbuf_alloc(&buffer, len,
+							 K_NO_WAIT);
+	zassert_true(packet, NULL);
+	packet->hdr.len = len;
+	packet->hdr.data = packet_cnt;
+	mpsc_pbuf_commit(&buffer, (union mpsc_pbuf_generic *)packet);
+
+	while ((n = mpsc_pbuf_claim_batch(&buffer, packets,
+					  ARRAY_SIZE(packets))) > 0) {
+		for (int i = 0; i < n; i++) {
+			packet = (struct test_data_var *)packets[i];
+			zassert_equal(packet->hdr.data, data++, NULL);
+		}
+
+		mpsc_pbuf_free_batch(&buffer, packets, n);
+	}
+
+	zassert_equal(data, packet_cnt + 1, NULL);
+	zassert_false(mpsc_pbuf_is_pending(&buffer), NULL);
+}
+
+void test_claim_batch(void)
+{
+	claim_batch(true);
+	claim_batch(false);
+}
+
+void free_out_of_order(bool pow2)
+{
+	struct test_data_var *p[3];
+	struct test_data_var *packet;
+	struct mpsc_pbuf_buffer buffer;
+	uint32_t len = 5;
+
+	init(&buffer, false, pow2);
+
+	uint32_t packet_cnt = saturate_buffer_uneven(&buffer, len);
+
+	/* Packets claimed by different consumers. */
+	for (int i = 0; i < ARRAY_SIZE(p); i++) {
+		p[i] = (struct test_data_var *)mpsc_pbuf_claim(&buffer);
+		zassert_true(p[i], NULL);
+		zassert_equal(p[i]->hdr.data, i, NULL);
+	}
+
+	/* Packets freed before the first one are not released. */
+	mpsc_pbuf_free(&buffer, (union mpsc_pbuf_generic *)p[2]);
+	mpsc_pbuf_free(&buffer, (union mpsc_pbuf_generic *)p[1]);
+	packet = (struct test_data_var *)mpsc_pbuf_alloc(&buffer, len,
+							 K_NO_WAIT);
+	zassert_equal(packet, NULL, NULL);
+
+	mpsc_pbuf_free(&buffer, (union mpsc_pbuf_generic *)p[0]);
+	for (int i = 0; i < ARRAY_SIZE(p); i++) {
+		packet = (struct test_data_var *)mpsc_pbuf_alloc(&buffer, len,
+								 K_NO_WAIT);
+		zassert_true(packet, NULL);
+		packet->hdr.len = len;
+		packet->hdr.data = packet_cnt + i;
+		mpsc_pbuf_commit(&buffer, (union mpsc_pbuf_generic *)packet);
+	}
+
+	for (int i = ARRAY_SIZE(p); i < packet_cnt + ARRAY_SIZE(p); i++) {
+		packet = (struct test_data_var *)mpsc_pbuf_claim(&buffer);
+		zassert_true(packet, NULL);
+		zassert_equal(packet->hdr.data, i, NULL);
+		mpsc_pbuf_free(&buffer, (union mpsc_pbuf_generic *)packet);
+	}
+
+	zassert_equal(mpsc_pbuf_claim(&buffer), NULL, NULL);
+}
+
+void test_free_out_of_order(void)
+{
+	free_out_of_order(true);
+	free_out_of_order(false);
+}
+
+void overwrite_while_batch_claimed(bool pow2)
+{
+	union mpsc_pbuf_generic *packets[2];
+	struct test_data_var *p0;
+	struct test_data_var *p1;
+	struct mpsc_pbuf_buffer buffer;
+	uint32_t n;
+
+	init(&buffer, true, pow2);
+
+	uint32_t fill_len = 5;
+	uint32_t len = 6;
+	uint32_t packet_cnt = saturate_buffer_uneven(&buffer, fill_len);
+
+	/* Claim a batch of packets. Buffer is now full. Allocation shall
+	 * skip all claimed packets and drop the following ones.
+	 */
+	n = mpsc_pbuf_claim_batch(&buffer, packets, ARRAY_SIZE(packets));
+	zassert_equal(n, ARRAY_SIZE(packets), NULL);
+	p0 = (struct test_data_var *)packets[0];
+
+	exp_dropped_data[0] = p0->hdr.data + 2;
+	exp_dropped_len[0] = fill_len;
+	exp_dropped_data[1] = p0->hdr.data + 3;
+	exp_dropped_len[1] = fill_len;
+	p1 = (struct test_data_var *)mpsc_pbuf_alloc(&buffer, len, K_NO_WAIT);
+
+	zassert_equal(drop_cnt, 2, NULL);
+	p1->hdr.len = len;
+	mpsc_pbuf_commit(&buffer, (union mpsc_pbuf_generic *)p1);
+
+	/* Claimed packets are intact. */
+	for (int i = 0; i < n; i++) {
+		p0 = (struct test_data_var *)packets[i];
+		zassert_equal(p0->hdr.data, i, NULL);
+		zassert_equal(p0->hdr.len, fill_len, NULL);
+	}
+
+	mpsc_pbuf_free_batch(&buffer, packets, n);
+
+	for (int i = 0; i < packet_cnt - drop_cnt - n; i++) {
+		p0 = (struct test_data_var *)mpsc_pbuf_claim(&buffer);
+		zassert_true(p0, NULL);
+		zassert_equal(p0->hdr.len, fill_len, NULL);
+		zassert_equal(p0->hdr.data, i + drop_cnt + n, NULL);
+		mpsc_pbuf_free(&buffer, (union mpsc_pbuf_generic *)p0);
+	}
+
+	p0 = (struct test_data_var *)mpsc_pbuf_claim(&buffer);
+	zassert_true(p0, NULL);
+	zassert_equal(p0->hdr.len, len, NULL);
+
+	p0 = (struct test_data_var *)mpsc_pbuf_claim(&buffer);
+	zassert_equal(p0, NULL, NULL);
+}
+
+void test_overwrite_while_batch_claimed(void)
+{
+	overwrite_while_batch_claimed(true);
+	overwrite_while_batch_claimed(false);
+}
+
 static uintptr_t current_rd_idx;
 
 static void validate_packet(struct test_data_var *packet)
@@ -1046,6 +1214,9 @@ void test_main(void)
 		ztest_unit_test(test_overwrite),
 		ztest_unit_test(test_overwrite_while_claimed),
 		ztest_unit_test(test_overwrite_while_claimed2),
+		ztest_unit_test(test_claim_batch),
+		ztest_unit_test(test_free_out_of_order),
+		ztest_unit_test(test_overwrite_while_batch_claimed),
 		ztest_unit_test(test_overwrite_consistency),
 		ztest_unit_test(test_pending_alloc)
 		);
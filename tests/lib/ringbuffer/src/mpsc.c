@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <ztest.h>
+#include <irq_offload.h>
+#include <sys/ring_buffer.h>
+
+#define STACKSIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define PRODUCERS 3
+#define RECORDS 1000
+
+/* Records of 2 to 7 words, telling their producer and sequence number */
+#define REC_WORDS(seq) (2U + (seq) % 6U)
+
+static K_THREAD_STACK_ARRAY_DEFINE(producer_stacks, PRODUCERS, STACKSIZE);
+static struct k_thread producer_threads[PRODUCERS];
+
+RING_BUF_MPSC_DECLARE_POW2(mpsc_ringbuf, 6);
+
+/**
+ * @brief Test reserving, committing and claiming records
+ *
+ * @details Records are read in the order they were reserved, once
+ * committed, and the records which do not fit contiguously at the end of
+ * the buffer are written at its start.
+ *
+ * @ingroup lib_ringbuffer_tests
+ *
+ * @see ring_buf_mpsc_reserve(), ring_buf_mpsc_commit(),
+ * ring_buf_mpsc_claim(), ring_buf_mpsc_free()
+ */
+void test_ringbuffer_mpsc_reserve_commit(void)
+{
+	uint32_t *first, *second, *rec;
+	uint32_t size, out[8];
+
+	first = ring_buf_mpsc_reserve(&mpsc_ringbuf, 8);
+	second = ring_buf_mpsc_reserve(&mpsc_ringbuf, 4);
+	zassert_not_null(first, NULL);
+	zassert_not_null(second, NULL);
+
+	/* Not available before the first is committed */
+	second[0] = 2;
+	ring_buf_mpsc_commit(&mpsc_ringbuf, second);
+	zassert_is_null(ring_buf_mpsc_claim(&mpsc_ringbuf, &size), NULL);
+
+	first[0] = 1;
+	first[1] = 1;
+	ring_buf_mpsc_commit(&mpsc_ringbuf, first);
+
+	rec = ring_buf_mpsc_claim(&mpsc_ringbuf, &size);
+	zassert_equal_ptr(rec, first, NULL);
+	zassert_equal(size, 8, NULL);
+	ring_buf_mpsc_free(&mpsc_ringbuf, rec);
+
+	zassert_equal(ring_buf_mpsc_get(&mpsc_ringbuf, out, sizeof(out)), 4,
+		      NULL);
+	zassert_equal(out[0], 2, NULL);
+	zassert_equal(ring_buf_mpsc_get(&mpsc_ringbuf, out, sizeof(out)),
+		      -EAGAIN, NULL);
+
+	/* Fill the buffer with records wrapping around its end */
+	for (uint32_t i = 0; i < 100; i++) {
+		out[0] = i;
+		zassert_equal(ring_buf_mpsc_put(&mpsc_ringbuf, out,
+						4 * REC_WORDS(i)), 0, NULL);
+		zassert_equal(ring_buf_mpsc_get(&mpsc_ringbuf, out,
+						sizeof(out)),
+			      4 * REC_WORDS(i), NULL);
+		zassert_equal(out[0], i, NULL);
+	}
+
+	zassert_equal(ring_buf_mpsc_get(&mpsc_ringbuf, out, 4), -EAGAIN,
+		      NULL);
+	zassert_equal(ring_buf_mpsc_dropped_get(&mpsc_ringbuf), 0, NULL);
+}
+
+static void mpsc_put(uint32_t producer, uint32_t seq)
+{
+	uint32_t rec[8] = { producer, seq };
+
+	while (ring_buf_mpsc_put(&mpsc_ringbuf, rec,
+				 4 * REC_WORDS(seq)) != 0) {
+		k_yield();
+	}
+}
+
+static void isr_put(const void *arg)
+{
+	uint32_t *seq = (uint32_t *)arg;
+	uint32_t rec[8] = { PRODUCERS, *seq };
+
+	if (ring_buf_mpsc_put(&mpsc_ringbuf, rec, 4 * REC_WORDS(*seq)) == 0) {
+		(*seq)++;
+	}
+}
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	uint32_t id = POINTER_TO_UINT(p1);
+
+	for (uint32_t seq = 0; seq < RECORDS; seq++) {
+		mpsc_put(id, seq);
+	}
+}
+
+/**
+ * @brief Test producers contending for the ring buffer
+ *
+ * @details Threads, running on all the CPUs on SMP, and the consumer
+ * thread from ISRs produce records at the same time, without locks. Each
+ * record must be read once, in the order of its producer.
+ *
+ * @ingroup lib_ringbuffer_tests
+ *
+ * @see ring_buf_mpsc_put(), ring_buf_mpsc_get()
+ */
+void test_ringbuffer_mpsc_contention(void)
+{
+	uint32_t next[PRODUCERS + 1] = { 0 };
+	uint32_t isr_seq = 0;
+	uint32_t total = 0;
+	uint32_t out[8];
+	int ret;
+
+	for (int i = 0; i < PRODUCERS; i++) {
+		k_thread_create(&producer_threads[i], producer_stacks[i],
+				STACKSIZE, producer, UINT_TO_POINTER(i),
+				NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	while (total < (PRODUCERS + 1) * RECORDS) {
+		if (isr_seq < RECORDS) {
+			irq_offload(isr_put, &isr_seq);
+		}
+
+		ret = ring_buf_mpsc_get(&mpsc_ringbuf, out, sizeof(out));
+		if (ret == -EAGAIN) {
+			/* Let the producers run, on a single CPU too */
+			k_sleep(K_TICKS(1));
+			continue;
+		}
+
+		zassert_true(out[0] <= PRODUCERS, "bad producer %u", out[0]);
+		zassert_equal(out[1], next[out[0]], "producer %u: got %u, expected %u",
+			      out[0], out[1], next[out[0]]);
+		zassert_equal(ret, 4 * REC_WORDS(out[1]), NULL);
+		next[out[0]]++;
+		total++;
+	}
+
+	for (int i = 0; i < PRODUCERS; i++) {
+		k_thread_join(&producer_threads[i], K_FOREVER);
+	}
+
+	zassert_equal(ring_buf_mpsc_get(&mpsc_ringbuf, out, sizeof(out)),
+		      -EAGAIN, NULL);
+}
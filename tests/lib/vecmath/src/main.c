@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <string.h>
+#include <sys/vecmath.h>
+
+#define LEN 67
+#define TAPS 10
+#define BLOCK 16
+
+static int16_t a[LEN];
+static int16_t b[LEN];
+
+/* Deterministic full scale samples */
+static void samples_fill(int16_t *buf, size_t len, uint32_t seed)
+{
+	for (size_t i = 0; i < len; i++) {
+		seed = seed * 1103515245U + 12345U;
+		buf[i] = (int16_t)(seed >> 16);
+	}
+}
+
+static void test_dot_q15(void)
+{
+	int64_t expected = 0;
+
+	samples_fill(a, LEN, 1);
+	samples_fill(b, LEN, 2);
+
+	for (size_t i = 0; i < LEN; i++) {
+		expected += (int32_t)a[i] * b[i];
+	}
+
+	zassert_equal(vecmath_dot_q15(a, b, LEN), expected, NULL);
+	zassert_equal(vecmath_dot_q15(a, b, 0), 0, NULL);
+
+	/* No overflow of the accumulator */
+	for (size_t i = 0; i < LEN; i++) {
+		a[i] = INT16_MIN;
+	}
+	zassert_equal(vecmath_dot_q15(a, a, LEN), (int64_t)LEN << 30, NULL);
+}
+
+static void test_copy_scale_q15(void)
+{
+	static const struct {
+		int16_t in;
+		int16_t scale;
+		int8_t shift;
+		int16_t out;
+	} cases[] = {
+		{ 0x4000, 0x4000, 0, 0x2000 },
+		{ 0x4000, 0x4000, 1, 0x4000 },
+		{ 0x4000, 0x4000, -2, 0x0800 },
+		{ 0x7fff, 0x7fff, 1, INT16_MAX },
+		{ INT16_MIN, 0x7fff, 2, INT16_MIN },
+		{ -0x4000, 0x4000, 0, -0x2000 },
+	};
+	int16_t out[ARRAY_SIZE(cases)];
+
+	for (size_t i = 0; i < ARRAY_SIZE(cases); i++) {
+		vecmath_copy_scale_q15(out, &cases[i].in, cases[i].scale,
+				       cases[i].shift, 1);
+		zassert_equal(out[0], cases[i].out, "case %zu", i);
+	}
+
+	/* In place */
+	samples_fill(a, LEN, 3);
+	memcpy(b, a, sizeof(b));
+	vecmath_copy_scale_q15(a, a, 0x4000, 0, LEN);
+	for (size_t i = 0; i < LEN; i++) {
+		zassert_equal(a[i], b[i] >> 1, "sample %zu", i);
+	}
+}
+
+static void test_q15_q31(void)
+{
+	static const int32_t q31[] = { 0x12345678, -1, INT32_MIN, INT32_MAX };
+	static const int16_t q15[] = { 0x1234, -1, INT16_MIN, INT16_MAX };
+	int32_t wide[LEN];
+	int16_t narrow[ARRAY_SIZE(q31)];
+
+	vecmath_q31_to_q15(narrow, q31, ARRAY_SIZE(q31));
+	zassert_mem_equal(narrow, q15, sizeof(q15), NULL);
+
+	samples_fill(a, LEN, 4);
+	vecmath_q15_to_q31(wide, a, LEN);
+	for (size_t i = 0; i < LEN; i++) {
+		zassert_equal(wide[i], (int32_t)a[i] * 65536, "sample %zu", i);
+	}
+
+	vecmath_q31_to_q15(b, wide, LEN);
+	zassert_mem_equal(a, b, sizeof(a), NULL);
+}
+
+static int16_t fir_ref(const int16_t *coeffs, const int16_t *in, size_t n)
+{
+	int64_t acc = 0;
+
+	/* coeffs[TAPS - 1] is b[0], applied to the current sample */
+	for (size_t k = 0; k < TAPS && k <= n; k++) {
+		acc += (int32_t)coeffs[TAPS - 1 - k] * in[n - k];
+	}
+
+	return (int16_t)CLAMP(acc >> 15, INT16_MIN, INT16_MAX);
+}
+
+static void test_fir_q15(void)
+{
+	static int16_t coeffs[VECMATH_FIR_Q15_COEFFS_LEN(TAPS)];
+	static int16_t state[VECMATH_FIR_Q15_STATE_LEN(TAPS, BLOCK)];
+	struct vecmath_fir_q15 fir;
+	int16_t out[LEN];
+	size_t len;
+
+	zassert_equal(vecmath_fir_q15_init(&fir, coeffs, TAPS - 1, state,
+					   BLOCK), -EINVAL, NULL);
+	zassert_equal(vecmath_fir_q15_init(&fir, coeffs, 2, state, BLOCK),
+		      -EINVAL, NULL);
+
+	samples_fill(coeffs, TAPS, 5);
+	samples_fill(a, LEN, 6);
+
+	/* Blocks of varying lengths, the state carried over */
+	zassert_equal(vecmath_fir_q15_init(&fir, coeffs, TAPS, state, BLOCK),
+		      0, NULL);
+	for (size_t i = 0; i < LEN; i += len) {
+		len = MIN(1 + i % BLOCK, LEN - i);
+		vecmath_fir_q15(&fir, &out[i], &a[i], len);
+	}
+
+	for (size_t n = 0; n < LEN; n++) {
+		zassert_equal(out[n], fir_ref(coeffs, a, n), "sample %zu", n);
+	}
+
+	/* The impulse response is the coefficients, in reverse order */
+	memset(b, 0, sizeof(b));
+	b[0] = INT16_MAX;
+	zassert_equal(vecmath_fir_q15_init(&fir, coeffs, TAPS, state, BLOCK),
+		      0, NULL);
+	vecmath_fir_q15(&fir, out, b, BLOCK);
+	for (size_t n = 0; n < TAPS; n++) {
+		zassert_equal(out[n], fir_ref(coeffs, b, n), "sample %zu", n);
+	}
+}
+
+void test_main(void)
+{
+	ztest_test_suite(vecmath,
+			 ztest_unit_test(test_dot_q15),
+			 ztest_unit_test(test_copy_scale_q15),
+			 ztest_unit_test(test_q15_q31),
+			 ztest_unit_test(test_fir_q15));
+	ztest_run_test_suite(vecmath);
+}
@@ -1168,9 +1168,78 @@ void test_loop(void)
 	net_pkt_print();
 }
 
+/* The packets of test_loop() are compressed again, this time with the
+ * address compression taken from the flow cache.
+ */
+void test_flow_cache(void)
+{
+	int count;
+
+	if (!IS_ENABLED(CONFIG_NET_6LO_FLOW_CACHE)) {
+		ztest_test_skip();
+	}
+
+	for (count = 0; count < ARRAY_SIZE(tests); count++) {
+		TC_START(tests[count].name);
+
+		test_6lo(tests[count].data);
+		test_6lo(tests[count].data);
+	}
+
+#if defined(CONFIG_NET_6LO_CONTEXT)
+	/* Changing a context must not leave stale cached compression */
+	net_6lo_set_context(net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY)),
+			    &ctx1);
+
+	test_6lo(&test_data_15);
+#endif
+}
+
+#define PERF_ROUNDS 1000
+
+void test_compress_perf(void)
+{
+	uint32_t compress_cycles = 0U;
+	uint32_t uncompress_cycles = 0U;
+	struct net_pkt *pkt;
+	uint32_t start;
+	int count;
+
+	for (count = 0; count < PERF_ROUNDS; count++) {
+		pkt = create_pkt(&test_data_2);
+		zassert_not_null(pkt, "failed to create buffer");
+
+		net_pkt_cursor_init(pkt);
+
+		start = k_cycle_get_32();
+		zassert_true(net_6lo_compress(pkt, true) >= 0,
+			     "compression failed");
+		compress_cycles += k_cycle_get_32() - start;
+
+		start = k_cycle_get_32();
+		zassert_true(net_6lo_uncompress(pkt), "uncompression failed");
+		uncompress_cycles += k_cycle_get_32() - start;
+
+		net_pkt_unref(pkt);
+	}
+
+	TC_PRINT("compress %u cycles, uncompress %u cycles per packet\n",
+		 compress_cycles / PERF_ROUNDS, uncompress_cycles / PERF_ROUNDS);
+
+	if (compress_cycles && uncompress_cycles) {
+		TC_PRINT("compress %u pkts/s, uncompress %u pkts/s\n",
+			 (uint32_t)((uint64_t)sys_clock_hw_cycles_per_sec() *
+				    PERF_ROUNDS / compress_cycles),
+			 (uint32_t)((uint64_t)sys_clock_hw_cycles_per_sec() *
+				    PERF_ROUNDS / uncompress_cycles));
+	}
+}
+
 /*test case main entry*/
 void test_main(void)
 {
-	ztest_test_suite(test_6lo, ztest_unit_test(test_loop));
+	ztest_test_suite(test_6lo, ztest_unit_test(test_loop),
+			 ztest_unit_test(test_flow_cache),
+			 ztest_unit_test(test_compress_perf));
 	ztest_run_test_suite(test_6lo);
 }
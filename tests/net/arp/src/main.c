@@ -647,9 +647,147 @@ void test_arp(void)
 	}
 }
 
+/* Feed an ARP request for our address from a host, which adds the host
+ * to the ARP table.
+ */
+static void arp_add_host(struct net_if *iface, struct in_addr *host,
+			 struct net_eth_addr *host_hwaddr, struct in_addr *me)
+{
+	struct net_eth_hdr *eth_hdr;
+	struct net_arp_hdr *arp_hdr;
+	enum net_verdict verdict;
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(struct net_eth_hdr) +
+					sizeof(struct net_arp_hdr),
+					AF_UNSPEC, 0, K_SECONDS(1));
+	zassert_not_null(pkt, "out of mem request");
+
+	setup_eth_header(iface, pkt, net_eth_broadcast_addr(),
+			 NET_ETH_PTYPE_ARP);
+
+	eth_hdr = (struct net_eth_hdr *)net_pkt_data(pkt);
+	net_buf_add(pkt->buffer, sizeof(struct net_eth_hdr));
+	net_buf_pull(pkt->buffer, sizeof(struct net_eth_hdr));
+	arp_hdr = NET_ARP_HDR(pkt);
+
+	arp_hdr->hwtype = htons(NET_ARP_HTYPE_ETH);
+	arp_hdr->protocol = htons(NET_ETH_PTYPE_IP);
+	arp_hdr->hwlen = sizeof(struct net_eth_addr);
+	arp_hdr->protolen = sizeof(struct in_addr);
+	arp_hdr->opcode = htons(NET_ARP_REQUEST);
+	memcpy(&arp_hdr->src_hwaddr, host_hwaddr, sizeof(*host_hwaddr));
+	(void)memset(&arp_hdr->dst_hwaddr, 0, sizeof(arp_hdr->dst_hwaddr));
+	net_ipaddr_copy(&arp_hdr->src_ipaddr, host);
+	net_ipaddr_copy(&arp_hdr->dst_ipaddr, me);
+
+	net_buf_add(pkt->buffer, sizeof(struct net_arp_hdr));
+
+	verdict = net_arp_input(pkt, eth_hdr);
+	zassert_not_equal(verdict, NET_DROP, "ARP request dropped");
+
+	net_pkt_unref(pkt);
+
+	/* Let the reply go out */
+	k_sleep(K_MSEC(1));
+}
+
+/* Check if the ARP table resolves a host, without sending a request */
+static bool arp_host_resolved(struct net_if *iface, struct in_addr *host,
+			      struct net_eth_addr *host_hwaddr)
+{
+	struct net_ipv4_hdr *ipv4;
+	struct net_pkt *pkt, *pkt2;
+	bool resolved;
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(struct net_ipv4_hdr),
+					AF_INET, 0, K_SECONDS(1));
+	zassert_not_null(pkt, "out of mem");
+
+	ipv4 = (struct net_ipv4_hdr *)net_buf_add(pkt->buffer,
+						  sizeof(struct net_ipv4_hdr));
+	(void)memset(ipv4, 0, sizeof(*ipv4));
+	net_ipaddr_copy(&ipv4->dst, host);
+
+	pkt2 = net_arp_prepare(pkt, host, NULL);
+	zassert_not_null(pkt2, "ARP prepare failed");
+
+	resolved = (pkt2 == pkt);
+	if (resolved) {
+		zassert_mem_equal(net_pkt_lladdr_dst(pkt)->addr, host_hwaddr,
+				  sizeof(*host_hwaddr), "Wrong hwaddr");
+	} else {
+		/* The request holds a reference to the pending packet */
+		net_pkt_unref(pkt2);
+	}
+
+	net_pkt_unref(pkt);
+
+	return resolved;
+}
+
+void test_arp_table(void)
+{
+	struct in_addr me = { { { 192, 168, 0, 1 } } };
+	struct net_eth_addr host_hwaddr = {
+		{ 0x00, 0x00, 0x5e, 0x00, 0x53, 0x00 }
+	};
+	struct in_addr host = { { { 192, 168, 0, 100 } } };
+	struct net_if *iface;
+	int i;
+
+	iface = net_if_lookup_by_dev(DEVICE_GET(net_arp_test));
+
+	req_test = true;
+	net_arp_clear_cache(iface);
+
+	for (i = 0; i < CONFIG_NET_ARP_TABLE_SIZE; i++) {
+		host.s4_addr[3] = 100 + i;
+		host_hwaddr.addr[5] = i;
+		arp_add_host(iface, &host, &host_hwaddr, &me);
+	}
+
+	/**TESTPOINT: Check that every host of a full table is resolved */
+	for (i = CONFIG_NET_ARP_TABLE_SIZE - 1; i >= 0; i--) {
+		host.s4_addr[3] = 100 + i;
+		host_hwaddr.addr[5] = i;
+		zassert_true(arp_host_resolved(iface, &host, &host_hwaddr),
+			     "Host %d not resolved", i);
+	}
+
+	/**TESTPOINT: Check that a new host replaces the oldest one */
+	host.s4_addr[3] = 100 + CONFIG_NET_ARP_TABLE_SIZE;
+	host_hwaddr.addr[5] = CONFIG_NET_ARP_TABLE_SIZE;
+	arp_add_host(iface, &host, &host_hwaddr, &me);
+	zassert_true(arp_host_resolved(iface, &host, &host_hwaddr),
+		     "New host not resolved");
+
+	for (i = 1; i < CONFIG_NET_ARP_TABLE_SIZE; i++) {
+		host.s4_addr[3] = 100 + i;
+		host_hwaddr.addr[5] = i;
+		zassert_true(arp_host_resolved(iface, &host, &host_hwaddr),
+			     "Host %d not resolved", i);
+	}
+
+	host.s4_addr[3] = 100;
+	host_hwaddr.addr[5] = 0;
+	zassert_false(arp_host_resolved(iface, &host, &host_hwaddr),
+		      "Oldest host still resolved");
+
+	net_arp_clear_cache(iface);
+
+	host.s4_addr[3] = 101;
+	host_hwaddr.addr[5] = 1;
+	zassert_false(arp_host_resolved(iface, &host, &host_hwaddr),
+		      "Host resolved after clearing the cache");
+
+	net_arp_clear_cache(iface);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_arp_fn,
-		ztest_unit_test(test_arp));
+		ztest_unit_test(test_arp),
+		ztest_unit_test(test_arp_table));
 	ztest_run_test_suite(test_arp_fn);
 }
@@ -30,6 +30,7 @@ LOG_MODULE_REGISTER(net_test, NET_LOG_LEVEL);
 
 #include "ipv6.h"
 #include "udp_internal.h"
+#include "tcp2_priv.h"
 
 #define NET_LOG_ENABLED 1
 #include "net_private.h"
@@ -80,6 +81,18 @@ static bool test_failed;
 static bool test_started;
 static bool start_receiving;
 
+/* The offloading enabled interface plays the TCP peer, and records the
+ * segments left to it for splitting
+ */
+static bool tso_started;
+static uint32_t tso_peer_seq;
+static uint16_t tso_mss_seen;
+static size_t tso_len_seen;
+static char tso_data[2000];
+
+/* The data is sent without copying, as a copy would be cut to the MTU */
+NET_BUF_POOL_DEFINE(tso_pool, 1, 0, 0, NULL);
+
 static K_SEM_DEFINE(wait_data, 0, UINT_MAX);
 
 #define WAIT_TIME K_SECONDS(1)
@@ -216,6 +229,88 @@ static int eth_tx_offloading_disabled(const struct device *dev,
 	return 0;
 }
 
+static void tso_peer_reply(struct net_if *iface, struct net_ipv6_hdr *ip,
+			   struct net_tcp_hdr *tcp, uint32_t ack,
+			   uint8_t flags)
+{
+	struct net_linkaddr *lladdr = net_if_get_link_addr(iface);
+	struct net_eth_hdr eth = {
+		.src.addr = { 0x01, 0x02, 0x33, 0x44, 0x05, 0x06 },
+		.type = htons(NET_ETH_PTYPE_IPV6),
+	};
+	struct net_ipv6_hdr ip_reply = {
+		.vtc = 0x60,
+		.len = htons(sizeof(struct net_tcp_hdr)),
+		.nexthdr = IPPROTO_TCP,
+		.hop_limit = 64,
+	};
+	struct net_tcp_hdr tcp_reply = {
+		.src_port = tcp->dst_port,
+		.dst_port = tcp->src_port,
+		.offset = (sizeof(struct net_tcp_hdr) / 4U) << 4,
+		.flags = flags,
+	};
+	struct net_pkt *pkt;
+
+	memcpy(eth.dst.addr, lladdr->addr, sizeof(eth.dst.addr));
+	net_ipaddr_copy(&ip_reply.src, &ip->dst);
+	net_ipaddr_copy(&ip_reply.dst, &ip->src);
+	sys_put_be32(tso_peer_seq, tcp_reply.seq);
+	sys_put_be32(ack, tcp_reply.ack);
+	sys_put_be16(UINT16_MAX, tcp_reply.wnd);
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, sizeof(eth) +
+					   sizeof(ip_reply) +
+					   sizeof(tcp_reply),
+					   AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate reply");
+
+	zassert_ok(net_pkt_write(pkt, &eth, sizeof(eth)), "eth header");
+	zassert_ok(net_pkt_write(pkt, &ip_reply, sizeof(ip_reply)),
+		   "IPv6 header");
+	zassert_ok(net_pkt_write(pkt, &tcp_reply, sizeof(tcp_reply)),
+		   "TCP header");
+
+	zassert_ok(net_recv_data(iface, pkt), "Cannot receive reply");
+}
+
+/* Answer the handshake, acknowledge the data and reset the connection
+ * when it is closed. Checksums are offloaded both ways, so none is
+ * needed in the replies.
+ */
+static void tso_peer(struct net_pkt *pkt)
+{
+	struct net_ipv6_hdr ip;
+	struct net_tcp_hdr tcp;
+	uint32_t seq;
+	size_t len;
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_pkt_skip(pkt, sizeof(struct net_eth_hdr)), "eth");
+	zassert_ok(net_pkt_read(pkt, &ip, sizeof(ip)), "IPv6 header");
+	zassert_equal(ip.nexthdr, IPPROTO_TCP, "Not a TCP segment");
+	zassert_ok(net_pkt_read(pkt, &tcp, sizeof(tcp)), "TCP header");
+	zassert_equal(tcp.chksum, 0, "Checksum calculated");
+
+	seq = sys_get_be32(tcp.seq);
+	len = ntohs(ip.len) - (tcp.offset >> 4) * 4U;
+
+	if (tcp.flags & SYN) {
+		tso_peer_reply(net_pkt_iface(pkt), &ip, &tcp, seq + 1,
+			       SYN | ACK);
+		tso_peer_seq++;
+	} else if (tcp.flags & FIN) {
+		tso_peer_reply(net_pkt_iface(pkt), &ip, &tcp, seq + len + 1,
+			       RST | ACK);
+	} else if (len > 0) {
+		tso_mss_seen = net_pkt_tso_mss(pkt);
+		tso_len_seen = len;
+
+		tso_peer_reply(net_pkt_iface(pkt), &ip, &tcp, seq + len, ACK);
+		k_sem_give(&wait_data);
+	}
+}
+
 static int eth_tx_offloading_enabled(const struct device *dev,
 				     struct net_pkt *pkt)
 {
@@ -230,6 +325,11 @@ static int eth_tx_offloading_enabled(const struct device *dev,
 		return -ENODATA;
 	}
 
+	if (tso_started) {
+		tso_peer(pkt);
+		return 0;
+	}
+
 	if (test_started) {
 		uint16_t chksum;
 
@@ -248,7 +348,8 @@ static int eth_tx_offloading_enabled(const struct device *dev,
 static enum ethernet_hw_caps eth_offloading_enabled(const struct device *dev)
 {
 	return ETHERNET_HW_TX_CHKSUM_OFFLOAD |
-		ETHERNET_HW_RX_CHKSUM_OFFLOAD;
+		ETHERNET_HW_RX_CHKSUM_OFFLOAD |
+		ETHERNET_HW_TX_TCP_SEGMENTATION;
 }
 
 static enum ethernet_hw_caps eth_offloading_disabled(const struct device *dev)
@@ -928,6 +1029,77 @@ static void test_rx_chksum_offload_enabled_test_v4(void)
 	k_sleep(K_MSEC(10));
 }
 
+static void test_tx_tcp_segmentation_offload(void)
+{
+	struct net_context *tcp_ctx;
+	struct net_if *iface;
+	struct net_buf *buf;
+	int ret;
+	struct sockaddr_in6 dst_addr6 = {
+		.sin6_family = AF_INET6,
+		.sin6_port = htons(TEST_PORT),
+	};
+	struct sockaddr_in6 src_addr6 = {
+		.sin6_family = AF_INET6,
+		.sin6_port = 0,
+	};
+
+	iface = eth_interfaces[1];
+	zassert_true(net_if_supports_tx_tso(iface), "No TSO support");
+	zassert_false(net_if_supports_tx_tso(eth_interfaces[0]),
+		      "TSO support without offloading");
+
+	ret = net_context_get(AF_INET6, SOCK_STREAM, IPPROTO_TCP, &tcp_ctx);
+	zassert_equal(ret, 0, "Create IPv6 TCP context failed");
+
+	memcpy(&src_addr6.sin6_addr, &my_addr2, sizeof(struct in6_addr));
+	memcpy(&dst_addr6.sin6_addr, &dst_addr, sizeof(struct in6_addr));
+
+	ret = net_context_bind(tcp_ctx, (struct sockaddr *)&src_addr6,
+			       sizeof(struct sockaddr_in6));
+	zassert_equal(ret, 0, "Context bind failure test failed");
+
+	ret = add_neighbor(iface, &dst_addr);
+	zassert_true(ret, "Cannot add neighbor");
+
+	tso_started = true;
+
+	ret = net_context_connect(tcp_ctx, (struct sockaddr *)&dst_addr6,
+				  sizeof(struct sockaddr_in6), NULL,
+				  WAIT_TIME, NULL);
+	zassert_equal(ret, 0, "Connect failed (%d)", ret);
+
+	memset(tso_data, 'a', sizeof(tso_data));
+
+	buf = net_buf_alloc_with_data(&tso_pool, tso_data, sizeof(tso_data),
+				      K_NO_WAIT);
+	zassert_not_null(buf, "Cannot allocate buffer");
+
+	ret = net_context_sendto_buf(tcp_ctx, buf, NULL, 0, NULL, K_NO_WAIT,
+				     NULL);
+	zassert_equal(ret, sizeof(tso_data), "Send TCP data failed (%d)",
+		      ret);
+
+	if (k_sem_take(&wait_data, WAIT_TIME)) {
+		DBG("Timeout while waiting interface data\n");
+		zassert_false(true, "Timeout");
+	}
+
+	/* Without an MSS option from the peer, the default one is used */
+	zassert_equal(tso_mss_seen, NET_IPV6_MTU, "Segment not marked (%u)",
+		      tso_mss_seen);
+	zassert_equal(tso_len_seen, sizeof(tso_data),
+		      "Data sent in more than one segment (%zu)",
+		      tso_len_seen);
+
+	net_context_put(tcp_ctx);
+
+	/* Let the connection be reset */
+	k_sleep(K_MSEC(10));
+
+	tso_started = false;
+}
+
 void test_main(void)
 {
 	ztest_test_suite(net_chksum_offload_test,
@@ -940,7 +1112,8 @@ void test_main(void)
 			 ztest_unit_test(test_rx_chksum_offload_disabled_test_v6),
 			 ztest_unit_test(test_rx_chksum_offload_disabled_test_v4),
 			 ztest_unit_test(test_rx_chksum_offload_enabled_test_v6),
-			 ztest_unit_test(test_rx_chksum_offload_enabled_test_v4)
+			 ztest_unit_test(test_rx_chksum_offload_enabled_test_v4),
+			 ztest_unit_test(test_tx_tcp_segmentation_offload)
 			 );
 
 	ztest_run_test_suite(net_chksum_offload_test);
@@ -0,0 +1,332 @@
+/* main.c - Application main entry point */
+
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_IPV4_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/printk.h>
+
+#include <ztest.h>
+
+#include <net/dummy.h>
+#include <net/buf.h>
+#include <net/net_ip.h>
+#include <net/net_if.h>
+#include <net/udp.h>
+
+#define NET_LOG_ENABLED 1
+#include "net_private.h"
+
+#include "ipv4.h"
+
+#define TEST_MTU 576
+#define SRC_PORT 4241
+#define DST_PORT 4242
+#define PAYLOAD_LEN 1500
+
+/* The UDP header and the payload split at 552 bytes, the largest multiple
+ * of 8 that fits after the IPv4 header.
+ */
+#define FRAG_COUNT 3
+#define FRAG_LEN ((TEST_MTU - NET_IPV4H_LEN) & ~7)
+
+#define WAIT_TIME K_MSEC(500)
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+static uint8_t mac_addr[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+static struct net_if *iface;
+static struct net_context *udp_ctx;
+static struct net_context *recv_ctx;
+static uint8_t payload[PAYLOAD_LEN];
+
+/* Fragments sent by the interface, in the order they were sent */
+static struct net_pkt *frags[FRAG_COUNT];
+static int frag_count;
+static bool recv_ok;
+
+static K_SEM_DEFINE(wait_frags, 0, UINT_MAX);
+static K_SEM_DEFINE(wait_data, 0, UINT_MAX);
+
+static int net_iface_dev_init(const struct device *dev)
+{
+	return 0;
+}
+
+static void net_iface_init(struct net_if *iface)
+{
+	net_if_set_link_addr(iface, mac_addr, sizeof(mac_addr),
+			     NET_LINK_ETHERNET);
+}
+
+static int tester_send(const struct device *dev, struct net_pkt *pkt)
+{
+	if (frag_count < FRAG_COUNT) {
+		frags[frag_count++] = net_pkt_clone(pkt, K_NO_WAIT);
+	}
+
+	k_sem_give(&wait_frags);
+
+	return 0;
+}
+
+static struct dummy_api net_iface_api = {
+	.iface_api.init = net_iface_init,
+	.send = tester_send,
+};
+
+NET_DEVICE_INIT(net_ipv4_frag_test, "net_ipv4_frag_test",
+		net_iface_dev_init, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &net_iface_api,
+		DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), TEST_MTU);
+
+static void recv_cb(struct net_context *context,
+		    struct net_pkt *pkt,
+		    union net_ip_header *ip_hdr,
+		    union net_proto_header *proto_hdr,
+		    int status,
+		    void *user_data)
+{
+	static uint8_t data[PAYLOAD_LEN];
+
+	recv_ok = net_pkt_remaining_data(pkt) == sizeof(data) &&
+		  !net_pkt_read(pkt, data, sizeof(data)) &&
+		  !memcmp(data, payload, sizeof(data));
+
+	net_pkt_unref(pkt);
+	k_sem_give(&wait_data);
+}
+
+static void frag_count_cb(struct net_ipv4_reassembly *reass, void *user_data)
+{
+	(*(int *)user_data)++;
+}
+
+static int pending_reassemblies(void)
+{
+	int count = 0;
+
+	net_ipv4_frag_foreach(frag_count_cb, &count);
+
+	return count;
+}
+
+/* Send the payload and collect its fragments */
+static void send_payload(void)
+{
+	struct sockaddr_in dst = {
+		.sin_family = AF_INET,
+		.sin_port = htons(DST_PORT),
+	};
+	int ret;
+
+	frag_count = 0;
+	k_sem_reset(&wait_frags);
+
+	net_ipaddr_copy(&dst.sin_addr, &peer_addr);
+
+	ret = net_context_sendto(udp_ctx, payload, sizeof(payload),
+				 (struct sockaddr *)&dst, sizeof(dst),
+				 NULL, K_NO_WAIT, NULL);
+	zassert_equal(ret, sizeof(payload), "Send failed (%d)", ret);
+
+	for (int i = 0; i < FRAG_COUNT; i++) {
+		zassert_ok(k_sem_take(&wait_frags, WAIT_TIME),
+			   "Timeout after %d fragments", i);
+	}
+
+	zassert_equal(k_sem_take(&wait_frags, K_MSEC(50)), -EAGAIN,
+		      "Too many fragments");
+
+	for (int i = 0; i < FRAG_COUNT; i++) {
+		zassert_not_null(frags[i], "Cannot clone fragment %d", i);
+	}
+}
+
+/* Feed a copy of a sent fragment back to us, as if the peer had sent
+ * it. Swapping the addresses does not change the checksums.
+ */
+static void recv_frag(int i)
+{
+	struct net_pkt *pkt = net_pkt_clone(frags[i], K_NO_WAIT);
+	struct net_ipv4_hdr *hdr;
+	struct in_addr addr;
+
+	zassert_not_null(pkt, "Cannot clone fragment %d", i);
+
+	hdr = NET_IPV4_HDR(pkt);
+	net_ipaddr_copy(&addr, &hdr->src);
+	net_ipaddr_copy(&hdr->src, &hdr->dst);
+	net_ipaddr_copy(&hdr->dst, &addr);
+
+	zassert_ok(net_recv_data(iface, pkt), "Cannot receive fragment %d", i);
+}
+
+static void release_frags(void)
+{
+	for (int i = 0; i < FRAG_COUNT; i++) {
+		net_pkt_unref(frags[i]);
+		frags[i] = NULL;
+	}
+}
+
+static void test_setup(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+	};
+	struct net_if_addr *ifaddr;
+	int ret;
+
+	for (int i = 0; i < sizeof(payload); i++) {
+		payload[i] = i;
+	}
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(iface, "No test interface");
+
+	ifaddr = net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "Cannot add IPv4 address");
+
+	ret = net_context_get(AF_INET, SOCK_DGRAM, IPPROTO_UDP, &udp_ctx);
+	zassert_equal(ret, 0, "Create IPv4 UDP context failed");
+
+	net_ipaddr_copy(&addr.sin_addr, &my_addr);
+	addr.sin_port = htons(SRC_PORT);
+
+	ret = net_context_bind(udp_ctx, (struct sockaddr *)&addr,
+			       sizeof(addr));
+	zassert_equal(ret, 0, "Context bind failed");
+
+	/* The fragments looped back are for the destination port */
+	ret = net_context_get(AF_INET, SOCK_DGRAM, IPPROTO_UDP, &recv_ctx);
+	zassert_equal(ret, 0, "Create IPv4 UDP context failed");
+
+	addr.sin_port = htons(DST_PORT);
+
+	ret = net_context_bind(recv_ctx, (struct sockaddr *)&addr,
+			       sizeof(addr));
+	zassert_equal(ret, 0, "Context bind failed");
+
+	ret = net_context_recv(recv_ctx, recv_cb, K_NO_WAIT, NULL);
+	zassert_equal(ret, 0, "Context recv setup failed (%d)", ret);
+}
+
+static void test_fragment_send(void)
+{
+	uint16_t id = 0U;
+
+	send_payload();
+
+	for (int i = 0; i < FRAG_COUNT; i++) {
+		struct net_ipv4_hdr *hdr = NET_IPV4_HDR(frags[i]);
+		uint16_t offset = (hdr->offset[0] << 8) | hdr->offset[1];
+		size_t len = net_pkt_get_len(frags[i]);
+
+		zassert_true(len <= TEST_MTU, "Fragment %d too long", i);
+		zassert_equal(ntohs(hdr->len), len, "Invalid length");
+		zassert_equal((offset & 0x1fff) * 8, i * FRAG_LEN,
+			      "Invalid offset in fragment %d", i);
+		zassert_equal(!!(offset & 0x2000), i < FRAG_COUNT - 1,
+			      "Invalid MF flag in fragment %d", i);
+
+		if (i == 0) {
+			id = (hdr->id[0] << 8) | hdr->id[1];
+			zassert_equal(len, NET_IPV4H_LEN + FRAG_LEN,
+				      "Invalid first fragment");
+		} else {
+			zassert_equal((hdr->id[0] << 8) | hdr->id[1], id,
+				      "Different id in fragment %d", i);
+		}
+	}
+
+	zassert_equal(net_pkt_get_len(frags[FRAG_COUNT - 1]),
+		      NET_IPV4H_LEN + NET_UDPH_LEN + PAYLOAD_LEN -
+		      (FRAG_COUNT - 1) * FRAG_LEN,
+		      "Invalid last fragment");
+}
+
+static void test_reassembly_in_order(void)
+{
+	recv_ok = false;
+
+	for (int i = 0; i < FRAG_COUNT; i++) {
+		recv_frag(i);
+	}
+
+	zassert_ok(k_sem_take(&wait_data, WAIT_TIME), "Timeout");
+	zassert_true(recv_ok, "Invalid reassembled data");
+	zassert_equal(pending_reassemblies(), 0, "Reassembly left pending");
+
+	release_frags();
+}
+
+static void test_reassembly_out_of_order(void)
+{
+	send_payload();
+
+	recv_ok = false;
+
+	/* Duplicates are ignored */
+	recv_frag(2);
+	recv_frag(0);
+	recv_frag(2);
+	recv_frag(1);
+
+	zassert_ok(k_sem_take(&wait_data, WAIT_TIME), "Timeout");
+	zassert_true(recv_ok, "Invalid reassembled data");
+	zassert_equal(k_sem_take(&wait_data, K_MSEC(50)), -EAGAIN,
+		      "Packet received twice");
+	zassert_equal(pending_reassemblies(), 0, "Reassembly left pending");
+
+	release_frags();
+}
+
+static void test_reassembly_timeout(void)
+{
+	send_payload();
+
+	recv_frag(0);
+	recv_frag(2);
+
+	/* Let the RX thread handle the fragments */
+	k_sleep(K_MSEC(50));
+
+	zassert_equal(pending_reassemblies(), 1, "No pending reassembly");
+
+	k_sleep(K_SECONDS(CONFIG_NET_IPV4_FRAGMENT_TIMEOUT));
+
+	zassert_equal(pending_reassemblies(), 0, "Reassembly not cancelled");
+
+	/* The missing fragment alone does not complete anything */
+	recv_frag(1);
+
+	zassert_equal(k_sem_take(&wait_data, K_MSEC(100)), -EAGAIN,
+		      "Incomplete packet received");
+
+	release_frags();
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_ipv4_fragment_test,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_fragment_send),
+			 ztest_unit_test(test_reassembly_in_order),
+			 ztest_unit_test(test_reassembly_out_of_order),
+			 ztest_unit_test(test_reassembly_timeout));
+
+	ztest_run_test_suite(net_ipv4_fragment_test);
+}
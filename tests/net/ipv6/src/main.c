@@ -1488,6 +1488,98 @@ static void test_dst_is_other_iface_mcast_recv(void)
 	net_context_put(ctx);
 }
 
+static void nbr_collect(struct net_nbr *nbr, void *user_data)
+{
+	struct in6_addr *addrs = user_data;
+	int i;
+
+	for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
+		if (net_ipv6_is_addr_unspecified(&addrs[i])) {
+			net_ipaddr_copy(&addrs[i], &net_ipv6_nbr_data(nbr)->addr);
+			return;
+		}
+	}
+}
+
+static void nbr_addr(struct in6_addr *addr, int i)
+{
+	/* Only the interface identifier differs, as on a real link */
+	net_ipv6_addr_create(addr, 0x2001, 0xdb8, 0x42, 0, 0, 0, i >> 8,
+			     i & 0xff);
+}
+
+/**
+ * @brief IPv6 neighbor lookup with a full table
+ */
+static void test_nbr_lookup_full_table(void)
+{
+	struct in6_addr addrs[CONFIG_NET_IPV6_MAX_NEIGHBORS] = { 0 };
+	uint8_t mac[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x00 };
+	struct net_linkaddr lladdr = {
+		.addr = mac,
+		.len = sizeof(mac),
+		.type = NET_LINK_ETHERNET,
+	};
+	struct in6_addr addr;
+	struct net_nbr *nbr;
+	int i;
+
+	net_ipv6_nbr_foreach(nbr_collect, addrs);
+
+	for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
+		if (!net_ipv6_is_addr_unspecified(&addrs[i])) {
+			net_ipv6_nbr_rm(TEST_NET_IF, &addrs[i]);
+		}
+	}
+
+	for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
+		nbr_addr(&addr, i);
+		mac[5] = i;
+
+		nbr = net_ipv6_nbr_add(TEST_NET_IF, &addr, &lladdr, false,
+				       NET_IPV6_NBR_STATE_REACHABLE);
+		zassert_not_null(nbr, "Cannot add neighbor %d", i);
+	}
+
+	for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
+		nbr_addr(&addr, i);
+
+		nbr = net_ipv6_nbr_lookup(TEST_NET_IF, &addr);
+		zassert_not_null(nbr, "Neighbor %d not found", i);
+		zassert_true(net_ipv6_addr_cmp(&net_ipv6_nbr_data(nbr)->addr,
+					       &addr), "Wrong neighbor %d", i);
+		zassert_equal_ptr(net_ipv6_nbr_lookup(NULL, &addr), nbr,
+				  "Neighbor %d not found on any iface", i);
+	}
+
+	nbr_addr(&addr, CONFIG_NET_IPV6_MAX_NEIGHBORS);
+	zassert_is_null(net_ipv6_nbr_lookup(TEST_NET_IF, &addr),
+			"Unknown neighbor found");
+
+	/* Reuse every other entry for another address */
+	for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i += 2) {
+		nbr_addr(&addr, i);
+		zassert_true(net_ipv6_nbr_rm(TEST_NET_IF, &addr),
+			     "Cannot remove neighbor %d", i);
+
+		nbr_addr(&addr, i + 0x100);
+		nbr = net_ipv6_nbr_add(TEST_NET_IF, &addr, &lladdr, false,
+				       NET_IPV6_NBR_STATE_REACHABLE);
+		zassert_not_null(nbr, "Cannot add neighbor %d", i + 0x100);
+	}
+
+	for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
+		nbr_addr(&addr, i);
+		zassert_equal(net_ipv6_nbr_lookup(TEST_NET_IF, &addr) != NULL,
+			      i % 2, "Neighbor %d lookup mismatch", i);
+
+		nbr_addr(&addr, i + 0x100);
+		zassert_equal(net_ipv6_nbr_lookup(TEST_NET_IF, &addr) != NULL,
+			      !(i % 2), "Neighbor %d lookup mismatch",
+			      i + 0x100);
+	}
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_ipv6_fn,
@@ -1520,7 +1612,8 @@ void test_main(void)
 			 ztest_unit_test(test_dst_org_scope_mcast_recv),
 			 ztest_unit_test(test_dst_unknown_group_mcast_recv),
 			 ztest_unit_test(test_dst_unjoined_group_mcast_recv),
-			 ztest_unit_test(test_dst_is_other_iface_mcast_recv)
+			 ztest_unit_test(test_dst_is_other_iface_mcast_recv),
+			 ztest_unit_test(test_nbr_lookup_full_table)
 			 );
 	ztest_run_test_suite(test_ipv6_fn);
 }
@@ -17,6 +17,7 @@ LOG_MODULE_REGISTER(net_test, LOG_LEVEL_DBG);
 #include <kernel.h>
 
 #include <net/coap.h>
+#include <net/coap_block_download.h>
 
 #include <tc_util.h>
 #include <ztest.h>
@@ -879,6 +880,278 @@ static void test_observer_server(void)
 		      "There should be no handler for this resource");
 }
 
+static struct coap_resource *index_matched;
+
+static int index_resource_get(struct coap_resource *resource,
+			      struct coap_packet *request,
+			      struct sockaddr *addr, socklen_t addr_len)
+{
+	index_matched = resource;
+
+	return 0;
+}
+
+static const char * const index_path_ab[] = { "a", "b", NULL };
+static const char * const index_path_aplus[] = { "a", "+", NULL };
+static const char * const index_path_ac[] = { "a", "c", NULL };
+static const char * const index_path_a[] = { "a", NULL };
+static const char * const index_path_xhash[] = { "x", "#", "y", NULL };
+static const char * const index_path_xz[] = { "x", "z", NULL };
+static const char * const index_path_root[] = { NULL };
+static struct coap_resource index_resources[] = {
+	{ .path = index_path_ab, .get = index_resource_get },
+	{ .path = index_path_aplus, .get = index_resource_get },
+	{ .path = index_path_ac, .get = index_resource_get },
+	{ .path = index_path_a, .get = index_resource_get },
+	{ .path = index_path_xhash, .get = index_resource_get },
+	{ .path = index_path_xz, .get = index_resource_get },
+	{ .path = index_path_root },
+	{ },
+};
+
+static void test_resource_index(void)
+{
+	static const char * const uris[][3] = {
+		{ "a", "b" }, { "a", "c" }, { "a", "d" }, { "a" },
+		{ "a", "b", "c" }, { "x" }, { "x", "z" }, { "x", "y", "w" },
+		{ "y" }, { NULL },
+	};
+	struct coap_resource_index_node nodes[12];
+	struct coap_resource_index index;
+	struct coap_option options[4] = {};
+	uint8_t opt_num = ARRAY_SIZE(options) - 1;
+	struct coap_resource *expected;
+	struct coap_packet req;
+	uint8_t *data = data_buf[0];
+	int r, r_index;
+
+	r = coap_resource_index_init(&index, index_resources, nodes, 3);
+	zassert_equal(r, -ENOMEM, "Index should not fit");
+
+	r = coap_resource_index_init(&index, index_resources, nodes,
+				     ARRAY_SIZE(nodes));
+	zassert_equal(r, 0, "Could not build the index");
+
+	for (int i = 0; i < ARRAY_SIZE(uris); i++) {
+		r = coap_packet_init(&req, data, COAP_BUF_SIZE, COAP_VERSION_1,
+				     COAP_TYPE_CON, 0, NULL, COAP_METHOD_GET,
+				     coap_next_id());
+		zassert_equal(r, 0, "Unable to initialize request");
+
+		for (int j = 0; j < 3 && uris[i][j]; j++) {
+			r = coap_packet_append_option(&req,
+						      COAP_OPTION_URI_PATH,
+						      uris[i][j],
+						      strlen(uris[i][j]));
+			zassert_equal(r, 0, "Unable to append path");
+		}
+
+		r = coap_packet_parse(&req, data, req.offset, options,
+				      opt_num);
+		zassert_equal(r, 0, "Could not parse packet");
+
+		/* Same result as a scan of the resources */
+		index_matched = NULL;
+		r = coap_handle_request(&req, index_resources, options,
+					opt_num, (struct sockaddr *)&dummy_addr,
+					sizeof(dummy_addr));
+		expected = index_matched;
+
+		index_matched = NULL;
+		r_index = coap_handle_request_index(&req, &index, options,
+						    opt_num,
+						    (struct sockaddr *)&dummy_addr,
+						    sizeof(dummy_addr));
+		zassert_equal(r_index, r, "Result differs for request %d", i);
+		zassert_equal_ptr(index_matched, expected,
+				  "Resource differs for request %d", i);
+	}
+}
+
+#define DOWNLOAD_SIZE 200
+#define DOWNLOAD_WINDOW 3
+#define DOWNLOAD_MAX_REQUESTS 8
+
+struct download_request {
+	uint8_t data[COAP_BUF_SIZE];
+	uint16_t len;
+};
+
+static struct download_request download_requests[DOWNLOAD_MAX_REQUESTS];
+static int download_num_requests;
+static uint8_t download_data[DOWNLOAD_SIZE];
+static size_t download_received;
+static bool download_last;
+
+static int download_request_cb(struct coap_block_download *download,
+			       struct coap_block_context *block,
+			       const uint8_t *token, uint8_t tkl,
+			       void *user_data)
+{
+	struct download_request *req;
+	struct coap_packet cpkt;
+	int r;
+
+	zassert_true(download_num_requests < DOWNLOAD_MAX_REQUESTS,
+		     "Too many requests waiting");
+	req = &download_requests[download_num_requests++];
+
+	r = coap_packet_init(&cpkt, req->data, sizeof(req->data),
+			     COAP_VERSION_1, COAP_TYPE_CON, tkl, token,
+			     COAP_METHOD_GET, coap_next_id());
+	zassert_equal(r, 0, "Unable to initialize request");
+
+	r = coap_append_block2_option(&cpkt, block);
+	zassert_equal(r, 0, "Unable to append block2 option");
+
+	if (block->current == 0U) {
+		r = coap_append_option_int(&cpkt, COAP_OPTION_SIZE2, 0);
+		zassert_equal(r, 0, "Unable to append size2 option");
+	}
+
+	req->len = cpkt.offset;
+
+	return 0;
+}
+
+static int download_sink_cb(struct coap_block_download *download,
+			    size_t offset, const uint8_t *data, uint16_t len,
+			    bool last, void *user_data)
+{
+	zassert_equal(offset, download_received, "Data out of order");
+	zassert_true(offset + len <= DOWNLOAD_SIZE, "Data past the end");
+	zassert_false(download_last, "Data after the last one");
+
+	memcpy(download_data + offset, data, len);
+	download_received += len;
+	download_last = last;
+
+	return 0;
+}
+
+/* Answers a request with blocks of at most 32 bytes, like a constrained
+ * server would.
+ */
+static void download_respond(struct coap_block_download *download, int i)
+{
+	struct download_request *req = &download_requests[i];
+	struct coap_block_context block;
+	struct coap_packet cpkt;
+	struct coap_packet rsp;
+	uint8_t rsp_data[COAP_BUF_SIZE];
+	uint8_t token[8];
+	uint8_t tkl;
+	size_t offset;
+	uint16_t len;
+	int block2;
+	int r;
+
+	r = coap_packet_parse(&cpkt, req->data, req->len, NULL, 0);
+	zassert_equal(r, 0, "Could not parse request");
+
+	block2 = coap_get_option_int(&cpkt, COAP_OPTION_BLOCK2);
+	zassert_true(block2 >= 0, "No block2 option in request");
+
+	coap_block_transfer_init(&block, MIN(block2 & 0x07, COAP_BLOCK_32),
+				 DOWNLOAD_SIZE);
+	offset = (block2 >> 4) * coap_block_size_to_bytes(block2 & 0x07);
+	block.current = offset;
+
+	tkl = coap_header_get_token(&cpkt, token);
+	r = coap_packet_init(&rsp, rsp_data, sizeof(rsp_data),
+			     COAP_VERSION_1, COAP_TYPE_ACK, tkl, token,
+			     COAP_RESPONSE_CODE_CONTENT,
+			     coap_header_get_id(&cpkt));
+	zassert_equal(r, 0, "Unable to initialize response");
+
+	r = coap_append_block2_option(&rsp, &block);
+	zassert_equal(r, 0, "Unable to append block2 option");
+
+	if (offset == 0U) {
+		r = coap_append_size2_option(&rsp, &block);
+		zassert_equal(r, 0, "Unable to append size2 option");
+	}
+
+	r = coap_packet_append_payload_marker(&rsp);
+	zassert_equal(r, 0, "Unable to append payload marker");
+
+	len = MIN(coap_block_size_to_bytes(block.block_size),
+		  DOWNLOAD_SIZE - offset);
+	for (int j = 0; j < len; j++) {
+		uint8_t c = offset + j;
+
+		r = coap_packet_append_payload(&rsp, &c, 1);
+		zassert_equal(r, 0, "Unable to append payload");
+	}
+
+	/* The request is answered, remove it from the waiting ones */
+	memmove(req, req + 1,
+		(--download_num_requests - i) * sizeof(*req));
+
+	r = coap_packet_parse(&rsp, rsp_data, rsp.offset, NULL, 0);
+	zassert_equal(r, 0, "Could not parse response");
+
+	r = coap_block_download_response(download, &rsp);
+	zassert_equal(r, 0, "Could not handle response");
+}
+
+static void test_block_download(void)
+{
+	static uint8_t buf[DOWNLOAD_WINDOW * 64];
+	struct coap_block_download download;
+	struct coap_packet cpkt;
+	uint8_t token[8];
+	uint8_t tkl;
+	int r;
+
+	r = coap_block_download_init(&download, COAP_BLOCK_64,
+				     DOWNLOAD_WINDOW, buf, sizeof(buf),
+				     download_request_cb, download_sink_cb,
+				     NULL);
+	zassert_equal(r, 0, "Could not initialize download");
+
+	r = coap_block_download_start(&download);
+	zassert_equal(r, 0, "Could not start download");
+	zassert_equal(download_num_requests, 1,
+		      "Only the first block should be requested");
+
+	/* The size is known from the first block, the window opens */
+	download_respond(&download, 0);
+	zassert_equal(download_num_requests, DOWNLOAD_WINDOW,
+		      "Blocks should be requested in parallel");
+
+	/* A request can be sent again with another token */
+	r = coap_packet_parse(&cpkt, download_requests[0].data,
+			      download_requests[0].len, NULL, 0);
+	zassert_equal(r, 0, "Could not parse request");
+	tkl = coap_header_get_token(&cpkt, token);
+
+	r = coap_block_download_retry(&download, token, tkl);
+	zassert_equal(r, 0, "Could not retry request");
+	zassert_equal(coap_block_download_retry(&download, token, tkl),
+		      -ENOENT, "Old token should not match");
+	memmove(&download_requests[0], &download_requests[1],
+		--download_num_requests * sizeof(download_requests[0]));
+
+	/* Answer the newest request first, until the end */
+	while (download_num_requests) {
+		zassert_false(coap_block_download_is_done(&download),
+			      "Download done too early");
+		download_respond(&download, download_num_requests - 1);
+	}
+
+	zassert_true(coap_block_download_is_done(&download),
+		     "Download not done");
+	zassert_true(download_last, "Last data not flagged");
+	zassert_equal(download_received, DOWNLOAD_SIZE,
+		      "Invalid downloaded size");
+
+	for (int i = 0; i < DOWNLOAD_SIZE; i++) {
+		zassert_equal(download_data[i], (uint8_t)i,
+			      "Invalid data at %d", i);
+	}
+}
+
 static int resource_reply_cb(const struct coap_packet *response,
 			     struct coap_reply *reply,
 			     const struct sockaddr *from)
@@ -967,6 +1240,8 @@ void test_main(void)
 			 ztest_unit_test(test_block2_size),
 			 ztest_unit_test(test_retransmit_second_round),
 			 ztest_unit_test(test_observer_server),
+			 ztest_unit_test(test_resource_index),
+			 ztest_unit_test(test_block_download),
 			 ztest_unit_test(test_observer_client));
 
 	ztest_run_test_suite(coap_tests);
@@ -1236,6 +1236,150 @@ static void test_dns_flags_len(void)
 		      "DNS message length check failed (%d)", ret);
 }
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+/* Domain: www.zephyrproject.org
+ * Transaction ID: 0xb041
+ * Query type: A
+ * Reply code: the given one, without answers
+ */
+#define RESP_ERROR(rcode)						\
+	{ 0xb0, 0x41, 0x81, 0x80 | (rcode), 0x00, 0x01, 0x00, 0x00,	\
+	  0x00, 0x00, 0x00, 0x00, 0x03, 0x77, 0x77, 0x77,		\
+	  0x0d, 0x7a, 0x65, 0x70, 0x68, 0x79, 0x72, 0x70,		\
+	  0x72, 0x6f, 0x6a, 0x65, 0x63, 0x74, 0x03, 0x6f,		\
+	  0x72, 0x67, 0x00, 0x00, 0x01, 0x00, 0x01 }
+
+static uint8_t resp_name_error[] = RESP_ERROR(DNS_HEADER_NAMEERROR);
+static uint8_t resp_server_failure[] = RESP_ERROR(DNS_HEADER_SERVERFAILURE);
+
+static int cache_cb_count;
+static int cache_cb_status;
+static struct sockaddr cache_cb_addr;
+
+static void cache_cb(enum dns_resolve_status status,
+		     struct dns_addrinfo *info,
+		     void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if (status == DNS_EAI_INPROGRESS) {
+		memcpy(&cache_cb_addr, &info->ai_addr, sizeof(cache_cb_addr));
+		cache_cb_count++;
+	} else {
+		cache_cb_status = status;
+	}
+}
+
+/* Feed a response to the query of DNAME1 as if it came from the server */
+static void cache_response(uint8_t *buf, size_t len, int expected_ret)
+{
+	struct dns_msg_t dns_msg = { 0 };
+	uint16_t dns_id = dns_unpack_header_id(buf);
+	int query_idx = -1;
+	uint16_t query_hash = 0;
+	int ret;
+
+	dns_msg.msg = buf;
+	dns_msg.msg_size = len;
+
+	/* The hash covers the labels and the query type */
+	setup_dns_context(&dns_ctx, 0, dns_id, buf + DNS_HEADER_SIZE,
+			  strlen(DNAME1) + 2 + 2, DNS_QUERY_TYPE_A);
+	dns_ctx.queries[0].query = DNAME1;
+
+	ret = dns_validate_msg(&dns_ctx, &dns_msg, &dns_id, &query_idx,
+			       NULL, &query_hash);
+	zassert_equal(ret, expected_ret, "DNS message failed (%d)", ret);
+
+	dns_ctx.queries[0].cb = NULL;
+}
+
+/* Returns true if the query was answered from the cache */
+static bool cache_query(const char *name, enum dns_query_type type)
+{
+	uint32_t hits = dns_ctx.cache_hits;
+	uint16_t dns_id;
+	int ret;
+
+	cache_cb_count = 0;
+	cache_cb_status = 0;
+
+	ret = dns_resolve_name(&dns_ctx, name, type, &dns_id, cache_cb, NULL,
+			       100);
+	zassert_equal(ret, 0, "Cannot resolve %s (%d)", name, ret);
+
+	/* There are no servers, so missed queries stay pending */
+	dns_ctx.queries[0].cb = NULL;
+
+	if (dns_ctx.cache_hits == hits) {
+		zassert_equal(cache_cb_count, 0, "Callback called on miss");
+		return false;
+	}
+
+	zassert_equal(dns_id, 0, "Cached query got an id");
+
+	return true;
+}
+
+static void test_dns_cache(void)
+{
+	struct dns_resolve_context *ctx = &dns_ctx;
+	uint32_t misses;
+	int ret;
+
+	k_mutex_init(&dns_ctx.lock);
+
+	cache_response(resp_ipv4, sizeof(resp_ipv4), DNS_EAI_ALLDONE);
+
+	zassert_true(cache_query(DNAME1, DNS_QUERY_TYPE_A), "Cache miss");
+	zassert_equal(cache_cb_count, 1, "Wrong number of addresses");
+	zassert_equal(cache_cb_status, DNS_EAI_ALLDONE, "Wrong status");
+	zassert_mem_equal(&net_sin(&cache_cb_addr)->sin_addr, resp_ipv4_addr,
+			  sizeof(resp_ipv4_addr), "Wrong address");
+
+	/* The names are not case sensitive */
+	zassert_true(cache_query("WWW.ZephyrProject.org", DNS_QUERY_TYPE_A),
+		     "Cache miss with other case");
+
+	misses = dns_ctx.cache_misses;
+	zassert_false(cache_query(DNAME1, DNS_QUERY_TYPE_AAAA),
+		      "Cache hit with other type");
+	zassert_false(cache_query("zephyrproject.org", DNS_QUERY_TYPE_A),
+		      "Cache hit with other name");
+	zassert_equal(dns_ctx.cache_misses, misses + 2, "Misses not counted");
+
+	ret = net_mgmt(NET_REQUEST_DNS_CACHE_FLUSH, NULL, &ctx, 1);
+	zassert_equal(ret, -EINVAL, "Flush with bad length (%d)", ret);
+	zassert_true(cache_query(DNAME1, DNS_QUERY_TYPE_A),
+		     "Cache flushed by bad request");
+
+	ret = net_mgmt(NET_REQUEST_DNS_CACHE_FLUSH, NULL, ctx, sizeof(*ctx));
+	zassert_equal(ret, 0, "Cannot flush the cache (%d)", ret);
+	zassert_false(cache_query(DNAME1, DNS_QUERY_TYPE_A),
+		      "Cache hit after flush");
+
+	/* A non existent name is cached, but not a server failure */
+	cache_response(resp_name_error, sizeof(resp_name_error),
+		       DNS_EAI_NODATA);
+	zassert_true(cache_query(DNAME1, DNS_QUERY_TYPE_A),
+		     "Name error not cached");
+	zassert_equal(cache_cb_count, 0, "Name error has addresses");
+	zassert_equal(cache_cb_status, DNS_EAI_NODATA, "Wrong status");
+
+	dns_resolve_cache_flush(ctx);
+
+	cache_response(resp_server_failure, sizeof(resp_server_failure),
+		       DNS_EAI_FAIL);
+	zassert_false(cache_query(DNAME1, DNS_QUERY_TYPE_A),
+		      "Server failure cached");
+}
+#else
+static void test_dns_cache(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 void test_main(void)
 {
 	ztest_test_suite(dns_tests,
@@ -1247,7 +1391,8 @@ void test_main(void)
 			 ztest_unit_test(test_dns_id_len),
 			 ztest_unit_test(test_dns_flags_len),
 			 ztest_unit_test(test_dns_malformed_responses),
-			 ztest_unit_test(test_dns_valid_responses)
+			 ztest_unit_test(test_dns_valid_responses),
+			 ztest_unit_test(test_dns_cache)
 		);
 
 	ztest_run_test_suite(dns_tests);
@@ -0,0 +1,513 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <init.h>
+#include <ztest.h>
+
+#include "lwm2m_object.h"
+#include "lwm2m_engine.h"
+#include "lwm2m_rw_senml_cbor.h"
+#include "lwm2m_rw_senml_json.h"
+
+#define TEST_OBJ_ID		32769
+#define TEST_OBJ_INST_MAX	2
+
+#define TEST_RES_S32		0
+#define TEST_RES_STRING		1
+#define TEST_RES_BOOL		2
+#define TEST_RES_FLOAT64	3
+#define TEST_RES_OPAQUE		4
+#define TEST_RES_OBJLNK		5
+#define TEST_RES_S64		6
+#define TEST_RES_MULTI		7
+
+#define TEST_RES_COUNT		8
+#define TEST_MULTI_COUNT	2
+#define TEST_RES_INST_COUNT	(TEST_RES_COUNT - 1 + TEST_MULTI_COUNT)
+
+struct test_data {
+	int32_t s32;
+	char string[32];
+	bool b;
+	float64_value_t f64;
+	uint8_t opaque[16];
+	struct lwm2m_objlnk objlnk;
+	int64_t s64;
+	int32_t multi[TEST_MULTI_COUNT];
+};
+
+static struct test_data data[TEST_OBJ_INST_MAX];
+
+static struct lwm2m_engine_obj test_obj;
+static struct lwm2m_engine_obj_field fields[] = {
+	OBJ_FIELD_DATA(TEST_RES_S32, RW, S32),
+	OBJ_FIELD_DATA(TEST_RES_STRING, RW, STRING),
+	OBJ_FIELD_DATA(TEST_RES_BOOL, RW, BOOL),
+	OBJ_FIELD_DATA(TEST_RES_FLOAT64, RW, FLOAT64),
+	OBJ_FIELD_DATA(TEST_RES_OPAQUE, RW, OPAQUE),
+	OBJ_FIELD_DATA(TEST_RES_OBJLNK, RW, OBJLNK),
+	OBJ_FIELD_DATA(TEST_RES_S64, RW, S64),
+	OBJ_FIELD_DATA(TEST_RES_MULTI, RW, S32),
+};
+
+static struct lwm2m_engine_obj_inst inst[TEST_OBJ_INST_MAX];
+static struct lwm2m_engine_res res[TEST_OBJ_INST_MAX][TEST_RES_COUNT];
+static struct lwm2m_engine_res_inst
+	res_inst[TEST_OBJ_INST_MAX][TEST_RES_INST_COUNT];
+
+static struct lwm2m_ctx test_ctx;
+static struct lwm2m_message test_msg;
+static struct coap_packet test_in;
+static uint8_t test_in_buf[MAX_PACKET_SIZE];
+
+static struct lwm2m_engine_obj_inst *test_obj_create(uint16_t obj_inst_id)
+{
+	struct test_data *d;
+	int index, i = 0, j = 0;
+
+	for (index = 0; index < TEST_OBJ_INST_MAX; index++) {
+		if (inst[index].obj == NULL) {
+			break;
+		}
+	}
+
+	if (index == TEST_OBJ_INST_MAX) {
+		return NULL;
+	}
+
+	d = &data[index];
+	init_res_instance(res_inst[index], ARRAY_SIZE(res_inst[index]));
+
+	INIT_OBJ_RES_DATA(TEST_RES_S32, res[index], i, res_inst[index], j,
+			  &d->s32, sizeof(d->s32));
+	INIT_OBJ_RES_DATA(TEST_RES_STRING, res[index], i, res_inst[index], j,
+			  d->string, sizeof(d->string));
+	INIT_OBJ_RES_DATA(TEST_RES_BOOL, res[index], i, res_inst[index], j,
+			  &d->b, sizeof(d->b));
+	INIT_OBJ_RES_DATA(TEST_RES_FLOAT64, res[index], i, res_inst[index], j,
+			  &d->f64, sizeof(d->f64));
+	INIT_OBJ_RES_DATA(TEST_RES_OPAQUE, res[index], i, res_inst[index], j,
+			  d->opaque, sizeof(d->opaque));
+	INIT_OBJ_RES_DATA(TEST_RES_OBJLNK, res[index], i, res_inst[index], j,
+			  &d->objlnk, sizeof(d->objlnk));
+	INIT_OBJ_RES_DATA(TEST_RES_S64, res[index], i, res_inst[index], j,
+			  &d->s64, sizeof(d->s64));
+	INIT_OBJ_RES_MULTI_DATA(TEST_RES_MULTI, res[index], i,
+				res_inst[index], j, TEST_MULTI_COUNT, true,
+				d->multi, sizeof(d->multi[0]));
+
+	inst[index].resources = res[index];
+	inst[index].resource_count = i;
+
+	return &inst[index];
+}
+
+static int test_obj_init(const struct device *dev)
+{
+	struct lwm2m_engine_obj_inst *obj_inst;
+	int i, ret;
+
+	test_obj.obj_id = TEST_OBJ_ID;
+	test_obj.fields = fields;
+	test_obj.field_count = ARRAY_SIZE(fields);
+	test_obj.max_instance_count = TEST_OBJ_INST_MAX;
+	test_obj.create_cb = test_obj_create;
+	lwm2m_register_obj(&test_obj);
+
+	for (i = 0; i < TEST_OBJ_INST_MAX; i++) {
+		ret = lwm2m_create_obj_inst(TEST_OBJ_ID, i, &obj_inst);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+SYS_INIT(test_obj_init, APPLICATION, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+static const struct test_data test_values = {
+	.s32 = -100000,
+	.string = "Hello \"SenML\"\n",
+	.b = true,
+	.f64 = { .val1 = 3, .val2 = 500000000 },
+	.opaque = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+		    0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff },
+	.objlnk = { .obj_id = 5, .obj_inst = 1 },
+	.s64 = 5000000000LL,
+	.multi = { 7, -7 },
+};
+
+static void context_reset(const struct lwm2m_writer *writer,
+			  const struct lwm2m_reader *reader)
+{
+	int ret;
+
+	for (int i = 0; i < TEST_OBJ_INST_MAX; i++) {
+		data[i] = test_values;
+	}
+
+	/* tell the instances apart */
+	data[1].s32 = 42;
+	data[1].b = false;
+
+	(void)memset(&test_msg, 0, sizeof(test_msg));
+	test_msg.ctx = &test_ctx;
+
+	ret = coap_packet_init(&test_msg.cpkt, test_msg.msg_data,
+			       sizeof(test_msg.msg_data), COAP_VERSION_1,
+			       COAP_TYPE_ACK, 0, NULL,
+			       COAP_RESPONSE_CODE_CONTENT, 0);
+	zassert_equal(ret, 0, "cannot init the output packet");
+
+	test_msg.out.out_cpkt = &test_msg.cpkt;
+	test_msg.out.writer = writer;
+	test_msg.in.in_cpkt = &test_in;
+	test_msg.in.reader = reader;
+}
+
+/* Make payload the input of test_msg */
+static void set_input(const void *payload, uint16_t len)
+{
+	zassert_true(len <= sizeof(test_in_buf), "payload too long");
+
+	memcpy(test_in_buf, payload, len);
+	test_in.data = test_in_buf;
+	test_in.offset = len;
+	test_in.max_len = len;
+	test_msg.in.offset = 0U;
+}
+
+/* Feed what the writer produced back to the reader */
+static void output_to_input(void)
+{
+	const uint8_t *payload;
+	uint16_t len;
+
+	payload = coap_packet_get_payload(&test_msg.cpkt, &len);
+	zassert_not_null(payload, "no payload written");
+	set_input(payload, len);
+}
+
+static void set_path(struct lwm2m_obj_path *path, uint8_t level,
+		     uint16_t obj_inst_id, uint16_t res_id)
+{
+	(void)memset(path, 0, sizeof(*path));
+	path->obj_id = TEST_OBJ_ID;
+	path->obj_inst_id = obj_inst_id;
+	path->res_id = res_id;
+	path->level = level;
+}
+
+static void assert_test_values(const struct test_data *d)
+{
+	zassert_equal(d->s32, test_values.s32, "s32 %d", d->s32);
+	zassert_equal(strcmp(d->string, test_values.string), 0,
+		      "string \"%s\"", d->string);
+	zassert_equal(d->b, test_values.b, "bool");
+	zassert_equal(d->f64.val1, test_values.f64.val1, "float val1");
+	zassert_equal(d->f64.val2, test_values.f64.val2, "float val2");
+	zassert_mem_equal(d->opaque, test_values.opaque,
+			  sizeof(test_values.opaque), "opaque");
+	zassert_equal(d->objlnk.obj_id, test_values.objlnk.obj_id, "objlnk");
+	zassert_equal(d->objlnk.obj_inst, test_values.objlnk.obj_inst,
+		      "objlnk");
+	zassert_equal(d->s64, test_values.s64, "s64");
+	zassert_equal(d->multi[0], test_values.multi[0], "multi 0");
+	zassert_equal(d->multi[1], test_values.multi[1], "multi 1");
+}
+
+/* Read all of instance 0, wipe it, then write the payload back */
+static void round_trip(int format, const struct lwm2m_writer *writer,
+		       const struct lwm2m_reader *reader,
+		       int (*read_op)(struct lwm2m_message *, int),
+		       int (*write_op)(struct lwm2m_message *))
+{
+	int ret;
+
+	context_reset(writer, reader);
+	set_path(&test_msg.path, 2U, 0, 0);
+
+	ret = read_op(&test_msg, format);
+	zassert_equal(ret, 0, "read failed: %d", ret);
+
+	output_to_input();
+	(void)memset(&data[0], 0, sizeof(data[0]));
+
+	ret = write_op(&test_msg);
+	zassert_equal(ret, 0, "write failed: %d", ret);
+
+	assert_test_values(&data[0]);
+	zassert_equal(data[1].s32, 42, "other instance written");
+}
+
+/* Composite read of a resource of each instance, with paths which do
+ * not exist in between: they are skipped.
+ */
+static void composite_read(int format, const struct lwm2m_writer *writer,
+			   int (*composite_op)(struct lwm2m_message *, int,
+					       struct lwm2m_obj_path *,
+					       uint8_t),
+			   const void *expected, uint16_t expected_len)
+{
+	struct lwm2m_obj_path paths[4];
+	const uint8_t *payload;
+	uint16_t len;
+	int ret;
+
+	context_reset(writer, NULL);
+	set_path(&paths[0], 3U, 0, TEST_RES_S32);
+	set_path(&paths[1], 3U, 1, 99);
+	set_path(&paths[2], 2U, 7, 0);
+	set_path(&paths[3], 3U, 1, TEST_RES_BOOL);
+
+	ret = composite_op(&test_msg, format, paths, ARRAY_SIZE(paths));
+	zassert_equal(ret, 0, "composite read failed: %d", ret);
+
+	payload = coap_packet_get_payload(&test_msg.cpkt, &len);
+	zassert_equal(len, expected_len, "payload length %u", len);
+	zassert_mem_equal(payload, expected, len, "payload");
+
+	/* nothing to read at all */
+	context_reset(writer, NULL);
+	ret = composite_op(&test_msg, format, &paths[1], 2);
+	zassert_equal(ret, -ENOENT, "composite read of nothing: %d", ret);
+}
+
+static void test_senml_cbor_round_trip(void)
+{
+	round_trip(LWM2M_FORMAT_APP_SENML_CBOR, &senml_cbor_writer,
+		   &senml_cbor_reader, do_read_op_senml_cbor,
+		   do_write_op_senml_cbor);
+}
+
+static void test_senml_cbor_composite_read(void)
+{
+	static const uint8_t expected[] = {
+		0x9f,
+		/* {-2: "/32769/0/", 0: "0", 2: -100000} */
+		0xa3, 0x21, 0x69, '/', '3', '2', '7', '6', '9', '/', '0', '/',
+		0x00, 0x61, '0', 0x02, 0x3a, 0x00, 0x01, 0x86, 0x9f,
+		/* {-2: "/32769/1/", 0: "2", 4: false} */
+		0xa3, 0x21, 0x69, '/', '3', '2', '7', '6', '9', '/', '1', '/',
+		0x00, 0x61, '2', 0x04, 0xf4,
+		0xff,
+	};
+
+	composite_read(LWM2M_FORMAT_APP_SENML_CBOR, &senml_cbor_writer,
+		       do_composite_read_op_senml_cbor,
+		       expected, sizeof(expected));
+}
+
+static void test_senml_cbor_composite_paths(void)
+{
+	/* [{0: "/32769/0/0"}, {-2: "/32769/1/", 0: "7/1"}] */
+	static const uint8_t pack[] = {
+		0x82,
+		0xa1, 0x00, 0x6a, '/', '3', '2', '7', '6', '9', '/', '0', '/',
+		'0',
+		0xa2, 0x21, 0x69, '/', '3', '2', '7', '6', '9', '/', '1', '/',
+		0x00, 0x63, '7', '/', '1',
+	};
+	struct lwm2m_obj_path paths[2];
+	int ret;
+
+	context_reset(NULL, &senml_cbor_reader);
+	set_input(pack, sizeof(pack));
+
+	ret = senml_cbor_parse_paths(&test_msg, paths, ARRAY_SIZE(paths));
+	zassert_equal(ret, 2, "parse failed: %d", ret);
+	zassert_equal(paths[0].level, 3U, "");
+	zassert_equal(paths[0].obj_inst_id, 0U, "");
+	zassert_equal(paths[0].res_id, 0U, "");
+	zassert_equal(paths[1].level, 4U, "");
+	zassert_equal(paths[1].obj_inst_id, 1U, "");
+	zassert_equal(paths[1].res_id, 7U, "");
+	zassert_equal(paths[1].res_inst_id, 1U, "");
+
+	/* one path too many */
+	context_reset(NULL, &senml_cbor_reader);
+	set_input(pack, sizeof(pack));
+	ret = senml_cbor_parse_paths(&test_msg, paths, 1);
+	zassert_equal(ret, -EFBIG, "too many paths: %d", ret);
+}
+
+static void test_senml_cbor_malformed(void)
+{
+	static const struct {
+		const char *what;
+		uint8_t len;
+		uint8_t pack[16];
+	} tests[] = {
+		{ "empty pack", 0, { 0 } },
+		{ "pack is a map", 1, { 0xa0 } },
+		{ "no break", 1, { 0x9f } },
+		{ "missing record", 5, { 0x82, 0xa1, 0x00, 0x61, '0' } },
+		{ "count over the data", 9,
+		  { 0x9b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+		{ "record is an array", 2, { 0x81, 0x80 } },
+		{ "missing map entry", 5, { 0x81, 0xa2, 0x00, 0x61, '0' } },
+		{ "label is bytes", 4, { 0x81, 0xa1, 0x40, 0x00 } },
+		{ "name is a number", 4, { 0x81, 0xa1, 0x00, 0x01 } },
+		{ "name over the data", 5, { 0x81, 0xa1, 0x00, 0x65, '1' } },
+		{ "truncated length", 5, { 0x81, 0xa1, 0x00, 0x79, 0x00 } },
+		{ "reserved info", 4, { 0x81, 0xa1, 0x00, 0x7c } },
+		{ "name too long", 6,
+		  { 0x81, 0xa1, 0x00, 0x78, 0x20, '1' } },
+		{ "value over the data", 13,
+		  { 0x81, 0xa2, 0x00, 0x63, '/', '1', '/', 0x08, 0x5a,
+		    0x7f, 0xff, 0xff, 0xff } },
+		{ "value is an array", 9,
+		  { 0x81, 0xa2, 0x00, 0x63, '/', '1', '/', 0x02, 0x80 } },
+		{ "indefinite string", 9,
+		  { 0x81, 0xa2, 0x00, 0x63, '/', '1', '/', 0x03, 0x7f } },
+		{ "bad name", 7, { 0x81, 0xa1, 0x00, 0x63, '/', 'a', '/' } },
+		{ "empty name", 4, { 0x81, 0xa1, 0x00, 0x60 } },
+	};
+	struct lwm2m_obj_path paths[2];
+	int ret;
+
+	for (int i = 0; i < ARRAY_SIZE(tests); i++) {
+		context_reset(NULL, &senml_cbor_reader);
+		set_input(tests[i].pack, tests[i].len);
+
+		ret = senml_cbor_parse_paths(&test_msg, paths,
+					     ARRAY_SIZE(paths));
+		zassert_true(ret < 0, "%s: accepted (%d)", tests[i].what,
+			     ret);
+	}
+}
+
+static void test_senml_json_round_trip(void)
+{
+	round_trip(LWM2M_FORMAT_APP_SENML_JSON, &senml_json_writer,
+		   &senml_json_reader, do_read_op_senml_json,
+		   do_write_op_senml_json);
+}
+
+static void test_senml_json_composite_read(void)
+{
+	static const char expected[] =
+		"[{\"bn\":\"/32769/0/\",\"n\":\"0\",\"v\":-100000},"
+		"{\"bn\":\"/32769/1/\",\"n\":\"2\",\"vb\":false}]";
+
+	composite_read(LWM2M_FORMAT_APP_SENML_JSON, &senml_json_writer,
+		       do_composite_read_op_senml_json,
+		       expected, strlen(expected));
+}
+
+static int json_write(const char *pack)
+{
+	context_reset(NULL, &senml_json_reader);
+	set_input(pack, strlen(pack));
+
+	return do_write_op_senml_json(&test_msg);
+}
+
+static void test_senml_json_bad_names(void)
+{
+	static const char * const names[] = {
+		/* base name and name which are not paths */
+		"[{\"bn\":\"/32769/x/\",\"n\":\"0\",\"v\":1}]",
+		"[{\"bn\":\"/32769/0/\",\"n\":\"0 \",\"v\":1}]",
+		"[{\"bn\":\"32769.0\",\"n\":\"0\",\"v\":1}]",
+		"[{\"n\":\"\",\"v\":1}]",
+		/* IDs out of range, or too many of them */
+		"[{\"bn\":\"/70000/0/\",\"n\":\"0\",\"v\":1}]",
+		"[{\"bn\":\"/32769/0/\",\"n\":\"0/1/2\",\"v\":1}]",
+		/* too long for the name buffers */
+		"[{\"bn\":\"/32769/0/00000000000000000000/\",\"n\":\"0\","
+		"\"v\":1}]",
+		/* not strings */
+		"[{\"bn\":32769,\"n\":\"0\",\"v\":1}]",
+		"[{\"bn\":\"/32769/0/\",\"n\":0,\"v\":1}]",
+	};
+	static const char * const packs[] = {
+		"{\"n\":\"/32769/0/0\",\"v\":1}",
+		"[{\"n\":\"/32769/0/0\",\"v\":1}{\"n\":\"/32769/0/0\"}]",
+		"[{\"n\":\"/32769/0/0\" \"v\":1}]",
+		"[{\"n\" \"/32769/0/0\",\"v\":1}]",
+		"[{\"n\":\"/32769/0/0,\"v\":1}]",
+		"[{\"n\":\"/32769/0/0\",\"v\":1}",
+		"[{\"n\":\"/32769/0/0\",\"v\":",
+	};
+	int ret;
+
+	for (int i = 0; i < ARRAY_SIZE(names); i++) {
+		ret = json_write(names[i]);
+		zassert_true(ret < 0, "%s: accepted (%d)", names[i], ret);
+		zassert_equal(data[0].s32, test_values.s32, "%s: written",
+			      names[i]);
+	}
+
+	/* the records before the error may have been written */
+	for (int i = 0; i < ARRAY_SIZE(packs); i++) {
+		ret = json_write(packs[i]);
+		zassert_true(ret < 0, "%s: accepted (%d)", packs[i], ret);
+	}
+
+	/* writes to paths which do not exist */
+	ret = json_write("[{\"bn\":\"/32769/0/\",\"n\":\"99\",\"v\":1}]");
+	zassert_equal(ret, -ENOENT, "unknown resource: %d", ret);
+	ret = json_write("[{\"bn\":\"/32769/0/\",\"n\":\"7/5\",\"v\":1}]");
+	zassert_equal(ret, -ENOENT, "unknown resource instance: %d", ret);
+	ret = json_write("[{\"bn\":\"/32770/0/\",\"n\":\"0\",\"v\":1}]");
+	zassert_equal(ret, -ENOENT, "unknown object: %d", ret);
+}
+
+static void test_senml_json_numbers(void)
+{
+	static const char * const bad[] = {
+		"-", ".", "-.", "e5", "1e", "1e+", "12x", "1.2.3", "--1",
+		"0x10", "true", "\"12\"",
+	};
+	char pack[64];
+	int ret;
+
+	/* a value which is not a number leaves the resource alone */
+	for (int i = 0; i < ARRAY_SIZE(bad); i++) {
+		snprintk(pack, sizeof(pack),
+			 "[{\"n\":\"/32769/0/0\",\"v\":%s}]", bad[i]);
+		ret = json_write(pack);
+		zassert_equal(ret, 0, "%s: %d", bad[i], ret);
+		zassert_equal(data[0].s32, test_values.s32, "%s: read as %d",
+			      bad[i], data[0].s32);
+	}
+
+	ret = json_write("[{\"n\":\"/32769/0/0\",\"v\":1.5e2}]");
+	zassert_equal(ret, 0, "");
+	zassert_equal(data[0].s32, 150, "1.5e2 read as %d", data[0].s32);
+
+	ret = json_write("[{\"n\":\"/32769/0/0\",\"v\":-2500E-3}]");
+	zassert_equal(ret, 0, "");
+	zassert_equal(data[0].s32, -2, "-2500E-3 read as %d", data[0].s32);
+
+	ret = json_write("[{\"n\":\"/32769/0/3\",\"v\":-0.25}]");
+	zassert_equal(ret, 0, "");
+	zassert_equal(data[0].f64.val1, 0, "");
+	zassert_equal(data[0].f64.val2, -250000000, "-0.25 read as %lld",
+		      (long long)data[0].f64.val2);
+
+	ret = json_write("[{\"n\":\"/32769/0/6\",\"v\":-9000000000}]");
+	zassert_equal(ret, 0, "");
+	zassert_equal(data[0].s64, -9000000000LL, "");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(lwm2m_content_senml,
+			 ztest_unit_test(test_senml_cbor_round_trip),
+			 ztest_unit_test(test_senml_cbor_composite_read),
+			 ztest_unit_test(test_senml_cbor_composite_paths),
+			 ztest_unit_test(test_senml_cbor_malformed),
+			 ztest_unit_test(test_senml_json_round_trip),
+			 ztest_unit_test(test_senml_json_composite_read),
+			 ztest_unit_test(test_senml_json_bad_names),
+			 ztest_unit_test(test_senml_json_numbers));
+
+	ztest_run_test_suite(lwm2m_content_senml);
+}
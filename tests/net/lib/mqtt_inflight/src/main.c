@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <sys/byteorder.h>
+#include <ztest.h>
+
+#include <net/mqtt.h>
+#include <mqtt_internal.h>
+#include <mqtt_transport.h>
+
+#define INFLIGHT_MAX	CONFIG_MQTT_LIB_INFLIGHT_MAX
+#define BUFFER_SIZE	128
+
+/* the tests keep up to three messages in flight */
+BUILD_ASSERT(INFLIGHT_MAX >= 3);
+
+/* Fixed headers of the PUBLISH messages of the tests */
+#define PUBLISH_QOS_1		0x32
+#define PUBLISH_QOS_1_DUP	0x3a
+#define PUBLISH_QOS_2		0x34
+#define PUBLISH_QOS_2_DUP	0x3c
+
+/* PUBLISH of topic "t" and payload "x" */
+#define PUBLISH_LEN		8
+#define PUBREL_LEN		4
+
+static uint8_t rx_buffer[BUFFER_SIZE];
+static uint8_t tx_buffer[BUFFER_SIZE];
+static struct mqtt_client test_client;
+
+/* What the client sent, and what the broker sends to it */
+static uint8_t sent[2 * BUFFER_SIZE];
+static size_t sent_len;
+static uint8_t to_receive[BUFFER_SIZE];
+static size_t to_receive_len;
+static size_t received;
+
+static int pubrec_count;
+
+int mqtt_client_custom_transport_connect(struct mqtt_client *client)
+{
+	return 0;
+}
+
+int mqtt_client_custom_transport_write(struct mqtt_client *client,
+				       const uint8_t *data, uint32_t datalen)
+{
+	zassert_true(sent_len + datalen <= sizeof(sent), "too much sent");
+
+	memcpy(&sent[sent_len], data, datalen);
+	sent_len += datalen;
+
+	return 0;
+}
+
+int mqtt_client_custom_transport_write_msg(struct mqtt_client *client,
+					   const struct msghdr *message)
+{
+	for (size_t i = 0; i < message->msg_iovlen; i++) {
+		(void)mqtt_client_custom_transport_write(client,
+					message->msg_iov[i].iov_base,
+					message->msg_iov[i].iov_len);
+	}
+
+	return 0;
+}
+
+int mqtt_client_custom_transport_read(struct mqtt_client *client,
+				      uint8_t *data, uint32_t buflen,
+				      bool shall_block)
+{
+	uint32_t len = MIN(buflen, to_receive_len - received);
+
+	memcpy(data, &to_receive[received], len);
+	received += len;
+
+	return len;
+}
+
+int mqtt_client_custom_transport_disconnect(struct mqtt_client *client)
+{
+	return 0;
+}
+
+static void evt_handler(struct mqtt_client *const c,
+			const struct mqtt_evt *evt)
+{
+	struct mqtt_pubrel_param rel;
+
+	if (evt->type != MQTT_EVT_PUBREC) {
+		return;
+	}
+
+	rel.message_id = evt->param.pubrec.message_id;
+
+	pubrec_count++;
+
+	/* What applications written without the in-flight table do */
+	zassert_equal(mqtt_publish_qos2_release(c, &rel), 0,
+		      "release failed");
+}
+
+/* Have the client read one packet of the broker */
+static void receive(const uint8_t *packet, size_t len)
+{
+	memcpy(to_receive, packet, len);
+	to_receive_len = len;
+	received = 0;
+	sent_len = 0;
+
+	zassert_equal(mqtt_input(&test_client), 0, "input failed");
+	zassert_equal(received, len, "packet not read");
+}
+
+static void receive_ack(uint8_t type, uint16_t message_id)
+{
+	const uint8_t packet[] = {
+		type, 0x02, message_id >> 8, message_id & 0xff
+	};
+
+	receive(packet, sizeof(packet));
+}
+
+static void broker_connect(bool session_present)
+{
+	const uint8_t connack[] = {
+		MQTT_PKT_TYPE_CONNACK, 0x02, session_present ? 0x01 : 0x00,
+		MQTT_CONNECTION_ACCEPTED
+	};
+
+	zassert_equal(mqtt_connect(&test_client), 0, "connect failed");
+	receive(connack, sizeof(connack));
+	zassert_true(MQTT_HAS_STATE(&test_client, MQTT_STATE_CONNECTED),
+		     "not connected");
+}
+
+static void broker_reconnect(bool session_present)
+{
+	zassert_equal(mqtt_abort(&test_client), 0, "abort failed");
+	broker_connect(session_present);
+}
+
+static void client_setup(void)
+{
+	mqtt_client_init(&test_client);
+	test_client.client_id = MQTT_UTF8_LITERAL("zephyr");
+	test_client.transport.type = MQTT_TRANSPORT_CUSTOM;
+	test_client.evt_cb = evt_handler;
+	test_client.rx_buf = rx_buffer;
+	test_client.rx_buf_size = sizeof(rx_buffer);
+	test_client.tx_buf = tx_buffer;
+	test_client.tx_buf_size = sizeof(tx_buffer);
+
+	pubrec_count = 0;
+	broker_connect(false);
+}
+
+static int publish(uint8_t qos, uint16_t message_id)
+{
+	const struct mqtt_publish_param param = {
+		.message.topic.topic = MQTT_UTF8_LITERAL("t"),
+		.message.topic.qos = qos,
+		.message.payload.data = (uint8_t *)"x",
+		.message.payload.len = 1,
+		.message_id = message_id,
+	};
+
+	sent_len = 0;
+
+	return mqtt_publish(&test_client, &param);
+}
+
+/* Returns the message id of the PUBLISH sent at offset */
+static uint16_t sent_publish(size_t offset, uint8_t header)
+{
+	zassert_true(sent_len >= offset + PUBLISH_LEN, "PUBLISH not sent");
+	zassert_equal(sent[offset], header, "header 0x%02x", sent[offset]);
+
+	return sys_get_be16(&sent[offset + 5]);
+}
+
+static void assert_sent_pubrel(size_t offset, uint16_t message_id)
+{
+	const uint8_t pubrel[] = {
+		MQTT_PKT_TYPE_PUBREL | 0x02, 0x02,
+		message_id >> 8, message_id & 0xff
+	};
+
+	zassert_true(sent_len >= offset + PUBREL_LEN, "PUBREL not sent");
+	zassert_mem_equal(&sent[offset], pubrel, sizeof(pubrel),
+			  "PUBREL of 0x%04x expected", message_id);
+}
+
+static void test_message_id_allocation(void)
+{
+	client_setup();
+
+	zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 2), 0, "");
+	zassert_equal(sent_publish(0, PUBLISH_QOS_1), 2, "");
+
+	zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 0), 0, "");
+	zassert_equal(sent_publish(0, PUBLISH_QOS_1), 1, "");
+
+	/* an id in flight is neither given nor assigned twice */
+	zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 2), -EBUSY, "");
+	zassert_equal(sent_len, 0, "");
+
+	zassert_equal(publish(MQTT_QOS_2_EXACTLY_ONCE, 0), 0, "");
+	zassert_equal(sent_publish(0, PUBLISH_QOS_2), 3, "");
+
+	receive_ack(MQTT_PKT_TYPE_PUBACK, 2);
+	zassert_equal(sent_len, 0, "");
+
+	zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 0), 0, "");
+	zassert_equal(sent_publish(0, PUBLISH_QOS_1), 4, "");
+}
+
+static void test_inflight_full(void)
+{
+	client_setup();
+
+	for (int i = 0; i < INFLIGHT_MAX; i++) {
+		zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 0), 0, "");
+	}
+
+	zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 0), -EAGAIN, "");
+	zassert_equal(publish(MQTT_QOS_2_EXACTLY_ONCE, 0), -EAGAIN, "");
+	zassert_equal(sent_len, 0, "full table, but sent");
+
+	/* QoS 0 messages are not kept */
+	zassert_equal(publish(MQTT_QOS_0_AT_MOST_ONCE, 0), 0, "");
+
+	receive_ack(MQTT_PKT_TYPE_PUBACK, 1);
+	zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 0), 0, "");
+	zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 0), -EAGAIN, "");
+}
+
+static void test_qos2_release(void)
+{
+	client_setup();
+
+	for (int i = 0; i < INFLIGHT_MAX; i++) {
+		zassert_equal(publish(MQTT_QOS_2_EXACTLY_ONCE, 0), 0, "");
+	}
+
+	/* one PUBREL, although the application releases the message too */
+	receive_ack(MQTT_PKT_TYPE_PUBREC, 1);
+	zassert_equal(pubrec_count, 1, "PUBREC not notified");
+	assert_sent_pubrel(0, 1);
+	zassert_equal(sent_len, PUBREL_LEN, "PUBREL sent twice");
+
+	/* a released message is kept until PUBCOMP */
+	zassert_equal(publish(MQTT_QOS_2_EXACTLY_ONCE, 0), -EAGAIN, "");
+
+	receive_ack(MQTT_PKT_TYPE_PUBCOMP, 1);
+	zassert_equal(sent_len, 0, "");
+	zassert_equal(publish(MQTT_QOS_2_EXACTLY_ONCE, 0), 0, "");
+}
+
+/* Three messages in flight: a QoS 1 one, a QoS 2 one not received by the
+ * broker yet and a QoS 2 one released.
+ */
+static void publish_mix(void)
+{
+	client_setup();
+
+	zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 0), 0, "");
+	zassert_equal(publish(MQTT_QOS_2_EXACTLY_ONCE, 0), 0, "");
+	zassert_equal(publish(MQTT_QOS_2_EXACTLY_ONCE, 0), 0, "");
+
+	receive_ack(MQTT_PKT_TYPE_PUBREC, 3);
+	assert_sent_pubrel(0, 3);
+}
+
+static void test_resend_session_present(void)
+{
+	publish_mix();
+	broker_reconnect(true);
+
+	/* same messages, with DUP, and the PUBREL again */
+	zassert_equal(sent_publish(0, PUBLISH_QOS_1_DUP), 1, "");
+	zassert_equal(sent_publish(PUBLISH_LEN, PUBLISH_QOS_2_DUP), 2, "");
+	assert_sent_pubrel(2 * PUBLISH_LEN, 3);
+	zassert_equal(sent_len, 2 * PUBLISH_LEN + PUBREL_LEN, "");
+
+	receive_ack(MQTT_PKT_TYPE_PUBACK, 1);
+	receive_ack(MQTT_PKT_TYPE_PUBREC, 2);
+	assert_sent_pubrel(0, 2);
+	receive_ack(MQTT_PKT_TYPE_PUBCOMP, 2);
+	receive_ack(MQTT_PKT_TYPE_PUBCOMP, 3);
+
+	for (int i = 0; i < INFLIGHT_MAX; i++) {
+		zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 0), 0,
+			      "entry still in use");
+	}
+}
+
+static void test_resend_clean_session(void)
+{
+	publish_mix();
+	broker_reconnect(false);
+
+	/* new messages, and the released one is dropped */
+	zassert_equal(sent_publish(0, PUBLISH_QOS_1), 1, "");
+	zassert_equal(sent_publish(PUBLISH_LEN, PUBLISH_QOS_2), 2, "");
+	zassert_equal(sent_len, 2 * PUBLISH_LEN, "released message resent");
+
+	receive_ack(MQTT_PKT_TYPE_PUBCOMP, 3);
+	zassert_equal(sent_len, 0, "");
+
+	for (int i = 2; i < INFLIGHT_MAX; i++) {
+		zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 0), 0, "");
+	}
+
+	zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 0), -EAGAIN, "");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(mqtt_inflight,
+			 ztest_unit_test(test_message_id_allocation),
+			 ztest_unit_test(test_inflight_full),
+			 ztest_unit_test(test_qos2_release),
+			 ztest_unit_test(test_resend_session_present),
+			 ztest_unit_test(test_resend_clean_session));
+
+	ztest_run_test_suite(mqtt_inflight);
+}
@@ -16,6 +16,12 @@
 
 #include <ztest.h>
 
+#if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
+#define FRAG_SIZE CONFIG_NET_BUF_DATA_SIZE
+#else
+#define FRAG_SIZE CONFIG_NET_BUF_DATA_MIN_FRAG_SIZE
+#endif
+
 static uint8_t mac_addr[sizeof(struct net_eth_addr)];
 static struct net_if *eth_if;
 static uint8_t small_buffer[512];
@@ -914,11 +920,17 @@ void test_net_pkt_headroom_copy(void)
 
 static void test_net_pkt_get_contiguous_len(void)
 {
+	struct net_pkt *pkt;
 	size_t cont_len;
 	int res;
+
+	if (!IS_ENABLED(CONFIG_NET_BUF_FIXED_DATA_SIZE)) {
+		ztest_test_skip();
+		return;
+	}
+
 	/* Allocate pkt with 2 fragments */
-	struct net_pkt *pkt = net_pkt_rx_alloc_with_buffer(
-					   NULL, CONFIG_NET_BUF_DATA_SIZE * 2,
+	pkt = net_pkt_rx_alloc_with_buffer(NULL, FRAG_SIZE * 2,
 					   AF_UNSPEC, 0, K_NO_WAIT);
 
 	zassert_not_null(pkt, "Pkt not allocated");
@@ -926,7 +938,7 @@ static void test_net_pkt_get_contiguous_len(void)
 	net_pkt_cursor_init(pkt);
 
 	cont_len = net_pkt_get_contiguous_len(pkt);
-	zassert_equal(CONFIG_NET_BUF_DATA_SIZE, cont_len,
+	zassert_equal(FRAG_SIZE, cont_len,
 		      "Expected one complete available net_buf");
 
 	net_pkt_set_overwrite(pkt, false);
@@ -938,11 +950,11 @@ static void test_net_pkt_get_contiguous_len(void)
 	}
 
 	cont_len = net_pkt_get_contiguous_len(pkt);
-	zassert_equal(CONFIG_NET_BUF_DATA_SIZE - 3, cont_len,
+	zassert_equal(FRAG_SIZE - 3, cont_len,
 		      "Expected a three byte reduction");
 
 	/* Fill the first fragment up until only 3 bytes are free */
-	for (int i = 0; i < CONFIG_NET_BUF_DATA_SIZE - 6; ++i) {
+	for (int i = 0; i < FRAG_SIZE - 6; ++i) {
 		res = net_pkt_write_u8(pkt, 0xAA);
 		zassert_equal(0, res, "Write packet failed");
 	}
@@ -959,11 +971,11 @@ static void test_net_pkt_get_contiguous_len(void)
 	}
 
 	cont_len = net_pkt_get_contiguous_len(pkt);
-	zassert_equal(CONFIG_NET_BUF_DATA_SIZE, cont_len,
+	zassert_equal(FRAG_SIZE, cont_len,
 		      "Expected next full net_buf is available");
 
 	/* Fill the last fragment */
-	for (int i = 0; i < CONFIG_NET_BUF_DATA_SIZE; ++i) {
+	for (int i = 0; i < FRAG_SIZE; ++i) {
 		res = net_pkt_write_u8(pkt, 0xAA);
 		zassert_equal(0, res, "Write packet failed");
 	}
@@ -974,6 +986,83 @@ static void test_net_pkt_get_contiguous_len(void)
 	net_pkt_unref(pkt);
 }
 
+#if defined(CONFIG_NET_BUF_VARIABLE_DATA_SIZE)
+static size_t pkt_frag_count(struct net_pkt *pkt)
+{
+	size_t count = 0;
+
+	for (struct net_buf *buf = pkt->buffer; buf; buf = buf->frags) {
+		count++;
+	}
+
+	return count;
+}
+
+#define VAR_PKT_COUNT 8
+
+static void test_net_pkt_variable_alloc(void)
+{
+	struct net_pkt *pkts[VAR_PKT_COUNT] = { NULL };
+	struct net_pkt *pkt;
+	size_t len = CONFIG_NET_BUF_DATA_POOL_SIZE / VAR_PKT_COUNT - 32;
+
+	/* The data of a packet fits in one buffer of the right size */
+	pkt = net_pkt_rx_alloc_with_buffer(NULL, 1000, AF_UNSPEC, 0,
+					   K_NO_WAIT);
+	zassert_not_null(pkt, "Pkt not allocated");
+	zassert_equal(pkt_frag_count(pkt), 1, "Data in several buffers");
+	zassert_equal(net_pkt_available_buffer(pkt), 1000,
+		      "Buffer not of the right size");
+	net_pkt_unref(pkt);
+
+	/* Fill the pool, and free every other packet so that the free
+	 * memory is only found in blocks smaller than a packet of twice
+	 * the length.
+	 */
+	for (int i = 0; i < VAR_PKT_COUNT; i++) {
+		pkts[i] = net_pkt_rx_alloc_with_buffer(NULL, len, AF_UNSPEC, 0,
+						       K_NO_WAIT);
+		if (!pkts[i]) {
+			break;
+		}
+	}
+
+	zassert_not_null(pkts[3], "Pool too small for the test");
+
+	for (int i = 0; i < VAR_PKT_COUNT; i += 2) {
+		if (pkts[i]) {
+			net_pkt_unref(pkts[i]);
+			pkts[i] = NULL;
+		}
+	}
+
+	pkt = net_pkt_rx_alloc_with_buffer(NULL, 2 * len, AF_UNSPEC, 0,
+					   K_NO_WAIT);
+	zassert_not_null(pkt, "Pkt not allocated in a fragmented pool");
+	zassert_true(pkt_frag_count(pkt) > 1, "Data not split");
+	zassert_equal(net_pkt_available_buffer(pkt), 2 * len,
+		      "Split buffers not of the requested length");
+
+	for (struct net_buf *buf = pkt->buffer; buf; buf = buf->frags) {
+		zassert_true(buf->size >= CONFIG_NET_BUF_DATA_MIN_FRAG_SIZE ||
+			     !buf->frags, "Too small fragment");
+	}
+
+	net_pkt_unref(pkt);
+
+	for (int i = 0; i < VAR_PKT_COUNT; i++) {
+		if (pkts[i]) {
+			net_pkt_unref(pkts[i]);
+		}
+	}
+}
+#else
+static void test_net_pkt_variable_alloc(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_NET_BUF_VARIABLE_DATA_SIZE */
+
 void test_main(void)
 {
 	eth_if = net_if_get_default();
@@ -989,7 +1078,8 @@ void test_main(void)
 			 ztest_unit_test(test_net_pkt_clone),
 			 ztest_unit_test(test_net_pkt_headroom),
 			 ztest_unit_test(test_net_pkt_headroom_copy),
-			 ztest_unit_test(test_net_pkt_get_contiguous_len)
+			 ztest_unit_test(test_net_pkt_get_contiguous_len),
+			 ztest_unit_test(test_net_pkt_variable_alloc)
 		);
 
 	ztest_run_test_suite(net_pkt_tests);
@@ -473,6 +473,63 @@ static void test_route_del_many(void)
 	}
 }
 
+static struct net_route_entry *prefix_route_add(uint16_t w1, uint16_t w2,
+						 uint16_t w3, uint8_t len)
+{
+	struct net_route_entry *route;
+	struct in6_addr addr;
+
+	net_ipv6_addr_create(&addr, 0x2001, w1, w2, w3, 0, 0, 0, 0);
+	route = net_route_add(my_iface, &addr, len, &peer_addr);
+	zassert_not_null(route, "Route add failed");
+	zassert_equal(route->prefix_len, len, "Wrong route returned");
+
+	return route;
+}
+
+static void prefix_route_check(uint16_t w1, uint16_t w2, uint16_t w3,
+			       struct net_route_entry *expected)
+{
+	struct in6_addr addr;
+
+	net_ipv6_addr_create(&addr, 0x2001, w1, w2, w3, 0, 0, 0, 0x5);
+	zassert_equal_ptr(net_route_lookup(NULL, &addr), expected,
+			  "Wrong route for 2001:%x:%x:%x::5", w1, w2, w3);
+}
+
+static void test_route_lookup_longest_prefix(void)
+{
+	struct net_route_entry *r64, *r48, *r48b, *r32;
+
+	/* Most specific first, and from addresses outside of the routes
+	 * already there, as adding a route to a destination that already
+	 * has one with the same nexthop just returns that one
+	 */
+	r64 = prefix_route_add(0xdb8, 1, 0, 64);
+	r48 = prefix_route_add(0xdb8, 1, 0xffff, 48);
+	r48b = prefix_route_add(0xdb8, 2, 0, 48);
+	r32 = prefix_route_add(0xdb8, 0xffff, 0, 32);
+
+	prefix_route_check(0xdb8, 1, 0, r64);
+	prefix_route_check(0xdb8, 1, 1, r48);
+	prefix_route_check(0xdb8, 2, 5, r48b);
+	prefix_route_check(0xdb8, 3, 0, r32);
+	prefix_route_check(0xdb9, 0, 0, NULL);
+
+	zassert_false(net_route_del(r48), "Route del failed");
+	prefix_route_check(0xdb8, 1, 1, r32);
+	prefix_route_check(0xdb8, 1, 0, r64);
+
+	zassert_false(net_route_del(r32), "Route del failed");
+	prefix_route_check(0xdb8, 3, 0, NULL);
+	prefix_route_check(0xdb8, 2, 5, r48b);
+
+	zassert_false(net_route_del(r64), "Route del failed");
+	zassert_false(net_route_del(r48b), "Route del failed");
+	prefix_route_check(0xdb8, 1, 0, NULL);
+	prefix_route_check(0xdb8, 2, 5, NULL);
+}
+
 /*test case main entry*/
 void test_main(void)
 {
@@ -492,6 +549,8 @@ void test_main(void)
 			ztest_unit_test(test_route_del_nexthop_again),
 			ztest_unit_test(test_populate_nbr_cache),
 			ztest_unit_test(test_route_add_many),
-			ztest_unit_test(test_route_del_many));
+			ztest_unit_test(test_route_del_many),
+			ztest_unit_test(test_populate_nbr_cache),
+			ztest_unit_test(test_route_lookup_longest_prefix));
 	ztest_run_test_suite(test_route);
 }
@@ -0,0 +1,310 @@
+/* main.c - Application main entry point */
+
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define NET_LOG_LEVEL CONFIG_NET_TC_LOG_LEVEL
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, NET_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/printk.h>
+
+#include <ztest.h>
+
+#include <net/ethernet.h>
+#include <net/buf.h>
+#include <net/net_ip.h>
+#include <net/net_l2.h>
+#include <net/udp.h>
+
+#define NET_LOG_ENABLED 1
+#include "net_private.h"
+
+#define TEST_PORT 4242
+#define FLOWS 16
+#define PKTS_PER_FLOW 4
+
+#define WAIT_TIME K_SECONDS(1)
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+static uint8_t peer_mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x02 };
+
+static struct net_if *iface;
+static struct net_context *udp_ctx;
+
+/* Per flow, the next sequence number expected and the thread that
+ * processed it
+ */
+static uint32_t next_seq[FLOWS];
+static k_tid_t flow_thread[FLOWS];
+static bool test_failed;
+
+static K_SEM_DEFINE(wait_data, 0, UINT_MAX);
+
+struct eth_context {
+	uint8_t mac_addr[6];
+};
+
+static struct eth_context eth_context;
+
+static void eth_iface_init(struct net_if *iface)
+{
+	const struct device *dev = net_if_get_device(iface);
+	struct eth_context *context = dev->data;
+
+	net_if_set_link_addr(iface, context->mac_addr,
+			     sizeof(context->mac_addr),
+			     NET_LINK_ETHERNET);
+
+	ethernet_init(iface);
+}
+
+static int eth_tx(const struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static enum ethernet_hw_caps eth_caps(const struct device *dev)
+{
+	/* So that the test packets do not need checksums */
+	return ETHERNET_HW_RX_CHKSUM_OFFLOAD;
+}
+
+static struct ethernet_api api_funcs = {
+	.iface_api.init = eth_iface_init,
+
+	.get_capabilities = eth_caps,
+	.send = eth_tx,
+};
+
+static int eth_init(const struct device *dev)
+{
+	struct eth_context *context = dev->data;
+
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	context->mac_addr[0] = 0x00;
+	context->mac_addr[1] = 0x00;
+	context->mac_addr[2] = 0x5E;
+	context->mac_addr[3] = 0x00;
+	context->mac_addr[4] = 0x53;
+	context->mac_addr[5] = 0x01;
+
+	return 0;
+}
+
+ETH_NET_DEVICE_INIT(eth_rx_flow_test, "eth_rx_flow_test",
+		    eth_init, NULL, &eth_context, NULL,
+		    CONFIG_ETH_INIT_PRIORITY, &api_funcs, NET_ETH_MTU);
+
+/* An IPv4 UDP datagram from the peer, carrying a sequence number. The
+ * fragment field is set as is, and the ports follow the IPv4 header even
+ * in a fragment, to see that they are not hashed then.
+ */
+static struct net_pkt *make_pkt(uint16_t src_port, uint32_t seq,
+				uint16_t frag)
+{
+	struct net_eth_hdr eth = {
+		.type = htons(NET_ETH_PTYPE_IP),
+	};
+	struct net_ipv4_hdr ip = {
+		.vhl = 0x45,
+		.len = htons(sizeof(struct net_ipv4_hdr) +
+			     sizeof(struct net_udp_hdr) + sizeof(seq)),
+		.ttl = 64,
+		.proto = IPPROTO_UDP,
+	};
+	struct net_udp_hdr udp = {
+		.src_port = htons(src_port),
+		.dst_port = htons(TEST_PORT),
+		.len = htons(sizeof(struct net_udp_hdr) + sizeof(seq)),
+	};
+	struct net_pkt *pkt;
+
+	memcpy(eth.dst.addr, eth_context.mac_addr, sizeof(eth.dst.addr));
+	memcpy(eth.src.addr, peer_mac, sizeof(eth.src.addr));
+	sys_put_be16(frag, ip.offset);
+	net_ipaddr_copy(&ip.src, &peer_addr);
+	net_ipaddr_copy(&ip.dst, &my_addr);
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, sizeof(eth) + sizeof(ip) +
+					   sizeof(udp) + sizeof(seq),
+					   AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+
+	zassert_ok(net_pkt_write(pkt, &eth, sizeof(eth)), "eth header");
+	zassert_ok(net_pkt_write(pkt, &ip, sizeof(ip)), "IPv4 header");
+	zassert_ok(net_pkt_write(pkt, &udp, sizeof(udp)), "UDP header");
+	zassert_ok(net_pkt_write_be32(pkt, seq), "data");
+
+	net_pkt_set_iface(pkt, iface);
+
+	return pkt;
+}
+
+static void test_setup(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(TEST_PORT),
+	};
+	struct net_if_addr *ifaddr;
+	int ret;
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(ETHERNET));
+	zassert_not_null(iface, "No Ethernet interface");
+
+	ifaddr = net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "Cannot add IPv4 address");
+
+	net_if_up(iface);
+
+	ret = net_context_get(AF_INET, SOCK_DGRAM, IPPROTO_UDP, &udp_ctx);
+	zassert_equal(ret, 0, "Create IPv4 UDP context failed");
+
+	net_ipaddr_copy(&addr.sin_addr, &my_addr);
+
+	ret = net_context_bind(udp_ctx, (struct sockaddr *)&addr,
+			       sizeof(addr));
+	zassert_equal(ret, 0, "Context bind failed");
+}
+
+static void test_flow_hash(void)
+{
+	uint32_t hash[FLOWS];
+	struct net_pkt *pkt;
+	bool spread = false;
+
+	for (int i = 0; i < FLOWS; i++) {
+		pkt = make_pkt(1000 + i, 0, 0);
+		hash[i] = net_tc_rx_flow_hash(pkt);
+		net_pkt_unref(pkt);
+
+		/* Other packets of the flow go the same way */
+		pkt = make_pkt(1000 + i, 1, 0);
+		zassert_equal(net_tc_rx_flow_hash(pkt), hash[i],
+			      "Flow %d hashed differently", i);
+		net_pkt_unref(pkt);
+
+		if (hash[i] != hash[0]) {
+			spread = true;
+		}
+	}
+
+	zassert_true(spread, "The ports are not hashed");
+
+	/* Fragments only hash the addresses and protocol, whatever comes
+	 * after the IPv4 header
+	 */
+	pkt = make_pkt(1000, 0, 0x2000);
+	hash[0] = net_tc_rx_flow_hash(pkt);
+	net_pkt_unref(pkt);
+
+	pkt = make_pkt(2000, 0, 0x0010);
+	zassert_equal(net_tc_rx_flow_hash(pkt), hash[0],
+		      "Fragments hashed differently");
+	net_pkt_unref(pkt);
+
+	/* The hash of the driver is used as is */
+	pkt = make_pkt(1000, 0, 0);
+	net_pkt_set_rx_hash(pkt, 0x12345678);
+	zassert_equal(net_tc_rx_flow_hash(pkt), 0x12345678,
+		      "Driver hash is not used");
+	net_pkt_unref(pkt);
+}
+
+static void recv_cb(struct net_context *context,
+		    struct net_pkt *pkt,
+		    union net_ip_header *ip_hdr,
+		    union net_proto_header *proto_hdr,
+		    int status,
+		    void *user_data)
+{
+	int flow = ntohs(proto_hdr->udp->src_port) - 1000;
+	uint32_t seq;
+
+	if (flow < 0 || flow >= FLOWS || net_pkt_read_be32(pkt, &seq)) {
+		test_failed = true;
+		goto out;
+	}
+
+	if (seq != next_seq[flow] ||
+	    (flow_thread[flow] && flow_thread[flow] != k_current_get())) {
+		test_failed = true;
+	}
+
+	next_seq[flow] = seq + 1;
+	flow_thread[flow] = k_current_get();
+
+out:
+	net_pkt_unref(pkt);
+	k_sem_give(&wait_data);
+}
+
+static void test_flow_order(void)
+{
+	int threads = 0;
+	int ret;
+
+	ret = net_context_recv(udp_ctx, recv_cb, K_NO_WAIT, NULL);
+	zassert_equal(ret, 0, "Context recv setup failed (%d)", ret);
+
+	/* Interleave the flows so that processing them in parallel could
+	 * reorder them
+	 */
+	for (int seq = 0; seq < PKTS_PER_FLOW; seq++) {
+		for (int i = 0; i < FLOWS; i++) {
+			ret = net_recv_data(iface, make_pkt(1000 + i, seq, 0));
+			zassert_equal(ret, 0, "Cannot receive packet (%d)",
+				      ret);
+		}
+	}
+
+	for (int i = 0; i < FLOWS * PKTS_PER_FLOW; i++) {
+		zassert_ok(k_sem_take(&wait_data, WAIT_TIME),
+			   "Timeout after %d packets", i);
+	}
+
+	zassert_false(test_failed, "Flow reordered or moved between threads");
+
+	for (int i = 0; i < FLOWS; i++) {
+		bool seen = false;
+
+		zassert_equal(next_seq[i], PKTS_PER_FLOW,
+			      "Flow %d incomplete", i);
+
+		for (int j = 0; j < i; j++) {
+			if (flow_thread[j] == flow_thread[i]) {
+				seen = true;
+			}
+		}
+
+		if (!seen) {
+			threads++;
+		}
+	}
+
+	zassert_true(threads > 1, "All flows processed by one thread");
+
+	net_context_put(udp_ctx);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_rx_flow_test,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_flow_hash),
+			 ztest_unit_test(test_flow_order));
+
+	ztest_run_test_suite(net_rx_flow_test);
+}
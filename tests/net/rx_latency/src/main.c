@@ -0,0 +1,242 @@
+/* main.c - Application main entry point */
+
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_STATISTICS_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/printk.h>
+
+#include <ztest.h>
+
+#include <net/dummy.h>
+#include <net/buf.h>
+#include <net/net_ip.h>
+#include <net/net_if.h>
+#include <net/net_mgmt.h>
+#include <net/net_stats.h>
+#include <net/socket.h>
+
+#define NET_LOG_ENABLED 1
+#include "net_private.h"
+
+#include "ipv4.h"
+#include "udp_internal.h"
+
+#define TEST_PORT 4242
+#define PEER_PORT 4241
+#define PKT_COUNT 4
+
+#define WAIT_TIME K_MSEC(100)
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+static uint8_t mac_addr[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+static struct net_if *iface;
+static int sock;
+
+static int net_iface_dev_init(const struct device *dev)
+{
+	return 0;
+}
+
+static void net_iface_init(struct net_if *iface)
+{
+	net_if_set_link_addr(iface, mac_addr, sizeof(mac_addr),
+			     NET_LINK_ETHERNET);
+}
+
+static int tester_send(const struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static struct dummy_api net_iface_api = {
+	.iface_api.init = net_iface_init,
+	.send = tester_send,
+};
+
+NET_DEVICE_INIT(net_rx_latency_test, "net_rx_latency_test",
+		net_iface_dev_init, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &net_iface_api,
+		DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+/* Receive an UDP datagram from the peer, as a driver would */
+static void recv_datagram(uint16_t dst_port)
+{
+	static const uint8_t data[] = "latency";
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, NET_UDPH_LEN + sizeof(data),
+					   AF_INET, IPPROTO_UDP, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+
+	zassert_ok(net_ipv4_create(pkt, &peer_addr, &my_addr), "IPv4 header");
+	zassert_ok(net_udp_create(pkt, htons(PEER_PORT), htons(dst_port)),
+		   "UDP header");
+	zassert_ok(net_pkt_write(pkt, data, sizeof(data)), "data");
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_ipv4_finalize(pkt, IPPROTO_UDP), "finalize");
+
+	zassert_ok(net_recv_data(iface, pkt), "Cannot receive packet");
+}
+
+static void read_datagram(int flags)
+{
+	struct pollfd fds = {
+		.fd = sock,
+		.events = POLLIN,
+	};
+	uint8_t buf[16];
+	int ret;
+
+	ret = poll(&fds, 1, k_ticks_to_ms_floor32(WAIT_TIME.ticks));
+	zassert_equal(ret, 1, "No data (%d)", errno);
+
+	ret = recv(sock, buf, sizeof(buf), flags);
+	zassert_true(ret > 0, "recv failed (%d)", errno);
+}
+
+static void get_latency(struct net_stats_rx_latency *lat)
+{
+	int ret;
+
+	ret = net_mgmt(NET_REQUEST_STATS_GET_RX_LATENCY, iface, lat,
+		       sizeof(struct net_stats_rx_latency) *
+		       NET_STATS_RX_STAGE_COUNT);
+	zassert_equal(ret, 0, "Cannot get RX latency (%d)", ret);
+}
+
+static net_stats_t stage_count(struct net_stats_rx_latency *lat,
+			       enum net_stats_rx_stage stage)
+{
+	net_stats_t count = 0;
+
+	for (int i = 0; i < NET_STATS_RX_LATENCY_BUCKETS; i++) {
+		count += lat[stage].hist[i];
+	}
+
+	return count;
+}
+
+static void test_setup(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(TEST_PORT),
+	};
+	struct net_if_addr *ifaddr;
+	int ret;
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(iface, "No test interface");
+
+	ifaddr = net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "Cannot add IPv4 address");
+
+	sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(sock >= 0, "Cannot create socket (%d)", errno);
+
+	net_ipaddr_copy(&addr.sin_addr, &my_addr);
+
+	ret = bind(sock, (struct sockaddr *)&addr, sizeof(addr));
+	zassert_equal(ret, 0, "bind failed (%d)", errno);
+}
+
+static void test_all_stages(void)
+{
+	struct net_stats_rx_latency before[NET_STATS_RX_STAGE_COUNT];
+	struct net_stats_rx_latency after[NET_STATS_RX_STAGE_COUNT];
+
+	get_latency(before);
+
+	for (int i = 0; i < PKT_COUNT; i++) {
+		recv_datagram(TEST_PORT);
+		read_datagram(0);
+	}
+
+	get_latency(after);
+
+	for (int i = 0; i < NET_STATS_RX_STAGE_COUNT; i++) {
+		zassert_equal(stage_count(after, i),
+			      stage_count(before, i) + PKT_COUNT,
+			      "Stage %d not collected", i);
+	}
+}
+
+static void test_socket_stage(void)
+{
+	struct net_stats_rx_latency before[NET_STATS_RX_STAGE_COUNT];
+	struct net_stats_rx_latency after[NET_STATS_RX_STAGE_COUNT];
+	int last = NET_STATS_RX_LATENCY_BUCKETS - 1;
+
+	get_latency(before);
+
+	/* The datagram waits in the socket longer than the last bucket
+	 * starts, and peeking at it does not count as reading it.
+	 */
+	recv_datagram(TEST_PORT);
+	k_sleep(K_MSEC(10));
+
+	read_datagram(MSG_PEEK);
+	read_datagram(0);
+
+	get_latency(after);
+
+	zassert_equal(stage_count(after, NET_STATS_RX_STAGE_SOCKET),
+		      stage_count(before, NET_STATS_RX_STAGE_SOCKET) + 1,
+		      "Socket stage collected more than once");
+	zassert_equal(after[NET_STATS_RX_STAGE_SOCKET].hist[last],
+		      before[NET_STATS_RX_STAGE_SOCKET].hist[last] + 1,
+		      "Socket wait not in the last bucket");
+}
+
+static void test_not_delivered(void)
+{
+	struct net_stats_rx_latency before[NET_STATS_RX_STAGE_COUNT];
+	struct net_stats_rx_latency after[NET_STATS_RX_STAGE_COUNT];
+
+	get_latency(before);
+
+	/* Nobody listens to the port, the packet stops after IP */
+	recv_datagram(TEST_PORT + 1);
+	k_sleep(K_MSEC(50));
+
+	get_latency(after);
+
+	for (int i = 0; i <= NET_STATS_RX_STAGE_IP; i++) {
+		zassert_equal(stage_count(after, i), stage_count(before, i) + 1,
+			      "Stage %d not collected", i);
+	}
+
+	for (int i = NET_STATS_RX_STAGE_TRANSPORT;
+	     i < NET_STATS_RX_STAGE_COUNT; i++) {
+		zassert_equal(stage_count(after, i), stage_count(before, i),
+			      "Stage %d collected", i);
+	}
+
+	close(sock);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_rx_latency_test,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_all_stages),
+			 ztest_unit_test(test_socket_stage),
+			 ztest_unit_test(test_not_delivered));
+
+	ztest_run_test_suite(net_rx_latency_test);
+}
@@ -370,11 +370,181 @@ static void test_packet_sockets_dgram(void)
 	close(sock2);
 }
 
+#define RING_FRAME_SIZE 256
+#define RING_FRAMES 2
+
+#if defined(CONFIG_NET_SOCKETS_PACKET_RING)
+static uint8_t rx_ring[RING_FRAME_SIZE * RING_FRAMES]
+	__aligned(TPACKET_ALIGNMENT);
+static uint8_t tx_ring[RING_FRAME_SIZE * RING_FRAMES]
+	__aligned(TPACKET_ALIGNMENT);
+
+static struct tpacket_hdr *ring_frame(uint8_t *ring, int i)
+{
+	return (struct tpacket_hdr *)&ring[i * RING_FRAME_SIZE];
+}
+
+static uint32_t frame_status(struct tpacket_hdr *hdr)
+{
+	return __atomic_load_n(&hdr->tp_status, __ATOMIC_ACQUIRE);
+}
+
+static void frame_set_status(struct tpacket_hdr *hdr, uint32_t status)
+{
+	__atomic_store_n(&hdr->tp_status, status, __ATOMIC_RELEASE);
+}
+
+/* Queue a packet in the TX ring, its first byte is the sequence number */
+static void queue_frame(int i, uint8_t seq)
+{
+	uint8_t data_to_send[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+	struct tpacket_hdr *hdr = ring_frame(tx_ring, i);
+
+	zassert_equal(frame_status(hdr), TP_STATUS_AVAILABLE,
+		      "TX frame %d not available", i);
+
+	data_to_send[0] = seq;
+	memcpy((uint8_t *)hdr + TPACKET_HDRLEN - sizeof(struct sockaddr_ll),
+	       data_to_send, sizeof(data_to_send));
+	hdr->tp_len = sizeof(data_to_send);
+
+	frame_set_status(hdr, TP_STATUS_SEND_REQUEST);
+}
+
+/* Check the packet in a RX frame, and give the frame back */
+static void check_frame(int i, uint8_t seq, struct net_if *iface)
+{
+	struct tpacket_hdr *hdr = ring_frame(rx_ring, i);
+	struct sockaddr_ll *ll = (struct sockaddr_ll *)
+		((uint8_t *)hdr + TPACKET_ALIGN(sizeof(*hdr)));
+	uint8_t *data = (uint8_t *)hdr + hdr->tp_mac;
+
+	zassert_true(frame_status(hdr) & TP_STATUS_USER,
+		     "Nothing in RX frame %d", i);
+	zassert_equal(hdr->tp_snaplen, hdr->tp_len, "Packet truncated");
+	zassert_true(hdr->tp_len > 10, "Packet too short (%d)", hdr->tp_len);
+	zassert_equal(data[hdr->tp_len - 10], seq, "Wrong packet in frame %d",
+		      i);
+	zassert_equal(ll->sll_family, AF_PACKET, "Wrong family");
+	zassert_equal(ll->sll_ifindex, net_if_get_by_iface(iface),
+		      "Wrong interface");
+
+	frame_set_status(hdr, TP_STATUS_KERNEL);
+}
+
+static void test_packet_sockets_ring(void)
+{
+	struct tpacket_req req = {
+		.tp_frame_size = RING_FRAME_SIZE,
+		.tp_frame_nr = RING_FRAMES,
+	};
+	struct user_data ud = { 0 };
+	struct tpacket_stats stats;
+	struct pollfd pfd;
+	socklen_t optlen;
+	int ret, sock1, sock2;
+
+	net_if_foreach(iface_cb, &ud);
+
+	zassert_not_null(ud.first, "1st Ethernet interface not found");
+
+	/* Capture with the RX ring what goes through the TX ring */
+	sock1 = setup_socket(ud.first, SOCK_RAW, ETH_P_ALL);
+	sock2 = setup_socket(ud.first, SOCK_DGRAM, ETH_P_TSN);
+
+	ret = bind_socket(sock1, ud.first);
+	zassert_equal(ret, 0, "Cannot bind 1st socket (%d)", -errno);
+
+	ret = bind_socket(sock2, ud.first);
+	zassert_equal(ret, 0, "Cannot bind 2nd socket (%d)", -errno);
+
+	req.tp_ring = rx_ring;
+	ret = setsockopt(sock1, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req));
+	zassert_equal(ret, 0, "Cannot set up RX ring (%d)", -errno);
+
+	ret = setsockopt(sock1, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req));
+	zassert_equal(ret, -1, "RX ring set up twice");
+	zassert_equal(errno, EBUSY, "Wrong errno (%d)", errno);
+
+	req.tp_ring = tx_ring;
+	ret = setsockopt(sock2, SOL_PACKET, PACKET_TX_RING, &req, sizeof(req));
+	zassert_equal(ret, 0, "Cannot set up TX ring (%d)", -errno);
+
+	/* One call sends all the frames queued */
+	queue_frame(0, 0);
+	queue_frame(1, 1);
+
+	ret = send(sock2, NULL, 0, 0);
+	zassert_equal(ret, 20, "Cannot send the ring (%d)", -errno);
+	zassert_equal(frame_status(ring_frame(tx_ring, 0)),
+		      TP_STATUS_AVAILABLE, "1st frame not sent");
+	zassert_equal(frame_status(ring_frame(tx_ring, 1)),
+		      TP_STATUS_AVAILABLE, "2nd frame not sent");
+
+	pfd.fd = sock1;
+	pfd.events = POLLIN;
+
+	ret = poll(&pfd, 1, 100);
+	zassert_equal(ret, 1, "RX ring not readable (%d)", ret);
+
+	/* Both packets have to be there before the ring is full */
+	k_msleep(50);
+
+	/* The ring is full, the next packet is dropped */
+	queue_frame(0, 2);
+
+	ret = send(sock2, NULL, 0, 0);
+	zassert_equal(ret, 10, "Cannot send the ring (%d)", -errno);
+
+	k_msleep(50);
+
+	check_frame(0, 0, ud.first);
+	check_frame(1, 1, ud.first);
+
+	ret = poll(&pfd, 1, 0);
+	zassert_equal(ret, 0, "RX ring readable when empty");
+
+	queue_frame(1, 3);
+
+	ret = send(sock2, NULL, 0, 0);
+	zassert_equal(ret, 10, "Cannot send the ring (%d)", -errno);
+
+	ret = poll(&pfd, 1, 100);
+	zassert_equal(ret, 1, "RX ring not readable (%d)", ret);
+
+	zassert_true(frame_status(ring_frame(rx_ring, 0)) & TP_STATUS_LOSING,
+		     "Drop not reported");
+	check_frame(0, 3, ud.first);
+
+	optlen = sizeof(stats);
+	ret = getsockopt(sock1, SOL_PACKET, PACKET_STATISTICS, &stats,
+			 &optlen);
+	zassert_equal(ret, 0, "Cannot get statistics (%d)", -errno);
+	zassert_equal(stats.tp_packets, 4, "Wrong packet count (%d)",
+		      stats.tp_packets);
+	zassert_equal(stats.tp_drops, 1, "Wrong drop count (%d)",
+		      stats.tp_drops);
+
+	req.tp_frame_nr = 0;
+	ret = setsockopt(sock2, SOL_PACKET, PACKET_TX_RING, &req, sizeof(req));
+	zassert_equal(ret, 0, "Cannot release TX ring (%d)", -errno);
+
+	close(sock1);
+	close(sock2);
+}
+#else
+static void test_packet_sockets_ring(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_NET_SOCKETS_PACKET_RING */
+
 void test_main(void)
 {
 	ztest_test_suite(socket_packet,
 			 ztest_unit_test(test_packet_sockets),
 			 ztest_unit_test(test_raw_packet_sockets),
-			 ztest_unit_test(test_packet_sockets_dgram));
+			 ztest_unit_test(test_packet_sockets_dgram),
+			 ztest_unit_test(test_packet_sockets_ring));
 	ztest_run_test_suite(socket_packet);
 }
@@ -46,6 +46,14 @@ extern void test_socketpair_poll_close_remote_end_POLLOUT(void);
 extern void test_socketpair_poll_signalling_POLLIN(void);
 extern void test_socketpair_poll_signalling_POLLOUT(void);
 
+/* in peek.c */
+extern void test_socketpair_peek(void);
+extern void test_socketpair_dontwait(void);
+
+/* in zero_copy.c */
+extern void test_socketpair_zero_copy(void);
+extern void test_socketpair_zero_copy_full(void);
+
 void test_main(void)
 {
 	k_thread_system_pool_assign(k_current_get());
@@ -82,7 +90,14 @@ void test_main(void)
 		ztest_unit_test(test_socketpair_poll_close_remote_end_POLLOUT),
 
 		ztest_unit_test(test_socketpair_poll_signalling_POLLIN),
-		ztest_unit_test(test_socketpair_poll_signalling_POLLOUT)
+		ztest_unit_test(test_socketpair_poll_signalling_POLLOUT),
+
+		ztest_user_unit_test(test_socketpair_peek),
+		ztest_user_unit_test(test_socketpair_dontwait),
+
+		/* the zero-copy calls are not available to user threads */
+		ztest_unit_test(test_socketpair_zero_copy),
+		ztest_unit_test(test_socketpair_zero_copy_full)
 	);
 
 	ztest_run_test_suite(socketpair);
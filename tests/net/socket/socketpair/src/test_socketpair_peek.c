@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <stdio.h>
+#include <string.h>
+#include <net/socket.h>
+#include <sys/util.h>
+#include <posix/unistd.h>
+
+#include <ztest_assert.h>
+
+void test_socketpair_peek(void)
+{
+	int res;
+	int sv[2] = {-1, -1};
+	char buf[CONFIG_NET_SOCKETPAIR_BUFFER_SIZE];
+	char peeked[CONFIG_NET_SOCKETPAIR_BUFFER_SIZE];
+
+	res = socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+	zassert_equal(res, 0, "socketpair(2) failed: %d", errno);
+
+	/* Move the queue indexes to the middle of the buffer, so that the
+	 * peeked data wraps around its end.
+	 */
+	res = send(sv[0], "xyz", 3, 0);
+	zassert_equal(res, 3, "send(2) failed: %d", errno);
+	res = recv(sv[1], buf, 3, 0);
+	zassert_equal(res, 3, "recv(2) failed: %d", errno);
+
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		buf[i] = (char)i;
+	}
+
+	res = send(sv[0], buf, sizeof(buf), 0);
+	zassert_equal(res, sizeof(buf), "send(2) failed: %d", errno);
+
+	/* The data is left in the queue */
+	for (int k = 0; k < 2; k++) {
+		memset(peeked, 0, sizeof(peeked));
+		res = recv(sv[1], peeked, sizeof(peeked), MSG_PEEK);
+		zassert_equal(res, sizeof(peeked), "recv(2) failed: %d",
+			      errno);
+		zassert_mem_equal(peeked, buf, sizeof(buf), "bad data");
+	}
+
+	res = recv(sv[1], peeked, 1, MSG_PEEK);
+	zassert_equal(res, 1, "recv(2) failed: %d", errno);
+	zassert_equal(peeked[0], buf[0], "bad data");
+
+	memset(peeked, 0, sizeof(peeked));
+	res = recv(sv[1], peeked, sizeof(peeked), 0);
+	zassert_equal(res, sizeof(peeked), "recv(2) failed: %d", errno);
+	zassert_mem_equal(peeked, buf, sizeof(buf), "bad data");
+
+	/* Nothing left */
+	res = recv(sv[1], peeked, sizeof(peeked), MSG_PEEK | MSG_DONTWAIT);
+	zassert_equal(res, -1, "expected recv(2) to fail");
+	zassert_equal(errno, EAGAIN, "errno: expected: EAGAIN actual: %d",
+		      errno);
+
+	close(sv[0]);
+	close(sv[1]);
+}
+
+void test_socketpair_dontwait(void)
+{
+	int res;
+	int sv[2] = {-1, -1};
+	char c = 'x';
+
+	res = socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+	zassert_equal(res, 0, "socketpair(2) failed: %d", errno);
+
+	/* The sockets are blocking, the flag applies to the call only */
+	res = recv(sv[0], &c, 1, MSG_DONTWAIT);
+	zassert_equal(res, -1, "expected recv(2) to fail");
+	zassert_equal(errno, EAGAIN, "errno: expected: EAGAIN actual: %d",
+		      errno);
+
+	for (size_t k = 0; k < CONFIG_NET_SOCKETPAIR_BUFFER_SIZE; ++k) {
+		res = send(sv[0], &c, 1, MSG_DONTWAIT);
+		zassert_equal(res, 1, "send(2) failed: %d", errno);
+	}
+
+	res = send(sv[0], &c, 1, MSG_DONTWAIT);
+	zassert_equal(res, -1, "expected send(2) to fail");
+	zassert_equal(errno, EAGAIN, "errno: expected: EAGAIN actual: %d",
+		      errno);
+
+	close(sv[0]);
+	close(sv[1]);
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <stdio.h>
+#include <string.h>
+#include <net/socket.h>
+#include <sys/util.h>
+#include <posix/unistd.h>
+
+#include <ztest_assert.h>
+
+void test_socketpair_zero_copy(void)
+{
+	int res;
+	int sv[2] = {-1, -1};
+	void *data;
+	char buf[8];
+
+	res = socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+	zassert_equal(res, 0, "socketpair(2) failed: %d", errno);
+
+	/* Nothing to claim yet */
+	res = zsock_socketpair_recv_claim(sv[1], &data, sizeof(buf));
+	zassert_equal(res, -1, "expected claim to fail");
+	zassert_equal(errno, EAGAIN, "errno: expected: EAGAIN actual: %d",
+		      errno);
+
+	res = zsock_socketpair_send_claim(sv[0], &data, sizeof(buf));
+	zassert_equal(res, sizeof(buf), "send claim failed: %d", errno);
+	memcpy(data, "01234567", sizeof(buf));
+
+	/* Committing more than claimed fails, and sends nothing */
+	res = zsock_socketpair_send_commit(sv[0], sizeof(buf) + 1);
+	zassert_equal(res, -1, "expected commit to fail");
+	zassert_equal(errno, EINVAL, "errno: expected: EINVAL actual: %d",
+		      errno);
+
+	res = zsock_socketpair_send_claim(sv[0], &data, sizeof(buf));
+	zassert_equal(res, sizeof(buf), "send claim failed: %d", errno);
+	memcpy(data, "01234567", sizeof(buf));
+	res = zsock_socketpair_send_commit(sv[0], sizeof(buf));
+	zassert_equal(res, 0, "send commit failed: %d", errno);
+
+	/* Consume part of the data in place, and read the rest */
+	res = zsock_socketpair_recv_claim(sv[1], &data, sizeof(buf));
+	zassert_equal(res, sizeof(buf), "recv claim failed: %d", errno);
+	zassert_mem_equal(data, "01234567", sizeof(buf), "bad data");
+	res = zsock_socketpair_recv_finish(sv[1], 3);
+	zassert_equal(res, 0, "recv finish failed: %d", errno);
+
+	res = recv(sv[1], buf, sizeof(buf), 0);
+	zassert_equal(res, 5, "recv(2) failed: %d", errno);
+	zassert_mem_equal(buf, "34567", 5, "bad data");
+
+	/* The other end is closed */
+	close(sv[0]);
+
+	res = zsock_socketpair_recv_claim(sv[1], &data, sizeof(buf));
+	zassert_equal(res, 0, "expected end-of-file, got %d", res);
+
+	res = zsock_socketpair_send_claim(sv[1], &data, sizeof(buf));
+	zassert_equal(res, -1, "expected claim to fail");
+	zassert_equal(errno, EPIPE, "errno: expected: EPIPE actual: %d",
+		      errno);
+
+	close(sv[1]);
+}
+
+void test_socketpair_zero_copy_full(void)
+{
+	int res;
+	int sv[2] = {-1, -1};
+	void *data;
+	size_t total = 0;
+
+	res = socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+	zassert_equal(res, 0, "socketpair(2) failed: %d", errno);
+
+	/* The claims stop at the end of the buffer */
+	while (true) {
+		res = zsock_socketpair_send_claim(sv[0], &data,
+						  CONFIG_NET_SOCKETPAIR_BUFFER_SIZE);
+		if (res == -1) {
+			break;
+		}
+
+		memset(data, 'x', res);
+		total += res;
+		res = zsock_socketpair_send_commit(sv[0], res);
+		zassert_equal(res, 0, "send commit failed: %d", errno);
+	}
+
+	zassert_equal(errno, EAGAIN, "errno: expected: EAGAIN actual: %d",
+		      errno);
+	zassert_equal(total, CONFIG_NET_SOCKETPAIR_BUFFER_SIZE,
+		      "sent %zu bytes", total);
+
+	close(sv[0]);
+	close(sv[1]);
+}
@@ -877,6 +877,134 @@ void test_v6_msg_waitall(void)
 	test_close(c_sock);
 }
 
+void test_v6_recv_buf(void)
+{
+	/* Test zero-copy receive on an ipv6 stream socket. */
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in6 c_saddr;
+	struct sockaddr_in6 s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	char rx_buf[sizeof(TEST_STR_SMALL)];
+	struct net_buf *frags;
+	size_t total = 0;
+	ssize_t recved;
+
+	prepare_sock_tcp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, ANY_PORT,
+			    &c_sock, &c_saddr);
+	prepare_sock_tcp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, SERVER_PORT,
+			    &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	recved = zsock_recv_buf(new_sock, &frags, MSG_DONTWAIT);
+	zassert_equal(recved, -1, "recv should have failed");
+	zassert_equal(errno, EAGAIN, "incorrect errno value");
+
+	test_send(c_sock, TEST_STR_SMALL, strlen(TEST_STR_SMALL), 0);
+
+	/* The data may come in several segments */
+	memset(rx_buf, 0, sizeof(rx_buf));
+	while (total < strlen(TEST_STR_SMALL)) {
+		recved = zsock_recv_buf(new_sock, &frags, 0);
+		zassert_true(recved > 0, "recv failed (%d)", errno);
+		zassert_equal(net_buf_frags_len(frags), recved,
+			      "fragments hold more than the data");
+		zassert_true(total + recved <= strlen(TEST_STR_SMALL),
+			     "too much data");
+
+		net_buf_linearize(rx_buf + total, sizeof(rx_buf) - total,
+				  frags, 0, recved);
+		net_buf_unref(frags);
+		total += recved;
+	}
+
+	zassert_mem_equal(rx_buf, TEST_STR_SMALL, strlen(TEST_STR_SMALL),
+			  "wrong data");
+
+	test_close(c_sock);
+
+	recved = zsock_recv_buf(new_sock, &frags, 0);
+	zassert_equal(recved, 0, "EOF not detected");
+	zassert_is_null(frags, "fragments returned at EOF");
+
+	test_close(new_sock);
+	test_close(s_sock);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+static const char ext_data[] = TEST_STR_SMALL;
+static K_SEM_DEFINE(ext_buf_released, 0, 1);
+
+static void ext_buf_destroy(struct net_buf *buf)
+{
+	net_buf_destroy(buf);
+	k_sem_give(&ext_buf_released);
+}
+
+/* Only holds buffers referring to external data */
+NET_BUF_POOL_DEFINE(ext_pool, 1, 0, 0, ext_buf_destroy);
+
+void test_v6_send_buf(void)
+{
+	/* Test zero-copy send on an ipv6 stream socket. */
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in6 c_saddr;
+	struct sockaddr_in6 s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	char rx_buf[sizeof(TEST_STR_SMALL)];
+	struct net_buf *frags;
+	ssize_t ret;
+
+	prepare_sock_tcp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, ANY_PORT,
+			    &c_sock, &c_saddr);
+	prepare_sock_tcp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, SERVER_PORT,
+			    &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	frags = net_buf_alloc_with_data(&ext_pool, (void *)ext_data,
+					strlen(TEST_STR_SMALL), K_NO_WAIT);
+	zassert_not_null(frags, "cannot allocate buffer");
+
+	ret = zsock_send_buf(c_sock, frags, 0);
+	zassert_equal(ret, -1, "send should have failed");
+	zassert_equal(errno, EDESTADDRREQ, "incorrect errno value");
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	ret = zsock_send_buf(c_sock, frags, 0);
+	zassert_equal(ret, strlen(TEST_STR_SMALL), "send failed (%d)", errno);
+
+	/* The buffer is kept for retransmissions until it is acked */
+	memset(rx_buf, 0, sizeof(rx_buf));
+	ret = recv(new_sock, rx_buf, strlen(TEST_STR_SMALL), MSG_WAITALL);
+	zassert_equal(ret, strlen(TEST_STR_SMALL), "recv failed (%d)", errno);
+	zassert_mem_equal(rx_buf, TEST_STR_SMALL, strlen(TEST_STR_SMALL),
+			  "wrong data");
+
+	zassert_equal(k_sem_take(&ext_buf_released, K_SECONDS(1)), 0,
+		      "buffer not released");
+
+	test_close(c_sock);
+	test_close(new_sock);
+	test_close(s_sock);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
 #ifdef CONFIG_USERSPACE
 #define CHILD_STACK_SZ		(2048 + CONFIG_TEST_EXTRA_STACKSIZE)
 struct k_thread child_thread;
@@ -969,6 +1097,8 @@ void test_main(void)
 		ztest_unit_test(test_v6_so_rcvtimeo),
 		ztest_unit_test(test_v4_msg_waitall),
 		ztest_unit_test(test_v6_msg_waitall),
+		ztest_unit_test(test_v6_recv_buf),
+		ztest_unit_test(test_v6_send_buf),
 		ztest_user_unit_test(test_socket_permission)
 		);
 
@@ -71,6 +71,9 @@ static K_THREAD_STACK_DEFINE(server_stack, STACK_SIZE);
 /** @brief the server thread object */
 static struct k_thread server_thread;
 
+/* TLS_SESSION_CACHE value set on both the client and the server sockets */
+static int session_cache = TLS_SESSION_CACHE_DISABLED;
+
 #ifdef CONFIG_TLS_CREDENTIALS
 /**
  * @brief The Certificate Authority (CA) Certificate
@@ -266,6 +269,11 @@ static void test_common(int peer_verify)
 			       sizeof("localhost"));
 		zassert_not_equal(r, -1, "failed to set TLS_HOSTNAME (%d)",
 				  errno);
+
+		r = setsockopt(server_fd, SOL_TLS, TLS_SESSION_CACHE,
+			       &session_cache, sizeof(session_cache));
+		zassert_not_equal(r, -1, "failed to set TLS_SESSION_CACHE (%d)",
+				  errno);
 	}
 
 	memset(&sa, 0, sizeof(sa));
@@ -347,6 +355,11 @@ static void test_common(int peer_verify)
 		r = setsockopt(client_fd, SOL_TLS, TLS_HOSTNAME, "localhost",
 			       sizeof("localhost"));
 		zassert_not_equal(r, -1, "failed to set TLS_HOSTNAME (%d)", errno);
+
+		r = setsockopt(client_fd, SOL_TLS, TLS_SESSION_CACHE,
+			       &session_cache, sizeof(session_cache));
+		zassert_not_equal(r, -1, "failed to set TLS_SESSION_CACHE (%d)",
+				  errno);
 	}
 
 	r = inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR, &sa.sin_addr.s_addr);
@@ -414,6 +427,44 @@ static void test_tls_peer_verify_required(void)
 	test_common(TLS_PEER_VERIFY_REQUIRED);
 }
 
+static void test_tls_session_cache(void)
+{
+	int fd, r, value;
+	socklen_t optlen = sizeof(value);
+
+	fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TLS_1_2);
+	zassert_not_equal(fd, -1, "failed to create socket (%d)", errno);
+
+	r = getsockopt(fd, SOL_TLS, TLS_SESSION_CACHE, &value, &optlen);
+	zassert_equal(r, 0, "failed to get TLS_SESSION_CACHE (%d)", errno);
+	zassert_equal(value, TLS_SESSION_CACHE_DISABLED,
+		      "session cache enabled by default");
+
+	value = 2;
+	r = setsockopt(fd, SOL_TLS, TLS_SESSION_CACHE, &value, sizeof(value));
+	zassert_equal(r, -1, "invalid TLS_SESSION_CACHE value accepted");
+	zassert_equal(errno, EINVAL, "unexpected errno (%d)", errno);
+
+	r = close(fd);
+	zassert_not_equal(r, -1, "close() failed (%d)", errno);
+
+	/* The second connection resumes the session of the first one */
+	session_cache = TLS_SESSION_CACHE_ENABLED;
+	test_common(TLS_PEER_VERIFY_REQUIRED);
+	test_common(TLS_PEER_VERIFY_REQUIRED);
+
+	fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TLS_1_2);
+	zassert_not_equal(fd, -1, "failed to create socket (%d)", errno);
+
+	r = setsockopt(fd, SOL_TLS, TLS_SESSION_CACHE_PURGE, NULL, 0);
+	zassert_equal(r, 0, "failed to purge session cache (%d)", errno);
+
+	r = close(fd);
+	zassert_not_equal(r, -1, "close() failed (%d)", errno);
+
+	session_cache = TLS_SESSION_CACHE_DISABLED;
+}
+
 void test_main(void)
 {
 	int r;
@@ -469,7 +520,8 @@ void test_main(void)
 		tls_socket_api_extension,
 		ztest_unit_test(test_tls_peer_verify_none),
 		ztest_unit_test(test_tls_peer_verify_optional),
-		ztest_unit_test(test_tls_peer_verify_required)
+		ztest_unit_test(test_tls_peer_verify_required),
+		ztest_unit_test(test_tls_session_cache)
 		);
 
 	ztest_run_test_suite(tls_socket_api_extension);
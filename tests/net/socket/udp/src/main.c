@@ -1212,6 +1212,347 @@ void test_v6_msg_trunc(void)
 		       (struct sockaddr *)&server_addr, sizeof(server_addr));
 }
 
+static void comm_sendto_recvmsg(int client_sock, int server_sock,
+				struct sockaddr *server_addr,
+				socklen_t server_addrlen, int level,
+				int pktinfo_type)
+{
+	struct sockaddr_storage src_addr;
+	struct iovec io_vector[2];
+	struct cmsghdr *cmsg;
+	struct msghdr msg;
+	const int on = 1;
+	ssize_t recved;
+	int rv;
+	union {
+		struct cmsghdr hdr;
+		unsigned char  buf[CMSG_SPACE(sizeof(struct in6_pktinfo))];
+	} cmsgbuf;
+
+	rv = bind(server_sock, server_addr, server_addrlen);
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = setsockopt(server_sock, level,
+			level == IPPROTO_IP ? IP_PKTINFO : IPV6_RECVPKTINFO,
+			&on, sizeof(on));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	rv = sendto(client_sock, BUF_AND_SIZE(TEST_STR2), 0,
+		    server_addr, server_addrlen);
+	zassert_equal(rv, STRLEN(TEST_STR2), "sendto failed");
+
+	/* Scattered over two buffers, the second one too short */
+	memset(rx_buf, 0, sizeof(rx_buf));
+	io_vector[0].iov_base = rx_buf;
+	io_vector[0].iov_len = 16;
+	io_vector[1].iov_base = rx_buf + 16;
+	io_vector[1].iov_len = STRLEN(TEST_STR2) - 20;
+
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_name = &src_addr;
+	msg.msg_namelen = sizeof(src_addr);
+	msg.msg_iov = io_vector;
+	msg.msg_iovlen = 2;
+	msg.msg_control = &cmsgbuf.buf;
+	msg.msg_controllen = sizeof(cmsgbuf.buf);
+
+	recved = recvmsg(server_sock, &msg, 0);
+	zassert_equal(recved, STRLEN(TEST_STR2) - 4, "unexpected received bytes");
+	zassert_mem_equal(rx_buf, TEST_STR2, recved, "wrong data");
+	zassert_equal(msg.msg_flags, MSG_TRUNC, "truncation not reported");
+	zassert_equal(msg.msg_namelen, server_addrlen, "wrong source length");
+	zassert_equal(src_addr.ss_family, server_addr->sa_family,
+		      "wrong source family");
+
+	cmsg = CMSG_FIRSTHDR(&msg);
+	zassert_not_null(cmsg, "no packet info");
+	zassert_equal(cmsg->cmsg_level, level, "wrong cmsg level");
+	zassert_equal(cmsg->cmsg_type, pktinfo_type, "wrong cmsg type");
+
+	if (level == IPPROTO_IP) {
+		struct in_pktinfo *info = (void *)CMSG_DATA(cmsg);
+
+		zassert_equal(cmsg->cmsg_len, CMSG_LEN(sizeof(*info)), NULL);
+		zassert_equal(info->ipi_addr.s_addr,
+			      net_sin(server_addr)->sin_addr.s_addr,
+			      "wrong destination address");
+		zassert_true(info->ipi_ifindex > 0, "no interface index");
+	} else {
+		struct in6_pktinfo *info = (void *)CMSG_DATA(cmsg);
+
+		zassert_equal(cmsg->cmsg_len, CMSG_LEN(sizeof(*info)), NULL);
+		zassert_true(net_ipv6_addr_cmp(&info->ipi6_addr,
+					       &net_sin6(server_addr)->sin6_addr),
+			     "wrong destination address");
+		zassert_true(info->ipi6_ifindex > 0, "no interface index");
+	}
+
+	/* No room for the ancillary data */
+	rv = sendto(client_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0,
+		    server_addr, server_addrlen);
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "sendto failed");
+
+	io_vector[0].iov_len = sizeof(rx_buf);
+	msg.msg_name = NULL;
+	msg.msg_namelen = 0;
+	msg.msg_iovlen = 1;
+	msg.msg_controllen = sizeof(struct cmsghdr);
+
+	recved = recvmsg(server_sock, &msg, 0);
+	zassert_equal(recved, STRLEN(TEST_STR_SMALL), "unexpected received bytes");
+	zassert_equal(msg.msg_flags, MSG_CTRUNC, "truncation not reported");
+	zassert_equal(msg.msg_controllen, 0, "ancillary data returned");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+void test_v4_sendto_recvmsg(void)
+{
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	comm_sendto_recvmsg(client_sock, server_sock,
+			    (struct sockaddr *)&server_addr,
+			    sizeof(server_addr), IPPROTO_IP, IP_PKTINFO);
+}
+
+void test_v6_sendto_recvmsg(void)
+{
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in6 client_addr;
+	struct sockaddr_in6 server_addr;
+
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	comm_sendto_recvmsg(client_sock, server_sock,
+			    (struct sockaddr *)&server_addr,
+			    sizeof(server_addr), IPPROTO_IPV6, IPV6_PKTINFO);
+}
+
+#define MMSG_COUNT 3
+
+void test_v6_sendmmsg_recvmmsg(void)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in6 client_addr;
+	struct sockaddr_in6 server_addr;
+	struct mmsghdr msgvec[MMSG_COUNT + 1];
+	struct iovec io_vector[MMSG_COUNT + 1];
+	static const char *const strs[MMSG_COUNT] = {
+		"first", "second one", TEST_STR_SMALL
+	};
+
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = bind(client_sock, (struct sockaddr *)&client_addr,
+		  sizeof(client_addr));
+	zassert_equal(rv, 0, "client bind failed");
+
+	memset(msgvec, 0, sizeof(msgvec));
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		io_vector[i].iov_base = (void *)strs[i];
+		io_vector[i].iov_len = strlen(strs[i]);
+		msgvec[i].msg_hdr.msg_iov = &io_vector[i];
+		msgvec[i].msg_hdr.msg_iovlen = 1;
+		msgvec[i].msg_hdr.msg_name = &server_addr;
+		msgvec[i].msg_hdr.msg_namelen = sizeof(server_addr);
+	}
+
+	rv = sendmmsg(client_sock, msgvec, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "sendmmsg failed (%d)", errno);
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgvec[i].msg_len, strlen(strs[i]),
+			      "wrong sent length");
+	}
+
+	/* One more slot than there are datagrams */
+	memset(msgvec, 0, sizeof(msgvec));
+	memset(rx_buf, 0, sizeof(rx_buf));
+	for (int i = 0; i <= MMSG_COUNT; i++) {
+		io_vector[i].iov_base = rx_buf + i * 32;
+		io_vector[i].iov_len = 32;
+		msgvec[i].msg_hdr.msg_iov = &io_vector[i];
+		msgvec[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = recvmmsg(server_sock, msgvec, MMSG_COUNT + 1, MSG_WAITFORONE);
+	zassert_equal(rv, MMSG_COUNT, "recvmmsg failed (%d)", errno);
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgvec[i].msg_len, strlen(strs[i]),
+			      "wrong received length");
+		zassert_mem_equal(io_vector[i].iov_base, strs[i],
+				  strlen(strs[i]), "wrong data");
+	}
+
+	rv = recvmmsg(server_sock, msgvec, MMSG_COUNT, MSG_DONTWAIT);
+	zassert_equal(rv, -1, "recvmmsg should have failed");
+	zassert_equal(errno, EAGAIN, "incorrect errno value");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+void test_v4_recvfrom_buf(void)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in src_addr;
+	socklen_t addrlen = sizeof(src_addr);
+	struct net_buf *frags;
+	ssize_t recved;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, CLIENT_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = bind(client_sock, (struct sockaddr *)&client_addr,
+		  sizeof(client_addr));
+	zassert_equal(rv, 0, "client bind failed");
+
+	rv = zsock_recvfrom_buf(server_sock, &frags, MSG_PEEK, NULL, NULL);
+	zassert_equal(rv, -1, "MSG_PEEK should not be supported");
+	zassert_equal(errno, EINVAL, "incorrect errno value");
+
+	rv = zsock_recv_buf(server_sock, &frags, MSG_DONTWAIT);
+	zassert_equal(rv, -1, "recv should have failed");
+	zassert_equal(errno, EAGAIN, "incorrect errno value");
+
+	rv = sendto(client_sock, BUF_AND_SIZE(TEST_STR2), 0,
+		    (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR2), "sendto failed");
+
+	recved = zsock_recvfrom_buf(server_sock, &frags, 0,
+				    (struct sockaddr *)&src_addr, &addrlen);
+	zassert_equal(recved, STRLEN(TEST_STR2), "unexpected received bytes");
+	zassert_not_null(frags, "no fragments");
+	zassert_equal(net_buf_frags_len(frags), recved,
+		      "fragments hold more than the data");
+	zassert_equal(addrlen, sizeof(src_addr), "wrong source length");
+	zassert_equal(src_addr.sin_port, client_addr.sin_port,
+		      "wrong source port");
+
+	memset(rx_buf, 0, sizeof(rx_buf));
+	zassert_equal(net_buf_linearize(rx_buf, sizeof(rx_buf), frags, 0,
+					recved), recved, NULL);
+	zassert_mem_equal(rx_buf, TEST_STR2, recved, "wrong data");
+
+	net_buf_unref(frags);
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+static const char ext_data[] = TEST_STR2;
+static K_SEM_DEFINE(ext_buf_released, 0, 2);
+
+static void ext_buf_destroy(struct net_buf *buf)
+{
+	net_buf_destroy(buf);
+	k_sem_give(&ext_buf_released);
+}
+
+/* Only holds buffers referring to external data */
+NET_BUF_POOL_DEFINE(ext_pool, 2, 0, 0, ext_buf_destroy);
+
+void test_v4_sendto_buf(void)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct net_buf *frags;
+	size_t half = STRLEN(TEST_STR2) / 2;
+	ssize_t recved;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, CLIENT_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = bind(client_sock, (struct sockaddr *)&client_addr,
+		  sizeof(client_addr));
+	zassert_equal(rv, 0, "client bind failed");
+
+	/* The data is read-only, which would fault if it was written to */
+	frags = net_buf_alloc_with_data(&ext_pool, (void *)ext_data, half,
+					K_NO_WAIT);
+	zassert_not_null(frags, "cannot allocate buffer");
+	net_buf_frag_add(frags,
+			 net_buf_alloc_with_data(&ext_pool,
+						 (void *)(ext_data + half),
+						 STRLEN(TEST_STR2) - half,
+						 K_NO_WAIT));
+	zassert_not_null(frags->frags, "cannot allocate buffer");
+
+	rv = zsock_send_buf(client_sock, frags, 0);
+	zassert_equal(rv, -1, "send should have failed");
+	zassert_equal(errno, EDESTADDRREQ, "incorrect errno value");
+	zassert_equal(k_sem_take(&ext_buf_released, K_NO_WAIT), -EBUSY,
+		      "buffer released on error");
+
+	rv = zsock_sendto_buf(client_sock, frags, 0,
+			      (struct sockaddr *)&server_addr,
+			      sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR2), "sendto failed");
+
+	memset(rx_buf, 0, sizeof(rx_buf));
+	recved = recv(server_sock, rx_buf, sizeof(rx_buf), 0);
+	zassert_equal(recved, STRLEN(TEST_STR2), "unexpected received bytes");
+	zassert_mem_equal(rx_buf, TEST_STR2, recved, "wrong data");
+
+	zassert_equal(k_sem_take(&ext_buf_released, K_MSEC(100)), 0,
+		      "buffer not released");
+	zassert_equal(k_sem_take(&ext_buf_released, K_MSEC(100)), 0,
+		      "buffer not released");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 void test_main(void)
 {
 	k_thread_system_pool_assign(k_current_get());
@@ -1242,7 +1583,12 @@ void test_main(void)
 			 ztest_unit_test(test_v6_sendmsg_with_txtime),
 			 ztest_user_unit_test(test_v6_sendmsg_with_txtime),
 			 ztest_unit_test(test_v4_msg_trunc),
-			 ztest_unit_test(test_v6_msg_trunc)
+			 ztest_unit_test(test_v6_msg_trunc),
+			 ztest_unit_test(test_v4_sendto_recvmsg),
+			 ztest_unit_test(test_v6_sendto_recvmsg),
+			 ztest_unit_test(test_v6_sendmmsg_recvmmsg),
+			 ztest_unit_test(test_v4_recvfrom_buf),
+			 ztest_unit_test(test_v4_sendto_buf)
 		);
 
 	ztest_run_test_suite(socket_udp);
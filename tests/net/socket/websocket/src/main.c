@@ -353,6 +353,36 @@ static void test_send_and_recv_lorem_ipsum(void)
 		      test_msg_len, ret);
 }
 
+static void test_send_and_recv_lorem_ipsum_iov(void)
+{
+	static struct websocket_context ctx;
+	struct iovec iov[3];
+	int ret;
+
+	memset(&ctx, 0, sizeof(ctx));
+
+	ctx.tmp_buf = temp_recv_buf;
+	ctx.tmp_buf_len = sizeof(temp_recv_buf);
+
+	test_msg_len = sizeof(lorem_ipsum) - 1;
+
+	/* Buffers not aligned on the masking value */
+	iov[0].iov_base = (void *)lorem_ipsum;
+	iov[0].iov_len = 3;
+	iov[1].iov_base = (void *)(lorem_ipsum + 3);
+	iov[1].iov_len = 10;
+	iov[2].iov_base = (void *)(lorem_ipsum + 13);
+	iov[2].iov_len = test_msg_len - 13;
+
+	ret = websocket_send_msg_iov(POINTER_TO_INT(&ctx), iov,
+				     ARRAY_SIZE(iov),
+				     WEBSOCKET_OPCODE_DATA_TEXT, true, true,
+				     SYS_FOREVER_MS);
+	zassert_equal(ret, test_msg_len,
+		      "Should have sent %zd bytes but sent %d instead",
+		      test_msg_len, ret);
+}
+
 static void test_recv_two_large_split_msg(void)
 {
 	static struct websocket_context ctx;
@@ -390,6 +420,7 @@ void test_main(void)
 			 ztest_unit_test(test_recv_whole_msg),
 			 ztest_unit_test(test_recv_two_msg),
 			 ztest_unit_test(test_send_and_recv_lorem_ipsum),
+			 ztest_unit_test(test_send_and_recv_lorem_ipsum_iov),
 			 ztest_unit_test(test_recv_two_large_split_msg)
 		);
 
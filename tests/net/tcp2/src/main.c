@@ -125,6 +125,7 @@ static void handle_syn_resend(void);
 static void handle_client_fin_wait_2_test(sa_family_t af, struct tcphdr *th);
 static void handle_client_closing_test(sa_family_t af, struct tcphdr *th);
 static void handle_server_recv_out_of_order(struct net_pkt *pkt);
+static void handle_sack_test(struct net_pkt *pkt);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -213,6 +214,10 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
+/* Options the peer sends in every segment of test case 10 */
+static uint8_t peer_options[40];
+static size_t peer_options_len;
+
 static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      uint16_t src_port,
 					      uint16_t dst_port,
@@ -223,11 +228,16 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct net_pkt *pkt;
 	struct tcphdr *th;
+	const uint8_t *opts = NULL;
 	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
 	if ((test_case_no == 4U) && (flags & SYN)) {
+		opts = tcp_options;
 		opts_len = sizeof(tcp_options);
+	} else if (test_case_no == 10U) {
+		opts = peer_options;
+		opts_len = peer_options_len;
 	}
 
 	/* Allocate buffer */
@@ -262,14 +272,10 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
-		th->th_off = 10U;
-	} else {
-		th->th_off = 5U;
-	}
+	th->th_off = 5U + opts_len / 4U;
 
 	th->th_flags = flags;
-	th->th_win = NET_IPV6_MTU;
+	th->th_win = htons(NET_IPV6_MTU);
 	th->th_seq = htonl(seq);
 
 	if (ACK & flags) {
@@ -281,9 +287,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
+	if (opts_len) {
 		/* Add TCP Options */
-		ret = net_pkt_write(pkt, tcp_options, opts_len);
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -420,6 +426,9 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case 9:
 		handle_server_recv_out_of_order(pkt);
 		break;
+	case 10:
+		handle_sack_test(pkt);
+		break;
 	default:
 		zassert_true(false, "Undefined test case");
 	}
@@ -1257,6 +1266,7 @@ static void check_rst_fail(uint32_t seq_value)
 	int rsterr_before, rsterr_after;
 	int ret;
 
+	net_stats_collect(iface);
 	rsterr_before = GET_STAT(iface, tcp.rsterr);
 
 	/* Invalid seq in the RST packet */
@@ -1270,6 +1280,7 @@ static void check_rst_fail(uint32_t seq_value)
 	/* Let the receiving thread run */
 	k_msleep(50);
 
+	net_stats_collect(iface);
 	rsterr_after = GET_STAT(iface, tcp.rsterr);
 
 	zassert_equal(rsterr_before + 1, rsterr_after,
@@ -1294,6 +1305,7 @@ static void check_rst_succeed(struct net_context *ctx,
 
 	reply = prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
 
+	net_stats_collect(iface);
 	rsterr_before = GET_STAT(iface, tcp.rsterr);
 
 	ret = net_recv_data(iface, reply);
@@ -1302,6 +1314,7 @@ static void check_rst_succeed(struct net_context *ctx,
 	/* Let the receiving thread run */
 	k_msleep(50);
 
+	net_stats_collect(iface);
 	rsterr_after = GET_STAT(iface, tcp.rsterr);
 
 	zassert_equal(rsterr_before, rsterr_after,
@@ -1315,7 +1328,7 @@ static void test_client_invalid_rst(void)
 {
 	struct net_context *ctx;
 	struct tcp *conn;
-	uint16_t wnd;
+	uint32_t wnd;
 
 	ctx = create_server_socket(0, 0);
 
@@ -1484,6 +1497,366 @@ static void test_server_timeout_out_of_order_data(void)
 	net_tcp_put(ooo_ctx);
 }
 
+struct sack_seg {
+	struct tcphdr th;
+	uint8_t opts[40];
+	size_t opts_len;
+	size_t data_len;
+};
+
+K_MSGQ_DEFINE(sack_msgq, sizeof(struct sack_seg), 8, 4);
+
+static struct net_context *sack_ctx;
+
+#define SACK_MSS 100
+
+/* Keep clear of the connections left over by the previous tests */
+#define SACK_PORT (MY_PORT + 1)
+#define CONGESTION_PORT (MY_PORT + 2)
+
+/* Hand the segments sent by the stack over to the test */
+static void handle_sack_test(struct net_pkt *pkt)
+{
+	struct sack_seg seg = { 0 };
+	size_t hdr_len;
+
+	zassert_equal(read_tcp_header(pkt, &seg.th), 0, "bad header");
+
+	hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	seg.opts_len = (seg.th.th_off - 5U) * 4U;
+	seg.data_len = net_pkt_get_len(pkt) - hdr_len - seg.th.th_off * 4U;
+
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_skip(pkt, hdr_len + sizeof(struct tcphdr));
+	net_pkt_read(pkt, seg.opts, MIN(seg.opts_len, sizeof(seg.opts)));
+	net_pkt_cursor_init(pkt);
+
+	(void)k_msgq_put(&sack_msgq, &seg, K_NO_WAIT);
+}
+
+static void sack_expect(struct sack_seg *seg, uint8_t flags, int line)
+{
+	zassert_equal(k_msgq_get(&sack_msgq, seg, K_MSEC(100)), 0,
+		      "no segment sent (line %d)", line);
+	zassert_equal(seg->th.th_flags, flags,
+		      "flags 0x%02x instead of 0x%02x (line %d)",
+		      seg->th.th_flags, flags, line);
+}
+
+static const uint8_t *sack_option_find(struct sack_seg *seg, uint8_t kind)
+{
+	for (size_t i = 0; i < seg->opts_len; ) {
+		if (seg->opts[i] == TCPOPT_END) {
+			break;
+		}
+
+		if (seg->opts[i] == TCPOPT_NOP) {
+			i++;
+			continue;
+		}
+
+		if (seg->opts[i] == kind) {
+			return &seg->opts[i];
+		}
+
+		i += seg->opts[i + 1];
+	}
+
+	return NULL;
+}
+
+static void sack_peer_options_set(uint32_t start, uint32_t end)
+{
+	uint8_t sack[] = { TCPOPT_NOP, TCPOPT_NOP, TCPOPT_SACK, 10 };
+
+	memcpy(peer_options, sack, sizeof(sack));
+	UNALIGNED_PUT(htonl(start), (uint32_t *)&peer_options[4]);
+	UNALIGNED_PUT(htonl(end), (uint32_t *)&peer_options[8]);
+	peer_options_len = 12;
+}
+
+static void sack_peer_send(struct net_pkt *pkt)
+{
+	zassert_not_null(pkt, "Cannot create pkt");
+	zassert_equal(net_recv_data(iface, pkt), 0, "recv data failed");
+}
+
+static void sack_accept_cb(struct net_context *ctx, struct sockaddr *addr,
+			   socklen_t addrlen, int status, void *user_data)
+{
+	sack_ctx = ctx;
+	test_tcp_accept_cb(ctx, addr, addrlen, status, user_data);
+}
+
+/* Test case scenario IPv6
+ *   send SYN with MSS, SACK permitted and window scale options,
+ *   expect SYN ACK with SACK permitted and window scale options,
+ *   send ACK,
+ *   send out-of-order data,
+ *   expect ACK reporting it in a SACK block,
+ *   send the missing data,
+ *   expect ACK of all the data, without SACK block,
+ *   expect four data segments,
+ *   send three duplicate ACKs reporting all but the first one,
+ *   expect the first segment to be resent.
+ *   any failures cause test case to fail.
+ */
+static void test_sack(void)
+{
+	const uint8_t syn_options[] = {
+		TCPOPT_MAXSEG, 4, 0, SACK_MSS,
+		TCPOPT_NOP, TCPOPT_NOP, TCPOPT_SACK_PERM, 2,
+		TCPOPT_NOP, TCPOPT_WINDOW, 3, 7 };
+	struct net_context *ctx;
+	struct sack_seg seg;
+	const uint8_t *opt;
+	uint32_t peer_seq, una;
+	int ret, i;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_SACK) ||
+	    !IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) ||
+	    CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT == 0) {
+		ztest_test_skip();
+		return;
+	}
+
+	test_case_no = 10;
+	seq = ack = 0;
+	k_msgq_purge(&sack_msgq);
+
+	ret = net_context_get(AF_INET6, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	ret = net_context_bind(ctx, (struct sockaddr *)&my_addr_v6_s,
+			       sizeof(struct sockaddr_in6));
+	zassert_equal(ret, 0, "Failed to bind net_context");
+
+	ret = net_context_listen(ctx, 1);
+	zassert_equal(ret, 0, "Failed to listen on net_context");
+
+	ret = net_context_accept(ctx, sack_accept_cb, K_FOREVER, NULL);
+	zassert_equal(ret, 0, "Failed to set accept on net_context");
+
+	memcpy(peer_options, syn_options, sizeof(syn_options));
+	peer_options_len = sizeof(syn_options);
+	sack_peer_send(prepare_syn_packet(AF_INET6, htons(SACK_PORT),
+					  htons(PEER_PORT)));
+
+	/**TESTPOINT: both options are agreed to */
+	sack_expect(&seg, SYN | ACK, __LINE__);
+	opt = sack_option_find(&seg, TCPOPT_WINDOW);
+	zassert_not_null(opt, "no window scale option");
+	zassert_equal(opt[1], 3, "bad window scale option");
+	zassert_not_null(sack_option_find(&seg, TCPOPT_SACK_PERM),
+			 "no SACK permitted option");
+
+	peer_options_len = 0;
+	peer_seq = ++seq;
+	ack = ntohl(seg.th.th_seq) + 1U;
+	sack_peer_send(prepare_ack_packet(AF_INET6, htons(SACK_PORT),
+					  htons(PEER_PORT)));
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	/**TESTPOINT: out-of-order data is reported */
+	seq = peer_seq + SACK_MSS;
+	sack_peer_send(prepare_data_packet(AF_INET6, htons(SACK_PORT),
+					   htons(PEER_PORT),
+					   lorem_ipsum + SACK_MSS, 10));
+
+	sack_expect(&seg, ACK, __LINE__);
+	zassert_equal(ntohl(seg.th.th_ack), peer_seq, "bad ACK");
+	opt = sack_option_find(&seg, TCPOPT_SACK);
+	zassert_not_null(opt, "no SACK option");
+	zassert_equal(opt[1], 10, "one SACK block expected");
+	zassert_equal(ntohl(UNALIGNED_GET((uint32_t *)&opt[2])),
+		      peer_seq + SACK_MSS, "bad SACK block start");
+	zassert_equal(ntohl(UNALIGNED_GET((uint32_t *)&opt[6])),
+		      peer_seq + SACK_MSS + 10, "bad SACK block end");
+
+	/**TESTPOINT: filling the hole delivers the queued data */
+	seq = peer_seq;
+	sack_peer_send(prepare_data_packet(AF_INET6, htons(SACK_PORT),
+					   htons(PEER_PORT),
+					   lorem_ipsum, SACK_MSS));
+
+	sack_expect(&seg, ACK, __LINE__);
+	zassert_equal(ntohl(seg.th.th_ack), peer_seq + SACK_MSS + 10,
+		      "queued data not acknowledged");
+	zassert_is_null(sack_option_find(&seg, TCPOPT_SACK),
+			"unexpected SACK option");
+	seq = peer_seq + SACK_MSS + 10;
+
+	/* The MSS of the peer splits the data in four segments */
+	ret = net_context_send(sack_ctx, lorem_ipsum, 4 * SACK_MSS, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_equal(ret, 4 * SACK_MSS, "Failed to send data to peer");
+
+	sack_expect(&seg, PSH | ACK, __LINE__);
+	una = ntohl(seg.th.th_seq);
+	for (i = 1; i < 4; i++) {
+		sack_expect(&seg, PSH | ACK, __LINE__);
+		zassert_equal(ntohl(seg.th.th_seq), una + i * SACK_MSS,
+			      "bad segment");
+	}
+
+	/**TESTPOINT: the third duplicate ACK resends the hole only */
+	ack = una;
+	for (i = 2; i <= 4; i++) {
+		sack_peer_options_set(una + SACK_MSS, una + i * SACK_MSS);
+		sack_peer_send(prepare_ack_packet(AF_INET6, htons(SACK_PORT),
+						  htons(PEER_PORT)));
+	}
+
+	sack_expect(&seg, PSH | ACK, __LINE__);
+	zassert_equal(ntohl(seg.th.th_seq), una, "wrong segment resent");
+	zassert_equal(seg.data_len, SACK_MSS, "wrong length resent");
+
+	peer_options_len = 0;
+	ack = una + 4 * SACK_MSS;
+	sack_peer_send(prepare_ack_packet(AF_INET6, htons(SACK_PORT),
+					  htons(PEER_PORT)));
+
+	net_context_put(sack_ctx);
+	net_context_put(ctx);
+}
+
+/* Test case scenario IPv6
+ *   select the congestion control algorithm of the listening context,
+ *   send SYN with MSS option only,
+ *   expect SYN ACK,
+ *   send ACK,
+ *   expect the initial window of four segments out of six,
+ *   send ACK of the first one,
+ *   expect the window to have grown by one segment,
+ *   send three duplicate ACKs,
+ *   expect the first unacknowledged segment to be resent.
+ *   any failures cause test case to fail.
+ */
+static void test_congestion(void)
+{
+	const uint8_t syn_options[] = { TCPOPT_MAXSEG, 4, 0, SACK_MSS };
+	struct net_context *ctx, *accepted;
+	struct sack_seg seg;
+	char name[16];
+	size_t len;
+	uint32_t peer_seq, una;
+	int ret, i;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CONTROL)) {
+		return;
+	}
+
+	test_case_no = 10;
+	seq = ack = 0;
+	k_msgq_purge(&sack_msgq);
+
+	ret = net_context_get(AF_INET6, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	/**TESTPOINT: algorithms are selected by name */
+	len = sizeof(name);
+	ret = net_context_get_option(ctx, NET_OPT_TCP_CONGESTION, name, &len);
+	zassert_equal(ret, 0, "Failed to get congestion control");
+	zassert_true(strcmp(name, "newreno") == 0 || strcmp(name, "cubic") == 0,
+		     "unexpected algorithm %s", name);
+	zassert_equal(len, strlen(name) + 1, "bad length");
+
+	ret = net_context_set_option(ctx, NET_OPT_TCP_CONGESTION, "vegas", 5);
+	zassert_equal(ret, -ENOENT, "unknown algorithm accepted");
+
+	ret = net_context_set_option(ctx, NET_OPT_TCP_CONGESTION, "cubic",
+				     sizeof("cubic"));
+	zassert_equal(ret, IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CUBIC) ?
+		      0 : -ENOENT, "Failed to set CUBIC");
+
+	ret = net_context_set_option(ctx, NET_OPT_TCP_CONGESTION, "newreno",
+				     strlen("newreno"));
+	zassert_equal(ret, 0, "Failed to set NewReno");
+
+	len = sizeof(name);
+	ret = net_context_get_option(ctx, NET_OPT_TCP_CONGESTION, name, &len);
+	zassert_equal(ret, 0, "Failed to get congestion control");
+	zassert_equal(strcmp(name, "newreno"), 0, "algorithm not set");
+
+	ret = net_context_bind(ctx, (struct sockaddr *)&my_addr_v6_s,
+			       sizeof(struct sockaddr_in6));
+	zassert_equal(ret, 0, "Failed to bind net_context");
+
+	ret = net_context_listen(ctx, 1);
+	zassert_equal(ret, 0, "Failed to listen on net_context");
+
+	ret = net_context_accept(ctx, sack_accept_cb, K_FOREVER, NULL);
+	zassert_equal(ret, 0, "Failed to set accept on net_context");
+
+	memcpy(peer_options, syn_options, sizeof(syn_options));
+	peer_options_len = sizeof(syn_options);
+	sack_peer_send(prepare_syn_packet(AF_INET6, htons(CONGESTION_PORT),
+					  htons(PEER_PORT)));
+
+	sack_expect(&seg, SYN | ACK, __LINE__);
+
+	peer_options_len = 0;
+	peer_seq = ++seq;
+	ack = ntohl(seg.th.th_seq) + 1U;
+	sack_peer_send(prepare_ack_packet(AF_INET6, htons(CONGESTION_PORT),
+					  htons(PEER_PORT)));
+	test_sem_take(K_MSEC(100), __LINE__);
+	accepted = sack_ctx;
+
+	/**TESTPOINT: the accepted connection inherits the algorithm */
+	len = sizeof(name);
+	ret = net_context_get_option(accepted, NET_OPT_TCP_CONGESTION, name,
+				     &len);
+	zassert_equal(ret, 0, "Failed to get congestion control");
+	zassert_equal(strcmp(name, "newreno"), 0, "algorithm not inherited");
+
+	/**TESTPOINT: the initial window is four segments */
+	ret = net_context_send(accepted, lorem_ipsum, 6 * SACK_MSS, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_equal(ret, 6 * SACK_MSS, "Failed to send data to peer");
+
+	sack_expect(&seg, PSH | ACK, __LINE__);
+	una = ntohl(seg.th.th_seq);
+	for (i = 1; i < 4; i++) {
+		sack_expect(&seg, PSH | ACK, __LINE__);
+		zassert_equal(ntohl(seg.th.th_seq), una + i * SACK_MSS,
+			      "bad segment");
+	}
+
+	zassert_equal(k_msgq_get(&sack_msgq, &seg, K_MSEC(50)), -EAGAIN,
+		      "initial window exceeded");
+
+	/**TESTPOINT: slow start opens the window on each ACK */
+	ack = una + SACK_MSS;
+	sack_peer_send(prepare_ack_packet(AF_INET6, htons(CONGESTION_PORT),
+					  htons(PEER_PORT)));
+
+	for (i = 4; i < 6; i++) {
+		sack_expect(&seg, PSH | ACK, __LINE__);
+		zassert_equal(ntohl(seg.th.th_seq), una + i * SACK_MSS,
+			      "bad segment");
+	}
+
+	/**TESTPOINT: the third duplicate ACK resends the lost segment */
+	for (i = 0; i < 3; i++) {
+		sack_peer_send(prepare_ack_packet(AF_INET6,
+						  htons(CONGESTION_PORT),
+						  htons(PEER_PORT)));
+	}
+
+	sack_expect(&seg, PSH | ACK, __LINE__);
+	zassert_equal(ntohl(seg.th.th_seq), una + SACK_MSS,
+		      "wrong segment resent");
+	zassert_equal(seg.data_len, SACK_MSS, "wrong length resent");
+
+	ack = una + 6 * SACK_MSS;
+	sack_peer_send(prepare_ack_packet(AF_INET6, htons(CONGESTION_PORT),
+					  htons(PEER_PORT)));
+
+	net_context_put(accepted);
+	net_context_put(ctx);
+}
+
 /** Test case main entry */
 void test_main(void)
 {
@@ -1499,7 +1872,9 @@ void test_main(void)
 			 ztest_unit_test(test_client_closing_ipv6),
 			 ztest_unit_test(test_client_invalid_rst),
 			 ztest_unit_test(test_server_recv_out_of_order_data),
-			 ztest_unit_test(test_server_timeout_out_of_order_data)
+			 ztest_unit_test(test_server_timeout_out_of_order_data),
+			 ztest_unit_test(test_sack),
+			 ztest_unit_test(test_congestion)
 			 );
 
 	ztest_run_test_suite(test_tcp_fn);
@@ -90,6 +90,9 @@ static struct {
 static bool test_started;
 static bool test_failed;
 static bool start_receiving;
+static bool batch_receiving;
+static struct net_pkt *recv_batch[MAX_PKT_TO_RECV];
+static int recv_batch_count;
 static bool recv_cb_called;
 static struct k_sem wait_data;
 
@@ -184,6 +187,14 @@ static int eth_tx(const struct device *dev, struct net_pkt *pkt)
 		udp_hdr->src_port = udp_hdr->dst_port;
 		udp_hdr->dst_port = port;
 
+		if (batch_receiving) {
+			zassert_true(recv_batch_count < ARRAY_SIZE(recv_batch),
+				     "Too many packets for the batch");
+			recv_batch[recv_batch_count++] =
+				net_pkt_clone(pkt, K_NO_WAIT);
+			return 0;
+		}
+
 		if (net_recv_data(net_pkt_iface(pkt),
 				  net_pkt_clone(pkt, K_NO_WAIT)) < 0) {
 			test_failed = true;
@@ -968,6 +979,67 @@ static void test_traffic_class_recv_data_mix_all_2(void)
 	zassert_false(test_failed, "Traffic class verification failed.");
 }
 
+static void traffic_class_recv_batch(const enum net_priority *prios,
+				     int count)
+{
+	int tc_count[MAX_TC] = { 0 };
+	struct net_if *iface;
+	int i, tc, ret;
+
+	(void)memset(recv_priorities, 0, sizeof(recv_priorities));
+	k_sem_init(&wait_data, 0, UINT_MAX);
+
+	batch_receiving = true;
+	recv_batch_count = 0;
+
+	for (i = 0; i < count; i++) {
+		tc = net_rx_priority2tc(prios[i]);
+		traffic_class_recv_packets_with_prio(prios[i], ++tc_count[tc]);
+	}
+
+	batch_receiving = false;
+
+	zassert_equal(recv_batch_count, count, "Sent %d packets, expected %d",
+		      recv_batch_count, count);
+
+	iface = net_pkt_iface(recv_batch[0]);
+	ret = net_recv_data_batch(iface, recv_batch, count);
+	zassert_equal(ret, count, "Queued %d packets, expected %d", ret,
+		      count);
+
+	for (i = 0; i < count; i++) {
+		if (k_sem_take(&wait_data, WAIT_TIME)) {
+			zassert_false(true, "Timeout, got %d packets", i);
+		}
+	}
+
+	zassert_false(test_failed, "Traffic class verification failed.");
+}
+
+static void test_traffic_class_recv_data_batch(void)
+{
+	static const enum net_priority prios[] = {
+		NET_PRIORITY_BE, NET_PRIORITY_BE, NET_PRIORITY_BE,
+		NET_PRIORITY_BE,
+	};
+
+	traffic_class_recv_batch(prios, ARRAY_SIZE(prios));
+}
+
+static void test_traffic_class_recv_data_batch_mix(void)
+{
+	/* The higher priorities come first so that they are received
+	 * before the lower ones. With a single class, all of them have to
+	 * fit in its MAX_PKT_TO_RECV slots.
+	 */
+	static const enum net_priority prios[] = {
+		NET_PRIORITY_NC, NET_PRIORITY_VI, NET_PRIORITY_EE,
+		NET_PRIORITY_BK,
+	};
+
+	traffic_class_recv_batch(prios, ARRAY_SIZE(prios));
+}
+
 void test_main(void)
 {
 	ztest_test_suite(net_traffic_class_test,
@@ -1006,6 +1078,8 @@ void test_main(void)
 			 ztest_unit_test(test_traffic_class_recv_data_mix),
 			 ztest_unit_test(test_traffic_class_recv_data_mix_all_1),
 			 ztest_unit_test(test_traffic_class_recv_data_mix_all_2),
+			 ztest_unit_test(test_traffic_class_recv_data_batch),
+			 ztest_unit_test(test_traffic_class_recv_data_batch_mix),
 			 ztest_unit_test(test_traffic_class_cleanup_rx)
 			 );
 
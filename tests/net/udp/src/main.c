@@ -154,6 +154,8 @@ struct ud {
 
 static struct ud *returned_ud;
 
+static struct ud bucket_ud[4];
+
 static enum net_verdict test_ok(struct net_conn *conn,
 				struct net_pkt *pkt,
 				union net_ip_header *ip_hdr,
@@ -646,6 +648,30 @@ void test_udp(void)
 	TEST_IPV6_OK(ud, &in6addr_peer, &in6addr_my, 12345, 42421);
 	TEST_IPV6_LONG_OK(ud, &in6addr_peer, &in6addr_my, 12345, 42421);
 
+	/* Ports sharing a bucket of the connection lookup table must still
+	 * be told apart, and must not hide the identical handler
+	 */
+	for (int j = 0; j < ARRAY_SIZE(bucket_ud); j++) {
+		uint16_t port = 5000 + j * CONFIG_NET_CONN_HASH_BUCKETS;
+
+		bucket_ud[j].local_port = port;
+		bucket_ud[j].test = "same bucket";
+		ret = net_udp_register(AF_INET, NULL, NULL, 0, port, NULL,
+				       test_ok, &bucket_ud[j], &handlers[i]);
+		zassert_equal(ret, 0, "UDP register port %u failed", port);
+		bucket_ud[j].handle = handlers[i++];
+	}
+
+	for (int j = 0; j < ARRAY_SIZE(bucket_ud); j++) {
+		ud = &bucket_ud[j];
+		TEST_IPV4_OK(ud, &in4addr_peer, &in4addr_my, 1234,
+			     ud->local_port);
+
+		ret = net_udp_register(AF_INET, NULL, NULL, 0, ud->local_port,
+				       NULL, test_fail, NULL, NULL);
+		zassert_equal(ret, -EALREADY, "identical handler registered");
+	}
+
 	/* Remote addr same as local addr, these two will never match */
 	REGISTER(AF_INET6, &my_addr6, NULL, 1234, 4242);
 	REGISTER(AF_INET, &my_addr4, NULL, 1234, 4242);
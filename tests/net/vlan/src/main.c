@@ -90,6 +90,7 @@ struct eth_context {
 	uint8_t mac_addr[6];
 
 	uint16_t expecting_tag;
+	bool tag_insert;
 };
 
 static struct eth_context eth_vlan_context;
@@ -129,9 +130,15 @@ static int eth_tx(const struct device *dev, struct net_pkt *pkt)
 			      net_pkt_vlan_tag(pkt),
 			      context->expecting_tag);
 
-		zassert_equal(context->expecting_tag,
-			      net_eth_vlan_get_vid(ntohs(hdr->vlan.tci)),
-			      "Invalid VLAN tag in ethernet header");
+		if (context->tag_insert) {
+			zassert_not_equal(ntohs(hdr->vlan.tpid),
+					  NET_ETH_PTYPE_VLAN,
+					  "VLAN tag in ethernet header");
+		} else {
+			zassert_equal(context->expecting_tag,
+				      net_eth_vlan_get_vid(ntohs(hdr->vlan.tci)),
+				      "Invalid VLAN tag in ethernet header");
+		}
 
 		k_sem_give(&wait_data);
 	}
@@ -141,7 +148,10 @@ static int eth_tx(const struct device *dev, struct net_pkt *pkt)
 
 static enum ethernet_hw_caps eth_capabilities(const struct device *dev)
 {
-	return ETHERNET_HW_VLAN;
+	struct eth_context *context = dev->data;
+
+	return ETHERNET_HW_VLAN |
+		(context->tag_insert ? ETHERNET_HW_VLAN_TAG_INSERT : 0);
 }
 
 static struct ethernet_api api_funcs = {
@@ -774,6 +784,48 @@ static void test_vlan_send_data(void)
 	net_context_unref(udp_v6_ctx);
 }
 
+/* The tag is left to the device, which gets the frame without it */
+static void test_vlan_send_data_tag_insert(void)
+{
+	int ret;
+	struct sockaddr_in6 dst_addr6 = {
+		.sin6_family = AF_INET6,
+		.sin6_port = htons(TEST_PORT),
+	};
+	struct sockaddr_in6 src_addr6 = {
+		.sin6_family = AF_INET6,
+		.sin6_port = 0,
+	};
+
+	ret = net_context_get(AF_INET6, SOCK_DGRAM, IPPROTO_UDP,
+			      &udp_v6_ctx);
+	zassert_equal(ret, 0, "Create IPv6 UDP context failed");
+
+	memcpy(&src_addr6.sin6_addr, &my_addr1, sizeof(struct in6_addr));
+	memcpy(&dst_addr6.sin6_addr, &dst_addr, sizeof(struct in6_addr));
+
+	ret = net_context_bind(udp_v6_ctx, (struct sockaddr *)&src_addr6,
+			       sizeof(struct sockaddr_in6));
+	zassert_equal(ret, 0, "Context bind failure test failed");
+
+	eth_vlan_context.tag_insert = true;
+
+	ret = net_context_sendto(udp_v6_ctx, test_data, strlen(test_data),
+				 (struct sockaddr *)&dst_addr6,
+				 sizeof(struct sockaddr_in6),
+				 NULL, K_NO_WAIT, NULL);
+	zassert_true(ret > 0, "Send UDP pkt failed");
+
+	if (k_sem_take(&wait_data, WAIT_TIME)) {
+		DBG("Timeout while waiting interface data\n");
+		zassert_false(true, "Timeout");
+	}
+
+	eth_vlan_context.tag_insert = false;
+
+	net_context_unref(udp_v6_ctx);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(net_vlan_test,
@@ -784,7 +836,8 @@ void test_main(void)
 			 ztest_unit_test(test_vlan_disable),
 			 ztest_unit_test(test_vlan_enable_all),
 			 ztest_unit_test(test_vlan_disable_all),
-			 ztest_unit_test(test_vlan_send_data)
+			 ztest_unit_test(test_vlan_send_data),
+			 ztest_unit_test(test_vlan_send_data_tag_insert)
 			 );
 
 	ztest_run_test_suite(net_vlan_test);
@@ -9,10 +9,12 @@
 
 extern void test_posix_clock(void);
 extern void test_posix_mqueue(void);
+extern void test_posix_mqueue_prio(void);
 extern void test_posix_normal_mutex(void);
 extern void test_posix_recursive_mutex(void);
 extern void test_posix_semaphore(void);
 extern void test_posix_rw_lock(void);
+extern void test_posix_rw_lock_kind(void);
 extern void test_posix_realtime(void);
 extern void test_posix_timer(void);
 extern void test_posix_pthread_execution(void);
@@ -50,9 +52,11 @@ void test_main(void)
 			ztest_unit_test(test_posix_normal_mutex),
 			ztest_unit_test(test_posix_recursive_mutex),
 			ztest_unit_test(test_posix_mqueue),
+			ztest_unit_test(test_posix_mqueue_prio),
 			ztest_unit_test(test_posix_realtime),
 			ztest_unit_test(test_posix_timer),
 			ztest_unit_test(test_posix_rw_lock),
+			ztest_unit_test(test_posix_rw_lock_kind),
 			ztest_unit_test(test_nanosleep_NULL_NULL),
 			ztest_unit_test(test_nanosleep_NULL_notNULL),
 			ztest_unit_test(test_nanosleep_notNULL_NULL),
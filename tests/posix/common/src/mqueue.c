@@ -7,6 +7,7 @@
 #include <ztest.h>
 #include <zephyr.h>
 #include <sys/printk.h>
+#include <errno.h>
 #include <fcntl.h>
 #include <sys/util.h>
 #include <mqueue.h>
@@ -107,3 +108,62 @@ void test_posix_mqueue(void)
 		      "unable to close message queue descriptor.");
 	zassert_false(mq_unlink(queue), "Not able to unlink Queue");
 }
+
+void test_posix_mqueue_prio(void)
+{
+	static const struct {
+		char data[MESSAGE_SIZE];
+		unsigned int prio;
+	} msgs[MESG_COUNT_PERMQ] = {
+		{ "low first", 1 }, { "high first", 5 },
+		{ "low second", 1 }, { "high second", 5 },
+	};
+	static const int order[MESG_COUNT_PERMQ] = { 1, 3, 0, 2 };
+	char rec_data[MESSAGE_SIZE];
+	struct mq_attr attrs;
+	unsigned int prio;
+	mqd_t mqd;
+	int i;
+
+	attrs.mq_msgsize = MESSAGE_SIZE;
+	attrs.mq_maxmsg = MESG_COUNT_PERMQ;
+
+	mqd = mq_open("prio", O_RDWR | O_CREAT | O_NONBLOCK, 0777, &attrs);
+	zassert_not_equal(mqd, (mqd_t)-1, "unable to open message queue");
+
+	zassert_equal(mq_send(mqd, send_data, MESSAGE_SIZE, MQ_PRIO_MAX), -1,
+		      "message sent with an invalid priority");
+	zassert_equal(errno, EINVAL, NULL);
+
+	for (i = 0; i < MESG_COUNT_PERMQ; i++) {
+		zassert_false(mq_send(mqd, msgs[i].data, strlen(msgs[i].data) + 1,
+				      msgs[i].prio),
+			      "unable to send message %d", i);
+	}
+
+	zassert_equal(mq_send(mqd, send_data, MESSAGE_SIZE, 0), -1,
+		      "message sent to a full queue");
+	zassert_equal(errno, EAGAIN, NULL);
+
+	zassert_false(mq_getattr(mqd, &attrs), NULL);
+	zassert_equal(attrs.mq_curmsgs, MESG_COUNT_PERMQ, NULL);
+
+	/* Highest priority first, in the order sent within a priority */
+	for (i = 0; i < MESG_COUNT_PERMQ; i++) {
+		const char *data = msgs[order[i]].data;
+
+		zassert_equal(mq_receive(mqd, rec_data, MESSAGE_SIZE, &prio),
+			      strlen(data) + 1, "wrong length of message %d", i);
+		zassert_false(strcmp(rec_data, data), "wrong message %d", i);
+		zassert_equal(prio, msgs[order[i]].prio,
+			      "wrong priority of message %d", i);
+	}
+
+	zassert_equal(mq_receive(mqd, rec_data, MESSAGE_SIZE, &prio), -1,
+		      "message received from an empty queue");
+	zassert_equal(errno, EAGAIN, NULL);
+
+	zassert_false(mq_close(mqd),
+		      "unable to close message queue descriptor.");
+	zassert_false(mq_unlink("prio"), "Not able to unlink Queue");
+}
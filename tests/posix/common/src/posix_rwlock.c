@@ -143,3 +143,57 @@ void test_posix_rw_lock(void)
 	zassert_false(pthread_rwlock_destroy(&rwlock),
 		      "Failed to destroy rwlock");
 }
+
+static void *writer_thread(void *p1)
+{
+	pthread_rwlock_t *lock = p1;
+
+	zassert_false(pthread_rwlock_wrlock(lock), "Failed to acquire WR lock");
+	zassert_false(pthread_rwlock_unlock(lock), "Failed to unlock");
+	pthread_exit(NULL);
+	return NULL;
+}
+
+static void rw_lock_kind(int kind)
+{
+	pthread_rwlockattr_t rwattr;
+	pthread_attr_t attr;
+	pthread_t writer;
+	void *status;
+	int ret;
+
+	zassert_false(pthread_rwlockattr_init(&rwattr), NULL);
+	zassert_false(pthread_rwlockattr_setkind_np(&rwattr, kind), NULL);
+	zassert_false(pthread_rwlock_init(&rwlock, &rwattr),
+		      "Failed to create rwlock");
+
+	zassert_false(pthread_rwlock_rdlock(&rwlock), "Failed to lock");
+
+	/* A writer waits for the reader */
+	zassert_false(pthread_attr_init(&attr), NULL);
+	pthread_attr_setstack(&attr, &stack[0][0], STACKSZ);
+	zassert_false(pthread_create(&writer, &attr, writer_thread, &rwlock),
+		      "Low memory to thread new thread");
+	usleep(USEC_PER_MSEC);
+
+	/* Another reader gets the lock unless the writer is preferred */
+	ret = pthread_rwlock_tryrdlock(&rwlock);
+	if (kind == PTHREAD_RWLOCK_PREFER_READER_NP) {
+		zassert_equal(ret, 0, "Reader not preferred");
+		zassert_false(pthread_rwlock_unlock(&rwlock), "Failed to unlock");
+	} else {
+		zassert_equal(ret, EBUSY, "Writer not preferred");
+	}
+
+	zassert_false(pthread_rwlock_unlock(&rwlock), "Failed to unlock");
+	zassert_false(pthread_join(writer, &status), "Failed to join");
+
+	zassert_false(pthread_rwlock_destroy(&rwlock),
+		      "Failed to destroy rwlock");
+}
+
+void test_posix_rw_lock_kind(void)
+{
+	rw_lock_kind(PTHREAD_RWLOCK_PREFER_READER_NP);
+	rw_lock_kind(PTHREAD_RWLOCK_PREFER_WRITER_NP);
+}
@@ -334,6 +334,43 @@ static void test_send_receive_single_block(void)
 	isotp_unbind(&recv_ctx);
 }
 
+static void test_send_receive_user_buf(void)
+{
+	const struct isotp_fc_opts fc_opts_user_buf = {
+		.bs = 0,
+		.stmin = 0
+	};
+	const size_t data_size = sizeof(data_buf) * 2 + 10;
+	static uint8_t user_buf[sizeof(data_buf) * 2 + 10];
+	int ret, i;
+
+	ret = isotp_bind(&recv_ctx, can_dev, &rx_addr, &tx_addr,
+			 &fc_opts_user_buf, K_NO_WAIT);
+	zassert_equal(ret, 0, "Binding failed (%d)", ret);
+
+	for (i = 0; i < NUMBER_OF_REPETITIONS; i++) {
+		memset(user_buf, 0, sizeof(user_buf));
+		isotp_recv_buf_set(&recv_ctx, user_buf, sizeof(user_buf));
+		send_test_data(can_dev, random_data, data_size);
+		ret = isotp_recv_buf_wait(&recv_ctx, K_MSEC(1000));
+		zassert_equal(ret, data_size, "recv returned %d", ret);
+		check_data(user_buf, random_data, data_size);
+
+		ret = isotp_recv(&recv_ctx, data_buf, sizeof(data_buf),
+				 K_MSEC(50));
+		zassert_equal(ret, ISOTP_RECV_TIMEOUT,
+			      "Expected timeout but got %d", ret);
+	}
+
+	isotp_recv_buf_set(&recv_ctx, user_buf, sizeof(user_buf));
+	send_sf(can_dev);
+	ret = isotp_recv_buf_wait(&recv_ctx, K_MSEC(1000));
+	zassert_equal(ret, DATA_SIZE_SF, "recv returned %d", ret);
+	check_data(user_buf, random_data, DATA_SIZE_SF);
+
+	isotp_unbind(&recv_ctx);
+}
+
 static void test_bind_unbind(void)
 {
 	int ret, i;
@@ -434,6 +471,7 @@ void test_main(void)
 			 ztest_unit_test(test_send_receive_sf),
 			 ztest_unit_test(test_send_receive_blocks),
 			 ztest_unit_test(test_send_receive_single_block),
+			 ztest_unit_test(test_send_receive_user_buf),
 			 ztest_unit_test(test_buffer_allocation),
 			 ztest_unit_test(test_buffer_allocation_wait)
 			 );
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <list>
+#include <vector>
+#include <ztest.h>
+#include <cpp/memory_resource.hpp>
+
+using namespace zephyr::pmr;
+
+#define NODES 8
+
+K_HEAP_DEFINE(test_heap, 2048);
+K_MEM_SLAB_DEFINE(test_slab, 32, NODES, 8);
+
+struct counted {
+	static int live;
+	int value;
+
+	counted(int v) : value{v}
+	{
+		++live;
+	}
+
+	~counted()
+	{
+		--live;
+	}
+};
+int counted::live;
+
+K_MEM_SLAB_DEFINE(obj_slab, sizeof(counted), 2, alignof(counted));
+
+static void test_heap_resource(void)
+{
+	heap_resource res(&test_heap);
+	std::vector<int, polymorphic_allocator<int>> vec(&res);
+
+	for (int i = 0; i < 100; i++) {
+		vec.push_back(i);
+	}
+
+	zassert_equal(vec[99], 99, "vector content lost");
+
+	void *p = res.allocate(16, 64);
+
+	zassert_not_null(p, "aligned allocation failed");
+	zassert_true(((uintptr_t)p % 64U) == 0U, "allocation not aligned");
+	res.deallocate(p, 16, 64);
+}
+
+static void test_slab_resource(void)
+{
+	slab_resource res(&test_slab);
+
+	{
+		std::list<int, polymorphic_allocator<int>> list(&res);
+
+		for (int i = 0; i < NODES; i++) {
+			list.push_back(i);
+		}
+
+		zassert_equal(k_mem_slab_num_used_get(&test_slab), NODES,
+			      "nodes not allocated from the slab");
+	}
+
+	zassert_equal(k_mem_slab_num_used_get(&test_slab), 0,
+		      "nodes not freed to the slab");
+
+#if !defined(__cpp_exceptions)
+	zassert_is_null(res.allocate(64, 8), "block too large allowed");
+#endif
+}
+
+static void test_monotonic_resource(void)
+{
+	monotonic_arena<64> arena;
+	void *p1 = arena.allocate(10, 1);
+	void *p2 = arena.allocate(8, 8);
+
+	zassert_not_null(p1, NULL);
+	zassert_not_null(p2, NULL);
+	zassert_true(((uintptr_t)p2 % 8U) == 0U, "allocation not aligned");
+	zassert_true((uint8_t *)p2 >= (uint8_t *)p1 + 10, "overlap");
+	zassert_equal(arena.used_bytes(), 24, NULL);
+
+#if !defined(__cpp_exceptions)
+	zassert_is_null(arena.allocate(64, 1), "arena overflow");
+#endif
+
+	arena.release();
+	zassert_equal(arena.used_bytes(), 0, NULL);
+	zassert_not_null(arena.allocate(64, 1), "arena not released");
+}
+
+static void test_thread_resource(void)
+{
+#if defined(CONFIG_THREAD_LOCAL_STORAGE)
+	monotonic_arena<64> arena;
+
+	zassert_equal(get_thread_resource(), new_delete_resource(), NULL);
+	zassert_is_null(set_thread_resource(&arena), NULL);
+	zassert_equal(get_thread_resource(), &arena, NULL);
+	zassert_equal(set_thread_resource(nullptr), &arena, NULL);
+#else
+	ztest_test_skip();
+#endif
+}
+
+static void test_object_slab(void)
+{
+	object_slab<counted> pool(&obj_slab);
+	counted *a = pool.create(1);
+	counted *b = pool.create(2);
+
+	zassert_not_null(a, NULL);
+	zassert_not_null(b, NULL);
+	zassert_equal(b->value, 2, "constructor not run");
+	zassert_equal(counted::live, 2, NULL);
+	zassert_is_null(pool.create(3), "slab overflow");
+
+	pool.destroy(a);
+	pool.destroy(b);
+	zassert_equal(counted::live, 0, "destructor not run");
+	zassert_equal(k_mem_slab_num_used_get(&obj_slab), 0, NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(cpp_memory_resource,
+			 ztest_unit_test(test_heap_resource),
+			 ztest_unit_test(test_slab_resource),
+			 ztest_unit_test(test_monotonic_resource),
+			 ztest_unit_test(test_thread_resource),
+			 ztest_unit_test(test_object_slab));
+	ztest_run_test_suite(cpp_memory_resource);
+}
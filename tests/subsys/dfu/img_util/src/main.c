@@ -9,6 +9,12 @@
 #include <storage/flash_map.h>
 #include <dfu/flash_img.h>
 
+#ifdef CONFIG_IMG_DELTA
+#include <dfu/flash_img_delta.h>
+#include <sys/byteorder.h>
+#include <tinycrypt/sha256.h>
+#endif
+
 void test_init_id(void)
 {
 	struct flash_img_context ctx_no_id;
@@ -158,12 +164,157 @@ void test_check_flash(void)
 	flash_area_close(ctx.flash_area);
 }
 
+#ifdef CONFIG_IMG_DELTA
+#define DELTA_SOURCE_SIZE 64
+
+static void sha256(uint8_t *hash, const uint8_t *data, size_t len)
+{
+	struct tc_sha256_state_struct sha;
+
+	zassert_true(tc_sha256_init(&sha) == TC_CRYPTO_SUCCESS, "sha init");
+	zassert_true(tc_sha256_update(&sha, data, len) == TC_CRYPTO_SUCCESS,
+		     "sha update");
+	zassert_true(tc_sha256_final(hash, &sha) == TC_CRYPTO_SUCCESS,
+		     "sha final");
+}
+
+/* Write data through a delta update, one byte at a time. */
+static int delta_apply(const uint8_t *data, size_t len, bool *patch)
+{
+	static struct flash_img_delta delta;
+	struct flash_img_context ctx;
+	int ret;
+
+	ret = flash_img_init(&ctx);
+	zassert_true(ret == 0, "Flash img init");
+	ret = flash_area_erase(ctx.flash_area, 0, ctx.flash_area->fa_size);
+	zassert_true(ret == 0, "Flash erase failure (%d)", ret);
+	ret = flash_img_delta_init(&delta, &ctx);
+	zassert_true(ret == 0, "Delta init");
+
+	for (size_t i = 0; i < len; i++) {
+		ret = flash_img_delta_write(&delta, &data[i], 1,
+					    i == len - 1);
+		if (ret) {
+			break;
+		}
+	}
+
+	if (ret == 0) {
+		zassert_equal(flash_img_delta_bytes_received(&delta), len,
+			      "Bytes received");
+	}
+
+	*patch = flash_img_delta_is_patch(&delta);
+
+	return ret;
+}
+
+static void target_verify(const uint8_t *data, size_t len)
+{
+	const struct flash_area *fa;
+	uint8_t temp;
+
+	zassert_true(flash_area_open(FLASH_AREA_ID(image_1), &fa) == 0,
+		     "Flash area open");
+
+	for (size_t i = 0; i < len; i++) {
+		zassert_true(flash_area_read(fa, i, &temp, 1) == 0,
+			     "Flash read");
+		zassert_equal(temp, data[i], "Target mismatch at %zu", i);
+	}
+
+	flash_area_close(fa);
+}
+
+void test_delta(void)
+{
+	static const uint8_t insert1[] = { 'a', 'b', 'c', 'd' };
+	static const uint8_t insert2[] = { 'x', 'y', 'z' };
+	static uint8_t patch[FLASH_IMG_DELTA_HDR_SIZE + 64];
+	uint8_t source[DELTA_SOURCE_SIZE];
+	uint8_t target[sizeof(insert1) + 32 + sizeof(insert2)];
+	const struct flash_area *fa;
+	size_t len;
+	bool is_patch;
+	int ret;
+
+	/* The patch applies to whatever the primary slot contains. */
+	zassert_true(flash_area_open(FLASH_AREA_ID(image_0), &fa) == 0,
+		     "Flash area open");
+	zassert_true(flash_area_read(fa, 0, source, sizeof(source)) == 0,
+		     "Flash read");
+	flash_area_close(fa);
+
+	memcpy(target, insert1, sizeof(insert1));
+	memcpy(&target[sizeof(insert1)], &source[8], 32);
+	memcpy(&target[sizeof(insert1) + 32], insert2, sizeof(insert2));
+
+	memset(patch, 0, sizeof(patch));
+	sys_put_le32(FLASH_IMG_DELTA_MAGIC, &patch[0]);
+	sys_put_le32(sizeof(source), &patch[4]);
+	sys_put_le32(sizeof(target), &patch[8]);
+	sha256(&patch[16], source, sizeof(source));
+	sha256(&patch[48], target, sizeof(target));
+	len = FLASH_IMG_DELTA_HDR_SIZE;
+
+	patch[len++] = FLASH_IMG_DELTA_OP_INSERT;
+	sys_put_le32(sizeof(insert1), &patch[len]);
+	len += 4;
+	memcpy(&patch[len], insert1, sizeof(insert1));
+	len += sizeof(insert1);
+
+	patch[len++] = FLASH_IMG_DELTA_OP_COPY;
+	sys_put_le32(8, &patch[len]);
+	sys_put_le32(32, &patch[len + 4]);
+	len += 8;
+
+	patch[len++] = FLASH_IMG_DELTA_OP_INSERT;
+	sys_put_le32(sizeof(insert2), &patch[len]);
+	len += 4;
+	memcpy(&patch[len], insert2, sizeof(insert2));
+	len += sizeof(insert2);
+
+	ret = delta_apply(patch, len, &is_patch);
+	zassert_equal(ret, 0, "Delta apply (%d)", ret);
+	zassert_true(is_patch, "Patch not detected");
+	target_verify(target, sizeof(target));
+
+	/* Truncated patch. */
+	ret = delta_apply(patch, len - 1, &is_patch);
+	zassert_equal(ret, -EBADMSG, "Truncated patch (%d)", ret);
+
+	/* Copy out of the source image. */
+	sys_put_le32(sizeof(source) - 16, &patch[FLASH_IMG_DELTA_HDR_SIZE +
+						 5 + sizeof(insert1) + 1]);
+	ret = delta_apply(patch, len, &is_patch);
+	zassert_equal(ret, -EBADMSG, "Copy out of the source (%d)", ret);
+
+	/* Patch made against another image. */
+	patch[16] ^= 0xff;
+	ret = delta_apply(patch, len, &is_patch);
+	zassert_equal(ret, -EBADMSG, "Wrong source (%d)", ret);
+
+	/* Full images are written as they are. */
+	ret = delta_apply(target, sizeof(target), &is_patch);
+	zassert_equal(ret, 0, "Full image (%d)", ret);
+	zassert_false(is_patch, "Full image detected as a patch");
+	target_verify(target, sizeof(target));
+}
+#else
+void test_delta(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_IMG_DELTA */
+
 void test_main(void)
 {
 	ztest_test_suite(test_util,
 			ztest_unit_test(test_collecting),
 			ztest_unit_test(test_init_id),
-			ztest_unit_test(test_check_flash)
+			ztest_unit_test(test_check_flash),
+			ztest_unit_test(test_delta)
 			);
 	ztest_run_test_suite(test_util);
 }
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <ztest.h>
+#include <storage/disk_access.h>
+
+#define DISK_NAME "CACHE"
+#define SECTOR_SIZE 512
+#define SECTOR_COUNT 64
+
+static uint8_t ramdisk_buf[SECTOR_COUNT][SECTOR_SIZE];
+static uint8_t buf[32][SECTOR_SIZE];
+
+static int read_calls;
+static int write_calls;
+static uint32_t written_sectors;
+
+static int ram_status(struct disk_info *disk)
+{
+	return DISK_STATUS_OK;
+}
+
+static int ram_init(struct disk_info *disk)
+{
+	return 0;
+}
+
+static int ram_read(struct disk_info *disk, uint8_t *buff, uint32_t sector,
+		    uint32_t count)
+{
+	zassert_true(sector + count <= SECTOR_COUNT, "Read past the disk");
+	memcpy(buff, ramdisk_buf[sector], count * SECTOR_SIZE);
+	read_calls++;
+
+	return 0;
+}
+
+static int ram_write(struct disk_info *disk, const uint8_t *buff,
+		     uint32_t sector, uint32_t count)
+{
+	zassert_true(sector + count <= SECTOR_COUNT, "Write past the disk");
+	memcpy(ramdisk_buf[sector], buff, count * SECTOR_SIZE);
+	write_calls++;
+	written_sectors += count;
+
+	return 0;
+}
+
+static int ram_ioctl(struct disk_info *disk, uint8_t cmd, void *buff)
+{
+	switch (cmd) {
+	case DISK_IOCTL_CTRL_SYNC:
+		break;
+	case DISK_IOCTL_GET_SECTOR_COUNT:
+		*(uint32_t *)buff = SECTOR_COUNT;
+		break;
+	case DISK_IOCTL_GET_SECTOR_SIZE:
+		*(uint32_t *)buff = SECTOR_SIZE;
+		break;
+	case DISK_IOCTL_GET_ERASE_BLOCK_SZ:
+		*(uint32_t *)buff = 1U;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static const struct disk_operations ram_ops = {
+	.init = ram_init,
+	.status = ram_status,
+	.read = ram_read,
+	.write = ram_write,
+	.ioctl = ram_ioctl,
+};
+
+static struct disk_info ram_disk = {
+	.name = DISK_NAME,
+	.ops = &ram_ops,
+};
+
+static void reset_counters(void)
+{
+	read_calls = 0;
+	write_calls = 0;
+	written_sectors = 0U;
+}
+
+static void fill(uint8_t *data, uint32_t sector, uint8_t seed)
+{
+	for (int i = 0; i < SECTOR_SIZE; i++) {
+		data[i] = (uint8_t)(sector + seed + i);
+	}
+}
+
+static void check(const uint8_t *data, uint32_t sector, uint8_t seed)
+{
+	uint8_t expected[SECTOR_SIZE];
+
+	fill(expected, sector, seed);
+	zassert_mem_equal(data, expected, SECTOR_SIZE,
+			  "Unexpected data in sector %u", sector);
+}
+
+static void test_init(void)
+{
+	zassert_equal(disk_access_register(&ram_disk), 0,
+		      "Failed to register the disk");
+
+	for (uint32_t i = 0U; i < SECTOR_COUNT; i++) {
+		fill(ramdisk_buf[i], i, 0);
+	}
+
+	zassert_equal(disk_access_init(DISK_NAME), 0,
+		      "Failed to initialize the disk");
+}
+
+static void test_read_hit(void)
+{
+	reset_counters();
+
+	zassert_equal(disk_access_read(DISK_NAME, buf[0], 3, 1), 0,
+		      "Read failed");
+	zassert_equal(disk_access_read(DISK_NAME, buf[1], 10, 1), 0,
+		      "Read failed");
+	zassert_equal(disk_access_read(DISK_NAME, buf[2], 3, 1), 0,
+		      "Read failed");
+	zassert_equal(read_calls, 2, "Cached sector read again");
+	check(buf[0], 3, 0);
+	check(buf[1], 10, 0);
+	check(buf[2], 3, 0);
+
+	/* The missing sectors around a cached one are read with one
+	 * request each.
+	 */
+	reset_counters();
+	zassert_equal(disk_access_read(DISK_NAME, buf[0], 1, 4), 0,
+		      "Read failed");
+	zassert_equal(read_calls, 2, "Missing sectors not read together");
+	for (uint32_t i = 0U; i < 4U; i++) {
+		check(buf[i], 1 + i, 0);
+	}
+}
+
+static void test_read_ahead(void)
+{
+	reset_counters();
+
+	for (uint32_t i = 20U; i < 29U; i++) {
+		zassert_equal(disk_access_read(DISK_NAME, buf[0], i, 1), 0,
+			      "Read failed");
+		check(buf[0], i, 0);
+	}
+
+	/* Sector 20, then sectors 21 to 28 read ahead together */
+	zassert_equal(read_calls, 2, "Sequential sectors not read ahead");
+}
+
+static void test_read_large(void)
+{
+	reset_counters();
+
+	zassert_equal(disk_access_read(DISK_NAME, buf[0], 32, 32), 0,
+		      "Read failed");
+	zassert_equal(read_calls, 1, "Large read split");
+	for (uint32_t i = 0U; i < 32U; i++) {
+		check(buf[i], 32 + i, 0);
+	}
+
+	/* Large reads do not evict the cache */
+	zassert_equal(disk_access_read(DISK_NAME, buf[0], 10, 1), 0,
+		      "Read failed");
+	zassert_equal(read_calls, 1, "Cached sector evicted");
+}
+
+static void test_write(void)
+{
+	reset_counters();
+
+	for (uint32_t i = 40U; i < 43U; i++) {
+		fill(buf[0], i, 1);
+		zassert_equal(disk_access_write(DISK_NAME, buf[0], i, 1), 0,
+			      "Write failed");
+	}
+
+	if (IS_ENABLED(CONFIG_DISK_CACHE_WRITE_BACK)) {
+		zassert_equal(write_calls, 0, "Sectors written through");
+		check(ramdisk_buf[40], 40, 0);
+	} else {
+		zassert_equal(write_calls, 3, "Sectors not written through");
+		check(ramdisk_buf[40], 40, 1);
+	}
+
+	/* The written sectors are cached */
+	zassert_equal(disk_access_read(DISK_NAME, buf[0], 40, 3), 0,
+		      "Read failed");
+	zassert_equal(read_calls, 0, "Written sectors read from the disk");
+	for (uint32_t i = 0U; i < 3U; i++) {
+		check(buf[i], 40 + i, 1);
+	}
+
+	reset_counters();
+	zassert_equal(disk_access_ioctl(DISK_NAME, DISK_IOCTL_CTRL_SYNC, NULL),
+		      0, "Sync failed");
+
+	if (IS_ENABLED(CONFIG_DISK_CACHE_WRITE_BACK)) {
+		/* Coalesced into a single request */
+		zassert_equal(write_calls, 1, "Dirty sectors not coalesced");
+		zassert_equal(written_sectors, 3U, "Unexpected sectors written");
+	} else {
+		zassert_equal(write_calls, 0, "Clean sectors written");
+	}
+
+	for (uint32_t i = 40U; i < 43U; i++) {
+		check(ramdisk_buf[i], i, 1);
+	}
+}
+
+static void test_write_evict(void)
+{
+	reset_counters();
+
+	/* Writing more sectors than the cache holds, one at a time */
+	for (uint32_t i = 0U; i < 2U * CONFIG_DISK_CACHE_SECTORS; i++) {
+		fill(buf[0], i, 2);
+		zassert_equal(disk_access_write(DISK_NAME, buf[0], i, 1), 0,
+			      "Write failed");
+	}
+
+	zassert_equal(disk_access_ioctl(DISK_NAME, DISK_IOCTL_CTRL_SYNC, NULL),
+		      0, "Sync failed");
+
+	for (uint32_t i = 0U; i < 2U * CONFIG_DISK_CACHE_SECTORS; i++) {
+		check(ramdisk_buf[i], i, 2);
+	}
+
+	if (IS_ENABLED(CONFIG_DISK_CACHE_WRITE_BACK)) {
+		zassert_true(write_calls < 2 * CONFIG_DISK_CACHE_SECTORS,
+			     "Evicted sectors not coalesced");
+	}
+
+	/* A large write updates the cached copies */
+	for (uint32_t i = 0U; i < 16U; i++) {
+		fill(buf[i], i, 3);
+	}
+
+	zassert_equal(disk_access_write(DISK_NAME, buf[0], 0, 16), 0,
+		      "Write failed");
+	for (uint32_t i = 0U; i < 16U; i++) {
+		zassert_equal(disk_access_read(DISK_NAME, buf[16], i, 1), 0,
+			      "Read failed");
+		check(buf[16], i, 3);
+		check(ramdisk_buf[i], i, 3);
+	}
+}
+
+void test_main(void)
+{
+	ztest_test_suite(disk_cache,
+			 ztest_unit_test(test_init),
+			 ztest_unit_test(test_read_hit),
+			 ztest_unit_test(test_read_ahead),
+			 ztest_unit_test(test_read_large),
+			 ztest_unit_test(test_write),
+			 ztest_unit_test(test_write_evict));
+	ztest_run_test_suite(disk_cache);
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "fcb_test.h"
+
+struct walk_bulk_arg {
+	int cnt;
+	int from_buf;
+};
+
+static int fcb_test_bulk_walk_cb(struct fcb_entry_ctx *entry_ctx,
+				 const uint8_t *data, void *arg)
+{
+	struct walk_bulk_arg *wa = (struct walk_bulk_arg *)arg;
+	uint16_t len = entry_ctx->loc.fe_data_len;
+	uint8_t test_data[128];
+	int rc;
+
+	zassert_equal(len, wa->cnt % 128, "unexpected element");
+
+	if (data) {
+		wa->from_buf++;
+	} else {
+		rc = flash_area_read(entry_ctx->fap,
+				     FCB_ENTRY_FA_DATA_OFF(entry_ctx->loc),
+				     test_data, len);
+		zassert_true(rc == 0, "read call failure");
+		data = test_data;
+	}
+
+	for (int i = 0; i < len; i++) {
+		zassert_equal(data[i], fcb_test_append_data(len, i),
+			      "fcb_test_append_data redout misrepresentation");
+	}
+
+	wa->cnt++;
+	return 0;
+}
+
+void test_fcb_walk_bulk(void)
+{
+	struct walk_bulk_arg wa = { 0 };
+	struct fcb *fcb = &test_fcb;
+	struct fcb_entry loc;
+	uint8_t test_data[128];
+	uint8_t buf[64];
+	int rc;
+
+	/* Enough elements to spill over the second sector */
+	for (int n = 0; n < 3; n++) {
+		for (int i = 0; i < sizeof(test_data); i++) {
+			for (int j = 0; j < i; j++) {
+				test_data[j] = fcb_test_append_data(i, j);
+			}
+			rc = fcb_append(fcb, i, &loc);
+			zassert_true(rc == 0, "fcb_append call failure");
+			rc = flash_area_write(fcb->fap,
+					      FCB_ENTRY_FA_DATA_OFF(loc),
+					      test_data, i);
+			zassert_true(rc == 0, "flash_area_write call failure");
+			rc = fcb_append_finish(fcb, &loc);
+			zassert_true(rc == 0, "fcb_append_finish call failure");
+		}
+	}
+	zassert_true(fcb->f_active.fe_sector != fcb->f_oldest,
+		     "elements should take two sectors");
+
+	/* An element without a valid CRC is skipped */
+	rc = fcb_append(fcb, 0, &loc);
+	zassert_true(rc == 0, "fcb_append call failure");
+
+	wa.cnt = 0;
+	wa.from_buf = 0;
+	rc = fcb_walk_bulk(fcb, NULL, buf, sizeof(buf),
+			   fcb_test_bulk_walk_cb, &wa);
+	zassert_true(rc == 0, "fcb_walk_bulk call failure");
+	zassert_true(wa.from_buf > 0, "no element read in bulk");
+	zassert_equal(wa.cnt, 3 * sizeof(test_data), "missing elements");
+	zassert_true(wa.from_buf < wa.cnt,
+		     "large elements can not be read in bulk");
+
+	/* Only the elements of the sector */
+	wa.cnt = 0;
+	rc = fcb_walk_bulk(fcb, &test_fcb_sector[0], buf, sizeof(buf),
+			   fcb_test_bulk_walk_cb, &wa);
+	zassert_true(rc == 0, "fcb_walk_bulk call failure");
+	zassert_true(wa.cnt > 0 && wa.cnt < 3 * sizeof(test_data),
+		     "unexpected element count");
+}
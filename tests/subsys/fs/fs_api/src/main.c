@@ -69,6 +69,7 @@ void test_main(void)
 {
 	ztest_test_suite(fat_fs_basic_test,
 			 ztest_unit_test(test_fs_register),
+			 ztest_unit_test(test_mount_lookup),
 			 ztest_unit_test_setup_teardown(test_mount,
 							fs_setup,
 							dummy_teardown),
@@ -83,8 +84,11 @@ void test_main(void)
 			 ztest_unit_test(test_file_open),
 			 ztest_unit_test(test_file_write),
 			 ztest_unit_test(test_file_read),
+			 ztest_unit_test(test_file_readv_writev),
+			 ztest_unit_test(test_file_aio),
 			 ztest_unit_test(test_file_seek),
 			 ztest_unit_test(test_file_truncate),
+			 ztest_unit_test(test_file_allocate),
 			 ztest_unit_test(test_file_close),
 			 ztest_unit_test(test_file_sync),
 			 ztest_unit_test(test_file_rename),
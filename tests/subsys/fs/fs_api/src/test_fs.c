@@ -155,6 +155,7 @@ static int temp_seek(struct fs_file_t *zfp, off_t offset, int whence)
 		return -EINVAL;
 	}
 
+	read_pos = cur;
 	return 0;
 }
 
@@ -180,6 +181,10 @@ static int temp_truncate(struct fs_file_t *zfp, off_t length)
 	if (length > BUF_LEN) {
 		return -EINVAL;
 	}
+	if (length > file_length) {
+		memset(buffer + file_length, 0, length - file_length);
+	}
+
 	file_length = length;
 	return 0;
 }
@@ -38,6 +38,7 @@ void test_opendir_closedir(void);
 void test_fs_dir_t_init(void);
 void test_fs_file_t_init(void);
 void test_fs_register(void);
+void test_mount_lookup(void);
 void test_mount(void);
 void test_file_statvfs(void);
 void test_mkdir(void);
@@ -47,8 +48,11 @@ void test_lsdir(void);
 void test_file_open(void);
 void test_file_write(void);
 void test_file_read(void);
+void test_file_readv_writev(void);
+void test_file_aio(void);
 void test_file_seek(void);
 void test_file_truncate(void);
+void test_file_allocate(void);
 void test_file_close(void);
 void test_file_sync(void);
 void test_file_rename(void);
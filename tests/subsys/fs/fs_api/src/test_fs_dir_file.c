@@ -684,6 +684,139 @@ void test_file_read(void)
 	TC_PRINT("Data read matches data written\n");
 }
 
+/**
+ * @brief Test fs_writev() and fs_readv() interfaces in file system core
+ *
+ * @ingroup filesystem_api
+ */
+void test_file_readv_writev(void)
+{
+	char part1[5], part2[1], part3[20];
+	struct fs_iovec wr_iov[] = {
+		{ .base = (char *)test_str, .len = 5 },
+		{ .base = (char *)test_str + 5, .len = strlen(test_str) - 5 },
+	};
+	struct fs_iovec rd_iov[] = {
+		{ .base = part1, .len = sizeof(part1) },
+		{ .base = part2, .len = sizeof(part2) },
+		{ .base = part3, .len = sizeof(part3) },
+	};
+	ssize_t brw;
+
+	TC_PRINT("\nVectored tests:\n");
+
+	fs_file_t_init(&err_filep);
+	brw = fs_writev(&err_filep, wr_iov, ARRAY_SIZE(wr_iov));
+	zassert_equal(brw, -EBADF, "Can't write an unopened file");
+	brw = fs_readv(&err_filep, rd_iov, ARRAY_SIZE(rd_iov));
+	zassert_equal(brw, -EBADF, "Can't read an unopened file");
+
+	brw = fs_writev(&filep, wr_iov, ARRAY_SIZE(wr_iov));
+	zassert_equal(brw, strlen(test_str), "Fail to write file");
+
+	zassert_equal(fs_seek(&filep, -strlen(test_str), FS_SEEK_END), 0,
+		      "Fail to seek file");
+
+	/* The read is short in the last buffer, at the end of the file */
+	brw = fs_readv(&filep, rd_iov, ARRAY_SIZE(rd_iov));
+	zassert_equal(brw, strlen(test_str), "Fail to read file");
+	zassert_mem_equal(part1, test_str, sizeof(part1), NULL);
+	zassert_mem_equal(part2, test_str + 5, sizeof(part2), NULL);
+	zassert_mem_equal(part3, test_str + 6, strlen(test_str) - 6, NULL);
+
+	brw = fs_readv(&filep, rd_iov, ARRAY_SIZE(rd_iov));
+	zassert_equal(brw, 0, "Read past the end of the file");
+}
+
+#if defined(CONFIG_FILE_SYSTEM_AIO)
+static void aio_cb(struct fs_aio *aio, ssize_t result)
+{
+	int *calls = aio->user_data;
+
+	(*calls)++;
+}
+
+static ssize_t aio_wait(struct k_poll_signal *signal)
+{
+	struct k_poll_event event = K_POLL_EVENT_INITIALIZER(
+		K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, signal);
+	unsigned int signaled;
+	int result;
+
+	zassert_equal(k_poll(&event, 1, K_SECONDS(1)), 0,
+		      "Request did not complete");
+	k_poll_signal_check(signal, &signaled, &result);
+	k_poll_signal_reset(signal);
+
+	return result;
+}
+#endif
+
+/**
+ * @brief Test fs_aio_submit() interface in file system core
+ *
+ * @ingroup filesystem_api
+ */
+void test_file_aio(void)
+{
+#if defined(CONFIG_FILE_SYSTEM_AIO)
+	struct k_poll_signal wr_signal, sync_signal, rd_signal;
+	char read_buff[20];
+	struct fs_iovec wr_iov = {
+		.base = (char *)test_str, .len = strlen(test_str)
+	};
+	struct fs_iovec rd_iov = {
+		.base = read_buff, .len = sizeof(read_buff)
+	};
+	struct fs_aio wr = {
+		.zfp = &filep, .type = FS_AIO_WRITE, .iov = &wr_iov,
+		.iovcnt = 1, .signal = &wr_signal,
+	};
+	struct fs_aio rd = {
+		.zfp = &filep, .type = FS_AIO_READ, .iov = &rd_iov,
+		.iovcnt = 1, .signal = &rd_signal,
+	};
+	struct fs_aio sync = {
+		.zfp = &filep, .type = FS_AIO_SYNC, .signal = &sync_signal,
+	};
+	struct fs_aio err = {
+		.zfp = &err_filep, .type = FS_AIO_SYNC,
+	};
+	int calls = 0;
+
+	TC_PRINT("\nAsynchronous tests:\n");
+
+	fs_file_t_init(&err_filep);
+	zassert_equal(fs_aio_submit(&err), -EBADF,
+		      "Submitted a request on an unopened file");
+
+	k_poll_signal_init(&wr_signal);
+	k_poll_signal_init(&sync_signal);
+	k_poll_signal_init(&rd_signal);
+	wr.cb = aio_cb;
+	wr.user_data = &calls;
+
+	/* Both requests are queued before the write has run */
+	zassert_equal(fs_aio_submit(&wr), 0, "Fail to submit write");
+	zassert_equal(fs_aio_submit(&sync), 0, "Fail to submit sync");
+
+	zassert_equal(aio_wait(&sync_signal), 0, "Fail to sync file");
+	zassert_equal(wr.result, strlen(test_str), "Fail to write file");
+	zassert_equal(aio_wait(&wr_signal), strlen(test_str), NULL);
+	zassert_equal(calls, 1, "Callback not called");
+
+	zassert_equal(fs_seek(&filep, -strlen(test_str), FS_SEEK_END), 0,
+		      "Fail to seek file");
+	zassert_equal(fs_aio_submit(&rd), 0, "Fail to submit read");
+	zassert_equal(aio_wait(&rd_signal), strlen(test_str),
+		      "Fail to read file");
+	zassert_mem_equal(read_buff, test_str, strlen(test_str),
+			  "Data read does not match data written");
+#else
+	ztest_test_skip();
+#endif
+}
+
 /**
  * @brief fs_seek tests for expected ENOTSUP
  *
@@ -867,6 +1000,21 @@ void test_file_truncate(void)
 	zassert_true(_test_file_truncate() == TC_PASS, NULL);
 }
 
+/**
+ * @brief Test fs_allocate() interface in file system core
+ *
+ * @ingroup filesystem_api
+ */
+void test_file_allocate(void)
+{
+	fs_file_t_init(&err_filep);
+	zassert_equal(fs_allocate(&err_filep, 1024), -EBADF,
+		      "Can't allocate an unopened file");
+
+	zassert_equal(fs_allocate(&filep, 1024), -ENOTSUP,
+		      "File system has no allocate interface");
+}
+
 /**
  * @brief Test close file interface in file system core
  *
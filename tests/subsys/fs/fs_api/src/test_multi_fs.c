@@ -112,6 +112,39 @@ static int test_fs_external(void)
 	return 0;
 }
 
+
+static K_SEM_DEFINE(slow_mount_sem, 0, 1);
+static K_THREAD_STACK_DEFINE(slow_mount_stack, 1024);
+static struct k_thread slow_mount_thread;
+static int slow_mount_result;
+
+/* A mount which only completes once the test lets it */
+static int slow_mount(struct fs_mount_t *mountp)
+{
+	k_sem_take(&slow_mount_sem, K_FOREVER);
+	return 0;
+}
+
+static int slow_unmount(struct fs_mount_t *mountp)
+{
+	return 0;
+}
+
+static struct fs_file_system_t slow_fs = {
+	.mount = slow_mount,
+	.unmount = slow_unmount,
+};
+
+static struct fs_mount_t slow_fs_mnt = {
+		.type = TEST_FS_2,
+		.mnt_point = "/SLOW:",
+};
+
+static void slow_mount_entry(void *p1, void *p2, void *p3)
+{
+	slow_mount_result = fs_mount(&slow_fs_mnt);
+}
+
 /**
  * @brief Multi file systems register and unregister
  *
@@ -131,6 +164,46 @@ void test_fs_register(void)
 	zassert_true(test_fs_deinit() == 0, "Failed to unregister filesystems");
 }
 
+/**
+ * @brief Look up mount points while another file system is being mounted
+ *
+ * @details
+ *  The operations on a mounted file system do not wait for the mount
+ *  of another one.
+ */
+void test_mount_lookup(void)
+{
+	struct fs_dirent entry;
+
+	zassert_equal(fs_register(TEST_FS_1, &temp_fs), 0,
+		      "Failed to register file system");
+	zassert_equal(fs_mount(&test_fs_mnt_1), 0, "Failed to mount");
+	zassert_equal(fs_register(TEST_FS_2, &slow_fs), 0,
+		      "Failed to register file system");
+
+	k_thread_create(&slow_mount_thread, slow_mount_stack,
+			K_THREAD_STACK_SIZEOF(slow_mount_stack),
+			slow_mount_entry, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	k_sleep(K_MSEC(10));
+
+	zassert_equal(fs_stat(TEST_FS_NAND1 "/file", &entry), 0,
+		      "Lookup failed during a mount");
+	zassert_equal(fs_stat("/SLOW:/file", &entry), -ENOENT,
+		      "File system found before its mount completed");
+
+	k_sem_give(&slow_mount_sem);
+	k_thread_join(&slow_mount_thread, K_FOREVER);
+	zassert_equal(slow_mount_result, 0, "Slow mount failed");
+
+	zassert_equal(fs_unmount(&slow_fs_mnt), 0, "Failed to unmount");
+	zassert_equal(fs_unmount(&test_fs_mnt_1), 0, "Failed to unmount");
+	zassert_equal(fs_unregister(TEST_FS_2, &slow_fs), 0,
+		      "Failed to unregister file system");
+	zassert_equal(fs_unregister(TEST_FS_1, &temp_fs), 0,
+		      "Failed to unregister file system");
+}
+
 /**
  * @}
  */
@@ -706,6 +706,365 @@ void test_nvs_gc_corrupt_ate(void)
 	zassert_true(err == 0,  "nvs_init call failure: %d", err);
 }
 
+void test_nvs_write_batch(void)
+{
+	int err;
+	uint16_t data[3] = { 10, 20, 30 };
+	uint16_t rd_data;
+	uint32_t sector;
+	uint16_t gc_count = 0U;
+	const struct nvs_batch_entry entries[] = {
+		{ .id = 1, .data = &data[0], .len = sizeof(data[0]) },
+		{ .id = 2, .data = &data[1], .len = sizeof(data[1]) },
+		{ .id = 3, .data = &data[2], .len = sizeof(data[2]) },
+	};
+	const struct nvs_batch_entry update[] = {
+		{ .id = 1, .data = &data[2], .len = sizeof(data[2]) },
+		{ .id = 2, .data = NULL, .len = 0 },
+	};
+
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+
+	err = nvs_write_batch(&fs, entries, ARRAY_SIZE(entries));
+	zassert_true(err == 0,  "nvs_write_batch call failure: %d", err);
+
+	for (int i = 0; i < ARRAY_SIZE(entries); i++) {
+		err = nvs_read(&fs, entries[i].id, &rd_data, sizeof(rd_data));
+		zassert_equal(err, sizeof(rd_data),
+			      "nvs_read call failure: %d", err);
+		zassert_equal(rd_data, data[i], "Wrong data read");
+	}
+
+	err = nvs_write_batch(&fs, update, ARRAY_SIZE(update));
+	zassert_true(err == 0,  "nvs_write_batch call failure: %d", err);
+
+	err = nvs_read(&fs, 1, &rd_data, sizeof(rd_data));
+	zassert_equal(err, sizeof(rd_data), "nvs_read call failure: %d", err);
+	zassert_equal(rd_data, data[2], "Wrong data read");
+
+	err = nvs_read(&fs, 2, &rd_data, sizeof(rd_data));
+	zassert_equal(err, -ENOENT, "Deleted entry read: %d", err);
+
+	/* Survives a remount and a garbage collection of the entries */
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+
+	sector = fs.ate_wra >> ADDR_SECT_SHIFT;
+	for (uint16_t i = 0U; gc_count < fs.sector_count; i++) {
+		err = nvs_write(&fs, 4, &i, sizeof(i));
+		zassert_equal(err, sizeof(i), "nvs_write call failure: %d", err);
+
+		if ((fs.ate_wra >> ADDR_SECT_SHIFT) != sector) {
+			sector = fs.ate_wra >> ADDR_SECT_SHIFT;
+			gc_count++;
+		}
+	}
+
+	err = nvs_read(&fs, 1, &rd_data, sizeof(rd_data));
+	zassert_equal(err, sizeof(rd_data), "nvs_read call failure: %d", err);
+	zassert_equal(rd_data, data[2], "Wrong data read");
+
+	err = nvs_read(&fs, 2, &rd_data, sizeof(rd_data));
+	zassert_equal(err, -ENOENT, "Deleted entry read: %d", err);
+
+	err = nvs_read(&fs, 3, &rd_data, sizeof(rd_data));
+	zassert_equal(err, sizeof(rd_data), "nvs_read call failure: %d", err);
+	zassert_equal(rd_data, data[2], "Wrong data read");
+}
+
+/*
+ * Test that a batch interrupted by a power loss is dropped as a whole.
+ */
+void test_nvs_write_batch_interrupted(void)
+{
+	int err;
+	uint16_t data[3] = { 10, 20, 30 };
+	uint16_t rd_data;
+	uint32_t *flash_write_stat;
+	uint32_t *flash_max_write_calls;
+	const struct nvs_batch_entry entries[] = {
+		{ .id = 1, .data = &data[0], .len = sizeof(data[0]) },
+		{ .id = 2, .data = &data[1], .len = sizeof(data[1]) },
+		{ .id = 3, .data = &data[2], .len = sizeof(data[2]) },
+	};
+
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+
+	err = nvs_write(&fs, 1, &data[2], sizeof(data[2]));
+	zassert_equal(err, sizeof(data[2]), "nvs_write call failure: %d", err);
+
+	stats_walk(sim_thresholds, flash_sim_max_write_calls_find,
+		   &flash_max_write_calls);
+	stats_walk(sim_stats, flash_sim_write_calls_find, &flash_write_stat);
+
+	/* Only the data and ate of the first two entries reach the flash */
+	*flash_max_write_calls = 4;
+	*flash_write_stat = 0;
+
+	err = nvs_write_batch(&fs, entries, ARRAY_SIZE(entries));
+	zassert_true(err == 0,  "nvs_write_batch call failure: %d", err);
+
+	*flash_max_write_calls = 0;
+
+	/* Reinitialize the NVS. */
+	memset(&fs, 0, sizeof(fs));
+	test_nvs_init();
+
+	err = nvs_read(&fs, 1, &rd_data, sizeof(rd_data));
+	zassert_equal(err, sizeof(rd_data), "nvs_read call failure: %d", err);
+	zassert_equal(rd_data, data[2], "Entry of interrupted batch read");
+
+	err = nvs_read(&fs, 2, &rd_data, sizeof(rd_data));
+	zassert_equal(err, -ENOENT, "Entry of interrupted batch read: %d",
+		      err);
+
+	/* The next write does not complete the batch */
+	err = nvs_write(&fs, 4, &data[0], sizeof(data[0]));
+	zassert_equal(err, sizeof(data[0]), "nvs_write call failure: %d", err);
+
+	err = nvs_read(&fs, 2, &rd_data, sizeof(rd_data));
+	zassert_equal(err, -ENOENT, "Entry of interrupted batch read: %d",
+		      err);
+
+	err = nvs_read(&fs, 1, &rd_data, sizeof(rd_data));
+	zassert_equal(err, sizeof(rd_data), "nvs_read call failure: %d", err);
+	zassert_equal(rd_data, data[2], "Entry of interrupted batch read");
+}
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+static size_t num_matching_cache_entries(uint32_t addr, bool compare_sector_only)
+{
+	uint32_t mask = compare_sector_only ? ADDR_SECT_MASK : UINT32_MAX;
+	size_t num = 0;
+
+	for (int i = 0; i < CONFIG_NVS_LOOKUP_CACHE_SIZE; i++) {
+		if ((fs.lookup_cache[i] & mask) == addr) {
+			num++;
+		}
+	}
+
+	return num;
+}
+#endif
+
+/*
+ * Test that the lookup cache holds the address of the last ATE of an ID
+ * after the file system is mounted.
+ */
+void test_nvs_cache_init(void)
+{
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	int err;
+	size_t num;
+	uint32_t ate_addr;
+	uint8_t data = 0;
+	struct nvs_ate ate;
+
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+
+	num = num_matching_cache_entries(NVS_LOOKUP_CACHE_NO_ADDR, false);
+	zassert_equal(num, CONFIG_NVS_LOOKUP_CACHE_SIZE,
+		      "Cache should be empty");
+
+	ate_addr = fs.ate_wra;
+	err = nvs_write(&fs, 1, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	zassert_equal(fs.lookup_cache[1], ate_addr,
+		      "Cache entry of ID 1 not set");
+
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+	zassert_equal(fs.lookup_cache[1], ate_addr,
+		      "Cache entry of ID 1 not rebuilt");
+
+	num = num_matching_cache_entries(NVS_LOOKUP_CACHE_NO_ADDR, false);
+	zassert_equal(num, CONFIG_NVS_LOOKUP_CACHE_SIZE - 1,
+		      "Only ID 1 should be cached");
+
+	err = flash_read(fs.flash_device, fs.offset +
+			 fs.sector_size * (ate_addr >> ADDR_SECT_SHIFT) +
+			 (ate_addr & ADDR_OFFS_MASK), &ate, sizeof(ate));
+	zassert_true(err == 0,  "flash_read failed: %d", err);
+	zassert_equal(ate.id, 1, "Cached ATE is not the one of ID 1");
+#else
+	ztest_test_skip();
+#endif
+}
+
+/*
+ * Test IDs sharing an entry of the lookup cache.
+ */
+void test_nvs_cache_collision(void)
+{
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	const uint16_t step = CONFIG_NVS_LOOKUP_CACHE_SIZE;
+	int err;
+	uint16_t id;
+	uint16_t data;
+
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+
+	for (id = 0; id < 3 * step; id += step) {
+		err = nvs_write(&fs, id, &id, sizeof(id));
+		zassert_equal(err, sizeof(id), "nvs_write call failure: %d",
+			      err);
+	}
+
+	for (id = 0; id < 3 * step; id += step) {
+		err = nvs_read(&fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_read call failure: %d",
+			      err);
+		zassert_equal(data, id, "Wrong data read for ID %u", id);
+	}
+
+	err = nvs_delete(&fs, step);
+	zassert_true(err == 0,  "nvs_delete call failure: %d", err);
+
+	err = nvs_read(&fs, step, &data, sizeof(data));
+	zassert_equal(err, -ENOENT, "Deleted entry still read: %d", err);
+
+	err = nvs_read(&fs, 0, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+	zassert_equal(data, 0, "Wrong data read for ID 0");
+#else
+	ztest_test_skip();
+#endif
+}
+
+/*
+ * Test that the lookup cache follows the entries moved by the garbage
+ * collection, and forgets the erased ones.
+ */
+void test_nvs_cache_gc(void)
+{
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	int err;
+	size_t num;
+	uint16_t data;
+	uint16_t sector;
+	uint16_t gc_count = 0U;
+
+	fs.sector_count = 2;
+
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+
+	/* ID 1 is written once, and moved by each garbage collection */
+	data = 1U;
+	err = nvs_write(&fs, 1, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+
+	sector = fs.ate_wra >> ADDR_SECT_SHIFT;
+
+	for (data = 0U; gc_count < 3; data++) {
+		err = nvs_write(&fs, 2, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d",
+			      err);
+
+		if ((fs.ate_wra >> ADDR_SECT_SHIFT) != sector) {
+			sector = fs.ate_wra >> ADDR_SECT_SHIFT;
+			gc_count++;
+		}
+	}
+
+	/* The sector after the write sector is the one erased last */
+	sector = (sector + 1) % fs.sector_count;
+	num = num_matching_cache_entries(sector << ADDR_SECT_SHIFT, true);
+	zassert_equal(num, 0, "Cache entries point to an erased sector");
+
+	err = nvs_read(&fs, 1, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+	zassert_equal(data, 1, "Wrong data read for ID 1");
+
+	err = nvs_delete(&fs, 2);
+	zassert_true(err == 0,  "nvs_delete call failure: %d", err);
+
+	err = nvs_read(&fs, 2, &data, sizeof(data));
+	zassert_equal(err, -ENOENT, "Deleted entry still read: %d", err);
+#else
+	ztest_test_skip();
+#endif
+}
+
+/*
+ * Test that the sector released by the garbage collection is not read
+ * while its erase is pending, and is erased in the background.
+ */
+void test_nvs_background_gc(void)
+{
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	int err;
+	uint16_t data;
+	uint32_t sector;
+	uint32_t erase_sector;
+	off_t offset;
+	uint8_t buf[16];
+
+	fs.sector_count = 2;
+
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+
+	/* ID 1 is written once, and moved by the garbage collection */
+	data = 1U;
+	err = nvs_write(&fs, 1, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+
+	/* Hold the erase back: the lock is recursive for this thread */
+	k_mutex_lock(&fs.nvs_lock, K_FOREVER);
+
+	sector = fs.ate_wra >> ADDR_SECT_SHIFT;
+	for (data = 0U; (fs.ate_wra >> ADDR_SECT_SHIFT) == sector; data++) {
+		err = nvs_write(&fs, 2, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d",
+			      err);
+	}
+
+	zassert_not_equal(fs.gc_erase_addr, NVS_GC_ERASE_NONE,
+			  "Erase of the released sector not pending");
+	erase_sector = fs.gc_erase_addr >> ADDR_SECT_SHIFT;
+	zassert_equal(erase_sector, sector, "Wrong sector released");
+
+	err = nvs_read(&fs, 1, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+	zassert_equal(data, 1, "Wrong data read for ID 1");
+
+	/* The released sector still holds the first write of ID 1 */
+	err = nvs_read_hist(&fs, 1, &data, sizeof(data), 1);
+	zassert_equal(err, -ENOENT, "Entry of released sector read: %d", err);
+
+	k_mutex_unlock(&fs.nvs_lock);
+	k_msleep(10);
+
+	zassert_equal(fs.gc_erase_addr, NVS_GC_ERASE_NONE,
+		      "Released sector not erased");
+
+	offset = fs.offset + fs.sector_size * erase_sector;
+	for (int i = 0; i < fs.sector_size; i += sizeof(buf)) {
+		err = flash_read(fs.flash_device, offset + i, buf, sizeof(buf));
+		zassert_true(err == 0,  "flash_read failed: %d", err);
+
+		for (int j = 0; j < sizeof(buf); j++) {
+			zassert_equal(buf[j],
+				      fs.flash_parameters->erase_value,
+				      "Released sector not erased");
+		}
+	}
+
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+
+	err = nvs_read(&fs, 2, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_nvs,
@@ -729,7 +1088,20 @@ void test_main(void)
 			 ztest_unit_test_setup_teardown(
 				 test_nvs_gc_corrupt_close_ate, setup, teardown),
 			 ztest_unit_test_setup_teardown(
-				 test_nvs_gc_corrupt_ate, setup, teardown)
+				 test_nvs_gc_corrupt_ate, setup, teardown),
+			 ztest_unit_test_setup_teardown(
+				 test_nvs_write_batch, setup, teardown),
+			 ztest_unit_test_setup_teardown(
+				 test_nvs_write_batch_interrupted, setup,
+				 teardown),
+			 ztest_unit_test_setup_teardown(
+				 test_nvs_cache_init, setup, teardown),
+			 ztest_unit_test_setup_teardown(
+				 test_nvs_cache_collision, setup, teardown),
+			 ztest_unit_test_setup_teardown(
+				 test_nvs_cache_gc, setup, teardown),
+			 ztest_unit_test_setup_teardown(
+				 test_nvs_background_gc, setup, teardown)
 			);
 
 	ztest_run_test_suite(test_nvs);
@@ -237,6 +237,48 @@ void test_log_message_with_string(void)
 		cyc / repeat, us / repeat);
 }
 
+/* Compare logging a message with string arguments, packaged with the
+ * string locations found at compile time, to packaging it at runtime.
+ */
+void test_log_message_string_args(void)
+{
+	char strbuf[] = "test string";
+	uint32_t cyc;
+	uint32_t runtime_cyc;
+	int repeat = 8;
+
+	if (!IS_ENABLED(CONFIG_LOG2)) {
+		return;
+	}
+
+	test_helpers_log_setup();
+	cyc = test_helpers_cycle_get();
+
+	for (int i = 0; i < repeat; i++) {
+		LOG_ERR("test with string arguments: %s %d %s", strbuf, i,
+			"constant");
+	}
+
+	cyc = test_helpers_cycle_get() - cyc;
+
+	test_helpers_log_setup();
+	runtime_cyc = test_helpers_cycle_get();
+
+	for (int i = 0; i < repeat; i++) {
+		z_log_msg2_runtime_create(CONFIG_LOG_DOMAIN_ID,
+				__log_current_const_data, LOG_LEVEL_ERR,
+				NULL, 0, "test with string arguments: %s %d %s",
+				strbuf, i, "constant");
+	}
+
+	runtime_cyc = test_helpers_cycle_get() - runtime_cyc;
+
+	PRINT("logging with string arguments %u cycles (%u us), "
+	      "runtime packaging %u cycles (%u us).\n",
+	      cyc / repeat, k_cyc_to_us_ceil32(cyc) / repeat,
+	      runtime_cyc / repeat, k_cyc_to_us_ceil32(runtime_cyc) / repeat);
+}
+
 /*test case main entry*/
 void test_main(void)
 {
@@ -254,7 +296,8 @@ void test_main(void)
 			 ztest_unit_test(test_log_message_store_time_no_overwrite),
 			 ztest_unit_test(test_log_message_store_time_overwrite),
 			 ztest_user_unit_test(test_log_message_store_time_no_overwrite_from_user),
-			 ztest_user_unit_test(test_log_message_with_string)
+			 ztest_user_unit_test(test_log_message_with_string),
+			 ztest_unit_test(test_log_message_string_args)
 			 );
 	ztest_run_test_suite(test_log_benchmark);
 }
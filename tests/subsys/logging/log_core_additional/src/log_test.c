@@ -205,6 +205,58 @@ static void test_log_sync(void)
 	}
 }
 
+static void log_flood(int count)
+{
+	for (int i = 0; i < count; i++) {
+		LOG_INF("flood %d", i);
+	}
+}
+
+/**
+ * @brief Rate limiting of log messages
+ *
+ * @details A call site logging in a loop is limited to the burst, then to
+ *          the rate. The next message which passes is preceded by the
+ *          report of the suppressed ones.
+ *
+ * @addtogroup logging
+ */
+
+static void test_log_ratelimit(void)
+{
+	if (!IS_ENABLED(CONFIG_LOG_RATELIMIT)) {
+		ztest_test_skip();
+		return;
+	}
+
+	log_setup(false);
+
+	zassert_equal(log_ratelimit_set(1, 3), 0, "Unexpected error");
+
+	backend1_cb.total_logs = 3;
+	log_flood(10);
+
+	while (log_test_process(false)) {
+	}
+
+	zassert_equal(backend1_cb.total_logs, backend1_cb.counter,
+		      "Unexpected amount of messages received by the backend.");
+
+	/* One message per second, after the report of the 7 suppressed. */
+	k_msleep(1000);
+	backend1_cb.counter = 0;
+	backend1_cb.total_logs = 2;
+	log_flood(1);
+
+	while (log_test_process(false)) {
+	}
+
+	zassert_equal(backend1_cb.total_logs, backend1_cb.counter,
+		      "Unexpected amount of messages received by the backend.");
+
+	zassert_equal(log_ratelimit_set(0, 1), 0, "Unexpected error");
+}
+
 /**
  * @brief Early logging
  * @details Handle log message attempts as well as creating new log contexts
@@ -450,6 +502,7 @@ void test_main(void)
 			 ztest_unit_test(test_log_timestamping),
 			 ztest_unit_test(test_log_early_logging),
 			 ztest_unit_test(test_log_sync),
+			 ztest_unit_test(test_log_ratelimit),
 			 ztest_unit_test(test_log_thread));
 	ztest_run_test_suite(test_log_list);
 }
@@ -240,6 +240,40 @@ void test_log_msg2_various_args(void)
 				   NULL, 0, str);
 }
 
+void test_log_msg2_strings(void)
+{
+#undef TEST_MSG
+#define TEST_MSG "%s %d %s"
+	static const uint8_t domain = 3;
+	static const uint8_t level = 2;
+	const void *source = (const void *)123;
+	int mode;
+	char rw_str[] = "transient";
+	static const char *ro_str = "constant";
+	char str[256];
+
+	test_init();
+
+	Z_LOG_MSG2_CREATE2(1, mode, 0, domain, source, level, NULL, 0,
+			TEST_MSG, rw_str, 100, ro_str);
+	zassert_equal(mode, EXP_MODE(FROM_STACK), NULL);
+
+	Z_LOG_MSG2_CREATE2(0, mode, 0, domain, source, level, NULL, 0,
+			TEST_MSG, rw_str, 100, ro_str);
+	zassert_equal(mode, EXP_MODE(FROM_STACK), NULL);
+
+	z_log_msg2_runtime_create(domain, (void *)source, level, NULL,
+				  0, TEST_MSG, rw_str, 100, ro_str);
+
+	snprintfcb(str, sizeof(str), TEST_MSG, rw_str, 100, ro_str);
+	/* Transient string must have been copied into the messages. */
+	memset(rw_str, 'x', sizeof(rw_str) - 1);
+
+	validate_base_message_set(source, domain, level,
+				   TEST_TIMESTAMP_INIT_VALUE,
+				   NULL, 0, str);
+}
+
 void test_log_msg2_only_data(void)
 {
 	static const uint8_t domain = 3;
@@ -494,19 +528,20 @@ void test_mode_size_str_with_2strings(void)
 			   1 /* accept one string pointer*/,
 			   domain, source, level,
 			   NULL, 0, TEST_STR, prefix, "sufix");
-	zassert_equal(mode, EXP_MODE(RUNTIME),
+	zassert_equal(mode, EXP_MODE(FROM_STACK),
 			"Unexpected creation mode");
 	Z_LOG_MSG2_CREATE2(0, mode,
 			   1 /* accept one string pointer*/,
 			   domain, source, level,
 			   NULL, 0, TEST_STR, prefix, "sufix");
-	zassert_equal(mode, EXP_MODE(RUNTIME),
+	zassert_equal(mode, EXP_MODE(FROM_STACK),
 			"Unexpected creation mode");
 
 	/* Calculate expected message length. Message consists of:
 	 * - header
 	 * - package: header + fmt pointer + 2 pointers (on some platforms
-	 *   strings are included in the package)
+	 *   string arguments are included in the package, the format string
+	 *   is also included when the package is created at runtime)
 	 *
 	 * Message size is rounded up to the required alignment.
 	 */
@@ -514,8 +549,10 @@ void test_mode_size_str_with_2strings(void)
 			 /* package */4 * sizeof(const char *);
 	if (TEST_LOG_MSG2_RW_STRINGS) {
 		exp_len += strlen("sufix") + 2 /* null + header */ +
-			  strlen(prefix) + 2 /* null + header */+
-			  strlen(TEST_STR) + 2 /* null + header */;
+			  strlen(prefix) + 2 /* null + header */;
+		if (mode == Z_LOG_MSG2_MODE_RUNTIME) {
+			exp_len += strlen(TEST_STR) + 2 /* null + header */;
+		}
 	}
 
 	exp_len = ROUND_UP(exp_len, Z_LOG_MSG2_ALIGNMENT) / sizeof(int);
@@ -575,6 +612,7 @@ void test_main(void)
 	ztest_test_suite(test_log_msg2,
 		ztest_unit_test(test_log_msg2_0_args_msg),
 		ztest_unit_test(test_log_msg2_various_args),
+		ztest_unit_test(test_log_msg2_strings),
 		ztest_unit_test(test_log_msg2_only_data),
 		ztest_unit_test(test_log_msg2_string_and_data),
 		ztest_unit_test(test_log_msg2_fp),
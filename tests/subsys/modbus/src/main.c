@@ -15,6 +15,7 @@ void test_main(void)
 			 ztest_unit_test(test_di_rd),
 			 ztest_unit_test(test_input_reg),
 			 ztest_unit_test(test_holding_reg),
+			 ztest_unit_test(test_reg_map),
 			 ztest_unit_test(test_diagnostic),
 			 ztest_unit_test(test_client_disable),
 			 ztest_unit_test(test_server_disable),
@@ -24,6 +25,7 @@ void test_main(void)
 			 ztest_unit_test(test_di_rd),
 			 ztest_unit_test(test_input_reg),
 			 ztest_unit_test(test_holding_reg),
+			 ztest_unit_test(test_reg_map),
 			 ztest_unit_test(test_diagnostic),
 			 ztest_unit_test(test_client_disable),
 			 ztest_unit_test(test_server_disable),
@@ -33,6 +35,7 @@ void test_main(void)
 			 ztest_unit_test(test_di_rd),
 			 ztest_unit_test(test_input_reg),
 			 ztest_unit_test(test_holding_reg),
+			 ztest_unit_test(test_reg_map),
 			 ztest_unit_test(test_diagnostic),
 			 ztest_unit_test(test_client_disable),
 			 ztest_unit_test(test_server_disable),
@@ -42,6 +45,7 @@ void test_main(void)
 			 ztest_unit_test(test_di_rd),
 			 ztest_unit_test(test_input_reg),
 			 ztest_unit_test(test_holding_reg),
+			 ztest_unit_test(test_reg_map),
 			 ztest_unit_test(test_diagnostic),
 			 ztest_unit_test(test_client_disable),
 			 ztest_unit_test(test_server_disable),
@@ -51,6 +55,7 @@ void test_main(void)
 			 ztest_unit_test(test_di_rd),
 			 ztest_unit_test(test_input_reg),
 			 ztest_unit_test(test_holding_reg),
+			 ztest_unit_test(test_reg_map),
 			 ztest_unit_test(test_diagnostic),
 			 ztest_unit_test(test_client_disable),
 			 ztest_unit_test(test_server_disable)
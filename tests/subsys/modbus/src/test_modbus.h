@@ -17,6 +17,7 @@
 #define MB_TEST_RESPONSE_TO	50000
 #define MB_TEST_NODE_ADDR	0x01
 #define MB_TEST_FP_OFFSET	5000
+#define MB_TEST_REG_MAP_OFFSET	1000
 
 /*
  * Integration platform for this test is FRDM-K64F.
@@ -44,6 +45,7 @@ void test_coil_wr_rd(void);
 void test_di_rd(void);
 void test_input_reg(void);
 void test_holding_reg(void);
+void test_reg_map(void);
 void test_diagnostic(void);
 void test_client_disable(void);
 
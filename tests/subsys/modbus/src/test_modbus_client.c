@@ -188,6 +188,49 @@ void test_holding_reg(void)
 		      "FC16FP verify failed");
 }
 
+void test_reg_map(void)
+{
+	const uint16_t offset = MB_TEST_REG_MAP_OFFSET;
+	uint16_t hr_wr[8] = {0x1234, 0, 0xffff, 3, 0x8000, 5, 6, 0xcafe};
+	uint16_t hr_rd[8] = {0};
+	uint16_t ir_rd[8] = {0};
+	int err;
+
+	/* Test FC16 | FC03 */
+	err = modbus_write_holding_regs(client_iface, node, offset,
+					hr_wr, ARRAY_SIZE(hr_wr));
+	zassert_equal(err, 0, "FC16 write request failed");
+
+	err = modbus_read_holding_regs(client_iface, node, offset,
+				       hr_rd, ARRAY_SIZE(hr_rd));
+	zassert_equal(err, 0, "FC03 read request failed");
+	zassert_equal(memcmp(hr_wr, hr_rd, sizeof(hr_wr)), 0,
+		      "FC16 verify failed");
+
+	/* Test FC06 | FC04, the map input registers are inverted */
+	err = modbus_write_holding_reg(client_iface, node, offset + 1, 0x5a5a);
+	zassert_equal(err, 0, "FC06 write request failed");
+	hr_wr[1] = 0x5a5a;
+
+	err = modbus_read_input_regs(client_iface, node, offset,
+				     ir_rd, ARRAY_SIZE(ir_rd));
+	zassert_equal(err, 0, "FC04 read request failed");
+
+	for (uint16_t idx = 0; idx < ARRAY_SIZE(ir_rd); idx++) {
+		zassert_equal(ir_rd[idx], (uint16_t)~hr_wr[idx],
+			      "FC04 verify failed");
+	}
+
+	/* Requests starting in the map must not go past its end */
+	err = modbus_read_holding_regs(client_iface, node, offset + 1,
+				       hr_rd, ARRAY_SIZE(hr_rd));
+	zassert_not_equal(err, 0, "FC03 out of range request not failed");
+
+	err = modbus_write_holding_regs(client_iface, node, offset + 1,
+					hr_wr, ARRAY_SIZE(hr_wr));
+	zassert_not_equal(err, 0, "FC16 out of range request not failed");
+}
+
 void test_diagnostic(void)
 {
 	uint16_t data = 0xcafe;
@@ -335,6 +378,11 @@ void test_holding_reg(void)
 	ztest_test_skip();
 }
 
+void test_reg_map(void)
+{
+	ztest_test_skip();
+}
+
 void test_diagnostic(void)
 {
 	ztest_test_skip();
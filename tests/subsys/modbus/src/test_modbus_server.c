@@ -13,6 +13,7 @@ const static uint16_t fp_offset = MB_TEST_FP_OFFSET;
 static uint16_t coils;
 static uint16_t holding_reg[8];
 static float holding_fp[4];
+static uint16_t map_reg[8];
 
 uint8_t server_iface;
 
@@ -171,10 +172,36 @@ static struct modbus_user_callbacks mbs_cbs = {
 	.holding_reg_wr_fp = holding_reg_wr_fp,
 };
 
+/* Input registers of the map, the holding ones bit inverted */
+static int map_inreg_rd(const struct modbus_reg_block *block, uint16_t addr,
+			uint16_t *regs, uint16_t num_regs)
+{
+	for (uint16_t i = 0; i < num_regs; i++) {
+		regs[i] = ~map_reg[addr - block->addr + i];
+	}
+
+	LOG_DBG("Map input registers read, addr %u, %u", addr, num_regs);
+
+	return 0;
+}
+
+static const struct modbus_reg_block reg_map[] = {
+	MODBUS_REG_BLOCK_ARRAY(MODBUS_REG_HOLDING, MB_TEST_REG_MAP_OFFSET,
+			       map_reg),
+	{
+		.type = MODBUS_REG_INPUT,
+		.addr = MB_TEST_REG_MAP_OFFSET,
+		.count = ARRAY_SIZE(map_reg),
+		.read = map_inreg_rd,
+	},
+};
+
 static struct modbus_iface_param server_param = {
 	.mode = MODBUS_MODE_RTU,
 	.server = {
 		.user_cb = &mbs_cbs,
+		.reg_map = reg_map,
+		.reg_map_size = ARRAY_SIZE(reg_map),
 		.unit_id = MB_TEST_NODE_ADDR,
 	},
 	.serial = {
@@ -164,6 +164,86 @@ void test_sync(void)
 	zassert_true(dev->pm->state == PM_DEVICE_STATE_SUSPEND, "Wrong state");
 }
 
+/*
+ * @brief test device runtime autosuspend delay
+ *
+ * @details
+ *  - An asynchronous release only suspends the device after the delay.
+ *  - A new usage within the delay keeps the device active.
+ *
+ * @see pm_device_autosuspend_delay_set(), pm_device_put_async()
+ *
+ * @ingroup power_tests
+ */
+void test_autosuspend(void)
+{
+	int ret;
+
+	pm_device_autosuspend_delay_set(dev, K_MSEC(100));
+
+	ret = api->open_sync(dev);
+	zassert_true(ret == 0, "Fail to bring up device");
+
+	ret = api->close(dev);
+	zassert_true(ret == 0, "Fail to release device");
+
+	k_msleep(10);
+	zassert_true(dev->pm->state == PM_DEVICE_STATE_ACTIVE, "Wrong state");
+
+	/* Used again before the delay, the suspend is cancelled */
+	ret = api->open_sync(dev);
+	zassert_true(ret == 0, "Fail to bring up device");
+
+	k_msleep(150);
+	zassert_true(dev->pm->state == PM_DEVICE_STATE_ACTIVE, "Wrong state");
+
+	ret = api->close(dev);
+	zassert_true(ret == 0, "Fail to release device");
+
+	ret = api->wait(dev);
+	zassert_true(ret == 0, "Fail to wait transaction");
+
+	zassert_true(dev->pm->state == PM_DEVICE_STATE_SUSPEND, "Wrong state");
+
+	pm_device_autosuspend_delay_set(dev, K_NO_WAIT);
+}
+
+/*
+ * @brief test device runtime batch API
+ *
+ * @see pm_device_get_many(), pm_device_put_many()
+ *
+ * @ingroup power_tests
+ */
+void test_many(void)
+{
+	const struct device *devs[CONFIG_PM_DEVICE_RUNTIME_BATCH_MAX + 1];
+	int ret;
+
+	for (int i = 0; i < ARRAY_SIZE(devs); i++) {
+		devs[i] = dev;
+	}
+
+	ret = pm_device_get_many(devs, ARRAY_SIZE(devs));
+	zassert_equal(ret, -EINVAL, "Too many devices accepted");
+
+	ret = pm_device_get_many(devs, 2);
+	zassert_true(ret == 0, "Fail to bring up devices");
+
+	zassert_true(dev->pm->state == PM_DEVICE_STATE_ACTIVE, "Wrong state");
+
+	ret = pm_device_put_many(devs, 1);
+	zassert_true(ret == 0, "Fail to suspend devices");
+
+	/* Still used once */
+	zassert_true(dev->pm->state == PM_DEVICE_STATE_ACTIVE, "Wrong state");
+
+	ret = pm_device_put_many(devs, 1);
+	zassert_true(ret == 0, "Fail to suspend devices");
+
+	zassert_true(dev->pm->state == PM_DEVICE_STATE_SUSPEND, "Wrong state");
+}
+
 /*
  * @brief test device runtime async API with multiple calls to check
  * if the reference count keeps consistent.
@@ -232,6 +312,8 @@ void test_main(void)
 							test_setup,
 							test_teardown),
 			 ztest_unit_test(test_sync),
+			 ztest_unit_test(test_autosuspend),
+			 ztest_unit_test(test_many),
 			 ztest_unit_test(test_multiple_times));
 	ztest_run_test_suite(device_runtime_test);
 }
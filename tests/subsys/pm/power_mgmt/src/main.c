@@ -11,6 +11,7 @@
 #include <ksched.h>
 #include <kernel.h>
 #include <pm/pm.h>
+#include <pm/policy.h>
 #include "dummy_driver.h"
 
 #define SLEEP_MSEC 100
@@ -189,6 +190,40 @@ void test_power_state_notification(void)
 	api->open(dev);
 }
 
+/**
+ * @brief Test the latency requirements
+ *
+ * @details
+ *  - the strictest requirement applies
+ *  - requirements can be updated and removed
+ *
+ * @see pm_policy_latency_request_add(), pm_policy_latency_request_update(),
+ *      pm_policy_latency_request_remove(), pm_policy_latency_max_get()
+ *
+ * @ingroup power_tests
+ */
+void test_latency_request(void)
+{
+	struct pm_policy_latency_request req1, req2;
+
+	zassert_equal(pm_policy_latency_max_get(), UINT32_MAX, NULL);
+
+	pm_policy_latency_request_add(&req1, 100U);
+	zassert_equal(pm_policy_latency_max_get(), 100U, NULL);
+
+	pm_policy_latency_request_add(&req2, 50U);
+	zassert_equal(pm_policy_latency_max_get(), 50U, NULL);
+
+	pm_policy_latency_request_update(&req2, 200U);
+	zassert_equal(pm_policy_latency_max_get(), 100U, NULL);
+
+	pm_policy_latency_request_remove(&req1);
+	zassert_equal(pm_policy_latency_max_get(), 200U, NULL);
+
+	pm_policy_latency_request_remove(&req2);
+	zassert_equal(pm_policy_latency_max_get(), UINT32_MAX, NULL);
+}
+
 void test_setup(void)
 {
 	int ret;
@@ -221,7 +256,8 @@ void test_main(void)
 			 ztest_unit_test_setup_teardown(
 						test_power_state_notification,
 						test_setup,
-						test_teardown));
+						test_teardown),
+			 ztest_unit_test(test_latency_request));
 	ztest_run_test_suite(power_management_test);
 	pm_notifier_unregister(&notifier);
 }
@@ -606,6 +606,243 @@ static void test_direct_loading_filter(void)
 	}
 }
 
+static uint8_t batch_vals[3];
+static unsigned int batch_load_cnt;
+
+static int batch_loader(const char *key, size_t len, settings_read_cb read_cb,
+			void *cb_arg, void *param)
+{
+	int rc;
+
+	zassert_equal(1, len, NULL);
+	zassert_not_null(key, NULL);
+	zassert_true(key[0] >= '1' && key[0] <= '3', "Unexpected key: %s", key);
+
+	rc = read_cb(cb_arg, &batch_vals[key[0] - '1'], len);
+	zassert_equal(len, rc, NULL);
+
+	batch_load_cnt++;
+	return 0;
+}
+
+static void test_save_batch(void)
+{
+	int rc;
+	uint8_t vals[] = { 1, 2, 3 };
+	const struct settings_batch_item items[] = {
+		{ .name = "batch/1", .value = &vals[0], .val_len = 1 },
+		{ .name = "batch/2", .value = &vals[1], .val_len = 1 },
+		{ .name = "batch/3", .value = &vals[2], .val_len = 1 },
+	};
+	const struct settings_batch_item update[] = {
+		{ .name = "batch/1", .value = &vals[2], .val_len = 1 },
+		{ .name = "batch/2", .value = NULL, .val_len = 0 },
+		{ .name = "batch/1", .value = &vals[1], .val_len = 1 },
+	};
+
+	rc = settings_save_batch(items, ARRAY_SIZE(items));
+	zassert_equal(0, rc, "settings_save_batch failed: %d", rc);
+
+	memset(batch_vals, 0, sizeof(batch_vals));
+	batch_load_cnt = 0;
+	rc = settings_load_subtree_direct("batch", batch_loader, NULL);
+	zassert_equal(0, rc, NULL);
+	zassert_equal(3, batch_load_cnt, NULL);
+	zassert_mem_equal(vals, batch_vals, sizeof(vals), NULL);
+
+	rc = settings_save_batch(update, ARRAY_SIZE(update));
+	zassert_equal(0, rc, "settings_save_batch failed: %d", rc);
+
+	memset(batch_vals, 0, sizeof(batch_vals));
+	batch_load_cnt = 0;
+	rc = settings_load_subtree_direct("batch", batch_loader, NULL);
+	zassert_equal(0, rc, NULL);
+	zassert_equal(2, batch_load_cnt, NULL);
+	zassert_equal(2, batch_vals[0], NULL);
+	zassert_equal(0, batch_vals[1], NULL);
+	zassert_equal(3, batch_vals[2], NULL);
+}
+
+static char subtree_key[8];
+static uint8_t subtree_val;
+static unsigned int subtree_load_cnt;
+
+static int subtree_loader(const char *key, size_t len,
+			  settings_read_cb read_cb, void *cb_arg, void *param)
+{
+	int rc;
+
+	zassert_equal(1, len, NULL);
+	zassert_not_null(key, NULL);
+
+	strncpy(subtree_key, key, sizeof(subtree_key) - 1);
+	rc = read_cb(cb_arg, &subtree_val, len);
+	zassert_equal(len, rc, NULL);
+
+	subtree_load_cnt++;
+	return 0;
+}
+
+static void check_subtree(const char *subtree, const char *key, uint8_t val)
+{
+	int rc;
+
+	memset(subtree_key, 0, sizeof(subtree_key));
+	subtree_load_cnt = 0;
+	rc = settings_load_subtree_direct(subtree, subtree_loader, NULL);
+	zassert_equal(0, rc, NULL);
+	zassert_equal(1, subtree_load_cnt, "Unexpected loads of %s", subtree);
+	zassert_true(!strcmp(key, subtree_key), "Unexpected key: %s",
+		     subtree_key);
+	zassert_equal(val, subtree_val, NULL);
+}
+
+/* Entries deleted and saved again in other subtrees are loaded with the
+ * subtree they belong to now.
+ */
+static void test_subtree_reuse(void)
+{
+	uint8_t vals[] = { 1, 2, 3 };
+	int rc;
+
+	rc = settings_save_one("sub_a/1", &vals[0], 1);
+	zassert_equal(0, rc, NULL);
+	rc = settings_save_one("sub_b/1", &vals[1], 1);
+	zassert_equal(0, rc, NULL);
+
+	check_subtree("sub_a", "1", vals[0]);
+	check_subtree("sub_b", "1", vals[1]);
+
+	rc = settings_delete("sub_a/1");
+	zassert_equal(0, rc, NULL);
+	rc = settings_save_one("sub_c/2", &vals[2], 1);
+	zassert_equal(0, rc, NULL);
+
+	subtree_load_cnt = 0;
+	rc = settings_load_subtree_direct("sub_a", subtree_loader, NULL);
+	zassert_equal(0, rc, NULL);
+	zassert_equal(0, subtree_load_cnt, NULL);
+
+	check_subtree("sub_b", "1", vals[1]);
+	check_subtree("sub_c", "2", vals[2]);
+
+	rc = settings_save_one("sub_a/1", &vals[2], 1);
+	zassert_equal(0, rc, NULL);
+	check_subtree("sub_a", "1", vals[2]);
+}
+
+static void test_save_deferred(void)
+{
+#if !defined(CONFIG_SETTINGS_WRITEBACK)
+	ztest_test_skip();
+#else
+	uint8_t vals[] = { 1, 2, 3, 4 };
+	char name[16];
+	int rc;
+
+	/* The last save wins, deferred or not */
+	rc = settings_save_one_deferred("wb/1", &vals[0], 1);
+	zassert_equal(0, rc, NULL);
+	rc = settings_save_one_deferred("wb/1", &vals[1], 1);
+	zassert_equal(0, rc, NULL);
+	check_subtree("wb", "1", vals[1]);
+
+	rc = settings_save_one_deferred("wb/1", &vals[2], 1);
+	zassert_equal(0, rc, NULL);
+	rc = settings_save_one("wb/1", &vals[3], 1);
+	zassert_equal(0, rc, NULL);
+	rc = settings_flush();
+	zassert_equal(0, rc, NULL);
+	check_subtree("wb", "1", vals[3]);
+
+	rc = settings_save_one_deferred("wb/1", NULL, 0);
+	zassert_equal(0, rc, NULL);
+	k_sleep(K_MSEC(CONFIG_SETTINGS_WRITEBACK_DELAY + 100));
+
+	subtree_load_cnt = 0;
+	rc = settings_load_subtree_direct("wb", subtree_loader, NULL);
+	zassert_equal(0, rc, NULL);
+	zassert_equal(0, subtree_load_cnt, NULL);
+
+	/* More items than the cache holds */
+	for (int i = 0; i <= CONFIG_SETTINGS_WRITEBACK_ENTRIES; i++) {
+		snprintk(name, sizeof(name), "wb/%d", i);
+		rc = settings_save_one_deferred(name, &vals[0], 1);
+		zassert_equal(0, rc, NULL);
+	}
+
+	subtree_load_cnt = 0;
+	rc = settings_load_subtree_direct("wb", subtree_loader, NULL);
+	zassert_equal(0, rc, NULL);
+	zassert_equal(CONFIG_SETTINGS_WRITEBACK_ENTRIES + 1, subtree_load_cnt,
+		      NULL);
+#endif
+}
+
+static unsigned int deferred_set_cnt;
+static unsigned int deferred_commit_cnt;
+
+static int deferred_set(const char *key, size_t len, settings_read_cb read_cb,
+			void *cb_arg)
+{
+	deferred_set_cnt++;
+	return 0;
+}
+
+static int deferred_commit(void)
+{
+	deferred_commit_cnt++;
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE_DEFERRED(deferred, "deferred", NULL,
+					deferred_set, deferred_commit, NULL);
+
+static void test_deferred_loading(void)
+{
+	uint8_t val = 1;
+	int rc;
+
+	rc = settings_save_one("deferred/1", &val, 1);
+	zassert_equal(0, rc, NULL);
+
+	deferred_set_cnt = 0;
+	deferred_commit_cnt = 0;
+	rc = settings_load();
+	zassert_equal(0, rc, NULL);
+
+	if (IS_ENABLED(CONFIG_SETTINGS_DEFERRED_LOAD_BACKGROUND)) {
+		/* Loaded once the system work queue runs */
+		zassert_equal(0, deferred_set_cnt, NULL);
+		k_sleep(K_MSEC(100));
+		zassert_equal(1, deferred_set_cnt, NULL);
+		zassert_equal(1, deferred_commit_cnt, NULL);
+	} else {
+		zassert_equal(0, deferred_set_cnt, NULL);
+		zassert_equal(0, deferred_commit_cnt, NULL);
+	}
+
+	deferred_set_cnt = 0;
+	deferred_commit_cnt = 0;
+	rc = settings_load_deferred();
+	zassert_equal(0, rc, NULL);
+	zassert_equal(1, deferred_set_cnt, NULL);
+	zassert_equal(1, deferred_commit_cnt, NULL);
+
+	/* Loaded on first access */
+	deferred_set_cnt = 0;
+	deferred_commit_cnt = 0;
+	rc = settings_load_subtree("deferred");
+	zassert_equal(0, rc, NULL);
+	zassert_equal(1, deferred_set_cnt, NULL);
+	zassert_equal(1, deferred_commit_cnt, NULL);
+
+	/* All the handlers are committed on request */
+	deferred_commit_cnt = 0;
+	rc = settings_commit();
+	zassert_equal(0, rc, NULL);
+	zassert_equal(1, deferred_commit_cnt, NULL);
+}
 
 void test_main(void)
 {
@@ -614,7 +851,11 @@ void test_main(void)
 			 ztest_unit_test(test_support_rtn),
 			 ztest_unit_test(test_register_and_loading),
 			 ztest_unit_test(test_direct_loading),
-			 ztest_unit_test(test_direct_loading_filter)
+			 ztest_unit_test(test_direct_loading_filter),
+			 ztest_unit_test(test_save_batch),
+			 ztest_unit_test(test_subtree_reuse),
+			 ztest_unit_test(test_save_deferred),
+			 ztest_unit_test(test_deferred_loading)
 			);
 
 	ztest_run_test_suite(settings_test_suite);
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <string.h>
+#include <stats/stats.h>
+
+#define ENTRY_CNT (sizeof(struct stats_histogram_summary) / sizeof(uint32_t))
+
+STATS_HISTOGRAM_DEFINE(hist, 16);
+
+struct walk_data {
+	uint32_t values[ENTRY_CNT];
+	/* Generated names only live during the walk. */
+	char names[ENTRY_CNT][8];
+	int cnt;
+};
+
+static int entry_get(struct stats_hdr *hdr, void *arg, const char *name,
+		     uint16_t off)
+{
+	struct walk_data *data = arg;
+
+	zassert_true(data->cnt < ENTRY_CNT, "Too many entries");
+	data->values[data->cnt] = *(uint32_t *)((uint8_t *)hdr + off);
+	strncpy(data->names[data->cnt], name, sizeof(data->names[0]) - 1);
+	data->cnt++;
+
+	return 0;
+}
+
+/* Relative error of the percentiles, from the bucket width. */
+static void assert_near(uint32_t value, uint32_t expected)
+{
+	uint32_t err = expected / STATS_HISTOGRAM_SUB_CNT;
+
+	zassert_true(value >= expected && value <= expected + err,
+		     "Got %u, expected %u", value, expected);
+}
+
+static void test_histogram_register(void)
+{
+	int rc;
+
+	rc = STATS_HISTOGRAM_INIT_AND_REG(hist, "hist");
+	zassert_equal(rc, 0, "Unexpected err: %d", rc);
+
+	zassert_equal_ptr(stats_group_find("hist"), &hist.s_hdr,
+			  "Histogram group not found");
+	zassert_true(hist.s_hdr.s_flags & STATS_HDR_F_HISTOGRAM,
+		     "Not flagged as histogram");
+
+	rc = STATS_HISTOGRAM_INIT_AND_REG(hist, "hist");
+	zassert_equal(rc, -EALREADY, "Unexpected err: %d", rc);
+}
+
+static void test_histogram_empty(void)
+{
+	struct stats_histogram_summary summary;
+
+	stats_reset(&hist.s_hdr);
+	stats_histogram_summary_get(&hist, &summary);
+
+	zassert_equal(summary.count, 0, NULL);
+	zassert_equal(summary.min, 0, NULL);
+	zassert_equal(summary.max, 0, NULL);
+	zassert_equal(stats_histogram_percentile(&hist, 500), 0, NULL);
+}
+
+static void test_histogram_percentiles(void)
+{
+	struct stats_histogram_summary summary;
+
+	stats_reset(&hist.s_hdr);
+
+	for (uint32_t i = 1; i <= 10000; i++) {
+		STATS_HISTOGRAM_RECORD(hist, i);
+	}
+
+	stats_histogram_summary_get(&hist, &summary);
+
+	zassert_equal(summary.count, 10000, NULL);
+	zassert_equal(summary.min, 1, NULL);
+	zassert_equal(summary.max, 10000, NULL);
+	zassert_equal(summary.mean, 5000, NULL);
+	assert_near(summary.p50, 5000);
+	assert_near(summary.p90, 9000);
+	assert_near(summary.p99, 9900);
+	assert_near(summary.p999, 9990);
+	zassert_equal(stats_histogram_percentile(&hist, 1000), 10000, NULL);
+
+	/* Small values have exact buckets. */
+	zassert_equal(stats_histogram_percentile(&hist, 0), 1, NULL);
+}
+
+static void test_histogram_overflow(void)
+{
+	stats_reset(&hist.s_hdr);
+
+	STATS_HISTOGRAM_RECORD(hist, 10);
+	STATS_HISTOGRAM_RECORD(hist, UINT32_MAX);
+
+	zassert_equal(stats_histogram_percentile(&hist, 500), 10, NULL);
+	zassert_equal(stats_histogram_percentile(&hist, 990), UINT32_MAX,
+		      NULL);
+}
+
+static int bucket_count(struct stats_histogram *h, void *arg, uint32_t low,
+			uint32_t high, uint32_t cnt)
+{
+	uint32_t *total = arg;
+
+	zassert_true(low <= high, "Invalid bucket %u-%u", low, high);
+	*total += cnt;
+
+	return 0;
+}
+
+static void test_histogram_buckets(void)
+{
+	uint32_t total = 0;
+
+	stats_reset(&hist.s_hdr);
+
+	for (uint32_t i = 0; i < 1000; i += 7) {
+		STATS_HISTOGRAM_RECORD(hist, i);
+	}
+
+	zassert_equal(stats_histogram_bucket_walk(&hist, bucket_count, &total),
+		      0, NULL);
+	zassert_equal(total, hist.count, NULL);
+}
+
+static void test_histogram_walk(void)
+{
+	struct walk_data data = { 0 };
+
+	stats_reset(&hist.s_hdr);
+	STATS_HISTOGRAM_RECORD(hist, 3);
+	STATS_HISTOGRAM_RECORD(hist, 5);
+
+	/* The entries are computed on read. */
+	zassert_equal(stats_walk(&hist.s_hdr, entry_get, &data), 0, NULL);
+	zassert_equal(data.cnt, ENTRY_CNT, NULL);
+	zassert_equal(data.values[0], 2, "Wrong count");
+	zassert_equal(data.values[1], 3, "Wrong min");
+	zassert_equal(data.values[2], 5, "Wrong max");
+	zassert_equal(data.values[3], 4, "Wrong mean");
+
+	if (IS_ENABLED(CONFIG_STATS_NAMES)) {
+		zassert_equal(strcmp(data.names[0], "count"), 0, NULL);
+		zassert_equal(strcmp(data.names[7], "p99.9"), 0, NULL);
+	} else {
+		zassert_equal(strcmp(data.names[0], "s0"), 0, NULL);
+	}
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_stats_histogram,
+			 ztest_unit_test(test_histogram_register),
+			 ztest_unit_test(test_histogram_empty),
+			 ztest_unit_test(test_histogram_percentiles),
+			 ztest_unit_test(test_histogram_overflow),
+			 ztest_unit_test(test_histogram_buckets),
+			 ztest_unit_test(test_histogram_walk));
+	ztest_run_test_suite(test_stats_histogram);
+}
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <drivers/flash.h>
+#include <storage/flash_map.h>
+#include <storage/flash_area_writer.h>
+
+#define MAX_PAGES 16
+
+FLASH_AREA_WRITER_BITMAP_DEFINE(erased, MAX_PAGES);
+static struct flash_area_writer writer;
+static const struct flash_area *fa;
+static size_t page_size;
+static uint8_t buf[256];
+
+static void dirty_area(void)
+{
+	int rc;
+
+	(void)memset(buf, 0x5a, sizeof(buf));
+
+	for (off_t off = 0; off < fa->fa_size; off += page_size) {
+		rc = flash_area_erase(fa, off, page_size);
+		zassert_equal(rc, 0, "erase failed");
+		rc = flash_area_write(fa, off + page_size - sizeof(buf), buf,
+				      sizeof(buf));
+		zassert_equal(rc, 0, "write failed");
+	}
+}
+
+static void setup(void)
+{
+	struct flash_pages_info info;
+	int rc;
+
+	rc = flash_area_open(FLASH_AREA_ID(storage), &fa);
+	zassert_equal(rc, 0, "open failed");
+
+	rc = flash_get_page_info_by_offs(flash_area_get_device(fa), fa->fa_off,
+					 &info);
+	zassert_equal(rc, 0, "no page info");
+	page_size = info.size;
+
+	zassert_true(fa->fa_size / page_size >= 3, "area too small");
+	zassert_true(fa->fa_size / page_size <= MAX_PAGES, "area too large");
+}
+
+void test_flash_area_is_erased(void)
+{
+	int rc;
+
+	setup();
+	dirty_area();
+
+	rc = flash_area_is_erased(fa, 0, page_size - sizeof(buf));
+	zassert_equal(rc, 1, "range not erased");
+
+	rc = flash_area_is_erased(fa, 0, page_size);
+	zassert_equal(rc, 0, "range erased");
+
+	rc = flash_area_is_erased(fa, page_size - 1, 1);
+	zassert_equal(rc, 0, "last byte erased");
+}
+
+void test_flash_area_writer_init(void)
+{
+	int rc;
+
+	setup();
+
+	rc = flash_area_writer_init(&writer, fa, erased, 1, 0);
+	zassert_equal(rc, -ENOMEM, "bitmap too small accepted");
+
+	rc = flash_area_writer_init(&writer, fa, erased, MAX_PAGES, 0);
+	zassert_equal(rc, 0, "init failed");
+	zassert_equal(writer.page_count, fa->fa_size / page_size,
+		      "wrong page count");
+}
+
+void test_flash_area_writer_scan(void)
+{
+	int rc;
+
+	setup();
+	dirty_area();
+
+	rc = flash_area_writer_init(&writer, fa, erased, MAX_PAGES, 0);
+	zassert_equal(rc, 0, "init failed");
+
+	rc = flash_area_erase(fa, page_size, page_size);
+	zassert_equal(rc, 0, "erase failed");
+
+	rc = flash_area_writer_scan(&writer);
+	zassert_equal(rc, 0, "scan failed");
+
+	zassert_false(atomic_test_bit(erased, 0), "page 0 erased");
+	zassert_true(atomic_test_bit(erased, 1), "page 1 not erased");
+	zassert_false(atomic_test_bit(erased, 2), "page 2 erased");
+}
+
+void test_flash_area_writer_write(void)
+{
+	uint8_t rd[sizeof(buf)];
+	int rc;
+
+	setup();
+	dirty_area();
+
+	rc = flash_area_writer_init(&writer, fa, erased, MAX_PAGES, 1);
+	zassert_equal(rc, 0, "init failed");
+
+	for (int i = 0; i < sizeof(buf); i++) {
+		buf[i] = i;
+	}
+
+	/* Fill the first page, then write a block into the second one */
+	for (off_t off = 0; off <= page_size; off += sizeof(buf)) {
+		rc = flash_area_writer_write(&writer, buf, sizeof(buf));
+		zassert_equal(rc, 0, "write failed");
+	}
+
+	rc = flash_area_writer_sync(&writer);
+	zassert_equal(rc, 0, "erase ahead failed");
+
+	zassert_equal(writer.offset, page_size + sizeof(buf),
+		      "wrong write offset");
+
+	rc = flash_area_read(fa, page_size, rd, sizeof(rd));
+	zassert_equal(rc, 0, "read failed");
+	zassert_mem_equal(rd, buf, sizeof(rd), "wrong data");
+
+	/* The end of the second page was erased when it was entered */
+	rc = flash_area_is_erased(fa, page_size + sizeof(buf),
+				  page_size - sizeof(buf));
+	zassert_equal(rc, 1, "page 1 not erased");
+
+	/* The third page is erased ahead, not the fourth one */
+	rc = flash_area_is_erased(fa, 2 * page_size, page_size);
+	zassert_equal(rc, 1, "page 2 not erased ahead");
+	zassert_true(atomic_test_bit(erased, 2), "page 2 not marked erased");
+
+	if (writer.page_count > 3) {
+		rc = flash_area_is_erased(fa, 3 * page_size, page_size);
+		zassert_equal(rc, 0, "page 3 erased");
+	}
+}
+
+void test_flash_area_writer_erase(void)
+{
+	int rc;
+
+	setup();
+	dirty_area();
+
+	rc = flash_area_writer_init(&writer, fa, erased, MAX_PAGES, 0);
+	zassert_equal(rc, 0, "init failed");
+
+	rc = flash_area_writer_erase(&writer, 0, 2 * page_size);
+	zassert_equal(rc, 0, "erase failed");
+	zassert_true(atomic_test_bit(erased, 1), "page 1 not marked erased");
+
+	/* A page marked erased is not erased again */
+	(void)memset(buf, 0x5a, sizeof(buf));
+	rc = flash_area_write(fa, page_size, buf, sizeof(buf));
+	zassert_equal(rc, 0, "write failed");
+
+	rc = flash_area_writer_erase(&writer, page_size, page_size);
+	zassert_equal(rc, 0, "erase failed");
+	rc = flash_area_is_erased(fa, page_size, sizeof(buf));
+	zassert_equal(rc, 0, "page erased again");
+
+	rc = flash_area_writer_erase(&writer, 1, page_size);
+	zassert_equal(rc, -EINVAL, "unaligned erase accepted");
+}
+
+void test_flash_area_writer_nospc(void)
+{
+	int rc;
+
+	setup();
+
+	rc = flash_area_writer_init(&writer, fa, erased, MAX_PAGES, 0);
+	zassert_equal(rc, 0, "init failed");
+
+	/* Writes after a seek into a page do not erase it */
+	rc = flash_area_writer_erase(&writer, fa->fa_size - page_size,
+				     page_size);
+	zassert_equal(rc, 0, "erase failed");
+
+	rc = flash_area_writer_seek(&writer, fa->fa_size - sizeof(buf));
+	zassert_equal(rc, 0, "seek failed");
+
+	rc = flash_area_writer_write(&writer, buf, sizeof(buf));
+	zassert_equal(rc, 0, "write failed");
+
+	rc = flash_area_writer_write(&writer, buf, sizeof(buf));
+	zassert_equal(rc, -ENOSPC, "write past the area accepted");
+
+	rc = flash_area_writer_seek(&writer, fa->fa_size + 1);
+	zassert_equal(rc, -EINVAL, "seek past the area accepted");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(flash_area_writer,
+			 ztest_unit_test(test_flash_area_is_erased),
+			 ztest_unit_test(test_flash_area_writer_init),
+			 ztest_unit_test(test_flash_area_writer_scan),
+			 ztest_unit_test(test_flash_area_writer_write),
+			 ztest_unit_test(test_flash_area_writer_erase),
+			 ztest_unit_test(test_flash_area_writer_nospc));
+	ztest_run_test_suite(flash_area_writer);
+}
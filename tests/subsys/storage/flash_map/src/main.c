@@ -169,12 +169,46 @@ void test_flash_area_erased_val(void)
 		      "value different than the flash erase value");
 }
 
+void test_flash_area_mmap(void)
+{
+	const uint8_t tst_vec[] = { 0x01, 0x23, 0x45, 0x67,
+				    0x89, 0xab, 0xcd, 0xef };
+	const struct flash_area *fa;
+	const void *addr;
+	int rc;
+
+	rc = flash_area_open(FLASH_AREA_ID(image_1), &fa);
+	zassert_true(rc == 0, "flash_area_open() fail");
+
+	rc = flash_area_mmap(fa, fa->fa_size - sizeof(tst_vec) + 1,
+			     sizeof(tst_vec), &addr);
+	zassert_equal(rc, -EINVAL, "Mapped a range out of the area");
+
+	rc = flash_area_mmap(fa, 0, sizeof(tst_vec), &addr);
+	if (!IS_ENABLED(CONFIG_FLASH_MMAP)) {
+		zassert_equal(rc, -ENOTSUP, "Mapped without CONFIG_FLASH_MMAP");
+		ztest_test_skip();
+	}
+	zassert_equal(rc, 0, "flash_area_mmap() fail, error %d", rc);
+
+	rc = flash_area_erase(fa, 0, fa->fa_size);
+	zassert_true(rc == 0, "Flash erase failure, error %d", rc);
+	rc = flash_area_write(fa, 0, tst_vec, sizeof(tst_vec));
+	zassert_true(rc == 0, "Flash write failure, error %d", rc);
+
+	zassert_mem_equal(addr, tst_vec, sizeof(tst_vec),
+			  "Mapped data does not match the written data");
+
+	flash_area_close(fa);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_flash_map,
 			 ztest_unit_test(test_flash_area_erased_val),
 			 ztest_unit_test(test_flash_area_get_sectors),
-			 ztest_unit_test(test_flash_area_check_int_sha256)
+			 ztest_unit_test(test_flash_area_check_int_sha256),
+			 ztest_unit_test(test_flash_area_mmap)
 			);
 	ztest_run_test_suite(test_flash_map);
 }
@@ -644,6 +644,40 @@ static void test_stream_flash_progress_clear(void)
 #endif
 }
 
+static void test_stream_flash_async(void)
+{
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	size_t len = page_size * 2 + 100;
+	int rc;
+
+	init_target();
+
+	rc = stream_flash_async_enable(&ctx);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, len, false);
+	zassert_equal(rc, 0, "expected success");
+	zassert_true(stream_flash_bytes_written(&ctx) < len,
+		     "the last bytes should still be buffered");
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, 0, true);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx), len,
+		      "all bytes should be written after flush");
+	VERIFY_WRITTEN(0, len);
+
+	/* An error of the work queue thread is returned by the flush */
+	cb_ret = -EFAULT;
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN / 2, false);
+	zassert_equal(rc, 0, "expected success");
+	rc = stream_flash_buffered_write(&ctx, write_buf, 0, true);
+	zassert_equal(rc, -EFAULT, "expected failure");
+	cb_ret = 0;
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	fdev = device_get_binding(FLASH_NAME);
@@ -667,7 +701,8 @@ void test_main(void)
 	     ztest_unit_test(test_stream_flash_bytes_written),
 	     ztest_unit_test(test_stream_flash_progress_api),
 	     ztest_unit_test(test_stream_flash_progress_resume),
-	     ztest_unit_test(test_stream_flash_progress_clear)
+	     ztest_unit_test(test_stream_flash_progress_clear),
+	     ztest_unit_test(test_stream_flash_async)
 	 );
 
 	ztest_run_test_suite(lib_stream_flash_test);